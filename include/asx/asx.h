@@ -47,6 +47,8 @@
 
 /* Runtime (walking skeleton — bd-ix8.8) */
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/digest.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/waker.h>
 
 #endif /* ASX_ASX_H */
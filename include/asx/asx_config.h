@@ -68,6 +68,68 @@
   #define ASX_DETERMINISTIC 1
 #endif
 
+/* Storage class for worker-local state. Deterministic builds poll on
+ * one thread and use plain globals, as do compilers without TLS. */
+#ifndef ASX_THREAD_LOCAL
+  #if ASX_DETERMINISTIC
+    #define ASX_THREAD_LOCAL
+  #elif defined(__GNUC__) || defined(__clang__)
+    #define ASX_THREAD_LOCAL __thread
+  #elif defined(_MSC_VER)
+    #define ASX_THREAD_LOCAL __declspec(thread)
+  #else
+    #define ASX_THREAD_LOCAL
+  #endif
+#endif
+
+/* Fault injection (asx_fault_inject) and hindsight logging at the clock,
+ * entropy and reactor hooks: compiled in except in NDEBUG builds without
+ * ASX_DEBUG. Override with -DASX_FAULT_INJECTION=0|1, -DASX_HINDSIGHT=0|1. */
+#if defined(NDEBUG) && !(defined(ASX_DEBUG) && ASX_DEBUG)
+  #define ASX_INSTRUMENTED_DEFAULT 0
+#else
+  #define ASX_INSTRUMENTED_DEFAULT 1
+#endif
+#ifndef ASX_FAULT_INJECTION
+  #define ASX_FAULT_INJECTION ASX_INSTRUMENTED_DEFAULT
+#endif
+#ifndef ASX_HINDSIGHT
+  #define ASX_HINDSIGHT ASX_INSTRUMENTED_DEFAULT
+#endif
+
+/* Per-task poll profiling (asx_task_profile_get): the scheduler times
+ * every poll and keeps per-slot counters. Off by default; with it off
+ * the poll path carries no clock reads. Enable with -DASX_TASK_PROFILE=1. */
+#ifndef ASX_TASK_PROFILE
+  #define ASX_TASK_PROFILE 0
+#endif
+
+/* Handle epochs across asx_runtime_reset: each reset moves the first
+ * generation of never-used slots past every generation handed out
+ * before it, so pre-reset handles stay stale. On by default only in
+ * non-deterministic builds: it makes handle values (and trace digests)
+ * depend on what ran before the reset, which breaks replay identity.
+ * Override with -DASX_HANDLE_EPOCH=0|1; `make test-handle-epoch` runs
+ * the suite with it on. */
+#ifndef ASX_HANDLE_EPOCH
+  #if ASX_DETERMINISTIC
+    #define ASX_HANDLE_EPOCH 0
+  #else
+    #define ASX_HANDLE_EPOCH 1
+  #endif
+#endif
+
+/* Allocation accounting (asx_resource_alloc_snapshot_get): hook
+ * allocations are counted per call-site tag and live blocks are kept
+ * in a table of ASX_ALLOC_PROFILE_BLOCKS entries (a power of two).
+ * Off by default. Enable with -DASX_ALLOC_PROFILE=1. */
+#ifndef ASX_ALLOC_PROFILE
+  #define ASX_ALLOC_PROFILE 0
+#endif
+#ifndef ASX_ALLOC_PROFILE_BLOCKS
+  #define ASX_ALLOC_PROFILE_BLOCKS 1024u
+#endif
+
 /* ------------------------------------------------------------------ */
 /* Resource classes                                                     */
 /*                                                                     */
@@ -179,12 +241,37 @@ ASX_API asx_containment_policy asx_containment_policy_for_profile(
 /* Return the active containment policy (derived from active profile). */
 ASX_API asx_containment_policy asx_containment_policy_active(void);
 
+/* The policy asx_containment_policy_active() returns, as a constant
+ * expression of ASX_SAFETY_PROFILE_SELECTED. */
+#define ASX_CONTAINMENT_POLICY_SELECTED                                       \
+    ((ASX_SAFETY_PROFILE_SELECTED) == ASX_SAFETY_DEBUG    ? ASX_CONTAIN_FAIL_FAST : \
+     (ASX_SAFETY_PROFILE_SELECTED) == ASX_SAFETY_HARDENED ? ASX_CONTAIN_POISON_REGION : \
+                                                            ASX_CONTAIN_ERROR_ONLY)
+
 /* ------------------------------------------------------------------ */
-/* Fault injection (deterministic-mode only)                           */
+/* Static profile                                                      */
+/*                                                                     */
+/* ASX_STATIC_PROFILE 1 fixes, at compile time, the settings the       */
+/* kernel otherwise looks up on its hot paths: the containment policy  */
+/* comes from ASX_CONTAINMENT_POLICY_SELECTED, and the telemetry tier  */
+/* is pinned to ASX_TELEMETRY_MIN_TIER (asx_telemetry_set_tier returns */
+/* ASX_E_INVALID_STATE for a less verbose tier). Branches for the      */
+/* other policies and tiers drop out of the scheduler, lifecycle and   */
+/* channels. Intended for release and HFT builds, e.g.                 */
+/*   -DNDEBUG -DASX_STATIC_PROFILE=1 -DASX_TELEMETRY_MIN_TIER=2        */
+/* ------------------------------------------------------------------ */
+#ifndef ASX_STATIC_PROFILE
+  #define ASX_STATIC_PROFILE 0
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Fault injection                                                     */
 /*                                                                     */
 /* Injects controlled faults into clock, entropy, and allocator paths  */
-/* for testing exhaustion/anomaly handling. Active only when            */
-/* ASX_DETERMINISTIC is set. No-op stubs in non-deterministic builds.  */
+/* for testing exhaustion/anomaly handling. A hook with no fault       */
+/* injected skips the fault table; trigger_after counts that hook's    */
+/* calls from its first injection. With ASX_FAULT_INJECTION 0,         */
+/* asx_fault_inject returns ASX_E_INVALID_STATE.                       */
 /* ------------------------------------------------------------------ */
 
 typedef enum {
@@ -228,6 +315,24 @@ typedef asx_status (*asx_ghost_reactor_wait_fn)(void *ctx, uint64_t logical_step
 
 typedef void (*asx_log_sink_fn)(void *ctx, int level, const char *message);
 
+/* Worker dispatch: run entry(arg, w) for every w in [0, worker_count) on
+ * up to worker_count OS threads and return once all calls finished. */
+typedef void (*asx_worker_entry_fn)(void *arg, uint32_t worker_index);
+typedef asx_status (*asx_worker_dispatch_fn)(void *ctx, uint32_t worker_count,
+                                             asx_worker_entry_fn entry, void *arg);
+/* Give up the rest of the calling thread's time slice. */
+typedef void (*asx_thread_yield_fn)(void *ctx);
+/* Pin the calling thread to the CPUs set in cpu_mask (bit n = CPU n). */
+typedef asx_status (*asx_thread_pin_fn)(void *ctx, uint64_t cpu_mask);
+/* Involuntary context switches of the calling thread so far. */
+typedef asx_status (*asx_thread_switches_fn)(void *ctx, uint64_t *out_count);
+
+/* File I/O submit: start op (a write or fsync) and return at once. The
+ * backend later hands the result to asx_runtime_file_complete on the
+ * scheduler thread, typically from its reactor wait hook. */
+struct asx_file_op;
+typedef asx_status (*asx_file_submit_fn)(void *ctx, struct asx_file_op *op);
+
 typedef struct {
     void *ctx;
     asx_alloc_fn malloc_fn;
@@ -257,21 +362,38 @@ typedef struct {
     asx_log_sink_fn write_fn;
 } asx_log_hooks;
 
+typedef struct {
+    void *ctx;
+    asx_worker_dispatch_fn dispatch_fn; /* NULL: single-threaded only */
+    asx_thread_yield_fn yield_fn;       /* NULL: yield waits pause the CPU */
+    asx_thread_pin_fn pin_fn;           /* NULL: workers are never pinned */
+    asx_thread_switches_fn switches_fn; /* NULL: no context-switch counts */
+} asx_thread_hooks;
+
+typedef struct {
+    void *ctx;
+    asx_file_submit_fn submit_fn; /* NULL: no asynchronous file I/O */
+} asx_file_hooks;
+
 typedef struct {
     asx_allocator_hooks allocator;
     asx_clock_hooks clock;
     asx_entropy_hooks entropy;
     asx_reactor_hooks reactor;
     asx_log_hooks log;
+    asx_thread_hooks threads;
+    asx_file_hooks file;
     uint8_t deterministic_seeded_prng; /* 1 when deterministic entropy stream is configured */
     uint8_t allocator_sealed;          /* 1 after asx_runtime_seal_allocator() */
 } asx_runtime_hooks;
 
-/* Wait policy (resource-plane only; does not affect semantics) */
+/* Wait policy (resource-plane only; does not affect semantics).
+ * How asx_scheduler_wait_idle spends the gap until the next timer. */
 typedef enum {
-    ASX_WAIT_BUSY_SPIN = 0,
-    ASX_WAIT_YIELD     = 1,
-    ASX_WAIT_SLEEP     = 2
+    ASX_WAIT_BUSY_SPIN = 0,  /* CPU pause loop polling the reactor */
+    ASX_WAIT_YIELD     = 1,  /* as BUSY_SPIN, yielding the CPU between polls */
+    ASX_WAIT_SLEEP     = 2,  /* block in the reactor until the deadline */
+    ASX_WAIT_ADAPTIVE  = 3   /* spin for a self-tuning window, then sleep */
 } asx_wait_policy;
 
 /* Obligation leak response policy */
@@ -348,6 +470,29 @@ ASX_API asx_status asx_runtime_realloc(void *ptr, size_t size, void **out_ptr);
  * ASX_E_HOOK_MISSING if no allocator. */
 ASX_API asx_status asx_runtime_free(void *ptr);
 
+/* Call-site tags for allocation accounting (ASX_ALLOC_PROFILE). The
+ * untagged helpers above count under ASX_ALLOC_TAG_OTHER. */
+typedef enum {
+    ASX_ALLOC_TAG_OTHER     = 0,  /* untagged callers */
+    ASX_ALLOC_TAG_ARENA     = 1,  /* region/task/obligation arena chunks */
+    ASX_ALLOC_TAG_CAPTURE   = 2,  /* region capture blocks */
+    ASX_ALLOC_TAG_CLEANUP   = 3,  /* cleanup stack overflow blocks */
+    ASX_ALLOC_TAG_TIMER     = 4,  /* timer wheel chunks */
+    ASX_ALLOC_TAG_CHANNEL   = 5,  /* channel rings and payload storage */
+    ASX_ALLOC_TAG_CODEC     = 6,  /* codec buffers and scratch copies */
+    ASX_ALLOC_TAG_EVENT_LOG = 7,  /* scheduler event ring */
+    ASX_ALLOC_TAG_BUFFER    = 8,  /* I/O buffer pools */
+    ASX_ALLOC_TAG_COUNT     = 9
+} asx_alloc_tag;
+
+/* asx_runtime_alloc / asx_runtime_realloc attributed to a call site.
+ * A realloc moves the block's bytes to the given tag. Same returns,
+ * plus ASX_E_INVALID_ARGUMENT for an unknown tag. */
+ASX_API asx_status asx_runtime_alloc_tagged(asx_alloc_tag tag, size_t size,
+                                            void **out_ptr);
+ASX_API asx_status asx_runtime_realloc_tagged(asx_alloc_tag tag, void *ptr,
+                                              size_t size, void **out_ptr);
+
 /* Read current time via clock hook. Returns ASX_OK on success,
  * ASX_E_HOOK_MISSING if no clock hook installed. */
 ASX_API asx_status asx_runtime_now_ns(asx_time *out_now);
@@ -355,11 +500,669 @@ ASX_API asx_status asx_runtime_now_ns(asx_time *out_now);
 /* Read random u64 via entropy hook. Returns ASX_OK on success,
  * ASX_E_HOOK_MISSING if no entropy hook installed. */
 ASX_API asx_status asx_runtime_random_u64(uint64_t *out_value);
+
+/*
+ * Seeded PRNG (xoshiro256**): the built-in deterministic entropy
+ * source. The default entropy hook runs one shared stream seeded with
+ * a fixed constant; give each worker its own asx_prng instead so
+ * parallel code draws without sharing state. asx_prng_jump advances a
+ * stream by 2^128 draws, so copies jumped 0, 1, 2... times never
+ * overlap in practice (asx_prng_stream does exactly that).
+ * Members are private. Not thread-safe per instance.
+ */
+typedef struct {
+    uint64_t s[4];
+} asx_prng;
+
+/* Expand seed into a full state with splitmix64 (any seed is valid). */
+ASX_API void asx_prng_seed(asx_prng *rng, uint64_t seed);
+
+/* Next 64 bits of the stream. */
+ASX_API uint64_t asx_prng_next(asx_prng *rng);
+
+/* Advance rng by 2^128 draws. */
+ASX_API void asx_prng_jump(asx_prng *rng);
+
+/* *out = root jumped index times: stream index of a root seed. */
+ASX_API void asx_prng_stream(const asx_prng *root, uint32_t index,
+                             asx_prng *out);
+
+/* Entropy hook (asx_entropy_u64_fn); ctx is an asx_prng. */
+ASX_API uint64_t asx_prng_random_u64(void *ctx);
+
+/* Point hooks' entropy at rng and mark it a seeded stream, so
+ * deterministic builds accept it. */
+ASX_API asx_status asx_prng_install(asx_prng *rng, asx_runtime_hooks *hooks);
+
+/*
+ * Simulated clock: time that moves only when the runtime waits, for
+ * long-horizon runs (watchdogs, lease expiry) that should take no real
+ * time. Installed as both clocks and as the reactor, an idle wait jumps
+ * straight to its logical step, the next timer deadline (ghost_wait_fn),
+ * or forward by its timeout (wait_fn), with nothing ready. The
+ * reactor hooks are taken, so no real I/O is driven meanwhile.
+ * asx_scheduler_run_until drives it. now may be read and set directly.
+ */
+typedef struct {
+    asx_time now;
+} asx_sim_clock;
+
+/* Start clock at start. */
+ASX_API void asx_sim_clock_init(asx_sim_clock *clock, asx_time start);
+
+/* Clock hook (asx_clock_now_ns_fn); ctx is an asx_sim_clock. */
+ASX_API asx_time asx_sim_clock_now(void *ctx);
+
+/* Point hooks' wall and logical clocks and reactor waits at clock.
+ * ASX_E_INVALID_ARGUMENT for NULL. */
+ASX_API asx_status asx_sim_clock_install(asx_sim_clock *clock,
+                                         asx_runtime_hooks *hooks);
 /* Wait for reactor readiness. Returns ready count via out_ready_count.
  * Returns ASX_E_HOOK_MISSING if no reactor hook installed. */
 ASX_API asx_status asx_runtime_reactor_wait(uint32_t timeout_ms, uint32_t *out_ready_count, uint64_t logical_step);
 /* Write a log message at the given severity level.
  * Returns ASX_E_HOOK_MISSING if no log hook installed. */
 ASX_API asx_status asx_runtime_log_write(int level, const char *message);
+/* Run entry(arg, w) for w in [0, worker_count) via the thread hook.
+ * Returns ASX_E_INVALID_STATE if no hooks are installed or
+ * ASX_E_HOOK_MISSING if no dispatch hook is set; the caller then runs
+ * the entries itself. */
+ASX_API asx_status asx_runtime_worker_dispatch(uint32_t worker_count,
+                                               asx_worker_entry_fn entry,
+                                               void *arg);
+/* Yield the calling thread via the thread hook.
+ * Returns ASX_E_INVALID_STATE if no hooks are installed or
+ * ASX_E_HOOK_MISSING if no yield hook is set. */
+ASX_API asx_status asx_runtime_thread_yield(void);
+/* Pin the calling thread to cpu_mask via the thread hook. Callable
+ * from worker threads. Returns as asx_runtime_thread_yield,
+ * ASX_E_INVALID_ARGUMENT for a zero mask, or the hook's own error. */
+ASX_API asx_status asx_runtime_thread_pin(uint64_t cpu_mask);
+/* Read the calling thread's involuntary context switch count via the
+ * thread hook. Callable from worker threads. Returns as
+ * asx_runtime_thread_pin, ASX_E_INVALID_ARGUMENT for NULL out_count. */
+ASX_API asx_status asx_runtime_thread_switches(uint64_t *out_count);
+
+/* Asynchronous file operations (asx_file_op.kind) */
+typedef enum {
+    ASX_FILE_OP_WRITE = 0,
+    ASX_FILE_OP_FSYNC = 1
+} asx_file_op_kind;
+
+/* One asynchronous write or fsync, resolving an obligation when done.
+ * Caller-owned; the op and its buffer must stay valid until done is
+ * set. backend is scratch space for the file hook. */
+typedef struct asx_file_op {
+    asx_obligation_id obligation; /* committed on success, else aborted */
+    const void *buf;
+    uint64_t offset;   /* UINT64_MAX: the current position */
+    int64_t handle;    /* file descriptor on POSIX */
+    int32_t result;    /* bytes written (0 for fsync) or -errno, once done */
+    uint32_t len;
+    uint32_t kind;     /* asx_file_op_kind */
+    uint32_t done;
+    void *backend[2];
+} asx_file_op;
+
+/* Write len bytes from buf to handle at offset through the file hook,
+ * off the scheduler thread. Reserves op->obligation in region; it is
+ * committed once every byte is written and aborted on an error or a
+ * short write, so a task awaits it with ASX_CO_AWAIT_OBLIGATION.
+ * Returns ASX_E_INVALID_ARGUMENT for a NULL op or buffer, len above
+ * INT32_MAX or a negative handle, ASX_E_INVALID_STATE if no hooks are installed,
+ * ASX_E_HOOK_MISSING if no file hook is set, the reserve status, or
+ * the hook's refusal (the obligation then aborted). */
+ASX_API ASX_MUST_USE asx_status asx_runtime_file_write(asx_region_id region,
+                                                      asx_file_op *op,
+                                                      int64_t handle,
+                                                      const void *buf,
+                                                      uint32_t len,
+                                                      uint64_t offset);
+/* Flush handle to stable storage through the file hook; otherwise as
+ * asx_runtime_file_write. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_file_fsync(asx_region_id region,
+                                                      asx_file_op *op,
+                                                      int64_t handle);
+/* Finish op with result (bytes written or -errno), resolving its
+ * obligation. For file hook backends, on the scheduler thread.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL, ASX_E_INVALID_STATE if op
+ * is already done, else the commit or abort status. */
+ASX_API asx_status asx_runtime_file_complete(asx_file_op *op, int32_t result);
+
+#if defined(ASX_PROFILE_POSIX) || defined(ASX_PROFILE_WIN32)
+/* Platform worker pool (posix/hooks.c, win32/hooks.c). Installed as the
+ * default thread hook by asx_runtime_hooks_init on these profiles. */
+ASX_API asx_status asx_platform_worker_dispatch(void *ctx, uint32_t worker_count,
+                                                asx_worker_entry_fn entry,
+                                                void *arg);
+/* Yield hook (asx_thread_yield_fn): sched_yield on POSIX, SwitchToThread
+ * on Win32. Installed by asx_runtime_hooks_init on these profiles. */
+ASX_API void asx_platform_thread_yield(void *ctx);
+/* Pin hook (asx_thread_pin_fn): pthread_setaffinity_np on Linux,
+ * SetThreadAffinityMask on Win32; CPUs past the host's set size are
+ * ignored. ASX_E_INVALID_ARGUMENT if no CPU in the mask exists,
+ * ASX_E_HOOK_MISSING on hosts without thread affinity. */
+ASX_API asx_status asx_platform_thread_pin(void *ctx, uint64_t cpu_mask);
+/* Switch-count hook (asx_thread_switches_fn): getrusage(RUSAGE_THREAD)
+ * ru_nivcsw on Linux; ASX_E_HOOK_MISSING elsewhere. */
+ASX_API asx_status asx_platform_thread_switches(void *ctx, uint64_t *out_count);
+/* Trace sink (asx_trace_sink_fn) appending each chunk to ctx, an open
+ * FILE*. Returns ASX_E_RESOURCE_EXHAUSTED on a short write. */
+ASX_API asx_status asx_platform_trace_file_sink(void *ctx,
+                                                const uint8_t *chunk,
+                                                uint32_t len);
+/* Map a file read-only (e.g. a trace for asx_replay_map_reference).
+ * Returns ASX_E_NOT_FOUND if it cannot be opened, ASX_E_INVALID_ARGUMENT
+ * if it is empty or 4 GiB or larger, ASX_E_RESOURCE_EXHAUSTED if the
+ * mapping fails. */
+ASX_API asx_status asx_platform_map_file(const char *path,
+                                         const uint8_t **out_data,
+                                         uint32_t *out_len);
+/* Release a mapping made by asx_platform_map_file. */
+ASX_API void asx_platform_unmap_file(const uint8_t *data, uint32_t len);
+#endif
+
+#if defined(ASX_PROFILE_POSIX) || defined(ASX_PROFILE_WIN32)
+/* Monotonic time in nanoseconds: CLOCK_MONOTONIC on POSIX,
+ * QueryPerformanceCounter on Win32. Installed as the default
+ * now_ns_fn by asx_runtime_hooks_init on these profiles. */
+ASX_API asx_time asx_platform_monotonic_now_ns(void *ctx);
+
+/* Fill len bytes from the OS entropy source: getrandom on Linux,
+ * /dev/urandom on other POSIX hosts, BCryptGenRandom on Win32.
+ * Returns ASX_E_RESOURCE_EXHAUSTED if the source cannot be read. */
+ASX_API asx_status asx_platform_entropy_fill(void *buf, size_t len);
+
+/* Live-mode entropy hook over asx_platform_entropy_fill. Install with
+ * deterministic_seeded_prng = 0. Falls back to a clock-seeded
+ * splitmix64 stream if the OS source is unavailable. */
+ASX_API uint64_t asx_platform_random_u64(void *ctx);
+#endif
+
+#if defined(ASX_PROFILE_POSIX)
+/* Fast clock over the CPU counter (invariant rdtsc on x86, cntvct_el0
+ * on AArch64), scaled to nanoseconds by calibration against
+ * CLOCK_MONOTONIC. Reads cost a few cycles and no call into libc, but
+ * drift from CLOCK_MONOTONIC by the counter's frequency error (and any
+ * NTP slew) until recalibrated. Members are private. */
+typedef struct {
+    asx_time base_ns;        /* CLOCK_MONOTONIC at base_ticks */
+    uint64_t base_ticks;
+    uint64_t mult;           /* ns per tick, 32.32 fixed point */
+} asx_platform_fast_clock;
+
+/* Calibrate clock over window_us microseconds of busy-waiting
+ * (0 selects 10 ms; at most 1 s). Longer windows scale more precisely.
+ * ASX_E_HOOK_MISSING if this CPU has no usable invariant counter,
+ * ASX_E_INVALID_ARGUMENT for NULL or an oversized window. */
+ASX_API asx_status asx_platform_fast_clock_calibrate(asx_platform_fast_clock *clock,
+                                                     uint32_t window_us);
+
+/* Clock hook (asx_clock_now_ns_fn); ctx is a calibrated clock. */
+ASX_API asx_time asx_platform_fast_now_ns(void *ctx);
+
+/* Point hooks' clock at a calibrated clock. */
+ASX_API asx_status asx_platform_fast_clock_install(asx_platform_fast_clock *clock,
+                                                   asx_runtime_hooks *hooks);
+
+/* Huge-page arena: an allocator hook that serves requests of at least
+ * min_slice bytes (region arena chunks: ASX_MAX_REGIONS slots with
+ * their 16 KiB capture arenas) from one anonymous mapping, so capture
+ * state shares a few TLB entries. The mapping is MAP_HUGETLB where the
+ * system has huge pages reserved, otherwise normal pages advised for
+ * transparent huge pages. Smaller requests, and slices once the
+ * mapping is full, go to the backing allocator. Installed as the
+ * allocator hook, so asx_runtime_seal_allocator still applies.
+ * Members are private. */
+#define ASX_PLATFORM_HUGE_PAGE_BYTES ((size_t)2u << 20)
+#define ASX_PLATFORM_HUGE_MIN_SLICE  ((size_t)64u << 10)
+
+typedef enum {
+    ASX_PLATFORM_PAGES_NORMAL  = 0,  /* plain pages, no THP advice */
+    ASX_PLATFORM_PAGES_THP     = 1,  /* advised MADV_HUGEPAGE */
+    ASX_PLATFORM_PAGES_HUGETLB = 2   /* MAP_HUGETLB */
+} asx_platform_page_kind;
+
+typedef struct {
+    uint8_t *base;
+    size_t   size;
+    size_t   used;                   /* bump cursor */
+    size_t   min_slice;
+    void    *free_slices;            /* released slices, reused first-fit */
+    asx_platform_page_kind pages;
+    asx_allocator_hooks backing;
+} asx_platform_huge_arena;
+
+/* Map size bytes (rounded up to ASX_PLATFORM_HUGE_PAGE_BYTES). backing
+ * NULL takes the libc default; min_slice 0 takes
+ * ASX_PLATFORM_HUGE_MIN_SLICE. ASX_E_INVALID_ARGUMENT for NULL or a
+ * zero size, ASX_E_RESOURCE_EXHAUSTED if no mapping can be made. */
+ASX_API asx_status asx_platform_huge_arena_open(asx_platform_huge_arena *arena,
+                                                size_t size, size_t min_slice,
+                                                const asx_allocator_hooks *backing);
+
+/* Unmap the arena. Slices still held become invalid. */
+ASX_API void asx_platform_huge_arena_close(asx_platform_huge_arena *arena);
+
+/* Allocator hooks; ctx is the arena. */
+ASX_API void *asx_platform_huge_alloc(void *ctx, size_t size);
+ASX_API void *asx_platform_huge_realloc(void *ctx, void *ptr, size_t size);
+ASX_API void  asx_platform_huge_free(void *ctx, void *ptr);
+
+/* Point hooks' allocator at arena. */
+ASX_API asx_status asx_platform_huge_arena_install(asx_platform_huge_arena *arena,
+                                                   asx_runtime_hooks *hooks);
+
+#define ASX_PLATFORM_NUMA_MAX_NODES 64u
+
+/* Prefer NUMA node for the arena's pages (mbind MPOL_PREFERRED on
+ * Linux) and move pages already touched there. Only memory the arena
+ * hands out is placed: a bound context's live state stays in the
+ * module globals, wherever the process put them.
+ * ASX_E_INVALID_ARGUMENT for NULL or a node the system does not have,
+ * ASX_E_INVALID_STATE for a closed arena, ASX_E_HOOK_MISSING where
+ * there is no NUMA policy support. */
+ASX_API asx_status asx_platform_huge_arena_bind_node(asx_platform_huge_arena *arena,
+                                                     uint32_t node);
+
+/* Readiness bits for asx_platform_reactor interest and results */
+enum {
+    ASX_PLATFORM_IO_READ   = 1u,
+    ASX_PLATFORM_IO_WRITE  = 2u,
+    ASX_PLATFORM_IO_HANGUP = 4u,  /* result only */
+    ASX_PLATFORM_IO_ERROR  = 8u   /* result only */
+};
+
+/* Ready entries one reactor wait can report */
+#define ASX_PLATFORM_REACTOR_EVENTS 64u
+
+typedef struct {
+    uint64_t token;   /* as registered */
+    uint32_t events;  /* ASX_PLATFORM_IO_* */
+} asx_platform_io_event;
+
+/*
+ * Readiness reactor on epoll (Linux) or kqueue (BSD, macOS), driven
+ * through the reactor wait hook. Caller-owned; ready[0..ready_count)
+ * holds the results of the last wait. kqueue reports read and write
+ * readiness of one fd as separate entries and keeps pointer-sized
+ * tokens. Treat fd as private.
+ */
+typedef struct {
+    int fd;
+    uint32_t ready_count;
+    asx_platform_io_event ready[ASX_PLATFORM_REACTOR_EVENTS];
+} asx_platform_reactor;
+
+/* Create the kernel queue. ASX_E_RESOURCE_EXHAUSTED if it cannot be
+ * created, ASX_E_HOOK_MISSING on hosts with neither epoll nor kqueue. */
+ASX_API asx_status asx_platform_reactor_open(asx_platform_reactor *r);
+
+/* Close the kernel queue; registered fds are left open. */
+ASX_API void asx_platform_reactor_close(asx_platform_reactor *r);
+
+/* Watch fd for interest (ASX_PLATFORM_IO_READ/WRITE), reporting token.
+ * ASX_E_ALREADY_EXISTS if fd is registered (epoll). */
+ASX_API asx_status asx_platform_reactor_add(asx_platform_reactor *r, int fd,
+                                            uint32_t interest, uint64_t token);
+
+/* Replace the interest and token of a registered fd.
+ * ASX_E_NOT_FOUND if fd is not registered (epoll). */
+ASX_API asx_status asx_platform_reactor_modify(asx_platform_reactor *r, int fd,
+                                               uint32_t interest, uint64_t token);
+
+/* Stop watching fd. ASX_E_NOT_FOUND if it is not registered (epoll). */
+ASX_API asx_status asx_platform_reactor_remove(asx_platform_reactor *r, int fd);
+
+/* Reactor wait hook (asx_reactor_wait_fn); ctx is the reactor. Blocks
+ * up to timeout_ms (UINT32_MAX: indefinitely) and fills r->ready. An
+ * interrupted wait reports zero ready entries. */
+ASX_API asx_status asx_platform_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                             uint32_t *ready_count);
+
+/* Point hooks' reactor wait hook at r. */
+ASX_API asx_status asx_platform_reactor_install(asx_platform_reactor *r,
+                                                asx_runtime_hooks *hooks);
+
+/*
+ * An fd registered with a reactor for task wakeups, edge-triggered and
+ * one-shot: arming read or write interest parks one task until the
+ * next readiness edge in that direction, and the wait reporting it
+ * disarms that direction and wakes that task only. A task re-arms
+ * after draining the fd to EAGAIN. Its address is the reactor token;
+ * caller-owned and must stay put while registered. events holds the
+ * readiness last reported; other members are private.
+ */
+typedef struct {
+    asx_platform_reactor *reactor;
+    int fd;
+    uint32_t armed;      /* ASX_PLATFORM_IO_READ/WRITE awaiting an edge */
+    uint32_t events;     /* ASX_PLATFORM_IO_* last reported */
+    asx_task_id reader;  /* parked for read (ASX_INVALID_ID: none) */
+    asx_task_id writer;  /* parked for write (ASX_INVALID_ID: none) */
+} asx_platform_io_source;
+
+/* Register fd with r, nothing armed. ASX_E_INVALID_ARGUMENT for NULL
+ * or a negative fd, else as asx_platform_reactor_add. */
+ASX_API asx_status asx_platform_io_register(asx_platform_reactor *r,
+                                            asx_platform_io_source *src,
+                                            int fd);
+
+/* Arm one direction (ASX_PLATFORM_IO_READ or WRITE) and park task on
+ * it, deferred to the end of its poll when called from there; readiness
+ * already pending is reported by the next wait. ASX_E_INVALID_ARGUMENT
+ * for NULL, an unregistered source or anything but one direction,
+ * ASX_E_INVALID_STATE while another parked task holds that direction. */
+ASX_API ASX_MUST_USE asx_status asx_platform_io_arm(asx_platform_io_source *src,
+                                                    asx_task_id task,
+                                                    uint32_t interest);
+
+/* Stop watching the fd, waking any armed task so it sees the fd gone.
+ * The fd is left open. */
+ASX_API asx_status asx_platform_io_deregister(asx_platform_io_source *src);
+
+/* Reactor wait hook (asx_reactor_wait_fn); ctx is a reactor whose fds
+ * are all io sources. Waits as asx_platform_reactor_wait, then wakes
+ * the task armed for each direction reported; a hangup or error wakes
+ * both. Reports the ready entries. */
+ASX_API asx_status asx_platform_io_wait(void *ctx, uint32_t timeout_ms,
+                                        uint32_t *ready_count);
+
+/* Point hooks' reactor wait hook at r as an io-source reactor. */
+ASX_API asx_status asx_platform_io_install(asx_platform_reactor *r,
+                                           asx_runtime_hooks *hooks);
+
+/* One queued or in-flight io_uring read/write. Caller-owned; must stay
+ * valid until done is set. Its address is the ASX_PARK_IO key. */
+typedef struct {
+    asx_task_id task;  /* woken on completion (ASX_INVALID_ID: none) */
+    int32_t result;    /* bytes transferred or -errno, once done */
+    uint32_t done;
+} asx_platform_uring_op;
+
+/*
+ * io_uring completion backend (Linux 5.11+), driven through the
+ * reactor wait hook. Reads and writes queue without a syscall; each
+ * wait submits the whole batch and reaps every completion in one
+ * io_uring_enter, waking each op's task. Deterministic builds keep
+ * replaying through ghost_wait_fn. Caller-owned; members are private.
+ */
+typedef struct {
+    int fd;
+    uint32_t sq_entries;
+    uint32_t cq_entries;
+    uint32_t sq_mask;
+    uint32_t cq_mask;
+    uint32_t queued;    /* in the SQ ring, not yet submitted */
+    uint32_t inflight;  /* submitted, not yet reaped */
+    uint32_t *sq_head;
+    uint32_t *sq_tail;
+    uint32_t *sq_array;
+    uint32_t *cq_head;
+    uint32_t *cq_tail;
+    void *cqes;
+    void *sqes;
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    size_t sqes_size;
+    const void *fixed_pool;  /* registered buffer pool, or NULL */
+} asx_platform_uring;
+
+/* Set up a ring of entries submissions (1..4096). ASX_E_HOOK_MISSING
+ * where io_uring is unavailable (non-Linux, disabled, pre-5.11),
+ * ASX_E_RESOURCE_EXHAUSTED if the ring cannot be created or mapped. */
+ASX_API asx_status asx_platform_uring_open(asx_platform_uring *u,
+                                           uint32_t entries);
+
+/* Tear down the ring. Ops still in flight are abandoned. */
+ASX_API void asx_platform_uring_close(asx_platform_uring *u);
+
+/* Queue a read of up to len bytes from fd into buf at offset
+ * (UINT64_MAX: the current position, as for sockets and pipes) and
+ * park task on it, deferred to the end of its poll when called from
+ * there. ASX_E_RESOURCE_EXHAUSTED while the ring is full. */
+ASX_API asx_status asx_platform_uring_read(asx_platform_uring *u,
+                                           asx_platform_uring_op *op,
+                                           asx_task_id task, int fd,
+                                           void *buf, uint32_t len,
+                                           uint64_t offset);
+
+/* Queue a write of len bytes from buf; otherwise as
+ * asx_platform_uring_read. */
+ASX_API asx_status asx_platform_uring_write(asx_platform_uring *u,
+                                            asx_platform_uring_op *op,
+                                            asx_task_id task, int fd,
+                                            const void *buf, uint32_t len,
+                                            uint64_t offset);
+
+struct asx_buffer_pool;
+
+/* Register the storage of pool (asx/runtime/buffer_pool.h) as the
+ * ring's fixed buffer, pinned once for every read_fixed. One pool per
+ * ring, until the ring is closed; the pool must outlive it.
+ * ASX_E_ALREADY_EXISTS if a pool is registered, ASX_E_RESOURCE_EXHAUSTED
+ * if the kernel refuses (e.g. RLIMIT_MEMLOCK). */
+ASX_API asx_status asx_platform_uring_register_pool(asx_platform_uring *u,
+                                                    const struct asx_buffer_pool *pool);
+
+/* Queue an IORING_OP_READ_FIXED of up to the buffer size from fd into
+ * the held pool buffer handle; otherwise as asx_platform_uring_read.
+ * Set the buffer's length from op->result once done.
+ * ASX_E_INVALID_STATE if handle is not held or pool is not the
+ * registered one. */
+ASX_API asx_status asx_platform_uring_read_fixed(asx_platform_uring *u,
+                                                 asx_platform_uring_op *op,
+                                                 asx_task_id task, int fd,
+                                                 const struct asx_buffer_pool *pool,
+                                                 uint64_t handle,
+                                                 uint64_t offset);
+
+/* Reactor wait hook (asx_reactor_wait_fn); ctx is the ring. Submits
+ * queued ops, waits up to timeout_ms (UINT32_MAX: indefinitely) for a
+ * first completion when none is ready, and reports completions reaped. */
+ASX_API asx_status asx_platform_uring_wait(void *ctx, uint32_t timeout_ms,
+                                           uint32_t *ready_count);
+
+/* File hook (asx_file_submit_fn); ctx is the ring. Queues op as an
+ * io_uring write or fsync; the wait that reaps it completes op.
+ * ASX_E_RESOURCE_EXHAUSTED while the ring is full. */
+ASX_API asx_status asx_platform_uring_file_submit(void *ctx, asx_file_op *op);
+
+/* Point hooks' reactor wait and file hooks at u. */
+ASX_API asx_status asx_platform_uring_install(asx_platform_uring *u,
+                                              asx_runtime_hooks *hooks);
+
+/* File hook (asx_file_submit_fn) on a helper thread, for systems
+ * without io_uring. The thread, started on first use, runs ops in
+ * submission order with pwrite (write at UINT64_MAX) or fsync. ctx is
+ * unused. ASX_E_RESOURCE_EXHAUSTED if the thread cannot be started. */
+ASX_API asx_status asx_platform_file_thread_submit(void *ctx, asx_file_op *op);
+
+/* Reactor wait hook (asx_reactor_wait_fn) completing the helper
+ * thread's finished ops on the calling (scheduler) thread. While ops
+ * are in flight and none has finished, waits up to timeout_ms
+ * (UINT32_MAX: indefinitely) for one. Reports ops completed. */
+ASX_API asx_status asx_platform_file_thread_wait(void *ctx, uint32_t timeout_ms,
+                                                 uint32_t *ready_count);
+
+/* Point hooks' reactor wait and file hooks at the helper thread. */
+ASX_API asx_status asx_platform_file_thread_install(asx_runtime_hooks *hooks);
+#endif
+
+#if defined(ASX_PROFILE_WIN32)
+/* Completions one IOCP wait can reap */
+#define ASX_PLATFORM_IOCP_ENTRIES 64u
+
+/* One overlapped read/write. Caller-owned; must stay valid until done
+ * is set. Its address is the ASX_PARK_IO key. */
+typedef struct {
+    uint64_t overlapped[4]; /* OVERLAPPED storage; keep first */
+    void *handle;
+    asx_task_id task;       /* woken on completion (ASX_INVALID_ID: none) */
+    uint32_t domain;        /* task's affinity domain at issue */
+    int32_t result;         /* bytes transferred or -GetLastError(), once done */
+    uint32_t done;
+} asx_platform_iocp_op;
+
+/*
+ * I/O completion port backend, driven through the reactor wait hook.
+ * Reads and writes are issued overlapped on associated handles; each
+ * wait reaps up to ASX_PLATFORM_IOCP_ENTRIES completions with one
+ * GetQueuedCompletionStatusEx and wakes each op's task on the calling
+ * (scheduler) thread, where the parallel scheduler places it by lane.
+ * Deterministic builds keep replaying through ghost_wait_fn.
+ * Caller-owned; members are private.
+ */
+typedef struct {
+    void *port;
+    uint32_t inflight;
+    uint32_t ready_count;  /* completions reaped by the last wait */
+} asx_platform_iocp;
+
+/* Create the port; threads is the kernel concurrency hint (0: one per
+ * CPU). ASX_E_RESOURCE_EXHAUSTED if it cannot be created. */
+ASX_API asx_status asx_platform_iocp_open(asx_platform_iocp *io,
+                                          uint32_t threads);
+
+/* Close the port. Ops still in flight are abandoned. */
+ASX_API void asx_platform_iocp_close(asx_platform_iocp *io);
+
+/* Associate a handle opened with FILE_FLAG_OVERLAPPED (or a socket)
+ * with the port. ASX_E_ALREADY_EXISTS if it belongs to a port. */
+ASX_API asx_status asx_platform_iocp_associate(asx_platform_iocp *io,
+                                               void *handle);
+
+/* Issue an overlapped read of up to len bytes at offset and park task
+ * on it, deferred to the end of its poll when called from there.
+ * ASX_E_INVALID_STATE if the transfer could not be started. */
+ASX_API asx_status asx_platform_iocp_read(asx_platform_iocp *io,
+                                          asx_platform_iocp_op *op,
+                                          asx_task_id task, void *handle,
+                                          void *buf, uint32_t len,
+                                          uint64_t offset);
+
+/* Issue an overlapped write; otherwise as asx_platform_iocp_read. */
+ASX_API asx_status asx_platform_iocp_write(asx_platform_iocp *io,
+                                           asx_platform_iocp_op *op,
+                                           asx_task_id task, void *handle,
+                                           const void *buf, uint32_t len,
+                                           uint64_t offset);
+
+/* Reactor wait hook (asx_reactor_wait_fn); ctx is the port. Waits up
+ * to timeout_ms (UINT32_MAX: indefinitely) and reports completions. */
+ASX_API asx_status asx_platform_iocp_wait(void *ctx, uint32_t timeout_ms,
+                                          uint32_t *ready_count);
+
+/* Point hooks' reactor wait hook at io. */
+ASX_API asx_status asx_platform_iocp_install(asx_platform_iocp *io,
+                                             asx_runtime_hooks *hooks);
+#endif
+
+#if defined(ASX_PROFILE_FREESTANDING)
+/* -------------------------------------------------------------------
+ * Freestanding adapter (src/platform/freestanding/hooks.c)
+ * ------------------------------------------------------------------- */
+
+/* Fixed-block pool over a caller-supplied static region. Every block
+ * has the same capacity; alloc and free are O(1). Members are private. */
+typedef struct {
+    uint8_t *base;
+    size_t   block_size;
+    uint32_t block_count;
+    uint32_t free_count;     /* blocks currently available */
+    void    *free_head;
+} asx_platform_pool;
+
+/* Carve region into blocks of block_size bytes (rounded up to 8-byte
+ * alignment). ASX_E_INVALID_ARGUMENT if not even one block fits. */
+ASX_API asx_status asx_platform_pool_init(asx_platform_pool *pool,
+                                          void *region, size_t region_size,
+                                          size_t block_size);
+
+/* Allocator hooks; ctx is the pool. alloc returns NULL for requests
+ * larger than a block or when the pool is empty; realloc succeeds only
+ * in place. Not interrupt-safe. */
+ASX_API void *asx_platform_pool_alloc(void *ctx, size_t size);
+ASX_API void *asx_platform_pool_realloc(void *ctx, void *ptr, size_t size);
+ASX_API void  asx_platform_pool_free(void *ctx, void *ptr);
+
+/* Point hooks' allocator at pool. */
+ASX_API asx_status asx_platform_pool_install(asx_platform_pool *pool,
+                                             asx_runtime_hooks *hooks);
+
+/* Read the free-running hardware tick counter. */
+typedef uint64_t (*asx_platform_tick_read_fn)(void *ctx);
+
+/* Monotonic clock over a tick counter of 1..64 bits, extended across
+ * wraps. Members are private. */
+typedef struct {
+    asx_platform_tick_read_fn read;
+    void    *read_ctx;
+    uint64_t hz;
+    uint64_t counter_mask;
+    uint64_t last_raw;
+    uint64_t wrap_ticks;     /* ticks accumulated by past wraps */
+} asx_platform_tick_clock;
+
+/* Bind clock to a counter ticking at hz with counter_bits bits. */
+ASX_API asx_status asx_platform_tick_clock_init(asx_platform_tick_clock *clock,
+                                                asx_platform_tick_read_fn read,
+                                                void *read_ctx, uint64_t hz,
+                                                uint32_t counter_bits);
+
+/* Clock hook (asx_clock_now_ns_fn); ctx is the clock. Must run at least
+ * once per counter wrap period or a wrap goes unnoticed. */
+ASX_API asx_time asx_platform_tick_now_ns(void *ctx);
+
+/* Point hooks' clock at clock. */
+ASX_API asx_status asx_platform_tick_clock_install(asx_platform_tick_clock *clock,
+                                                   asx_runtime_hooks *hooks);
+
+#define ASX_PLATFORM_WFI_LINES 32u
+
+/* Sleep until an interrupt; returns early when *pending is nonzero. */
+typedef void (*asx_platform_idle_fn)(void *ctx, volatile uint32_t *pending);
+
+/* Reactor that sleeps the core until an interrupt handler signals one
+ * of ASX_PLATFORM_WFI_LINES lines. Members are private. */
+typedef struct {
+    volatile uint32_t pending;            /* lines signalled since last wait */
+    asx_platform_idle_fn idle;
+    void *idle_ctx;
+    asx_platform_tick_clock *clock;       /* bounds timeouts; may be NULL */
+    uint32_t signals[ASX_PLATFORM_WFI_LINES];
+} asx_platform_wfi_reactor;
+
+/* Default idle hook: WFI with interrupts masked across the pending
+ * check (ARMv6-M/v7-M/v8-M, RISC-V); a plain poll elsewhere. */
+ASX_API void asx_platform_wfi_idle(void *ctx, volatile uint32_t *pending);
+
+/* Reset r. idle NULL selects asx_platform_wfi_idle. Without a clock a
+ * bounded wait ends at the first interrupt. */
+ASX_API asx_status asx_platform_wfi_init(asx_platform_wfi_reactor *r,
+                                         asx_platform_idle_fn idle,
+                                         void *idle_ctx,
+                                         asx_platform_tick_clock *clock);
+
+/* Mark line ready. The only call safe from an interrupt handler. */
+ASX_API void asx_platform_wfi_signal(asx_platform_wfi_reactor *r,
+                                     uint32_t line);
+
+/* Park key for line, for asx_task_park_on_io. */
+ASX_API uint64_t asx_platform_wfi_key(const asx_platform_wfi_reactor *r,
+                                      uint32_t line);
+
+/* Reactor wait hook (asx_reactor_wait_fn); ctx is the reactor. Sleeps
+ * up to timeout_ms (UINT32_MAX: indefinitely) unless a line is already
+ * pending, then wakes the tasks parked on each signalled line. */
+ASX_API asx_status asx_platform_wfi_wait(void *ctx, uint32_t timeout_ms,
+                                         uint32_t *ready_count);
+
+/* Point hooks' reactor wait hook at r. */
+ASX_API asx_status asx_platform_wfi_install(asx_platform_wfi_reactor *r,
+                                            asx_runtime_hooks *hooks);
+#endif
 
 #endif /* ASX_CONFIG_H */
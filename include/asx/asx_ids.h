@@ -3,6 +3,8 @@
  *
  * All externally visible runtime entities use opaque generation-safe handles.
  * Handle format: [16-bit type_tag | 16-bit state_mask | 32-bit arena_index]
+ * by default, or with ASX_HANDLE_WIDE=1
+ *                [8-bit type_tag | 8-bit state_mask | 48-bit arena_index]
  *
  * Handle validation requires:
  *   - type tag match
@@ -21,13 +23,44 @@
 #include <stdint.h>
 #include <asx/asx_export.h>
 
+/* ------------------------------------------------------------------ */
+/* Handle layout                                                      */
+/* ------------------------------------------------------------------ */
+
+/*
+ * The arena index splits into [generation | slot_index], 16 bits each
+ * by default. ASX_HANDLE_WIDE=1 widens both to 24 bits for large
+ * growable arenas (16M live entities per type, 16M reuses of a slot
+ * before its generation wraps) and narrows the type tag and state mask
+ * to 8 bits: there are six type tags and no lifecycle has more than
+ * six states. The layout is fixed at build time; handles are not
+ * portable between the two.
+ */
+#ifndef ASX_HANDLE_WIDE
+#define ASX_HANDLE_WIDE 0
+#endif
+
+/* ASX_HANDLE_SLOT_LIMIT: slots per entity type (usable in #if) */
+#if ASX_HANDLE_WIDE
+#define ASX_HANDLE_FIELD_BITS 24u
+#define ASX_HANDLE_SLOT_LIMIT 16777216u
+typedef uint32_t asx_generation;
+#else
+#define ASX_HANDLE_FIELD_BITS 16u
+#define ASX_HANDLE_SLOT_LIMIT 65536u
+typedef uint16_t asx_generation;
+#endif
+
+/* Mask of the slot and generation fields */
+#define ASX_HANDLE_FIELD_MASK (ASX_HANDLE_SLOT_LIMIT - 1u)
+
 /* ------------------------------------------------------------------ */
 /* Opaque handle types                                                */
 /* ------------------------------------------------------------------ */
 
 /*
- * Internal structure: [type_tag:16 | state_mask:16 | arena_index:32].
- * Users must not inspect or construct these directly.
+ * Internal structure: [type_tag:16 | state_mask:16 | arena_index:32]
+ * (see ASX_HANDLE_WIDE above). Users must not inspect or construct these directly.
  * Use asx_handle_* helpers for all operations.
  */
 typedef uint64_t asx_region_id;
@@ -55,13 +88,37 @@ typedef uint64_t asx_channel_id;
 /* Handle packing/unpacking helpers                                   */
 /* ------------------------------------------------------------------ */
 
+#if ASX_HANDLE_WIDE
+#define ASX_HANDLE_INDEX_MASK UINT64_C(0xFFFFFFFFFFFF)
+
 static inline uint64_t asx_handle_pack(uint16_t type_tag,
                                        uint16_t state_mask,
-                                       uint32_t index)
+                                       uint64_t index)
+{
+    return ((uint64_t)(type_tag & 0xFFu) << 56)
+         | ((uint64_t)(state_mask & 0xFFu) << 48)
+         | (index & ASX_HANDLE_INDEX_MASK);
+}
+
+static inline uint16_t asx_handle_type_tag(uint64_t h)
+{
+    return (uint16_t)(h >> 56);
+}
+
+static inline uint16_t asx_handle_state_mask(uint64_t h)
+{
+    return (uint16_t)((h >> 48) & 0xFF);
+}
+#else
+#define ASX_HANDLE_INDEX_MASK UINT64_C(0xFFFFFFFF)
+
+static inline uint64_t asx_handle_pack(uint16_t type_tag,
+                                       uint16_t state_mask,
+                                       uint64_t index)
 {
     return ((uint64_t)type_tag << 48)
          | ((uint64_t)state_mask << 32)
-         | (uint64_t)index;
+         | (index & ASX_HANDLE_INDEX_MASK);
 }
 
 static inline uint16_t asx_handle_type_tag(uint64_t h)
@@ -73,10 +130,11 @@ static inline uint16_t asx_handle_state_mask(uint64_t h)
 {
     return (uint16_t)((h >> 32) & 0xFFFF);
 }
+#endif
 
-static inline uint32_t asx_handle_index(uint64_t h)
+static inline uint64_t asx_handle_index(uint64_t h)
 {
-    return (uint32_t)(h & 0xFFFFFFFF);
+    return h & ASX_HANDLE_INDEX_MASK;
 }
 
 static inline int asx_handle_is_valid(uint64_t h)
@@ -93,26 +151,34 @@ static inline int asx_handle_state_allowed(uint64_t h, uint16_t allowed_mask)
 /*
  * Generation-safe handle decomposition.
  *
- * The 32-bit index field is a composite: [generation:16 | slot_index:16].
- * This enables stale-handle detection: when a slot is recycled, its
- * generation counter increments. Old handles carry the old generation
- * and will fail validation against the new slot generation.
+ * The index field is a composite: [generation | slot_index], each
+ * ASX_HANDLE_FIELD_BITS wide. This enables stale-handle detection:
+ * when a slot is recycled, its generation counter advances (see
+ * asx_generation_next). Old handles carry the old generation and will
+ * fail validation against the new slot generation.
  */
-static inline uint16_t asx_handle_slot(uint64_t h)
+static inline uint32_t asx_handle_slot(uint64_t h)
 {
-    return (uint16_t)(h & 0xFFFF);
+    return (uint32_t)(h & ASX_HANDLE_FIELD_MASK);
 }
 
-static inline uint16_t asx_handle_generation(uint64_t h)
+static inline asx_generation asx_handle_generation(uint64_t h)
 {
-    return (uint16_t)((h >> 16) & 0xFFFF);
+    return (asx_generation)((h >> ASX_HANDLE_FIELD_BITS) & ASX_HANDLE_FIELD_MASK);
 }
 
 /* Pack a composite index from generation + slot index */
-static inline uint32_t asx_handle_pack_index(uint16_t generation,
-                                              uint16_t slot_index)
+static inline uint64_t asx_handle_pack_index(asx_generation generation,
+                                             uint32_t slot_index)
+{
+    return ((uint64_t)(generation & ASX_HANDLE_FIELD_MASK) << ASX_HANDLE_FIELD_BITS)
+         | (uint64_t)(slot_index & ASX_HANDLE_FIELD_MASK);
+}
+
+/* The generation a recycled slot takes, wrapping within the field */
+static inline asx_generation asx_generation_next(asx_generation generation)
 {
-    return ((uint32_t)generation << 16) | (uint32_t)slot_index;
+    return (asx_generation)((generation + 1u) & ASX_HANDLE_FIELD_MASK);
 }
 
 /* ------------------------------------------------------------------ */
@@ -118,8 +118,21 @@ static inline int asx_is_error(asx_status s) {
 /* Deterministic task-local error ledger (zero-allocation)            */
 /* ------------------------------------------------------------------ */
 
+/* Entries kept per task (at most 255). */
 #define ASX_ERROR_LEDGER_DEPTH      16u
-#define ASX_ERROR_LEDGER_TASK_SLOTS 64u
+
+/* Task arena slots with a ledger of their own; tasks in higher slots
+ * share one fallback ledger. A slot costs a 16-byte header. */
+#ifndef ASX_ERROR_LEDGER_TASK_SLOTS
+#define ASX_ERROR_LEDGER_TASK_SLOTS 256u
+#endif
+
+/* Entry rings shared by the slots, taken on a task's first error. When
+ * every ring is in use the earliest-taken one is reclaimed and its
+ * task's ledger reads as empty. */
+#ifndef ASX_ERROR_LEDGER_RINGS
+#define ASX_ERROR_LEDGER_RINGS      16u
+#endif
 
 typedef struct asx_error_ledger_entry {
     asx_task_id task_id;
@@ -133,7 +146,8 @@ typedef struct asx_error_ledger_entry {
 /* Reset all ledger state. Primarily for tests and deterministic replay setup. */
 ASX_API void asx_error_ledger_reset(void);
 
-/* Bind the implicit task context used by ASX_TRY(). */
+/* Bind the implicit task context used by ASX_TRY(). The binding is
+ * worker-local (ASX_THREAD_LOCAL): each worker thread has its own. */
 ASX_API void asx_error_ledger_bind_task(asx_task_id task_id);
 
 /* Return the currently bound task id (ASX_INVALID_ID if unbound). */
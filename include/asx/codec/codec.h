@@ -19,10 +19,26 @@
 extern "C" {
 #endif
 
+/* Caller-supplied bump arena for codec allocations.
+ *
+ * While an arena is active (asx_codec_set_arena), buffer growth and
+ * decoded fixture strings are carved from it instead of the allocator
+ * hooks, so steady-state encode/decode makes no heap calls. Codec
+ * frees of arena memory are no-ops (the most recent block is popped),
+ * and one asx_codec_arena_reset releases everything at once. Exhaustion
+ * surfaces as ASX_E_RESOURCE_EXHAUSTED. */
+typedef struct asx_codec_arena {
+    uint8_t *base;
+    size_t cap;
+    size_t used;
+    size_t last;   /* offset of the most recent block */
+} asx_codec_arena;
+
 typedef struct {
     char *data;
     size_t len;
     size_t cap;
+    asx_codec_arena *arena;  /* owner of data; NULL = allocator hooks */
 } asx_codec_buffer;
 
 typedef struct {
@@ -53,6 +69,69 @@ typedef struct {
     asx_codec_slice capture_run_id;
 } asx_codec_bin_fixture_view;
 
+/* Fixture field ids. Values are the binary frame tags. */
+typedef enum {
+    ASX_CODEC_FIELD_SCENARIO_ID                  = 1,
+    ASX_CODEC_FIELD_FIXTURE_SCHEMA_VERSION       = 2,
+    ASX_CODEC_FIELD_SCENARIO_DSL_VERSION         = 3,
+    ASX_CODEC_FIELD_PROFILE                      = 4,
+    ASX_CODEC_FIELD_CODEC                        = 5,   /* varint */
+    ASX_CODEC_FIELD_SEED                         = 6,   /* varint */
+    ASX_CODEC_FIELD_INPUT_JSON                   = 7,
+    ASX_CODEC_FIELD_EXPECTED_EVENTS_JSON         = 8,
+    ASX_CODEC_FIELD_EXPECTED_FINAL_SNAPSHOT_JSON = 9,
+    ASX_CODEC_FIELD_EXPECTED_ERROR_CODES_JSON    = 10,
+    ASX_CODEC_FIELD_SEMANTIC_DIGEST              = 11,
+    ASX_CODEC_FIELD_RUST_BASELINE_COMMIT         = 12,
+    ASX_CODEC_FIELD_RUST_TOOLCHAIN_COMMIT_HASH   = 13,
+    ASX_CODEC_FIELD_RUST_TOOLCHAIN_RELEASE       = 14,
+    ASX_CODEC_FIELD_RUST_TOOLCHAIN_HOST          = 15,
+    ASX_CODEC_FIELD_CARGO_LOCK_SHA256            = 16,
+    ASX_CODEC_FIELD_CAPTURE_RUN_ID               = 17
+} asx_codec_field;
+
+/* One completed field from the streaming decoder. Byte fields are
+ * NUL-terminated and only valid for the duration of the callback. */
+typedef struct {
+    asx_codec_field field;
+    uint64_t value;           /* CODEC and SEED */
+    asx_codec_slice bytes;    /* every other field */
+} asx_codec_stream_field;
+
+/* Field sink; a non-OK return aborts the stream with that status. */
+typedef asx_status (*asx_codec_stream_field_fn)(void *ctx,
+                                                const asx_codec_stream_field *field);
+
+/* Resumable push decoder for binary fixture frames.
+ *
+ * Bytes are fed in chunks of any size. Each field is checked as it
+ * completes (the same rules as asx_codec_decode_fixture_bin_view) and
+ * handed to the sink, so peak memory is the caller's field buffer:
+ * the largest field plus one byte. Fields arrive before the checksum
+ * footer is verified; only ASX_OK from asx_codec_bin_stream_finish
+ * confirms the frame. Unknown tags are skipped without buffering.
+ * Treat the members as private. */
+typedef struct {
+    asx_codec_stream_field_fn on_field;
+    void *ctx;
+    char *field_buf;
+    size_t field_cap;
+    asx_status error;            /* sticky once set */
+    uint8_t state;
+    uint8_t flags;
+    uint8_t wire;
+    uint8_t version;
+    uint8_t varint_len;
+    uint8_t header[11];
+    uint32_t tag;
+    uint32_t seen;
+    uint32_t checksum;
+    uint32_t payload_left;
+    uint64_t varint;
+    size_t have;
+    size_t need;
+} asx_codec_bin_stream;
+
 typedef struct asx_codec_vtable {
     asx_codec_kind codec;
     asx_status (*encode_fixture)(const asx_canonical_fixture *fixture,
@@ -62,6 +141,21 @@ typedef struct asx_codec_vtable {
                                  asx_canonical_fixture *out_fixture);
 } asx_codec_vtable;
 
+/* Bind an arena to caller storage (cap bytes at mem). */
+ASX_API void asx_codec_arena_init(asx_codec_arena *arena, void *mem, size_t cap);
+
+/* Release every block carved from the arena. Buffers and fixtures
+ * that still point into it must not be used afterwards. */
+ASX_API void asx_codec_arena_reset(asx_codec_arena *arena);
+
+/* Route subsequent codec allocations through arena (NULL restores the
+ * runtime allocator hooks). Buffers keep the owner they first grew
+ * from; decoded fixtures record the arena that backs their strings. */
+ASX_API void asx_codec_set_arena(asx_codec_arena *arena);
+
+/* Arena currently receiving codec allocations (NULL when none). */
+ASX_API asx_codec_arena *asx_codec_active_arena(void);
+
 /* Buffer lifecycle helpers */
 ASX_API void asx_codec_buffer_init(asx_codec_buffer *buf);
 ASX_API void asx_codec_buffer_reset(asx_codec_buffer *buf);
@@ -91,12 +185,40 @@ ASX_API ASX_MUST_USE asx_status asx_codec_decode_fixture(asx_codec_kind codec,
                                                          size_t payload_len,
                                                          asx_canonical_fixture *out_fixture);
 
+/* Encode count fixtures back to back into out_payloads, replacing its
+ * contents and growing it once per sweep rather than once per fixture.
+ * offsets (count + 1 entries) receives the layout: payload i spans
+ * [offsets[i], offsets[i + 1]). All or nothing: on failure
+ * out_payloads is left empty and the first error is returned. */
+ASX_API ASX_MUST_USE asx_status asx_codec_encode_fixtures(asx_codec_kind codec,
+                                                          const asx_canonical_fixture *fixtures,
+                                                          size_t count,
+                                                          asx_codec_buffer *out_payloads,
+                                                          size_t *offsets);
+
+/* Decode count payloads laid out as by asx_codec_encode_fixtures into
+ * out_fixtures, which must be initialized and are reset first. All or
+ * nothing: on failure every out_fixtures entry is left reset. */
+ASX_API ASX_MUST_USE asx_status asx_codec_decode_fixtures(asx_codec_kind codec,
+                                                          const void *payloads,
+                                                          const size_t *offsets,
+                                                          size_t count,
+                                                          asx_canonical_fixture *out_fixtures);
+
 /* JSON baseline helpers (codec vtable backing functions) */
 ASX_API ASX_MUST_USE asx_status asx_codec_encode_fixture_json(const asx_canonical_fixture *fixture,
                                                               asx_codec_buffer *out_json);
 ASX_API ASX_MUST_USE asx_status asx_codec_decode_fixture_json(const char *json,
                                                               asx_canonical_fixture *out_fixture);
 
+/* Frame schema version written by the binary encoder: V1 (default,
+ * FNV-1a footer) or V2 (CRC32C footer). Decoders accept both and check
+ * each frame under its own version. */
+ASX_API ASX_MUST_USE asx_status asx_codec_set_bin_frame_version(uint8_t version);
+
+/* Frame schema version the binary encoder currently writes. */
+ASX_API uint8_t asx_codec_bin_frame_version(void);
+
 /* Binary decode view helper for safe zero-copy payload inspection. */
 ASX_API void asx_codec_bin_fixture_view_init(asx_codec_bin_fixture_view *view);
 ASX_API ASX_MUST_USE asx_status asx_codec_decode_fixture_bin_view(
@@ -104,6 +226,41 @@ ASX_API ASX_MUST_USE asx_status asx_codec_decode_fixture_bin_view(
     size_t payload_len,
     asx_codec_bin_fixture_view *out_view);
 
+/* Start a streaming binary decode. field_buf (field_cap bytes) holds
+ * one field at a time; a longer field fails the stream with
+ * ASX_E_RESOURCE_EXHAUSTED. */
+ASX_API void asx_codec_bin_stream_init(asx_codec_bin_stream *stream,
+                                       void *field_buf,
+                                       size_t field_cap,
+                                       asx_codec_stream_field_fn on_field,
+                                       void *ctx);
+
+/* Feed the next len bytes of the frame. Bytes past the end of the
+ * frame are rejected. Returns the stream's sticky error, if any. */
+ASX_API ASX_MUST_USE asx_status asx_codec_bin_stream_feed(asx_codec_bin_stream *stream,
+                                                          const void *data,
+                                                          size_t len);
+
+/* Close the stream: ASX_OK only when a complete frame with every
+ * required field and a matching checksum footer has been fed. */
+ASX_API ASX_MUST_USE asx_status asx_codec_bin_stream_finish(asx_codec_bin_stream *stream);
+
+/* Borrowed JSON decode: fills the same view as the binary path with
+ * slices into json, which must outlive the view. Raw JSON members are
+ * the value text verbatim; string members are the bytes between the
+ * quotes and may still hold escapes. Frame fields stay zero. Applies
+ * asx_codec_decode_fixture_json's schema checks without allocating. */
+ASX_API ASX_MUST_USE asx_status asx_codec_decode_fixture_json_view(
+    const char *json,
+    asx_codec_bin_fixture_view *out_view);
+
+/* Resolve a JSON view string slice to its text. Slices without escapes
+ * come back unchanged; otherwise they are unescaped into scratch
+ * (replacing its contents) and out_text points there. */
+ASX_API ASX_MUST_USE asx_status asx_codec_json_view_text(asx_codec_slice raw,
+                                                         asx_codec_buffer *scratch,
+                                                         asx_codec_slice *out_text);
+
 /* Build deterministic replay key from canonical semantic fields. */
 ASX_API ASX_MUST_USE asx_status asx_codec_fixture_replay_key(const asx_canonical_fixture *fixture,
                                                              asx_codec_buffer *out_key);
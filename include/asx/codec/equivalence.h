@@ -63,6 +63,61 @@ ASX_API ASX_MUST_USE asx_status asx_codec_fixture_semantic_key(
     const asx_canonical_fixture *fixture,
     asx_codec_buffer *out_key);
 
+/* Seed of asx_codec_fixture_semantic_hash. */
+#define ASX_CODEC_SEMANTIC_HASH_SEED 0x6a09e667f3bcc908ULL
+
+/*
+ * 64-bit hash over every field asx_codec_fixture_semantic_eq compares
+ * (WORD64 mixing, independent of digest mode and host byte order).
+ * Semantically equal fixtures hash equal; a hash match still needs
+ * asx_codec_fixture_semantic_eq to confirm. Fixtures need not be valid.
+ */
+ASX_API ASX_MUST_USE asx_status asx_codec_fixture_semantic_hash(
+    const asx_canonical_fixture *fixture,
+    uint64_t *out_hash);
+
+/* One open-addressing slot; fixture is NULL when empty. */
+typedef struct {
+    uint64_t hash;
+    const asx_canonical_fixture *fixture;
+} asx_codec_semantic_slot;
+
+/*
+ * Open-addressing index of fixtures keyed by semantic hash, for
+ * one-pass corpus dedupe and cross-codec matching. Slots are caller
+ * storage; indexed fixtures are borrowed and must outlive the index.
+ * Full field compares run only on hash hits. Treat members as private.
+ */
+typedef struct {
+    asx_codec_semantic_slot *slots;
+    uint32_t capacity;
+    uint32_t count;
+} asx_codec_semantic_index;
+
+/* Bind an empty index to capacity slots (a power of two, at least 4).
+ * At most three quarters of the slots are filled. */
+ASX_API ASX_MUST_USE asx_status asx_codec_semantic_index_init(
+    asx_codec_semantic_index *index,
+    asx_codec_semantic_slot *slots,
+    uint32_t capacity);
+
+/*
+ * Add fixture unless a semantically equal one is indexed already; then
+ * returns ASX_E_ALREADY_EXISTS and, when out_existing is non-NULL, sets
+ * it to the earlier fixture. ASX_E_RESOURCE_EXHAUSTED when full.
+ */
+ASX_API ASX_MUST_USE asx_status asx_codec_semantic_index_insert(
+    asx_codec_semantic_index *index,
+    const asx_canonical_fixture *fixture,
+    const asx_canonical_fixture **out_existing);
+
+/* Look up a semantically equal fixture: ASX_OK with *out_match set
+ * (when non-NULL), or ASX_E_NOT_FOUND. */
+ASX_API ASX_MUST_USE asx_status asx_codec_semantic_index_find(
+    const asx_codec_semantic_index *index,
+    const asx_canonical_fixture *fixture,
+    const asx_canonical_fixture **out_match);
+
 /*
  * Cross-codec round-trip verification.
  *
@@ -77,6 +132,28 @@ ASX_API ASX_MUST_USE asx_status asx_codec_cross_codec_verify(
     const asx_canonical_fixture *fixture,
     asx_codec_equiv_report *report);
 
+/*
+ * Batch cross-codec verification for conformance and fuzz sweeps.
+ *
+ * Runs asx_codec_cross_codec_verify over count fixtures; statuses[i]
+ * receives fixture i's result and, when reports is non-NULL, reports[i]
+ * its mismatches. Each worker reuses one pair of encode buffers for all
+ * of its fixtures. Returns ASX_OK if every fixture verified, otherwise
+ * the status of the lowest-indexed failure.
+ *
+ * workers (1..ASX_MAX_WORKERS) > 1 spreads fixtures over the thread
+ * hook's worker threads; the allocator hook must then be thread-safe
+ * (the libc default is). Deterministic builds, runs with an active
+ * codec arena, and runtimes without a dispatch hook verify serially,
+ * with identical results.
+ */
+ASX_API ASX_MUST_USE asx_status asx_codec_cross_codec_verify_batch(
+    const asx_canonical_fixture *fixtures,
+    size_t count,
+    uint32_t workers,
+    asx_status *statuses,
+    asx_codec_equiv_report *reports);
+
 #ifdef __cplusplus
 }
 #endif
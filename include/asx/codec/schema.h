@@ -24,7 +24,8 @@ typedef enum {
 } asx_codec_kind;
 
 enum {
-    ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1 = 1u,
+    ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1 = 1u,  /* FNV-1a 32 checksum footer */
+    ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2 = 2u,  /* CRC32C checksum footer */
     ASX_CODEC_BIN_FRAME_MESSAGE_FIXTURE   = 1u,
     ASX_CODEC_BIN_FLAG_CHECKSUM_FOOTER    = 1u
 };
@@ -38,6 +39,8 @@ typedef struct {
     char *capture_run_id;
 } asx_fixture_provenance;
 
+struct asx_codec_arena;  /* asx/codec/codec.h */
+
 typedef struct {
     char *scenario_id;
     char *fixture_schema_version;
@@ -51,12 +54,14 @@ typedef struct {
     char *expected_error_codes_json;
     char *semantic_digest;
     asx_fixture_provenance provenance;
+    struct asx_codec_arena *arena;  /* backs the strings; NULL = heap */
 } asx_canonical_fixture;
 
 /* Initialize fixture fields to zero/empty defaults. */
 ASX_API void asx_canonical_fixture_init(asx_canonical_fixture *fixture);
 
-/* Free owned fixture strings and reset to defaults. */
+/* Free owned fixture strings and reset to defaults. Arena-backed
+ * strings are left to asx_codec_arena_reset. */
 ASX_API void asx_canonical_fixture_reset(asx_canonical_fixture *fixture);
 
 /* Validate required canonical schema fields and deterministic constraints. */
@@ -150,7 +150,8 @@ ASX_API asx_adaptive_policy asx_adaptive_policy_active(void);
  *   posterior->state_count must equal surface->state_count.
  * Returns ASX_OK on success.
  * Returns ASX_E_INVALID_ARGUMENT if any precondition fails.
- * The decision is logged to the evidence ledger. */
+ * The decision is logged to the evidence ledger unless sampled out
+ * (asx_adaptive_set_ledger_sampling). */
 ASX_API ASX_MUST_USE asx_status asx_adaptive_decide(
     const asx_adaptive_surface   *surface,
     const asx_adaptive_posterior *posterior,
@@ -158,11 +159,61 @@ ASX_API ASX_MUST_USE asx_status asx_adaptive_decide(
     uint8_t                       evidence_count,
     asx_adaptive_decision        *out_decision);
 
+/* -------------------------------------------------------------------
+ * Incremental engine: cached losses and running expected loss
+ *
+ * For surfaces decided at a high rate. Init evaluates the loss matrix
+ * once and keeps each action's expected loss, so new evidence for a
+ * state costs one update per action and a decision is an argmin over the
+ * running sums, with no loss_fn calls. Decisions, fallback, budget and
+ * ledger behave exactly as asx_adaptive_decide on the same posterior.
+ * loss_fn must be pure; re-init after the losses change.
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    const asx_adaptive_surface *surface;   /* borrowed */
+    uint32_t loss[ASX_ADAPTIVE_MAX_ACTIONS][ASX_ADAPTIVE_MAX_ACTIONS];
+    uint64_t expected[ASX_ADAPTIVE_MAX_ACTIONS]; /* fp 16.16 per action */
+    asx_adaptive_posterior posterior;
+} asx_adaptive_engine;
+
+/* Bind an engine to a surface and its starting posterior.
+ * Returns ASX_E_INVALID_ARGUMENT on the asx_adaptive_decide
+ * preconditions or a NULL engine. */
+ASX_API ASX_MUST_USE asx_status asx_adaptive_engine_init(
+    asx_adaptive_engine *eng,
+    const asx_adaptive_surface *surface,
+    const asx_adaptive_posterior *posterior);
+
+/* New evidence for one state: set P(state), fp 0.32.
+ * Returns ASX_E_INVALID_ARGUMENT for an unknown state. */
+ASX_API ASX_MUST_USE asx_status asx_adaptive_engine_observe(
+    asx_adaptive_engine *eng, uint8_t state_index, uint32_t posterior_fp32);
+
+/* Replace the whole posterior; only states whose value changed are
+ * updated. Returns ASX_E_INVALID_ARGUMENT on a state count mismatch. */
+ASX_API ASX_MUST_USE asx_status asx_adaptive_engine_update(
+    asx_adaptive_engine *eng, const asx_adaptive_posterior *posterior);
+
+/* Decide from the running sums, as asx_adaptive_decide would. */
+ASX_API ASX_MUST_USE asx_status asx_adaptive_engine_decide(
+    asx_adaptive_engine *eng,
+    const asx_adaptive_evidence_term *evidence,
+    uint8_t evidence_count,
+    asx_adaptive_decision *out_decision);
+
 /* -------------------------------------------------------------------
  * Evidence ledger queries
  * ------------------------------------------------------------------- */
 
-/* Return the total number of decisions logged since last reset. */
+/* Ledger sampling: record the decisions whose sequence number is a
+ * multiple of every (1: all, the default; 0: none). Sequence numbers
+ * count every decision, so a deterministic run samples, and digests,
+ * the same entries each time. Reset restores 1. */
+ASX_API void asx_adaptive_set_ledger_sampling(uint32_t every);
+
+/* Return the total number of decisions logged since last reset
+ * (sampled-out decisions are not logged). */
 ASX_API uint32_t asx_adaptive_ledger_count(void);
 
 /* Return nonzero if the ledger has overflowed (wrapped). */
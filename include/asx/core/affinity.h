@@ -46,8 +46,11 @@ typedef uint32_t asx_affinity_domain;
 /* Sentinel for entities with no domain binding. */
 #define ASX_AFFINITY_DOMAIN_NONE ((asx_affinity_domain)0xFFFFFFFFu)
 
-/* Tracking table capacity */
+/* Tracking table capacity. Override at build time with a power of two;
+ * the table hashes into twice as many slots. */
+#ifndef ASX_AFFINITY_TABLE_CAPACITY
 #define ASX_AFFINITY_TABLE_CAPACITY 256u
+#endif
 
 /* ------------------------------------------------------------------ */
 /* API (real implementations when ASX_DEBUG_AFFINITY is defined)       */
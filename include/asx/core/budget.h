@@ -38,6 +38,12 @@ ASX_API asx_budget asx_budget_zero(void);
 /* Componentwise tightening: min deadline, min quota, min priority */
 ASX_API asx_budget asx_budget_meet(const asx_budget *a, const asx_budget *b);
 
+/* Meet each of budgets[0..count) with bound in place, e.g. to clamp a
+ * batch of child budgets to their region's. Branch-free per element.
+ * No-op when budgets or bound is NULL. */
+ASX_API void asx_budget_meet_each(asx_budget *budgets, uint32_t count,
+                                  const asx_budget *bound);
+
 /* Consume one poll from quota. Returns old quota or 0 if exhausted. */
 ASX_API uint32_t asx_budget_consume_poll(asx_budget *b);
 
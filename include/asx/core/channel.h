@@ -7,11 +7,23 @@
  * the capacity without enqueuing.
  *
  * Messages are uint64_t tokens (opaque to the channel). FIFO ordering
- * is guaranteed for committed messages.
+ * is guaranteed for committed messages; a priority channel keeps it
+ * within each of its classes and delivers the most urgent class first. Payload channels instead carry
+ * fixed-size elements: the producer writes into its reserved slot in
+ * place and the receiver borrows the slot until it releases the view.
+ * Broadcast channels deliver every committed value to each subscribed
+ * receiver; the slowest subscriber bounds the producers' capacity.
+ * Oneshots carry a single value whose send side is an obligation.
  *
- * Walking skeleton: single-threaded, non-blocking (try_reserve/try_recv).
- * Blocking variants will be added when the scheduler gains channel
- * awareness (future phase).
+ * Non-blocking (try_reserve/try_recv); tasks park on a channel to wait
+ * (asx/runtime/waker.h). Reserve, send, abort and receive are lock-free
+ * and may be called concurrently from parallel worker threads (many
+ * producers, one consumer) where compiler atomics are available;
+ * create, close and reset belong to the calling thread.
+ *
+ * A channel belongs to the region it was created in: asx_region_drain
+ * closes and reclaims the region's channels once its tasks are done,
+ * after which their handles report ASX_E_NOT_FOUND.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -28,12 +40,23 @@ extern "C" {
 #endif
 
 /* ------------------------------------------------------------------ */
-/* Capacity limits (walking skeleton: fixed-size arenas)              */
+/* Capacity limits                                                    */
+/*                                                                    */
+/* Each channel's ring and permit storage is sized to its capacity at */
+/* create. Capacities up to ASX_CHANNEL_MAX_CAPACITY come from a      */
+/* static pool with room for ASX_MAX_CHANNELS of them; larger ones,   */
+/* up to ASX_CHANNEL_ARENA_MAX_CAPACITY, come from asx_runtime_alloc  */
+/* and need the allocator hook installed and unsealed.                */
 /* ------------------------------------------------------------------ */
 
 #define ASX_MAX_CHANNELS         16u
 #define ASX_CHANNEL_MAX_CAPACITY 64u
+#define ASX_CHANNEL_ARENA_MAX_CAPACITY 16384u
 #define ASX_CHANNEL_MAX_WAITERS  32u
+#define ASX_CHANNEL_MAX_ELEMENT_SIZE 4096u
+#define ASX_CHANNEL_MAX_SUBSCRIBERS  8u
+#define ASX_CHANNEL_MAX_PRIORITIES   4u
+#define ASX_MAX_ONESHOTS         64u
 
 /* ------------------------------------------------------------------ */
 /* Channel lifecycle states                                           */
@@ -52,21 +75,99 @@ typedef enum {
 
 typedef struct asx_send_permit {
     asx_channel_id  channel_id;
-    uint32_t        token;      /* monotonic token for linearity check */
+    uint32_t        token;      /* [generation:16 | permit slot:16] */
     int             consumed;   /* 1 if already sent or aborted */
 } asx_send_permit;
 
+/* ------------------------------------------------------------------ */
+/* Receive view (payload channels)                                    */
+/* ------------------------------------------------------------------ */
+
+typedef struct asx_recv_view {
+    asx_channel_id  channel_id;
+    const void     *data;       /* element bytes, valid until release */
+    uint32_t        size;       /* channel element size */
+    uint32_t        token;      /* committed slot token */
+    int             released;   /* 1 if already released */
+} asx_recv_view;
+
+/* ------------------------------------------------------------------ */
+/* Broadcast receiver (one subscriber's cursor)                       */
+/* ------------------------------------------------------------------ */
+
+typedef struct asx_broadcast_receiver {
+    asx_channel_id  channel_id;
+    uint32_t        token;      /* [generation:16 | subscriber slot:16] */
+} asx_broadcast_receiver;
+
+/* ------------------------------------------------------------------ */
+/* Channel statistics                                                 */
+/*                                                                    */
+/* Kept for channels created while the telemetry tier is above        */
+/* ULTRA_MIN. Counters are 32-bit and wrap; queue times are measured  */
+/* with asx_runtime_now_ns from commit to receive and are 0 without a */
+/* clock hook.                                                        */
+/* ------------------------------------------------------------------ */
+
+typedef struct asx_channel_stats {
+    uint32_t high_water;    /* largest queue length reached */
+    uint32_t sends;         /* messages committed */
+    uint32_t receives;      /* messages received (all subscribers) */
+    uint32_t reserve_full;  /* reservations refused with CHANNEL_FULL */
+    uint64_t wait_total_ns; /* summed commit-to-receive time */
+    uint64_t wait_max_ns;   /* longest commit-to-receive time */
+} asx_channel_stats;
+
 /* ------------------------------------------------------------------ */
 /* Channel lifecycle API                                              */
 /* ------------------------------------------------------------------ */
 
 /* Create a bounded channel within a region.
- * capacity must be > 0 and <= ASX_CHANNEL_MAX_CAPACITY.
- * Returns ASX_OK and sets *out_id on success. */
+ * capacity must be > 0 and <= ASX_CHANNEL_ARENA_MAX_CAPACITY.
+ * Returns ASX_OK and sets *out_id on success, ASX_E_RESOURCE_EXHAUSTED
+ * if every channel slot is in use or a capacity above
+ * ASX_CHANNEL_MAX_CAPACITY cannot be allocated. */
 ASX_API ASX_MUST_USE asx_status asx_channel_create(asx_region_id region,
                                                     uint32_t capacity,
                                                     asx_channel_id *out_id);
 
+/* Create a bounded payload channel carrying element_size-byte elements.
+ * Storage for capacity elements comes from asx_runtime_alloc now and is
+ * returned by asx_channel_reset. Payload channels use the slot API
+ * below; the uint64_t value calls return ASX_E_INVALID_STATE on them.
+ * Returns ASX_E_INVALID_ARGUMENT if element_size is 0 or above
+ * ASX_CHANNEL_MAX_ELEMENT_SIZE, ASX_E_RESOURCE_EXHAUSTED if the arena
+ * is full or the allocator fails, and the errors of
+ * asx_channel_create otherwise. */
+ASX_API ASX_MUST_USE asx_status asx_channel_create_payload(asx_region_id region,
+                                                            uint32_t capacity,
+                                                            uint32_t element_size,
+                                                            asx_channel_id *out_id);
+
+/* Create a bounded broadcast channel within a region. Producers use
+ * the normal reserve/send/abort protocol; each committed value is
+ * delivered to every subscriber (asx_broadcast_subscribe) and holds its
+ * capacity until the slowest subscriber has read it. queue_len counts
+ * values some subscriber has not read yet; asx_channel_try_recv and
+ * asx_channel_try_recv_many return ASX_E_INVALID_STATE on it. Errors as
+ * asx_channel_create. */
+ASX_API ASX_MUST_USE asx_status asx_channel_create_broadcast(asx_region_id region,
+                                                              uint32_t capacity,
+                                                              asx_channel_id *out_id);
+
+/* Create a bounded value channel with classes priority classes (2 to
+ * ASX_CHANNEL_MAX_PRIORITIES); 0 is the most urgent. Every class shares
+ * the one capacity and reservation; asx_send_permit_send_priority picks
+ * the class at send, asx_send_permit_send and asx_send_permit_send_many
+ * use the least urgent. Receives drain class 0 first, each class FIFO.
+ * Storage that outgrows the static pool segment comes from
+ * asx_runtime_alloc. Returns ASX_E_INVALID_ARGUMENT for a bad classes,
+ * and the errors of asx_channel_create otherwise. */
+ASX_API ASX_MUST_USE asx_status asx_channel_create_priority(asx_region_id region,
+                                                             uint32_t capacity,
+                                                             uint32_t classes,
+                                                             asx_channel_id *out_id);
+
 /* Close the sender side. No new reserves will succeed.
  * Pending messages remain available for recv.
  * Open → SenderClosed; ReceiverClosed → FullyClosed. */
@@ -93,6 +194,16 @@ ASX_API ASX_MUST_USE asx_status asx_channel_queue_len(asx_channel_id id,
 ASX_API ASX_MUST_USE asx_status asx_channel_reserved_count(asx_channel_id id,
                                                             uint32_t *out);
 
+/* Element size of a payload channel; 0 for a value channel. */
+ASX_API ASX_MUST_USE asx_status asx_channel_element_size(asx_channel_id id,
+                                                          uint32_t *out);
+
+/* Snapshot of the channel's statistics.
+ * Returns ASX_E_INVALID_STATE if the channel was created at the
+ * ULTRA_MIN telemetry tier and keeps none. */
+ASX_API ASX_MUST_USE asx_status asx_channel_get_stats(asx_channel_id id,
+                                                       asx_channel_stats *out);
+
 /* ------------------------------------------------------------------ */
 /* Two-phase send protocol                                            */
 /* ------------------------------------------------------------------ */
@@ -105,12 +216,54 @@ ASX_API ASX_MUST_USE asx_status asx_channel_reserved_count(asx_channel_id id,
 ASX_API ASX_MUST_USE asx_status asx_channel_try_reserve(asx_channel_id id,
                                                          asx_send_permit *out);
 
+/* Try to reserve up to count send slots with a single capacity claim.
+ * Fills out_permits[0 .. *out_reserved) with independent permits, each
+ * consumed by send or abort exactly like a single permit. With
+ * all_or_nothing nonzero either all count permits are reserved or none.
+ * Returns ASX_OK with *out_reserved >= 1,
+ *   ASX_E_CHANNEL_FULL if no slot (or, with all_or_nothing, fewer than
+ *     count slots) is free, and the other errors of
+ *     asx_channel_try_reserve (*out_reserved = 0),
+ *   ASX_E_INVALID_ARGUMENT if out_permits or out_reserved is NULL or
+ *     count is 0. */
+ASX_API ASX_MUST_USE asx_status asx_channel_try_reserve_many(asx_channel_id id,
+                                                              asx_send_permit *out_permits,
+                                                              uint32_t count,
+                                                              int all_or_nothing,
+                                                              uint32_t *out_reserved);
+
 /* Commit a reserved permit by sending a value.
  * Consumes the permit. The value is enqueued FIFO.
  * Returns ASX_E_DISCONNECTED if receiver closed (value NOT enqueued). */
 ASX_API ASX_MUST_USE asx_status asx_send_permit_send(asx_send_permit *permit,
                                                       uint64_t value);
 
+/* Commit a reserved permit by sending a value at priority class
+ * priority. As asx_send_permit_send, which is this with the channel's
+ * least urgent class; a plain channel has only class 0.
+ * Returns ASX_E_INVALID_ARGUMENT if priority is not below the
+ * channel's class count (permit left unconsumed). */
+ASX_API ASX_MUST_USE asx_status asx_send_permit_send_priority(asx_send_permit *permit,
+                                                               uint32_t priority,
+                                                               uint64_t value);
+
+/* Commit count permits of one channel in a single pass: permits[i]
+ * sends values[i]. Valid permits' values are enqueued in array order as
+ * contiguous FIFO runs of up to 64, with a single wake. Every permit of the
+ * channel is consumed, as with asx_send_permit_send; a permit for
+ * another channel is left untouched.
+ * Returns ASX_OK when every value was sent (*out_sent = count),
+ *   ASX_E_INVALID_STATE if some permit was already consumed or stale,
+ *   ASX_E_INVALID_ARGUMENT if some permit names another channel (the
+ *     valid ones are still sent; *out_sent counts them), or if
+ *     permits, values or out_sent is NULL or count is 0,
+ *   ASX_E_DISCONNECTED if the receiver closed (nothing enqueued),
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for an invalid channel. */
+ASX_API ASX_MUST_USE asx_status asx_send_permit_send_many(asx_send_permit *permits,
+                                                           const uint64_t *values,
+                                                           uint32_t count,
+                                                           uint32_t *out_sent);
+
 /* Abort a reserved permit without sending.
  * Returns the capacity to the pool. */
 ASX_API void asx_send_permit_abort(asx_send_permit *permit);
@@ -126,6 +279,168 @@ ASX_API void asx_send_permit_abort(asx_send_permit *permit);
 ASX_API ASX_MUST_USE asx_status asx_channel_try_recv(asx_channel_id id,
                                                       uint64_t *out_value);
 
+/* Try to receive up to max messages in FIFO order. Non-blocking.
+ * Costs one handle lookup and one wake for the whole run, so draining
+ * a busy channel is cheaper than repeated asx_channel_try_recv.
+ * Returns ASX_OK with *out_count in [1, max] and out_values filled,
+ *   ASX_E_WOULD_BLOCK / ASX_E_DISCONNECTED as asx_channel_try_recv
+ *   when nothing is queued (*out_count = 0),
+ *   ASX_E_INVALID_ARGUMENT if out_values or out_count is NULL or
+ *   max is 0. */
+ASX_API ASX_MUST_USE asx_status asx_channel_try_recv_many(asx_channel_id id,
+                                                           uint64_t *out_values,
+                                                           uint32_t max,
+                                                           uint32_t *out_count);
+
+/* ------------------------------------------------------------------ */
+/* Payload channel API (zero-copy slots)                              */
+/* ------------------------------------------------------------------ */
+
+/* Try to reserve an element slot of a payload channel. Non-blocking.
+ * On ASX_OK fills *out and points *out_data at the slot's element
+ * bytes; write the message there, then asx_send_permit_commit (or
+ * asx_send_permit_abort) the permit. Errors as asx_channel_try_reserve;
+ * ASX_E_INVALID_STATE for a value channel. */
+ASX_API ASX_MUST_USE asx_status asx_channel_try_reserve_slot(asx_channel_id id,
+                                                              asx_send_permit *out,
+                                                              void **out_data);
+
+/* Commit a slot permit: its element is enqueued FIFO without copying.
+ * Consumes the permit. Returns ASX_E_DISCONNECTED if the receiver
+ * closed (element dropped), ASX_E_INVALID_STATE if already consumed,
+ * stale, or not a payload permit (the latter left untouched). */
+ASX_API ASX_MUST_USE asx_status asx_send_permit_commit(asx_send_permit *permit);
+
+/* Try to borrow the oldest committed element. Non-blocking.
+ * On ASX_OK *out views the element in place; its slot keeps its share
+ * of capacity until asx_recv_view_release.
+ * Returns ASX_E_WOULD_BLOCK / ASX_E_DISCONNECTED as asx_channel_try_recv,
+ * ASX_E_INVALID_STATE for a value channel. */
+ASX_API ASX_MUST_USE asx_status asx_channel_try_recv_view(asx_channel_id id,
+                                                           asx_recv_view *out);
+
+/* Release a borrowed element, returning its slot to producers. The view
+ * (and any copy of it) must not be read afterwards.
+ * Returns ASX_E_INVALID_STATE if already released. */
+ASX_API ASX_MUST_USE asx_status asx_recv_view_release(asx_recv_view *view);
+
+/* ------------------------------------------------------------------ */
+/* Broadcast receive API                                              */
+/*                                                                    */
+/* Subscribe and unsubscribe belong to the calling thread; each       */
+/* receiver may be polled from any one worker at a time.              */
+/* ------------------------------------------------------------------ */
+
+/* Subscribe to a broadcast channel. The receiver sees values committed
+ * after this call, in FIFO order.
+ * Returns ASX_E_RESOURCE_EXHAUSTED with ASX_CHANNEL_MAX_SUBSCRIBERS
+ * receivers already subscribed, ASX_E_INVALID_STATE if the channel is
+ * not a broadcast channel or its receiver side is closed. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_subscribe(asx_channel_id id,
+                                                         asx_broadcast_receiver *out);
+
+/* Drop a subscription. Values it had not read stop holding capacity.
+ * Closing the receiver side drops every subscription.
+ * Returns ASX_E_INVALID_STATE for a stale or dropped receiver. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_unsubscribe(asx_broadcast_receiver *rx);
+
+/* Try to receive the receiver's next value. Non-blocking.
+ * Returns ASX_E_WOULD_BLOCK / ASX_E_DISCONNECTED as asx_channel_try_recv,
+ * ASX_E_INVALID_STATE for a stale or dropped receiver. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_try_recv(const asx_broadcast_receiver *rx,
+                                                        uint64_t *out_value);
+
+/* ------------------------------------------------------------------ */
+/* Oneshots                                                           */
+/*                                                                    */
+/* A oneshot is one value cell, taken from a pool of ASX_MAX_ONESHOTS */
+/* shared by all regions, and an obligation reserved in the same      */
+/* region as its send side: committing the obligation sends the       */
+/* staged value, aborting it tells the receiver no value will come.   */
+/* The receiver parks on the obligation (asx_task_park_on_obligation, */
+/* or ASX_CO_AWAIT_ONESHOT) and is woken by the resolve. The cell is  */
+/* freed when the receiver takes the outcome or drops the oneshot,    */
+/* and at the latest when the region closes.                          */
+/* ------------------------------------------------------------------ */
+
+typedef struct asx_oneshot {
+    asx_obligation_id sender;   /* commit sends, abort cancels */
+    uint32_t          token;    /* [generation:16 | cell:16] */
+} asx_oneshot;
+
+/* Create a oneshot in region, reserving its sender obligation.
+ * Returns ASX_E_INVALID_ARGUMENT if out is NULL,
+ * ASX_E_RESOURCE_EXHAUSTED if every cell is in use, and the errors of
+ * asx_obligation_reserve otherwise. */
+ASX_API ASX_MUST_USE asx_status asx_oneshot_create(asx_region_id region,
+                                                    asx_oneshot *out);
+
+/* Stage value and commit the sender obligation, waking the receiver.
+ * With the receiver gone the obligation still commits and the value
+ * is discarded.
+ * Returns ASX_E_INVALID_STATE for a freed oneshot,
+ * ASX_E_INVALID_TRANSITION once the sender has resolved. */
+ASX_API ASX_MUST_USE asx_status asx_oneshot_send(const asx_oneshot *os,
+                                                  uint64_t value);
+
+/* Take the oneshot's outcome. Non-blocking. The cell is freed once
+ * this returns ASX_OK or ASX_E_DISCONNECTED.
+ * Returns ASX_OK with the sent value, ASX_E_WOULD_BLOCK while the
+ * sender is reserved, ASX_E_DISCONNECTED if it was aborted,
+ * ASX_E_INVALID_STATE for a freed or dropped oneshot. */
+ASX_API ASX_MUST_USE asx_status asx_oneshot_try_recv(const asx_oneshot *os,
+                                                      uint64_t *out_value);
+
+/* Give up the receive side. The cell is freed now if the sender has
+ * resolved, otherwise when it does; the sender must still be
+ * committed or aborted.
+ * Returns ASX_E_INVALID_STATE for a freed or dropped oneshot. */
+ASX_API ASX_MUST_USE asx_status asx_oneshot_drop(const asx_oneshot *os);
+
+/* ------------------------------------------------------------------ */
+/* Bridge channels                                                    */
+/*                                                                    */
+/* A bridge carries uint64_t tokens between runtime contexts          */
+/* (asx_runtime_context_init), which share no channel table: it lives */
+/* in caller storage, uses no handles, and needs no context bound.    */
+/* One sender and one receiver; the sender's and the receiver's       */
+/* cursors sit on separate cache lines, each side caching the other.  */
+/* Contexts run in turn, so both ends are usually driven from one     */
+/* thread. No wakes: the receiver polls, typically from a task of     */
+/* its own context. Members are private.                              */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    uint64_t *cells;
+    uint32_t  mask;
+    uint8_t   pad0[52];
+    uint32_t  head;          /* receiver: next position to read */
+    uint32_t  tail_seen;     /* receiver's last view of tail */
+    uint8_t   pad1[56];
+    uint32_t  tail;          /* sender: next position to write */
+    uint32_t  head_seen;     /* sender's last view of head */
+    uint8_t   pad2[56];
+} asx_channel_bridge;
+
+/* Set up a bridge over capacity cells of caller storage, which must
+ * outlive it. capacity is a power of two up to 2^31.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL or a bad capacity. */
+ASX_API ASX_MUST_USE asx_status asx_channel_bridge_init(asx_channel_bridge *bridge,
+                                                         uint64_t *cells,
+                                                         uint32_t capacity);
+
+/* Send value, from the bridge's one sender. Non-blocking.
+ * Returns ASX_E_CHANNEL_FULL with capacity values unread,
+ * ASX_E_INVALID_STATE for a bridge never initialized. */
+ASX_API ASX_MUST_USE asx_status asx_channel_bridge_send(asx_channel_bridge *bridge,
+                                                         uint64_t value);
+
+/* Receive the oldest value, from the bridge's one receiver. Non-blocking.
+ * Returns ASX_E_WOULD_BLOCK when empty, ASX_E_INVALID_STATE for a
+ * bridge never initialized. */
+ASX_API ASX_MUST_USE asx_status asx_channel_bridge_try_recv(asx_channel_bridge *bridge,
+                                                             uint64_t *out_value);
+
 /* ------------------------------------------------------------------ */
 /* Reset (test support)                                               */
 /* ------------------------------------------------------------------ */
@@ -5,8 +5,11 @@
  * deterministic LIFO unwind: every acquire registers a cleanup action,
  * commit/abort pops it, finalization drains the remainder.
  *
- * Cleanup stacks are per-region (walking skeleton uses fixed-size static
- * arrays). Phase 3 will add per-task stacks and hook-backed allocation.
+ * Cleanup stacks are per-region. The first ASX_CLEANUP_INLINE_CAPACITY
+ * entries live inside the stack itself; deeper entries go to chunks of
+ * ASX_CLEANUP_CHUNK_CAPACITY taken from asx_runtime_alloc. Chunks stay
+ * chained across drain for reuse and go back to the allocator hook in
+ * asx_cleanup_release.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -22,8 +25,14 @@
 extern "C" {
 #endif
 
-/* Maximum entries per cleanup stack (walking skeleton) */
-#define ASX_CLEANUP_STACK_CAPACITY 32
+/* Maximum entries per cleanup stack (inline plus chunked) */
+#define ASX_CLEANUP_STACK_CAPACITY 1024
+
+/* Entries stored in the stack itself before any chunk is needed */
+#define ASX_CLEANUP_INLINE_CAPACITY 4
+
+/* Entries per overflow chunk */
+#define ASX_CLEANUP_CHUNK_CAPACITY 16
 
 /* Cleanup action callback: called with user context during drain.
  * Must not fail — cleanup actions are best-effort during unwind. */
@@ -35,20 +44,36 @@ typedef uint32_t asx_cleanup_handle;
 /* Sentinel for invalid cleanup handle */
 #define ASX_CLEANUP_INVALID ((asx_cleanup_handle)UINT32_MAX)
 
-/* Cleanup stack (fixed-size, walking skeleton) */
+/* One registered action. Members are private. */
 typedef struct {
-    asx_cleanup_fn  fns[ASX_CLEANUP_STACK_CAPACITY];
-    void           *data[ASX_CLEANUP_STACK_CAPACITY];
-    uint16_t        generations[ASX_CLEANUP_STACK_CAPACITY];
+    asx_cleanup_fn  fn;         /* NULL once popped or drained */
+    void           *data;
+    uint16_t        generation;
+} asx_cleanup_entry;
+
+/* Overflow chunk, defined in cleanup.c */
+struct asx_cleanup_chunk;
+
+/* Cleanup stack: inline entries, then chained chunks */
+typedef struct {
+    asx_cleanup_entry         entries[ASX_CLEANUP_INLINE_CAPACITY];
+    struct asx_cleanup_chunk *chunks;  /* first chunk, entries INLINE.. */
+    struct asx_cleanup_chunk *top;     /* chunk holding entry count-1 */
     uint32_t        count;      /* stack depth / high-water slot + 1 */
     uint32_t        drained;    /* 1 after drain has run */
 } asx_cleanup_stack;
 
-/* Initialize a cleanup stack to empty state. */
+/* Initialize a cleanup stack to empty state. Chunks a previous use left
+ * chained are not freed; use asx_cleanup_release for that. */
 ASX_API void asx_cleanup_init(asx_cleanup_stack *stack);
 
+/* Return every chunk to the allocator hook and reinitialize the stack.
+ * Entries still pending are discarded without being called. */
+ASX_API void asx_cleanup_release(asx_cleanup_stack *stack);
+
 /* Register a cleanup action. Returns a handle for later pop/cancel.
- * Returns ASX_E_RESOURCE_EXHAUSTED if the stack is full.
+ * Returns ASX_E_RESOURCE_EXHAUSTED if the stack holds
+ * ASX_CLEANUP_STACK_CAPACITY entries or a new chunk cannot be allocated.
  * The cleanup_fn will be called during drain if not popped first. */
 ASX_API ASX_MUST_USE asx_status asx_cleanup_push(asx_cleanup_stack *stack,
                                                  asx_cleanup_fn fn,
@@ -67,6 +92,12 @@ ASX_API ASX_MUST_USE asx_status asx_cleanup_pop(asx_cleanup_stack *stack,
  * stack is a no-op. */
 ASX_API void asx_cleanup_drain(asx_cleanup_stack *stack);
 
+/* Drain at most max_calls un-popped entries, top first, in the same
+ * order asx_cleanup_drain uses. Returns the number of callbacks run.
+ * The stack counts as drained once its last entry has gone. */
+ASX_API uint32_t asx_cleanup_drain_some(asx_cleanup_stack *stack,
+                                        uint32_t max_calls);
+
 /* Query the number of un-popped entries remaining. */
 ASX_API uint32_t asx_cleanup_pending(const asx_cleanup_stack *stack);
 
@@ -15,6 +15,14 @@
  * Violations are recorded into a deterministic ring buffer that can be
  * queried for diagnostics and integrated into test assertions.
  *
+ * Sampled mode (production canaries): build with ASX_DEBUG_GHOST and
+ * ASX_GHOST_SAMPLE_EVERY=N, or call asx_ghost_set_sampling(N), and
+ * only one region in N is checked — region transitions, linearity
+ * tracking of the region's obligations and its leak scan. The choice
+ * is a hash of the region handle, so the same regions are checked on
+ * every replay. A violation sink (asx_hindsight_route_ghost) carries
+ * violations to the hindsight flush.
+ *
  * SPDX-License-Identifier: MIT
  */
 
@@ -24,6 +32,7 @@
 #include <asx/asx_export.h>
 #include <asx/asx_status.h>
 #include <asx/asx_ids.h>
+#include <asx/core/transition.h>
 
 /* Auto-enable ghost monitors in debug builds unless explicitly disabled.
  * Define ASX_DEBUG_GHOST_DISABLE to suppress this auto-enable. */
@@ -67,14 +76,41 @@ typedef struct {
 
 #ifdef ASX_DEBUG_GHOST
 
-/* Reset all ghost monitor state. Call before each test. */
+/* Reset all ghost monitor state. Call before each test. The sampling
+ * rate and violation sink survive. */
 ASX_API void asx_ghost_reset(void);
 
+/* --- Sampling --- */
+
+/* Default 1-in-N region sampling rate (1 checks every region). */
+#ifndef ASX_GHOST_SAMPLE_EVERY
+#define ASX_GHOST_SAMPLE_EVERY 1u
+#endif
+
+/* Check one region in every (0 or 1: all). */
+ASX_API void asx_ghost_set_sampling(uint32_t every);
+
+/* Active sampling rate (1 when every region is checked). */
+ASX_API ASX_MUST_USE uint32_t asx_ghost_sampling(void);
+
+/* Nonzero if region falls in the checked sample. Deterministic in the
+ * handle; ASX_INVALID_ID is always sampled. */
+ASX_API ASX_MUST_USE int asx_ghost_region_sampled(asx_region_id region);
+
+/* Called with each violation after it is recorded in the ring. */
+typedef void (*asx_ghost_violation_fn)(void *ctx,
+                                       const asx_ghost_violation *v);
+
+/* Install (or with fn NULL remove) the violation sink. */
+ASX_API void asx_ghost_set_violation_sink(asx_ghost_violation_fn fn,
+                                          void *ctx);
+
 /* --- Protocol monitor --- */
 
 /* Record and validate a region state transition.
  * Returns ASX_OK if legal, records violation and returns
- * ASX_E_INVALID_TRANSITION if not.
+ * ASX_E_INVALID_TRANSITION if not. Violations in unsampled regions
+ * are returned but not recorded.
  * Note: no ASX_MUST_USE — these are primarily side-effect operations
  * for recording violations. Callers may check or ignore the result. */
 ASX_API asx_status asx_ghost_check_region_transition(
@@ -88,6 +124,19 @@ ASX_API asx_status asx_ghost_check_task_transition(
 ASX_API asx_status asx_ghost_check_obligation_transition(
     asx_obligation_id id, asx_obligation_state from, asx_obligation_state to);
 
+/* Legal transitions are decided inline from the packed masks in
+ * transition.h; only a violation calls out to be recorded. The
+ * states are evaluated twice. */
+#define asx_ghost_check_region_transition(id,f,t)                      \
+    (asx_region_transition_legal((f), (t)) ? ASX_OK :                  \
+     asx_ghost_check_region_transition((id), (f), (t)))
+#define asx_ghost_check_task_transition(id,f,t)                        \
+    (asx_task_transition_legal((f), (t)) ? ASX_OK :                    \
+     asx_ghost_check_task_transition((id), (f), (t)))
+#define asx_ghost_check_obligation_transition(id,f,t)                  \
+    (asx_obligation_transition_legal((f), (t)) ? ASX_OK :              \
+     asx_ghost_check_obligation_transition((id), (f), (t)))
+
 /* --- Linearity monitor --- */
 
 /* Track a newly reserved obligation. */
@@ -99,6 +148,7 @@ ASX_API void asx_ghost_obligation_resolved(asx_obligation_id id);
 
 /* Scan for leaked obligations (reserved but never resolved) in a region.
  * Returns the count of leaked obligations found and records violations.
+ * Unsampled regions are not scanned (returns 0).
  * No ASX_MUST_USE — primarily a side-effect operation. */
 ASX_API uint32_t asx_ghost_check_obligation_leaks(asx_region_id region);
 
@@ -120,8 +170,11 @@ ASX_API ASX_MUST_USE const char *asx_ghost_violation_kind_str(
 
 /* --- Borrow ledger --- */
 
-/* Maximum number of handles tracked simultaneously. */
+/* Maximum number of handles tracked simultaneously. Override at build
+ * time with a power of two; the ledger hashes into twice as many slots. */
+#ifndef ASX_GHOST_BORROW_TABLE_CAPACITY
 #define ASX_GHOST_BORROW_TABLE_CAPACITY 128u
+#endif
 
 /* Acquire a shared borrow on an entity. Records a BORROW_SHARED violation
  * if an exclusive borrow is already active. Returns the new shared count. */
@@ -146,9 +199,18 @@ ASX_API ASX_MUST_USE int asx_ghost_borrow_is_exclusive(uint64_t entity_id);
 
 /* --- Determinism monitor --- */
 
-/* Maximum events tracked per determinism check window. */
+/* Runs of up to this many events are compared key by key. */
 #define ASX_GHOST_DETERMINISM_CAPACITY 256u
 
+/* Longer runs are compared by per-window digests: one digest per
+ * ASX_GHOST_DETERMINISM_WINDOW events, at most
+ * ASX_GHOST_DETERMINISM_WINDOWS of them. When the table fills,
+ * neighbouring windows are merged and the window length doubles, so
+ * memory stays constant and a divergence is located to a window of
+ * length/WINDOWS events or finer, for runs of any length. */
+#define ASX_GHOST_DETERMINISM_WINDOW   256u
+#define ASX_GHOST_DETERMINISM_WINDOWS  64u
+
 /* Reset determinism monitor state. */
 ASX_API void asx_ghost_determinism_reset(void);
 
@@ -161,10 +223,23 @@ ASX_API void asx_ghost_determinism_record(uint64_t event_key);
 ASX_API void asx_ghost_determinism_seal(void);
 
 /* Check if the current event sequence matches the sealed reference.
- * Returns the number of drift violations detected (0 = stable). */
+ * Returns the number of drift violations detected (0 = stable). Runs
+ * within ASX_GHOST_DETERMINISM_CAPACITY record one violation per
+ * differing key (entity_id = key, from_state = index); longer runs
+ * record one per differing window (entity_id = first event index,
+ * from_state = window index, to_state = window length). */
 ASX_API ASX_MUST_USE uint32_t asx_ghost_determinism_check(void);
 
-/* Return a simple hash digest of the current event sequence. */
+/* Locate the first divergence from the sealed reference, without
+ * recording violations: events [*out_first, *out_first + *out_len)
+ * hold it (len 1 when compared key by key). Returns nonzero if the
+ * runs diverge; a run that is a prefix of the other diverges where it
+ * ends. Either out may be NULL. */
+ASX_API ASX_MUST_USE int asx_ghost_determinism_locate(uint32_t *out_first,
+                                                      uint32_t *out_len);
+
+/* Return a rolling FNV-1a digest of every event recorded since reset
+ * or seal. */
 ASX_API ASX_MUST_USE uint64_t asx_ghost_determinism_digest(void);
 
 /* Return the number of events recorded since last reset. */
@@ -174,6 +249,10 @@ ASX_API ASX_MUST_USE uint32_t asx_ghost_determinism_event_count(void);
 
 /* Zero-overhead stubs when ghost monitors are disabled. */
 #define asx_ghost_reset()                           ((void)0)
+#define asx_ghost_set_sampling(n)                   ((void)(n))
+#define asx_ghost_sampling()                        ((uint32_t)1)
+#define asx_ghost_region_sampled(r)                 ((void)(r), (int)0)
+#define asx_ghost_set_violation_sink(fn,ctx)        ((void)(fn), (void)(ctx))
 #define asx_ghost_check_region_transition(id,f,t)   (ASX_OK)
 #define asx_ghost_check_task_transition(id,f,t)     (ASX_OK)
 #define asx_ghost_check_obligation_transition(id,f,t) (ASX_OK)
@@ -194,6 +273,7 @@ ASX_API ASX_MUST_USE uint32_t asx_ghost_determinism_event_count(void);
 #define asx_ghost_determinism_record(k)             ((void)(k))
 #define asx_ghost_determinism_seal()                ((void)0)
 #define asx_ghost_determinism_check()               ((uint32_t)0)
+#define asx_ghost_determinism_locate(f,l)           ((void)(f), (void)(l), (int)0)
 #define asx_ghost_determinism_digest()              ((uint64_t)0)
 #define asx_ghost_determinism_event_count()         ((uint32_t)0)
 
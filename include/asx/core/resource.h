@@ -18,6 +18,7 @@
 #include <asx/asx_export.h>
 #include <asx/asx_status.h>
 #include <asx/asx_ids.h>
+#include <asx/asx_config.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,7 +32,8 @@ typedef enum {
     ASX_RESOURCE_REGION     = 0,
     ASX_RESOURCE_TASK       = 1,
     ASX_RESOURCE_OBLIGATION = 2,
-    ASX_RESOURCE_KIND_COUNT = 3
+    ASX_RESOURCE_ALLOCATOR  = 3,  /* blocks of an installed slab (asx/runtime/slab.h) */
+    ASX_RESOURCE_KIND_COUNT = 4
 } asx_resource_kind;
 
 /* ------------------------------------------------------------------ */
@@ -40,7 +42,7 @@ typedef enum {
 
 typedef struct {
     asx_resource_kind kind;
-    uint32_t capacity;      /* hard ceiling (compile-time constant) */
+    uint32_t capacity;      /* hard ceiling; allocator: blocks carved */
     uint32_t used;          /* currently allocated count */
     uint32_t remaining;     /* capacity - used */
 } asx_resource_snapshot;
@@ -49,7 +51,11 @@ typedef struct {
 /* Global resource queries                                             */
 /* ------------------------------------------------------------------ */
 
-/* Hard ceiling for a resource kind. Returns 0 for unknown kinds. */
+/* Hard ceiling for a resource kind: slots already backed by the arena,
+ * or the ASX_ARENA_MAX_* growth ceiling while the allocator hook can
+ * still grow it. ASX_RESOURCE_ALLOCATOR counts the blocks carved by
+ * the slab installed as the allocator hook (0 without one). Returns 0
+ * for unknown kinds. */
 ASX_API ASX_MUST_USE uint32_t asx_resource_capacity(asx_resource_kind kind);
 
 /* Current allocation count for a resource kind. */
@@ -67,20 +73,112 @@ ASX_API ASX_MUST_USE asx_status asx_resource_snapshot_get(
 /* Admission gate                                                      */
 /* ------------------------------------------------------------------ */
 
-/* Pre-check whether `count` more of `kind` can be allocated.
+/* Pre-check whether `count` more of `kind` can be allocated outside
+ * any claim: headroom less what outstanding claims hold.
  * Returns ASX_OK if admission is possible.
  * Returns ASX_E_RESOURCE_EXHAUSTED if insufficient headroom.
  * Returns ASX_E_INVALID_ARGUMENT for count==0 or unknown kind.
  *
- * This is a pure query — no side effects, no reservation. */
+ * This is a pure query — no side effects, no reservation. A check that
+ * must still hold at spawn time takes a claim instead. */
 ASX_API ASX_MUST_USE asx_status asx_resource_admit(
     asx_resource_kind kind, uint32_t count);
 
+/* ------------------------------------------------------------------ */
+/* Claims and per-region quotas                                        */
+/* ------------------------------------------------------------------ */
+
+/* Capacity claimed ahead of use. The slots behind a claim are backed
+ * when it is taken, and plain spawns and reserves treat them as taken,
+ * so each spend through asx_task_spawn_claimed or
+ * asx_obligation_reserve_claimed cannot fail for lack of slots.
+ * Members are read-only for callers; a token must not be copied. */
+typedef struct {
+    asx_region_id     region;
+    asx_resource_kind kind;
+    uint32_t          count;     /* claims not yet spent */
+} asx_resource_token;
+
+/* Claim count slots of kind (ASX_RESOURCE_TASK or
+ * ASX_RESOURCE_OBLIGATION) for region, all or nothing. The region's
+ * quota and admission policy are consulted here, once, rather than on
+ * each spend. Claims left unspent go back with
+ * asx_resource_token_release or when the region reaches CLOSED.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL out, count 0 or another kind,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE on invalid region,
+ *   ASX_E_REGION_NOT_OPEN / ASX_E_REGION_POISONED as for spawn,
+ *   ASX_E_ADMISSION_LIMIT past the region's quota,
+ *   ASX_E_RESOURCE_EXHAUSTED when the slots cannot be backed, or the
+ *   admission policy's refusal. */
+ASX_API ASX_MUST_USE asx_status asx_resource_claim(
+    asx_region_id region, asx_resource_kind kind, uint32_t count,
+    asx_resource_token *out);
+
+/* Return a token's unspent claims and zero its count. Safe on a spent
+ * token, NULL, or a token whose region has since closed. */
+ASX_API void asx_resource_token_release(asx_resource_token *token);
+
+/* Slots of kind held by outstanding claims across all regions. */
+ASX_API ASX_MUST_USE uint32_t asx_resource_claimed(asx_resource_kind kind);
+
+/* Cap the live plus claimed tasks (ASX_RESOURCE_TASK) or RESERVED plus
+ * claimed obligations (ASX_RESOURCE_OBLIGATION) of one region at
+ * limit, so one tenant cannot take the whole arena; 0 removes the
+ * quota. Spawns, reserves and claims past it fail with
+ * ASX_E_ADMISSION_LIMIT. A limit below what the region already holds
+ * refuses further admission without touching existing work.
+ * Returns ASX_E_INVALID_ARGUMENT for another kind,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE on invalid region. */
+ASX_API ASX_MUST_USE asx_status asx_resource_region_set_quota(
+    asx_region_id region, asx_resource_kind kind, uint32_t limit);
+
+/* ------------------------------------------------------------------ */
+/* Watermarks                                                          */
+/* ------------------------------------------------------------------ */
+
+typedef enum {
+    ASX_WATERMARK_HIGH = 0,  /* use rose to the high mark */
+    ASX_WATERMARK_LOW  = 1   /* use fell back to the low mark */
+} asx_watermark_edge;
+
+/* Called once per crossing, from inside the spawn, reserve or reclaim
+ * that moved use across the edge. It must not spawn tasks or reserve
+ * obligations itself; setting a region's admission policy to start
+ * shedding is the intended response. */
+typedef void (*asx_resource_watermark_fn)(void *ctx, asx_resource_kind kind,
+                                          asx_watermark_edge edge,
+                                          uint32_t used);
+
+/* Edges on the used count of one kind, with hysteresis: crossing high
+ * arms low and the reverse, so use hovering at one mark fires once. */
+typedef struct {
+    uint32_t                  low;   /* fire LOW when used falls to this */
+    uint32_t                  high;  /* fire HIGH when used rises to this */
+    asx_resource_watermark_fn fn;    /* may be NULL: trace event only */
+    void                     *ctx;
+} asx_resource_watermark;
+
+/* Install (or with NULL, remove) watermarks on ASX_RESOURCE_TASK or
+ * ASX_RESOURCE_OBLIGATION. Each crossing emits ASX_TRACE_WATERMARK and
+ * then calls fn. Between crossings a change of use costs one compare.
+ * The side starts from the current use and nothing fires for it.
+ * asx_runtime_reset removes every watermark.
+ * Returns ASX_E_INVALID_ARGUMENT for another kind, high 0, or
+ *   low >= high. */
+ASX_API ASX_MUST_USE asx_status asx_resource_set_watermark(
+    asx_resource_kind kind, const asx_resource_watermark *wm);
+
+/* 1 while kind's use is past its high mark and has not yet fallen to
+ * its low mark, else 0 (including without watermarks). */
+ASX_API ASX_MUST_USE int asx_resource_watermark_high(asx_resource_kind kind);
+
 /* ------------------------------------------------------------------ */
 /* Per-region resource queries                                         */
 /* ------------------------------------------------------------------ */
 
-/* Remaining capture arena bytes for a specific region.
+/* Remaining capture arena bytes for a specific region: its capture
+ * limit less the bytes handed out. Past the inline bytes, reaching it
+ * also needs the allocator to serve each chained block.
  * Returns ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE on invalid region. */
 ASX_API ASX_MUST_USE asx_status asx_resource_region_capture_remaining(
     asx_region_id region, uint32_t *out_bytes);
@@ -89,6 +187,42 @@ ASX_API ASX_MUST_USE asx_status asx_resource_region_capture_remaining(
 ASX_API ASX_MUST_USE asx_status asx_resource_region_cleanup_remaining(
     asx_region_id region, uint32_t *out_slots);
 
+/* ------------------------------------------------------------------ */
+/* Allocation accounting (ASX_ALLOC_PROFILE)                           */
+/* ------------------------------------------------------------------ */
+
+/* Counters for one call-site tag. bytes sums the sizes requested by
+ * every alloc and realloc; live_bytes is what tracked blocks hold now. */
+typedef struct {
+    uint64_t allocs;
+    uint64_t reallocs;
+    uint64_t frees;
+    uint64_t bytes;
+    uint64_t live_bytes;
+    uint64_t peak_bytes;
+} asx_alloc_site_stats;
+
+typedef struct {
+    asx_alloc_site_stats site[ASX_ALLOC_TAG_COUNT];
+    uint64_t live_bytes;      /* all tags */
+    uint64_t peak_bytes;      /* high-water mark of live_bytes */
+    uint64_t sealed_rejects;  /* alloc/realloc calls refused by the seal */
+    uint64_t unhooked;        /* codec allocations made without hooks */
+    uint64_t untracked;       /* blocks past ASX_ALLOC_PROFILE_BLOCKS */
+} asx_alloc_snapshot;
+
+/* Copy the allocation counters. A steady state after
+ * asx_runtime_seal_allocator shows as unchanged allocs/reallocs and
+ * zero sealed_rejects between two snapshots.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL output,
+ *   ASX_E_INVALID_STATE if built without ASX_ALLOC_PROFILE. */
+ASX_API ASX_MUST_USE asx_status asx_resource_alloc_snapshot_get(
+    asx_alloc_snapshot *out);
+
+/* Zero the call counters and restart the high-water marks at the live
+ * bytes. Live bytes are kept, since their blocks are still held. */
+ASX_API void asx_resource_alloc_snapshot_reset(void);
+
 /* ------------------------------------------------------------------ */
 /* Diagnostic                                                          */
 /* ------------------------------------------------------------------ */
@@ -96,6 +230,9 @@ ASX_API ASX_MUST_USE asx_status asx_resource_region_cleanup_remaining(
 /* Human-readable name for a resource kind. Never returns NULL. */
 ASX_API ASX_MUST_USE const char *asx_resource_kind_str(asx_resource_kind kind);
 
+/* Human-readable name for an allocation tag. Never returns NULL. */
+ASX_API ASX_MUST_USE const char *asx_alloc_tag_str(asx_alloc_tag tag);
+
 #ifdef __cplusplus
 }
 #endif
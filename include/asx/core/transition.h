@@ -5,6 +5,11 @@
  * against the authority table before execution. Illegal transitions produce
  * ASX_E_INVALID_TRANSITION.
  *
+ * Each table row is a packed 16-bit mask of the states a state may move
+ * to, bit n for state n (the same layout as a handle's state mask). The
+ * asx_*_transition_legal helpers are inline, so a check with a known
+ * target folds to one AND; the runtime and the ghost monitors use them.
+ *
  * SPDX-License-Identifier: MIT
  */
 
@@ -18,6 +23,70 @@
 /* State enums (asx_region_state, asx_task_state, asx_obligation_state)
  * are defined in asx_ids.h. */
 
+#define ASX_STATE_BIT(s) ((uint16_t)(1u << (unsigned)(s)))
+
+/* Region: Open -> Closing -> [Draining ->] Finalizing -> Closed */
+#define ASX_REGION_NEXT_OPEN       ASX_STATE_BIT(ASX_REGION_CLOSING)
+#define ASX_REGION_NEXT_CLOSING    (ASX_STATE_BIT(ASX_REGION_DRAINING) | \
+                                    ASX_STATE_BIT(ASX_REGION_FINALIZING))
+#define ASX_REGION_NEXT_DRAINING   ASX_STATE_BIT(ASX_REGION_FINALIZING)
+#define ASX_REGION_NEXT_FINALIZING ASX_STATE_BIT(ASX_REGION_CLOSED)
+#define ASX_REGION_NEXT_CLOSED     0u
+
+/* Task (T1..T13 in transition_tables.c) */
+#define ASX_TASK_NEXT_CREATED      (ASX_STATE_BIT(ASX_TASK_RUNNING) |          \
+                                    ASX_STATE_BIT(ASX_TASK_CANCEL_REQUESTED) | \
+                                    ASX_STATE_BIT(ASX_TASK_COMPLETED))
+#define ASX_TASK_NEXT_RUNNING      (ASX_STATE_BIT(ASX_TASK_CANCEL_REQUESTED) | \
+                                    ASX_STATE_BIT(ASX_TASK_COMPLETED))
+#define ASX_TASK_NEXT_CANCEL_REQUESTED                                         \
+                                   (ASX_STATE_BIT(ASX_TASK_CANCEL_REQUESTED) | \
+                                    ASX_STATE_BIT(ASX_TASK_CANCELLING) |       \
+                                    ASX_STATE_BIT(ASX_TASK_COMPLETED))
+#define ASX_TASK_NEXT_CANCELLING   (ASX_STATE_BIT(ASX_TASK_CANCELLING) |       \
+                                    ASX_STATE_BIT(ASX_TASK_FINALIZING) |       \
+                                    ASX_STATE_BIT(ASX_TASK_COMPLETED))
+#define ASX_TASK_NEXT_FINALIZING   (ASX_STATE_BIT(ASX_TASK_FINALIZING) |       \
+                                    ASX_STATE_BIT(ASX_TASK_COMPLETED))
+#define ASX_TASK_NEXT_COMPLETED    0u
+
+/* Obligation: Reserved -> Committed | Aborted | Leaked */
+#define ASX_OBLIGATION_NEXT_RESERVED (ASX_STATE_BIT(ASX_OBLIGATION_COMMITTED) | \
+                                      ASX_STATE_BIT(ASX_OBLIGATION_ABORTED) |   \
+                                      ASX_STATE_BIT(ASX_OBLIGATION_LEAKED))
+
+/* Nonzero if from -> to is legal; 0 for illegal or out-of-range states. */
+static inline int asx_region_transition_legal(asx_region_state from,
+                                              asx_region_state to)
+{
+    static const uint16_t next[5] = {
+        ASX_REGION_NEXT_OPEN, ASX_REGION_NEXT_CLOSING, ASX_REGION_NEXT_DRAINING,
+        ASX_REGION_NEXT_FINALIZING, ASX_REGION_NEXT_CLOSED
+    };
+    return (unsigned)from < 5u && (unsigned)to < 16u &&
+           (next[from] & ASX_STATE_BIT(to)) != 0;
+}
+
+static inline int asx_task_transition_legal(asx_task_state from,
+                                            asx_task_state to)
+{
+    static const uint16_t next[6] = {
+        ASX_TASK_NEXT_CREATED, ASX_TASK_NEXT_RUNNING,
+        ASX_TASK_NEXT_CANCEL_REQUESTED, ASX_TASK_NEXT_CANCELLING,
+        ASX_TASK_NEXT_FINALIZING, ASX_TASK_NEXT_COMPLETED
+    };
+    return (unsigned)from < 6u && (unsigned)to < 16u &&
+           (next[from] & ASX_STATE_BIT(to)) != 0;
+}
+
+static inline int asx_obligation_transition_legal(asx_obligation_state from,
+                                                  asx_obligation_state to)
+{
+    /* Only Reserved has successors */
+    return from == ASX_OBLIGATION_RESERVED && (unsigned)to < 16u &&
+           (ASX_OBLIGATION_NEXT_RESERVED & ASX_STATE_BIT(to)) != 0;
+}
+
 /* Validate a region state transition. Returns ASX_OK or ASX_E_INVALID_TRANSITION. */
 ASX_API ASX_MUST_USE asx_status asx_region_transition_check(asx_region_state from, asx_region_state to);
 
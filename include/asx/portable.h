@@ -3,7 +3,9 @@
  *
  * Centralizes all multi-byte load/store operations into audited,
  * byte-by-byte helpers that are safe on any alignment and endianness.
- * No pointer casts, no platform-specific intrinsics, pure C99.
+ * No pointer casts, no platform-specific intrinsics, pure C99. The
+ * bulk array helpers copy with memcpy where the host byte order is
+ * known to match the wire order.
  *
  * Wire formats:
  *   - Binary fixture codec: big-endian (network byte order)
@@ -17,7 +19,9 @@
 #ifndef ASX_PORTABLE_H
 #define ASX_PORTABLE_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,7 +31,9 @@ extern "C" {
  * Compile-time endian detection (informational only)
  *
  * The load/store helpers work correctly regardless of host byte order.
- * These defines exist for diagnostics and compile-time assertions.
+ * These defines exist for diagnostics and compile-time assertions;
+ * ASX_ENDIAN_DETECTED is 1 only when the compiler reported the order,
+ * and only then do the bulk helpers take the memcpy path.
  * ------------------------------------------------------------------- */
 
 #if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && \
@@ -45,6 +51,10 @@ extern "C" {
   /* Fallback: assume little-endian (x86/ARM default) */
   #define ASX_ENDIAN_LITTLE 1
   #define ASX_ENDIAN_BIG    0
+  #define ASX_ENDIAN_DETECTED 0
+#endif
+#ifndef ASX_ENDIAN_DETECTED
+  #define ASX_ENDIAN_DETECTED 1
 #endif
 
 /* -------------------------------------------------------------------
@@ -143,6 +153,108 @@ static inline void asx_store_be_u64(uint8_t *p, uint64_t v)
     asx_store_be_u32(p + 4, (uint32_t)(v & 0xFFFFFFFFu));
 }
 
+/* -------------------------------------------------------------------
+ * Bulk array helpers
+ *
+ * Store count host values to dst, or load count values from src, in
+ * the helper's wire order; buffers need no alignment. A host of the
+ * same (detected) byte order copies with one memcpy. Otherwise each
+ * value goes through the scalar helper; the loop has no carried
+ * state, so GCC and Clang turn it into byte-shuffle vector code at
+ * -O2 and above without any intrinsics here.
+ * ------------------------------------------------------------------- */
+
+#define ASX_ENDIAN_LE_NATIVE (ASX_ENDIAN_DETECTED && ASX_ENDIAN_LITTLE)
+#define ASX_ENDIAN_BE_NATIVE (ASX_ENDIAN_DETECTED && ASX_ENDIAN_BIG)
+
+static inline void asx_store_le_u32_array(uint8_t *dst, const uint32_t *src,
+                                          uint32_t count)
+{
+#if ASX_ENDIAN_LE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 4u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) asx_store_le_u32(dst + (size_t)i * 4u, src[i]);
+#endif
+}
+
+static inline void asx_load_le_u32_array(uint32_t *dst, const uint8_t *src,
+                                         uint32_t count)
+{
+#if ASX_ENDIAN_LE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 4u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) dst[i] = asx_load_le_u32(src + (size_t)i * 4u);
+#endif
+}
+
+static inline void asx_store_le_u64_array(uint8_t *dst, const uint64_t *src,
+                                          uint32_t count)
+{
+#if ASX_ENDIAN_LE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 8u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) asx_store_le_u64(dst + (size_t)i * 8u, src[i]);
+#endif
+}
+
+static inline void asx_load_le_u64_array(uint64_t *dst, const uint8_t *src,
+                                         uint32_t count)
+{
+#if ASX_ENDIAN_LE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 8u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) dst[i] = asx_load_le_u64(src + (size_t)i * 8u);
+#endif
+}
+
+static inline void asx_store_be_u32_array(uint8_t *dst, const uint32_t *src,
+                                          uint32_t count)
+{
+#if ASX_ENDIAN_BE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 4u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) asx_store_be_u32(dst + (size_t)i * 4u, src[i]);
+#endif
+}
+
+static inline void asx_load_be_u32_array(uint32_t *dst, const uint8_t *src,
+                                         uint32_t count)
+{
+#if ASX_ENDIAN_BE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 4u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) dst[i] = asx_load_be_u32(src + (size_t)i * 4u);
+#endif
+}
+
+static inline void asx_store_be_u64_array(uint8_t *dst, const uint64_t *src,
+                                          uint32_t count)
+{
+#if ASX_ENDIAN_BE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 8u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) asx_store_be_u64(dst + (size_t)i * 8u, src[i]);
+#endif
+}
+
+static inline void asx_load_be_u64_array(uint64_t *dst, const uint8_t *src,
+                                         uint32_t count)
+{
+#if ASX_ENDIAN_BE_NATIVE
+    if (count != 0u) memcpy(dst, src, (size_t)count * 8u);
+#else
+    uint32_t i;
+    for (i = 0; i < count; i++) dst[i] = asx_load_be_u64(src + (size_t)i * 8u);
+#endif
+}
+
 /* -------------------------------------------------------------------
  * Byte-order canary for runtime endian verification
  *
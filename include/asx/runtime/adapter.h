@@ -165,6 +165,32 @@ ASX_API void asx_adapter_dispatch(asx_adapter_domain domain,
                                    const void *domain_ctx,
                                    asx_adapter_decision *out);
 
+/* -------------------------------------------------------------------
+ * Compiled dispatch tables (opt-in)
+ *
+ * asx_adapter_dispatch_tables_build compiles each path whose decision
+ * depends only on the load percent (the CORE fallback, HFT, automotive
+ * without deadline history, router at ASX_CLASS_R2) into a
+ * load-percent -> decision table with precomputed hashes. While
+ * enabled, asx_adapter_dispatch on those paths is a table index with
+ * results identical to the reference path; another resource class, a
+ * tracker with deadlines, loads above capacity, zero capacity, a shed
+ * count clamped by used, or a digest mode changed after the build
+ * still run the reference path. The isomorphism proofs additionally
+ * fail wherever a table disagrees with the reference.
+ * ------------------------------------------------------------------- */
+
+/* Build the tables and enable them once asx_adapter_prove_isomorphism_sweep
+ * passes for every domain. ASX_E_INVALID_STATE if it does not (tables
+ * stay off). */
+ASX_API ASX_MUST_USE asx_status asx_adapter_dispatch_tables_build(void);
+
+/* Disable the tables; dispatch returns to the reference path. */
+ASX_API void asx_adapter_dispatch_tables_clear(void);
+
+/* Nonzero while the tables serve asx_adapter_dispatch. */
+ASX_API int asx_adapter_dispatch_tables_enabled(void);
+
 /* -------------------------------------------------------------------
  * Isomorphism proof API
  *
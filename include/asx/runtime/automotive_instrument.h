@@ -21,6 +21,7 @@
 #include <asx/asx_export.h>
 #include <asx/asx_status.h>
 #include <asx/asx_ids.h>
+#include <asx/time/timer_wheel.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -33,8 +34,14 @@ extern "C" {
  * Tracks deadline hits/misses, worst-case margin, and running
  * statistics for compliance reporting. Margin is defined as
  * (deadline - completion_time) in nanoseconds; negative = miss.
+ *
+ * Alongside the cumulative counts, the last ASX_AUTO_DEADLINE_WINDOW
+ * outcomes are kept as a ring of miss bits in a single word, so the
+ * sliding-window miss rate is maintained in O(1) per record.
  * ------------------------------------------------------------------- */
 
+#define ASX_AUTO_DEADLINE_WINDOW  64u   /* outcomes per window (bits) */
+
 typedef struct {
     uint32_t total_deadlines;   /* total deadlines evaluated */
     uint32_t deadline_hits;     /* completed before deadline */
@@ -43,6 +50,9 @@ typedef struct {
     int64_t  best_margin_ns;    /* most positive margin (best hit) */
     uint64_t total_margin_ns;   /* sum of absolute margins for mean */
     uint32_t total_margin_count;/* count for mean margin computation */
+    uint64_t window_bits;       /* 1 = miss; bit 0 is the newest outcome */
+    uint32_t window_len;        /* outcomes in the window (<= WINDOW) */
+    uint32_t window_misses;     /* set bits in window_bits */
 } asx_auto_deadline_tracker;
 
 /* Initialize a deadline tracker. */
@@ -61,24 +71,90 @@ ASX_API void asx_auto_deadline_record(asx_auto_deadline_tracker *dt,
 ASX_API uint32_t asx_auto_deadline_miss_rate(
     const asx_auto_deadline_tracker *dt);
 
+/* Miss rate over the last ASX_AUTO_DEADLINE_WINDOW outcomes, in the
+ * same pct*100 units. Returns 0 if no deadlines recorded. */
+ASX_API uint32_t asx_auto_deadline_window_miss_rate(
+    const asx_auto_deadline_tracker *dt);
+
 /* Reset the deadline tracker. */
 ASX_API void asx_auto_deadline_reset(asx_auto_deadline_tracker *dt);
 
+/* -------------------------------------------------------------------
+ * Per-class deadline table
+ *
+ * One tracker per task class (or region), indexed 0..CLASSES-1, so a
+ * class missing every deadline is not hidden by the aggregate rate.
+ * Each class may carry its own miss-rate limit for the compliance gate.
+ * ------------------------------------------------------------------- */
+
+#define ASX_AUTO_DEADLINE_CLASSES  8u
+
+typedef struct {
+    asx_auto_deadline_tracker classes[ASX_AUTO_DEADLINE_CLASSES];
+    uint32_t max_miss_rate_pct100[ASX_AUTO_DEADLINE_CLASSES]; /* 0: gate's */
+} asx_auto_deadline_table;
+
+/* Initialize a class table: empty trackers, gate-default limits. */
+ASX_API void asx_auto_deadline_table_init(asx_auto_deadline_table *table);
+
+/* Set a class's window miss-rate limit (pct*100); 0 reverts to the
+ * gate's max_miss_rate_pct100.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL or an unknown class. */
+ASX_API ASX_MUST_USE asx_status asx_auto_deadline_table_set_limit(
+    asx_auto_deadline_table *table, uint32_t class_index,
+    uint32_t max_miss_rate_pct100);
+
+/* Record a deadline result for one class.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL or an unknown class. */
+ASX_API ASX_MUST_USE asx_status asx_auto_deadline_table_record(
+    asx_auto_deadline_table *table, uint32_t class_index,
+    uint64_t deadline_ns, uint64_t actual_ns);
+
+/* Tracker for one class, or NULL for NULL or an unknown class. */
+ASX_API const asx_auto_deadline_tracker *asx_auto_deadline_table_get(
+    const asx_auto_deadline_table *table, uint32_t class_index);
+
 /* -------------------------------------------------------------------
  * Watchdog monitor — checkpoint interval tracking
  *
  * Tracks the interval between successive checkpoint calls for a
  * monitored entity. If the interval exceeds the configured
  * watchdog_period_ns, a watchdog violation is recorded.
+ *
+ * Timer mode (asx_auto_watchdog_arm_timer) replaces polling: each
+ * checkpoint re-arms one timer on asx_timer_wheel_global() through
+ * asx_timer_update, and a supervisor task running
+ * asx_auto_watchdog_poll stays parked on it. Nothing is checked per
+ * loop; when the timer fires (the global wheel is collected, as by
+ * asx_scheduler_wait_idle) the task escalates once per overdue period
+ * until the next checkpoint.
  * ------------------------------------------------------------------- */
 
-typedef struct {
+struct asx_auto_watchdog_s;
+
+/* Escalation on expiry. overdue_ns is how long the watchdog has gone
+ * without a checkpoint past its period. */
+typedef void (*asx_auto_watchdog_escalate_fn)(void *ctx,
+                                              struct asx_auto_watchdog_s *wd,
+                                              uint64_t overdue_ns);
+
+typedef struct asx_auto_watchdog_s {
     uint64_t watchdog_period_ns;     /* max allowed interval between checkpoints */
     uint64_t last_checkpoint_ns;     /* timestamp of last checkpoint */
     uint32_t total_checkpoints;      /* total checkpoints recorded */
     uint32_t violations;             /* intervals exceeding watchdog_period */
     uint64_t worst_interval_ns;      /* longest observed interval */
     int      armed;                  /* 1 if last_checkpoint_ns is valid */
+    /* Timer mode (private except escalations and timer_failures) */
+    asx_auto_watchdog_escalate_fn escalate;
+    void            *escalate_ctx;
+    asx_timer_handle timer;
+    uint64_t         timer_deadline_ns; /* deadline of the live timer */
+    uint32_t         escalations;       /* expiries escalated */
+    uint32_t         timer_failures;    /* re-arms the wheel refused */
+    uint8_t          timer_mode;
+    uint8_t          has_timer;
+    uint8_t          escalated;         /* since the last checkpoint */
 } asx_auto_watchdog;
 
 /* Initialize a watchdog monitor with the given period. */
@@ -94,9 +170,30 @@ ASX_API void asx_auto_watchdog_checkpoint(asx_auto_watchdog *wd,
 ASX_API int asx_auto_watchdog_would_trigger(const asx_auto_watchdog *wd,
                                              uint64_t now_ns);
 
-/* Reset the watchdog monitor. Preserves the period. */
+/* Reset the watchdog monitor. Preserves the period; leaves timer
+ * mode (cancelling the timer). */
 ASX_API void asx_auto_watchdog_reset(asx_auto_watchdog *wd);
 
+/* Switch to timer mode with an escalation callback (may be NULL: the
+ * expiry is still counted and audited). If a checkpoint was already
+ * recorded the timer is armed from it, otherwise from the next one.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL wd or a zero period, or the
+ * asx_timer_update error. */
+ASX_API ASX_MUST_USE asx_status asx_auto_watchdog_arm_timer(
+    asx_auto_watchdog *wd, asx_auto_watchdog_escalate_fn escalate,
+    void *escalate_ctx);
+
+/* Leave timer mode and cancel the timer; a parked supervisor task is
+ * woken and completes. */
+ASX_API void asx_auto_watchdog_disarm_timer(asx_auto_watchdog *wd);
+
+/* Supervisor task poll function; user_data is the watchdog. Parks on
+ * the watchdog's timer and returns ASX_E_PENDING. On expiry it counts
+ * a violation, logs ASX_AUDIT_WATCHDOG_VIOLATION to the global audit
+ * ring (entity: the task), calls the escalation and re-arms one period
+ * later. Returns ASX_OK once the watchdog leaves timer mode. */
+ASX_API asx_status asx_auto_watchdog_poll(void *user_data, asx_task_id self);
+
 /* -------------------------------------------------------------------
  * Degraded-mode audit ring — bounded event log
  *
@@ -161,6 +258,95 @@ ASX_API const char *asx_audit_kind_str(asx_audit_kind kind);
 /* Reset the audit ring. */
 ASX_API void asx_auto_audit_reset(asx_auto_audit_ring *ring);
 
+/* -------------------------------------------------------------------
+ * Audit persistence — page-batched, CRC-protected appends
+ *
+ * A persistence stage follows an audit ring and packs its new entries
+ * into page-sized records, handing only full pages to a storage hook
+ * so flash sees one write per ASX_AUTO_AUDIT_PAGE_ENTRIES events.
+ * asx_auto_audit_record is untouched: the stage pulls from the ring
+ * when flushed, normally from a task running
+ * asx_auto_audit_persist_poll, so storage latency stays off the
+ * recording path. Entries overwritten in the ring before a flush are
+ * counted as lost.
+ *
+ * Page format (little-endian, ASX_AUTO_AUDIT_PAGE_BYTES):
+ *   [0..3]   magic       "ASXa" (0x41535861)
+ *   [4..7]   page_seq    position in the log, from 0
+ *   [8..9]   entry_count 1..ASX_AUTO_AUDIT_PAGE_ENTRIES
+ *   [10..11] version     1
+ *   [12..15] crc         CRC32C of bytes [0..11] and the entries
+ *   Per entry (32 bytes): seq u32, kind u32, timestamp_ns u64,
+ *   entity_id u64, detail i64. Unused bytes are 0xFF (erased flash).
+ * ------------------------------------------------------------------- */
+
+#define ASX_AUTO_AUDIT_PAGE_BYTES    256u
+#define ASX_AUTO_AUDIT_PAGE_MAGIC    0x41535861u  /* "ASXa" */
+#define ASX_AUTO_AUDIT_PAGE_VERSION  1u
+#define ASX_AUTO_AUDIT_PAGE_HEADER   16u
+#define ASX_AUTO_AUDIT_PAGE_RECORD   32u
+#define ASX_AUTO_AUDIT_PAGE_ENTRIES \
+    ((ASX_AUTO_AUDIT_PAGE_BYTES - ASX_AUTO_AUDIT_PAGE_HEADER) / ASX_AUTO_AUDIT_PAGE_RECORD)
+
+/* Append one page to storage. page is only valid for the call. A
+ * non-OK return keeps the page; it is offered again on the next flush. */
+typedef asx_status (*asx_auto_audit_store_fn)(void *ctx,
+                                              const uint8_t *page,
+                                              uint32_t len);
+
+/* Caller-owned stage. Members are private except the counters. */
+typedef struct {
+    const asx_auto_audit_ring *ring;
+    asx_auto_audit_store_fn    store;
+    void                      *store_ctx;
+    uint8_t  page[ASX_AUTO_AUDIT_PAGE_BYTES];
+    uint32_t staged;            /* entries in page */
+    uint32_t next_seq;          /* next ring sequence to stage */
+    uint32_t page_seq;          /* sequence of the page being filled */
+    uint32_t pages_written;     /* pages the store accepted */
+    uint32_t lost;              /* entries overwritten before staging */
+    uint32_t store_failures;    /* store calls that returned non-OK */
+    int      stopping;
+} asx_auto_audit_persist;
+
+/* Follow ring from its next entry; entries already in the ring (such
+ * as those just recovered) are not persisted again. first_page is the
+ * page_seq to continue from: the pages recovered, or 0 for a new log.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL p, ring or store. */
+ASX_API ASX_MUST_USE asx_status asx_auto_audit_persist_init(
+    asx_auto_audit_persist *p, const asx_auto_audit_ring *ring,
+    asx_auto_audit_store_fn store, void *store_ctx, uint32_t first_page);
+
+/* Stage new ring entries and store every page that fills. With sync
+ * nonzero a partly filled page is stored too (and the next entry
+ * starts a new page), trading a flash write for durability.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL, or the store's
+ * error, in which case the page stays staged. */
+ASX_API ASX_MUST_USE asx_status asx_auto_audit_persist_flush(
+    asx_auto_audit_persist *p, int sync);
+
+/* Ask the flush task to store what remains and complete. */
+ASX_API void asx_auto_audit_persist_stop(asx_auto_audit_persist *p);
+
+/* Task poll function; user_data is the stage. Each poll flushes full
+ * pages and returns ASX_E_PENDING; after asx_auto_audit_persist_stop
+ * it syncs and returns ASX_OK once the store accepted everything. A
+ * failing store is retried on later polls. */
+ASX_API asx_status asx_auto_audit_persist_poll(void *user_data,
+                                               asx_task_id self);
+
+/* Rebuild ring from a persisted log of pages laid end to end, keeping
+ * each entry's original sequence number; the ring is reset first and
+ * keeps the newest ASX_AUTO_AUDIT_RING_SIZE entries. Decoding stops at
+ * the image end or an erased page (no magic). *out_pages (may be NULL)
+ * receives the pages decoded.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL, or
+ * ASX_E_REPLAY_MISMATCH at a page with a bad CRC, version, count or
+ * page_seq (a torn write); the pages before it are kept. */
+ASX_API ASX_MUST_USE asx_status asx_auto_audit_recover(
+    const uint8_t *image, uint32_t len, asx_auto_audit_ring *ring,
+    uint32_t *out_pages);
+
 /* -------------------------------------------------------------------
  * Compliance gate — deadline and watchdog threshold evaluation
  *
@@ -180,20 +366,27 @@ typedef struct {
     uint32_t actual_violations;      /* actual watchdog violations */
     uint32_t actual_checkpoints;     /* actual checkpoint count */
     uint32_t violation_mask;         /* bitmask of failed checks */
+    uint32_t failed_classes;         /* bit per class over its limit */
+    uint32_t worst_class_miss_rate;  /* highest class window rate (pct*100) */
 } asx_auto_compliance_result;
 
 /* Violation bitmask bits */
 #define ASX_COMPLIANCE_DEADLINE_RATE  (1u << 0)
 #define ASX_COMPLIANCE_WATCHDOG       (1u << 1)
 #define ASX_COMPLIANCE_CHECKPOINT_MIN (1u << 2)
+#define ASX_COMPLIANCE_CLASS_RATE     (1u << 3)
 
 /* Initialize a compliance gate with default automotive thresholds. */
 ASX_API void asx_auto_compliance_gate_init(asx_auto_compliance_gate *gate);
 
-/* Evaluate compliance against deadline tracker and watchdog state. */
+/* Evaluate compliance against deadline tracker and watchdog state.
+ * dt is gated on its cumulative rate. Each class in classes (NULL to
+ * skip) that has recorded deadlines is gated separately on its window
+ * rate against its own limit, or the gate's when it has none. */
 ASX_API void asx_auto_compliance_evaluate(
     const asx_auto_compliance_gate *gate,
     const asx_auto_deadline_tracker *dt,
+    const asx_auto_deadline_table *classes,
     const asx_auto_watchdog *wd,
     asx_auto_compliance_result *result);
 
@@ -213,6 +406,9 @@ ASX_API asx_auto_deadline_tracker *asx_auto_deadline_global(void);
 /* Get pointer to the global watchdog monitor. */
 ASX_API asx_auto_watchdog *asx_auto_watchdog_global(void);
 
+/* Get pointer to the global per-class deadline table. */
+ASX_API asx_auto_deadline_table *asx_auto_deadline_classes_global(void);
+
 /* Get pointer to the global audit ring. */
 ASX_API asx_auto_audit_ring *asx_auto_audit_global(void);
 
@@ -222,6 +418,14 @@ ASX_API void asx_auto_record_deadline(uint64_t deadline_ns,
                                        uint64_t actual_ns,
                                        uint64_t entity_id);
 
+/* Convenience: as asx_auto_record_deadline, and also record the
+ * result in class_index of the global class table.
+ * Returns ASX_E_INVALID_ARGUMENT (recording nothing) for an unknown
+ * class. */
+ASX_API ASX_MUST_USE asx_status asx_auto_record_deadline_class(
+    uint32_t class_index, uint64_t deadline_ns, uint64_t actual_ns,
+    uint64_t entity_id);
+
 /* Convenience: record a checkpoint in the global watchdog
  * and auto-log violations to the audit ring. */
 ASX_API void asx_auto_record_checkpoint(uint64_t now_ns,
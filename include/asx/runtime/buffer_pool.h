@@ -0,0 +1,128 @@
+/*
+ * asx/runtime/buffer_pool.h — refcounted fixed-size I/O buffers
+ *
+ * A pool of count buffers of one size, carved from a single block
+ * taken through the allocator hooks, for moving received data from
+ * the reactor to consumer tasks without a copy. A buffer is named by
+ * a 64-bit handle, so it travels through a channel as an ordinary
+ * value; whoever holds a reference reads the bytes in place. Each
+ * handle carries its buffer's generation, so a handle kept after the
+ * last release is refused rather than aliasing the buffer's next use.
+ *
+ * References: acquire returns a buffer holding one; retain adds one
+ * per extra holder (e.g. per broadcast subscriber); each holder
+ * releases its own, and the last release returns the buffer.
+ *
+ * Because the storage is one contiguous block, the POSIX io_uring
+ * backend registers the whole pool as a single fixed buffer
+ * (asx_platform_uring_register_pool) and reads into any buffer with
+ * IORING_OP_READ_FIXED, skipping the per-read page pinning.
+ *
+ * In non-deterministic GCC/Clang builds the free list is guarded by a
+ * spin lock and reference counts are atomic, so buffers may be
+ * released on parallel-scheduler workers. Deterministic builds run
+ * single-threaded and use neither.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_BUFFER_POOL_H
+#define ASX_RUNTIME_BUFFER_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_config.h>
+#include <asx/core/resource.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Buffers are this many bytes apart and aligned to it */
+#define ASX_BUFFER_ALIGN 64u
+
+/* Never a valid buffer handle */
+#define ASX_BUFFER_NONE ((uint64_t)0)
+
+/* 1 when the free-list lock and atomic reference counts are compiled in */
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define ASX_BUFFER_THREADED 1
+#else
+#define ASX_BUFFER_THREADED 0
+#endif
+
+/* Per-buffer bookkeeping. Members are private. */
+typedef struct {
+    uint32_t refs;
+    uint32_t len;          /* valid bytes */
+    uint32_t generation;   /* bumped when the buffer is returned */
+    uint32_t next;         /* free list */
+} asx_buffer_slot;
+
+/* Caller-owned pool. Members are private. */
+typedef struct asx_buffer_pool {
+    void     *block;       /* as allocated */
+    uint8_t  *base;        /* first buffer, ASX_BUFFER_ALIGN aligned */
+    asx_buffer_slot *slots;
+    uint32_t  buffer_size; /* rounded up to ASX_BUFFER_ALIGN */
+    uint32_t  count;
+    uint32_t  free_head;
+    uint32_t  free_count;
+    uint32_t  lock;
+} asx_buffer_pool;
+
+/* Allocate count buffers of at least buffer_size bytes in one block
+ * tagged ASX_ALLOC_TAG_BUFFER.
+ * ASX_E_INVALID_ARGUMENT for NULL, a zero size or count, or a pool
+ * larger than 1 GiB (the io_uring fixed-buffer limit), else the
+ * allocator's status. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_pool_init(asx_buffer_pool *pool,
+                                                     uint32_t buffer_size,
+                                                     uint32_t count);
+
+/* Free the block. ASX_E_INVALID_STATE while any buffer is held. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_pool_destroy(asx_buffer_pool *pool);
+
+/* Take a free buffer holding one reference and no valid bytes.
+ * ASX_E_RESOURCE_EXHAUSTED when every buffer is held. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_acquire(asx_buffer_pool *pool,
+                                                   uint64_t *out_handle);
+
+/* Add a reference for another holder. ASX_E_INVALID_STATE for a
+ * released or foreign handle. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_retain(asx_buffer_pool *pool,
+                                                  uint64_t handle);
+
+/* Drop one reference; the last returns the buffer to the pool and
+ * makes every copy of handle stale. ASX_E_INVALID_STATE for a
+ * released or foreign handle. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_release(asx_buffer_pool *pool,
+                                                   uint64_t handle);
+
+/* The buffer's storage (*out_data, buffer_size bytes) and valid
+ * length. Either output may be NULL. ASX_E_INVALID_STATE for a
+ * released or foreign handle. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_get(const asx_buffer_pool *pool,
+                                               uint64_t handle,
+                                               uint8_t **out_data,
+                                               uint32_t *out_len);
+
+/* Record how many bytes are valid, e.g. after a read completes.
+ * ASX_E_INVALID_ARGUMENT if len exceeds the buffer size. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_set_len(asx_buffer_pool *pool,
+                                                   uint64_t handle,
+                                                   uint32_t len);
+
+/* Buffer utilization as ASX_RESOURCE_ALLOCATOR: capacity is count,
+ * used is buffers held, remaining is buffers free.
+ * ASX_E_INVALID_ARGUMENT for NULL. */
+ASX_API ASX_MUST_USE asx_status asx_buffer_pool_snapshot(asx_buffer_pool *pool,
+                                                         asx_resource_snapshot *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_BUFFER_POOL_H */
@@ -0,0 +1,93 @@
+/*
+ * asx/runtime/digest.h — shared 64-bit digest primitives
+ *
+ * One home for the hashes behind trace, telemetry, hindsight and
+ * adapter decision digests. Two mixers are available:
+ *
+ *   FNV1A   — byte-at-a-time FNV-1a over host-order field bytes. The
+ *             compatibility mode: every stored fixture uses it.
+ *   WORD64  — one multiply-xorshift step per 64-bit word over field
+ *             values. About 8x fewer multiplies per event and
+ *             independent of host byte order.
+ *
+ * CRC32C is also provided for integrity footers (binary codec frames).
+ *
+ * The mode is selected per digest domain and defaults to FNV1A
+ * everywhere. Trace and telemetry latch their domain's mode at their
+ * next reset, so select modes before a scenario starts. Trace binary
+ * exports record a WORD64 trace digest in the header flags, so import
+ * and chunk verification check each buffer under the mode that wrote it.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_DIGEST_H
+#define ASX_RUNTIME_DIGEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ASX_DIGEST_FNV1A  = 0,  /* byte-at-a-time FNV-1a (compatibility) */
+    ASX_DIGEST_WORD64 = 1   /* word-at-a-time multiply-xorshift */
+} asx_digest_mode;
+
+typedef enum {
+    ASX_DIGEST_DOMAIN_TRACE     = 0,  /* trace ring, replay, snapshots */
+    ASX_DIGEST_DOMAIN_TELEMETRY = 1,  /* telemetry rolling digest */
+    ASX_DIGEST_DOMAIN_HINDSIGHT = 2,  /* hindsight ring digest */
+    ASX_DIGEST_DOMAIN_ADAPTER   = 3,  /* adapter decision digests */
+    ASX_DIGEST_DOMAIN_COUNT     = 4
+} asx_digest_domain;
+
+#define ASX_DIGEST_FNV_PRIME  0x00000100000001B3ULL
+#define ASX_DIGEST_WORD_MUL   0x9E3779B97F4A7C15ULL
+
+/* Fold one 64-bit word into a WORD64 digest. */
+static inline uint64_t asx_digest_word(uint64_t hash, uint64_t word)
+{
+    hash ^= word;
+    hash *= ASX_DIGEST_WORD_MUL;
+    return hash ^ (hash >> 32);
+}
+
+/* Select the digest mode for a domain.
+ * Returns ASX_E_INVALID_ARGUMENT for an unknown domain or mode. */
+ASX_API asx_status asx_digest_set_mode(asx_digest_domain domain,
+                                       asx_digest_mode mode);
+
+/* Current mode of a domain (FNV1A for an unknown domain). */
+ASX_API asx_digest_mode asx_digest_get_mode(asx_digest_domain domain);
+
+/* Return every domain to FNV1A. */
+ASX_API void asx_digest_reset_modes(void);
+
+/* Fold len bytes into an FNV-1a digest (host byte order). */
+ASX_API uint64_t asx_digest_fnv1a(uint64_t hash, const void *data,
+                                  uint32_t len);
+
+/* Fold count 32-bit values into a digest under mode. FNV1A mixes each
+ * value's host-order bytes; WORD64 packs them two per word. */
+ASX_API uint64_t asx_digest_u32s(asx_digest_mode mode, uint64_t hash,
+                                 const uint32_t *vals, uint32_t count);
+
+/* Fold len bytes into a digest under mode. WORD64 reads the bytes as
+ * little-endian words, the last one zero-padded and tagged with len. */
+ASX_API uint64_t asx_digest_bytes(asx_digest_mode mode, uint64_t hash,
+                                  const void *data, uint32_t len);
+
+/* Continue a CRC32C (Castagnoli) over len bytes; start from 0 and feed
+ * the previous result to chain chunks. Slice-by-8, no hardware needed. */
+ASX_API uint32_t asx_digest_crc32c(uint32_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_DIGEST_H */
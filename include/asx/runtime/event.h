@@ -3,8 +3,18 @@
  *
  * Extends the scheduler event model with operation-level lifecycle events
  * and a running FNV-1a hash chain for deterministic replay verification.
- * The hash chain digests event (kind, entity, sequence) tuples, producing
- * a single 64-bit fingerprint that captures the full execution ordering.
+ * The hash chain digests event (kind, entity, parent, status, sequence)
+ * tuples, producing a single 64-bit fingerprint that captures the full
+ * execution ordering.
+ *
+ * Events go to a preallocated ring of ASX_EVENT_LOG_CAPACITY records;
+ * once it is full the oldest are overwritten, while the chain and the
+ * count keep covering every event since reset. Each emit is O(1). The
+ * chain value is also kept at a checkpoint every
+ * asx_event_checkpoint_interval() events (the interval doubles whenever
+ * the checkpoint table fills), so replay verification bisects on
+ * checkpoints and compares records only within the one interval where
+ * the chains part.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -55,7 +65,9 @@ typedef struct {
 } asx_event_record;
 
 enum {
-    ASX_EVENT_LOG_CAPACITY = 512u
+    ASX_EVENT_LOG_CAPACITY        = 512u,
+    ASX_EVENT_CHECKPOINT_INTERVAL = 32u,   /* events per checkpoint at reset */
+    ASX_EVENT_CHECKPOINT_CAPACITY = 256u
 };
 
 /* ------------------------------------------------------------------ */
@@ -74,7 +86,8 @@ ASX_API uint32_t asx_event_emit(asx_event_kind kind,
 /* Total events emitted since last reset. */
 ASX_API uint32_t asx_event_log_count(void);
 
-/* Read event at index (0-based). Returns 1 on success, 0 on OOB. */
+/* Read event at index (0-based, the event's sequence). Returns 1 on
+ * success, 0 if index was not emitted or has left the ring. */
 ASX_API int asx_event_log_get(uint32_t index, asx_event_record *out);
 
 /* ------------------------------------------------------------------ */
@@ -84,6 +97,20 @@ ASX_API int asx_event_log_get(uint32_t index, asx_event_record *out);
 /* Read the running hash chain digest. */
 ASX_API uint64_t asx_event_hash_chain(void);
 
+/* Hash chain of events[0..count): what asx_event_hash_chain reports
+ * after emitting them from reset. */
+ASX_API uint64_t asx_event_hash_chain_of(const asx_event_record *events,
+                                         uint32_t count);
+
+/* Events per checkpoint: ASX_EVENT_CHECKPOINT_INTERVAL times a power
+ * of two. */
+ASX_API uint32_t asx_event_checkpoint_interval(void);
+
+/* Copy up to capacity checkpoints; out[k] is the chain after the first
+ * (k + 1) * asx_event_checkpoint_interval() events. Returns the number
+ * held. A reference run exports these for asx_event_replay_locate. */
+ASX_API uint32_t asx_event_checkpoints(uint64_t *out, uint32_t capacity);
+
 /* ------------------------------------------------------------------ */
 /* Event serialization                                                 */
 /* ------------------------------------------------------------------ */
@@ -113,12 +140,35 @@ typedef struct {
  * Compare recorded events against an expected sequence.
  * Returns ASX_OK if identical, ASX_E_EQUIVALENCE_MISMATCH if not.
  * Populates divergence with first-divergence diagnostics.
+ *
+ * Hashes expected once; equal chains and counts match without a record
+ * comparison. If the first divergent event has left the ring, the
+ * index is the start of its checkpoint interval and actual is zeroed.
+ * ASX_E_INVALID_ARGUMENT if expected is NULL with a nonzero count.
  */
 ASX_API ASX_MUST_USE asx_status asx_event_replay_verify(
     const asx_event_record *expected,
     uint32_t expected_count,
     asx_replay_divergence *divergence);
 
+/*
+ * Locate the first divergence from a reference run without hashing it
+ * again: expected_checkpoints/checkpoint_count/interval are as that run
+ * reported through asx_event_checkpoints and
+ * asx_event_checkpoint_interval. Only the expected records of the
+ * interval where the chains part are read. Same results as
+ * asx_event_replay_verify. ASX_E_INVALID_ARGUMENT for NULL pointers or
+ * an interval that is not ASX_EVENT_CHECKPOINT_INTERVAL times a power
+ * of two.
+ */
+ASX_API ASX_MUST_USE asx_status asx_event_replay_locate(
+    const uint64_t *expected_checkpoints,
+    uint32_t checkpoint_count,
+    uint32_t interval,
+    const asx_event_record *expected,
+    uint32_t expected_count,
+    asx_replay_divergence *divergence);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,7 +1,7 @@
 /*
  * asx/runtime/hft_instrument.h — HFT profile instrumentation (bd-j4m.3)
  *
- * Provides latency histogram, jitter tracker, deterministic overload
+ * Provides latency histograms, jitter tracker, deterministic overload
  * policy, and metric gate hooks for the HFT profile. All instrumentation
  * is operational (affects observability, not semantics). The overload
  * policy produces deterministic outcomes given identical input state,
@@ -10,7 +10,7 @@
  * Key invariants:
  *   - Overload decisions are pure functions of (load, capacity, policy)
  *   - Histogram bins use fixed log2 boundaries — no floating point
- *   - Jitter is computed as mean absolute deviation (MAD)
+ *   - Jitter is a streaming mean absolute deviation (MAD), O(1) per sample
  *   - Gate hooks evaluate pass/fail against configurable thresholds
  *
  * SPDX-License-Identifier: MIT
@@ -21,6 +21,7 @@
 
 #include <asx/asx_export.h>
 #include <asx/asx_status.h>
+#include <asx/asx_ids.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -72,43 +73,176 @@ ASX_API uint64_t asx_hft_histogram_mean(const asx_hft_histogram *h);
 /* Reset histogram to initial state. */
 ASX_API void asx_hft_histogram_reset(asx_hft_histogram *h);
 
+/* Add src's samples into dst. */
+ASX_API void asx_hft_histogram_merge(asx_hft_histogram *dst,
+                                      const asx_hft_histogram *src);
+
+/* -------------------------------------------------------------------
+ * Log-linear latency histogram — HdrHistogram-style layout
+ *
+ * Each power-of-two range of values is split into 2^precision linear
+ * buckets, so every recorded value is kept to within a relative error
+ * of 2^-precision across the whole range, from single nanoseconds up
+ * to 2^range_bits - 1 ns (range_bits 36 covers about 68 s):
+ *
+ *   values [0, 2^(p+1))         one bucket per value
+ *   values [2^e, 2^(e+1)), e>p  2^p buckets of width 2^(e-p)
+ *
+ * Recording is O(1): the bucket index comes from a count of leading
+ * zeros, with no loop and no floating point. Samples at or above the
+ * range land in the top bucket and are counted in overflow; min, max
+ * and the sum stay exact.
+ *
+ * Histograms with the same precision and range merge by adding
+ * counts, so each worker can record into its own and a reader folds
+ * them together. Storage is fixed (ASX_HFT_HDR_COUNTS_MAX counters)
+ * and caller-owned.
+ * ------------------------------------------------------------------- */
+
+#define ASX_HFT_HDR_PRECISION_MIN   1u
+#define ASX_HFT_HDR_PRECISION_MAX   7u   /* <1% relative error */
+#define ASX_HFT_HDR_RANGE_BITS_MAX  36u  /* values below 2^36 ns */
+#define ASX_HFT_HDR_COUNTS_MAX \
+    ((ASX_HFT_HDR_RANGE_BITS_MAX - ASX_HFT_HDR_PRECISION_MAX + 1u) \
+     << ASX_HFT_HDR_PRECISION_MAX)
+
+/* Defaults for asx_hft_hdr_init_default: ~3% error up to ~68 s */
+#define ASX_HFT_HDR_DEFAULT_PRECISION   5u
+#define ASX_HFT_HDR_DEFAULT_RANGE_BITS  36u
+
+/* Quantiles are given in parts per million */
+#define ASX_HFT_PPM_P50     500000u
+#define ASX_HFT_PPM_P99     990000u
+#define ASX_HFT_PPM_P99_9   999000u
+#define ASX_HFT_PPM_P99_99  999900u
+
+typedef struct {
+    uint32_t counts[ASX_HFT_HDR_COUNTS_MAX];
+    uint32_t bucket_count;  /* counters in use for this layout */
+    uint8_t  precision;     /* linear sub-bucket bits */
+    uint8_t  range_bits;    /* values below 2^range_bits are exact */
+    uint64_t total;         /* samples recorded */
+    uint64_t overflow;      /* samples >= 2^range_bits */
+    uint64_t sum_ns;
+    uint64_t min_ns;        /* UINT64_MAX while empty */
+    uint64_t max_ns;
+} asx_hft_hdr;
+
+/* Initialize an empty histogram. ASX_E_INVALID_ARGUMENT if h is NULL,
+ * precision is outside [ASX_HFT_HDR_PRECISION_MIN,
+ * ASX_HFT_HDR_PRECISION_MAX], or range_bits is not in
+ * (precision, ASX_HFT_HDR_RANGE_BITS_MAX]. */
+ASX_API ASX_MUST_USE asx_status asx_hft_hdr_init(asx_hft_hdr *h,
+                                                  uint32_t precision,
+                                                  uint32_t range_bits);
+
+/* Initialize with the default precision and range. */
+ASX_API void asx_hft_hdr_init_default(asx_hft_hdr *h);
+
+/* Record a latency sample in nanoseconds. O(1). */
+ASX_API void asx_hft_hdr_record(asx_hft_hdr *h, uint64_t ns);
+
+/* Value at quantile ppm (parts per million, clamped to 1000000): the
+ * highest value equivalent to the bucket holding that rank, capped at
+ * max_ns. ppm 0 gives min_ns. Returns 0 if h is NULL or empty. */
+ASX_API uint64_t asx_hft_hdr_value_at(const asx_hft_hdr *h, uint32_t ppm);
+
+/* Mean latency in nanoseconds. Returns 0 if no samples. */
+ASX_API uint64_t asx_hft_hdr_mean(const asx_hft_hdr *h);
+
+/* Add src's samples into dst. ASX_E_INVALID_ARGUMENT if either is
+ * NULL or their precision and range differ. */
+ASX_API ASX_MUST_USE asx_status asx_hft_hdr_merge(asx_hft_hdr *dst,
+                                                   const asx_hft_hdr *src);
+
+/* Clear all samples, keeping the layout. */
+ASX_API void asx_hft_hdr_reset(asx_hft_hdr *h);
+
+/*
+ * Binary form (little-endian), sparse so an idle histogram stays small:
+ *   [0..3]  magic       "ASXh" (0x41535868)
+ *   [4]     version     1
+ *   [5]     precision
+ *   [6]     range_bits
+ *   [7]     reserved    0
+ * then unsigned LEB128 varints: overflow, sum_ns, min_ns, max_ns, the
+ * number of nonzero buckets, and per nonzero bucket in index order
+ * the gap since the previous one (index - previous - 1, or the index
+ * for the first) and its count. total is the sum of the counts.
+ */
+#define ASX_HFT_HDR_BINARY_MAGIC    0x41535868u  /* "ASXh" */
+#define ASX_HFT_HDR_BINARY_VERSION  1u
+
+/* Serialize h into buf. ASX_E_INVALID_ARGUMENT if h or out_len is
+ * NULL; ASX_E_BUFFER_TOO_SMALL if buf is NULL or capacity is short,
+ * with *out_len set to the size needed. On success *out_len is the
+ * number of bytes written. */
+ASX_API ASX_MUST_USE asx_status asx_hft_hdr_export(const asx_hft_hdr *h,
+                                                    uint8_t *buf,
+                                                    uint32_t capacity,
+                                                    uint32_t *out_len);
+
+/* Rebuild a histogram from asx_hft_hdr_export output. Returns
+ * ASX_E_INVALID_ARGUMENT on a bad magic, version or layout, a bucket
+ * out of range, a zero or oversized count, truncation or trailing
+ * bytes; out is left initialized but empty on failure. */
+ASX_API ASX_MUST_USE asx_status asx_hft_hdr_import(const uint8_t *buf,
+                                                    uint32_t len,
+                                                    asx_hft_hdr *out);
+
 /* -------------------------------------------------------------------
  * Jitter tracker — streaming mean absolute deviation
  *
- * Tracks jitter as the mean absolute deviation (MAD) of latency
- * samples around the running mean. Updated incrementally without
- * storing all samples.
+ * Tracks jitter as an exponentially weighted mean absolute deviation
+ * of latency samples around an exponentially weighted mean, both in
+ * 24.8 fixed point with weight 2^-shift per sample:
+ *
+ *   d     = |x - mean|
+ *   mean += (x - mean) >> shift
+ *   dev  += (d - dev) >> shift
  *
- * Two-pass streaming approximation:
- *   Pass 1: accumulate sum, count (via histogram)
- *   Pass 2: compute MAD from histogram bin midpoints
+ * Each sample costs a few integer operations and no bin walk, so the
+ * estimate can be read on every overload or gate decision. It follows
+ * roughly the last window samples; a step change shows up at once and
+ * decays as the mean catches up.
  *
- * For exact jitter from raw samples, use the sorted-samples
- * approach in bench_runtime.c. This tracker is for real-time
- * monitoring with bounded memory.
+ * The histogram is still filled. asx_hft_jitter_recompute derives
+ * the older bin-midpoint MAD from it on request. For exact jitter from
+ * raw samples, use the sorted-samples approach in bench_runtime.c.
  * ------------------------------------------------------------------- */
 
+#define ASX_HFT_JITTER_WINDOW_DEFAULT  16u
+#define ASX_HFT_JITTER_WINDOW_MAX      65536u
+
 typedef struct {
     asx_hft_histogram  hist;            /* underlying histogram */
-    uint64_t           mad_ns;          /* last computed MAD */
-    uint32_t           recompute_every; /* recompute MAD every N samples */
-    uint32_t           samples_since;   /* samples since last recompute */
+    uint64_t           mad_ns;          /* bin-midpoint MAD, by recompute */
+    uint64_t           mean_q8;         /* EWMA mean, ns << 8 */
+    uint64_t           dev_q8;          /* EWMA absolute deviation, ns << 8 */
+    uint32_t           shift;           /* log2 of the window */
+    uint32_t           samples;         /* samples since init or reset */
 } asx_hft_jitter_tracker;
 
-/* Initialize a jitter tracker. recompute_interval controls how often
- * MAD is recalculated (0 = every sample, expensive). */
+/* Initialize a jitter tracker averaging over about window samples,
+ * rounded down to a power of two and clamped to
+ * [2, ASX_HFT_JITTER_WINDOW_MAX]; 0 selects
+ * ASX_HFT_JITTER_WINDOW_DEFAULT. */
 ASX_API void asx_hft_jitter_init(asx_hft_jitter_tracker *jt,
-                                  uint32_t recompute_interval);
+                                  uint32_t window);
 
-/* Record a latency sample and possibly recompute jitter. */
+/* Record a latency sample and update the jitter estimate. O(1). */
 ASX_API void asx_hft_jitter_record(asx_hft_jitter_tracker *jt, uint64_t ns);
 
-/* Force recompute of MAD from current histogram state. */
+/* Recompute the bin-midpoint MAD from the histogram into mad_ns. Not
+ * needed for asx_hft_jitter_get; costs a pass over the bins. */
 ASX_API void asx_hft_jitter_recompute(asx_hft_jitter_tracker *jt);
 
-/* Read the current jitter (MAD) in nanoseconds. */
+/* Read the current streaming jitter (MAD) in nanoseconds. */
 ASX_API uint64_t asx_hft_jitter_get(const asx_hft_jitter_tracker *jt);
 
+/* Read the bin-midpoint MAD as of the last asx_hft_jitter_recompute. */
+ASX_API uint64_t asx_hft_jitter_binned(const asx_hft_jitter_tracker *jt);
+
 /* Reset the jitter tracker. */
 ASX_API void asx_hft_jitter_reset(asx_hft_jitter_tracker *jt);
 
@@ -119,7 +253,8 @@ ASX_API void asx_hft_jitter_reset(asx_hft_jitter_tracker *jt);
  * determines behavior deterministically. Three modes:
  *
  *   REJECT     — excess spawns fail with ASX_E_ADMISSION_CLOSED
- *   SHED_OLDEST— cancel the oldest non-terminal task to make room
+ *   SHED_OLDEST— cancel the oldest non-terminal tasks to make room
+ *                (asx_overload_shed carries the decision out)
  *   BACKPRESSURE— block (return WOULD_BLOCK) until capacity frees
  *
  * The policy is a pure function of (mode, load, capacity), making
@@ -158,6 +293,12 @@ ASX_API void asx_overload_evaluate(const asx_overload_policy *pol,
                                     uint32_t capacity,
                                     asx_overload_decision *decision);
 
+/* Carry out a SHED_OLDEST decision: cancel decision->shed_count of
+ * region's oldest tasks (asx_region_shed_oldest). Returns the number
+ * shed; 0 for decisions that did not trigger or use another mode. */
+ASX_API uint32_t asx_overload_shed(asx_region_id region,
+                                    const asx_overload_decision *decision);
+
 /* Return human-readable name for an overload mode. */
 ASX_API const char *asx_overload_mode_str(asx_overload_mode mode);
 
@@ -201,6 +342,15 @@ ASX_API void asx_hft_gate_evaluate(const asx_hft_gate *gate,
                                     const asx_hft_jitter_tracker *jt,
                                     asx_hft_gate_result *result);
 
+/* Evaluate a gate against a log-linear histogram. Same contract as
+ * asx_hft_gate_evaluate; the p99.9 and p99.99 thresholds see tail
+ * values to within the histogram's precision instead of the fixed
+ * histogram's 32 us overflow bucket. */
+ASX_API void asx_hft_gate_evaluate_hdr(const asx_hft_gate *gate,
+                                        const asx_hft_hdr *hdr,
+                                        const asx_hft_jitter_tracker *jt,
+                                        asx_hft_gate_result *result);
+
 /* -------------------------------------------------------------------
  * Global HFT instrumentation state
  *
@@ -214,12 +364,50 @@ ASX_API void asx_hft_instrument_reset(void);
 /* Get pointer to the global scheduler latency histogram. */
 ASX_API asx_hft_histogram *asx_hft_sched_histogram(void);
 
+/* Get pointer to the global cancel latency histogram. Each task that
+ * completes with a cancel pending records the asx_runtime_now_ns delta
+ * since its first cancel signal; nothing is recorded without a clock. */
+ASX_API asx_hft_histogram *asx_hft_cancel_histogram(void);
+
 /* Get pointer to the global jitter tracker. */
 ASX_API asx_hft_jitter_tracker *asx_hft_sched_jitter(void);
 
-/* Record a scheduler poll latency sample (convenience wrapper). */
+/* Record a scheduler poll latency sample (convenience wrapper).
+ * Called from a poll running on a parallel worker thread (parallel.h),
+ * the sample goes to that worker's histogram as with
+ * asx_hft_record_worker_poll_latency; otherwise to the global
+ * histogram and jitter tracker. */
 ASX_API void asx_hft_record_poll_latency(uint64_t ns);
 
+/* -------------------------------------------------------------------
+ * Per-worker poll latency
+ *
+ * Each worker records into a histogram of its own, one cache-line
+ * padded slot per worker, with plain writes: no worker ever writes a
+ * line another worker writes. Every slot holds two histograms and the
+ * worker fills the one selected by a shared epoch. A snapshot flips
+ * the epoch, waits out at most one record already in progress on the
+ * retired side, folds the retired histograms into a running total and
+ * clears them, so snapshots never stop the workers.
+ *
+ * Snapshots must be taken from one thread at a time, normally the
+ * thread driving the scheduler. Worker samples do not feed the jitter
+ * tracker.
+ * ------------------------------------------------------------------- */
+
+#define ASX_HFT_MAX_WORKERS 32u
+
+/* Record a poll latency sample for worker_index (0 to
+ * ASX_HFT_MAX_WORKERS - 1; others are ignored). Each index must be
+ * written by one thread at a time. */
+ASX_API void asx_hft_record_worker_poll_latency(uint32_t worker_index,
+                                                 uint64_t ns);
+
+/* Fold every worker's samples so far into *out together with the
+ * global scheduler histogram, ready for asx_hft_gate_evaluate.
+ * ASX_E_INVALID_ARGUMENT if out is NULL. */
+ASX_API ASX_MUST_USE asx_status asx_hft_sched_snapshot(asx_hft_histogram *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,7 +8,8 @@
  * context for replay diagnostics.
  *
  * Steady-state overhead: one branch per log site (disabled → zero cost).
- * Enabled in ASX_DEBUG builds and CI; controlled by ASX_HINDSIGHT flag.
+ * The runtime's own clock, entropy and reactor log sites compile in
+ * only when ASX_HINDSIGHT is set (asx_config.h; off in NDEBUG builds).
  *
  * SPDX-License-Identifier: MIT
  */
@@ -26,6 +27,10 @@ extern "C" {
 
 /* -------------------------------------------------------------------
  * Hindsight ring capacity (configurable at init time)
+ *
+ * Size of the built-in ring and the default capacity. A smaller
+ * capacity, or caller-provided storage of any size, can be set with
+ * asx_hindsight_init_with().
  * ------------------------------------------------------------------- */
 
 #define ASX_HINDSIGHT_CAPACITY 256u
@@ -59,6 +64,9 @@ typedef enum {
     /* Timer resolution (0x50–0x5F) */
     ASX_ND_TIMER_COALESCE    = 0x50,  /* timer coalescing decision */
 
+    /* Adapter shadow evaluation (0x60–0x6F) */
+    ASX_ND_ADAPTER_DIVERGENCE = 0x60, /* sampled FALLBACK digest differed */
+
     /* Sentinel */
     ASX_ND_KIND_COUNT
 } asx_nd_event_kind;
@@ -102,18 +110,63 @@ ASX_API void asx_hindsight_init(void);
 /* Reset the ring to empty state (test support). */
 ASX_API void asx_hindsight_reset(void);
 
+/* Re-initialize the ring with capacity slots. storage == NULL selects
+ * the built-in ring (capacity at most ASX_HINDSIGHT_CAPACITY); otherwise
+ * storage must hold capacity events and outlive its use. The choice
+ * survives init/reset. Returns ASX_E_INVALID_ARGUMENT for a zero or
+ * oversized capacity. */
+ASX_API asx_status asx_hindsight_init_with(asx_hindsight_event *storage,
+                                           uint32_t capacity);
+
+/* Return the active ring capacity. */
+ASX_API uint32_t asx_hindsight_capacity(void);
+
 /* Log a nondeterministic boundary event into the ring.
  * If the ring is full, the oldest entry is overwritten (wrapping). */
 ASX_API void asx_hindsight_log(asx_nd_event_kind kind,
                                 uint64_t entity_id,
                                 uint64_t observed_value);
 
+/* -------------------------------------------------------------------
+ * Per-kind sampling
+ *
+ * Keeps high-rate kinds (clock reads on every poll) from churning the
+ * ring. Of the events offered for a kind, 1 in sample_every passes the
+ * sampler; at most max_per_window of those are recorded per window
+ * trace events (window == 0: per reset). Decisions depend only on the
+ * event stream, so they replay. Dropped events take no ring slot or
+ * sequence number. A zeroed config records everything (the default).
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t sample_every;    /* keep 1 in N offered events (0/1 = all) */
+    uint32_t max_per_window;  /* cap on recorded events (0 = no cap) */
+    uint32_t window;          /* window length in trace events */
+} asx_hindsight_sampling;
+
+/* Set (or with cfg == NULL clear) the sampling config for a kind.
+ * Survives init/reset; restarts the kind's window. Returns
+ * ASX_E_INVALID_ARGUMENT for an out-of-range kind. */
+ASX_API asx_status asx_hindsight_set_sampling(asx_nd_event_kind kind,
+                                              const asx_hindsight_sampling *cfg);
+
+/* Query the sampling config for a kind (zeroed if none). */
+ASX_API asx_hindsight_sampling asx_hindsight_sampling_active(
+    asx_nd_event_kind kind);
+
+/* Events of a kind offered to asx_hindsight_log since reset. Counted
+ * only while at least one kind has a sampling config. */
+ASX_API uint32_t asx_hindsight_seen_count(asx_nd_event_kind kind);
+
+/* Events of a kind dropped by sampling since reset. */
+ASX_API uint32_t asx_hindsight_dropped_count(asx_nd_event_kind kind);
+
 /* Return the total number of events logged since last reset.
- * May exceed ASX_HINDSIGHT_CAPACITY if the ring has wrapped. */
+ * May exceed the capacity if the ring has wrapped. */
 ASX_API uint32_t asx_hindsight_total_count(void);
 
 /* Return the number of events currently readable in the ring.
- * At most ASX_HINDSIGHT_CAPACITY. */
+ * At most the capacity. */
 ASX_API uint32_t asx_hindsight_readable_count(void);
 
 /* Return nonzero if the ring has overwritten older entries. */
@@ -134,7 +187,35 @@ ASX_API int asx_hindsight_get(uint32_t index, asx_hindsight_event *out);
  * Returns ASX_OK on success. Does not clear the ring. */
 ASX_API asx_status asx_hindsight_flush_json(asx_hindsight_flush_buffer *out);
 
-/* Compute FNV-1a digest over the ring contents (for replay identity). */
+/* -------------------------------------------------------------------
+ * Binary flush — raw ring dump, rendered to JSON later
+ *
+ * The trigger path copies the ring out verbatim; the JSON render can
+ * run afterwards, off the hot path or offline. Dumps hold raw host
+ * structs and are read back on a host with the same record layout
+ * (checked through the record size in the header).
+ * ------------------------------------------------------------------- */
+
+#define ASX_HINDSIGHT_DUMP_MAGIC   0x41535868u  /* "ASXh" */
+#define ASX_HINDSIGHT_DUMP_VERSION 1u
+#define ASX_HINDSIGHT_DUMP_HEADER  32u
+
+/* Dump the ring (header + readable slots) into buf. Returns
+ * ASX_E_BUFFER_TOO_SMALL with the needed size in *out_len if capacity
+ * is short. Does not clear the ring. */
+ASX_API asx_status asx_hindsight_flush_binary(uint8_t *buf,
+                                              uint32_t capacity,
+                                              uint32_t *out_len);
+
+/* Render a dump from asx_hindsight_flush_binary as the same JSON that
+ * asx_hindsight_flush_json would have produced at dump time.
+ * Returns ASX_E_INVALID_ARGUMENT for a malformed or foreign dump. */
+ASX_API asx_status asx_hindsight_render_json(const uint8_t *dump,
+                                             uint32_t len,
+                                             asx_hindsight_flush_buffer *out);
+
+/* Compute the ring digest (for replay identity): FNV-1a unless the
+ * hindsight digest domain selects WORD64. */
 ASX_API uint64_t asx_hindsight_digest(void);
 
 /* -------------------------------------------------------------------
@@ -189,11 +270,36 @@ ASX_API asx_hindsight_policy asx_hindsight_policy_active(void);
 ASX_API asx_status asx_hindsight_flush_on_invariant(
     asx_hindsight_flush_buffer *out);
 
+/* Flush the ring into out as each ghost violation is recorded (while
+ * flush_on_invariant is set), so sampled canary builds capture the
+ * context of the violation, not of a later poll. out NULL detaches.
+ * out must outlive the routing. Resets the flush count. No effect
+ * without ASX_DEBUG_GHOST.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API void asx_hindsight_route_ghost(asx_hindsight_flush_buffer *out);
+
+/* Flushes made by the routing since it was last set. */
+ASX_API uint32_t asx_hindsight_ghost_flush_count(void);
+
 /* Compare the current ring digest against an expected value.
  * Returns 1 if digests differ (divergence detected), 0 otherwise.
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API int asx_hindsight_check_divergence(uint64_t expected_digest);
 
+/* Compare a reference run's digest for trace window (see "Digest
+ * windows" in trace.h) against this run's, so a shadow replica finds a
+ * divergence while running instead of at the end. On a mismatch the
+ * ring is flushed into out at once, when out is non-NULL and
+ * flush_on_divergence is set.
+ * Returns ASX_OK if the digests match,
+ *   ASX_E_PENDING if this run has not closed that window yet,
+ *   ASX_E_NOT_FOUND if windows are off or the window is no longer held,
+ *   ASX_E_REPLAY_MISMATCH if they differ.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_hindsight_check_window(
+    uint32_t window, uint64_t expected_digest,
+    asx_hindsight_flush_buffer *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,119 @@
+/*
+ * asx/runtime/loadgen.h — open-loop load generator
+ *
+ * Produces arrivals on a schedule fixed in advance by an arrival
+ * process, independent of how fast the system under test serves
+ * them: Poisson (exponential gaps at a mean rate), on/off bursts
+ * (Poisson while on, silent while off), or offsets replayed from a
+ * recorded trace. The caller supplies time; asx_loadgen_pump issues
+ * every arrival whose intended time has passed through an action
+ * callback (a spawn, a channel send), so a stall is followed by the
+ * backlog it caused rather than by a quietly slower arrival rate.
+ *
+ * Latency is measured from the intended arrival time, which corrects
+ * for coordinated omission: a request delayed because the generator
+ * was blocked still counts its full wait. The uncorrected time from
+ * issue to completion is kept alongside for comparison.
+ *
+ * Sampling is integer-only and seeded (asx_prng), so a given config
+ * and seed produce the same schedule on every platform.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_LOADGEN_H
+#define ASX_RUNTIME_LOADGEN_H
+
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_config.h>
+#include <asx/runtime/hft_instrument.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ASX_LOADGEN_POISSON = 0,  /* exponential gaps at rate_per_sec */
+    ASX_LOADGEN_ON_OFF  = 1,  /* Poisson during on_ns, none during off_ns */
+    ASX_LOADGEN_TRACE   = 2   /* offsets replayed from trace_ns */
+} asx_loadgen_kind;
+
+typedef struct {
+    asx_loadgen_kind kind;
+    uint64_t         rate_per_sec;  /* POISSON mean rate, ON_OFF rate while on */
+    uint64_t         on_ns;         /* ON_OFF: length of each burst */
+    uint64_t         off_ns;        /* ON_OFF: silence between bursts */
+    const uint64_t  *trace_ns;      /* TRACE: non-decreasing offsets from start */
+    uint32_t         trace_count;
+    uint64_t         seed;
+    uint64_t         limit;         /* arrivals to issue, 0 = unbounded */
+} asx_loadgen_config;
+
+/* One issued arrival, handed to the action and back to complete. */
+typedef struct {
+    uint64_t seq;          /* 0-based arrival number */
+    uint64_t intended_ns;  /* when the schedule called for it */
+    uint64_t issued_ns;    /* the pump's now when it was issued */
+} asx_loadgen_arrival;
+
+/* Issue one arrival. A non-OK return counts the arrival as rejected;
+ * the schedule moves on either way. */
+typedef asx_status (*asx_loadgen_action_fn)(void *ctx,
+                                            const asx_loadgen_arrival *arrival);
+
+/* Generator state. Members are read-only for callers. */
+typedef struct {
+    asx_loadgen_config cfg;
+    asx_prng    prng;
+    uint64_t    mean_gap_q16;  /* 2^16 ns / rate, Poisson kinds */
+    uint64_t    start_ns;
+    uint64_t    offset_ns;     /* schedule offset of the next arrival */
+    uint64_t    next_ns;       /* absolute intended time of the next arrival */
+    uint64_t    issued;
+    uint64_t    rejected;
+    uint64_t    completed;
+    uint64_t    max_lag_ns;    /* largest issue time past intended */
+    int         done;          /* limit or trace end reached */
+    asx_hft_hdr latency;       /* completion - intended (CO-corrected) */
+    asx_hft_hdr service;       /* completion - issued */
+} asx_loadgen;
+
+/* Start a schedule at start_ns. Returns ASX_E_INVALID_ARGUMENT for
+ * NULL pointers, an unknown kind, a zero rate (POISSON, ON_OFF), a
+ * zero on_ns (ON_OFF), or a NULL or decreasing trace (TRACE). */
+ASX_API ASX_MUST_USE asx_status asx_loadgen_init(asx_loadgen *gen,
+                                                 const asx_loadgen_config *cfg,
+                                                 uint64_t start_ns);
+
+/* Issue, in order, every arrival intended at or before now_ns, up to
+ * max of them, through action. *out_issued (may be NULL) receives the
+ * number issued, rejected ones included.
+ * Returns ASX_E_INVALID_ARGUMENT for NULL gen or action or max 0. */
+ASX_API ASX_MUST_USE asx_status asx_loadgen_pump(asx_loadgen *gen,
+                                                 uint64_t now_ns,
+                                                 uint32_t max,
+                                                 asx_loadgen_action_fn action,
+                                                 void *ctx,
+                                                 uint32_t *out_issued);
+
+/* Record that arrival finished at done_ns. */
+ASX_API void asx_loadgen_complete(asx_loadgen *gen,
+                                  const asx_loadgen_arrival *arrival,
+                                  uint64_t done_ns);
+
+/* Intended time of the next arrival; UINT64_MAX once done. */
+ASX_API uint64_t asx_loadgen_next_ns(const asx_loadgen *gen);
+
+/* 1 once the schedule has no arrivals left. */
+ASX_API int asx_loadgen_done(const asx_loadgen *gen);
+
+/* Human-readable name for an arrival process. Never returns NULL. */
+ASX_API ASX_MUST_USE const char *asx_loadgen_kind_str(asx_loadgen_kind kind);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_LOADGEN_H */
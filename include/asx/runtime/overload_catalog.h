@@ -21,6 +21,7 @@
 
 #include <asx/asx_export.h>
 #include <asx/asx_status.h>
+#include <asx/core/resource.h>
 #include <asx/runtime/hft_instrument.h>
 #include <asx/runtime/profile_compat.h>
 #include <stdint.h>
@@ -117,6 +118,21 @@ ASX_API asx_status asx_overload_catalog_get(asx_profile_id id,
 ASX_API asx_status asx_overload_catalog_to_policy(asx_profile_id id,
                                                    asx_overload_policy *out);
 
+/* Points of capacity by which a catalog watermark's high mark leads
+ * the profile's threshold, and its low mark trails the high mark. */
+#define ASX_CATALOG_WATERMARK_LEAD_PCT 10u
+
+/* Derive watermarks for capacity slots from a profile's threshold, so
+ * a callback can move to the entry's degrade class before admission
+ * starts refusing: high sits ASX_CATALOG_WATERMARK_LEAD_PCT points
+ * below threshold_pct (at least 1 slot), low the same distance below
+ * high (at least 1 slot below it, floor 0). fn and ctx are NULL.
+ * Returns ASX_E_INVALID_ARGUMENT for invalid profile, NULL out or
+ * capacity < 2. */
+ASX_API asx_status asx_overload_catalog_to_watermark(asx_profile_id id,
+                                                     uint32_t capacity,
+                                                     asx_resource_watermark *out);
+
 /* -------------------------------------------------------------------
  * Catalog validation
  *
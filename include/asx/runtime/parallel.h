@@ -5,9 +5,22 @@
  * profile. Tasks are assigned to lanes by work class (ready, cancel, timed).
  * Each lane has bounded fairness controls to prevent starvation.
  *
- * Walking skeleton: single-threaded simulation of lane scheduling.
- * Real multi-threaded dispatch will be added when platform threading
- * hooks are implemented.
+ * With worker_count > 1 and a thread hook installed (asx_thread_hooks;
+ * the POSIX and Win32 adapters provide one by default), each round's
+ * lane selections are polled concurrently on OS worker threads. Lane
+ * selection and result handling stay on the calling thread in lane
+ * order, so the trace is identical to a serialized run whenever poll
+ * results are. Each worker drains its own work-stealing deque and then
+ * steals from busy workers; steals are reported per worker in
+ * asx_worker_state. Deterministic builds (ASX_DETERMINISTIC) always poll
+ * serially on the calling thread.
+ *
+ * Concurrency contract: a poll function that may run on a worker thread
+ * must not call runtime APIs other than parking itself (waker.h), the
+ * channel send/receive protocol (asx/core/channel.h), whose wakes are
+ * deferred to the end of the batch, and asx_trace_emit, whose events
+ * are staged per worker and merged into the trace in serial order; the
+ * runtime kernel remains single-threaded.
  *
  * Feature-gated: compile with -DASX_PROFILE_PARALLEL to enable.
  * When disabled, all APIs compile to zero-overhead stubs.
@@ -33,9 +46,10 @@ extern "C" {
  * Lane capacity limits
  * ------------------------------------------------------------------- */
 
-#define ASX_MAX_WORKERS       4u
+#define ASX_MAX_WORKERS       32u
 #define ASX_MAX_LANES         3u  /* READY, CANCEL, TIMED */
 #define ASX_LANE_TASK_CAPACITY 64u
+#define ASX_PARALLEL_REGION_MAX 32u  /* regions per asx_parallel_run_regions */
 
 /* -------------------------------------------------------------------
  * Lane classification
@@ -43,7 +57,17 @@ extern "C" {
  * Tasks are assigned to lanes by their work class:
  *   READY  — tasks with no pending cancel or timer dependency
  *   CANCEL — tasks in cancel phase (CancelRequested, Cancelling)
- *   TIMED  — tasks blocked on timer deadlines
+ *   TIMED  — tasks parked on a timer (asx_task_park_on_timer); never
+ *            polled and given no quota. When the timer fires
+ *            (asx_timer_collect_expired) or is cancelled, the task moves
+ *            to READY (CANCEL if cancelled) at the next round boundary.
+ *
+ * The first run over a set of regions classifies their tasks. Lanes
+ * then persist across runs over the same regions: tasks join on spawn
+ * or wake, move to CANCEL when cancelled (at the next round boundary
+ * under CANCEL_STRICT, else at the next run, if cancelled mid-run),
+ * and leave on completion or a non-timer park. A run over different
+ * regions, or asx_runtime_reset, starts the classification afresh.
  * ------------------------------------------------------------------- */
 
 typedef enum {
@@ -57,14 +81,23 @@ typedef enum {
  *
  * Controls how poll budget is distributed across lanes:
  *   ROUND_ROBIN — each lane gets equal share per round
- *   WEIGHTED    — lanes get budget proportional to assigned weights
+ *   WEIGHTED    — lanes get budget proportional to assigned weights;
+ *                 the fraction of a poll a round's share leaves over
+ *                 carries to later rounds and runs (deficit round
+ *                 robin), so polls track the weights exactly over
+ *                 time even when one round's share rounds to zero
  *   PRIORITY    — cancel lane drains first, then ready, then timed
+ *   CANCEL_STRICT — as PRIORITY, but tasks cancelled while in READY
+ *                 move to CANCEL at the next round boundary, and the
+ *                 cancel lane is capped at cancel_round_cap polls per
+ *                 round (0 = uncapped) so cleanup cannot starve READY
  * ------------------------------------------------------------------- */
 
 typedef enum {
     ASX_FAIRNESS_ROUND_ROBIN = 0,
     ASX_FAIRNESS_WEIGHTED    = 1,
-    ASX_FAIRNESS_PRIORITY    = 2
+    ASX_FAIRNESS_PRIORITY    = 2,
+    ASX_FAIRNESS_CANCEL_STRICT = 3
 } asx_fairness_policy;
 
 /* -------------------------------------------------------------------
@@ -90,10 +123,23 @@ typedef struct {
     int                 active;       /* 1 if worker is running */
     uint32_t            polls_total;  /* lifetime poll count */
     uint32_t            tasks_completed; /* lifetime completions */
+    uint32_t            steals_total; /* polls taken from other workers' deques */
+    uint64_t            cpu_mask;     /* configured CPU set, 0 = unpinned */
+    int                 pinned;       /* 1 once its thread runs on cpu_mask */
+    uint64_t            involuntary_switches; /* while polling, pinned only */
 } asx_worker_state;
 
 /* -------------------------------------------------------------------
  * Parallel scheduler configuration
+ *
+ * worker_cpus maps workers to CPU sets (bit n = CPU n), e.g. the
+ * isolated cores of an HFT host. A worker with a set serves affinity
+ * domain w + 1, matching region placement in asx_parallel_run_regions,
+ * and in threaded mode its thread is pinned there (the thread hook's
+ * pin_fn) at its first batch. Worker 0 is the calling thread, so a set
+ * for it pins the caller. Pinned workers also count the involuntary
+ * context switches their thread takes while polling (switches_fn), so
+ * a host can check that the isolation holds.
  * ------------------------------------------------------------------- */
 
 typedef struct {
@@ -101,6 +147,8 @@ typedef struct {
     asx_fairness_policy fairness;
     uint32_t            lane_weights[ASX_MAX_LANES]; /* per-lane weights */
     uint32_t            starvation_limit; /* max rounds without polls before alert */
+    uint32_t            cancel_round_cap; /* CANCEL_STRICT: cancel polls per round, 0 = no cap */
+    uint64_t            worker_cpus[ASX_MAX_WORKERS]; /* CPU set per worker, 0 = unpinned */
 } asx_parallel_config;
 
 /* -------------------------------------------------------------------
@@ -164,6 +212,8 @@ ASX_API uint32_t asx_parallel_worker_count(void);
  * streams to asx_scheduler_run() for deterministic parity.
  *
  * Returns ASX_OK when all tasks complete,
+ *   ASX_E_PENDING when every remaining task is parked (waker.h),
+ *     including timer waiters left in the TIMED lane,
  *   ASX_E_POLL_BUDGET_EXHAUSTED if budget runs out,
  *   ASX_E_INVALID_ARGUMENT if budget is NULL.
  *
@@ -173,6 +223,32 @@ ASX_API ASX_MUST_USE asx_status asx_parallel_run(
     asx_region_id region,
     asx_budget *budget);
 
+/* Run several independent regions under one budget and one set of
+ * lanes (ASX_LANE_TASK_CAPACITY tasks per lane across all of them;
+ * tasks past that wait outside the lanes and join them as earlier
+ * tasks leave, at the next round boundary).
+ *
+ * Each region is pinned to one worker for the run: the worker matching
+ * its affinity domain (asx_affinity_bind; domain d selects worker
+ * (d - 1) mod worker_count), or else the worker at its position in
+ * regions modulo worker_count. In threaded mode a worker polls only
+ * its regions' selections and nothing is stolen, so polls of one
+ * region never overlap and need no locking among themselves; regions
+ * sharing a worker are polled in selection order.
+ *
+ * Selection and result handling stay on the calling thread: regions
+ * are merged into the trace in the order given within each lane, so
+ * the combined trace does not depend on worker count or timing.
+ *
+ * Returns as asx_parallel_run, with ASX_OK once every region's tasks
+ * have completed and ASX_E_PENDING if any region still holds parked
+ * tasks; ASX_E_INVALID_ARGUMENT if regions is NULL, region_count is 0
+ * or exceeds ASX_PARALLEL_REGION_MAX, or a region is listed twice. */
+ASX_API ASX_MUST_USE asx_status asx_parallel_run_regions(
+    const asx_region_id *regions,
+    uint32_t region_count,
+    asx_budget *budget);
+
 /* -------------------------------------------------------------------
  * API: Fairness queries
  * ------------------------------------------------------------------- */
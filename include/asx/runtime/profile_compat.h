@@ -124,6 +124,8 @@ typedef struct {
     uint64_t        digest_b;
     asx_semantic_rule divergence_rule; /* which rule was violated (if !pass) */
     uint32_t        divergence_index; /* first event index of divergence */
+    uint32_t        divergence_window; /* events from divergence_index that
+                                          hold it (0 = not located) */
 } asx_parity_result;
 
 /* -------------------------------------------------------------------
@@ -189,6 +191,42 @@ ASX_API int asx_profile_digest_compare(uint64_t digest_a,
 ASX_API int asx_profile_check_parity(uint64_t expected_digest,
                                       asx_parity_result *out);
 
+/* -------------------------------------------------------------------
+ * API: Windowed parity checking
+ *
+ * Each run reports its parity checkpoints through
+ * asx_telemetry_parity_checkpoints/asx_telemetry_parity_window.
+ * Checkpoints are cumulative, so once two runs part every later
+ * checkpoint differs; the first divergent window is found by bisection
+ * and only it needs an event-level diff. Events after the last
+ * checkpoint are covered by the final digest comparison.
+ * ------------------------------------------------------------------- */
+
+/* Compare the parity checkpoints of two runs. Windows of different
+ * lengths are compared at the longer one. Returns 1 if every shared
+ * checkpoint matches and both runs cover the same events. Otherwise
+ * returns 0 with divergence_index/divergence_window the first divergent
+ * window and digest_a/digest_b the checkpoints there (or each run's last
+ * checkpoint when one run ends early). Also 0, unlocated, for NULL
+ * checkpoints with a nonzero count or a window that is not
+ * ASX_TELEMETRY_PARITY_WINDOW times a power of two. */
+ASX_API int asx_profile_parity_windows_compare(const uint64_t *checkpoints_a,
+                                                uint32_t count_a,
+                                                uint32_t window_a,
+                                                asx_profile_id profile_a,
+                                                const uint64_t *checkpoints_b,
+                                                uint32_t count_b,
+                                                uint32_t window_b,
+                                                asx_profile_id profile_b,
+                                                asx_parity_result *out);
+
+/* Compare the current run's parity checkpoints (as profile_a) against
+ * expected ones from a reference run, as above. */
+ASX_API int asx_profile_check_parity_windows(const uint64_t *expected,
+                                              uint32_t count,
+                                              uint32_t window,
+                                              asx_parity_result *out);
+
 #ifdef __cplusplus
 }
 #endif
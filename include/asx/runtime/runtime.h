@@ -17,20 +17,72 @@
 #include <asx/asx_ids.h>
 #include <asx/core/outcome.h>
 #include <asx/core/budget.h>
+#include <asx/core/resource.h>
+#include <asx/runtime/hft_instrument.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /* -------------------------------------------------------------------
- * Arena capacity (walking skeleton: fixed-size static arenas)
- * Phase 3 will replace with dynamic hook-backed allocation.
+ * Arena capacity
+ *
+ * ASX_MAX_* slots are always available from static storage and form
+ * the first chunk of each arena. While runtime hooks are installed and
+ * the allocator is not sealed, arenas grow one chunk (ASX_MAX_* slots)
+ * at a time through asx_runtime_alloc up to ASX_ARENA_MAX_*. After
+ * asx_runtime_seal_allocator() the arena keeps its current size.
+ * Slot indices travel in the handle slot field, which bounds every
+ * ceiling at ASX_HANDLE_SLOT_LIMIT: 65536, or 16M with ASX_HANDLE_WIDE.
+ * The wide layout raises the task and obligation defaults to 1M; each
+ * ceiling costs one chunk pointer per ASX_MAX_* slots of static storage.
  * ------------------------------------------------------------------- */
 
 #define ASX_MAX_REGIONS      8
 #define ASX_MAX_TASKS        64
 #define ASX_MAX_OBLIGATIONS  128
-#define ASX_REGION_CAPTURE_ARENA_BYTES 16384u
+
+#ifndef ASX_ARENA_MAX_REGIONS
+#define ASX_ARENA_MAX_REGIONS      1024u
+#endif
+#if ASX_HANDLE_WIDE
+#ifndef ASX_ARENA_MAX_TASKS
+#define ASX_ARENA_MAX_TASKS        1048576u
+#endif
+#ifndef ASX_ARENA_MAX_OBLIGATIONS
+#define ASX_ARENA_MAX_OBLIGATIONS  1048576u
+#endif
+#else
+#ifndef ASX_ARENA_MAX_TASKS
+#define ASX_ARENA_MAX_TASKS        65536u
+#endif
+#ifndef ASX_ARENA_MAX_OBLIGATIONS
+#define ASX_ARENA_MAX_OBLIGATIONS  65536u
+#endif
+#endif
+
+#if ASX_ARENA_MAX_REGIONS > ASX_HANDLE_SLOT_LIMIT || \
+    ASX_ARENA_MAX_TASKS > ASX_HANDLE_SLOT_LIMIT || \
+    ASX_ARENA_MAX_OBLIGATIONS > ASX_HANDLE_SLOT_LIMIT
+#error "ASX_ARENA_MAX_* must fit the handle slot field (see ASX_HANDLE_WIDE)"
+#endif
+
+/* Region capture arenas (asx_task_spawn_captured). Each region slot
+ * holds ASX_REGION_CAPTURE_INLINE_BYTES inline; past that the arena
+ * chains blocks of at least ASX_REGION_CAPTURE_BLOCK_BYTES from the
+ * allocator hook, up to the region's capture limit (by default
+ * ASX_REGION_CAPTURE_ARENA_BYTES). Chained blocks are returned when
+ * the slot is reused or the runtime is reset. By default the inline
+ * bytes cover the default limit, so nothing is chained unless a
+ * region asks for more; tight builds define a smaller inline size
+ * (e.g. -DASX_REGION_CAPTURE_INLINE_BYTES=256) and pay for capture
+ * only where it is used. */
+#define ASX_REGION_CAPTURE_ARENA_BYTES  16384u
+#ifndef ASX_REGION_CAPTURE_INLINE_BYTES
+#define ASX_REGION_CAPTURE_INLINE_BYTES ASX_REGION_CAPTURE_ARENA_BYTES
+#endif
+#define ASX_REGION_CAPTURE_BLOCK_BYTES  4096u
+#define ASX_REGION_CAPTURE_UNBOUNDED    UINT32_MAX
 
 /* -------------------------------------------------------------------
  * Task poll function signature
@@ -73,6 +125,42 @@ typedef struct asx_co_state {
     (CO_STATE_PTR)->line = 0u;                     \
     return ASX_OK
 
+/* Coroutine frames: declare the task's state once, resume token
+ * first, and spawn it with ASX_CO_SPAWN. The frame is carved zeroed
+ * from the region capture arena and handed to the poll function as
+ * user_data, so spawning allocates nothing else and nothing is
+ * copied. Anything that must survive a yield or an await (waker.h
+ * ASX_CO_AWAIT_*) lives in the frame.
+ *
+ *   ASX_CO_FRAME_BEGIN(reader_frame)
+ *       asx_channel_id ch;
+ *       uint64_t       value;
+ *       asx_status     st;
+ *   ASX_CO_FRAME_END(reader_frame);
+ *
+ *   static asx_status reader(void *data, asx_task_id self) {
+ *       reader_frame *f = ASX_CO_FRAME(reader_frame, data);
+ *       ASX_CO_BEGIN(&f->co);
+ *       ASX_CO_AWAIT_RECV(&f->co, self, f->ch, &f->value, f->st);
+ *       ASX_CO_END(&f->co);
+ *   }
+ */
+#define ASX_CO_FRAME_BEGIN(NAME)                   \
+    typedef struct NAME {                          \
+        asx_co_state co;
+
+#define ASX_CO_FRAME_END(NAME)                     \
+    } NAME
+
+#define ASX_CO_FRAME(NAME, USER_DATA) ((NAME *)(USER_DATA))
+
+/* Spawn POLL_FN with a zeroed NAME frame. OUT_FRAME is a void ** that
+ * receives the frame, for filling in inputs before the first poll.
+ * Evaluates to the asx_task_spawn_captured status. */
+#define ASX_CO_SPAWN(REGION, NAME, POLL_FN, OUT_ID, OUT_FRAME)       \
+    asx_task_spawn_captured((REGION), (POLL_FN), (uint32_t)sizeof(NAME), \
+                            NULL, (OUT_ID), (OUT_FRAME))
+
 /* -------------------------------------------------------------------
  * Region lifecycle
  * ------------------------------------------------------------------- */
@@ -89,10 +177,94 @@ typedef struct asx_co_state {
  * See: API_MISUSE_CATALOG.md § Region Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_region_open(asx_region_id *out_id);
 
+/* Per-region options for asx_region_open_with. */
+typedef struct {
+    uint32_t capture_limit;    /* capture bytes; 0: ASX_REGION_CAPTURE_ARENA_BYTES,
+                                * ASX_REGION_CAPTURE_UNBOUNDED: while the
+                                * allocator serves */
+    uint32_t capture_reserve;  /* bytes allocated at open and used first, so
+                                * spawns up to it need no allocator call */
+    asx_region_id parent;      /* open as a child of this region;
+                                * ASX_INVALID_ID: a root region */
+    uint32_t dtor_batch;       /* 0: captured-state destructors run at
+                                * completion; else queued and run, oldest
+                                * first, up to dtor_batch at the end of
+                                * each scheduler round, the rest at drain
+                                * before the cleanup stack */
+} asx_region_options;
+
+/* Defaults: capture limit ASX_REGION_CAPTURE_ARENA_BYTES, no reserve,
+ * root region, destructors at completion. */
+ASX_API void asx_region_options_init(asx_region_options *opts);
+
+/* Open a new region with a sized capture arena, optionally as the last
+ * child of opts->parent. opts NULL is asx_region_open.
+ *
+ * Preconditions: out_id must not be NULL; a parent must be OPEN and
+ *   not poisoned.
+ * Postconditions: as asx_region_open; the region's capture arena holds
+ *   opts->capture_reserve bytes ready. A child is closed, cancelled and
+ *   drained along with its parent and leaves the parent's child list
+ *   when it reaches CLOSED.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_id is NULL
+ *   or capture_reserve exceeds capture_limit,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for a bad parent handle,
+ *   ASX_E_REGION_NOT_OPEN / ASX_E_REGION_POISONED for a parent that
+ *   cannot admit children,
+ *   ASX_E_RESOURCE_EXHAUSTED if the region arena is full or the
+ *   reserve cannot be allocated.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_open_with(const asx_region_options *opts,
+                                                     asx_region_id *out_id);
+
+/* Give a region a deadline: once the runtime clock reaches it, the
+ * scheduler cancels every task in the region's subtree with
+ * ASX_CANCEL_DEADLINE, as asx_cancel_propagate would. The check runs
+ * once per round of asx_scheduler_run / asx_parallel_run over the
+ * region or a descendant. One timer on asx_timer_wheel_global() backs
+ * the deadline, so asx_scheduler_wait_idle wakes for it. Per-task
+ * timeouts: spawn the task into its own child region.
+ *
+ * A later call replaces the deadline; 0 removes it. The deadline is
+ * dropped when it fires or the region reaches CLOSED.
+ *
+ * Preconditions: id must be a valid OPEN or CLOSING region handle.
+ * Returns ASX_OK on success, ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for a
+ *   bad handle, ASX_E_REGION_CLOSED once the region is finalizing,
+ *   or the asx_timer_register error (the old deadline stays).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_set_deadline(asx_region_id id,
+                                                        asx_time deadline);
+
+/* Attach an overload policy that spawns, obligation reserves and
+ * channel reserves in the region consult inline, so admission is one
+ * call rather than asx_resource_admit, asx_overload_evaluate and the
+ * spawn in turn. For a catalog profile pass the policy from
+ * asx_overload_catalog_to_policy. policy NULL detaches it.
+ *
+ * Spawns (every entry point, a batch once) evaluate the policy against
+ * asx_resource_used / asx_resource_capacity of ASX_RESOURCE_TASK,
+ * obligation reserves against ASX_RESOURCE_OBLIGATION, as measured
+ * before the call. A triggered REJECT returns ASX_E_ADMISSION_CLOSED
+ * and BACKPRESSURE ASX_E_WOULD_BLOCK; SHED_OLDEST sheds shed_max tasks
+ * (asx_region_shed_oldest) and admits. A channel of the region admits
+ * claims only below threshold_pct of its capacity, checked in the same
+ * atomic claim as capacity, and refuses with the same statuses; shed
+ * mode adds no ceiling there. Every triggered decision is traced as
+ * ASX_TRACE_ADMISSION.
+ *
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for an unknown mode
+ *   or threshold_pct above 100, ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE
+ *   for a bad handle.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_set_admission(
+    asx_region_id id, const asx_overload_policy *policy);
+
 /* Initiate region close. Transitions: Open → Closing → Closed.
  *
  * Preconditions: id must be a valid region handle for an OPEN region.
  * Postconditions: region transitions toward CLOSED; tasks are drained.
+ *   Every OPEN descendant region moves to CLOSING too, in pre-order.
  * Returns ASX_OK on success, ASX_E_NOT_FOUND if id is invalid,
  *   ASX_E_STALE_HANDLE if generation mismatch, ASX_E_REGION_POISONED
  *   if the region is poisoned, ASX_E_INVALID_TRANSITION if already closed.
@@ -175,7 +347,8 @@ ASX_API ASX_MUST_USE asx_status asx_region_contain_fault(
  *   ASX_E_STALE_HANDLE if generation mismatch,
  *   ASX_E_REGION_NOT_OPEN if region is closed,
  *   ASX_E_REGION_POISONED if region is poisoned,
- *   ASX_E_RESOURCE_EXHAUSTED if the task arena is full.
+ *   ASX_E_RESOURCE_EXHAUSTED if every task slot is live or completed
+ *   but not yet reclaimed (see asx_task_get_outcome).
  * Ownership: user_data is borrowed (caller retains ownership).
  * Thread-safety: not thread-safe; single-threaded mode only.
  * See: API_MISUSE_CATALOG.md § Task Lifecycle. */
@@ -184,6 +357,29 @@ ASX_API ASX_MUST_USE asx_status asx_task_spawn(asx_region_id region,
                                                void *user_data,
                                                asx_task_id *out_id);
 
+/* Spawn a task into the region of a claim token, spending one of its
+ * claims. The region's admission policy and quota were consulted when
+ * the claim was taken, so neither is consulted again.
+ *
+ * Preconditions: token holds a live ASX_RESOURCE_TASK claim
+ *   (asx_resource_claim); its region is still OPEN; poll_fn and out_id
+ *   must not be NULL.
+ * Postconditions: on success, *out_id holds a task handle in CREATED
+ *   state and token->count is one lower.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if token, poll_fn
+ *   or out_id is NULL or the token is spent or of another kind,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE if the region is gone,
+ *   ASX_E_REGION_NOT_OPEN if it is closing, ASX_E_REGION_POISONED if
+ *   poisoned, ASX_E_INVALID_STATE if a copy of the token already spent
+ *   the region's claims. Never ASX_E_RESOURCE_EXHAUSTED.
+ * Ownership: user_data is borrowed (caller retains ownership).
+ * Thread-safety: not thread-safe; single-threaded mode only.
+ * See: API_MISUSE_CATALOG.md § Task Lifecycle. */
+ASX_API ASX_MUST_USE asx_status asx_task_spawn_claimed(asx_resource_token *token,
+                                                       asx_task_poll_fn poll_fn,
+                                                       void *user_data,
+                                                       asx_task_id *out_id);
+
 /* Spawn a task with captured state allocated from the region arena.
  * The returned state pointer is stable for the task lifetime and is
  * automatically passed as user_data to poll_fn.
@@ -196,7 +392,8 @@ ASX_API ASX_MUST_USE asx_status asx_task_spawn(asx_region_id region,
  *   out_id is NULL, ASX_E_NOT_FOUND if region is invalid,
  *   ASX_E_REGION_NOT_OPEN if region is closed,
  *   ASX_E_REGION_POISONED if poisoned,
- *   ASX_E_RESOURCE_EXHAUSTED if task or capture arena is full.
+ *   ASX_E_RESOURCE_EXHAUSTED if the task arena is full or the capture
+ *   arena is at its limit or cannot chain another block.
  * Ownership: state memory is region-owned; freed on region drain.
  *   state_dtor (if non-NULL) is called before deallocation.
  * Thread-safety: not thread-safe; single-threaded mode only. */
@@ -207,28 +404,410 @@ ASX_API ASX_MUST_USE asx_status asx_task_spawn_captured(asx_region_id region,
                                                         asx_task_id *out_id,
                                                         void **out_state);
 
+/* Spawn n tasks into one region in a single call: task i runs
+ * poll_fns[i] with user_datas[i] (user_datas NULL: every task gets
+ * NULL). The region checks and asx_resource_admit(ASX_RESOURCE_TASK, n)
+ * run once, and either all n tasks are spawned or none is. The trace
+ * and handles match n asx_task_spawn calls in index order.
+ *
+ * Preconditions: region must be OPEN and not poisoned; n > 0;
+ *   poll_fns (every entry non-NULL) and out_ids hold n entries.
+ * Postconditions: on success, out_ids[0..n) hold task handles.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for n == 0 or a
+ *   NULL array or poll_fn, the asx_task_spawn region errors, and
+ *   ASX_E_RESOURCE_EXHAUSTED if n task slots are not available.
+ * Ownership: user_datas entries are borrowed.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_spawn_batch(asx_region_id region,
+                                                     uint32_t n,
+                                                     const asx_task_poll_fn *poll_fns,
+                                                     void *const *user_datas,
+                                                     asx_task_id *out_ids);
+
+/* Captured fan-out: as asx_task_spawn_batch, with each task given
+ * zeroed state_size bytes of captured state as in
+ * asx_task_spawn_captured. All n captures are carved from the region
+ * arena in one contiguous bump, slices 8-byte aligned; out_states[i]
+ * is task i's state.
+ *
+ * Preconditions: as asx_task_spawn_batch; state_size > 0; out_states
+ *   holds n entries.
+ * Postconditions: on success, every task is spawned with its state.
+ * Returns as asx_task_spawn_batch, plus ASX_E_INVALID_ARGUMENT for
+ *   state_size == 0 and ASX_E_RESOURCE_EXHAUSTED if the capture arena
+ *   cannot hold n slices.
+ * Ownership: state memory is region-owned; state_dtor (if non-NULL) is
+ *   called for each task's state on completion.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_spawn_captured_batch(
+    asx_region_id region,
+    uint32_t n,
+    const asx_task_poll_fn *poll_fns,
+    uint32_t state_size,
+    asx_task_state_dtor_fn state_dtor,
+    asx_task_id *out_ids,
+    void **out_states);
+
 /* Query the current state of a task.
  *
  * Preconditions: out_state must not be NULL; id must be a valid handle.
  * Postconditions: on success, *out_state holds the current task state.
  * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_state is NULL,
- *   ASX_E_NOT_FOUND if id is invalid or wrong type tag.
+ *   ASX_E_NOT_FOUND if id is invalid or wrong type tag,
+ *   ASX_E_STALE_HANDLE if the task's slot was reclaimed and reused.
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API ASX_MUST_USE asx_status asx_task_get_state(asx_task_id id,
                                                    asx_task_state *out_state);
 
 /* Query the outcome of a completed task.
+ *
+ * Reading the outcome reclaims the task's slot, as does its region
+ * reaching CLOSED. The handle keeps answering get_state and
+ * get_outcome until a later spawn reuses the slot, after which it
+ * returns ASX_E_STALE_HANDLE.
  *
  * Preconditions: out_outcome must not be NULL; task must be COMPLETED.
- * Postconditions: on success, *out_outcome holds the task's final outcome.
+ * Postconditions: on success, *out_outcome holds the task's final
+ *   outcome and the slot is free for reuse.
  * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_outcome is NULL,
  *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE if the slot was reused,
  *   ASX_E_TASK_NOT_COMPLETED if the task has not finished.
  * Thread-safety: not thread-safe; single-threaded mode only.
  * See: API_MISUSE_CATALOG.md § Task Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_task_get_outcome(asx_task_id id,
                                                      asx_outcome *out_outcome);
 
+/* Per-task poll profile (ASX_TASK_PROFILE builds).
+ *
+ * Counters start at zero on spawn. pending_ns accumulates the time
+ * from spawn, or from the end of the previous poll, to the start of
+ * each poll (ready or parked); poll_ns_total accumulates time inside
+ * the poll function. Only asx_scheduler_run* polls are recorded. */
+typedef struct {
+    uint32_t polls;
+    uint64_t poll_ns_total;
+    uint64_t poll_ns_max;
+    uint64_t pending_ns;
+} asx_task_profile;
+
+/* Read a task's poll profile.
+ *
+ * Valid while the handle answers asx_task_get_state, i.e. until the
+ * slot is reused.
+ *
+ * Preconditions: out must not be NULL; id must be a valid handle.
+ * Postconditions: on success, *out holds the task's counters.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out is NULL,
+ *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE if the slot was reused,
+ *   ASX_E_INVALID_STATE if built without ASX_TASK_PROFILE.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_profile_get(asx_task_id id,
+                                                     asx_task_profile *out);
+
+/* Task-local words: a few 64-bit values stored in the task slot
+ * itself, for per-task metadata (a request id, a retry count) that
+ * would otherwise need asx_task_spawn_captured or a user_data
+ * allocation. Every word reads 0 after spawn. */
+#ifndef ASX_TASK_LOCAL_WORDS
+#define ASX_TASK_LOCAL_WORDS 4u
+#endif
+
+/* Store a task-local word.
+ *
+ * Valid while the handle answers asx_task_get_state, i.e. until the
+ * slot is reused; a poll function may set its own words through self.
+ *
+ * Preconditions: index < ASX_TASK_LOCAL_WORDS; id must be a valid handle.
+ * Postconditions: on success, word index of the task holds value.
+ * Returns ASX_OK on success,
+ *   ASX_E_INVALID_ARGUMENT if index >= ASX_TASK_LOCAL_WORDS,
+ *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE if the slot was reused.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_local_set(asx_task_id id,
+                                                   uint32_t index,
+                                                   uint64_t value);
+
+/* Read a task-local word.
+ *
+ * Preconditions: out must not be NULL; index < ASX_TASK_LOCAL_WORDS;
+ *   id must be a valid handle.
+ * Postconditions: on success, *out holds the word (0 if never set).
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out is NULL or
+ *   index >= ASX_TASK_LOCAL_WORDS,
+ *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE if the slot was reused.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_local_get(asx_task_id id,
+                                                   uint32_t index,
+                                                   uint64_t *out);
+
+/* -------------------------------------------------------------------
+ * Task groups
+ *
+ * A group counts its member tasks' completions and joins their
+ * outcomes (asx_outcome_join) as each one completes, so a parent
+ * waiting for "all done" or "first N done" parks once on the group
+ * instead of polling every child. A group belongs to a region, takes
+ * members from that region only, and is freed by
+ * asx_task_group_destroy or at the latest when the region closes.
+ * Groups come from a pool of ASX_MAX_TASK_GROUPS shared by all
+ * regions; a task is in at most one group.
+ * ------------------------------------------------------------------- */
+
+#define ASX_MAX_TASK_GROUPS 32u
+
+typedef struct asx_task_group {
+    uint32_t token;    /* [generation:16 | group:16] */
+} asx_task_group;
+
+/* Create an empty task group in a region.
+ *
+ * Preconditions: region must be a valid, open region; out not NULL.
+ * Postconditions: on success, *out names a group with no members.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out is NULL,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for an invalid region,
+ *   ASX_E_REGION_NOT_OPEN if the region is closing,
+ *   ASX_E_RESOURCE_EXHAUSTED if every group is in use.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_group_create(asx_region_id region,
+                                                      asx_task_group *out);
+
+/* Add a task of the group's region to the group. A task that has
+ * already completed counts as done at once, with its outcome.
+ *
+ * Preconditions: group live; task valid, in the group's region and
+ *   in no group.
+ * Postconditions: on success, the group's member count is one more.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if group is NULL
+ *   or the task is in another region,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for an invalid task,
+ *   ASX_E_INVALID_STATE for a destroyed group or a task already in one.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_group_add(const asx_task_group *group,
+                                                   asx_task_id task);
+
+/* Check whether count members have completed (0: every member).
+ * Does not block.
+ *
+ * Preconditions: group live; count no more than the member count.
+ * Postconditions: on ASX_OK, *out_outcome holds the join of the
+ *   outcomes of every member completed so far.
+ * Returns ASX_OK once enough members are done, ASX_E_WOULD_BLOCK
+ *   before, ASX_E_INVALID_ARGUMENT for NULL arguments or count above
+ *   the member count, ASX_E_INVALID_STATE for a destroyed group.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_group_try_join(const asx_task_group *group,
+                                                        uint32_t count,
+                                                        asx_outcome *out_outcome);
+
+/* Park a task until count members of the group have completed (0:
+ * every member). The task is woken once, by the completion that
+ * reaches the count, and should then call asx_task_group_try_join.
+ *
+ * Returns ASX_E_INVALID_ARGUMENT / ASX_E_INVALID_STATE as
+ *   asx_task_group_try_join, otherwise as asx_task_park_on_channel
+ *   (asx/runtime/waker.h).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_group(asx_task_id task,
+                                                       const asx_task_group *group,
+                                                       uint32_t count);
+
+/* Report how many members a group has and how many have completed.
+ *
+ * Preconditions: group live; out_done and out_members not NULL.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for NULL arguments,
+ *   ASX_E_INVALID_STATE for a destroyed group.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_group_progress(const asx_task_group *group,
+                                                        uint32_t *out_done,
+                                                        uint32_t *out_members);
+
+/* Destroy a group whose members have all completed.
+ *
+ * Postconditions: on success, the group's handle is invalid.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if group is NULL,
+ *   ASX_E_INVALID_STATE for a destroyed group,
+ *   ASX_E_TASK_NOT_COMPLETED while a member is still running.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_group_destroy(const asx_task_group *group);
+
+/* -------------------------------------------------------------------
+ * Semaphores
+ *
+ * A counting semaphore bounds how many tasks of a region hold a permit
+ * at once. A task that finds no permit queues FIFO on the semaphore
+ * and parks; each release hands its permit straight to the first
+ * queued task and wakes only that one, so waiters are neither polled
+ * nor woken in a herd. The wait queue is threaded through the tasks
+ * themselves: a queued task that is cancelled or completes leaves it
+ * in O(1), passing on any permit it was handed but never took.
+ * Semaphores come from a pool of ASX_MAX_SEMAPHORES shared by all
+ * regions and are freed by asx_semaphore_destroy or when their region
+ * closes.
+ * ------------------------------------------------------------------- */
+
+#define ASX_MAX_SEMAPHORES 16u
+
+typedef struct asx_semaphore {
+    uint32_t token;    /* [generation:16 | semaphore:16] */
+} asx_semaphore;
+
+/* Create a semaphore in a region holding permits permits.
+ *
+ * Preconditions: region must be a valid, open region; permits > 0;
+ *   out not NULL.
+ * Postconditions: on success, *out names a semaphore with every permit
+ *   available and no waiters.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out is NULL or
+ *   permits is 0, ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for an invalid
+ *   region, ASX_E_REGION_NOT_OPEN if the region is closing,
+ *   ASX_E_RESOURCE_EXHAUSTED if every semaphore is in use.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_semaphore_create(asx_region_id region,
+                                                     uint32_t permits,
+                                                     asx_semaphore *out);
+
+/* Take a permit for a task, or queue the task for one. Does not block:
+ * a queued task keeps its place across calls and should park with
+ * asx_task_park_on_semaphore, then call again once woken.
+ *
+ * Preconditions: sem live; task valid and in the semaphore's region.
+ * Postconditions: on ASX_OK the task holds one permit and is off the
+ *   queue; on ASX_E_WOULD_BLOCK it is queued behind earlier waiters.
+ * Returns ASX_OK when a permit was taken, ASX_E_WOULD_BLOCK while the
+ *   task waits its turn, ASX_E_CANCELLED if the task has a pending
+ *   cancel (it is never queued), ASX_E_INVALID_ARGUMENT if sem is NULL
+ *   or the task is in another region, ASX_E_NOT_FOUND /
+ *   ASX_E_STALE_HANDLE for an invalid task, ASX_E_INVALID_STATE for a
+ *   destroyed semaphore or a task queued on another one.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_semaphore_try_acquire(const asx_semaphore *sem,
+                                                          asx_task_id task);
+
+/* Park a task queued by asx_semaphore_try_acquire until a release
+ * hands it a permit. A task already handed one is not parked.
+ *
+ * Returns ASX_E_INVALID_ARGUMENT if sem is NULL, ASX_E_INVALID_STATE
+ *   for a destroyed semaphore or a task not queued on it, otherwise as
+ *   asx_task_park_on_channel (asx/runtime/waker.h).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_semaphore(asx_task_id task,
+                                                           const asx_semaphore *sem);
+
+/* Return a permit. With tasks queued, the permit goes to the first
+ * of them, which alone is woken; otherwise it becomes available.
+ *
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if sem is NULL,
+ *   ASX_E_INVALID_STATE for a destroyed semaphore or when every
+ *   permit is already available.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_semaphore_release(const asx_semaphore *sem);
+
+/* Report a semaphore's available permits and queued tasks.
+ *
+ * Preconditions: sem live; out_available and out_waiters not NULL.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for NULL arguments,
+ *   ASX_E_INVALID_STATE for a destroyed semaphore.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_semaphore_query(const asx_semaphore *sem,
+                                                    uint32_t *out_available,
+                                                    uint32_t *out_waiters);
+
+/* Destroy a semaphore no task is queued on. Permits still held are
+ * simply forgotten.
+ *
+ * Postconditions: on success, the semaphore's handle is invalid.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if sem is NULL,
+ *   ASX_E_INVALID_STATE for a destroyed semaphore,
+ *   ASX_E_TASKS_STILL_ACTIVE while tasks are queued.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_semaphore_destroy(const asx_semaphore *sem);
+
+/* -------------------------------------------------------------------
+ * Rate limiters
+ *
+ * A token bucket holding up to burst tokens that gains one token every
+ * interval_ns of asx_runtime_now_ns time. Refill is lazy: the bucket is
+ * brought up to date only when it is used, so an idle limiter costs
+ * nothing. A task short of tokens parks on the limiter's refill timer,
+ * registered on asx_timer_wheel_global() for the earliest time any
+ * waiter's tokens are due, so asx_scheduler_wait_idle sleeps until
+ * then instead of the task being re-polled. Waiters sharing the timer
+ * wake together and re-check; one that still lacks tokens parks again.
+ * A limiter belongs to a region, is shared by any of its tasks, and
+ * is freed by asx_rate_limiter_destroy or when the region closes.
+ * Limiters come from a pool of ASX_MAX_RATE_LIMITERS.
+ * ------------------------------------------------------------------- */
+
+#define ASX_MAX_RATE_LIMITERS 16u
+
+typedef struct asx_rate_limiter {
+    uint32_t token;    /* [generation:16 | limiter:16] */
+} asx_rate_limiter;
+
+/* Create a full token bucket in a region.
+ *
+ * Preconditions: region must be a valid, open region; burst > 0;
+ *   interval_ns > 0 and burst * interval_ns fits in 64 bits; out not
+ *   NULL.
+ * Postconditions: on success, *out names a limiter holding burst
+ *   tokens as of now.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for a NULL out or
+ *   a bad burst or interval, ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for
+ *   an invalid region, ASX_E_REGION_NOT_OPEN if the region is closing,
+ *   ASX_E_RESOURCE_EXHAUSTED if every limiter is in use, or the
+ *   asx_runtime_now_ns error.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_rate_limiter_create(asx_region_id region,
+                                                        uint32_t burst,
+                                                        uint64_t interval_ns,
+                                                        asx_rate_limiter *out);
+
+/* Take count tokens if the bucket holds them. Does not block.
+ *
+ * Preconditions: limiter live; 0 < count <= burst.
+ * Returns ASX_OK when taken, ASX_E_WOULD_BLOCK when short (nothing is
+ *   taken), ASX_E_INVALID_ARGUMENT if limiter is NULL or count is out
+ *   of range, ASX_E_INVALID_STATE for a destroyed limiter, or the
+ *   asx_runtime_now_ns error.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_rate_limiter_try_take(const asx_rate_limiter *limiter,
+                                                          uint32_t count);
+
+/* Park a task of the limiter's region until count tokens can be due,
+ * arming the refill timer for that time if it is not due sooner. A
+ * bucket already holding count tokens does not park the task.
+ *
+ * Returns ASX_E_INVALID_ARGUMENT / ASX_E_INVALID_STATE as
+ *   asx_rate_limiter_try_take, ASX_E_INVALID_ARGUMENT for a task in
+ *   another region, the asx_timer_update error, otherwise as
+ *   asx_task_park_on_timer (asx/runtime/waker.h).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_rate_limiter(asx_task_id task,
+                                                              const asx_rate_limiter *limiter,
+                                                              uint32_t count);
+
+/* Report the tokens a limiter holds now.
+ *
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for NULL arguments,
+ *   ASX_E_INVALID_STATE for a destroyed limiter, or the
+ *   asx_runtime_now_ns error.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_rate_limiter_query(const asx_rate_limiter *limiter,
+                                                       uint32_t *out_tokens);
+
+/* Destroy a limiter. Its refill timer is cancelled, which wakes any
+ * parked waiter; their next take reports ASX_E_INVALID_STATE.
+ *
+ * Postconditions: on success, the limiter's handle is invalid.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if limiter is
+ *   NULL, ASX_E_INVALID_STATE for a destroyed limiter.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_rate_limiter_destroy(const asx_rate_limiter *limiter);
+
 /* -------------------------------------------------------------------
  * Cancellation (bd-2cw.3)
  *
@@ -272,15 +851,37 @@ ASX_API ASX_MUST_USE asx_status asx_task_cancel_with_origin(
     asx_region_id origin_region,
     asx_task_id origin_task);
 
-/* Propagate cancellation to all tasks in a region.
+/* Propagate cancellation to all tasks in a region and its descendants.
+ *
+ * Regions are visited in pre-order (the region, then each child's
+ * subtree in open order) and tasks in spawn order, touching only the
+ * subtree's regions and their live tasks.
  *
  * Preconditions: region must be a valid region handle.
- * Postconditions: all running tasks in the region enter CancelRequested.
+ * Postconditions: all running tasks in the subtree enter CancelRequested,
+ *   with origin_region set to region.
  * Returns the number of tasks that received the cancel signal.
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API uint32_t asx_cancel_propagate(asx_region_id region,
                                        asx_cancel_kind kind);
 
+/* Shed load: cancel the count oldest tasks of region with
+ * ASX_CANCEL_RESOURCE.
+ *
+ * The region's live-task list is its age index: tasks join it at
+ * spawn and leave on completion, so a walk from its head meets them
+ * oldest first. Tasks already cancelling are skipped and not counted.
+ * The walk stops after count cancels or once no uncancelled task is
+ * left, so it costs O(count) plus the cancelling tasks ahead of the
+ * victims. Child regions are not touched.
+ *
+ * Postconditions: each shed task enters CancelRequested, with
+ *   origin_region set to region.
+ * Returns the number of tasks shed (0 if region is invalid).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API uint32_t asx_region_shed_oldest(asx_region_id region,
+                                         uint32_t count);
+
 /* Task checkpoint: observe cancel status and advance phase.
  * If in CancelRequested, transitions to Cancelling and applies
  * cleanup budget. Returns cancel status in *out.
@@ -315,6 +916,24 @@ ASX_API ASX_MUST_USE asx_status asx_task_finalize(asx_task_id id);
 ASX_API ASX_MUST_USE asx_status asx_task_get_cancel_phase(asx_task_id id,
                                                            asx_cancel_phase *out);
 
+/* Query where a task's cancel came from: the origin passed to
+ * asx_task_cancel_with_origin, or the region that propagated or shed
+ * it. Both outputs are ASX_INVALID_ID when the task was never
+ * cancelled, was cancelled without an origin, or its origin could not
+ * be recorded because ASX_MAX_TASKS attributed tasks were live.
+ *
+ * Preconditions: out_region and out_task must not be NULL; id must be
+ *   a valid task handle.
+ * Postconditions: on success, *out_region and *out_task hold the
+ *   recorded origin.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if an output is
+ *   NULL, ASX_E_NOT_FOUND if id is invalid.
+ * Thread-safety: not thread-safe; single-threaded mode only.
+ * See: API_MISUSE_CATALOG.md § Task Lifecycle. */
+ASX_API ASX_MUST_USE asx_status asx_task_get_cancel_origin(asx_task_id id,
+                                                            asx_region_id *out_region,
+                                                            asx_task_id *out_task);
+
 /* -------------------------------------------------------------------
  * Obligation lifecycle
  * ------------------------------------------------------------------- */
@@ -329,13 +948,72 @@ ASX_API ASX_MUST_USE asx_status asx_task_get_cancel_phase(asx_task_id id,
  * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_id is NULL,
  *   ASX_E_NOT_FOUND if region is invalid, ASX_E_STALE_HANDLE if
  *   generation mismatch, ASX_E_REGION_POISONED if poisoned,
- *   ASX_E_RESOURCE_EXHAUSTED if the obligation arena is full.
+ *   ASX_E_RESOURCE_EXHAUSTED if every obligation slot holds an
+ *   unresolved obligation and the arena cannot grow. Slots freed by
+ *   commit or abort are reused first, in O(1).
  * Ownership: caller owns the obligation; must commit or abort.
  * Thread-safety: not thread-safe; single-threaded mode only.
  * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_obligation_reserve(asx_region_id region,
                                                         asx_obligation_id *out_id);
 
+/* Reserve an obligation in the region of a claim token, spending one
+ * of its claims. As asx_obligation_reserve, but the slot was backed
+ * and the region's policy and quota consulted when the claim was
+ * taken.
+ *
+ * Preconditions: token holds a live ASX_RESOURCE_OBLIGATION claim; its
+ *   region is still OPEN; out_id must not be NULL.
+ * Postconditions: on success, *out_id holds an obligation handle in
+ *   RESERVED state and token->count is one lower.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if token or out_id
+ *   is NULL or the token is spent or of another kind, ASX_E_NOT_FOUND
+ *   / ASX_E_STALE_HANDLE if the region is gone, ASX_E_REGION_NOT_OPEN
+ *   if it is closing, ASX_E_REGION_POISONED if poisoned,
+ *   ASX_E_INVALID_STATE if a copy of the token already spent the
+ *   region's claims. Never ASX_E_RESOURCE_EXHAUSTED.
+ * Ownership: caller owns the obligation; must commit or abort.
+ * Thread-safety: not thread-safe; single-threaded mode only.
+ * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
+ASX_API ASX_MUST_USE asx_status asx_obligation_reserve_claimed(
+    asx_resource_token *token, asx_obligation_id *out_id);
+
+/* Give a RESERVED obligation a lease: once the runtime clock reaches
+ * deadline the obligation is aborted, with an ASX_TRACE_OBLIGATION_ABORT
+ * event carrying the deadline. The check runs once per scheduler round
+ * of the region and when a drain reaches the obligation check; a timer
+ * on the global wheel makes asx_scheduler_wait_idle wake for it. While
+ * every obligation left in a draining region is leased, the drain
+ * returns ASX_E_PENDING instead of ASX_E_OBLIGATIONS_UNRESOLVED.
+ *
+ * A later call replaces the lease; 0 removes it. Commit or abort
+ * drops it.
+ *
+ * Preconditions: id must be a valid obligation handle in RESERVED state.
+ * Postconditions: on success, the obligation carries the new lease.
+ * Returns ASX_OK on success, ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE if the slot was reused,
+ *   ASX_E_INVALID_STATE if the obligation is resolved,
+ *   ASX_E_RESOURCE_EXHAUSTED if ASX_MAX_OBLIGATIONS leases are held,
+ *   or the asx_timer_register error (the old lease stays).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_obligation_set_lease(asx_obligation_id id,
+                                                          asx_time deadline);
+
+/* Reserve an obligation with a lease: asx_obligation_reserve followed
+ * by asx_obligation_set_lease. If the lease cannot be set the
+ * reservation is aborted and its error returned.
+ *
+ * Preconditions: as asx_obligation_reserve.
+ * Postconditions: on success, *out_id holds a leased RESERVED obligation.
+ * Returns the errors of asx_obligation_reserve and
+ *   asx_obligation_set_lease.
+ * Ownership: caller owns the obligation; the lease aborts it if the
+ *   caller does not resolve it in time.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_obligation_reserve_leased(
+    asx_region_id region, asx_time deadline, asx_obligation_id *out_id);
+
 /* Commit a reserved obligation. Transitions: Reserved → Committed.
  *
  * Preconditions: id must be a valid obligation handle in RESERVED state.
@@ -346,6 +1024,23 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_reserve(asx_region_id region,
  * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_obligation_commit(asx_obligation_id id);
 
+/* Commit a batch of reserved obligations, as asx_obligation_commit on
+ * each id in array order: the same transitions, trace records and
+ * wakes. All-or-nothing: every handle is checked before any commits.
+ *
+ * Preconditions: ids holds n valid handles in RESERVED state, each at
+ *   most once; ids may be NULL when n is 0.
+ * Postconditions: on success, every obligation is COMMITTED; on
+ *   failure, none changed.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if ids is NULL and
+ *   n is not 0, ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for the first
+ *   invalid handle, ASX_E_INVALID_TRANSITION for the first one not
+ *   RESERVED or listed twice.
+ * Thread-safety: not thread-safe; single-threaded mode only.
+ * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
+ASX_API ASX_MUST_USE asx_status asx_obligation_commit_many(const asx_obligation_id *ids,
+                                                            uint32_t n);
+
 /* Abort a reserved obligation. Transitions: Reserved → Aborted.
  *
  * Preconditions: id must be a valid obligation handle in RESERVED state.
@@ -356,12 +1051,29 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_commit(asx_obligation_id id);
  * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_obligation_abort(asx_obligation_id id);
 
-/* Query the current state of an obligation.
+/* Abort every RESERVED obligation of a region in one pass over its
+ * reserved list, oldest reservation first, in O(reserved) without an
+ * arena scan. Equivalent to
+ * asx_obligation_abort on each in that order. Works in any region
+ * state, so a closing or poisoned region can be unblocked.
+ *
+ * Preconditions: region must be a valid handle.
+ * Postconditions: the region holds no RESERVED obligation; if
+ *   out_aborted is not NULL it holds the number aborted.
+ * Returns ASX_OK on success, ASX_E_NOT_FOUND if region is invalid,
+ *   ASX_E_STALE_HANDLE if generation mismatch.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_abort_obligations(asx_region_id region,
+                                                              uint32_t *out_aborted);
+
+/* Query the current state of an obligation. A resolved obligation
+ * reports its terminal state until a later reserve reuses its slot.
  *
  * Preconditions: out_state must not be NULL; id must be a valid handle.
  * Postconditions: on success, *out_state holds the obligation state.
  * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_state is NULL,
- *   ASX_E_NOT_FOUND if id is invalid.
+ *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE once the slot has been reused.
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API ASX_MUST_USE asx_status asx_obligation_get_state(asx_obligation_id id,
                                                           asx_obligation_state *out_state);
@@ -375,10 +1087,14 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_get_state(asx_obligation_id id,
  *
  * Preconditions: region must be a valid handle; budget must not be NULL
  *   and must have remaining polls > 0.
- * Postconditions: tasks are polled in arena-index order; event log is
+ * Postconditions: tasks are polled in arena-index order, filtered by
+ *   the scheduler mode (asx_scheduler_set_mode); event log is
  *   populated; budget is decremented.
  * Returns ASX_OK when all tasks complete (quiescent),
- *   ASX_E_BUDGET_EXHAUSTED if polls ran out before completion,
+ *   ASX_E_PENDING when every remaining task is parked (see waker.h);
+ *     call again after an event source wakes one,
+ *   ASX_E_POLL_BUDGET_EXHAUSTED if polls or reported cost
+ *     (asx_task_report_cost) ran out before completion,
  *   ASX_E_NOT_FOUND if region is invalid,
  *   ASX_E_STALE_HANDLE if generation mismatch,
  *   ASX_E_INVALID_ARGUMENT if budget is NULL.
@@ -387,6 +1103,232 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_get_state(asx_obligation_id id,
 ASX_API ASX_MUST_USE asx_status asx_scheduler_run(asx_region_id region,
                                                   asx_budget *budget);
 
+/* How asx_scheduler_run_all splits the remaining polls of each pass */
+typedef enum {
+    ASX_SCHED_SHARE_EQUAL    = 0,  /* same share for every runnable region */
+    ASX_SCHED_SHARE_BY_TASKS = 1,  /* in proportion to live task count */
+    ASX_SCHED_SHARE_IN_ORDER = 2   /* each region may use all that is left */
+} asx_scheduler_share;
+
+/* Run every region that has live tasks in one call.
+ *
+ * Works in passes. Each pass visits regions in ascending slot order
+ * and runs each region with a runnable task on its share of the polls
+ * left at the start of the pass, exactly as asx_scheduler_run would.
+ * A share never drops below the region's live task count, so each
+ * region finishes at least one full round. The event log is reset once
+ * per call and accumulates across regions.
+ *
+ * Preconditions: budget must not be NULL.
+ * Postconditions: budget is decremented by every poll made.
+ * Returns ASX_OK when no region has live tasks left,
+ *   ASX_E_PENDING when every remaining task is parked (see waker.h),
+ *   ASX_E_POLL_BUDGET_EXHAUSTED if polls ran out first,
+ *   ASX_E_INVALID_ARGUMENT for a NULL budget or unknown policy,
+ *   or a fault containment error as from asx_scheduler_run.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_run_all(asx_budget *budget,
+                                                      asx_scheduler_share policy);
+
+/* Task priority levels: 0 is the most urgent */
+#define ASX_TASK_PRIORITY_LEVELS   32u
+#define ASX_TASK_PRIORITY_DEFAULT  16u
+#define ASX_SCHED_AGING_MAX_ROUNDS 2048u
+#define ASX_TASK_HOT_POLLS_MAX     255u
+
+/* Which ready tasks a scheduler round polls */
+typedef enum {
+    ASX_SCHED_MODE_ROUND_ROBIN = 0,  /* every ready task (default) */
+    ASX_SCHED_MODE_PRIORITY    = 1,  /* the most urgent task priority */
+    ASX_SCHED_MODE_EDF         = 2   /* the earliest deadline bucket */
+} asx_scheduler_mode;
+
+/* Select the scheduler mode for asx_scheduler_run and
+ * asx_scheduler_run_all; asx_parallel_run stays round-robin.
+ *
+ * Outside round-robin each round polls only the ready tasks at the
+ * most urgent occupied level, in arena-index order; the rest wait,
+ * and cancellation completions still happen for every task. PRIORITY
+ * levels are task priorities. EDF levels are power-of-two buckets of
+ * the time left to each task's scheduling deadline: level 0 is due
+ * (or under 1 us away), level n is under 2^n us away up to level 30,
+ * and tasks without a deadline sit at level 31. Every aging_rounds
+ * rounds a task waits raise it one level until it is polled; 0
+ * disables aging, so a busy urgent level can starve the others.
+ * asx_runtime_reset restores round-robin without aging.
+ *
+ * Returns ASX_OK, or ASX_E_INVALID_ARGUMENT for an unknown mode or
+ *   aging_rounds above ASX_SCHED_AGING_MAX_ROUNDS.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_set_mode(asx_scheduler_mode mode,
+                                                       uint32_t aging_rounds);
+
+/* Batch poll: poll n tasks that share one poll function at once.
+ * results[k] receives what poll_fn(user_datas[k], task_ids[k]) would
+ * have returned; tasks appear in ascending arena index. */
+typedef void (*asx_task_batch_poll_fn)(void *const *user_datas,
+                                       const asx_task_id *task_ids,
+                                       uint32_t n, asx_status *results);
+
+#define ASX_SCHED_BATCH_POLL_MAX 64u  /* tasks per batch call */
+#define ASX_SCHED_BATCH_FN_MAX   8u   /* registered poll functions */
+
+/* Let asx_scheduler_run and asx_scheduler_run_all poll runs of tasks
+ * spawned with poll_fn through one batch_fn call instead of one
+ * indirect call per task; batch_fn NULL drops the registration.
+ *
+ * A batch is a run of consecutive ready-list tasks with poll_fn, up to
+ * ASX_SCHED_BATCH_POLL_MAX and the polls left in the budget; tasks
+ * with hot polls, a pending cancel or, in ranked modes, another level
+ * end a run and are polled singly. Each batched task consumes one
+ * poll, and results are applied in arena order with the same
+ * scheduler events and trace records as single polls, so the trace is
+ * unchanged as long as batch_fn emits none itself (its events land
+ * before the batch's SCHED_POLL records). A cost quota is checked
+ * before the batch, not between its tasks, and a failure that ends
+ * the run is returned only once every batched result is applied.
+ *
+ * Inside batch_fn each task may park itself (waker.h), use the
+ * channel send/receive protocol, whose wakes are deferred to the end
+ * of the batch, and report its cost; obligations are not attributed
+ * to a task. asx_parallel_run always polls singly.
+ * asx_runtime_reset drops every registration.
+ *
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT if poll_fn is NULL,
+ *   ASX_E_RESOURCE_EXHAUSTED if ASX_SCHED_BATCH_FN_MAX functions are
+ *     already registered.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_register_batch_poll(
+    asx_task_poll_fn poll_fn, asx_task_batch_poll_fn batch_fn);
+
+/* Set a task's priority level for ASX_SCHED_MODE_PRIORITY. Tasks
+ * spawn at ASX_TASK_PRIORITY_DEFAULT.
+ *
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT if priority >= ASX_TASK_PRIORITY_LEVELS,
+ *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE once the slot has been reused.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_set_priority(asx_task_id id,
+                                                      uint32_t priority);
+
+/* Let a task that returns ASX_E_PENDING be polled again at once, up
+ * to polls more times in the same round, instead of waiting for the
+ * next round. Meant for tasks that yield only because they hit their
+ * own slice limit. Each re-poll consumes a budget poll and is logged
+ * and traced as a regular poll, so the event stream stays
+ * deterministic. A park, completion, pending cancel or spent budget
+ * ends the run of re-polls. asx_parallel_run ignores the quota.
+ * Tasks spawn with 0.
+ *
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT if polls > ASX_TASK_HOT_POLLS_MAX,
+ *   ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE once the slot has been reused.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_set_hot_polls(asx_task_id id,
+                                                       uint32_t polls);
+
+/* Set the absolute time (asx_runtime_now_ns clock) that orders a task
+ * under ASX_SCHED_MODE_EDF; 0 clears it. Ordering only: a passed
+ * deadline cancels nothing (see asx_region_set_deadline for that).
+ *
+ * Returns ASX_OK, ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_STALE_HANDLE once the slot has been reused.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_set_sched_deadline(asx_task_id id,
+                                                            asx_time deadline);
+
+/* Report cost a poll consumed, in whatever unit the caller's budgets
+ * use (work units, bytes, measured ns). Reports accumulate, saturating
+ * at UINT32_MAX, and the scheduler charges them to the run's
+ * cost_quota once the poll returns. A charge larger than what is left
+ * empties the quota, and the run then stops with
+ * ASX_E_POLL_BUDGET_EXHAUSTED before the next poll. Polls that report
+ * nothing are free: unconstrained cost budgets are unaffected.
+ *
+ * Returns ASX_OK, ASX_E_NOT_FOUND if self is invalid,
+ *   ASX_E_STALE_HANDLE once the slot has been reused.
+ * Thread-safety: callable from tasks polled in a parallel batch, for
+ *   their own handle. */
+ASX_API ASX_MUST_USE asx_status asx_task_report_cost(asx_task_id self,
+                                                     uint32_t cost);
+
+/* Block in the reactor until the next timer on the global wheel is due,
+ * then fire every expired timer, waking tasks parked on them. Call this
+ * when asx_scheduler_run returns ASX_E_PENDING instead of re-polling.
+ *
+ * The reactor timeout is the time to asx_timer_next_deadline(), rounded
+ * up to milliseconds and capped at max_wait_ms (the wait used when no
+ * timer is registered). A timer already due skips the reactor wait.
+ * In deterministic builds the ghost reactor receives that deadline as
+ * its logical step. The gap is spent per asx_scheduler_set_wait_policy.
+ *
+ * Preconditions: runtime hooks installed with a clock and, unless a
+ *   timer is already due, a reactor wait function; out_fired not NULL.
+ * Postconditions: *out_fired holds the number of timers fired.
+ * Returns ASX_OK on success,
+ *   ASX_E_INVALID_ARGUMENT if out_fired is NULL,
+ *   ASX_E_INVALID_STATE if the clock or reactor hook is missing,
+ *   or the reactor hook's own error.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_wait_idle(uint32_t max_wait_ms,
+                                                        uint32_t *out_fired);
+
+/* Select how asx_scheduler_wait_idle spends an idle gap, typically
+ * cfg.wait_policy from asx_runtime_config_init. SLEEP (the default)
+ * blocks in the reactor. BUSY_SPIN pauses the CPU and YIELD yields the
+ * thread (the thread hook's yield_fn), both polling the reactor with a
+ * zero timeout until something is ready or the deadline passes; they
+ * need a reactor wait_fn. ADAPTIVE spins like BUSY_SPIN for up to
+ * asx_scheduler_spin_window_ns, then sleeps for the rest of the gap;
+ * the window doubles after a wait the spin caught and halves after one
+ * that parked, between 1 us and 1 ms. Any spin parks early once the
+ * clock stops moving, so simulated clocks keep working. Deterministic
+ * builds always sleep. asx_runtime_reset restores SLEEP.
+ *
+ * Returns ASX_OK, or ASX_E_INVALID_ARGUMENT for an unknown policy.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_set_wait_policy(asx_wait_policy policy);
+
+/* The wait policy set by asx_scheduler_set_wait_policy. */
+ASX_API asx_wait_policy asx_scheduler_wait_policy(void);
+
+/* Current ADAPTIVE spin window in nanoseconds (starts at 50 us). */
+ASX_API uint64_t asx_scheduler_spin_window_ns(void);
+
+/* Run region as asx_scheduler_run, and whenever every task is parked
+ * wait out the gap with asx_scheduler_wait_idle and run again, until
+ * the region is quiescent or the next timer lies past horizon. Under
+ * an asx_sim_clock each gap is a jump straight to the next deadline,
+ * so simulated days run in milliseconds, replaying identically.
+ *
+ * Preconditions: as asx_scheduler_run and asx_scheduler_wait_idle;
+ *   budget is shared by every run.
+ * Returns ASX_OK once the region is quiescent,
+ *   ASX_E_PENDING if tasks stay parked with no timer registered, or
+ *     the next deadline is past horizon (the clock is left before it),
+ *   ASX_E_INVALID_STATE if a wait neither fired a timer nor moved the
+ *     clock, as with a logical clock nothing advances,
+ *   or the errors of asx_scheduler_run and asx_scheduler_wait_idle.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_run_until(asx_region_id region,
+                                                        asx_budget *budget,
+                                                        asx_time horizon);
+
+/* Coarse time for deadline checks that tolerate a round's staleness,
+ * e.g. asx_budget_is_past_deadline. Inside asx_scheduler_run or
+ * asx_parallel_run the first call in each round reads the clock hook
+ * and later calls in that round return the same value; outside a run
+ * every call reads the hook.
+ *
+ * Preconditions: out_now not NULL.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if out_now is NULL, or the
+ *   error from asx_runtime_now_ns.
+ * Thread-safety: callable from tasks polled in a parallel batch. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_coarse_now_ns(asx_time *out_now);
+
 /* -------------------------------------------------------------------
  * Scheduler event sequencing (deterministic replay support)
  *
@@ -396,7 +1338,8 @@ ASX_API ASX_MUST_USE asx_status asx_scheduler_run(asx_region_id region,
  * replay identity verification.
  *
  * Tie-break rule: tasks are polled in arena index order within a
- * round. Index order is stable and deterministic.
+ * round, also within a level under the priority and EDF modes. Index
+ * order is stable and deterministic.
  * ------------------------------------------------------------------- */
 
 typedef enum {
@@ -404,7 +1347,8 @@ typedef enum {
     ASX_SCHED_EVENT_COMPLETE      = 1,  /* task completed (OK or error) */
     ASX_SCHED_EVENT_BUDGET        = 2,  /* budget exhausted */
     ASX_SCHED_EVENT_QUIESCENT     = 3,  /* all tasks complete */
-    ASX_SCHED_EVENT_CANCEL_FORCED = 4   /* task force-completed: cleanup budget exhausted */
+    ASX_SCHED_EVENT_CANCEL_FORCED = 4,  /* task force-completed: cleanup budget exhausted */
+    ASX_SCHED_EVENT_IDLE          = 5   /* remaining tasks all parked (waker.h) */
 } asx_scheduler_event_kind;
 
 typedef struct {
@@ -414,18 +1358,45 @@ typedef struct {
     uint32_t                 round;     /* scheduler round (0-based) */
 } asx_scheduler_event;
 
-/* Read the total event count from the last scheduler_run call.
+/* The log is a ring: past its capacity each event overwrites the
+ * oldest. The inline ring holds ASX_SCHED_EVENT_LOG_CAPACITY events
+ * (a power of two; override at build time); asx_scheduler_event_log_reserve
+ * grows it from the allocator hook up to ASX_SCHED_EVENT_LOG_MAX. */
+#ifndef ASX_SCHED_EVENT_LOG_CAPACITY
+#define ASX_SCHED_EVENT_LOG_CAPACITY 256u
+#endif
+#define ASX_SCHED_EVENT_LOG_MAX      65536u
+
+/* Read the total event count from the last scheduler_run call,
+ * including events the ring has since overwritten.
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API uint32_t asx_scheduler_event_count(void);
 
-/* Read event at index (0-based). Returns 1 on success, 0 on out-of-bounds.
+/* Index of the oldest event still in the ring: 0 until the log wraps.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API uint32_t asx_scheduler_event_first(void);
+
+/* Read event at index (0-based). Returns 1 on success, 0 on out-of-bounds
+ * or for an event the ring has overwritten.
  *
- * Preconditions: out must not be NULL; index < asx_scheduler_event_count().
+ * Preconditions: out must not be NULL;
+ *   asx_scheduler_event_first() <= index < asx_scheduler_event_count().
  * Postconditions: on success (returns 1), *out holds the event.
  * Thread-safety: not thread-safe; single-threaded mode only.
  * See: API_MISUSE_CATALOG.md § Scheduler. */
 ASX_API int asx_scheduler_event_get(uint32_t index, asx_scheduler_event *out);
 
+/* Resize the event ring to hold at least capacity events, rounded up
+ * to a power of two. Capacities up to ASX_SCHED_EVENT_LOG_CAPACITY go
+ * back to the inline ring and free an allocated one. The newest events
+ * that fit are kept. The ring survives asx_runtime_reset.
+ *
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT if capacity > ASX_SCHED_EVENT_LOG_MAX,
+ *   or the allocator hook's error (the old ring stays in place).
+ * Thread-safety: not thread-safe; call outside scheduler runs. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_event_log_reserve(uint32_t capacity);
+
 /* Reset event log (called automatically by asx_scheduler_run). */
 ASX_API void asx_scheduler_event_reset(void);
 
@@ -446,21 +1417,150 @@ ASX_API ASX_MUST_USE asx_status asx_quiescence_check(asx_region_id id);
 /* Drain a region: run scheduler then close through to CLOSED.
  * This is the high-level "shut down cleanly" operation.
  *
+ * Descendant regions are closed and cancelled with the region (in
+ * pre-order), then drained leaves first, each child before its parent,
+ * all from the one budget. An error from a descendant is returned as
+ * is; calling again resumes where the drain stopped.
+ *
  * Preconditions: id must be a valid region handle; budget must not be NULL.
- * Postconditions: on success, region reaches CLOSED state; all tasks
- *   completed; cleanup destructors called in LIFO order.
+ * Postconditions: on success, region and all its descendants reach
+ *   CLOSED state; all tasks completed; deferred captured-state
+ *   destructors (asx_region_options.dtor_batch) run in completion
+ *   order, then cleanup destructors in LIFO order.
  * Returns ASX_OK on success, ASX_E_NOT_FOUND if id is invalid,
  *   ASX_E_INVALID_ARGUMENT if budget is NULL,
- *   ASX_E_BUDGET_EXHAUSTED if not all tasks completed within budget.
+ *   ASX_E_BUDGET_EXHAUSTED if not all tasks completed within budget,
+ *   ASX_E_PENDING while only leased obligations (asx_obligation_set_lease)
+ *   hold the region open.
  * Thread-safety: not thread-safe; single-threaded mode only.
  * See: API_MISUSE_CATALOG.md § Region Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_region_drain(asx_region_id id,
                                                  asx_budget *budget);
 
+/* Where asx_region_drain_step stopped */
+typedef enum {
+    ASX_REGION_DRAIN_CHILDREN = 0,  /* descendants still draining */
+    ASX_REGION_DRAIN_TASKS    = 1,  /* the region's own tasks still running */
+    ASX_REGION_DRAIN_CLEANUP  = 2,  /* cleanup callbacks still pending */
+    ASX_REGION_DRAIN_DONE     = 3   /* region and subtree CLOSED */
+} asx_region_drain_phase;
+
+/* Make bounded progress on asx_region_drain.
+ *
+ * Does the same work in the same order as asx_region_drain, but stops
+ * once budget's polls are spent or cleanup_quota cleanup callbacks
+ * (counted over the whole subtree) have run. State lives in the
+ * regions themselves, so steps can be interleaved with other
+ * scheduler work and asx_region_drain can finish a stepped drain.
+ *
+ * Preconditions: id must be a valid region handle; budget and
+ *   out_phase must not be NULL.
+ * Postconditions: *out_phase holds the phase the drain is in on
+ *   ASX_OK and ASX_E_PENDING.
+ * Returns ASX_OK once the subtree is CLOSED (phase DONE),
+ *   ASX_E_PENDING if a quota stopped the step,
+ *   ASX_E_INVALID_ARGUMENT if budget or out_phase is NULL,
+ *   otherwise the errors of asx_region_drain.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_drain_step(
+    asx_region_id id, asx_budget *budget, uint32_t cleanup_quota,
+    asx_region_drain_phase *out_phase);
+
 /* Reset all runtime state (test support only).
- * Clears all regions and tasks. Not for production use. */
+ * Clears all regions and tasks. Only slots used since the previous
+ * reset are rewritten, so the cost follows what was used. Handle
+ * generations restart at 0 unless built with ASX_HANDLE_EPOCH (the
+ * default when not deterministic), which keeps pre-reset handles
+ * stale. Not for production use. */
 ASX_API void asx_runtime_reset(void);
 
+/* -------------------------------------------------------------------
+ * Runtime contexts
+ *
+ * An asx_runtime is one complete runtime kept in caller storage: its
+ * arenas and claims, scheduler, wakers and events, trace and replay,
+ * hooks and faults, channels, timers, error ledgers and debug
+ * monitors. One context is bound at a time and every other call acts
+ * on it. A process starts with an implicit context bound, so code that
+ * never creates one is unaffected.
+ *
+ * Binding saves the outgoing context into its storage and loads the
+ * incoming one, so each context sees only its own regions, tasks,
+ * channels and timers; a handle from one context is meaningless in
+ * another. Contexts are independent, not concurrent: the binding is
+ * process-wide and not thread-safe, so calls on different contexts
+ * must not overlap, even from different threads, and none may bind
+ * from inside a poll, callback or scheduler run. Contexts therefore
+ * give no multi-core scaling; run them in turn on one thread.
+ *
+ * A bind copies the whole state (asx_runtime_context_size() bytes,
+ * mostly trace rings) out and back in and restarts snapshot dirty
+ * tracking, and asx_runtime_context_fini binds twice. Bind at coarse
+ * boundaries (a tenant's turn), not per operation. Digest modes,
+ * adapter tables and codec settings stay process-wide.
+ * ------------------------------------------------------------------- */
+
+typedef struct asx_runtime asx_runtime;
+
+/* Bytes of storage a context needs; fixed for a given build.
+ * Thread-safety: safe to call concurrently. */
+ASX_API uint32_t asx_runtime_context_size(void);
+
+/* Create a context in storage, in the state a process starts in (no
+ * hooks installed, nothing open). It is not bound.
+ *
+ * Preconditions: storage is 8-byte aligned and holds at least
+ *   asx_runtime_context_size() bytes; out must not be NULL.
+ * Postconditions: on ASX_OK, *out refers to the new context.
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT for NULL or misaligned storage or NULL out,
+ *   ASX_E_BUFFER_TOO_SMALL if size is under asx_runtime_context_size().
+ * Ownership: storage must outlive the context; release its allocations
+ *   with asx_runtime_context_fini before reusing the storage.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_context_init(void *storage,
+                                                         uint32_t size,
+                                                         asx_runtime **out);
+
+/* Give the implicit context storage, so it can be bound away from and
+ * back to. It stays bound.
+ *
+ * Preconditions: as for asx_runtime_context_init.
+ * Returns ASX_OK, the errors of asx_runtime_context_init, or
+ *   ASX_E_INVALID_STATE once a context has been adopted or bound.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_context_adopt(void *storage,
+                                                          uint32_t size,
+                                                          asx_runtime **out);
+
+/* Bind ctx, saving the bound context into its storage.
+ *
+ * Preconditions: ctx came from asx_runtime_context_init or _adopt and
+ *   has not been finalized; no scheduler run, poll or callback is in
+ *   progress.
+ * Returns ASX_OK (also when ctx is already bound),
+ *   ASX_E_INVALID_ARGUMENT for NULL or finalized ctx,
+ *   ASX_E_INVALID_STATE while the implicit context is bound without
+ *   having been adopted (its state would be lost).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_context_bind(asx_runtime *ctx);
+
+/* The bound context, or NULL while the implicit one is bound and has
+ * not been adopted.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API asx_runtime *asx_runtime_context_current(void);
+
+/* Release what ctx allocated through its hooks (grown arenas, region
+ * captures, channel rings, timer chunks, a grown event log) and
+ * invalidate it. The bound context is untouched.
+ *
+ * Preconditions: ctx is a valid context other than the bound one, and
+ *   the bound context was created or adopted (it is bound back).
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL or finalized ctx,
+ *   ASX_E_INVALID_STATE if ctx is bound or no context was adopted.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_context_fini(asx_runtime *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,154 @@
+/*
+ * asx/runtime/scenario.h — in-process dsl-v1 scenario executor
+ *
+ * Compiles the ops of a scenario (docs/SCENARIO_DSL.md) once into a
+ * compact bytecode array and replays it directly against the runtime
+ * API, so a conformance sweep runs thousands of fixtures per process
+ * instead of one process per fixture.
+ *
+ * Compilation parses a JSON object holding an "ops" array: the dsl-v1
+ * envelope itself, or a fixture's input_json. Opcode strings become
+ * opcodes, and each entity name ("r1", "t1") becomes a small slot
+ * number bound to one kind (region, task, obligation, channel, permit,
+ * timer), so running touches no strings. Unknown opcodes, names used
+ * as two kinds and malformed ops are rejected at compile time.
+ *
+ * Op arguments, by opcode:
+ *   SpawnRegion       region
+ *   CloseRegion       region
+ *   SpawnTask         region, task, polls (polls to completion, default 1)
+ *   PollTask          region, polls (scheduler budget, default 1)
+ *   RequestCancel     task, kind ("User", "Deadline", ... default "User")
+ *   AckCancel         task (asx_checkpoint on its behalf)
+ *   ReserveObligation region, obligation
+ *   CommitObligation  obligation
+ *   AbortObligation   obligation
+ *   ChannelReserve    channel, permit, region, capacity (default 4); the
+ *                     first reserve on a channel creates it in region
+ *   ChannelSend       permit, value (default 0)
+ *   ChannelAbort      permit
+ *   TimerRegister     timer, deadline (ns on the simulated clock)
+ *   TimerCancel       timer
+ *   AdvanceTime       ns, then fires every timer due
+ *   Assert            one of region, task or obligation, and state
+ *                     ("Open", "Completed", "Committed", ...)
+ *   noop
+ *
+ * An op's "expect": {"status": "ASX_E_..."} is checked against the
+ * status the op returned; without it the status is only recorded.
+ * Assert always expects ASX_OK, returning ASX_E_REPLAY_MISMATCH when
+ * the state differs.
+ *
+ * Each run starts from asx_runtime_reset with an asx_prng seeded from
+ * the program's seed and an asx_sim_clock at 0 installed as hooks, so
+ * the same program replays identically.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_SCENARIO_H
+#define ASX_RUNTIME_SCENARIO_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Distinct entity names one program may bind */
+#define ASX_SCENARIO_MAX_NAMES 64u
+
+/* Non-OK op statuses kept per run, in op order */
+#define ASX_SCENARIO_MAX_ERRORS 16u
+
+/* Slot of an op without that argument */
+#define ASX_SCENARIO_NO_SLOT 0xFFu
+
+/* asx_scenario_op.flags: status is checked against expect */
+#define ASX_SCENARIO_OP_EXPECT 0x01u
+
+typedef enum {
+    ASX_SCENARIO_NOOP = 0,
+    ASX_SCENARIO_SPAWN_REGION,
+    ASX_SCENARIO_CLOSE_REGION,
+    ASX_SCENARIO_SPAWN_TASK,
+    ASX_SCENARIO_POLL_TASK,
+    ASX_SCENARIO_REQUEST_CANCEL,
+    ASX_SCENARIO_ACK_CANCEL,
+    ASX_SCENARIO_RESERVE_OBLIGATION,
+    ASX_SCENARIO_COMMIT_OBLIGATION,
+    ASX_SCENARIO_ABORT_OBLIGATION,
+    ASX_SCENARIO_CHANNEL_RESERVE,
+    ASX_SCENARIO_CHANNEL_SEND,
+    ASX_SCENARIO_CHANNEL_ABORT,
+    ASX_SCENARIO_TIMER_REGISTER,
+    ASX_SCENARIO_TIMER_CANCEL,
+    ASX_SCENARIO_ADVANCE_TIME,
+    ASX_SCENARIO_ASSERT_REGION,
+    ASX_SCENARIO_ASSERT_TASK,
+    ASX_SCENARIO_ASSERT_OBLIGATION
+} asx_scenario_opcode;
+
+/* One compiled op. a, b and c are name slots (ASX_SCENARIO_NO_SLOT
+ * when unused); arg is the op's number (polls, kind, state, ns,
+ * deadline, value or capacity). */
+typedef struct {
+    uint32_t   id;        /* the op's "id" */
+    uint8_t    code;      /* asx_scenario_opcode */
+    uint8_t    flags;
+    uint8_t    a;         /* region, task, obligation, channel, permit or timer */
+    uint8_t    b;         /* region of a spawn or reserve; permit of a channel reserve */
+    uint8_t    c;         /* region of a channel reserve */
+    asx_status expect;
+    uint64_t   arg;
+} asx_scenario_op;
+
+/* Compiled scenario over caller-owned op storage */
+typedef struct {
+    asx_scenario_op *ops;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t names;       /* slots bound */
+    uint64_t seed;        /* the envelope's "seed", 0 if absent */
+} asx_scenario_program;
+
+/* Outcome of one run */
+typedef struct {
+    uint32_t   executed;     /* ops run, including a mismatching one */
+    uint32_t   failed_id;    /* id of the op that mismatched */
+    asx_status expected;     /* its expected status */
+    asx_status actual;       /* the status it returned */
+    uint32_t   error_count;  /* ops that returned non-OK */
+    asx_status errors[ASX_SCENARIO_MAX_ERRORS];
+} asx_scenario_result;
+
+/* Bind program to capacity ops at ops. */
+ASX_API void asx_scenario_program_init(asx_scenario_program *program,
+                                       asx_scenario_op *ops,
+                                       uint32_t capacity);
+
+/* Compile the "ops" (and "seed", if present) of the JSON object at
+ * json into program, replacing its contents.
+ * ASX_E_INVALID_ARGUMENT for NULL, malformed JSON, an unknown opcode,
+ * kind, state or status name, a missing or mistyped argument, or more
+ * than ASX_SCENARIO_MAX_NAMES names; ASX_E_BUFFER_TOO_SMALL when the
+ * ops exceed the capacity. On failure program->count is 0. */
+ASX_API ASX_MUST_USE asx_status asx_scenario_compile(asx_scenario_program *program,
+                                                     const char *json);
+
+/* Reset the runtime and run program's ops in order, stopping at the
+ * first op whose status differs from its expectation.
+ * Returns ASX_OK when every expectation held,
+ *   ASX_E_REPLAY_MISMATCH at a mismatch (see out),
+ *   ASX_E_INVALID_ARGUMENT for NULL,
+ *   or the hook installation error. */
+ASX_API ASX_MUST_USE asx_status asx_scenario_run(const asx_scenario_program *program,
+                                                 asx_scenario_result *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_SCENARIO_H */
@@ -0,0 +1,137 @@
+/*
+ * asx/runtime/slab.h — size-class slab allocator hook
+ *
+ * A built-in asx_allocator_hooks implementation for runtimes whose
+ * allocations cluster at a few sizes (task captures, channel rings,
+ * codec buffers). A request is rounded up to the smallest size class
+ * that fits and served from that class's free list. Blocks are carved
+ * from chunks taken from a backing allocator (the libc default unless
+ * configured) and go back to their class on free; chunks are returned
+ * only by asx_slab_destroy. Requests above the largest class pass
+ * straight through to the backing allocator.
+ *
+ * Steady state without allocator calls: asx_slab_reserve each class,
+ * then asx_slab_seal. A sealed slab never calls the backing allocator
+ * again and fails requests its free lists cannot serve. Sealing the
+ * slab leaves asx_runtime_alloc working, whereas
+ * asx_runtime_seal_allocator refuses every allocation.
+ *
+ * In non-deterministic GCC/Clang builds a spin lock guards the shared
+ * free lists, and per-thread caches (opt-in) keep up to
+ * ASX_SLAB_CACHE_DEPTH blocks per class so most alloc/free pairs on a
+ * worker thread take no lock. Deterministic builds run single-threaded
+ * and use neither.
+ *
+ * Blocks are aligned to 8 bytes, enough for every runtime type.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_SLAB_H
+#define ASX_RUNTIME_SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_config.h>
+#include <asx/core/resource.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ASX_SLAB_MAX_CLASSES  8u
+#define ASX_SLAB_CACHE_DEPTH  16u     /* per-thread blocks per class */
+#define ASX_SLAB_CHUNK_BYTES  4096u   /* default refill chunk */
+
+/* 1 when per-thread caches and locking are compiled in */
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define ASX_SLAB_THREADED 1
+#else
+#define ASX_SLAB_THREADED 0
+#endif
+
+typedef struct {
+    size_t class_sizes[ASX_SLAB_MAX_CLASSES]; /* ascending; 0 ends the list */
+    uint32_t chunk_bytes;          /* backing bytes per refill */
+    int thread_cache;              /* nonzero: per-thread caches */
+    asx_allocator_hooks backing;   /* where chunks come from */
+} asx_slab_config;
+
+/* One size class. Members are private. */
+typedef struct {
+    size_t   block_size;           /* usable bytes per block */
+    void    *free_head;
+    uint32_t blocks_per_chunk;
+    uint32_t total;                /* blocks carved so far */
+    uint32_t free_count;           /* blocks on the shared free list */
+} asx_slab_class;
+
+/* Caller-owned allocator state. Members are private. */
+typedef struct {
+    asx_slab_class classes[ASX_SLAB_MAX_CLASSES];
+    uint32_t class_count;
+    uint32_t large_live;           /* pass-through allocations held */
+    asx_allocator_hooks backing;
+    void    *chunks;               /* backing chunks, linked for destroy */
+    uint64_t epoch;                /* tells thread caches apart */
+    uint32_t lock;
+    uint8_t  sealed;
+    uint8_t  thread_cache;
+} asx_slab;
+
+/* Defaults: classes 16, 32, ... 2048 bytes, 4 KiB chunks, no thread
+ * caches, libc backing allocator. */
+ASX_API void asx_slab_config_init(asx_slab_config *cfg);
+
+/* Set up an empty slab. cfg NULL takes the defaults.
+ * ASX_E_INVALID_ARGUMENT unless the class sizes are nonzero and strictly
+ * ascending and the backing allocator has malloc and free. */
+ASX_API ASX_MUST_USE asx_status asx_slab_init(asx_slab *slab,
+                                              const asx_slab_config *cfg);
+
+/* Return every chunk to the backing allocator. Blocks still held and
+ * pass-through allocations become invalid. */
+ASX_API void asx_slab_destroy(asx_slab *slab);
+
+/* Carve blocks until size's class has at least count free.
+ * ASX_E_INVALID_ARGUMENT: size exceeds the largest class.
+ * ASX_E_INVALID_STATE: sealed. ASX_E_RESOURCE_EXHAUSTED: backing failed. */
+ASX_API ASX_MUST_USE asx_status asx_slab_reserve(asx_slab *slab, size_t size,
+                                                 uint32_t count);
+
+/* Stop calling the backing allocator; only reserved blocks are served.
+ * ASX_E_INVALID_STATE if already sealed. */
+ASX_API ASX_MUST_USE asx_status asx_slab_seal(asx_slab *slab);
+
+/* Allocator hooks; ctx is the slab. realloc within a block's class
+ * stays in place. Freeing a pointer from another allocator is
+ * undefined. */
+ASX_API void *asx_slab_alloc(void *ctx, size_t size);
+ASX_API void *asx_slab_realloc(void *ctx, void *ptr, size_t size);
+ASX_API void  asx_slab_free(void *ctx, void *ptr);
+
+/* Point hooks' allocator at slab. */
+ASX_API ASX_MUST_USE asx_status asx_slab_install(asx_slab *slab,
+                                                 asx_runtime_hooks *hooks);
+
+/* Return the calling thread's cached blocks to the shared lists. Call
+ * on each worker before it exits; until then its cache counts as used. */
+ASX_API void asx_slab_thread_flush(asx_slab *slab);
+
+/*
+ * Block utilization as ASX_RESOURCE_ALLOCATOR: capacity is blocks
+ * carved, used is blocks held by callers or thread caches, remaining
+ * is blocks free on the shared lists. class_index UINT32_MAX sums all
+ * classes. ASX_E_INVALID_ARGUMENT for NULL or an unknown class.
+ */
+ASX_API ASX_MUST_USE asx_status asx_slab_snapshot(asx_slab *slab,
+                                                  uint32_t class_index,
+                                                  asx_resource_snapshot *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_SLAB_H */
@@ -6,6 +6,17 @@
  * conformance testing. Snapshots are serializable to JSON for
  * comparison against fixture expected_final_snapshot fields.
  *
+ * Records are indexed by arena slot; an unused slot has id
+ * ASX_INVALID_ID and the counts are the number of records in use.
+ * Lifecycle transitions mark the slots they change, so capturing again
+ * into the snapshot captured last rebuilds only those slots. Any other
+ * snapshot, or the first capture after asx_runtime_reset, is rebuilt
+ * in full.
+ *
+ * A snapshot also persists in a binary form, whole or as a delta
+ * against an earlier snapshot, and can be restored into the arenas
+ * after a restart (see below).
+ *
  * SPDX-License-Identifier: MIT
  */
 
@@ -33,6 +44,7 @@ typedef struct {
     uint32_t         task_count;
     uint32_t         task_total;
     int              poisoned;
+    asx_region_id    parent;     /* ASX_INVALID_ID for a root or CLOSED */
 } asx_snapshot_region;
 
 typedef struct {
@@ -66,6 +78,7 @@ typedef struct {
     uint32_t              obligation_count;
     asx_snapshot_obligation obligations[ASX_SNAPSHOT_MAX_OBLIGATIONS];
     uint64_t              event_hash;    /* hash chain at capture time */
+    uint64_t              capture_mark;  /* capture this reflects; not compared */
 } asx_runtime_snapshot;
 
 /* ------------------------------------------------------------------ */
@@ -76,7 +89,9 @@ typedef struct {
 ASX_API void asx_runtime_snapshot_init(asx_runtime_snapshot *snap);
 
 /* Capture current runtime state into snapshot.
- * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if snap is NULL. */
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if snap is NULL,
+ * ASX_E_BUFFER_TOO_SMALL if a live entity's slot lies beyond the
+ * snapshot's capacity (the snapshot is left unchanged). */
 ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_capture(
     asx_runtime_snapshot *snap);
 
@@ -92,6 +107,109 @@ ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_eq(
     const asx_runtime_snapshot *a,
     const asx_runtime_snapshot *b);
 
+/* Digest over the records in use, the counts and event_hash (WORD64
+ * mixer). capture_mark does not contribute. 0 for NULL. */
+ASX_API uint64_t asx_runtime_snapshot_digest(const asx_runtime_snapshot *snap);
+
+/* ------------------------------------------------------------------ */
+/* Binary persistence                                                  */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Wire format (little-endian):
+ *   Header (40 bytes):
+ *     [0..3]   magic        "ASXs" (0x41535873)
+ *     [4..7]   version      1, ASX_SNAPSHOT_BINARY_FLAG_DELTA in the
+ *                           upper half for a delta
+ *     [8..11]  record_count
+ *     [12..15] reserved, 0
+ *     [16..23] event_hash
+ *     [24..31] base_digest  digest of the snapshot a delta applies
+ *                           to; 0 for a full snapshot
+ *     [32..39] digest       digest of the snapshot after decoding
+ *
+ *   Per record (32 bytes each), ascending kind then slot:
+ *     [0]      kind         1 region, 2 task, 3 obligation; with
+ *                           ASX_SNAPSHOT_RECORD_CLEARED the slot is
+ *                           emptied and the other fields are 0
+ *     [1]      state
+ *     [2..3]   slot
+ *     [4..7]   a            region task_count, task outcome_status
+ *     [8..11]  b            region task_total
+ *     [12..15] c            region poisoned
+ *     [16..23] id
+ *     [24..31] link         region parent, task/obligation region
+ *
+ * A full snapshot lists every record in use. A delta lists the slots
+ * that differ from its base, so periodic checkpoints written as a
+ * full snapshot followed by deltas cost only what changed, and a
+ * restart decodes the base and each delta in turn.
+ */
+
+#define ASX_SNAPSHOT_BINARY_MAGIC      0x41535873u  /* "ASXs" */
+#define ASX_SNAPSHOT_BINARY_VERSION    1u
+#define ASX_SNAPSHOT_BINARY_FLAG_DELTA 0x00010000u
+#define ASX_SNAPSHOT_BINARY_HEADER     40u
+#define ASX_SNAPSHOT_BINARY_RECORD     32u
+#define ASX_SNAPSHOT_RECORD_CLEARED    0x80u
+
+/* Encode snap, in full when base is NULL, else as a delta against
+ * base. *out_len receives the bytes written.
+ * ASX_E_INVALID_ARGUMENT if snap, buf or out_len is NULL,
+ * ASX_E_BUFFER_TOO_SMALL if capacity is insufficient. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_encode(
+    const asx_runtime_snapshot *snap,
+    const asx_runtime_snapshot *base,
+    uint8_t *buf,
+    uint32_t capacity,
+    uint32_t *out_len);
+
+/* Decode a binary snapshot into snap. A full snapshot replaces its
+ * contents; a delta applies to them, and snap must hold the delta's
+ * base. snap is unchanged on failure and is never treated as a
+ * previous capture. ASX_E_INVALID_ARGUMENT for NULL, a bad header,
+ * truncation or a malformed record; ASX_E_REPLAY_MISMATCH if snap is
+ * not the delta's base or the decoded digest does not match. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_decode(
+    asx_runtime_snapshot *snap,
+    const uint8_t *buf,
+    uint32_t len);
+
+/* ------------------------------------------------------------------ */
+/* Restore                                                             */
+/* ------------------------------------------------------------------ */
+
+/* Supplies the poll function and user data of a task that had not
+ * completed. Return non-OK to abandon the restore with that status. */
+typedef asx_status (*asx_snapshot_rebind_fn)(void *ctx,
+                                             const asx_snapshot_task *task,
+                                             asx_task_poll_fn *out_poll,
+                                             void **out_user_data);
+
+/*
+ * Reset the runtime and rebuild it from snap: every slot in use is
+ * live again under its recorded handle (same slot and generation),
+ * with its state, counters, region tree and outcome, and slots whose
+ * region CLOSED or whose obligation resolved are back on the free
+ * lists. Tasks that had not completed become ready in their region
+ * and take their poll function from rebind; a cancelled one restarts
+ * its cleanup budget as a user cancel.
+ *
+ * Not restored: captured task state, cleanup stacks, deadlines,
+ * admission policies, parked waits and channels, none of which the
+ * snapshot records. The trace is left as it is.
+ *
+ * The runtime is untouched unless the snapshot is consistent (dense
+ * slots, handle types and slots, task and region references, counts)
+ * and rebind succeeds for every unfinished task.
+ * ASX_E_INVALID_ARGUMENT for NULL snap, an inconsistent snapshot, or
+ * unfinished tasks without rebind.
+ */
+ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_restore(
+    const asx_runtime_snapshot *snap,
+    asx_snapshot_rebind_fn rebind,
+    void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,12 +37,24 @@ typedef enum {
     ASX_TELEMETRY_ULTRA_MIN = 2   /* minimal: rolling digest only */
 } asx_telemetry_tier;
 
+/* Most verbose tier this build can run at (numeric, for #if). Release
+ * and HFT builds may raise it to 1 (OPS_LIGHT) or 2 (ULTRA_MIN): more
+ * verbose tier requests are clamped to it, and at 2 the trace-ring
+ * store in asx_telemetry_emit() compiles away, leaving only the
+ * rolling digest. */
+#ifndef ASX_TELEMETRY_MIN_TIER
+#define ASX_TELEMETRY_MIN_TIER 0
+#endif
+
 /* -------------------------------------------------------------------
  * Tier configuration API
  * ------------------------------------------------------------------- */
 
-/* Set the active telemetry tier. Takes effect immediately.
- * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if tier is unknown. */
+/* Set the active telemetry tier. Takes effect immediately; tiers more
+ * verbose than ASX_TELEMETRY_MIN_TIER are clamped to it.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if tier is unknown,
+ * ASX_E_INVALID_STATE under ASX_STATIC_PROFILE for a tier less verbose
+ * than ASX_TELEMETRY_MIN_TIER (the tier is fixed there). */
 ASX_API asx_status asx_telemetry_set_tier(asx_telemetry_tier tier);
 
 /* Query the current telemetry tier. */
@@ -81,9 +93,34 @@ ASX_API void asx_telemetry_emit(asx_trace_event_kind kind,
  * tier is FORENSIC; includes filtered events when tier is higher. */
 ASX_API uint64_t asx_telemetry_digest(void);
 
-/* Reset the rolling digest to the FNV-1a offset basis. */
+/* Reset the rolling digest to the FNV-1a offset basis. Also clears
+ * the parity checkpoints. */
 ASX_API void asx_telemetry_digest_reset(void);
 
+/* -------------------------------------------------------------------
+ * Parity checkpoints
+ *
+ * The rolling digest is also recorded after every parity window of
+ * events, so two profile runs of one scenario can be compared window
+ * by window and a mismatch names the first divergent window instead
+ * of only the final digest. When the table fills, every second
+ * checkpoint is kept and the window doubles, so a run of any length
+ * fits in ASX_TELEMETRY_PARITY_CHECKPOINTS entries.
+ * ------------------------------------------------------------------- */
+
+#define ASX_TELEMETRY_PARITY_WINDOW      64u   /* events per window at reset */
+#define ASX_TELEMETRY_PARITY_CHECKPOINTS 128u
+
+/* Current parity window: ASX_TELEMETRY_PARITY_WINDOW times a power of
+ * two. */
+ASX_API uint32_t asx_telemetry_parity_window(void);
+
+/* Copy up to capacity parity checkpoints into out; out[k] is the
+ * rolling digest after (k + 1) * asx_telemetry_parity_window() events.
+ * Returns the number copied. */
+ASX_API uint32_t asx_telemetry_parity_checkpoints(uint64_t *out,
+                                                  uint32_t capacity);
+
 /* -------------------------------------------------------------------
  * Tier event retention query
  *
@@ -18,6 +18,7 @@
 #include <asx/asx_export.h>
 #include <asx/asx_status.h>
 #include <asx/asx_ids.h>
+#include <asx/codec/codec.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,11 +45,13 @@ typedef enum {
     ASX_TRACE_REGION_CLOSED    = 0x12,
     ASX_TRACE_TASK_SPAWN       = 0x13,
     ASX_TRACE_TASK_TRANSITION  = 0x14,
+    ASX_TRACE_TASK_PARK        = 0x15,  /* aux = asx_park_kind */
+    ASX_TRACE_TASK_WAKE        = 0x16,  /* aux = asx_park_kind */
 
     /* Obligation events (0x20–0x2F) */
     ASX_TRACE_OBLIGATION_RESERVE = 0x20,
     ASX_TRACE_OBLIGATION_COMMIT  = 0x21,
-    ASX_TRACE_OBLIGATION_ABORT   = 0x22,
+    ASX_TRACE_OBLIGATION_ABORT   = 0x22,  /* lease expired; aux = lease deadline */
 
     /* Channel events (0x30–0x3F) */
     ASX_TRACE_CHANNEL_SEND     = 0x30,
@@ -57,9 +60,32 @@ typedef enum {
     /* Timer events (0x40–0x4F) */
     ASX_TRACE_TIMER_SET        = 0x40,
     ASX_TRACE_TIMER_FIRE       = 0x41,
-    ASX_TRACE_TIMER_CANCEL     = 0x42
+    ASX_TRACE_TIMER_CANCEL     = 0x42,
+
+    /* Admission events (0x50–0x5F) */
+    ASX_TRACE_ADMISSION        = 0x50,  /* aux = ASX_TRACE_ADMISSION_AUX */
+    ASX_TRACE_WATERMARK        = 0x51   /* aux = ASX_TRACE_WATERMARK_AUX */
 } asx_trace_event_kind;
 
+/* Where an attached overload policy refused or shed (see
+ * asx_region_set_admission). */
+typedef enum {
+    ASX_ADMISSION_SPAWN      = 0,  /* entity: region */
+    ASX_ADMISSION_OBLIGATION = 1,  /* entity: region */
+    ASX_ADMISSION_CHANNEL    = 2   /* entity: channel */
+} asx_admission_site;
+
+/* ASX_TRACE_ADMISSION payload: site, asx_overload_mode and load percent
+ * of the triggered decision. */
+#define ASX_TRACE_ADMISSION_AUX(site, mode, load_pct) \
+    (((uint64_t)(site) << 16) | ((uint64_t)(mode) << 8) | \
+     (uint64_t)((load_pct) > 255u ? 255u : (load_pct)))
+
+/* ASX_TRACE_WATERMARK payload: asx_resource_kind, asx_watermark_edge
+ * and the use that crossed it. The entity is ASX_INVALID_ID. */
+#define ASX_TRACE_WATERMARK_AUX(kind, edge, used) \
+    (((uint64_t)(kind) << 40) | ((uint64_t)(edge) << 32) | (uint64_t)(used))
+
 /* -------------------------------------------------------------------
  * Trace event record
  *
@@ -88,7 +114,9 @@ typedef struct {
  * automatically reset at the start of each asx_scheduler_run call.
  * ------------------------------------------------------------------- */
 
-/* Emit a trace event. Thread-safe: none (single-threaded runtime). */
+/* Emit a trace event. Thread-safe: none (single-threaded runtime),
+ * except from a poll running on a parallel worker (parallel.h), where
+ * events are staged per worker and merged in serial order. */
 ASX_API void asx_trace_emit(asx_trace_event_kind kind,
                              uint64_t entity_id,
                              uint64_t aux);
@@ -99,9 +127,132 @@ ASX_API uint32_t asx_trace_event_count(void);
 /* Read event at index (0 = oldest). Returns 1 on success, 0 on OOB. */
 ASX_API int asx_trace_event_get(uint32_t index, asx_trace_event *out);
 
-/* Reset trace state. Called automatically by scheduler_run. */
+/* Reset trace state. Called automatically by scheduler_run. Latches
+ * the trace domain's digest mode (asx_digest_set_mode). */
 ASX_API void asx_trace_reset(void);
 
+/* Opt-in latency stamps: while enabled, each stored event records the
+ * asx_runtime_now_ns delta since the previous one (0 for the first, or
+ * without a clock hook; saturates at UINT32_MAX). Stamps are kept out
+ * of the digest, so replay identity holds with them on or off. Events
+ * staged by parallel workers are stamped when merged. Survives
+ * asx_trace_reset. */
+ASX_API void asx_trace_set_timestamps(int enabled);
+
+/* Nonzero while timestamps are enabled. */
+ASX_API int asx_trace_timestamps_enabled(void);
+
+/* Read the time delta of the event at index (0 = oldest). Returns 1 on
+ * success, 0 on OOB. */
+ASX_API int asx_trace_event_delta_ns(uint32_t index, uint32_t *out_ns);
+
+/* -------------------------------------------------------------------
+ * Kind filter
+ *
+ * A disabled kind is checked at the top of asx_trace_emit and never
+ * stored: the ring, the history ring and exports hold only enabled
+ * kinds, so a host can keep lifecycle events and spend no ring space
+ * on per-poll ones. A dropped event still takes its sequence number
+ * and is folded into asx_trace_digest in stream order, so the
+ * semantic digest covers every kind and matches an unfiltered run
+ * while the stored events fit the ring or a sink is installed.
+ *
+ * Exports carry, and replay compares, the digest of the stored events
+ * instead, chained across chunks, so a filtered trace still verifies
+ * and replays against a run with the same filter.
+ * ------------------------------------------------------------------- */
+
+/* Enable or disable recording of kind. All kinds start enabled; the
+ * filter survives asx_trace_reset. Kinds past 255 are always
+ * recorded. */
+ASX_API void asx_trace_set_kind_enabled(asx_trace_event_kind kind,
+                                        int enabled);
+
+/* Nonzero while kind is recorded. */
+ASX_API int asx_trace_kind_enabled(asx_trace_event_kind kind);
+
+/* Events dropped by the filter since the last reset. */
+ASX_API uint32_t asx_trace_filtered_count(void);
+
+/* -------------------------------------------------------------------
+ * Digest windows
+ *
+ * For streaming divergence checks between two runs fed the same
+ * inputs, such as a primary and its shadow replica. With a window
+ * length set, asx_trace_digest is latched each time the stream
+ * reaches a multiple of length events. Window k holds the digest as
+ * of sequence (k + 1) * length, counting filtered events, so the first
+ * window whose digests differ bounds where the runs diverged. The
+ * newest ASX_TRACE_WINDOW_HISTORY windows are kept.
+ *
+ * The primary publishes each (window, digest) pair as it closes, over
+ * any transport; the replica checks them with
+ * asx_hindsight_check_window.
+ * ------------------------------------------------------------------- */
+
+#ifndef ASX_TRACE_WINDOW_HISTORY
+#define ASX_TRACE_WINDOW_HISTORY 16u
+#endif
+
+/* Latch the digest every events events; 0 turns windows off and drops
+ * the latched ones. The length survives asx_trace_reset. Windows are numbered from sequence
+ * 0, so set mid-run the first one closed may not be window 0. */
+ASX_API void asx_trace_set_digest_window(uint32_t events);
+
+/* The window length, 0 when off. */
+ASX_API uint32_t asx_trace_digest_window(void);
+
+/* Windows closed since the last reset: the index of the open one. */
+ASX_API uint32_t asx_trace_window_count(void);
+
+/* Write window's latched digest to out_digest. Returns 1 if the
+ * window is closed and still held, 0 otherwise. */
+ASX_API int asx_trace_window_get(uint32_t window, uint64_t *out_digest);
+
+/* -------------------------------------------------------------------
+ * Round records
+ *
+ * With round mode on, the sequential scheduler does not store a
+ * SCHED_POLL event per poll. Each round's polls go into a round
+ * record instead: a bitmap over a window of up to 64 consecutive
+ * arena indices, plus per polled index its handle's generation and
+ * state and the ring position it was polled at. Every other event is
+ * stored as before.
+ *
+ * The canonical per-poll stream is rebuilt in the ring from pending
+ * records the first time anything reads the trace (event count and
+ * get, digest, replay, export), so readers, the digest and replay see
+ * exactly what a run with round mode off would have recorded.
+ *
+ * A poll is stored as a plain event whenever the record store is full,
+ * a sink, mapped replay reference, history storage, kind filter,
+ * digest windows or timestamps are active, or the canonical stream has reached
+ * ASX_TRACE_CAPACITY. The parallel scheduler always stores plain
+ * events.
+ * ------------------------------------------------------------------- */
+
+#define ASX_TRACE_ROUND_CAPACITY 256u  /* pending records */
+#define ASX_TRACE_ROUND_WINDOW   64u   /* arena indices per record */
+
+typedef struct {
+    uint32_t round;        /* scheduler round (SCHED_POLL aux) */
+    uint32_t first_index;  /* arena index of bit 0 of polled */
+    uint64_t polled;       /* bit k: index first_index + k was polled */
+} asx_trace_round;
+
+/* Turn round mode on or off. Survives asx_trace_reset. */
+ASX_API void asx_trace_set_round_mode(int enabled);
+
+/* Nonzero while round mode is on. */
+ASX_API int asx_trace_round_mode_enabled(void);
+
+/* Round records not yet rebuilt into the ring. */
+ASX_API uint32_t asx_trace_round_count(void);
+
+/* Read pending record index (0 = oldest) without rebuilding. Returns 1
+ * on success, 0 on OOB. */
+ASX_API int asx_trace_round_get(uint32_t index, asx_trace_round *out);
+
 /* -------------------------------------------------------------------
  * Hash-chain digest
  *
@@ -111,7 +262,9 @@ ASX_API void asx_trace_reset(void);
  * parity with the Rust reference implementation.
  * ------------------------------------------------------------------- */
 
-/* Compute the current trace digest (FNV-1a over all events). */
+/* Current trace digest over all stored events, under the mode latched
+ * at the last reset (FNV-1a by default). Kept as a running hash: a
+ * query only hashes events emitted since the last. */
 ASX_API uint64_t asx_trace_digest(void);
 
 /* -------------------------------------------------------------------
@@ -147,9 +300,74 @@ ASX_API asx_status asx_replay_load_reference(const asx_trace_event *events,
 ASX_API void asx_replay_clear_reference(void);
 
 /* Compare the current trace against the loaded reference.
+ * Events already matched by an earlier call are not compared again:
+ * each call only checks those past the verified prefix, so repeated
+ * checks of a growing trace cost O(new events).
  * Returns the comparison result. */
 ASX_API asx_replay_result asx_replay_verify(void);
 
+/* Length of the verified prefix of the loaded reference; *out_digest,
+ * if non-NULL, receives its digest. Loading or clearing a reference,
+ * asx_trace_reset, a streamed chunk and rebuilt round polls drop it to
+ * 0. A mapped reference is checked as events are emitted and keeps no
+ * prefix. */
+ASX_API uint32_t asx_replay_verified_prefix(uint64_t *out_digest);
+
+/* -------------------------------------------------------------------
+ * Trace diff
+ *
+ * Aligns a reference and an actual event sequence and reports every
+ * stretch where they differ, so a verify mismatch that realigns later
+ * (an inserted poll, a dropped wake) shows as its own short window
+ * instead of poisoning the rest of the trace. Events are equal when
+ * kind, entity and aux agree; sequence numbers are positions.
+ *
+ * The common prefix and suffix are trimmed first, then a Myers diff
+ * searches the middle for edit scripts of at most band inserted plus
+ * deleted events, in ASX_TRACE_DIFF_WORK_WORDS(band) words of caller
+ * work space; a larger gap reports one unaligned window.
+ * ------------------------------------------------------------------- */
+
+#define ASX_TRACE_DIFF_MAX_WINDOWS 16u
+#define ASX_TRACE_DIFF_WORK_WORDS(band) (((band) + 1u) * ((band) + 1u))
+
+/* One run of edits between matched events. A window with both lengths
+ * non-zero replaced ref_len events by act_len others. */
+typedef struct {
+    uint32_t ref_start;   /* index of its first reference event */
+    uint32_t ref_len;     /* reference events missing from actual */
+    uint32_t act_start;   /* index of its first actual event */
+    uint32_t act_len;     /* actual events not in the reference */
+} asx_trace_diff_window;
+
+typedef struct {
+    uint32_t edits;         /* ref_len + act_len over every window */
+    uint32_t matched;       /* events aligned in both sequences */
+    uint32_t window_count;  /* windows found; the first MAX are stored */
+    int      aligned;       /* 0: edits exceed the band, and the one
+                             * window spans the unaligned middle */
+    asx_trace_diff_window windows[ASX_TRACE_DIFF_MAX_WINDOWS];
+} asx_trace_diff;
+
+/* Diff act[0..act_count) against ref[0..ref_count) into out, searching
+ * up to the largest band that work_words words of work hold.
+ * ASX_E_INVALID_ARGUMENT for a NULL out, or a NULL array with a
+ * non-zero count. */
+ASX_API ASX_MUST_USE asx_status asx_trace_diff_events(const asx_trace_event *ref,
+                                                      uint32_t ref_count,
+                                                      const asx_trace_event *act,
+                                                      uint32_t act_count,
+                                                      uint32_t *work,
+                                                      uint32_t work_words,
+                                                      asx_trace_diff *out);
+
+/* Diff the current trace against the loaded reference, as
+ * asx_trace_diff_events. ASX_E_INVALID_STATE when no reference is
+ * loaded or it is mapped rather than copied. */
+ASX_API ASX_MUST_USE asx_status asx_replay_diff(uint32_t *work,
+                                                uint32_t work_words,
+                                                asx_trace_diff *out);
+
 /* -------------------------------------------------------------------
  * Snapshot export
  *
@@ -191,7 +409,7 @@ ASX_API const char *asx_replay_result_kind_str(asx_replay_result_kind kind);
  *     [0..3]   magic      "ASXt" (0x41535874)
  *     [4..7]   version    1
  *     [8..11]  event_count
- *     [12..15] reserved   0
+ *     [12..15] chunk_index (0 unless streamed through a sink)
  *     [16..23] trace_digest (FNV-1a 64-bit)
  *
  *   Per event (24 bytes each):
@@ -199,10 +417,35 @@ ASX_API const char *asx_replay_result_kind_str(asx_replay_result_kind kind);
  *     [4..7]   kind       (uint32)
  *     [8..15]  entity_id  (uint64)
  *     [16..23] aux        (uint64)
+ *
+ * Version 2 (compact) keeps the header, with version 2, followed by
+ * the first event's sequence as a varint (absent when empty; later
+ * sequences are implicit, +1 per event) and per event:
+ *     kind       (1 byte)
+ *     entity_id  zigzag varint delta against the previous event of
+ *                the same kind in this buffer (0 before the first)
+ *     aux        zigzag varint delta, likewise
+ * Varints are unsigned LEB128. The header digest is the same FNV-1a
+ * over the decoded events, so v1 and v2 exports of one trace carry
+ * the same digest. Import, continuity checks and chunk verification
+ * accept either version.
+ *
+ * The upper half of the version word holds flags. With
+ * ASX_TRACE_BINARY_FLAG_TIMES (set while trace timestamps are on) the
+ * events are followed by a time column of one delta per event, in ns
+ * since the previous event: uint32 in v1, varint in v2. The column is
+ * outside the digest.
+ * ASX_TRACE_BINARY_FLAG_WORD_DIGEST marks a header digest computed with
+ * the WORD64 mixer (asx/runtime/digest.h) instead of FNV-1a; readers
+ * verify each buffer under the mixer its flags name.
  * ------------------------------------------------------------------- */
 
 #define ASX_TRACE_BINARY_MAGIC    0x41535874u  /* "ASXt" */
 #define ASX_TRACE_BINARY_VERSION  1u
+#define ASX_TRACE_BINARY_VERSION_COMPACT 2u
+#define ASX_TRACE_BINARY_VERSION_MASK    0x0000FFFFu
+#define ASX_TRACE_BINARY_FLAG_TIMES      0x00010000u  /* time column */
+#define ASX_TRACE_BINARY_FLAG_WORD_DIGEST 0x00020000u /* WORD64 digest */
 #define ASX_TRACE_BINARY_HEADER   24u
 #define ASX_TRACE_BINARY_EVENT    24u
 
@@ -214,19 +457,152 @@ ASX_API asx_status asx_trace_export_binary(uint8_t *buf,
                                             uint32_t capacity,
                                             uint32_t *out_len);
 
-/* Import a binary trace buffer as the replay reference.
+/* Export the current trace in the compact (v2) format. Same contract
+ * as asx_trace_export_binary; also returns ASX_E_INVALID_ARGUMENT if
+ * an event kind does not fit in one byte. The output never exceeds
+ * 29 + 21 * event_count bytes. */
+ASX_API asx_status asx_trace_export_compact(uint8_t *buf,
+                                             uint32_t capacity,
+                                             uint32_t *out_len);
+
+/* Import a binary trace buffer (v1 or v2) as the replay reference.
  * Validates header magic, version, and digest. On success, the
  * events are loaded as the replay reference (same as
  * asx_replay_load_reference). Returns ASX_OK on success. */
 ASX_API asx_status asx_trace_import_binary(const uint8_t *buf,
                                             uint32_t len);
 
+/* Use a binary trace in place as the replay reference, e.g. a file
+ * mapped with asx_platform_map_file. buf holds one or more v1 chunks
+ * back to back (an export, or the output of a streaming sink); their
+ * headers and digest chain are validated up front. Nothing is copied
+ * and there is no capacity limit: each event emitted from now on, and
+ * again after every asx_trace_reset, is compared with the next record,
+ * and asx_replay_verify reports the first divergence. buf must stay
+ * valid until asx_replay_clear_reference or another load. Compact (v2)
+ * buffers are rejected; import those instead. */
+ASX_API asx_status asx_replay_map_reference(const uint8_t *buf,
+                                            uint32_t len);
+
 /* Check whether the current trace matches a persisted binary buffer.
  * Combines import + verify in one call. Returns ASX_OK if the
  * current trace matches the persisted events. */
 ASX_API asx_status asx_trace_continuity_check(const uint8_t *buf,
                                                uint32_t len);
 
+/* -------------------------------------------------------------------
+ * Streaming trace sink
+ *
+ * With a sink installed, a full ring is encoded as one binary chunk
+ * (the format above, chunk_index in the header) and handed to the
+ * sink before the ring is reused, so traces may run well beyond
+ * ASX_TRACE_CAPACITY. Sequence numbers keep counting across chunks
+ * and each chunk's digest extends the previous one: chaining
+ * asx_trace_chunk_verify over all chunks reproduces asx_trace_digest.
+ * Without a sink the ring keeps its fixed-capacity behavior.
+ * ------------------------------------------------------------------- */
+
+/* Receives one encoded chunk. The buffer is only valid for the call.
+ * A non-OK return drops the chunk; tracing carries on. */
+typedef asx_status (*asx_trace_sink_fn)(void *ctx,
+                                        const uint8_t *chunk,
+                                        uint32_t len);
+
+/* Install a chunk sink, or remove it with sink == NULL. Survives
+ * asx_trace_reset. */
+ASX_API void asx_trace_set_sink(asx_trace_sink_fn sink, void *ctx);
+
+/* Hand any buffered events to the sink as a (possibly partial) chunk.
+ * Returns ASX_E_INVALID_STATE if no sink is installed. */
+ASX_API asx_status asx_trace_flush(void);
+
+/* Chunks handed to the sink since the last reset. */
+ASX_API uint32_t asx_trace_chunk_count(void);
+
+/* Validate one chunk whose digest chains from prev_digest (use the
+ * FNV-1a basis, i.e. the digest of an empty trace, for chunk 0).
+ * On success *out_digest receives the chunk's digest, the input for
+ * the next chunk. Returns ASX_E_REPLAY_MISMATCH on a broken chain. */
+ASX_API asx_status asx_trace_chunk_verify(const uint8_t *buf,
+                                          uint32_t len,
+                                          uint64_t prev_digest,
+                                          uint64_t *out_digest);
+
+/* Stream the bytes asx_trace_export_binary would write through writer,
+ * staged in caller scratch: every call but the last gets exactly
+ * block_len bytes (a flash page, a socket buffer), so no buffer holds
+ * the whole trace. A non-OK writer return stops the export and is
+ * returned. On ASX_OK, *out_len (if non-NULL) receives the total.
+ * Returns ASX_E_INVALID_ARGUMENT for a NULL writer or scratch or a
+ * zero block_len. */
+ASX_API ASX_MUST_USE asx_status asx_trace_export_binary_blocks(asx_trace_sink_fn writer,
+                                                               void *ctx,
+                                                               uint8_t *scratch,
+                                                               uint32_t block_len,
+                                                               uint32_t *out_len);
+
+/* -------------------------------------------------------------------
+ * Compressed history ring
+ *
+ * For post-mortem diagnostics where RAM is short (the embedded router
+ * profile): with storage attached, every emitted event is also
+ * appended to it as a delta/varint record, as in the compact format,
+ * of 3 to 6 bytes for typical events against the ring's 24, so the
+ * same RAM holds several times the history. Records are written as
+ * events are emitted and never re-encoded.
+ *
+ * The storage is split into ASX_TRACE_HISTORY_SEGMENT-byte segments
+ * that each decode on their own; once all are full the oldest is
+ * dropped, so the history holds the most recent events. It keeps no
+ * time column. While storage is attached round mode stores plain
+ * polls, and asx_trace_reset empties the history.
+ * ------------------------------------------------------------------- */
+
+#ifndef ASX_TRACE_HISTORY_SEGMENT
+#define ASX_TRACE_HISTORY_SEGMENT 512u
+#endif
+
+/* Record history into len bytes at storage, replacing any attached
+ * before and starting empty; NULL detaches. Returns
+ * ASX_E_INVALID_ARGUMENT for NULL storage with a non-zero len, or less
+ * than two segments. */
+ASX_API asx_status asx_trace_history_attach(uint8_t *storage,
+                                            uint32_t len);
+
+/* Events held in the history (0 with none attached). */
+ASX_API uint32_t asx_trace_history_count(void);
+
+/* Decode the history, oldest first, and stream it through writer as
+ * one v1 chunk per segment, staged in block_len bytes of scratch as
+ * asx_trace_export_binary_blocks does. Chunk digests chain from the
+ * empty-trace digest, so asx_trace_chunk_verify checks the stream.
+ * Returns ASX_E_INVALID_ARGUMENT for a NULL writer or scratch or a
+ * zero block_len, ASX_E_INVALID_STATE with no storage attached, or the
+ * writer's error. */
+ASX_API ASX_MUST_USE asx_status asx_trace_history_export(asx_trace_sink_fn writer,
+                                                         void *ctx,
+                                                         uint8_t *scratch,
+                                                         uint32_t block_len,
+                                                         uint32_t *out_len);
+
+/* -------------------------------------------------------------------
+ * JSON export
+ * ------------------------------------------------------------------- */
+
+/* Export the stored events as a JSON array of
+ * {"sequence","kind","entity_id","aux"} objects (kind by name, plus
+ * "delta_ns" while timestamps are on), replacing out's contents. The
+ * buffer is sized once from the event count and filled in one pass.
+ * Returns ASX_E_INVALID_ARGUMENT if out is NULL, or the buffer's
+ * allocation error. */
+ASX_API ASX_MUST_USE asx_status asx_trace_export_json(asx_codec_buffer *out);
+
+/* Stream the same JSON through sink in chunks of up to about 28 KiB,
+ * without allocating. A non-OK sink return stops the export and is
+ * returned. Chunks break between events. */
+ASX_API ASX_MUST_USE asx_status asx_trace_export_json_sink(asx_trace_sink_fn sink,
+                                                           void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
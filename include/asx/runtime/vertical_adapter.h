@@ -153,9 +153,67 @@ ASX_API asx_status asx_adapter_evaluate_both(asx_adapter_id id,
                                               asx_adapter_result *fallback_out,
                                               asx_adapter_result *accel_out);
 
-/* Reset all adapter state (global HFT/automotive instrument state). */
+/* -------------------------------------------------------------------
+ * Shadow evaluation (opt-in)
+ *
+ * asx_adapter_evaluate_shadowed runs the ACCELERATED path and, on a
+ * deterministic 1-in-N sample per adapter (the 1st, N+1th, ...
+ * evaluation), re-runs FALLBACK on the same input and compares the
+ * decision digests. A mismatch is counted and, in ASX_HINDSIGHT
+ * builds, logged to the hindsight ring as ASX_ND_ADAPTER_DIVERGENCE
+ * with the adapter id in the high word of entity_id, used in the low
+ * word, and the fallback digest as the observed value. This keeps
+ * divergence checking on in production at 1/N of the evaluate_both
+ * cost.
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t evaluations;   /* shadowed evaluations */
+    uint32_t sampled;       /* of those, re-run in FALLBACK */
+    uint32_t divergences;   /* of those, with differing digests */
+} asx_adapter_shadow_stats;
+
+/* Set the shadow sample rate: 1 in sample_every evaluations of each
+ * adapter is re-run in FALLBACK; 0 turns sampling off. Restarts every
+ * adapter's sample phase. */
+ASX_API void asx_adapter_shadow_set_rate(uint32_t sample_every);
+
+/* Evaluate in ACCELERATED mode, re-running FALLBACK when sampled.
+ * *out is the accelerated result. Same errors as asx_adapter_evaluate. */
+ASX_API asx_status asx_adapter_evaluate_shadowed(asx_adapter_id id,
+                                                  uint32_t used,
+                                                  uint32_t capacity,
+                                                  asx_adapter_result *out);
+
+/* Read the shadow counters. */
+ASX_API void asx_adapter_shadow_stats_get(asx_adapter_shadow_stats *out);
+
+/* Reset all adapter state (global HFT/automotive instrument state,
+ * shadow rate and counters). */
 ASX_API void asx_adapter_reset_all(void);
 
+/* -------------------------------------------------------------------
+ * Compiled decision tables (opt-in)
+ *
+ * asx_adapter_tables_build compiles every profile's catalog policy into
+ * a load-percent -> decision table, digests included, and checks each
+ * row against asx_overload_evaluate before enabling it. From then on
+ * asx_adapter_evaluate indexes the table instead of evaluating and
+ * hashing; results are identical. Loads above capacity, zero capacity,
+ * shed counts clamped by used, and a digest mode changed after the
+ * build still take the reference path.
+ * ------------------------------------------------------------------- */
+
+/* Build and enable the tables. ASX_E_INVALID_STATE if a catalog entry
+ * is missing or a row disagrees with the reference (tables stay off). */
+ASX_API ASX_MUST_USE asx_status asx_adapter_tables_build(void);
+
+/* Disable the tables; evaluation returns to the reference path. */
+ASX_API void asx_adapter_tables_clear(void);
+
+/* Nonzero while the tables serve asx_adapter_evaluate. */
+ASX_API int asx_adapter_tables_enabled(void);
+
 /* -------------------------------------------------------------------
  * Isomorphism proof API
  * ------------------------------------------------------------------- */
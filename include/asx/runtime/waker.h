@@ -0,0 +1,277 @@
+/*
+ * asx/runtime/waker.h — task parking and event-driven wakeups
+ *
+ * A task that cannot make progress parks itself on a wait source
+ * (channel, timer, or obligation) and returns ASX_E_PENDING. The
+ * scheduler then stops polling it until the source signals readiness:
+ *
+ *   - channel:    send commit, permit abort, receive, or close
+ *   - timer:      fire (asx_timer_collect_expired) or cancel
+ *   - obligation: commit or abort
+ *   - io:         completion reaped by a platform reactor backend
+ *   - group:      the member completion reaching the awaited count
+ *   - semaphore:  a release handing the task its permit
+ *
+ * asx_select waits on several channels and an optional timer at once:
+ * the task is parked on the whole set and woken by the first source
+ * that signals. ASX_CO_AWAIT_* wrap the check-park-yield pattern for
+ * coroutine tasks.
+ *
+ * Woken tasks rejoin their region's ready list in arena index order.
+ * Wakeups are delivered in park order and every park/wake is recorded
+ * in the trace (ASX_TRACE_TASK_PARK / ASX_TRACE_TASK_WAKE), so replay
+ * stays deterministic.
+ *
+ * Wakeups may be spurious (e.g. two timer wheels sharing a slot key);
+ * a woken task must re-check its condition and park again if needed.
+ * Tasks with a pending cancel are never parked so bounded cleanup
+ * keeps running.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_WAKER_H
+#define ASX_RUNTIME_WAKER_H
+
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/time/timer_wheel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------
+ * Wait sources
+ * ------------------------------------------------------------------- */
+
+typedef enum {
+    ASX_PARK_NONE       = 0,
+    ASX_PARK_CHANNEL    = 1,
+    ASX_PARK_TIMER      = 2,
+    ASX_PARK_OBLIGATION = 3,
+    ASX_PARK_SELECT     = 4,  /* any source of an asx_select set */
+    ASX_PARK_IO         = 5,  /* platform I/O operation completion */
+    ASX_PARK_GROUP      = 6,  /* task group count reached */
+    ASX_PARK_SEMAPHORE  = 7   /* semaphore permit handed over */
+} asx_park_kind;
+
+/* Wait-source keys. Event sources and parkers must derive keys the
+ * same way; these helpers are the single definition. */
+static inline uint64_t asx_park_key_channel(asx_channel_id id)
+{
+    return (uint64_t)asx_handle_index(id);
+}
+
+static inline uint64_t asx_park_key_timer(const asx_timer_handle *h)
+{
+    return ((uint64_t)h->generation << 32) | (uint64_t)h->slot;
+}
+
+static inline uint64_t asx_park_key_obligation(asx_obligation_id id)
+{
+    return (uint64_t)asx_handle_index(id);
+}
+
+/* I/O keys are the address of the backend's operation record. */
+static inline uint64_t asx_park_key_io(const void *op)
+{
+    return (uint64_t)(uintptr_t)op;
+}
+
+/* -------------------------------------------------------------------
+ * Parking
+ *
+ * When called from the task's own poll function the park takes effect
+ * once the poll returns ASX_E_PENDING (any other result discards it).
+ * When called on a task that is not being polled, it parks at once.
+ * Parking a task with a pending cancel is a no-op returning ASX_OK.
+ * ------------------------------------------------------------------- */
+
+/* Park a task until the given channel changes readiness.
+ * Returns ASX_OK on success, ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for
+ *   an invalid task, ASX_E_INVALID_STATE if the task is terminal.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_channel(asx_task_id task,
+                                                          asx_channel_id channel);
+
+/* Park a task until the given timer fires or is cancelled.
+ * Returns ASX_E_INVALID_ARGUMENT if timer is NULL; otherwise as
+ *   asx_task_park_on_channel.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_timer(asx_task_id task,
+                                                        const asx_timer_handle *timer);
+
+/* Park a task until the given obligation is committed or aborted.
+ * Returns as asx_task_park_on_channel.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_obligation(asx_task_id task,
+                                                             asx_obligation_id obligation);
+
+/* Park a task until the I/O source signals key (asx_park_key_io).
+ * Returns as asx_task_park_on_channel.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_park_on_io(asx_task_id task,
+                                                     uint64_t key);
+
+/* -------------------------------------------------------------------
+ * Waking
+ * ------------------------------------------------------------------- */
+
+/* Wake a single task regardless of its wait source. Waking a task
+ * that is not parked is a no-op returning ASX_OK.
+ * Returns ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for an invalid task.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_wake(asx_task_id task);
+
+/* Wake every task parked on (kind, key), in park order. Called by event
+ * sources; adapters with their own sources may call it too.
+ * Returns the number of tasks woken.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API uint32_t asx_wake_source(asx_park_kind kind, uint64_t key);
+
+/* Wake variant for event sources that may run on a worker thread while
+ * a parallel batch polls (asx/runtime/parallel.h). During a batch the
+ * wake is recorded and applied on the calling thread after the batch,
+ * in (kind, key) order; otherwise it is asx_wake_source. Returns the
+ * number of tasks woken now (0 when deferred).
+ * Thread-safety: safe from concurrent batch polls where compiler
+ *   atomics are available (GCC/Clang); otherwise single-threaded. */
+ASX_API uint32_t asx_wake_source_deferred(asx_park_kind kind, uint64_t key);
+
+/* Query whether a task is currently parked (off the ready list).
+ * Returns ASX_OK and sets *out_parked to 0/1, ASX_E_INVALID_ARGUMENT if
+ *   out_parked is NULL, or ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_is_parked(asx_task_id task,
+                                                    int *out_parked);
+
+/* Number of tasks currently parked across all regions. */
+ASX_API uint32_t asx_parked_count(void);
+
+/* -------------------------------------------------------------------
+ * Select
+ *
+ * A select set names up to ASX_SELECT_MAX_CHANNELS channels and an
+ * optional timer. A channel is ready when a receive would not block
+ * (a message is queued, or the sender side closed); the timer is ready
+ * once it has fired or been cancelled. Tasks parked on a set take one
+ * of ASX_SELECT_MAX_WAITERS select records until they are woken.
+ * ------------------------------------------------------------------- */
+
+#define ASX_SELECT_MAX_CHANNELS 8u
+#define ASX_SELECT_MAX_WAITERS  32u
+
+typedef struct asx_select_set {
+    asx_channel_id          channels[ASX_SELECT_MAX_CHANNELS];
+    uint32_t                channel_count;
+    const asx_timer_wheel  *timer_wheel;  /* wheel holding timer */
+    const asx_timer_handle *timer;        /* NULL for no timeout */
+} asx_select_set;
+
+/* Return the first ready source of set, or park task on all of them.
+ * Sources are checked in order: channels[0 .. channel_count), then the
+ * timer. Meant to be called from task's own poll function.
+ * Returns ASX_OK with *out_index = the ready channel's position, or
+ *   channel_count for the timer,
+ *   ASX_E_PENDING if nothing is ready: the task is parked on the set
+ *     (as asx_task_park_on_channel) and the poll should return it,
+ *   ASX_E_INVALID_ARGUMENT if set or out_index is NULL, the set is
+ *     empty, channel_count exceeds ASX_SELECT_MAX_CHANNELS, or a timer
+ *     is given without its wheel,
+ *   ASX_E_RESOURCE_EXHAUSTED if every select record is in use,
+ *   or the channel lookup / task park error.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_select(asx_task_id task,
+                                            const asx_select_set *set,
+                                            uint32_t *out_index);
+
+/* -------------------------------------------------------------------
+ * Coroutine awaits
+ *
+ * Use between ASX_CO_BEGIN and ASX_CO_END (runtime.h). Each await
+ * checks its condition and, while it does not hold, parks the task on
+ * the wait source and returns ASX_E_PENDING, so the scheduler leaves
+ * the task alone until the source signals. The condition is checked
+ * again on every resume since wakeups may be spurious. A failed park
+ * is returned from the poll. Outputs and status lvalues must live in
+ * the coroutine frame. One await or yield per source line.
+ * ------------------------------------------------------------------- */
+
+#define ASX_CO_AWAIT(CO_STATE_PTR, COND, PARK)                 \
+    for (;;) {                                                 \
+        asx_status asx_co_park_;                               \
+        if (COND) break;                                       \
+        (CO_STATE_PTR)->line = (uint32_t)__LINE__;             \
+        asx_co_park_ = (PARK);                                 \
+        if (asx_co_park_ != ASX_OK) return asx_co_park_;       \
+        return ASX_E_PENDING;                                  \
+        case __LINE__:;                                        \
+    }
+
+/* Receive from CH into *OUT_PTR. ST is ASX_OK on receipt, or the error
+ * that ended the wait (ASX_E_DISCONNECTED once the sender closed). */
+#define ASX_CO_AWAIT_RECV(CO_STATE_PTR, SELF, CH, OUT_PTR, ST)          \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 ((ST) = asx_channel_try_recv((CH), (OUT_PTR)))         \
+                     != ASX_E_WOULD_BLOCK,                              \
+                 asx_task_park_on_channel((SELF), (CH)))
+
+/* Receive the outcome of oneshot *OS_PTR into *OUT_PTR. ST is ASX_OK
+ * on receipt, or the error that ended the wait (ASX_E_DISCONNECTED
+ * once the sender aborted). */
+#define ASX_CO_AWAIT_ONESHOT(CO_STATE_PTR, SELF, OS_PTR, OUT_PTR, ST)   \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 ((ST) = asx_oneshot_try_recv((OS_PTR), (OUT_PTR)))     \
+                     != ASX_E_WOULD_BLOCK,                              \
+                 asx_task_park_on_obligation((SELF), (OS_PTR)->sender))
+
+/* Wait until COUNT members of task group *GROUP_PTR have completed
+ * (0: every member); *OUT_PTR receives their joined outcome. ST is
+ * ASX_OK, or the error that ended the wait. */
+#define ASX_CO_AWAIT_GROUP(CO_STATE_PTR, SELF, GROUP_PTR, COUNT, OUT_PTR, ST) \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 ((ST) = asx_task_group_try_join((GROUP_PTR), (COUNT),  \
+                                                 (OUT_PTR)))            \
+                     != ASX_E_WOULD_BLOCK,                              \
+                 asx_task_park_on_group((SELF), (GROUP_PTR), (COUNT)))
+
+/* Take a permit of semaphore *SEM_PTR, waiting FIFO for one. ST is
+ * ASX_OK once held, or the error that ended the wait (ASX_E_CANCELLED
+ * for a task being cancelled). */
+#define ASX_CO_AWAIT_SEMAPHORE(CO_STATE_PTR, SELF, SEM_PTR, ST)         \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 ((ST) = asx_semaphore_try_acquire((SEM_PTR), (SELF)))  \
+                     != ASX_E_WOULD_BLOCK,                              \
+                 asx_task_park_on_semaphore((SELF), (SEM_PTR)))
+
+/* Take COUNT tokens of rate limiter *RL_PTR, sleeping on its refill
+ * timer while short. ST is ASX_OK once taken, or the error that ended
+ * the wait. */
+#define ASX_CO_AWAIT_RATE(CO_STATE_PTR, SELF, RL_PTR, COUNT, ST)        \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 ((ST) = asx_rate_limiter_try_take((RL_PTR), (COUNT)))  \
+                     != ASX_E_WOULD_BLOCK,                              \
+                 asx_task_park_on_rate_limiter((SELF), (RL_PTR), (COUNT)))
+
+/* Wait until the timer *HANDLE_PTR on WHEEL fires or is cancelled. */
+#define ASX_CO_AWAIT_TIMER(CO_STATE_PTR, SELF, WHEEL, HANDLE_PTR)       \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 !asx_timer_is_live((WHEEL), (HANDLE_PTR)),             \
+                 asx_task_park_on_timer((SELF), (HANDLE_PTR)))
+
+/* Wait until obligation OB is resolved; *STATE_PTR receives its final
+ * state. ST is ASX_OK, or the lookup error that ended the wait. */
+#define ASX_CO_AWAIT_OBLIGATION(CO_STATE_PTR, SELF, OB, STATE_PTR, ST)  \
+    ASX_CO_AWAIT((CO_STATE_PTR),                                        \
+                 ((ST) = asx_obligation_get_state((OB), (STATE_PTR)))   \
+                     != ASX_OK ||                                       \
+                 *(STATE_PTR) != ASX_OBLIGATION_RESERVED,               \
+                 asx_task_park_on_obligation((SELF), (OB)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_WAKER_H */
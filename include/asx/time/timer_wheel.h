@@ -3,8 +3,17 @@
  *
  * Provides timer registration, firing, and cancellation with:
  *   - Deterministic tie-break: same-deadline timers fire in insertion order
- *   - O(1) cancel via generation-validated handles
- *   - Fixed-size arena (no dynamic allocation)
+ *   - O(1) register and cancel via a free list and generation-validated handles
+ *   - Optional coalescing: timers with slack and nearby deadlines share
+ *     one wheel entry and fire together
+ *   - Hierarchical 4-level wheel with occupied bitmaps: advancing time
+ *     costs O(buckets passed + timers fired), not O(registered timers)
+ *   - Chunked arena: ASX_MAX_TIMERS slots are static; further chunks come
+ *     from the allocator hook up to ASX_ARENA_MAX_TIMERS, following the
+ *     runtime arena rules (no growth without hooks or once sealed).
+ *     Cancelled and fired slots are reused lowest first, and grown
+ *     chunks left empty are returned, while a chunk of slack remains
+ *     and the allocator is unsealed
  *
  * SPDX-License-Identifier: MIT
  */
@@ -21,9 +30,12 @@
 extern "C" {
 #endif
 
-/* Maximum number of concurrent timers in the wheel */
+/* Timers per arena chunk; the first chunk is static */
 #define ASX_MAX_TIMERS 128u
 
+/* Ceiling on concurrent timers when the arena grows through hooks */
+#define ASX_ARENA_MAX_TIMERS 65536u
+
 /* Default maximum timer duration (24 hours in nanoseconds) */
 #define ASX_TIMER_MAX_DURATION_NS ((uint64_t)86400ULL * 1000000000ULL)
 
@@ -45,8 +57,10 @@ typedef struct {
 
 typedef struct asx_timer_wheel asx_timer_wheel;
 
-/* Initialize a timer wheel. Must be called before any other operation.
- * Sets current_time to 0 and all slots to empty. */
+/* Initialize a timer wheel. Must be called before any other operation,
+ * on zeroed storage (the global wheel's is), which it leaves almost
+ * untouched: current_time is 0, all slots are empty and each is set up
+ * when first taken. A wheel in use is cleared with asx_timer_wheel_reset. */
 ASX_API void asx_timer_wheel_init(asx_timer_wheel *wheel);
 
 /* Reset a timer wheel to its initial state (test support). */
@@ -59,13 +73,55 @@ ASX_API void asx_timer_wheel_reset(asx_timer_wheel *wheel);
 /* Register a timer that fires at the given deadline.
  * Returns ASX_OK on success and fills *out_handle.
  * Returns ASX_E_TIMER_DURATION_EXCEEDED if deadline - now > max duration.
- * Returns ASX_E_RESOURCE_EXHAUSTED if no slots available. */
+ * Returns ASX_E_RESOURCE_EXHAUSTED if no slot is free and the arena
+ *   cannot grow (no allocator hook, sealed, or ASX_ARENA_MAX_TIMERS). */
 ASX_API ASX_MUST_USE asx_status asx_timer_register(
     asx_timer_wheel *wheel,
     asx_time deadline,
     void *waker_data,
     asx_timer_handle *out_handle);
 
+/* Register count timers in one call. Item i uses deadlines[i] and
+ * waker_data[i] (waker_data may be NULL for all-NULL data) and behaves
+ * exactly like the i-th of count sequential asx_timer_register calls:
+ * insertion_seq follows array order and a failed item does not stop
+ * later ones. Failed items get handle {UINT32_MAX, 0}.
+ *
+ * Preconditions: wheel and out_handles must not be NULL; deadlines
+ *   must not be NULL when count > 0; out_status may be NULL, else it
+ *   receives each item's status.
+ * Returns ASX_OK if every item registered, else the first item failure
+ *   (ASX_E_TIMER_DURATION_EXCEEDED or ASX_E_RESOURCE_EXHAUSTED),
+ *   ASX_E_INVALID_ARGUMENT for NULL parameters (nothing registered).
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_timer_register_batch(
+    asx_timer_wheel *wheel,
+    const asx_time *deadlines,
+    void *const *waker_data,
+    uint32_t count,
+    asx_timer_handle *out_handles,
+    asx_status *out_status);
+
+/* Register a timer that may fire up to slack_ns late, so timers with
+ * nearby deadlines share one wheel entry. The deadline is rounded up
+ * to a multiple of the largest power of two <= slack_ns; a timer whose
+ * rounded deadline matches a recently created group joins it. A group
+ * is cascaded and expired as one entry and fires its members together,
+ * in registration order, where its first registration would sort. The
+ * handle behaves as asx_timer_register's; each group holds one extra
+ * slot while it has members. slack_ns 0, or a deadline already due,
+ * registers exactly as asx_timer_register.
+ *
+ * Errors as asx_timer_register, the duration checked against the
+ * rounded deadline.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_timer_register_coalesced(
+    asx_timer_wheel *wheel,
+    asx_time deadline,
+    uint64_t slack_ns,
+    void *waker_data,
+    asx_timer_handle *out_handle);
+
 /* -------------------------------------------------------------------
  * Timer cancellation (O(1) logical cancel)
  *
@@ -82,6 +138,17 @@ ASX_API ASX_MUST_USE asx_status asx_timer_register(
 ASX_API int asx_timer_cancel(asx_timer_wheel *wheel,
                               const asx_timer_handle *handle);
 
+/* Cancel count handles in one call, in array order, with the same
+ * per-handle semantics as asx_timer_cancel. Returns the number
+ * cancelled; out_cancelled (may be NULL) receives 1 or 0 per item.
+ *
+ * Preconditions: wheel and handles must not be NULL.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API uint32_t asx_timer_cancel_batch(asx_timer_wheel *wheel,
+                                         const asx_timer_handle *handles,
+                                         uint32_t count,
+                                         int *out_cancelled);
+
 /* -------------------------------------------------------------------
  * Timer collection (fire expired timers)
  *
@@ -132,6 +199,38 @@ ASX_API ASX_MUST_USE asx_status asx_timer_update(
 /* Return the number of active (live, non-cancelled) timers. */
 ASX_API uint32_t asx_timer_active_count(const asx_timer_wheel *wheel);
 
+/* Return 1 if handle names a live timer (registered, not yet fired or
+ * cancelled), 0 if it is stale, fired, cancelled, or either is NULL. */
+ASX_API int asx_timer_is_live(const asx_timer_wheel *wheel,
+                               const asx_timer_handle *handle);
+
+/* Earliest deadline among live timers, for sizing a reactor wait.
+ * Amortized O(1): the minimum is cached and only recomputed (a bitmap
+ * scan plus one bucket) after the timer holding it fires or is
+ * cancelled. A deadline <= the current time means a timer is due.
+ *
+ * Returns ASX_OK and fills *out_deadline,
+ *   ASX_E_NOT_FOUND if no timer is registered,
+ *   ASX_E_INVALID_ARGUMENT if wheel or out_deadline is NULL.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_timer_next_deadline(
+    asx_timer_wheel *wheel,
+    asx_time *out_deadline);
+
+/* Slot arena usage, for watching cancel-heavy workloads */
+typedef struct {
+    uint32_t capacity;  /* slots across the chunks held */
+    uint32_t used;      /* live timers plus coalescing groups */
+    uint32_t free;      /* slots ready for reuse */
+    uint32_t trimmed;   /* empty chunks returned to the allocator */
+} asx_timer_arena_stats;
+
+/* Fill *out with the wheel's slot arena usage.
+ * Returns ASX_E_INVALID_ARGUMENT if wheel or out is NULL. */
+ASX_API ASX_MUST_USE asx_status asx_timer_arena_query(
+    const asx_timer_wheel *wheel,
+    asx_timer_arena_stats *out);
+
 /* Set the maximum allowed timer duration in nanoseconds. */
 ASX_API void asx_timer_set_max_duration(asx_timer_wheel *wheel,
                                          uint64_t max_duration_ns);
@@ -0,0 +1,77 @@
+/*
+ * bridge.c — single-producer single-consumer bridge between contexts
+ *
+ * A bounded ring in caller storage with free-running 32-bit cursors:
+ * the sender owns tail, the receiver owns head, and tail - head is the
+ * number of unread values. Each side keeps its last view of the other
+ * side's cursor and reloads it only when that view says full (sender)
+ * or empty (receiver), so in steady state each side touches the other
+ * side's cache line once per lap rather than once per value.
+ *
+ * The sender publishes a value by storing tail with release order
+ * after writing the cell; the receiver frees the cell by storing head
+ * with release order after reading it. Without compiler atomics (or
+ * in deterministic builds) the same code runs on plain loads and
+ * stores, and a bridge is then only safe within one thread.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <asx/asx.h>
+#include <asx/core/channel.h>
+
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define bridge_load(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define bridge_store(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define bridge_load(p)      (*(p))
+#define bridge_store(p, v)  (void)(*(p) = (v))
+#endif
+
+asx_status asx_channel_bridge_init(asx_channel_bridge *bridge,
+                                   uint64_t *cells, uint32_t capacity)
+{
+    if (bridge == NULL || cells == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (capacity == 0u || capacity > 0x80000000u ||
+        (capacity & (capacity - 1u)) != 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    memset(bridge, 0, sizeof(*bridge));
+    bridge->cells = cells;
+    bridge->mask = capacity - 1u;
+    return ASX_OK;
+}
+
+asx_status asx_channel_bridge_send(asx_channel_bridge *bridge, uint64_t value)
+{
+    uint32_t tail;
+
+    if (bridge == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (bridge->cells == NULL) return ASX_E_INVALID_STATE;
+    tail = bridge->tail;
+    if (tail - bridge->head_seen > bridge->mask) {
+        bridge->head_seen = bridge_load(&bridge->head);
+        if (tail - bridge->head_seen > bridge->mask) return ASX_E_CHANNEL_FULL;
+    }
+    bridge->cells[tail & bridge->mask] = value;
+    bridge_store(&bridge->tail, tail + 1u);
+    return ASX_OK;
+}
+
+asx_status asx_channel_bridge_try_recv(asx_channel_bridge *bridge,
+                                       uint64_t *out_value)
+{
+    uint32_t head;
+
+    if (bridge == NULL || out_value == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (bridge->cells == NULL) return ASX_E_INVALID_STATE;
+    head = bridge->head;
+    if (head == bridge->tail_seen) {
+        bridge->tail_seen = bridge_load(&bridge->tail);
+        if (head == bridge->tail_seen) return ASX_E_WOULD_BLOCK;
+    }
+    *out_value = bridge->cells[head & bridge->mask];
+    bridge_store(&bridge->head, head + 1u);
+    return ASX_OK;
+}
@@ -1,8 +1,26 @@
 /*
  * mpsc.c — bounded MPSC two-phase channel implementation (bd-2cw.6)
  *
- * Walking skeleton: single-threaded, non-blocking (try_reserve/try_recv).
- * Fixed-size arena of channel slots with ring-buffer message queues.
+ * Non-blocking (try_reserve/try_recv) over a fixed-size arena of
+ * channel slots. Each slot's ring and permit table are sized to its
+ * capacity at create: from a static pool up to ASX_CHANNEL_MAX_CAPACITY,
+ * from asx_runtime_alloc beyond it. Producers may reserve, send and abort concurrently
+ * from parallel worker threads, and the single consumer may receive
+ * alongside them, without locks:
+ *
+ *   - a CAS on the claim counter (queue_len + reserved) admits a
+ *     reservation, so the capacity invariant holds under contention
+ *   - messages go through a bounded ring with per-cell sequence numbers
+ *     (Vyukov): a producer claims a ring position with one CAS, writes
+ *     the value and publishes it by advancing the cell's sequence
+ *   - permit slots come from an atomic free bitmap; send/abort retire a
+ *     permit with a single CAS on its token, so only one consumer of a
+ *     permit (or copy of it) can ever succeed
+ *
+ * Wakes go through asx_wake_source_deferred, so a send on a worker
+ * thread wakes the receiver after the batch. Create, close and reset
+ * stay on the calling thread. Without compiler atomics (or in
+ * deterministic builds) the same code runs on plain loads and stores.
  *
  * Two-phase protocol:
  *   1. try_reserve — claims capacity, returns permit
@@ -11,6 +29,39 @@
  *
  * Capacity invariant: queue_len + reserved_count <= capacity
  *
+ * Permit tokens encode [generation:16 | permit slot:16], like the
+ * default handle index in asx_ids.h, so reserve, send and abort validate and
+ * release a permit in O(1); a slot's generation advances on reuse, so
+ * a consumed or copied permit can never match again.
+ *
+ * Payload channels give every permit slot a fixed-size buffer in
+ * storage taken from asx_runtime_alloc at create. The producer writes
+ * into its permit's buffer in place; commit marks the token committed
+ * and queues it instead of a value, and the buffer (with its share of
+ * capacity) stays lent to the receiver until the view is released:
+ *
+ *   Capacity invariant: queue_len + reserved + lent <= capacity
+ *
+ * Broadcast channels share the ring among up to
+ * ASX_CHANNEL_MAX_SUBSCRIBERS receivers, each with its own cursor. A
+ * published cell records how many subscribers still have to read it;
+ * the last reader frees the cell and its capacity, so the slowest
+ * subscriber applies backpressure through the normal reserve protocol.
+ * Cells can then be freed out of order, so producers check every cell
+ * of a run. Subscribing and unsubscribing stay on the calling thread.
+ *
+ * Priority channels keep one ring per class (2 to
+ * ASX_CHANNEL_MAX_PRIORITIES), each sized for the whole capacity, under
+ * the one claim counter: a message's class picks only the ring it is
+ * published to, and the consumer drains class 0 first. Plain channels
+ * are the one-class case.
+ *
+ * Channels created while the telemetry tier is above ULTRA_MIN keep
+ * occupancy statistics. Producer counters are 32-bit atomics; queue
+ * times come from a commit stamp per ring position and are summed by
+ * the reader (per subscriber for broadcast), so no 64-bit atomics are
+ * needed. Untracked channels pay one branch and no stamp storage.
+ *
  * Semantics specified in docs/CHANNEL_TIMER_KERNEL_SEMANTICS.md.
  *
  * SPDX-License-Identifier: MIT
@@ -18,32 +69,181 @@
 
 #include <asx/asx.h>
 #include <asx/core/channel.h>
-#include <string.h>
+#include <asx/runtime/waker.h>
+#include <asx/runtime/telemetry.h>
+#include "../runtime/runtime_internal.h"
+#include "../runtime/context_internal.h"
+#include "../core/bits.h"
+
+/* ------------------------------------------------------------------ */
+/* Atomics                                                            */
+/* ------------------------------------------------------------------ */
+
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define chan_load(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define chan_store(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define chan_cas(p, e, d)  __atomic_compare_exchange_n((p), &(e), (d), 0, \
+                               __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define chan_add(p, v)     (void)__atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define chan_sub(p, v)     (void)__atomic_fetch_sub((p), (v), __ATOMIC_ACQ_REL)
+#define chan_or(p, v)      (void)__atomic_fetch_or((p), (v), __ATOMIC_ACQ_REL)
+#define chan_sub_fetch(p, v) __atomic_sub_fetch((p), (v), __ATOMIC_ACQ_REL)
+#else
+static int chan_cas_plain(uint32_t *p, uint32_t *expected, uint32_t desired)
+{
+    if (*p != *expected) {
+        *expected = *p;
+        return 0;
+    }
+    *p = desired;
+    return 1;
+}
+#define chan_load(p)       (*(p))
+#define chan_store(p, v)   (void)(*(p) = (v))
+#define chan_cas(p, e, d)  chan_cas_plain((p), &(e), (d))
+#define chan_add(p, v)     (void)(*(p) += (v))
+#define chan_sub(p, v)     (void)(*(p) -= (v))
+#define chan_or(p, v)      (void)(*(p) |= (v))
+#define chan_sub_fetch(p, v) (*(p) -= (v))
+#endif
 
 /* ------------------------------------------------------------------ */
 /* Internal channel slot                                              */
 /* ------------------------------------------------------------------ */
 
+/* Each channel's ring has capacity rounded up to a power of two cells:
+ * positions wrap at 2^32, so a cell index is always pos & ring_mask.
+ * Admission keeps at most `capacity` positions outstanding. */
+#define CHAN_PERMIT_WORDS(cap)  (((cap) + 31u) / 32u)
+
+/* Token flag for a committed payload buffer; above any permit slot. */
+#define CHAN_TOKEN_COMMITTED 0x8000u
+#if ASX_CHANNEL_ARENA_MAX_CAPACITY > CHAN_TOKEN_COMMITTED
+#error "ASX_CHANNEL_ARENA_MAX_CAPACITY must leave the committed token bit free"
+#endif
+
+/* Permit and subscriber tokens keep [generation:16 | slot:16] under
+ * either handle layout; they never leave the channel's own API. */
+static uint32_t chan_token_pack(uint16_t generation, uint32_t slot)
+{
+    return ((uint32_t)generation << 16) | (slot & 0xFFFFu);
+}
+
+static uint32_t chan_token_slot(uint32_t token)
+{
+    return token & 0xFFFFu;
+}
+
+static uint16_t chan_token_generation(uint32_t token)
+{
+    return (uint16_t)(token >> 16);
+}
+
+/* Static ULTRA_MIN builds never track occupancy, so the stamp and
+ * statistics branches compile away. */
+#if ASX_STATIC_PROFILE && ASX_TELEMETRY_MIN_TIER >= 2
+#define CHAN_TRACKED(s) ((void)(s), 0)
+#else
+#define CHAN_TRACKED(s) ((s)->tracked)
+#endif
+
+/* Payload buffers are laid out at this alignment */
+#define CHAN_PAYLOAD_ALIGN 8u
+
+typedef struct {
+    uint32_t seq;    /* == pos: free for position pos; == pos + 1: holds it */
+    uint32_t unread; /* broadcast: subscribers yet to read the cell */
+    uint64_t value;
+} asx_channel_cell;
+
+typedef struct {
+    uint32_t cursor;     /* next position this subscriber reads */
+    uint16_t generation;
+    int      active;
+
+    /* Receive statistics, written only by this subscriber's reader */
+    uint32_t receives;
+    uint64_t wait_total_ns;
+    uint64_t wait_max_ns;
+} asx_channel_subscriber;
+
+/* Ring and permit storage bytes: cells, commit stamps (tracked channels
+ * only), tokens, free bitmap, generations */
+#define CHAN_STORAGE_BYTES(cap, ring, stamped) \
+    (((ring) * sizeof(asx_channel_cell) + \
+      ((stamped) ? (ring) * sizeof(uint64_t) : 0u) + \
+      (cap) * sizeof(uint32_t) + CHAN_PERMIT_WORDS(cap) * sizeof(uint32_t) + \
+      (cap) * sizeof(uint16_t) + 7u) & ~(size_t)7u)
+
+/* Static pool: one segment per slot, large enough for any channel of
+ * up to ASX_CHANNEL_MAX_CAPACITY, so reclaiming a slot frees its ring */
+#define CHAN_SEGMENT_WORDS \
+    (CHAN_STORAGE_BYTES(ASX_CHANNEL_MAX_CAPACITY, ASX_CHANNEL_MAX_CAPACITY, 1) / 8u)
+#define CHAN_POOL_WORDS (ASX_MAX_CHANNELS * CHAN_SEGMENT_WORDS)
+
+/* Drain and bulk-send staging runs */
+#define CHAN_RUN 64u
+
 typedef struct {
     asx_channel_state state;
     asx_region_id     region;
-    uint16_t          generation;
+    asx_generation    generation;
     int               alive;
-
-    /* Bounded ring buffer */
     uint32_t          capacity;
-    uint64_t          queue[ASX_CHANNEL_MAX_CAPACITY];
-    uint32_t          queue_head;   /* next read position */
-    uint32_t          queue_len;    /* committed messages in queue */
+    uint32_t          region_next;  /* owning region's channel list */
+
+    /* Bounded lock-free ring per priority class (storage sized at
+     * create); class k's cells start at k * (ring_mask + 1) */
+    asx_channel_cell *cells;
+    uint32_t          ring_mask;    /* ring cells - 1 */
+    uint32_t          classes;      /* priority classes, 1 unless created so */
+    uint32_t          enqueue_pos[ASX_CHANNEL_MAX_PRIORITIES]; /* next position a producer claims */
+    uint32_t          dequeue_pos[ASX_CHANNEL_MAX_PRIORITIES]; /* next position the consumer reads */
+    uint32_t          queue_len;    /* committed messages in queue, all classes */
 
     /* Two-phase accounting */
-    uint32_t          reserved;     /* outstanding permits */
-    uint32_t          next_token;   /* monotonic permit token */
-    uint32_t          permit_tokens[ASX_CHANNEL_MAX_CAPACITY]; /* 0 = free */
+    uint32_t          claimed;      /* queue_len + outstanding permits */
+    uint32_t          admit_limit;  /* claims refused at or past this */
+    asx_overload_mode admit_mode;   /* region policy behind a lower limit */
+    uint32_t          permit_words;
+    uint32_t         *permit_free;  /* [permit_words], 1 = free */
+    uint32_t         *permit_token; /* [capacity], 0 = none */
+    uint16_t         *permit_gen;   /* [capacity], owner-only */
+    void             *heap;         /* storage block from the allocator */
+
+    /* Payload storage: one buffer per permit slot (NULL for values) */
+    unsigned char    *payload;
+    uint32_t          element_size;
+    uint32_t          stride;       /* element_size rounded to alignment */
+    uint32_t          lent;         /* dequeued buffers not yet released */
+
+    /* Broadcast subscribers (calling thread changes membership) */
+    int               broadcast;
+    uint32_t          subscribers;  /* active count, stamped on each cell */
+    asx_channel_subscriber subs[ASX_CHANNEL_MAX_SUBSCRIBERS];
+
+    /* Occupancy statistics (tracked channels only) */
+    int               tracked;
+    uint64_t         *stamps;       /* [ring] commit time per position */
+    uint32_t          high_water;
+    uint32_t          sends;
+    uint32_t          reserve_full;
+    uint32_t          receives;     /* reader-owned, like the waits */
+    uint64_t          wait_total_ns;
+    uint64_t          wait_max_ns;
 } asx_channel_slot;
 
 static asx_channel_slot g_channels[ASX_MAX_CHANNELS];
 static uint32_t         g_channel_count;
+static uint64_t         g_channel_pool[CHAN_POOL_WORDS];
+
+static const asx_context_block g_channel_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_channels),
+    ASX_CONTEXT_BLOCK(g_channel_count),
+    ASX_CONTEXT_BLOCK(g_channel_pool)
+};
+
+const asx_context_module asx_channel_context = ASX_CONTEXT_MODULE(g_channel_blocks);
 
 /* ------------------------------------------------------------------ */
 /* Internal helpers                                                   */
@@ -52,8 +252,8 @@ static uint32_t         g_channel_count;
 static asx_status channel_slot_lookup(asx_channel_id id,
                                       asx_channel_slot **out)
 {
-    uint16_t slot_idx;
-    uint16_t gen;
+    uint32_t slot_idx;
+    asx_generation gen;
     asx_channel_slot *s;
 
     if (!asx_handle_is_valid(id)) {
@@ -82,84 +282,524 @@ static asx_status channel_slot_lookup(asx_channel_id id,
     return ASX_OK;
 }
 
-static asx_channel_id channel_make_handle(uint16_t slot_idx, uint16_t gen)
+/* Wake tasks parked on this channel after a readiness change. */
+static void channel_wake(asx_channel_id id)
 {
-    uint32_t index = asx_handle_pack_index(gen, slot_idx);
+    (void)asx_wake_source_deferred(ASX_PARK_CHANNEL, asx_park_key_channel(id));
+}
+
+static asx_channel_id channel_make_handle(uint32_t slot_idx, asx_generation gen)
+{
+    uint64_t index = asx_handle_pack_index(gen, slot_idx);
     return asx_handle_pack(ASX_TYPE_CHANNEL, 0, index);
 }
 
-static int channel_token_find(const asx_channel_slot *s,
-                              uint32_t token,
-                              uint32_t *out_idx)
+/* Smallest power of two >= n (n <= ASX_CHANNEL_ARENA_MAX_CAPACITY). */
+static uint32_t channel_ring_size(uint32_t n)
+{
+    uint32_t ring = 1u;
+    while (ring < n) { /* ASX_CHECKPOINT_WAIVER("bounded by 32 doublings") */
+        ring <<= 1;
+    }
+    return ring;
+}
+
+/* Carve ring and permit storage for s->capacity and s->classes: from
+ * the slot's static pool segment when it fits (any single ring of up
+ * to ASX_CHANNEL_MAX_CAPACITY does), else from the allocator hook. */
+static asx_status channel_storage_acquire(asx_channel_slot *s)
+{
+    uint32_t cap = s->capacity;
+    uint32_t ring = channel_ring_size(cap);
+    size_t cells = (size_t)ring * s->classes;
+    size_t bytes = CHAN_STORAGE_BYTES((size_t)cap, cells, CHAN_TRACKED(s));
+    unsigned char *base;
+
+    if (bytes <= CHAN_SEGMENT_WORDS * sizeof(uint64_t)) {
+        size_t slot_idx = (size_t)(s - g_channels);
+        base = (unsigned char *)&g_channel_pool[slot_idx * CHAN_SEGMENT_WORDS];
+        s->heap = NULL;
+    } else {
+        void *mem;
+        if (asx_runtime_alloc_tagged(ASX_ALLOC_TAG_CHANNEL, bytes, &mem) != ASX_OK) {
+            return ASX_E_RESOURCE_EXHAUSTED;
+        }
+        base = (unsigned char *)mem;
+        s->heap = mem;
+    }
+
+    s->ring_mask    = ring - 1u;
+    s->permit_words = CHAN_PERMIT_WORDS(cap);
+    s->cells        = (asx_channel_cell *)(void *)base;
+    base += cells * sizeof(asx_channel_cell);
+    s->stamps       = NULL;
+    if (CHAN_TRACKED(s)) {
+        s->stamps = (uint64_t *)(void *)base;
+        base += cells * sizeof(uint64_t);
+    }
+    s->permit_token = (uint32_t *)(void *)base;
+    base += (size_t)cap * sizeof(uint32_t);
+    s->permit_free  = (uint32_t *)(void *)base;
+    base += (size_t)s->permit_words * sizeof(uint32_t);
+    s->permit_gen   = (uint16_t *)(void *)base;
+    return ASX_OK;
+}
+
+/* Return a slot's ring, permit and payload storage (failed open,
+ * reclaim or reset); pool segments need no bookkeeping. */
+static void channel_storage_release(asx_channel_slot *s)
+{
+    if (s->heap != NULL) {
+        (void)asx_runtime_free(s->heap);
+    }
+    if (s->payload != NULL) {
+        (void)asx_runtime_free(s->payload);
+    }
+    s->payload = NULL;
+    s->heap = NULL;
+    s->cells = NULL;
+    s->stamps = NULL;
+    s->permit_token = NULL;
+    s->permit_free = NULL;
+    s->permit_gen = NULL;
+}
+
+/* Empty ring and permit table for a newly opened slot; calling thread. */
+static void channel_ring_init(asx_channel_slot *s)
 {
     uint32_t i;
 
-    if (token == 0u) return 0;
+    for (i = 0; i < (s->ring_mask + 1u) * s->classes; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by channel ring size and classes");
+        s->cells[i].seq = i & s->ring_mask;
+        s->cells[i].value = 0;
+        if (s->stamps != NULL) s->stamps[i] = 0u;
+    }
+    for (i = 0; i < s->capacity; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by channel capacity");
+        s->permit_token[i] = 0u;
+        s->permit_gen[i] = 0u;
+    }
+    for (i = 0; i < s->permit_words; i++) {
+        uint32_t lo = i * 32u;
+        uint32_t n = s->capacity > lo ? s->capacity - lo : 0u;
+        ASX_CHECKPOINT_WAIVER("bounded by channel permit words");
+        s->permit_free[i] = n >= 32u ? 0xFFFFFFFFu : (1u << n) - 1u;
+    }
+    for (i = 0; i < ASX_CHANNEL_MAX_PRIORITIES; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_CHANNEL_MAX_PRIORITIES");
+        s->enqueue_pos[i] = 0;
+        s->dequeue_pos[i] = 0;
+    }
+    s->queue_len   = 0;
+    s->claimed     = 0;
+    s->lent        = 0;
+    s->subscribers = 0;
+    for (i = 0; i < ASX_CHANNEL_MAX_SUBSCRIBERS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_CHANNEL_MAX_SUBSCRIBERS");
+        s->subs[i].active = 0;
+    }
+    s->high_water    = 0;
+    s->sends         = 0;
+    s->reserve_full  = 0;
+    s->receives      = 0;
+    s->wait_total_ns = 0;
+    s->wait_max_ns   = 0;
+}
 
-    for (i = 0; i < ASX_CHANNEL_MAX_CAPACITY; i++) {
-        if (s->permit_tokens[i] == token) {
-            if (out_idx != NULL) {
-                *out_idx = i;
-            }
-            return 1;
-        }
+/* Stamp for queue-time statistics; 0 (not measured) without a clock. */
+static uint64_t channel_now(void)
+{
+    asx_time now;
+    if (asx_runtime_now_ns(&now) != ASX_OK) {
+        return 0u;
     }
+    return (uint64_t)now;
+}
+
+/* Producer side of a queued run: count it and raise the high-water mark
+ * to the queue length it reached. */
+static void channel_stats_sent(asx_channel_slot *s, uint32_t n, uint32_t len)
+{
+    uint32_t hw = chan_load(&s->high_water);
 
-    return 0;
+    chan_add(&s->sends, n);
+    while (len > hw) { /* ASX_CHECKPOINT_WAIVER("lock-free CAS retry; bounded by concurrent producers") */
+        if (chan_cas(&s->high_water, hw, len)) break;
+    }
 }
 
-static uint32_t channel_token_allocate(asx_channel_slot *s)
+/* Reader side: fold the queue time of the message in cell index idx
+ * into the reader's totals. Must run before the cell is freed for
+ * reuse. */
+static void channel_stats_received(const asx_channel_slot *s, uint32_t idx,
+                                   uint64_t now, uint32_t *receives,
+                                   uint64_t *wait_total, uint64_t *wait_max)
 {
-    uint32_t token;
+    uint64_t stamp = s->stamps[idx];
+
+    (*receives)++;
+    if (stamp != 0u && now >= stamp) {
+        uint64_t wait = now - stamp;
+        *wait_total += wait;
+        if (wait > *wait_max) *wait_max = wait;
+    }
+}
+
+/* Take capacity for up to want permits in one CAS, keeping
+ * queue_len + reserved <= capacity. Returns the number claimed, or 0
+ * if fewer than min are available. */
+static uint32_t channel_claim(asx_channel_slot *s, uint32_t want, uint32_t min)
+{
+    uint32_t c = chan_load(&s->claimed);
+
+    for (;;) {
+        uint32_t limit = chan_load(&s->admit_limit);
+        uint32_t room;
+        uint32_t k;
+        ASX_CHECKPOINT_WAIVER("lock-free CAS retry; bounded by concurrent producers");
+        room = c < limit ? limit - c : 0u;
+        k = want < room ? want : room;
+        if (k == 0u || k < min) return 0;
+        if (chan_cas(&s->claimed, c, c + k)) return k;
+    }
+}
+
+/* channel_claim for the reserve entry points: a refusal is counted as
+ * a reserve failure when the channel is tracked. */
+static uint32_t channel_reserve_claim(asx_channel_slot *s, uint32_t want,
+                                      uint32_t min)
+{
+    uint32_t k = channel_claim(s, want, min);
+    if (k == 0u && CHAN_TRACKED(s)) {
+        chan_add(&s->reserve_full, 1u);
+    }
+    return k;
+}
 
-    /* token 0 is reserved as "invalid / free-slot marker" */
-    token = s->next_token;
-    if (token == 0u) token = 1u;
+/* Claim ceiling from the owning region's admission policy: the first
+ * claim count whose load reaches threshold_pct, or the capacity. */
+static void channel_admission_set(asx_channel_slot *s, const asx_region_slot *r)
+{
+    uint32_t limit = s->capacity;
 
-    while (channel_token_find(s, token, NULL)) {
-        token++;
-        if (token == 0u) token = 1u;
+    if (r->admission_on && r->admission.mode != ASX_OVERLOAD_SHED_OLDEST) {
+        uint64_t edge = ((uint64_t)r->admission.threshold_pct * s->capacity
+                         + 99u) / 100u;
+        if (edge < limit) limit = (uint32_t)edge;
+        s->admit_mode = r->admission.mode;
     }
+    chan_store(&s->admit_limit, limit);
+}
 
-    s->next_token = token + 1u;
-    if (s->next_token == 0u) s->next_token = 1u;
+/* Status for a refused claim of min slots: the policy's, traced, when
+ * capacity alone would have admitted it, else ASX_E_CHANNEL_FULL. */
+static asx_status channel_refusal(asx_channel_slot *s, asx_channel_id id,
+                                  uint32_t min)
+{
+    uint32_t c = chan_load(&s->claimed);
+
+    if (chan_load(&s->admit_limit) < s->capacity && c <= s->capacity &&
+        min <= s->capacity - c) {
+        uint32_t load_pct = (uint32_t)(((uint64_t)c * 100u) / s->capacity);
+        asx_trace_emit(ASX_TRACE_ADMISSION, id,
+                       ASX_TRACE_ADMISSION_AUX(ASX_ADMISSION_CHANNEL,
+                                               s->admit_mode, load_pct));
+        return s->admit_mode == ASX_OVERLOAD_REJECT ? ASX_E_ADMISSION_CLOSED
+                                                    : ASX_E_WOULD_BLOCK;
+    }
+    return ASX_E_CHANNEL_FULL;
+}
 
-    return token;
+/* Pop a free permit slot and issue its token, or return 0 if none. */
+static uint32_t channel_token_allocate(asx_channel_slot *s)
+{
+    uint32_t w;
+
+    for (w = 0; w < s->permit_words; w++) {
+        uint32_t bits = chan_load(&s->permit_free[w]);
+        ASX_CHECKPOINT_WAIVER("bounded by channel permit words");
+        while (bits != 0u) {
+            uint32_t bit = bits & (~bits + 1u);
+            ASX_CHECKPOINT_WAIVER("lock-free CAS retry; bounded by concurrent producers");
+            if (chan_cas(&s->permit_free[w], bits, bits & ~bit)) {
+                uint32_t idx = w * 32u + asx_ctz32(bit);
+                uint16_t gen = (uint16_t)(s->permit_gen[idx] + 1u);
+                uint32_t token;
+                if (gen == 0u) gen = 1u;
+                s->permit_gen[idx] = gen;
+                token = chan_token_pack(gen, idx);
+                chan_store(&s->permit_token[idx], token);
+                return token;
+            }
+        }
+    }
+    return 0u;
 }
 
+/* Retire a permit token; exactly one caller per issued token succeeds. */
 static asx_status channel_token_consume(asx_channel_slot *s, uint32_t token)
 {
-    uint32_t idx;
+    uint32_t idx = chan_token_slot(token);
+    uint32_t expected = token;
 
-    if (!channel_token_find(s, token, &idx)) {
+    if (idx >= s->capacity || chan_token_generation(token) == 0u) {
+        return ASX_E_INVALID_STATE;
+    }
+    if (!chan_cas(&s->permit_token[idx], expected, 0u)) {
         return ASX_E_INVALID_STATE;
     }
+    chan_or(&s->permit_free[idx / 32u], 1u << (idx % 32u));
+    return ASX_OK;
+}
+
+/* Retire a payload permit but keep its buffer: the token becomes the
+ * committed form the receiver's view carries. */
+static asx_status channel_token_commit(asx_channel_slot *s, uint32_t token)
+{
+    uint32_t idx = chan_token_slot(token);
+    uint32_t expected = token;
 
-    s->permit_tokens[idx] = 0u;
-    if (s->reserved > 0u) {
-        s->reserved--;
+    if (idx >= s->capacity || chan_token_generation(token) == 0u) {
+        return ASX_E_INVALID_STATE;
+    }
+    if (!chan_cas(&s->permit_token[idx], expected, token | CHAN_TOKEN_COMMITTED)) {
+        return ASX_E_INVALID_STATE;
     }
+    return ASX_OK;
+}
+
+/* Return a committed buffer and its capacity; one caller succeeds. */
+static asx_status channel_buffer_release(asx_channel_slot *s, uint32_t committed)
+{
+    uint32_t idx = chan_token_slot(committed) & ~CHAN_TOKEN_COMMITTED;
+    uint32_t expected = committed;
 
+    if ((committed & CHAN_TOKEN_COMMITTED) == 0u || idx >= s->capacity) {
+        return ASX_E_INVALID_STATE;
+    }
+    if (!chan_cas(&s->permit_token[idx], expected, 0u)) {
+        return ASX_E_INVALID_STATE;
+    }
+    chan_or(&s->permit_free[idx / 32u], 1u << (idx % 32u));
+    chan_sub(&s->claimed, 1u);
     return ASX_OK;
 }
 
+static void *channel_buffer(asx_channel_slot *s, uint32_t token)
+{
+    uint32_t idx = chan_token_slot(token) & ~CHAN_TOKEN_COMMITTED;
+    return s->payload + (size_t)idx * s->stride;
+}
+
+/* Append n committed values as one contiguous run to the ring of
+ * priority class lane. The caller's claims guarantee free cells, and
+ * every class ring can hold the whole capacity, so the loop only races
+ * other producers for the positions. The consumer frees a ring's cells
+ * in order, so the run is free once its last cell is. */
+static void channel_enqueue(asx_channel_slot *s, uint32_t lane,
+                            const uint64_t *values, uint32_t n)
+{
+    uint32_t *tail = &s->enqueue_pos[lane];
+    uint32_t base = lane * (s->ring_mask + 1u);
+    uint32_t pos = chan_load(tail);
+    uint64_t now = CHAN_TRACKED(s) ? channel_now() : 0u;
+    uint32_t i;
+
+    for (;;) {
+        uint32_t last = pos + n - 1u;
+        ASX_CHECKPOINT_WAIVER("lock-free CAS retry; bounded by concurrent producers");
+        if (chan_load(&s->cells[base + (last & s->ring_mask)].seq) == last) {
+            if (chan_cas(tail, pos, pos + n)) break;
+        } else {
+            pos = chan_load(tail);
+        }
+    }
+
+    if (!s->broadcast) {
+        chan_add(&s->queue_len, n);
+        if (CHAN_TRACKED(s)) channel_stats_sent(s, n, chan_load(&s->queue_len));
+        for (i = 0; i < n; i++) {
+            uint32_t idx = base + ((pos + i) & s->ring_mask);
+            asx_channel_cell *cell = &s->cells[idx];
+            ASX_CHECKPOINT_WAIVER("bounded by channel capacity");
+            cell->value = values[i];
+            if (CHAN_TRACKED(s)) s->stamps[idx] = now;
+            chan_store(&cell->seq, pos + i + 1u);
+        }
+        return;
+    }
+
+    /* Broadcast: a cell is free once its last subscriber has read it */
+    if (s->subscribers != 0u) {
+        chan_add(&s->queue_len, n);
+    }
+    if (CHAN_TRACKED(s)) channel_stats_sent(s, n, chan_load(&s->queue_len));
+    for (i = 0; i < n; i++) {
+        asx_channel_cell *cell = &s->cells[(pos + i) & s->ring_mask];
+        ASX_CHECKPOINT_WAIVER("bounded by channel capacity");
+        while (chan_load(&cell->seq) != pos + i) {
+            ASX_CHECKPOINT_WAIVER("lock-free wait; a subscriber is freeing the cell");
+        }
+        if (s->subscribers == 0u) {
+            /* No one to deliver to: the cell is passed at once */
+            chan_store(&cell->seq, pos + i + s->ring_mask + 1u);
+            continue;
+        }
+        cell->value = values[i];
+        cell->unread = s->subscribers;
+        if (CHAN_TRACKED(s)) s->stamps[(pos + i) & s->ring_mask] = now;
+        chan_store(&cell->seq, pos + i + 1u);
+    }
+    if (s->subscribers == 0u) {
+        chan_sub(&s->claimed, n);
+    }
+}
+
+/* A subscriber has read the cell at pos; the last reader frees it and
+ * its capacity. Returns 1 if the cell was freed. */
+static int channel_cell_pass(asx_channel_slot *s, uint32_t pos)
+{
+    asx_channel_cell *cell = &s->cells[pos & s->ring_mask];
+
+    if (chan_sub_fetch(&cell->unread, 1u) != 0u) {
+        return 0;
+    }
+    chan_store(&cell->seq, pos + s->ring_mask + 1u);
+    chan_sub(&s->queue_len, 1u);
+    chan_sub(&s->claimed, 1u);
+    return 1;
+}
+
+/* Pass every cell a subscriber has not read yet (leaving, or receiver
+ * close); calling thread, so every position below enqueue_pos[0] is
+ * published. */
+static void channel_subscriber_drain(asx_channel_slot *s,
+                                     asx_channel_subscriber *sub)
+{
+    uint32_t end = s->enqueue_pos[0];
+
+    while (sub->cursor != end) { /* ASX_CHECKPOINT_WAIVER("bounded by channel capacity") */
+        (void)channel_cell_pass(s, sub->cursor);
+        sub->cursor++;
+    }
+}
+
+/* A leaving subscriber's receive statistics carry over to the channel;
+ * calling thread. */
+static void channel_subscriber_retire_stats(asx_channel_slot *s,
+                                            const asx_channel_subscriber *sub)
+{
+    s->receives += sub->receives;
+    s->wait_total_ns += sub->wait_total_ns;
+    if (sub->wait_max_ns > s->wait_max_ns) s->wait_max_ns = sub->wait_max_ns;
+}
+
+/* Single consumer: take up to max of the oldest published values,
+ * class 0 (most urgent) first, each class in FIFO order. Cells are
+ * released one by one, the counters once per run. A payload channel's
+ * dequeued buffers stay claimed until their views release. Only
+ * deliveries (received nonzero) count toward the statistics. */
+static uint32_t channel_dequeue(asx_channel_slot *s, uint64_t *out_values,
+                                uint32_t max, int received)
+{
+    uint32_t n = 0;
+    uint32_t lane;
+    int stats = received && CHAN_TRACKED(s);
+    uint64_t now = stats ? channel_now() : 0u;
+
+    for (lane = 0; lane < s->classes && n < max; lane++) {
+        uint32_t base = lane * (s->ring_mask + 1u);
+        uint32_t pos = s->dequeue_pos[lane];
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_CHANNEL_MAX_PRIORITIES");
+        while (n < max) {
+            uint32_t idx = base + (pos & s->ring_mask);
+            asx_channel_cell *cell = &s->cells[idx];
+            ASX_CHECKPOINT_WAIVER("bounded by max and channel capacity");
+            if (chan_load(&cell->seq) != pos + 1u) break;
+            if (out_values != NULL) out_values[n] = cell->value;
+            if (stats) {
+                channel_stats_received(s, idx, now, &s->receives,
+                                       &s->wait_total_ns, &s->wait_max_ns);
+            }
+            chan_store(&cell->seq, pos + s->ring_mask + 1u);
+            pos++;
+            n++;
+        }
+        s->dequeue_pos[lane] = pos;
+    }
+    if (n > 0u) {
+        if (s->payload != NULL) {
+            chan_add(&s->lent, n);
+            chan_sub(&s->queue_len, n);
+        } else {
+            chan_sub(&s->queue_len, n);
+            chan_sub(&s->claimed, n);
+        }
+    }
+    return n;
+}
+
+/* Discard every published message (receiver close); calling thread. */
+static void channel_discard(asx_channel_slot *s)
+{
+    uint64_t tokens[CHAN_RUN];
+    uint32_t n;
+    uint32_t i;
+
+    if (s->broadcast) {
+        uint32_t i2;
+        for (i2 = 0; i2 < ASX_CHANNEL_MAX_SUBSCRIBERS; i2++) {
+            asx_channel_subscriber *sub = &s->subs[i2];
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_CHANNEL_MAX_SUBSCRIBERS");
+            if (!sub->active) continue;
+            channel_subscriber_drain(s, sub);
+            channel_subscriber_retire_stats(s, sub);
+            sub->active = 0;
+        }
+        s->subscribers = 0;
+        return;
+    }
+    if (s->payload == NULL) {
+        (void)channel_dequeue(s, NULL, s->capacity, 0);
+        return;
+    }
+    do { /* ASX_CHECKPOINT_WAIVER("bounded by channel capacity") */
+        n = channel_dequeue(s, tokens, CHAN_RUN, 0);
+        for (i = 0; i < n; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by CHAN_RUN");
+            (void)channel_buffer_release(s, (uint32_t)tokens[i]);
+        }
+        chan_sub(&s->lent, n);
+    } while (n == CHAN_RUN);
+}
+
 /* ------------------------------------------------------------------ */
 /* Channel lifecycle                                                  */
 /* ------------------------------------------------------------------ */
 
-asx_status asx_channel_create(asx_region_id region,
+/* Shared create path; element_size 0 makes a value channel, classes
+ * above 1 a priority channel. */
+static asx_status channel_open(asx_region_id region,
                                uint32_t capacity,
+                               uint32_t element_size,
+                               int broadcast,
+                               uint32_t classes,
                                asx_channel_id *out_id)
 {
     uint16_t i;
     asx_channel_slot *s;
-    asx_region_state region_state;
+    asx_region_slot *r;
+    uint32_t *head;
     asx_status st;
 
     if (out_id == NULL) {
         return ASX_E_INVALID_ARGUMENT;
     }
-    if (capacity == 0 || capacity > ASX_CHANNEL_MAX_CAPACITY) {
+    if (capacity == 0 || capacity > ASX_CHANNEL_ARENA_MAX_CAPACITY) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (element_size > ASX_CHANNEL_MAX_ELEMENT_SIZE) {
         return ASX_E_INVALID_ARGUMENT;
     }
     if (!asx_handle_is_valid(region)) {
@@ -169,28 +809,47 @@ asx_status asx_channel_create(asx_region_id region,
         return ASX_E_INVALID_ARGUMENT;
     }
 
-    st = asx_region_get_state(region, &region_state);
+    st = asx_region_slot_lookup(region, &r);
     if (st != ASX_OK) {
         return st;
     }
-    if (region_state != ASX_REGION_OPEN) {
+    if (r->state != ASX_REGION_OPEN) {
         return ASX_E_INVALID_STATE;
     }
+    head = &r->channel_head;
 
     for (i = 0; i < ASX_MAX_CHANNELS; i++) {
         if (!g_channels[i].alive) {
             s = &g_channels[i];
 
+            s->capacity = capacity;
+            s->classes  = classes;
+            s->tracked  = asx_telemetry_get_tier() != ASX_TELEMETRY_ULTRA_MIN;
+            st = channel_storage_acquire(s);
+            if (st != ASX_OK) {
+                return st;
+            }
+            if (element_size != 0u) {
+                uint32_t stride = (element_size + CHAN_PAYLOAD_ALIGN - 1u) &
+                                  ~(CHAN_PAYLOAD_ALIGN - 1u);
+                void *mem;
+                if (asx_runtime_alloc_tagged(ASX_ALLOC_TAG_CHANNEL,
+                                             (size_t)stride * capacity, &mem) != ASX_OK) {
+                    channel_storage_release(s);
+                    return ASX_E_RESOURCE_EXHAUSTED;
+                }
+                s->payload = (unsigned char *)mem;
+                s->stride  = stride;
+            }
+            s->element_size = element_size;
+            s->broadcast   = broadcast;
             s->state       = ASX_CHANNEL_OPEN;
             s->region      = region;
             s->alive       = 1;
-            s->capacity    = capacity;
-            s->queue_head  = 0;
-            s->queue_len   = 0;
-            s->reserved    = 0;
-            s->next_token  = 1;
-            memset(s->queue, 0, sizeof(s->queue));
-            memset(s->permit_tokens, 0, sizeof(s->permit_tokens));
+            s->region_next = *head;
+            *head          = i;
+            channel_ring_init(s);
+            channel_admission_set(s, r);
 
             g_channel_count++;
             *out_id = channel_make_handle(i, s->generation);
@@ -201,6 +860,42 @@ asx_status asx_channel_create(asx_region_id region,
     return ASX_E_RESOURCE_EXHAUSTED;
 }
 
+asx_status asx_channel_create(asx_region_id region,
+                               uint32_t capacity,
+                               asx_channel_id *out_id)
+{
+    return channel_open(region, capacity, 0u, 0, 1u, out_id);
+}
+
+asx_status asx_channel_create_payload(asx_region_id region,
+                                       uint32_t capacity,
+                                       uint32_t element_size,
+                                       asx_channel_id *out_id)
+{
+    if (element_size == 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return channel_open(region, capacity, element_size, 0, 1u, out_id);
+}
+
+asx_status asx_channel_create_broadcast(asx_region_id region,
+                                         uint32_t capacity,
+                                         asx_channel_id *out_id)
+{
+    return channel_open(region, capacity, 0u, 1, 1u, out_id);
+}
+
+asx_status asx_channel_create_priority(asx_region_id region,
+                                        uint32_t capacity,
+                                        uint32_t classes,
+                                        asx_channel_id *out_id)
+{
+    if (classes < 2u || classes > ASX_CHANNEL_MAX_PRIORITIES) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return channel_open(region, capacity, 0u, 0, classes, out_id);
+}
+
 asx_status asx_channel_close_sender(asx_channel_id id)
 {
     asx_channel_slot *s;
@@ -214,9 +909,11 @@ asx_status asx_channel_close_sender(asx_channel_id id)
     switch (s->state) {
     case ASX_CHANNEL_OPEN:
         s->state = ASX_CHANNEL_SENDER_CLOSED;
+        channel_wake(id);
         return ASX_OK;
     case ASX_CHANNEL_RECEIVER_CLOSED:
         s->state = ASX_CHANNEL_FULLY_CLOSED;
+        channel_wake(id);
         return ASX_OK;
     case ASX_CHANNEL_SENDER_CLOSED:
     case ASX_CHANNEL_FULLY_CLOSED:
@@ -239,13 +936,13 @@ asx_status asx_channel_close_receiver(asx_channel_id id)
     switch (s->state) {
     case ASX_CHANNEL_OPEN:
         s->state = ASX_CHANNEL_RECEIVER_CLOSED;
-        s->queue_len = 0;
-        s->queue_head = 0;
+        channel_discard(s);
+        channel_wake(id);
         return ASX_OK;
     case ASX_CHANNEL_SENDER_CLOSED:
         s->state = ASX_CHANNEL_FULLY_CLOSED;
-        s->queue_len = 0;
-        s->queue_head = 0;
+        channel_discard(s);
+        channel_wake(id);
         return ASX_OK;
     case ASX_CHANNEL_RECEIVER_CLOSED:
     case ASX_CHANNEL_FULLY_CLOSED:
@@ -289,7 +986,7 @@ asx_status asx_channel_queue_len(asx_channel_id id, uint32_t *out)
         return st;
     }
 
-    *out = s->queue_len;
+    *out = chan_load(&s->queue_len);
     return ASX_OK;
 }
 
@@ -306,7 +1003,65 @@ asx_status asx_channel_reserved_count(asx_channel_id id, uint32_t *out)
         return st;
     }
 
-    *out = s->reserved;
+    {
+        /* claimed first: it never drops below queue_len + lent */
+        uint32_t claimed = chan_load(&s->claimed);
+        uint32_t held = chan_load(&s->queue_len) + chan_load(&s->lent);
+        *out = claimed > held ? claimed - held : 0u;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_channel_element_size(asx_channel_id id, uint32_t *out)
+{
+    asx_channel_slot *s;
+    asx_status st;
+
+    if (out == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    *out = s->element_size;
+    return ASX_OK;
+}
+
+asx_status asx_channel_get_stats(asx_channel_id id, asx_channel_stats *out)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint32_t i;
+
+    if (out == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (!CHAN_TRACKED(s)) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    out->high_water    = chan_load(&s->high_water);
+    out->sends         = chan_load(&s->sends);
+    out->reserve_full  = chan_load(&s->reserve_full);
+    out->receives      = s->receives;
+    out->wait_total_ns = s->wait_total_ns;
+    out->wait_max_ns   = s->wait_max_ns;
+    for (i = 0; i < ASX_CHANNEL_MAX_SUBSCRIBERS; i++) {
+        const asx_channel_subscriber *sub = &s->subs[i];
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_CHANNEL_MAX_SUBSCRIBERS");
+        if (!sub->active) continue;
+        out->receives += sub->receives;
+        out->wait_total_ns += sub->wait_total_ns;
+        if (sub->wait_max_ns > out->wait_max_ns) {
+            out->wait_max_ns = sub->wait_max_ns;
+        }
+    }
     return ASX_OK;
 }
 
@@ -328,6 +1083,9 @@ asx_status asx_channel_try_reserve(asx_channel_id id,
     if (st != ASX_OK) {
         return st;
     }
+    if (s->payload != NULL) {
+        return ASX_E_INVALID_STATE;
+    }
 
     if (s->state == ASX_CHANNEL_SENDER_CLOSED ||
         s->state == ASX_CHANNEL_FULLY_CLOSED) {
@@ -338,80 +1096,239 @@ asx_status asx_channel_try_reserve(asx_channel_id id,
         return ASX_E_DISCONNECTED;
     }
 
-    if (s->queue_len + s->reserved >= s->capacity) {
-        return ASX_E_CHANNEL_FULL;
+    if (channel_reserve_claim(s, 1u, 1u) == 0u) {
+        return channel_refusal(s, id, 1u);
     }
 
     {
-        uint32_t permit_idx;
         uint32_t token = channel_token_allocate(s);
-        int found = 0;
-        for (permit_idx = 0; permit_idx < ASX_CHANNEL_MAX_CAPACITY; permit_idx++) {
-            if (s->permit_tokens[permit_idx] == 0u) {
-                s->permit_tokens[permit_idx] = token;
-                found = 1;
-                out->channel_id = id;
-                out->token = token;
-                out->consumed = 0;
-                s->reserved++;
-                break;
-            }
-        }
-        if (!found) {
+        if (token == 0u) {
+            chan_sub(&s->claimed, 1u);
             return ASX_E_RESOURCE_EXHAUSTED;
         }
+        out->channel_id = id;
+        out->token = token;
+        out->consumed = 0;
     }
 
     return ASX_OK;
 }
 
-/* ------------------------------------------------------------------ */
-/* Two-phase send: commit (send value)                                */
-/* ------------------------------------------------------------------ */
-
-asx_status asx_send_permit_send(asx_send_permit *permit, uint64_t value)
+asx_status asx_channel_try_reserve_many(asx_channel_id id,
+                                         asx_send_permit *out_permits,
+                                         uint32_t count,
+                                         int all_or_nothing,
+                                         uint32_t *out_reserved)
 {
     asx_channel_slot *s;
     asx_status st;
-    uint32_t write_pos;
+    uint32_t k;
+    uint32_t i;
 
-    if (permit == NULL) {
+    if (out_reserved == NULL) {
         return ASX_E_INVALID_ARGUMENT;
     }
-    if (permit->consumed) {
-        return ASX_E_INVALID_STATE;
+    *out_reserved = 0;
+    if (out_permits == NULL || count == 0u) {
+        return ASX_E_INVALID_ARGUMENT;
     }
 
-    st = channel_slot_lookup(permit->channel_id, &s);
+    st = channel_slot_lookup(id, &s);
     if (st != ASX_OK) {
-        permit->consumed = 1;
         return st;
     }
-
-    st = channel_token_consume(s, permit->token);
-    if (st != ASX_OK) {
-        permit->consumed = 1;
-        return st;
+    if (s->payload != NULL) {
+        return ASX_E_INVALID_STATE;
     }
 
-    permit->consumed = 1;
-
-    if (s->state == ASX_CHANNEL_RECEIVER_CLOSED ||
+    if (s->state == ASX_CHANNEL_SENDER_CLOSED ||
         s->state == ASX_CHANNEL_FULLY_CLOSED) {
-        return ASX_E_DISCONNECTED;
+        return ASX_E_INVALID_STATE;
     }
 
-    if (s->queue_len >= s->capacity) {
-        return ASX_E_CHANNEL_FULL;
+    if (s->state == ASX_CHANNEL_RECEIVER_CLOSED) {
+        return ASX_E_DISCONNECTED;
     }
 
-    write_pos = (s->queue_head + s->queue_len) % s->capacity;
-    s->queue[write_pos] = value;
-    s->queue_len++;
+    /* One claim for the whole batch */
+    k = channel_reserve_claim(s, count, all_or_nothing ? count : 1u);
+    if (k == 0u) {
+        return channel_refusal(s, id, all_or_nothing ? count : 1u);
+    }
 
+    for (i = 0; i < k; i++) {
+        uint32_t token = channel_token_allocate(s);
+        ASX_CHECKPOINT_WAIVER("bounded by channel capacity");
+        if (token == 0u) {
+            /* Cannot happen while claims bound live permits; undo */
+            chan_sub(&s->claimed, k - i);
+            break;
+        }
+        out_permits[i].channel_id = id;
+        out_permits[i].token = token;
+        out_permits[i].consumed = 0;
+    }
+    *out_reserved = i;
+    return i == k ? ASX_OK : ASX_E_RESOURCE_EXHAUSTED;
+}
+
+/* ------------------------------------------------------------------ */
+/* Two-phase send: commit (send value)                                */
+/* ------------------------------------------------------------------ */
+
+/* Priority argument for a plain send: the channel's least urgent class */
+#define CHAN_CLASS_LAST UINT32_MAX
+
+static asx_status channel_permit_send(asx_send_permit *permit,
+                                      uint32_t priority, uint64_t value)
+{
+    asx_channel_slot *s;
+    asx_status st;
+
+    if (permit == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (permit->consumed) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    st = channel_slot_lookup(permit->channel_id, &s);
+    if (st != ASX_OK) {
+        permit->consumed = 1;
+        return st;
+    }
+    if (s->payload != NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+    if (priority == CHAN_CLASS_LAST) {
+        priority = s->classes - 1u;
+    } else if (priority >= s->classes) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_token_consume(s, permit->token);
+    if (st != ASX_OK) {
+        permit->consumed = 1;
+        return st;
+    }
+
+    permit->consumed = 1;
+
+    if (s->state == ASX_CHANNEL_RECEIVER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        chan_sub(&s->claimed, 1u);
+        return ASX_E_DISCONNECTED;
+    }
+
+    /* The permit's claim now covers the queued message */
+    channel_enqueue(s, priority, &value, 1u);
+
+    channel_wake(permit->channel_id);
     return ASX_OK;
 }
 
+asx_status asx_send_permit_send(asx_send_permit *permit, uint64_t value)
+{
+    return channel_permit_send(permit, CHAN_CLASS_LAST, value);
+}
+
+asx_status asx_send_permit_send_priority(asx_send_permit *permit,
+                                          uint32_t priority,
+                                          uint64_t value)
+{
+    if (priority == CHAN_CLASS_LAST) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return channel_permit_send(permit, priority, value);
+}
+
+/* Queue a run of values whose permits were retired; their claims now
+ * cover the queued messages, or are returned if the receiver closed. */
+static asx_status channel_commit_run(asx_channel_slot *s, const uint64_t *run,
+                                     uint32_t n)
+{
+    if (s->state == ASX_CHANNEL_RECEIVER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        chan_sub(&s->claimed, n);
+        return ASX_E_DISCONNECTED;
+    }
+    channel_enqueue(s, s->classes - 1u, run, n);
+    return ASX_OK;
+}
+
+asx_status asx_send_permit_send_many(asx_send_permit *permits,
+                                      const uint64_t *values,
+                                      uint32_t count,
+                                      uint32_t *out_sent)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    asx_status first = ASX_OK;
+    asx_channel_id id;
+    uint64_t run[CHAN_RUN];
+    uint32_t n = 0;
+    uint32_t sent = 0;
+    int disconnected = 0;
+    uint32_t i;
+
+    if (out_sent == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    *out_sent = 0;
+    if (permits == NULL || values == NULL || count == 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    id = permits[0].channel_id;
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        for (i = 0; i < count; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by caller batch count");
+            if (permits[i].channel_id == id) permits[i].consumed = 1;
+        }
+        return st;
+    }
+    if (s->payload != NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    /* Retire the permits in order; each live token admits one value,
+     * staged into runs of up to CHAN_RUN committed at once. */
+    for (i = 0; i < count; i++) {
+        asx_send_permit *p = &permits[i];
+        ASX_CHECKPOINT_WAIVER("bounded by caller batch count");
+        if (p->channel_id != id) {
+            if (first == ASX_OK) first = ASX_E_INVALID_ARGUMENT;
+            continue;
+        }
+        if (p->consumed) {
+            if (first == ASX_OK) first = ASX_E_INVALID_STATE;
+            continue;
+        }
+        p->consumed = 1;
+        if (channel_token_consume(s, p->token) != ASX_OK) {
+            if (first == ASX_OK) first = ASX_E_INVALID_STATE;
+            continue;
+        }
+        run[n++] = values[i];
+        if (n == CHAN_RUN) {
+            if (channel_commit_run(s, run, n) == ASX_OK) sent += n;
+            else disconnected = 1;
+            n = 0;
+        }
+    }
+    if (n > 0u) {
+        if (channel_commit_run(s, run, n) == ASX_OK) sent += n;
+        else disconnected = 1;
+    }
+
+    *out_sent = sent;
+    if (sent > 0u) {
+        channel_wake(id);
+    }
+    return disconnected ? ASX_E_DISCONNECTED : first;
+}
+
 /* ------------------------------------------------------------------ */
 /* Two-phase send: abort (return capacity)                            */
 /* ------------------------------------------------------------------ */
@@ -432,7 +1349,10 @@ void asx_send_permit_abort(asx_send_permit *permit)
         return;
     }
 
-    (void)channel_token_consume(s, permit->token);
+    if (channel_token_consume(s, permit->token) == ASX_OK) {
+        chan_sub(&s->claimed, 1u);
+        channel_wake(permit->channel_id);
+    }
 }
 
 /* ------------------------------------------------------------------ */
@@ -452,11 +1372,356 @@ asx_status asx_channel_try_recv(asx_channel_id id, uint64_t *out_value)
     if (st != ASX_OK) {
         return st;
     }
+    if (s->payload != NULL || s->broadcast) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    if (channel_dequeue(s, out_value, 1u, 1) != 0u) {
+        channel_wake(id);
+        return ASX_OK;
+    }
+
+    if (s->state == ASX_CHANNEL_SENDER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        return ASX_E_DISCONNECTED;
+    }
+
+    return ASX_E_WOULD_BLOCK;
+}
+
+asx_status asx_channel_try_recv_many(asx_channel_id id,
+                                      uint64_t *out_values,
+                                      uint32_t max,
+                                      uint32_t *out_count)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint32_t n;
+
+    if (out_count == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    *out_count = 0;
+    if (out_values == NULL || max == 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (s->payload != NULL || s->broadcast) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    /* One lookup and one wake for the whole run */
+    n = channel_dequeue(s, out_values, max, 1);
+    if (n != 0u) {
+        *out_count = n;
+        channel_wake(id);
+        return ASX_OK;
+    }
+
+    if (s->state == ASX_CHANNEL_SENDER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        return ASX_E_DISCONNECTED;
+    }
+
+    return ASX_E_WOULD_BLOCK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Payload channels: in-place reserve, commit, borrowed receive       */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_channel_try_reserve_slot(asx_channel_id id,
+                                         asx_send_permit *out,
+                                         void **out_data)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint32_t token;
+
+    if (out == NULL || out_data == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (s->payload == NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    if (s->state == ASX_CHANNEL_SENDER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    if (s->state == ASX_CHANNEL_RECEIVER_CLOSED) {
+        return ASX_E_DISCONNECTED;
+    }
+
+    if (channel_reserve_claim(s, 1u, 1u) == 0u) {
+        return channel_refusal(s, id, 1u);
+    }
+
+    token = channel_token_allocate(s);
+    if (token == 0u) {
+        chan_sub(&s->claimed, 1u);
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    out->channel_id = id;
+    out->token = token;
+    out->consumed = 0;
+    *out_data = channel_buffer(s, token);
+    return ASX_OK;
+}
+
+asx_status asx_send_permit_commit(asx_send_permit *permit)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint64_t committed;
+
+    if (permit == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (permit->consumed) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    st = channel_slot_lookup(permit->channel_id, &s);
+    if (st != ASX_OK) {
+        permit->consumed = 1;
+        return st;
+    }
+    if (s->payload == NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    st = channel_token_commit(s, permit->token);
+    permit->consumed = 1;
+    if (st != ASX_OK) {
+        return st;
+    }
+    committed = permit->token | CHAN_TOKEN_COMMITTED;
+
+    if (s->state == ASX_CHANNEL_RECEIVER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        (void)channel_buffer_release(s, (uint32_t)committed);
+        return ASX_E_DISCONNECTED;
+    }
+
+    /* The buffer was written in place; only its token is queued */
+    channel_enqueue(s, 0u, &committed, 1u);
+
+    channel_wake(permit->channel_id);
+    return ASX_OK;
+}
+
+asx_status asx_channel_try_recv_view(asx_channel_id id, asx_recv_view *out)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint64_t committed;
+
+    if (out == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (s->payload == NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    if (channel_dequeue(s, &committed, 1u, 1) != 0u) {
+        out->channel_id = id;
+        out->data = channel_buffer(s, (uint32_t)committed);
+        out->size = s->element_size;
+        out->token = (uint32_t)committed;
+        out->released = 0;
+        return ASX_OK;
+    }
+
+    if (s->state == ASX_CHANNEL_SENDER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        return ASX_E_DISCONNECTED;
+    }
+
+    return ASX_E_WOULD_BLOCK;
+}
+
+asx_status asx_recv_view_release(asx_recv_view *view)
+{
+    asx_channel_slot *s;
+    asx_status st;
+
+    if (view == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (view->released) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    view->released = 1;
+    view->data = NULL;
+
+    st = channel_slot_lookup(view->channel_id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    st = channel_buffer_release(s, view->token);
+    if (st != ASX_OK) {
+        return st;
+    }
+    chan_sub(&s->lent, 1u);
+
+    /* Capacity came back */
+    channel_wake(view->channel_id);
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Broadcast channels: subscribers with independent cursors           */
+/* ------------------------------------------------------------------ */
+
+static asx_status channel_subscriber_lookup(const asx_broadcast_receiver *rx,
+                                            asx_channel_slot **out_s,
+                                            asx_channel_subscriber **out_sub)
+{
+    asx_channel_slot *s;
+    asx_channel_subscriber *sub;
+    asx_status st;
+    uint32_t idx;
+
+    st = channel_slot_lookup(rx->channel_id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (!s->broadcast) {
+        return ASX_E_INVALID_STATE;
+    }
+    idx = chan_token_slot(rx->token);
+    if (idx >= ASX_CHANNEL_MAX_SUBSCRIBERS) {
+        return ASX_E_INVALID_STATE;
+    }
+    sub = &s->subs[idx];
+    if (!sub->active || sub->generation != chan_token_generation(rx->token)) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    *out_s = s;
+    *out_sub = sub;
+    return ASX_OK;
+}
+
+asx_status asx_broadcast_subscribe(asx_channel_id id,
+                                    asx_broadcast_receiver *out)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint16_t i;
+
+    if (out == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (!s->broadcast ||
+        s->state == ASX_CHANNEL_RECEIVER_CLOSED ||
+        s->state == ASX_CHANNEL_FULLY_CLOSED) {
+        return ASX_E_INVALID_STATE;
+    }
 
-    if (s->queue_len > 0) {
-        *out_value = s->queue[s->queue_head];
-        s->queue_head = (s->queue_head + 1u) % s->capacity;
-        s->queue_len--;
+    for (i = 0; i < ASX_CHANNEL_MAX_SUBSCRIBERS; i++) {
+        asx_channel_subscriber *sub = &s->subs[i];
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_CHANNEL_MAX_SUBSCRIBERS");
+        if (sub->active) continue;
+
+        /* Sees only messages committed from now on */
+        sub->generation = (uint16_t)(sub->generation + 1u);
+        if (sub->generation == 0u) sub->generation = 1u;
+        sub->cursor = s->enqueue_pos[0];
+        sub->active = 1;
+        sub->receives = 0;
+        sub->wait_total_ns = 0;
+        sub->wait_max_ns = 0;
+        s->subscribers++;
+
+        out->channel_id = id;
+        out->token = chan_token_pack(sub->generation, i);
+        return ASX_OK;
+    }
+
+    return ASX_E_RESOURCE_EXHAUSTED;
+}
+
+asx_status asx_broadcast_unsubscribe(asx_broadcast_receiver *rx)
+{
+    asx_channel_slot *s;
+    asx_channel_subscriber *sub;
+    asx_status st;
+
+    if (rx == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_subscriber_lookup(rx, &s, &sub);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    /* Unread messages stop waiting for this subscriber */
+    channel_subscriber_drain(s, sub);
+    channel_subscriber_retire_stats(s, sub);
+    sub->active = 0;
+    s->subscribers--;
+    rx->token = 0u;
+
+    channel_wake(rx->channel_id);
+    return ASX_OK;
+}
+
+asx_status asx_broadcast_try_recv(const asx_broadcast_receiver *rx,
+                                   uint64_t *out_value)
+{
+    asx_channel_slot *s;
+    asx_channel_subscriber *sub;
+    asx_channel_cell *cell;
+    asx_status st;
+    uint32_t pos;
+
+    if (rx == NULL || out_value == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = channel_subscriber_lookup(rx, &s, &sub);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    pos = sub->cursor;
+    cell = &s->cells[pos & s->ring_mask];
+    if (chan_load(&cell->seq) == pos + 1u) {
+        *out_value = cell->value;
+        sub->cursor = pos + 1u;
+        if (CHAN_TRACKED(s)) {
+            channel_stats_received(s, pos & s->ring_mask, channel_now(), &sub->receives,
+                                   &sub->wait_total_ns, &sub->wait_max_ns);
+        }
+        if (channel_cell_pass(s, pos)) {
+            /* Slowest subscriber moved: capacity came back */
+            channel_wake(rx->channel_id);
+        }
         return ASX_OK;
     }
 
@@ -468,6 +1733,52 @@ asx_status asx_channel_try_recv(asx_channel_id id, uint64_t *out_value)
     return ASX_E_WOULD_BLOCK;
 }
 
+/* ------------------------------------------------------------------ */
+/* Region teardown                                                    */
+/* ------------------------------------------------------------------ */
+
+void asx_channel_region_reclaim(asx_region_id region, uint32_t *head)
+{
+    uint32_t idx = *head;
+
+    /* Newest channel first, like the region's cleanup stack */
+    while (idx != ASX_CHANNEL_LINK_NONE) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_CHANNELS") */
+        asx_channel_slot *s = &g_channels[idx];
+        asx_channel_id id = channel_make_handle(idx, s->generation);
+        uint32_t next = s->region_next;
+
+        s->region_next = ASX_CHANNEL_LINK_NONE;
+        if (s->alive && s->region == region) {
+            if (s->state != ASX_CHANNEL_RECEIVER_CLOSED &&
+                s->state != ASX_CHANNEL_FULLY_CLOSED) {
+                channel_discard(s);
+            }
+            channel_storage_release(s);
+            s->state = ASX_CHANNEL_FULLY_CLOSED;
+            s->alive = 0;
+            s->generation = asx_generation_next(s->generation);
+            g_channel_count--;
+            /* Waiters elsewhere re-check and see the handle is gone */
+            channel_wake(id);
+        }
+        idx = next;
+    }
+    *head = ASX_CHANNEL_LINK_NONE;
+}
+
+void asx_channel_region_admission(const asx_region_slot *region)
+{
+    uint32_t idx;
+
+    for (idx = region->channel_head; idx != ASX_CHANNEL_LINK_NONE;
+         idx = g_channels[idx].region_next) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_CHANNELS");
+        if (g_channels[idx].alive) {
+            channel_admission_set(&g_channels[idx], region);
+        }
+    }
+}
+
 /* ------------------------------------------------------------------ */
 /* Reset (test support)                                               */
 /* ------------------------------------------------------------------ */
@@ -477,17 +1788,25 @@ void asx_channel_reset(void)
     uint16_t i;
 
     for (i = 0; i < ASX_MAX_CHANNELS; i++) {
+        /* Never opened since the last reset: nothing to clear */
+        if (g_channels[i].capacity == 0u) continue;
         if (g_channels[i].alive) {
-            g_channels[i].generation++;
+            g_channels[i].generation = asx_generation_next(g_channels[i].generation);
         }
+        channel_storage_release(&g_channels[i]);
         g_channels[i].alive      = 0;
+        g_channels[i].region_next = ASX_CHANNEL_LINK_NONE;
         g_channels[i].state      = ASX_CHANNEL_OPEN;
-        g_channels[i].queue_head = 0;
-        g_channels[i].queue_len  = 0;
-        g_channels[i].reserved   = 0;
-        g_channels[i].next_token = 1;
-        memset(g_channels[i].queue, 0, sizeof(g_channels[i].queue));
-        memset(g_channels[i].permit_tokens, 0, sizeof(g_channels[i].permit_tokens));
+        g_channels[i].capacity   = 0;
+        g_channels[i].payload    = NULL;
+        g_channels[i].element_size = 0;
+        g_channels[i].stride     = 0;
+        g_channels[i].broadcast  = 0;
+        g_channels[i].heap       = NULL;
+        g_channels[i].cells      = NULL;
+        g_channels[i].permit_token = NULL;
+        g_channels[i].permit_free  = NULL;
+        g_channels[i].permit_gen   = NULL;
     }
     g_channel_count = 0;
 }
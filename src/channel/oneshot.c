@@ -0,0 +1,257 @@
+/*
+ * oneshot.c — single-value cells sent through an obligation
+ *
+ * A fixed pool of ASX_MAX_ONESHOTS cells. Free cells wait on a LIFO
+ * free list behind a never-used cursor, as the lifecycle arenas do, so
+ * create and free never scan. A live cell sits on its region's
+ * doubly-linked oneshot list, so the receiver frees it in O(1) and
+ * region close reclaims whatever was never received.
+ *
+ * The sender obligation's slot holds the cell index while it is
+ * reserved; commit and abort report the outcome here through
+ * asx_oneshot_resolved before the obligation wakes its parked tasks,
+ * so a woken receiver always finds the cell resolved.
+ *
+ * Cell states:
+ *
+ *   PENDING   --commit-->  SENT       --try_recv--> free
+ *   PENDING   --abort--->  CANCELLED  --try_recv--> free
+ *   PENDING   --drop---->  DROPPED    --resolve---> free
+ *   SENT / CANCELLED       --drop---->  free
+ *
+ * Handles encode [generation:16 | cell:16]; a cell's generation
+ * advances when it is freed, so a stale oneshot can never match.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/core/channel.h>
+#include "../runtime/runtime_internal.h"
+#include "../runtime/context_internal.h"
+
+typedef enum {
+    ONESHOT_FREE      = 0,
+    ONESHOT_PENDING   = 1,
+    ONESHOT_SENT      = 2,
+    ONESHOT_CANCELLED = 3,
+    ONESHOT_DROPPED   = 4   /* receiver gone, sender still reserved */
+} oneshot_state;
+
+typedef struct {
+    uint64_t       value;
+    asx_region_id  region;
+    uint32_t       prev;         /* region list links */
+    uint32_t       next;         /* doubles as the free-list link */
+    uint16_t       generation;
+    uint8_t        state;        /* oneshot_state */
+} asx_oneshot_cell;
+
+static asx_oneshot_cell g_oneshot_cells[ASX_MAX_ONESHOTS];
+static uint32_t         g_oneshot_count;     /* never-used cursor */
+static uint32_t         g_oneshot_free_head = ASX_ONESHOT_LINK_NONE;
+
+static const uint32_t g_oneshot_link_none = ASX_ONESHOT_LINK_NONE;
+static const asx_context_block g_oneshot_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_oneshot_cells),
+    ASX_CONTEXT_BLOCK(g_oneshot_count),
+    ASX_CONTEXT_BLOCK_INIT(g_oneshot_free_head, g_oneshot_link_none)
+};
+
+const asx_context_module asx_oneshot_context = ASX_CONTEXT_MODULE(g_oneshot_blocks);
+
+/* ------------------------------------------------------------------ */
+/* Internal helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+static uint32_t oneshot_token(uint32_t idx)
+{
+    return ((uint32_t)g_oneshot_cells[idx].generation << 16) | idx;
+}
+
+/* The live cell os names, or NULL */
+static asx_oneshot_cell *oneshot_lookup(const asx_oneshot *os)
+{
+    uint32_t idx;
+
+    if (os == NULL) return NULL;
+    idx = os->token & 0xFFFFu;
+    if (idx >= g_oneshot_count) return NULL;
+    if (g_oneshot_cells[idx].state == ONESHOT_FREE) return NULL;
+    if (os->token != oneshot_token(idx)) return NULL;
+    return &g_oneshot_cells[idx];
+}
+
+static void oneshot_unlink(uint32_t *head, asx_oneshot_cell *c)
+{
+    if (c->prev != ASX_ONESHOT_LINK_NONE) {
+        g_oneshot_cells[c->prev].next = c->next;
+    } else {
+        *head = c->next;
+    }
+    if (c->next != ASX_ONESHOT_LINK_NONE) {
+        g_oneshot_cells[c->next].prev = c->prev;
+    }
+}
+
+static void oneshot_release(asx_oneshot_cell *c)
+{
+    c->state = ONESHOT_FREE;
+    c->generation = (uint16_t)(c->generation + 1u);
+    c->prev = ASX_ONESHOT_LINK_NONE;
+    c->next = g_oneshot_free_head;
+    g_oneshot_free_head = (uint32_t)(c - g_oneshot_cells);
+}
+
+/* Take c off its region's list and free it. The region is open: it
+ * closes only after reclaiming every cell on its list. */
+static void oneshot_free(asx_oneshot_cell *c)
+{
+    asx_region_slot *r;
+
+    if (asx_region_slot_lookup(c->region, &r) == ASX_OK) {
+        oneshot_unlink(&r->oneshot_head, c);
+    }
+    oneshot_release(c);
+}
+
+/* ------------------------------------------------------------------ */
+/* Oneshot API                                                        */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_oneshot_create(asx_region_id region, asx_oneshot *out)
+{
+    asx_obligation_id sender;
+    asx_obligation_slot *o;
+    asx_region_slot *r;
+    asx_oneshot_cell *c;
+    uint32_t idx;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->sender = ASX_INVALID_ID;
+    out->token = 0;
+    if (g_oneshot_free_head == ASX_ONESHOT_LINK_NONE &&
+        g_oneshot_count >= ASX_MAX_ONESHOTS) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+
+    st = asx_obligation_reserve(region, &sender);
+    if (st != ASX_OK) return st;
+    /* Both just succeeded for these handles */
+    st = asx_obligation_slot_lookup(sender, &o);
+    if (st != ASX_OK) return st;
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+
+    if (g_oneshot_free_head != ASX_ONESHOT_LINK_NONE) {
+        idx = g_oneshot_free_head;
+        g_oneshot_free_head = g_oneshot_cells[idx].next;
+    } else {
+        idx = g_oneshot_count++;
+    }
+    c = &g_oneshot_cells[idx];
+    c->value = 0;
+    c->region = region;
+    c->state = ONESHOT_PENDING;
+    c->prev = ASX_ONESHOT_LINK_NONE;
+    c->next = r->oneshot_head;
+    if (r->oneshot_head != ASX_ONESHOT_LINK_NONE) {
+        g_oneshot_cells[r->oneshot_head].prev = idx;
+    }
+    r->oneshot_head = idx;
+    o->link = idx;
+
+    out->sender = sender;
+    out->token = oneshot_token(idx);
+    return ASX_OK;
+}
+
+asx_status asx_oneshot_send(const asx_oneshot *os, uint64_t value)
+{
+    asx_oneshot_cell *c;
+
+    if (os == NULL) return ASX_E_INVALID_ARGUMENT;
+    c = oneshot_lookup(os);
+    if (c == NULL) return ASX_E_INVALID_STATE;
+    if (c->state != ONESHOT_PENDING && c->state != ONESHOT_DROPPED) {
+        return ASX_E_INVALID_TRANSITION;
+    }
+    c->value = value;
+    return asx_obligation_commit(os->sender);
+}
+
+asx_status asx_oneshot_try_recv(const asx_oneshot *os, uint64_t *out_value)
+{
+    asx_oneshot_cell *c;
+
+    if (os == NULL || out_value == NULL) return ASX_E_INVALID_ARGUMENT;
+    c = oneshot_lookup(os);
+    if (c == NULL || c->state == ONESHOT_DROPPED) return ASX_E_INVALID_STATE;
+    if (c->state == ONESHOT_PENDING) return ASX_E_WOULD_BLOCK;
+    if (c->state == ONESHOT_CANCELLED) {
+        oneshot_free(c);
+        return ASX_E_DISCONNECTED;
+    }
+    *out_value = c->value;
+    oneshot_free(c);
+    return ASX_OK;
+}
+
+asx_status asx_oneshot_drop(const asx_oneshot *os)
+{
+    asx_oneshot_cell *c;
+
+    if (os == NULL) return ASX_E_INVALID_ARGUMENT;
+    c = oneshot_lookup(os);
+    if (c == NULL || c->state == ONESHOT_DROPPED) return ASX_E_INVALID_STATE;
+    if (c->state == ONESHOT_PENDING) {
+        c->state = ONESHOT_DROPPED;
+    } else {
+        oneshot_free(c);
+    }
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Runtime integration                                                */
+/* ------------------------------------------------------------------ */
+
+void asx_oneshot_resolved(uint32_t cell, int committed)
+{
+    asx_oneshot_cell *c = &g_oneshot_cells[cell];
+
+    if (c->state == ONESHOT_DROPPED) {
+        oneshot_free(c);
+    } else {
+        c->state = committed ? ONESHOT_SENT : ONESHOT_CANCELLED;
+    }
+}
+
+void asx_oneshot_region_reclaim(uint32_t *head)
+{
+    uint32_t idx = *head;
+
+    while (idx != ASX_ONESHOT_LINK_NONE) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_ONESHOTS") */
+        uint32_t next = g_oneshot_cells[idx].next;
+
+        oneshot_release(&g_oneshot_cells[idx]);
+        idx = next;
+    }
+    *head = ASX_ONESHOT_LINK_NONE;
+}
+
+void asx_oneshot_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_oneshot_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_ONESHOTS");
+        /* Keep generations so handles from before the reset stay stale */
+        g_oneshot_cells[i].state = ONESHOT_FREE;
+        g_oneshot_cells[i].generation = (uint16_t)(g_oneshot_cells[i].generation + 1u);
+        g_oneshot_cells[i].next = (i + 1u < g_oneshot_count) ? i + 1u
+                                                             : ASX_ONESHOT_LINK_NONE;
+    }
+    g_oneshot_free_head = g_oneshot_count != 0u ? 0u : ASX_ONESHOT_LINK_NONE;
+}
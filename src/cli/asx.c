@@ -0,0 +1,933 @@
+/*
+ * asx.c — asx command-line tool
+ *
+ * Field-triage front end over the runtime API:
+ *
+ *   asx run          --scenario F [--seed N]
+ *   asx trace export --scenario F --out F [--format bin|json] [--seed N]
+ *   asx digest       F
+ *   asx replay       --trace F --scenario F [--seed N] [--verify-digest]
+ *                    [--diff]
+ *   asx conformance  --fixtures DIR [--jobs N] [--cache F]
+ *
+ * Scenarios are dsl-v1 JSON (docs/SCENARIO_DSL.md) run in process by
+ * asx_scenario_run; --seed overrides the scenario's own. Each process
+ * runs one scenario, so a trace is exported from the run that makes it.
+ *
+ * Binary traces are never loaded: digest maps the file and chains
+ * asx_trace_chunk_verify across its v1 chunks, one ring of events on
+ * the stack at a time, and replay hands the mapping to
+ * asx_replay_map_reference. Export streams each full ring to the file
+ * through asx_platform_trace_file_sink, so neither side is bounded by
+ * ASX_TRACE_CAPACITY; files are bounded by the 4 GiB mapping limit.
+ * Compact (v2) traces are single chunks and replay through
+ * asx_trace_import_binary. JSON export holds the events still in the
+ * ring and is for reading only.
+ *
+ * replay --diff loads the reference (one ring at most) instead of
+ * mapping it and, on a mismatch, prints each divergent window of the
+ * asx_replay_diff alignment, so a run that realigns after an extra
+ * event shows where it went off and where it came back.
+ *
+ * conformance runs every fixture-v1 file under DIR in process:
+ * decode, validate, compile its input and run it at its seed. Runtime
+ * contexts are process-wide rather than per thread, so the corpus is
+ * sharded round-robin across forked workers, each with its own runtime
+ * and codec arena, writing verdicts into shared result slots. The
+ * parent reports one JSON line per fixture in path order, then a
+ * summary whose digest folds every fixture's trace digest, so the
+ * report is the same for any --jobs. With --cache F, verdicts and
+ * digests are kept in F keyed by each fixture's semantic key; a later
+ * run of the same executable and profile only compiles and runs the
+ * fixtures whose key is new.
+ *
+ * Exit status: 0 success, 1 mismatch or failed run, 2 usage or I/O.
+ *
+ * Build:  make cli PROFILE=POSIX
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#if defined(__linux__)
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <asx/asx.h>
+#include <asx/codec/codec.h>
+#include <asx/codec/equivalence.h>
+#include <asx/runtime/profile_compat.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/scenario.h>
+
+#define CLI_MAX_OPS 4096u
+#define CLI_MAX_JOBS 64u
+#define CLI_ARENA_BYTES (1u << 20)
+#define CLI_FNV_PRIME 0x100000001b3ULL
+#define CLI_DIFF_BAND 256u
+
+#define CLI_OK       0
+#define CLI_MISMATCH 1
+#define CLI_USAGE    2
+
+static asx_scenario_op g_cli_ops[CLI_MAX_OPS];
+static uint32_t g_cli_diff_work[ASX_TRACE_DIFF_WORK_WORDS(CLI_DIFF_BAND)];
+
+typedef struct {
+    const char *scenario;
+    const char *trace;
+    const char *out;
+    const char *format;
+    const char *fixtures;
+    const char *cache;
+    uint32_t    jobs;
+    uint64_t    seed;
+    int         has_seed;
+    int         verify_digest;
+    int         diff;
+} cli_args;
+
+static void cli_usage(void)
+{
+    fprintf(stderr,
+        "usage: asx run --scenario F [--seed N]\n"
+        "       asx trace export --scenario F --out F [--format bin|json] [--seed N]\n"
+        "       asx digest F\n"
+        "       asx replay --trace F --scenario F [--seed N] [--verify-digest] [--diff]\n"
+        "       asx conformance --fixtures DIR [--jobs N] [--cache F]\n");
+}
+
+static int cli_fail(const char *what, const char *subject, asx_status st)
+{
+    fprintf(stderr, "asx: %s %s: %s\n", what, subject, asx_status_str(st));
+    return CLI_USAGE;
+}
+
+/* Parse the options after the subcommand; returns 0 on a bad option. */
+static int cli_parse(int argc, char **argv, int first, cli_args *a)
+{
+    int i;
+
+    memset(a, 0, sizeof(*a));
+    a->format = "bin";
+    for (i = first; i < argc; i++) {
+        const char *opt = argv[i];
+        char *end;
+
+        if (strcmp(opt, "--verify-digest") == 0) {
+            a->verify_digest = 1;
+            continue;
+        }
+        if (strcmp(opt, "--diff") == 0) {
+            a->diff = 1;
+            continue;
+        }
+        if (i + 1 >= argc) break;
+        if (strcmp(opt, "--scenario") == 0) {
+            a->scenario = argv[++i];
+        } else if (strcmp(opt, "--trace") == 0) {
+            a->trace = argv[++i];
+        } else if (strcmp(opt, "--out") == 0) {
+            a->out = argv[++i];
+        } else if (strcmp(opt, "--format") == 0) {
+            a->format = argv[++i];
+        } else if (strcmp(opt, "--cache") == 0) {
+            a->cache = argv[++i];
+        } else if (strcmp(opt, "--fixtures") == 0) {
+            a->fixtures = argv[++i];
+        } else if (strcmp(opt, "--jobs") == 0) {
+            unsigned long jobs = strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || jobs == 0 || jobs > CLI_MAX_JOBS) break;
+            a->jobs = (uint32_t)jobs;
+        } else if (strcmp(opt, "--seed") == 0) {
+            a->seed = strtoull(argv[++i], &end, 0);
+            if (*argv[i] == '\0' || *end != '\0') break;
+            a->has_seed = 1;
+        } else {
+            break;
+        }
+    }
+    if (i < argc) {
+        fprintf(stderr, "asx: bad option '%s'\n", argv[i]);
+        return 0;
+    }
+    return 1;
+}
+
+/* Read a whole file as a NUL-terminated string the caller frees. */
+static asx_status cli_read_file(const char *path, char **out)
+{
+    FILE *f;
+    char *text;
+    long size;
+    size_t got;
+
+    f = fopen(path, "rb");
+    if (f == NULL) return ASX_E_NOT_FOUND;
+    if (fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 0 ||
+        fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    text = (char *)malloc((size_t)size + 1u);
+    if (text == NULL) {
+        fclose(f);
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    got = fread(text, 1, (size_t)size, f);
+    fclose(f);
+    text[got] = '\0';
+    *out = text;
+    return ASX_OK;
+}
+
+/* Read a scenario file and compile it into g_cli_ops. */
+static int cli_load_scenario(const cli_args *a, asx_scenario_program *program)
+{
+    char *text;
+    asx_status st;
+
+    if (a->scenario == NULL) {
+        fprintf(stderr, "asx: --scenario is required\n");
+        return CLI_USAGE;
+    }
+    st = cli_read_file(a->scenario, &text);
+    if (st != ASX_OK) return cli_fail("cannot read", a->scenario, st);
+
+    asx_scenario_program_init(program, g_cli_ops, CLI_MAX_OPS);
+    st = asx_scenario_compile(program, text);
+    free(text);
+    if (st != ASX_OK) return cli_fail("cannot compile", a->scenario, st);
+    if (a->has_seed) program->seed = a->seed;
+    return CLI_OK;
+}
+
+/* Run program from a fresh trace and report how it went. */
+static int cli_run_program(const asx_scenario_program *program)
+{
+    asx_scenario_result result;
+    asx_status st;
+
+    asx_trace_reset();
+    st = asx_scenario_run(program, &result);
+    if (st == ASX_E_REPLAY_MISMATCH) {
+        fprintf(stderr, "asx: op %" PRIu32 " returned %s, expected %s\n",
+                result.failed_id, asx_status_str(result.actual),
+                asx_status_str(result.expected));
+        return CLI_MISMATCH;
+    }
+    if (st != ASX_OK) return cli_fail("cannot run", "scenario", st);
+    fprintf(stderr, "asx: %" PRIu32 " ops, %" PRIu32 " errors\n",
+            result.executed, result.error_count);
+    return CLI_OK;
+}
+
+/* Drops chunks, so a plain run digests past the ring like an export */
+static asx_status cli_discard_sink(void *ctx, const uint8_t *chunk, uint32_t len)
+{
+    (void)ctx;
+    (void)chunk;
+    (void)len;
+    return ASX_OK;
+}
+
+static int cmd_run(const cli_args *a)
+{
+    asx_scenario_program program;
+    int rc = cli_load_scenario(a, &program);
+
+    if (rc != CLI_OK) return rc;
+    asx_trace_set_sink(cli_discard_sink, NULL);
+    rc = cli_run_program(&program);
+    asx_trace_set_sink(NULL, NULL);
+    if (rc != CLI_OK) return rc;
+    printf("0x%016" PRIx64 "\n", asx_trace_digest());
+    return CLI_OK;
+}
+
+static int cmd_trace_export(const cli_args *a)
+{
+    asx_scenario_program program;
+    FILE *f;
+    asx_status st = ASX_OK;
+    int json;
+    int rc;
+
+    json = strcmp(a->format, "json") == 0;
+    if (!json && strcmp(a->format, "bin") != 0) {
+        fprintf(stderr, "asx: --format is bin or json\n");
+        return CLI_USAGE;
+    }
+    if (a->out == NULL) {
+        fprintf(stderr, "asx: --out is required\n");
+        return CLI_USAGE;
+    }
+    rc = cli_load_scenario(a, &program);
+    if (rc != CLI_OK) return rc;
+
+    f = fopen(a->out, "wb");
+    if (f == NULL) return cli_fail("cannot create", a->out, ASX_E_NOT_FOUND);
+
+    /* Binary: every full ring goes to the file as it fills */
+    if (!json) asx_trace_set_sink(asx_platform_trace_file_sink, f);
+    rc = cli_run_program(&program);
+    if (rc == CLI_OK) {
+        st = json ? asx_trace_export_json_sink(asx_platform_trace_file_sink, f)
+                  : asx_trace_flush();
+    }
+    asx_trace_set_sink(NULL, NULL);
+    if (fclose(f) != 0 && st == ASX_OK) st = ASX_E_RESOURCE_EXHAUSTED;
+    if (rc != CLI_OK) return rc;
+    if (st != ASX_OK) return cli_fail("cannot write", a->out, st);
+    return CLI_OK;
+}
+
+/* Length of the chunk at p, at most left; verify rejects a short one */
+static uint32_t cli_chunk_len(const uint8_t *p, uint32_t left)
+{
+    uint32_t word;
+    uint32_t count;
+    uint64_t len;
+
+    if (left < ASX_TRACE_BINARY_HEADER) return left;
+    word  = (uint32_t)p[4] | (uint32_t)p[5] << 8 |
+            (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24;
+    count = (uint32_t)p[8] | (uint32_t)p[9] << 8 |
+            (uint32_t)p[10] << 16 | (uint32_t)p[11] << 24;
+    if ((word & ASX_TRACE_BINARY_VERSION_MASK) != ASX_TRACE_BINARY_VERSION) {
+        return left;  /* compact: one chunk, verify rejects anything else */
+    }
+    len = ASX_TRACE_BINARY_HEADER + (uint64_t)count * ASX_TRACE_BINARY_EVENT;
+    if (word & ASX_TRACE_BINARY_FLAG_TIMES) len += (uint64_t)count * 4u;
+    return len > left ? left : (uint32_t)len;
+}
+
+static int cmd_digest(const char *path)
+{
+    const uint8_t *data;
+    uint32_t len;
+    uint32_t off = 0;
+    uint32_t chunks = 0;
+    uint64_t digest;
+    asx_status st;
+
+    st = asx_platform_map_file(path, &data, &len);
+    if (st != ASX_OK) return cli_fail("cannot map", path, st);
+
+    /* The digest of an empty trace is the chain's basis */
+    asx_trace_reset();
+    digest = asx_trace_digest();
+    while (off < len && st == ASX_OK) {
+        uint32_t n = cli_chunk_len(data + off, len - off);
+
+        st = asx_trace_chunk_verify(data + off, n, digest, &digest);
+        off += n;
+        chunks++;
+    }
+    asx_platform_unmap_file(data, len);
+    if (st != ASX_OK) {
+        fprintf(stderr, "asx: %s: chunk %" PRIu32 ": %s\n", path, chunks - 1u,
+                asx_status_str(st));
+        return CLI_MISMATCH;
+    }
+    printf("0x%016" PRIx64 "\n", digest);
+    return CLI_OK;
+}
+
+/* Print the windows where the run left the loaded reference. */
+static void cli_print_diff(void)
+{
+    asx_trace_diff diff;
+    uint32_t shown;
+    uint32_t i;
+
+    if (asx_replay_diff(g_cli_diff_work,
+                        ASX_TRACE_DIFF_WORK_WORDS(CLI_DIFF_BAND),
+                        &diff) != ASX_OK) {
+        return;
+    }
+    printf("%" PRIu32 " window(s), %" PRIu32 " edit(s), %" PRIu32
+           " matched%s\n", diff.window_count, diff.edits, diff.matched,
+           diff.aligned ? "" : ", unaligned past the band");
+    shown = diff.window_count < ASX_TRACE_DIFF_MAX_WINDOWS
+          ? diff.window_count : ASX_TRACE_DIFF_MAX_WINDOWS;
+    for (i = 0; i < shown; i++) {
+        const asx_trace_diff_window *w = &diff.windows[i];
+
+        printf("  reference [%" PRIu32 ", %" PRIu32 ") actual [%" PRIu32
+               ", %" PRIu32 ")\n", w->ref_start, w->ref_start + w->ref_len,
+               w->act_start, w->act_start + w->act_len);
+    }
+}
+
+static int cmd_replay(const cli_args *a)
+{
+    asx_scenario_program program;
+    asx_replay_result result;
+    const uint8_t *data;
+    uint32_t len;
+    uint32_t version;
+    asx_status st;
+    int rc;
+
+    if (a->trace == NULL) {
+        fprintf(stderr, "asx: --trace is required\n");
+        return CLI_USAGE;
+    }
+    rc = cli_load_scenario(a, &program);
+    if (rc != CLI_OK) return rc;
+
+    st = asx_platform_map_file(a->trace, &data, &len);
+    if (st != ASX_OK) return cli_fail("cannot map", a->trace, st);
+    version = len >= 8u ? (uint32_t)data[4] | (uint32_t)data[5] << 8 : 0u;
+    st = version == ASX_TRACE_BINARY_VERSION && !a->diff
+       ? asx_replay_map_reference(data, len)
+       : asx_trace_import_binary(data, len);
+    if (st != ASX_OK) {
+        asx_platform_unmap_file(data, len);
+        return cli_fail("cannot load", a->trace, st);
+    }
+
+    rc = cli_run_program(&program);
+    if (rc == CLI_OK) {
+        result = asx_replay_verify();
+        printf("%s", asx_replay_result_kind_str(result.result));
+        if (result.result != ASX_REPLAY_MATCH &&
+            result.result != ASX_REPLAY_DIGEST_MISMATCH) {
+            printf(" at event %" PRIu32, result.divergence_index);
+        } else if (a->verify_digest) {
+            printf(" expected 0x%016" PRIx64 " actual 0x%016" PRIx64,
+                   result.expected_digest, result.actual_digest);
+        }
+        printf("\n");
+        if (result.result != ASX_REPLAY_MATCH) rc = CLI_MISMATCH;
+        if (a->diff && result.result != ASX_REPLAY_MATCH) cli_print_diff();
+    }
+    asx_replay_clear_reference();
+    asx_platform_unmap_file(data, len);
+    return rc;
+}
+
+/* Where a fixture stopped; CLI_STAGE_DONE is a pass */
+enum {
+    CLI_STAGE_WORKER = 0,  /* never reached: its worker died */
+    CLI_STAGE_READ,
+    CLI_STAGE_DECODE,
+    CLI_STAGE_VALIDATE,
+    CLI_STAGE_COMPILE,
+    CLI_STAGE_RUN,
+    CLI_STAGE_DONE
+};
+
+static const char *const g_cli_stage_names[] = {
+    "worker", "read", "decode", "validate", "compile", "run", "done"
+};
+
+/* One fixture's outcome, written by the worker that ran it */
+typedef struct {
+    uint32_t   stage;
+    asx_status status;         /* ASX_OK, or the failing stage's error */
+    uint32_t   errors;         /* ops that returned non-OK */
+    uint64_t   semantic_hash;
+    uint64_t   trace_digest;
+    uint64_t   key;            /* cache key, when keyed */
+    uint32_t   keyed;
+    uint32_t   cached;         /* verdict came from the cache */
+    char       scenario_id[96];
+    char       profile[40];
+} cli_fixture_result;
+
+typedef struct {
+    char   **paths;
+    uint32_t count;
+    uint32_t cap;
+} cli_paths;
+
+static uint8_t g_cli_arena_mem[CLI_ARENA_BYTES];
+
+/* -------------------------------------------------------------------
+ * Fixture cache
+ *
+ * A sorted array of records behind a header naming the build and
+ * profile they came from, mapped read-only before the workers fork.
+ * A fixture whose semantic key and semantic hash are found takes its
+ * verdict from the record instead of being compiled and run; a header
+ * for another build or profile empties the cache.
+ * ------------------------------------------------------------------- */
+
+#define CLI_CACHE_MAGIC   0x41535863u  /* "ASXc" */
+#define CLI_CACHE_VERSION 1u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t build_hash;     /* of this executable, library included */
+    uint64_t profile_hash;   /* of asx_profile_name(asx_profile_active()) */
+} cli_cache_header;
+
+typedef struct {
+    uint64_t key;            /* of asx_codec_fixture_semantic_key */
+    uint64_t semantic_hash;
+    uint64_t trace_digest;
+    uint32_t stage;
+    asx_status status;
+    uint32_t errors;
+    uint32_t reserved;
+} cli_cache_record;
+
+static struct {
+    int enabled;
+    const uint8_t *data;
+    uint32_t len;
+    const cli_cache_record *records;
+    uint32_t count;
+    uint64_t build_hash;
+    uint64_t profile_hash;
+} g_cli_cache;
+
+static const char *g_cli_exe;
+
+static uint64_t cli_fnv(uint64_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    size_t i;
+
+    for (i = 0; i < len; i++) hash = (hash ^ p[i]) * CLI_FNV_PRIME;
+    return hash;
+}
+
+static int cli_record_cmp(const void *a, const void *b)
+{
+    const cli_cache_record *x = (const cli_cache_record *)a;
+    const cli_cache_record *y = (const cli_cache_record *)b;
+
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->semantic_hash != y->semantic_hash) {
+        return x->semantic_hash < y->semantic_hash ? -1 : 1;
+    }
+    return 0;
+}
+
+static const cli_cache_record *cli_cache_find(const cli_cache_record *records,
+                                              uint32_t count,
+                                              uint64_t key,
+                                              uint64_t semantic_hash)
+{
+    cli_cache_record probe;
+
+    if (count == 0) return NULL;
+    memset(&probe, 0, sizeof(probe));
+    probe.key = key;
+    probe.semantic_hash = semantic_hash;
+    return (const cli_cache_record *)bsearch(&probe, records, count,
+                                             sizeof(*records), cli_record_cmp);
+}
+
+/* Key the cache to this build and map path, if it is a cache for it. */
+static asx_status cli_cache_open(const char *path)
+{
+    const uint8_t *exe;
+    uint32_t exe_len;
+    const char *profile = asx_profile_name(asx_profile_active());
+    const cli_cache_header *h;
+    asx_status st;
+
+    /* The executable links the library statically: its bytes are the build */
+    st = asx_platform_map_file("/proc/self/exe", &exe, &exe_len);
+    if (st != ASX_OK) st = asx_platform_map_file(g_cli_exe, &exe, &exe_len);
+    if (st != ASX_OK) return st;
+    g_cli_cache.build_hash = cli_fnv(0xcbf29ce484222325ULL, exe, exe_len);
+    asx_platform_unmap_file(exe, exe_len);
+    g_cli_cache.profile_hash = cli_fnv(0xcbf29ce484222325ULL, profile,
+                                       strlen(profile));
+    g_cli_cache.enabled = 1;
+
+    if (asx_platform_map_file(path, &g_cli_cache.data, &g_cli_cache.len) != ASX_OK) {
+        return ASX_OK;  /* none yet */
+    }
+    h = (const cli_cache_header *)(const void *)g_cli_cache.data;
+    if (g_cli_cache.len >= sizeof(*h) &&
+        h->magic == CLI_CACHE_MAGIC && h->version == CLI_CACHE_VERSION &&
+        h->build_hash == g_cli_cache.build_hash &&
+        h->profile_hash == g_cli_cache.profile_hash &&
+        g_cli_cache.len == sizeof(*h) + (uint64_t)h->count * sizeof(cli_cache_record)) {
+        g_cli_cache.records = (const cli_cache_record *)(const void *)(h + 1);
+        g_cli_cache.count = h->count;
+    }
+    return ASX_OK;
+}
+
+static void cli_cache_close(void)
+{
+    asx_platform_unmap_file(g_cli_cache.data, g_cli_cache.len);
+    memset(&g_cli_cache, 0, sizeof(g_cli_cache));
+}
+
+/* Add every *.json under dir to list; returns 0 if dir cannot be read. */
+static int cli_collect(const char *dir, cli_paths *list)
+{
+    DIR *d = opendir(dir);
+    struct dirent *ent;
+
+    if (d == NULL) return 0;
+    while ((ent = readdir(d)) != NULL) {
+        const char *name = ent->d_name;
+        size_t n = strlen(name);
+        char *path;
+
+        if (name[0] == '.') continue;
+        path = (char *)malloc(strlen(dir) + n + 2u);
+        if (path == NULL) break;
+        sprintf(path, "%s/%s", dir, name);
+        if (cli_collect(path, list) || n < 5u ||
+            strcmp(name + n - 5u, ".json") != 0) {
+            free(path);
+            continue;
+        }
+        if (list->count == list->cap) {
+            uint32_t cap = list->cap != 0 ? list->cap * 2u : 64u;
+            char **grown = (char **)realloc(list->paths, cap * sizeof(char *));
+            if (grown == NULL) {
+                free(path);
+                break;
+            }
+            list->paths = grown;
+            list->cap = cap;
+        }
+        list->paths[list->count++] = path;
+    }
+    closedir(d);
+    return 1;
+}
+
+static int cli_path_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+static void cli_copy_field(char *dst, size_t cap, const char *src)
+{
+    size_t n = src != NULL ? strlen(src) : 0u;
+
+    if (n >= cap) n = cap - 1u;
+    if (n != 0) memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+/* Decode, validate, compile and run the fixture at path into r. */
+static void cli_run_fixture(const char *path, asx_codec_arena *arena,
+                            cli_fixture_result *r)
+{
+    asx_canonical_fixture fx;
+    asx_scenario_program program;
+    asx_scenario_result res;
+    const cli_cache_record *hit = NULL;
+    char *text;
+
+    r->stage = CLI_STAGE_READ;
+    r->status = cli_read_file(path, &text);
+    if (r->status != ASX_OK) return;
+
+    asx_codec_arena_reset(arena);
+    asx_canonical_fixture_init(&fx);
+    r->stage = CLI_STAGE_DECODE;
+    r->status = asx_codec_decode_fixture_json(text, &fx);
+    free(text);
+    if (r->status == ASX_OK) {
+        cli_copy_field(r->scenario_id, sizeof(r->scenario_id), fx.scenario_id);
+        cli_copy_field(r->profile, sizeof(r->profile), fx.profile);
+        r->status = asx_codec_fixture_semantic_hash(&fx, &r->semantic_hash);
+    }
+    if (r->status == ASX_OK && g_cli_cache.enabled) {
+        asx_codec_buffer key;
+
+        asx_codec_buffer_init(&key);
+        r->status = asx_codec_fixture_semantic_key(&fx, &key);
+        if (r->status == ASX_OK) {
+            r->key = cli_fnv(0xcbf29ce484222325ULL, key.data, key.len);
+            r->keyed = 1;
+            hit = cli_cache_find(g_cli_cache.records, g_cli_cache.count,
+                                 r->key, r->semantic_hash);
+        }
+        asx_codec_buffer_reset(&key);
+    }
+    if (hit != NULL) {
+        r->stage = hit->stage;
+        r->status = hit->status;
+        r->errors = hit->errors;
+        r->trace_digest = hit->trace_digest;
+        r->cached = 1;
+        asx_canonical_fixture_reset(&fx);
+        return;
+    }
+    if (r->status == ASX_OK) {
+        r->stage = CLI_STAGE_VALIDATE;
+        r->status = asx_canonical_fixture_validate(&fx);
+    }
+    if (r->status == ASX_OK) {
+        r->stage = CLI_STAGE_COMPILE;
+        asx_scenario_program_init(&program, g_cli_ops, CLI_MAX_OPS);
+        r->status = asx_scenario_compile(&program, fx.input_json);
+        program.seed = fx.seed;
+    }
+    if (r->status == ASX_OK) {
+        r->stage = CLI_STAGE_RUN;
+        asx_trace_reset();
+        r->status = asx_scenario_run(&program, &res);
+        r->errors = res.error_count;
+        r->trace_digest = asx_trace_digest();
+    }
+    if (r->status == ASX_OK) r->stage = CLI_STAGE_DONE;
+    asx_canonical_fixture_reset(&fx);
+}
+
+/* Run every jobs-th fixture starting at shard, each in a fresh runtime */
+static void cli_conformance_shard(const cli_paths *list,
+                                  cli_fixture_result *results,
+                                  uint32_t shard, uint32_t jobs)
+{
+    asx_codec_arena arena;
+    uint32_t i;
+
+    asx_codec_arena_init(&arena, g_cli_arena_mem, sizeof(g_cli_arena_mem));
+    asx_codec_set_arena(&arena);
+    asx_trace_set_sink(cli_discard_sink, NULL);
+    for (i = shard; i < list->count; i += jobs) {
+        cli_run_fixture(list->paths[i], &arena, &results[i]);
+    }
+    asx_trace_set_sink(NULL, NULL);
+    asx_codec_set_arena(NULL);
+}
+
+static void cli_print_json_string(const char *s)
+{
+    putchar('"');
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') putchar('\\');
+        if ((unsigned char)*s >= 0x20u) putchar(*s);
+    }
+    putchar('"');
+}
+
+static uint64_t cli_fold(uint64_t hash, uint64_t word)
+{
+    return (hash ^ word) * CLI_FNV_PRIME;
+}
+
+/* Write this run's keyed results, plus the old records they do not
+ * replace, to path through a temporary file. */
+static asx_status cli_cache_save(const char *path,
+                                 const cli_fixture_result *results,
+                                 uint32_t count)
+{
+    cli_cache_header h;
+    cli_cache_record *records;
+    uint32_t fresh = 0;
+    uint32_t n = 0;
+    uint32_t i;
+    char *tmp;
+    FILE *f;
+    int ok;
+
+    records = (cli_cache_record *)malloc(((size_t)count + g_cli_cache.count) *
+                                         sizeof(*records) + 1u);
+    tmp = (char *)malloc(strlen(path) + 5u);
+    if (records == NULL || tmp == NULL) {
+        free(records);
+        free(tmp);
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    for (i = 0; i < count; i++) {
+        const cli_fixture_result *r = &results[i];
+        cli_cache_record *rec;
+
+        if (!r->keyed) continue;
+        rec = &records[fresh++];
+        memset(rec, 0, sizeof(*rec));
+        rec->key = r->key;
+        rec->semantic_hash = r->semantic_hash;
+        rec->trace_digest = r->trace_digest;
+        rec->stage = r->stage;
+        rec->status = r->status;
+        rec->errors = r->errors;
+    }
+    qsort(records, fresh, sizeof(*records), cli_record_cmp);
+    for (i = 0; i < fresh; i++) {
+        if (n == 0 || cli_record_cmp(&records[n - 1u], &records[i]) != 0) {
+            records[n++] = records[i];
+        }
+    }
+    fresh = n;
+    for (i = 0; i < g_cli_cache.count; i++) {
+        const cli_cache_record *old = &g_cli_cache.records[i];
+        if (cli_cache_find(records, fresh, old->key, old->semantic_hash) == NULL) {
+            records[n++] = *old;
+        }
+    }
+    qsort(records, n, sizeof(*records), cli_record_cmp);
+
+    memset(&h, 0, sizeof(h));
+    h.magic = CLI_CACHE_MAGIC;
+    h.version = CLI_CACHE_VERSION;
+    h.count = n;
+    h.build_hash = g_cli_cache.build_hash;
+    h.profile_hash = g_cli_cache.profile_hash;
+
+    sprintf(tmp, "%s.tmp", path);
+    f = fopen(tmp, "wb");
+    ok = f != NULL &&
+         fwrite(&h, sizeof(h), 1, f) == 1 &&
+         fwrite(records, sizeof(*records), n, f) == n;
+    if (f != NULL && fclose(f) != 0) ok = 0;
+    ok = ok && rename(tmp, path) == 0;
+    if (!ok) (void)remove(tmp);
+    free(records);
+    free(tmp);
+    return ok ? ASX_OK : ASX_E_RESOURCE_EXHAUSTED;
+}
+
+static int cmd_conformance(const cli_args *a)
+{
+    cli_paths list;
+    cli_fixture_result *results;
+    pid_t pids[CLI_MAX_JOBS];
+    size_t bytes;
+    uint32_t jobs = a->jobs;
+    uint32_t passed = 0;
+    uint32_t cached = 0;
+    uint32_t w;
+    uint32_t i;
+    uint64_t digest = 0xcbf29ce484222325ULL;
+
+    if (a->fixtures == NULL) {
+        fprintf(stderr, "asx: --fixtures is required\n");
+        return CLI_USAGE;
+    }
+    memset(&list, 0, sizeof(list));
+    if (!cli_collect(a->fixtures, &list)) {
+        return cli_fail("cannot read", a->fixtures, ASX_E_NOT_FOUND);
+    }
+    if (list.count == 0) {
+        fprintf(stderr, "asx: no fixtures under %s\n", a->fixtures);
+        free(list.paths);
+        return CLI_USAGE;
+    }
+    qsort(list.paths, list.count, sizeof(char *), cli_path_cmp);
+    if (a->cache != NULL) {
+        asx_status st = cli_cache_open(a->cache);
+        if (st != ASX_OK) return cli_fail("cannot key", a->cache, st);
+    }
+
+    if (jobs == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = online > 0 ? (uint32_t)online : 1u;
+        if (jobs > CLI_MAX_JOBS) jobs = CLI_MAX_JOBS;
+    }
+    if (jobs > list.count) jobs = list.count;
+
+    /* Result slots are shared with the workers; stages start at WORKER */
+    bytes = sizeof(*results) * list.count;
+    results = (cli_fixture_result *)mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (results == (cli_fixture_result *)MAP_FAILED) {
+        return cli_fail("cannot map", "results", ASX_E_RESOURCE_EXHAUSTED);
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    for (w = 0; w < jobs; w++) {
+        pids[w] = fork();
+        if (pids[w] == 0) {
+            cli_conformance_shard(&list, results, w, jobs);
+            _exit(0);
+        }
+        /* No worker: run the shard here */
+        if (pids[w] < 0) cli_conformance_shard(&list, results, w, jobs);
+    }
+    for (w = 0; w < jobs; w++) {
+        if (pids[w] > 0) (void)waitpid(pids[w], NULL, 0);
+    }
+
+    for (i = 0; i < list.count; i++) {
+        const cli_fixture_result *r = &results[i];
+        int pass = r->stage == CLI_STAGE_DONE;
+
+        passed += pass ? 1u : 0u;
+        cached += r->cached;
+        digest = cli_fold(digest, (uint64_t)r->stage);
+        digest = cli_fold(digest, r->semantic_hash);
+        digest = cli_fold(digest, r->trace_digest);
+
+        printf("{\"file\":");
+        cli_print_json_string(list.paths[i]);
+        printf(",\"scenario_id\":");
+        cli_print_json_string(r->scenario_id);
+        printf(",\"profile\":");
+        cli_print_json_string(r->profile);
+        printf(",\"verdict\":\"%s\",\"stage\":\"%s\",\"status\":\"%s\""
+               ",\"errors\":%" PRIu32
+               ",\"semantic_hash\":\"0x%016" PRIx64 "\""
+               ",\"trace_digest\":\"0x%016" PRIx64 "\",\"cached\":%s}\n",
+               pass ? "pass" : "fail", g_cli_stage_names[r->stage],
+               asx_status_str(r->status), r->errors,
+               r->semantic_hash, r->trace_digest,
+               r->cached ? "true" : "false");
+        free(list.paths[i]);
+    }
+    printf("{\"kind\":\"summary\",\"fixtures\":%" PRIu32 ",\"passed\":%" PRIu32
+           ",\"failed\":%" PRIu32 ",\"cached\":%" PRIu32 ",\"jobs\":%" PRIu32
+           ",\"digest\":\"0x%016" PRIx64 "\"}\n",
+           list.count, passed, list.count - passed, cached, jobs, digest);
+
+    if (g_cli_cache.enabled) {
+        asx_status st = cli_cache_save(a->cache, results, list.count);
+        if (st != ASX_OK) fprintf(stderr, "asx: cannot write %s: %s\n", a->cache,
+                                  asx_status_str(st));
+        cli_cache_close();
+    }
+    (void)munmap(results, bytes);
+    free(list.paths);
+    return passed == list.count ? CLI_OK : CLI_MISMATCH;
+}
+
+int main(int argc, char **argv)
+{
+    cli_args a;
+    const char *cmd = argc > 1 ? argv[1] : "";
+
+    g_cli_exe = argv[0];
+    if (strcmp(cmd, "run") == 0) {
+        if (!cli_parse(argc, argv, 2, &a)) return CLI_USAGE;
+        return cmd_run(&a);
+    }
+    if (strcmp(cmd, "trace") == 0 && argc > 2 && strcmp(argv[2], "export") == 0) {
+        if (!cli_parse(argc, argv, 3, &a)) return CLI_USAGE;
+        return cmd_trace_export(&a);
+    }
+    if (strcmp(cmd, "digest") == 0 && argc == 3) {
+        return cmd_digest(argv[2]);
+    }
+    if (strcmp(cmd, "replay") == 0) {
+        if (!cli_parse(argc, argv, 2, &a)) return CLI_USAGE;
+        return cmd_replay(&a);
+    }
+    if (strcmp(cmd, "conformance") == 0) {
+        if (!cli_parse(argc, argv, 2, &a)) return CLI_USAGE;
+        return cmd_conformance(&a);
+    }
+    cli_usage();
+    return CLI_USAGE;
+}
@@ -10,6 +10,7 @@
 #include <asx/core/adaptive.h>
 #include <asx/asx_config.h>
 #include <string.h>
+#include "../runtime/context_internal.h"
 
 /* -------------------------------------------------------------------
  * Internal state (static, zero-allocation)
@@ -19,12 +20,27 @@ static asx_adaptive_policy g_policy;
 static uint32_t            g_decision_seq;
 static uint32_t            g_fallback_count;
 static int                 g_in_fallback;
+static uint32_t            g_ledger_every = 1u;
 
 /* Ring buffer for evidence ledger */
 static asx_adaptive_ledger_entry g_ledger[ASX_ADAPTIVE_LEDGER_DEPTH];
 static uint32_t g_ledger_write;  /* next write position */
 static uint32_t g_ledger_total;  /* total entries written */
 
+static const uint32_t g_ledger_every_init = 1u;
+static const asx_context_block g_adaptive_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_policy),
+    ASX_CONTEXT_BLOCK(g_decision_seq),
+    ASX_CONTEXT_BLOCK(g_fallback_count),
+    ASX_CONTEXT_BLOCK(g_in_fallback),
+    ASX_CONTEXT_BLOCK_INIT(g_ledger_every, g_ledger_every_init),
+    ASX_CONTEXT_BLOCK(g_ledger),
+    ASX_CONTEXT_BLOCK(g_ledger_write),
+    ASX_CONTEXT_BLOCK(g_ledger_total)
+};
+
+const asx_context_module asx_adaptive_context = ASX_CONTEXT_MODULE(g_adaptive_blocks);
+
 /* -------------------------------------------------------------------
  * Init / reset
  * ------------------------------------------------------------------- */
@@ -40,6 +56,7 @@ void asx_adaptive_reset(void)
     g_decision_seq   = 0;
     g_fallback_count = 0;
     g_in_fallback    = 0;
+    g_ledger_every   = 1u;
     g_ledger_write   = 0;
     g_ledger_total   = 0;
     memset(g_ledger, 0, sizeof(g_ledger));
@@ -73,6 +90,13 @@ asx_adaptive_policy asx_adaptive_policy_active(void)
  * Track counterfactual (second-best) for audit.
  * ------------------------------------------------------------------- */
 
+/* One term of the sum: loss is fp 16.16, posterior is fp 0.32, the
+ * product is fp 16.48; shift right 32 to get fp 16.16. */
+static uint64_t loss_term(uint32_t loss, uint32_t posterior_fp32)
+{
+    return ((uint64_t)loss * (uint64_t)posterior_fp32) >> 32;
+}
+
 static uint64_t compute_expected_loss(const asx_adaptive_surface *surface,
                                        const asx_adaptive_posterior *posterior,
                                        asx_adaptive_action action)
@@ -83,11 +107,8 @@ static uint64_t compute_expected_loss(const asx_adaptive_surface *surface,
                   ? surface->state_count : ASX_ADAPTIVE_MAX_ACTIONS;
     for (i = 0; i < count; i++) {
         ASX_CHECKPOINT_WAIVER("bounded: count clamped to ASX_ADAPTIVE_MAX_ACTIONS");
-        uint32_t loss = surface->loss_fn(surface->loss_ctx, action, i);
-        /* loss is fp 16.16, posterior is fp 0.32
-         * product is fp 16.48; shift right 32 to get fp 16.16 */
-        uint64_t product = (uint64_t)loss * (uint64_t)posterior->posterior[i];
-        total += (product >> 32);
+        total += loss_term(surface->loss_fn(surface->loss_ctx, action, i),
+                           posterior->posterior[i]);
     }
     return total;
 }
@@ -120,21 +141,10 @@ static void write_ledger(const asx_adaptive_surface *surface,
     g_ledger_total++;
 }
 
-asx_status asx_adaptive_decide(
-    const asx_adaptive_surface   *surface,
-    const asx_adaptive_posterior *posterior,
-    const asx_adaptive_evidence_term *evidence,
-    uint8_t                       evidence_count,
-    asx_adaptive_decision        *out_decision)
+static asx_status check_surface(const asx_adaptive_surface *surface,
+                                const asx_adaptive_posterior *posterior)
 {
-    uint8_t a;
-    uint64_t best_loss;
-    uint64_t second_loss;
-    asx_adaptive_action best_action;
-    asx_adaptive_action second_action;
-    int use_fallback;
-
-    if (!surface || !posterior || !out_decision) {
+    if (!surface || !posterior) {
         return ASX_E_INVALID_ARGUMENT;
     }
     if (surface->action_count < 1 ||
@@ -151,62 +161,215 @@ asx_status asx_adaptive_decide(
     if (!surface->loss_fn) {
         return ASX_E_INVALID_ARGUMENT;
     }
+    return ASX_OK;
+}
 
-    /* Check fallback conditions */
-    use_fallback = 0;
+/* Check fallback conditions against the active policy */
+static int needs_fallback(uint32_t confidence_fp32)
+{
+    int use_fallback = 0;
 
     if (g_policy.confidence_threshold_fp32 > 0 &&
-        posterior->confidence_fp32 < g_policy.confidence_threshold_fp32) {
+        confidence_fp32 < g_policy.confidence_threshold_fp32) {
         use_fallback = 1;
     }
     if (g_policy.budget_remaining > 0 && g_decision_seq >= g_policy.budget_remaining) {
         use_fallback = 1;
     }
-
     g_in_fallback = use_fallback;
+    return use_fallback;
+}
+
+static void fallback_decision(const asx_adaptive_surface *surface,
+                              uint32_t confidence_fp32,
+                              asx_adaptive_decision *out_decision)
+{
+    /* Deterministic fallback: use surface's declared fallback action */
+    out_decision->selected          = surface->fallback;
+    out_decision->expected_loss_fp16 = 0;
+    out_decision->counterfactual    = surface->fallback;
+    out_decision->cf_loss_fp16      = 0;
+    out_decision->used_fallback     = 1;
+    out_decision->confidence_fp32   = confidence_fp32;
+    g_fallback_count++;
+}
 
-    if (use_fallback) {
-        /* Deterministic fallback: use surface's declared fallback action */
-        out_decision->selected          = surface->fallback;
-        out_decision->expected_loss_fp16 = 0;
-        out_decision->counterfactual    = surface->fallback;
-        out_decision->cf_loss_fp16      = 0;
-        out_decision->used_fallback     = 1;
-        out_decision->confidence_fp32   = posterior->confidence_fp32;
-        g_fallback_count++;
+/* argmin over expected[], keeping the runner-up as counterfactual */
+static void select_action(const uint64_t *expected, uint8_t action_count,
+                          uint32_t confidence_fp32,
+                          asx_adaptive_decision *out_decision)
+{
+    uint8_t a;
+    uint64_t best_loss    = UINT64_MAX;
+    uint64_t second_loss  = UINT64_MAX;
+    asx_adaptive_action best_action   = 0;
+    asx_adaptive_action second_action = 0;
+
+    for (a = 0; a < action_count; a++) {
+        ASX_CHECKPOINT_WAIVER("bounded: action_count <= ASX_ADAPTIVE_MAX_ACTIONS");
+        uint64_t el = expected[a];
+        if (el < best_loss) {
+            second_loss   = best_loss;
+            second_action = best_action;
+            best_loss     = el;
+            best_action   = a;
+        } else if (el < second_loss) {
+            second_loss   = el;
+            second_action = a;
+        }
+    }
+
+    out_decision->selected          = best_action;
+    out_decision->expected_loss_fp16 = (uint32_t)best_loss;
+    out_decision->counterfactual    = second_action;
+    out_decision->cf_loss_fp16      = (uint32_t)second_loss;
+    out_decision->used_fallback     = 0;
+    out_decision->confidence_fp32   = confidence_fp32;
+}
+
+/* Log a sampled decision and advance the sequence */
+static void record_decision(const asx_adaptive_surface *surface,
+                            const asx_adaptive_decision *decision,
+                            const asx_adaptive_evidence_term *evidence,
+                            uint8_t evidence_count)
+{
+    if (g_ledger_every != 0 && g_decision_seq % g_ledger_every == 0) {
+        write_ledger(surface, decision, evidence, evidence_count);
+    }
+    g_decision_seq++;
+}
+
+asx_status asx_adaptive_decide(
+    const asx_adaptive_surface   *surface,
+    const asx_adaptive_posterior *posterior,
+    const asx_adaptive_evidence_term *evidence,
+    uint8_t                       evidence_count,
+    asx_adaptive_decision        *out_decision)
+{
+    uint64_t expected[ASX_ADAPTIVE_MAX_ACTIONS];
+    uint8_t a;
+
+    if (!out_decision || check_surface(surface, posterior) != ASX_OK) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    if (needs_fallback(posterior->confidence_fp32)) {
+        fallback_decision(surface, posterior->confidence_fp32, out_decision);
     } else {
         /* Expected-loss evaluation */
-        best_loss    = UINT64_MAX;
-        second_loss  = UINT64_MAX;
-        best_action  = 0;
-        second_action = 0;
-
         for (a = 0; a < surface->action_count; a++) {
             ASX_CHECKPOINT_WAIVER("bounded: action_count <= ASX_ADAPTIVE_MAX_ACTIONS");
-            uint64_t el = compute_expected_loss(surface, posterior, a);
-            if (el < best_loss) {
-                second_loss   = best_loss;
-                second_action = best_action;
-                best_loss     = el;
-                best_action   = a;
-            } else if (el < second_loss) {
-                second_loss   = el;
-                second_action = a;
-            }
+            expected[a] = compute_expected_loss(surface, posterior, a);
+        }
+        select_action(expected, surface->action_count,
+                      posterior->confidence_fp32, out_decision);
+    }
+
+    record_decision(surface, out_decision, evidence, evidence_count);
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Incremental engine
+ *
+ * expected[a] always equals compute_expected_loss() for the stored
+ * posterior: each term is truncated before summing, so swapping one
+ * state's term in and out reproduces the full sum exactly.
+ * ------------------------------------------------------------------- */
+
+asx_status asx_adaptive_engine_init(asx_adaptive_engine *eng,
+                                    const asx_adaptive_surface *surface,
+                                    const asx_adaptive_posterior *posterior)
+{
+    uint8_t a;
+    uint8_t i;
+
+    if (!eng || check_surface(surface, posterior) != ASX_OK) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    memset(eng, 0, sizeof(*eng));
+    eng->surface   = surface;
+    eng->posterior = *posterior;
+    for (a = 0; a < surface->action_count; a++) {
+        ASX_CHECKPOINT_WAIVER("bounded: action_count <= ASX_ADAPTIVE_MAX_ACTIONS");
+        for (i = 0; i < surface->state_count; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded: state_count <= ASX_ADAPTIVE_MAX_ACTIONS");
+            eng->loss[a][i] = surface->loss_fn(surface->loss_ctx, a, i);
+            eng->expected[a] += loss_term(eng->loss[a][i],
+                                          posterior->posterior[i]);
         }
+    }
+    return ASX_OK;
+}
+
+asx_status asx_adaptive_engine_observe(asx_adaptive_engine *eng,
+                                       uint8_t state_index,
+                                       uint32_t posterior_fp32)
+{
+    uint32_t old;
+    uint8_t a;
 
-        out_decision->selected          = best_action;
-        out_decision->expected_loss_fp16 = (uint32_t)best_loss;
-        out_decision->counterfactual    = second_action;
-        out_decision->cf_loss_fp16      = (uint32_t)second_loss;
-        out_decision->used_fallback     = 0;
-        out_decision->confidence_fp32   = posterior->confidence_fp32;
+    if (!eng || !eng->surface || state_index >= eng->posterior.state_count) {
+        return ASX_E_INVALID_ARGUMENT;
     }
 
-    /* Write to evidence ledger */
-    write_ledger(surface, out_decision, evidence, evidence_count);
-    g_decision_seq++;
+    old = eng->posterior.posterior[state_index];
+    if (old == posterior_fp32) {
+        return ASX_OK;
+    }
+    for (a = 0; a < eng->surface->action_count; a++) {
+        ASX_CHECKPOINT_WAIVER("bounded: action_count <= ASX_ADAPTIVE_MAX_ACTIONS");
+        eng->expected[a] -= loss_term(eng->loss[a][state_index], old);
+        eng->expected[a] += loss_term(eng->loss[a][state_index], posterior_fp32);
+    }
+    eng->posterior.posterior[state_index] = posterior_fp32;
+    return ASX_OK;
+}
+
+asx_status asx_adaptive_engine_update(asx_adaptive_engine *eng,
+                                      const asx_adaptive_posterior *posterior)
+{
+    uint8_t i;
+
+    if (!eng || !eng->surface || !posterior ||
+        posterior->state_count != eng->posterior.state_count) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < posterior->state_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded: state_count <= ASX_ADAPTIVE_MAX_ACTIONS");
+        asx_status st = asx_adaptive_engine_observe(eng, i,
+                                                    posterior->posterior[i]);
+        if (st != ASX_OK) {
+            return st;
+        }
+    }
+    eng->posterior.confidence_fp32 = posterior->confidence_fp32;
+    return ASX_OK;
+}
 
+asx_status asx_adaptive_engine_decide(
+    asx_adaptive_engine              *eng,
+    const asx_adaptive_evidence_term *evidence,
+    uint8_t                           evidence_count,
+    asx_adaptive_decision            *out_decision)
+{
+    uint32_t confidence;
+
+    if (!eng || !eng->surface || !out_decision) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    confidence = eng->posterior.confidence_fp32;
+    if (needs_fallback(confidence)) {
+        fallback_decision(eng->surface, confidence, out_decision);
+    } else {
+        select_action(eng->expected, eng->surface->action_count,
+                      confidence, out_decision);
+    }
+
+    record_decision(eng->surface, out_decision, evidence, evidence_count);
     return ASX_OK;
 }
 
@@ -214,6 +377,11 @@ asx_status asx_adaptive_decide(
  * Ledger queries
  * ------------------------------------------------------------------- */
 
+void asx_adaptive_set_ledger_sampling(uint32_t every)
+{
+    g_ledger_every = every;
+}
+
 uint32_t asx_adaptive_ledger_count(void)
 {
     return g_ledger_total;
@@ -13,47 +13,61 @@
 
 #ifdef ASX_DEBUG_AFFINITY
 
-#include <string.h>
+#include "entity_hash.h"
+#include "../runtime/context_internal.h"
 
 /* -------------------------------------------------------------------
  * Tracking table: maps entity IDs to their affinity domains
+ *
+ * Open-addressing hash with twice ASX_AFFINITY_TABLE_CAPACITY slots.
  * ------------------------------------------------------------------- */
 
 typedef struct {
-    uint64_t            entity_id;
     asx_affinity_domain domain;
-    int                 occupied;
 } asx_affinity_entry;
 
-static asx_affinity_entry g_affinity_table[ASX_AFFINITY_TABLE_CAPACITY];
-static uint32_t           g_affinity_count;
+#define AFFINITY_SLOTS (2u * ASX_AFFINITY_TABLE_CAPACITY)
+
+typedef char affinity_capacity_is_pow2
+    [(ASX_AFFINITY_TABLE_CAPACITY &
+      (ASX_AFFINITY_TABLE_CAPACITY - 1u)) == 0u ? 1 : -1];
+
+static uint64_t           g_affinity_keys[AFFINITY_SLOTS];
+static uint8_t            g_affinity_used[AFFINITY_SLOTS];
+static asx_affinity_entry g_affinity_table[AFFINITY_SLOTS];
+#define AFFINITY_HASH_INIT { \
+    g_affinity_keys, g_affinity_used, (uint8_t *)g_affinity_table, \
+    sizeof(asx_affinity_entry), AFFINITY_SLOTS - 1u, \
+    ASX_AFFINITY_TABLE_CAPACITY, 0 \
+}
+static asx_entity_hash    g_affinity_hash = AFFINITY_HASH_INIT;
 static asx_affinity_domain g_current_domain = ASX_AFFINITY_DOMAIN_ANY;
 
+static const asx_entity_hash g_affinity_hash_init = AFFINITY_HASH_INIT;
+static const asx_context_block g_affinity_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_affinity_keys),
+    ASX_CONTEXT_BLOCK(g_affinity_used),
+    ASX_CONTEXT_BLOCK(g_affinity_table),
+    ASX_CONTEXT_BLOCK_INIT(g_affinity_hash, g_affinity_hash_init),
+    ASX_CONTEXT_BLOCK(g_current_domain)      /* ANY is 0 */
+};
+
+const asx_context_module asx_affinity_context = ASX_CONTEXT_MODULE(g_affinity_blocks);
+
 /* -------------------------------------------------------------------
  * Internal helpers
  * ------------------------------------------------------------------- */
 
 static asx_affinity_entry *affinity_find(uint64_t entity_id)
 {
-    uint32_t i;
-    for (i = 0; i < ASX_AFFINITY_TABLE_CAPACITY; i++) {
-        if (g_affinity_table[i].occupied &&
-            g_affinity_table[i].entity_id == entity_id) {
-            return &g_affinity_table[i];
-        }
-    }
-    return NULL;
+    return (asx_affinity_entry *)asx_entity_hash_find(&g_affinity_hash,
+                                                      entity_id);
 }
 
-static asx_affinity_entry *affinity_alloc(void)
+static asx_affinity_entry *affinity_alloc(uint64_t entity_id)
 {
-    uint32_t i;
-    for (i = 0; i < ASX_AFFINITY_TABLE_CAPACITY; i++) {
-        if (!g_affinity_table[i].occupied) {
-            return &g_affinity_table[i];
-        }
-    }
-    return NULL;
+    return (asx_affinity_entry *)asx_entity_hash_insert(&g_affinity_hash,
+                                                        entity_id);
 }
 
 /* -------------------------------------------------------------------
@@ -62,8 +76,7 @@ static asx_affinity_entry *affinity_alloc(void)
 
 void asx_affinity_reset(void)
 {
-    memset(g_affinity_table, 0, sizeof(g_affinity_table));
-    g_affinity_count = 0;
+    asx_entity_hash_clear(&g_affinity_hash);
     g_current_domain = ASX_AFFINITY_DOMAIN_ANY;
 }
 
@@ -94,15 +107,12 @@ asx_status asx_affinity_bind(uint64_t entity_id, asx_affinity_domain domain)
         return ASX_OK;
     }
 
-    entry = affinity_alloc();
+    entry = affinity_alloc(entity_id);
     if (entry == NULL) {
         return ASX_E_AFFINITY_TABLE_FULL;
     }
 
-    entry->entity_id = entity_id;
     entry->domain = domain;
-    entry->occupied = 1;
-    g_affinity_count++;
 
     return ASX_OK;
 }
@@ -189,18 +199,13 @@ void asx_affinity_unbind(uint64_t entity_id)
 {
     asx_affinity_entry *entry = affinity_find(entity_id);
     if (entry != NULL) {
-        entry->occupied = 0;
-        entry->entity_id = 0;
-        entry->domain = ASX_AFFINITY_DOMAIN_NONE;
-        if (g_affinity_count > 0) {
-            g_affinity_count--;
-        }
+        asx_entity_hash_remove(&g_affinity_hash, entry);
     }
 }
 
 uint32_t asx_affinity_tracked_count(void)
 {
-    return g_affinity_count;
+    return g_affinity_hash.count;
 }
 
 #endif /* ASX_DEBUG_AFFINITY */
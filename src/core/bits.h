@@ -0,0 +1,41 @@
+/*
+ * bits.h — bit scanning helpers (internal)
+ *
+ * Lowest-set-bit index for the occupancy bitmaps. De Bruijn
+ * multiply-and-lookup: branch-free, pure C99, and the same result on
+ * every compiler and target, so no intrinsic is needed to keep traces
+ * identical across builds.
+ *
+ * Not part of the public API.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_CORE_BITS_H
+#define ASX_CORE_BITS_H
+
+#include <stdint.h>
+
+/* Index of the lowest set bit; word must be nonzero. */
+static inline uint32_t asx_ctz32(uint32_t word)
+{
+    static const uint8_t debruijn[32] = {
+         0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+        31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+    };
+    return debruijn[((word & (~word + 1u)) * 0x077CB531u) >> 27];
+}
+
+/* Index of the lowest set bit; word must be nonzero. */
+static inline uint32_t asx_ctz64(uint64_t word)
+{
+    static const uint8_t debruijn[64] = {
+         0,  1,  2, 53,  3,  7, 54, 27,  4, 38, 41,  8, 34, 55, 48, 28,
+        62,  5, 39, 46, 44, 42, 22,  9, 24, 35, 59, 56, 49, 18, 29, 11,
+        63, 52,  6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10,
+        51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12
+    };
+    return debruijn[((word & (~word + 1u)) * 0x022FDD63CC95386DULL) >> 58];
+}
+
+#endif /* ASX_CORE_BITS_H */
@@ -5,6 +5,8 @@
  */
 
 #include <asx/core/budget.h>
+#include <asx/asx_config.h>
+#include <stddef.h>
 
 asx_budget asx_budget_infinite(void) {
     asx_budget b;
@@ -24,15 +26,24 @@ asx_budget asx_budget_zero(void) {
     return b;
 }
 
-static uint64_t min_u64(uint64_t a, uint64_t b) { return a < b ? a : b; }
-static uint32_t min_u32(uint32_t a, uint32_t b) { return a < b ? a : b; }
-static uint8_t  min_u8(uint8_t a, uint8_t b)    { return a < b ? a : b; }
+/* Branchless minimums: the comparison becomes an all-ones or all-zero
+ * mask that selects a or b, so meet has no data-dependent branches and
+ * the batch loop below stays a straight line the compiler can vectorize. */
+static uint64_t min_u64(uint64_t a, uint64_t b) {
+    return b ^ ((a ^ b) & (0u - (uint64_t)(a < b)));
+}
+static uint32_t min_u32(uint32_t a, uint32_t b) {
+    return b ^ ((a ^ b) & (0u - (uint32_t)(a < b)));
+}
+static uint8_t  min_u8(uint8_t a, uint8_t b) {
+    return (uint8_t)min_u32(a, b);
+}
 
-/* deadline meet: earliest finite deadline wins; 0 means unconstrained */
+/* deadline meet: earliest finite deadline wins; 0 means unconstrained.
+ * Biasing by one maps 0 to UINT64_MAX, after which a plain minimum
+ * applies; the bias is undone on the result. */
 static asx_time min_deadline(asx_time a, asx_time b) {
-    if (a == 0) return b;
-    if (b == 0) return a;
-    return a < b ? a : b;
+    return min_u64(a - 1u, b - 1u) + 1u;
 }
 
 asx_budget asx_budget_meet(const asx_budget *a, const asx_budget *b) {
@@ -44,6 +55,30 @@ asx_budget asx_budget_meet(const asx_budget *a, const asx_budget *b) {
     return result;
 }
 
+void asx_budget_meet_each(asx_budget *budgets, uint32_t count,
+                          const asx_budget *bound) {
+    asx_time deadline;
+    uint32_t polls;
+    uint64_t cost;
+    uint8_t  priority;
+    uint32_t i;
+
+    if (budgets == NULL || bound == NULL) return;
+    deadline = bound->deadline;
+    polls    = bound->poll_quota;
+    cost     = bound->cost_quota;
+    priority = bound->priority;
+    for (i = 0; i < count; i++) {
+        asx_budget *b = &budgets[i];
+
+        ASX_CHECKPOINT_WAIVER("bounded: count, caller-owned array");
+        b->deadline   = min_deadline(b->deadline, deadline);
+        b->poll_quota = min_u32(b->poll_quota, polls);
+        b->cost_quota = min_u64(b->cost_quota, cost);
+        b->priority   = min_u8(b->priority, priority);
+    }
+}
+
 uint32_t asx_budget_consume_poll(asx_budget *b) {
     if (b->poll_quota == 0) return 0;
     return b->poll_quota--;
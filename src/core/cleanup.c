@@ -2,7 +2,9 @@
  * cleanup.c — deterministic cleanup stack implementation
  *
  * LIFO stack of cleanup actions for RAII-equivalent unwind in C.
- * Walking skeleton uses fixed-size arrays (ASX_CLEANUP_STACK_CAPACITY).
+ * Entry i lives inline for i < ASX_CLEANUP_INLINE_CAPACITY, otherwise in
+ * chunk (i - INLINE) / CHUNK. Chunks are doubly linked so drain can walk
+ * down from the top chunk.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -13,6 +15,13 @@
 
 #define ASX_CLEANUP_HANDLE_SLOT_MASK 0xFFFFu
 
+struct asx_cleanup_chunk {
+    struct asx_cleanup_chunk *prev;
+    struct asx_cleanup_chunk *next;
+    uint32_t          index;     /* position in the chain */
+    asx_cleanup_entry entries[ASX_CLEANUP_CHUNK_CAPACITY];
+};
+
 static uint32_t cleanup_handle_slot(asx_cleanup_handle handle)
 {
     return (uint32_t)(handle & ASX_CLEANUP_HANDLE_SLOT_MASK);
@@ -37,24 +46,123 @@ static uint16_t cleanup_next_generation(uint16_t current)
     return current;
 }
 
+static void cleanup_entry_clear(asx_cleanup_entry *e)
+{
+    e->fn = NULL;
+    e->data = NULL;
+    e->generation = 0u;
+}
+
+/* Entry idx < count. Chunks below the top are reached walking down, so
+ * entries near the top of the stack cost the least. */
+static asx_cleanup_entry *cleanup_entry_at(asx_cleanup_stack *stack,
+                                           uint32_t idx)
+{
+    struct asx_cleanup_chunk *c;
+    uint32_t k;
+
+    if (idx < ASX_CLEANUP_INLINE_CAPACITY) return &stack->entries[idx];
+    idx -= ASX_CLEANUP_INLINE_CAPACITY;
+    k = idx / ASX_CLEANUP_CHUNK_CAPACITY;
+    c = stack->top;
+    while (c->index > k) {
+        ASX_CHECKPOINT_WAIVER("bounded: chunk chain <= ASX_CLEANUP_STACK_CAPACITY / CHUNK");
+        c = c->prev;
+    }
+    return &c->entries[idx % ASX_CLEANUP_CHUNK_CAPACITY];
+}
+
+/* Entries of c in use: a full chunk unless it is the top one */
+static uint32_t cleanup_chunk_used(const asx_cleanup_stack *stack,
+                                   const struct asx_cleanup_chunk *c)
+{
+    if (c != stack->top) return ASX_CLEANUP_CHUNK_CAPACITY;
+    return stack->count - ASX_CLEANUP_INLINE_CAPACITY
+         - c->index * ASX_CLEANUP_CHUNK_CAPACITY;
+}
+
+/* Make room for entry count: step to (or allocate) the next chunk when
+ * count starts one. */
+static asx_status cleanup_grow(asx_cleanup_stack *stack)
+{
+    struct asx_cleanup_chunk *next;
+    void *mem;
+    uint32_t i;
+
+    if (stack->count < ASX_CLEANUP_INLINE_CAPACITY) return ASX_OK;
+    if ((stack->count - ASX_CLEANUP_INLINE_CAPACITY)
+            % ASX_CLEANUP_CHUNK_CAPACITY != 0u) {
+        return ASX_OK;
+    }
+
+    next = (stack->top != NULL) ? stack->top->next : stack->chunks;
+    if (next == NULL) {
+        if (asx_runtime_alloc_tagged(ASX_ALLOC_TAG_CLEANUP, sizeof(*next), &mem) != ASX_OK)
+            return ASX_E_RESOURCE_EXHAUSTED;
+        next = (struct asx_cleanup_chunk *)mem;
+        for (i = 0; i < ASX_CLEANUP_CHUNK_CAPACITY; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded: i < ASX_CLEANUP_CHUNK_CAPACITY");
+            cleanup_entry_clear(&next->entries[i]);
+        }
+        next->prev = stack->top;
+        next->next = NULL;
+        if (stack->top != NULL) {
+            next->index = stack->top->index + 1u;
+            stack->top->next = next;
+        } else {
+            next->index = 0u;
+            stack->chunks = next;
+        }
+    }
+    stack->top = next;
+    return ASX_OK;
+}
+
+/* Drop entry count-1, stepping down a chunk when it was the first of one */
+static void cleanup_shrink(asx_cleanup_stack *stack)
+{
+    stack->count--;
+    if (stack->count >= ASX_CLEANUP_INLINE_CAPACITY &&
+        (stack->count - ASX_CLEANUP_INLINE_CAPACITY)
+            % ASX_CLEANUP_CHUNK_CAPACITY == 0u) {
+        stack->top = stack->top->prev;
+    }
+}
+
 void asx_cleanup_init(asx_cleanup_stack *stack)
 {
     uint32_t i;
     if (stack == NULL) return;
-    for (i = 0; i < ASX_CLEANUP_STACK_CAPACITY; i++) {
-        stack->fns[i]  = NULL;
-        stack->data[i] = NULL;
-        stack->generations[i] = 0u;
+    for (i = 0; i < ASX_CLEANUP_INLINE_CAPACITY; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded: i < ASX_CLEANUP_INLINE_CAPACITY");
+        cleanup_entry_clear(&stack->entries[i]);
     }
+    stack->chunks  = NULL;
+    stack->top     = NULL;
     stack->count   = 0;
     stack->drained = 0;
 }
 
+void asx_cleanup_release(asx_cleanup_stack *stack)
+{
+    struct asx_cleanup_chunk *c;
+
+    if (stack == NULL) return;
+    while (stack->chunks != NULL) {
+        ASX_CHECKPOINT_WAIVER("bounded: chunk chain <= ASX_CLEANUP_STACK_CAPACITY / CHUNK");
+        c = stack->chunks;
+        stack->chunks = c->next;
+        (void)asx_runtime_free(c);
+    }
+    asx_cleanup_init(stack);
+}
+
 asx_status asx_cleanup_push(asx_cleanup_stack *stack,
                              asx_cleanup_fn fn,
                              void *user_data,
                              asx_cleanup_handle *out_handle)
 {
+    asx_cleanup_entry *e;
     uint32_t idx;
 
     if (stack == NULL || fn == NULL || out_handle == NULL)
@@ -67,18 +175,22 @@ asx_status asx_cleanup_push(asx_cleanup_stack *stack,
 
     if (stack->count >= ASX_CLEANUP_STACK_CAPACITY)
         return ASX_E_RESOURCE_EXHAUSTED;
+    if (cleanup_grow(stack) != ASX_OK)
+        return ASX_E_RESOURCE_EXHAUSTED;
 
     idx = stack->count++;
-    stack->generations[idx] = cleanup_next_generation(stack->generations[idx]);
-    stack->fns[idx]  = fn;
-    stack->data[idx] = user_data;
-    *out_handle = cleanup_make_handle(idx, stack->generations[idx]);
+    e = cleanup_entry_at(stack, idx);
+    e->generation = cleanup_next_generation(e->generation);
+    e->fn   = fn;
+    e->data = user_data;
+    *out_handle = cleanup_make_handle(idx, e->generation);
     return ASX_OK;
 }
 
 asx_status asx_cleanup_pop(asx_cleanup_stack *stack,
                             asx_cleanup_handle handle)
 {
+    asx_cleanup_entry *e;
     uint32_t slot;
     uint16_t generation;
 
@@ -87,16 +199,19 @@ asx_status asx_cleanup_pop(asx_cleanup_stack *stack,
     generation = cleanup_handle_generation(handle);
 
     if (slot >= stack->count) return ASX_E_NOT_FOUND;
-    if (stack->fns[slot] == NULL) return ASX_E_NOT_FOUND;
-    if (stack->generations[slot] != generation) return ASX_E_NOT_FOUND;
+    e = cleanup_entry_at(stack, slot);
+    if (e->fn == NULL) return ASX_E_NOT_FOUND;
+    if (e->generation != generation) return ASX_E_NOT_FOUND;
 
     /* Mark as resolved — will be skipped during drain */
-    stack->fns[slot]  = NULL;
-    stack->data[slot] = NULL;
+    e->fn   = NULL;
+    e->data = NULL;
 
     /* Keep depth tight for normal LIFO pop sequences. */
-    while (stack->count > 0u && stack->fns[stack->count - 1u] == NULL) {
-        stack->count--;
+    while (stack->count > 0u &&
+           cleanup_entry_at(stack, stack->count - 1u)->fn == NULL) {
+        ASX_CHECKPOINT_WAIVER("bounded: count <= ASX_CLEANUP_STACK_CAPACITY");
+        cleanup_shrink(stack);
     }
 
     return ASX_OK;
@@ -104,35 +219,57 @@ asx_status asx_cleanup_pop(asx_cleanup_stack *stack,
 
 void asx_cleanup_drain(asx_cleanup_stack *stack)
 {
-    uint32_t i;
-    if (stack == NULL) return;
-    if (stack->drained) return;
-
-    /* Drain in LIFO order: highest index first */
-    i = stack->count;
-    while (i > 0) {
-        /* ASX_CHECKPOINT_WAIVER: bounded by count <= ASX_CLEANUP_STACK_CAPACITY */
-        i--;
-        if (stack->fns[i] != NULL) {
-            stack->fns[i](stack->data[i]);
-            stack->fns[i]  = NULL;
-            stack->data[i] = NULL;
+    (void)asx_cleanup_drain_some(stack, UINT32_MAX);
+}
+
+uint32_t asx_cleanup_drain_some(asx_cleanup_stack *stack, uint32_t max_calls)
+{
+    asx_cleanup_entry *e;
+    asx_cleanup_fn fn;
+    void *data;
+    uint32_t calls = 0;
+
+    if (stack == NULL) return 0;
+    if (stack->drained) return 0;
+
+    /* LIFO: take the top entry off before calling it. Chunks stay
+     * chained so a rearmed stack keeps its generations. */
+    while (stack->count > 0u && calls < max_calls) {
+        ASX_CHECKPOINT_WAIVER("bounded: count <= ASX_CLEANUP_STACK_CAPACITY");
+        e = cleanup_entry_at(stack, stack->count - 1u);
+        fn   = e->fn;
+        data = e->data;
+        e->fn   = NULL;
+        e->data = NULL;
+        cleanup_shrink(stack);
+        if (fn != NULL) {
+            fn(data);
+            calls++;
         }
     }
 
-    stack->count   = 0;
-    stack->drained = 1;
+    if (stack->count == 0u) stack->drained = 1;
+    return calls;
 }
 
 uint32_t asx_cleanup_pending(const asx_cleanup_stack *stack)
 {
-    uint32_t i, pending;
+    const struct asx_cleanup_chunk *c;
+    uint32_t i, n, pending;
     if (stack == NULL) return 0;
     pending = 0;
-    for (i = 0; i < stack->count; i++) {
-        ASX_CHECKPOINT_WAIVER("bounded: count <= ASX_CLEANUP_STACK_CAPACITY");
-        if (stack->fns[i] != NULL) {
-            pending++;
+    n = stack->count < ASX_CLEANUP_INLINE_CAPACITY
+      ? stack->count : ASX_CLEANUP_INLINE_CAPACITY;
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded: i <= ASX_CLEANUP_INLINE_CAPACITY");
+        if (stack->entries[i].fn != NULL) pending++;
+    }
+    for (c = stack->top; c != NULL; c = c->prev) {
+        ASX_CHECKPOINT_WAIVER("bounded: chunk chain <= ASX_CLEANUP_STACK_CAPACITY / CHUNK");
+        n = cleanup_chunk_used(stack, c);
+        for (i = 0; i < n; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded: i <= ASX_CLEANUP_CHUNK_CAPACITY");
+            if (c->entries[i].fn != NULL) pending++;
         }
     }
     return pending;
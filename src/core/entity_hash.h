@@ -0,0 +1,125 @@
+/*
+ * entity_hash.h — open-addressing hash keyed by entity ID (internal)
+ *
+ * Fixed-storage map from a 64-bit entity ID to a small value record,
+ * shared by the debug-only tracking tables (ghost borrow ledger,
+ * affinity table). The caller owns the key, used-flag and value arrays
+ * (usually static, with the struct initialized alongside them); the
+ * slot count must be a power of two. Lookups probe linearly from a
+ * Fibonacci hash of the key. Removal shifts later members of the probe
+ * run back into the hole, so there are no tombstones and a miss stops
+ * at the first empty slot.
+ *
+ * Sizing the slots at twice the entry limit keeps the load factor at
+ * or below one half, which bounds the expected probe length even when
+ * the table is at its limit.
+ *
+ * Not part of the public API.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_CORE_ENTITY_HASH_H
+#define ASX_CORE_ENTITY_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t *keys;
+    uint8_t  *used;
+    uint8_t  *values;      /* slots * value_size bytes */
+    size_t    value_size;
+    uint32_t  mask;        /* slots - 1 */
+    uint32_t  limit;       /* most entries held at once */
+    uint32_t  count;
+} asx_entity_hash;
+
+static inline uint32_t asx_entity_hash_home(const asx_entity_hash *h,
+                                            uint64_t key)
+{
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & h->mask;
+}
+
+static inline void *asx_entity_hash_value(const asx_entity_hash *h,
+                                          uint32_t slot)
+{
+    return h->values + (size_t)slot * h->value_size;
+}
+
+/* Forget every entry. Values are left for insert to overwrite. */
+static inline void asx_entity_hash_clear(asx_entity_hash *h)
+{
+    memset(h->used, 0, (size_t)h->mask + 1u);
+    h->count = 0;
+}
+
+/* Value record for key, or NULL if absent. */
+static inline void *asx_entity_hash_find(const asx_entity_hash *h,
+                                         uint64_t key)
+{
+    uint32_t slot = asx_entity_hash_home(h, key);
+    uint32_t probes;
+
+    for (probes = 0; probes <= h->mask; probes++) {
+        if (!h->used[slot]) {
+            return NULL;
+        }
+        if (h->keys[slot] == key) {
+            return asx_entity_hash_value(h, slot);
+        }
+        slot = (slot + 1u) & h->mask;
+    }
+    return NULL;
+}
+
+/* Add key (which must be absent) with a zeroed value record. Returns
+ * the record, or NULL when the table holds `limit` entries. */
+static inline void *asx_entity_hash_insert(asx_entity_hash *h, uint64_t key)
+{
+    uint32_t slot;
+    void *value;
+
+    if (h->count >= h->limit) {
+        return NULL;
+    }
+    slot = asx_entity_hash_home(h, key);
+    while (h->used[slot]) {
+        slot = (slot + 1u) & h->mask;
+    }
+    h->keys[slot] = key;
+    h->used[slot] = 1;
+    h->count++;
+    value = asx_entity_hash_value(h, slot);
+    memset(value, 0, h->value_size);
+    return value;
+}
+
+/* Remove the entry whose record find/insert returned. Later members of
+ * the probe run move back to keep every key reachable from its home
+ * slot, so pointers to other records are invalidated. */
+static inline void asx_entity_hash_remove(asx_entity_hash *h, void *value)
+{
+    uint32_t hole = (uint32_t)((size_t)((uint8_t *)value - h->values) /
+                               h->value_size);
+    uint32_t next = (hole + 1u) & h->mask;
+
+    while (h->used[next]) {
+        uint32_t home = asx_entity_hash_home(h, h->keys[next]);
+        /* next may fill the hole unless its home lies in (hole, next] */
+        if (((next - home) & h->mask) >= ((next - hole) & h->mask)) {
+            h->keys[hole] = h->keys[next];
+            memcpy(asx_entity_hash_value(h, hole),
+                   asx_entity_hash_value(h, next), h->value_size);
+            hole = next;
+        }
+        next = (next + 1u) & h->mask;
+    }
+    h->used[hole] = 0;
+    if (h->count > 0) {
+        h->count--;
+    }
+}
+
+#endif /* ASX_CORE_ENTITY_HASH_H */
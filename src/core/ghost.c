@@ -15,6 +15,8 @@
 #ifdef ASX_DEBUG_GHOST
 
 #include <string.h>
+#include "entity_hash.h"
+#include "../runtime/context_internal.h"
 
 /* -------------------------------------------------------------------
  * Violation ring buffer
@@ -25,40 +27,63 @@ static uint32_t g_ghost_ring_write;   /* next write position */
 static uint32_t g_ghost_ring_count;   /* total violations recorded */
 static int      g_ghost_ring_overflow; /* set once ring wraps */
 
+/* Sampling rate and violation sink; both survive reset */
+static uint32_t g_ghost_sample_every = ASX_GHOST_SAMPLE_EVERY;
+static asx_ghost_violation_fn g_ghost_sink;
+static void    *g_ghost_sink_ctx;
+
 /* -------------------------------------------------------------------
  * Linearity tracking table
  *
  * Tracks which obligation IDs have been reserved and/or resolved.
- * Uses a small fixed table keyed by slot index. Each slot stores:
- *   - obligation handle (for identity verification)
- *   - reserved flag
- *   - resolved flag
+ * Indexed directly by the handle's slot index, so reserve and resolve
+ * are O(1) whatever the obligation count. Each slot stores:
+ *   - obligation handle (identity; its generation tells a recycled
+ *     slot from the obligation being resolved)
+ *   - reserved / resolved flags
+ * Slots below the high-water mark are the only ones ever written, so
+ * reset and the leak scan touch no more, and the scan is skipped when
+ * nothing is outstanding.
  * ------------------------------------------------------------------- */
 
-#define ASX_GHOST_LINEARITY_CAPACITY 256u
+#define ASX_GHOST_LINEARITY_CAPACITY ASX_ARENA_MAX_OBLIGATIONS  /* every obligation slot */
 
-typedef struct {
-    asx_obligation_id id;
-    int reserved;
-    int resolved;
-} asx_ghost_linearity_entry;
+#define GHOST_LIN_RESERVED 0x01u
+#define GHOST_LIN_RESOLVED 0x02u
 
-static asx_ghost_linearity_entry g_ghost_linearity[ASX_GHOST_LINEARITY_CAPACITY];
-static uint32_t g_ghost_linearity_count;
+static asx_obligation_id g_ghost_linearity_id[ASX_GHOST_LINEARITY_CAPACITY];
+static uint8_t  g_ghost_linearity_flags[ASX_GHOST_LINEARITY_CAPACITY];
+static uint32_t g_ghost_linearity_hwm;          /* 1 + highest slot used */
+static uint32_t g_ghost_linearity_outstanding;  /* reserved, unresolved */
 
 /* -------------------------------------------------------------------
  * Borrow ledger state (forward declarations; full API below)
+ *
+ * Entity ID -> borrow record in an open-addressing hash with twice
+ * ASX_GHOST_BORROW_TABLE_CAPACITY slots.
  * ------------------------------------------------------------------- */
 
 typedef struct {
-    uint64_t entity_id;
     uint32_t shared_count;
     int      exclusive;
-    int      occupied;
 } asx_ghost_borrow_entry;
 
-static asx_ghost_borrow_entry g_ghost_borrows[ASX_GHOST_BORROW_TABLE_CAPACITY];
-static uint32_t g_ghost_borrow_count;
+#define GHOST_BORROW_SLOTS (2u * ASX_GHOST_BORROW_TABLE_CAPACITY)
+
+typedef char ghost_borrow_capacity_is_pow2
+    [(ASX_GHOST_BORROW_TABLE_CAPACITY &
+      (ASX_GHOST_BORROW_TABLE_CAPACITY - 1u)) == 0u ? 1 : -1];
+
+static uint64_t g_ghost_borrow_keys[GHOST_BORROW_SLOTS];
+static uint8_t  g_ghost_borrow_used[GHOST_BORROW_SLOTS];
+static asx_ghost_borrow_entry g_ghost_borrows[GHOST_BORROW_SLOTS];
+#define GHOST_BORROW_HASH_INIT { \
+    g_ghost_borrow_keys, g_ghost_borrow_used, (uint8_t *)g_ghost_borrows, \
+    sizeof(asx_ghost_borrow_entry), GHOST_BORROW_SLOTS - 1u, \
+    ASX_GHOST_BORROW_TABLE_CAPACITY, 0 \
+}
+static asx_entity_hash g_ghost_borrow_hash = GHOST_BORROW_HASH_INIT;
+static const asx_entity_hash g_ghost_borrow_hash_init = GHOST_BORROW_HASH_INIT;
 
 /* -------------------------------------------------------------------
  * Determinism monitor state (forward declarations; full API below)
@@ -71,6 +96,52 @@ static uint64_t g_ghost_det_reference[ASX_GHOST_DETERMINISM_CAPACITY];
 static uint32_t g_ghost_det_ref_count;
 static int      g_ghost_det_sealed;
 
+/* Windowed digests of a run. A window spans
+ * ASX_GHOST_DETERMINISM_WINDOW << level events and its digest is a
+ * balanced merge tree of base-window digests, so merging two windows
+ * gives the digest the next level would have computed directly. */
+typedef struct {
+    uint64_t windows[ASX_GHOST_DETERMINISM_WINDOWS]; /* completed windows */
+    uint64_t carry[32];       /* pending merges inside the open window */
+    uint64_t base;            /* digest of the open base window */
+    uint64_t rolling;         /* digest of every event */
+    uint32_t base_events;     /* events in the open base window */
+    uint32_t bases;           /* base windows in the open window */
+    uint32_t window_count;
+    uint32_t level;
+} asx_ghost_det_trace;
+
+static asx_ghost_det_trace g_ghost_det_run;
+static asx_ghost_det_trace g_ghost_det_ref_run;
+
+static const uint32_t g_ghost_sample_every_init = ASX_GHOST_SAMPLE_EVERY;
+static const asx_context_block g_ghost_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_ghost_ring),
+    ASX_CONTEXT_BLOCK(g_ghost_ring_write),
+    ASX_CONTEXT_BLOCK(g_ghost_ring_count),
+    ASX_CONTEXT_BLOCK(g_ghost_ring_overflow),
+    ASX_CONTEXT_BLOCK_INIT(g_ghost_sample_every, g_ghost_sample_every_init),
+    ASX_CONTEXT_BLOCK(g_ghost_sink),
+    ASX_CONTEXT_BLOCK(g_ghost_sink_ctx),
+    ASX_CONTEXT_BLOCK(g_ghost_linearity_id),
+    ASX_CONTEXT_BLOCK(g_ghost_linearity_flags),
+    ASX_CONTEXT_BLOCK(g_ghost_linearity_hwm),
+    ASX_CONTEXT_BLOCK(g_ghost_linearity_outstanding),
+    ASX_CONTEXT_BLOCK(g_ghost_borrow_keys),
+    ASX_CONTEXT_BLOCK(g_ghost_borrow_used),
+    ASX_CONTEXT_BLOCK(g_ghost_borrows),
+    ASX_CONTEXT_BLOCK_INIT(g_ghost_borrow_hash, g_ghost_borrow_hash_init),
+    ASX_CONTEXT_BLOCK(g_ghost_det_events),
+    ASX_CONTEXT_BLOCK(g_ghost_det_count),
+    ASX_CONTEXT_BLOCK(g_ghost_det_reference),
+    ASX_CONTEXT_BLOCK(g_ghost_det_ref_count),
+    ASX_CONTEXT_BLOCK(g_ghost_det_sealed),
+    ASX_CONTEXT_BLOCK(g_ghost_det_run),
+    ASX_CONTEXT_BLOCK(g_ghost_det_ref_run)
+};
+
+const asx_context_module asx_ghost_context = ASX_CONTEXT_MODULE(g_ghost_blocks);
+
 /* Forward declaration for use in asx_ghost_reset */
 static void ghost_determinism_reset_impl(void);
 
@@ -95,18 +166,21 @@ static void ghost_record_violation(asx_ghost_violation_kind kind,
     if (g_ghost_ring_count > ASX_GHOST_RING_CAPACITY) {
         g_ghost_ring_overflow = 1;
     }
+    if (g_ghost_sink != NULL) {
+        g_ghost_sink(g_ghost_sink_ctx, v);
+    }
 }
 
-/* Find linearity entry by obligation ID. Returns NULL if not tracked. */
-static asx_ghost_linearity_entry *ghost_linearity_find(asx_obligation_id id)
+/* Slot of a tracked obligation ID, or -1 if the slot holds another
+ * generation (or nothing). */
+static int32_t ghost_linearity_find(asx_obligation_id id)
 {
-    uint32_t i;
-    for (i = 0; i < g_ghost_linearity_count; i++) {
-        if (g_ghost_linearity[i].id == id) {
-            return &g_ghost_linearity[i];
-        }
+    uint32_t slot = asx_handle_slot(id);
+    if ((g_ghost_linearity_flags[slot] & GHOST_LIN_RESERVED) == 0u ||
+        g_ghost_linearity_id[slot] != id) {
+        return -1;
     }
-    return NULL;
+    return (int32_t)slot;
 }
 
 /* -------------------------------------------------------------------
@@ -120,23 +194,58 @@ void asx_ghost_reset(void)
     g_ghost_ring_count    = 0;
     g_ghost_ring_overflow = 0;
 
-    memset(g_ghost_linearity, 0, sizeof(g_ghost_linearity));
-    g_ghost_linearity_count = 0;
+    memset(g_ghost_linearity_id, 0,
+           g_ghost_linearity_hwm * sizeof(g_ghost_linearity_id[0]));
+    memset(g_ghost_linearity_flags, 0, g_ghost_linearity_hwm);
+    g_ghost_linearity_hwm = 0;
+    g_ghost_linearity_outstanding = 0;
 
-    memset(g_ghost_borrows, 0, sizeof(g_ghost_borrows));
-    g_ghost_borrow_count = 0;
+    asx_entity_hash_clear(&g_ghost_borrow_hash);
 
     ghost_determinism_reset_impl();
 }
 
+/* --- Sampling --- */
+
+void asx_ghost_set_sampling(uint32_t every)
+{
+    g_ghost_sample_every = every > 1u ? every : 1u;
+}
+
+uint32_t asx_ghost_sampling(void)
+{
+    return g_ghost_sample_every > 1u ? g_ghost_sample_every : 1u;
+}
+
+int asx_ghost_region_sampled(asx_region_id region)
+{
+    if (g_ghost_sample_every <= 1u || region == ASX_INVALID_ID) {
+        return 1;
+    }
+    /* Mix the handle so neighbouring slots and generations spread out */
+    return (uint32_t)((region * 0x9E3779B97F4A7C15ull) >> 32)
+           % g_ghost_sample_every == 0u;
+}
+
+void asx_ghost_set_violation_sink(asx_ghost_violation_fn fn, void *ctx)
+{
+    g_ghost_sink = fn;
+    g_ghost_sink_ctx = fn != NULL ? ctx : NULL;
+}
+
 /* --- Protocol monitor --- */
 
+/* The header's inline fast paths would expand here */
+#undef asx_ghost_check_region_transition
+#undef asx_ghost_check_task_transition
+#undef asx_ghost_check_obligation_transition
+
 asx_status asx_ghost_check_region_transition(asx_region_id id,
                                               asx_region_state from,
                                               asx_region_state to)
 {
     asx_status st = asx_region_transition_check(from, to);
-    if (st != ASX_OK) {
+    if (st != ASX_OK && asx_ghost_region_sampled(id)) {
         ghost_record_violation(ASX_GHOST_PROTOCOL_REGION, id,
                                (int)from, (int)to);
     }
@@ -171,32 +280,36 @@ asx_status asx_ghost_check_obligation_transition(asx_obligation_id id,
 
 void asx_ghost_obligation_reserved(asx_obligation_id id)
 {
-    asx_ghost_linearity_entry *entry;
+    uint32_t slot = asx_handle_slot(id);
+    uint8_t flags = g_ghost_linearity_flags[slot];
 
-    if (g_ghost_linearity_count >= ASX_GHOST_LINEARITY_CAPACITY) {
-        return; /* table full — silent cap */
+    /* A recycled slot replaces the previous generation's entry */
+    if ((flags & GHOST_LIN_RESERVED) != 0u && (flags & GHOST_LIN_RESOLVED) == 0u) {
+        g_ghost_linearity_outstanding--;
+    }
+    g_ghost_linearity_id[slot]    = id;
+    g_ghost_linearity_flags[slot] = GHOST_LIN_RESERVED;
+    g_ghost_linearity_outstanding++;
+    if ((uint32_t)slot >= g_ghost_linearity_hwm) {
+        g_ghost_linearity_hwm = (uint32_t)slot + 1u;
     }
-
-    entry = &g_ghost_linearity[g_ghost_linearity_count++];
-    entry->id       = id;
-    entry->reserved = 1;
-    entry->resolved = 0;
 }
 
 void asx_ghost_obligation_resolved(asx_obligation_id id)
 {
-    asx_ghost_linearity_entry *entry = ghost_linearity_find(id);
-    if (entry == NULL) {
-        return; /* not tracked (table was full or ID never reserved) */
+    int32_t slot = ghost_linearity_find(id);
+    if (slot < 0) {
+        return; /* not tracked (ID never reserved or slot recycled) */
     }
 
-    if (entry->resolved) {
+    if (g_ghost_linearity_flags[slot] & GHOST_LIN_RESOLVED) {
         /* Double resolution — linearity violation */
         ghost_record_violation(ASX_GHOST_LINEARITY_DOUBLE, id, -1, -1);
         return;
     }
 
-    entry->resolved = 1;
+    g_ghost_linearity_flags[slot] |= GHOST_LIN_RESOLVED;
+    g_ghost_linearity_outstanding--;
 }
 
 uint32_t asx_ghost_check_obligation_leaks(asx_region_id region)
@@ -204,9 +317,13 @@ uint32_t asx_ghost_check_obligation_leaks(asx_region_id region)
     uint32_t i;
     uint32_t leak_count = 0;
 
-    for (i = 0; i < g_ghost_linearity_count; i++) {
-        asx_ghost_linearity_entry *entry = &g_ghost_linearity[i];
-        if (!entry->reserved || entry->resolved) {
+    if (g_ghost_linearity_outstanding == 0 ||
+        !asx_ghost_region_sampled(region)) {
+        return 0;
+    }
+
+    for (i = 0; i < g_ghost_linearity_hwm; i++) {
+        if (g_ghost_linearity_flags[i] != GHOST_LIN_RESERVED) {
             continue;
         }
 
@@ -223,7 +340,8 @@ uint32_t asx_ghost_check_obligation_leaks(asx_region_id region)
          */
         (void)region; /* walking skeleton: report all unresolved */
 
-        ghost_record_violation(ASX_GHOST_LINEARITY_LEAK, entry->id, -1, -1);
+        ghost_record_violation(ASX_GHOST_LINEARITY_LEAK,
+                               g_ghost_linearity_id[i], -1, -1);
         leak_count++;
     }
 
@@ -289,35 +407,20 @@ const char *asx_ghost_violation_kind_str(asx_ghost_violation_kind kind)
  * one exclusive (&mut), never both simultaneously.
  * ------------------------------------------------------------------- */
 
-/* asx_ghost_borrow_entry and g_ghost_borrows/g_ghost_borrow_count
- * are forward-declared above asx_ghost_reset for initialization. */
+/* asx_ghost_borrow_entry and g_ghost_borrow_hash are forward-declared
+ * above asx_ghost_reset for initialization. */
 
 static asx_ghost_borrow_entry *ghost_borrow_find(uint64_t entity_id)
 {
-    uint32_t i;
-    for (i = 0; i < ASX_GHOST_BORROW_TABLE_CAPACITY; i++) {
-        if (g_ghost_borrows[i].occupied &&
-            g_ghost_borrows[i].entity_id == entity_id) {
-            return &g_ghost_borrows[i];
-        }
-    }
-    return NULL;
+    return (asx_ghost_borrow_entry *)asx_entity_hash_find(
+        &g_ghost_borrow_hash, entity_id);
 }
 
 static asx_ghost_borrow_entry *ghost_borrow_alloc(uint64_t entity_id)
 {
-    uint32_t i;
-    for (i = 0; i < ASX_GHOST_BORROW_TABLE_CAPACITY; i++) {
-        if (!g_ghost_borrows[i].occupied) {
-            g_ghost_borrows[i].entity_id = entity_id;
-            g_ghost_borrows[i].shared_count = 0;
-            g_ghost_borrows[i].exclusive = 0;
-            g_ghost_borrows[i].occupied = 1;
-            g_ghost_borrow_count++;
-            return &g_ghost_borrows[i];
-        }
-    }
-    return NULL; /* table full */
+    /* NULL when the table is full */
+    return (asx_ghost_borrow_entry *)asx_entity_hash_insert(
+        &g_ghost_borrow_hash, entity_id);
 }
 
 uint32_t asx_ghost_borrow_shared(uint64_t entity_id)
@@ -379,10 +482,7 @@ void asx_ghost_borrow_release(uint64_t entity_id)
 
     /* Reclaim slot if no borrows remain */
     if (!entry->exclusive && entry->shared_count == 0) {
-        entry->occupied = 0;
-        if (g_ghost_borrow_count > 0) {
-            g_ghost_borrow_count--;
-        }
+        asx_entity_hash_remove(&g_ghost_borrow_hash, entry);
     }
 }
 
@@ -392,12 +492,7 @@ void asx_ghost_borrow_release_all(uint64_t entity_id)
     if (entry == NULL) {
         return;
     }
-    entry->shared_count = 0;
-    entry->exclusive = 0;
-    entry->occupied = 0;
-    if (g_ghost_borrow_count > 0) {
-        g_ghost_borrow_count--;
-    }
+    asx_entity_hash_remove(&g_ghost_borrow_hash, entry);
 }
 
 uint32_t asx_ghost_borrow_shared_count(uint64_t entity_id)
@@ -423,12 +518,146 @@ int asx_ghost_borrow_is_exclusive(uint64_t entity_id)
  *
  * Records scheduler event keys in sequence and compares against a
  * sealed reference ordering. Any divergence records a DETERMINISM_DRIFT
- * violation. The digest function provides a simple hash for quick
- * identity comparison across runs.
+ * violation. The first ASX_GHOST_DETERMINISM_CAPACITY keys are kept
+ * for an exact comparison; every key also feeds the windowed digests
+ * (asx_ghost_det_trace), which take over for longer runs. The digest
+ * function is a rolling hash for quick identity comparison across runs.
  *
  * g_ghost_det_* variables are forward-declared above asx_ghost_reset.
  * ------------------------------------------------------------------- */
 
+#define GHOST_DET_BASIS 0x517cc1b727220a95ULL  /* FNV-1a offset basis */
+#define GHOST_DET_PRIME 0x00000100000001B3ULL  /* FNV-1a prime */
+
+static uint64_t ghost_det_mix(uint64_t hash, uint64_t key)
+{
+    return (hash ^ key) * GHOST_DET_PRIME;
+}
+
+static uint64_t ghost_det_merge(uint64_t older, uint64_t newer)
+{
+    return ghost_det_mix(ghost_det_mix(GHOST_DET_BASIS, older), newer);
+}
+
+static void ghost_det_trace_reset(asx_ghost_det_trace *t)
+{
+    t->base = GHOST_DET_BASIS;
+    t->rolling = GHOST_DET_BASIS;
+    t->base_events = 0;
+    t->bases = 0;
+    t->window_count = 0;
+    t->level = 0;
+}
+
+static void ghost_det_trace_record(asx_ghost_det_trace *t, uint64_t key)
+{
+    uint64_t d;
+    uint32_t j;
+    uint32_t i;
+
+    t->rolling = ghost_det_mix(t->rolling, key);
+    t->base = ghost_det_mix(t->base, key);
+    if (++t->base_events < ASX_GHOST_DETERMINISM_WINDOW) {
+        return;
+    }
+
+    /* Base window complete: fold it in like a binary counter */
+    d = t->base;
+    t->base = GHOST_DET_BASIS;
+    t->base_events = 0;
+    for (j = 0; (t->bases >> j) & 1u; j++) {
+        d = ghost_det_merge(t->carry[j], d);
+    }
+    t->carry[j] = d;
+    t->bases++;
+    if (t->bases < (1u << t->level)) {
+        return;
+    }
+
+    t->bases = 0;
+    t->windows[t->window_count++] = t->carry[t->level];
+    if (t->window_count == ASX_GHOST_DETERMINISM_WINDOWS) {
+        /* Table full: merge neighbours and double the window length */
+        for (i = 0; i < ASX_GHOST_DETERMINISM_WINDOWS / 2u; i++) {
+            t->windows[i] = ghost_det_merge(t->windows[2u * i],
+                                            t->windows[2u * i + 1u]);
+        }
+        t->window_count = ASX_GHOST_DETERMINISM_WINDOWS / 2u;
+        t->level++;
+    }
+}
+
+/* Compare the current run's windows with the reference's, merging the
+ * finer table up to the coarser level. Returns the number of differing
+ * windows (plus a differing tail when the lengths match), reporting
+ * the first in out_first/out_len and recording violations if asked. */
+static uint32_t ghost_det_compare_windows(int record, uint32_t *out_first,
+                                          uint32_t *out_len)
+{
+    static uint64_t aligned[ASX_GHOST_DETERMINISM_WINDOWS];
+    const asx_ghost_det_trace *fine = &g_ghost_det_run;
+    const asx_ghost_det_trace *coarse = &g_ghost_det_ref_run;
+    uint32_t min_count = g_ghost_det_count < g_ghost_det_ref_count
+                         ? g_ghost_det_count : g_ghost_det_ref_count;
+    uint32_t n, level, span, common, i;
+    uint32_t diffs = 0;
+
+    if (fine->level > coarse->level) {
+        fine = &g_ghost_det_ref_run;
+        coarse = &g_ghost_det_run;
+    }
+    n = fine->window_count;
+    memcpy(aligned, fine->windows, n * sizeof(aligned[0]));
+    for (level = fine->level; level < coarse->level; level++) {
+        for (i = 0; i < n / 2u; i++) {
+            aligned[i] = ghost_det_merge(aligned[2u * i], aligned[2u * i + 1u]);
+        }
+        n /= 2u;
+    }
+
+    span = ASX_GHOST_DETERMINISM_WINDOW << coarse->level;
+    common = n < coarse->window_count ? n : coarse->window_count;
+    for (i = 0; i < common; i++) {
+        if (aligned[i] == coarse->windows[i]) {
+            continue;
+        }
+        if (diffs++ == 0u) {
+            *out_first = i * span;
+            *out_len = span;
+        }
+        if (record) {
+            ghost_record_violation(ASX_GHOST_DETERMINISM_DRIFT,
+                                   (uint64_t)i * span, (int)i, (int)span);
+        }
+    }
+    if (diffs > 0u) {
+        return diffs;
+    }
+
+    /* Every common window matches: the divergence is in the tail */
+    *out_first = common * span;
+    *out_len = min_count > *out_first ? min_count - *out_first : 0u;
+    if (g_ghost_det_count != g_ghost_det_ref_count) {
+        (*out_len)++;   /* up to where the shorter run ends */
+    } else if (g_ghost_det_run.rolling != g_ghost_det_ref_run.rolling) {
+        diffs = 1;
+        if (record) {
+            ghost_record_violation(ASX_GHOST_DETERMINISM_DRIFT,
+                                   (uint64_t)*out_first, (int)common,
+                                   (int)*out_len);
+        }
+    } else {
+        *out_len = 0;
+    }
+    return diffs;
+}
+
+static int ghost_det_windowed(void)
+{
+    return g_ghost_det_count > ASX_GHOST_DETERMINISM_CAPACITY ||
+           g_ghost_det_ref_count > ASX_GHOST_DETERMINISM_CAPACITY;
+}
+
 static void ghost_determinism_reset_impl(void)
 {
     memset(g_ghost_det_events, 0, sizeof(g_ghost_det_events));
@@ -436,6 +665,8 @@ static void ghost_determinism_reset_impl(void)
     memset(g_ghost_det_reference, 0, sizeof(g_ghost_det_reference));
     g_ghost_det_ref_count = 0;
     g_ghost_det_sealed = 0;
+    ghost_det_trace_reset(&g_ghost_det_run);
+    ghost_det_trace_reset(&g_ghost_det_ref_run);
 }
 
 void asx_ghost_determinism_reset(void)
@@ -449,6 +680,7 @@ void asx_ghost_determinism_record(uint64_t event_key)
         g_ghost_det_events[g_ghost_det_count] = event_key;
     }
     g_ghost_det_count++;
+    ghost_det_trace_record(&g_ghost_det_run, event_key);
 }
 
 void asx_ghost_determinism_seal(void)
@@ -459,17 +691,20 @@ void asx_ghost_determinism_seal(void)
     memcpy(g_ghost_det_reference, g_ghost_det_events,
            copy_count * sizeof(uint64_t));
     g_ghost_det_ref_count = g_ghost_det_count;
+    g_ghost_det_ref_run = g_ghost_det_run;
     g_ghost_det_sealed = 1;
 
     /* Reset current sequence for the next run */
     memset(g_ghost_det_events, 0, sizeof(g_ghost_det_events));
     g_ghost_det_count = 0;
+    ghost_det_trace_reset(&g_ghost_det_run);
 }
 
 uint32_t asx_ghost_determinism_check(void)
 {
     uint32_t drift_count = 0;
     uint32_t check_count;
+    uint32_t first, len;
     uint32_t i;
 
     if (!g_ghost_det_sealed) {
@@ -484,13 +719,14 @@ uint32_t asx_ghost_determinism_check(void)
         drift_count++;
     }
 
+    if (ghost_det_windowed()) {
+        return drift_count + ghost_det_compare_windows(1, &first, &len);
+    }
+
     /* Compare element-by-element up to the shorter sequence */
     check_count = g_ghost_det_count < g_ghost_det_ref_count
                   ? g_ghost_det_count
                   : g_ghost_det_ref_count;
-    if (check_count > ASX_GHOST_DETERMINISM_CAPACITY) {
-        check_count = ASX_GHOST_DETERMINISM_CAPACITY;
-    }
 
     for (i = 0; i < check_count; i++) {
         if (g_ghost_det_events[i] != g_ghost_det_reference[i]) {
@@ -504,22 +740,43 @@ uint32_t asx_ghost_determinism_check(void)
     return drift_count;
 }
 
-uint64_t asx_ghost_determinism_digest(void)
+int asx_ghost_determinism_locate(uint32_t *out_first, uint32_t *out_len)
 {
-    uint64_t hash = 0x517cc1b727220a95ULL; /* FNV-1a offset basis */
-    uint32_t count;
+    uint32_t first = 0;
+    uint32_t len = 0;
+    uint32_t check_count;
     uint32_t i;
 
-    count = g_ghost_det_count < ASX_GHOST_DETERMINISM_CAPACITY
-            ? g_ghost_det_count
-            : ASX_GHOST_DETERMINISM_CAPACITY;
+    if (!g_ghost_det_sealed) {
+        return 0;
+    }
 
-    for (i = 0; i < count; i++) {
-        hash ^= g_ghost_det_events[i];
-        hash *= 0x00000100000001B3ULL; /* FNV-1a prime */
+    if (ghost_det_windowed()) {
+        (void)ghost_det_compare_windows(0, &first, &len);
+    } else {
+        check_count = g_ghost_det_count < g_ghost_det_ref_count
+                      ? g_ghost_det_count
+                      : g_ghost_det_ref_count;
+        first = check_count;
+        for (i = 0; i < check_count; i++) {
+            if (g_ghost_det_events[i] != g_ghost_det_reference[i]) {
+                first = i;
+                break;
+            }
+        }
+        if (first < check_count || g_ghost_det_count != g_ghost_det_ref_count) {
+            len = 1;
+        }
     }
 
-    return hash;
+    if (out_first != NULL) *out_first = first;
+    if (out_len != NULL) *out_len = len;
+    return len > 0u;
+}
+
+uint64_t asx_ghost_determinism_digest(void)
+{
+    return g_ghost_det_run.rolling;
 }
 
 uint32_t asx_ghost_determinism_event_count(void)
@@ -5,19 +5,72 @@
  */
 
 #include <asx/asx.h>
+#include <string.h>
+#include "../runtime/context_internal.h"
+
+/*
+ * Error ledger storage. Each task arena slot has a small header; the
+ * owner handle carries the generation, so a recycled slot's first
+ * error restarts the ledger. Entry rings come from a shared pool on a
+ * slot's first error, so tasks that never fail hold no entries. Once
+ * the pool is exhausted the ring handed out longest ago is reclaimed
+ * (its task's ledger reads as empty). Handles outside the table share
+ * the fallback ledger, which has a ring of its own.
+ */
+typedef struct {
+    const char *operation;
+    const char *file;
+    uint32_t    line;
+    uint32_t    sequence;
+    asx_status  status;
+} asx_error_ledger_record;      /* task_id implied by the ledger owner */
 
 typedef struct asx_task_ledger {
-    asx_task_id            owner;
-    uint32_t               used;
-    uint32_t               write_index;
-    uint32_t               next_sequence;
-    int                    overflowed;
-    asx_error_ledger_entry entries[ASX_ERROR_LEDGER_DEPTH];
+    asx_task_id owner;
+    uint32_t    next_sequence;
+    uint16_t    ring;           /* 1 + pool index; 0 = none yet */
+    uint8_t     used;
+    uint8_t     write_index;
+    uint8_t     overflowed;
 } asx_task_ledger;
 
+typedef char asx_error_ledger_depth_fits
+    [ASX_ERROR_LEDGER_DEPTH <= 255u ? 1 : -1];
+
 static asx_task_ledger g_task_ledgers[ASX_ERROR_LEDGER_TASK_SLOTS];
 static asx_task_ledger g_fallback_ledger;
-static asx_task_id     g_bound_task = ASX_INVALID_ID;
+static asx_error_ledger_record g_fallback_ring[ASX_ERROR_LEDGER_DEPTH];
+static asx_error_ledger_record g_ledger_pool[ASX_ERROR_LEDGER_RINGS]
+                                            [ASX_ERROR_LEDGER_DEPTH];
+static uint16_t        g_ledger_pool_slot[ASX_ERROR_LEDGER_RINGS];
+static uint32_t        g_ledger_pool_used;  /* rings handed out so far */
+static uint32_t        g_ledger_pool_hand;  /* next ring to reclaim */
+
+static const asx_context_block g_status_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_task_ledgers),
+    ASX_CONTEXT_BLOCK(g_fallback_ledger),
+    ASX_CONTEXT_BLOCK(g_fallback_ring),
+    ASX_CONTEXT_BLOCK(g_ledger_pool),
+    ASX_CONTEXT_BLOCK(g_ledger_pool_slot),
+    ASX_CONTEXT_BLOCK(g_ledger_pool_used),
+    ASX_CONTEXT_BLOCK(g_ledger_pool_hand)
+};
+
+const asx_context_module asx_status_context = ASX_CONTEXT_MODULE(g_status_blocks);
+
+/* Worker-local ASX_TRY context; the scheduler binds it inline
+ * (runtime_internal.h), so it is not static. */
+ASX_THREAD_LOCAL asx_task_id g_asx_ledger_bound_task = ASX_INVALID_ID;
+
+/* Workers that fail at once share the ring pool and fallback ledger */
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+static uint32_t g_ledger_lock;
+#define ledger_lock()   while (__atomic_exchange_n(&g_ledger_lock, 1u, __ATOMIC_ACQUIRE) != 0u) {}
+#define ledger_unlock() __atomic_store_n(&g_ledger_lock, 0u, __ATOMIC_RELEASE)
+#else
+#define ledger_lock()   ((void)0)
+#define ledger_unlock() ((void)0)
+#endif
 
 static const char *g_must_use_surfaces[] = {
     "asx_region_transition_check",
@@ -39,23 +92,44 @@ static const char *g_must_use_surfaces[] = {
     "asx_error_ledger_get"
 };
 
+/* Restart a ledger for owner; its ring (if any) is kept for reuse.
+ * Entries are overwritten before they are read. */
 static void asx_task_ledger_clear(asx_task_ledger *ledger, asx_task_id owner)
 {
-    uint32_t i;
-
     ledger->owner = owner;
     ledger->used = 0;
     ledger->write_index = 0;
     ledger->next_sequence = 0;
     ledger->overflowed = 0;
-    for (i = 0; i < ASX_ERROR_LEDGER_DEPTH; i++) {
-        ledger->entries[i].task_id = owner;
-        ledger->entries[i].status = ASX_OK;
-        ledger->entries[i].operation = "";
-        ledger->entries[i].file = "";
-        ledger->entries[i].line = 0;
-        ledger->entries[i].sequence = 0;
+}
+
+static asx_error_ledger_record *asx_task_ledger_ring(const asx_task_ledger *ledger)
+{
+    if (ledger == &g_fallback_ledger) {
+        return g_fallback_ring;
+    }
+    return g_ledger_pool[ledger->ring - 1u];
+}
+
+/* Hand a pool ring to the ledger at slot, reclaiming the oldest one
+ * once every ring is in use. */
+static void asx_task_ledger_attach_ring(asx_task_ledger *ledger, uint16_t slot)
+{
+    uint32_t r;
+
+    if (g_ledger_pool_used < ASX_ERROR_LEDGER_RINGS) {
+        r = g_ledger_pool_used++;
+    } else {
+        asx_task_ledger *victim;
+
+        r = g_ledger_pool_hand;
+        g_ledger_pool_hand = (r + 1u) % ASX_ERROR_LEDGER_RINGS;
+        victim = &g_task_ledgers[g_ledger_pool_slot[r]];
+        victim->ring = 0;
+        asx_task_ledger_clear(victim, ASX_INVALID_ID);
     }
+    g_ledger_pool_slot[r] = slot;
+    ledger->ring = (uint16_t)(r + 1u);
 }
 
 static int asx_error_ledger_is_task_id(asx_task_id task_id)
@@ -65,7 +139,7 @@ static int asx_error_ledger_is_task_id(asx_task_id task_id)
 
 static asx_task_ledger *asx_error_ledger_slot_for_task(asx_task_id task_id)
 {
-    uint16_t slot;
+    uint32_t slot;
 
     if (!asx_error_ledger_is_task_id(task_id)) {
         return &g_fallback_ledger;
@@ -78,12 +152,24 @@ static asx_task_ledger *asx_error_ledger_slot_for_task(asx_task_id task_id)
     return &g_task_ledgers[slot];
 }
 
+/* A task handle's state bits change as it runs; its slot and
+ * generation name it. */
+static int asx_task_ledger_owned_by(const asx_task_ledger *ledger,
+                                    asx_task_id task_id)
+{
+    if (ledger == &g_fallback_ledger) {
+        return ledger->owner == task_id;
+    }
+    return ledger->owner != ASX_INVALID_ID &&
+           asx_handle_index(ledger->owner) == asx_handle_index(task_id);
+}
+
 static const asx_task_ledger *asx_error_ledger_readonly(asx_task_id task_id)
 {
     const asx_task_ledger *ledger;
 
     ledger = asx_error_ledger_slot_for_task(task_id);
-    if (ledger->owner != task_id) {
+    if (!asx_task_ledger_owned_by(ledger, task_id)) {
         return NULL;
     }
     return ledger;
@@ -96,6 +182,7 @@ static void asx_error_ledger_record_impl(asx_task_id task_id,
                                          uint32_t line)
 {
     asx_task_ledger *ledger;
+    asx_error_ledger_record *rec;
     uint32_t index;
 
     if (status == ASX_OK) {
@@ -103,24 +190,35 @@ static void asx_error_ledger_record_impl(asx_task_id task_id,
     }
 
     ledger = asx_error_ledger_slot_for_task(task_id);
-    if (ledger->owner != task_id) {
+    if (ledger == &g_fallback_ledger) {
+        ledger_lock();
+    }
+    if (!asx_task_ledger_owned_by(ledger, task_id)) {
         asx_task_ledger_clear(ledger, task_id);
     }
+    if (ledger != &g_fallback_ledger && ledger->ring == 0u) {
+        ledger_lock();
+        asx_task_ledger_attach_ring(ledger, (uint16_t)asx_handle_slot(task_id));
+        ledger_unlock();
+    }
 
     index = ledger->write_index;
-    ledger->entries[index].task_id = task_id;
-    ledger->entries[index].status = status;
-    ledger->entries[index].operation = (operation != NULL) ? operation : "";
-    ledger->entries[index].file = (file != NULL) ? file : "";
-    ledger->entries[index].line = line;
-    ledger->entries[index].sequence = ledger->next_sequence++;
-
-    ledger->write_index = (index + 1u) % ASX_ERROR_LEDGER_DEPTH;
+    rec = &asx_task_ledger_ring(ledger)[index];
+    rec->status = status;
+    rec->operation = (operation != NULL) ? operation : "";
+    rec->file = (file != NULL) ? file : "";
+    rec->line = line;
+    rec->sequence = ledger->next_sequence++;
+
+    ledger->write_index = (uint8_t)((index + 1u) % ASX_ERROR_LEDGER_DEPTH);
     if (ledger->used < ASX_ERROR_LEDGER_DEPTH) {
         ledger->used++;
     } else {
         ledger->overflowed = 1;
     }
+    if (ledger == &g_fallback_ledger) {
+        ledger_unlock();
+    }
 }
 
 const char *asx_status_str(asx_status s)
@@ -186,23 +284,21 @@ const char *asx_status_str(asx_status s)
 
 void asx_error_ledger_reset(void)
 {
-    uint32_t i;
-
-    for (i = 0; i < ASX_ERROR_LEDGER_TASK_SLOTS; i++) {
-        asx_task_ledger_clear(&g_task_ledgers[i], ASX_INVALID_ID);
-    }
+    memset(g_task_ledgers, 0, sizeof(g_task_ledgers));
     asx_task_ledger_clear(&g_fallback_ledger, ASX_INVALID_ID);
-    g_bound_task = ASX_INVALID_ID;
+    g_ledger_pool_used = 0;
+    g_ledger_pool_hand = 0;
+    g_asx_ledger_bound_task = ASX_INVALID_ID;
 }
 
 void asx_error_ledger_bind_task(asx_task_id task_id)
 {
-    g_bound_task = task_id;
+    g_asx_ledger_bound_task = task_id;
 }
 
 asx_task_id asx_error_ledger_bound_task(void)
 {
-    return g_bound_task;
+    return g_asx_ledger_bound_task;
 }
 
 void asx_error_ledger_record_current(asx_status status,
@@ -210,7 +306,7 @@ void asx_error_ledger_record_current(asx_status status,
                                      const char *file,
                                      uint32_t line)
 {
-    asx_error_ledger_record_impl(g_bound_task, status, operation, file, line);
+    asx_error_ledger_record_impl(g_asx_ledger_bound_task, status, operation, file, line);
 }
 
 void asx_error_ledger_record_for_task(asx_task_id task_id,
@@ -249,6 +345,7 @@ int asx_error_ledger_get(asx_task_id task_id,
                          asx_error_ledger_entry *out_entry)
 {
     const asx_task_ledger *ledger;
+    const asx_error_ledger_record *rec;
     uint32_t oldest;
     uint32_t logical_index;
 
@@ -265,7 +362,13 @@ int asx_error_ledger_get(asx_task_id task_id,
         ? 0u
         : ledger->write_index;
     logical_index = (oldest + index) % ASX_ERROR_LEDGER_DEPTH;
-    *out_entry = ledger->entries[logical_index];
+    rec = &asx_task_ledger_ring(ledger)[logical_index];
+    out_entry->task_id = task_id;
+    out_entry->status = rec->status;
+    out_entry->operation = rec->operation;
+    out_entry->file = rec->file;
+    out_entry->line = rec->line;
+    out_entry->sequence = rec->sequence;
     return 1;
 }
 
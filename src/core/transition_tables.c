@@ -1,7 +1,8 @@
 /*
  * transition_tables.c — state machine transition authority tables
  *
- * Transition legality is encoded as lookup tables. O(1) validation.
+ * Out-of-line transition checks over the packed masks in transition.h,
+ * plus state predicates and names.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -9,29 +10,16 @@
 #include <asx/core/transition.h>
 
 /*
- * Region transition authority table.
- * region_transitions[from][to] = 1 if legal, 0 if forbidden.
+ * The authority tables are the ASX_*_NEXT_* masks in transition.h.
  *
- * Legal transitions:
+ * Region:
  *   Open -> Closing
  *   Closing -> Draining
  *   Closing -> Finalizing  (fast path: no children)
  *   Draining -> Finalizing
  *   Finalizing -> Closed
- */
-static const int region_transitions[5][5] = {
-    /* To:  Open  Clos  Drain Final Closed */
-    /*Open*/  {0,    1,    0,    0,    0},
-    /*Clos*/  {0,    0,    1,    1,    0},
-    /*Drain*/ {0,    0,    0,    1,    0},
-    /*Final*/ {0,    0,    0,    0,    1},
-    /*Closed*/{0,    0,    0,    0,    0}
-};
-
-/*
- * Task transition authority table.
  *
- * Legal transitions:
+ * Task:
  *   Created -> Running          (T1: first poll)
  *   Created -> CancelRequested  (T2: cancel before first poll)
  *   Created -> Completed        (T3: error at spawn)
@@ -45,46 +33,26 @@ static const int region_transitions[5][5] = {
  *   Cancelling -> Cancelling    (T9: strengthen)
  *   Finalizing -> Completed     (T13: finalize done)
  *   Finalizing -> Finalizing    (T12: strengthen)
- */
-static const int task_transitions[6][6] = {
-    /* To:   Creat  Run   CanR  Cling Final Comp */
-    /*Creat*/ {0,    1,    1,    0,    0,    1},
-    /*Run*/   {0,    0,    1,    0,    0,    1},
-    /*CanR*/  {0,    0,    1,    1,    0,    1},
-    /*Cling*/ {0,    0,    0,    1,    1,    1},
-    /*Final*/ {0,    0,    0,    0,    1,    1},
-    /*Comp*/  {0,    0,    0,    0,    0,    0}
-};
-
-/*
- * Obligation transition authority table.
  *
- * Legal transitions:
+ * Obligation:
  *   Reserved -> Committed
  *   Reserved -> Aborted
  *   Reserved -> Leaked
  */
-static const int obligation_transitions[4][4] = {
-    /* To:    Res   Comm  Abort Leaked */
-    /*Res*/   {0,    1,    1,    1},
-    /*Comm*/  {0,    0,    0,    0},
-    /*Abort*/ {0,    0,    0,    0},
-    /*Leaked*/{0,    0,    0,    0}
-};
 
 asx_status asx_region_transition_check(asx_region_state from, asx_region_state to) {
     if ((unsigned)from > 4 || (unsigned)to > 4) return ASX_E_INVALID_ARGUMENT;
-    return region_transitions[from][to] ? ASX_OK : ASX_E_INVALID_TRANSITION;
+    return asx_region_transition_legal(from, to) ? ASX_OK : ASX_E_INVALID_TRANSITION;
 }
 
 asx_status asx_task_transition_check(asx_task_state from, asx_task_state to) {
     if ((unsigned)from > 5 || (unsigned)to > 5) return ASX_E_INVALID_ARGUMENT;
-    return task_transitions[from][to] ? ASX_OK : ASX_E_INVALID_TRANSITION;
+    return asx_task_transition_legal(from, to) ? ASX_OK : ASX_E_INVALID_TRANSITION;
 }
 
 asx_status asx_obligation_transition_check(asx_obligation_state from, asx_obligation_state to) {
     if ((unsigned)from > 3 || (unsigned)to > 3) return ASX_E_INVALID_ARGUMENT;
-    return obligation_transitions[from][to] ? ASX_OK : ASX_E_INVALID_TRANSITION;
+    return asx_obligation_transition_legal(from, to) ? ASX_OK : ASX_E_INVALID_TRANSITION;
 }
 
 int asx_region_can_spawn(asx_region_state s) {
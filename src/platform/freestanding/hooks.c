@@ -1,5 +1,18 @@
 /*
- * freestanding/hooks.c — freestanding platform adapter (minimal hooks only)
+ * freestanding/hooks.c — freestanding platform adapter
+ *
+ * Hooks for MCU-class targets with no OS underneath:
+ *   - a fixed-block pool allocator over a caller-supplied static
+ *     region (O(1) alloc and free through an intrusive free list, no
+ *     fragmentation),
+ *   - a clock hook fed by a hardware tick counter of any width,
+ *     extended to 64 bits across wraps,
+ *   - a reactor wait hook that sleeps the core with WFI until an
+ *     interrupt handler signals a line, then wakes the tasks parked on
+ *     that line.
+ *
+ * Uses only <stddef.h>/<stdint.h>. Interrupt handlers may only call
+ * asx_platform_wfi_signal; everything else runs on the scheduler.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -8,5 +21,297 @@
 typedef int asx_freestanding_hooks_stub;
 
 #ifdef ASX_PROFILE_FREESTANDING
-/* Stub: freestanding hooks pending */
+
+#include <asx/asx_config.h>
+#include <asx/runtime/waker.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* -------------------------------------------------------------------
+ * Fixed-block pool allocator
+ * ------------------------------------------------------------------- */
+
+/* A free block stores the link to the next free block in place */
+typedef struct pool_free_block {
+    struct pool_free_block *next;
+} pool_free_block;
+
+/* Blocks are aligned for any of the runtime's scalar types */
+#define POOL_ALIGN (sizeof(uint64_t) > sizeof(void *) ? sizeof(uint64_t) \
+                                                       : sizeof(void *))
+
+asx_status asx_platform_pool_init(asx_platform_pool *pool, void *region,
+                                  size_t region_size, size_t block_size)
+{
+    uintptr_t start;
+    uintptr_t end;
+    pool_free_block *prev = NULL;
+    uint32_t i;
+
+    if (pool == NULL || region == NULL || block_size == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (block_size > (size_t)-1 - POOL_ALIGN) return ASX_E_INVALID_ARGUMENT;
+    block_size = (block_size + POOL_ALIGN - 1u) & ~(POOL_ALIGN - 1u);
+
+    start = ((uintptr_t)region + POOL_ALIGN - 1u) & ~(uintptr_t)(POOL_ALIGN - 1u);
+    end = (uintptr_t)region + region_size;
+    if (end < (uintptr_t)region || start >= end ||
+        (end - start) / block_size == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    pool->base = (uint8_t *)start;
+    pool->block_size = block_size;
+    pool->block_count = (end - start) / block_size > UINT32_MAX
+                      ? UINT32_MAX : (uint32_t)((end - start) / block_size);
+    pool->free_count = pool->block_count;
+    pool->free_head = NULL;
+
+    /* Thread the free list in address order */
+    for (i = 0; i < pool->block_count; i++) { /* ASX_CHECKPOINT_WAIVER("one-time init bounded by block_count") */
+        pool_free_block *b = (pool_free_block *)(void *)
+            (pool->base + (size_t)i * block_size);
+        b->next = NULL;
+        if (prev == NULL) {
+            pool->free_head = b;
+        } else {
+            prev->next = b;
+        }
+        prev = b;
+    }
+    return ASX_OK;
+}
+
+/* Is ptr the start of one of the pool's blocks? */
+static int pool_owns(const asx_platform_pool *pool, const void *ptr)
+{
+    uintptr_t off;
+
+    if ((uintptr_t)ptr < (uintptr_t)pool->base) return 0;
+    off = (uintptr_t)ptr - (uintptr_t)pool->base;
+    return off / pool->block_size < pool->block_count &&
+           off % pool->block_size == 0;
+}
+
+void *asx_platform_pool_alloc(void *ctx, size_t size)
+{
+    asx_platform_pool *pool = (asx_platform_pool *)ctx;
+    pool_free_block *b;
+
+    if (pool == NULL || size > pool->block_size) return NULL;
+    b = (pool_free_block *)pool->free_head;
+    if (b == NULL) return NULL;
+    pool->free_head = b->next;
+    pool->free_count--;
+    return b;
+}
+
+void asx_platform_pool_free(void *ctx, void *ptr)
+{
+    asx_platform_pool *pool = (asx_platform_pool *)ctx;
+    pool_free_block *b = (pool_free_block *)ptr;
+
+    if (pool == NULL || ptr == NULL || !pool_owns(pool, ptr)) return;
+    b->next = (pool_free_block *)pool->free_head;
+    pool->free_head = b;
+    pool->free_count++;
+}
+
+void *asx_platform_pool_realloc(void *ctx, void *ptr, size_t size)
+{
+    asx_platform_pool *pool = (asx_platform_pool *)ctx;
+
+    if (ptr == NULL) return asx_platform_pool_alloc(ctx, size);
+    if (size == 0) {
+        asx_platform_pool_free(ctx, ptr);
+        return NULL;
+    }
+    /* Every block has the same capacity: it fits in place or not at all */
+    if (pool == NULL || size > pool->block_size || !pool_owns(pool, ptr)) {
+        return NULL;
+    }
+    return ptr;
+}
+
+asx_status asx_platform_pool_install(asx_platform_pool *pool,
+                                     asx_runtime_hooks *hooks)
+{
+    if (pool == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->allocator.ctx = pool;
+    hooks->allocator.malloc_fn = asx_platform_pool_alloc;
+    hooks->allocator.realloc_fn = asx_platform_pool_realloc;
+    hooks->allocator.free_fn = asx_platform_pool_free;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Tick-counter clock
+ * ------------------------------------------------------------------- */
+
+asx_status asx_platform_tick_clock_init(asx_platform_tick_clock *clock,
+                                        asx_platform_tick_read_fn read,
+                                        void *read_ctx, uint64_t hz,
+                                        uint32_t counter_bits)
+{
+    if (clock == NULL || read == NULL || hz == 0 ||
+        counter_bits == 0 || counter_bits > 64u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    clock->read = read;
+    clock->read_ctx = read_ctx;
+    clock->hz = hz;
+    clock->counter_mask = counter_bits == 64u
+                        ? UINT64_MAX : (((uint64_t)1 << counter_bits) - 1u);
+    clock->last_raw = read(read_ctx) & clock->counter_mask;
+    clock->wrap_ticks = 0;
+    return ASX_OK;
+}
+
+asx_time asx_platform_tick_now_ns(void *ctx)
+{
+    asx_platform_tick_clock *clock = (asx_platform_tick_clock *)ctx;
+    uint64_t raw;
+    uint64_t ticks;
+
+    if (clock == NULL || clock->read == NULL) return 0;
+    raw = clock->read(clock->read_ctx) & clock->counter_mask;
+    if (raw < clock->last_raw) {
+        clock->wrap_ticks += clock->counter_mask + 1u; /* 0 for 64-bit */
+    }
+    clock->last_raw = raw;
+    ticks = clock->wrap_ticks + raw;
+
+    /* Split to keep ticks * 1e9 from overflowing */
+    return (asx_time)((ticks / clock->hz) * 1000000000u +
+                      (ticks % clock->hz) * 1000000000u / clock->hz);
+}
+
+asx_status asx_platform_tick_clock_install(asx_platform_tick_clock *clock,
+                                           asx_runtime_hooks *hooks)
+{
+    if (clock == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->clock.ctx = clock;
+    hooks->clock.now_ns_fn = asx_platform_tick_now_ns;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * WFI reactor
+ * ------------------------------------------------------------------- */
+
+#if defined(__arm__) && defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+#define WFI_MASK()   __asm__ volatile("cpsid i" ::: "memory")
+#define WFI_UNMASK() __asm__ volatile("cpsie i" ::: "memory")
+#define WFI_SLEEP()  __asm__ volatile("wfi" ::: "memory")
+#elif defined(__riscv)
+#define WFI_MASK()   __asm__ volatile("csrc mstatus, 8" ::: "memory")
+#define WFI_UNMASK() __asm__ volatile("csrs mstatus, 8" ::: "memory")
+#define WFI_SLEEP()  __asm__ volatile("wfi" ::: "memory")
+#else
+#define WFI_MASK()   ((void)0)
+#define WFI_UNMASK() ((void)0)
+#define WFI_SLEEP()  ((void)0)  /* no sleep instruction: poll */
 #endif
+
+/* Sleep until an interrupt unless a line is already pending. WFI wakes
+ * on a pending interrupt even while masked, so one raised between the
+ * check and the sleep is not lost. */
+void asx_platform_wfi_idle(void *ctx, volatile uint32_t *pending)
+{
+    (void)ctx;
+    WFI_MASK();
+    if (*pending == 0u) WFI_SLEEP();
+    WFI_UNMASK();
+}
+
+static uint32_t wfi_take_pending(asx_platform_wfi_reactor *r)
+{
+    uint32_t mask;
+
+    WFI_MASK();
+    mask = r->pending;
+    r->pending = 0;
+    WFI_UNMASK();
+    return mask;
+}
+
+asx_status asx_platform_wfi_init(asx_platform_wfi_reactor *r,
+                                 asx_platform_idle_fn idle, void *idle_ctx,
+                                 asx_platform_tick_clock *clock)
+{
+    uint32_t i;
+
+    if (r == NULL) return ASX_E_INVALID_ARGUMENT;
+    r->pending = 0;
+    r->idle = idle != NULL ? idle : asx_platform_wfi_idle;
+    r->idle_ctx = idle_ctx;
+    r->clock = clock;
+    for (i = 0; i < ASX_PLATFORM_WFI_LINES; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PLATFORM_WFI_LINES") */
+        r->signals[i] = 0;
+    }
+    return ASX_OK;
+}
+
+void asx_platform_wfi_signal(asx_platform_wfi_reactor *r, uint32_t line)
+{
+    if (r == NULL || line >= ASX_PLATFORM_WFI_LINES) return;
+    /* Single-core target: a read-modify-write from an ISR cannot be
+     * torn by the scheduler, which masks interrupts to take the mask */
+    r->pending |= (uint32_t)1u << line;
+}
+
+uint64_t asx_platform_wfi_key(const asx_platform_wfi_reactor *r, uint32_t line)
+{
+    if (r == NULL || line >= ASX_PLATFORM_WFI_LINES) return 0;
+    return asx_park_key_io(&r->signals[line]);
+}
+
+asx_status asx_platform_wfi_wait(void *ctx, uint32_t timeout_ms,
+                                 uint32_t *ready_count)
+{
+    asx_platform_wfi_reactor *r = (asx_platform_wfi_reactor *)ctx;
+    asx_time deadline = 0;
+    uint32_t mask;
+    uint32_t line;
+    uint32_t n = 0;
+
+    if (r == NULL || ready_count == NULL) return ASX_E_INVALID_ARGUMENT;
+    *ready_count = 0;
+
+    if (r->pending == 0u && timeout_ms > 0) {
+        int bounded = timeout_ms != UINT32_MAX && r->clock != NULL;
+        if (bounded) {
+            deadline = asx_platform_tick_now_ns(r->clock) +
+                       (asx_time)timeout_ms * 1000000u;
+        }
+        for (;;) { /* ASX_CHECKPOINT_WAIVER("idle sleep; ends on a signal or the deadline") */
+            r->idle(r->idle_ctx, &r->pending);
+            if (r->pending != 0u) break;
+            /* Without a clock one interrupt ends a bounded wait */
+            if (timeout_ms != UINT32_MAX && !bounded) break;
+            if (bounded && asx_platform_tick_now_ns(r->clock) >= deadline) break;
+        }
+    }
+
+    mask = wfi_take_pending(r);
+    for (line = 0; mask != 0u; line++, mask >>= 1) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PLATFORM_WFI_LINES") */
+        if ((mask & 1u) == 0u) continue;
+        r->signals[line]++;
+        n++;
+        (void)asx_wake_source(ASX_PARK_IO, asx_park_key_io(&r->signals[line]));
+    }
+    *ready_count = n;
+    return ASX_OK;
+}
+
+asx_status asx_platform_wfi_install(asx_platform_wfi_reactor *r,
+                                    asx_runtime_hooks *hooks)
+{
+    if (r == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->reactor.ctx = r;
+    hooks->reactor.wait_fn = asx_platform_wfi_wait;
+    return ASX_OK;
+}
+
+#endif /* ASX_PROFILE_FREESTANDING */
@@ -1,11 +1,1659 @@
 /*
- * posix/hooks.c — POSIX platform adapter (stub)
+ * posix/hooks.c — POSIX platform adapter
+ *
+ * Provides the worker-dispatch thread hook on a persistent pthread pool.
+ * Helper threads are created lazily on first use and park on a condition
+ * variable between dispatches; the calling thread always acts as worker
+ * 0, so a dispatch of N workers wakes N-1 helpers. If a helper cannot be
+ * created, its share runs on the calling thread instead. The thread
+ * hook's yield is sched_yield; on Linux it also pins threads to CPU
+ * sets and counts their involuntary context switches.
+ * Also provides a stdio file sink for streamed trace chunks,
+ * read-only file mapping (mmap) for replay references, and a
+ * huge-page mapping allocator for the region arenas, optionally bound
+ * to a NUMA node.
+ *
+ * Live-mode hooks: a CLOCK_MONOTONIC clock (the default now_ns_fn on
+ * this profile), an opt-in CPU-counter fast clock calibrated against
+ * it, OS entropy (getrandom on Linux, /dev/urandom
+ * elsewhere), and a readiness reactor on epoll (Linux) or kqueue
+ * (BSD, macOS) for the reactor wait hook, and on Linux an optional
+ * io_uring backend that queues reads and writes for tasks, submits
+ * them in one batch per wait and wakes each owner on completion.
+ * Readiness sources tie registered fds to the tasks armed on them,
+ * edge-triggered and one-shot, so a wait wakes exactly those tasks.
+ * Asynchronous file writes and fsyncs (the file hook) run on that ring
+ * or, without io_uring, on a helper thread whose finished ops the
+ * scheduler thread completes from the reactor wait hook.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #ifdef ASX_PROFILE_POSIX
-/* Stub: POSIX hooks pending */
+
+#define _POSIX_C_SOURCE 200809L
+#if defined(__APPLE__)
+#define _DARWIN_C_SOURCE
+#elif defined(__linux__)
+#define _GNU_SOURCE /* syscall() for io_uring, thread affinity */
+#endif
+
+#include <asx/asx_config.h>
+#include <asx/runtime/buffer_pool.h>
+#include <asx/runtime/parallel.h>
+#include <asx/runtime/waker.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__linux__)
+#define ASX_POSIX_EPOLL 1
+#include <sys/epoll.h>
+#include <sys/random.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || \
+      defined(__NetBSD__) || defined(__DragonFly__)
+#define ASX_POSIX_KQUEUE 1
+#include <sys/event.h>
+#endif
+
+/* -------------------------------------------------------------------
+ * Worker pool state (guarded by g_pool_lock)
+ * ------------------------------------------------------------------- */
+
+static pthread_mutex_t g_pool_dispatch = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_pool_lock     = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_pool_work     = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  g_pool_done     = PTHREAD_COND_INITIALIZER;
+
+static uint32_t            g_pool_started;    /* helper threads alive */
+static uint64_t            g_pool_generation; /* bumped per dispatch */
+static uint32_t            g_pool_active;     /* workers in current job */
+static uint32_t            g_pool_pending;    /* helpers not yet finished */
+static asx_worker_entry_fn g_pool_entry;
+static void               *g_pool_arg;
+
+static void *pool_thread_main(void *p)
+{
+    uint32_t self = (uint32_t)(uintptr_t)p;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&g_pool_lock);
+    for (;;) { /* ASX_CHECKPOINT_WAIVER("platform worker thread main loop") */
+        asx_worker_entry_fn entry;
+        void *arg;
+
+        while (g_pool_generation == seen) {
+            pthread_cond_wait(&g_pool_work, &g_pool_lock);
+        }
+        seen = g_pool_generation;
+        if (self >= g_pool_active) continue;
+
+        entry = g_pool_entry;
+        arg = g_pool_arg;
+        pthread_mutex_unlock(&g_pool_lock);
+        entry(arg, self);
+        pthread_mutex_lock(&g_pool_lock);
+
+        if (--g_pool_pending == 0) {
+            pthread_cond_signal(&g_pool_done);
+        }
+    }
+    return NULL; /* not reached */
+}
+
+/* Grow the pool to `helpers` threads; returns the number available. */
+static uint32_t pool_ensure_helpers(uint32_t helpers)
+{
+    while (g_pool_started < helpers) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+        pthread_t th;
+        uintptr_t idx = (uintptr_t)g_pool_started + 1u;
+        if (pthread_create(&th, NULL, pool_thread_main, (void *)idx) != 0) {
+            break;
+        }
+        (void)pthread_detach(th);
+        g_pool_started++;
+    }
+    return g_pool_started < helpers ? g_pool_started : helpers;
+}
+
+asx_status asx_platform_worker_dispatch(void *ctx, uint32_t worker_count,
+                                        asx_worker_entry_fn entry, void *arg)
+{
+    uint32_t helpers;
+    uint32_t w;
+
+    (void)ctx;
+    if (entry == NULL || worker_count == 0 || worker_count > ASX_MAX_WORKERS) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (worker_count == 1) {
+        entry(arg, 0);
+        return ASX_OK;
+    }
+
+    pthread_mutex_lock(&g_pool_dispatch);
+
+    pthread_mutex_lock(&g_pool_lock);
+    helpers = pool_ensure_helpers(worker_count - 1u);
+    g_pool_entry = entry;
+    g_pool_arg = arg;
+    g_pool_active = helpers + 1u;
+    g_pool_pending = helpers;
+    g_pool_generation++;
+    pthread_cond_broadcast(&g_pool_work);
+    pthread_mutex_unlock(&g_pool_lock);
+
+    /* Worker 0 plus any shares whose helper could not be created */
+    entry(arg, 0);
+    for (w = helpers + 1u; w < worker_count; w++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+        entry(arg, w);
+    }
+
+    pthread_mutex_lock(&g_pool_lock);
+    while (g_pool_pending > 0) {
+        pthread_cond_wait(&g_pool_done, &g_pool_lock);
+    }
+    pthread_mutex_unlock(&g_pool_lock);
+
+    pthread_mutex_unlock(&g_pool_dispatch);
+    return ASX_OK;
+}
+
+void asx_platform_thread_yield(void *ctx)
+{
+    (void)ctx;
+    sched_yield();
+}
+
+#if defined(__linux__)
+
+asx_status asx_platform_thread_pin(void *ctx, uint64_t cpu_mask)
+{
+    cpu_set_t set;
+    uint32_t cpu;
+
+    (void)ctx;
+    CPU_ZERO(&set);
+    for (cpu = 0; cpu < 64u && cpu < (uint32_t)CPU_SETSIZE; cpu++) { /* ASX_CHECKPOINT_WAIVER("bounded by 64 mask bits") */
+        if ((cpu_mask >> cpu) & 1u) CPU_SET(cpu, &set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_platform_thread_switches(void *ctx, uint64_t *out_count)
+{
+    struct rusage ru;
+
+    (void)ctx;
+    if (out_count == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (getrusage(RUSAGE_THREAD, &ru) != 0) return ASX_E_HOOK_MISSING;
+    *out_count = (uint64_t)ru.ru_nivcsw;
+    return ASX_OK;
+}
+
+#else
+
+asx_status asx_platform_thread_pin(void *ctx, uint64_t cpu_mask)
+{
+    (void)ctx;
+    (void)cpu_mask;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_thread_switches(void *ctx, uint64_t *out_count)
+{
+    (void)ctx;
+    (void)out_count;
+    return ASX_E_HOOK_MISSING;
+}
+
+#endif
+
+/* -------------------------------------------------------------------
+ * Trace file sink
+ * ------------------------------------------------------------------- */
+
+asx_status asx_platform_trace_file_sink(void *ctx, const uint8_t *chunk,
+                                        uint32_t len)
+{
+    FILE *f = (FILE *)ctx;
+
+    if (f == NULL || chunk == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (fwrite(chunk, 1, len, f) != len) return ASX_E_RESOURCE_EXHAUSTED;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Read-only file mapping
+ * ------------------------------------------------------------------- */
+
+asx_status asx_platform_map_file(const char *path, const uint8_t **out_data,
+                                 uint32_t *out_len)
+{
+    struct stat st;
+    void *map;
+    int fd;
+
+    if (path == NULL || out_data == NULL || out_len == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return ASX_E_NOT_FOUND;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 ||
+        (uint64_t)st.st_size > UINT32_MAX) {
+        (void)close(fd);
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    /* The mapping outlives the descriptor */
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED) return ASX_E_RESOURCE_EXHAUSTED;
+
+    *out_data = (const uint8_t *)map;
+    *out_len = (uint32_t)st.st_size;
+    return ASX_OK;
+}
+
+void asx_platform_unmap_file(const uint8_t *data, uint32_t len)
+{
+    if (data != NULL) (void)munmap((void *)(uintptr_t)data, len);
+}
+
+/* -------------------------------------------------------------------
+ * Huge-page arena
+ *
+ * Slices carry a 64-byte header (slice capacity, free-list link) so
+ * payloads stay cache-line aligned. Slices are never split or merged:
+ * region chunks all have one size, so first-fit reuse is exact.
+ * ------------------------------------------------------------------- */
+
+#define HUGE_SLICE_HEADER 64u
+
+typedef struct huge_slice {
+    size_t capacity;                 /* payload bytes */
+    struct huge_slice *next;         /* while on free_slices */
+} huge_slice;
+
+static pthread_mutex_t g_huge_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int huge_owns(const asx_platform_huge_arena *a, const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    return a->base != NULL && p >= a->base && p < a->base + a->size;
+}
+
+static huge_slice *huge_slice_of(void *ptr)
+{
+    return (huge_slice *)(void *)((uint8_t *)ptr - HUGE_SLICE_HEADER);
+}
+
+asx_status asx_platform_huge_arena_open(asx_platform_huge_arena *arena,
+                                        size_t size, size_t min_slice,
+                                        const asx_allocator_hooks *backing)
+{
+    asx_runtime_hooks defaults;
+    void *map = MAP_FAILED;
+
+    if (arena == NULL || size == 0) return ASX_E_INVALID_ARGUMENT;
+    if (size > ((size_t)-1 >> 1)) return ASX_E_INVALID_ARGUMENT;
+    if (backing != NULL && (backing->malloc_fn == NULL || backing->free_fn == NULL)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    size = (size + ASX_PLATFORM_HUGE_PAGE_BYTES - 1u) &
+           ~(ASX_PLATFORM_HUGE_PAGE_BYTES - 1u);
+
+    memset(arena, 0, sizeof(*arena));
+#if defined(MAP_HUGETLB)
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (map != MAP_FAILED) arena->pages = ASX_PLATFORM_PAGES_HUGETLB;
+#endif
+    if (map == MAP_FAILED) {
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) return ASX_E_RESOURCE_EXHAUSTED;
+        arena->pages = ASX_PLATFORM_PAGES_NORMAL;
+#if defined(MADV_HUGEPAGE)
+        if (madvise(map, size, MADV_HUGEPAGE) == 0) {
+            arena->pages = ASX_PLATFORM_PAGES_THP;
+        }
+#endif
+    }
+
+    arena->base = (uint8_t *)map;
+    arena->size = size;
+    arena->min_slice = min_slice != 0 ? min_slice : ASX_PLATFORM_HUGE_MIN_SLICE;
+    if (backing != NULL) {
+        arena->backing = *backing;
+    } else {
+        (void)asx_runtime_hooks_init(&defaults);
+        arena->backing = defaults.allocator;
+    }
+    return ASX_OK;
+}
+
+void asx_platform_huge_arena_close(asx_platform_huge_arena *arena)
+{
+    if (arena == NULL || arena->base == NULL) return;
+    (void)munmap(arena->base, arena->size);
+    arena->base = NULL;
+    arena->size = 0;
+    arena->used = 0;
+    arena->free_slices = NULL;
+}
+
+void *asx_platform_huge_alloc(void *ctx, size_t size)
+{
+    asx_platform_huge_arena *a = (asx_platform_huge_arena *)ctx;
+    huge_slice **link;
+    huge_slice *slice = NULL;
+    size_t need;
+
+    if (a == NULL || size == 0) return NULL;
+    if (size < a->min_slice || size > a->size) {
+        return a->backing.malloc_fn(a->backing.ctx, size);
+    }
+    need = HUGE_SLICE_HEADER + ((size + HUGE_SLICE_HEADER - 1u) &
+                                ~(size_t)(HUGE_SLICE_HEADER - 1u));
+
+    (void)pthread_mutex_lock(&g_huge_lock);
+    for (link = (huge_slice **)&a->free_slices; *link != NULL; link = &(*link)->next) {
+        if ((*link)->capacity >= size) {
+            slice = *link;
+            *link = slice->next;
+            break;
+        }
+    }
+    if (slice == NULL && need <= a->size - a->used) {
+        slice = (huge_slice *)(void *)(a->base + a->used);
+        slice->capacity = need - HUGE_SLICE_HEADER;
+        a->used += need;
+    }
+    (void)pthread_mutex_unlock(&g_huge_lock);
+
+    /* Mapping exhausted: normal pages from the backing allocator */
+    if (slice == NULL) return a->backing.malloc_fn(a->backing.ctx, size);
+    slice->next = NULL;
+    return (uint8_t *)slice + HUGE_SLICE_HEADER;
+}
+
+void asx_platform_huge_free(void *ctx, void *ptr)
+{
+    asx_platform_huge_arena *a = (asx_platform_huge_arena *)ctx;
+    huge_slice *slice;
+
+    if (a == NULL || ptr == NULL) return;
+    if (!huge_owns(a, ptr)) {
+        a->backing.free_fn(a->backing.ctx, ptr);
+        return;
+    }
+    slice = huge_slice_of(ptr);
+    (void)pthread_mutex_lock(&g_huge_lock);
+    slice->next = (huge_slice *)a->free_slices;
+    a->free_slices = slice;
+    (void)pthread_mutex_unlock(&g_huge_lock);
+}
+
+void *asx_platform_huge_realloc(void *ctx, void *ptr, size_t size)
+{
+    asx_platform_huge_arena *a = (asx_platform_huge_arena *)ctx;
+    void *moved;
+    size_t keep;
+
+    if (a == NULL) return NULL;
+    if (ptr == NULL) return asx_platform_huge_alloc(a, size);
+    if (size == 0) {
+        asx_platform_huge_free(a, ptr);
+        return NULL;
+    }
+    if (!huge_owns(a, ptr)) {
+        if (a->backing.realloc_fn != NULL) {
+            return a->backing.realloc_fn(a->backing.ctx, ptr, size);
+        }
+        return NULL;
+    }
+    keep = huge_slice_of(ptr)->capacity;
+    if (size <= keep) return ptr;
+    moved = asx_platform_huge_alloc(a, size);
+    if (moved == NULL) return NULL;
+    memcpy(moved, ptr, keep);
+    asx_platform_huge_free(a, ptr);
+    return moved;
+}
+
+asx_status asx_platform_huge_arena_install(asx_platform_huge_arena *arena,
+                                           asx_runtime_hooks *hooks)
+{
+    if (arena == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (arena->base == NULL) return ASX_E_INVALID_STATE;
+    hooks->allocator.ctx = arena;
+    hooks->allocator.malloc_fn = asx_platform_huge_alloc;
+    hooks->allocator.realloc_fn = asx_platform_huge_realloc;
+    hooks->allocator.free_fn = asx_platform_huge_free;
+    return ASX_OK;
+}
+
+/* mbind(2) by raw syscall, so there is no libnuma dependency */
+#define HUGE_MPOL_PREFERRED 1
+#define HUGE_MPOL_MF_MOVE   (1u << 1)
+
+asx_status asx_platform_huge_arena_bind_node(asx_platform_huge_arena *arena,
+                                             uint32_t node)
+{
+    if (arena == NULL || node >= ASX_PLATFORM_NUMA_MAX_NODES) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (arena->base == NULL) return ASX_E_INVALID_STATE;
+#if defined(__linux__) && defined(SYS_mbind)
+    {
+        unsigned long mask = 1ul << node;
+
+        if (syscall(SYS_mbind, arena->base, arena->size, HUGE_MPOL_PREFERRED,
+                    &mask, (unsigned long)ASX_PLATFORM_NUMA_MAX_NODES + 1ul,
+                    HUGE_MPOL_MF_MOVE) != 0) {
+            return errno == EINVAL ? ASX_E_INVALID_ARGUMENT : ASX_E_HOOK_MISSING;
+        }
+    }
+    return ASX_OK;
+#else
+    return ASX_E_HOOK_MISSING;
+#endif
+}
+
+/* -------------------------------------------------------------------
+ * Monotonic clock
+ * ------------------------------------------------------------------- */
+
+asx_time asx_platform_monotonic_now_ns(void *ctx)
+{
+    struct timespec ts;
+
+    (void)ctx;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) return 0;
+    return (asx_time)ts.tv_sec * 1000000000u + (asx_time)ts.tv_nsec;
+}
+
+/* -------------------------------------------------------------------
+ * Fast clock
+ *
+ * now = base_ns + (ticks - base_ticks) * mult / 2^32. The product is
+ * formed from 32-bit halves so slow counters (mult above 2^32) and long
+ * uptimes do not overflow.
+ * ------------------------------------------------------------------- */
+
+#define FAST_CLOCK_DEFAULT_WINDOW_US 10000u
+#define FAST_CLOCK_MAX_WINDOW_US     1000000u
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+
+static uint64_t fast_ticks(void)
+{
+    uint32_t lo, hi;
+
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/* Invariant TSC: constant rate across P-states and C-states */
+static int fast_ticks_usable(void)
+{
+    unsigned int a, b, c, d;
+
+    if (!__get_cpuid(0x80000000u, &a, &b, &c, &d) || a < 0x80000007u) return 0;
+    if (!__get_cpuid(0x80000007u, &a, &b, &c, &d)) return 0;
+    return (d & (1u << 8)) != 0u;
+}
+
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+
+static uint64_t fast_ticks(void)
+{
+    uint64_t v;
+
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(v) : : "memory");
+    return v;
+}
+
+static int fast_ticks_usable(void)
+{
+    return 1;
+}
+
+#else
+
+static uint64_t fast_ticks(void)
+{
+    return 0;
+}
+
+static int fast_ticks_usable(void)
+{
+    return 0;
+}
+
+#endif
+
+asx_status asx_platform_fast_clock_calibrate(asx_platform_fast_clock *clock,
+                                             uint32_t window_us)
+{
+    asx_time t0, t1, window_ns;
+    uint64_t c0, c1;
+
+    if (clock == NULL || window_us > FAST_CLOCK_MAX_WINDOW_US) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (!fast_ticks_usable()) return ASX_E_HOOK_MISSING;
+    if (window_us == 0) window_us = FAST_CLOCK_DEFAULT_WINDOW_US;
+    window_ns = (asx_time)window_us * 1000u;
+
+    t0 = asx_platform_monotonic_now_ns(NULL);
+    c0 = fast_ticks();
+    do { /* ASX_CHECKPOINT_WAIVER("bounded by window_us <= 1 s") */
+        t1 = asx_platform_monotonic_now_ns(NULL);
+        c1 = fast_ticks();
+    } while (t1 - t0 < window_ns);
+    /* A window stretched past 2 s by preemption is not worth keeping;
+     * below that the shifted dividend fits in 64 bits. */
+    if (c1 <= c0 || t1 - t0 >= ((asx_time)1 << 31)) return ASX_E_HOOK_MISSING;
+
+    clock->mult = ((t1 - t0) << 32) / (c1 - c0);
+    if (clock->mult == 0u) return ASX_E_HOOK_MISSING;
+    clock->base_ns = t1;
+    clock->base_ticks = c1;
+    return ASX_OK;
+}
+
+asx_time asx_platform_fast_now_ns(void *ctx)
+{
+    const asx_platform_fast_clock *clock = (const asx_platform_fast_clock *)ctx;
+    uint64_t d, d_hi, d_lo, m_hi, m_lo;
+
+    if (clock == NULL) return 0;
+    d = fast_ticks() - clock->base_ticks;
+    if (d > ((uint64_t)1 << 63)) d = 0; /* read on a core behind the base */
+    d_hi = d >> 32;
+    d_lo = d & 0xFFFFFFFFu;
+    m_hi = clock->mult >> 32;
+    m_lo = clock->mult & 0xFFFFFFFFu;
+    return clock->base_ns + ((d_hi * m_hi) << 32) + d_hi * m_lo +
+           d_lo * m_hi + ((d_lo * m_lo) >> 32);
+}
+
+asx_status asx_platform_fast_clock_install(asx_platform_fast_clock *clock,
+                                           asx_runtime_hooks *hooks)
+{
+    if (clock == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (clock->mult == 0u) return ASX_E_INVALID_STATE;
+    hooks->clock.ctx = clock;
+    hooks->clock.now_ns_fn = asx_platform_fast_now_ns;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * OS entropy
+ * ------------------------------------------------------------------- */
+
+static asx_status entropy_fill_urandom(uint8_t *p, size_t len)
+{
+    int fd = open("/dev/urandom", O_RDONLY);
+
+    if (fd < 0) return ASX_E_RESOURCE_EXHAUSTED;
+    while (len > 0) { /* ASX_CHECKPOINT_WAIVER("bounded by len; retries EINTR") */
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            (void)close(fd);
+            return ASX_E_RESOURCE_EXHAUSTED;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    (void)close(fd);
+    return ASX_OK;
+}
+
+asx_status asx_platform_entropy_fill(void *buf, size_t len)
+{
+    uint8_t *p = (uint8_t *)buf;
+
+    if (buf == NULL && len > 0) return ASX_E_INVALID_ARGUMENT;
+#if defined(ASX_POSIX_EPOLL)
+    while (len > 0) { /* ASX_CHECKPOINT_WAIVER("bounded by len; retries EINTR") */
+        ssize_t n = getrandom(p, len, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == ENOSYS) return entropy_fill_urandom(p, len);
+        if (n <= 0) return ASX_E_RESOURCE_EXHAUSTED;
+        p += n;
+        len -= (size_t)n;
+    }
+    return ASX_OK;
+#else
+    return entropy_fill_urandom(p, len);
+#endif
+}
+
+uint64_t asx_platform_random_u64(void *ctx)
+{
+    static uint64_t fallback;
+    uint64_t v;
+
+    (void)ctx;
+    if (asx_platform_entropy_fill(&v, sizeof(v)) == ASX_OK) return v;
+
+    /* No OS source: splitmix64 over the clock rather than a fixed value */
+    fallback += asx_platform_monotonic_now_ns(NULL) + 0x9E3779B97F4A7C15ULL;
+    v = fallback;
+    v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    v = (v ^ (v >> 27)) * 0x94D049BB133111EBULL;
+    return v ^ (v >> 31);
+}
+
+/* -------------------------------------------------------------------
+ * Readiness reactor (epoll / kqueue)
+ * ------------------------------------------------------------------- */
+
+static asx_status reactor_errno_status(int err)
+{
+    switch (err) {
+    case EEXIST: return ASX_E_ALREADY_EXISTS;
+    case ENOENT: return ASX_E_NOT_FOUND;
+    case ENOMEM:
+    case ENOSPC:
+    case EMFILE:
+    case ENFILE: return ASX_E_RESOURCE_EXHAUSTED;
+    default:     return ASX_E_INVALID_ARGUMENT;
+    }
+}
+
+asx_status asx_platform_reactor_open(asx_platform_reactor *r)
+{
+    if (r == NULL) return ASX_E_INVALID_ARGUMENT;
+    r->ready_count = 0;
+#if defined(ASX_POSIX_EPOLL)
+    r->fd = epoll_create1(EPOLL_CLOEXEC);
+#elif defined(ASX_POSIX_KQUEUE)
+    r->fd = kqueue();
+    if (r->fd >= 0) (void)fcntl(r->fd, F_SETFD, FD_CLOEXEC);
+#else
+    r->fd = -1;
+    return ASX_E_HOOK_MISSING;
+#endif
+    if (r->fd < 0) return ASX_E_RESOURCE_EXHAUSTED;
+    return ASX_OK;
+}
+
+void asx_platform_reactor_close(asx_platform_reactor *r)
+{
+    if (r == NULL || r->fd < 0) return;
+    (void)close(r->fd);
+    r->fd = -1;
+    r->ready_count = 0;
+}
+
+#if defined(ASX_POSIX_EPOLL)
+
+static asx_status reactor_ctl(asx_platform_reactor *r, int op, int fd,
+                              uint32_t interest, uint64_t token)
+{
+    struct epoll_event ev;
+
+    ev.events = 0;
+    if (interest & ASX_PLATFORM_IO_READ) ev.events |= EPOLLIN;
+    if (interest & ASX_PLATFORM_IO_WRITE) ev.events |= EPOLLOUT;
+    ev.data.u64 = token;
+    if (epoll_ctl(r->fd, op, fd, &ev) != 0) return reactor_errno_status(errno);
+    return ASX_OK;
+}
+
+asx_status asx_platform_reactor_add(asx_platform_reactor *r, int fd,
+                                    uint32_t interest, uint64_t token)
+{
+    if (r == NULL || r->fd < 0 || fd < 0) return ASX_E_INVALID_ARGUMENT;
+    return reactor_ctl(r, EPOLL_CTL_ADD, fd, interest, token);
+}
+
+asx_status asx_platform_reactor_modify(asx_platform_reactor *r, int fd,
+                                       uint32_t interest, uint64_t token)
+{
+    if (r == NULL || r->fd < 0 || fd < 0) return ASX_E_INVALID_ARGUMENT;
+    return reactor_ctl(r, EPOLL_CTL_MOD, fd, interest, token);
+}
+
+asx_status asx_platform_reactor_remove(asx_platform_reactor *r, int fd)
+{
+    if (r == NULL || r->fd < 0 || fd < 0) return ASX_E_INVALID_ARGUMENT;
+    return reactor_ctl(r, EPOLL_CTL_DEL, fd, 0, 0);
+}
+
+asx_status asx_platform_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                     uint32_t *ready_count)
+{
+    asx_platform_reactor *r = (asx_platform_reactor *)ctx;
+    struct epoll_event evs[ASX_PLATFORM_REACTOR_EVENTS];
+    int timeout;
+    int n;
+    int i;
+
+    if (r == NULL || r->fd < 0 || ready_count == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    r->ready_count = 0;
+    *ready_count = 0;
+    timeout = timeout_ms == UINT32_MAX ? -1
+            : (timeout_ms > (uint32_t)INT_MAX ? INT_MAX : (int)timeout_ms);
+
+    n = epoll_wait(r->fd, evs, (int)ASX_PLATFORM_REACTOR_EVENTS, timeout);
+    if (n < 0) return errno == EINTR ? ASX_OK : ASX_E_INVALID_STATE;
+
+    for (i = 0; i < n; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PLATFORM_REACTOR_EVENTS") */
+        asx_platform_io_event *out = &r->ready[i];
+        uint32_t e = evs[i].events;
+        out->token = evs[i].data.u64;
+        out->events = 0;
+        if (e & EPOLLIN) out->events |= ASX_PLATFORM_IO_READ;
+        if (e & EPOLLOUT) out->events |= ASX_PLATFORM_IO_WRITE;
+        if (e & EPOLLHUP) out->events |= ASX_PLATFORM_IO_HANGUP;
+        if (e & EPOLLERR) out->events |= ASX_PLATFORM_IO_ERROR;
+    }
+    r->ready_count = (uint32_t)n;
+    *ready_count = (uint32_t)n;
+    return ASX_OK;
+}
+
+#elif defined(ASX_POSIX_KQUEUE)
+
+/* Apply one filter change; a missing filter on delete is not an error. */
+static asx_status reactor_filter(asx_platform_reactor *r, int fd,
+                                 short filter, int on, uint64_t token)
+{
+    struct kevent kev;
+
+    EV_SET(&kev, (uintptr_t)fd, filter, on ? (EV_ADD | EV_ENABLE) : EV_DELETE,
+           0, 0, (void *)(uintptr_t)token);
+    if (kevent(r->fd, &kev, 1, NULL, 0, NULL) != 0) {
+        if (!on && errno == ENOENT) return ASX_OK;
+        return reactor_errno_status(errno);
+    }
+    return ASX_OK;
+}
+
+static asx_status reactor_set(asx_platform_reactor *r, int fd,
+                              uint32_t interest, uint64_t token)
+{
+    asx_status st;
+
+    st = reactor_filter(r, fd, EVFILT_READ,
+                        (interest & ASX_PLATFORM_IO_READ) != 0, token);
+    if (st != ASX_OK) return st;
+    return reactor_filter(r, fd, EVFILT_WRITE,
+                          (interest & ASX_PLATFORM_IO_WRITE) != 0, token);
+}
+
+asx_status asx_platform_reactor_add(asx_platform_reactor *r, int fd,
+                                    uint32_t interest, uint64_t token)
+{
+    if (r == NULL || r->fd < 0 || fd < 0) return ASX_E_INVALID_ARGUMENT;
+    return reactor_set(r, fd, interest, token);
+}
+
+asx_status asx_platform_reactor_modify(asx_platform_reactor *r, int fd,
+                                       uint32_t interest, uint64_t token)
+{
+    if (r == NULL || r->fd < 0 || fd < 0) return ASX_E_INVALID_ARGUMENT;
+    return reactor_set(r, fd, interest, token);
+}
+
+asx_status asx_platform_reactor_remove(asx_platform_reactor *r, int fd)
+{
+    if (r == NULL || r->fd < 0 || fd < 0) return ASX_E_INVALID_ARGUMENT;
+    return reactor_set(r, fd, 0, 0);
+}
+
+asx_status asx_platform_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                     uint32_t *ready_count)
+{
+    asx_platform_reactor *r = (asx_platform_reactor *)ctx;
+    struct kevent evs[ASX_PLATFORM_REACTOR_EVENTS];
+    struct timespec ts;
+    int n;
+    int i;
+
+    if (r == NULL || r->fd < 0 || ready_count == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    r->ready_count = 0;
+    *ready_count = 0;
+    ts.tv_sec = (time_t)(timeout_ms / 1000u);
+    ts.tv_nsec = (long)(timeout_ms % 1000u) * 1000000L;
+
+    n = kevent(r->fd, NULL, 0, evs, (int)ASX_PLATFORM_REACTOR_EVENTS,
+               timeout_ms == UINT32_MAX ? NULL : &ts);
+    if (n < 0) return errno == EINTR ? ASX_OK : ASX_E_INVALID_STATE;
+
+    for (i = 0; i < n; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PLATFORM_REACTOR_EVENTS") */
+        asx_platform_io_event *out = &r->ready[i];
+        out->token = (uint64_t)(uintptr_t)evs[i].udata;
+        out->events = evs[i].filter == EVFILT_WRITE ? ASX_PLATFORM_IO_WRITE
+                                                    : ASX_PLATFORM_IO_READ;
+        if (evs[i].flags & EV_EOF) out->events |= ASX_PLATFORM_IO_HANGUP;
+        if (evs[i].flags & EV_ERROR) out->events |= ASX_PLATFORM_IO_ERROR;
+    }
+    r->ready_count = (uint32_t)n;
+    *ready_count = (uint32_t)n;
+    return ASX_OK;
+}
+
+#else
+
+asx_status asx_platform_reactor_add(asx_platform_reactor *r, int fd,
+                                    uint32_t interest, uint64_t token)
+{
+    (void)r; (void)fd; (void)interest; (void)token;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_reactor_modify(asx_platform_reactor *r, int fd,
+                                       uint32_t interest, uint64_t token)
+{
+    (void)r; (void)fd; (void)interest; (void)token;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_reactor_remove(asx_platform_reactor *r, int fd)
+{
+    (void)r; (void)fd;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                     uint32_t *ready_count)
+{
+    (void)ctx; (void)timeout_ms;
+    if (ready_count != NULL) *ready_count = 0;
+    return ASX_E_HOOK_MISSING;
+}
+
+#endif
+
+asx_status asx_platform_reactor_install(asx_platform_reactor *r,
+                                        asx_runtime_hooks *hooks)
+{
+    if (r == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->reactor.ctx = r;
+    hooks->reactor.wait_fn = asx_platform_reactor_wait;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Readiness sources: edge-triggered, one-shot task wakeups
+ *
+ * Each direction has its own park key, the address of its waiter
+ * field, so a read edge never wakes the writer. epoll one-shot
+ * disarms the whole fd on any event, so a direction still armed after
+ * a dispatch is re-armed; kqueue one-shot filters are per direction.
+ * ------------------------------------------------------------------- */
+
+#if defined(ASX_POSIX_EPOLL)
+
+/* Point the kernel registration at src's armed directions */
+static asx_status io_source_ctl(asx_platform_io_source *src, int op)
+{
+    struct epoll_event ev;
+
+    ev.events = EPOLLET | EPOLLONESHOT;
+    if (src->armed & ASX_PLATFORM_IO_READ) ev.events |= EPOLLIN;
+    if (src->armed & ASX_PLATFORM_IO_WRITE) ev.events |= EPOLLOUT;
+    ev.data.u64 = (uint64_t)(uintptr_t)src;
+    if (epoll_ctl(src->reactor->fd, op, src->fd, &ev) != 0) {
+        return reactor_errno_status(errno);
+    }
+    return ASX_OK;
+}
+
+static asx_status io_source_add(asx_platform_io_source *src)
+{
+    return io_source_ctl(src, EPOLL_CTL_ADD);
+}
+
+static asx_status io_source_rearm(asx_platform_io_source *src, uint32_t interest)
+{
+    (void)interest;
+    return io_source_ctl(src, EPOLL_CTL_MOD);
+}
+
+static asx_status io_source_del(asx_platform_io_source *src)
+{
+    return io_source_ctl(src, EPOLL_CTL_DEL);
+}
+
+#elif defined(ASX_POSIX_KQUEUE)
+
+static asx_status io_source_add(asx_platform_io_source *src)
+{
+    (void)src; /* filters are added as directions are armed */
+    return ASX_OK;
+}
+
+static asx_status io_source_rearm(asx_platform_io_source *src, uint32_t interest)
+{
+    struct kevent kev;
+
+    EV_SET(&kev, (uintptr_t)src->fd,
+           interest == ASX_PLATFORM_IO_READ ? EVFILT_READ : EVFILT_WRITE,
+           EV_ADD | EV_ENABLE | EV_ONESHOT | EV_CLEAR, 0, 0, (void *)src);
+    if (kevent(src->reactor->fd, &kev, 1, NULL, 0, NULL) != 0) {
+        return reactor_errno_status(errno);
+    }
+    return ASX_OK;
+}
+
+static asx_status io_source_del(asx_platform_io_source *src)
+{
+    return reactor_set(src->reactor, src->fd, 0, 0);
+}
+
+#else
+
+static asx_status io_source_add(asx_platform_io_source *src)
+{
+    (void)src;
+    return ASX_E_HOOK_MISSING;
+}
+
+static asx_status io_source_rearm(asx_platform_io_source *src, uint32_t interest)
+{
+    (void)src; (void)interest;
+    return ASX_E_HOOK_MISSING;
+}
+
+static asx_status io_source_del(asx_platform_io_source *src)
+{
+    (void)src;
+    return ASX_E_HOOK_MISSING;
+}
+
+#endif
+
+/* Disarm the directions in fire and wake their tasks */
+static void io_source_fire(asx_platform_io_source *src, uint32_t fire)
+{
+    fire &= src->armed;
+    src->armed &= ~fire;
+    if (fire & ASX_PLATFORM_IO_READ) {
+        src->reader = ASX_INVALID_ID;
+        (void)asx_wake_source(ASX_PARK_IO, asx_park_key_io(&src->reader));
+    }
+    if (fire & ASX_PLATFORM_IO_WRITE) {
+        src->writer = ASX_INVALID_ID;
+        (void)asx_wake_source(ASX_PARK_IO, asx_park_key_io(&src->writer));
+    }
+}
+
+asx_status asx_platform_io_register(asx_platform_reactor *r,
+                                    asx_platform_io_source *src, int fd)
+{
+    asx_status st;
+
+    if (r == NULL || r->fd < 0 || src == NULL || fd < 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    src->reactor = r;
+    src->fd = fd;
+    src->armed = 0;
+    src->events = 0;
+    src->reader = ASX_INVALID_ID;
+    src->writer = ASX_INVALID_ID;
+    st = io_source_add(src);
+    if (st != ASX_OK) {
+        src->reactor = NULL;
+        src->fd = -1;
+    }
+    return st;
+}
+
+asx_status asx_platform_io_arm(asx_platform_io_source *src, asx_task_id task,
+                               uint32_t interest)
+{
+    asx_task_id *holder;
+    int parked = 0;
+    asx_status st;
+
+    if (src == NULL || src->reactor == NULL || src->fd < 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (interest != ASX_PLATFORM_IO_READ && interest != ASX_PLATFORM_IO_WRITE) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    holder = interest == ASX_PLATFORM_IO_READ ? &src->reader : &src->writer;
+    /* A holder woken by cancellation no longer counts */
+    if (*holder != ASX_INVALID_ID && *holder != task &&
+        asx_task_is_parked(*holder, &parked) == ASX_OK && parked) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    src->armed |= interest;
+    st = io_source_rearm(src, interest);
+    if (st == ASX_OK) st = asx_task_park_on_io(task, asx_park_key_io(holder));
+    if (st != ASX_OK) {
+        src->armed &= ~interest; /* a stray kernel edge then wakes nobody */
+        return st;
+    }
+    *holder = task;
+    return ASX_OK;
+}
+
+asx_status asx_platform_io_deregister(asx_platform_io_source *src)
+{
+    asx_status st;
+
+    if (src == NULL || src->reactor == NULL || src->fd < 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = io_source_del(src);
+    io_source_fire(src, ASX_PLATFORM_IO_READ | ASX_PLATFORM_IO_WRITE);
+    src->reactor = NULL;
+    src->fd = -1;
+    return st;
+}
+
+asx_status asx_platform_io_wait(void *ctx, uint32_t timeout_ms,
+                                uint32_t *ready_count)
+{
+    asx_platform_reactor *r = (asx_platform_reactor *)ctx;
+    asx_status st;
+    uint32_t i;
+
+    st = asx_platform_reactor_wait(ctx, timeout_ms, ready_count);
+    if (st != ASX_OK) return st;
+    for (i = 0; i < r->ready_count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PLATFORM_REACTOR_EVENTS") */
+        asx_platform_io_source *src =
+            (asx_platform_io_source *)(uintptr_t)r->ready[i].token;
+        uint32_t ev = r->ready[i].events;
+        uint32_t fire = ev & (ASX_PLATFORM_IO_READ | ASX_PLATFORM_IO_WRITE);
+
+        if (ev & (ASX_PLATFORM_IO_HANGUP | ASX_PLATFORM_IO_ERROR)) {
+            fire = ASX_PLATFORM_IO_READ | ASX_PLATFORM_IO_WRITE;
+        }
+        src->events = ev;
+        io_source_fire(src, fire);
+#if defined(ASX_POSIX_EPOLL)
+        if (src->armed != 0) (void)io_source_ctl(src, EPOLL_CTL_MOD);
+#endif
+    }
+    return ASX_OK;
+}
+
+asx_status asx_platform_io_install(asx_platform_reactor *r,
+                                   asx_runtime_hooks *hooks)
+{
+    if (r == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->reactor.ctx = r;
+    hooks->reactor.wait_fn = asx_platform_io_wait;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * File helper thread (guarded by g_file_lock)
+ *
+ * Submitted ops queue FIFO through backend[0]. The thread moves each
+ * to the finished list once its pwrite or fsync returns; the scheduler
+ * thread takes that list in asx_platform_file_thread_wait and resolves
+ * the obligations, so no runtime state is touched off that thread.
+ * ------------------------------------------------------------------- */
+
+static pthread_mutex_t g_file_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_file_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  g_file_done = PTHREAD_COND_INITIALIZER;
+
+static uint32_t     g_file_started;
+static uint32_t     g_file_inflight;   /* submitted, not yet finished */
+static asx_file_op *g_file_head;       /* submitted, not yet started */
+static asx_file_op *g_file_tail;
+static asx_file_op *g_file_done_head;  /* finished, not yet completed */
+static asx_file_op *g_file_done_tail;
+
+/* Run op to the end: bytes written or -errno */
+static int32_t file_thread_run(const asx_file_op *op)
+{
+    const char *p = (const char *)op->buf;
+    uint32_t left = op->len;
+    int fd = (int)op->handle;
+    ssize_t n;
+
+    if (op->kind == ASX_FILE_OP_FSYNC) return fsync(fd) == 0 ? 0 : -errno;
+    while (left > 0) { /* ASX_CHECKPOINT_WAIVER("platform helper thread, bounded by len") */
+        n = op->offset == UINT64_MAX
+          ? write(fd, p, left)
+          : pwrite(fd, p, left, (off_t)(op->offset + (op->len - left)));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -errno;
+        if (n == 0) break;
+        p += n;
+        left -= (uint32_t)n;
+    }
+    return (int32_t)(op->len - left);
+}
+
+static void *file_thread_main(void *p)
+{
+    (void)p;
+    pthread_mutex_lock(&g_file_lock);
+    for (;;) { /* ASX_CHECKPOINT_WAIVER("platform file thread main loop") */
+        asx_file_op *op;
+        int32_t res;
+
+        while (g_file_head == NULL) {
+            pthread_cond_wait(&g_file_work, &g_file_lock);
+        }
+        op = g_file_head;
+        g_file_head = (asx_file_op *)op->backend[0];
+        if (g_file_head == NULL) g_file_tail = NULL;
+        pthread_mutex_unlock(&g_file_lock);
+        res = file_thread_run(op);
+        pthread_mutex_lock(&g_file_lock);
+
+        op->result = res;
+        op->backend[0] = NULL;
+        if (g_file_done_tail != NULL) g_file_done_tail->backend[0] = op;
+        else g_file_done_head = op;
+        g_file_done_tail = op;
+        g_file_inflight--;
+        pthread_cond_signal(&g_file_done);
+    }
+    return NULL; /* not reached */
+}
+
+asx_status asx_platform_file_thread_submit(void *ctx, asx_file_op *op)
+{
+    pthread_t th;
+
+    (void)ctx;
+    if (op == NULL || op->handle < 0 || op->handle > INT_MAX) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    pthread_mutex_lock(&g_file_lock);
+    if (!g_file_started) {
+        if (pthread_create(&th, NULL, file_thread_main, NULL) != 0) {
+            pthread_mutex_unlock(&g_file_lock);
+            return ASX_E_RESOURCE_EXHAUSTED;
+        }
+        (void)pthread_detach(th);
+        g_file_started = 1;
+    }
+    op->backend[0] = NULL;
+    if (g_file_tail != NULL) g_file_tail->backend[0] = op;
+    else g_file_head = op;
+    g_file_tail = op;
+    g_file_inflight++;
+    pthread_cond_signal(&g_file_work);
+    pthread_mutex_unlock(&g_file_lock);
+    return ASX_OK;
+}
+
+asx_status asx_platform_file_thread_wait(void *ctx, uint32_t timeout_ms,
+                                         uint32_t *ready_count)
+{
+    struct timespec ts;
+    asx_file_op *op;
+    uint32_t n = 0;
+
+    (void)ctx;
+    if (ready_count == NULL) return ASX_E_INVALID_ARGUMENT;
+    pthread_mutex_lock(&g_file_lock);
+    if (g_file_done_head == NULL && g_file_inflight > 0 && timeout_ms > 0) {
+        if (timeout_ms == UINT32_MAX) {
+            while (g_file_done_head == NULL) {
+                pthread_cond_wait(&g_file_done, &g_file_lock);
+            }
+        } else {
+            (void)clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec += (time_t)(timeout_ms / 1000u);
+            ts.tv_nsec += (long)(timeout_ms % 1000u) * 1000000L;
+            if (ts.tv_nsec >= 1000000000L) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000L;
+            }
+            while (g_file_done_head == NULL &&
+                   pthread_cond_timedwait(&g_file_done, &g_file_lock, &ts) == 0) {
+            }
+        }
+    }
+    op = g_file_done_head;
+    g_file_done_head = NULL;
+    g_file_done_tail = NULL;
+    pthread_mutex_unlock(&g_file_lock);
+
+    /* The owner may reuse an op once it is complete */
+    while (op != NULL) { /* ASX_CHECKPOINT_WAIVER("bounded by ops submitted") */
+        asx_file_op *next = (asx_file_op *)op->backend[0];
+        (void)asx_runtime_file_complete(op, op->result);
+        op = next;
+        n++;
+    }
+    *ready_count = n;
+    return ASX_OK;
+}
+
+asx_status asx_platform_file_thread_install(asx_runtime_hooks *hooks)
+{
+    if (hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->reactor.ctx = NULL;
+    hooks->reactor.wait_fn = asx_platform_file_thread_wait;
+    hooks->file.ctx = NULL;
+    hooks->file.submit_fn = asx_platform_file_thread_submit;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * io_uring backend (Linux)
+ *
+ * Raw syscalls against the kernel ABI, no liburing. Ring indices are
+ * shared with the kernel: our tail stores and its head loads pair as
+ * release/acquire.
+ * ------------------------------------------------------------------- */
+
+#if defined(ASX_POSIX_EPOLL)
+
+#define uring_load(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define uring_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static uint32_t *uring_u32(void *base, uint32_t off)
+{
+    return (uint32_t *)(void *)((char *)base + off);
+}
+
+static void uring_unmap(asx_platform_uring *u)
+{
+    if (u->sqes != NULL) (void)munmap(u->sqes, u->sqes_size);
+    if (u->cq_ring != NULL && u->cq_ring != u->sq_ring) {
+        (void)munmap(u->cq_ring, u->cq_ring_size);
+    }
+    if (u->sq_ring != NULL) (void)munmap(u->sq_ring, u->sq_ring_size);
+    u->sqes = NULL;
+    u->cq_ring = NULL;
+    u->sq_ring = NULL;
+}
+
+asx_status asx_platform_uring_open(asx_platform_uring *u, uint32_t entries)
+{
+    struct io_uring_params p;
+    void *map;
+    long fd;
+
+    if (u == NULL || entries == 0 || entries > 4096u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    memset(u, 0, sizeof(*u));
+    u->fd = -1;
+    memset(&p, 0, sizeof(p));
+    fd = syscall(__NR_io_uring_setup, entries, &p);
+    if (fd < 0) {
+        return (errno == ENOMEM || errno == EMFILE || errno == ENFILE)
+             ? ASX_E_RESOURCE_EXHAUSTED : ASX_E_HOOK_MISSING;
+    }
+    u->fd = (int)fd;
+    if (!(p.features & IORING_FEAT_EXT_ARG)) {
+        asx_platform_uring_close(u); /* need timed waits (5.11+) */
+        return ASX_E_HOOK_MISSING;
+    }
+
+    u->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    u->cq_ring_size = p.cq_off.cqes +
+                      p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_ring_size > u->sq_ring_size) u->sq_ring_size = u->cq_ring_size;
+        u->cq_ring_size = u->sq_ring_size;
+    }
+    map = mmap(NULL, u->sq_ring_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, u->fd, (off_t)IORING_OFF_SQ_RING);
+    if (map == MAP_FAILED) goto fail;
+    u->sq_ring = map;
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_ring = map;
+    } else {
+        map = mmap(NULL, u->cq_ring_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, u->fd, (off_t)IORING_OFF_CQ_RING);
+        if (map == MAP_FAILED) goto fail;
+        u->cq_ring = map;
+    }
+    u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    map = mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, u->fd, (off_t)IORING_OFF_SQES);
+    if (map == MAP_FAILED) goto fail;
+    u->sqes = map;
+
+    u->sq_head  = uring_u32(u->sq_ring, p.sq_off.head);
+    u->sq_tail  = uring_u32(u->sq_ring, p.sq_off.tail);
+    u->sq_array = uring_u32(u->sq_ring, p.sq_off.array);
+    u->sq_mask  = *uring_u32(u->sq_ring, p.sq_off.ring_mask);
+    u->cq_head  = uring_u32(u->cq_ring, p.cq_off.head);
+    u->cq_tail  = uring_u32(u->cq_ring, p.cq_off.tail);
+    u->cqes     = (char *)u->cq_ring + p.cq_off.cqes;
+    u->cq_mask  = *uring_u32(u->cq_ring, p.cq_off.ring_mask);
+    u->sq_entries = p.sq_entries;
+    u->cq_entries = p.cq_entries;
+    return ASX_OK;
+
+fail:
+    asx_platform_uring_close(u);
+    return ASX_E_RESOURCE_EXHAUSTED;
+}
+
+void asx_platform_uring_close(asx_platform_uring *u)
+{
+    if (u == NULL) return;
+    uring_unmap(u);
+    if (u->fd >= 0) (void)close(u->fd);
+    u->fd = -1;
+    u->queued = 0;
+    u->inflight = 0;
+    u->fixed_pool = NULL;
+}
+
+/* Whether one more op fits: its completion in the CQ ring, its
+ * submission in the SQ ring */
+static int uring_has_room(const asx_platform_uring *u)
+{
+    return u->inflight + u->queued < u->cq_entries &&
+           *u->sq_tail - uring_load(u->sq_head) < u->sq_entries;
+}
+
+/* Queue one SQE after uring_has_room; the next wait submits it.
+ * File ops are tagged in the low bit of user_data. */
+static void uring_push(asx_platform_uring *u, uint8_t opcode, int fd,
+                       uint64_t addr, uint32_t len, uint64_t offset,
+                       uint64_t user_data)
+{
+    uint32_t tail = *u->sq_tail;
+    struct io_uring_sqe *sqe =
+        &((struct io_uring_sqe *)u->sqes)[tail & u->sq_mask];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = addr;
+    sqe->len = len;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    u->sq_array[tail & u->sq_mask] = tail & u->sq_mask;
+    uring_store(u->sq_tail, tail + 1u);
+    u->queued++;
+}
+
+/* Queue one SQE for op, parking task on it */
+static asx_status uring_queue(asx_platform_uring *u, uint8_t opcode,
+                              asx_platform_uring_op *op, asx_task_id task,
+                              int fd, uint64_t addr, uint32_t len,
+                              uint64_t offset)
+{
+    asx_status st;
+
+    if (u == NULL || u->fd < 0 || op == NULL || fd < 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (!uring_has_room(u)) return ASX_E_RESOURCE_EXHAUSTED;
+    if (task != ASX_INVALID_ID) {
+        st = asx_task_park_on_io(task, asx_park_key_io(op));
+        if (st != ASX_OK) return st;
+    }
+
+    op->task = task;
+    op->result = 0;
+    op->done = 0;
+    uring_push(u, opcode, fd, addr, len, offset, (uint64_t)(uintptr_t)op);
+    return ASX_OK;
+}
+
+asx_status asx_platform_uring_read(asx_platform_uring *u,
+                                   asx_platform_uring_op *op,
+                                   asx_task_id task, int fd, void *buf,
+                                   uint32_t len, uint64_t offset)
+{
+    if (buf == NULL && len > 0) return ASX_E_INVALID_ARGUMENT;
+    return uring_queue(u, IORING_OP_READ, op, task, fd,
+                       (uint64_t)(uintptr_t)buf, len, offset);
+}
+
+asx_status asx_platform_uring_write(asx_platform_uring *u,
+                                    asx_platform_uring_op *op,
+                                    asx_task_id task, int fd,
+                                    const void *buf, uint32_t len,
+                                    uint64_t offset)
+{
+    if (buf == NULL && len > 0) return ASX_E_INVALID_ARGUMENT;
+    return uring_queue(u, IORING_OP_WRITE, op, task, fd,
+                       (uint64_t)(uintptr_t)buf, len, offset);
+}
+
+asx_status asx_platform_uring_register_pool(asx_platform_uring *u,
+                                            const asx_buffer_pool *pool)
+{
+    struct iovec iov;
+
+    if (u == NULL || u->fd < 0 || pool == NULL || pool->base == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (u->fixed_pool != NULL) return ASX_E_ALREADY_EXISTS;
+    iov.iov_base = pool->base;
+    iov.iov_len = (size_t)pool->buffer_size * pool->count;
+    if (syscall(__NR_io_uring_register, u->fd, IORING_REGISTER_BUFFERS,
+                &iov, 1) < 0) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    u->fixed_pool = pool;
+    return ASX_OK;
+}
+
+asx_status asx_platform_uring_read_fixed(asx_platform_uring *u,
+                                         asx_platform_uring_op *op,
+                                         asx_task_id task, int fd,
+                                         const asx_buffer_pool *pool,
+                                         uint64_t handle, uint64_t offset)
+{
+    uint8_t *data;
+
+    if (u == NULL || pool == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (pool != u->fixed_pool ||
+        asx_buffer_get(pool, handle, &data, NULL) != ASX_OK) {
+        return ASX_E_INVALID_STATE;
+    }
+    /* Fixed buffer 0 is the whole pool; buf_index stays zero */
+    return uring_queue(u, IORING_OP_READ_FIXED, op, task, fd,
+                       (uint64_t)(uintptr_t)data, pool->buffer_size, offset);
+}
+
+asx_status asx_platform_uring_file_submit(void *ctx, asx_file_op *op)
+{
+    asx_platform_uring *u = (asx_platform_uring *)ctx;
+
+    if (u == NULL || u->fd < 0 || op == NULL ||
+        op->handle < 0 || op->handle > INT_MAX) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (!uring_has_room(u)) return ASX_E_RESOURCE_EXHAUSTED;
+    if (op->kind == ASX_FILE_OP_FSYNC) {
+        uring_push(u, IORING_OP_FSYNC, (int)op->handle, 0, 0, 0,
+                   (uint64_t)(uintptr_t)op | 1u);
+    } else {
+        uring_push(u, IORING_OP_WRITE, (int)op->handle,
+                   (uint64_t)(uintptr_t)op->buf, op->len, op->offset,
+                   (uint64_t)(uintptr_t)op | 1u);
+    }
+    return ASX_OK;
+}
+
+/* Drain the CQ ring, completing ops and waking their tasks. */
+static uint32_t uring_reap(asx_platform_uring *u)
+{
+    uint32_t head = *u->cq_head;
+    uint32_t tail = uring_load(u->cq_tail);
+    uint32_t n = 0;
+
+    while (head != tail) { /* ASX_CHECKPOINT_WAIVER("bounded by CQ ring size") */
+        const struct io_uring_cqe *cqe =
+            &((const struct io_uring_cqe *)u->cqes)[head & u->cq_mask];
+        uint64_t tag = cqe->user_data;
+        asx_platform_uring_op *op;
+
+        head++;
+        n++;
+        if (tag & 1u) {
+            (void)asx_runtime_file_complete(
+                (asx_file_op *)(uintptr_t)(tag & ~(uint64_t)1u), cqe->res);
+            continue;
+        }
+        op = (asx_platform_uring_op *)(uintptr_t)tag;
+        op->result = cqe->res;
+        op->done = 1;
+        if (op->task != ASX_INVALID_ID) {
+            (void)asx_wake_source(ASX_PARK_IO, asx_park_key_io(op));
+        }
+    }
+    uring_store(u->cq_head, head);
+    u->inflight -= n;
+    return n;
+}
+
+asx_status asx_platform_uring_wait(void *ctx, uint32_t timeout_ms,
+                                   uint32_t *ready_count)
+{
+    asx_platform_uring *u = (asx_platform_uring *)ctx;
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec ts;
+    unsigned flags = 0;
+    unsigned min_complete = 0;
+    long rc;
+
+    if (u == NULL || u->fd < 0 || ready_count == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    *ready_count = uring_reap(u);
+
+    /* One syscall submits the whole batch and, if nothing completed
+     * yet, waits for the first completion */
+    if (*ready_count == 0 && timeout_ms > 0 && u->inflight + u->queued > 0) {
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        min_complete = 1;
+        memset(&arg, 0, sizeof(arg));
+        if (timeout_ms != UINT32_MAX) {
+            ts.tv_sec = (int64_t)(timeout_ms / 1000u);
+            ts.tv_nsec = (long long)(timeout_ms % 1000u) * 1000000LL;
+            arg.ts = (uint64_t)(uintptr_t)&ts;
+        }
+    }
+    if (u->queued == 0 && min_complete == 0) return ASX_OK;
+
+    rc = syscall(__NR_io_uring_enter, u->fd, u->queued, min_complete, flags,
+                 flags != 0 ? (void *)&arg : NULL, sizeof(arg));
+    if (rc < 0) {
+        if (errno != EINTR && errno != ETIME && errno != EBUSY) {
+            return ASX_E_INVALID_STATE;
+        }
+    } else {
+        u->inflight += (uint32_t)rc;
+        u->queued -= (uint32_t)rc;
+    }
+    *ready_count += uring_reap(u);
+    return ASX_OK;
+}
+
+#else
+
+asx_status asx_platform_uring_open(asx_platform_uring *u, uint32_t entries)
+{
+    (void)entries;
+    if (u != NULL) u->fd = -1;
+    return ASX_E_HOOK_MISSING;
+}
+
+void asx_platform_uring_close(asx_platform_uring *u)
+{
+    if (u != NULL) u->fd = -1;
+}
+
+asx_status asx_platform_uring_read(asx_platform_uring *u,
+                                   asx_platform_uring_op *op,
+                                   asx_task_id task, int fd, void *buf,
+                                   uint32_t len, uint64_t offset)
+{
+    (void)u; (void)op; (void)task; (void)fd; (void)buf; (void)len; (void)offset;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_uring_write(asx_platform_uring *u,
+                                    asx_platform_uring_op *op,
+                                    asx_task_id task, int fd,
+                                    const void *buf, uint32_t len,
+                                    uint64_t offset)
+{
+    (void)u; (void)op; (void)task; (void)fd; (void)buf; (void)len; (void)offset;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_uring_register_pool(asx_platform_uring *u,
+                                            const asx_buffer_pool *pool)
+{
+    (void)u; (void)pool;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_uring_read_fixed(asx_platform_uring *u,
+                                         asx_platform_uring_op *op,
+                                         asx_task_id task, int fd,
+                                         const asx_buffer_pool *pool,
+                                         uint64_t handle, uint64_t offset)
+{
+    (void)u; (void)op; (void)task; (void)fd; (void)pool; (void)handle; (void)offset;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_uring_file_submit(void *ctx, asx_file_op *op)
+{
+    (void)ctx; (void)op;
+    return ASX_E_HOOK_MISSING;
+}
+
+asx_status asx_platform_uring_wait(void *ctx, uint32_t timeout_ms,
+                                   uint32_t *ready_count)
+{
+    (void)ctx; (void)timeout_ms;
+    if (ready_count != NULL) *ready_count = 0;
+    return ASX_E_HOOK_MISSING;
+}
+
+#endif
+
+asx_status asx_platform_uring_install(asx_platform_uring *u,
+                                      asx_runtime_hooks *hooks)
+{
+    if (u == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->reactor.ctx = u;
+    hooks->reactor.wait_fn = asx_platform_uring_wait;
+    hooks->file.ctx = u;
+    hooks->file.submit_fn = asx_platform_uring_file_submit;
+    return ASX_OK;
+}
+
 #else
 typedef int asx_no_empty_tu_warning;
 #endif
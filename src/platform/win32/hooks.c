@@ -1,11 +1,432 @@
 /*
- * win32/hooks.c — Win32 platform adapter (stub)
+ * win32/hooks.c — Win32 platform adapter
+ *
+ * Provides the worker-dispatch thread hook on a persistent Win32 thread
+ * pool (SRW lock + condition variables, Vista and later). Mirrors the
+ * POSIX adapter: helpers start lazily, the calling thread is worker 0,
+ * and shares whose helper could not be created run on the caller.
+ * The thread hook also yields (SwitchToThread) and pins threads to CPU
+ * sets (SetThreadAffinityMask).
+ * Also provides a stdio file sink for streamed trace chunks and
+ * read-only file mapping (MapViewOfFile) for replay references.
+ *
+ * Live-mode hooks: a QueryPerformanceCounter clock (the default
+ * now_ns_fn on this profile), BCryptGenRandom entropy, and an I/O
+ * completion port backend for the reactor wait hook that wakes each
+ * operation's task on completion.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #ifdef ASX_PROFILE_WIN32
-/* Stub: Win32 hooks pending */
+
+#include <asx/asx_config.h>
+#include <asx/runtime/parallel.h>
+#include <asx/runtime/waker.h>
+#include <asx/core/affinity.h>
+#include <windows.h>
+#include <bcrypt.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#pragma comment(lib, "bcrypt.lib")
+#endif
+
+/* -------------------------------------------------------------------
+ * Worker pool state (guarded by g_pool_lock)
+ * ------------------------------------------------------------------- */
+
+static SRWLOCK            g_pool_dispatch = SRWLOCK_INIT;
+static SRWLOCK            g_pool_lock     = SRWLOCK_INIT;
+static CONDITION_VARIABLE g_pool_work     = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE g_pool_done     = CONDITION_VARIABLE_INIT;
+
+static uint32_t            g_pool_started;
+static uint64_t            g_pool_generation;
+static uint32_t            g_pool_active;
+static uint32_t            g_pool_pending;
+static asx_worker_entry_fn g_pool_entry;
+static void               *g_pool_arg;
+
+static DWORD WINAPI pool_thread_main(LPVOID p)
+{
+    uint32_t self = (uint32_t)(uintptr_t)p;
+    uint64_t seen = 0;
+
+    AcquireSRWLockExclusive(&g_pool_lock);
+    for (;;) { /* ASX_CHECKPOINT_WAIVER("platform worker thread main loop") */
+        asx_worker_entry_fn entry;
+        void *arg;
+
+        while (g_pool_generation == seen) {
+            (void)SleepConditionVariableSRW(&g_pool_work, &g_pool_lock, INFINITE, 0);
+        }
+        seen = g_pool_generation;
+        if (self >= g_pool_active) continue;
+
+        entry = g_pool_entry;
+        arg = g_pool_arg;
+        ReleaseSRWLockExclusive(&g_pool_lock);
+        entry(arg, self);
+        AcquireSRWLockExclusive(&g_pool_lock);
+
+        if (--g_pool_pending == 0) {
+            WakeConditionVariable(&g_pool_done);
+        }
+    }
+}
+
+static uint32_t pool_ensure_helpers(uint32_t helpers)
+{
+    while (g_pool_started < helpers) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+        uintptr_t idx = (uintptr_t)g_pool_started + 1u;
+        HANDLE th = CreateThread(NULL, 0, pool_thread_main, (LPVOID)idx, 0, NULL);
+        if (th == NULL) break;
+        (void)CloseHandle(th);
+        g_pool_started++;
+    }
+    return g_pool_started < helpers ? g_pool_started : helpers;
+}
+
+asx_status asx_platform_worker_dispatch(void *ctx, uint32_t worker_count,
+                                        asx_worker_entry_fn entry, void *arg)
+{
+    uint32_t helpers;
+    uint32_t w;
+
+    (void)ctx;
+    if (entry == NULL || worker_count == 0 || worker_count > ASX_MAX_WORKERS) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (worker_count == 1) {
+        entry(arg, 0);
+        return ASX_OK;
+    }
+
+    AcquireSRWLockExclusive(&g_pool_dispatch);
+
+    AcquireSRWLockExclusive(&g_pool_lock);
+    helpers = pool_ensure_helpers(worker_count - 1u);
+    g_pool_entry = entry;
+    g_pool_arg = arg;
+    g_pool_active = helpers + 1u;
+    g_pool_pending = helpers;
+    g_pool_generation++;
+    WakeAllConditionVariable(&g_pool_work);
+    ReleaseSRWLockExclusive(&g_pool_lock);
+
+    entry(arg, 0);
+    for (w = helpers + 1u; w < worker_count; w++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+        entry(arg, w);
+    }
+
+    AcquireSRWLockExclusive(&g_pool_lock);
+    while (g_pool_pending > 0) {
+        (void)SleepConditionVariableSRW(&g_pool_done, &g_pool_lock, INFINITE, 0);
+    }
+    ReleaseSRWLockExclusive(&g_pool_lock);
+
+    ReleaseSRWLockExclusive(&g_pool_dispatch);
+    return ASX_OK;
+}
+
+void asx_platform_thread_yield(void *ctx)
+{
+    (void)ctx;
+    (void)SwitchToThread();
+}
+
+asx_status asx_platform_thread_pin(void *ctx, uint64_t cpu_mask)
+{
+    DWORD_PTR mask = (DWORD_PTR)cpu_mask;
+
+    (void)ctx;
+    if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return ASX_OK;
+}
+
+/* Windows keeps no per-thread involuntary switch count */
+asx_status asx_platform_thread_switches(void *ctx, uint64_t *out_count)
+{
+    (void)ctx;
+    (void)out_count;
+    return ASX_E_HOOK_MISSING;
+}
+
+/* -------------------------------------------------------------------
+ * Trace file sink
+ * ------------------------------------------------------------------- */
+
+asx_status asx_platform_trace_file_sink(void *ctx, const uint8_t *chunk,
+                                        uint32_t len)
+{
+    FILE *f = (FILE *)ctx;
+
+    if (f == NULL || chunk == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (fwrite(chunk, 1, len, f) != len) return ASX_E_RESOURCE_EXHAUSTED;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Read-only file mapping
+ * ------------------------------------------------------------------- */
+
+asx_status asx_platform_map_file(const char *path, const uint8_t **out_data,
+                                 uint32_t *out_len)
+{
+    HANDLE file;
+    HANDLE mapping;
+    LARGE_INTEGER size;
+    LPVOID view;
+
+    if (path == NULL || out_data == NULL || out_len == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return ASX_E_NOT_FOUND;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+        (uint64_t)size.QuadPart > UINT32_MAX) {
+        (void)CloseHandle(file);
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    /* The view keeps the mapping alive once both handles are closed */
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    (void)CloseHandle(file);
+    if (mapping == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    (void)CloseHandle(mapping);
+    if (view == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+
+    *out_data = (const uint8_t *)view;
+    *out_len = (uint32_t)size.QuadPart;
+    return ASX_OK;
+}
+
+void asx_platform_unmap_file(const uint8_t *data, uint32_t len)
+{
+    (void)len;
+    if (data != NULL) (void)UnmapViewOfFile(data);
+}
+
+/* -------------------------------------------------------------------
+ * Monotonic clock
+ * ------------------------------------------------------------------- */
+
+asx_time asx_platform_monotonic_now_ns(void *ctx)
+{
+    static LONGLONG freq; /* fixed at boot; racing first reads agree */
+    LARGE_INTEGER now;
+    LARGE_INTEGER f;
+    uint64_t ticks;
+
+    (void)ctx;
+    if (freq == 0) {
+        if (!QueryPerformanceFrequency(&f) || f.QuadPart <= 0) return 0;
+        freq = f.QuadPart;
+    }
+    (void)QueryPerformanceCounter(&now);
+    ticks = (uint64_t)now.QuadPart;
+
+    /* Split to keep ticks * 1e9 from overflowing */
+    return (asx_time)((ticks / (uint64_t)freq) * 1000000000u +
+                      (ticks % (uint64_t)freq) * 1000000000u / (uint64_t)freq);
+}
+
+/* -------------------------------------------------------------------
+ * OS entropy
+ * ------------------------------------------------------------------- */
+
+asx_status asx_platform_entropy_fill(void *buf, size_t len)
+{
+    uint8_t *p = (uint8_t *)buf;
+
+    if (buf == NULL && len > 0) return ASX_E_INVALID_ARGUMENT;
+    while (len > 0) { /* ASX_CHECKPOINT_WAIVER("bounded by len in ULONG steps") */
+        ULONG n = len > 0x7fffffffu ? 0x7fffffffu : (ULONG)len;
+        if (!BCRYPT_SUCCESS(BCryptGenRandom(NULL, p, n,
+                                            BCRYPT_USE_SYSTEM_PREFERRED_RNG))) {
+            return ASX_E_RESOURCE_EXHAUSTED;
+        }
+        p += n;
+        len -= n;
+    }
+    return ASX_OK;
+}
+
+uint64_t asx_platform_random_u64(void *ctx)
+{
+    static uint64_t fallback;
+    uint64_t v;
+
+    (void)ctx;
+    if (asx_platform_entropy_fill(&v, sizeof(v)) == ASX_OK) return v;
+
+    /* No OS source: splitmix64 over the clock rather than a fixed value */
+    fallback += asx_platform_monotonic_now_ns(NULL) + 0x9E3779B97F4A7C15ULL;
+    v = fallback;
+    v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    v = (v ^ (v >> 27)) * 0x94D049BB133111EBULL;
+    return v ^ (v >> 31);
+}
+
+/* -------------------------------------------------------------------
+ * I/O completion port backend
+ * ------------------------------------------------------------------- */
+
+/* The public op reserves the OVERLAPPED as its first member */
+typedef char asx_iocp_overlapped_fits[
+    sizeof(OVERLAPPED) <= sizeof(((asx_platform_iocp_op *)0)->overlapped) ? 1 : -1];
+
+asx_status asx_platform_iocp_open(asx_platform_iocp *io, uint32_t threads)
+{
+    if (io == NULL) return ASX_E_INVALID_ARGUMENT;
+    io->inflight = 0;
+    io->ready_count = 0;
+    io->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0,
+                                      (DWORD)threads);
+    if (io->port == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+    return ASX_OK;
+}
+
+void asx_platform_iocp_close(asx_platform_iocp *io)
+{
+    if (io == NULL || io->port == NULL) return;
+    (void)CloseHandle((HANDLE)io->port);
+    io->port = NULL;
+    io->inflight = 0;
+    io->ready_count = 0;
+}
+
+asx_status asx_platform_iocp_associate(asx_platform_iocp *io, void *handle)
+{
+    if (io == NULL || io->port == NULL || handle == NULL ||
+        (HANDLE)handle == INVALID_HANDLE_VALUE) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (CreateIoCompletionPort((HANDLE)handle, (HANDLE)io->port, 0, 0) == NULL) {
+        return GetLastError() == ERROR_INVALID_PARAMETER
+             ? ASX_E_ALREADY_EXISTS : ASX_E_INVALID_ARGUMENT;
+    }
+    return ASX_OK;
+}
+
+/* Issue one overlapped transfer for op and park task on it. */
+static asx_status iocp_issue(asx_platform_iocp *io, asx_platform_iocp_op *op,
+                             asx_task_id task, void *handle, void *buf,
+                             uint32_t len, uint64_t offset, int write)
+{
+    OVERLAPPED *ov;
+    BOOL ok;
+    asx_affinity_domain domain = ASX_AFFINITY_DOMAIN_ANY;
+
+    if (io == NULL || io->port == NULL || op == NULL || handle == NULL ||
+        (buf == NULL && len > 0)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (task != ASX_INVALID_ID &&
+        asx_affinity_get_domain(task, &domain) != ASX_OK) {
+        domain = ASX_AFFINITY_DOMAIN_ANY;
+    }
+
+    memset(op, 0, sizeof(*op));
+    op->task = task;
+    op->handle = handle;
+    op->domain = domain;
+    ov = (OVERLAPPED *)(void *)op->overlapped;
+    ov->Offset = (DWORD)(offset & 0xffffffffu);
+    ov->OffsetHigh = (DWORD)(offset >> 32);
+
+    ok = write ? WriteFile((HANDLE)handle, buf, (DWORD)len, NULL, ov)
+               : ReadFile((HANDLE)handle, buf, (DWORD)len, NULL, ov);
+    if (!ok && GetLastError() != ERROR_IO_PENDING) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    /* Synchronous success still posts a completion to the port */
+    io->inflight++;
+    if (task != ASX_INVALID_ID) {
+        return asx_task_park_on_io(task, asx_park_key_io(op));
+    }
+    return ASX_OK;
+}
+
+asx_status asx_platform_iocp_read(asx_platform_iocp *io,
+                                  asx_platform_iocp_op *op,
+                                  asx_task_id task, void *handle,
+                                  void *buf, uint32_t len, uint64_t offset)
+{
+    return iocp_issue(io, op, task, handle, buf, len, offset, 0);
+}
+
+asx_status asx_platform_iocp_write(asx_platform_iocp *io,
+                                   asx_platform_iocp_op *op,
+                                   asx_task_id task, void *handle,
+                                   const void *buf, uint32_t len,
+                                   uint64_t offset)
+{
+    return iocp_issue(io, op, task, handle, (void *)(uintptr_t)buf, len,
+                      offset, 1);
+}
+
+asx_status asx_platform_iocp_wait(void *ctx, uint32_t timeout_ms,
+                                  uint32_t *ready_count)
+{
+    asx_platform_iocp *io = (asx_platform_iocp *)ctx;
+    OVERLAPPED_ENTRY entries[ASX_PLATFORM_IOCP_ENTRIES];
+    ULONG n = 0;
+    ULONG i;
+
+    if (io == NULL || io->port == NULL || ready_count == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    io->ready_count = 0;
+    *ready_count = 0;
+
+    /* INFINITE is UINT32_MAX, matching the hook contract */
+    if (!GetQueuedCompletionStatusEx((HANDLE)io->port, entries,
+                                     ASX_PLATFORM_IOCP_ENTRIES, &n,
+                                     (DWORD)timeout_ms, FALSE)) {
+        return GetLastError() == WAIT_TIMEOUT ? ASX_OK : ASX_E_INVALID_STATE;
+    }
+
+    for (i = 0; i < n; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PLATFORM_IOCP_ENTRIES") */
+        asx_platform_iocp_op *op;
+        DWORD bytes = 0;
+
+        if (entries[i].lpOverlapped == NULL) continue; /* posted wakeup */
+        op = (asx_platform_iocp_op *)(void *)entries[i].lpOverlapped;
+        if (GetOverlappedResult((HANDLE)op->handle, entries[i].lpOverlapped,
+                                &bytes, FALSE)) {
+            op->result = (int32_t)bytes;
+        } else {
+            op->result = -(int32_t)(GetLastError() & 0x7fffffffu);
+        }
+        op->done = 1;
+        io->inflight--;
+        io->ready_count++;
+        if (op->task != ASX_INVALID_ID) {
+            (void)asx_wake_source(ASX_PARK_IO, asx_park_key_io(op));
+        }
+    }
+    *ready_count = io->ready_count;
+    return ASX_OK;
+}
+
+asx_status asx_platform_iocp_install(asx_platform_iocp *io,
+                                     asx_runtime_hooks *hooks)
+{
+    if (io == NULL || hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    hooks->reactor.ctx = io;
+    hooks->reactor.wait_fn = asx_platform_iocp_wait;
+    return ASX_OK;
+}
+
 #else
 typedef int asx_no_empty_tu_warning;
 #endif
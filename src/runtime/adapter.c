@@ -18,39 +18,29 @@
 /* ASX_CHECKPOINT_WAIVER_FILE() — no kernel loops; pure function evaluations */
 
 #include <asx/runtime/adapter.h>
+#include <asx/runtime/digest.h>
 #include <stdint.h>
 #include <string.h>
 
 /* -------------------------------------------------------------------
- * Internal: FNV-1a hash for decision fields
+ * Internal: hash for decision fields (adapter digest domain)
  * ------------------------------------------------------------------- */
 
 #define FNV_OFFSET 14695981039346656037ULL
-#define FNV_PRIME  1099511628211ULL
-
-static uint64_t fnv_hash_u32(uint64_t h, uint32_t val)
-{
-    const unsigned char *p = (const unsigned char *)&val;
-    int i;
-    for (i = 0; i < 4; i++) {
-        h ^= (uint64_t)p[i];
-        h *= FNV_PRIME;
-    }
-    return h;
-}
 
 static uint64_t decision_hash(const asx_adapter_decision *d)
 {
-    uint64_t h = FNV_OFFSET;
-    h = fnv_hash_u32(h, (uint32_t)d->triggered);
-    h = fnv_hash_u32(h, (uint32_t)d->mode);
-    h = fnv_hash_u32(h, d->load_pct);
-    h = fnv_hash_u32(h, d->shed_count);
-    h = fnv_hash_u32(h, (uint32_t)d->admit_status);
-    return h;
+    uint32_t f[5];
+    f[0] = (uint32_t)d->triggered;
+    f[1] = (uint32_t)d->mode;
+    f[2] = d->load_pct;
+    f[3] = d->shed_count;
+    f[4] = (uint32_t)d->admit_status;
+    return asx_digest_u32s(asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER),
+                           FNV_OFFSET, f, 5u);
 }
 
-static uint32_t percent_load_u32(uint32_t used, uint32_t capacity)
+static uint32_t adapter_percent_load_u32(uint32_t used, uint32_t capacity)
 {
     uint64_t pct;
 
@@ -113,7 +103,7 @@ static void core_fallback_decide(uint32_t used, uint32_t capacity,
         return;
     }
 
-    load_pct = percent_load_u32(used, capacity);
+    load_pct = adapter_percent_load_u32(used, capacity);
     out->load_pct = load_pct;
 
     if (load_pct >= 90) {
@@ -150,7 +140,7 @@ void asx_adapter_hft_decide(uint32_t used, uint32_t capacity,
         return;
     }
 
-    load_pct = percent_load_u32(used, capacity);
+    load_pct = adapter_percent_load_u32(used, capacity);
     out->load_pct = load_pct;
 
     if (load_pct >= 85) {
@@ -196,7 +186,7 @@ void asx_adapter_auto_decide(uint32_t used, uint32_t capacity,
         return;
     }
 
-    load_pct = percent_load_u32(used, capacity);
+    load_pct = adapter_percent_load_u32(used, capacity);
     out->load_pct = load_pct;
 
     if (load_pct >= 90) {
@@ -255,7 +245,7 @@ void asx_adapter_router_decide(uint32_t used, uint32_t capacity,
         return;
     }
 
-    load_pct = percent_load_u32(used, scaled_capacity);
+    load_pct = adapter_percent_load_u32(used, scaled_capacity);
     out->load_pct = load_pct;
 
     if (load_pct >= 75) {
@@ -270,7 +260,7 @@ void asx_adapter_router_decide(uint32_t used, uint32_t capacity,
      * (REJECT at 90% of original capacity) would reject. This ensures
      * the isomorphism contract holds even with R3 capacity scaling. */
     if (!out->triggered && capacity > 0) {
-        uint32_t core_pct = percent_load_u32(used, capacity);
+        uint32_t core_pct = adapter_percent_load_u32(used, capacity);
         if (core_pct >= 90) {
             out->triggered = 1;
             out->load_pct = core_pct;
@@ -288,15 +278,46 @@ void asx_adapter_router_fallback(uint32_t used, uint32_t capacity,
 }
 
 /* -------------------------------------------------------------------
- * Unified dispatch
+ * Compiled dispatch tables
+ *
+ * One table per path that depends on (used, capacity) only through the
+ * load percent: the CORE fallback, HFT, automotive without deadline
+ * history, and router at R2. Each holds a row per percent 0..100 with
+ * its hash. Everything else runs the reference path.
  * ------------------------------------------------------------------- */
 
-void asx_adapter_dispatch(asx_adapter_domain domain,
-                           asx_adapter_mode mode,
-                           uint32_t used,
-                           uint32_t capacity,
-                           const void *domain_ctx,
-                           asx_adapter_decision *out)
+#define TABLE_LOADS          101u
+#define TABLE_BUILD_CAPACITY 100u
+#define TABLE_CHECK_CAPACITY 1000u
+
+typedef enum {
+    TABLE_FALLBACK = 0,
+    TABLE_HFT      = 1,
+    TABLE_AUTO     = 2,
+    TABLE_ROUTER   = 3,
+    TABLE_COUNT    = 4,
+    TABLE_NONE     = 5
+} table_path;
+
+typedef struct {
+    asx_adapter_mode  path_used;
+    asx_overload_mode mode;
+    uint32_t          shed_count;   /* when triggered */
+    asx_status        refused;      /* admit_status when triggered */
+    uint8_t           triggered[TABLE_LOADS];
+    uint64_t          hash[TABLE_LOADS];
+} dispatch_table;
+
+static dispatch_table  g_tables[TABLE_COUNT];
+static int             g_tables_on = 0;
+static asx_digest_mode g_tables_digest;
+
+/* Reference dispatch: every path evaluated and hashed in full. */
+static void dispatch_reference(asx_adapter_domain domain,
+                               asx_adapter_mode mode,
+                               uint32_t used, uint32_t capacity,
+                               const void *domain_ctx,
+                               asx_adapter_decision *out)
 {
     if (mode == ASX_ADAPTER_FALLBACK) {
         core_fallback_decide(used, capacity, out);
@@ -325,6 +346,152 @@ void asx_adapter_dispatch(asx_adapter_domain domain,
     }
 }
 
+/* The table serving a dispatch, or TABLE_NONE. */
+static table_path dispatch_table_for(asx_adapter_domain domain,
+                                     asx_adapter_mode mode,
+                                     const void *domain_ctx)
+{
+    if (mode == ASX_ADAPTER_FALLBACK) return TABLE_FALLBACK;
+
+    switch (domain) {
+    case ASX_ADAPTER_DOMAIN_HFT:
+        return TABLE_HFT;
+    case ASX_ADAPTER_DOMAIN_AUTOMOTIVE: {
+        const asx_auto_deadline_tracker *dt =
+            (const asx_auto_deadline_tracker *)domain_ctx;
+        return (dt == NULL || dt->total_deadlines == 0) ? TABLE_AUTO
+                                                        : TABLE_NONE;
+    }
+    case ASX_ADAPTER_DOMAIN_ROUTER:
+        return (domain_ctx == NULL ||
+                *(const asx_resource_class *)domain_ctx == ASX_CLASS_R2)
+                   ? TABLE_ROUTER : TABLE_NONE;
+    case ASX_ADAPTER_DOMAIN_COUNT:
+        return TABLE_FALLBACK;
+    }
+    return TABLE_NONE;
+}
+
+static void table_decision(const dispatch_table *t, uint32_t pct,
+                           asx_adapter_decision *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->path_used = t->path_used;
+    out->mode = t->mode;
+    out->load_pct = pct;
+    out->triggered = t->triggered[pct];
+    out->shed_count = out->triggered ? t->shed_count : 0u;
+    out->admit_status = out->triggered ? t->refused : ASX_OK;
+}
+
+/* Fill *out from a table row; 0 when the reference must run. */
+static int table_lookup(table_path path, uint32_t used, uint32_t capacity,
+                        asx_adapter_decision *out)
+{
+    const dispatch_table *t;
+    uint32_t pct;
+
+    if (!g_tables_on || path == TABLE_NONE) return 0;
+    if (capacity == 0u || used > capacity) return 0;
+    if (asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER) != g_tables_digest)
+        return 0;
+
+    t = &g_tables[path];
+    pct = (uint32_t)(((uint64_t)used * 100u) / capacity);
+    if (t->triggered[pct] && used < t->shed_count) return 0;
+
+    table_decision(t, pct, out);
+    out->decision_hash = t->hash[pct];
+    return 1;
+}
+
+/* -------------------------------------------------------------------
+ * Unified dispatch
+ * ------------------------------------------------------------------- */
+
+void asx_adapter_dispatch(asx_adapter_domain domain,
+                           asx_adapter_mode mode,
+                           uint32_t used,
+                           uint32_t capacity,
+                           const void *domain_ctx,
+                           asx_adapter_decision *out)
+{
+    if (table_lookup(dispatch_table_for(domain, mode, domain_ctx),
+                     used, capacity, out)) {
+        return;
+    }
+    dispatch_reference(domain, mode, used, capacity, domain_ctx, out);
+}
+
+/* Context and mode that route a dispatch to each table. */
+static const struct {
+    asx_adapter_domain domain;
+    asx_adapter_mode   mode;
+} g_table_routes[TABLE_COUNT] = {
+    { ASX_ADAPTER_DOMAIN_HFT,        ASX_ADAPTER_FALLBACK },
+    { ASX_ADAPTER_DOMAIN_HFT,        ASX_ADAPTER_ACCELERATED },
+    { ASX_ADAPTER_DOMAIN_AUTOMOTIVE, ASX_ADAPTER_ACCELERATED },
+    { ASX_ADAPTER_DOMAIN_ROUTER,     ASX_ADAPTER_ACCELERATED }
+};
+
+asx_status asx_adapter_dispatch_tables_build(void)
+{
+    asx_adapter_isomorphism failed;
+    uint32_t k;
+
+    g_tables_on = 0;
+    g_tables_digest = asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER);
+
+    for (k = 0; k < (uint32_t)TABLE_COUNT; k++) {
+        dispatch_table *t = &g_tables[k];
+        asx_adapter_decision d;
+        uint32_t pct;
+
+        memset(t, 0, sizeof(*t));
+        t->refused = ASX_OK;
+        for (pct = 0; pct < TABLE_LOADS; pct++) {
+            dispatch_reference(g_table_routes[k].domain,
+                               g_table_routes[k].mode, pct,
+                               TABLE_BUILD_CAPACITY, NULL, &d);
+            t->path_used = d.path_used;
+            t->mode = d.mode;
+            t->triggered[pct] = (uint8_t)(d.triggered != 0);
+            if (d.triggered) {
+                t->shed_count = d.shed_count;
+                t->refused = d.admit_status;
+            }
+        }
+        for (pct = 0; pct < TABLE_LOADS; pct++) {
+            table_decision(t, pct, &d);
+            t->hash[pct] = decision_hash(&d);
+        }
+    }
+
+    /* The sweep checks every table-served dispatch against the
+     * reference; a capacity other than the build's puts several loads
+     * on each row */
+    g_tables_on = 1;
+    for (k = 0; k < (uint32_t)ASX_ADAPTER_DOMAIN_COUNT; k++) {
+        if (!asx_adapter_prove_isomorphism_sweep((asx_adapter_domain)k,
+                                                 TABLE_CHECK_CAPACITY,
+                                                 NULL, &failed)) {
+            g_tables_on = 0;
+            return ASX_E_INVALID_STATE;
+        }
+    }
+    return ASX_OK;
+}
+
+void asx_adapter_dispatch_tables_clear(void)
+{
+    g_tables_on = 0;
+}
+
+int asx_adapter_dispatch_tables_enabled(void)
+{
+    return g_tables_on;
+}
+
 /* -------------------------------------------------------------------
  * Isomorphism proof
  *
@@ -364,6 +531,17 @@ void asx_adapter_prove_isomorphism(asx_adapter_domain domain,
     proof->accel_hash = accel.decision_hash;
     proof->fallback_hash = fallback.decision_hash;
 
+    /* Table-served decisions must match the reference exactly */
+    if (g_tables_on) {
+        asx_adapter_decision ref;
+        dispatch_reference(domain, ASX_ADAPTER_ACCELERATED,
+                           load, capacity, domain_ctx, &ref);
+        if (ref.decision_hash != accel.decision_hash) return;
+        dispatch_reference(domain, ASX_ADAPTER_FALLBACK,
+                           load, capacity, domain_ctx, &ref);
+        if (ref.decision_hash != fallback.decision_hash) return;
+    }
+
     /*
      * Isomorphism holds if:
      * 1. Both admit (triggered==0), OR
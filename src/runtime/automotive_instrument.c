@@ -2,7 +2,8 @@
  * automotive_instrument.c — automotive profile instrumentation (bd-j4m.4)
  *
  * Implements deadline tracking, watchdog checkpoint monitoring,
- * degraded-mode audit logging, and compliance gate evaluation.
+ * degraded-mode audit logging and its page persistence, and
+ * compliance gate evaluation.
  *
  * All operations are single-threaded consistent with the asx
  * runtime threading model.
@@ -11,7 +12,12 @@
  */
 
 #include <asx/runtime/automotive_instrument.h>
+#include <asx/runtime/digest.h>
+#include <asx/runtime/waker.h>
+#include <asx/asx_config.h>
+#include <asx/portable.h>
 #include <string.h>
+#include "context_internal.h"
 
 /* -------------------------------------------------------------------
  * Deadline tracker
@@ -55,6 +61,19 @@ void asx_auto_deadline_record(asx_auto_deadline_tracker *dt,
         dt->total_margin_ns += abs_margin;
         dt->total_margin_count++;
     }
+
+    /* Slide the window: drop the oldest bit once full, push the new one */
+    {
+        uint32_t miss = actual_ns > deadline_ns ? 1u : 0u;
+        if (dt->window_len == ASX_AUTO_DEADLINE_WINDOW) {
+            dt->window_misses -= (uint32_t)(dt->window_bits >>
+                                            (ASX_AUTO_DEADLINE_WINDOW - 1u));
+        } else {
+            dt->window_len++;
+        }
+        dt->window_bits = (dt->window_bits << 1) | (uint64_t)miss;
+        dt->window_misses += miss;
+    }
 }
 
 uint32_t asx_auto_deadline_miss_rate(const asx_auto_deadline_tracker *dt)
@@ -64,11 +83,58 @@ uint32_t asx_auto_deadline_miss_rate(const asx_auto_deadline_tracker *dt)
     return (dt->deadline_misses * 10000u) / dt->total_deadlines;
 }
 
+uint32_t asx_auto_deadline_window_miss_rate(const asx_auto_deadline_tracker *dt)
+{
+    if (!dt || dt->window_len == 0) return 0;
+    return (dt->window_misses * 10000u) / dt->window_len;
+}
+
 void asx_auto_deadline_reset(asx_auto_deadline_tracker *dt)
 {
     asx_auto_deadline_init(dt);
 }
 
+/* -------------------------------------------------------------------
+ * Per-class deadline table
+ * ------------------------------------------------------------------- */
+
+void asx_auto_deadline_table_init(asx_auto_deadline_table *table)
+{
+    if (!table) return;
+    memset(table, 0, sizeof(*table));
+}
+
+asx_status asx_auto_deadline_table_set_limit(asx_auto_deadline_table *table,
+                                             uint32_t class_index,
+                                             uint32_t max_miss_rate_pct100)
+{
+    if (!table || class_index >= ASX_AUTO_DEADLINE_CLASSES) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    table->max_miss_rate_pct100[class_index] = max_miss_rate_pct100;
+    return ASX_OK;
+}
+
+asx_status asx_auto_deadline_table_record(asx_auto_deadline_table *table,
+                                          uint32_t class_index,
+                                          uint64_t deadline_ns,
+                                          uint64_t actual_ns)
+{
+    if (!table || class_index >= ASX_AUTO_DEADLINE_CLASSES) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    asx_auto_deadline_record(&table->classes[class_index],
+                             deadline_ns, actual_ns);
+    return ASX_OK;
+}
+
+const asx_auto_deadline_tracker *asx_auto_deadline_table_get(
+    const asx_auto_deadline_table *table, uint32_t class_index)
+{
+    if (!table || class_index >= ASX_AUTO_DEADLINE_CLASSES) return NULL;
+    return &table->classes[class_index];
+}
+
 /* -------------------------------------------------------------------
  * Watchdog monitor
  * ------------------------------------------------------------------- */
@@ -80,6 +146,21 @@ void asx_auto_watchdog_init(asx_auto_watchdog *wd, uint64_t period_ns)
     wd->watchdog_period_ns = period_ns;
 }
 
+/* Move the watchdog's timer to deadline_ns */
+static asx_status watchdog_timer_set(asx_auto_watchdog *wd, uint64_t deadline_ns)
+{
+    asx_status st = asx_timer_update(asx_timer_wheel_global(),
+                                     wd->has_timer ? &wd->timer : NULL,
+                                     (asx_time)deadline_ns, wd, &wd->timer);
+    if (st != ASX_OK) {
+        wd->timer_failures++;
+        return st;
+    }
+    wd->has_timer = 1;
+    wd->timer_deadline_ns = deadline_ns;
+    return ASX_OK;
+}
+
 void asx_auto_watchdog_checkpoint(asx_auto_watchdog *wd, uint64_t now_ns)
 {
     if (!wd) return;
@@ -91,13 +172,20 @@ void asx_auto_watchdog_checkpoint(asx_auto_watchdog *wd, uint64_t now_ns)
         if (interval > wd->worst_interval_ns) {
             wd->worst_interval_ns = interval;
         }
-        if (wd->watchdog_period_ns > 0 && interval > wd->watchdog_period_ns) {
+        /* An expiry already escalated has been counted */
+        if (wd->watchdog_period_ns > 0 && interval > wd->watchdog_period_ns &&
+            !wd->escalated) {
             wd->violations++;
         }
     }
 
     wd->last_checkpoint_ns = now_ns;
     wd->armed = 1;
+    wd->escalated = 0;
+
+    if (wd->timer_mode) {
+        (void)watchdog_timer_set(wd, now_ns + wd->watchdog_period_ns);
+    }
 }
 
 int asx_auto_watchdog_would_trigger(const asx_auto_watchdog *wd,
@@ -113,10 +201,77 @@ void asx_auto_watchdog_reset(asx_auto_watchdog *wd)
 {
     uint64_t period;
     if (!wd) return;
+    asx_auto_watchdog_disarm_timer(wd);
     period = wd->watchdog_period_ns;
     asx_auto_watchdog_init(wd, period);
 }
 
+asx_status asx_auto_watchdog_arm_timer(asx_auto_watchdog *wd,
+                                       asx_auto_watchdog_escalate_fn escalate,
+                                       void *escalate_ctx)
+{
+    if (!wd || wd->watchdog_period_ns == 0) return ASX_E_INVALID_ARGUMENT;
+
+    if (wd->armed) {
+        asx_status st = watchdog_timer_set(
+            wd, wd->last_checkpoint_ns + wd->watchdog_period_ns);
+        if (st != ASX_OK) return st;
+    }
+    wd->escalate = escalate;
+    wd->escalate_ctx = escalate_ctx;
+    wd->timer_mode = 1;
+    return ASX_OK;
+}
+
+void asx_auto_watchdog_disarm_timer(asx_auto_watchdog *wd)
+{
+    if (!wd) return;
+    wd->timer_mode = 0;
+    if (wd->has_timer) {
+        (void)asx_timer_cancel(asx_timer_wheel_global(), &wd->timer);
+        wd->has_timer = 0;
+    }
+}
+
+asx_status asx_auto_watchdog_poll(void *user_data, asx_task_id self)
+{
+    asx_auto_watchdog *wd = (asx_auto_watchdog *)user_data;
+    asx_timer_wheel *wheel = asx_timer_wheel_global();
+    asx_status st;
+
+    if (!wd) return ASX_E_INVALID_ARGUMENT;
+    if (!wd->timer_mode) return ASX_OK;
+    /* No checkpoint yet, or the wheel refused a re-arm: stay runnable */
+    if (!wd->has_timer) return ASX_E_PENDING;
+
+    if (!asx_timer_is_live(wheel, &wd->timer)) {
+        /* Fired: escalate, then wait one more period */
+        uint64_t fired_at = wd->timer_deadline_ns;
+        uint64_t overdue = fired_at - wd->last_checkpoint_ns -
+                           wd->watchdog_period_ns;
+
+        wd->violations++;
+        wd->escalations++;
+        wd->escalated = 1;
+        asx_auto_audit_record(asx_auto_audit_global(),
+                              ASX_AUDIT_WATCHDOG_VIOLATION, fired_at,
+                              (uint64_t)self,
+                              (int64_t)(fired_at - wd->last_checkpoint_ns));
+        if (wd->escalate) {
+            wd->escalate(wd->escalate_ctx, wd, overdue);
+        }
+        if (!wd->timer_mode) return ASX_OK;
+        wd->has_timer = 0;
+        if (watchdog_timer_set(wd, fired_at + wd->watchdog_period_ns) != ASX_OK) {
+            return ASX_E_PENDING;
+        }
+    }
+
+    st = asx_task_park_on_timer(self, &wd->timer);
+    (void)st; /* unparked the task is merely polled again */
+    return ASX_E_PENDING;
+}
+
 /* -------------------------------------------------------------------
  * Audit ring
  * ------------------------------------------------------------------- */
@@ -204,6 +359,178 @@ void asx_auto_audit_reset(asx_auto_audit_ring *ring)
     asx_auto_audit_init(ring);
 }
 
+/* -------------------------------------------------------------------
+ * Audit persistence
+ * ------------------------------------------------------------------- */
+
+static uint32_t audit_page_crc(const uint8_t *page, uint32_t entries)
+{
+    uint32_t crc = asx_digest_crc32c(0u, page, 12u);
+    return asx_digest_crc32c(crc, page + ASX_AUTO_AUDIT_PAGE_HEADER,
+                             (size_t)entries * ASX_AUTO_AUDIT_PAGE_RECORD);
+}
+
+/* Seal the staged page and offer it to storage */
+static asx_status audit_page_store(asx_auto_audit_persist *p)
+{
+    asx_status st;
+
+    asx_store_le_u32(p->page, ASX_AUTO_AUDIT_PAGE_MAGIC);
+    asx_store_le_u32(p->page + 4, p->page_seq);
+    asx_store_le_u16(p->page + 8, (uint16_t)p->staged);
+    asx_store_le_u16(p->page + 10, (uint16_t)ASX_AUTO_AUDIT_PAGE_VERSION);
+    asx_store_le_u32(p->page + 12, audit_page_crc(p->page, p->staged));
+
+    st = p->store(p->store_ctx, p->page, ASX_AUTO_AUDIT_PAGE_BYTES);
+    if (st != ASX_OK) {
+        p->store_failures++;
+        return st;
+    }
+    p->pages_written++;
+    p->page_seq++;
+    p->staged = 0;
+    memset(p->page, 0xFF, sizeof(p->page));
+    return ASX_OK;
+}
+
+asx_status asx_auto_audit_persist_init(asx_auto_audit_persist *p,
+                                       const asx_auto_audit_ring *ring,
+                                       asx_auto_audit_store_fn store,
+                                       void *store_ctx,
+                                       uint32_t first_page)
+{
+    if (!p || !ring || !store) return ASX_E_INVALID_ARGUMENT;
+    memset(p, 0, sizeof(*p));
+    memset(p->page, 0xFF, sizeof(p->page));
+    p->ring = ring;
+    p->store = store;
+    p->store_ctx = store_ctx;
+    p->next_seq = ring->next_seq;
+    p->page_seq = first_page;
+    return ASX_OK;
+}
+
+asx_status asx_auto_audit_persist_flush(asx_auto_audit_persist *p, int sync)
+{
+    uint32_t available;
+    uint32_t i;
+    asx_status st;
+
+    if (!p || !p->ring) return ASX_E_INVALID_ARGUMENT;
+
+    /* A full page left by a failed store goes first */
+    if (p->staged == ASX_AUTO_AUDIT_PAGE_ENTRIES) {
+        st = audit_page_store(p);
+        if (st != ASX_OK) return st;
+    }
+
+    available = asx_auto_audit_count(p->ring);
+    for (i = 0; i < available; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded: available <= ASX_AUTO_AUDIT_RING_SIZE");
+        const asx_audit_entry *e = asx_auto_audit_get(p->ring, i);
+        uint8_t *rec;
+
+        if ((int32_t)(e->seq - p->next_seq) < 0) continue;
+        if (e->seq != p->next_seq) {
+            p->lost += e->seq - p->next_seq;
+        }
+
+        rec = p->page + ASX_AUTO_AUDIT_PAGE_HEADER +
+              p->staged * ASX_AUTO_AUDIT_PAGE_RECORD;
+        asx_store_le_u32(rec, e->seq);
+        asx_store_le_u32(rec + 4, (uint32_t)e->kind);
+        asx_store_le_u64(rec + 8, e->timestamp_ns);
+        asx_store_le_u64(rec + 16, e->entity_id);
+        asx_store_le_u64(rec + 24, (uint64_t)e->detail);
+        p->staged++;
+        p->next_seq = e->seq + 1u;
+
+        if (p->staged == ASX_AUTO_AUDIT_PAGE_ENTRIES) {
+            st = audit_page_store(p);
+            if (st != ASX_OK) return st;
+        }
+    }
+
+    if (sync && p->staged > 0) {
+        return audit_page_store(p);
+    }
+    return ASX_OK;
+}
+
+void asx_auto_audit_persist_stop(asx_auto_audit_persist *p)
+{
+    if (!p) return;
+    p->stopping = 1;
+}
+
+asx_status asx_auto_audit_persist_poll(void *user_data, asx_task_id self)
+{
+    asx_auto_audit_persist *p = (asx_auto_audit_persist *)user_data;
+    asx_status st;
+
+    (void)self;
+    if (!p) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_auto_audit_persist_flush(p, p->stopping);
+    if (p->stopping && st == ASX_OK) {
+        return ASX_OK;
+    }
+    return ASX_E_PENDING;
+}
+
+asx_status asx_auto_audit_recover(const uint8_t *image, uint32_t len,
+                                  asx_auto_audit_ring *ring,
+                                  uint32_t *out_pages)
+{
+    uint32_t pages = 0;
+    uint32_t first_page = 0;
+    uint32_t off;
+    asx_status st = ASX_OK;
+
+    if (out_pages) *out_pages = 0;
+    if (!image || !ring) return ASX_E_INVALID_ARGUMENT;
+
+    asx_auto_audit_init(ring);
+    for (off = 0; len - off >= ASX_AUTO_AUDIT_PAGE_BYTES;
+         off += ASX_AUTO_AUDIT_PAGE_BYTES) {
+        ASX_CHECKPOINT_WAIVER("bounded: len / ASX_AUTO_AUDIT_PAGE_BYTES pages");
+        const uint8_t *pg = image + off;
+        uint32_t count;
+        uint32_t page_seq;
+        uint32_t i;
+
+        if (asx_load_le_u32(pg) != ASX_AUTO_AUDIT_PAGE_MAGIC) break;
+
+        page_seq = asx_load_le_u32(pg + 4);
+        count = asx_load_le_u16(pg + 8);
+        if (pages == 0) first_page = page_seq;
+        if (asx_load_le_u16(pg + 10) != ASX_AUTO_AUDIT_PAGE_VERSION ||
+            count == 0 || count > ASX_AUTO_AUDIT_PAGE_ENTRIES ||
+            page_seq != first_page + pages ||
+            asx_load_le_u32(pg + 12) != audit_page_crc(pg, count)) {
+            st = ASX_E_REPLAY_MISMATCH;
+            break;
+        }
+
+        for (i = 0; i < count; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded: count <= ASX_AUTO_AUDIT_PAGE_ENTRIES");
+            const uint8_t *rec = pg + ASX_AUTO_AUDIT_PAGE_HEADER +
+                                 i * ASX_AUTO_AUDIT_PAGE_RECORD;
+            /* Keep the persisted sequence number */
+            ring->next_seq = asx_load_le_u32(rec);
+            asx_auto_audit_record(ring,
+                                  (asx_audit_kind)asx_load_le_u32(rec + 4),
+                                  asx_load_le_u64(rec + 8),
+                                  asx_load_le_u64(rec + 16),
+                                  (int64_t)asx_load_le_u64(rec + 24));
+        }
+        pages++;
+    }
+
+    if (out_pages) *out_pages = pages;
+    return st;
+}
+
 /* -------------------------------------------------------------------
  * Compliance gate
  * ------------------------------------------------------------------- */
@@ -223,9 +550,12 @@ void asx_auto_compliance_gate_init(asx_auto_compliance_gate *gate)
 void asx_auto_compliance_evaluate(
     const asx_auto_compliance_gate *gate,
     const asx_auto_deadline_tracker *dt,
+    const asx_auto_deadline_table *classes,
     const asx_auto_watchdog *wd,
     asx_auto_compliance_result *result)
 {
+    uint32_t c;
+
     if (!gate || !result) return;
 
     memset(result, 0, sizeof(*result));
@@ -240,6 +570,31 @@ void asx_auto_compliance_evaluate(
         }
     }
 
+    /* Per-class window miss rate check */
+    if (classes) {
+        for (c = 0; c < ASX_AUTO_DEADLINE_CLASSES; c++) {
+            ASX_CHECKPOINT_WAIVER("bounded: ASX_AUTO_DEADLINE_CLASSES");
+            const asx_auto_deadline_tracker *ct = &classes->classes[c];
+            uint32_t limit = classes->max_miss_rate_pct100[c] != 0
+                           ? classes->max_miss_rate_pct100[c]
+                           : gate->max_miss_rate_pct100;
+            uint32_t rate;
+
+            if (ct->window_len == 0) continue;
+            rate = asx_auto_deadline_window_miss_rate(ct);
+            if (rate > result->worst_class_miss_rate) {
+                result->worst_class_miss_rate = rate;
+            }
+            if (rate > limit) {
+                result->failed_classes |= 1u << c;
+            }
+        }
+        if (result->failed_classes != 0) {
+            result->violation_mask |= ASX_COMPLIANCE_CLASS_RATE;
+            result->pass = 0;
+        }
+    }
+
     /* Watchdog violation check */
     if (wd) {
         result->actual_violations = wd->violations;
@@ -262,14 +617,26 @@ void asx_auto_compliance_evaluate(
  * ------------------------------------------------------------------- */
 
 static asx_auto_deadline_tracker g_deadline;
+static asx_auto_deadline_table   g_deadline_classes;
 static asx_auto_watchdog         g_watchdog;
 static asx_auto_audit_ring       g_audit;
 static int                       g_auto_initialized = 0;
 
+static const asx_context_block g_automotive_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_deadline),
+    ASX_CONTEXT_BLOCK(g_deadline_classes),
+    ASX_CONTEXT_BLOCK(g_watchdog),
+    ASX_CONTEXT_BLOCK(g_audit),
+    ASX_CONTEXT_BLOCK(g_auto_initialized)
+};
+
+const asx_context_module asx_automotive_context = ASX_CONTEXT_MODULE(g_automotive_blocks);
+
 static void ensure_auto_init(void)
 {
     if (!g_auto_initialized) {
         asx_auto_deadline_init(&g_deadline);
+        asx_auto_deadline_table_init(&g_deadline_classes);
         asx_auto_watchdog_init(&g_watchdog, 10000000u); /* 10ms default period */
         asx_auto_audit_init(&g_audit);
         g_auto_initialized = 1;
@@ -278,7 +645,9 @@ static void ensure_auto_init(void)
 
 void asx_auto_instrument_reset(void)
 {
+    asx_auto_watchdog_disarm_timer(&g_watchdog);
     asx_auto_deadline_init(&g_deadline);
+    asx_auto_deadline_table_init(&g_deadline_classes);
     asx_auto_watchdog_init(&g_watchdog, 10000000u);
     asx_auto_audit_init(&g_audit);
     g_auto_initialized = 1;
@@ -296,6 +665,12 @@ asx_auto_watchdog *asx_auto_watchdog_global(void)
     return &g_watchdog;
 }
 
+asx_auto_deadline_table *asx_auto_deadline_classes_global(void)
+{
+    ensure_auto_init();
+    return &g_deadline_classes;
+}
+
 asx_auto_audit_ring *asx_auto_audit_global(void)
 {
     ensure_auto_init();
@@ -317,6 +692,21 @@ void asx_auto_record_deadline(uint64_t deadline_ns,
     }
 }
 
+asx_status asx_auto_record_deadline_class(uint32_t class_index,
+                                          uint64_t deadline_ns,
+                                          uint64_t actual_ns,
+                                          uint64_t entity_id)
+{
+    asx_status st;
+
+    ensure_auto_init();
+    st = asx_auto_deadline_table_record(&g_deadline_classes, class_index,
+                                        deadline_ns, actual_ns);
+    if (st != ASX_OK) return st;
+    asx_auto_record_deadline(deadline_ns, actual_ns, entity_id);
+    return ASX_OK;
+}
+
 void asx_auto_record_checkpoint(uint64_t now_ns, uint64_t entity_id)
 {
     int would_trigger;
@@ -324,8 +714,10 @@ void asx_auto_record_checkpoint(uint64_t now_ns, uint64_t entity_id)
 
     ensure_auto_init();
 
-    /* Check if this checkpoint would trigger a violation before recording */
-    would_trigger = asx_auto_watchdog_would_trigger(&g_watchdog, now_ns);
+    /* Check if this checkpoint would trigger a violation before recording;
+     * an expiry escalated by the timer was logged already */
+    would_trigger = !g_watchdog.escalated &&
+                    asx_auto_watchdog_would_trigger(&g_watchdog, now_ns);
 
     /* Save previous checkpoint time BEFORE updating (otherwise interval = 0) */
     prev_checkpoint_ns = g_watchdog.last_checkpoint_ns;
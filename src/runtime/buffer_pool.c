@@ -0,0 +1,203 @@
+/*
+ * buffer_pool.c — refcounted fixed-size I/O buffers
+ *
+ * One allocation holds every buffer, over-allocated by ASX_BUFFER_ALIGN
+ * so the first buffer can be aligned, followed by the slot array. Free
+ * buffers form a LIFO list through their slots, so a buffer just
+ * released, still warm in cache, is handed out next.
+ *
+ * Handles encode [generation:32 | index + 1:32], keeping 0 free for
+ * ASX_BUFFER_NONE.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("buffer_pool: the only loop builds the "
+ *   "free list at init, bounded by the buffer count.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/runtime/buffer_pool.h>
+#include <string.h>
+
+#define BUFFER_LINK_NONE 0xFFFFFFFFu
+#define BUFFER_POOL_MAX  ((uint64_t)1u << 30)
+
+#if ASX_BUFFER_THREADED
+#define buffer_lock(p)   while (__atomic_exchange_n(&(p)->lock, 1u, __ATOMIC_ACQUIRE) != 0u) {}
+#define buffer_unlock(p) __atomic_store_n(&(p)->lock, 0u, __ATOMIC_RELEASE)
+#define buffer_refs_add(s)  __atomic_add_fetch(&(s)->refs, 1u, __ATOMIC_RELAXED)
+#define buffer_refs_drop(s) __atomic_sub_fetch(&(s)->refs, 1u, __ATOMIC_ACQ_REL)
+#else
+#define buffer_lock(p)   ((void)0)
+#define buffer_unlock(p) ((void)0)
+#define buffer_refs_add(s)  (++(s)->refs)
+#define buffer_refs_drop(s) (--(s)->refs)
+#endif
+
+static uint64_t buffer_handle(const asx_buffer_pool *pool, uint32_t idx)
+{
+    return ((uint64_t)pool->slots[idx].generation << 32) | (uint64_t)(idx + 1u);
+}
+
+/* The held buffer named by handle, or NULL */
+static asx_buffer_slot *buffer_lookup(const asx_buffer_pool *pool,
+                                      uint64_t handle, uint32_t *out_idx)
+{
+    uint32_t idx;
+    asx_buffer_slot *s;
+
+    if (pool == NULL || pool->slots == NULL) return NULL;
+    idx = (uint32_t)(handle & 0xFFFFFFFFu);
+    if (idx == 0u || idx > pool->count) return NULL;
+    idx--;
+    s = &pool->slots[idx];
+    if (s->generation != (uint32_t)(handle >> 32) || s->refs == 0u) return NULL;
+    if (out_idx != NULL) *out_idx = idx;
+    return s;
+}
+
+asx_status asx_buffer_pool_init(asx_buffer_pool *pool, uint32_t buffer_size,
+                                uint32_t count)
+{
+    uint64_t size;
+    uint64_t bytes;
+    uintptr_t base;
+    void *block;
+    uint32_t i;
+    asx_status st;
+
+    if (pool == NULL) return ASX_E_INVALID_ARGUMENT;
+    memset(pool, 0, sizeof(*pool));
+    pool->free_head = BUFFER_LINK_NONE;
+    if (buffer_size == 0u || count == 0u) return ASX_E_INVALID_ARGUMENT;
+    size = ((uint64_t)buffer_size + ASX_BUFFER_ALIGN - 1u) &
+           ~(uint64_t)(ASX_BUFFER_ALIGN - 1u);
+    bytes = size * count;
+    if (bytes > BUFFER_POOL_MAX) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_runtime_alloc_tagged(ASX_ALLOC_TAG_BUFFER,
+                                  (size_t)(bytes + ASX_BUFFER_ALIGN +
+                                           (uint64_t)count * sizeof(asx_buffer_slot)),
+                                  &block);
+    if (st != ASX_OK) return st;
+
+    base = ((uintptr_t)block + ASX_BUFFER_ALIGN - 1u) &
+           ~(uintptr_t)(ASX_BUFFER_ALIGN - 1u);
+    pool->block = block;
+    pool->base = (uint8_t *)base;
+    pool->slots = (asx_buffer_slot *)(void *)(pool->base + bytes);
+    pool->buffer_size = (uint32_t)size;
+    pool->count = count;
+    for (i = 0; i < count; i++) {
+        pool->slots[i].refs = 0;
+        pool->slots[i].len = 0;
+        pool->slots[i].generation = 1;
+        pool->slots[i].next = i + 1u < count ? i + 1u : BUFFER_LINK_NONE;
+    }
+    pool->free_head = 0;
+    pool->free_count = count;
+    return ASX_OK;
+}
+
+asx_status asx_buffer_pool_destroy(asx_buffer_pool *pool)
+{
+    if (pool == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (pool->block == NULL) return ASX_OK;
+    if (pool->free_count != pool->count) return ASX_E_INVALID_STATE;
+    (void)asx_runtime_free(pool->block);
+    memset(pool, 0, sizeof(*pool));
+    pool->free_head = BUFFER_LINK_NONE;
+    return ASX_OK;
+}
+
+asx_status asx_buffer_acquire(asx_buffer_pool *pool, uint64_t *out_handle)
+{
+    asx_buffer_slot *s;
+    uint32_t idx;
+
+    if (out_handle == NULL) return ASX_E_INVALID_ARGUMENT;
+    *out_handle = ASX_BUFFER_NONE;
+    if (pool == NULL || pool->slots == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    buffer_lock(pool);
+    idx = pool->free_head;
+    if (idx == BUFFER_LINK_NONE) {
+        buffer_unlock(pool);
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    s = &pool->slots[idx];
+    pool->free_head = s->next;
+    pool->free_count--;
+    s->len = 0;
+    s->refs = 1;
+    buffer_unlock(pool);
+
+    *out_handle = buffer_handle(pool, idx);
+    return ASX_OK;
+}
+
+asx_status asx_buffer_retain(asx_buffer_pool *pool, uint64_t handle)
+{
+    asx_buffer_slot *s = buffer_lookup(pool, handle, NULL);
+
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    (void)buffer_refs_add(s);
+    return ASX_OK;
+}
+
+asx_status asx_buffer_release(asx_buffer_pool *pool, uint64_t handle)
+{
+    uint32_t idx;
+    asx_buffer_slot *s = buffer_lookup(pool, handle, &idx);
+
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    if (buffer_refs_drop(s) != 0u) return ASX_OK;
+
+    buffer_lock(pool);
+    s->generation++;
+    if (s->generation == 0u) s->generation = 1;
+    s->next = pool->free_head;
+    pool->free_head = idx;
+    pool->free_count++;
+    buffer_unlock(pool);
+    return ASX_OK;
+}
+
+asx_status asx_buffer_get(const asx_buffer_pool *pool, uint64_t handle,
+                          uint8_t **out_data, uint32_t *out_len)
+{
+    uint32_t idx;
+    const asx_buffer_slot *s = buffer_lookup(pool, handle, &idx);
+
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    if (out_data != NULL) *out_data = pool->base + (size_t)idx * pool->buffer_size;
+    if (out_len != NULL) *out_len = s->len;
+    return ASX_OK;
+}
+
+asx_status asx_buffer_set_len(asx_buffer_pool *pool, uint64_t handle,
+                              uint32_t len)
+{
+    asx_buffer_slot *s = buffer_lookup(pool, handle, NULL);
+
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    if (len > pool->buffer_size) return ASX_E_INVALID_ARGUMENT;
+    s->len = len;
+    return ASX_OK;
+}
+
+asx_status asx_buffer_pool_snapshot(asx_buffer_pool *pool,
+                                    asx_resource_snapshot *out)
+{
+    uint32_t free_count;
+
+    if (pool == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    buffer_lock(pool);
+    free_count = pool->free_count;
+    buffer_unlock(pool);
+
+    out->kind = ASX_RESOURCE_ALLOCATOR;
+    out->capacity = pool->count;
+    out->used = pool->count - free_count;
+    out->remaining = free_count;
+    return ASX_OK;
+}
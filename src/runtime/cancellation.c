@@ -16,15 +16,101 @@
 #include <asx/core/transition.h>
 #include <asx/core/cancel.h>
 #include <asx/core/ghost.h>
+#include <asx/runtime/hft_instrument.h>
 #include "runtime_internal.h"
+#include "context_internal.h"
+
+/* -------------------------------------------------------------------
+ * Cancel attribution side table
+ *
+ * Only cancels that name an origin take an entry, so a task that
+ * completes normally or is cancelled plainly carries just a kind byte
+ * and an index. With every entry in use the origin goes unrecorded and
+ * asx_task_get_cancel_origin reports none.
+ * ------------------------------------------------------------------- */
+
+#define CANCEL_ATTR_SLOTS ASX_MAX_TASKS
+
+typedef struct {
+    asx_region_id origin_region;
+    asx_task_id   origin_task;
+    uint32_t      free_next;
+} cancel_attr_entry;
+
+static cancel_attr_entry g_cancel_attr[CANCEL_ATTR_SLOTS];
+static uint32_t g_cancel_attr_count;
+static uint32_t g_cancel_attr_free_head = ASX_CANCEL_ATTR_NONE;
+
+static const uint32_t g_cancel_attr_none = ASX_CANCEL_ATTR_NONE;
+static const asx_context_block g_cancellation_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_cancel_attr),
+    ASX_CONTEXT_BLOCK(g_cancel_attr_count),
+    ASX_CONTEXT_BLOCK_INIT(g_cancel_attr_free_head, g_cancel_attr_none)
+};
+
+const asx_context_module asx_cancellation_context = ASX_CONTEXT_MODULE(g_cancellation_blocks);
+
+void asx_cancel_attr_reset(void)
+{
+    g_cancel_attr_count = 0;
+    g_cancel_attr_free_head = ASX_CANCEL_ATTR_NONE;
+}
+
+void asx_cancel_attr_release(asx_task_cold *cold)
+{
+    uint32_t i = cold->cancel_attr;
+
+    if (i == ASX_CANCEL_ATTR_NONE) return;
+    g_cancel_attr[i].free_next = g_cancel_attr_free_head;
+    g_cancel_attr_free_head = i;
+    cold->cancel_attr = ASX_CANCEL_ATTR_NONE;
+}
+
+static asx_task_id cancel_attr_task(const asx_task_cold *cold)
+{
+    if (cold->cancel_attr == ASX_CANCEL_ATTR_NONE) return ASX_INVALID_ID;
+    return g_cancel_attr[cold->cancel_attr].origin_task;
+}
+
+/* Record the origin of cold's cancel, taking an entry on first use.
+ * An origin of two invalid handles needs no entry. */
+static void cancel_attr_set(asx_task_cold *cold, asx_region_id origin_region,
+                            asx_task_id origin_task)
+{
+    uint32_t i = cold->cancel_attr;
+
+    if (i == ASX_CANCEL_ATTR_NONE) {
+        if (origin_region == ASX_INVALID_ID && origin_task == ASX_INVALID_ID) return;
+        if (g_cancel_attr_free_head != ASX_CANCEL_ATTR_NONE) {
+            i = g_cancel_attr_free_head;
+            g_cancel_attr_free_head = g_cancel_attr[i].free_next;
+        } else if (g_cancel_attr_count < CANCEL_ATTR_SLOTS) {
+            i = g_cancel_attr_count++;
+        } else {
+            return;
+        }
+        cold->cancel_attr = i;
+    }
+    g_cancel_attr[i].origin_region = origin_region;
+    g_cancel_attr[i].origin_task = origin_task;
+}
 
 /* -------------------------------------------------------------------
  * Task cancel request
  * ------------------------------------------------------------------- */
 
+void asx_task_cancel_latency_record(asx_time cancel_ns)
+{
+    asx_time now;
+
+    if (asx_runtime_now_ns(&now) != ASX_OK || now < cancel_ns) return;
+    asx_hft_histogram_record(asx_hft_cancel_histogram(), now - cancel_ns);
+}
+
 asx_status asx_task_cancel(asx_task_id id, asx_cancel_kind kind)
 {
     asx_task_slot *t;
+    asx_region_slot *r;
     asx_status st;
     asx_budget cleanup;
 
@@ -38,15 +124,16 @@ asx_status asx_task_cancel(asx_task_id id, asx_cancel_kind kind)
 
     if (t->cancel_pending) {
         /* Strengthen: if new cancel is higher severity, upgrade */
-        if (asx_cancel_severity(kind) > asx_cancel_severity(t->cancel_reason.kind)) {
-            t->cancel_reason.kind = kind;
+        if (asx_cancel_severity(kind) >
+            asx_cancel_severity((asx_cancel_kind)t->cold->cancel_kind)) {
+            t->cold->cancel_kind = (uint8_t)kind;
             cleanup = asx_cancel_cleanup_budget(kind);
             /* Tighten budget: take the minimum polls remaining */
             if (asx_budget_polls(&cleanup) < t->cleanup_polls_remaining) {
                 t->cleanup_polls_remaining = asx_budget_polls(&cleanup);
             }
         }
-        t->cancel_epoch++;
+        t->cold->cancel_epoch++;
         return ASX_OK;
     }
 
@@ -64,20 +151,26 @@ asx_status asx_task_cancel(asx_task_id id, asx_cancel_kind kind)
 
     (void)asx_ghost_check_task_transition(id, t->state, ASX_TASK_CANCEL_REQUESTED);
     t->state = ASX_TASK_CANCEL_REQUESTED;
+    asx_snapshot_touch_task(asx_handle_slot(id));
 
     t->cancel_pending = 1;
-    t->cancel_reason.kind = kind;
-    t->cancel_reason.origin_region = ASX_INVALID_ID;
-    t->cancel_reason.origin_task = ASX_INVALID_ID;
-    t->cancel_reason.timestamp = 0;
-    t->cancel_reason.message = NULL;
-    t->cancel_reason.cause = NULL;
-    t->cancel_reason.truncated = 0;
-    t->cancel_epoch = 1;
+    if (asx_runtime_now_ns(&t->cold->cancel_ns) != ASX_OK) t->cold->cancel_ns = 0;
+    if (asx_region_slot_lookup(t->region, &r) == ASX_OK) {
+        r->tasks_uncancelled--;
+    }
+    t->cold->cancel_kind = (uint8_t)kind;
+    asx_cancel_attr_release(t->cold);
+    t->cold->cancel_epoch = 1;
 
     cleanup = asx_cancel_cleanup_budget(kind);
     t->cleanup_polls_remaining = asx_budget_polls(&cleanup);
 
+    /* A parked task must run its bounded cleanup: wake it now. A
+     * semaphore waiter gives up its place first. */
+    if (t->cold->sem != 0u) asx_semaphore_task_left(asx_handle_slot(id));
+    asx_task_wake_internal(asx_handle_slot(id));
+    asx_parallel_lane_sync(asx_handle_slot(id));
+
     return ASX_OK;
 }
 
@@ -100,7 +193,7 @@ asx_status asx_task_cancel_with_origin(asx_task_id id,
     if (st != ASX_OK) return st;
 
     was_pending = t->cancel_pending;
-    old_kind = t->cancel_reason.kind;
+    old_kind = (asx_cancel_kind)t->cold->cancel_kind;
 
     st = asx_task_cancel(id, kind);
     if (st != ASX_OK) return st;
@@ -110,8 +203,7 @@ asx_status asx_task_cancel_with_origin(asx_task_id id,
      * existing stronger cancel's origin attribution is preserved. */
     if (!was_pending ||
         asx_cancel_severity(kind) > asx_cancel_severity(old_kind)) {
-        t->cancel_reason.origin_region = origin_region;
-        t->cancel_reason.origin_task = origin_task;
+        cancel_attr_set(t->cold, origin_region, origin_task);
     }
 
     return ASX_OK;
@@ -123,31 +215,135 @@ asx_status asx_task_cancel_with_origin(asx_task_id id,
 
 uint32_t asx_cancel_propagate(asx_region_id region, asx_cancel_kind kind)
 {
+    asx_region_slot *r;
+    uint32_t root;
+    uint32_t ridx;
     uint32_t i;
     uint32_t count = 0;
 
-    for (i = 0; i < g_task_count; i++) {
-        ASX_CHECKPOINT_WAIVER("kernel-propagation: single-pass cancel sweep bounded by "
-                              "g_task_count <= ASX_MAX_TASKS; O(1) per iteration");
-        asx_task_slot *t = &g_tasks[i];
-        asx_task_id tid;
+    if (asx_region_slot_lookup(region, &r) != ASX_OK) return 0;
+
+    root = asx_handle_slot(region);
+    for (ridx = root; ridx != ASX_REGION_LINK_NONE;
+         ridx = asx_region_preorder_next(root, ridx)) {
+        ASX_CHECKPOINT_WAIVER("kernel-propagation: pre-order walk bounded by "
+                              "the subtree's regions");
+        for (i = asx_region_at(ridx)->task_head; i != ASX_TASK_LINK_NONE;
+             i = asx_task_cold_at(i)->region_next) {
+            ASX_CHECKPOINT_WAIVER("kernel-propagation: single-pass cancel sweep bounded by "
+                                  "the region's tasks; O(1) per iteration");
+            asx_task_slot *t = asx_task_at(i);
+            asx_task_id tid;
+
+            tid = asx_handle_pack(ASX_TYPE_TASK,
+                                  (uint16_t)(1u << (unsigned)t->state),
+                                  asx_handle_pack_index(asx_slot_generation(t->key), i));
+
+            if (asx_task_cancel(tid, kind) == ASX_OK) {
+                /* Set origin region for propagation traceability */
+                cancel_attr_set(t->cold, region, cancel_attr_task(t->cold));
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
 
-        if (!t->alive) continue;
-        if (t->region != region) continue;
-        if (asx_task_is_terminal(t->state)) continue;
+uint32_t asx_region_shed_oldest(asx_region_id region, uint32_t count)
+{
+    asx_region_slot *r;
+    uint32_t i;
+    uint32_t shed = 0;
 
+    if (asx_region_slot_lookup(region, &r) != ASX_OK) return 0;
+
+    for (i = r->task_head;
+         i != ASX_TASK_LINK_NONE && shed < count && r->tasks_uncancelled > 0;
+         i = asx_task_cold_at(i)->region_next) {
+        ASX_CHECKPOINT_WAIVER("kernel-shed: oldest-first walk bounded by "
+                              "count and the region's live tasks");
+        asx_task_slot *t = asx_task_at(i);
+        asx_task_id tid;
+
+        if (t->cancel_pending) continue;
         tid = asx_handle_pack(ASX_TYPE_TASK,
                               (uint16_t)(1u << (unsigned)t->state),
-                              asx_handle_pack_index(t->generation, (uint16_t)i));
-
-        if (asx_task_cancel(tid, kind) == ASX_OK) {
-            /* Set origin region for propagation traceability */
-            t->cancel_reason.origin_region = region;
-            count++;
+                              asx_handle_pack_index(asx_slot_generation(t->key), i));
+        if (asx_task_cancel(tid, ASX_CANCEL_RESOURCE) == ASX_OK) {
+            cancel_attr_set(t->cold, region, cancel_attr_task(t->cold));
+            shed++;
         }
     }
 
-    return count;
+    return shed;
+}
+
+/* -------------------------------------------------------------------
+ * Region deadlines
+ *
+ * One timer per region on the global wheel. The timer lets
+ * asx_scheduler_wait_idle sleep exactly until the deadline; the check
+ * itself happens once per scheduler round, against the round's coarse
+ * time, never per poll.
+ * ------------------------------------------------------------------- */
+
+asx_status asx_region_set_deadline(asx_region_id id, asx_time deadline)
+{
+    asx_region_slot *r;
+    asx_timer_handle h;
+    asx_status st;
+
+    st = asx_region_slot_lookup(id, &r);
+    if (st != ASX_OK) return st;
+    if (r->state != ASX_REGION_OPEN && r->state != ASX_REGION_CLOSING)
+        return ASX_E_REGION_CLOSED;
+
+    if (deadline == 0) {
+        asx_region_deadline_clear(r);
+        return ASX_OK;
+    }
+
+    /* Register first so a failure leaves the old deadline in force */
+    st = asx_timer_register(asx_timer_wheel_global(), deadline, NULL, &h);
+    if (st != ASX_OK) return st;
+    asx_region_deadline_clear(r);
+    r->deadline = deadline;
+    r->deadline_timer = h;
+    return ASX_OK;
+}
+
+void asx_region_deadline_clear(asx_region_slot *region)
+{
+    if (region->deadline == 0) return;
+    (void)asx_timer_cancel(asx_timer_wheel_global(), &region->deadline_timer);
+    region->deadline = 0;
+}
+
+void asx_region_deadline_poll(uint32_t region_idx)
+{
+    asx_timer_wheel *wheel = asx_timer_wheel_global();
+    asx_time now = 0;
+    int have_now = 0;
+    uint32_t idx;
+
+    for (idx = region_idx; idx != ASX_REGION_LINK_NONE;
+         idx = asx_region_at(idx)->parent) {
+        ASX_CHECKPOINT_WAIVER("bounded by region tree depth");
+        asx_region_slot *r = asx_region_at(idx);
+
+        if (r->deadline == 0) continue;
+        /* A fired timer is due without a clock read */
+        if (asx_timer_is_live(wheel, &r->deadline_timer)) {
+            if (!have_now) {
+                if (asx_runtime_coarse_now_ns(&now) != ASX_OK) return;
+                have_now = 1;
+            }
+            if (now < r->deadline) continue;
+        }
+        asx_region_deadline_clear(r);
+        (void)asx_cancel_propagate(asx_region_handle_at(idx), ASX_CANCEL_DEADLINE);
+    }
 }
 
 /* -------------------------------------------------------------------
@@ -177,13 +373,14 @@ asx_status asx_checkpoint(asx_task_id self, asx_checkpoint_result *out)
     if (t->state == ASX_TASK_CANCEL_REQUESTED) {
         (void)asx_ghost_check_task_transition(self, t->state, ASX_TASK_CANCELLING);
         t->state = ASX_TASK_CANCELLING;
-        t->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+        t->cold->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+        asx_snapshot_touch_task(asx_handle_slot(self));
     }
 
     out->cancelled = 1;
-    out->phase = t->cancel_phase;
+    out->phase = t->cold->cancel_phase;
     out->polls_remaining = t->cleanup_polls_remaining;
-    out->kind = t->cancel_reason.kind;
+    out->kind = (asx_cancel_kind)t->cold->cancel_kind;
 
     /* Budget is decremented by the scheduler after each poll,
      * not here. Checkpoint only observes and transitions phases. */
@@ -209,7 +406,8 @@ asx_status asx_task_finalize(asx_task_id id)
 
     (void)asx_ghost_check_task_transition(id, t->state, ASX_TASK_FINALIZING);
     t->state = ASX_TASK_FINALIZING;
-    t->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
+    t->cold->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
+    asx_snapshot_touch_task(asx_handle_slot(id));
 
     return ASX_OK;
 }
@@ -228,6 +426,27 @@ asx_status asx_task_get_cancel_phase(asx_task_id id, asx_cancel_phase *out)
     st = asx_task_slot_lookup(id, &t);
     if (st != ASX_OK) return st;
 
-    *out = t->cancel_phase;
+    *out = t->cold->cancel_phase;
+    return ASX_OK;
+}
+
+asx_status asx_task_get_cancel_origin(asx_task_id id,
+                                      asx_region_id *out_region,
+                                      asx_task_id *out_task)
+{
+    asx_task_slot *t;
+    asx_status st;
+    const cancel_attr_entry *e = NULL;
+
+    if (out_region == NULL || out_task == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+
+    if (t->cold->cancel_attr != ASX_CANCEL_ATTR_NONE) {
+        e = &g_cancel_attr[t->cold->cancel_attr];
+    }
+    *out_region = e != NULL ? e->origin_region : ASX_INVALID_ID;
+    *out_task = e != NULL ? e->origin_task : ASX_INVALID_ID;
     return ASX_OK;
 }
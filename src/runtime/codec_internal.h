@@ -1,8 +1,9 @@
 /*
  * codec_internal.h — shared buffer helpers for codec implementations
  *
- * Internal header for functions shared between hooks.c (JSON/BIN codecs)
- * and equivalence.c (cross-codec verification). Not part of the public API.
+ * Internal header for functions shared between hooks.c (JSON/BIN codecs),
+ * equivalence.c (cross-codec verification) and scenario.c (scenario
+ * compilation). Not part of the public API.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -14,6 +15,27 @@
 #include <asx/asx_status.h>
 #include <asx/codec/codec.h>
 
+/* Longest decimal uint64_t (18446744073709551615) */
+#define ASX_CODEC_U64_DIGITS_MAX 20u
+
+/* Ensure room for additional bytes plus the NUL terminator. */
+asx_status asx_codec_buffer_reserve(asx_codec_buffer *buf, size_t additional);
+
+/* Write value in decimal at dst (room for ASX_CODEC_U64_DIGITS_MAX
+ * bytes, no terminator); returns the digit count. */
+size_t asx_codec_format_u64(char *dst, uint64_t value);
+
+/* JSON scanners over NUL-terminated text. The scan functions check
+ * one value starting at cursor (a string, or any value nested at most
+ * 64 deep) and set *out_next past it. */
+const char *asx_codec_json_skip_ws(const char *cursor);
+asx_status asx_codec_json_scan_string(const char *cursor, const char **out_next);
+asx_status asx_codec_json_scan_value(const char *cursor, const char **out_next,
+                                     uint32_t depth);
+/* Parse an unsigned decimal integer, rejecting overflow. */
+asx_status asx_codec_json_decode_u64(const char *cursor, const char **out_next,
+                                     uint64_t *out_value);
+
 asx_status asx_codec_buffer_append_bytes(asx_codec_buffer *buf,
                                          const char *data, size_t len);
 asx_status asx_codec_buffer_append_cstr(asx_codec_buffer *buf,
@@ -0,0 +1,227 @@
+/*
+ * context.c — runtime contexts over the module state blocks
+ *
+ * A context is a header followed by an image of every block listed in
+ * context_internal.h, each rounded up to 8 bytes. The bound context's
+ * image is stale: its state lives in the module variables until the
+ * next bind copies it out and the incoming image in. A new context's
+ * image is built from each block's startup value, so binding it is
+ * the same as starting a process.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/time/timer_wheel.h>
+#include "runtime_internal.h"
+#include "context_internal.h"
+
+/* ASX_CHECKPOINT_WAIVER_FILE("context: loops bounded by the fixed module and block tables") */
+
+#define CONTEXT_MAGIC  0x61737852u   /* "asxR" */
+#define CONTEXT_ALIGN  8u
+
+struct asx_runtime {
+    uint32_t magic;
+    uint32_t size;      /* bytes of storage, header included */
+};
+
+static const asx_context_module *const g_context_modules[] = {
+    &asx_lifecycle_context,
+    &asx_cancellation_context,
+    &asx_resource_context,
+    &asx_waker_context,
+    &asx_scheduler_context,
+    &asx_group_context,
+    &asx_semaphore_context,
+    &asx_rate_limiter_context,
+    &asx_trace_context,
+    &asx_hooks_context,
+    &asx_event_context,
+    &asx_telemetry_context,
+    &asx_hindsight_context,
+    &asx_parallel_context,
+    &asx_hft_context,
+    &asx_automotive_context,
+    &asx_channel_context,
+    &asx_oneshot_context,
+    &asx_timer_context,
+#ifdef ASX_DEBUG_GHOST
+    &asx_ghost_context,
+#endif
+    &asx_status_context,
+#ifdef ASX_DEBUG_AFFINITY
+    &asx_affinity_context,
+#endif
+    &asx_adaptive_context
+};
+
+#define CONTEXT_MODULE_COUNT \
+    ((uint32_t)(sizeof(g_context_modules) / sizeof(g_context_modules[0])))
+
+/* NULL while the implicit context a process starts with is bound */
+static asx_runtime *g_context_bound;
+
+static uint32_t context_round(uint32_t size)
+{
+    return (size + CONTEXT_ALIGN - 1u) & ~(CONTEXT_ALIGN - 1u);
+}
+
+uint32_t asx_runtime_context_size(void)
+{
+    uint32_t total = (uint32_t)sizeof(asx_runtime);
+    uint32_t m;
+    uint32_t b;
+
+    for (m = 0; m < CONTEXT_MODULE_COUNT; m++) {
+        for (b = 0; b < g_context_modules[m]->count; b++) {
+            total += context_round(g_context_modules[m]->blocks[b].size);
+        }
+    }
+    return total;
+}
+
+static uint8_t *context_image(asx_runtime *ctx)
+{
+    return (uint8_t *)ctx + sizeof(asx_runtime);
+}
+
+static void context_save(asx_runtime *ctx)
+{
+    uint8_t *p = context_image(ctx);
+    uint32_t m;
+    uint32_t b;
+
+    for (m = 0; m < CONTEXT_MODULE_COUNT; m++) {
+        for (b = 0; b < g_context_modules[m]->count; b++) {
+            const asx_context_block *blk = &g_context_modules[m]->blocks[b];
+
+            memcpy(p, blk->addr, blk->size);
+            p += context_round(blk->size);
+        }
+    }
+}
+
+static void context_load(asx_runtime *ctx)
+{
+    const uint8_t *p = context_image(ctx);
+    uint32_t m;
+    uint32_t b;
+
+    for (m = 0; m < CONTEXT_MODULE_COUNT; m++) {
+        for (b = 0; b < g_context_modules[m]->count; b++) {
+            const asx_context_block *blk = &g_context_modules[m]->blocks[b];
+
+            memcpy(blk->addr, p, blk->size);
+            p += context_round(blk->size);
+        }
+    }
+    /* Dirty tracking is shared: the next capture anywhere is full */
+    asx_snapshot_reset();
+}
+
+static asx_status context_carve(void *storage, uint32_t size,
+                                asx_runtime **out)
+{
+    asx_runtime *ctx;
+
+    if (out != NULL) *out = NULL;
+    if (storage == NULL || out == NULL ||
+        ((uintptr_t)storage & (CONTEXT_ALIGN - 1u)) != 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (size < asx_runtime_context_size()) return ASX_E_BUFFER_TOO_SMALL;
+    ctx = (asx_runtime *)storage;
+    ctx->magic = CONTEXT_MAGIC;
+    ctx->size = size;
+    *out = ctx;
+    return ASX_OK;
+}
+
+static int context_valid(const asx_runtime *ctx)
+{
+    return ctx != NULL && ctx->magic == CONTEXT_MAGIC;
+}
+
+asx_status asx_runtime_context_init(void *storage, uint32_t size,
+                                    asx_runtime **out)
+{
+    asx_runtime *ctx;
+    uint8_t *p;
+    uint32_t m;
+    uint32_t b;
+    asx_status st;
+
+    st = context_carve(storage, size, out);
+    if (st != ASX_OK) return st;
+    ctx = *out;
+    p = context_image(ctx);
+    for (m = 0; m < CONTEXT_MODULE_COUNT; m++) {
+        for (b = 0; b < g_context_modules[m]->count; b++) {
+            const asx_context_block *blk = &g_context_modules[m]->blocks[b];
+
+            if (blk->init != NULL) {
+                memcpy(p, blk->init, blk->size);
+            } else {
+                memset(p, 0, blk->size);
+            }
+            p += context_round(blk->size);
+        }
+    }
+    return ASX_OK;
+}
+
+asx_status asx_runtime_context_adopt(void *storage, uint32_t size,
+                                     asx_runtime **out)
+{
+    asx_status st;
+
+    if (g_context_bound != NULL) {
+        if (out != NULL) *out = NULL;
+        return ASX_E_INVALID_STATE;
+    }
+    st = context_carve(storage, size, out);
+    if (st != ASX_OK) return st;
+    g_context_bound = *out;
+    return ASX_OK;
+}
+
+asx_status asx_runtime_context_bind(asx_runtime *ctx)
+{
+    if (!context_valid(ctx)) return ASX_E_INVALID_ARGUMENT;
+    if (ctx == g_context_bound) return ASX_OK;
+    if (g_context_bound == NULL) return ASX_E_INVALID_STATE;
+    context_save(g_context_bound);
+    context_load(ctx);
+    g_context_bound = ctx;
+    return ASX_OK;
+}
+
+asx_runtime *asx_runtime_context_current(void)
+{
+    return g_context_bound;
+}
+
+asx_status asx_runtime_context_fini(asx_runtime *ctx)
+{
+    asx_runtime *prev = g_context_bound;
+    asx_status st;
+
+    if (!context_valid(ctx)) return ASX_E_INVALID_ARGUMENT;
+    if (ctx == prev || prev == NULL) return ASX_E_INVALID_STATE;
+
+    /* Free what ctx allocated through its own hooks */
+    context_save(prev);
+    context_load(ctx);
+    g_context_bound = ctx;
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    st = asx_scheduler_event_log_reserve(0);   /* back to inline, no alloc */
+    context_load(prev);
+    g_context_bound = prev;
+    ctx->magic = 0;
+    return st;
+}
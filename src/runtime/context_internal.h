@@ -0,0 +1,71 @@
+/*
+ * context_internal.h — per-runtime state blocks for asx_runtime contexts
+ *
+ * Each module that keeps runtime state in file-scope variables lists
+ * them as blocks: an address, a size, and the value the block holds
+ * at startup (NULL for all zero). context.c copies the bound
+ * context's blocks out to its storage and the next context's in, so
+ * module code keeps using its variables directly and they always
+ * hold the bound context's state.
+ *
+ * Left out, and so shared by every context: process-wide settings
+ * (digest modes, adapter dispatch tables, codec settings), the slab
+ * epoch and ledger lock, per-thread caches, scratch no call keeps past
+ * its return, and snapshot dirty tracking, which every bind resets.
+ *
+ * Not part of the public API.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_CONTEXT_INTERNAL_H
+#define ASX_RUNTIME_CONTEXT_INTERNAL_H
+
+#include <stdint.h>
+
+typedef struct {
+    void       *addr;
+    uint32_t    size;
+    const void *init;   /* startup value, NULL for all zero */
+} asx_context_block;
+
+typedef struct {
+    const asx_context_block *blocks;
+    uint32_t                 count;
+} asx_context_module;
+
+#define ASX_CONTEXT_BLOCK(var) { &(var), (uint32_t)sizeof(var), NULL }
+#define ASX_CONTEXT_BLOCK_INIT(var, init) \
+    { &(var), (uint32_t)sizeof(var), &(init) }
+#define ASX_CONTEXT_MODULE(blocks) \
+    { (blocks), (uint32_t)(sizeof(blocks) / sizeof((blocks)[0])) }
+
+extern const asx_context_module asx_lifecycle_context;     /* lifecycle.c */
+extern const asx_context_module asx_cancellation_context;  /* cancellation.c */
+extern const asx_context_module asx_resource_context;      /* resource.c */
+extern const asx_context_module asx_waker_context;         /* waker.c */
+extern const asx_context_module asx_scheduler_context;     /* scheduler.c */
+extern const asx_context_module asx_group_context;         /* task_group.c */
+extern const asx_context_module asx_semaphore_context;     /* semaphore.c */
+extern const asx_context_module asx_rate_limiter_context;  /* rate_limiter.c */
+extern const asx_context_module asx_trace_context;         /* trace.c */
+extern const asx_context_module asx_hooks_context;         /* hooks.c */
+extern const asx_context_module asx_event_context;         /* event.c */
+extern const asx_context_module asx_telemetry_context;     /* telemetry.c */
+extern const asx_context_module asx_hindsight_context;     /* hindsight.c */
+extern const asx_context_module asx_parallel_context;      /* parallel.c */
+extern const asx_context_module asx_hft_context;           /* hft_instrument.c */
+extern const asx_context_module asx_automotive_context;    /* automotive_instrument.c */
+extern const asx_context_module asx_channel_context;       /* mpsc.c */
+extern const asx_context_module asx_oneshot_context;       /* oneshot.c */
+extern const asx_context_module asx_timer_context;         /* timer_wheel.c */
+#ifdef ASX_DEBUG_GHOST
+extern const asx_context_module asx_ghost_context;         /* ghost.c */
+#endif
+extern const asx_context_module asx_status_context;        /* status.c */
+#ifdef ASX_DEBUG_AFFINITY
+extern const asx_context_module asx_affinity_context;      /* affinity.c */
+#endif
+extern const asx_context_module asx_adaptive_context;      /* adaptive.c */
+
+#endif /* ASX_RUNTIME_CONTEXT_INTERNAL_H */
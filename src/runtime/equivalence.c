@@ -11,6 +11,9 @@
 #include <asx/codec/equivalence.h>
 #include <asx/codec/codec.h>
 #include <asx/codec/schema.h>
+#include <asx/asx_config.h>
+#include <asx/runtime/parallel.h>
+#include <asx/runtime/digest.h>
 #include "codec_internal.h"
 #include <stddef.h>
 #include <string.h>
@@ -198,66 +201,270 @@ asx_status asx_codec_fixture_semantic_key(const asx_canonical_fixture *fixture,
     return asx_codec_buffer_append_char(out_key, '}');
 }
 
+/* ------------------------------------------------------------------ */
+/* Semantic hash and index                                             */
+/* ------------------------------------------------------------------ */
+
+/* Length word first so field boundaries cannot shift; NULL folds a
+ * marker no length can produce. */
+static uint64_t hash_str(uint64_t hash, const char *text)
+{
+    size_t len;
+
+    if (text == NULL) return asx_digest_word(hash, UINT64_MAX);
+    len = strlen(text);
+    hash = asx_digest_word(hash, (uint64_t)len);
+    while (len > 0x7FFFFFFFu) { /* ASX_CHECKPOINT_WAIVER("bounded by string length") */
+        hash = asx_digest_bytes(ASX_DIGEST_WORD64, hash, text, 0x7FFFFFFFu);
+        text += 0x7FFFFFFFu;
+        len -= 0x7FFFFFFFu;
+    }
+    return asx_digest_bytes(ASX_DIGEST_WORD64, hash, text, (uint32_t)len);
+}
+
+asx_status asx_codec_fixture_semantic_hash(const asx_canonical_fixture *fixture,
+                                           uint64_t *out_hash)
+{
+    uint64_t h = ASX_CODEC_SEMANTIC_HASH_SEED;
+
+    if (fixture == NULL || out_hash == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    /* The fields asx_codec_fixture_semantic_eq compares, in its order */
+    h = hash_str(h, fixture->scenario_id);
+    h = hash_str(h, fixture->fixture_schema_version);
+    h = hash_str(h, fixture->scenario_dsl_version);
+    h = hash_str(h, fixture->profile);
+    h = asx_digest_word(h, fixture->seed);
+    h = hash_str(h, fixture->input_json);
+    h = hash_str(h, fixture->expected_events_json);
+    h = hash_str(h, fixture->expected_final_snapshot_json);
+    h = hash_str(h, fixture->expected_error_codes_json);
+    h = hash_str(h, fixture->semantic_digest);
+    h = hash_str(h, fixture->provenance.rust_baseline_commit);
+    h = hash_str(h, fixture->provenance.rust_toolchain_commit_hash);
+    h = hash_str(h, fixture->provenance.rust_toolchain_release);
+    h = hash_str(h, fixture->provenance.rust_toolchain_host);
+    h = hash_str(h, fixture->provenance.cargo_lock_sha256);
+    h = hash_str(h, fixture->provenance.capture_run_id);
+
+    *out_hash = h;
+    return ASX_OK;
+}
+
+asx_status asx_codec_semantic_index_init(asx_codec_semantic_index *index,
+                                         asx_codec_semantic_slot *slots,
+                                         uint32_t capacity)
+{
+    if (index == NULL || slots == NULL || capacity < 4u ||
+        (capacity & (capacity - 1u)) != 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    memset(slots, 0, (size_t)capacity * sizeof(*slots));
+    index->slots = slots;
+    index->capacity = capacity;
+    index->count = 0;
+    return ASX_OK;
+}
+
+/* Linear probe from the hash's home slot. Returns the slot holding an
+ * equivalent fixture, or else the empty slot that ends the run. */
+static asx_codec_semantic_slot *index_probe(const asx_codec_semantic_index *index,
+                                            const asx_canonical_fixture *fixture,
+                                            uint64_t hash)
+{
+    uint32_t mask = index->capacity - 1u;
+    uint32_t pos = (uint32_t)hash & mask;
+
+    /* Load is capped below capacity, so an empty slot always ends the probe */
+    for (;;) { /* ASX_CHECKPOINT_WAIVER("bounded by index capacity") */
+        asx_codec_semantic_slot *slot = &index->slots[pos];
+
+        if (slot->fixture == NULL) return slot;
+        if (slot->hash == hash &&
+            asx_codec_fixture_semantic_eq(slot->fixture, fixture, NULL) == ASX_OK) {
+            return slot;
+        }
+        pos = (pos + 1u) & mask;
+    }
+}
+
+asx_status asx_codec_semantic_index_insert(asx_codec_semantic_index *index,
+                                           const asx_canonical_fixture *fixture,
+                                           const asx_canonical_fixture **out_existing)
+{
+    asx_codec_semantic_slot *slot;
+    uint64_t hash;
+    asx_status st;
+
+    if (index == NULL || index->slots == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = asx_codec_fixture_semantic_hash(fixture, &hash);
+    if (st != ASX_OK) return st;
+
+    slot = index_probe(index, fixture, hash);
+    if (slot->fixture != NULL) {
+        if (out_existing != NULL) *out_existing = slot->fixture;
+        return ASX_E_ALREADY_EXISTS;
+    }
+    if (index->count >= index->capacity - index->capacity / 4u) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    slot->hash = hash;
+    slot->fixture = fixture;
+    index->count++;
+    return ASX_OK;
+}
+
+asx_status asx_codec_semantic_index_find(const asx_codec_semantic_index *index,
+                                         const asx_canonical_fixture *fixture,
+                                         const asx_canonical_fixture **out_match)
+{
+    asx_codec_semantic_slot *slot;
+    uint64_t hash;
+    asx_status st;
+
+    if (index == NULL || index->slots == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = asx_codec_fixture_semantic_hash(fixture, &hash);
+    if (st != ASX_OK) return st;
+
+    slot = index_probe(index, fixture, hash);
+    if (slot->fixture == NULL) return ASX_E_NOT_FOUND;
+    if (out_match != NULL) *out_match = slot->fixture;
+    return ASX_OK;
+}
+
 /* ------------------------------------------------------------------ */
 /* Cross-codec round-trip verification                                 */
 /* ------------------------------------------------------------------ */
 
-asx_status asx_codec_cross_codec_verify(const asx_canonical_fixture *fixture,
-                                        asx_codec_equiv_report *report)
+/* One round trip through caller-owned encode buffers, so a sweep
+ * grows them once instead of allocating per fixture. */
+static asx_status cross_codec_verify_with(const asx_canonical_fixture *fixture,
+                                          asx_codec_equiv_report *report,
+                                          asx_codec_buffer *json_buf,
+                                          asx_codec_buffer *bin_buf)
 {
     asx_canonical_fixture from_json;
     asx_canonical_fixture from_bin;
-    asx_codec_buffer json_buf;
-    asx_codec_buffer bin_buf;
     asx_status st;
-    asx_status result;
 
     if (fixture == NULL) return ASX_E_INVALID_ARGUMENT;
 
     asx_canonical_fixture_init(&from_json);
     asx_canonical_fixture_init(&from_bin);
-    asx_codec_buffer_init(&json_buf);
-    asx_codec_buffer_init(&bin_buf);
 
-    /* Encode as JSON */
-    st = asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, fixture, &json_buf);
-    if (st != ASX_OK) {
-        result = st;
-        goto cleanup;
+    /* Encode as JSON and BIN */
+    st = asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, fixture, json_buf);
+    if (st == ASX_OK) {
+        st = asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, fixture, bin_buf);
     }
 
-    /* Encode as BIN */
-    st = asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, fixture, &bin_buf);
-    if (st != ASX_OK) {
-        result = st;
-        goto cleanup;
+    /* Decode both; the JSON buffer is already NUL-terminated */
+    if (st == ASX_OK) {
+        st = asx_codec_decode_fixture_json(json_buf->data, &from_json);
     }
-
-    /* Decode JSON */
-    st = asx_codec_decode_fixture(ASX_CODEC_KIND_JSON,
-                                  json_buf.data, json_buf.len,
-                                  &from_json);
-    if (st != ASX_OK) {
-        result = st;
-        goto cleanup;
+    if (st == ASX_OK) {
+        st = asx_codec_decode_fixture(ASX_CODEC_KIND_BIN,
+                                      bin_buf->data, bin_buf->len,
+                                      &from_bin);
     }
 
-    /* Decode BIN */
-    st = asx_codec_decode_fixture(ASX_CODEC_KIND_BIN,
-                                  bin_buf.data, bin_buf.len,
-                                  &from_bin);
-    if (st != ASX_OK) {
-        result = st;
-        goto cleanup;
+    /* Compare decoded fixtures for semantic equivalence */
+    if (st == ASX_OK) {
+        st = asx_codec_fixture_semantic_eq(&from_json, &from_bin, report);
     }
 
-    /* Compare decoded fixtures for semantic equivalence */
-    result = asx_codec_fixture_semantic_eq(&from_json, &from_bin, report);
+    asx_canonical_fixture_reset(&from_bin);
+    asx_canonical_fixture_reset(&from_json);
+    return st;
+}
 
-cleanup:
+asx_status asx_codec_cross_codec_verify(const asx_canonical_fixture *fixture,
+                                        asx_codec_equiv_report *report)
+{
+    asx_codec_buffer json_buf;
+    asx_codec_buffer bin_buf;
+    asx_status result;
+
+    if (fixture == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    asx_codec_buffer_init(&json_buf);
+    asx_codec_buffer_init(&bin_buf);
+    result = cross_codec_verify_with(fixture, report, &json_buf, &bin_buf);
     asx_codec_buffer_reset(&bin_buf);
     asx_codec_buffer_reset(&json_buf);
-    asx_canonical_fixture_reset(&from_bin);
-    asx_canonical_fixture_reset(&from_json);
     return result;
 }
+
+/* ------------------------------------------------------------------ */
+/* Batch verification                                                  */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    const asx_canonical_fixture *fixtures;
+    size_t count;
+    uint32_t workers;
+    asx_status *statuses;
+    asx_codec_equiv_report *reports;
+} equiv_batch;
+
+/* Worker w takes fixtures w, w + workers, ... with its own buffers. */
+static void equiv_batch_worker(void *arg, uint32_t worker_index)
+{
+    equiv_batch *b = (equiv_batch *)arg;
+    asx_codec_buffer json_buf;
+    asx_codec_buffer bin_buf;
+    size_t i;
+
+    asx_codec_buffer_init(&json_buf);
+    asx_codec_buffer_init(&bin_buf);
+    for (i = worker_index; i < b->count; i += b->workers) { /* ASX_CHECKPOINT_WAIVER("bounded by caller fixture count") */
+        b->statuses[i] = cross_codec_verify_with(&b->fixtures[i],
+                                                 b->reports != NULL ? &b->reports[i] : NULL,
+                                                 &json_buf, &bin_buf);
+    }
+    asx_codec_buffer_reset(&bin_buf);
+    asx_codec_buffer_reset(&json_buf);
+}
+
+asx_status asx_codec_cross_codec_verify_batch(const asx_canonical_fixture *fixtures,
+                                              size_t count,
+                                              uint32_t workers,
+                                              asx_status *statuses,
+                                              asx_codec_equiv_report *reports)
+{
+    equiv_batch b;
+    uint32_t w;
+    size_t i;
+
+    if ((count > 0u && (fixtures == NULL || statuses == NULL)) ||
+        workers == 0u || workers > ASX_MAX_WORKERS) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    b.fixtures = fixtures;
+    b.count = count;
+    b.statuses = statuses;
+    b.reports = reports;
+
+    /* Threads only where the codec has no shared mutable state: the
+     * active arena is a single bump pointer, and deterministic builds
+     * keep allocation order (and fault injection) reproducible. */
+#if ASX_DETERMINISTIC
+    b.workers = 1u;
+#else
+    b.workers = asx_codec_active_arena() != NULL ? 1u : workers;
+#endif
+    if ((size_t)b.workers > count) b.workers = count > 0u ? (uint32_t)count : 1u;
+
+    if (b.workers == 1u ||
+        asx_runtime_worker_dispatch(b.workers, equiv_batch_worker, &b) != ASX_OK) {
+        for (w = 0; w < b.workers; w++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+            equiv_batch_worker(&b, w);
+        }
+    }
+
+    for (i = 0; i < count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by caller fixture count") */
+        if (statuses[i] != ASX_OK) return statuses[i];
+    }
+    return ASX_OK;
+}
@@ -0,0 +1,388 @@
+/*
+ * event.c — operation-level event log, hash chain and replay locator
+ *
+ * The ring keeps the last ASX_EVENT_LOG_CAPACITY records; the chain and
+ * the checkpoint table cover everything since reset. A full checkpoint
+ * table keeps every second entry and doubles the interval, so it spans
+ * any run in fixed space.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <asx/asx.h>
+#include <asx/runtime/event.h>
+#include <asx/runtime/digest.h>
+#include "codec_internal.h"
+#include "context_internal.h"
+
+#define EVENT_FNV_OFFSET 14695981039346656037ULL
+
+static asx_event_record g_event_ring[ASX_EVENT_LOG_CAPACITY];
+static uint32_t g_event_count;
+static uint64_t g_event_chain = EVENT_FNV_OFFSET;
+static uint64_t g_event_cps[ASX_EVENT_CHECKPOINT_CAPACITY];
+static uint32_t g_event_cp_count;
+static uint32_t g_event_cp_interval = ASX_EVENT_CHECKPOINT_INTERVAL;
+
+static const uint64_t g_event_chain_init = EVENT_FNV_OFFSET;
+static const uint32_t g_event_cp_interval_init = ASX_EVENT_CHECKPOINT_INTERVAL;
+static const asx_context_block g_event_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_event_ring),
+    ASX_CONTEXT_BLOCK(g_event_count),
+    ASX_CONTEXT_BLOCK_INIT(g_event_chain, g_event_chain_init),
+    ASX_CONTEXT_BLOCK(g_event_cps),
+    ASX_CONTEXT_BLOCK(g_event_cp_count),
+    ASX_CONTEXT_BLOCK_INIT(g_event_cp_interval, g_event_cp_interval_init)
+};
+
+const asx_context_module asx_event_context = ASX_CONTEXT_MODULE(g_event_blocks);
+
+void asx_event_log_reset(void)
+{
+    g_event_count = 0;
+    g_event_chain = EVENT_FNV_OFFSET;
+    g_event_cp_count = 0;
+    g_event_cp_interval = ASX_EVENT_CHECKPOINT_INTERVAL;
+}
+
+/* Fold one event into a chain, over its little-endian fields */
+static uint64_t event_chain_step(uint64_t chain, const asx_event_record *ev)
+{
+    uint8_t b[28];
+    uint64_t words[2];
+    uint32_t vals[3];
+    uint32_t i;
+
+    words[0] = ev->entity_id;
+    words[1] = ev->parent_id;
+    vals[0] = (uint32_t)ev->kind;
+    vals[1] = (uint32_t)ev->status;
+    vals[2] = ev->sequence;
+    for (i = 0; i < 8u; i++) {
+        b[i]      = (uint8_t)(words[0] >> (8u * i));
+        b[8u + i] = (uint8_t)(words[1] >> (8u * i));
+    }
+    for (i = 0; i < 4u; i++) {
+        b[16u + i] = (uint8_t)(vals[0] >> (8u * i));
+        b[20u + i] = (uint8_t)(vals[1] >> (8u * i));
+        b[24u + i] = (uint8_t)(vals[2] >> (8u * i));
+    }
+    return asx_digest_fnv1a(chain, b, (uint32_t)sizeof(b));
+}
+
+uint32_t asx_event_emit(asx_event_kind kind,
+                        uint64_t entity_id,
+                        uint64_t parent_id,
+                        asx_status status)
+{
+    asx_event_record *ev = &g_event_ring[g_event_count % ASX_EVENT_LOG_CAPACITY];
+    uint32_t seq = g_event_count;
+
+    ev->kind      = kind;
+    ev->entity_id = entity_id;
+    ev->parent_id = parent_id;
+    ev->sequence  = seq;
+    ev->status    = status;
+    g_event_chain = event_chain_step(g_event_chain, ev);
+    g_event_count++;
+
+    if (g_event_count % g_event_cp_interval == 0) {
+        if (g_event_cp_count == ASX_EVENT_CHECKPOINT_CAPACITY) {
+            uint32_t k;
+
+            /* Keep the checkpoints at the doubled interval */
+            for (k = 0; k < ASX_EVENT_CHECKPOINT_CAPACITY / 2u; k++) {
+                ASX_CHECKPOINT_WAIVER("bounded by ASX_EVENT_CHECKPOINT_CAPACITY");
+                g_event_cps[k] = g_event_cps[2u * k + 1u];
+            }
+            g_event_cp_count = ASX_EVENT_CHECKPOINT_CAPACITY / 2u;
+            g_event_cp_interval *= 2u;
+        }
+        if (g_event_count % g_event_cp_interval == 0) {
+            g_event_cps[g_event_cp_count++] = g_event_chain;
+        }
+    }
+    return seq;
+}
+
+uint32_t asx_event_log_count(void)
+{
+    return g_event_count;
+}
+
+/* Ring record for index, or NULL once it has been overwritten */
+static const asx_event_record *event_at(uint32_t index)
+{
+    if (index >= g_event_count) return NULL;
+    if (g_event_count - index > ASX_EVENT_LOG_CAPACITY) return NULL;
+    return &g_event_ring[index % ASX_EVENT_LOG_CAPACITY];
+}
+
+int asx_event_log_get(uint32_t index, asx_event_record *out)
+{
+    const asx_event_record *ev = event_at(index);
+
+    if (ev == NULL || out == NULL) return 0;
+    *out = *ev;
+    return 1;
+}
+
+uint64_t asx_event_hash_chain(void)
+{
+    return g_event_chain;
+}
+
+uint64_t asx_event_hash_chain_of(const asx_event_record *events, uint32_t count)
+{
+    uint64_t chain = EVENT_FNV_OFFSET;
+    uint32_t i;
+
+    if (events == NULL) return chain;
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by count");
+        chain = event_chain_step(chain, &events[i]);
+    }
+    return chain;
+}
+
+uint32_t asx_event_checkpoint_interval(void)
+{
+    return g_event_cp_interval;
+}
+
+uint32_t asx_event_checkpoints(uint64_t *out, uint32_t capacity)
+{
+    uint32_t n = g_event_cp_count < capacity ? g_event_cp_count : capacity;
+
+    if (out == NULL) return 0;
+    memcpy(out, g_event_cps, (size_t)n * sizeof(out[0]));
+    return n;
+}
+
+/* ------------------------------------------------------------------ */
+/* JSON and names                                                      */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_event_log_to_json(asx_codec_buffer *out)
+{
+    asx_status st;
+    uint32_t first;
+    uint32_t i;
+    int is_first;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    first = g_event_count > ASX_EVENT_LOG_CAPACITY
+          ? g_event_count - ASX_EVENT_LOG_CAPACITY : 0u;
+
+    st = asx_codec_buffer_append_char(out, '[');
+    if (st != ASX_OK) return st;
+    for (i = first; i < g_event_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_EVENT_LOG_CAPACITY");
+        const asx_event_record *ev = event_at(i);
+
+        if (i != first) {
+            st = asx_codec_buffer_append_char(out, ',');
+            if (st != ASX_OK) return st;
+        }
+        st = asx_codec_buffer_append_char(out, '{');
+        if (st != ASX_OK) return st;
+        is_first = 1;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "sequence",
+                                               ev->sequence);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_string_field(out, &is_first, "kind",
+                                                  asx_event_kind_str(ev->kind));
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "entity",
+                                               ev->entity_id);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "parent",
+                                               ev->parent_id);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "status",
+                                               (uint64_t)ev->status);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_char(out, '}');
+        if (st != ASX_OK) return st;
+    }
+    return asx_codec_buffer_append_char(out, ']');
+}
+
+const char *asx_event_kind_str(asx_event_kind kind)
+{
+    switch (kind) {
+    case ASX_EVENT_REGION_OPEN:       return "region_open";
+    case ASX_EVENT_REGION_CLOSE:      return "region_close";
+    case ASX_EVENT_TASK_SPAWN:        return "task_spawn";
+    case ASX_EVENT_TASK_POLL:         return "task_poll";
+    case ASX_EVENT_TASK_COMPLETE:     return "task_complete";
+    case ASX_EVENT_OBLIGATION_CREATE: return "obligation_create";
+    case ASX_EVENT_OBLIGATION_COMMIT: return "obligation_commit";
+    case ASX_EVENT_OBLIGATION_ABORT:  return "obligation_abort";
+    case ASX_EVENT_BUDGET_EXHAUSTED:  return "budget_exhausted";
+    case ASX_EVENT_QUIESCENT:         return "quiescent";
+    case ASX_EVENT_DRAIN_BEGIN:       return "drain_begin";
+    case ASX_EVENT_DRAIN_END:         return "drain_end";
+    case ASX_EVENT_KIND_COUNT:
+    default:                          return "unknown";
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Replay divergence                                                   */
+/* ------------------------------------------------------------------ */
+
+static int event_record_eq(const asx_event_record *a, const asx_event_record *b)
+{
+    return a->kind == b->kind && a->entity_id == b->entity_id &&
+           a->parent_id == b->parent_id && a->sequence == b->sequence &&
+           a->status == b->status;
+}
+
+/* 1 if interval is ASX_EVENT_CHECKPOINT_INTERVAL times a power of two */
+static int event_interval_ok(uint32_t interval)
+{
+    uint32_t q;
+
+    if (interval < ASX_EVENT_CHECKPOINT_INTERVAL ||
+        interval % ASX_EVENT_CHECKPOINT_INTERVAL != 0) {
+        return 0;
+    }
+    q = interval / ASX_EVENT_CHECKPOINT_INTERVAL;
+    return (q & (q - 1u)) == 0;
+}
+
+/*
+ * First event that can differ from expected, found by bisecting the
+ * checkpoints both sides hold at the coarser of the two intervals.
+ * Chains that part stay apart, so "checkpoint k differs" is monotone in
+ * k. Records are then compared from the first differing interval (or
+ * the last common checkpoint) on.
+ */
+static asx_status event_locate(const uint64_t *exp_cps, uint32_t exp_n,
+                               uint32_t exp_interval, int chains_differ,
+                               const asx_event_record *expected,
+                               uint32_t expected_count,
+                               asx_replay_divergence *div)
+{
+    uint32_t step = exp_interval > g_event_cp_interval
+                  ? exp_interval : g_event_cp_interval;
+    uint32_t limit = expected_count < g_event_count ? expected_count : g_event_count;
+    uint32_t m = limit / step;
+    uint32_t lo = 0;
+    uint32_t hi;
+    uint32_t i;
+
+    if ((uint64_t)exp_n * exp_interval / step < m) {
+        m = (uint32_t)((uint64_t)exp_n * exp_interval / step);
+    }
+    if ((uint64_t)g_event_cp_count * g_event_cp_interval / step < m) {
+        m = (uint32_t)((uint64_t)g_event_cp_count * g_event_cp_interval / step);
+    }
+    hi = m;
+    while (lo < hi) {
+        ASX_CHECKPOINT_WAIVER("bounded by log2 of the checkpoint count");
+        uint32_t mid = lo + (hi - lo) / 2u;
+        uint32_t events = (mid + 1u) * step;
+
+        if (g_event_cps[events / g_event_cp_interval - 1u] !=
+            exp_cps[events / exp_interval - 1u]) {
+            hi = mid;
+        } else {
+            lo = mid + 1u;
+        }
+    }
+
+    if (div != NULL) memset(div, 0, sizeof(*div));
+    if (div != NULL) {
+        div->expected_count = expected_count;
+        div->actual_count = g_event_count;
+    }
+    /* A differing checkpoint proves a divergence in its interval even
+     * when the ring no longer holds the records to pin it down. */
+    if (lo < m) chains_differ = 1;
+    for (i = lo * step; i < limit; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by expected_count");
+        const asx_event_record *act = event_at(i);
+
+        if (act == NULL && !chains_differ) continue;
+        if (act == NULL) {
+            if (div != NULL) {
+                div->diverged = 1;
+                div->first_divergence_index = lo * step;
+                div->expected = expected[lo * step];
+            }
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+        if (event_record_eq(act, &expected[i])) continue;
+        if (div != NULL) {
+            div->diverged = 1;
+            div->first_divergence_index = i;
+            div->expected = expected[i];
+            if (act != NULL) div->actual = *act;
+        }
+        return ASX_E_EQUIVALENCE_MISMATCH;
+    }
+    if (expected_count != g_event_count) {
+        if (div != NULL) {
+            const asx_event_record *act = event_at(limit);
+
+            div->diverged = 1;
+            div->count_mismatch = 1;
+            div->first_divergence_index = limit;
+            if (limit < expected_count) div->expected = expected[limit];
+            if (act != NULL) div->actual = *act;
+        }
+        return ASX_E_EQUIVALENCE_MISMATCH;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_event_replay_verify(const asx_event_record *expected,
+                                   uint32_t expected_count,
+                                   asx_replay_divergence *divergence)
+{
+    uint64_t cps[ASX_EVENT_CHECKPOINT_CAPACITY];
+    uint64_t chain = EVENT_FNV_OFFSET;
+    uint32_t n = 0;
+    uint32_t i;
+
+    if (expected == NULL && expected_count != 0) return ASX_E_INVALID_ARGUMENT;
+
+    /* Expected's checkpoints at the live interval, in the same pass */
+    for (i = 0; i < expected_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by expected_count");
+        chain = event_chain_step(chain, &expected[i]);
+        if ((i + 1u) % g_event_cp_interval == 0 &&
+            n < ASX_EVENT_CHECKPOINT_CAPACITY) {
+            cps[n++] = chain;
+        }
+    }
+    if (expected_count == g_event_count && chain == g_event_chain) {
+        if (divergence != NULL) {
+            memset(divergence, 0, sizeof(*divergence));
+            divergence->expected_count = expected_count;
+            divergence->actual_count = g_event_count;
+        }
+        return ASX_OK;
+    }
+    return event_locate(cps, n, g_event_cp_interval, 1, expected,
+                        expected_count, divergence);
+}
+
+asx_status asx_event_replay_locate(const uint64_t *expected_checkpoints,
+                                   uint32_t checkpoint_count,
+                                   uint32_t interval,
+                                   const asx_event_record *expected,
+                                   uint32_t expected_count,
+                                   asx_replay_divergence *divergence)
+{
+    if ((expected_checkpoints == NULL && checkpoint_count != 0) ||
+        (expected == NULL && expected_count != 0) ||
+        !event_interval_ok(interval)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return event_locate(expected_checkpoints, checkpoint_count, interval, 0,
+                        expected, expected_count, divergence);
+}
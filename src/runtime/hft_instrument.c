@@ -1,20 +1,25 @@
 /*
  * hft_instrument.c — HFT profile instrumentation (bd-j4m.3)
  *
- * Implements latency histogram, jitter tracking, deterministic
+ * Implements latency histograms, jitter tracking, deterministic
  * overload policy, and metric gate evaluation for the HFT profile.
  *
  * All operations are single-threaded (no locking) consistent with
- * the asx runtime threading model.
+ * the asx runtime threading model, except per-worker poll latency,
+ * whose slots are written by their workers while snapshots are taken.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/runtime/hft_instrument.h>
+#include <asx/runtime/runtime.h>
+#include <asx/asx_config.h>
+#include "runtime_internal.h"
+#include "context_internal.h"
 #include <stdint.h>
 #include <string.h>
 
-/* ASX_CHECKPOINT_WAIVER_FILE("hft-instrument: all loops bounded by ASX_HFT_HISTOGRAM_BINS (16)") */
+/* ASX_CHECKPOINT_WAIVER_FILE("hft-instrument: all loops bounded by ASX_HFT_HISTOGRAM_BINS (16), ASX_HFT_HDR_COUNTS_MAX or the input length") */
 
 /* -------------------------------------------------------------------
  * Integer log2 — branchless floor(log2(x)) for x > 0
@@ -36,6 +41,14 @@ static uint32_t ilog2(uint64_t x)
     return r;
 }
 
+/* floor(log2(x)) for x > 0 from a count of leading zeros where the
+ * compiler has one; the HDR record path relies on it being O(1). */
+#if defined(__GNUC__) || defined(__clang__)
+#define hdr_log2(x) (63u - (uint32_t)__builtin_clzll(x))
+#else
+#define hdr_log2(x) ilog2(x)
+#endif
+
 /* Bin lower bound for a given bin index. */
 static uint64_t bin_lower(uint32_t bin)
 {
@@ -138,18 +151,312 @@ void asx_hft_histogram_reset(asx_hft_histogram *h)
     asx_hft_histogram_init(h);
 }
 
+void asx_hft_histogram_merge(asx_hft_histogram *dst,
+                             const asx_hft_histogram *src)
+{
+    uint32_t i;
+
+    if (!dst || !src || src->total == 0) return;
+    for (i = 0; i < ASX_HFT_HISTOGRAM_BINS; i++) {
+        dst->bins[i] += src->bins[i];
+    }
+    dst->overflow += src->overflow;
+    dst->total += src->total;
+    dst->sum_ns += src->sum_ns;
+    if (src->min_ns < dst->min_ns) dst->min_ns = src->min_ns;
+    if (src->max_ns > dst->max_ns) dst->max_ns = src->max_ns;
+}
+
+/* -------------------------------------------------------------------
+ * Log-linear histogram
+ *
+ * Bucket index for value v at precision p: values below 2^(p+1) index
+ * themselves; above, with shift = floor(log2 v) - p, the index is
+ * (shift << p) + (v >> shift), where v >> shift is in [2^p, 2^(p+1)).
+ * ------------------------------------------------------------------- */
+
+static uint32_t hdr_index(uint32_t precision, uint64_t v)
+{
+    uint32_t shift;
+
+    if (v < (UINT64_C(2) << precision)) return (uint32_t)v;
+    shift = hdr_log2(v) - precision;
+    return (shift << precision) + (uint32_t)(v >> shift);
+}
+
+/* Highest value that maps to bucket i */
+static uint64_t hdr_upper(uint32_t precision, uint32_t i)
+{
+    uint32_t shift;
+    uint64_t mantissa;
+
+    if (i < (2u << precision)) return i;
+    shift = (i >> precision) - 1u;
+    mantissa = (uint64_t)(i & ((1u << precision) - 1u)) | (UINT64_C(1) << precision);
+    return (mantissa << shift) + ((UINT64_C(1) << shift) - 1u);
+}
+
+static int hdr_layout_valid(uint32_t precision, uint32_t range_bits)
+{
+    return precision >= ASX_HFT_HDR_PRECISION_MIN &&
+           precision <= ASX_HFT_HDR_PRECISION_MAX &&
+           range_bits > precision &&
+           range_bits <= ASX_HFT_HDR_RANGE_BITS_MAX;
+}
+
+asx_status asx_hft_hdr_init(asx_hft_hdr *h, uint32_t precision,
+                            uint32_t range_bits)
+{
+    if (!h || !hdr_layout_valid(precision, range_bits)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    memset(h, 0, sizeof(*h));
+    h->precision = (uint8_t)precision;
+    h->range_bits = (uint8_t)range_bits;
+    h->bucket_count = (range_bits - precision + 1u) << precision;
+    h->min_ns = UINT64_MAX;
+    return ASX_OK;
+}
+
+void asx_hft_hdr_init_default(asx_hft_hdr *h)
+{
+    asx_status st = asx_hft_hdr_init(h, ASX_HFT_HDR_DEFAULT_PRECISION,
+                                     ASX_HFT_HDR_DEFAULT_RANGE_BITS);
+    (void)st;
+}
+
+void asx_hft_hdr_record(asx_hft_hdr *h, uint64_t ns)
+{
+    uint64_t v = ns;
+
+    if (!h || h->bucket_count == 0) return;
+
+    h->total++;
+    h->sum_ns += ns;
+    if (ns < h->min_ns) h->min_ns = ns;
+    if (ns > h->max_ns) h->max_ns = ns;
+
+    if ((ns >> h->range_bits) != 0) {
+        h->overflow++;
+        v = (UINT64_C(1) << h->range_bits) - 1u;
+    }
+    h->counts[hdr_index(h->precision, v)]++;
+}
+
+uint64_t asx_hft_hdr_value_at(const asx_hft_hdr *h, uint32_t ppm)
+{
+    uint64_t target;
+    uint64_t cumulative = 0;
+    uint64_t v;
+    uint32_t i;
+
+    if (!h || h->total == 0) return 0;
+    if (ppm == 0) return h->min_ns;
+    if (ppm > 1000000u) ppm = 1000000u;
+
+    /* Rank of the sample at the quantile, rounded up */
+    target = (h->total * ppm + 999999u) / 1000000u;
+
+    for (i = 0; i < h->bucket_count; i++) {
+        cumulative += h->counts[i];
+        if (cumulative >= target) break;
+    }
+    if (i == h->bucket_count) return h->max_ns;
+    v = hdr_upper(h->precision, i);
+    return v < h->max_ns ? v : h->max_ns;
+}
+
+uint64_t asx_hft_hdr_mean(const asx_hft_hdr *h)
+{
+    if (!h || h->total == 0) return 0;
+    return h->sum_ns / h->total;
+}
+
+asx_status asx_hft_hdr_merge(asx_hft_hdr *dst, const asx_hft_hdr *src)
+{
+    uint32_t i;
+
+    if (!dst || !src) return ASX_E_INVALID_ARGUMENT;
+    if (dst->precision != src->precision ||
+        dst->range_bits != src->range_bits) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < src->bucket_count; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    dst->total += src->total;
+    dst->overflow += src->overflow;
+    dst->sum_ns += src->sum_ns;
+    if (src->min_ns < dst->min_ns) dst->min_ns = src->min_ns;
+    if (src->max_ns > dst->max_ns) dst->max_ns = src->max_ns;
+    return ASX_OK;
+}
+
+void asx_hft_hdr_reset(asx_hft_hdr *h)
+{
+    asx_status st;
+
+    if (!h) return;
+    st = asx_hft_hdr_init(h, h->precision, h->range_bits);
+    (void)st;
+}
+
+/* Binary form: unsigned LEB128 varints after an 8-byte header. With
+ * p == NULL only the length is computed. */
+#define HDR_BINARY_HEADER  8u
+#define HDR_VARINT_MAX     10u
+
+static uint32_t hdr_put_varint(uint8_t *p, uint64_t v)
+{
+    uint32_t n = 0;
+
+    while (v >= 0x80u) {
+        if (p != NULL) p[n] = (uint8_t)((v & 0x7Fu) | 0x80u);
+        v >>= 7;
+        n++;
+    }
+    if (p != NULL) p[n] = (uint8_t)v;
+    return n + 1u;
+}
+
+/* Read one varint from [*p, end); returns 0 on truncation or overlong. */
+static int hdr_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *out)
+{
+    uint64_t v = 0;
+    uint32_t shift = 0;
+    uint32_t n;
+
+    for (n = 0; n < HDR_VARINT_MAX && *p < end; n++) {
+        uint8_t b = *(*p)++;
+        v |= (uint64_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            *out = v;
+            return 1;
+        }
+        shift += 7u;
+    }
+    return 0;
+}
+
+/* Encode h at buf (NULL: measure only); returns the length. */
+static uint32_t hdr_encode(const asx_hft_hdr *h, uint8_t *buf)
+{
+    uint32_t len = HDR_BINARY_HEADER;
+    uint32_t nonzero = 0;
+    uint32_t prev = 0;
+    uint32_t i;
+
+    if (buf != NULL) {
+        buf[0] = (uint8_t)(ASX_HFT_HDR_BINARY_MAGIC & 0xFFu);
+        buf[1] = (uint8_t)((ASX_HFT_HDR_BINARY_MAGIC >> 8) & 0xFFu);
+        buf[2] = (uint8_t)((ASX_HFT_HDR_BINARY_MAGIC >> 16) & 0xFFu);
+        buf[3] = (uint8_t)((ASX_HFT_HDR_BINARY_MAGIC >> 24) & 0xFFu);
+        buf[4] = (uint8_t)ASX_HFT_HDR_BINARY_VERSION;
+        buf[5] = h->precision;
+        buf[6] = h->range_bits;
+        buf[7] = 0;
+    }
+    for (i = 0; i < h->bucket_count; i++) {
+        if (h->counts[i] != 0) nonzero++;
+    }
+    len += hdr_put_varint(buf != NULL ? buf + len : NULL, h->overflow);
+    len += hdr_put_varint(buf != NULL ? buf + len : NULL, h->sum_ns);
+    len += hdr_put_varint(buf != NULL ? buf + len : NULL, h->min_ns);
+    len += hdr_put_varint(buf != NULL ? buf + len : NULL, h->max_ns);
+    len += hdr_put_varint(buf != NULL ? buf + len : NULL, nonzero);
+    for (i = 0; i < h->bucket_count; i++) {
+        if (h->counts[i] == 0) continue;
+        len += hdr_put_varint(buf != NULL ? buf + len : NULL, i - prev);
+        len += hdr_put_varint(buf != NULL ? buf + len : NULL, h->counts[i]);
+        prev = i + 1u;
+    }
+    return len;
+}
+
+asx_status asx_hft_hdr_export(const asx_hft_hdr *h, uint8_t *buf,
+                              uint32_t capacity, uint32_t *out_len)
+{
+    uint32_t needed;
+
+    if (!h || !out_len || h->bucket_count == 0) return ASX_E_INVALID_ARGUMENT;
+    needed = hdr_encode(h, NULL);
+    *out_len = needed;
+    if (!buf || capacity < needed) return ASX_E_BUFFER_TOO_SMALL;
+    (void)hdr_encode(h, buf);
+    return ASX_OK;
+}
+
+asx_status asx_hft_hdr_import(const uint8_t *buf, uint32_t len,
+                              asx_hft_hdr *out)
+{
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t nonzero;
+    uint64_t v;
+    uint32_t magic;
+    uint32_t next = 0;
+    asx_status st;
+
+    if (!buf || !out || len < HDR_BINARY_HEADER) return ASX_E_INVALID_ARGUMENT;
+    magic = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+            ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    if (magic != ASX_HFT_HDR_BINARY_MAGIC ||
+        buf[4] != ASX_HFT_HDR_BINARY_VERSION || buf[7] != 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = asx_hft_hdr_init(out, buf[5], buf[6]);
+    if (st != ASX_OK) return st;
+
+    p = buf + HDR_BINARY_HEADER;
+    end = buf + len;
+    if (!hdr_get_varint(&p, end, &out->overflow) ||
+        !hdr_get_varint(&p, end, &out->sum_ns) ||
+        !hdr_get_varint(&p, end, &out->min_ns) ||
+        !hdr_get_varint(&p, end, &out->max_ns) ||
+        !hdr_get_varint(&p, end, &nonzero) ||
+        nonzero > out->bucket_count) {
+        goto fail;
+    }
+    while (nonzero-- > 0) {
+        uint32_t i;
+
+        if (!hdr_get_varint(&p, end, &v) ||
+            v >= (uint64_t)(out->bucket_count - next)) {
+            goto fail;
+        }
+        i = next + (uint32_t)v;
+        if (!hdr_get_varint(&p, end, &v) || v == 0 || v > UINT32_MAX) {
+            goto fail;
+        }
+        out->counts[i] = (uint32_t)v;
+        out->total += v;
+        next = i + 1u;
+    }
+    if (p != end || out->overflow > out->total) goto fail;
+    return ASX_OK;
+
+fail:
+    asx_hft_hdr_reset(out);
+    return ASX_E_INVALID_ARGUMENT;
+}
+
 /* -------------------------------------------------------------------
  * Jitter tracker
  * ------------------------------------------------------------------- */
 
-void asx_hft_jitter_init(asx_hft_jitter_tracker *jt,
-                          uint32_t recompute_interval)
+void asx_hft_jitter_init(asx_hft_jitter_tracker *jt, uint32_t window)
 {
     if (!jt) return;
+    if (window == 0) window = ASX_HFT_JITTER_WINDOW_DEFAULT;
+    if (window < 2u) window = 2u;
+    if (window > ASX_HFT_JITTER_WINDOW_MAX) window = ASX_HFT_JITTER_WINDOW_MAX;
     asx_hft_histogram_init(&jt->hist);
     jt->mad_ns = 0;
-    jt->recompute_every = recompute_interval;
-    jt->samples_since = 0;
+    jt->mean_q8 = 0;
+    jt->dev_q8 = 0;
+    jt->shift = ilog2(window);
+    jt->samples = 0;
 }
 
 void asx_hft_jitter_recompute(asx_hft_jitter_tracker *jt)
@@ -193,19 +500,42 @@ void asx_hft_jitter_recompute(asx_hft_jitter_tracker *jt)
 
 void asx_hft_jitter_record(asx_hft_jitter_tracker *jt, uint64_t ns)
 {
+    uint64_t x;
+    uint64_t d;
+
     if (!jt) return;
 
     asx_hft_histogram_record(&jt->hist, ns);
-    jt->samples_since++;
 
-    if (jt->recompute_every == 0 ||
-        jt->samples_since >= jt->recompute_every) {
-        asx_hft_jitter_recompute(jt);
-        jt->samples_since = 0;
+    /* Saturate rather than wrap the 24.8 fixed-point sample */
+    x = ns < (UINT64_MAX >> 8) ? ns << 8 : UINT64_MAX & ~UINT64_C(0xFF);
+    if (jt->samples++ == 0) {
+        jt->mean_q8 = x;
+        jt->dev_q8 = 0;
+        return;
+    }
+
+    if (x >= jt->mean_q8) {
+        d = x - jt->mean_q8;
+        jt->mean_q8 += d >> jt->shift;
+    } else {
+        d = jt->mean_q8 - x;
+        jt->mean_q8 -= d >> jt->shift;
+    }
+    if (d >= jt->dev_q8) {
+        jt->dev_q8 += (d - jt->dev_q8) >> jt->shift;
+    } else {
+        jt->dev_q8 -= (jt->dev_q8 - d) >> jt->shift;
     }
 }
 
 uint64_t asx_hft_jitter_get(const asx_hft_jitter_tracker *jt)
+{
+    if (!jt) return 0;
+    return jt->dev_q8 >> 8;
+}
+
+uint64_t asx_hft_jitter_binned(const asx_hft_jitter_tracker *jt)
 {
     if (!jt) return 0;
     return jt->mad_ns;
@@ -213,10 +543,8 @@ uint64_t asx_hft_jitter_get(const asx_hft_jitter_tracker *jt)
 
 void asx_hft_jitter_reset(asx_hft_jitter_tracker *jt)
 {
-    uint32_t interval;
     if (!jt) return;
-    interval = jt->recompute_every;
-    asx_hft_jitter_init(jt, interval);
+    asx_hft_jitter_init(jt, 1u << jt->shift);
 }
 
 /* -------------------------------------------------------------------
@@ -286,6 +614,16 @@ void asx_overload_evaluate(const asx_overload_policy *pol,
     }
 }
 
+uint32_t asx_overload_shed(asx_region_id region,
+                           const asx_overload_decision *decision)
+{
+    if (!decision || !decision->triggered ||
+        decision->mode != ASX_OVERLOAD_SHED_OLDEST) {
+        return 0;
+    }
+    return asx_region_shed_oldest(region, decision->shed_count);
+}
+
 const char *asx_overload_mode_str(asx_overload_mode mode)
 {
     switch (mode) {
@@ -393,18 +731,104 @@ void asx_hft_gate_evaluate(const asx_hft_gate *gate,
     }
 }
 
+void asx_hft_gate_evaluate_hdr(const asx_hft_gate *gate,
+                                const asx_hft_hdr *hdr,
+                                const asx_hft_jitter_tracker *jt,
+                                asx_hft_gate_result *result)
+{
+    if (!gate || !result) return;
+
+    memset(result, 0, sizeof(*result));
+    result->pass = 1;
+
+    if (hdr && gate->p99_ns > 0) {
+        result->actual_p99 = asx_hft_hdr_value_at(hdr, ASX_HFT_PPM_P99);
+        if (result->actual_p99 > gate->p99_ns) {
+            result->violations |= ASX_GATE_VIOLATION_P99;
+        }
+    }
+    if (hdr && gate->p99_9_ns > 0) {
+        result->actual_p99_9 = asx_hft_hdr_value_at(hdr, ASX_HFT_PPM_P99_9);
+        if (result->actual_p99_9 > gate->p99_9_ns) {
+            result->violations |= ASX_GATE_VIOLATION_P99_9;
+        }
+    }
+    if (hdr && gate->p99_99_ns > 0) {
+        result->actual_p99_99 = asx_hft_hdr_value_at(hdr, ASX_HFT_PPM_P99_99);
+        if (result->actual_p99_99 > gate->p99_99_ns) {
+            result->violations |= ASX_GATE_VIOLATION_P99_99;
+        }
+    }
+    if (jt && gate->jitter_ns > 0) {
+        result->actual_jitter = asx_hft_jitter_get(jt);
+        if (result->actual_jitter > gate->jitter_ns) {
+            result->violations |= ASX_GATE_VIOLATION_JITTER;
+        }
+    }
+    if (result->violations != 0) result->pass = 0;
+}
+
 /* -------------------------------------------------------------------
  * Global instrumentation state
  * ------------------------------------------------------------------- */
 
 static asx_hft_histogram      g_sched_hist;
+static asx_hft_histogram      g_cancel_hist;
 static asx_hft_jitter_tracker  g_sched_jitter;
 static int                     g_initialized = 0;
 
+/* -------------------------------------------------------------------
+ * Per-worker poll latency
+ *
+ * A worker announces a record in progress (writing), then reads the
+ * epoch; a snapshot publishes the new epoch, then reads writing. The
+ * seq_cst fences between each store and load guarantee that either
+ * the worker sees the new epoch or the snapshot sees it writing, in
+ * which case the snapshot waits until that record is done or the
+ * worker is seen on the new side. Without compiler atomics, or in
+ * deterministic builds, everything runs on one thread.
+ * ------------------------------------------------------------------- */
+
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define hft_load(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define hft_store(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define hft_fence()      __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define hft_load(p)      (*(p))
+#define hft_store(p, v)  (*(p) = (v))
+#define hft_fence()      ((void)0)
+#endif
+
+typedef struct {
+    asx_hft_histogram side[2];
+    uint32_t          writing;  /* 1 while a record is in progress */
+    uint32_t          seen;     /* epoch of the last record */
+    uint8_t           pad[56];  /* slots never share a cache line */
+} hft_worker_slot;
+
+static hft_worker_slot   g_worker_slots[ASX_HFT_MAX_WORKERS];
+static uint32_t          g_worker_epoch;
+static asx_hft_histogram g_worker_folded;  /* retired sides so far */
+static int               g_worker_folded_init;
+
+static const asx_context_block g_hft_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_sched_hist),
+    ASX_CONTEXT_BLOCK(g_cancel_hist),
+    ASX_CONTEXT_BLOCK(g_sched_jitter),
+    ASX_CONTEXT_BLOCK(g_initialized),
+    ASX_CONTEXT_BLOCK(g_worker_slots),
+    ASX_CONTEXT_BLOCK(g_worker_epoch),
+    ASX_CONTEXT_BLOCK(g_worker_folded),
+    ASX_CONTEXT_BLOCK(g_worker_folded_init)
+};
+
+const asx_context_module asx_hft_context = ASX_CONTEXT_MODULE(g_hft_blocks);
+
 static void ensure_init(void)
 {
     if (!g_initialized) {
         asx_hft_histogram_init(&g_sched_hist);
+        asx_hft_histogram_init(&g_cancel_hist);
         asx_hft_jitter_init(&g_sched_jitter, 64);
         g_initialized = 1;
     }
@@ -413,8 +837,13 @@ static void ensure_init(void)
 void asx_hft_instrument_reset(void)
 {
     asx_hft_histogram_init(&g_sched_hist);
+    asx_hft_histogram_init(&g_cancel_hist);
     asx_hft_jitter_init(&g_sched_jitter, 64);
     g_initialized = 1;
+    memset(g_worker_slots, 0, sizeof(g_worker_slots));
+    g_worker_epoch = 0;
+    asx_hft_histogram_init(&g_worker_folded);
+    g_worker_folded_init = 1;
 }
 
 asx_hft_histogram *asx_hft_sched_histogram(void)
@@ -423,6 +852,12 @@ asx_hft_histogram *asx_hft_sched_histogram(void)
     return &g_sched_hist;
 }
 
+asx_hft_histogram *asx_hft_cancel_histogram(void)
+{
+    ensure_init();
+    return &g_cancel_hist;
+}
+
 asx_hft_jitter_tracker *asx_hft_sched_jitter(void)
 {
     ensure_init();
@@ -431,7 +866,67 @@ asx_hft_jitter_tracker *asx_hft_sched_jitter(void)
 
 void asx_hft_record_poll_latency(uint64_t ns)
 {
+    uint32_t worker = asx_trace_stage_worker();
+
+    if (worker < ASX_HFT_MAX_WORKERS) {
+        asx_hft_record_worker_poll_latency(worker, ns);
+        return;
+    }
     ensure_init();
     asx_hft_histogram_record(&g_sched_hist, ns);
     asx_hft_jitter_record(&g_sched_jitter, ns);
 }
+
+void asx_hft_record_worker_poll_latency(uint32_t worker_index, uint64_t ns)
+{
+    hft_worker_slot *slot;
+    asx_hft_histogram *h;
+    uint32_t epoch;
+
+    if (worker_index >= ASX_HFT_MAX_WORKERS) return;
+    slot = &g_worker_slots[worker_index];
+
+    hft_store(&slot->writing, 1u);
+    hft_fence();
+    epoch = hft_load(&g_worker_epoch);
+    h = &slot->side[epoch & 1u];
+    /* Sides are cleared by zeroing; an empty one has no minimum yet */
+    if (h->total == 0) h->min_ns = UINT64_MAX;
+    asx_hft_histogram_record(h, ns);
+    hft_store(&slot->seen, epoch);
+    hft_store(&slot->writing, 0u);
+}
+
+asx_status asx_hft_sched_snapshot(asx_hft_histogram *out)
+{
+    uint32_t epoch;
+    uint32_t retired;
+    uint32_t w;
+
+    if (!out) return ASX_E_INVALID_ARGUMENT;
+    if (!g_worker_folded_init) {
+        asx_hft_histogram_init(&g_worker_folded);
+        g_worker_folded_init = 1;
+    }
+
+    epoch = g_worker_epoch + 1u;
+    hft_store(&g_worker_epoch, epoch);
+    hft_fence();
+    retired = (epoch & 1u) ^ 1u;
+
+    for (w = 0; w < ASX_HFT_MAX_WORKERS; w++) {
+        hft_worker_slot *slot = &g_worker_slots[w];
+
+        /* At most one record can still target the retired side */
+        while (hft_load(&slot->writing) != 0 &&
+               hft_load(&slot->seen) != epoch) {
+        }
+        asx_hft_histogram_merge(&g_worker_folded, &slot->side[retired]);
+        memset(&slot->side[retired], 0, sizeof(slot->side[retired]));
+    }
+
+    ensure_init();
+    *out = g_sched_hist;
+    asx_hft_histogram_merge(out, &g_worker_folded);
+    return ASX_OK;
+}
@@ -3,10 +3,12 @@
  *
  * Bounded wrapping ring buffer for nondeterministic boundary events.
  * Provides JSON flush for replay diagnostics and FNV-1a digest for
- * deterministic identity comparison.
+ * deterministic identity comparison. The binary flush copies the raw
+ * slots out in one memcpy; JSON can then be rendered from that dump
+ * later, off the trigger path. Both renderers share one ring view.
  *
  * ASX_CHECKPOINT_WAIVER_FILE("hindsight-ring: all loops are bounded by "
- *   "ASX_HINDSIGHT_CAPACITY (256) or integer-conversion constants. "
+ *   "the ring capacity or integer-conversion constants. "
  *   "Flush/digest functions are diagnostic-only, not on task poll path.")
  *
  * SPDX-License-Identifier: MIT
@@ -14,31 +16,76 @@
 
 #include <asx/runtime/hindsight.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/digest.h>
 #include <asx/core/ghost.h>
 #include <string.h>
+#include "context_internal.h"
 
 /* -------------------------------------------------------------------
  * Ring buffer state
  * ------------------------------------------------------------------- */
 
-static asx_hindsight_event g_ring[ASX_HINDSIGHT_CAPACITY];
-static uint32_t g_write_index;   /* next slot to write (wrapping) */
+static asx_hindsight_event g_ring_builtin[ASX_HINDSIGHT_CAPACITY];
+static asx_hindsight_event *g_ring = g_ring_builtin;
+static uint32_t g_capacity = ASX_HINDSIGHT_CAPACITY;
+static uint32_t g_write_index;   /* next slot to write, < g_capacity */
 static uint32_t g_total_count;   /* total events ever logged */
 static uint32_t g_next_sequence; /* monotonic per-event sequence */
 
 /* Default flush policy: both triggers enabled */
-static asx_hindsight_policy g_policy = { 1, 1 };
+static asx_hindsight_policy g_hindsight_policy = { 1, 1 };
+
+/* Per-kind sampling (configuration survives init/reset, counters do not) */
+typedef struct {
+    asx_hindsight_sampling cfg;
+    uint32_t seen;          /* events offered since reset */
+    uint32_t dropped;       /* events not recorded since reset */
+    uint32_t window_start;  /* trace sequence the current window began at */
+    uint32_t window_used;   /* events recorded in the current window */
+} hs_kind_sampling;
+
+static hs_kind_sampling g_sampling[ASX_ND_KIND_COUNT];
+static uint32_t g_sampling_kinds;   /* kinds with a non-default config */
+static uint32_t g_ghost_route_flushes;
+
+static asx_hindsight_event *const g_ring_init = g_ring_builtin;
+static const uint32_t g_capacity_init = ASX_HINDSIGHT_CAPACITY;
+static const asx_hindsight_policy g_hindsight_policy_init = { 1, 1 };
+static const asx_context_block g_hindsight_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_ring_builtin),
+    ASX_CONTEXT_BLOCK_INIT(g_ring, g_ring_init),
+    ASX_CONTEXT_BLOCK_INIT(g_capacity, g_capacity_init),
+    ASX_CONTEXT_BLOCK(g_write_index),
+    ASX_CONTEXT_BLOCK(g_total_count),
+    ASX_CONTEXT_BLOCK(g_next_sequence),
+    ASX_CONTEXT_BLOCK_INIT(g_hindsight_policy, g_hindsight_policy_init),
+    ASX_CONTEXT_BLOCK(g_sampling),
+    ASX_CONTEXT_BLOCK(g_sampling_kinds),
+    ASX_CONTEXT_BLOCK(g_ghost_route_flushes)
+};
+
+const asx_context_module asx_hindsight_context = ASX_CONTEXT_MODULE(g_hindsight_blocks);
 
 /* -------------------------------------------------------------------
  * Init / Reset
  * ------------------------------------------------------------------- */
 
+/* Readers stop at the logged count and the logger clears each slot it
+ * takes, so the ring itself is never swept: its untouched pages stay
+ * untouched. */
 void asx_hindsight_init(void)
 {
-    memset(g_ring, 0, sizeof(g_ring));
+    uint32_t k;
+
     g_write_index = 0;
     g_total_count = 0;
     g_next_sequence = 0;
+    for (k = 0; k < (uint32_t)ASX_ND_KIND_COUNT; k++) {
+        g_sampling[k].seen = 0;
+        g_sampling[k].dropped = 0;
+        g_sampling[k].window_start = 0;
+        g_sampling[k].window_used = 0;
+    }
 }
 
 void asx_hindsight_reset(void)
@@ -46,27 +93,137 @@ void asx_hindsight_reset(void)
     asx_hindsight_init();
 }
 
+asx_status asx_hindsight_init_with(asx_hindsight_event *storage,
+                                   uint32_t capacity)
+{
+    if (capacity == 0) return ASX_E_INVALID_ARGUMENT;
+    if (storage == NULL && capacity > ASX_HINDSIGHT_CAPACITY) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    g_ring = storage != NULL ? storage : g_ring_builtin;
+    g_capacity = capacity;
+    asx_hindsight_init();
+    return ASX_OK;
+}
+
+uint32_t asx_hindsight_capacity(void)
+{
+    return g_capacity;
+}
+
 /* -------------------------------------------------------------------
  * Event logging
  * ------------------------------------------------------------------- */
 
+/* Sampling decision for one offered event: 1 to record, 0 to drop.
+ * Windows are measured in trace events so the decision replays. */
+static int hs_sample(asx_nd_event_kind kind)
+{
+    hs_kind_sampling *st;
+    uint32_t k = (uint32_t)kind;
+
+    if (k >= (uint32_t)ASX_ND_KIND_COUNT) return 1;
+    st = &g_sampling[k];
+    st->seen++;
+
+    if (st->cfg.sample_every > 1u &&
+        (st->seen - 1u) % st->cfg.sample_every != 0) {
+        st->dropped++;
+        return 0;
+    }
+    if (st->cfg.max_per_window > 0) {
+        if (st->cfg.window > 0) {
+            uint32_t now = asx_trace_event_count();
+            if (now - st->window_start >= st->cfg.window) {
+                st->window_start = now;
+                st->window_used = 0;
+            }
+        }
+        if (st->window_used >= st->cfg.max_per_window) {
+            st->dropped++;
+            return 0;
+        }
+        st->window_used++;
+    }
+    return 1;
+}
+
 void asx_hindsight_log(asx_nd_event_kind kind,
                         uint64_t entity_id,
                         uint64_t observed_value)
 {
-    uint32_t idx = g_write_index % ASX_HINDSIGHT_CAPACITY;
-    asx_hindsight_event *e = &g_ring[idx];
+    asx_hindsight_event *e;
+
+    if (g_sampling_kinds != 0 && !hs_sample(kind)) return;
 
+    e = &g_ring[g_write_index];
+
+    memset(e, 0, sizeof(*e));
     e->sequence = g_next_sequence++;
     e->kind = kind;
     e->entity_id = entity_id;
     e->observed_value = observed_value;
     e->trace_seq = asx_trace_event_count();
 
-    g_write_index++;
+    if (++g_write_index == g_capacity) g_write_index = 0;
     g_total_count++;
 }
 
+/* -------------------------------------------------------------------
+ * Sampling configuration
+ * ------------------------------------------------------------------- */
+
+static int hs_sampling_is_default(const asx_hindsight_sampling *cfg)
+{
+    return cfg->sample_every <= 1u && cfg->max_per_window == 0;
+}
+
+asx_status asx_hindsight_set_sampling(asx_nd_event_kind kind,
+                                      const asx_hindsight_sampling *cfg)
+{
+    hs_kind_sampling *st;
+    uint32_t k = (uint32_t)kind;
+
+    if (k >= (uint32_t)ASX_ND_KIND_COUNT) return ASX_E_INVALID_ARGUMENT;
+    st = &g_sampling[k];
+
+    if (!hs_sampling_is_default(&st->cfg)) g_sampling_kinds--;
+    if (cfg != NULL) {
+        st->cfg = *cfg;
+    } else {
+        memset(&st->cfg, 0, sizeof(st->cfg));
+    }
+    if (!hs_sampling_is_default(&st->cfg)) g_sampling_kinds++;
+
+    st->window_start = asx_trace_event_count();
+    st->window_used = 0;
+    return ASX_OK;
+}
+
+asx_hindsight_sampling asx_hindsight_sampling_active(asx_nd_event_kind kind)
+{
+    asx_hindsight_sampling none;
+    uint32_t k = (uint32_t)kind;
+
+    if (k >= (uint32_t)ASX_ND_KIND_COUNT) {
+        memset(&none, 0, sizeof(none));
+        return none;
+    }
+    return g_sampling[k].cfg;
+}
+
+uint32_t asx_hindsight_seen_count(asx_nd_event_kind kind)
+{
+    uint32_t k = (uint32_t)kind;
+    return k < (uint32_t)ASX_ND_KIND_COUNT ? g_sampling[k].seen : 0;
+}
+
+uint32_t asx_hindsight_dropped_count(asx_nd_event_kind kind)
+{
+    uint32_t k = (uint32_t)kind;
+    return k < (uint32_t)ASX_ND_KIND_COUNT ? g_sampling[k].dropped : 0;
+}
+
 /* -------------------------------------------------------------------
  * Queries
  * ------------------------------------------------------------------- */
@@ -78,38 +235,68 @@ uint32_t asx_hindsight_total_count(void)
 
 uint32_t asx_hindsight_readable_count(void)
 {
-    if (g_total_count <= ASX_HINDSIGHT_CAPACITY) {
+    if (g_total_count <= g_capacity) {
         return g_total_count;
     }
-    return ASX_HINDSIGHT_CAPACITY;
+    return g_capacity;
 }
 
 int asx_hindsight_overflowed(void)
 {
-    return g_total_count > ASX_HINDSIGHT_CAPACITY;
+    return g_total_count > g_capacity;
 }
 
-int asx_hindsight_get(uint32_t index, asx_hindsight_event *out)
-{
-    uint32_t readable;
-    uint32_t oldest_slot;
-    uint32_t actual_slot;
+/* -------------------------------------------------------------------
+ * Ring view — the live ring or a binary dump of one
+ * ------------------------------------------------------------------- */
 
-    if (out == NULL) return 0;
+typedef struct {
+    const uint8_t *slots;      /* raw asx_hindsight_event records */
+    uint32_t       capacity;
+    uint32_t       total_count;
+    uint32_t       write_index;
+    uint64_t       digest;
+} hs_view;
 
-    readable = asx_hindsight_readable_count();
-    if (index >= readable) return 0;
+static uint32_t view_readable(const hs_view *v)
+{
+    return v->total_count <= v->capacity ? v->total_count : v->capacity;
+}
 
-    if (g_total_count <= ASX_HINDSIGHT_CAPACITY) {
-        /* Ring has not wrapped — direct index */
-        *out = g_ring[index];
-    } else {
+/* Record at logical index (0 = oldest); index must be readable. The
+ * dump may be unaligned, so records are copied out bytewise. */
+static void view_get(const hs_view *v, uint32_t index, asx_hindsight_event *out)
+{
+    uint32_t slot = index;
+
+    if (v->total_count > v->capacity) {
         /* Ring has wrapped — oldest is at write_index */
-        oldest_slot = g_write_index % ASX_HINDSIGHT_CAPACITY;
-        actual_slot = (oldest_slot + index) % ASX_HINDSIGHT_CAPACITY;
-        *out = g_ring[actual_slot];
+        slot = (v->write_index + index) % v->capacity;
     }
+    memcpy(out, v->slots + (size_t)slot * sizeof(asx_hindsight_event),
+           sizeof(asx_hindsight_event));
+}
+
+static hs_view live_view(void)
+{
+    hs_view v;
+    v.slots = (const uint8_t *)g_ring;
+    v.capacity = g_capacity;
+    v.total_count = g_total_count;
+    v.write_index = g_write_index;
+    v.digest = 0;
+    return v;
+}
 
+int asx_hindsight_get(uint32_t index, asx_hindsight_event *out)
+{
+    hs_view v;
+
+    if (out == NULL) return 0;
+
+    v = live_view();
+    if (index >= view_readable(&v)) return 0;
+    view_get(&v, index, out);
     return 1;
 }
 
@@ -199,31 +386,27 @@ static void flush_hex64(asx_hindsight_flush_buffer *buf, uint64_t val)
  * JSON flush
  * ------------------------------------------------------------------- */
 
-asx_status asx_hindsight_flush_json(asx_hindsight_flush_buffer *out)
+static void flush_render(asx_hindsight_flush_buffer *out, const hs_view *v)
 {
-    uint32_t readable;
+    uint32_t readable = view_readable(v);
     uint32_t i;
     asx_hindsight_event ev;
 
-    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
-
     out->len = 0;
     out->data[0] = '\0';
 
-    readable = asx_hindsight_readable_count();
-
     flush_str(out, "{\"total_count\":");
-    flush_u32(out, g_total_count);
+    flush_u32(out, v->total_count);
     flush_str(out, ",\"overflowed\":");
-    flush_str(out, asx_hindsight_overflowed() ? "true" : "false");
+    flush_str(out, v->total_count > v->capacity ? "true" : "false");
     flush_str(out, ",\"capacity\":");
-    flush_u32(out, ASX_HINDSIGHT_CAPACITY);
+    flush_u32(out, v->capacity);
     flush_str(out, ",\"digest\":");
-    flush_hex64(out, asx_hindsight_digest());
+    flush_hex64(out, v->digest);
     flush_str(out, ",\"events\":[");
 
     for (i = 0; i < readable; i++) {
-        if (!asx_hindsight_get(i, &ev)) break;
+        view_get(v, i, &ev);
 
         if (i > 0) flush_str(out, ",");
         flush_str(out, "{\"seq\":");
@@ -242,29 +425,111 @@ asx_status asx_hindsight_flush_json(asx_hindsight_flush_buffer *out)
     }
 
     flush_str(out, "]}");
+}
+
+asx_status asx_hindsight_flush_json(asx_hindsight_flush_buffer *out)
+{
+    hs_view v;
 
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    v = live_view();
+    v.digest = asx_hindsight_digest();
+    flush_render(out, &v);
     return ASX_OK;
 }
 
 /* -------------------------------------------------------------------
- * FNV-1a digest
+ * Binary flush and deferred render
+ *
+ * Header (host order, the records are raw host structs):
+ *   magic, version, record_size, capacity, total_count, write_index
+ *   (uint32 each), digest (uint64). Then the readable slots verbatim,
+ *   in slot order; the renderer rotates them using write_index.
  * ------------------------------------------------------------------- */
 
-static uint64_t hs_fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
+static void dump_put32(uint8_t *p, uint32_t v) { memcpy(p, &v, 4); }
+
+static uint32_t dump_get32(const uint8_t *p)
 {
-    const uint8_t *p = (const uint8_t *)data;
-    uint32_t i;
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+asx_status asx_hindsight_flush_binary(uint8_t *buf, uint32_t capacity,
+                                      uint32_t *out_len)
+{
+    uint32_t readable;
+    uint32_t needed;
+    uint64_t digest;
+
+    if (buf == NULL || out_len == NULL) return ASX_E_INVALID_ARGUMENT;
 
-    for (i = 0; i < len; i++) {
-        hash ^= (uint64_t)p[i];
-        hash *= 0x00000100000001B3ULL;
+    readable = asx_hindsight_readable_count();
+    needed = ASX_HINDSIGHT_DUMP_HEADER +
+             readable * (uint32_t)sizeof(asx_hindsight_event);
+    if (capacity < needed) {
+        *out_len = needed;
+        return ASX_E_BUFFER_TOO_SMALL;
     }
-    return hash;
+
+    digest = asx_hindsight_digest();
+    dump_put32(buf + 0, ASX_HINDSIGHT_DUMP_MAGIC);
+    dump_put32(buf + 4, ASX_HINDSIGHT_DUMP_VERSION);
+    dump_put32(buf + 8, (uint32_t)sizeof(asx_hindsight_event));
+    dump_put32(buf + 12, g_capacity);
+    dump_put32(buf + 16, g_total_count);
+    dump_put32(buf + 20, g_write_index);
+    memcpy(buf + 24, &digest, 8);
+    memcpy(buf + ASX_HINDSIGHT_DUMP_HEADER, g_ring,
+           (size_t)readable * sizeof(asx_hindsight_event));
+
+    *out_len = needed;
+    return ASX_OK;
 }
 
+asx_status asx_hindsight_render_json(const uint8_t *dump, uint32_t len,
+                                     asx_hindsight_flush_buffer *out)
+{
+    hs_view v;
+    uint32_t readable;
+
+    if (dump == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (len < ASX_HINDSIGHT_DUMP_HEADER) return ASX_E_INVALID_ARGUMENT;
+    if (dump_get32(dump + 0) != ASX_HINDSIGHT_DUMP_MAGIC ||
+        dump_get32(dump + 4) != ASX_HINDSIGHT_DUMP_VERSION ||
+        dump_get32(dump + 8) != (uint32_t)sizeof(asx_hindsight_event)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    v.slots = dump + ASX_HINDSIGHT_DUMP_HEADER;
+    v.capacity = dump_get32(dump + 12);
+    v.total_count = dump_get32(dump + 16);
+    v.write_index = dump_get32(dump + 20);
+    memcpy(&v.digest, dump + 24, 8);
+    if (v.capacity == 0 || v.write_index >= v.capacity) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    readable = view_readable(&v);
+    if ((len - ASX_HINDSIGHT_DUMP_HEADER) / (uint32_t)sizeof(asx_hindsight_event)
+            < readable) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    flush_render(out, &v);
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Digest (FNV-1a or WORD64, per the hindsight digest domain)
+ * ------------------------------------------------------------------- */
+
 uint64_t asx_hindsight_digest(void)
 {
     uint64_t hash = 0x517cc1b727220a95ULL;
+    asx_digest_mode mode = asx_digest_get_mode(ASX_DIGEST_DOMAIN_HINDSIGHT);
     uint32_t readable;
     uint32_t i;
     asx_hindsight_event ev;
@@ -275,11 +540,18 @@ uint64_t asx_hindsight_digest(void)
         uint32_t k;
         if (!asx_hindsight_get(i, &ev)) break;
         k = (uint32_t)ev.kind;
-        hash = hs_fnv1a_mix(hash, &ev.sequence, sizeof(ev.sequence));
-        hash = hs_fnv1a_mix(hash, &k, sizeof(k));
-        hash = hs_fnv1a_mix(hash, &ev.entity_id, sizeof(ev.entity_id));
-        hash = hs_fnv1a_mix(hash, &ev.observed_value, sizeof(ev.observed_value));
-        hash = hs_fnv1a_mix(hash, &ev.trace_seq, sizeof(ev.trace_seq));
+        if (mode == ASX_DIGEST_WORD64) {
+            hash = asx_digest_word(hash, (uint64_t)ev.sequence | ((uint64_t)k << 32));
+            hash = asx_digest_word(hash, ev.entity_id);
+            hash = asx_digest_word(hash, ev.observed_value);
+            hash = asx_digest_word(hash, (uint64_t)ev.trace_seq);
+            continue;
+        }
+        hash = asx_digest_fnv1a(hash, &ev.sequence, sizeof(ev.sequence));
+        hash = asx_digest_fnv1a(hash, &k, sizeof(k));
+        hash = asx_digest_fnv1a(hash, &ev.entity_id, sizeof(ev.entity_id));
+        hash = asx_digest_fnv1a(hash, &ev.observed_value, sizeof(ev.observed_value));
+        hash = asx_digest_fnv1a(hash, &ev.trace_seq, sizeof(ev.trace_seq));
     }
 
     return hash;
@@ -303,7 +575,7 @@ asx_status asx_hindsight_flush_on_divergence(
     }
 
     /* Respect flush policy */
-    if (!g_policy.flush_on_divergence) {
+    if (!g_hindsight_policy.flush_on_divergence) {
         return ASX_E_PENDING;
     }
 
@@ -325,6 +597,7 @@ const char *asx_nd_event_kind_str(asx_nd_event_kind kind)
     case ASX_ND_SIGNAL_ARRIVAL:   return "signal_arrival";
     case ASX_ND_SCHED_TIE_BREAK: return "sched_tie_break";
     case ASX_ND_TIMER_COALESCE:   return "timer_coalesce";
+    case ASX_ND_ADAPTER_DIVERGENCE: return "adapter_divergence";
     case ASX_ND_KIND_COUNT:       return "unknown";
     default:                      return "unknown";
     }
@@ -337,13 +610,13 @@ const char *asx_nd_event_kind_str(asx_nd_event_kind kind)
 void asx_hindsight_set_policy(const asx_hindsight_policy *policy)
 {
     if (policy != NULL) {
-        g_policy = *policy;
+        g_hindsight_policy = *policy;
     }
 }
 
 asx_hindsight_policy asx_hindsight_policy_active(void)
 {
-    return g_policy;
+    return g_hindsight_policy;
 }
 
 /* -------------------------------------------------------------------
@@ -360,13 +633,37 @@ asx_status asx_hindsight_flush_on_invariant(asx_hindsight_flush_buffer *out)
     }
 
     /* Only flush if policy allows it */
-    if (!g_policy.flush_on_invariant) {
+    if (!g_hindsight_policy.flush_on_invariant) {
         return ASX_E_PENDING;
     }
 
     return asx_hindsight_flush_json(out);
 }
 
+/* Flush into the routed buffer as each violation is recorded */
+static void hindsight_ghost_sink(void *ctx, const asx_ghost_violation *v)
+{
+    (void)v;
+    if (!g_hindsight_policy.flush_on_invariant) {
+        return;
+    }
+    if (asx_hindsight_flush_json((asx_hindsight_flush_buffer *)ctx) == ASX_OK) {
+        g_ghost_route_flushes++;
+    }
+}
+
+void asx_hindsight_route_ghost(asx_hindsight_flush_buffer *out)
+{
+    g_ghost_route_flushes = 0;
+    asx_ghost_set_violation_sink(out != NULL ? hindsight_ghost_sink : NULL,
+                                 out);
+}
+
+uint32_t asx_hindsight_ghost_flush_count(void)
+{
+    return g_ghost_route_flushes;
+}
+
 /* -------------------------------------------------------------------
  * Divergence detection
  * ------------------------------------------------------------------- */
@@ -375,3 +672,24 @@ int asx_hindsight_check_divergence(uint64_t expected_digest)
 {
     return asx_hindsight_digest() != expected_digest;
 }
+
+asx_status asx_hindsight_check_window(uint32_t window,
+                                      uint64_t expected_digest,
+                                      asx_hindsight_flush_buffer *out)
+{
+    uint64_t local;
+
+    if (!asx_trace_window_get(window, &local)) {
+        if (asx_trace_digest_window() != 0 &&
+            window >= asx_trace_window_count()) {
+            return ASX_E_PENDING;
+        }
+        return ASX_E_NOT_FOUND;
+    }
+    if (local == expected_digest) return ASX_OK;
+
+    if (out != NULL && g_hindsight_policy.flush_on_divergence) {
+        (void)asx_hindsight_flush_json(out);
+    }
+    return ASX_E_REPLAY_MISMATCH;
+}
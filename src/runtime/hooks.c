@@ -5,6 +5,7 @@
  *   - Hook initialization with safe defaults (malloc-based allocator, stderr log)
  *   - Deterministic mode validation (forbids ambient entropy, requires logical clock)
  *   - Allocator seal for hardened/no-allocation profiles
+ *   - Seeded xoshiro256** PRNG with jump() streams (default entropy hook)
  *   - Hook-backed runtime helpers that dispatch through the active hook table
  *
  * ASX_CHECKPOINT_WAIVER_FILE("codec-and-hooks: all loops in this file are either "
@@ -18,9 +19,14 @@
 #include <asx/asx_config.h>
 #include <asx/portable.h>
 #include <asx/runtime/hindsight.h>
+#include <asx/runtime/runtime.h>
 #include <asx/codec/codec.h>
 #include <asx/codec/equivalence.h>
+#include <asx/runtime/digest.h>
+#include <asx/core/resource.h>
+#include "../core/entity_hash.h"
 #include "codec_internal.h"
+#include "context_internal.h"
 #include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -54,18 +60,146 @@ static asx_time default_logical_clock(void *ctx) {
     return 0; /* logical clock starts at 0, advanced by runtime */
 }
 
+#if !defined(ASX_PROFILE_POSIX) && !defined(ASX_PROFILE_WIN32)
 static asx_time default_wall_clock(void *ctx) {
     (void)ctx;
-    return 0; /* stub: real platforms override this */
+    return 0; /* stub: platform adapters provide a real clock */
+}
+#endif
+
+/* -------------------------------------------------------------------
+ * Seeded PRNG: xoshiro256** (Blackman & Vigna), splitmix64 seeding
+ * ------------------------------------------------------------------- */
+
+static uint64_t prng_rotl(uint64_t x, unsigned k) {
+    return (x << k) | (x >> (64u - k));
+}
+
+void asx_prng_seed(asx_prng *rng, uint64_t seed) {
+    uint32_t i;
+
+    if (!rng) return;
+    for (i = 0; i < 4u; i++) {
+        uint64_t z;
+
+        seed += 0x9E3779B97F4A7C15ULL;
+        z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t asx_prng_next(asx_prng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = prng_rotl(s[1] * 5u, 7) * 9u;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = prng_rotl(s[3], 45);
+    return result;
+}
+
+void asx_prng_jump(asx_prng *rng) {
+    static const uint64_t jump[4] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+    uint64_t acc[4] = {0, 0, 0, 0};
+    uint32_t i, b;
+
+    if (!rng) return;
+    for (i = 0; i < 4u; i++) {
+        for (b = 0; b < 64u; b++) {
+            if (jump[i] & ((uint64_t)1 << b)) {
+                acc[0] ^= rng->s[0];
+                acc[1] ^= rng->s[1];
+                acc[2] ^= rng->s[2];
+                acc[3] ^= rng->s[3];
+            }
+            (void)asx_prng_next(rng);
+        }
+    }
+    memcpy(rng->s, acc, sizeof(acc));
+}
+
+void asx_prng_stream(const asx_prng *root, uint32_t index, asx_prng *out) {
+    uint32_t i;
+
+    if (!root || !out) return;
+    *out = *root;
+    for (i = 0; i < index; i++) asx_prng_jump(out);
+}
+
+uint64_t asx_prng_random_u64(void *ctx) {
+    return ctx ? asx_prng_next((asx_prng *)ctx) : 0u;
+}
+
+asx_status asx_prng_install(asx_prng *rng, asx_runtime_hooks *hooks) {
+    if (!rng || !hooks) return ASX_E_INVALID_ARGUMENT;
+    hooks->entropy.ctx = rng;
+    hooks->entropy.random_u64_fn = asx_prng_random_u64;
+    hooks->deterministic_seeded_prng = 1;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Simulated clock
+ * ------------------------------------------------------------------- */
+
+void asx_sim_clock_init(asx_sim_clock *clock, asx_time start) {
+    if (clock) clock->now = start;
+}
+
+asx_time asx_sim_clock_now(void *ctx) {
+    return ((const asx_sim_clock *)ctx)->now;
+}
+
+static asx_status sim_clock_wait(void *ctx, uint32_t timeout_ms,
+                                 uint32_t *ready_count) {
+    asx_sim_clock *clock = (asx_sim_clock *)ctx;
+    uint64_t step = (uint64_t)timeout_ms * 1000000u;
+
+    clock->now = step > UINT64_MAX - clock->now ? UINT64_MAX : clock->now + step;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+static asx_status sim_clock_ghost_wait(void *ctx, uint64_t logical_step,
+                                       uint32_t *ready_count) {
+    asx_sim_clock *clock = (asx_sim_clock *)ctx;
+
+    if (logical_step > clock->now) clock->now = logical_step;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+asx_status asx_sim_clock_install(asx_sim_clock *clock, asx_runtime_hooks *hooks) {
+    if (!clock || !hooks) return ASX_E_INVALID_ARGUMENT;
+    hooks->clock.ctx = clock;
+    hooks->clock.now_ns_fn = asx_sim_clock_now;
+    hooks->clock.logical_now_ns_fn = asx_sim_clock_now;
+    hooks->reactor.ctx = clock;
+    hooks->reactor.wait_fn = sim_clock_wait;
+    hooks->reactor.ghost_wait_fn = sim_clock_ghost_wait;
+    return ASX_OK;
 }
 
+/* Default entropy hook: one process-wide stream, seeded on first use */
+static asx_prng g_default_prng;
+static int g_default_prng_seeded;
+
 static uint64_t default_seeded_entropy(void *ctx) {
-    /* Deterministic PRNG: simple counter-based default.
-     * Real deployments should provide a proper seeded PRNG. */
-    static uint64_t state = 0x5DEECE66DULL;
     (void)ctx;
-    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
-    return state;
+    if (!g_default_prng_seeded) {
+        asx_prng_seed(&g_default_prng, 0x5DEECE66DULL);
+        g_default_prng_seeded = 1;
+    }
+    return asx_prng_next(&g_default_prng);
 }
 
 static asx_status default_ghost_reactor_wait(void *ctx, uint64_t logical_step,
@@ -117,17 +251,40 @@ asx_containment_policy asx_containment_policy_active(void) {
 }
 
 /* ------------------------------------------------------------------ */
-/* Fault injection state (deterministic-mode only)                    */
+/* Fault injection state                                              */
+/*                                                                    */
+/* Hooks check one armed bit before touching the fault table, so      */
+/* builds with no faults injected take a straight-line path. With     */
+/* ASX_FAULT_INJECTION 0 the checks are compiled out entirely.        */
 /* ------------------------------------------------------------------ */
 
+#if ASX_FAULT_INJECTION
+
 #define ASX_FAULT_MAX_ACTIVE 8u
 
+/* g_fault_armed bits: hooks with at least one fault injected */
+#define FAULT_ARMED_CLOCK   1u
+#define FAULT_ARMED_ENTROPY 2u
+#define FAULT_ARMED_ALLOC   4u
+
 static asx_fault_injection g_faults[ASX_FAULT_MAX_ACTIVE];
 static uint32_t g_fault_count = 0;
+static uint32_t g_fault_armed = 0;
 static uint32_t g_fault_clock_calls = 0;
 static uint32_t g_fault_entropy_calls = 0;
 static uint32_t g_fault_alloc_calls = 0;
 
+static uint32_t fault_armed_bit(asx_fault_kind kind) {
+    switch (kind) {
+        case ASX_FAULT_CLOCK_SKEW:
+        case ASX_FAULT_CLOCK_REVERSE: return FAULT_ARMED_CLOCK;
+        case ASX_FAULT_ENTROPY_CONST: return FAULT_ARMED_ENTROPY;
+        case ASX_FAULT_ALLOC_FAIL:    return FAULT_ARMED_ALLOC;
+        case ASX_FAULT_NONE:          return 0;
+    }
+    return 0;
+}
+
 asx_status asx_fault_inject(const asx_fault_injection *fault) {
     if (!fault) return ASX_E_INVALID_ARGUMENT;
     if (fault->kind == ASX_FAULT_NONE) return ASX_E_INVALID_ARGUMENT;
@@ -135,12 +292,14 @@ asx_status asx_fault_inject(const asx_fault_injection *fault) {
         return ASX_E_RESOURCE_EXHAUSTED;
     g_faults[g_fault_count] = *fault;
     g_fault_count++;
+    g_fault_armed |= fault_armed_bit(fault->kind);
     return ASX_OK;
 }
 
 asx_status asx_fault_clear(void) {
     memset(g_faults, 0, sizeof(g_faults));
     g_fault_count = 0;
+    g_fault_armed = 0;
     g_fault_clock_calls = 0;
     g_fault_entropy_calls = 0;
     g_fault_alloc_calls = 0;
@@ -162,6 +321,73 @@ static int fault_should_fire(asx_fault_injection *f, uint32_t call_number) {
     return 1;
 }
 
+/* Nonzero when an allocation fault fires for this call */
+static int fault_apply_alloc(void) {
+    uint32_t i;
+    int fire = 0;
+
+    for (i = 0; i < g_fault_count; i++) {
+        if (g_faults[i].kind == ASX_FAULT_ALLOC_FAIL &&
+            fault_should_fire(&g_faults[i], g_fault_alloc_calls)) {
+            fire = 1;
+            break;
+        }
+    }
+    g_fault_alloc_calls++;
+    return fire;
+}
+
+static asx_time fault_apply_clock(asx_time raw) {
+    uint32_t i;
+
+    for (i = 0; i < g_fault_count; i++) {
+        if (g_faults[i].kind == ASX_FAULT_CLOCK_SKEW &&
+            fault_should_fire(&g_faults[i], g_fault_clock_calls)) {
+            raw += (asx_time)g_faults[i].param;
+        } else if (g_faults[i].kind == ASX_FAULT_CLOCK_REVERSE &&
+                   fault_should_fire(&g_faults[i], g_fault_clock_calls)) {
+            if (raw >= (asx_time)g_faults[i].param) {
+                raw -= (asx_time)g_faults[i].param;
+            } else {
+                raw = 0;
+            }
+        }
+    }
+    g_fault_clock_calls++;
+    return raw;
+}
+
+static uint64_t fault_apply_entropy(uint64_t value) {
+    uint32_t i;
+
+    for (i = 0; i < g_fault_count; i++) {
+        if (g_faults[i].kind == ASX_FAULT_ENTROPY_CONST &&
+            fault_should_fire(&g_faults[i], g_fault_entropy_calls)) {
+            value = g_faults[i].param;
+        }
+    }
+    g_fault_entropy_calls++;
+    return value;
+}
+
+#else /* !ASX_FAULT_INJECTION */
+
+asx_status asx_fault_inject(const asx_fault_injection *fault) {
+    if (!fault) return ASX_E_INVALID_ARGUMENT;
+    if (fault->kind == ASX_FAULT_NONE) return ASX_E_INVALID_ARGUMENT;
+    return ASX_E_INVALID_STATE;
+}
+
+asx_status asx_fault_clear(void) {
+    return ASX_OK;
+}
+
+uint32_t asx_fault_injection_count(void) {
+    return 0;
+}
+
+#endif /* ASX_FAULT_INJECTION */
+
 /* ------------------------------------------------------------------ */
 /* Hook initialization                                                */
 /* ------------------------------------------------------------------ */
@@ -178,11 +404,23 @@ asx_status asx_runtime_hooks_init(asx_runtime_hooks *hooks) {
     /* Log sink is opt-in (NULL by default) */
 
     /* Deterministic-safe defaults: logical clock, seeded PRNG, ghost reactor */
+#if defined(ASX_PROFILE_POSIX) || defined(ASX_PROFILE_WIN32)
+    hooks->clock.now_ns_fn         = asx_platform_monotonic_now_ns;
+#else
     hooks->clock.now_ns_fn         = default_wall_clock;
+#endif
     hooks->clock.logical_now_ns_fn = default_logical_clock;
     hooks->entropy.random_u64_fn   = default_seeded_entropy;
     hooks->reactor.ghost_wait_fn   = default_ghost_reactor_wait;
 
+    /* Worker threads only where the platform adapter provides them */
+#if defined(ASX_PROFILE_POSIX) || defined(ASX_PROFILE_WIN32)
+    hooks->threads.dispatch_fn     = asx_platform_worker_dispatch;
+    hooks->threads.yield_fn        = asx_platform_thread_yield;
+    hooks->threads.pin_fn          = asx_platform_thread_pin;
+    hooks->threads.switches_fn     = asx_platform_thread_switches;
+#endif
+
     hooks->deterministic_seeded_prng = 1;
     hooks->allocator_sealed = 0;
 
@@ -258,54 +496,223 @@ asx_status asx_runtime_seal_allocator(void) {
 /* Hook-backed runtime helpers                                        */
 /* ------------------------------------------------------------------ */
 
-asx_status asx_runtime_alloc(size_t size, void **out_ptr) {
+/* Allocation accounting. Live blocks are tracked by address in a
+ * fixed table so free and realloc can debit the right tag without
+ * changing the block layout; a block freed through a hook that never
+ * saw it (e.g. a codec field set with plain malloc) is not debited.
+ * Blocks past the table's capacity are counted in `untracked`. */
+#if ASX_ALLOC_PROFILE
+typedef struct {
+    uint64_t size;
+    uint32_t tag;
+} alloc_block;
+
+#define ALLOC_SLOTS (2u * ASX_ALLOC_PROFILE_BLOCKS)
+
+typedef char alloc_blocks_is_pow2
+    [(ASX_ALLOC_PROFILE_BLOCKS & (ASX_ALLOC_PROFILE_BLOCKS - 1u)) == 0u ? 1 : -1];
+
+static asx_alloc_snapshot g_alloc_stats;
+static uint64_t    g_alloc_keys[ALLOC_SLOTS];
+static uint8_t     g_alloc_used[ALLOC_SLOTS];
+static alloc_block g_alloc_blocks[ALLOC_SLOTS];
+#define ALLOC_HASH_INIT { \
+    g_alloc_keys, g_alloc_used, (uint8_t *)g_alloc_blocks, \
+    sizeof(alloc_block), ALLOC_SLOTS - 1u, ASX_ALLOC_PROFILE_BLOCKS, 0 \
+}
+static asx_entity_hash g_alloc_hash = ALLOC_HASH_INIT;
+static const asx_entity_hash g_alloc_hash_init = ALLOC_HASH_INIT;
+
+static void alloc_track(void *ptr, asx_alloc_tag tag, size_t size)
+{
+    asx_alloc_site_stats *site = &g_alloc_stats.site[tag];
+    alloc_block *b;
+
+    site->bytes += (uint64_t)size;
+    b = (alloc_block *)asx_entity_hash_insert(&g_alloc_hash,
+                                              (uint64_t)(uintptr_t)ptr);
+    if (b == NULL) {
+        g_alloc_stats.untracked++;
+        return;
+    }
+    b->size = (uint64_t)size;
+    b->tag = (uint32_t)tag;
+    site->live_bytes += b->size;
+    if (site->live_bytes > site->peak_bytes) site->peak_bytes = site->live_bytes;
+    g_alloc_stats.live_bytes += b->size;
+    if (g_alloc_stats.live_bytes > g_alloc_stats.peak_bytes)
+        g_alloc_stats.peak_bytes = g_alloc_stats.live_bytes;
+}
+
+/* Debit and forget ptr; returns 1 when it was tracked. */
+static int alloc_untrack(void *ptr)
+{
+    alloc_block *b = (alloc_block *)asx_entity_hash_find(&g_alloc_hash,
+                                                         (uint64_t)(uintptr_t)ptr);
+
+    if (b == NULL) return 0;
+    g_alloc_stats.site[b->tag].live_bytes -= b->size;
+    g_alloc_stats.live_bytes -= b->size;
+    asx_entity_hash_remove(&g_alloc_hash, b);
+    return 1;
+}
+#endif
+
+/* Hooks, faults and allocation accounting belong to a runtime context;
+ * the codec arena and frame version are process-wide codec settings. */
+static const asx_context_block g_hooks_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_default_prng),
+    ASX_CONTEXT_BLOCK(g_default_prng_seeded),
+    ASX_CONTEXT_BLOCK(g_hooks),
+    ASX_CONTEXT_BLOCK(g_hooks_installed),
+#if ASX_FAULT_INJECTION
+    ASX_CONTEXT_BLOCK(g_faults),
+    ASX_CONTEXT_BLOCK(g_fault_count),
+    ASX_CONTEXT_BLOCK(g_fault_armed),
+    ASX_CONTEXT_BLOCK(g_fault_clock_calls),
+    ASX_CONTEXT_BLOCK(g_fault_entropy_calls),
+    ASX_CONTEXT_BLOCK(g_fault_alloc_calls),
+#endif
+#if ASX_ALLOC_PROFILE
+    ASX_CONTEXT_BLOCK(g_alloc_stats),
+    ASX_CONTEXT_BLOCK(g_alloc_keys),
+    ASX_CONTEXT_BLOCK(g_alloc_used),
+    ASX_CONTEXT_BLOCK(g_alloc_blocks),
+    ASX_CONTEXT_BLOCK_INIT(g_alloc_hash, g_alloc_hash_init),
+#endif
+};
+
+const asx_context_module asx_hooks_context = ASX_CONTEXT_MODULE(g_hooks_blocks);
+
+asx_status asx_runtime_alloc_tagged(asx_alloc_tag tag, size_t size,
+                                    void **out_ptr) {
     void *p;
-    uint32_t i;
 
-    if (!out_ptr) return ASX_E_INVALID_ARGUMENT;
+    if (!out_ptr || (unsigned)tag >= (unsigned)ASX_ALLOC_TAG_COUNT)
+        return ASX_E_INVALID_ARGUMENT;
     if (!g_hooks_installed) return ASX_E_INVALID_STATE;
-    if (g_hooks.allocator_sealed) return ASX_E_ALLOCATOR_SEALED;
+    if (g_hooks.allocator_sealed) {
+#if ASX_ALLOC_PROFILE
+        g_alloc_stats.sealed_rejects++;
+#endif
+        return ASX_E_ALLOCATOR_SEALED;
+    }
     if (!g_hooks.allocator.malloc_fn) return ASX_E_INVALID_STATE;
 
-    /* Check for allocation fault injection */
-    for (i = 0; i < g_fault_count; i++) {
-        if (g_faults[i].kind == ASX_FAULT_ALLOC_FAIL &&
-            fault_should_fire(&g_faults[i], g_fault_alloc_calls)) {
-            g_fault_alloc_calls++;
-            return ASX_E_RESOURCE_EXHAUSTED;
-        }
-    }
-    g_fault_alloc_calls++;
+#if ASX_FAULT_INJECTION
+    if ((g_fault_armed & FAULT_ARMED_ALLOC) && fault_apply_alloc())
+        return ASX_E_RESOURCE_EXHAUSTED;
+#endif
 
     p = g_hooks.allocator.malloc_fn(g_hooks.allocator.ctx, size);
     if (!p) return ASX_E_RESOURCE_EXHAUSTED;
+#if ASX_ALLOC_PROFILE
+    g_alloc_stats.site[tag].allocs++;
+    alloc_track(p, tag, size);
+#endif
     *out_ptr = p;
     return ASX_OK;
 }
 
-asx_status asx_runtime_realloc(void *ptr, size_t size, void **out_ptr) {
+asx_status asx_runtime_realloc_tagged(asx_alloc_tag tag, void *ptr,
+                                      size_t size, void **out_ptr) {
     void *p;
-    if (!out_ptr) return ASX_E_INVALID_ARGUMENT;
+
+    if (!out_ptr || (unsigned)tag >= (unsigned)ASX_ALLOC_TAG_COUNT)
+        return ASX_E_INVALID_ARGUMENT;
     if (!g_hooks_installed) return ASX_E_INVALID_STATE;
-    if (g_hooks.allocator_sealed) return ASX_E_ALLOCATOR_SEALED;
+    if (g_hooks.allocator_sealed) {
+#if ASX_ALLOC_PROFILE
+        g_alloc_stats.sealed_rejects++;
+#endif
+        return ASX_E_ALLOCATOR_SEALED;
+    }
     if (!g_hooks.allocator.realloc_fn) return ASX_E_INVALID_STATE;
 
     p = g_hooks.allocator.realloc_fn(g_hooks.allocator.ctx, ptr, size);
     if (!p && size > 0) return ASX_E_RESOURCE_EXHAUSTED;
+#if ASX_ALLOC_PROFILE
+    if (ptr != NULL) {
+        (void)alloc_untrack(ptr);
+        g_alloc_stats.site[tag].reallocs++;
+    } else {
+        g_alloc_stats.site[tag].allocs++;
+    }
+    if (p != NULL) alloc_track(p, tag, size);
+#endif
     *out_ptr = p;
     return ASX_OK;
 }
 
+asx_status asx_runtime_alloc(size_t size, void **out_ptr) {
+    return asx_runtime_alloc_tagged(ASX_ALLOC_TAG_OTHER, size, out_ptr);
+}
+
+asx_status asx_runtime_realloc(void *ptr, size_t size, void **out_ptr) {
+    return asx_runtime_realloc_tagged(ASX_ALLOC_TAG_OTHER, ptr, size, out_ptr);
+}
+
 asx_status asx_runtime_free(void *ptr) {
     if (!g_hooks_installed) return ASX_E_INVALID_STATE;
     if (!g_hooks.allocator.free_fn) return ASX_E_INVALID_STATE;
+#if ASX_ALLOC_PROFILE
+    if (ptr != NULL) {
+        alloc_block *b = (alloc_block *)asx_entity_hash_find(
+            &g_alloc_hash, (uint64_t)(uintptr_t)ptr);
+
+        if (b != NULL) g_alloc_stats.site[b->tag].frees++;
+        (void)alloc_untrack(ptr);
+    }
+#endif
     g_hooks.allocator.free_fn(g_hooks.allocator.ctx, ptr);
     return ASX_OK;
 }
 
+asx_status asx_resource_alloc_snapshot_get(asx_alloc_snapshot *out) {
+    if (!out) return ASX_E_INVALID_ARGUMENT;
+#if ASX_ALLOC_PROFILE
+    *out = g_alloc_stats;
+    return ASX_OK;
+#else
+    return ASX_E_INVALID_STATE;
+#endif
+}
+
+void asx_resource_alloc_snapshot_reset(void) {
+#if ASX_ALLOC_PROFILE
+    uint32_t i;
+
+    for (i = 0; i < (uint32_t)ASX_ALLOC_TAG_COUNT; i++) {
+        asx_alloc_site_stats *site = &g_alloc_stats.site[i];
+
+        site->allocs = site->reallocs = site->frees = site->bytes = 0;
+        site->peak_bytes = site->live_bytes;
+    }
+    g_alloc_stats.peak_bytes = g_alloc_stats.live_bytes;
+    g_alloc_stats.sealed_rejects = 0;
+    g_alloc_stats.unhooked = 0;
+    g_alloc_stats.untracked = 0;
+#endif
+}
+
+const char *asx_alloc_tag_str(asx_alloc_tag tag) {
+    switch (tag) {
+    case ASX_ALLOC_TAG_OTHER:     return "other";
+    case ASX_ALLOC_TAG_ARENA:     return "arena";
+    case ASX_ALLOC_TAG_CAPTURE:   return "capture";
+    case ASX_ALLOC_TAG_CLEANUP:   return "cleanup";
+    case ASX_ALLOC_TAG_TIMER:     return "timer";
+    case ASX_ALLOC_TAG_CHANNEL:   return "channel";
+    case ASX_ALLOC_TAG_CODEC:     return "codec";
+    case ASX_ALLOC_TAG_EVENT_LOG: return "event_log";
+    case ASX_ALLOC_TAG_BUFFER:    return "buffer";
+    case ASX_ALLOC_TAG_COUNT:     return "unknown";
+    default:                      return "unknown";
+    }
+}
+
 asx_status asx_runtime_now_ns(asx_time *out_now) {
     asx_time raw;
-    uint32_t i;
 
     if (!out_now) return ASX_E_INVALID_ARGUMENT;
     if (!g_hooks_installed) return ASX_E_INVALID_STATE;
@@ -321,32 +728,20 @@ asx_status asx_runtime_now_ns(asx_time *out_now) {
         return ASX_E_INVALID_STATE;
     }
 
-    /* Apply clock fault injection */
-    for (i = 0; i < g_fault_count; i++) {
-        if (g_faults[i].kind == ASX_FAULT_CLOCK_SKEW &&
-            fault_should_fire(&g_faults[i], g_fault_clock_calls)) {
-            raw += (asx_time)g_faults[i].param;
-        } else if (g_faults[i].kind == ASX_FAULT_CLOCK_REVERSE &&
-                   fault_should_fire(&g_faults[i], g_fault_clock_calls)) {
-            if (raw >= (asx_time)g_faults[i].param) {
-                raw -= (asx_time)g_faults[i].param;
-            } else {
-                raw = 0;
-            }
-        }
-    }
-    g_fault_clock_calls++;
+#if ASX_FAULT_INJECTION
+    if (g_fault_armed & FAULT_ARMED_CLOCK) raw = fault_apply_clock(raw);
+#endif
 
+#if ASX_HINDSIGHT
     /* Log nondeterministic clock boundary event */
     asx_hindsight_log(ASX_ND_CLOCK_READ, 0, (uint64_t)raw);
+#endif
 
     *out_now = raw;
     return ASX_OK;
 }
 
 asx_status asx_runtime_random_u64(uint64_t *out_value) {
-    uint32_t i;
-
     if (!out_value) return ASX_E_INVALID_ARGUMENT;
     if (!g_hooks_installed) return ASX_E_INVALID_STATE;
 
@@ -358,17 +753,15 @@ asx_status asx_runtime_random_u64(uint64_t *out_value) {
     if (!g_hooks.entropy.random_u64_fn) return ASX_E_INVALID_STATE;
     *out_value = g_hooks.entropy.random_u64_fn(g_hooks.entropy.ctx);
 
-    /* Apply entropy fault injection */
-    for (i = 0; i < g_fault_count; i++) {
-        if (g_faults[i].kind == ASX_FAULT_ENTROPY_CONST &&
-            fault_should_fire(&g_faults[i], g_fault_entropy_calls)) {
-            *out_value = g_faults[i].param;
-        }
-    }
-    g_fault_entropy_calls++;
+#if ASX_FAULT_INJECTION
+    if (g_fault_armed & FAULT_ARMED_ENTROPY)
+        *out_value = fault_apply_entropy(*out_value);
+#endif
 
+#if ASX_HINDSIGHT
     /* Log nondeterministic entropy boundary event */
     asx_hindsight_log(ASX_ND_ENTROPY_READ, 0, *out_value);
+#endif
 
     return ASX_OK;
 }
@@ -383,22 +776,26 @@ asx_status asx_runtime_reactor_wait(uint32_t timeout_ms,
     if (g_hooks.reactor.ghost_wait_fn) {
         asx_status rs_ = g_hooks.reactor.ghost_wait_fn(
             g_hooks.reactor.ctx, logical_step, out_ready_count);
+#if ASX_HINDSIGHT
         if (rs_ == ASX_OK) {
             asx_hindsight_log(
                 *out_ready_count > 0 ? ASX_ND_IO_READY : ASX_ND_IO_TIMEOUT,
                 0, (uint64_t)*out_ready_count);
         }
+#endif
         return rs_;
     }
 #endif
     if (g_hooks.reactor.wait_fn) {
         asx_status rs_ = g_hooks.reactor.wait_fn(
             g_hooks.reactor.ctx, timeout_ms, out_ready_count);
+#if ASX_HINDSIGHT
         if (rs_ == ASX_OK) {
             asx_hindsight_log(
                 *out_ready_count > 0 ? ASX_ND_IO_READY : ASX_ND_IO_TIMEOUT,
                 0, (uint64_t)*out_ready_count);
         }
+#endif
         return rs_;
     }
     return ASX_E_INVALID_STATE;
@@ -411,6 +808,95 @@ asx_status asx_runtime_log_write(int level, const char *message) {
     return ASX_OK;
 }
 
+asx_status asx_runtime_worker_dispatch(uint32_t worker_count,
+                                       asx_worker_entry_fn entry,
+                                       void *arg) {
+    if (!entry || worker_count == 0) return ASX_E_INVALID_ARGUMENT;
+    if (!g_hooks_installed) return ASX_E_INVALID_STATE;
+    if (!g_hooks.threads.dispatch_fn) return ASX_E_HOOK_MISSING;
+    return g_hooks.threads.dispatch_fn(g_hooks.threads.ctx, worker_count,
+                                       entry, arg);
+}
+
+asx_status asx_runtime_thread_yield(void) {
+    if (!g_hooks_installed) return ASX_E_INVALID_STATE;
+    if (!g_hooks.threads.yield_fn) return ASX_E_HOOK_MISSING;
+    g_hooks.threads.yield_fn(g_hooks.threads.ctx);
+    return ASX_OK;
+}
+
+asx_status asx_runtime_thread_pin(uint64_t cpu_mask) {
+    if (cpu_mask == 0u) return ASX_E_INVALID_ARGUMENT;
+    if (!g_hooks_installed) return ASX_E_INVALID_STATE;
+    if (!g_hooks.threads.pin_fn) return ASX_E_HOOK_MISSING;
+    return g_hooks.threads.pin_fn(g_hooks.threads.ctx, cpu_mask);
+}
+
+asx_status asx_runtime_thread_switches(uint64_t *out_count) {
+    if (!out_count) return ASX_E_INVALID_ARGUMENT;
+    if (!g_hooks_installed) return ASX_E_INVALID_STATE;
+    if (!g_hooks.threads.switches_fn) return ASX_E_HOOK_MISSING;
+    return g_hooks.threads.switches_fn(g_hooks.threads.ctx, out_count);
+}
+
+/* Reserve op's obligation and hand op to the file hook */
+static asx_status file_submit(asx_region_id region, asx_file_op *op)
+{
+    asx_status st;
+
+    if (!g_hooks_installed) return ASX_E_INVALID_STATE;
+    if (!g_hooks.file.submit_fn) return ASX_E_HOOK_MISSING;
+    st = asx_obligation_reserve(region, &op->obligation);
+    if (st != ASX_OK) return st;
+    op->result = 0;
+    op->done = 0;
+    st = g_hooks.file.submit_fn(g_hooks.file.ctx, op);
+    if (st != ASX_OK) {
+        asx_status ab = asx_obligation_abort(op->obligation);
+        (void)ab;
+        op->done = 1;
+    }
+    return st;
+}
+
+asx_status asx_runtime_file_write(asx_region_id region, asx_file_op *op,
+                                  int64_t handle, const void *buf,
+                                  uint32_t len, uint64_t offset) {
+    if (!op || (!buf && len > 0) || len > (uint32_t)INT32_MAX || handle < 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    op->kind = ASX_FILE_OP_WRITE;
+    op->handle = handle;
+    op->buf = buf;
+    op->len = len;
+    op->offset = offset;
+    return file_submit(region, op);
+}
+
+asx_status asx_runtime_file_fsync(asx_region_id region, asx_file_op *op,
+                                  int64_t handle) {
+    if (!op || handle < 0) return ASX_E_INVALID_ARGUMENT;
+    op->kind = ASX_FILE_OP_FSYNC;
+    op->handle = handle;
+    op->buf = NULL;
+    op->len = 0;
+    op->offset = 0;
+    return file_submit(region, op);
+}
+
+asx_status asx_runtime_file_complete(asx_file_op *op, int32_t result) {
+    int ok;
+
+    if (!op) return ASX_E_INVALID_ARGUMENT;
+    if (op->done) return ASX_E_INVALID_STATE;
+    op->result = result;
+    op->done = 1;
+    ok = op->kind == ASX_FILE_OP_WRITE ? result >= 0 && (uint32_t)result == op->len
+                                       : result == 0;
+    return ok ? asx_obligation_commit(op->obligation)
+              : asx_obligation_abort(op->obligation);
+}
+
 /* ------------------------------------------------------------------ */
 /* Config initialization                                              */
 /* ------------------------------------------------------------------ */
@@ -419,8 +905,10 @@ void asx_runtime_config_init(asx_runtime_config *cfg) {
     if (!cfg) return;
     memset(cfg, 0, sizeof(*cfg));
     cfg->size = (uint32_t)sizeof(*cfg);
-#if defined(ASX_PROFILE_EMBEDDED_ROUTER) || defined(ASX_PROFILE_HFT)
+#if defined(ASX_PROFILE_HFT)
     cfg->wait_policy = ASX_WAIT_BUSY_SPIN;
+#elif defined(ASX_PROFILE_EMBEDDED_ROUTER)
+    cfg->wait_policy = ASX_WAIT_ADAPTIVE;
 #elif defined(ASX_PROFILE_AUTOMOTIVE)
     cfg->wait_policy = ASX_WAIT_SLEEP;
 #else
@@ -438,34 +926,165 @@ void asx_runtime_config_init(asx_runtime_config *cfg) {
 /* Codec schema + JSON baseline implementation (bd-2n0.1)             */
 /* ------------------------------------------------------------------ */
 
-static int asx_codec_text_nonempty(const char *text)
+/* Codec allocations go to the active arena when one is set, otherwise
+ * through the allocator hooks (seal and ASX_FAULT_ALLOC_FAIL apply).
+ * Before any hooks are installed they fall back to libc so standalone
+ * fixture tooling keeps working. */
+static asx_codec_arena *g_codec_arena = NULL;
+
+void asx_codec_arena_init(asx_codec_arena *arena, void *mem, size_t cap)
 {
-    return text != NULL && text[0] != '\0';
+    if (arena == NULL) {
+        return;
+    }
+    arena->base = (uint8_t *)mem;
+    arena->cap = (mem != NULL) ? cap : 0u;
+    arena->used = 0u;
+    arena->last = 0u;
 }
 
-static int asx_codec_is_lower_hex(char ch)
+void asx_codec_arena_reset(asx_codec_arena *arena)
 {
-    return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f');
+    if (arena == NULL) {
+        return;
+    }
+    arena->used = 0u;
+    arena->last = 0u;
 }
 
-static const char *asx_codec_json_skip_ws(const char *cursor)
+void asx_codec_set_arena(asx_codec_arena *arena)
 {
-    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') {
-        cursor++;
-    }
-    return cursor;
+    g_codec_arena = arena;
 }
 
-static asx_status asx_codec_json_scan_string(const char *cursor, const char **out_next)
+asx_codec_arena *asx_codec_active_arena(void)
 {
-    const char *scan;
+    return g_codec_arena;
+}
 
-    if (cursor == NULL || out_next == NULL || *cursor != '"') {
+static asx_status asx_codec_alloc(asx_codec_arena *arena, size_t size, void **out_ptr)
+{
+    void *p;
+    size_t offset;
+
+    if (arena != NULL) {
+        offset = (arena->used + 7u) & ~(size_t)7u;
+        if (offset < arena->used || offset > arena->cap ||
+            size > arena->cap - offset) {
+            return ASX_E_RESOURCE_EXHAUSTED;
+        }
+        arena->last = offset;
+        arena->used = offset + size;
+        *out_ptr = arena->base + offset;
+        return ASX_OK;
+    }
+    if (g_hooks_installed) {
+        return asx_runtime_alloc_tagged(ASX_ALLOC_TAG_CODEC, size, out_ptr);
+    }
+#if ASX_ALLOC_PROFILE
+    g_alloc_stats.unhooked++;
+#endif
+    p = malloc(size);
+    if (p == NULL) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    *out_ptr = p;
+    return ASX_OK;
+}
+
+/* Grow a block of old_size bytes. The newest arena block grows in
+ * place; older ones are copied to a fresh block. */
+static asx_status asx_codec_grow(asx_codec_arena *arena, void *ptr,
+                                 size_t old_size, size_t size, void **out_ptr)
+{
+    void *p;
+    asx_status st;
+
+    if (arena != NULL) {
+        if (ptr != NULL && (uint8_t *)ptr == arena->base + arena->last &&
+            size <= arena->cap - arena->last) {
+            arena->used = arena->last + size;
+            *out_ptr = ptr;
+            return ASX_OK;
+        }
+        st = asx_codec_alloc(arena, size, &p);
+        if (st != ASX_OK) {
+            return st;
+        }
+        if (ptr != NULL && old_size > 0u) {
+            memcpy(p, ptr, old_size);
+        }
+        *out_ptr = p;
+        return ASX_OK;
+    }
+    if (g_hooks_installed) {
+        return asx_runtime_realloc_tagged(ASX_ALLOC_TAG_CODEC, ptr, size, out_ptr);
+    }
+#if ASX_ALLOC_PROFILE
+    g_alloc_stats.unhooked++;
+#endif
+    p = realloc(ptr, size);
+    if (p == NULL) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    *out_ptr = p;
+    return ASX_OK;
+}
+
+/* Arena blocks are not freed individually; only the newest is popped
+ * so scratch copies do not pile up. */
+static void asx_codec_release(asx_codec_arena *arena, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    if (arena != NULL) {
+        if ((uint8_t *)ptr == arena->base + arena->last) {
+            arena->used = arena->last;
+        }
+        return;
+    }
+    if (g_hooks_installed) {
+        (void)asx_runtime_free(ptr);
+        return;
+    }
+    free(ptr);
+}
+
+static int asx_codec_text_nonempty(const char *text)
+{
+    return text != NULL && text[0] != '\0';
+}
+
+static int asx_codec_is_lower_hex(char ch)
+{
+    return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f');
+}
+
+const char *asx_codec_json_skip_ws(const char *cursor)
+{
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') {
+        cursor++;
+    }
+    return cursor;
+}
+
+asx_status asx_codec_json_scan_string(const char *cursor, const char **out_next)
+{
+    const char *scan;
+
+    if (cursor == NULL || out_next == NULL || *cursor != '"') {
         return ASX_E_INVALID_ARGUMENT;
     }
 
+    /* strcspn hops over plain runs; libc implementations classify
+     * 16-32 bytes per step where the target has vector units. */
     scan = cursor + 1;
-    while (*scan != '\0') {
+    for (;;) {
+        scan += strcspn(scan, "\"\\");
+        if (*scan == '\0') {
+            break;
+        }
         if (*scan == '"') {
             *out_next = scan + 1;
             return ASX_OK;
@@ -544,8 +1163,6 @@ static asx_status asx_codec_json_scan_number(const char *cursor, const char **ou
     return ASX_OK;
 }
 
-static asx_status asx_codec_json_scan_value(const char *cursor, const char **out_next, uint32_t depth);
-
 static asx_status asx_codec_json_scan_array(const char *cursor, const char **out_next, uint32_t depth)
 {
     const char *scan;
@@ -627,7 +1244,7 @@ static asx_status asx_codec_json_scan_object(const char *cursor, const char **ou
     }
 }
 
-static asx_status asx_codec_json_scan_value(const char *cursor, const char **out_next, uint32_t depth)
+asx_status asx_codec_json_scan_value(const char *cursor, const char **out_next, uint32_t depth)
 {
     const char *scan;
 
@@ -689,14 +1306,25 @@ static int asx_codec_json_value_matches(const char *json_text, char required_fir
     return *next == '\0';
 }
 
+static int asx_codec_json_raw_matches(const char *json_text,
+                                      char required_first_char,
+                                      int raw_scanned)
+{
+    if (raw_scanned) {
+        return json_text != NULL && json_text[0] == required_first_char;
+    }
+    return asx_codec_json_value_matches(json_text, required_first_char);
+}
+
 static char *asx_codec_strdup_range(const char *begin, size_t len)
 {
+    void *mem;
     char *copy;
 
-    copy = (char *)malloc(len + 1u);
-    if (copy == NULL) {
+    if (asx_codec_alloc(g_codec_arena, len + 1u, &mem) != ASX_OK) {
         return NULL;
     }
+    copy = (char *)mem;
     if (len > 0u) {
         memcpy(copy, begin, len);
     }
@@ -709,15 +1337,60 @@ static int asx_codec_key_equals(const char *lhs, const char *rhs)
     return lhs != NULL && rhs != NULL && strcmp(lhs, rhs) == 0;
 }
 
+/* Unescape the JSON string body [readp, end) into out, which must hold
+ * at least end - readp bytes. \uXXXX escapes decode to '?'. */
+static asx_status asx_codec_json_unescape(const char *readp,
+                                          const char *end,
+                                          char *out,
+                                          size_t *out_len)
+{
+    size_t write_index = 0u;
+
+    while (readp < end) {
+        if (*readp == '\\') {
+            readp++;
+            if (readp >= end) {
+                return ASX_E_INVALID_ARGUMENT;
+            }
+            switch (*readp) {
+            case '"':  out[write_index++] = '"';  break;
+            case '\\': out[write_index++] = '\\'; break;
+            case '/':  out[write_index++] = '/';  break;
+            case 'b':  out[write_index++] = '\b'; break;
+            case 'f':  out[write_index++] = '\f'; break;
+            case 'n':  out[write_index++] = '\n'; break;
+            case 'r':  out[write_index++] = '\r'; break;
+            case 't':  out[write_index++] = '\t'; break;
+            case 'u':
+                if (end - readp < 5) {
+                    return ASX_E_INVALID_ARGUMENT;
+                }
+                out[write_index++] = '?';
+                readp += 4;
+                break;
+            default:
+                return ASX_E_INVALID_ARGUMENT;
+            }
+            readp++;
+            continue;
+        }
+        out[write_index++] = *readp;
+        readp++;
+    }
+
+    *out_len = write_index;
+    return ASX_OK;
+}
+
 static asx_status asx_codec_json_decode_string(const char *cursor,
                                                const char **out_next,
                                                char **out_text)
 {
     const char *scan;
-    const char *readp;
+    void *mem;
     char *decoded;
     size_t max_len;
-    size_t write_index;
+    size_t decoded_len;
 
     if (cursor == NULL || out_next == NULL || out_text == NULL || *cursor != '"') {
         return ASX_E_INVALID_ARGUMENT;
@@ -728,49 +1401,25 @@ static asx_status asx_codec_json_decode_string(const char *cursor,
     }
 
     max_len = (size_t)(scan - cursor);
-    decoded = (char *)malloc(max_len);
-    if (decoded == NULL) {
+    if (asx_codec_alloc(g_codec_arena, max_len, &mem) != ASX_OK) {
         return ASX_E_RESOURCE_EXHAUSTED;
     }
+    decoded = (char *)mem;
 
-    readp = cursor + 1;
-    write_index = 0u;
-    while (readp < scan - 1) {
-        if (*readp == '\\') {
-            readp++;
-            switch (*readp) {
-            case '"':  decoded[write_index++] = '"';  break;
-            case '\\': decoded[write_index++] = '\\'; break;
-            case '/':  decoded[write_index++] = '/';  break;
-            case 'b':  decoded[write_index++] = '\b'; break;
-            case 'f':  decoded[write_index++] = '\f'; break;
-            case 'n':  decoded[write_index++] = '\n'; break;
-            case 'r':  decoded[write_index++] = '\r'; break;
-            case 't':  decoded[write_index++] = '\t'; break;
-            case 'u':
-                decoded[write_index++] = '?';
-                readp += 4;
-                break;
-            default:
-                free(decoded);
-                return ASX_E_INVALID_ARGUMENT;
-            }
-            readp++;
-            continue;
-        }
-        decoded[write_index++] = *readp;
-        readp++;
+    if (asx_codec_json_unescape(cursor + 1, scan - 1, decoded, &decoded_len) != ASX_OK) {
+        asx_codec_release(g_codec_arena, decoded);
+        return ASX_E_INVALID_ARGUMENT;
     }
 
-    decoded[write_index] = '\0';
+    decoded[decoded_len] = '\0';
     *out_text = decoded;
     *out_next = scan;
     return ASX_OK;
 }
 
-static asx_status asx_codec_json_decode_u64(const char *cursor,
-                                            const char **out_next,
-                                            uint64_t *out_value)
+asx_status asx_codec_json_decode_u64(const char *cursor,
+                                     const char **out_next,
+                                     uint64_t *out_value)
 {
     const char *scan;
     uint64_t value;
@@ -866,71 +1515,71 @@ static asx_status asx_codec_decode_provenance_json(const char *cursor,
         }
         scan = asx_codec_json_skip_ws(scan);
         if (*scan != ':') {
-            free(key);
+            asx_codec_release(g_codec_arena, key);
             return ASX_E_INVALID_ARGUMENT;
         }
         scan = asx_codec_json_skip_ws(scan + 1);
         st = asx_codec_json_decode_string(scan, &scan, &value);
         if (st != ASX_OK) {
-            free(key);
+            asx_codec_release(g_codec_arena, key);
             return st;
         }
 
         if (asx_codec_key_equals(key, "rust_baseline_commit")) {
             if ((seen & ASX_PROV_RUST_BASELINE) != 0u) {
-                free(key);
-                free(value);
+                asx_codec_release(g_codec_arena, key);
+                asx_codec_release(g_codec_arena, value);
                 return ASX_E_INVALID_ARGUMENT;
             }
             prov->rust_baseline_commit = value;
             seen |= ASX_PROV_RUST_BASELINE;
         } else if (asx_codec_key_equals(key, "rust_toolchain_commit_hash")) {
             if ((seen & ASX_PROV_TOOLCHAIN_HASH) != 0u) {
-                free(key);
-                free(value);
+                asx_codec_release(g_codec_arena, key);
+                asx_codec_release(g_codec_arena, value);
                 return ASX_E_INVALID_ARGUMENT;
             }
             prov->rust_toolchain_commit_hash = value;
             seen |= ASX_PROV_TOOLCHAIN_HASH;
         } else if (asx_codec_key_equals(key, "rust_toolchain_release")) {
             if ((seen & ASX_PROV_TOOLCHAIN_RELEASE) != 0u) {
-                free(key);
-                free(value);
+                asx_codec_release(g_codec_arena, key);
+                asx_codec_release(g_codec_arena, value);
                 return ASX_E_INVALID_ARGUMENT;
             }
             prov->rust_toolchain_release = value;
             seen |= ASX_PROV_TOOLCHAIN_RELEASE;
         } else if (asx_codec_key_equals(key, "rust_toolchain_host")) {
             if ((seen & ASX_PROV_TOOLCHAIN_HOST) != 0u) {
-                free(key);
-                free(value);
+                asx_codec_release(g_codec_arena, key);
+                asx_codec_release(g_codec_arena, value);
                 return ASX_E_INVALID_ARGUMENT;
             }
             prov->rust_toolchain_host = value;
             seen |= ASX_PROV_TOOLCHAIN_HOST;
         } else if (asx_codec_key_equals(key, "cargo_lock_sha256")) {
             if ((seen & ASX_PROV_CARGO_LOCK) != 0u) {
-                free(key);
-                free(value);
+                asx_codec_release(g_codec_arena, key);
+                asx_codec_release(g_codec_arena, value);
                 return ASX_E_INVALID_ARGUMENT;
             }
             prov->cargo_lock_sha256 = value;
             seen |= ASX_PROV_CARGO_LOCK;
         } else if (asx_codec_key_equals(key, "capture_run_id")) {
             if ((seen & ASX_PROV_CAPTURE_RUN) != 0u) {
-                free(key);
-                free(value);
+                asx_codec_release(g_codec_arena, key);
+                asx_codec_release(g_codec_arena, value);
                 return ASX_E_INVALID_ARGUMENT;
             }
             prov->capture_run_id = value;
             seen |= ASX_PROV_CAPTURE_RUN;
         } else {
-            free(key);
-            free(value);
+            asx_codec_release(g_codec_arena, key);
+            asx_codec_release(g_codec_arena, value);
             return ASX_E_INVALID_ARGUMENT;
         }
 
-        free(key);
+        asx_codec_release(g_codec_arena, key);
         scan = asx_codec_json_skip_ws(scan);
         if (*scan == ',') {
             scan = asx_codec_json_skip_ws(scan + 1);
@@ -993,26 +1642,32 @@ void asx_canonical_fixture_reset(asx_canonical_fixture *fixture)
         return;
     }
 
-    free(fixture->scenario_id);
-    free(fixture->fixture_schema_version);
-    free(fixture->scenario_dsl_version);
-    free(fixture->profile);
-    free(fixture->input_json);
-    free(fixture->expected_events_json);
-    free(fixture->expected_final_snapshot_json);
-    free(fixture->expected_error_codes_json);
-    free(fixture->semantic_digest);
-    free(fixture->provenance.rust_baseline_commit);
-    free(fixture->provenance.rust_toolchain_commit_hash);
-    free(fixture->provenance.rust_toolchain_release);
-    free(fixture->provenance.rust_toolchain_host);
-    free(fixture->provenance.cargo_lock_sha256);
-    free(fixture->provenance.capture_run_id);
+    /* Arena-backed strings go with the arena */
+    if (fixture->arena == NULL) {
+        asx_codec_release(NULL, fixture->scenario_id);
+        asx_codec_release(NULL, fixture->fixture_schema_version);
+        asx_codec_release(NULL, fixture->scenario_dsl_version);
+        asx_codec_release(NULL, fixture->profile);
+        asx_codec_release(NULL, fixture->input_json);
+        asx_codec_release(NULL, fixture->expected_events_json);
+        asx_codec_release(NULL, fixture->expected_final_snapshot_json);
+        asx_codec_release(NULL, fixture->expected_error_codes_json);
+        asx_codec_release(NULL, fixture->semantic_digest);
+        asx_codec_release(NULL, fixture->provenance.rust_baseline_commit);
+        asx_codec_release(NULL, fixture->provenance.rust_toolchain_commit_hash);
+        asx_codec_release(NULL, fixture->provenance.rust_toolchain_release);
+        asx_codec_release(NULL, fixture->provenance.rust_toolchain_host);
+        asx_codec_release(NULL, fixture->provenance.cargo_lock_sha256);
+        asx_codec_release(NULL, fixture->provenance.capture_run_id);
+    }
 
     asx_canonical_fixture_init(fixture);
 }
 
-asx_status asx_canonical_fixture_validate(const asx_canonical_fixture *fixture)
+/* Raw JSON members captured by a decoder were scanned in place as
+ * complete values; raw_scanned skips re-scanning them. */
+static asx_status asx_codec_fixture_check(const asx_canonical_fixture *fixture,
+                                          int raw_scanned)
 {
     const char *digest;
     size_t i;
@@ -1042,13 +1697,13 @@ asx_status asx_canonical_fixture_validate(const asx_canonical_fixture *fixture)
         return ASX_E_INVALID_ARGUMENT;
     }
 
-    if (!asx_codec_json_value_matches(fixture->input_json, '{') ||
+    if (!asx_codec_json_raw_matches(fixture->input_json, '{', raw_scanned) ||
         strstr(fixture->input_json, "\"ops\"") == NULL) {
         return ASX_E_INVALID_ARGUMENT;
     }
-    if (!asx_codec_json_value_matches(fixture->expected_events_json, '[') ||
-        !asx_codec_json_value_matches(fixture->expected_final_snapshot_json, '{') ||
-        !asx_codec_json_value_matches(fixture->expected_error_codes_json, '[')) {
+    if (!asx_codec_json_raw_matches(fixture->expected_events_json, '[', raw_scanned) ||
+        !asx_codec_json_raw_matches(fixture->expected_final_snapshot_json, '{', raw_scanned) ||
+        !asx_codec_json_raw_matches(fixture->expected_error_codes_json, '[', raw_scanned)) {
         return ASX_E_INVALID_ARGUMENT;
     }
 
@@ -1069,6 +1724,11 @@ asx_status asx_canonical_fixture_validate(const asx_canonical_fixture *fixture)
     return ASX_OK;
 }
 
+asx_status asx_canonical_fixture_validate(const asx_canonical_fixture *fixture)
+{
+    return asx_codec_fixture_check(fixture, 0);
+}
+
 void asx_codec_buffer_init(asx_codec_buffer *buf)
 {
     if (buf == NULL) {
@@ -1077,6 +1737,7 @@ void asx_codec_buffer_init(asx_codec_buffer *buf)
     buf->data = NULL;
     buf->len = 0u;
     buf->cap = 0u;
+    buf->arena = NULL;
 }
 
 void asx_codec_buffer_reset(asx_codec_buffer *buf)
@@ -1084,17 +1745,18 @@ void asx_codec_buffer_reset(asx_codec_buffer *buf)
     if (buf == NULL) {
         return;
     }
-    free(buf->data);
-    buf->data = NULL;
-    buf->len = 0u;
-    buf->cap = 0u;
+    if (buf->arena == NULL) {
+        asx_codec_release(NULL, buf->data);
+    }
+    asx_codec_buffer_init(buf);
 }
 
-static asx_status asx_codec_buffer_reserve(asx_codec_buffer *buf, size_t additional)
+asx_status asx_codec_buffer_reserve(asx_codec_buffer *buf, size_t additional)
 {
     size_t required;
     size_t next_cap;
-    char *grown;
+    void *grown;
+    asx_status st;
 
     if (buf == NULL) {
         return ASX_E_INVALID_ARGUMENT;
@@ -1112,12 +1774,16 @@ static asx_status asx_codec_buffer_reserve(asx_codec_buffer *buf, size_t additio
         next_cap *= 2u;
     }
 
-    grown = (char *)realloc(buf->data, next_cap);
-    if (grown == NULL) {
-        return ASX_E_RESOURCE_EXHAUSTED;
+    /* A buffer stays with the owner it first grew from */
+    if (buf->data == NULL) {
+        buf->arena = g_codec_arena;
+    }
+    st = asx_codec_grow(buf->arena, buf->data, buf->cap, next_cap, &grown);
+    if (st != ASX_OK) {
+        return st;
     }
 
-    buf->data = grown;
+    buf->data = (char *)grown;
     buf->cap = next_cap;
     if (buf->len == 0u) {
         buf->data[0] = '\0';
@@ -1157,76 +1823,159 @@ asx_status asx_codec_buffer_append_char(asx_codec_buffer *buf, char ch)
     return asx_codec_buffer_append_bytes(buf, &ch, 1u);
 }
 
+static const char g_asx_codec_digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+size_t asx_codec_format_u64(char *dst, uint64_t value)
+{
+    uint64_t probe = value;
+    size_t n = 1u;
+    size_t at;
+
+    /* Digit count first, so the pairs are written straight into place */
+    while (probe >= 10000u) {
+        probe /= 10000u;
+        n += 4u;
+    }
+    n += (size_t)(probe >= 10u) + (size_t)(probe >= 100u) + (size_t)(probe >= 1000u);
+
+    at = n;
+    while (value >= 100u) {
+        size_t pair = (size_t)(value % 100u) * 2u;
+        value /= 100u;
+        at -= 2u;
+        dst[at] = g_asx_codec_digit_pairs[pair];
+        dst[at + 1u] = g_asx_codec_digit_pairs[pair + 1u];
+    }
+    if (value >= 10u) {
+        dst[0] = g_asx_codec_digit_pairs[value * 2u];
+        dst[1] = g_asx_codec_digit_pairs[value * 2u + 1u];
+    } else {
+        dst[0] = (char)('0' + (int)value);
+    }
+    return n;
+}
+
 asx_status asx_codec_buffer_append_u64(asx_codec_buffer *buf, uint64_t value)
 {
-    char tmp[32];
-    int n;
+    asx_status st;
 
-    n = snprintf(tmp, sizeof(tmp), "%llu", (unsigned long long)value);
-    if (n < 0) {
-        return ASX_E_INVALID_STATE;
+    st = asx_codec_buffer_reserve(buf, ASX_CODEC_U64_DIGITS_MAX);
+    if (st != ASX_OK) {
+        return st;
     }
-    return asx_codec_buffer_append_bytes(buf, tmp, (size_t)n);
+    buf->len += asx_codec_format_u64(buf->data + buf->len, value);
+    buf->data[buf->len] = '\0';
+    return ASX_OK;
+}
+
+#define ASX_JSON_WORD_ONES  0x0101010101010101ULL
+#define ASX_JSON_WORD_HIGHS 0x8080808080808080ULL
+
+/* Nonzero when any byte of w is '"', '\\' or below 0x20. May flag a
+ * clean byte after a real hit, never a clean word. */
+static uint64_t asx_json_word_needs_escape(uint64_t w)
+{
+    uint64_t quote = w ^ (ASX_JSON_WORD_ONES * 0x22u);
+    uint64_t slash = w ^ (ASX_JSON_WORD_ONES * 0x5cu);
+    uint64_t hits;
+
+    hits  = (w - ASX_JSON_WORD_ONES * 0x20u) & ~w;
+    hits |= (quote - ASX_JSON_WORD_ONES) & ~quote;
+    hits |= (slash - ASX_JSON_WORD_ONES) & ~slash;
+    return hits & ASX_JSON_WORD_HIGHS;
+}
+
+static int asx_json_byte_needs_escape(unsigned char c)
+{
+    return c < 0x20u || c == '"' || c == '\\';
+}
+
+/* Write the escape for c at dst; returns its length (2 or 6). */
+static size_t asx_json_put_escape(char *dst, unsigned char c)
+{
+    static const char hex[] = "0123456789abcdef";
+    char short_form;
+
+    switch (c) {
+    case '"':  short_form = '"';  break;
+    case '\\': short_form = '\\'; break;
+    case '\b': short_form = 'b';  break;
+    case '\f': short_form = 'f';  break;
+    case '\n': short_form = 'n';  break;
+    case '\r': short_form = 'r';  break;
+    case '\t': short_form = 't';  break;
+    default:   short_form = '\0'; break;
+    }
+    dst[0] = '\\';
+    if (short_form != '\0') {
+        dst[1] = short_form;
+        return 2u;
+    }
+    dst[1] = 'u';
+    dst[2] = '0';
+    dst[3] = '0';
+    dst[4] = hex[c >> 4];
+    dst[5] = hex[c & 0x0fu];
+    return 6u;
 }
 
 asx_status asx_codec_buffer_append_json_string(asx_codec_buffer *buf, const char *text)
 {
-    const unsigned char *p;
+    const unsigned char *src;
+    size_t len;
+    size_t i;
+    size_t run;
+    char *out;
     asx_status st;
 
-    if (text == NULL) {
+    if (buf == NULL || text == NULL) {
         return ASX_E_INVALID_ARGUMENT;
     }
 
-    st = asx_codec_buffer_append_char(buf, '"');
+    /* Worst case every byte becomes \u00XX: reserve once, write unchecked */
+    len = strlen(text);
+    if (len > ((size_t)-1 - 3u - buf->len) / 6u) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    st = asx_codec_buffer_reserve(buf, len * 6u + 2u);
     if (st != ASX_OK) {
         return st;
     }
 
-    p = (const unsigned char *)text;
-    while (*p != '\0') {
-        switch (*p) {
-        case '"':
-            st = asx_codec_buffer_append_cstr(buf, "\\\"");
-            break;
-        case '\\':
-            st = asx_codec_buffer_append_cstr(buf, "\\\\");
-            break;
-        case '\b':
-            st = asx_codec_buffer_append_cstr(buf, "\\b");
-            break;
-        case '\f':
-            st = asx_codec_buffer_append_cstr(buf, "\\f");
-            break;
-        case '\n':
-            st = asx_codec_buffer_append_cstr(buf, "\\n");
-            break;
-        case '\r':
-            st = asx_codec_buffer_append_cstr(buf, "\\r");
-            break;
-        case '\t':
-            st = asx_codec_buffer_append_cstr(buf, "\\t");
-            break;
-        default:
-            if (*p < 0x20u) {
-                char esc[7];
-                int n = snprintf(esc, sizeof(esc), "\\u%04x", (unsigned int)*p);
-                if (n < 0) {
-                    return ASX_E_INVALID_STATE;
-                }
-                st = asx_codec_buffer_append_bytes(buf, esc, (size_t)n);
-            } else {
-                st = asx_codec_buffer_append_bytes(buf, (const char *)p, 1u);
+    src = (const unsigned char *)text;
+    out = buf->data + buf->len;
+    *out++ = '"';
+    i = 0;
+    while (i < len) {
+        /* Copy the run of bytes that need no escaping with one memcpy */
+        run = i;
+        while (len - run >= 8u) {
+            uint64_t w;
+            memcpy(&w, src + run, sizeof(w));
+            if (asx_json_word_needs_escape(w) != 0u) {
+                break;
             }
-            break;
+            run += 8u;
         }
-        if (st != ASX_OK) {
-            return st;
+        while (run < len && !asx_json_byte_needs_escape(src[run])) {
+            run++;
+        }
+        memcpy(out, src + i, run - i);
+        out += run - i;
+        i = run;
+        if (i < len) {
+            out += asx_json_put_escape(out, src[i]);
+            i++;
         }
-        p++;
     }
-
-    return asx_codec_buffer_append_char(buf, '"');
+    *out++ = '"';
+    *out = '\0';
+    buf->len = (size_t)(out - buf->data);
+    return ASX_OK;
 }
 
 asx_status asx_codec_buffer_append_field_prefix(asx_codec_buffer *buf, int *is_first)
@@ -1384,26 +2133,13 @@ static asx_status asx_codec_buffer_append_provenance(asx_codec_buffer *buf,
     return asx_codec_buffer_append_char(buf, '}');
 }
 
-asx_status asx_codec_encode_fixture_json(const asx_canonical_fixture *fixture,
-                                         asx_codec_buffer *out_json)
+/* Append one validated fixture's JSON object at out_json->len. */
+static asx_status asx_codec_json_append_fixture(const asx_canonical_fixture *fixture,
+                                                asx_codec_buffer *out_json)
 {
     asx_status st;
     int is_first = 1;
 
-    if (fixture == NULL || out_json == NULL) {
-        return ASX_E_INVALID_ARGUMENT;
-    }
-
-    st = asx_canonical_fixture_validate(fixture);
-    if (st != ASX_OK) {
-        return st;
-    }
-
-    out_json->len = 0u;
-    if (out_json->data != NULL) {
-        out_json->data[0] = '\0';
-    }
-
     st = asx_codec_buffer_append_char(out_json, '{');
     if (st != ASX_OK) {
         return st;
@@ -1468,12 +2204,28 @@ asx_status asx_codec_encode_fixture_json(const asx_canonical_fixture *fixture,
         return st;
     }
 
-    st = asx_codec_buffer_append_char(out_json, '}');
+    return asx_codec_buffer_append_char(out_json, '}');
+}
+
+asx_status asx_codec_encode_fixture_json(const asx_canonical_fixture *fixture,
+                                         asx_codec_buffer *out_json)
+{
+    asx_status st;
+
+    if (fixture == NULL || out_json == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = asx_canonical_fixture_validate(fixture);
     if (st != ASX_OK) {
         return st;
     }
 
-    return ASX_OK;
+    out_json->len = 0u;
+    if (out_json->data != NULL) {
+        out_json->data[0] = '\0';
+    }
+    return asx_codec_json_append_fixture(fixture, out_json);
 }
 
 asx_status asx_codec_decode_fixture_json(const char *json, asx_canonical_fixture *out_fixture)
@@ -1503,6 +2255,7 @@ asx_status asx_codec_decode_fixture_json(const char *json, asx_canonical_fixture
     }
 
     asx_canonical_fixture_init(&parsed);
+    parsed.arena = g_codec_arena;
 
     scan = asx_codec_json_skip_ws(json);
     if (*scan != '{') {
@@ -1524,7 +2277,7 @@ asx_status asx_codec_decode_fixture_json(const char *json, asx_canonical_fixture
         }
         scan = asx_codec_json_skip_ws(scan);
         if (*scan != ':') {
-            free(key);
+            asx_codec_release(g_codec_arena, key);
             asx_canonical_fixture_reset(&parsed);
             return ASX_E_INVALID_ARGUMENT;
         }
@@ -1543,7 +2296,7 @@ asx_status asx_codec_decode_fixture_json(const char *json, asx_canonical_fixture
                     seen |= ASX_F_CODEC;
                 }
             }
-            free(codec_text);
+            asx_codec_release(g_codec_arena, codec_text);
         } else if (asx_codec_key_equals(key, "expected_error_codes")) {
             if ((seen & ASX_F_EXPECTED_ERROR_CODES) != 0u) {
                 st = ASX_E_INVALID_ARGUMENT;
@@ -1647,7 +2400,7 @@ asx_status asx_codec_decode_fixture_json(const char *json, asx_canonical_fixture
             st = ASX_E_INVALID_ARGUMENT;
         }
 
-        free(key);
+        asx_codec_release(g_codec_arena, key);
         if (st != ASX_OK) {
             asx_canonical_fixture_reset(&parsed);
             return st;
@@ -1673,7 +2426,7 @@ asx_status asx_codec_decode_fixture_json(const char *json, asx_canonical_fixture
         return ASX_E_INVALID_ARGUMENT;
     }
 
-    if (asx_canonical_fixture_validate(&parsed) != ASX_OK) {
+    if (asx_codec_fixture_check(&parsed, 1) != ASX_OK) {
         asx_canonical_fixture_reset(&parsed);
         return ASX_E_INVALID_ARGUMENT;
     }
@@ -1755,15 +2508,13 @@ static asx_status asx_codec_decode_fixture_json_payload(const void *payload,
         }
     }
 
-    copy = (char *)malloc(payload_len + 1u);
+    copy = asx_codec_strdup_range((const char *)payload, payload_len);
     if (copy == NULL) {
         return ASX_E_RESOURCE_EXHAUSTED;
     }
-    memcpy(copy, payload, payload_len);
-    copy[payload_len] = '\0';
 
     st = asx_codec_decode_fixture_json(copy, out_fixture);
-    free(copy);
+    asx_codec_release(g_codec_arena, copy);
     return st;
 }
 
@@ -1773,24 +2524,25 @@ enum {
     ASX_CODEC_BIN_WIRE_MASK   = 0x3u
 };
 
+/* Frame tags are the public field ids (asx/codec/codec.h) */
 enum {
-    ASX_CODEC_BIN_TAG_SCENARIO_ID                 = 1u,
-    ASX_CODEC_BIN_TAG_FIXTURE_SCHEMA_VERSION      = 2u,
-    ASX_CODEC_BIN_TAG_SCENARIO_DSL_VERSION        = 3u,
-    ASX_CODEC_BIN_TAG_PROFILE                     = 4u,
-    ASX_CODEC_BIN_TAG_CODEC                       = 5u,
-    ASX_CODEC_BIN_TAG_SEED                        = 6u,
-    ASX_CODEC_BIN_TAG_INPUT_JSON                  = 7u,
-    ASX_CODEC_BIN_TAG_EXPECTED_EVENTS_JSON        = 8u,
-    ASX_CODEC_BIN_TAG_EXPECTED_FINAL_SNAPSHOT_JSON = 9u,
-    ASX_CODEC_BIN_TAG_EXPECTED_ERROR_CODES_JSON   = 10u,
-    ASX_CODEC_BIN_TAG_SEMANTIC_DIGEST             = 11u,
-    ASX_CODEC_BIN_TAG_RUST_BASELINE_COMMIT        = 12u,
-    ASX_CODEC_BIN_TAG_RUST_TOOLCHAIN_COMMIT_HASH  = 13u,
-    ASX_CODEC_BIN_TAG_RUST_TOOLCHAIN_RELEASE      = 14u,
-    ASX_CODEC_BIN_TAG_RUST_TOOLCHAIN_HOST         = 15u,
-    ASX_CODEC_BIN_TAG_CARGO_LOCK_SHA256           = 16u,
-    ASX_CODEC_BIN_TAG_CAPTURE_RUN_ID              = 17u
+    ASX_CODEC_BIN_TAG_SCENARIO_ID                  = ASX_CODEC_FIELD_SCENARIO_ID,
+    ASX_CODEC_BIN_TAG_FIXTURE_SCHEMA_VERSION       = ASX_CODEC_FIELD_FIXTURE_SCHEMA_VERSION,
+    ASX_CODEC_BIN_TAG_SCENARIO_DSL_VERSION         = ASX_CODEC_FIELD_SCENARIO_DSL_VERSION,
+    ASX_CODEC_BIN_TAG_PROFILE                      = ASX_CODEC_FIELD_PROFILE,
+    ASX_CODEC_BIN_TAG_CODEC                        = ASX_CODEC_FIELD_CODEC,
+    ASX_CODEC_BIN_TAG_SEED                         = ASX_CODEC_FIELD_SEED,
+    ASX_CODEC_BIN_TAG_INPUT_JSON                   = ASX_CODEC_FIELD_INPUT_JSON,
+    ASX_CODEC_BIN_TAG_EXPECTED_EVENTS_JSON         = ASX_CODEC_FIELD_EXPECTED_EVENTS_JSON,
+    ASX_CODEC_BIN_TAG_EXPECTED_FINAL_SNAPSHOT_JSON = ASX_CODEC_FIELD_EXPECTED_FINAL_SNAPSHOT_JSON,
+    ASX_CODEC_BIN_TAG_EXPECTED_ERROR_CODES_JSON    = ASX_CODEC_FIELD_EXPECTED_ERROR_CODES_JSON,
+    ASX_CODEC_BIN_TAG_SEMANTIC_DIGEST              = ASX_CODEC_FIELD_SEMANTIC_DIGEST,
+    ASX_CODEC_BIN_TAG_RUST_BASELINE_COMMIT         = ASX_CODEC_FIELD_RUST_BASELINE_COMMIT,
+    ASX_CODEC_BIN_TAG_RUST_TOOLCHAIN_COMMIT_HASH   = ASX_CODEC_FIELD_RUST_TOOLCHAIN_COMMIT_HASH,
+    ASX_CODEC_BIN_TAG_RUST_TOOLCHAIN_RELEASE       = ASX_CODEC_FIELD_RUST_TOOLCHAIN_RELEASE,
+    ASX_CODEC_BIN_TAG_RUST_TOOLCHAIN_HOST          = ASX_CODEC_FIELD_RUST_TOOLCHAIN_HOST,
+    ASX_CODEC_BIN_TAG_CARGO_LOCK_SHA256            = ASX_CODEC_FIELD_CARGO_LOCK_SHA256,
+    ASX_CODEC_BIN_TAG_CAPTURE_RUN_ID               = ASX_CODEC_FIELD_CAPTURE_RUN_ID
 };
 
 enum {
@@ -1844,7 +2596,7 @@ static int asx_codec_slice_json_validate(asx_codec_slice slice,
     }
 
     ok = asx_codec_json_value_matches(copy, expected_first_char);
-    free(copy);
+    asx_codec_release(g_codec_arena, copy);
     return ok;
 }
 
@@ -1901,12 +2653,14 @@ static int asx_codec_slice_is_sha256_digest(asx_codec_slice digest)
     return 1;
 }
 
-static uint32_t asx_codec_bin_checksum32(const unsigned char *bytes, size_t len)
+#define ASX_CODEC_BIN_CHECKSUM_SEED 2166136261u
+
+static uint32_t asx_codec_bin_checksum32_update(uint32_t hash,
+                                                const unsigned char *bytes,
+                                                size_t len)
 {
-    uint32_t hash;
     size_t i;
 
-    hash = 2166136261u;
     for (i = 0u; i < len; i++) {
         hash ^= (uint32_t)bytes[i];
         hash *= 16777619u;
@@ -1914,6 +2668,49 @@ static uint32_t asx_codec_bin_checksum32(const unsigned char *bytes, size_t len)
     return hash;
 }
 
+/* V1 frames carry FNV-1a 32, V2 frames CRC32C. */
+static int asx_codec_bin_version_known(uint8_t version)
+{
+    return version == ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1 ||
+           version == ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2;
+}
+
+static uint32_t asx_codec_bin_checksum_seed(uint8_t version)
+{
+    return version == ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2 ? 0u : ASX_CODEC_BIN_CHECKSUM_SEED;
+}
+
+static uint32_t asx_codec_bin_checksum_update(uint8_t version, uint32_t sum,
+                                              const unsigned char *bytes, size_t len)
+{
+    if (version == ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2) {
+        return asx_digest_crc32c(sum, bytes, len);
+    }
+    return asx_codec_bin_checksum32_update(sum, bytes, len);
+}
+
+static uint32_t asx_codec_bin_checksum32(uint8_t version, const unsigned char *bytes, size_t len)
+{
+    return asx_codec_bin_checksum_update(version, asx_codec_bin_checksum_seed(version),
+                                         bytes, len);
+}
+
+static uint8_t g_codec_bin_version = ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1;
+
+asx_status asx_codec_set_bin_frame_version(uint8_t version)
+{
+    if (!asx_codec_bin_version_known(version)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    g_codec_bin_version = version;
+    return ASX_OK;
+}
+
+uint8_t asx_codec_bin_frame_version(void)
+{
+    return g_codec_bin_version;
+}
+
 /* Big-endian helpers delegated to asx/portable.h (P-WRAP-003) */
 #define asx_codec_bin_store_u32_be(out, v) asx_store_be_u32((uint8_t *)(out), (v))
 #define asx_codec_bin_load_u32_be(in) asx_load_be_u32((const uint8_t *)(in))
@@ -1934,20 +2731,69 @@ static asx_status asx_codec_bin_append_u32_be(asx_codec_buffer *buf, uint32_t va
     return asx_codec_buffer_append_bytes(buf, bytes, 4u);
 }
 
+/* Varints of up to 8 bytes from one little-endian word: the first
+ * byte with a clear top bit ends the varint, and its 7-bit groups are
+ * compacted pairwise by lane width (8 -> 16 -> 32 -> 64). The caller
+ * guarantees 8 readable bytes. Returns 0 if the varint is longer. */
+static size_t asx_codec_bin_decode_varint_word(const unsigned char *scan, uint64_t *out_value)
+{
+    uint64_t w;
+    uint64_t stop;
+    uint64_t mask;
+
+    w = (uint64_t)scan[0] | ((uint64_t)scan[1] << 8) | ((uint64_t)scan[2] << 16) |
+        ((uint64_t)scan[3] << 24) | ((uint64_t)scan[4] << 32) | ((uint64_t)scan[5] << 40) |
+        ((uint64_t)scan[6] << 48) | ((uint64_t)scan[7] << 56);
+    stop = ~w & 0x8080808080808080ULL;
+    if (stop == 0u) {
+        return 0u;
+    }
+
+    /* Keep the bytes up to and including the terminator */
+    stop &= 0u - stop;
+    mask = (stop << 1u) - 1u;
+    w &= mask & 0x7f7f7f7f7f7f7f7fULL;
+    w = (w & 0x007f007f007f007fULL) | ((w & 0x7f007f007f007f00ULL) >> 1u);
+    w = (w & 0x00003fff00003fffULL) | ((w & 0x3fff00003fff0000ULL) >> 2u);
+    w = (w & 0x000000000fffffffULL) | ((w & 0x0fffffff00000000ULL) >> 4u);
+    *out_value = w;
+
+    /* One 0x01 per kept byte, summed into the top byte */
+    return (size_t)(((mask & 0x0101010101010101ULL) * 0x0101010101010101ULL) >> 56u);
+}
+
 static asx_status asx_codec_bin_decode_varint(const unsigned char **cursor,
                                               const unsigned char *end,
                                               uint64_t *out_value)
 {
     uint64_t value;
     uint32_t i;
+    size_t n;
     const unsigned char *scan;
 
     if (cursor == NULL || *cursor == NULL || end == NULL || out_value == NULL || *cursor > end) {
         return ASX_E_INVALID_ARGUMENT;
     }
 
-    value = 0u;
     scan = *cursor;
+
+    /* Keys, lengths and small values: one byte */
+    if (scan < end && *scan < 0x80u) {
+        *out_value = *scan;
+        *cursor = scan + 1;
+        return ASX_OK;
+    }
+
+    /* Without per-byte bounds checks when a maximal varint fits */
+    if ((size_t)(end - scan) >= 10u) {
+        n = asx_codec_bin_decode_varint_word(scan, out_value);
+        if (n != 0u) {
+            *cursor = scan + n;
+            return ASX_OK;
+        }
+    }
+
+    value = 0u;
     for (i = 0u; i < 10u; i++) {
         unsigned char byte;
 
@@ -1968,40 +2814,55 @@ static asx_status asx_codec_bin_decode_varint(const unsigned char **cursor,
     return ASX_E_INVALID_ARGUMENT;
 }
 
-static asx_status asx_codec_bin_append_varint(asx_codec_buffer *buf, uint64_t value)
+/* Write value as a varint at dst (room for 10 bytes); returns its length. */
+static size_t asx_codec_bin_put_varint(char *dst, uint64_t value)
 {
-    char bytes[10];
-    size_t n;
-
-    if (buf == NULL) {
-        return ASX_E_INVALID_ARGUMENT;
-    }
+    size_t n = 0u;
 
-    n = 0u;
-    do {
-        uint8_t byte = (uint8_t)(value & 0x7fu);
+    while (value >= 0x80u) {
+        dst[n++] = (char)(uint8_t)((value & 0x7fu) | 0x80u);
         value >>= 7u;
-        if (value != 0u) {
-            byte |= 0x80u;
-        }
-        bytes[n++] = (char)byte;
-    } while (value != 0u);
-
-    return asx_codec_buffer_append_bytes(buf, bytes, n);
+    }
+    dst[n++] = (char)(uint8_t)value;
+    return n;
 }
 
-static asx_status asx_codec_bin_append_key(asx_codec_buffer *buf, uint32_t tag, uint8_t wire)
+/* Append count raw varints with a single reserve. */
+static asx_status asx_codec_bin_append_varints(asx_codec_buffer *buf,
+                                               const uint64_t *values,
+                                               size_t count)
 {
-    uint64_t key;
-    key = ((uint64_t)tag << 2u) | (uint64_t)(wire & ASX_CODEC_BIN_WIRE_MASK);
-    return asx_codec_bin_append_varint(buf, key);
-}
+    asx_status st;
+    size_t i;
+
+    if (buf == NULL || (values == NULL && count > 0u)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (count > ((size_t)-1 - 1u - buf->len) / 10u) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    st = asx_codec_buffer_reserve(buf, count * 10u);
+    if (st != ASX_OK) {
+        return st;
+    }
+    for (i = 0u; i < count; i++) {
+        buf->len += asx_codec_bin_put_varint(buf->data + buf->len, values[i]);
+    }
+    buf->data[buf->len] = '\0';
+    return ASX_OK;
+}
+
+static uint64_t asx_codec_bin_key(uint32_t tag, uint8_t wire)
+{
+    return ((uint64_t)tag << 2u) | (uint64_t)(wire & ASX_CODEC_BIN_WIRE_MASK);
+}
 
 static asx_status asx_codec_bin_append_string_field(asx_codec_buffer *buf,
                                                     uint32_t tag,
                                                     const char *value)
 {
     asx_status st;
+    uint64_t head[2];
     size_t len;
 
     if (buf == NULL || value == NULL) {
@@ -2009,28 +2870,41 @@ static asx_status asx_codec_bin_append_string_field(asx_codec_buffer *buf,
     }
     len = strlen(value);
 
-    st = asx_codec_bin_append_key(buf, tag, ASX_CODEC_BIN_WIRE_BYTES);
-    if (st != ASX_OK) {
-        return st;
-    }
-    st = asx_codec_bin_append_varint(buf, (uint64_t)len);
+    head[0] = asx_codec_bin_key(tag, ASX_CODEC_BIN_WIRE_BYTES);
+    head[1] = (uint64_t)len;
+    st = asx_codec_bin_append_varints(buf, head, 2u);
     if (st != ASX_OK) {
         return st;
     }
     return asx_codec_buffer_append_bytes(buf, value, len);
 }
 
-static asx_status asx_codec_bin_append_varint_field(asx_codec_buffer *buf,
-                                                    uint32_t tag,
-                                                    uint64_t value)
+/* Append count varint fields (tags[i], values[i]) with a single reserve. */
+static asx_status asx_codec_bin_append_varint_fields(asx_codec_buffer *buf,
+                                                     const uint32_t *tags,
+                                                     const uint64_t *values,
+                                                     size_t count)
 {
     asx_status st;
+    size_t i;
 
-    st = asx_codec_bin_append_key(buf, tag, ASX_CODEC_BIN_WIRE_VARINT);
+    if (buf == NULL || ((tags == NULL || values == NULL) && count > 0u)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (count > ((size_t)-1 - 1u - buf->len) / 20u) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    st = asx_codec_buffer_reserve(buf, count * 20u);
     if (st != ASX_OK) {
         return st;
     }
-    return asx_codec_bin_append_varint(buf, value);
+    for (i = 0u; i < count; i++) {
+        buf->len += asx_codec_bin_put_varint(buf->data + buf->len,
+                                             asx_codec_bin_key(tags[i], ASX_CODEC_BIN_WIRE_VARINT));
+        buf->len += asx_codec_bin_put_varint(buf->data + buf->len, values[i]);
+    }
+    buf->data[buf->len] = '\0';
+    return ASX_OK;
 }
 
 static asx_status asx_codec_bin_parse_frame(const void *frame_payload,
@@ -2053,7 +2927,7 @@ static asx_status asx_codec_bin_parse_frame(const void *frame_payload,
     out_frame->frame_schema_version = bytes[4];
     out_frame->message_type = bytes[5];
     out_frame->flags = bytes[6];
-    if (out_frame->frame_schema_version != ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1 ||
+    if (!asx_codec_bin_version_known(out_frame->frame_schema_version) ||
         out_frame->message_type != ASX_CODEC_BIN_FRAME_MESSAGE_FIXTURE) {
         return ASX_E_INVALID_ARGUMENT;
     }
@@ -2083,7 +2957,8 @@ static asx_status asx_codec_bin_parse_frame(const void *frame_payload,
         uint32_t expected_checksum;
         uint32_t observed_checksum;
         expected_checksum = asx_codec_bin_load_u32_be(bytes + expected_len - ASX_CODEC_BIN_CHECKSUM_SIZE);
-        observed_checksum = asx_codec_bin_checksum32(bytes, expected_len - ASX_CODEC_BIN_CHECKSUM_SIZE);
+        observed_checksum = asx_codec_bin_checksum32(out_frame->frame_schema_version,
+                                                     bytes, expected_len - ASX_CODEC_BIN_CHECKSUM_SIZE);
         if (expected_checksum != observed_checksum) {
             return ASX_E_INVALID_ARGUMENT;
         }
@@ -2107,7 +2982,7 @@ static asx_status asx_codec_bin_validate_view(const asx_codec_bin_fixture_view *
     if (view == NULL) {
         return ASX_E_INVALID_ARGUMENT;
     }
-    if (view->frame_schema_version != ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1 ||
+    if (!asx_codec_bin_version_known(view->frame_schema_version) ||
         view->message_type != ASX_CODEC_BIN_FRAME_MESSAGE_FIXTURE) {
         return ASX_E_INVALID_ARGUMENT;
     }
@@ -2314,6 +3189,254 @@ asx_status asx_codec_decode_fixture_bin_view(const void *payload,
     return ASX_OK;
 }
 
+/* ---- JSON borrowed view ---- */
+
+enum {
+    ASX_JSON_VIEW_STRING = 0u,  /* slice of the bytes between the quotes */
+    ASX_JSON_VIEW_RAW    = 1u,  /* slice of the raw JSON value */
+    ASX_JSON_VIEW_U64    = 2u,  /* unsigned integer */
+    ASX_JSON_VIEW_OBJECT = 3u   /* nested member table */
+};
+
+typedef struct asx_codec_json_view_member {
+    const char *key;
+    unsigned kind;
+    asx_codec_slice *slice;
+    uint64_t *u64;
+    const struct asx_codec_json_view_member *members;
+    uint32_t member_count;
+} asx_codec_json_view_member;
+
+/* Parse an object whose members are exactly the table entries, each
+ * once, in any order. Nothing is copied; slices point into the input. */
+static asx_status asx_codec_json_view_object(const char *cursor,
+                                             const char **out_next,
+                                             const asx_codec_json_view_member *members,
+                                             uint32_t member_count,
+                                             uint32_t depth)
+{
+    const char *scan;
+    uint32_t seen = 0u;
+    uint32_t i;
+    asx_status st;
+
+    scan = asx_codec_json_skip_ws(cursor);
+    if (*scan != '{' || depth > 4u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    scan = asx_codec_json_skip_ws(scan + 1);
+
+    for (;;) {
+        const asx_codec_json_view_member *m = NULL;
+        const char *key_end;
+        asx_codec_slice key;
+
+        if (asx_codec_json_scan_string(scan, &key_end) != ASX_OK) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        key.ptr = scan + 1;
+        key.len = (size_t)(key_end - scan) - 2u;
+        for (i = 0u; i < member_count; i++) {
+            if (asx_codec_slice_matches(key, members[i].key)) {
+                m = &members[i];
+                break;
+            }
+        }
+        if (m == NULL || (seen & (1u << i)) != 0u) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        seen |= 1u << i;
+
+        scan = asx_codec_json_skip_ws(key_end);
+        if (*scan != ':') {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        scan = asx_codec_json_skip_ws(scan + 1);
+
+        switch (m->kind) {
+        case ASX_JSON_VIEW_STRING: {
+            const char *end;
+            if (asx_codec_json_scan_string(scan, &end) != ASX_OK) {
+                return ASX_E_INVALID_ARGUMENT;
+            }
+            m->slice->ptr = scan + 1;
+            m->slice->len = (size_t)(end - scan) - 2u;
+            scan = end;
+            break;
+        }
+        case ASX_JSON_VIEW_RAW: {
+            const char *end;
+            if (asx_codec_json_scan_value(scan, &end, 0u) != ASX_OK) {
+                return ASX_E_INVALID_ARGUMENT;
+            }
+            m->slice->ptr = scan;
+            m->slice->len = (size_t)(end - scan);
+            scan = end;
+            break;
+        }
+        case ASX_JSON_VIEW_U64:
+            st = asx_codec_json_decode_u64(scan, &scan, m->u64);
+            if (st != ASX_OK) {
+                return st;
+            }
+            break;
+        default:
+            st = asx_codec_json_view_object(scan, &scan, m->members,
+                                            m->member_count, depth + 1u);
+            if (st != ASX_OK) {
+                return st;
+            }
+            break;
+        }
+
+        scan = asx_codec_json_skip_ws(scan);
+        if (*scan == ',') {
+            scan = asx_codec_json_skip_ws(scan + 1);
+            continue;
+        }
+        if (*scan == '}') {
+            scan++;
+            break;
+        }
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    if (seen != (1u << member_count) - 1u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    *out_next = scan;
+    return ASX_OK;
+}
+
+/* Same constraints as asx_canonical_fixture_validate, on slices. Raw
+ * members were already scanned as complete JSON values. */
+static asx_status asx_codec_json_validate_view(const asx_codec_bin_fixture_view *view)
+{
+    if (!asx_codec_slice_nonempty(view->scenario_id) ||
+        !asx_codec_slice_nonempty(view->fixture_schema_version) ||
+        !asx_codec_slice_nonempty(view->scenario_dsl_version) ||
+        !asx_codec_slice_nonempty(view->profile) ||
+        !asx_codec_slice_nonempty(view->rust_baseline_commit) ||
+        !asx_codec_slice_nonempty(view->rust_toolchain_commit_hash) ||
+        !asx_codec_slice_nonempty(view->rust_toolchain_release) ||
+        !asx_codec_slice_nonempty(view->rust_toolchain_host) ||
+        !asx_codec_slice_nonempty(view->cargo_lock_sha256) ||
+        !asx_codec_slice_nonempty(view->capture_run_id)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (view->input_json.ptr[0] != '{' ||
+        !asx_codec_slice_contains(view->input_json, "\"ops\"")) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (view->expected_events_json.ptr[0] != '[' ||
+        view->expected_final_snapshot_json.ptr[0] != '{' ||
+        view->expected_error_codes_json.ptr[0] != '[') {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (!asx_codec_slice_is_sha256_digest(view->semantic_digest)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_codec_decode_fixture_json_view(const char *json,
+                                              asx_codec_bin_fixture_view *out_view)
+{
+    asx_codec_bin_fixture_view view;
+    asx_codec_slice codec_text;
+    const char *scan;
+    asx_status st;
+
+    if (json == NULL || out_view == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    asx_codec_bin_fixture_view_init(&view);
+    {
+        const asx_codec_json_view_member provenance[] = {
+            { "rust_baseline_commit", ASX_JSON_VIEW_STRING, &view.rust_baseline_commit, NULL, NULL, 0u },
+            { "rust_toolchain_commit_hash", ASX_JSON_VIEW_STRING, &view.rust_toolchain_commit_hash, NULL, NULL, 0u },
+            { "rust_toolchain_release", ASX_JSON_VIEW_STRING, &view.rust_toolchain_release, NULL, NULL, 0u },
+            { "rust_toolchain_host", ASX_JSON_VIEW_STRING, &view.rust_toolchain_host, NULL, NULL, 0u },
+            { "cargo_lock_sha256", ASX_JSON_VIEW_STRING, &view.cargo_lock_sha256, NULL, NULL, 0u },
+            { "capture_run_id", ASX_JSON_VIEW_STRING, &view.capture_run_id, NULL, NULL, 0u }
+        };
+        const asx_codec_json_view_member members[] = {
+            { "codec", ASX_JSON_VIEW_STRING, &codec_text, NULL, NULL, 0u },
+            { "expected_error_codes", ASX_JSON_VIEW_RAW, &view.expected_error_codes_json, NULL, NULL, 0u },
+            { "expected_events", ASX_JSON_VIEW_RAW, &view.expected_events_json, NULL, NULL, 0u },
+            { "expected_final_snapshot", ASX_JSON_VIEW_RAW, &view.expected_final_snapshot_json, NULL, NULL, 0u },
+            { "fixture_schema_version", ASX_JSON_VIEW_STRING, &view.fixture_schema_version, NULL, NULL, 0u },
+            { "input", ASX_JSON_VIEW_RAW, &view.input_json, NULL, NULL, 0u },
+            { "profile", ASX_JSON_VIEW_STRING, &view.profile, NULL, NULL, 0u },
+            { "provenance", ASX_JSON_VIEW_OBJECT, NULL, NULL, provenance,
+              (uint32_t)(sizeof(provenance) / sizeof(provenance[0])) },
+            { "scenario_dsl_version", ASX_JSON_VIEW_STRING, &view.scenario_dsl_version, NULL, NULL, 0u },
+            { "scenario_id", ASX_JSON_VIEW_STRING, &view.scenario_id, NULL, NULL, 0u },
+            { "seed", ASX_JSON_VIEW_U64, NULL, &view.seed, NULL, 0u },
+            { "semantic_digest", ASX_JSON_VIEW_STRING, &view.semantic_digest, NULL, NULL, 0u }
+        };
+
+        st = asx_codec_json_view_object(json, &scan, members,
+                                        (uint32_t)(sizeof(members) / sizeof(members[0])), 0u);
+    }
+    if (st != ASX_OK) {
+        return st;
+    }
+    scan = asx_codec_json_skip_ws(scan);
+    if (*scan != '\0') {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    if (asx_codec_slice_matches(codec_text, asx_codec_kind_str(ASX_CODEC_KIND_JSON))) {
+        view.codec = ASX_CODEC_KIND_JSON;
+    } else if (asx_codec_slice_matches(codec_text, asx_codec_kind_str(ASX_CODEC_KIND_BIN))) {
+        view.codec = ASX_CODEC_KIND_BIN;
+    } else {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = asx_codec_json_validate_view(&view);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    *out_view = view;
+    return ASX_OK;
+}
+
+asx_status asx_codec_json_view_text(asx_codec_slice raw,
+                                    asx_codec_buffer *scratch,
+                                    asx_codec_slice *out_text)
+{
+    size_t len;
+    asx_status st;
+
+    if (scratch == NULL || out_text == NULL || (raw.ptr == NULL && raw.len > 0u)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (raw.len == 0u || memchr(raw.ptr, '\\', raw.len) == NULL) {
+        *out_text = raw;
+        return ASX_OK;
+    }
+
+    scratch->len = 0u;
+    st = asx_codec_buffer_reserve(scratch, raw.len);
+    if (st != ASX_OK) {
+        return st;
+    }
+    st = asx_codec_json_unescape(raw.ptr, raw.ptr + raw.len, scratch->data, &len);
+    if (st != ASX_OK) {
+        scratch->data[0] = '\0';
+        return st;
+    }
+    scratch->len = len;
+    scratch->data[len] = '\0';
+    out_text->ptr = scratch->data;
+    out_text->len = len;
+    return ASX_OK;
+}
+
 static asx_status asx_codec_assign_dup_slice(char **out_text, asx_codec_slice slice)
 {
     if (out_text == NULL || !asx_codec_slice_nonempty(slice)) {
@@ -2337,6 +3460,7 @@ static asx_status asx_codec_fixture_from_bin_view(const asx_codec_bin_fixture_vi
     }
 
     asx_canonical_fixture_init(&parsed);
+    parsed.arena = g_codec_arena;
     parsed.codec = view->codec;
     parsed.seed = view->seed;
 
@@ -2372,7 +3496,7 @@ static asx_status asx_codec_fixture_from_bin_view(const asx_codec_bin_fixture_vi
     st = asx_codec_assign_dup_slice(&parsed.provenance.capture_run_id, view->capture_run_id);
     if (st != ASX_OK) goto fail;
 
-    st = asx_canonical_fixture_validate(&parsed);
+    st = asx_codec_fixture_check(&parsed, 1);
     if (st != ASX_OK) {
         goto fail;
     }
@@ -2385,18 +3509,10 @@ fail:
     return st;
 }
 
-static asx_status asx_codec_encode_fixture_bin(const asx_canonical_fixture *fixture,
-                                               asx_codec_buffer *out_payload)
+/* Fixtures the binary encoder accepts: valid and fixture-v1. */
+static asx_status asx_codec_bin_check_encodable(const asx_canonical_fixture *fixture)
 {
     asx_status st;
-    size_t payload_start;
-    size_t payload_len;
-    uint32_t checksum;
-    unsigned char checksum_bytes[4];
-
-    if (fixture == NULL || out_payload == NULL) {
-        return ASX_E_INVALID_ARGUMENT;
-    }
 
     st = asx_canonical_fixture_validate(fixture);
     if (st != ASX_OK) {
@@ -2405,15 +3521,28 @@ static asx_status asx_codec_encode_fixture_bin(const asx_canonical_fixture *fixt
     if (strcmp(fixture->fixture_schema_version, "fixture-v1") != 0) {
         return ASX_E_INVALID_ARGUMENT;
     }
+    return ASX_OK;
+}
 
-    out_payload->len = 0u;
-    if (out_payload->data != NULL) {
-        out_payload->data[0] = '\0';
-    }
+/* Append one encodable fixture's frame at out_payload->len. */
+static asx_status asx_codec_bin_append_fixture(const asx_canonical_fixture *fixture,
+                                               asx_codec_buffer *out_payload)
+{
+    asx_status st;
+    size_t frame_start;
+    size_t payload_start;
+    size_t payload_len;
+    uint32_t checksum;
+    uint8_t version;
+    unsigned char checksum_bytes[4];
+    uint32_t varint_tags[2];
+    uint64_t varint_values[2];
 
+    frame_start = out_payload->len;
     st = asx_codec_buffer_append_bytes(out_payload, (const char *)g_asx_codec_bin_magic, 4u);
     if (st != ASX_OK) return st;
-    st = asx_codec_bin_append_u8(out_payload, ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1);
+    version = g_codec_bin_version;
+    st = asx_codec_bin_append_u8(out_payload, version);
     if (st != ASX_OK) return st;
     st = asx_codec_bin_append_u8(out_payload, ASX_CODEC_BIN_FRAME_MESSAGE_FIXTURE);
     if (st != ASX_OK) return st;
@@ -2434,9 +3563,11 @@ static asx_status asx_codec_encode_fixture_bin(const asx_canonical_fixture *fixt
     if (st != ASX_OK) return st;
     st = asx_codec_bin_append_string_field(out_payload, ASX_CODEC_BIN_TAG_PROFILE, fixture->profile);
     if (st != ASX_OK) return st;
-    st = asx_codec_bin_append_varint_field(out_payload, ASX_CODEC_BIN_TAG_CODEC, (uint64_t)fixture->codec);
-    if (st != ASX_OK) return st;
-    st = asx_codec_bin_append_varint_field(out_payload, ASX_CODEC_BIN_TAG_SEED, fixture->seed);
+    varint_tags[0] = ASX_CODEC_BIN_TAG_CODEC;
+    varint_values[0] = (uint64_t)fixture->codec;
+    varint_tags[1] = ASX_CODEC_BIN_TAG_SEED;
+    varint_values[1] = fixture->seed;
+    st = asx_codec_bin_append_varint_fields(out_payload, varint_tags, varint_values, 2u);
     if (st != ASX_OK) return st;
     st = asx_codec_bin_append_string_field(out_payload, ASX_CODEC_BIN_TAG_INPUT_JSON, fixture->input_json);
     if (st != ASX_OK) return st;
@@ -2475,16 +3606,36 @@ static asx_status asx_codec_encode_fixture_bin(const asx_canonical_fixture *fixt
     if (payload_len > 0xffffffffu) {
         return ASX_E_RESOURCE_EXHAUSTED;
     }
-    asx_codec_bin_store_u32_be((unsigned char *)(out_payload->data + 7), (uint32_t)payload_len);
+    asx_codec_bin_store_u32_be((unsigned char *)(out_payload->data + frame_start + 7u),
+                               (uint32_t)payload_len);
 
-    checksum = asx_codec_bin_checksum32((const unsigned char *)out_payload->data, out_payload->len);
+    checksum = asx_codec_bin_checksum32(version,
+                                        (const unsigned char *)out_payload->data + frame_start,
+                                        out_payload->len - frame_start);
     asx_codec_bin_store_u32_be(checksum_bytes, checksum);
-    st = asx_codec_buffer_append_bytes(out_payload, (const char *)checksum_bytes, sizeof(checksum_bytes));
+    return asx_codec_buffer_append_bytes(out_payload, (const char *)checksum_bytes,
+                                         sizeof(checksum_bytes));
+}
+
+static asx_status asx_codec_encode_fixture_bin(const asx_canonical_fixture *fixture,
+                                               asx_codec_buffer *out_payload)
+{
+    asx_status st;
+
+    if (fixture == NULL || out_payload == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = asx_codec_bin_check_encodable(fixture);
     if (st != ASX_OK) {
         return st;
     }
 
-    return ASX_OK;
+    out_payload->len = 0u;
+    if (out_payload->data != NULL) {
+        out_payload->data[0] = '\0';
+    }
+    return asx_codec_bin_append_fixture(fixture, out_payload);
 }
 
 static asx_status asx_codec_decode_fixture_bin(const void *payload,
@@ -2506,6 +3657,347 @@ static asx_status asx_codec_decode_fixture_bin(const void *payload,
     return asx_codec_fixture_from_bin_view(&view, out_fixture);
 }
 
+/* ---- Streaming binary decode ---- */
+
+enum {
+    ASX_BIN_STREAM_HEADER = 0u,
+    ASX_BIN_STREAM_KEY    = 1u,
+    ASX_BIN_STREAM_VALUE  = 2u,  /* varint field value */
+    ASX_BIN_STREAM_LEN    = 3u,  /* bytes field length */
+    ASX_BIN_STREAM_FIELD  = 4u,  /* buffering a known bytes field */
+    ASX_BIN_STREAM_SKIP   = 5u,  /* skipping an unknown bytes field */
+    ASX_BIN_STREAM_FOOTER = 6u,
+    ASX_BIN_STREAM_DONE   = 7u
+};
+
+void asx_codec_bin_stream_init(asx_codec_bin_stream *stream,
+                               void *field_buf,
+                               size_t field_cap,
+                               asx_codec_stream_field_fn on_field,
+                               void *ctx)
+{
+    if (stream == NULL) {
+        return;
+    }
+    memset(stream, 0, sizeof(*stream));
+    stream->on_field = on_field;
+    stream->ctx = ctx;
+    stream->field_buf = (char *)field_buf;
+    stream->field_cap = (field_buf != NULL) ? field_cap : 0u;
+    stream->error = ASX_OK;
+    stream->state = ASX_BIN_STREAM_HEADER;
+}
+
+static asx_status asx_codec_bin_stream_fail(asx_codec_bin_stream *stream, asx_status st)
+{
+    stream->error = st;
+    return st;
+}
+
+static asx_status asx_codec_bin_stream_emit(asx_codec_bin_stream *stream,
+                                            const asx_codec_stream_field *field)
+{
+    if (stream->on_field == NULL) {
+        return ASX_OK;
+    }
+    return stream->on_field(stream->ctx, field);
+}
+
+/* Move on once an element ends: next key, footer, or done. */
+static void asx_codec_bin_stream_next(asx_codec_bin_stream *stream)
+{
+    stream->varint = 0u;
+    stream->varint_len = 0u;
+    stream->have = 0u;
+    if (stream->payload_left > 0u) {
+        stream->state = ASX_BIN_STREAM_KEY;
+    } else if ((stream->flags & ASX_CODEC_BIN_FLAG_CHECKSUM_FOOTER) != 0u) {
+        stream->state = ASX_BIN_STREAM_FOOTER;
+        stream->need = ASX_CODEC_BIN_CHECKSUM_SIZE;
+    } else {
+        stream->state = ASX_BIN_STREAM_DONE;
+    }
+}
+
+static asx_status asx_codec_bin_stream_header(asx_codec_bin_stream *stream)
+{
+    const unsigned char *bytes = stream->header;
+
+    if (memcmp(bytes, g_asx_codec_bin_magic, 4u) != 0 ||
+        !asx_codec_bin_version_known(bytes[4]) ||
+        bytes[5] != ASX_CODEC_BIN_FRAME_MESSAGE_FIXTURE ||
+        (bytes[6] & (uint8_t)(~ASX_CODEC_BIN_FLAG_CHECKSUM_FOOTER)) != 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    stream->version = bytes[4];
+    stream->flags = bytes[6];
+    stream->checksum = asx_codec_bin_checksum32(stream->version, bytes,
+                                                ASX_CODEC_BIN_HEADER_SIZE);
+    stream->payload_left = asx_codec_bin_load_u32_be(bytes + 7);
+    asx_codec_bin_stream_next(stream);
+    return ASX_OK;
+}
+
+/* Returns 1 when the varint is complete, 0 for more, -1 when malformed. */
+static int asx_codec_bin_stream_varint(asx_codec_bin_stream *stream, unsigned char byte)
+{
+    if (stream->varint_len == 9u && (byte & 0xfeu) != 0u) {
+        return -1;
+    }
+    stream->varint |= ((uint64_t)(byte & 0x7fu)) << (7u * stream->varint_len);
+    stream->varint_len++;
+    if ((byte & 0x80u) == 0u) {
+        return 1;
+    }
+    return stream->varint_len < 10u ? 0 : -1;
+}
+
+/* Per-field checks matching asx_codec_bin_validate_view. */
+static asx_status asx_codec_bin_stream_check(uint32_t tag, asx_codec_slice text)
+{
+    if (text.len == 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    switch (tag) {
+    case ASX_CODEC_BIN_TAG_FIXTURE_SCHEMA_VERSION:
+        return asx_codec_slice_matches(text, "fixture-v1") ? ASX_OK : ASX_E_INVALID_ARGUMENT;
+    case ASX_CODEC_BIN_TAG_INPUT_JSON:
+        if (strlen(text.ptr) != text.len ||
+            !asx_codec_json_value_matches(text.ptr, '{') ||
+            strstr(text.ptr, "\"ops\"") == NULL) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        return ASX_OK;
+    case ASX_CODEC_BIN_TAG_EXPECTED_EVENTS_JSON:
+    case ASX_CODEC_BIN_TAG_EXPECTED_ERROR_CODES_JSON:
+        return (strlen(text.ptr) == text.len &&
+                asx_codec_json_value_matches(text.ptr, '[')) ? ASX_OK : ASX_E_INVALID_ARGUMENT;
+    case ASX_CODEC_BIN_TAG_EXPECTED_FINAL_SNAPSHOT_JSON:
+        return (strlen(text.ptr) == text.len &&
+                asx_codec_json_value_matches(text.ptr, '{')) ? ASX_OK : ASX_E_INVALID_ARGUMENT;
+    case ASX_CODEC_BIN_TAG_SEMANTIC_DIGEST:
+        return asx_codec_slice_is_sha256_digest(text) ? ASX_OK : ASX_E_INVALID_ARGUMENT;
+    default:
+        return ASX_OK;
+    }
+}
+
+static asx_status asx_codec_bin_stream_key(asx_codec_bin_stream *stream)
+{
+    uint64_t key = stream->varint;
+
+    stream->tag = (uint32_t)(key >> 2u);
+    stream->wire = (uint8_t)(key & ASX_CODEC_BIN_WIRE_MASK);
+    if (stream->tag == 0u || stream->tag > 63u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (stream->wire == ASX_CODEC_BIN_WIRE_VARINT) {
+        stream->state = ASX_BIN_STREAM_VALUE;
+    } else if (stream->wire == ASX_CODEC_BIN_WIRE_BYTES) {
+        stream->state = ASX_BIN_STREAM_LEN;
+    } else {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    stream->varint = 0u;
+    stream->varint_len = 0u;
+    return ASX_OK;
+}
+
+static asx_status asx_codec_bin_stream_value(asx_codec_bin_stream *stream)
+{
+    asx_codec_stream_field field;
+    uint32_t bit;
+
+    if (stream->tag != ASX_CODEC_BIN_TAG_CODEC && stream->tag != ASX_CODEC_BIN_TAG_SEED) {
+        asx_codec_bin_stream_next(stream);
+        return ASX_OK;
+    }
+    bit = 1u << (stream->tag - 1u);
+    if ((stream->seen & bit) != 0u ||
+        (stream->tag == ASX_CODEC_BIN_TAG_CODEC &&
+         stream->varint > (uint64_t)ASX_CODEC_KIND_BIN)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    stream->seen |= bit;
+
+    memset(&field, 0, sizeof(field));
+    field.field = (asx_codec_field)stream->tag;
+    field.value = stream->varint;
+    asx_codec_bin_stream_next(stream);
+    return asx_codec_bin_stream_emit(stream, &field);
+}
+
+static asx_status asx_codec_bin_stream_len(asx_codec_bin_stream *stream)
+{
+    uint32_t bit;
+
+    if (stream->varint > (uint64_t)stream->payload_left) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    stream->need = (size_t)stream->varint;
+    stream->have = 0u;
+    if (stream->tag > ASX_CODEC_BIN_TAG_CAPTURE_RUN_ID ||
+        stream->tag == ASX_CODEC_BIN_TAG_CODEC ||
+        stream->tag == ASX_CODEC_BIN_TAG_SEED) {
+        stream->state = ASX_BIN_STREAM_SKIP;
+        return ASX_OK;
+    }
+    bit = 1u << (stream->tag - 1u);
+    if ((stream->seen & bit) != 0u) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (stream->need >= stream->field_cap) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    stream->state = ASX_BIN_STREAM_FIELD;
+    return ASX_OK;
+}
+
+static asx_status asx_codec_bin_stream_field(asx_codec_bin_stream *stream)
+{
+    asx_codec_stream_field field;
+    asx_status st;
+
+    stream->field_buf[stream->need] = '\0';
+    memset(&field, 0, sizeof(field));
+    field.field = (asx_codec_field)stream->tag;
+    field.bytes.ptr = stream->field_buf;
+    field.bytes.len = stream->need;
+
+    st = asx_codec_bin_stream_check(stream->tag, field.bytes);
+    if (st != ASX_OK) {
+        return st;
+    }
+    stream->seen |= 1u << (stream->tag - 1u);
+    asx_codec_bin_stream_next(stream);
+    return asx_codec_bin_stream_emit(stream, &field);
+}
+
+asx_status asx_codec_bin_stream_feed(asx_codec_bin_stream *stream,
+                                     const void *data,
+                                     size_t len)
+{
+    const unsigned char *p = (const unsigned char *)data;
+    asx_status st = ASX_OK;
+
+    if (stream == NULL || (data == NULL && len > 0u)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (stream->error != ASX_OK) {
+        return stream->error;
+    }
+
+    while (len > 0u) {
+        size_t n;
+        int step;
+
+        switch (stream->state) {
+        case ASX_BIN_STREAM_HEADER:
+            n = ASX_CODEC_BIN_HEADER_SIZE - stream->have;
+            if (n > len) n = len;
+            memcpy(stream->header + stream->have, p, n);
+            stream->have += n;
+            p += n;
+            len -= n;
+            if (stream->have == ASX_CODEC_BIN_HEADER_SIZE) {
+                st = asx_codec_bin_stream_header(stream);
+            }
+            break;
+
+        case ASX_BIN_STREAM_KEY:
+        case ASX_BIN_STREAM_VALUE:
+        case ASX_BIN_STREAM_LEN:
+            if (stream->payload_left == 0u) {
+                return asx_codec_bin_stream_fail(stream, ASX_E_INVALID_ARGUMENT);
+            }
+            stream->checksum = asx_codec_bin_checksum_update(stream->version, stream->checksum, p, 1u);
+            stream->payload_left--;
+            step = asx_codec_bin_stream_varint(stream, *p);
+            p++;
+            len--;
+            if (step < 0) {
+                st = ASX_E_INVALID_ARGUMENT;
+            } else if (step > 0) {
+                if (stream->state == ASX_BIN_STREAM_KEY) {
+                    st = asx_codec_bin_stream_key(stream);
+                } else if (stream->state == ASX_BIN_STREAM_VALUE) {
+                    st = asx_codec_bin_stream_value(stream);
+                } else {
+                    st = asx_codec_bin_stream_len(stream);
+                }
+            }
+            break;
+
+        case ASX_BIN_STREAM_FIELD:
+        case ASX_BIN_STREAM_SKIP:
+            n = stream->need - stream->have;
+            if (n > len) n = len;
+            if (stream->state == ASX_BIN_STREAM_FIELD) {
+                memcpy(stream->field_buf + stream->have, p, n);
+            }
+            stream->checksum = asx_codec_bin_checksum_update(stream->version, stream->checksum, p, n);
+            stream->payload_left -= (uint32_t)n;
+            stream->have += n;
+            p += n;
+            len -= n;
+            break;
+
+        case ASX_BIN_STREAM_FOOTER:
+            n = ASX_CODEC_BIN_CHECKSUM_SIZE - stream->have;
+            if (n > len) n = len;
+            memcpy(stream->header + stream->have, p, n);
+            stream->have += n;
+            p += n;
+            len -= n;
+            if (stream->have == ASX_CODEC_BIN_CHECKSUM_SIZE) {
+                if (asx_codec_bin_load_u32_be(stream->header) != stream->checksum) {
+                    st = ASX_E_INVALID_ARGUMENT;
+                } else {
+                    stream->state = ASX_BIN_STREAM_DONE;
+                }
+            }
+            break;
+
+        default:
+            /* Trailing bytes after a complete frame */
+            st = ASX_E_INVALID_ARGUMENT;
+            break;
+        }
+
+        /* Zero-length fields complete without consuming bytes */
+        if (st == ASX_OK && stream->have == stream->need &&
+            (stream->state == ASX_BIN_STREAM_FIELD || stream->state == ASX_BIN_STREAM_SKIP)) {
+            if (stream->state == ASX_BIN_STREAM_FIELD) {
+                st = asx_codec_bin_stream_field(stream);
+            } else {
+                asx_codec_bin_stream_next(stream);
+            }
+        }
+        if (st != ASX_OK) {
+            return asx_codec_bin_stream_fail(stream, st);
+        }
+    }
+    return ASX_OK;
+}
+
+asx_status asx_codec_bin_stream_finish(asx_codec_bin_stream *stream)
+{
+    enum {
+        ASX_BIN_STREAM_REQUIRED = (1u << 17) - 1u
+    };
+
+    if (stream == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (stream->error != ASX_OK) {
+        return stream->error;
+    }
+    if (stream->state != ASX_BIN_STREAM_DONE || stream->seen != ASX_BIN_STREAM_REQUIRED) {
+        return asx_codec_bin_stream_fail(stream, ASX_E_INVALID_ARGUMENT);
+    }
+    return ASX_OK;
+}
+
 static const asx_codec_vtable g_asx_codec_json_vtable = {
     ASX_CODEC_KIND_JSON,
     asx_codec_encode_fixture_json,
@@ -2557,6 +4049,99 @@ asx_status asx_codec_decode_fixture(asx_codec_kind codec,
     return vt->decode_fixture(payload, payload_len, out_fixture);
 }
 
+asx_status asx_codec_encode_fixtures(asx_codec_kind codec,
+                                     const asx_canonical_fixture *fixtures,
+                                     size_t count,
+                                     asx_codec_buffer *out_payloads,
+                                     size_t *offsets)
+{
+    asx_status st = ASX_OK;
+    size_t i;
+
+    if ((fixtures == NULL && count > 0u) || out_payloads == NULL || offsets == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (codec != ASX_CODEC_KIND_JSON && codec != ASX_CODEC_KIND_BIN) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    out_payloads->len = 0u;
+    if (out_payloads->data != NULL) {
+        out_payloads->data[0] = '\0';
+    }
+
+    for (i = 0u; i < count && st == ASX_OK; i++) {
+        offsets[i] = out_payloads->len;
+        if (codec == ASX_CODEC_KIND_JSON) {
+            st = asx_canonical_fixture_validate(&fixtures[i]);
+            if (st == ASX_OK) st = asx_codec_json_append_fixture(&fixtures[i], out_payloads);
+        } else {
+            st = asx_codec_bin_check_encodable(&fixtures[i]);
+            if (st == ASX_OK) st = asx_codec_bin_append_fixture(&fixtures[i], out_payloads);
+        }
+    }
+    if (st != ASX_OK) {
+        out_payloads->len = 0u;
+        if (out_payloads->data != NULL) {
+            out_payloads->data[0] = '\0';
+        }
+        return st;
+    }
+    offsets[count] = out_payloads->len;
+    return ASX_OK;
+}
+
+asx_status asx_codec_decode_fixtures(asx_codec_kind codec,
+                                     const void *payloads,
+                                     const size_t *offsets,
+                                     size_t count,
+                                     asx_canonical_fixture *out_fixtures)
+{
+    const char *bytes = (const char *)payloads;
+    asx_codec_buffer scratch;
+    asx_status st = ASX_OK;
+    size_t i;
+
+    if ((count > 0u && (payloads == NULL || out_fixtures == NULL)) || offsets == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (codec != ASX_CODEC_KIND_JSON && codec != ASX_CODEC_KIND_BIN) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    for (i = 0u; i < count; i++) {
+        if (offsets[i + 1u] < offsets[i]) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+
+    /* JSON payloads are NUL-terminated in one reused scratch buffer */
+    asx_codec_buffer_init(&scratch);
+    for (i = 0u; i < count && st == ASX_OK; i++) {
+        const char *payload = bytes + offsets[i];
+        size_t len = offsets[i + 1u] - offsets[i];
+
+        asx_canonical_fixture_reset(&out_fixtures[i]);
+        if (codec == ASX_CODEC_KIND_BIN) {
+            st = asx_codec_decode_fixture_bin(payload, len, &out_fixtures[i]);
+        } else if (len == 0u || memchr(payload, '\0', len) != NULL) {
+            st = ASX_E_INVALID_ARGUMENT;
+        } else {
+            scratch.len = 0u;
+            st = asx_codec_buffer_append_bytes(&scratch, payload, len);
+            if (st == ASX_OK) st = asx_codec_decode_fixture_json(scratch.data, &out_fixtures[i]);
+        }
+    }
+    asx_codec_buffer_reset(&scratch);
+
+    if (st != ASX_OK) {
+        while (i > 0u) {
+            i--;
+            asx_canonical_fixture_reset(&out_fixtures[i]);
+        }
+    }
+    return st;
+}
+
 /* Cross-codec semantic equivalence functions are defined in equivalence.c.
  * They were previously duplicated here (bd-2n0.3) — removed to fix ODR
  * violation that caused linker errors when both TUs were compiled. */
@@ -4,8 +4,9 @@
  * Provides generation-safe handle validation, cleanup-stack primitives,
  * and region/task lifecycle operations.
  *
- * Uses fixed-size static arenas. Phase 3 will replace with
- * hook-backed dynamic allocation (bd-hwb.3, bd-2cw.1).
+ * Arenas are chunked slabs (see runtime_internal.h): the first chunk
+ * is static, later chunks come from asx_runtime_alloc while the
+ * allocator is unsealed.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -14,188 +15,725 @@
 #include <asx/runtime/runtime.h>
 #include <asx/core/transition.h>
 #include <asx/core/ghost.h>
+#include <asx/runtime/waker.h>
 #include <string.h>
 #include "runtime_internal.h"
+#include "context_internal.h"
 
 /* -------------------------------------------------------------------
- * Global arenas (walking skeleton: fixed-size, no dynamic allocation)
+ * Global arenas (chunk 0 static, further chunks hook-allocated)
  * ------------------------------------------------------------------- */
 
-asx_region_slot g_regions[ASX_MAX_REGIONS];
-uint32_t        g_region_count;
+static asx_region_slot     g_region_base[ASX_MAX_REGIONS];
+static asx_task_slot       g_task_base[ASX_MAX_TASKS];
+static asx_task_cold       g_task_cold_base[ASX_MAX_TASKS];
+static asx_obligation_slot g_obligation_base[ASX_MAX_OBLIGATIONS];
+#if ASX_TASK_PROFILE
+static asx_task_profile_slot g_task_profile_base[ASX_MAX_TASKS];
+#endif
 
-asx_task_slot   g_tasks[ASX_MAX_TASKS];
-uint32_t        g_task_count;
+asx_region_slot *g_region_chunks[ASX_REGION_CHUNK_LIMIT] = { g_region_base };
+uint32_t         g_region_capacity = ASX_MAX_REGIONS;
+uint32_t         g_region_count;
+uint32_t         g_region_free_head = ASX_REGION_LINK_NONE;
+
+asx_task_slot   *g_task_chunks[ASX_TASK_CHUNK_LIMIT] = { g_task_base };
+asx_task_cold   *g_task_cold_chunks[ASX_TASK_CHUNK_LIMIT] = { g_task_cold_base };
+uint32_t         g_task_capacity = ASX_MAX_TASKS;
+uint32_t         g_task_count;
+uint32_t         g_task_free_head = ASX_TASK_LINK_NONE;
+uint32_t         g_task_free_count;
+uint32_t         g_task_claimed;
+#if ASX_TASK_PROFILE
+asx_task_profile_slot *g_task_profile_chunks[ASX_TASK_CHUNK_LIMIT] = { g_task_profile_base };
+#endif
 
-asx_obligation_slot g_obligations[ASX_MAX_OBLIGATIONS];
-uint32_t            g_obligation_count;
+asx_obligation_slot *g_obligation_chunks[ASX_OBLIGATION_CHUNK_LIMIT] = { g_obligation_base };
+uint32_t             g_obligation_capacity = ASX_MAX_OBLIGATIONS;
+uint32_t             g_obligation_count;
+uint32_t             g_obligation_free_head = ASX_OBLIGATION_LINK_NONE;
+uint32_t             g_obligation_free_count;
+uint32_t             g_obligation_claimed;
+
+/* Deferred captured-state destructors (asx_region_options.dtor_batch):
+ * entries queue on their region, oldest first, or sit on the free list */
+#define DTOR_DEFER_SLOTS ASX_MAX_TASKS
+#define DTOR_DEFER_NONE  UINT32_MAX
+
+typedef struct {
+    asx_task_state_dtor_fn fn;
+    void                  *state;
+    uint32_t               size;
+    uint32_t               next;
+} dtor_defer_entry;
+
+static dtor_defer_entry g_dtor_defer[DTOR_DEFER_SLOTS];
+static uint32_t         g_dtor_defer_count;
+static uint32_t         g_dtor_defer_free_head = DTOR_DEFER_NONE;
+
+/* Obligation leases: entries are taken by asx_obligation_set_lease
+ * and go back when the obligation resolves, or sit on the free list */
+#define LEASE_SLOTS ASX_MAX_OBLIGATIONS
+
+typedef struct {
+    asx_time         deadline;
+    asx_timer_handle timer;
+    uint32_t         next;      /* free-list link */
+} lease_entry;
+
+static lease_entry g_lease[LEASE_SLOTS];
+static uint32_t    g_lease_count;
+static uint32_t    g_lease_free_head = ASX_LEASE_NONE;
+
+/* Handle epoch: the generation a never-used slot starts at. With
+ * ASX_HANDLE_EPOCH each reset moves it past every generation handed
+ * out since the previous one; otherwise it stays 0. */
+static asx_generation g_handle_epoch;
+
+/* Startup values of the arena globals, for fresh asx_runtime contexts */
+static asx_region_slot *const g_region_chunks_init[ASX_REGION_CHUNK_LIMIT] = { g_region_base };
+static asx_task_slot   *const g_task_chunks_init[ASX_TASK_CHUNK_LIMIT] = { g_task_base };
+static asx_task_cold   *const g_task_cold_chunks_init[ASX_TASK_CHUNK_LIMIT] = { g_task_cold_base };
+#if ASX_TASK_PROFILE
+static asx_task_profile_slot *const g_task_profile_chunks_init[ASX_TASK_CHUNK_LIMIT] = { g_task_profile_base };
+#endif
+static asx_obligation_slot *const g_obligation_chunks_init[ASX_OBLIGATION_CHUNK_LIMIT] = { g_obligation_base };
+static const uint32_t g_region_capacity_init     = ASX_MAX_REGIONS;
+static const uint32_t g_task_capacity_init       = ASX_MAX_TASKS;
+static const uint32_t g_obligation_capacity_init = ASX_MAX_OBLIGATIONS;
+static const uint32_t g_lifecycle_link_none      = UINT32_MAX;
+
+static const asx_context_block g_lifecycle_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_region_base),
+    ASX_CONTEXT_BLOCK(g_task_base),
+    ASX_CONTEXT_BLOCK(g_task_cold_base),
+    ASX_CONTEXT_BLOCK(g_obligation_base),
+#if ASX_TASK_PROFILE
+    ASX_CONTEXT_BLOCK(g_task_profile_base),
+    ASX_CONTEXT_BLOCK_INIT(g_task_profile_chunks, g_task_profile_chunks_init),
+#endif
+    ASX_CONTEXT_BLOCK_INIT(g_region_chunks, g_region_chunks_init),
+    ASX_CONTEXT_BLOCK_INIT(g_region_capacity, g_region_capacity_init),
+    ASX_CONTEXT_BLOCK(g_region_count),
+    ASX_CONTEXT_BLOCK_INIT(g_region_free_head, g_lifecycle_link_none),
+    ASX_CONTEXT_BLOCK_INIT(g_task_chunks, g_task_chunks_init),
+    ASX_CONTEXT_BLOCK_INIT(g_task_cold_chunks, g_task_cold_chunks_init),
+    ASX_CONTEXT_BLOCK_INIT(g_task_capacity, g_task_capacity_init),
+    ASX_CONTEXT_BLOCK(g_task_count),
+    ASX_CONTEXT_BLOCK_INIT(g_task_free_head, g_lifecycle_link_none),
+    ASX_CONTEXT_BLOCK(g_task_free_count),
+    ASX_CONTEXT_BLOCK(g_task_claimed),
+    ASX_CONTEXT_BLOCK_INIT(g_obligation_chunks, g_obligation_chunks_init),
+    ASX_CONTEXT_BLOCK_INIT(g_obligation_capacity, g_obligation_capacity_init),
+    ASX_CONTEXT_BLOCK(g_obligation_count),
+    ASX_CONTEXT_BLOCK_INIT(g_obligation_free_head, g_lifecycle_link_none),
+    ASX_CONTEXT_BLOCK(g_obligation_free_count),
+    ASX_CONTEXT_BLOCK(g_obligation_claimed),
+    ASX_CONTEXT_BLOCK(g_dtor_defer),
+    ASX_CONTEXT_BLOCK(g_dtor_defer_count),
+    ASX_CONTEXT_BLOCK_INIT(g_dtor_defer_free_head, g_lifecycle_link_none),
+    ASX_CONTEXT_BLOCK(g_lease),
+    ASX_CONTEXT_BLOCK(g_lease_count),
+    ASX_CONTEXT_BLOCK_INIT(g_lease_free_head, g_lifecycle_link_none),
+    ASX_CONTEXT_BLOCK(g_handle_epoch)
+};
+
+const asx_context_module asx_lifecycle_context = ASX_CONTEXT_MODULE(g_lifecycle_blocks);
 
 /* -------------------------------------------------------------------
- * Reset (test support)
+ * Region capture arenas
+ *
+ * Bump allocation in the current block, 8-byte granules. A request the
+ * current block cannot hold chains a new block sized for it (at least
+ * ASX_REGION_CAPTURE_BLOCK_BYTES, at most what the limit leaves); the
+ * tail of the old block is abandoned. capture_used counts bytes handed
+ * out, so the limit bounds what spawns receive, not the block tails.
  * ------------------------------------------------------------------- */
 
-void asx_runtime_reset(void)
+typedef struct capture_block {
+    struct capture_block *next;
+} capture_block;
+
+/* Header rounded to keep payloads 8-byte aligned on every target */
+#define CAPTURE_BLOCK_HEADER 16u
+
+/* Arena position saved before an allocation so a failed spawn can undo it */
+typedef struct {
+    uint8_t *cur;
+    uint32_t cur_size;
+    uint32_t cur_used;
+    uint32_t used;
+    void    *chain;
+} capture_mark;
+
+static uint32_t asx_align_up_u32(uint32_t value, uint32_t align)
 {
-    uint32_t i;
-    for (i = 0; i < ASX_MAX_REGIONS; i++) {
-        g_regions[i].state      = ASX_REGION_OPEN;
-        g_regions[i].task_count = 0;
-        g_regions[i].task_total = 0;
-        g_regions[i].generation = 0;
-        g_regions[i].alive      = 0;
-        asx_cleanup_init(&g_regions[i].cleanup);
-        g_regions[i].capture_used = 0;
-    }
-    g_region_count = 0;
-    for (i = 0; i < ASX_MAX_TASKS; i++) {
-        g_tasks[i].state      = ASX_TASK_CREATED;
-        g_tasks[i].region     = ASX_INVALID_ID;
-        g_tasks[i].poll_fn    = NULL;
-        g_tasks[i].user_data  = NULL;
-        g_tasks[i].outcome    = asx_outcome_make(ASX_OUTCOME_OK);
-        g_tasks[i].generation = 0;
-        g_tasks[i].alive      = 0;
-        g_tasks[i].captured_state = NULL;
-        g_tasks[i].captured_size = 0;
-        g_tasks[i].captured_dtor = NULL;
-        g_tasks[i].cancel_phase = 0;
-        g_tasks[i].cancel_pending = 0;
-        g_tasks[i].cancel_epoch = 0;
-        g_tasks[i].cleanup_polls_remaining = 0;
-        memset(&g_tasks[i].cancel_reason, 0, sizeof(g_tasks[i].cancel_reason));
+    uint32_t rem = value % align;
+    if (rem == 0u) return value;
+    return value + (align - rem);
+}
+
+static void region_capture_init(asx_region_slot *r, uint32_t limit)
+{
+    r->capture_cur      = r->capture_inline;
+    r->capture_cur_size = ASX_REGION_CAPTURE_INLINE_BYTES;
+    r->capture_cur_used = 0;
+    r->capture_used     = 0;
+    r->capture_limit    = limit;
+    r->capture_chain    = NULL;
+}
+
+static void capture_block_free_until(asx_region_slot *r, void *stop)
+{
+    while (r->capture_chain != stop) {
+        ASX_CHECKPOINT_WAIVER("bounded by blocks chained to this region");
+        capture_block *b = (capture_block *)r->capture_chain;
+        r->capture_chain = b->next;
+        (void)asx_runtime_free(b);
     }
-    g_task_count = 0;
-    for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
-        g_obligations[i].state      = ASX_OBLIGATION_RESERVED;
-        g_obligations[i].region     = ASX_INVALID_ID;
-        g_obligations[i].generation = 0;
-        g_obligations[i].alive      = 0;
+}
+
+static void region_capture_release(asx_region_slot *r)
+{
+    capture_block_free_until(r, NULL);
+}
+
+/* Chain a block with payload bytes and make it current. */
+static asx_status region_capture_push(asx_region_slot *r, uint32_t bytes)
+{
+    void *mem;
+    capture_block *b;
+
+    if (bytes > UINT32_MAX - CAPTURE_BLOCK_HEADER) return ASX_E_RESOURCE_EXHAUSTED;
+    if (asx_runtime_alloc_tagged(ASX_ALLOC_TAG_CAPTURE,
+                                 (size_t)bytes + CAPTURE_BLOCK_HEADER, &mem) != ASX_OK)
+        return ASX_E_RESOURCE_EXHAUSTED;
+    b = (capture_block *)mem;
+    b->next = (capture_block *)r->capture_chain;
+    r->capture_chain    = b;
+    r->capture_cur      = (uint8_t *)mem + CAPTURE_BLOCK_HEADER;
+    r->capture_cur_size = bytes;
+    r->capture_cur_used = 0;
+    return ASX_OK;
+}
+
+static void *asx_region_capture_alloc(asx_region_slot *region, uint32_t size,
+                                      capture_mark *mark)
+{
+    uint32_t left;
+    uint32_t aligned_size;
+    void *p;
+
+    if (size == 0u || mark == NULL) return NULL;
+
+    left = region->capture_limit - region->capture_used;
+    if (size > left) return NULL;
+    aligned_size = asx_align_up_u32(size, 8u);
+    if (aligned_size < size || aligned_size > left) return NULL;
+
+    mark->cur      = region->capture_cur;
+    mark->cur_size = region->capture_cur_size;
+    mark->cur_used = region->capture_cur_used;
+    mark->used     = region->capture_used;
+    mark->chain    = region->capture_chain;
+
+    if (aligned_size > region->capture_cur_size - region->capture_cur_used) {
+        uint32_t block = ASX_REGION_CAPTURE_BLOCK_BYTES;
+
+        if (block > left) block = left;
+        if (block < aligned_size) block = aligned_size;
+        if (region_capture_push(region, block) != ASX_OK) return NULL;
     }
-    g_obligation_count = 0;
 
-    /* Reset ghost safety monitors */
-    asx_ghost_reset();
+    p = region->capture_cur + region->capture_cur_used;
+    region->capture_cur_used += aligned_size;
+    region->capture_used += aligned_size;
+    return p;
+}
+
+static void asx_region_capture_rollback(asx_region_slot *region,
+                                        const capture_mark *mark)
+{
+    capture_block_free_until(region, mark->chain);
+    region->capture_cur      = mark->cur;
+    region->capture_cur_size = mark->cur_size;
+    region->capture_cur_used = mark->cur_used;
+    region->capture_used     = mark->used;
 }
 
 /* -------------------------------------------------------------------
- * Generation-safe lookup helpers (shared across TUs)
- *
- * Returns ASX_OK on success, ASX_E_STALE_HANDLE when the slot is
- * alive but the handle's generation doesn't match, or ASX_E_NOT_FOUND
- * for all other failures (invalid handle, wrong type tag, dead slot).
+ * Slot initialization
  * ------------------------------------------------------------------- */
 
-asx_status asx_region_slot_lookup(asx_region_id id, asx_region_slot **out)
+/* Empty channel, task, obligation and child lists; no parent */
+static void region_tree_reset(asx_region_slot *r)
 {
-    uint16_t tag, slot_idx, handle_gen;
+    r->channel_head = ASX_CHANNEL_LINK_NONE;
+    r->oneshot_head = ASX_ONESHOT_LINK_NONE;
+    r->group_head   = ASX_GROUP_LINK_NONE;
+    r->sem_head     = ASX_SEMAPHORE_LINK_NONE;
+    r->rate_head    = ASX_RATE_LINK_NONE;
+    r->task_head    = ASX_TASK_LINK_NONE;
+    r->task_tail    = ASX_TASK_LINK_NONE;
+    r->done_head    = ASX_TASK_LINK_NONE;
+    r->done_tail    = ASX_TASK_LINK_NONE;
+    r->obligation_head = ASX_OBLIGATION_LINK_NONE;
+    r->obligation_tail = ASX_OBLIGATION_LINK_NONE;
+    r->leases       = 0;
+    r->lease_next   = 0;
+    r->dtor_head    = DTOR_DEFER_NONE;
+    r->dtor_tail    = DTOR_DEFER_NONE;
+    r->dtor_pending = 0;
+    r->parent       = ASX_REGION_LINK_NONE;
+    r->first_child  = ASX_REGION_LINK_NONE;
+    r->last_child   = ASX_REGION_LINK_NONE;
+    r->prev_sibling = ASX_REGION_LINK_NONE;
+    r->next_sibling = ASX_REGION_LINK_NONE;
+}
 
-    *out = NULL;
-    if (!asx_handle_is_valid(id)) return ASX_E_NOT_FOUND;
+static void region_slot_init(asx_region_slot *r)
+{
+    r->state      = ASX_REGION_OPEN;
+    r->task_count = 0;
+    r->task_total = 0;
+    r->tasks_uncancelled = 0;
+    r->obligations_reserved = 0;
+    r->tasks_claimed = 0;
+    r->obligations_claimed = 0;
+    r->task_quota = 0;
+    r->obligation_quota = 0;
+    r->key        = 0;
+    r->free_next  = ASX_REGION_LINK_NONE;
+    r->poisoned   = 0;
+    r->deadline   = 0;
+    r->deadline_timer.slot = UINT32_MAX;
+    r->admission_on = 0;
+    r->deadline_timer.generation = 0;
+    r->dtor_batch = 0;
+    asx_cleanup_init(&r->cleanup);
+    region_capture_init(r, ASX_REGION_CAPTURE_ARENA_BYTES);
+    asx_region_ready_reset(r);
+    region_tree_reset(r);
+}
 
-    tag = asx_handle_type_tag(id);
-    if (tag != ASX_TYPE_REGION) return ASX_E_NOT_FOUND;
+static void task_slot_init(asx_task_slot *t, asx_task_cold *cold)
+{
+    t->state      = ASX_TASK_CREATED;
+    t->region     = ASX_INVALID_ID;
+    t->poll_fn    = NULL;
+    t->user_data  = NULL;
+    t->cold       = cold;
+    t->key        = 0;
+    t->cancel_pending = 0;
+    t->cleanup_polls_remaining = 0;
+    t->ready_prev = ASX_TASK_LINK_NONE;
+    t->ready_next = ASX_TASK_LINK_NONE;
+    t->ready_linked = 0;
+    t->park_kind  = 0;
+    t->parked     = 0;
+    t->priority   = (uint8_t)ASX_TASK_PRIORITY_DEFAULT;
+    t->sched_wait = 0;
+    t->hot_polls  = 0;
+    t->poll_cost  = 0;
+
+    cold->outcome        = (uint8_t)ASX_OUTCOME_OK;
+    cold->captured_state = NULL;
+    cold->captured_size  = 0;
+    cold->captured_dtor  = NULL;
+    cold->cancel_phase   = 0;
+    cold->cancel_epoch   = 0;
+    cold->park_key       = 0;
+    cold->sched_deadline = 0;
+    cold->cancel_ns = 0;
+    memset(cold->local, 0, sizeof(cold->local));
+    cold->region_prev    = ASX_TASK_LINK_NONE;
+    cold->region_next    = ASX_TASK_LINK_NONE;
+    cold->lane           = 0;
+    cold->reclaimed      = 0;
+    cold->group          = 0;
+    cold->sem            = 0;
+    cold->sem_granted    = 0;
+    cold->sem_prev       = ASX_TASK_LINK_NONE;
+    cold->sem_next       = ASX_TASK_LINK_NONE;
+    cold->cancel_kind    = (uint8_t)ASX_CANCEL_USER;
+    cold->cancel_attr    = ASX_CANCEL_ATTR_NONE;
+}
 
-    slot_idx = asx_handle_slot(id);
-    if (slot_idx >= ASX_MAX_REGIONS) return ASX_E_NOT_FOUND;
-    if (!g_regions[slot_idx].alive) return ASX_E_NOT_FOUND;
+static void obligation_slot_init(asx_obligation_slot *o)
+{
+    o->state      = ASX_OBLIGATION_RESERVED;
+    o->region     = ASX_INVALID_ID;
+    o->key        = 0;
+    o->link       = ASX_ONESHOT_LINK_NONE;
+    o->region_prev = ASX_OBLIGATION_LINK_NONE;
+    o->region_next = ASX_OBLIGATION_LINK_NONE;
+    o->lease      = ASX_LEASE_NONE;
+}
 
-    handle_gen = asx_handle_generation(id);
-    if (handle_gen != g_regions[slot_idx].generation) return ASX_E_STALE_HANDLE;
+/* -------------------------------------------------------------------
+ * Arena growth
+ *
+ * Each grow call appends exactly one chunk. Failure of the allocator
+ * hook (not installed, sealed, fault-injected, or out of memory) is
+ * reported as ASX_E_RESOURCE_EXHAUSTED so callers see the same status
+ * as a full static arena.
+ * ------------------------------------------------------------------- */
 
-    *out = &g_regions[slot_idx];
+static asx_status arena_chunk_alloc(size_t bytes, void **out)
+{
+    if (asx_runtime_alloc_tagged(ASX_ALLOC_TAG_ARENA, bytes, out) != ASX_OK) {
+        *out = NULL;
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
     return ASX_OK;
 }
 
-asx_status asx_task_slot_lookup(asx_task_id id, asx_task_slot **out)
+static asx_status region_arena_grow(void)
 {
-    uint16_t tag, slot_idx, handle_gen;
+    void *mem;
+    asx_region_slot *chunk;
+    uint32_t i;
 
-    *out = NULL;
-    if (!asx_handle_is_valid(id)) return ASX_E_NOT_FOUND;
+    if (g_region_capacity >= ASX_ARENA_MAX_REGIONS) return ASX_E_RESOURCE_EXHAUSTED;
+    if (arena_chunk_alloc(sizeof(asx_region_slot) * ASX_MAX_REGIONS, &mem) != ASX_OK)
+        return ASX_E_RESOURCE_EXHAUSTED;
+    chunk = (asx_region_slot *)mem;
+    for (i = 0; i < ASX_MAX_REGIONS; i++) {
+        region_slot_init(&chunk[i]);
+    }
+    g_region_chunks[g_region_capacity / ASX_MAX_REGIONS] = chunk;
+    g_region_capacity += ASX_MAX_REGIONS;
+    return ASX_OK;
+}
 
-    tag = asx_handle_type_tag(id);
-    if (tag != ASX_TYPE_TASK) return ASX_E_NOT_FOUND;
+#if ASX_TASK_PROFILE
+#define TASK_PROFILE_CHUNK_BYTES (sizeof(asx_task_profile_slot) * ASX_MAX_TASKS)
+#else
+#define TASK_PROFILE_CHUNK_BYTES 0u
+#endif
+
+/* One allocation per task chunk: hot slots first, cold slots after,
+ * then profile slots in ASX_TASK_PROFILE builds. */
+static asx_status task_arena_grow(void)
+{
+    void *mem;
+    asx_task_slot *chunk;
+    asx_task_cold *cold;
+    uint32_t i;
 
-    slot_idx = asx_handle_slot(id);
-    if (slot_idx >= ASX_MAX_TASKS) return ASX_E_NOT_FOUND;
-    if (!g_tasks[slot_idx].alive) return ASX_E_NOT_FOUND;
+    if (g_task_capacity >= ASX_ARENA_MAX_TASKS) return ASX_E_RESOURCE_EXHAUSTED;
+    if (arena_chunk_alloc((sizeof(asx_task_slot) + sizeof(asx_task_cold)) * ASX_MAX_TASKS
+                          + TASK_PROFILE_CHUNK_BYTES, &mem) != ASX_OK)
+        return ASX_E_RESOURCE_EXHAUSTED;
+    chunk = (asx_task_slot *)mem;
+    cold  = (asx_task_cold *)(void *)(chunk + ASX_MAX_TASKS);
+    for (i = 0; i < ASX_MAX_TASKS; i++) {
+        task_slot_init(&chunk[i], &cold[i]);
+    }
+    g_task_chunks[g_task_capacity / ASX_MAX_TASKS] = chunk;
+    g_task_cold_chunks[g_task_capacity / ASX_MAX_TASKS] = cold;
+#if ASX_TASK_PROFILE
+    g_task_profile_chunks[g_task_capacity / ASX_MAX_TASKS] =
+        (asx_task_profile_slot *)(void *)(cold + ASX_MAX_TASKS);
+#endif
+    g_task_capacity += ASX_MAX_TASKS;
+    return ASX_OK;
+}
 
-    handle_gen = asx_handle_generation(id);
-    if (handle_gen != g_tasks[slot_idx].generation) return ASX_E_STALE_HANDLE;
+static asx_status obligation_arena_grow(void)
+{
+    void *mem;
+    asx_obligation_slot *chunk;
+    uint32_t i;
 
-    *out = &g_tasks[slot_idx];
+    if (g_obligation_capacity >= ASX_ARENA_MAX_OBLIGATIONS) return ASX_E_RESOURCE_EXHAUSTED;
+    if (arena_chunk_alloc(sizeof(asx_obligation_slot) * ASX_MAX_OBLIGATIONS, &mem) != ASX_OK)
+        return ASX_E_RESOURCE_EXHAUSTED;
+    chunk = (asx_obligation_slot *)mem;
+    for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
+        obligation_slot_init(&chunk[i]);
+    }
+    g_obligation_chunks[g_obligation_capacity / ASX_MAX_OBLIGATIONS] = chunk;
+    g_obligation_capacity += ASX_MAX_OBLIGATIONS;
     return ASX_OK;
 }
 
-static uint32_t asx_align_up_u32(uint32_t value, uint32_t align)
+int asx_arena_can_grow(void)
 {
-    uint32_t rem = value % align;
-    if (rem == 0u) return value;
-    return value + (align - rem);
+    const asx_runtime_hooks *hooks = asx_runtime_get_hooks();
+    return hooks != NULL && !hooks->allocator_sealed;
 }
 
-static void *asx_region_capture_alloc(asx_region_slot *region, uint32_t size, uint32_t *old_used_out)
+/* -------------------------------------------------------------------
+ * Reset (test support)
+ *
+ * Grown chunks are returned to the allocator hook and every arena
+ * shrinks back to its static chunk.
+ * ------------------------------------------------------------------- */
+
+/* Widen span to cover a live slot's generation, counted from the epoch */
+static uint32_t epoch_span_note(uint32_t span, uint32_t key)
 {
-    uint32_t start;
-    uint32_t aligned_size;
-    uint32_t end;
+    uint32_t d;
 
-    if (size == 0u || old_used_out == NULL) return NULL;
+    if (!asx_slot_live(key)) return span;
+    d = ((uint32_t)asx_slot_generation(key) - (uint32_t)g_handle_epoch)
+        & ASX_HANDLE_FIELD_MASK;
+    return d > span ? d : span;
+}
 
-    *old_used_out = region->capture_used;
-    start = asx_align_up_u32(region->capture_used, 8u);
-    aligned_size = asx_align_up_u32(size, 8u);
+void asx_runtime_reset(void)
+{
+    uint32_t i;
+    uint32_t span = 0;
+
+    /* Only slots below the high-water marks were touched since the
+     * last reset; everything above is still zeroed storage, which
+     * region open, task spawn and obligation reserve set up on first
+     * use */
+    for (i = 0; i < g_region_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by g_region_count <= g_region_capacity");
+        /* Queued destructors still see their state */
+        if (asx_region_at(i)->dtor_pending != 0u) {
+            (void)asx_region_dtor_flush(asx_region_at(i), UINT32_MAX);
+        }
+        region_capture_release(asx_region_at(i));
+        asx_cleanup_release(&asx_region_at(i)->cleanup);
+        span = epoch_span_note(span, asx_region_at(i)->key);
+        region_slot_init(asx_region_at(i));
+    }
+    for (i = 0; i < g_task_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by g_task_count <= g_task_capacity");
+        span = epoch_span_note(span, asx_task_at(i)->key);
+        task_slot_init(asx_task_at(i), asx_task_cold_at(i));
+    }
+    for (i = 0; i < g_obligation_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by g_obligation_count <= g_obligation_capacity");
+        span = epoch_span_note(span, asx_obligation_at(i)->key);
+        obligation_slot_init(asx_obligation_at(i));
+    }
+#if ASX_HANDLE_EPOCH
+    if (g_region_count != 0u || g_task_count != 0u ||
+        g_obligation_count != 0u) {
+        g_handle_epoch = asx_generation_next(
+            (asx_generation)((uint32_t)g_handle_epoch + span));
+    }
+#else
+    (void)span;
+#endif
+    g_dtor_defer_count = 0;
+    g_dtor_defer_free_head = DTOR_DEFER_NONE;
+    g_lease_count = 0;
+    g_lease_free_head = ASX_LEASE_NONE;
+    for (i = 1; i < ASX_REGION_CHUNK_LIMIT; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_REGION_CHUNK_LIMIT");
+        if (g_region_chunks[i] != NULL) {
+            (void)asx_runtime_free(g_region_chunks[i]);
+            g_region_chunks[i] = NULL;
+        }
+    }
+    for (i = 1; i < ASX_TASK_CHUNK_LIMIT; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_TASK_CHUNK_LIMIT");
+        if (g_task_chunks[i] != NULL) {
+            (void)asx_runtime_free(g_task_chunks[i]);
+            g_task_chunks[i] = NULL;
+            g_task_cold_chunks[i] = NULL;
+#if ASX_TASK_PROFILE
+            g_task_profile_chunks[i] = NULL;
+#endif
+        }
+    }
+    for (i = 1; i < ASX_OBLIGATION_CHUNK_LIMIT; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_OBLIGATION_CHUNK_LIMIT");
+        if (g_obligation_chunks[i] != NULL) {
+            (void)asx_runtime_free(g_obligation_chunks[i]);
+            g_obligation_chunks[i] = NULL;
+        }
+    }
+    g_region_capacity     = ASX_MAX_REGIONS;
+    g_task_capacity       = ASX_MAX_TASKS;
+    g_obligation_capacity = ASX_MAX_OBLIGATIONS;
 
-    if (start > ASX_REGION_CAPTURE_ARENA_BYTES) return NULL;
-    if (aligned_size > (ASX_REGION_CAPTURE_ARENA_BYTES - start)) return NULL;
+    g_region_count = 0;
+    g_region_free_head = ASX_REGION_LINK_NONE;
+    g_task_count = 0;
+    g_task_free_head = ASX_TASK_LINK_NONE;
+    g_task_free_count = 0;
+    g_task_claimed = 0;
+    g_obligation_count = 0;
+    g_obligation_free_head = ASX_OBLIGATION_LINK_NONE;
+    g_obligation_free_count = 0;
+    g_obligation_claimed = 0;
+    asx_oneshot_reset();
+    asx_task_group_reset();
+    asx_semaphore_reset();
+    asx_rate_limiter_reset();
+    asx_watermark_reset();
+    asx_waker_reset();
+    asx_cancel_attr_reset();
+    asx_scheduler_mode_reset();
+    asx_snapshot_reset();
+    asx_parallel_lanes_invalidate();
 
-    end = start + aligned_size;
-    if (end > ASX_REGION_CAPTURE_ARENA_BYTES) return NULL;
+    /* Reset ghost safety monitors */
+    asx_ghost_reset();
+}
 
-    region->capture_used = end;
-    return (void *)&region->capture_arena[start];
+/* -------------------------------------------------------------------
+ * Generation-safe lookup helpers (shared across TUs)
+ *
+ * The lookups themselves are inline in runtime_internal.h and return
+ * ASX_OK on a key match. A miss lands here: ASX_E_STALE_HANDLE when
+ * the slot is alive but the handle's generation doesn't match, or
+ * ASX_E_NOT_FOUND for all other failures (invalid handle, wrong type
+ * tag, dead slot).
+ * ------------------------------------------------------------------- */
+
+asx_status asx_slot_lookup_miss(uint64_t id, uint16_t type_tag,
+                                uint32_t slot_key)
+{
+    if (asx_handle_type_tag(id) != type_tag) return ASX_E_NOT_FOUND;
+    if (!asx_slot_live(slot_key)) return ASX_E_NOT_FOUND;
+    return ASX_E_STALE_HANDLE;
+}
+
+/* Move a completed task from its region's done list to the task free
+ * list, once. The slot stays alive with its outcome, so the old handle
+ * still reads it until the slot is reused under a new generation. With
+ * ASX_DEBUG_QUARANTINE defined task slots are never reused. */
+static void task_reclaim(asx_region_slot *r, uint32_t idx)
+{
+#ifndef ASX_DEBUG_QUARANTINE
+    asx_task_cold *cold = asx_task_cold_at(idx);
+
+    if (cold->reclaimed) return;
+    if (cold->region_prev != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(cold->region_prev)->region_next = cold->region_next;
+    } else {
+        r->done_head = cold->region_next;
+    }
+    if (cold->region_next != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(cold->region_next)->region_prev = cold->region_prev;
+    } else {
+        r->done_tail = cold->region_prev;
+    }
+    cold->region_prev = ASX_TASK_LINK_NONE;
+    cold->region_next = g_task_free_head;
+    cold->reclaimed = 1;
+    g_task_free_head = idx;
+    g_task_free_count++;
+    asx_watermark_note(ASX_RESOURCE_TASK, g_task_count - g_task_free_count);
+#else
+    (void)r; (void)idx;
+#endif
 }
 
 /* -------------------------------------------------------------------
  * Region lifecycle
  * ------------------------------------------------------------------- */
 
+void asx_region_options_init(asx_region_options *opts)
+{
+    if (opts == NULL) return;
+    opts->capture_limit = ASX_REGION_CAPTURE_ARENA_BYTES;
+    opts->capture_reserve = 0;
+    opts->parent = ASX_INVALID_ID;
+    opts->dtor_batch = 0;
+}
+
 asx_status asx_region_open(asx_region_id *out_id)
+{
+    return asx_region_open_with(NULL, out_id);
+}
+
+asx_status asx_region_open_with(const asx_region_options *opts,
+                                asx_region_id *out_id)
 {
     uint32_t idx;
     int reclaim;
+    asx_generation generation = g_handle_epoch;
+    asx_region_slot *r = NULL;
+    asx_region_slot *parent = NULL;
+    uint32_t limit = ASX_REGION_CAPTURE_ARENA_BYTES;
+    uint32_t reserve = 0;
+    asx_status st;
 
     if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (opts != NULL) {
+        if (opts->capture_limit != 0u) limit = opts->capture_limit;
+        reserve = opts->capture_reserve;
+        if (reserve > limit) return ASX_E_INVALID_ARGUMENT;
+        if (opts->parent != ASX_INVALID_ID) {
+            st = asx_region_slot_lookup(opts->parent, &parent);
+            if (st != ASX_OK) return st;
+            if (parent->poisoned) return ASX_E_REGION_POISONED;
+            if (!asx_region_can_spawn(parent->state)) return ASX_E_REGION_NOT_OPEN;
+        }
+    }
 
-    /* Scan for a recyclable slot: unused (alive=0) or CLOSED with no tasks.
+    /* Most recently CLOSED slot first, else the next never-used slot.
      * When ASX_DEBUG_QUARANTINE is defined, CLOSED slots are never recycled
      * so that any stale-handle dereference surfaces as RESOURCE_EXHAUSTED
      * instead of silently aliasing a new region. Zero-cost when disabled. */
-    reclaim = 0;
-    for (idx = 0; idx < ASX_MAX_REGIONS; idx++) {
-        if (!g_regions[idx].alive) break;
-#ifndef ASX_DEBUG_QUARANTINE
-        if (g_regions[idx].state == ASX_REGION_CLOSED
-            && g_regions[idx].task_count == 0) {
-            reclaim = 1;
-            break;
+    reclaim = g_region_free_head != ASX_REGION_LINK_NONE;
+    if (reclaim) {
+        idx = g_region_free_head;
+    } else {
+        idx = g_region_count;
+        if (idx >= g_region_capacity &&
+            region_arena_grow() != ASX_OK) {
+            return ASX_E_RESOURCE_EXHAUSTED;
         }
-#endif
     }
-    if (idx >= ASX_MAX_REGIONS) return ASX_E_RESOURCE_EXHAUSTED;
+    r = asx_region_at(idx);
+    if (!reclaim) {
+        /* Chunk-0 slots start as zeroed storage and are set up here */
+        region_slot_init(r);
+    }
+
+    /* Blocks chained by the slot's previous region go back first */
+    region_capture_release(r);
+    region_capture_init(r, limit);
+    if (reserve > ASX_REGION_CAPTURE_INLINE_BYTES &&
+        region_capture_push(r, asx_align_up_u32(reserve, 8u)) != ASX_OK) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
 
     /* Increment generation on slot reclaim to invalidate stale handles */
     if (reclaim) {
-        g_regions[idx].generation++;
+        g_region_free_head = r->free_next;
+        r->free_next = ASX_REGION_LINK_NONE;
+        generation = asx_generation_next(asx_slot_generation(r->key));
     }
 
-    g_regions[idx].state      = ASX_REGION_OPEN;
-    g_regions[idx].task_count = 0;
-    g_regions[idx].task_total = 0;
-    g_regions[idx].alive      = 1;
-    g_regions[idx].poisoned   = 0;
-    asx_cleanup_init(&g_regions[idx].cleanup);
-    g_regions[idx].capture_used = 0;
+    r->state      = ASX_REGION_OPEN;
+    r->task_count = 0;
+    r->task_total = 0;
+    r->tasks_uncancelled = 0;
+    r->obligations_reserved = 0;
+    r->tasks_claimed = 0;
+    r->obligations_claimed = 0;
+    r->task_quota = 0;
+    r->obligation_quota = 0;
+    r->key        = asx_slot_key(ASX_TYPE_REGION, generation);
+    r->poisoned   = 0;
+    r->dtor_batch = opts != NULL ? opts->dtor_batch : 0u;
+    asx_snapshot_touch_region(idx);
+    r->admission_on = 0;
+    asx_cleanup_release(&r->cleanup);
+    asx_region_ready_reset(r);
+    region_tree_reset(r);
+    if (parent != NULL) {
+        /* Append: children stay in open order for the pre-order walk */
+        r->parent = asx_handle_slot(opts->parent);
+        r->prev_sibling = parent->last_child;
+        if (parent->last_child != ASX_REGION_LINK_NONE) {
+            asx_region_at(parent->last_child)->next_sibling = idx;
+        } else {
+            parent->first_child = idx;
+        }
+        parent->last_child = idx;
+    }
 
     if (idx >= g_region_count) {
         g_region_count = idx + 1;
@@ -203,14 +741,72 @@ asx_status asx_region_open(asx_region_id *out_id)
 
     *out_id = asx_handle_pack(ASX_TYPE_REGION,
                               (uint16_t)(1u << (unsigned)ASX_REGION_OPEN),
-                              asx_handle_pack_index(
-                                  g_regions[idx].generation,
-                                  (uint16_t)idx));
+                              asx_handle_pack_index(generation, idx));
 
     asx_trace_emit(ASX_TRACE_REGION_OPEN, *out_id, 0);
     return ASX_OK;
 }
 
+void asx_region_slot_retire(uint32_t region_idx)
+{
+    asx_region_slot *r = asx_region_at(region_idx);
+
+    asx_region_deadline_clear(r);
+    /* Unspent claims can no longer be spent */
+    g_task_claimed -= r->tasks_claimed;
+    g_obligation_claimed -= r->obligations_claimed;
+    r->tasks_claimed = 0;
+    r->obligations_claimed = 0;
+#ifndef ASX_DEBUG_QUARANTINE
+    while (r->done_head != ASX_TASK_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by the region's completed tasks");
+        task_reclaim(r, r->done_head);
+    }
+#endif
+
+    if (r->parent != ASX_REGION_LINK_NONE) {
+        asx_region_slot *p = asx_region_at(r->parent);
+
+        if (r->prev_sibling != ASX_REGION_LINK_NONE) {
+            asx_region_at(r->prev_sibling)->next_sibling = r->next_sibling;
+        } else {
+            p->first_child = r->next_sibling;
+        }
+        if (r->next_sibling != ASX_REGION_LINK_NONE) {
+            asx_region_at(r->next_sibling)->prev_sibling = r->prev_sibling;
+        } else {
+            p->last_child = r->prev_sibling;
+        }
+        r->parent = ASX_REGION_LINK_NONE;
+        r->prev_sibling = ASX_REGION_LINK_NONE;
+        r->next_sibling = ASX_REGION_LINK_NONE;
+    }
+#ifndef ASX_DEBUG_QUARANTINE
+    r->free_next = g_region_free_head;
+    g_region_free_head = region_idx;
+#endif
+}
+
+void asx_region_close_descendants(uint32_t region_idx)
+{
+    uint32_t idx;
+
+    for (idx = asx_region_preorder_next(region_idx, region_idx);
+         idx != ASX_REGION_LINK_NONE;
+         idx = asx_region_preorder_next(region_idx, idx)) {
+        ASX_CHECKPOINT_WAIVER("bounded by the subtree's regions");
+        asx_region_slot *r = asx_region_at(idx);
+        asx_region_id rid;
+
+        if (r->state != ASX_REGION_OPEN) continue;
+        rid = asx_region_handle_at(idx);
+        (void)asx_ghost_check_region_transition(rid, ASX_REGION_OPEN, ASX_REGION_CLOSING);
+        r->state = ASX_REGION_CLOSING;
+        asx_snapshot_touch_region(idx);
+        asx_trace_emit(ASX_TRACE_REGION_CLOSE, rid, 0);
+    }
+}
+
 asx_status asx_region_close(asx_region_id id)
 {
     asx_region_slot *r;
@@ -221,14 +817,17 @@ asx_status asx_region_close(asx_region_id id)
     if (r->poisoned) return ASX_E_REGION_POISONED;
 
     /* Ghost protocol monitor: record transition for diagnostics */
-    asx_ghost_check_region_transition(id, r->state, ASX_REGION_CLOSING);
+    (void)asx_ghost_check_region_transition(id, r->state, ASX_REGION_CLOSING);
 
     /* Transition Open -> Closing */
-    st = asx_region_transition_check(r->state, ASX_REGION_CLOSING);
-    if (st != ASX_OK) return st;
+    if (!asx_region_transition_legal(r->state, ASX_REGION_CLOSING)) {
+        return ASX_E_INVALID_TRANSITION;
+    }
 
     r->state = ASX_REGION_CLOSING;
+    asx_snapshot_touch_region(asx_handle_slot(id));
     asx_trace_emit(ASX_TRACE_REGION_CLOSE, id, 0);
+    asx_region_close_descendants(asx_handle_slot(id));
     return ASX_OK;
 }
 
@@ -256,6 +855,7 @@ asx_status asx_region_poison(asx_region_id id)
     if (st != ASX_OK) return st;
 
     r->poisoned = 1;
+    asx_snapshot_touch_region(asx_handle_slot(id));
     return ASX_OK;
 }
 
@@ -279,7 +879,7 @@ asx_status asx_region_contain_fault(asx_region_id id, asx_status fault)
 
     if (fault == ASX_OK) return ASX_OK;
 
-    policy = asx_containment_policy_active();
+    policy = asx_containment_policy_kernel();
     switch (policy) {
     case ASX_CONTAIN_FAIL_FAST:
         return fault;
@@ -299,23 +899,286 @@ asx_status asx_region_contain_fault(asx_region_id id, asx_status fault)
     }
 }
 
+/* Queue a destructor on region r; 0 with every entry in use */
+static int dtor_defer_push(asx_region_slot *r, asx_task_state_dtor_fn fn,
+                           void *state, uint32_t size)
+{
+    uint32_t i;
+
+    if (g_dtor_defer_free_head != DTOR_DEFER_NONE) {
+        i = g_dtor_defer_free_head;
+        g_dtor_defer_free_head = g_dtor_defer[i].next;
+    } else if (g_dtor_defer_count < DTOR_DEFER_SLOTS) {
+        i = g_dtor_defer_count++;
+    } else {
+        return 0;
+    }
+    g_dtor_defer[i].fn = fn;
+    g_dtor_defer[i].state = state;
+    g_dtor_defer[i].size = size;
+    g_dtor_defer[i].next = DTOR_DEFER_NONE;
+    if (r->dtor_tail != DTOR_DEFER_NONE) {
+        g_dtor_defer[r->dtor_tail].next = i;
+    } else {
+        r->dtor_head = i;
+    }
+    r->dtor_tail = i;
+    r->dtor_pending++;
+    return 1;
+}
+
+uint32_t asx_region_dtor_flush(asx_region_slot *region, uint32_t max_calls)
+{
+    uint32_t calls = 0;
+
+    /* The entry leaves the queue before its destructor runs */
+    while (region->dtor_head != DTOR_DEFER_NONE && calls < max_calls) {
+        ASX_CHECKPOINT_WAIVER("bounded by the region's queued destructors");
+        uint32_t i = region->dtor_head;
+        dtor_defer_entry e = g_dtor_defer[i];
+
+        region->dtor_head = e.next;
+        if (region->dtor_head == DTOR_DEFER_NONE) {
+            region->dtor_tail = DTOR_DEFER_NONE;
+        }
+        region->dtor_pending--;
+        g_dtor_defer[i].fn = NULL;
+        g_dtor_defer[i].state = NULL;
+        g_dtor_defer[i].next = g_dtor_defer_free_head;
+        g_dtor_defer_free_head = i;
+        e.fn(e.state, e.size);
+        calls++;
+    }
+    return calls;
+}
+
 void asx_task_release_capture_internal(asx_task_slot *task)
 {
+    asx_task_cold *cold;
+
     if (task == NULL) return;
+    cold = task->cold;
+
+    if (cold->captured_dtor != NULL && cold->captured_state != NULL) {
+        asx_region_slot *r = asx_region_at(asx_handle_slot(task->region));
 
-    if (task->captured_dtor != NULL && task->captured_state != NULL) {
-        task->captured_dtor(task->captured_state, task->captured_size);
+        if (r->dtor_batch == 0u ||
+            !dtor_defer_push(r, cold->captured_dtor, cold->captured_state,
+                             cold->captured_size)) {
+            cold->captured_dtor(cold->captured_state, cold->captured_size);
+        }
     }
 
-    task->captured_dtor = NULL;
-    task->captured_state = NULL;
-    task->captured_size = 0;
+    cold->captured_dtor = NULL;
+    cold->captured_state = NULL;
+    cold->captured_size = 0;
+}
+
+/* -------------------------------------------------------------------
+ * Region ready list (intrusive, ascending arena index)
+ *
+ * The scheduler walks this list instead of scanning the whole task
+ * arena, so a round costs O(runnable tasks in the region). Keeping the
+ * list sorted by arena index preserves the deterministic tie-break.
+ * ------------------------------------------------------------------- */
+
+void asx_region_ready_reset(asx_region_slot *region)
+{
+    region->ready_head = ASX_TASK_LINK_NONE;
+    region->ready_tail = ASX_TASK_LINK_NONE;
+}
+
+void asx_region_ready_insert(asx_region_slot *region, uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+    uint32_t after;
+
+    if (t->ready_linked) return;
+
+    /* Walk back from the tail to the insertion point. Spawn hands out
+     * ascending indices, so this is O(1) for the append case. */
+    after = region->ready_tail;
+    while (after != ASX_TASK_LINK_NONE && after > task_idx) {
+        ASX_CHECKPOINT_WAIVER("kernel-ready-list: bounded by region task count");
+        after = asx_task_at(after)->ready_prev;
+    }
+
+    t->ready_prev = after;
+    if (after == ASX_TASK_LINK_NONE) {
+        t->ready_next = region->ready_head;
+        region->ready_head = task_idx;
+    } else {
+        t->ready_next = asx_task_at(after)->ready_next;
+        asx_task_at(after)->ready_next = task_idx;
+    }
+    if (t->ready_next == ASX_TASK_LINK_NONE) {
+        region->ready_tail = task_idx;
+    } else {
+        asx_task_at(t->ready_next)->ready_prev = task_idx;
+    }
+    t->ready_linked = 1;
+}
+
+void asx_region_ready_remove(asx_region_slot *region, uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+
+    if (!t->ready_linked) return;
+
+    if (t->ready_prev == ASX_TASK_LINK_NONE) {
+        region->ready_head = t->ready_next;
+    } else {
+        asx_task_at(t->ready_prev)->ready_next = t->ready_next;
+    }
+    if (t->ready_next == ASX_TASK_LINK_NONE) {
+        region->ready_tail = t->ready_prev;
+    } else {
+        asx_task_at(t->ready_next)->ready_prev = t->ready_prev;
+    }
+    t->ready_prev = ASX_TASK_LINK_NONE;
+    t->ready_next = ASX_TASK_LINK_NONE;
+    t->ready_linked = 0;
 }
 
 /* -------------------------------------------------------------------
  * Task lifecycle
  * ------------------------------------------------------------------- */
 
+/* Take a free task slot and make it a CREATED task of region r. The
+ * caller has checked the region and guaranteed a slot exists (free
+ * list entry or arena capacity), so this cannot fail. */
+static asx_task_id task_spawn_slot(asx_region_id region, asx_region_slot *r,
+                                   asx_task_poll_fn poll_fn, void *user_data)
+{
+    asx_task_slot *t;
+    asx_task_id id;
+    uint32_t idx;
+    asx_generation generation = g_handle_epoch;
+
+    if (g_task_free_head != ASX_TASK_LINK_NONE) {
+        /* Reuse a reclaimed slot; the new generation stales old handles */
+        idx = g_task_free_head;
+        t = asx_task_at(idx);
+        g_task_free_head = t->cold->region_next;
+        g_task_free_count--;
+        generation = asx_generation_next(asx_slot_generation(t->key));
+        asx_cancel_attr_release(t->cold);
+    } else {
+        idx = g_task_count++;
+        t = asx_task_at(idx);
+    }
+    task_slot_init(t, asx_task_cold_at(idx));
+#if ASX_TASK_PROFILE
+    {
+        asx_task_profile_slot *prof = asx_task_profile_at(idx);
+
+        memset(&prof->stats, 0, sizeof(prof->stats));
+        prof->in_poll = 0;
+        if (asx_runtime_now_ns(&prof->mark) != ASX_OK) prof->mark = 0;
+    }
+#endif
+    t->key        = asx_slot_key(ASX_TYPE_TASK, generation);
+    t->region     = region;
+    t->poll_fn    = poll_fn;
+    t->user_data  = user_data;
+    asx_region_ready_insert(r, idx);
+    asx_task_cold_at(idx)->region_prev = r->task_tail;
+    if (r->task_tail != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(r->task_tail)->region_next = idx;
+    } else {
+        r->task_head = idx;
+    }
+    r->task_tail = idx;
+
+    r->task_count++;
+    r->task_total++;
+    r->tasks_uncancelled++;
+    asx_parallel_lane_sync(idx);
+    asx_snapshot_touch_region(asx_handle_slot(region));
+    asx_snapshot_touch_task(idx);
+
+    id = asx_handle_pack(ASX_TYPE_TASK,
+                         (uint16_t)(1u << (unsigned)ASX_TASK_CREATED),
+                         asx_handle_pack_index(generation, idx));
+
+    asx_trace_emit(ASX_TRACE_TASK_SPAWN, id, (uint64_t)region);
+    asx_watermark_note(ASX_RESOURCE_TASK, g_task_count - g_task_free_count);
+    return id;
+}
+
+asx_status asx_task_slots_ensure(uint32_t count)
+{
+    while (g_task_free_count + (g_task_capacity - g_task_count) < count) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_TASK_CHUNK_LIMIT growth steps");
+        if (task_arena_grow() != ASX_OK) return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_region_set_admission(asx_region_id id,
+                                    const asx_overload_policy *policy)
+{
+    asx_region_slot *r;
+    asx_status st;
+
+    if (policy != NULL) {
+        switch (policy->mode) {
+        case ASX_OVERLOAD_REJECT:
+        case ASX_OVERLOAD_SHED_OLDEST:
+        case ASX_OVERLOAD_BACKPRESSURE:
+            break;
+        default:
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        if (policy->threshold_pct > 100u) return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = asx_region_slot_lookup(id, &r);
+    if (st != ASX_OK) return st;
+
+    if (policy != NULL) r->admission = *policy;
+    r->admission_on = policy != NULL;
+    asx_channel_region_admission(r);
+    return ASX_OK;
+}
+
+asx_status asx_region_admission(asx_region_id region, asx_region_slot *r,
+                                asx_resource_kind kind,
+                                asx_admission_site site)
+{
+    asx_overload_decision dec;
+
+    if (!r->admission_on) return ASX_OK;
+
+    asx_overload_evaluate(&r->admission, asx_resource_used(kind),
+                          asx_resource_capacity(kind), &dec);
+    if (!dec.triggered) return ASX_OK;
+
+    asx_trace_emit(ASX_TRACE_ADMISSION, region,
+                   ASX_TRACE_ADMISSION_AUX(site, dec.mode, dec.load_pct));
+    if (dec.admit_status == ASX_OK) (void)asx_overload_shed(region, &dec);
+    return dec.admit_status;
+}
+
+/* Region checks and admission shared by every spawn entry point
+ * outside a claim, for n tasks. */
+static asx_status task_spawn_region(asx_region_id region, uint32_t n,
+                                    asx_region_slot **out)
+{
+    asx_status st;
+
+    st = asx_region_slot_lookup(region, out);
+    if (st != ASX_OK) return st;
+    if ((*out)->poisoned) return ASX_E_REGION_POISONED;
+
+    /* Only open regions can spawn tasks */
+    if (!asx_region_can_spawn((*out)->state)) return ASX_E_REGION_NOT_OPEN;
+    st = asx_region_quota_admit(*out, ASX_RESOURCE_TASK, n);
+    if (st != ASX_OK) return st;
+    return asx_region_admission(region, *out, ASX_RESOURCE_TASK,
+                                ASX_ADMISSION_SPAWN);
+}
+
 asx_status asx_task_spawn(asx_region_id region,
                           asx_task_poll_fn poll_fn,
                           void *user_data,
@@ -323,47 +1186,79 @@ asx_status asx_task_spawn(asx_region_id region,
 {
     asx_region_slot *r;
     asx_status st;
-    uint32_t idx;
 
     if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
     if (poll_fn == NULL) return ASX_E_INVALID_ARGUMENT;
 
-    st = asx_region_slot_lookup(region, &r);
+    st = task_spawn_region(region, 1u, &r);
     if (st != ASX_OK) return st;
-    if (r->poisoned) return ASX_E_REGION_POISONED;
+    /* Leave the slots behind outstanding claims untouched */
+    if (asx_task_slots_ensure(1u + g_task_claimed) != ASX_OK)
+        return ASX_E_RESOURCE_EXHAUSTED;
 
-    /* Only open regions can spawn tasks */
-    if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
+    *out_id = task_spawn_slot(region, r, poll_fn, user_data);
+    return ASX_OK;
+}
 
-    if (g_task_count >= ASX_MAX_TASKS) return ASX_E_RESOURCE_EXHAUSTED;
-
-    idx = g_task_count++;
-    g_tasks[idx].state      = ASX_TASK_CREATED;
-    g_tasks[idx].region     = region;
-    g_tasks[idx].poll_fn    = poll_fn;
-    g_tasks[idx].user_data  = user_data;
-    g_tasks[idx].outcome    = asx_outcome_make(ASX_OUTCOME_OK);
-    g_tasks[idx].generation = 0;
-    g_tasks[idx].alive      = 1;
-    g_tasks[idx].captured_state = NULL;
-    g_tasks[idx].captured_size = 0;
-    g_tasks[idx].captured_dtor = NULL;
-    g_tasks[idx].cancel_phase = 0;
-    g_tasks[idx].cancel_pending = 0;
-    g_tasks[idx].cancel_epoch = 0;
-    g_tasks[idx].cleanup_polls_remaining = 0;
-    memset(&g_tasks[idx].cancel_reason, 0, sizeof(g_tasks[idx].cancel_reason));
+asx_status asx_task_spawn_claimed(asx_resource_token *token,
+                                  asx_task_poll_fn poll_fn,
+                                  void *user_data,
+                                  asx_task_id *out_id)
+{
+    asx_region_slot *r;
+    asx_status st;
 
-    r->task_count++;
-    r->task_total++;
+    if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (poll_fn == NULL) return ASX_E_INVALID_ARGUMENT;
 
-    *out_id = asx_handle_pack(ASX_TYPE_TASK,
-                              (uint16_t)(1u << (unsigned)ASX_TASK_CREATED),
-                              asx_handle_pack_index(
-                                  g_tasks[idx].generation,
-                                  (uint16_t)idx));
+    st = asx_resource_token_spend(token, ASX_RESOURCE_TASK, &r);
+    if (st != ASX_OK) return st;
 
-    asx_trace_emit(ASX_TRACE_TASK_SPAWN, *out_id, (uint64_t)region);
+    /* The claim kept a backed slot free */
+    *out_id = task_spawn_slot(token->region, r, poll_fn, user_data);
+    return ASX_OK;
+}
+
+/* Validate a batch and reserve its task slots: all or nothing. */
+static asx_status task_batch_admit(asx_region_id region, uint32_t n,
+                                   const asx_task_poll_fn *poll_fns,
+                                   asx_region_slot **out)
+{
+    asx_status st;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by the batch size n");
+        if (poll_fns[i] == NULL) return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = task_spawn_region(region, n, out);
+    if (st != ASX_OK) return st;
+    st = asx_resource_admit(ASX_RESOURCE_TASK, n);
+    if (st != ASX_OK) return st;
+    return asx_task_slots_ensure(n + g_task_claimed);
+}
+
+asx_status asx_task_spawn_batch(asx_region_id region, uint32_t n,
+                                const asx_task_poll_fn *poll_fns,
+                                void *const *user_datas,
+                                asx_task_id *out_ids)
+{
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t i;
+
+    if (n == 0u || poll_fns == NULL || out_ids == NULL)
+        return ASX_E_INVALID_ARGUMENT;
+
+    st = task_batch_admit(region, n, poll_fns, &r);
+    if (st != ASX_OK) return st;
+
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by the batch size n");
+        out_ids[i] = task_spawn_slot(region, r, poll_fns[i],
+                                     user_datas != NULL ? user_datas[i] : NULL);
+    }
     return ASX_OK;
 }
 
@@ -378,7 +1273,7 @@ asx_status asx_task_spawn_captured(asx_region_id region,
     asx_task_slot *t;
     asx_status st;
     void *captured;
-    uint32_t old_capture_used;
+    capture_mark mark;
 
     if (out_id == NULL || out_state == NULL) return ASX_E_INVALID_ARGUMENT;
     if (poll_fn == NULL || state_size == 0u) return ASX_E_INVALID_ARGUMENT;
@@ -387,29 +1282,73 @@ asx_status asx_task_spawn_captured(asx_region_id region,
     if (st != ASX_OK) return st;
     if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
 
-    captured = asx_region_capture_alloc(r, state_size, &old_capture_used);
+    captured = asx_region_capture_alloc(r, state_size, &mark);
     if (captured == NULL) return ASX_E_RESOURCE_EXHAUSTED;
     memset(captured, 0, state_size);
 
     st = asx_task_spawn(region, poll_fn, captured, out_id);
     if (st != ASX_OK) {
-        r->capture_used = old_capture_used;
+        asx_region_capture_rollback(r, &mark);
         return st;
     }
 
     st = asx_task_slot_lookup(*out_id, &t);
     if (st != ASX_OK) {
-        r->capture_used = old_capture_used;
+        asx_region_capture_rollback(r, &mark);
         return st;
     }
 
-    t->captured_state = captured;
-    t->captured_size = state_size;
-    t->captured_dtor = state_dtor;
+    t->cold->captured_state = captured;
+    t->cold->captured_size = state_size;
+    t->cold->captured_dtor = state_dtor;
     *out_state = captured;
     return ASX_OK;
 }
 
+asx_status asx_task_spawn_captured_batch(asx_region_id region, uint32_t n,
+                                         const asx_task_poll_fn *poll_fns,
+                                         uint32_t state_size,
+                                         asx_task_state_dtor_fn state_dtor,
+                                         asx_task_id *out_ids,
+                                         void **out_states)
+{
+    asx_region_slot *r;
+    asx_status st;
+    uint8_t *captured;
+    capture_mark mark;
+    uint32_t stride;
+    uint32_t i;
+
+    if (n == 0u || poll_fns == NULL || out_ids == NULL || out_states == NULL)
+        return ASX_E_INVALID_ARGUMENT;
+    if (state_size == 0u) return ASX_E_INVALID_ARGUMENT;
+
+    st = task_batch_admit(region, n, poll_fns, &r);
+    if (st != ASX_OK) return st;
+
+    /* One bump for every capture, each slice 8-byte aligned */
+    stride = asx_align_up_u32(state_size, 8u);
+    if (stride < state_size || stride > UINT32_MAX / n)
+        return ASX_E_RESOURCE_EXHAUSTED;
+    captured = (uint8_t *)asx_region_capture_alloc(r, stride * n, &mark);
+    if (captured == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+    memset(captured, 0, (size_t)stride * n);
+
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by the batch size n");
+        void *state = captured + (size_t)stride * i;
+        asx_task_cold *cold;
+
+        out_ids[i] = task_spawn_slot(region, r, poll_fns[i], state);
+        cold = asx_task_cold_at(asx_handle_slot(out_ids[i]));
+        cold->captured_state = state;
+        cold->captured_size = state_size;
+        cold->captured_dtor = state_dtor;
+        out_states[i] = state;
+    }
+    return ASX_OK;
+}
+
 asx_status asx_task_get_state(asx_task_id id,
                               asx_task_state *out_state)
 {
@@ -429,6 +1368,7 @@ asx_status asx_task_get_outcome(asx_task_id id,
                                 asx_outcome *out_outcome)
 {
     asx_task_slot *t;
+    asx_region_slot *r;
     asx_status st;
 
     if (out_outcome == NULL) return ASX_E_INVALID_ARGUMENT;
@@ -437,7 +1377,64 @@ asx_status asx_task_get_outcome(asx_task_id id,
     if (st != ASX_OK) return st;
     if (!asx_task_is_terminal(t->state)) return ASX_E_TASK_NOT_COMPLETED;
 
-    *out_outcome = t->outcome;
+    *out_outcome = asx_task_cold_outcome(t->cold);
+    /* A region reclaims all its completed tasks on reaching CLOSED, so
+     * the owning region of an unreclaimed task is still live */
+    if (asx_region_slot_lookup(t->region, &r) == ASX_OK) {
+        task_reclaim(r, asx_handle_slot(id));
+    }
+    return ASX_OK;
+}
+
+asx_status asx_task_profile_get(asx_task_id id, asx_task_profile *out)
+{
+#if ASX_TASK_PROFILE
+    asx_task_slot *t;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+
+    *out = asx_task_profile_at(asx_handle_slot(id))->stats;
+    return ASX_OK;
+#else
+    (void)id;
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    return ASX_E_INVALID_STATE;
+#endif
+}
+
+asx_status asx_task_local_set(asx_task_id id, uint32_t index,
+                              uint64_t value)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    if (index >= ASX_TASK_LOCAL_WORDS) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+
+    t->cold->local[index] = value;
+    return ASX_OK;
+}
+
+asx_status asx_task_local_get(asx_task_id id, uint32_t index,
+                              uint64_t *out)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    if (out == NULL || index >= ASX_TASK_LOCAL_WORDS) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+
+    *out = t->cold->local[index];
     return ASX_OK;
 }
 
@@ -445,27 +1442,115 @@ asx_status asx_task_get_outcome(asx_task_id id,
  * Obligation lifecycle
  * ------------------------------------------------------------------- */
 
-asx_status asx_obligation_slot_lookup(asx_obligation_id id,
-                                       asx_obligation_slot **out)
+/* Return an obligation's lease entry and cancel its timer */
+static void obligation_lease_drop(asx_region_slot *r, asx_obligation_slot *o)
 {
-    uint16_t tag, slot_idx, handle_gen;
+    lease_entry *e = &g_lease[o->lease];
+
+    (void)asx_timer_cancel(asx_timer_wheel_global(), &e->timer);
+    e->next = g_lease_free_head;
+    g_lease_free_head = o->lease;
+    o->lease = ASX_LEASE_NONE;
+    r->leases--;
+    if (r->leases == 0u) r->lease_next = 0;
+}
 
-    *out = NULL;
-    if (!asx_handle_is_valid(id)) return ASX_E_NOT_FOUND;
+/* Drop a resolved obligation from its region's reserved count and
+ * list, hand the outcome to the oneshot cell it sends to, if any, and
+ * put its slot on the free list. It stays alive
+ * with its terminal state, so the old handle still reads that state
+ * until the slot is reused. With ASX_DEBUG_QUARANTINE defined slots
+ * are never reused, as for regions. */
+static void obligation_release(asx_obligation_id id, asx_obligation_slot *o)
+{
+    asx_region_slot *r;
 
-    tag = asx_handle_type_tag(id);
-    if (tag != ASX_TYPE_OBLIGATION) return ASX_E_NOT_FOUND;
+    /* Reserve requires an open region and the region cannot close
+     * while this obligation is RESERVED, so the lookup succeeds */
+    if (asx_region_slot_lookup(o->region, &r) == ASX_OK) {
+        r->obligations_reserved--;
+        if (o->lease != ASX_LEASE_NONE) obligation_lease_drop(r, o);
+        if (o->region_prev != ASX_OBLIGATION_LINK_NONE) {
+            asx_obligation_at(o->region_prev)->region_next = o->region_next;
+        } else {
+            r->obligation_head = o->region_next;
+        }
+        if (o->region_next != ASX_OBLIGATION_LINK_NONE) {
+            asx_obligation_at(o->region_next)->region_prev = o->region_prev;
+        } else {
+            r->obligation_tail = o->region_prev;
+        }
+        o->region_prev = ASX_OBLIGATION_LINK_NONE;
+        o->region_next = ASX_OBLIGATION_LINK_NONE;
+    }
+    asx_snapshot_touch_obligation(asx_handle_slot(id));
+    if (o->link != ASX_ONESHOT_LINK_NONE) {
+        asx_oneshot_resolved(o->link, o->state == ASX_OBLIGATION_COMMITTED);
+        o->link = ASX_ONESHOT_LINK_NONE;
+    }
+#ifndef ASX_DEBUG_QUARANTINE
+    o->link = g_obligation_free_head;
+    g_obligation_free_head = asx_handle_slot(id);
+    g_obligation_free_count++;
+    asx_watermark_note(ASX_RESOURCE_OBLIGATION,
+                       g_obligation_count - g_obligation_free_count);
+#else
+    (void)id; (void)o;
+#endif
+}
 
-    slot_idx = asx_handle_slot(id);
-    if (slot_idx >= ASX_MAX_OBLIGATIONS) return ASX_E_NOT_FOUND;
-    if (!g_obligations[slot_idx].alive) return ASX_E_NOT_FOUND;
+asx_status asx_obligation_slots_ensure(uint32_t count)
+{
+    while (g_obligation_free_count +
+           (g_obligation_capacity - g_obligation_count) < count) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_OBLIGATION_CHUNK_LIMIT growth steps");
+        if (obligation_arena_grow() != ASX_OK) return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    return ASX_OK;
+}
 
-    handle_gen = asx_handle_generation(id);
-    if (handle_gen != g_obligations[slot_idx].generation)
-        return ASX_E_STALE_HANDLE;
+/* Take a slot the caller has ensured is backed and reserve it for
+ * region. */
+static asx_obligation_id obligation_reserve_slot(asx_region_id region,
+                                                 asx_region_slot *r)
+{
+    asx_obligation_slot *o;
+    asx_obligation_id id;
+    uint32_t idx;
+    asx_generation generation = g_handle_epoch;
+
+    if (g_obligation_free_head != ASX_OBLIGATION_LINK_NONE) {
+        /* Reuse a resolved slot; the new generation stales old handles */
+        idx = g_obligation_free_head;
+        o = asx_obligation_at(idx);
+        g_obligation_free_head = o->link;
+        g_obligation_free_count--;
+        generation = asx_generation_next(asx_slot_generation(o->key));
+    } else {
+        idx = g_obligation_count++;
+        o = asx_obligation_at(idx);
+    }
+    obligation_slot_init(o);
+    o->region     = region;
+    o->key        = asx_slot_key(ASX_TYPE_OBLIGATION, generation);
+    r->obligations_reserved++;
+    asx_region_obligation_append(r, idx);
+    asx_snapshot_touch_obligation(idx);
+
+    id = asx_handle_pack(ASX_TYPE_OBLIGATION,
+                         (uint16_t)(1u << (unsigned)ASX_OBLIGATION_RESERVED),
+                         asx_handle_pack_index(generation, idx));
+
+    /* Ghost linearity monitor: track obligation reservation. Unsampled
+     * regions' obligations stay untracked, so resolve is a no-op. */
+    if (asx_ghost_region_sampled(region)) {
+        asx_ghost_obligation_reserved(id);
+    }
 
-    *out = &g_obligations[slot_idx];
-    return ASX_OK;
+    asx_trace_emit(ASX_TRACE_OBLIGATION_RESERVE, id, (uint64_t)region);
+    asx_watermark_note(ASX_RESOURCE_OBLIGATION,
+                       g_obligation_count - g_obligation_free_count);
+    return id;
 }
 
 asx_status asx_obligation_reserve(asx_region_id region,
@@ -473,7 +1558,6 @@ asx_status asx_obligation_reserve(asx_region_id region,
 {
     asx_region_slot *r;
     asx_status st;
-    uint32_t idx;
 
     if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
 
@@ -483,29 +1567,52 @@ asx_status asx_obligation_reserve(asx_region_id region,
 
     /* Only open regions can reserve obligations */
     if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
-
-    if (g_obligation_count >= ASX_MAX_OBLIGATIONS)
+    st = asx_region_quota_admit(r, ASX_RESOURCE_OBLIGATION, 1u);
+    if (st != ASX_OK) return st;
+    st = asx_region_admission(region, r, ASX_RESOURCE_OBLIGATION,
+                              ASX_ADMISSION_OBLIGATION);
+    if (st != ASX_OK) return st;
+    /* Leave the slots behind outstanding claims untouched */
+    if (asx_obligation_slots_ensure(1u + g_obligation_claimed) != ASX_OK)
         return ASX_E_RESOURCE_EXHAUSTED;
 
-    idx = g_obligation_count++;
-    g_obligations[idx].state      = ASX_OBLIGATION_RESERVED;
-    g_obligations[idx].region     = region;
-    g_obligations[idx].generation = 0;
-    g_obligations[idx].alive      = 1;
+    *out_id = obligation_reserve_slot(region, r);
+    return ASX_OK;
+}
 
-    *out_id = asx_handle_pack(ASX_TYPE_OBLIGATION,
-                               (uint16_t)(1u << (unsigned)ASX_OBLIGATION_RESERVED),
-                               asx_handle_pack_index(
-                                   g_obligations[idx].generation,
-                                   (uint16_t)idx));
+asx_status asx_obligation_reserve_claimed(asx_resource_token *token,
+                                          asx_obligation_id *out_id)
+{
+    asx_region_slot *r;
+    asx_status st;
 
-    /* Ghost linearity monitor: track obligation reservation */
-    asx_ghost_obligation_reserved(*out_id);
+    if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_resource_token_spend(token, ASX_RESOURCE_OBLIGATION, &r);
+    if (st != ASX_OK) return st;
 
-    asx_trace_emit(ASX_TRACE_OBLIGATION_RESERVE, *out_id, (uint64_t)region);
+    /* The claim kept a backed slot free */
+    *out_id = obligation_reserve_slot(token->region, r);
     return ASX_OK;
 }
 
+/* Apply a legal transition out of RESERVED: release the slot, close
+ * the ghost linearity record, trace a commit and wake parked tasks. */
+static void obligation_resolve(asx_obligation_id id, asx_obligation_slot *o,
+                               asx_obligation_state to)
+{
+    o->state = to;
+    obligation_release(id, o);
+
+    /* Ghost linearity monitor: track obligation resolution */
+    asx_ghost_obligation_resolved(id);
+
+    if (to == ASX_OBLIGATION_COMMITTED) {
+        asx_trace_emit(ASX_TRACE_OBLIGATION_COMMIT, id, 0);
+    }
+    (void)asx_wake_source(ASX_PARK_OBLIGATION, asx_park_key_obligation(id));
+}
+
 asx_status asx_obligation_commit(asx_obligation_id id)
 {
     asx_obligation_slot *o;
@@ -517,15 +1624,52 @@ asx_status asx_obligation_commit(asx_obligation_id id)
     /* Ghost protocol monitor: validate obligation transition */
     (void)asx_ghost_check_obligation_transition(id, o->state, ASX_OBLIGATION_COMMITTED);
 
-    st = asx_obligation_transition_check(o->state, ASX_OBLIGATION_COMMITTED);
-    if (st != ASX_OK) return st;
+    if (!asx_obligation_transition_legal(o->state, ASX_OBLIGATION_COMMITTED)) {
+        return ASX_E_INVALID_TRANSITION;
+    }
 
-    o->state = ASX_OBLIGATION_COMMITTED;
+    obligation_resolve(id, o, ASX_OBLIGATION_COMMITTED);
+    return ASX_OK;
+}
 
-    /* Ghost linearity monitor: track obligation resolution */
-    asx_ghost_obligation_resolved(id);
+asx_status asx_obligation_commit_many(const asx_obligation_id *ids, uint32_t n)
+{
+    asx_obligation_slot *o;
+    asx_status st;
+    uint32_t i;
 
-    asx_trace_emit(ASX_TRACE_OBLIGATION_COMMIT, id, 0);
+    if (ids == NULL && n != 0u) return ASX_E_INVALID_ARGUMENT;
+
+    /* Validate every handle first, marking each COMMITTED so a
+     * duplicate fails like a double commit; a failure restores the
+     * marked prefix and leaves the batch untouched */
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by caller's batch size n");
+        st = asx_obligation_slot_lookup(ids[i], &o);
+        if (st == ASX_OK &&
+            !asx_obligation_transition_legal(o->state, ASX_OBLIGATION_COMMITTED)) {
+            (void)asx_ghost_check_obligation_transition(ids[i], o->state,
+                                                        ASX_OBLIGATION_COMMITTED);
+            st = ASX_E_INVALID_TRANSITION;
+        }
+        if (st != ASX_OK) {
+            while (i-- > 0u) {
+                ASX_CHECKPOINT_WAIVER("bounded by the validated prefix");
+                asx_obligation_at(asx_handle_slot(ids[i]))->state =
+                    ASX_OBLIGATION_RESERVED;
+            }
+            return st;
+        }
+        o->state = ASX_OBLIGATION_COMMITTED;
+    }
+
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by caller's batch size n");
+        o = asx_obligation_at(asx_handle_slot(ids[i]));
+        (void)asx_ghost_check_obligation_transition(ids[i], ASX_OBLIGATION_RESERVED,
+                                                    ASX_OBLIGATION_COMMITTED);
+        obligation_resolve(ids[i], o, ASX_OBLIGATION_COMMITTED);
+    }
     return ASX_OK;
 }
 
@@ -540,14 +1684,44 @@ asx_status asx_obligation_abort(asx_obligation_id id)
     /* Ghost protocol monitor: validate obligation transition */
     (void)asx_ghost_check_obligation_transition(id, o->state, ASX_OBLIGATION_ABORTED);
 
-    st = asx_obligation_transition_check(o->state, ASX_OBLIGATION_ABORTED);
-    if (st != ASX_OK) return st;
+    if (!asx_obligation_transition_legal(o->state, ASX_OBLIGATION_ABORTED)) {
+        return ASX_E_INVALID_TRANSITION;
+    }
 
-    o->state = ASX_OBLIGATION_ABORTED;
+    obligation_resolve(id, o, ASX_OBLIGATION_ABORTED);
+    return ASX_OK;
+}
 
-    /* Ghost linearity monitor: track obligation resolution */
-    asx_ghost_obligation_resolved(id);
+asx_status asx_region_abort_obligations(asx_region_id region,
+                                        uint32_t *out_aborted)
+{
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t idx;
+    uint32_t aborted = 0;
 
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+
+    /* Every obligation on the list is RESERVED; resolve unlinks it,
+     * so the next link is read first */
+    idx = r->obligation_head;
+    while (idx != ASX_OBLIGATION_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by the region's reserved obligations");
+        asx_obligation_slot *o = asx_obligation_at(idx);
+        uint32_t next = o->region_next;
+        asx_obligation_id id = asx_handle_pack(
+            ASX_TYPE_OBLIGATION,
+            (uint16_t)(1u << (unsigned)ASX_OBLIGATION_RESERVED),
+            asx_handle_pack_index(asx_slot_generation(o->key), idx));
+
+        (void)asx_ghost_check_obligation_transition(id, o->state, ASX_OBLIGATION_ABORTED);
+        obligation_resolve(id, o, ASX_OBLIGATION_ABORTED);
+        aborted++;
+        idx = next;
+    }
+
+    if (out_aborted != NULL) *out_aborted = aborted;
     return ASX_OK;
 }
 
@@ -565,3 +1739,109 @@ asx_status asx_obligation_get_state(asx_obligation_id id,
     *out_state = o->state;
     return ASX_OK;
 }
+
+asx_status asx_obligation_set_lease(asx_obligation_id id, asx_time deadline)
+{
+    asx_obligation_slot *o;
+    asx_region_slot *r;
+    asx_timer_handle h;
+    uint32_t idx;
+    asx_status st;
+
+    st = asx_obligation_slot_lookup(id, &o);
+    if (st != ASX_OK) return st;
+    if (o->state != ASX_OBLIGATION_RESERVED) return ASX_E_INVALID_STATE;
+    st = asx_region_slot_lookup(o->region, &r);
+    if (st != ASX_OK) return st;
+
+    if (deadline == 0) {
+        if (o->lease != ASX_LEASE_NONE) obligation_lease_drop(r, o);
+        return ASX_OK;
+    }
+    if (o->lease == ASX_LEASE_NONE && g_lease_free_head == ASX_LEASE_NONE &&
+        g_lease_count >= LEASE_SLOTS) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+
+    /* Register first so a failure leaves the old lease in force */
+    st = asx_timer_register(asx_timer_wheel_global(), deadline, NULL, &h);
+    if (st != ASX_OK) return st;
+    if (o->lease != ASX_LEASE_NONE) {
+        idx = o->lease;
+        (void)asx_timer_cancel(asx_timer_wheel_global(), &g_lease[idx].timer);
+    } else if (g_lease_free_head != ASX_LEASE_NONE) {
+        idx = g_lease_free_head;
+        g_lease_free_head = g_lease[idx].next;
+        r->leases++;
+    } else {
+        idx = g_lease_count++;
+        r->leases++;
+    }
+    g_lease[idx].deadline = deadline;
+    g_lease[idx].timer = h;
+    g_lease[idx].next = ASX_LEASE_NONE;
+    o->lease = idx;
+    if (r->lease_next == 0 || deadline < r->lease_next) {
+        r->lease_next = deadline;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_obligation_reserve_leased(asx_region_id region,
+                                         asx_time deadline,
+                                         asx_obligation_id *out_id)
+{
+    asx_obligation_id id;
+    asx_status st;
+
+    st = asx_obligation_reserve(region, &id);
+    if (st != ASX_OK) return st;
+    st = asx_obligation_set_lease(id, deadline);
+    if (st != ASX_OK) {
+        asx_status undo = asx_obligation_abort(id);
+        (void)undo;
+        return st;
+    }
+    *out_id = id;
+    return ASX_OK;
+}
+
+void asx_region_lease_poll(uint32_t region_idx)
+{
+    asx_region_slot *r = asx_region_at(region_idx);
+    asx_time now;
+    asx_time next = 0;
+    uint32_t idx;
+
+    if (r->leases == 0u) return;
+    if (asx_runtime_coarse_now_ns(&now) != ASX_OK) return;
+    if (now < r->lease_next) return;
+
+    /* Resolve unlinks, so the next link is read first */
+    idx = r->obligation_head;
+    while (idx != ASX_OBLIGATION_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by the region's reserved obligations");
+        asx_obligation_slot *o = asx_obligation_at(idx);
+        uint32_t link = o->region_next;
+
+        if (o->lease != ASX_LEASE_NONE) {
+            asx_time deadline = g_lease[o->lease].deadline;
+
+            if (deadline <= now) {
+                asx_obligation_id id = asx_handle_pack(
+                    ASX_TYPE_OBLIGATION,
+                    (uint16_t)(1u << (unsigned)ASX_OBLIGATION_RESERVED),
+                    asx_handle_pack_index(asx_slot_generation(o->key), idx));
+
+                (void)asx_ghost_check_obligation_transition(
+                    id, o->state, ASX_OBLIGATION_ABORTED);
+                asx_trace_emit(ASX_TRACE_OBLIGATION_ABORT, id, deadline);
+                obligation_resolve(id, o, ASX_OBLIGATION_ABORTED);
+            } else if (next == 0 || deadline < next) {
+                next = deadline;
+            }
+        }
+        idx = link;
+    }
+    r->lease_next = next;
+}
@@ -0,0 +1,198 @@
+/*
+ * loadgen.c — open-loop load generator
+ *
+ * Exponential gaps come from inverse-CDF sampling, -ln(U) scaled by
+ * the mean gap, with ln computed in Q16 fixed point from a 53-bit
+ * uniform draw: the integer part of log2 from the bit length, sixteen
+ * fractional bits by repeated squaring of the normalized mantissa.
+ * On/off bursts run the Poisson clock only while on and map its
+ * offsets onto on+off periods, so each burst keeps the full rate.
+ *
+ * Single-threaded; each worker driving load owns its own generator.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/runtime/loadgen.h>
+#include <string.h>
+
+/* ASX_CHECKPOINT_WAIVER_FILE("loadgen: loops bounded by the 64-bit width, 16 fraction bits, the trace length or the pump's max") */
+
+#define LOADGEN_NS_PER_SEC UINT64_C(1000000000)
+#define LOADGEN_LN2_Q16    UINT64_C(45426)   /* ln 2 * 2^16 */
+#define LOADGEN_UNIFORM_BITS 53u
+
+static uint32_t loadgen_bit_length(uint64_t x)
+{
+    uint32_t n = 0;
+
+    while (x != 0u) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+
+/* -ln(U) in Q16 for U uniform in (0, 1]. */
+static uint64_t loadgen_neg_ln_q16(asx_prng *prng)
+{
+    uint64_t x = (asx_prng_next(prng) >> (64u - LOADGEN_UNIFORM_BITS)) + 1u;
+    uint32_t k = loadgen_bit_length(x) - 1u;   /* floor(log2 x) */
+    uint64_t m;                                 /* mantissa, Q30 in [1, 2) */
+    uint64_t frac = 0;
+    uint64_t log2_q16;
+    uint32_t i;
+
+    m = k >= 30u ? x >> (k - 30u) : x << (30u - k);
+    for (i = 0; i < 16u; i++) {
+        m = (m * m) >> 30;
+        frac <<= 1;
+        if (m >= (UINT64_C(1) << 31)) {
+            m >>= 1;
+            frac |= 1u;
+        }
+    }
+    log2_q16 = ((uint64_t)k << 16) | frac;
+    return ((((uint64_t)LOADGEN_UNIFORM_BITS << 16) - log2_q16) *
+            LOADGEN_LN2_Q16) >> 16;
+}
+
+/* (a * b) >> 32 for b < 2^32 without a 128-bit product. */
+static uint64_t loadgen_mul_q32(uint64_t a, uint64_t b)
+{
+    return (a >> 32) * b + (((a & UINT64_C(0xFFFFFFFF)) * b) >> 32);
+}
+
+/* Place the arrival numbered gen->issued, or mark the schedule done. */
+static void loadgen_schedule(asx_loadgen *gen)
+{
+    const asx_loadgen_config *cfg = &gen->cfg;
+    uint64_t offset;
+
+    if (cfg->limit != 0u && gen->issued >= cfg->limit) {
+        gen->done = 1;
+    }
+    switch (cfg->kind) {
+    case ASX_LOADGEN_TRACE:
+        if (gen->issued >= cfg->trace_count) {
+            gen->done = 1;
+        }
+        if (gen->done) return;
+        gen->next_ns = gen->start_ns + cfg->trace_ns[gen->issued];
+        return;
+    case ASX_LOADGEN_POISSON:
+    case ASX_LOADGEN_ON_OFF:
+        break;
+    default:
+        gen->done = 1;
+        return;
+    }
+    if (gen->done) return;
+
+    gen->offset_ns += loadgen_mul_q32(gen->mean_gap_q16,
+                                      loadgen_neg_ln_q16(&gen->prng));
+    offset = gen->offset_ns;
+    if (cfg->kind == ASX_LOADGEN_ON_OFF) {
+        offset = (offset / cfg->on_ns) * (cfg->on_ns + cfg->off_ns) +
+                 offset % cfg->on_ns;
+    }
+    gen->next_ns = gen->start_ns + offset;
+}
+
+asx_status asx_loadgen_init(asx_loadgen *gen, const asx_loadgen_config *cfg,
+                            uint64_t start_ns)
+{
+    uint32_t i;
+
+    if (gen == NULL || cfg == NULL) return ASX_E_INVALID_ARGUMENT;
+    switch (cfg->kind) {
+    case ASX_LOADGEN_ON_OFF:
+        if (cfg->on_ns == 0u) return ASX_E_INVALID_ARGUMENT;
+        /* fall through */
+    case ASX_LOADGEN_POISSON:
+        if (cfg->rate_per_sec == 0u) return ASX_E_INVALID_ARGUMENT;
+        break;
+    case ASX_LOADGEN_TRACE:
+        if (cfg->trace_ns == NULL && cfg->trace_count != 0u)
+            return ASX_E_INVALID_ARGUMENT;
+        for (i = 1; i < cfg->trace_count; i++) {
+            if (cfg->trace_ns[i] < cfg->trace_ns[i - 1u])
+                return ASX_E_INVALID_ARGUMENT;
+        }
+        break;
+    default:
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    memset(gen, 0, sizeof(*gen));
+    gen->cfg = *cfg;
+    gen->start_ns = start_ns;
+    asx_prng_seed(&gen->prng, cfg->seed);
+    if (cfg->kind != ASX_LOADGEN_TRACE) {
+        gen->mean_gap_q16 = (LOADGEN_NS_PER_SEC << 16) / cfg->rate_per_sec;
+    }
+    asx_hft_hdr_init_default(&gen->latency);
+    asx_hft_hdr_init_default(&gen->service);
+    loadgen_schedule(gen);
+    return ASX_OK;
+}
+
+asx_status asx_loadgen_pump(asx_loadgen *gen, uint64_t now_ns, uint32_t max,
+                            asx_loadgen_action_fn action, void *ctx,
+                            uint32_t *out_issued)
+{
+    asx_loadgen_arrival arrival;
+    uint32_t n = 0;
+
+    if (out_issued != NULL) *out_issued = 0;
+    if (gen == NULL || action == NULL || max == 0u) return ASX_E_INVALID_ARGUMENT;
+
+    while (n < max && !gen->done && gen->next_ns <= now_ns) {
+        arrival.seq = gen->issued;
+        arrival.intended_ns = gen->next_ns;
+        arrival.issued_ns = now_ns;
+        if (now_ns - gen->next_ns > gen->max_lag_ns) {
+            gen->max_lag_ns = now_ns - gen->next_ns;
+        }
+        if (action(ctx, &arrival) != ASX_OK) {
+            gen->rejected++;
+        }
+        gen->issued++;
+        n++;
+        loadgen_schedule(gen);
+    }
+    if (out_issued != NULL) *out_issued = n;
+    return ASX_OK;
+}
+
+void asx_loadgen_complete(asx_loadgen *gen, const asx_loadgen_arrival *arrival,
+                          uint64_t done_ns)
+{
+    if (gen == NULL || arrival == NULL) return;
+    asx_hft_hdr_record(&gen->latency, done_ns > arrival->intended_ns
+                                      ? done_ns - arrival->intended_ns : 0u);
+    asx_hft_hdr_record(&gen->service, done_ns > arrival->issued_ns
+                                      ? done_ns - arrival->issued_ns : 0u);
+    gen->completed++;
+}
+
+uint64_t asx_loadgen_next_ns(const asx_loadgen *gen)
+{
+    if (gen == NULL || gen->done) return UINT64_MAX;
+    return gen->next_ns;
+}
+
+int asx_loadgen_done(const asx_loadgen *gen)
+{
+    return gen == NULL || gen->done;
+}
+
+const char *asx_loadgen_kind_str(asx_loadgen_kind kind)
+{
+    switch (kind) {
+    case ASX_LOADGEN_POISSON: return "poisson";
+    case ASX_LOADGEN_ON_OFF:  return "on_off";
+    case ASX_LOADGEN_TRACE:   return "trace";
+    default:                  return "unknown";
+    }
+}
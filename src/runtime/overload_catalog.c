@@ -162,6 +162,33 @@ asx_status asx_overload_catalog_to_policy(asx_profile_id id,
     return ASX_OK;
 }
 
+asx_status asx_overload_catalog_to_watermark(asx_profile_id id,
+                                             uint32_t capacity,
+                                             asx_resource_watermark *out)
+{
+    uint32_t pct;
+    uint32_t lead;
+    uint32_t high;
+
+    if (!out || capacity < 2u) return ASX_E_INVALID_ARGUMENT;
+    if ((int)id < 0 || (int)id >= ASX_PROFILE_ID_COUNT) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    pct = g_catalog[(int)id].threshold_pct;
+    pct = pct > ASX_CATALOG_WATERMARK_LEAD_PCT
+        ? pct - ASX_CATALOG_WATERMARK_LEAD_PCT : 0u;
+    lead = (uint32_t)(((uint64_t)capacity * ASX_CATALOG_WATERMARK_LEAD_PCT) / 100u);
+    if (lead == 0u) lead = 1u;
+
+    high = (uint32_t)(((uint64_t)capacity * pct) / 100u);
+    if (high == 0u) high = 1u;
+    out->high = high;
+    out->low = high > lead ? high - lead : 0u;
+    out->fn = NULL;
+    out->ctx = NULL;
+    return ASX_OK;
+}
+
 /* -------------------------------------------------------------------
  * Structural validation
  * ------------------------------------------------------------------- */
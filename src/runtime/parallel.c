@@ -2,9 +2,27 @@
  * parallel.c — optional parallel profile worker model and lane scheduler
  *
  * Implements lane-based task scheduling with bounded fairness controls.
- * Walking skeleton: single-threaded simulation. Tasks are classified
- * into READY, CANCEL, and TIMED lanes. The scheduler polls lanes
- * according to the configured fairness policy.
+ * Tasks are classified into READY, CANCEL, and TIMED lanes. The
+ * scheduler polls lanes according to the configured fairness policy,
+ * either inline or, with >1 worker and a thread hook, as per-round
+ * batches spread across OS worker threads.
+ *
+ * The TIMED lane holds tasks parked on a timer (waker.h). They are
+ * never polled and get no quota; at the start of each round, tasks the
+ * timer wheel has woken move to the READY (or CANCEL) lane.
+ *
+ * The inputs to a round's quotas (pollable lanes, their total weight)
+ * and the starved-lane count are kept up to date as tasks join and
+ * leave lanes, so neither quotas nor starvation queries walk the lanes.
+ * WEIGHTED quotas are deficit round robin: the fraction of a poll a
+ * lane's share does not cover carries to its next quota.
+ *
+ * Lane membership itself persists between runs over the same regions.
+ * Spawn, cancel, park, wake and completion move the task through
+ * asx_parallel_lane_sync, so a run only classifies a region's tasks
+ * when the set of regions differs from the previous run's.
+ * Tasks a full lane (ASX_LANE_TASK_CAPACITY) turns away wait outside
+ * the lanes and are offered a place again at each round boundary.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -12,10 +30,12 @@
 #include <asx/runtime/parallel.h>
 #include <asx/runtime/runtime.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/waker.h>
 #include <asx/asx_config.h>
 #include <asx/core/transition.h>
 #include <asx/core/cancel.h>
 #include "runtime_internal.h"
+#include "context_internal.h"
 #include <string.h>
 
 /* -------------------------------------------------------------------
@@ -27,8 +47,28 @@ typedef struct {
     uint32_t     count;
     uint32_t     polls_this_round;
     uint32_t     starvation_count;
+    /* WEIGHTED: share carried from earlier quotas, in units of
+     * 1/g_lane_totals.weight polls */
+    uint64_t     deficit;
 } lane_internal;
 
+/* Lane aggregates maintained on every membership or starvation change */
+typedef struct {
+    uint32_t     pollable;  /* non-TIMED lanes holding tasks */
+    uint32_t     weight;    /* sum of their lane_weights */
+    uint32_t     starved;   /* lanes holding tasks past starvation_limit */
+} lane_totals;
+
+/* Regions whose tasks the lanes hold, by slot, in the order the run
+ * that classified them listed them; count 0 until a run classifies. */
+typedef struct {
+    uint32_t     count;
+    uint32_t     slot[ASX_PARALLEL_REGION_MAX];
+    uint32_t     cancel_deferred;  /* READY tasks cancelled mid-run */
+    uint32_t     overflow;         /* tasks a full lane turned away */
+    int          running;
+} lane_scope;
+
 /* -------------------------------------------------------------------
  * Global parallel scheduler state
  * ------------------------------------------------------------------- */
@@ -36,8 +76,22 @@ typedef struct {
 static int               g_initialized;
 static asx_parallel_config g_config;
 static lane_internal     g_lanes[ASX_MAX_LANES];
+static lane_totals       g_lane_totals;
+static lane_scope        g_lane_scope;
 static asx_worker_state  g_workers[ASX_MAX_WORKERS];
 
+/* The run set and batch below are rebuilt by every run and stay out */
+static const asx_context_block g_parallel_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_initialized),
+    ASX_CONTEXT_BLOCK(g_config),
+    ASX_CONTEXT_BLOCK(g_lanes),
+    ASX_CONTEXT_BLOCK(g_lane_totals),
+    ASX_CONTEXT_BLOCK(g_lane_scope),
+    ASX_CONTEXT_BLOCK(g_workers)
+};
+
+const asx_context_module asx_parallel_context = ASX_CONTEXT_MODULE(g_parallel_blocks);
+
 /* -------------------------------------------------------------------
  * Init / Reset
  * ------------------------------------------------------------------- */
@@ -57,14 +111,22 @@ asx_status asx_parallel_init(const asx_parallel_config *cfg)
     for (i = 0; i < ASX_MAX_LANES; i++) {
         memset(&g_lanes[i], 0, sizeof(lane_internal));
     }
+    memset(&g_lane_totals, 0, sizeof(g_lane_totals));
+    memset(&g_lane_scope, 0, sizeof(g_lane_scope));
 
     /* Initialize workers */
     for (i = 0; i < cfg->worker_count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS checked above") */
         g_workers[i].id = i;
-        g_workers[i].domain = ASX_AFFINITY_DOMAIN_ANY;
+        g_workers[i].domain = cfg->worker_cpus[i] != 0u
+                            ? (asx_affinity_domain)(i + 1u)
+                            : ASX_AFFINITY_DOMAIN_ANY;
+        g_workers[i].cpu_mask = cfg->worker_cpus[i];
+        g_workers[i].pinned = 0;
+        g_workers[i].involuntary_switches = 0;
         g_workers[i].active = 1;
         g_workers[i].polls_total = 0;
         g_workers[i].tasks_completed = 0;
+        g_workers[i].steals_total = 0;
     }
 
     g_initialized = 1;
@@ -74,6 +136,8 @@ asx_status asx_parallel_init(const asx_parallel_config *cfg)
 void asx_parallel_reset(void)
 {
     memset(g_lanes, 0, sizeof(g_lanes));
+    memset(&g_lane_totals, 0, sizeof(g_lane_totals));
+    memset(&g_lane_scope, 0, sizeof(g_lane_scope));
     memset(g_workers, 0, sizeof(g_workers));
     memset(&g_config, 0, sizeof(g_config));
     g_initialized = 0;
@@ -83,9 +147,66 @@ void asx_parallel_reset(void)
  * Lane management
  * ------------------------------------------------------------------- */
 
+/* A lane competes for budget only if it holds pollable tasks; the
+ * TIMED lane holds parked timer waiters and never does. */
+static int lane_pollable(uint32_t i)
+{
+    return i != (uint32_t)ASX_LANE_TIMED && g_lanes[i].count > 0;
+}
+
+static int lane_starved(uint32_t i)
+{
+    return g_lanes[i].count > 0 &&
+           g_lanes[i].starvation_count > g_config.starvation_limit;
+}
+
+/* Fold lane i's change into g_lane_totals, given its flags before.
+ * A lane leaving the pollable set drops its carried share, as a
+ * deficit round robin queue does on emptying. */
+static void lane_totals_update(uint32_t i, int was_pollable, int was_starved)
+{
+    int pollable = lane_pollable(i);
+    int starved = lane_starved(i);
+
+    if (starved != was_starved) {
+        if (starved) g_lane_totals.starved++;
+        else g_lane_totals.starved--;
+    }
+    if (pollable == was_pollable) return;
+    if (pollable) {
+        g_lane_totals.pollable++;
+        g_lane_totals.weight += g_config.lane_weights[i];
+    } else {
+        g_lane_totals.pollable--;
+        g_lane_totals.weight -= g_config.lane_weights[i];
+        g_lanes[i].deficit = 0;
+    }
+}
+
+/* Cold state of the live task tid names, or NULL. Lanes accept any
+ * task id, so only ids that resolve carry a lane tag. */
+static asx_task_cold *lane_task_cold(asx_task_id tid)
+{
+    asx_task_slot *t;
+
+    if (asx_task_slot_lookup(tid, &t) != ASX_OK) return NULL;
+    return t->cold;
+}
+
+/* Set lane i's starvation count, keeping the starved total */
+static void lane_set_starvation(uint32_t i, uint32_t count)
+{
+    int was_starved = lane_starved(i);
+
+    g_lanes[i].starvation_count = count;
+    lane_totals_update(i, lane_pollable(i), was_starved);
+}
+
 asx_status asx_lane_assign(asx_task_id tid, asx_lane_class lane)
 {
     lane_internal *l;
+    asx_task_cold *cold;
+    int was_pollable, was_starved;
 
     if ((int)lane < 0 || (int)lane >= (int)ASX_MAX_LANES) {
         return ASX_E_INVALID_ARGUMENT;
@@ -96,11 +217,33 @@ asx_status asx_lane_assign(asx_task_id tid, asx_lane_class lane)
         return ASX_E_RESOURCE_EXHAUSTED;
     }
 
+    was_pollable = lane_pollable((uint32_t)lane);
+    was_starved = lane_starved((uint32_t)lane);
     l->tasks[l->count] = tid;
     l->count++;
+    lane_totals_update((uint32_t)lane, was_pollable, was_starved);
+    cold = lane_task_cold(tid);
+    if (cold != NULL) cold->lane = (uint8_t)((uint32_t)lane + 1u);
     return ASX_OK;
 }
 
+/* Remove the task at position j, shifting the rest down */
+static void lane_remove_at(lane_internal *l, uint32_t j)
+{
+    uint32_t i = (uint32_t)(l - g_lanes);
+    int was_pollable = lane_pollable(i);
+    int was_starved = lane_starved(i);
+    asx_task_cold *cold = lane_task_cold(l->tasks[j]);
+    uint32_t k;
+
+    if (cold != NULL && cold->lane == i + 1u) cold->lane = 0;
+    for (k = j; k + 1 < l->count; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_LANE_TASK_CAPACITY") */
+        l->tasks[k] = l->tasks[k + 1];
+    }
+    l->count--;
+    lane_totals_update(i, was_pollable, was_starved);
+}
+
 asx_status asx_lane_remove(asx_task_id tid)
 {
     uint32_t i, j;
@@ -109,12 +252,7 @@ asx_status asx_lane_remove(asx_task_id tid)
         lane_internal *l = &g_lanes[i];
         for (j = 0; j < l->count; j++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_LANE_TASK_CAPACITY") */
             if (l->tasks[j] == tid) {
-                /* Shift remaining tasks down */
-                uint32_t k;
-                for (k = j; k + 1 < l->count; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_LANE_TASK_CAPACITY") */
-                    l->tasks[k] = l->tasks[k + 1];
-                }
-                l->count--;
+                lane_remove_at(l, j);
                 return ASX_OK;
             }
         }
@@ -186,32 +324,28 @@ static void compute_lane_quotas(uint32_t total_budget,
 
     switch (g_config.fairness) {
     case ASX_FAIRNESS_ROUND_ROBIN: {
-        uint32_t active_lanes = 0;
-        uint32_t per_lane;
-        for (i = 0; i < ASX_MAX_LANES; i++) {
-            if (g_lanes[i].count > 0) active_lanes++;
-        }
-        per_lane = (active_lanes > 0) ? total_budget / active_lanes : 0;
+        uint32_t per_lane = g_lane_totals.pollable > 0
+                          ? total_budget / g_lane_totals.pollable : 0;
         for (i = 0; i < ASX_MAX_LANES; i++) {
-            quotas[i] = (g_lanes[i].count > 0) ? per_lane : 0;
+            quotas[i] = lane_pollable(i) ? per_lane : 0;
         }
         break;
     }
 
     case ASX_FAIRNESS_WEIGHTED: {
-        uint32_t total_weight = 0;
+        /* Each lane's exact share is total_budget * weight / W polls;
+         * the quota is its whole part and the remainder carries, so
+         * over rounds every lane's polls track its weight exactly */
+        uint64_t w = g_lane_totals.weight;
         for (i = 0; i < ASX_MAX_LANES; i++) {
-            if (g_lanes[i].count > 0) {
-                total_weight += g_config.lane_weights[i];
-            }
-        }
-        for (i = 0; i < ASX_MAX_LANES; i++) {
-            if (g_lanes[i].count > 0 && total_weight > 0) {
-                quotas[i] = (total_budget * g_config.lane_weights[i])
-                            / total_weight;
-            } else {
-                quotas[i] = 0;
-            }
+            lane_internal *l = &g_lanes[i];
+            uint64_t share;
+
+            quotas[i] = 0;
+            if (!lane_pollable(i) || w == 0) continue;
+            share = l->deficit + (uint64_t)total_budget * g_config.lane_weights[i];
+            quotas[i] = (uint32_t)(share / w);
+            l->deficit = share - (uint64_t)quotas[i] * w;
         }
         break;
     }
@@ -220,7 +354,18 @@ static void compute_lane_quotas(uint32_t total_budget,
         /* Cancel lane gets full budget first, then ready, then timed */
         quotas[ASX_LANE_CANCEL] = total_budget;
         quotas[ASX_LANE_READY]  = total_budget;
-        quotas[ASX_LANE_TIMED]  = total_budget;
+        quotas[ASX_LANE_TIMED]  = 0;
+        break;
+
+    case ASX_FAIRNESS_CANCEL_STRICT:
+        /* Cancel lane first, up to its cap; ready gets what is left */
+        quotas[ASX_LANE_CANCEL] = total_budget;
+        if (g_config.cancel_round_cap != 0 &&
+            g_config.cancel_round_cap < total_budget) {
+            quotas[ASX_LANE_CANCEL] = g_config.cancel_round_cap;
+        }
+        quotas[ASX_LANE_READY]  = total_budget;
+        quotas[ASX_LANE_TIMED]  = 0;
         break;
 
     default:
@@ -231,6 +376,28 @@ static void compute_lane_quotas(uint32_t total_budget,
     }
 }
 
+/* WEIGHTED: settle the round's quotas. A lane the budget cut off
+ * keeps the polls it was owed; one that ran out of tasks forfeits
+ * them and its carry, as a deficit round robin queue does on
+ * emptying. */
+static void settle_lane_deficits(const uint32_t quotas[ASX_MAX_LANES],
+                                 const uint32_t polled[ASX_MAX_LANES],
+                                 int budget_hit)
+{
+    uint32_t i;
+
+    if (g_config.fairness != ASX_FAIRNESS_WEIGHTED) return;
+    for (i = 0; i < ASX_MAX_LANES; i++) {
+        if (!lane_pollable(i) || polled[i] >= quotas[i]) continue;
+        if (budget_hit) {
+            g_lanes[i].deficit += (uint64_t)(quotas[i] - polled[i]) *
+                                  g_lane_totals.weight;
+        } else {
+            g_lanes[i].deficit = 0;
+        }
+    }
+}
+
 /* Priority-ordered lane indices for scheduling */
 static const int g_priority_order[ASX_MAX_LANES] = {
     ASX_LANE_CANCEL,  /* cancel tasks drain first */
@@ -245,10 +412,120 @@ static void lane_remove_internal(asx_task_id tid)
     (void)st_;
 }
 
+/* A full lane turns the task away; it stays outside the lanes
+ * (cold->lane 0) until parallel_retry_overflow finds it room. */
 static void lane_assign_internal(asx_task_id tid, asx_lane_class lc)
 {
-    asx_status st_ = asx_lane_assign(tid, lc);
-    (void)st_;
+    if (asx_lane_assign(tid, lc) != ASX_OK) g_lane_scope.overflow++;
+}
+
+/* Number of tasks the next round could poll */
+static uint32_t lane_runnable_tasks(void)
+{
+    return g_lanes[ASX_LANE_READY].count + g_lanes[ASX_LANE_CANCEL].count;
+}
+
+/* Move TIMED-lane tasks that are no longer parked (timer fired, timer
+ * cancelled, or task cancelled) to the lane they now belong to. Tasks
+ * still waiting stay put at no poll cost. */
+static void parallel_promote_timed(void)
+{
+    lane_internal *timed = &g_lanes[ASX_LANE_TIMED];
+    uint32_t j = 0;
+
+    while (j < timed->count) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_LANE_TASK_CAPACITY");
+        asx_task_id tid = timed->tasks[j];
+        uint32_t slot_idx = asx_handle_slot(tid);
+        asx_task_slot *t = NULL;
+
+        if (slot_idx < g_task_capacity) t = asx_task_at(slot_idx);
+        if (t != NULL && asx_slot_live(t->key) && !asx_task_is_terminal(t->state) &&
+            t->parked) {
+            j++;
+            continue;
+        }
+
+        lane_remove_at(timed, j);
+        if (t != NULL && asx_slot_live(t->key) && !asx_task_is_terminal(t->state)) {
+            lane_assign_internal(tid, t->cancel_pending ? ASX_LANE_CANCEL
+                                                        : ASX_LANE_READY);
+        }
+    }
+}
+
+/* Move READY-lane tasks cancelled during a run to the CANCEL lane,
+ * keeping their relative order. CANCEL_STRICT does so at every round
+ * boundary, so they are serviced ahead of ready work from the next
+ * round on; other policies wait for the next run. */
+static void parallel_promote_cancelled(void)
+{
+    lane_internal *ready = &g_lanes[ASX_LANE_READY];
+    uint32_t j = 0;
+
+    if (g_lane_scope.cancel_deferred == 0) return;
+    g_lane_scope.cancel_deferred = 0;
+    while (j < ready->count) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_LANE_TASK_CAPACITY");
+        asx_task_id tid = ready->tasks[j];
+        uint32_t slot_idx = asx_handle_slot(tid);
+
+        if (slot_idx < g_task_capacity && asx_slot_live(asx_task_at(slot_idx)->key) &&
+            asx_task_at(slot_idx)->cancel_pending) {
+            lane_remove_at(ready, j);
+            lane_assign_internal(tid, ASX_LANE_CANCEL);
+            continue;
+        }
+        j++;
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Regions of the current run
+ *
+ * asx_parallel_run covers one region; asx_parallel_run_regions covers
+ * several that share the lanes and the budget. A run over a new region
+ * set classifies the tasks of every covered region in region order;
+ * from then on tasks join and leave lanes in event order, which
+ * selection and the trace follow. Each region is pinned to one worker
+ * for the whole run.
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t         count;
+    int              pinned;  /* threaded polls go to the region's worker */
+    asx_region_id    id[ASX_PARALLEL_REGION_MAX];
+    asx_region_slot *rslot[ASX_PARALLEL_REGION_MAX];
+    uint32_t         slot[ASX_PARALLEL_REGION_MAX];
+    uint8_t          worker[ASX_PARALLEL_REGION_MAX];
+} parallel_run_set;
+
+static parallel_run_set g_run;
+
+/* Index in g_run of the region owning t. Region handles carry a state
+ * mask, so regions are matched by slot. */
+static uint32_t parallel_region_of(const asx_task_slot *t)
+{
+    uint32_t slot = asx_handle_slot(t->region);
+    uint32_t i;
+
+    for (i = 1; i < g_run.count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+        if (g_run.slot[i] == slot) return i;
+    }
+    return 0;
+}
+
+/* Worker a region runs on: the affinity domain it is bound to, domain
+ * d mapping to worker (d - 1) mod worker_count, else its position. */
+static uint8_t parallel_region_worker(asx_region_id region, uint32_t pos)
+{
+    asx_affinity_domain d = ASX_AFFINITY_DOMAIN_ANY;
+
+    if (asx_affinity_get_domain((uint64_t)region, &d) == ASX_OK &&
+        d != ASX_AFFINITY_DOMAIN_ANY && d != ASX_AFFINITY_DOMAIN_NONE) {
+        return (uint8_t)((d - 1u) % g_config.worker_count);
+    }
+    return (uint8_t)(pos % g_config.worker_count);
 }
 
 static asx_status parallel_return_budget(uint32_t round)
@@ -259,10 +536,362 @@ static asx_status parallel_return_budget(uint32_t round)
 
 static asx_status parallel_return_quiescent(uint32_t round)
 {
+    uint32_t i;
+
+    /* Lanes drained but tasks remain: all parked, idle until woken.
+     * A wake puts the task back in its lane for the next run. */
+    for (i = 0; i < g_run.count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+        if (g_run.rslot[i]->task_count > 0) return ASX_E_PENDING;
+    }
     asx_trace_emit(ASX_TRACE_SCHED_QUIESCENT, ASX_INVALID_ID, round);
     return ASX_OK;
 }
 
+/* -------------------------------------------------------------------
+ * Threaded poll batches
+ *
+ * In threaded mode a round first selects tasks from the lanes on the
+ * calling thread (lane priority order), then polls the whole batch on
+ * the worker threads, then applies results on the calling thread in
+ * selection order. Lane quotas are spent during selection, so the
+ * fairness policy holds at lane level however the polls are spread.
+ *
+ * Each worker owns a Chase-Lev work-stealing deque over a contiguous
+ * block of the batch. The block is the deque's storage: entries are
+ * batch indices in [top, bottom), the owner pops from the bottom and
+ * an idle worker steals from the top of the next busy worker. Nothing
+ * is pushed during a dispatch, so a deque seen empty stays empty and
+ * one pass over the victims finds all remaining work. Without compiler
+ * atomics, workers only drain their own block.
+ *
+ * Trace events a poll emits on a worker are staged in that worker's
+ * buffer (trace.c) and merged right after the poll's SCHED_POLL event
+ * when results are applied, reproducing the serial trace.
+ *
+ * A multi-region run is pinned instead: each entry carries its
+ * region's worker, every worker polls only its own entries, and
+ * nothing is stolen, so a region's polls never overlap each other.
+ * ------------------------------------------------------------------- */
+
+#define ASX_PARALLEL_BATCH_MAX (ASX_MAX_LANES * ASX_LANE_TASK_CAPACITY)
+
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define ASX_PARALLEL_STEALING 1
+#define deque_load(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define deque_store(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define deque_fence()         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define deque_cas(p, e, d)    __atomic_compare_exchange_n((p), &(e), (d), 0, \
+                                  __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)
+#else
+#define ASX_PARALLEL_STEALING 0
+#endif
+
+typedef struct {
+    int32_t  top;      /* next entry a thief takes */
+    int32_t  bottom;   /* one past the owner's next entry */
+    uint32_t steals;   /* entries this worker stole in the batch */
+    uint32_t pin_ok;   /* the thread runs on pinned_mask */
+    uint64_t pinned_mask; /* CPU set last applied to the thread */
+    uint64_t switches; /* involuntary switches during the batch */
+    uint8_t  pad[32];  /* one deque per cache line */
+} parallel_deque;
+
+typedef struct {
+    uint32_t       count;
+    uint32_t       workers;
+    uint32_t       round;
+    uint32_t       slot[ASX_PARALLEL_BATCH_MAX];
+    asx_task_id    tid[ASX_PARALLEL_BATCH_MAX];
+    asx_status     result[ASX_PARALLEL_BATCH_MAX];
+    uint8_t        lane[ASX_PARALLEL_BATCH_MAX];
+    uint8_t        region[ASX_PARALLEL_BATCH_MAX]; /* index in g_run */
+    uint8_t        worker[ASX_PARALLEL_BATCH_MAX]; /* who polled entry k */
+    uint32_t       trace_at[ASX_PARALLEL_BATCH_MAX]; /* staged run start */
+    parallel_deque deque[ASX_MAX_WORKERS];
+} parallel_batch;
+
+static parallel_batch g_batch;
+
+/* First batch entry owned by worker w (w == workers gives count) */
+static uint32_t batch_block_begin(const parallel_batch *b, uint32_t w)
+{
+    return (uint32_t)(((uint64_t)b->count * w) / b->workers);
+}
+
+/* Owner side: take the bottom entry. Returns 0 when empty. */
+static int deque_pop(parallel_deque *d, int32_t *out)
+{
+#if ASX_PARALLEL_STEALING
+    int32_t b = d->bottom - 1;
+    int32_t t;
+    int won = 1;
+
+    deque_store(&d->bottom, b);
+    deque_fence();
+    t = deque_load(&d->top);
+    if (t > b) {
+        deque_store(&d->bottom, b + 1);
+        return 0;
+    }
+    if (t == b) {
+        /* Last entry: race any thief for it */
+        won = deque_cas(&d->top, t, t + 1);
+        deque_store(&d->bottom, b + 1);
+    }
+    if (!won) return 0;
+    *out = b;
+    return 1;
+#else
+    if (d->top >= d->bottom) return 0;
+    d->bottom--;
+    *out = d->bottom;
+    return 1;
+#endif
+}
+
+#if ASX_PARALLEL_STEALING
+/* Thief side: take the top entry. Returns 1 on success, 0 when empty,
+ * -1 when another worker won the race (retry). */
+static int deque_steal(parallel_deque *d, int32_t *out)
+{
+    int32_t t = deque_load(&d->top);
+    int32_t b;
+
+    deque_fence();
+    b = deque_load(&d->bottom);
+    if (t >= b) return 0;
+    if (!deque_cas(&d->top, t, t + 1)) return -1;
+    *out = t;
+    return 1;
+}
+#endif
+
+static void batch_poll_entry(parallel_batch *b, int32_t k, uint32_t worker_index)
+{
+    asx_task_slot *t = asx_task_at(b->slot[k]);
+
+    b->trace_at[k] = asx_trace_stage_mark(worker_index);
+    asx_trace_stage_enter(worker_index, b->round, b->lane[k], b->slot[k]);
+    asx_ledger_bind(b->tid[k]);
+    b->result[k] = t->poll_fn(t->user_data, b->tid[k]);
+    asx_ledger_bind(ASX_INVALID_ID);
+    asx_trace_stage_leave();
+    b->worker[k] = (uint8_t)worker_index;
+}
+
+/* A worker with a CPU set pins its thread there the first time it runs
+ * (again only if the set changes) and samples its involuntary context
+ * switches around the batch. Workers without one cost nothing. */
+static uint64_t batch_worker_enter(parallel_batch *b, uint32_t worker_index)
+{
+    parallel_deque *d = &b->deque[worker_index];
+    uint64_t mask = g_config.worker_cpus[worker_index];
+    uint64_t start = 0;
+
+    d->switches = 0;
+    if (mask == 0u) return 0;
+    if (d->pinned_mask != mask) {
+        d->pin_ok = asx_runtime_thread_pin(mask) == ASX_OK;
+        d->pinned_mask = mask;
+    }
+    if (asx_runtime_thread_switches(&start) != ASX_OK) return UINT64_MAX;
+    return start;
+}
+
+static void batch_worker_leave(parallel_batch *b, uint32_t worker_index,
+                               uint64_t start)
+{
+    uint64_t now;
+
+    if (g_config.worker_cpus[worker_index] == 0u || start == UINT64_MAX) return;
+    if (asx_runtime_thread_switches(&now) == ASX_OK && now >= start) {
+        b->deque[worker_index].switches = now - start;
+    }
+}
+
+static void parallel_batch_worker(void *arg, uint32_t worker_index)
+{
+    parallel_batch *b = (parallel_batch *)arg;
+    parallel_deque *own = &b->deque[worker_index];
+    uint64_t start = batch_worker_enter(b, worker_index);
+    int32_t k;
+
+    while (deque_pop(own, &k)) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_BATCH_MAX") */
+        batch_poll_entry(b, k, worker_index);
+    }
+
+#if ASX_PARALLEL_STEALING
+    {
+        uint32_t i;
+        for (i = 1; i < b->workers; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+            parallel_deque *victim = &b->deque[(worker_index + i) % b->workers];
+            int got;
+            for (;;) { /* ASX_CHECKPOINT_WAIVER("each retry means another worker took an entry") */
+                got = deque_steal(victim, &k);
+                if (got == 0) break;
+                if (got < 0) continue;
+                own->steals++;
+                batch_poll_entry(b, k, worker_index);
+            }
+        }
+    }
+#endif
+    batch_worker_leave(b, worker_index, start);
+}
+
+/* Pinned batches: poll the entries tagged with this worker, in order */
+static void parallel_pinned_worker(void *arg, uint32_t worker_index)
+{
+    parallel_batch *b = (parallel_batch *)arg;
+    uint64_t start = batch_worker_enter(b, worker_index);
+    uint32_t k;
+
+    for (k = 0; k < b->count; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_BATCH_MAX") */
+        if (b->worker[k] == worker_index) {
+            batch_poll_entry(b, (int32_t)k, worker_index);
+        }
+    }
+    batch_worker_leave(b, worker_index, start);
+}
+
+/* Threaded polling needs >1 worker, a dispatch hook, and a
+ * non-deterministic build; otherwise polls stay serialized. */
+static int parallel_threaded(void)
+{
+#if ASX_DETERMINISTIC
+    return 0;
+#else
+    const asx_runtime_hooks *hooks = asx_runtime_get_hooks();
+    return g_config.worker_count > 1 && hooks != NULL &&
+           hooks->threads.dispatch_fn != NULL;
+#endif
+}
+
+/* Apply one poll result on the calling thread. Returns 1 if the task
+ * left its lane (completed or parked), 0 if it stays. */
+static int parallel_apply_result(asx_region_slot *rslot,
+                                 asx_budget *budget,
+                                 uint32_t slot_idx,
+                                 asx_task_id tid,
+                                 asx_status poll_result,
+                                 uint32_t worker,
+                                 uint32_t round)
+{
+    asx_task_slot *t = asx_task_at(slot_idx);
+
+    asx_budget_charge_task(budget, t);
+    asx_waker_poll_end(rslot, slot_idx, poll_result);
+    g_workers[worker].polls_total++;
+
+    if (poll_result != ASX_E_PENDING) {
+        /* Completed (OK) or failed (error). If cancel was pending,
+         * outcome joins to CANCELLED in the severity lattice. */
+        t->state = ASX_TASK_COMPLETED;
+        if (t->cancel_pending) {
+            asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
+        } else {
+            asx_task_cold_set_outcome(t->cold,
+                poll_result == ASX_OK ? ASX_OUTCOME_OK : ASX_OUTCOME_ERR);
+        }
+        asx_task_release_capture_internal(t);
+        asx_region_task_completed(rslot, slot_idx);
+        asx_region_ready_remove(rslot, slot_idx);
+        g_workers[worker].tasks_completed++;
+        asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
+        return 1;
+    }
+
+    /* PENDING and parked — the park took it off the pollable lanes
+     * until woken; timer waiters wait in the TIMED lane */
+    if (t->parked) return 1;
+
+    /* PENDING — still active */
+    if (t->cancel_pending && t->cleanup_polls_remaining > 0) {
+        t->cleanup_polls_remaining--;
+    }
+    return 0;
+}
+
+/* Fault containment after a failed poll (bd-hwb.15). In POISON_REGION
+ * mode the region is poisoned and the run continues draining. */
+static asx_status parallel_contain(asx_region_id region, asx_status poll_result)
+{
+    if (poll_result == ASX_OK || poll_result == ASX_E_PENDING) return ASX_OK;
+    if (asx_containment_policy_kernel() != ASX_CONTAIN_POISON_REGION) {
+        return poll_result;
+    }
+    {
+        asx_status fc_ = asx_region_contain_fault(region, poll_result);
+        (void)fc_;  /* the run continues draining */
+    }
+    return ASX_OK;
+}
+
+/* Poll the batch on worker threads, then apply results in selection
+ * order. Every result is applied even after a fatal containment status
+ * so no completed poll is lost; the first such status is returned. */
+static asx_status parallel_batch_run(asx_budget *budget, uint32_t round)
+{
+    parallel_batch *b = &g_batch;
+    asx_worker_entry_fn worker_fn = parallel_batch_worker;
+    asx_status first_fault = ASX_OK;
+    uint32_t w;
+    uint32_t k;
+
+    if (b->count == 0) return ASX_OK;
+
+    b->workers = g_config.worker_count;
+    if (g_run.pinned) {
+        worker_fn = parallel_pinned_worker;
+    } else if (b->workers > b->count) {
+        b->workers = b->count;
+    }
+    for (w = 0; w < b->workers; w++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+        b->deque[w].top = (int32_t)batch_block_begin(b, w);
+        b->deque[w].bottom = (int32_t)batch_block_begin(b, w + 1u);
+        b->deque[w].steals = 0;
+    }
+    b->round = round;
+    asx_trace_stage_reset(b->workers);
+
+    asx_waker_batch_begin();
+    if (asx_runtime_worker_dispatch(b->workers, worker_fn, b) != ASX_OK) {
+        for (w = 0; w < b->workers; w++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+            worker_fn(b, w);
+        }
+    }
+    asx_waker_batch_end();
+
+    for (w = 0; w < b->workers; w++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_WORKERS") */
+        g_workers[w].steals_total += b->deque[w].steals;
+        g_workers[w].involuntary_switches += b->deque[w].switches;
+        g_workers[w].pinned = g_config.worker_cpus[w] != 0u &&
+                              b->deque[w].pin_ok &&
+                              b->deque[w].pinned_mask == g_config.worker_cpus[w];
+    }
+
+    /* Apply in selection order; polls are credited to whichever worker
+     * ran them, stolen or not. */
+    for (k = 0; k < b->count; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_BATCH_MAX") */
+        asx_status fc_;
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)b->tid[k], round);
+        asx_trace_stage_merge(b->worker[k], b->trace_at[k], round,
+                              b->lane[k], b->slot[k]);
+        (void)parallel_apply_result(g_run.rslot[b->region[k]], budget,
+                                    b->slot[k], b->tid[k], b->result[k],
+                                    b->worker[k], round);
+        fc_ = parallel_contain(g_run.id[b->region[k]], b->result[k]);
+        if (first_fault == ASX_OK) first_fault = fc_;
+    }
+
+    /* Wakes raised by channel operations on the workers; applied after
+     * every park of this batch is in place */
+    asx_waker_flush_deferred();
+
+    b->count = 0;
+    return first_fault;
+}
+
 /* -------------------------------------------------------------------
  * Parallel scheduler run
  *
@@ -270,69 +899,243 @@ static asx_status parallel_return_quiescent(uint32_t round)
  * In single-worker mode, produces deterministic event streams.
  * ------------------------------------------------------------------- */
 
-asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
+/* Lane task t belongs in, as lane + 1, or 0 for none: parked tasks
+ * other than timer waiters and finished tasks are in no lane. */
+static uint8_t lane_of_task(const asx_task_slot *t)
+{
+    if (!asx_slot_live(t->key) || asx_task_is_terminal(t->state)) return 0;
+    if (t->parked) {
+        return t->park_kind == ASX_PARK_TIMER
+             ? (uint8_t)(ASX_LANE_TIMED + 1) : 0u;
+    }
+    return t->cancel_pending ? (uint8_t)(ASX_LANE_CANCEL + 1)
+                             : (uint8_t)(ASX_LANE_READY + 1);
+}
+
+static asx_task_id lane_task_handle(const asx_task_slot *t, uint32_t idx)
+{
+    return asx_handle_pack(ASX_TYPE_TASK,
+                           (uint16_t)(1u << (unsigned)t->state),
+                           asx_handle_pack_index(asx_slot_generation(t->key),
+                                                  idx));
+}
+
+/* Assign a region's live tasks to lanes, in spawn order, tagging each */
+static void parallel_classify_region(const asx_region_slot *rslot)
+{
+    uint32_t i;
+
+    for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+         i = asx_task_cold_at(i)->region_next) { /* ASX_CHECKPOINT_WAIVER("bounded by the region's live tasks") */
+        asx_task_slot *t = asx_task_at(i);
+        uint8_t lane = lane_of_task(t);
+
+        t->cold->lane = 0;
+        if (lane != 0) {
+            lane_assign_internal(lane_task_handle(t, i),
+                                 (asx_lane_class)(lane - 1u));
+        }
+    }
+}
+
+/* Reuse the lanes if they already hold the run's regions; otherwise
+ * empty them and classify the run's regions into them. */
+static void parallel_lanes_attach(void)
+{
+    uint32_t lane_idx;
+    uint32_t r;
+
+    if (g_lane_scope.count == g_run.count) {
+        for (r = 0; r < g_run.count; r++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+            if (g_lane_scope.slot[r] != g_run.slot[r]) break;
+        }
+        if (r == g_run.count) {
+            parallel_promote_cancelled();
+            return;
+        }
+    }
+
+    for (lane_idx = 0; lane_idx < ASX_MAX_LANES; lane_idx++) {
+        g_lanes[lane_idx].count = 0;
+    }
+    g_lane_totals.pollable = 0;
+    g_lane_totals.weight = 0;
+    g_lane_totals.starved = 0;
+    g_lane_scope.cancel_deferred = 0;
+    g_lane_scope.overflow = 0;
+    for (r = 0; r < g_run.count; r++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+        g_lane_scope.slot[r] = g_run.slot[r];
+        parallel_classify_region(g_run.rslot[r]);
+    }
+    g_lane_scope.count = g_run.count;
+}
+
+/* Offer lanes that have drained to the tasks a full lane turned away,
+ * in region and spawn order. Only walks the regions while some task is
+ * waiting; one still turned away counts again for the next round. */
+static void parallel_retry_overflow(void)
+{
+    uint32_t r;
+    uint32_t i;
+
+    if (g_lane_scope.overflow == 0) return;
+    g_lane_scope.overflow = 0;
+    for (r = 0; r < g_lane_scope.count; r++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+        const asx_region_slot *rslot = g_run.rslot[r];
+
+        for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+             i = asx_task_cold_at(i)->region_next) { /* ASX_CHECKPOINT_WAIVER("bounded by the region's live tasks") */
+            asx_task_slot *t = asx_task_at(i);
+            uint8_t lane;
+
+            if (t->cold->lane != 0) continue;
+            lane = lane_of_task(t);
+            if (lane != 0) {
+                lane_assign_internal(lane_task_handle(t, i),
+                                     (asx_lane_class)(lane - 1u));
+            }
+        }
+    }
+}
+
+static int lane_scope_covers(const asx_task_slot *t)
+{
+    uint32_t slot = asx_handle_slot(t->region);
+    uint32_t r;
+
+    for (r = 0; r < g_lane_scope.count; r++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+        if (g_lane_scope.slot[r] == slot) return 1;
+    }
+    return 0;
+}
+
+void asx_parallel_lane_sync(uint32_t task_idx)
+{
+    asx_task_slot *t;
+    uint8_t from;
+    uint8_t to;
+
+    if (g_lane_scope.count == 0) return;
+    t = asx_task_at(task_idx);
+    if (!lane_scope_covers(t)) return;
+
+    from = t->cold->lane;
+    to = lane_of_task(t);
+    if (to == from) return;
+
+    /* A woken timer waiter leaves the TIMED lane through
+     * parallel_promote_timed, in lane order. A task cancelled mid-run
+     * stays put until parallel_promote_cancelled, so no lane shifts
+     * under the round polling it. */
+    if (from == (uint8_t)(ASX_LANE_TIMED + 1) && to != 0) return;
+    if (from == (uint8_t)(ASX_LANE_READY + 1) &&
+        to == (uint8_t)(ASX_LANE_CANCEL + 1) && g_lane_scope.running) {
+        g_lane_scope.cancel_deferred++;
+        return;
+    }
+
+    if (from != 0) {
+        lane_internal *l = &g_lanes[from - 1u];
+        uint32_t j;
+
+        for (j = 0; j < l->count; j++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_LANE_TASK_CAPACITY") */
+            if (asx_handle_slot(l->tasks[j]) == task_idx) {
+                lane_remove_at(l, j);
+                break;
+            }
+        }
+        t->cold->lane = 0;
+    }
+    if (to != 0) {
+        lane_assign_internal(lane_task_handle(t, task_idx),
+                             (asx_lane_class)(to - 1u));
+    }
+}
+
+void asx_parallel_lanes_invalidate(void)
+{
+    uint32_t lane_idx;
+
+    for (lane_idx = 0; lane_idx < ASX_MAX_LANES; lane_idx++) {
+        g_lanes[lane_idx].count = 0;
+    }
+    memset(&g_lane_totals, 0, sizeof(g_lane_totals));
+    memset(&g_lane_scope, 0, sizeof(g_lane_scope));
+}
+
+/* Resolve the covered regions into g_run. Duplicates are rejected so
+ * every task belongs to exactly one entry. */
+static asx_status parallel_run_begin(const asx_region_id *regions,
+                                     uint32_t region_count)
+{
+    uint32_t i, j;
+    asx_status st;
+
+    g_run.count = 0;
+    for (i = 0; i < region_count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+        st = asx_region_slot_lookup(regions[i], &g_run.rslot[i]);
+        if (st != ASX_OK) return st;
+        g_run.id[i] = regions[i];
+        g_run.slot[i] = asx_handle_slot(regions[i]);
+        for (j = 0; j < i; j++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+            if (g_run.slot[j] == g_run.slot[i]) return ASX_E_INVALID_ARGUMENT;
+        }
+        g_run.worker[i] = parallel_region_worker(regions[i], i);
+    }
+    g_run.count = region_count;
+    g_run.pinned = region_count > 1;
+    return ASX_OK;
+}
+
+static asx_status parallel_run_rounds(const asx_region_id *regions,
+                                      uint32_t region_count,
+                                      asx_budget *budget)
 {
-    asx_region_slot *rslot;
     asx_status st;
     uint32_t round;
     uint32_t lane_idx;
+    uint32_t r;
+    int threaded;
 
     if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
     if (!g_initialized) return ASX_E_INVALID_STATE;
 
-    st = asx_region_slot_lookup(region, &rslot);
+    st = parallel_run_begin(regions, region_count);
     if (st != ASX_OK) return st;
 
-    /* Auto-classify existing tasks into lanes */
-    {
-        uint32_t i;
-        /* Clear lanes first */
-        for (i = 0; i < ASX_MAX_LANES; i++) {
-            g_lanes[i].count = 0;
-        }
-        /* Scan task arena and assign to lanes */
-        for (i = 0; i < g_task_count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TASKS") */
-            asx_task_slot *t = &g_tasks[i];
-            asx_task_id tid;
-            asx_lane_class lc;
-
-            if (!t->alive) continue;
-            if (t->region != region) continue;
-            if (asx_task_is_terminal(t->state)) continue;
-
-            tid = asx_handle_pack(ASX_TYPE_TASK,
-                                  (uint16_t)(1u << (unsigned)t->state),
-                                  asx_handle_pack_index(t->generation,
-                                                         (uint16_t)i));
-
-            /* Classify by cancel state */
-            if (t->cancel_pending) {
-                lc = ASX_LANE_CANCEL;
-            } else {
-                lc = ASX_LANE_READY;
-            }
-            /* Note: TIMED lane assignment would require timer integration.
-             * Walking skeleton assigns to READY by default. */
+    parallel_lanes_attach();
+    g_lane_scope.running = 1;
 
-            lane_assign_internal(tid, lc);
-        }
-    }
+    threaded = parallel_threaded();
+    g_batch.count = 0;
 
     /* Scheduler loop */
     for (round = 0; ; round++) {
         uint32_t total_active;
         uint32_t quotas[ASX_MAX_LANES];
+        uint32_t polled[ASX_MAX_LANES] = { 0 };
         uint32_t lane_order_idx;
         int any_polled;
+        int budget_hit = 0;
 
         ASX_CHECKPOINT_WAIVER("kernel-parallel-scheduler: budget exhaustion "
                               "provides bounded termination");
+        asx_coarse_round_begin();
+        for (r = 0; r < g_run.count; r++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+            asx_region_deadline_poll(g_run.slot[r]);
+            asx_region_lease_poll(g_run.slot[r]);
+        }
 
         if (asx_budget_is_exhausted(budget)) {
             return parallel_return_budget(round);
         }
 
-        total_active = asx_lane_total_tasks();
+        parallel_promote_timed();
+        if (g_config.fairness == ASX_FAIRNESS_CANCEL_STRICT) {
+            parallel_promote_cancelled();
+        }
+        parallel_retry_overflow();
+        total_active = lane_runnable_tasks();
         if (total_active == 0) {
             return parallel_return_quiescent(round);
         }
@@ -347,8 +1150,8 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
 
         any_polled = 0;
 
-        /* Poll each lane in priority order */
-        for (lane_order_idx = 0; lane_order_idx < ASX_MAX_LANES;
+        /* Poll (or, in threaded mode, select) each lane in priority order */
+        for (lane_order_idx = 0; lane_order_idx < ASX_MAX_LANES && !budget_hit;
              lane_order_idx++) {
             int li = g_priority_order[lane_order_idx];
             lane_internal *lane = &g_lanes[li];
@@ -359,6 +1162,12 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
             ASX_CHECKPOINT_WAIVER("kernel-parallel-scheduler: lane iteration "
                                   "bounded by ASX_LANE_TASK_CAPACITY");
 
+            /* Timer waiters cost nothing and are never starved */
+            if (li == ASX_LANE_TIMED) {
+                lane->polls_this_round = 0;
+                lane_set_starvation((uint32_t)li, 0);
+                continue;
+            }
             if (lane->count == 0) continue;
 
             /* Poll tasks in this lane up to quota */
@@ -366,25 +1175,30 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
             while (j < lane->count && polls_this_lane < quota) {
                 asx_task_id tid;
                 asx_task_slot *t;
-                uint16_t slot_idx;
+                asx_region_slot *rslot;
+                uint32_t slot_idx;
+                uint32_t ri;
                 asx_status poll_result;
 
                 ASX_CHECKPOINT_WAIVER("kernel-parallel-scheduler: inner poll "
                                       "bounded by lane count and quota");
 
                 if (asx_budget_is_exhausted(budget)) {
-                    return parallel_return_budget(round);
+                    budget_hit = 1;
+                    break;
                 }
 
                 tid = lane->tasks[j];
                 slot_idx = asx_handle_slot(tid);
-                if (slot_idx >= ASX_MAX_TASKS) {
+                if (slot_idx >= g_task_capacity) {
                     lane_remove_internal(tid);
                     continue; /* don't increment j, array shifted */
                 }
-                t = &g_tasks[slot_idx];
+                t = asx_task_at(slot_idx);
+                ri = parallel_region_of(t);
+                rslot = g_run.rslot[ri];
 
-                if (!t->alive || asx_task_is_terminal(t->state)) {
+                if (!asx_slot_live(t->key) || asx_task_is_terminal(t->state)) {
                     /* Remove completed task from lane */
                     lane_remove_internal(tid);
                     continue; /* don't increment j, array shifted */
@@ -393,7 +1207,7 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                 /* Refresh handle from live slot to avoid stale state masks. */
                 tid = asx_handle_pack(ASX_TYPE_TASK,
                                       (uint16_t)(1u << (unsigned)t->state),
-                                      asx_handle_pack_index(t->generation, slot_idx));
+                                      asx_handle_pack_index(asx_slot_generation(t->key), slot_idx));
                 lane->tasks[j] = tid;
 
                 /* Handle cancel force-completion */
@@ -402,10 +1216,10 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                      t->state == ASX_TASK_CANCEL_REQUESTED) &&
                     t->cleanup_polls_remaining == 0) {
                     t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                    asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
                     asx_task_release_capture_internal(t);
-                    rslot->task_count--;
-                    lane_remove_internal(tid);
+                    asx_region_task_completed(rslot, slot_idx);
+                    asx_region_ready_remove(rslot, slot_idx);
                     g_workers[0].tasks_completed++;
                     asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
                                    (uint64_t)tid, round);
@@ -414,10 +1228,10 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
 
                 if (t->state == ASX_TASK_FINALIZING) {
                     t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                    asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
                     asx_task_release_capture_internal(t);
-                    rslot->task_count--;
-                    lane_remove_internal(tid);
+                    asx_region_task_completed(rslot, slot_idx);
+                    asx_region_ready_remove(rslot, slot_idx);
                     g_workers[0].tasks_completed++;
                     asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
                                    (uint64_t)tid, round);
@@ -426,75 +1240,81 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
 
                 /* Consume budget */
                 if (asx_budget_consume_poll(budget) == 0) {
-                    return parallel_return_budget(round);
+                    budget_hit = 1;
+                    break;
                 }
 
                 /* Transition Created → Running */
                 if (t->state == ASX_TASK_CREATED) {
                     t->state = ASX_TASK_RUNNING;
+                    asx_snapshot_touch_task(slot_idx);
                 }
 
-                asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)tid, round);
-
-                /* Poll the task */
-                poll_result = t->poll_fn(t->user_data, tid);
                 polls_this_lane++;
-                g_workers[0].polls_total++;
                 any_polled = 1;
 
-                if (poll_result == ASX_OK) {
-                    t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(
-                        t->cancel_pending ? ASX_OUTCOME_CANCELLED
-                                          : ASX_OUTCOME_OK);
-                    asx_task_release_capture_internal(t);
-                    rslot->task_count--;
-                    lane_remove_internal(tid);
-                    g_workers[0].tasks_completed++;
-                    asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
-                                   (uint64_t)tid, round);
-                    continue;
-                } else if (poll_result != ASX_E_PENDING) {
-                    t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(
-                        t->cancel_pending ? ASX_OUTCOME_CANCELLED
-                                          : ASX_OUTCOME_ERR);
-                    asx_task_release_capture_internal(t);
-                    rslot->task_count--;
-                    lane_remove_internal(tid);
-                    g_workers[0].tasks_completed++;
-                    asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
-                                   (uint64_t)tid, round);
-
-                    {
-                        asx_status fc_ = asx_region_contain_fault(region, poll_result);
-                        if (fc_ != ASX_OK &&
-                            asx_containment_policy_active() != ASX_CONTAIN_POISON_REGION) {
-                            return fc_;
-                        }
-                    }
+                if (threaded) {
+                    /* Poll later on a worker; stays in lane until applied */
+                    g_batch.slot[g_batch.count] = slot_idx;
+                    g_batch.tid[g_batch.count] = tid;
+                    g_batch.lane[g_batch.count] = (uint8_t)li;
+                    g_batch.region[g_batch.count] = (uint8_t)ri;
+                    g_batch.worker[g_batch.count] = g_run.worker[ri];
+                    g_batch.count++;
+                    j++;
                     continue;
                 }
 
-                /* PENDING — still active */
-                if (t->cancel_pending && t->cleanup_polls_remaining > 0) {
-                    t->cleanup_polls_remaining--;
+                asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)tid, round);
+
+                /* Poll the task */
+                asx_waker_poll_begin(slot_idx);
+                asx_ledger_bind(tid);
+                poll_result = t->poll_fn(t->user_data, tid);
+                asx_ledger_bind(ASX_INVALID_ID);
+                if (parallel_apply_result(rslot, budget, slot_idx, tid,
+                                          poll_result, 0, round)) {
+                    st = parallel_contain(g_run.id[ri], poll_result);
+                    if (st != ASX_OK) return st;
+                    continue; /* left the lane: array shifted */
                 }
 
                 j++;
             }
 
+            polled[li] = polls_this_lane;
+            if (budget_hit) break;
+
             lane->polls_this_round = polls_this_lane;
 
             /* Track starvation */
             if (polls_this_lane == 0 && lane->count > 0) {
-                lane->starvation_count++;
+                lane_set_starvation((uint32_t)li, lane->starvation_count + 1u);
             } else {
-                lane->starvation_count = 0;
+                lane_set_starvation((uint32_t)li, 0);
             }
         }
 
-        if (asx_lane_total_tasks() == 0) {
+        settle_lane_deficits(quotas, polled, budget_hit);
+
+        /* Threaded mode: poll this round's selections concurrently */
+        st = parallel_batch_run(budget, round);
+        if (st != ASX_OK) return st;
+
+        /* Destructors deferred by this round's completions */
+        for (r = 0; r < g_run.count; r++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_PARALLEL_REGION_MAX") */
+            if (g_run.rslot[r]->dtor_pending != 0u) {
+                (void)asx_region_dtor_flush(g_run.rslot[r],
+                                            g_run.rslot[r]->dtor_batch);
+            }
+        }
+
+        if (budget_hit) {
+            return parallel_return_budget(round);
+        }
+
+        parallel_promote_timed();
+        if (lane_runnable_tasks() == 0) {
             return parallel_return_quiescent(round);
         }
 
@@ -507,20 +1327,38 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
     }
 }
 
+asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
+{
+    asx_status st = parallel_run_rounds(&region, 1u, budget);
+
+    g_lane_scope.running = 0;
+    asx_coarse_run_end();
+    return st;
+}
+
+asx_status asx_parallel_run_regions(const asx_region_id *regions,
+                                    uint32_t region_count,
+                                    asx_budget *budget)
+{
+    asx_status st;
+
+    if (regions == NULL || region_count == 0 ||
+        region_count > ASX_PARALLEL_REGION_MAX) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = parallel_run_rounds(regions, region_count, budget);
+    g_lane_scope.running = 0;
+    asx_coarse_run_end();
+    return st;
+}
+
 /* -------------------------------------------------------------------
  * Fairness queries
  * ------------------------------------------------------------------- */
 
 int asx_parallel_starvation_detected(void)
 {
-    uint32_t i;
-    for (i = 0; i < ASX_MAX_LANES; i++) {
-        if (g_lanes[i].count > 0 &&
-            g_lanes[i].starvation_count > g_config.starvation_limit) {
-            return 1;
-        }
-    }
-    return 0;
+    return g_lane_totals.starved > 0;
 }
 
 uint32_t asx_parallel_max_starvation(void)
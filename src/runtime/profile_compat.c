@@ -118,7 +118,7 @@ static const asx_profile_descriptor g_descriptors[ASX_PROFILE_ID_COUNT] = {
     /* EMBEDDED_ROUTER */
     {
         ASX_PROFILE_ID_EMBEDDED_ROUTER, "EMBEDDED_ROUTER",
-        ASX_WAIT_BUSY_SPIN,
+        ASX_WAIT_ADAPTIVE,
         ASX_MAX_REGIONS, ASX_MAX_TASKS, ASX_MAX_OBLIGATIONS, ASX_MAX_TIMERS,
         1, 1,
         ASX_CLASS_R2, 256
@@ -342,6 +342,7 @@ int asx_profile_digest_compare(uint64_t digest_a,
         out->pass = 1;
         out->divergence_rule = ASX_SRULE_LIFECYCLE_TRANSITIONS; /* unused */
         out->divergence_index = 0;
+        out->divergence_window = 0;
         return 1;
     }
 
@@ -351,6 +352,7 @@ int asx_profile_digest_compare(uint64_t digest_a,
      * event-level divergence detail. */
     out->divergence_rule = ASX_SRULE_DETERMINISTIC_ORDERING;
     out->divergence_index = 0;
+    out->divergence_window = 0;
     return 0;
 }
 
@@ -372,11 +374,122 @@ int asx_profile_check_parity(uint64_t expected_digest,
         out->pass = 1;
         out->divergence_rule = ASX_SRULE_LIFECYCLE_TRANSITIONS;
         out->divergence_index = 0;
+        out->divergence_window = 0;
         return 1;
     }
 
     out->pass = 0;
     out->divergence_rule = ASX_SRULE_DETERMINISTIC_ORDERING;
     out->divergence_index = 0;
+    out->divergence_window = 0;
     return 0;
 }
+
+/* -------------------------------------------------------------------
+ * Windowed parity checking
+ * ------------------------------------------------------------------- */
+
+static int parity_window_ok(uint32_t window)
+{
+    uint32_t q;
+
+    if (window < ASX_TELEMETRY_PARITY_WINDOW ||
+        window % ASX_TELEMETRY_PARITY_WINDOW != 0) {
+        return 0;
+    }
+    q = window / ASX_TELEMETRY_PARITY_WINDOW;
+    return (q & (q - 1u)) == 0;
+}
+
+int asx_profile_parity_windows_compare(const uint64_t *checkpoints_a,
+                                        uint32_t count_a,
+                                        uint32_t window_a,
+                                        asx_profile_id profile_a,
+                                        const uint64_t *checkpoints_b,
+                                        uint32_t count_b,
+                                        uint32_t window_b,
+                                        asx_profile_id profile_b,
+                                        asx_parity_result *out)
+{
+    uint64_t cover_a;
+    uint64_t cover_b;
+    uint32_t step;
+    uint32_t shared;
+    uint32_t lo = 0;
+    uint32_t hi;
+
+    if (out == NULL) return 0;
+
+    out->profile_a = profile_a;
+    out->profile_b = profile_b;
+    out->digest_a = 0;
+    out->digest_b = 0;
+    out->pass = 0;
+    out->divergence_rule = ASX_SRULE_DETERMINISTIC_ORDERING;
+    out->divergence_index = 0;
+    out->divergence_window = 0;
+
+    if ((checkpoints_a == NULL && count_a != 0) ||
+        (checkpoints_b == NULL && count_b != 0) ||
+        !parity_window_ok(window_a) || !parity_window_ok(window_b)) {
+        return 0;
+    }
+
+    cover_a = (uint64_t)count_a * window_a;
+    cover_b = (uint64_t)count_b * window_b;
+    step = window_a > window_b ? window_a : window_b;
+    shared = (uint32_t)((cover_a < cover_b ? cover_a : cover_b) / step);
+
+    /* First shared checkpoint that differs; the runs agree before it */
+    hi = shared;
+    while (lo < hi) {
+        ASX_CHECKPOINT_WAIVER("bounded by log2 of the checkpoint count");
+        uint32_t mid = lo + (hi - lo) / 2u;
+        uint64_t events = (uint64_t)(mid + 1u) * step;
+
+        if (checkpoints_a[events / window_a - 1u] !=
+            checkpoints_b[events / window_b - 1u]) {
+            hi = mid;
+        } else {
+            lo = mid + 1u;
+        }
+    }
+
+    if (lo < shared) {
+        uint64_t events = (uint64_t)(lo + 1u) * step;
+
+        out->digest_a = checkpoints_a[events / window_a - 1u];
+        out->digest_b = checkpoints_b[events / window_b - 1u];
+        out->divergence_index = lo * step;
+        out->divergence_window = step;
+        return 0;
+    }
+    if (count_a != 0) out->digest_a = checkpoints_a[count_a - 1u];
+    if (count_b != 0) out->digest_b = checkpoints_b[count_b - 1u];
+    if (cover_a != cover_b) {
+        /* One run ends early: it parts where the shorter one stops */
+        out->divergence_index = shared * step;
+        out->divergence_window = step;
+        return 0;
+    }
+    out->pass = 1;
+    out->divergence_rule = ASX_SRULE_LIFECYCLE_TRANSITIONS; /* unused */
+    return 1;
+}
+
+int asx_profile_check_parity_windows(const uint64_t *expected,
+                                      uint32_t count,
+                                      uint32_t window,
+                                      asx_parity_result *out)
+{
+    uint64_t current[ASX_TELEMETRY_PARITY_CHECKPOINTS];
+    uint32_t n;
+
+    n = asx_telemetry_parity_checkpoints(current,
+                                         ASX_TELEMETRY_PARITY_CHECKPOINTS);
+    return asx_profile_parity_windows_compare(current, n,
+                                              asx_telemetry_parity_window(),
+                                              asx_profile_active(),
+                                              expected, count, window,
+                                              asx_profile_active(), out);
+}
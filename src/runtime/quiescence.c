@@ -17,28 +17,33 @@
 #include <asx/core/ghost.h>
 #include "runtime_internal.h"
 
-static asx_status asx_region_obligations_resolved(asx_region_id id)
+/* Both queries read the per-region counters maintained by lifecycle.c,
+ * cancellation.c and the schedulers. Ghost builds also rescan the
+ * arenas and answer from the scan, so a counter that drifted shows up
+ * as a behaviour difference against the release build. */
+
+#ifdef ASX_DEBUG_GHOST
+static int asx_region_scan_reserved(asx_region_id id)
 {
     uint32_t i;
 
     for (i = 0; i < g_obligation_count; i++) {
-        if (!g_obligations[i].alive) continue;
-        if (g_obligations[i].region != id) continue;
-        if (g_obligations[i].state == ASX_OBLIGATION_RESERVED) {
-            return ASX_E_OBLIGATIONS_UNRESOLVED;
-        }
+        const asx_obligation_slot *o = asx_obligation_at(i);
+        if (!asx_slot_live(o->key)) continue;
+        if (o->region != id) continue;
+        if (o->state == ASX_OBLIGATION_RESERVED) return 1;
     }
 
-    return ASX_OK;
+    return 0;
 }
 
-static int asx_region_has_uncancelled_tasks(asx_region_id id)
+static int asx_region_scan_uncancelled(asx_region_id id)
 {
     uint32_t i;
 
     for (i = 0; i < g_task_count; i++) {
-        asx_task_slot *t = &g_tasks[i];
-        if (!t->alive) continue;
+        asx_task_slot *t = asx_task_at(i);
+        if (!asx_slot_live(t->key)) continue;
         if (t->region != id) continue;
         if (asx_task_is_terminal(t->state)) continue;
         if (!t->cancel_pending) return 1;
@@ -46,6 +51,33 @@ static int asx_region_has_uncancelled_tasks(asx_region_id id)
 
     return 0;
 }
+#endif
+
+static asx_status asx_region_obligations_resolved(asx_region_id id,
+                                                  const asx_region_slot *r)
+{
+    int reserved = r->obligations_reserved > 0;
+
+#ifdef ASX_DEBUG_GHOST
+    reserved = asx_region_scan_reserved(id);
+#else
+    (void)id;
+#endif
+    return reserved ? ASX_E_OBLIGATIONS_UNRESOLVED : ASX_OK;
+}
+
+static int asx_region_has_uncancelled_tasks(asx_region_id id,
+                                            const asx_region_slot *r)
+{
+    int uncancelled = r->tasks_uncancelled > 0;
+
+#ifdef ASX_DEBUG_GHOST
+    uncancelled = asx_region_scan_uncancelled(id);
+#else
+    (void)id;
+#endif
+    return uncancelled;
+}
 
 /* -------------------------------------------------------------------
  * Quiescence check
@@ -67,7 +99,7 @@ asx_status asx_quiescence_check(asx_region_id id)
         return ASX_E_QUIESCENCE_TASKS_LIVE;
     }
 
-    return asx_region_obligations_resolved(id);
+    return asx_region_obligations_resolved(id, r);
 }
 
 /* -------------------------------------------------------------------
@@ -80,34 +112,35 @@ asx_status asx_quiescence_check(asx_region_id id)
  *   4. Advance (Closing → Draining → Finalizing → Closed)
  * ------------------------------------------------------------------- */
 
-asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
+/* 1 if any CLOSING region of the subtree still has a task that was
+ * never cancelled. */
+static int asx_region_subtree_uncancelled(uint32_t root)
 {
-    asx_region_slot *r;
-    asx_status st;
-
-    if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
+    uint32_t idx;
 
-    st = asx_region_slot_lookup(id, &r);
-    if (st != ASX_OK) return st;
-
-    /* Step 1: Close the region if still open */
-    if (r->state == ASX_REGION_OPEN) {
-        asx_ghost_check_region_transition(id, ASX_REGION_OPEN, ASX_REGION_CLOSING);
-        st = asx_region_transition_check(ASX_REGION_OPEN, ASX_REGION_CLOSING);
-        if (st != ASX_OK) return st;
-        r->state = ASX_REGION_CLOSING;
+    for (idx = root; idx != ASX_REGION_LINK_NONE;
+         idx = asx_region_preorder_next(root, idx)) {
+        ASX_CHECKPOINT_WAIVER("bounded by the subtree's regions");
+        const asx_region_slot *r = asx_region_at(idx);
 
-        /* Propagate PARENT cancel to all active tasks in this region.
-         * Tasks observe cancellation via asx_checkpoint() and have
-         * bounded cleanup before forced completion. (bd-2cw.3) */
-        asx_cancel_propagate(id, ASX_CANCEL_PARENT);
+        if (r->state != ASX_REGION_CLOSING || r->task_count == 0) continue;
+        if (asx_region_has_uncancelled_tasks(asx_region_handle_at(idx), r)) {
+            return 1;
+        }
     }
 
-    if (r->state == ASX_REGION_CLOSING &&
-        r->task_count > 0 &&
-        asx_region_has_uncancelled_tasks(id)) {
-        asx_cancel_propagate(id, ASX_CANCEL_PARENT);
-    }
+    return 0;
+}
+
+/* Steps 2-4 for one region whose children are all CLOSED: run its
+ * tasks to completion, then advance to CLOSED. Runs at most
+ * *cleanup_quota cleanup callbacks and charges them to it; ASX_E_PENDING
+ * when callbacks remain, with the region left FINALIZING. */
+static asx_status region_drain_one(asx_region_id id, asx_region_slot *r,
+                                   asx_budget *budget,
+                                   uint32_t *cleanup_quota)
+{
+    asx_status st;
 
     /* Step 2: Run scheduler to drain tasks */
     if (r->task_count > 0) {
@@ -121,41 +154,151 @@ asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
 
     /* Step 3: Advance through closing protocol */
     if (r->state == ASX_REGION_CLOSING) {
-        /* No children (walking skeleton) — fast path: skip Draining */
-        asx_ghost_check_region_transition(id, ASX_REGION_CLOSING,
-                                               ASX_REGION_FINALIZING);
-        st = asx_region_transition_check(ASX_REGION_CLOSING,
-                                         ASX_REGION_FINALIZING);
-        if (st != ASX_OK) return st;
+        /* Children are already CLOSED — fast path: skip Draining */
+        (void)asx_ghost_check_region_transition(id, ASX_REGION_CLOSING,
+                                                ASX_REGION_FINALIZING);
+        if (!asx_region_transition_legal(ASX_REGION_CLOSING,
+                                         ASX_REGION_FINALIZING)) {
+            return ASX_E_INVALID_TRANSITION;
+        }
         r->state = ASX_REGION_FINALIZING;
+        asx_snapshot_touch_region(asx_handle_slot(id));
     }
 
     if (r->state == ASX_REGION_DRAINING) {
-        asx_ghost_check_region_transition(id, ASX_REGION_DRAINING,
-                                               ASX_REGION_FINALIZING);
-        st = asx_region_transition_check(ASX_REGION_DRAINING,
-                                         ASX_REGION_FINALIZING);
-        if (st != ASX_OK) return st;
+        (void)asx_ghost_check_region_transition(id, ASX_REGION_DRAINING,
+                                                ASX_REGION_FINALIZING);
+        if (!asx_region_transition_legal(ASX_REGION_DRAINING,
+                                         ASX_REGION_FINALIZING)) {
+            return ASX_E_INVALID_TRANSITION;
+        }
         r->state = ASX_REGION_FINALIZING;
+        asx_snapshot_touch_region(asx_handle_slot(id));
     }
 
     if (r->state == ASX_REGION_FINALIZING) {
-        st = asx_region_obligations_resolved(id);
-        if (st != ASX_OK) return st;
+        /* Expired leases abort here too; the rest expire in bounded
+         * time, so the drain is pending rather than stuck on them */
+        asx_region_lease_poll(asx_handle_slot(id));
+        st = asx_region_obligations_resolved(id, r);
+        if (st != ASX_OK) {
+            return r->leases == r->obligations_reserved ? ASX_E_PENDING : st;
+        }
 
         /* Ghost linearity monitor: check for leaked obligations before close */
         (void)asx_ghost_check_obligation_leaks(id);
 
-        /* Drain cleanup stack in LIFO order before closing */
-        asx_cleanup_drain(&r->cleanup);
+        /* Deferred task destructors first, in completion order, then
+         * the cleanup stack in LIFO order before closing */
+        *cleanup_quota -= asx_region_dtor_flush(r, *cleanup_quota);
+        if (r->dtor_pending > 0) return ASX_E_PENDING;
+        *cleanup_quota -= asx_cleanup_drain_some(&r->cleanup, *cleanup_quota);
+        if (r->cleanup.count > 0) return ASX_E_PENDING;
 
-        asx_ghost_check_region_transition(id, ASX_REGION_FINALIZING,
-                                               ASX_REGION_CLOSED);
-        st = asx_region_transition_check(ASX_REGION_FINALIZING,
-                                         ASX_REGION_CLOSED);
-        if (st != ASX_OK) return st;
+        /* Close and reclaim the region's channels, newest first */
+        asx_channel_region_reclaim(id, &r->channel_head);
+        asx_oneshot_region_reclaim(&r->oneshot_head);
+        asx_task_group_region_reclaim(&r->group_head);
+        asx_semaphore_region_reclaim(&r->sem_head);
+        asx_rate_limiter_region_reclaim(&r->rate_head);
+
+        (void)asx_ghost_check_region_transition(id, ASX_REGION_FINALIZING,
+                                                ASX_REGION_CLOSED);
+        if (!asx_region_transition_legal(ASX_REGION_FINALIZING,
+                                         ASX_REGION_CLOSED)) {
+            return ASX_E_INVALID_TRANSITION;
+        }
         r->state = ASX_REGION_CLOSED;
+        asx_snapshot_touch_region(asx_handle_slot(id));
+        asx_region_slot_retire(asx_handle_slot(id));
     }
 
     return ASX_OK;
 }
+
+static asx_status region_drain_subtree(asx_region_id id, asx_region_slot *r,
+                                       asx_budget *budget,
+                                       uint32_t *cleanup_quota)
+{
+    asx_status st;
+    uint32_t root = asx_handle_slot(id);
+
+    /* Step 1: Close the region and its subtree if still open */
+    if (r->state == ASX_REGION_OPEN) {
+        (void)asx_ghost_check_region_transition(id, ASX_REGION_OPEN, ASX_REGION_CLOSING);
+        if (!asx_region_transition_legal(ASX_REGION_OPEN, ASX_REGION_CLOSING)) {
+            return ASX_E_INVALID_TRANSITION;
+        }
+        r->state = ASX_REGION_CLOSING;
+        asx_snapshot_touch_region(root);
+        asx_region_close_descendants(root);
+
+        /* Propagate PARENT cancel to all active tasks in the subtree.
+         * Tasks observe cancellation via asx_checkpoint() and have
+         * bounded cleanup before forced completion. (bd-2cw.3) */
+        asx_cancel_propagate(id, ASX_CANCEL_PARENT);
+    } else if (asx_region_subtree_uncancelled(root)) {
+        asx_cancel_propagate(id, ASX_CANCEL_PARENT);
+    }
+
+    /* Descendants finish first: drain the subtree's first leaf until
+     * only the region itself is left. A leaf leaves the tree on CLOSED. */
+    while (r->first_child != ASX_REGION_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by the subtree's regions; each pass closes one");
+        uint32_t leaf = r->first_child;
+
+        while (asx_region_at(leaf)->first_child != ASX_REGION_LINK_NONE) {
+            ASX_CHECKPOINT_WAIVER("bounded by region tree depth");
+            leaf = asx_region_at(leaf)->first_child;
+        }
+        st = region_drain_one(asx_region_handle_at(leaf), asx_region_at(leaf),
+                              budget, cleanup_quota);
+        if (st != ASX_OK) return st;
+    }
+
+    return region_drain_one(id, r, budget, cleanup_quota);
+}
+
+asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
+{
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t cleanup_quota = UINT32_MAX;
+
+    if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(id, &r);
+    if (st != ASX_OK) return st;
+    return region_drain_subtree(id, r, budget, &cleanup_quota);
+}
+
+/* Phase a region is in between drain steps */
+static asx_region_drain_phase region_drain_phase(const asx_region_slot *r)
+{
+    if (r->state == ASX_REGION_CLOSED) return ASX_REGION_DRAIN_DONE;
+    if (r->first_child != ASX_REGION_LINK_NONE) return ASX_REGION_DRAIN_CHILDREN;
+    if (r->task_count > 0) return ASX_REGION_DRAIN_TASKS;
+    return ASX_REGION_DRAIN_CLEANUP;
+}
+
+asx_status asx_region_drain_step(asx_region_id id, asx_budget *budget,
+                                 uint32_t cleanup_quota,
+                                 asx_region_drain_phase *out_phase)
+{
+    asx_region_slot *r;
+    asx_status st;
+
+    if (budget == NULL || out_phase == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(id, &r);
+    if (st != ASX_OK) return st;
+
+    /* Same walk as asx_region_drain; a spent quota ends the step and
+     * the next call picks up from the region states it left behind. */
+    st = region_drain_subtree(id, r, budget, &cleanup_quota);
+    if (st == ASX_E_POLL_BUDGET_EXHAUSTED) st = ASX_E_PENDING;
+    if (st != ASX_OK && st != ASX_E_PENDING) return st;
+
+    *out_phase = region_drain_phase(r);
+    return st;
+}
@@ -0,0 +1,289 @@
+/*
+ * rate_limiter.c — token buckets with timer-wheel refill waits
+ *
+ * A fixed pool of ASX_MAX_RATE_LIMITERS buckets with a LIFO free list
+ * behind a never-used cursor, as the task groups have. A bucket keeps
+ * its tokens as of `last` and is brought up to date from
+ * asx_runtime_now_ns only when used: whole intervals since `last` are
+ * credited and `last` advances by exactly those intervals, so partial
+ * progress toward the next token is never lost. A full bucket resets
+ * `last` to now.
+ *
+ * Each bucket owns at most one timer on the global wheel, armed for the
+ * earliest time a parked waiter's tokens are due. A waiter needing an
+ * earlier time moves the timer; the move cancels the old one, waking
+ * its waiters to re-check, as any timer wake may be spurious.
+ *
+ * Handles encode [generation:16 | limiter:16].
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include <asx/time/timer_wheel.h>
+#include "runtime_internal.h"
+#include "context_internal.h"
+
+typedef struct {
+    asx_timer_handle timer;      /* refill timer, live while waiters sleep */
+    asx_time       last;         /* time the tokens are counted up to */
+    asx_time       timer_at;     /* deadline of timer while has_timer */
+    uint64_t       interval_ns;  /* time to gain one token */
+    asx_region_id  region;
+    uint32_t       burst;
+    uint32_t       tokens;
+    uint32_t       next;         /* region list, or free list once freed */
+    uint16_t       generation;
+    uint8_t        live;
+    uint8_t        has_timer;
+} asx_rate_slot;
+
+static asx_rate_slot g_rates[ASX_MAX_RATE_LIMITERS];
+static uint32_t      g_rate_count;     /* never-used cursor */
+static uint32_t      g_rate_free_head = ASX_RATE_LINK_NONE;
+
+static const uint32_t g_rate_link_none = ASX_RATE_LINK_NONE;
+static const asx_context_block g_rate_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_rates),
+    ASX_CONTEXT_BLOCK(g_rate_count),
+    ASX_CONTEXT_BLOCK_INIT(g_rate_free_head, g_rate_link_none)
+};
+
+const asx_context_module asx_rate_limiter_context = ASX_CONTEXT_MODULE(g_rate_blocks);
+
+/* ------------------------------------------------------------------ */
+/* Internal helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+static uint32_t rate_token(uint32_t idx)
+{
+    return ((uint32_t)g_rates[idx].generation << 16) | idx;
+}
+
+/* The live limiter named by limiter, or NULL */
+static asx_rate_slot *rate_lookup(const asx_rate_limiter *limiter)
+{
+    uint32_t idx;
+
+    if (limiter == NULL) return NULL;
+    idx = limiter->token & 0xFFFFu;
+    if (idx >= g_rate_count || !g_rates[idx].live) return NULL;
+    if (limiter->token != rate_token(idx)) return NULL;
+    return &g_rates[idx];
+}
+
+static void rate_release(asx_rate_slot *s)
+{
+    if (s->has_timer) {
+        (void)asx_timer_cancel(asx_timer_wheel_global(), &s->timer);
+        s->has_timer = 0;
+    }
+    s->live = 0;
+    s->generation = (uint16_t)(s->generation + 1u);
+    s->next = g_rate_free_head;
+    g_rate_free_head = (uint32_t)(s - g_rates);
+}
+
+/* Credit the whole intervals elapsed since s->last */
+static void rate_refill(asx_rate_slot *s, asx_time now)
+{
+    uint64_t gained;
+
+    if (now <= s->last) return;
+    gained = (now - s->last) / s->interval_ns;
+    if (gained >= (uint64_t)(s->burst - s->tokens)) {
+        s->tokens = s->burst;
+        s->last = now;
+    } else {
+        s->tokens += (uint32_t)gained;
+        s->last += gained * s->interval_ns;
+    }
+}
+
+/* Look up a limiter for a request of count tokens and bring it up to
+ * date */
+static asx_status rate_begin(const asx_rate_limiter *limiter, uint32_t count,
+                             asx_rate_slot **out)
+{
+    asx_rate_slot *s;
+    asx_time now;
+    asx_status st;
+
+    if (limiter == NULL) return ASX_E_INVALID_ARGUMENT;
+    s = rate_lookup(limiter);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    if (count == 0u || count > s->burst) return ASX_E_INVALID_ARGUMENT;
+    st = asx_runtime_now_ns(&now);
+    if (st != ASX_OK) return st;
+    rate_refill(s, now);
+    *out = s;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Rate limiter API                                                   */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_rate_limiter_create(asx_region_id region, uint32_t burst,
+                                   uint64_t interval_ns, asx_rate_limiter *out)
+{
+    asx_region_slot *r;
+    asx_rate_slot *s;
+    asx_time now;
+    uint32_t idx;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->token = 0;
+    if (burst == 0u || interval_ns == 0u) return ASX_E_INVALID_ARGUMENT;
+    if (interval_ns > UINT64_MAX / burst) return ASX_E_INVALID_ARGUMENT;
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+    if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
+    st = asx_runtime_now_ns(&now);
+    if (st != ASX_OK) return st;
+
+    if (g_rate_free_head != ASX_RATE_LINK_NONE) {
+        idx = g_rate_free_head;
+        g_rate_free_head = g_rates[idx].next;
+    } else if (g_rate_count < ASX_MAX_RATE_LIMITERS) {
+        idx = g_rate_count++;
+    } else {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    s = &g_rates[idx];
+    s->region = region;
+    s->burst = burst;
+    s->tokens = burst;
+    s->interval_ns = interval_ns;
+    s->last = now;
+    s->timer_at = 0;
+    s->has_timer = 0;
+    s->live = 1;
+    s->next = r->rate_head;
+    r->rate_head = idx;
+
+    out->token = rate_token(idx);
+    return ASX_OK;
+}
+
+asx_status asx_rate_limiter_try_take(const asx_rate_limiter *limiter,
+                                     uint32_t count)
+{
+    asx_rate_slot *s;
+    asx_status st;
+
+    st = rate_begin(limiter, count, &s);
+    if (st != ASX_OK) return st;
+    if (s->tokens < count) return ASX_E_WOULD_BLOCK;
+    s->tokens -= count;
+    return ASX_OK;
+}
+
+asx_status asx_task_park_on_rate_limiter(asx_task_id task,
+                                         const asx_rate_limiter *limiter,
+                                         uint32_t count)
+{
+    asx_timer_wheel *wheel = asx_timer_wheel_global();
+    asx_rate_slot *s;
+    asx_task_slot *t;
+    asx_time due;
+    asx_status st;
+
+    st = rate_begin(limiter, count, &s);
+    if (st != ASX_OK) return st;
+    st = asx_task_slot_lookup(task, &t);
+    if (st != ASX_OK) return st;
+    if (t->region != s->region) return ASX_E_INVALID_ARGUMENT;
+    if (s->tokens >= count) return ASX_OK; /* polled again, takes them */
+
+    /* count - tokens <= burst, and burst * interval_ns fits */
+    due = s->last + (uint64_t)(count - s->tokens) * s->interval_ns;
+    if (!s->has_timer || !asx_timer_is_live(wheel, &s->timer) ||
+        due < s->timer_at) {
+        st = asx_timer_update(wheel, s->has_timer ? &s->timer : NULL,
+                              due, NULL, &s->timer);
+        if (st != ASX_OK) {
+            s->has_timer = 0;
+            return st;
+        }
+        s->has_timer = 1;
+        s->timer_at = due;
+    }
+    return asx_task_park_on_timer(task, &s->timer);
+}
+
+asx_status asx_rate_limiter_query(const asx_rate_limiter *limiter,
+                                  uint32_t *out_tokens)
+{
+    asx_rate_slot *s;
+    asx_status st;
+
+    if (out_tokens == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = rate_begin(limiter, 1u, &s);
+    if (st != ASX_OK) return st;
+    *out_tokens = s->tokens;
+    return ASX_OK;
+}
+
+asx_status asx_rate_limiter_destroy(const asx_rate_limiter *limiter)
+{
+    asx_rate_slot *s;
+    asx_region_slot *r;
+    uint32_t idx;
+    uint32_t *link;
+
+    if (limiter == NULL) return ASX_E_INVALID_ARGUMENT;
+    s = rate_lookup(limiter);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+
+    /* The region is open: closing it would have freed the limiter */
+    idx = limiter->token & 0xFFFFu;
+    if (asx_region_slot_lookup(s->region, &r) == ASX_OK) {
+        for (link = &r->rate_head; *link != ASX_RATE_LINK_NONE;
+             link = &g_rates[*link].next) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_RATE_LIMITERS");
+            if (*link == idx) {
+                *link = s->next;
+                break;
+            }
+        }
+    }
+    rate_release(s);
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Runtime integration                                                */
+/* ------------------------------------------------------------------ */
+
+void asx_rate_limiter_region_reclaim(uint32_t *head)
+{
+    uint32_t idx = *head;
+
+    while (idx != ASX_RATE_LINK_NONE) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_RATE_LIMITERS") */
+        uint32_t next = g_rates[idx].next;
+
+        rate_release(&g_rates[idx]);
+        idx = next;
+    }
+    *head = ASX_RATE_LINK_NONE;
+}
+
+void asx_rate_limiter_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_rate_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_RATE_LIMITERS");
+        /* Keep generations so handles from before the reset stay stale.
+         * Timers belong to the wheel, which is reset on its own. */
+        g_rates[i].live = 0;
+        g_rates[i].has_timer = 0;
+        g_rates[i].generation = (uint16_t)(g_rates[i].generation + 1u);
+        g_rates[i].next = (i + 1u < g_rate_count) ? i + 1u : ASX_RATE_LINK_NONE;
+    }
+    g_rate_free_head = g_rate_count != 0u ? 0u : ASX_RATE_LINK_NONE;
+}
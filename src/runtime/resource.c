@@ -4,17 +4,48 @@
  * Provides deterministic resource admission checks, capacity queries,
  * and point-in-time snapshots for diagnostics and replay validation.
  *
- * All queries inspect the walking-skeleton static arenas without
- * side effects. Admission checks are pure predicates — they never
- * allocate or modify state.
+ * All queries inspect the chunked arenas without side effects.
+ * Capacity covers slots already backed by chunks plus, while the
+ * allocator hook can still grow the arena, the chunks it could add up
+ * to ASX_ARENA_MAX_*. Admission checks are pure predicates — they
+ * never allocate or modify state.
+ *
+ * Claims are the exception: asx_resource_claim grows the arena until
+ * the claimed slots are backed and counts them per region and in
+ * total, and plain spawns and reserves ensure room past that total, so
+ * spending a claim never meets exhaustion. A region's quota bounds its
+ * live plus claimed tasks or obligations.
+ *
+ * Watermarks keep a window per kind (runtime_internal.h) that the
+ * lifecycle tests after each change of use; only a crossing reaches
+ * this file, which flips the side, re-arms the window, traces and
+ * calls back.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <stddef.h>
 #include <asx/core/resource.h>
+#include <asx/core/transition.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/slab.h>
 #include "runtime_internal.h"
+#include "context_internal.h"
+
+/* Block counts of the slab installed as the allocator hook, if any */
+static asx_resource_snapshot allocator_snapshot(void)
+{
+    const asx_runtime_hooks *hooks = asx_runtime_get_hooks();
+    asx_resource_snapshot snap;
+
+    if (hooks == NULL || hooks->allocator.malloc_fn != asx_slab_alloc ||
+        asx_slab_snapshot((asx_slab *)hooks->allocator.ctx, UINT32_MAX,
+                          &snap) != ASX_OK) {
+        snap.kind = ASX_RESOURCE_ALLOCATOR;
+        snap.capacity = snap.used = snap.remaining = 0;
+    }
+    return snap;
+}
 
 /* ------------------------------------------------------------------ */
 /* Global resource queries                                             */
@@ -22,10 +53,17 @@
 
 uint32_t asx_resource_capacity(asx_resource_kind kind)
 {
+    int grow = asx_arena_can_grow();
+
     switch (kind) {
-    case ASX_RESOURCE_REGION:     return ASX_MAX_REGIONS;
-    case ASX_RESOURCE_TASK:       return ASX_MAX_TASKS;
-    case ASX_RESOURCE_OBLIGATION: return ASX_MAX_OBLIGATIONS;
+    case ASX_RESOURCE_REGION:
+        return grow ? ASX_ARENA_MAX_REGIONS : g_region_capacity;
+    case ASX_RESOURCE_TASK:
+        return grow ? ASX_ARENA_MAX_TASKS : g_task_capacity;
+    case ASX_RESOURCE_OBLIGATION:
+        return grow ? ASX_ARENA_MAX_OBLIGATIONS : g_obligation_capacity;
+    case ASX_RESOURCE_ALLOCATOR:
+        return allocator_snapshot().capacity;
     case ASX_RESOURCE_KIND_COUNT: return 0;
     }
     return 0;
@@ -35,8 +73,9 @@ uint32_t asx_resource_used(asx_resource_kind kind)
 {
     switch (kind) {
     case ASX_RESOURCE_REGION:     return g_region_count;
-    case ASX_RESOURCE_TASK:       return g_task_count;
-    case ASX_RESOURCE_OBLIGATION: return g_obligation_count;
+    case ASX_RESOURCE_TASK:       return g_task_count - g_task_free_count;
+    case ASX_RESOURCE_OBLIGATION: return g_obligation_count - g_obligation_free_count;
+    case ASX_RESOURCE_ALLOCATOR:  return allocator_snapshot().used;
     case ASX_RESOURCE_KIND_COUNT: return 0;
     }
     return 0;
@@ -57,6 +96,10 @@ asx_status asx_resource_snapshot_get(asx_resource_kind kind,
     if (kind >= ASX_RESOURCE_KIND_COUNT)
         return ASX_E_INVALID_ARGUMENT;
 
+    if (kind == ASX_RESOURCE_ALLOCATOR) {
+        *out = allocator_snapshot();
+        return ASX_OK;
+    }
     out->kind      = kind;
     out->capacity  = asx_resource_capacity(kind);
     out->used      = asx_resource_used(kind);
@@ -78,11 +121,264 @@ asx_status asx_resource_admit(asx_resource_kind kind, uint32_t count)
         return ASX_E_INVALID_ARGUMENT;
 
     remaining = asx_resource_remaining(kind);
-    if (count > remaining) return ASX_E_RESOURCE_EXHAUSTED;
+    if (count > remaining || remaining - count < asx_resource_claimed(kind))
+        return ASX_E_RESOURCE_EXHAUSTED;
 
     return ASX_OK;
 }
 
+/* ------------------------------------------------------------------ */
+/* Claims and per-region quotas                                        */
+/* ------------------------------------------------------------------ */
+
+uint32_t asx_resource_claimed(asx_resource_kind kind)
+{
+    switch (kind) {
+    case ASX_RESOURCE_TASK:       return g_task_claimed;
+    case ASX_RESOURCE_OBLIGATION: return g_obligation_claimed;
+    case ASX_RESOURCE_REGION:
+    case ASX_RESOURCE_ALLOCATOR:
+    case ASX_RESOURCE_KIND_COUNT: return 0;
+    }
+    return 0;
+}
+
+asx_status asx_region_quota_admit(const asx_region_slot *r,
+                                  asx_resource_kind kind, uint32_t count)
+{
+    uint32_t quota;
+    uint32_t held;
+
+    if (kind == ASX_RESOURCE_TASK) {
+        quota = r->task_quota;
+        held = r->task_count + r->tasks_claimed;
+    } else {
+        quota = r->obligation_quota;
+        held = r->obligations_reserved + r->obligations_claimed;
+    }
+    if (quota == 0u) return ASX_OK;
+    if (held > quota || count > quota - held) return ASX_E_ADMISSION_LIMIT;
+    return ASX_OK;
+}
+
+asx_status asx_resource_claim(asx_region_id region, asx_resource_kind kind,
+                              uint32_t count, asx_resource_token *out)
+{
+    asx_region_slot *r;
+    asx_status st;
+
+    if (out == NULL || count == 0u) return ASX_E_INVALID_ARGUMENT;
+    if (kind != ASX_RESOURCE_TASK && kind != ASX_RESOURCE_OBLIGATION)
+        return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+    if (r->poisoned) return ASX_E_REGION_POISONED;
+    if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
+
+    st = asx_region_quota_admit(r, kind, count);
+    if (st != ASX_OK) return st;
+    st = asx_resource_admit(kind, count);
+    if (st != ASX_OK) return st;
+    st = asx_region_admission(region, r, kind,
+                              kind == ASX_RESOURCE_TASK ? ASX_ADMISSION_SPAWN
+                                                        : ASX_ADMISSION_OBLIGATION);
+    if (st != ASX_OK) return st;
+
+    /* Back every claimed slot now; admit bounded the sum */
+    if (kind == ASX_RESOURCE_TASK) {
+        if (asx_task_slots_ensure(g_task_claimed + count) != ASX_OK)
+            return ASX_E_RESOURCE_EXHAUSTED;
+        g_task_claimed += count;
+        r->tasks_claimed += count;
+    } else {
+        if (asx_obligation_slots_ensure(g_obligation_claimed + count) != ASX_OK)
+            return ASX_E_RESOURCE_EXHAUSTED;
+        g_obligation_claimed += count;
+        r->obligations_claimed += count;
+    }
+
+    out->region = region;
+    out->kind = kind;
+    out->count = count;
+    return ASX_OK;
+}
+
+asx_status asx_resource_token_spend(asx_resource_token *token,
+                                    asx_resource_kind kind,
+                                    asx_region_slot **out)
+{
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t *claimed;
+
+    if (token == NULL || token->kind != kind || token->count == 0u)
+        return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(token->region, &r);
+    if (st != ASX_OK) return st;
+    if (r->poisoned) return ASX_E_REGION_POISONED;
+    if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
+
+    claimed = kind == ASX_RESOURCE_TASK ? &r->tasks_claimed
+                                        : &r->obligations_claimed;
+    /* A copy of the token spent the region's claims already */
+    if (*claimed == 0u) return ASX_E_INVALID_STATE;
+
+    (*claimed)--;
+    if (kind == ASX_RESOURCE_TASK) {
+        g_task_claimed--;
+    } else {
+        g_obligation_claimed--;
+    }
+    token->count--;
+    *out = r;
+    return ASX_OK;
+}
+
+void asx_resource_token_release(asx_resource_token *token)
+{
+    asx_region_slot *r;
+    uint32_t n;
+
+    if (token == NULL || token->count == 0u) return;
+
+    /* A closed region already returned its claims */
+    if (asx_region_slot_lookup(token->region, &r) == ASX_OK) {
+        if (token->kind == ASX_RESOURCE_TASK) {
+            n = token->count < r->tasks_claimed ? token->count : r->tasks_claimed;
+            r->tasks_claimed -= n;
+            g_task_claimed -= n;
+        } else if (token->kind == ASX_RESOURCE_OBLIGATION) {
+            n = token->count < r->obligations_claimed ? token->count
+                                                      : r->obligations_claimed;
+            r->obligations_claimed -= n;
+            g_obligation_claimed -= n;
+        }
+    }
+    token->count = 0;
+}
+
+asx_status asx_resource_region_set_quota(asx_region_id region,
+                                         asx_resource_kind kind,
+                                         uint32_t limit)
+{
+    asx_region_slot *r;
+    asx_status st;
+
+    if (kind != ASX_RESOURCE_TASK && kind != ASX_RESOURCE_OBLIGATION)
+        return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+
+    if (kind == ASX_RESOURCE_TASK) {
+        r->task_quota = limit;
+    } else {
+        r->obligation_quota = limit;
+    }
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Watermarks                                                          */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    asx_resource_watermark cfg;   /* high == 0: none set */
+    int                    above;
+} watermark_state;
+
+static watermark_state g_watermark[ASX_RESOURCE_KIND_COUNT];
+
+/* One entry per asx_resource_kind, all open until a watermark is set */
+#define WATERMARK_WINDOWS_OPEN { \
+    { 0u, UINT32_MAX }, { 0u, UINT32_MAX }, \
+    { 0u, UINT32_MAX }, { 0u, UINT32_MAX } \
+}
+asx_watermark_window g_watermark_window[ASX_RESOURCE_KIND_COUNT] = WATERMARK_WINDOWS_OPEN;
+
+static const asx_watermark_window g_watermark_window_init[ASX_RESOURCE_KIND_COUNT] =
+    WATERMARK_WINDOWS_OPEN;
+static const asx_context_block g_resource_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_watermark),
+    ASX_CONTEXT_BLOCK_INIT(g_watermark_window, g_watermark_window_init)
+};
+
+const asx_context_module asx_resource_context = ASX_CONTEXT_MODULE(g_resource_blocks);
+
+static void watermark_arm(asx_resource_kind kind)
+{
+    const watermark_state *s = &g_watermark[kind];
+    asx_watermark_window *w = &g_watermark_window[kind];
+
+    if (s->cfg.high == 0u) {
+        w->base = 0;
+        w->span = UINT32_MAX;
+    } else if (!s->above) {
+        w->base = 0;              /* trips at used >= high */
+        w->span = s->cfg.high;
+    } else {
+        w->base = s->cfg.low + 1u; /* trips at used <= low */
+        w->span = UINT32_MAX - s->cfg.low - 1u;
+    }
+}
+
+void asx_watermark_cross(asx_resource_kind kind, uint32_t used)
+{
+    watermark_state *s = &g_watermark[kind];
+    asx_watermark_edge edge;
+
+    s->above = !s->above;
+    edge = s->above ? ASX_WATERMARK_HIGH : ASX_WATERMARK_LOW;
+    watermark_arm(kind);
+    asx_trace_emit(ASX_TRACE_WATERMARK, ASX_INVALID_ID,
+                   ASX_TRACE_WATERMARK_AUX(kind, edge, used));
+    if (s->cfg.fn != NULL) s->cfg.fn(s->cfg.ctx, kind, edge, used);
+}
+
+void asx_watermark_reset(void)
+{
+    uint32_t k;
+
+    for (k = 0; k < (uint32_t)ASX_RESOURCE_KIND_COUNT; k++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_RESOURCE_KIND_COUNT");
+        g_watermark[k].cfg.high = 0;
+        g_watermark[k].cfg.fn = NULL;
+        g_watermark[k].above = 0;
+        watermark_arm((asx_resource_kind)k);
+    }
+}
+
+asx_status asx_resource_set_watermark(asx_resource_kind kind,
+                                      const asx_resource_watermark *wm)
+{
+    watermark_state *s;
+
+    if (kind != ASX_RESOURCE_TASK && kind != ASX_RESOURCE_OBLIGATION)
+        return ASX_E_INVALID_ARGUMENT;
+    if (wm != NULL && (wm->high == 0u || wm->low >= wm->high))
+        return ASX_E_INVALID_ARGUMENT;
+
+    s = &g_watermark[kind];
+    if (wm == NULL) {
+        s->cfg.high = 0;
+        s->cfg.fn = NULL;
+        s->above = 0;
+    } else {
+        s->cfg = *wm;
+        s->above = asx_resource_used(kind) >= wm->high;
+    }
+    watermark_arm(kind);
+    return ASX_OK;
+}
+
+int asx_resource_watermark_high(asx_resource_kind kind)
+{
+    if (kind >= ASX_RESOURCE_KIND_COUNT) return 0;
+    return g_watermark[kind].above;
+}
+
 /* ------------------------------------------------------------------ */
 /* Per-region resource queries                                         */
 /* ------------------------------------------------------------------ */
@@ -98,11 +394,8 @@ asx_status asx_resource_region_capture_remaining(asx_region_id region,
     st = asx_region_slot_lookup(region, &r);
     if (st != ASX_OK) return st;
 
-    if (r->capture_used >= ASX_REGION_CAPTURE_ARENA_BYTES) {
-        *out_bytes = 0;
-    } else {
-        *out_bytes = ASX_REGION_CAPTURE_ARENA_BYTES - r->capture_used;
-    }
+    /* Room under the region's limit; chaining may still fail to allocate */
+    *out_bytes = r->capture_limit - r->capture_used;
     return ASX_OK;
 }
 
@@ -135,6 +428,7 @@ const char *asx_resource_kind_str(asx_resource_kind kind)
     case ASX_RESOURCE_REGION:     return "region";
     case ASX_RESOURCE_TASK:       return "task";
     case ASX_RESOURCE_OBLIGATION: return "obligation";
+    case ASX_RESOURCE_ALLOCATOR:  return "allocator";
     case ASX_RESOURCE_KIND_COUNT: return "unknown";
     }
     return "unknown";
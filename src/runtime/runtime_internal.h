@@ -1,8 +1,14 @@
 /*
  * runtime_internal.h — shared internal state for walking skeleton runtime
  *
- * NOT part of the public API. Used only by runtime .c translation units.
- * Phase 3 will replace static arenas with hook-backed dynamic allocation.
+ * NOT part of the public API. Used only by runtime .c translation units
+ * and, for region ownership of channels, by src/channel.
+ *
+ * Arenas are chunked slabs: chunk 0 is a static array of ASX_MAX_*
+ * slots, further chunks of the same size are allocated through
+ * asx_runtime_alloc on demand until the allocator is sealed. Slot
+ * addresses never move, so slot pointers and handles stay valid and
+ * index lookup is O(1) (one chunk-table load).
  *
  * SPDX-License-Identifier: MIT
  */
@@ -10,78 +16,762 @@
 #ifndef ASX_RUNTIME_INTERNAL_H
 #define ASX_RUNTIME_INTERNAL_H
 
+#include <asx/asx_config.h>
 #include <asx/asx_ids.h>
 #include <asx/asx_status.h>
 #include <asx/core/outcome.h>
 #include <asx/core/cleanup.h>
 #include <asx/core/cancel.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/snapshot.h>
+#include <asx/runtime/trace.h>
+#include <asx/time/timer_wheel.h>
 
 /* -------------------------------------------------------------------
- * Arena slot types (walking skeleton: fixed-size)
+ * Arena slot types
  * ------------------------------------------------------------------- */
 
+/* Sentinel for "no task" in intrusive per-region ready-list links */
+#define ASX_TASK_LINK_NONE UINT32_MAX
+
+/* Sentinel for "no slot" in the region and obligation free lists */
+#define ASX_REGION_LINK_NONE     UINT32_MAX
+#define ASX_OBLIGATION_LINK_NONE UINT32_MAX
+
+/* Sentinel for "no channel" in per-region channel-list links */
+#define ASX_CHANNEL_LINK_NONE UINT32_MAX
+
+/* Sentinel for "no cell" in oneshot links (region lists, obligations) */
+#define ASX_ONESHOT_LINK_NONE UINT32_MAX
+
+/* Sentinel for "no group" in task group links (region lists, free list) */
+#define ASX_GROUP_LINK_NONE UINT32_MAX
+
+/* Sentinel for "no semaphore" in semaphore links (region lists, free list) */
+#define ASX_SEMAPHORE_LINK_NONE UINT32_MAX
+
+/* Sentinel for "no limiter" in rate limiter links (region lists, free list) */
+#define ASX_RATE_LINK_NONE UINT32_MAX
+
+/* Slot keys. A slot that has been handed out stores the (type tag,
+ * generation) pair of the handles naming it, packed into 32 bits the
+ * way asx_handle_key extracts them from a handle; a never-used slot
+ * stores 0. Lookups validate tag, liveness and generation with one
+ * compare of the two keys. */
+static inline uint32_t asx_slot_key(uint16_t type_tag, asx_generation generation)
+{
+    return ((uint32_t)type_tag << ASX_HANDLE_FIELD_BITS)
+         | ((uint32_t)generation & ASX_HANDLE_FIELD_MASK);
+}
+
+static inline uint32_t asx_handle_key(uint64_t h)
+{
+    return asx_slot_key(asx_handle_type_tag(h), asx_handle_generation(h));
+}
+
+static inline int asx_slot_live(uint32_t key)
+{
+    return key != 0u;
+}
+
+static inline asx_generation asx_slot_generation(uint32_t key)
+{
+    return (asx_generation)(key & ASX_HANDLE_FIELD_MASK);
+}
+
 typedef struct {
     asx_region_state   state;
     uint32_t           task_count;     /* live (non-completed) tasks */
     uint32_t           task_total;     /* total spawned tasks */
-    uint16_t           generation;     /* increments on slot reclaim */
-    int                alive;          /* 1 if slot in use */
+    uint32_t           tasks_uncancelled;    /* live tasks, no cancel pending */
+    uint32_t           obligations_reserved; /* live RESERVED obligations */
+    /* Capacity held by outstanding asx_resource_token claims, and the
+     * per-region ceilings on live + claimed (0 = no quota) */
+    uint32_t           tasks_claimed;
+    uint32_t           obligations_claimed;
+    uint32_t           task_quota;
+    uint32_t           obligation_quota;
+    uint32_t           key;            /* asx_slot_key; generation increments on reclaim */
+    uint32_t           free_next;      /* free-list link once CLOSED */
     int                poisoned;       /* 1 if region has been poisoned (containment) */
+    /* Deadline cancel: while deadline != 0, deadline_timer is live on
+     * the global wheel so an idle scheduler wakes for it */
+    asx_time           deadline;
+    asx_timer_handle   deadline_timer;
+    /* Admission policy consulted by spawn and reserve while set */
+    asx_overload_policy admission;
+    int                admission_on;
     asx_cleanup_stack  cleanup;        /* LIFO cleanup for finalization */
-    uint8_t            capture_arena[ASX_REGION_CAPTURE_ARENA_BYTES];
-    uint32_t           capture_used;
+    /* Capture arena: bump allocation in capture_cur, which is
+     * capture_inline or the newest block on capture_chain */
+    uint8_t           *capture_cur;
+    uint32_t           capture_cur_size;
+    uint32_t           capture_cur_used;
+    uint32_t           capture_used;    /* bytes handed out, all blocks */
+    uint32_t           capture_limit;
+    void              *capture_chain;   /* allocated blocks, newest first */
+    uint8_t            capture_inline[ASX_REGION_CAPTURE_INLINE_BYTES];
+    /* Intrusive ready list of non-terminal tasks, ascending arena index */
+    uint32_t           ready_head;
+    uint32_t           ready_tail;
+    /* Intrusive list of owned channels (slot indices), newest first */
+    uint32_t           channel_head;
+    /* Intrusive doubly-linked list of owned oneshot cells */
+    uint32_t           oneshot_head;
+    /* Intrusive list of owned task groups, newest first */
+    uint32_t           group_head;
+    /* Intrusive list of owned semaphores, newest first */
+    uint32_t           sem_head;
+    /* Intrusive list of owned rate limiters, newest first */
+    uint32_t           rate_head;
+    /* Intrusive doubly-linked list of live (non-completed) tasks in
+     * spawn (ascending arena index) order, through asx_task_cold
+     * region_prev/region_next. Joined on spawn, left on completion. */
+    uint32_t           task_head;
+    uint32_t           task_tail;
+    /* Completed tasks whose outcome is unobserved, completion order,
+     * same links. Each leaves for the task free list when its outcome
+     * is read or the region reaches CLOSED. */
+    uint32_t           done_head;
+    uint32_t           done_tail;
+    /* Intrusive doubly-linked list of RESERVED obligations in reserve
+     * order, through asx_obligation_slot region_prev/region_next.
+     * Joined on reserve, left on commit or abort. */
+    uint32_t           obligation_head;
+    uint32_t           obligation_tail;
+    /* Leased RESERVED obligations and the earliest lease deadline
+     * among them (0 = none); a later deadline may linger until the
+     * next expiry check recomputes it */
+    uint32_t           leases;
+    asx_time           lease_next;
+    /* Captured-state destructors deferred by completions while
+     * dtor_batch != 0, oldest first, through a lifecycle.c side table.
+     * Each scheduler round runs up to dtor_batch; drain runs the rest
+     * before the cleanup stack. */
+    uint32_t           dtor_head;
+    uint32_t           dtor_tail;
+    uint32_t           dtor_pending;
+    uint32_t           dtor_batch;
+    /* Region tree (slot indices, ASX_REGION_LINK_NONE at ends). Children
+     * are kept in open order and leave the list on reaching CLOSED. */
+    uint32_t           parent;
+    uint32_t           first_child;
+    uint32_t           last_child;
+    uint32_t           prev_sibling;
+    uint32_t           next_sibling;
 } asx_region_slot;
 
+/* Sentinel for "no attribution" in asx_task_cold.cancel_attr */
+#define ASX_CANCEL_ATTR_NONE UINT32_MAX
+
+/* Cold per-task state: touched on spawn, completion, cancellation and
+ * result queries, never on a plain poll. Lives in an array parallel to
+ * the hot slots so a scheduler round only streams hot cache lines.
+ * The outcome is stored as its severity and the cancel reason as its
+ * kind; origin attribution, which most tasks never get, lives in a
+ * side table entry referenced by cancel_attr. */
 typedef struct {
-    asx_task_state   state;
-    asx_region_id    region;
-    asx_task_poll_fn poll_fn;
-    void            *user_data;
-    asx_outcome      outcome;
-    uint16_t         generation;     /* increments on slot reclaim */
-    int              alive;
-    void            *captured_state;
-    uint32_t         captured_size;
+    void              *captured_state;
     asx_task_state_dtor_fn captured_dtor;
+    uint64_t           park_key;        /* wait-source key while park_kind set */
+    asx_time           sched_deadline;  /* EDF ordering deadline, 0 = none */
+    asx_time           cancel_ns;       /* clock at first cancel, 0 = unknown */
+    uint64_t           local[ASX_TASK_LOCAL_WORDS]; /* task-local words */
+    uint32_t           captured_size;
     /* Cancellation tracking (bd-2cw.3) */
-    asx_cancel_phase   cancel_phase;
-    asx_cancel_reason  cancel_reason;
     uint32_t           cancel_epoch;
+    uint32_t           cancel_attr;     /* side table entry or ASX_CANCEL_ATTR_NONE */
+    uint32_t           region_prev;     /* region live/done list links; */
+    uint32_t           region_next;     /* region_next links the free list */
+    uint32_t           sem_prev;        /* semaphore wait queue links */
+    uint32_t           sem_next;
+    uint32_t           wait_prev;       /* waker wait list links while parked */
+    uint32_t           wait_next;
+    uint32_t           park_seq;        /* park order, merges wait lists */
+    asx_cancel_phase   cancel_phase;
+    uint8_t            outcome;         /* asx_outcome_severity */
+    uint8_t            cancel_kind;     /* asx_cancel_kind, valid once cancelled */
+    uint8_t            reclaimed;       /* 1 once on the task free list */
+    uint8_t            group;           /* task group index + 1, 0 = none */
+    uint8_t            sem;             /* semaphore index + 1 while queued, 0 = none */
+    uint8_t            sem_granted;     /* 1 once handed a permit not yet taken */
+    uint8_t            lane;            /* parallel lane + 1 while in one, 0 = none */
+} asx_task_cold;
+
+static inline asx_outcome asx_task_cold_outcome(const asx_task_cold *cold)
+{
+    return asx_outcome_make((asx_outcome_severity)cold->outcome);
+}
+
+static inline void asx_task_cold_set_outcome(asx_task_cold *cold,
+                                             asx_outcome_severity severity)
+{
+    cold->outcome = (uint8_t)severity;
+}
+
+/* Hot per-task state: everything the scheduler reads or writes on each
+ * poll, packed to stay within one 64-byte cache line. */
+typedef struct {
+    asx_region_id      region;
+    asx_task_poll_fn   poll_fn;
+    void              *user_data;
+    asx_task_cold     *cold;            /* parallel cold slot, set on spawn */
+    asx_task_state     state;
     uint32_t           cleanup_polls_remaining;
-    int                cancel_pending;  /* 1 if cancel signal delivered */
+    /* Region ready-list links (arena indices, ASX_TASK_LINK_NONE at ends) */
+    uint32_t           ready_prev;
+    uint32_t           ready_next;
+    uint32_t           key;             /* asx_slot_key; generation increments on reclaim */
+    uint8_t            cancel_pending;  /* 1 if cancel signal delivered */
+    uint8_t            ready_linked;    /* 1 while on the region ready list */
+    uint8_t            park_kind;       /* asx_park_kind; set while parked or park requested */
+    uint8_t            parked;          /* 1 while on the park list (links reused) */
+    uint8_t            priority;        /* ASX_SCHED_MODE_PRIORITY level */
+    uint8_t            hot_polls;       /* immediate re-polls after PENDING */
+    uint16_t           sched_wait;      /* rounds passed over, saturating */
+    uint32_t           poll_cost;       /* reported cost not yet charged */
 } asx_task_slot;
 
 typedef struct {
     asx_obligation_state state;
     asx_region_id        region;
-    uint16_t             generation;
-    int                  alive;
+    uint32_t             key;          /* asx_slot_key; generation increments on reuse */
+    uint32_t             link;         /* oneshot cell while reserved (ASX_ONESHOT_LINK_NONE
+                                        * for none), free-list link once resolved */
+    uint32_t             region_prev;  /* region reserved-list links while */
+    uint32_t             region_next;  /* RESERVED, ASX_OBLIGATION_LINK_NONE at ends */
+    uint32_t             lease;        /* lease table entry, ASX_LEASE_NONE if unleased */
 } asx_obligation_slot;
 
 /* -------------------------------------------------------------------
  * Global arenas (defined in lifecycle.c)
+ *
+ * g_*_capacity is the number of slots currently backed by chunks.
+ * g_region_count is the region slot high-water mark; g_task_count and
+ * g_obligation_count are monotonic slot allocation cursors. CLOSED
+ * region slots, reclaimed task slots and resolved obligation slots wait
+ * on LIFO free lists (g_*_free_head) and are reused before the cursor
+ * moves, so open, spawn and reserve never scan.
  * ------------------------------------------------------------------- */
 
-extern asx_region_slot      g_regions[ASX_MAX_REGIONS];
+#define ASX_REGION_CHUNK_LIMIT     (ASX_ARENA_MAX_REGIONS / ASX_MAX_REGIONS)
+#define ASX_TASK_CHUNK_LIMIT       (ASX_ARENA_MAX_TASKS / ASX_MAX_TASKS)
+#define ASX_OBLIGATION_CHUNK_LIMIT (ASX_ARENA_MAX_OBLIGATIONS / ASX_MAX_OBLIGATIONS)
+
+extern asx_region_slot     *g_region_chunks[ASX_REGION_CHUNK_LIMIT];
+extern uint32_t             g_region_capacity;
 extern uint32_t             g_region_count;
+extern uint32_t             g_region_free_head;
 
-extern asx_task_slot        g_tasks[ASX_MAX_TASKS];
+extern asx_task_slot       *g_task_chunks[ASX_TASK_CHUNK_LIMIT];
+extern asx_task_cold       *g_task_cold_chunks[ASX_TASK_CHUNK_LIMIT];
+extern uint32_t             g_task_capacity;
 extern uint32_t             g_task_count;
+extern uint32_t             g_task_free_head;
+extern uint32_t             g_task_free_count;
+extern uint32_t             g_task_claimed;        /* all regions' tasks_claimed */
 
-extern asx_obligation_slot  g_obligations[ASX_MAX_OBLIGATIONS];
+extern asx_obligation_slot *g_obligation_chunks[ASX_OBLIGATION_CHUNK_LIMIT];
+extern uint32_t             g_obligation_capacity;
 extern uint32_t             g_obligation_count;
+extern uint32_t             g_obligation_free_head;
+extern uint32_t             g_obligation_free_count;
+extern uint32_t             g_obligation_claimed;  /* all regions' obligations_claimed */
+
+/* O(1) slot access. Callers guarantee idx < g_*_capacity. */
+static inline asx_region_slot *asx_region_at(uint32_t idx)
+{
+    return &g_region_chunks[idx / ASX_MAX_REGIONS][idx % ASX_MAX_REGIONS];
+}
+
+static inline asx_task_slot *asx_task_at(uint32_t idx)
+{
+    return &g_task_chunks[idx / ASX_MAX_TASKS][idx % ASX_MAX_TASKS];
+}
+
+static inline asx_task_cold *asx_task_cold_at(uint32_t idx)
+{
+    return &g_task_cold_chunks[idx / ASX_MAX_TASKS][idx % ASX_MAX_TASKS];
+}
+
+static inline asx_obligation_slot *asx_obligation_at(uint32_t idx)
+{
+    return &g_obligation_chunks[idx / ASX_MAX_OBLIGATIONS][idx % ASX_MAX_OBLIGATIONS];
+}
+
+/* Per-task poll profile side table (ASX_TASK_PROFILE), parallel to the
+ * hot and cold slots. mark is the clock at spawn or at the end of the
+ * last poll while pending, and the poll start while in_poll is set. */
+#if ASX_TASK_PROFILE
+typedef struct {
+    asx_task_profile stats;
+    asx_time         mark;
+    uint8_t          in_poll;   /* 1 when poll_begin read the clock */
+} asx_task_profile_slot;
+
+extern asx_task_profile_slot *g_task_profile_chunks[ASX_TASK_CHUNK_LIMIT];
+
+static inline asx_task_profile_slot *asx_task_profile_at(uint32_t idx)
+{
+    return &g_task_profile_chunks[idx / ASX_MAX_TASKS][idx % ASX_MAX_TASKS];
+}
+
+/* Close the pending span and start timing a poll. */
+static inline void asx_task_profile_poll_begin(uint32_t idx)
+{
+    asx_task_profile_slot *p = asx_task_profile_at(idx);
+    asx_time now;
+
+    p->in_poll = 0;
+    if (asx_runtime_now_ns(&now) != ASX_OK) return;
+    if (now > p->mark) p->stats.pending_ns += now - p->mark;
+    p->mark = now;
+    p->in_poll = 1;
+}
+
+/* Count the poll and open the next pending span. A clock read that
+ * fails on either side counts the poll with zero duration. */
+static inline void asx_task_profile_poll_end(uint32_t idx)
+{
+    asx_task_profile_slot *p = asx_task_profile_at(idx);
+    asx_time now;
+    uint64_t ns = 0;
+
+    p->stats.polls++;
+    if (asx_runtime_now_ns(&now) != ASX_OK) return;
+    if (p->in_poll && now > p->mark) ns = now - p->mark;
+    p->mark = now;
+    p->in_poll = 0;
+    p->stats.poll_ns_total += ns;
+    if (ns > p->stats.poll_ns_max) p->stats.poll_ns_max = ns;
+}
+#endif
+
+/* Snapshot dirty words (snapshot.c): one bit per slot the snapshot
+ * covers, set by every transition that changes a captured field and
+ * cleared by asx_runtime_snapshot_capture. Slots beyond the snapshot's
+ * capacity are not tracked. */
+#define ASX_SNAPSHOT_DIRTY_WORDS(n) (((uint32_t)(n) + 63u) / 64u)
+
+extern uint64_t g_snapshot_dirty_regions[ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_REGIONS)];
+extern uint64_t g_snapshot_dirty_tasks[ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_TASKS)];
+extern uint64_t g_snapshot_dirty_obligations[ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_OBLIGATIONS)];
+
+/* Forget the dirty bits and force the next capture to be full. */
+void asx_snapshot_reset(void);
+
+static inline void asx_snapshot_touch_region(uint32_t idx)
+{
+    if (idx < ASX_SNAPSHOT_MAX_REGIONS) {
+        g_snapshot_dirty_regions[idx / 64u] |= (uint64_t)1 << (idx % 64u);
+    }
+}
+
+static inline void asx_snapshot_touch_task(uint32_t idx)
+{
+    if (idx < ASX_SNAPSHOT_MAX_TASKS) {
+        g_snapshot_dirty_tasks[idx / 64u] |= (uint64_t)1 << (idx % 64u);
+    }
+}
+
+static inline void asx_snapshot_touch_obligation(uint32_t idx)
+{
+    if (idx < ASX_SNAPSHOT_MAX_OBLIGATIONS) {
+        g_snapshot_dirty_obligations[idx / 64u] |= (uint64_t)1 << (idx % 64u);
+    }
+}
+
+/* Record now minus cancel_ns in the cancel latency histogram
+ * (cancellation.c). */
+void asx_task_cancel_latency_record(asx_time cancel_ns);
+
+/* Task group integration (task_group.c). completed counts a member's
+ * completion and wakes the group's waiter once the awaited count is
+ * reached; wait validates a park request and returns the park key;
+ * region_reclaim frees the region's groups at close; reset empties
+ * the pool and is called by asx_runtime_reset. */
+void asx_task_group_completed(uint32_t group, asx_outcome_severity severity);
+asx_status asx_task_group_wait(const asx_task_group *group, uint32_t count,
+                               uint64_t *out_key);
+void asx_task_group_region_reclaim(uint32_t *head);
+void asx_task_group_reset(void);
+
+/* Semaphore integration (semaphore.c). wait validates a park request
+ * and reports whether the task was already handed its permit;
+ * task_left takes a task being cancelled or completed off its
+ * semaphore in O(1), passing on a permit it was handed but never took;
+ * region_reclaim frees the region's semaphores at close; reset empties
+ * the pool and is called by asx_runtime_reset. */
+asx_status asx_semaphore_wait(const asx_semaphore *sem, asx_task_id task,
+                              uint64_t *out_key, int *out_granted);
+void asx_semaphore_task_left(uint32_t task_idx);
+void asx_semaphore_region_reclaim(uint32_t *head);
+void asx_semaphore_reset(void);
+
+/* Rate limiter integration (rate_limiter.c). region_reclaim frees the
+ * region's limiters at close, cancelling their refill timers; reset
+ * empties the pool and is called by asx_runtime_reset. */
+void asx_rate_limiter_region_reclaim(uint32_t *head);
+void asx_rate_limiter_reset(void);
+
+/* Parallel lane membership (parallel.c). Lanes persist across parallel
+ * runs over the same regions; every site that spawns, cancels, parks,
+ * wakes or completes a task calls asx_parallel_lane_sync so the task
+ * joins, moves between or leaves lanes without a region rescan. A
+ * no-op for tasks of regions the lanes do not cover. Runtime reset
+ * drops the lanes so the next run classifies afresh. */
+void asx_parallel_lane_sync(uint32_t task_idx);
+void asx_parallel_lanes_invalidate(void);
+
+/* Account for task task_idx of region reaching COMPLETED. Call at
+ * every completion site in place of a bare task_count decrement so the
+ * quiescence counters and the live-task list stay exact. The task moves
+ * to the region's done list, counts toward its task group and leaves
+ * any semaphore queue and parallel lane; task and region are marked for the next
+ * snapshot capture. The outcome must already be set. */
+static inline void asx_region_task_completed(asx_region_slot *region,
+                                             uint32_t task_idx)
+{
+    const asx_task_slot *task = asx_task_at(task_idx);
+    asx_task_cold *cold = task->cold;
+
+    region->task_count--;
+    if (cold->group != 0u) {
+        asx_task_group_completed(cold->group - 1u,
+                                 (asx_outcome_severity)cold->outcome);
+    }
+    if (cold->sem != 0u) {
+        asx_semaphore_task_left(task_idx);
+    }
+    asx_snapshot_touch_region(asx_handle_slot(task->region));
+    asx_snapshot_touch_task(task_idx);
+    if (!task->cancel_pending) {
+        region->tasks_uncancelled--;
+    } else if (cold->cancel_ns != 0) {
+        asx_task_cancel_latency_record(cold->cancel_ns);
+    }
+
+    if (cold->region_prev != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(cold->region_prev)->region_next = cold->region_next;
+    } else {
+        region->task_head = cold->region_next;
+    }
+    if (cold->region_next != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(cold->region_next)->region_prev = cold->region_prev;
+    } else {
+        region->task_tail = cold->region_prev;
+    }
+    cold->region_prev = region->done_tail;
+    cold->region_next = ASX_TASK_LINK_NONE;
+    if (region->done_tail != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(region->done_tail)->region_next = task_idx;
+    } else {
+        region->done_head = task_idx;
+    }
+    region->done_tail = task_idx;
+    asx_parallel_lane_sync(task_idx);
+}
+
+/* Pre-order successor of region slot idx within the subtree rooted at
+ * root, or ASX_REGION_LINK_NONE once the subtree is done. Walking from
+ * root visits root, then each child's subtree in open order, touching
+ * only the subtree's slots. */
+static inline uint32_t asx_region_preorder_next(uint32_t root, uint32_t idx)
+{
+    const asx_region_slot *r = asx_region_at(idx);
+
+    if (r->first_child != ASX_REGION_LINK_NONE) return r->first_child;
+    while (idx != root) {
+        ASX_CHECKPOINT_WAIVER("bounded by region tree depth");
+        r = asx_region_at(idx);
+        if (r->next_sibling != ASX_REGION_LINK_NONE) return r->next_sibling;
+        idx = r->parent;
+    }
+    return ASX_REGION_LINK_NONE;
+}
+
+/* Handle for a live region slot. */
+static inline asx_region_id asx_region_handle_at(uint32_t idx)
+{
+    const asx_region_slot *r = asx_region_at(idx);
+
+    return asx_handle_pack(ASX_TYPE_REGION,
+                           (uint16_t)(1u << (unsigned)r->state),
+                           asx_handle_pack_index(asx_slot_generation(r->key), idx));
+}
+
+/* ASX_TRY task context (src/core/status.c), worker-local. Poll loops
+ * set it directly around each poll instead of calling
+ * asx_error_ledger_bind_task. */
+extern ASX_THREAD_LOCAL asx_task_id g_asx_ledger_bound_task;
+
+static inline void asx_ledger_bind(asx_task_id tid)
+{
+    g_asx_ledger_bound_task = tid;
+}
+
+/* Containment policy on kernel paths; a constant under
+ * ASX_STATIC_PROFILE so the other policies' branches fold away. */
+static inline asx_containment_policy asx_containment_policy_kernel(void)
+{
+#if ASX_STATIC_PROFILE
+    return (asx_containment_policy)ASX_CONTAINMENT_POLICY_SELECTED;
+#else
+    return asx_containment_policy_active();
+#endif
+}
+
+/* 1 when another chunk could be obtained from the allocator hook
+ * (hooks installed and allocator not sealed). Pure query. */
+int asx_arena_can_grow(void);
 
 /* -------------------------------------------------------------------
  * Shared lookup functions (generation-safe, used across TUs)
+ *
+ * Inline so nearly every API call resolves its handle without a call:
+ * the slot index is bounds-checked, then the handle key is compared
+ * against the slot key. A miss goes out of line to pick the status.
  * ------------------------------------------------------------------- */
 
-ASX_MUST_USE asx_status asx_region_slot_lookup(asx_region_id id, asx_region_slot **out);
-ASX_MUST_USE asx_status asx_task_slot_lookup(asx_task_id id, asx_task_slot **out);
-ASX_MUST_USE asx_status asx_obligation_slot_lookup(asx_obligation_id id,
-                                                   asx_obligation_slot **out);
+/* Status for a handle whose key did not match: ASX_E_NOT_FOUND for a
+ * wrong or invalid tag, an out-of-range index (slot_key 0) or a never-
+ * used slot, ASX_E_STALE_HANDLE for a live slot of a newer generation. */
+ASX_MUST_USE asx_status asx_slot_lookup_miss(uint64_t id, uint16_t type_tag,
+                                             uint32_t slot_key);
+
+ASX_MUST_USE static inline asx_status asx_region_slot_lookup(asx_region_id id,
+                                                             asx_region_slot **out)
+{
+    uint32_t idx = asx_handle_slot(id);
+    uint32_t key = asx_handle_key(id);
+    asx_region_slot *r = idx < g_region_capacity ? asx_region_at(idx) : NULL;
+    uint32_t slot_key = r != NULL ? r->key : 0u;
+
+    if (key == slot_key && key != 0u) {
+        *out = r;
+        return ASX_OK;
+    }
+    *out = NULL;
+    return asx_slot_lookup_miss(id, ASX_TYPE_REGION, slot_key);
+}
+
+ASX_MUST_USE static inline asx_status asx_task_slot_lookup(asx_task_id id,
+                                                           asx_task_slot **out)
+{
+    uint32_t idx = asx_handle_slot(id);
+    uint32_t key = asx_handle_key(id);
+    asx_task_slot *t = idx < g_task_capacity ? asx_task_at(idx) : NULL;
+    uint32_t slot_key = t != NULL ? t->key : 0u;
+
+    if (key == slot_key && key != 0u) {
+        *out = t;
+        return ASX_OK;
+    }
+    *out = NULL;
+    return asx_slot_lookup_miss(id, ASX_TYPE_TASK, slot_key);
+}
+
+ASX_MUST_USE static inline asx_status asx_obligation_slot_lookup(asx_obligation_id id,
+                                                                 asx_obligation_slot **out)
+{
+    uint32_t idx = asx_handle_slot(id);
+    uint32_t key = asx_handle_key(id);
+    asx_obligation_slot *o = idx < g_obligation_capacity ? asx_obligation_at(idx) : NULL;
+    uint32_t slot_key = o != NULL ? o->key : 0u;
+
+    if (key == slot_key && key != 0u) {
+        *out = o;
+        return ASX_OK;
+    }
+    *out = NULL;
+    return asx_slot_lookup_miss(id, ASX_TYPE_OBLIGATION, slot_key);
+}
+
+/* Detach a region slot that just reached CLOSED from its parent's child
+ * list, reclaim its completed task slots, and put it on the free list
+ * so the next asx_region_open reuses it. With ASX_DEBUG_QUARANTINE the
+ * slot is detached but nothing is freed. */
+void asx_region_slot_retire(uint32_t region_idx);
+
+/* Grow the task or obligation arena until count slots can be taken
+ * without failing. Callers add g_*_claimed so claimed slots stay
+ * backed. Returns ASX_E_RESOURCE_EXHAUSTED at the arena ceiling. */
+ASX_MUST_USE asx_status asx_task_slots_ensure(uint32_t count);
+ASX_MUST_USE asx_status asx_obligation_slots_ensure(uint32_t count);
+
+/* Consult the region's attached overload policy against kind's load,
+ * shedding or refusing in the same call. */
+ASX_MUST_USE asx_status asx_region_admission(asx_region_id region,
+                                             asx_region_slot *r,
+                                             asx_resource_kind kind,
+                                             asx_admission_site site);
+
+/* Claims and quotas (resource.c). quota_admit refuses, with
+ * ASX_E_ADMISSION_LIMIT, count more of kind (TASK or OBLIGATION) past
+ * the region's quota. token_spend takes one claim from token for an
+ * open region and returns its slot. */
+ASX_MUST_USE asx_status asx_region_quota_admit(const asx_region_slot *r,
+                                               asx_resource_kind kind,
+                                               uint32_t count);
+ASX_MUST_USE asx_status asx_resource_token_spend(asx_resource_token *token,
+                                                 asx_resource_kind kind,
+                                                 asx_region_slot **out);
+
+/* Resource watermarks (resource.c). A kind's window is the band of use
+ * that crosses no edge, tested as one unsigned compare of used - base
+ * against span: under high while below, over low while above, every
+ * value with no watermark set. note is called after each change of a
+ * kind's use. */
+typedef struct {
+    uint32_t base;
+    uint32_t span;
+} asx_watermark_window;
+
+extern asx_watermark_window g_watermark_window[ASX_RESOURCE_KIND_COUNT];
+
+void asx_watermark_cross(asx_resource_kind kind, uint32_t used);
+void asx_watermark_reset(void);
+
+static inline void asx_watermark_note(asx_resource_kind kind, uint32_t used)
+{
+    const asx_watermark_window *w = &g_watermark_window[kind];
+
+    if (used - w->base >= w->span) asx_watermark_cross(kind, used);
+}
+
+/* Move every OPEN region below region_idx (not region_idx itself) to
+ * CLOSING, in pre-order, so the subtree admits no new work. */
+void asx_region_close_descendants(uint32_t region_idx);
+
+/* Region deadlines (cancellation.c). deadline_poll runs once per
+ * scheduler round: a passed deadline on the region or an ancestor
+ * cancels that region's subtree with ASX_CANCEL_DEADLINE. clear drops
+ * the deadline and its timer. */
+void asx_region_deadline_poll(uint32_t region_idx);
+void asx_region_deadline_clear(asx_region_slot *region);
+
+/* Obligation leases (lifecycle.c). lease_poll runs once per scheduler
+ * round and before drain checks the reserved count: every RESERVED
+ * obligation of the region whose lease has passed is aborted. */
+#define ASX_LEASE_NONE UINT32_MAX
+void asx_region_lease_poll(uint32_t region_idx);
+
+/* Cancel attribution side table (cancellation.c). Entries are taken
+ * when a cancel records an origin and go back when the task slot is
+ * reused; reset empties the table. */
+void asx_cancel_attr_reset(void);
+void asx_cancel_attr_release(asx_task_cold *cold);
+
+/* Back to round-robin without aging (scheduler.c) */
+void asx_scheduler_mode_reset(void);
+
+/* Charge t's reported cost to budget's cost quota and clear it
+ * (scheduler.c). The work is already done, so a cost above the
+ * remaining quota empties it instead of failing. */
+void asx_budget_charge_task(asx_budget *budget, asx_task_slot *t);
+
+/* Region ready list maintenance. The list holds every non-terminal
+ * task of the region in ascending arena index order so the scheduler
+ * can walk only runnable tasks while keeping the index tie-break.
+ * Insert is O(1) for the common append case; remove is O(1). */
+void asx_region_ready_reset(asx_region_slot *region);
+void asx_region_ready_insert(asx_region_slot *region, uint32_t task_idx);
+void asx_region_ready_remove(asx_region_slot *region, uint32_t task_idx);
+
+/* Append a RESERVED obligation to its region's reserved list (reserve
+ * and snapshot restore); obligation resolve unlinks it. */
+static inline void asx_region_obligation_append(asx_region_slot *region,
+                                                uint32_t obligation_idx)
+{
+    asx_obligation_slot *o = asx_obligation_at(obligation_idx);
+
+    o->region_prev = region->obligation_tail;
+    o->region_next = ASX_OBLIGATION_LINK_NONE;
+    if (region->obligation_tail != ASX_OBLIGATION_LINK_NONE) {
+        asx_obligation_at(region->obligation_tail)->region_next = obligation_idx;
+    } else {
+        region->obligation_head = obligation_idx;
+    }
+    region->obligation_tail = obligation_idx;
+}
+
+/* Waker integration (waker.c). Parked tasks sit on a global park list
+ * that reuses the ready_prev/ready_next links, and on a wait list per
+ * source hash through wait_prev/wait_next. The scheduler brackets
+ * every poll with poll_begin/poll_end so a park requested by the task
+ * itself is applied only after the poll returns ASX_E_PENDING. */
+void asx_waker_reset(void);
+void asx_waker_poll_begin(uint32_t task_idx);
+void asx_waker_poll_end(asx_region_slot *region, uint32_t task_idx,
+                        asx_status poll_result);
+void asx_task_wake_internal(uint32_t task_idx);
+
+/* Parked tasks the last asx_wake_source examined (waker.c) */
+uint32_t asx_waker_last_visits(void);
+
+/* Parallel batches: while active, parks from (concurrent) polls only
+ * record the request; asx_waker_poll_end applies each afterwards. */
+void asx_waker_batch_begin(void);
+void asx_waker_batch_end(void);
+
+/* Apply wakes recorded by asx_wake_source_deferred during a batch.
+ * Called on the calling thread after the batch's results (and parks)
+ * have been applied, so no wake can be lost to a pending park. */
+void asx_waker_flush_deferred(void);
+
+/* Per-worker trace staging for parallel batches (trace.c). Between
+ * enter and leave, asx_trace_emit on that thread appends to the
+ * worker's own buffer, stamped with (round, lane, arena index),
+ * instead of the ring. The calling thread then merges each poll's run
+ * into the ring in selection order. mark returns the buffer position a
+ * run will start at; merge emits the run starting there whose stamp
+ * matches. */
+void     asx_trace_stage_reset(uint32_t workers);
+void     asx_trace_stage_enter(uint32_t worker, uint32_t round,
+                               uint32_t lane, uint32_t slot);
+void     asx_trace_stage_leave(void);
+uint32_t asx_trace_stage_mark(uint32_t worker);
+/* Worker entered on the calling thread, UINT32_MAX outside a batch
+ * poll (and always in builds without staging). */
+uint32_t asx_trace_stage_worker(void);
+void     asx_trace_stage_merge(uint32_t worker, uint32_t begin,
+                               uint32_t round, uint32_t lane,
+                               uint32_t slot);
+
+/* Round mode (trace.c): hold the sequential scheduler's SCHED_POLL
+ * for tid in the current round record. Returns 0 when the caller must
+ * emit the event itself (round mode off or unavailable). */
+int asx_trace_round_poll(asx_task_id tid, uint32_t round);
+
+/* Coarse clock (scheduler.c). Both schedulers call round_begin at the
+ * top of every round and run_end on every return, so
+ * asx_runtime_coarse_now_ns caches one reading per round. */
+void asx_coarse_round_begin(void);
+void asx_coarse_run_end(void);
+
+/* Channel integration (mpsc.c). Close and reclaim every channel on the
+ * region's list, newest first, returning their storage; empties the
+ * list. Called by asx_region_drain once the region's tasks are done. */
+void asx_channel_region_reclaim(asx_region_id region, uint32_t *head);
+
+/* Re-derive the admission ceiling of every channel the region owns
+ * from its attached policy (none: the channel capacity). */
+void asx_channel_region_admission(const asx_region_slot *region);
+
+/* Oneshot integration (oneshot.c). resolved is called by obligation
+ * commit (committed 1) and abort (0) for the cell the obligation sends
+ * to; region_reclaim frees every cell on the region's list once its
+ * obligations are resolved; reset empties the cell pool and is called
+ * by asx_runtime_reset. */
+void asx_oneshot_resolved(uint32_t cell, int committed);
+void asx_oneshot_region_reclaim(uint32_t *head);
+void asx_oneshot_reset(void);
 
 /* Release captured state for a task exactly once. */
 void asx_task_release_capture_internal(asx_task_slot *task);
 
+/* Run up to max_calls of region's deferred captured-state destructors,
+ * oldest first. Returns how many ran. */
+uint32_t asx_region_dtor_flush(asx_region_slot *region, uint32_t max_calls);
+
 #endif /* ASX_RUNTIME_INTERNAL_H */
@@ -0,0 +1,766 @@
+/*
+ * scenario.c — in-process dsl-v1 scenario executor
+ *
+ * Compilation walks the JSON once with the codec scanners. Canonical
+ * serialization sorts keys, so an op's "args" arrive before its "op";
+ * each op's arguments are gathered into a scenario_args record and
+ * laid out by the opcode's scenario_opdef row once the op object
+ * closes. Names are interned into a per-compile table of slices into
+ * the input, so the program keeps only slot numbers.
+ *
+ * Running keeps one scenario_slot per name in a file-scope table,
+ * since spawned scenario tasks hold a pointer to theirs and the
+ * runtime they live in is itself global.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("scenario: loops walk the input JSON, the "
+ *   "name and keyword tables, or the program's ops, each bounded by "
+ *   "the input or a fixed table. The executor runs outside task polls.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/runtime/scenario.h>
+#include <asx/asx_config.h>
+#include <asx/runtime/runtime.h>
+#include <asx/core/channel.h>
+#include <asx/time/timer_wheel.h>
+#include "codec_internal.h"
+#include <string.h>
+
+/* String arguments; the first six name entities and double as their kinds */
+enum {
+    SCN_ARG_REGION = 0,
+    SCN_ARG_TASK,
+    SCN_ARG_OBLIGATION,
+    SCN_ARG_CHANNEL,
+    SCN_ARG_PERMIT,
+    SCN_ARG_TIMER,
+    SCN_ARG_KIND,
+    SCN_ARG_STATE,
+    SCN_ARG_STR_COUNT
+};
+
+/* Numeric arguments */
+enum {
+    SCN_NUM_POLLS = 0,
+    SCN_NUM_NS,
+    SCN_NUM_DEADLINE,
+    SCN_NUM_VALUE,
+    SCN_NUM_CAPACITY,
+    SCN_NUM_COUNT
+};
+
+#define SCN_NONE   (-1)
+#define SCN_ASSERT 0xFFu   /* opdef code: resolved by the named entity */
+#define SCN_AWAKE_BATCH 32u
+
+static const char *const g_scn_str_keys[SCN_ARG_STR_COUNT] = {
+    "region", "task", "obligation", "channel", "permit", "timer", "kind", "state"
+};
+
+static const char *const g_scn_num_keys[SCN_NUM_COUNT] = {
+    "polls", "ns", "deadline", "value", "capacity"
+};
+
+typedef struct {
+    const char *name;
+    uint8_t     code;
+    int8_t      a, b, c;      /* string argument bound to each slot */
+    int8_t      num;          /* numeric argument carried in arg */
+    uint8_t     required;     /* num has no default */
+    uint64_t    fallback;     /* its default */
+} scenario_opdef;
+
+static const scenario_opdef g_scn_opdefs[] = {
+    { "noop",              ASX_SCENARIO_NOOP,               SCN_NONE, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "SpawnRegion",       ASX_SCENARIO_SPAWN_REGION,       SCN_ARG_REGION, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "CloseRegion",       ASX_SCENARIO_CLOSE_REGION,       SCN_ARG_REGION, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "SpawnTask",         ASX_SCENARIO_SPAWN_TASK,         SCN_ARG_TASK, SCN_ARG_REGION, SCN_NONE, SCN_NUM_POLLS, 0, 1 },
+    { "PollTask",          ASX_SCENARIO_POLL_TASK,          SCN_ARG_REGION, SCN_NONE, SCN_NONE, SCN_NUM_POLLS, 0, 1 },
+    { "RequestCancel",     ASX_SCENARIO_REQUEST_CANCEL,     SCN_ARG_TASK, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "AckCancel",         ASX_SCENARIO_ACK_CANCEL,         SCN_ARG_TASK, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "ReserveObligation", ASX_SCENARIO_RESERVE_OBLIGATION, SCN_ARG_OBLIGATION, SCN_ARG_REGION, SCN_NONE, SCN_NONE, 0, 0 },
+    { "CommitObligation",  ASX_SCENARIO_COMMIT_OBLIGATION,  SCN_ARG_OBLIGATION, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "AbortObligation",   ASX_SCENARIO_ABORT_OBLIGATION,   SCN_ARG_OBLIGATION, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "ChannelReserve",    ASX_SCENARIO_CHANNEL_RESERVE,    SCN_ARG_CHANNEL, SCN_ARG_PERMIT, SCN_ARG_REGION, SCN_NUM_CAPACITY, 0, 4 },
+    { "ChannelSend",       ASX_SCENARIO_CHANNEL_SEND,       SCN_ARG_PERMIT, SCN_NONE, SCN_NONE, SCN_NUM_VALUE, 0, 0 },
+    { "ChannelAbort",      ASX_SCENARIO_CHANNEL_ABORT,      SCN_ARG_PERMIT, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "TimerRegister",     ASX_SCENARIO_TIMER_REGISTER,     SCN_ARG_TIMER, SCN_NONE, SCN_NONE, SCN_NUM_DEADLINE, 1, 0 },
+    { "TimerCancel",       ASX_SCENARIO_TIMER_CANCEL,       SCN_ARG_TIMER, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 },
+    { "AdvanceTime",       ASX_SCENARIO_ADVANCE_TIME,       SCN_NONE, SCN_NONE, SCN_NONE, SCN_NUM_NS, 1, 0 },
+    { "Assert",            SCN_ASSERT,                      SCN_NONE, SCN_NONE, SCN_NONE, SCN_NONE, 0, 0 }
+};
+
+/* Indexed by asx_cancel_kind */
+static const char *const g_scn_cancel_kinds[] = {
+    "User", "Timeout", "Deadline", "PollQuota", "CostBudget", "FailFast",
+    "RaceLost", "LinkedExit", "Parent", "Resource", "Shutdown"
+};
+
+/* Indexed by asx_region_state, asx_task_state, asx_obligation_state */
+static const char *const g_scn_region_states[] = {
+    "Open", "Closing", "Draining", "Finalizing", "Closed"
+};
+static const char *const g_scn_task_states[] = {
+    "Created", "Running", "CancelRequested", "Cancelling", "Finalizing",
+    "Completed"
+};
+static const char *const g_scn_obligation_states[] = {
+    "Reserved", "Committed", "Aborted", "Leaked"
+};
+
+#define SCN_STATUS(s) { #s, s }
+
+static const struct {
+    const char *name;
+    asx_status  status;
+} g_scn_statuses[] = {
+    SCN_STATUS(ASX_OK),
+    SCN_STATUS(ASX_E_PENDING),
+    SCN_STATUS(ASX_E_INVALID_ARGUMENT),
+    SCN_STATUS(ASX_E_INVALID_STATE),
+    SCN_STATUS(ASX_E_NOT_FOUND),
+    SCN_STATUS(ASX_E_ALREADY_EXISTS),
+    SCN_STATUS(ASX_E_BUFFER_TOO_SMALL),
+    SCN_STATUS(ASX_E_INVALID_TRANSITION),
+    SCN_STATUS(ASX_E_REGION_NOT_FOUND),
+    SCN_STATUS(ASX_E_REGION_CLOSED),
+    SCN_STATUS(ASX_E_REGION_AT_CAPACITY),
+    SCN_STATUS(ASX_E_REGION_NOT_OPEN),
+    SCN_STATUS(ASX_E_ADMISSION_CLOSED),
+    SCN_STATUS(ASX_E_ADMISSION_LIMIT),
+    SCN_STATUS(ASX_E_REGION_POISONED),
+    SCN_STATUS(ASX_E_TASK_NOT_FOUND),
+    SCN_STATUS(ASX_E_SCHEDULER_UNAVAILABLE),
+    SCN_STATUS(ASX_E_NAME_CONFLICT),
+    SCN_STATUS(ASX_E_TASK_NOT_COMPLETED),
+    SCN_STATUS(ASX_E_POLL_BUDGET_EXHAUSTED),
+    SCN_STATUS(ASX_E_OBLIGATION_ALREADY_RESOLVED),
+    SCN_STATUS(ASX_E_UNRESOLVED_OBLIGATIONS),
+    SCN_STATUS(ASX_E_CANCELLED),
+    SCN_STATUS(ASX_E_WITNESS_PHASE_REGRESSION),
+    SCN_STATUS(ASX_E_WITNESS_REASON_WEAKENED),
+    SCN_STATUS(ASX_E_WITNESS_TASK_MISMATCH),
+    SCN_STATUS(ASX_E_WITNESS_REGION_MISMATCH),
+    SCN_STATUS(ASX_E_WITNESS_EPOCH_MISMATCH),
+    SCN_STATUS(ASX_E_DISCONNECTED),
+    SCN_STATUS(ASX_E_WOULD_BLOCK),
+    SCN_STATUS(ASX_E_CHANNEL_FULL),
+    SCN_STATUS(ASX_E_CHANNEL_NOT_DRAINED),
+    SCN_STATUS(ASX_E_TIMER_NOT_FOUND),
+    SCN_STATUS(ASX_E_TIMERS_PENDING),
+    SCN_STATUS(ASX_E_TIMER_DURATION_EXCEEDED),
+    SCN_STATUS(ASX_E_TASKS_STILL_ACTIVE),
+    SCN_STATUS(ASX_E_OBLIGATIONS_UNRESOLVED),
+    SCN_STATUS(ASX_E_REGIONS_NOT_CLOSED),
+    SCN_STATUS(ASX_E_INCOMPLETE_CHILDREN),
+    SCN_STATUS(ASX_E_QUIESCENCE_NOT_REACHED),
+    SCN_STATUS(ASX_E_QUIESCENCE_TASKS_LIVE),
+    SCN_STATUS(ASX_E_RESOURCE_EXHAUSTED),
+    SCN_STATUS(ASX_E_STALE_HANDLE),
+    SCN_STATUS(ASX_E_HOOK_MISSING),
+    SCN_STATUS(ASX_E_HOOK_INVALID),
+    SCN_STATUS(ASX_E_DETERMINISM_VIOLATION),
+    SCN_STATUS(ASX_E_ALLOCATOR_SEALED),
+    SCN_STATUS(ASX_E_AFFINITY_VIOLATION),
+    SCN_STATUS(ASX_E_AFFINITY_NOT_BOUND),
+    SCN_STATUS(ASX_E_AFFINITY_ALREADY_BOUND),
+    SCN_STATUS(ASX_E_AFFINITY_TRANSFER_REQUIRED),
+    SCN_STATUS(ASX_E_AFFINITY_TABLE_FULL),
+    SCN_STATUS(ASX_E_EQUIVALENCE_MISMATCH),
+    SCN_STATUS(ASX_E_REPLAY_MISMATCH)
+};
+
+#define SCN_COUNT(a) ((uint32_t)(sizeof(a) / sizeof((a)[0])))
+
+/* -------------------------------------------------------------------
+ * Compilation
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    asx_codec_slice slice[ASX_SCENARIO_MAX_NAMES];
+    uint8_t kind[ASX_SCENARIO_MAX_NAMES];
+    uint32_t count;
+} scenario_names;
+
+/* One op's arguments as read; a zero-length slice is absent */
+typedef struct {
+    asx_codec_slice str[SCN_ARG_STR_COUNT];
+    uint64_t num[SCN_NUM_COUNT];
+    uint8_t has_num[SCN_NUM_COUNT];
+} scenario_args;
+
+static int scenario_slice_is(asx_codec_slice s, const char *text)
+{
+    size_t n = strlen(text);
+    return s.len == n && memcmp(s.ptr, text, n) == 0;
+}
+
+/* Index of s in a keyword table, or -1 */
+static int scenario_lookup(asx_codec_slice s, const char *const *table,
+                           uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        if (scenario_slice_is(s, table[i])) return (int)i;
+    }
+    return -1;
+}
+
+/* Read a string without escapes: names and keywords never need them */
+static asx_status scenario_read_string(const char **cursor, asx_codec_slice *out)
+{
+    const char *start = asx_codec_json_skip_ws(*cursor);
+    const char *end;
+    asx_status st = asx_codec_json_scan_string(start, &end);
+
+    if (st != ASX_OK) return st;
+    out->ptr = start + 1;
+    out->len = (size_t)(end - start) - 2u;
+    if (memchr(out->ptr, '\\', out->len) != NULL) return ASX_E_INVALID_ARGUMENT;
+    *cursor = end;
+    return ASX_OK;
+}
+
+static asx_status scenario_read_u64(const char **cursor, uint64_t *out)
+{
+    return asx_codec_json_decode_u64(asx_codec_json_skip_ws(*cursor), cursor, out);
+}
+
+/* Step past the ':' after an object key */
+static asx_status scenario_read_colon(const char **cursor)
+{
+    const char *scan = asx_codec_json_skip_ws(*cursor);
+
+    if (*scan != ':') return ASX_E_INVALID_ARGUMENT;
+    *cursor = scan + 1;
+    return ASX_OK;
+}
+
+/* Object iteration: *more is 1 with *cursor at the next key, 0 once
+ * the closing brace is consumed. first marks the opening brace. */
+static asx_status scenario_next_member(const char **cursor, int first, int *more)
+{
+    const char *scan = asx_codec_json_skip_ws(*cursor);
+
+    if (first) {
+        if (*scan != '{') return ASX_E_INVALID_ARGUMENT;
+        scan = asx_codec_json_skip_ws(scan + 1);
+        if (*scan == '}') {
+            *cursor = scan + 1;
+            *more = 0;
+            return ASX_OK;
+        }
+    } else if (*scan == ',') {
+        scan = asx_codec_json_skip_ws(scan + 1);
+    } else if (*scan == '}') {
+        *cursor = scan + 1;
+        *more = 0;
+        return ASX_OK;
+    } else {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (*scan != '"') return ASX_E_INVALID_ARGUMENT;
+    *cursor = scan;
+    *more = 1;
+    return ASX_OK;
+}
+
+static asx_status scenario_skip_value(const char **cursor)
+{
+    return asx_codec_json_scan_value(asx_codec_json_skip_ws(*cursor), cursor, 0u);
+}
+
+static asx_status scenario_parse_args(const char **cursor, scenario_args *args)
+{
+    asx_codec_slice key;
+    int first = 1;
+    int more;
+    int idx;
+    asx_status st;
+
+    for (;;) {
+        st = scenario_next_member(cursor, first, &more);
+        if (st != ASX_OK || !more) return st;
+        first = 0;
+        st = scenario_read_string(cursor, &key);
+        if (st == ASX_OK) st = scenario_read_colon(cursor);
+        if (st != ASX_OK) return st;
+
+        idx = scenario_lookup(key, g_scn_str_keys, SCN_ARG_STR_COUNT);
+        if (idx >= 0) {
+            st = scenario_read_string(cursor, &args->str[idx]);
+            if (st == ASX_OK && args->str[idx].len == 0u) st = ASX_E_INVALID_ARGUMENT;
+        } else {
+            idx = scenario_lookup(key, g_scn_num_keys, SCN_NUM_COUNT);
+            if (idx >= 0) {
+                st = scenario_read_u64(cursor, &args->num[idx]);
+                args->has_num[idx] = 1;
+            } else {
+                st = scenario_skip_value(cursor);  /* later optional fields */
+            }
+        }
+        if (st != ASX_OK) return st;
+    }
+}
+
+static asx_status scenario_parse_expect(const char **cursor, asx_status *out)
+{
+    asx_codec_slice key;
+    asx_codec_slice name;
+    int first = 1;
+    int found = 0;
+    int more;
+    uint32_t i;
+    asx_status st;
+
+    for (;;) {
+        st = scenario_next_member(cursor, first, &more);
+        if (st != ASX_OK) return st;
+        if (!more) return found ? ASX_OK : ASX_E_INVALID_ARGUMENT;
+        first = 0;
+        st = scenario_read_string(cursor, &key);
+        if (st == ASX_OK) st = scenario_read_colon(cursor);
+        if (st != ASX_OK) return st;
+        if (!scenario_slice_is(key, "status")) {
+            st = scenario_skip_value(cursor);
+            if (st != ASX_OK) return st;
+            continue;
+        }
+        st = scenario_read_string(cursor, &name);
+        if (st != ASX_OK) return st;
+        for (i = 0; i < SCN_COUNT(g_scn_statuses); i++) {
+            if (scenario_slice_is(name, g_scn_statuses[i].name)) break;
+        }
+        if (i == SCN_COUNT(g_scn_statuses)) return ASX_E_INVALID_ARGUMENT;
+        *out = g_scn_statuses[i].status;
+        found = 1;
+    }
+}
+
+/* Slot of name, interning it with kind on first use */
+static asx_status scenario_bind(scenario_names *names, asx_codec_slice name,
+                                int kind, uint8_t *out_slot)
+{
+    uint32_t i;
+
+    for (i = 0; i < names->count; i++) {
+        if (names->slice[i].len == name.len &&
+            memcmp(names->slice[i].ptr, name.ptr, name.len) == 0) {
+            if (names->kind[i] != (uint8_t)kind) return ASX_E_INVALID_ARGUMENT;
+            *out_slot = (uint8_t)i;
+            return ASX_OK;
+        }
+    }
+    if (names->count == ASX_SCENARIO_MAX_NAMES) return ASX_E_INVALID_ARGUMENT;
+    names->slice[names->count] = name;
+    names->kind[names->count] = (uint8_t)kind;
+    *out_slot = (uint8_t)names->count++;
+    return ASX_OK;
+}
+
+static asx_status scenario_bind_arg(scenario_names *names,
+                                    const scenario_args *args, int which,
+                                    uint8_t *out_slot)
+{
+    if (which == SCN_NONE) {
+        *out_slot = ASX_SCENARIO_NO_SLOT;
+        return ASX_OK;
+    }
+    if (args->str[which].len == 0u) return ASX_E_INVALID_ARGUMENT;
+    return scenario_bind(names, args->str[which], which, out_slot);
+}
+
+/* Assert: the one entity named picks the opcode and its state table */
+static asx_status scenario_build_assert(scenario_names *names,
+                                        const scenario_args *args,
+                                        asx_scenario_op *op)
+{
+    static const uint8_t codes[3] = {
+        ASX_SCENARIO_ASSERT_REGION, ASX_SCENARIO_ASSERT_TASK,
+        ASX_SCENARIO_ASSERT_OBLIGATION
+    };
+    static const char *const *const tables[3] = {
+        g_scn_region_states, g_scn_task_states, g_scn_obligation_states
+    };
+    static const uint32_t sizes[3] = {
+        SCN_COUNT(g_scn_region_states), SCN_COUNT(g_scn_task_states),
+        SCN_COUNT(g_scn_obligation_states)
+    };
+    int which = SCN_NONE;
+    int i;
+    int state;
+
+    for (i = SCN_ARG_REGION; i <= SCN_ARG_OBLIGATION; i++) {
+        if (args->str[i].len == 0u) continue;
+        if (which != SCN_NONE) return ASX_E_INVALID_ARGUMENT;
+        which = i;
+    }
+    if (which == SCN_NONE) return ASX_E_INVALID_ARGUMENT;
+    state = scenario_lookup(args->str[SCN_ARG_STATE], tables[which], sizes[which]);
+    if (state < 0) return ASX_E_INVALID_ARGUMENT;
+
+    op->code = codes[which];
+    op->arg = (uint64_t)state;
+    if (!(op->flags & ASX_SCENARIO_OP_EXPECT)) {
+        op->flags |= ASX_SCENARIO_OP_EXPECT;
+        op->expect = ASX_OK;
+    }
+    return scenario_bind(names, args->str[which], which, &op->a);
+}
+
+/* Lay out one op from its opcode row and gathered arguments */
+static asx_status scenario_build(scenario_names *names, asx_codec_slice opname,
+                                 const scenario_args *args, asx_scenario_op *op)
+{
+    const scenario_opdef *def = NULL;
+    uint32_t i;
+    int kind;
+    asx_status st;
+
+    for (i = 0; i < SCN_COUNT(g_scn_opdefs); i++) {
+        if (scenario_slice_is(opname, g_scn_opdefs[i].name)) {
+            def = &g_scn_opdefs[i];
+            break;
+        }
+    }
+    if (def == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (def->code == SCN_ASSERT) return scenario_build_assert(names, args, op);
+
+    op->code = def->code;
+    st = scenario_bind_arg(names, args, def->a, &op->a);
+    if (st == ASX_OK) st = scenario_bind_arg(names, args, def->b, &op->b);
+    if (st == ASX_OK) st = scenario_bind_arg(names, args, def->c, &op->c);
+    if (st != ASX_OK) return st;
+
+    if (def->num != SCN_NONE) {
+        if (args->has_num[def->num]) {
+            op->arg = args->num[def->num];
+        } else if (def->required) {
+            return ASX_E_INVALID_ARGUMENT;
+        } else {
+            op->arg = def->fallback;
+        }
+    }
+    if ((def->num == SCN_NUM_POLLS || def->num == SCN_NUM_CAPACITY) &&
+        (op->arg == 0u || op->arg > UINT32_MAX)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    if (op->code == ASX_SCENARIO_REQUEST_CANCEL) {
+        kind = 0;
+        if (args->str[SCN_ARG_KIND].len != 0u) {
+            kind = scenario_lookup(args->str[SCN_ARG_KIND], g_scn_cancel_kinds,
+                                   SCN_COUNT(g_scn_cancel_kinds));
+            if (kind < 0) return ASX_E_INVALID_ARGUMENT;
+        }
+        op->arg = (uint64_t)kind;
+    }
+    return ASX_OK;
+}
+
+static asx_status scenario_parse_op(const char **cursor, scenario_names *names,
+                                    asx_scenario_op *op)
+{
+    scenario_args args;
+    asx_codec_slice key;
+    asx_codec_slice opname = { NULL, 0 };
+    uint64_t id = 0;
+    int first = 1;
+    int more;
+    asx_status st;
+
+    memset(&args, 0, sizeof(args));
+    memset(op, 0, sizeof(*op));
+    op->a = ASX_SCENARIO_NO_SLOT;
+    op->b = ASX_SCENARIO_NO_SLOT;
+    op->c = ASX_SCENARIO_NO_SLOT;
+
+    for (;;) {
+        st = scenario_next_member(cursor, first, &more);
+        if (st != ASX_OK) return st;
+        if (!more) break;
+        first = 0;
+        st = scenario_read_string(cursor, &key);
+        if (st == ASX_OK) st = scenario_read_colon(cursor);
+        if (st != ASX_OK) return st;
+
+        if (scenario_slice_is(key, "args")) {
+            st = scenario_parse_args(cursor, &args);
+        } else if (scenario_slice_is(key, "expect")) {
+            st = scenario_parse_expect(cursor, &op->expect);
+            op->flags |= ASX_SCENARIO_OP_EXPECT;
+        } else if (scenario_slice_is(key, "id")) {
+            st = scenario_read_u64(cursor, &id);
+            if (st == ASX_OK && id > UINT32_MAX) st = ASX_E_INVALID_ARGUMENT;
+        } else if (scenario_slice_is(key, "op")) {
+            st = scenario_read_string(cursor, &opname);
+        } else {
+            st = scenario_skip_value(cursor);
+        }
+        if (st != ASX_OK) return st;
+    }
+    op->id = (uint32_t)id;
+    return scenario_build(names, opname, &args, op);
+}
+
+static asx_status scenario_parse_ops(const char **cursor,
+                                     asx_scenario_program *program,
+                                     scenario_names *names)
+{
+    const char *scan = asx_codec_json_skip_ws(*cursor);
+    asx_status st;
+
+    if (*scan != '[') return ASX_E_INVALID_ARGUMENT;
+    scan = asx_codec_json_skip_ws(scan + 1);
+    if (*scan == ']') {
+        *cursor = scan + 1;
+        return ASX_OK;
+    }
+    for (;;) {
+        if (program->count == program->capacity) return ASX_E_BUFFER_TOO_SMALL;
+        st = scenario_parse_op(&scan, names, &program->ops[program->count]);
+        if (st != ASX_OK) return st;
+        program->count++;
+        scan = asx_codec_json_skip_ws(scan);
+        if (*scan == ']') {
+            *cursor = scan + 1;
+            return ASX_OK;
+        }
+        if (*scan != ',') return ASX_E_INVALID_ARGUMENT;
+        scan++;
+    }
+}
+
+void asx_scenario_program_init(asx_scenario_program *program,
+                               asx_scenario_op *ops, uint32_t capacity)
+{
+    if (program == NULL) return;
+    memset(program, 0, sizeof(*program));
+    program->ops = ops;
+    program->capacity = ops != NULL ? capacity : 0u;
+}
+
+asx_status asx_scenario_compile(asx_scenario_program *program, const char *json)
+{
+    scenario_names names;
+    asx_codec_slice key;
+    const char *cursor = json;
+    int first = 1;
+    int found = 0;
+    int more;
+    asx_status st = ASX_OK;
+
+    if (program == NULL) return ASX_E_INVALID_ARGUMENT;
+    program->count = 0;
+    program->names = 0;
+    program->seed = 0;
+    if (json == NULL) return ASX_E_INVALID_ARGUMENT;
+    names.count = 0;
+
+    for (;;) {
+        st = scenario_next_member(&cursor, first, &more);
+        if (st != ASX_OK || !more) break;
+        first = 0;
+        st = scenario_read_string(&cursor, &key);
+        if (st == ASX_OK) st = scenario_read_colon(&cursor);
+        if (st != ASX_OK) break;
+
+        if (scenario_slice_is(key, "ops") && !found) {
+            st = scenario_parse_ops(&cursor, program, &names);
+            found = 1;
+        } else if (scenario_slice_is(key, "seed")) {
+            st = scenario_read_u64(&cursor, &program->seed);
+        } else {
+            st = scenario_skip_value(&cursor);
+        }
+        if (st != ASX_OK) break;
+    }
+    if (st == ASX_OK && (!found || *asx_codec_json_skip_ws(cursor) != '\0')) {
+        st = ASX_E_INVALID_ARGUMENT;
+    }
+    if (st != ASX_OK) {
+        program->count = 0;
+        return st;
+    }
+    program->names = names.count;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Execution
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint64_t id;              /* region, task, obligation or channel */
+    asx_send_permit permit;
+    asx_timer_handle timer;
+    uint64_t polls_left;      /* task: polls until it completes */
+} scenario_slot;
+
+static scenario_slot g_scn_slots[ASX_SCENARIO_MAX_NAMES];
+static asx_prng g_scn_rng;
+static asx_sim_clock g_scn_clock;
+
+/* Scenario task body: completes on its polls'th poll */
+static asx_status scenario_task_poll(void *data, asx_task_id self)
+{
+    scenario_slot *slot = (scenario_slot *)data;
+
+    (void)self;
+    if (slot->polls_left > 1u) {
+        slot->polls_left--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+static asx_status scenario_advance(uint64_t ns)
+{
+    void *wakers[SCN_AWAKE_BATCH];
+    uint32_t got;
+
+    g_scn_clock.now = ns > UINT64_MAX - g_scn_clock.now ? UINT64_MAX
+                                                        : g_scn_clock.now + ns;
+    do {
+        got = asx_timer_collect_expired(asx_timer_wheel_global(), g_scn_clock.now,
+                                        wakers, SCN_AWAKE_BATCH);
+    } while (got == SCN_AWAKE_BATCH);
+    return ASX_OK;
+}
+
+static asx_status scenario_exec(const asx_scenario_op *op)
+{
+    scenario_slot *a = op->a != ASX_SCENARIO_NO_SLOT ? &g_scn_slots[op->a] : NULL;
+    scenario_slot *b = op->b != ASX_SCENARIO_NO_SLOT ? &g_scn_slots[op->b] : NULL;
+    scenario_slot *c = op->c != ASX_SCENARIO_NO_SLOT ? &g_scn_slots[op->c] : NULL;
+    asx_budget budget;
+    asx_checkpoint_result cr;
+    asx_region_state rs;
+    asx_task_state ts;
+    asx_obligation_state os;
+    asx_status st;
+
+    /* Hand-built programs may leave a slot an opcode needs unbound */
+    if (a == NULL && op->code != ASX_SCENARIO_NOOP &&
+        op->code != ASX_SCENARIO_ADVANCE_TIME) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (b == NULL && (op->code == ASX_SCENARIO_SPAWN_TASK ||
+                      op->code == ASX_SCENARIO_RESERVE_OBLIGATION ||
+                      op->code == ASX_SCENARIO_CHANNEL_RESERVE)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (c == NULL && op->code == ASX_SCENARIO_CHANNEL_RESERVE) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    switch (op->code) {
+    case ASX_SCENARIO_NOOP:
+        return ASX_OK;
+    case ASX_SCENARIO_SPAWN_REGION:
+        return asx_region_open(&a->id);
+    case ASX_SCENARIO_CLOSE_REGION:
+        return asx_region_close(a->id);
+    case ASX_SCENARIO_SPAWN_TASK:
+        a->polls_left = op->arg;
+        return asx_task_spawn(b->id, scenario_task_poll, a, &a->id);
+    case ASX_SCENARIO_POLL_TASK:
+        budget = asx_budget_from_polls((uint32_t)op->arg);
+        return asx_scheduler_run(a->id, &budget);
+    case ASX_SCENARIO_REQUEST_CANCEL:
+        return asx_task_cancel(a->id, (asx_cancel_kind)op->arg);
+    case ASX_SCENARIO_ACK_CANCEL:
+        return asx_checkpoint(a->id, &cr);
+    case ASX_SCENARIO_RESERVE_OBLIGATION:
+        return asx_obligation_reserve(b->id, &a->id);
+    case ASX_SCENARIO_COMMIT_OBLIGATION:
+        return asx_obligation_commit(a->id);
+    case ASX_SCENARIO_ABORT_OBLIGATION:
+        return asx_obligation_abort(a->id);
+    case ASX_SCENARIO_CHANNEL_RESERVE:
+        if (a->id == ASX_INVALID_ID) {
+            st = asx_channel_create(c->id, (uint32_t)op->arg, &a->id);
+            if (st != ASX_OK) return st;
+        }
+        return asx_channel_try_reserve(a->id, &b->permit);
+    case ASX_SCENARIO_CHANNEL_SEND:
+        return asx_send_permit_send(&a->permit, op->arg);
+    case ASX_SCENARIO_CHANNEL_ABORT:
+        asx_send_permit_abort(&a->permit);
+        return ASX_OK;
+    case ASX_SCENARIO_TIMER_REGISTER:
+        return asx_timer_register(asx_timer_wheel_global(), op->arg, a, &a->timer);
+    case ASX_SCENARIO_TIMER_CANCEL:
+        return asx_timer_cancel(asx_timer_wheel_global(), &a->timer)
+               ? ASX_OK : ASX_E_TIMER_NOT_FOUND;
+    case ASX_SCENARIO_ADVANCE_TIME:
+        return scenario_advance(op->arg);
+    case ASX_SCENARIO_ASSERT_REGION:
+        st = asx_region_get_state(a->id, &rs);
+        if (st != ASX_OK) return st;
+        return (uint64_t)rs == op->arg ? ASX_OK : ASX_E_REPLAY_MISMATCH;
+    case ASX_SCENARIO_ASSERT_TASK:
+        st = asx_task_get_state(a->id, &ts);
+        if (st != ASX_OK) return st;
+        return (uint64_t)ts == op->arg ? ASX_OK : ASX_E_REPLAY_MISMATCH;
+    case ASX_SCENARIO_ASSERT_OBLIGATION:
+        st = asx_obligation_get_state(a->id, &os);
+        if (st != ASX_OK) return st;
+        return (uint64_t)os == op->arg ? ASX_OK : ASX_E_REPLAY_MISMATCH;
+    default:
+        return ASX_E_INVALID_ARGUMENT;
+    }
+}
+
+asx_status asx_scenario_run(const asx_scenario_program *program,
+                            asx_scenario_result *out)
+{
+    asx_runtime_hooks hooks;
+    const asx_scenario_op *op;
+    uint32_t i;
+    asx_status st;
+
+    if (program == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (program->count > 0u && program->ops == NULL) return ASX_E_INVALID_ARGUMENT;
+    memset(out, 0, sizeof(*out));
+    memset(g_scn_slots, 0, sizeof(g_scn_slots));
+
+    asx_runtime_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    st = asx_runtime_hooks_init(&hooks);
+    if (st != ASX_OK) return st;
+    asx_prng_seed(&g_scn_rng, program->seed);
+    st = asx_prng_install(&g_scn_rng, &hooks);
+    if (st != ASX_OK) return st;
+    asx_sim_clock_init(&g_scn_clock, 0);
+    st = asx_sim_clock_install(&g_scn_clock, &hooks);
+    if (st != ASX_OK) return st;
+    st = asx_runtime_set_hooks(&hooks);
+    if (st != ASX_OK) return st;
+
+    for (i = 0; i < program->count; i++) {
+        op = &program->ops[i];
+        if ((op->a != ASX_SCENARIO_NO_SLOT && op->a >= ASX_SCENARIO_MAX_NAMES) ||
+            (op->b != ASX_SCENARIO_NO_SLOT && op->b >= ASX_SCENARIO_MAX_NAMES) ||
+            (op->c != ASX_SCENARIO_NO_SLOT && op->c >= ASX_SCENARIO_MAX_NAMES)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        st = scenario_exec(op);
+        out->executed++;
+        if (st != ASX_OK) {
+            if (out->error_count < ASX_SCENARIO_MAX_ERRORS) {
+                out->errors[out->error_count] = st;
+            }
+            out->error_count++;
+        }
+        if ((op->flags & ASX_SCENARIO_OP_EXPECT) && st != op->expect) {
+            out->failed_id = op->id;
+            out->expected = op->expect;
+            out->actual = st;
+            return ASX_E_REPLAY_MISMATCH;
+        }
+    }
+    return ASX_OK;
+}
@@ -3,7 +3,14 @@
  *
  * Round-robin scheduler that polls all non-completed tasks in arena
  * index order (deterministic tie-break). Emits a monotonic event
- * sequence for replay identity verification.
+ * sequence for replay identity verification. Each round walks the
+ * region's intrusive ready list, so its cost is O(runnable tasks)
+ * rather than O(task arena). Parked tasks (waker.h) are off the ready
+ * list entirely and cost nothing until an event source wakes them.
+ * The priority and EDF modes narrow each round to the most urgent
+ * occupied level of the ready list.
+ * Runs of tasks sharing a registered poll function are polled through
+ * one batch call and their results applied in the same order.
  *
  * Tie-break rule: tasks are polled in ascending arena index within
  * each round. This ordering is stable and deterministic for any
@@ -18,28 +25,34 @@
 #include <asx/core/transition.h>
 #include <asx/core/cancel.h>
 #include <asx/asx_config.h>
+#include <asx/time/timer_wheel.h>
 #include "runtime_internal.h"
+#include "context_internal.h"
+#include "../core/bits.h"
 
 /* -------------------------------------------------------------------
  * Event log (ring buffer for deterministic sequencing)
+ *
+ * Event seq lives in slot seq & (g_event_cap - 1), so once the ring is
+ * full each event overwrites the oldest one. The inline ring needs no
+ * allocator; asx_scheduler_event_log_reserve swaps in a larger one.
  * ------------------------------------------------------------------- */
 
-#define ASX_SCHED_EVENT_LOG_CAPACITY 256u
-
-static asx_scheduler_event g_event_log[ASX_SCHED_EVENT_LOG_CAPACITY];
+static asx_scheduler_event g_event_inline[ASX_SCHED_EVENT_LOG_CAPACITY];
+static asx_scheduler_event *g_event_log = g_event_inline;
+static uint32_t g_event_cap = ASX_SCHED_EVENT_LOG_CAPACITY;
 static uint32_t g_event_count = 0;
 
 static void sched_emit(asx_scheduler_event_kind kind,
                        asx_task_id tid,
                        uint32_t round)
 {
-    if (g_event_count < ASX_SCHED_EVENT_LOG_CAPACITY) {
-        asx_scheduler_event *e = &g_event_log[g_event_count];
-        e->kind = kind;
-        e->task_id = tid;
-        e->sequence = g_event_count;
-        e->round = round;
-    }
+    asx_scheduler_event *e = &g_event_log[g_event_count & (g_event_cap - 1u)];
+
+    e->kind = kind;
+    e->task_id = tid;
+    e->sequence = g_event_count;
+    e->round = round;
     g_event_count++;
 }
 
@@ -48,20 +61,284 @@ uint32_t asx_scheduler_event_count(void)
     return g_event_count;
 }
 
+uint32_t asx_scheduler_event_first(void)
+{
+    return g_event_count > g_event_cap ? g_event_count - g_event_cap : 0;
+}
+
 int asx_scheduler_event_get(uint32_t index, asx_scheduler_event *out)
 {
     if (out == NULL) return 0;
     if (index >= g_event_count) return 0;
-    if (index >= ASX_SCHED_EVENT_LOG_CAPACITY) return 0;
-    *out = g_event_log[index];
+    if (index < asx_scheduler_event_first()) return 0;
+    *out = g_event_log[index & (g_event_cap - 1u)];
     return 1;
 }
 
+asx_status asx_scheduler_event_log_reserve(uint32_t capacity)
+{
+    asx_scheduler_event *log = g_event_inline;
+    uint32_t cap = ASX_SCHED_EVENT_LOG_CAPACITY;
+    uint32_t seq;
+    void *mem;
+    asx_status st;
+
+    if (capacity > ASX_SCHED_EVENT_LOG_MAX) return ASX_E_INVALID_ARGUMENT;
+    while (cap < capacity) {
+        ASX_CHECKPOINT_WAIVER("bounded by doublings up to ASX_SCHED_EVENT_LOG_MAX");
+        cap <<= 1;
+    }
+    if (cap == g_event_cap) return ASX_OK;
+    if (cap > ASX_SCHED_EVENT_LOG_CAPACITY) {
+        st = asx_runtime_alloc_tagged(ASX_ALLOC_TAG_EVENT_LOG,
+                                      (size_t)cap * sizeof(asx_scheduler_event),
+                                      &mem);
+        if (st != ASX_OK) return st;
+        log = (asx_scheduler_event *)mem;
+    }
+
+    /* Carry over the newest events that fit the new ring */
+    seq = g_event_count > cap ? g_event_count - cap : 0;
+    if (seq < asx_scheduler_event_first()) seq = asx_scheduler_event_first();
+    for (; seq < g_event_count; seq++) {
+        ASX_CHECKPOINT_WAIVER("bounded by the retained ring window");
+        log[seq & (cap - 1u)] = g_event_log[seq & (g_event_cap - 1u)];
+    }
+
+    if (g_event_log != g_event_inline) (void)asx_runtime_free(g_event_log);
+    g_event_log = log;
+    g_event_cap = cap;
+    return ASX_OK;
+}
+
 void asx_scheduler_event_reset(void)
 {
     g_event_count = 0;
 }
 
+/* -------------------------------------------------------------------
+ * Coarse clock: at most one clock hook read per scheduler round
+ *
+ * The cache holds the round's reading plus one, so 0 means "not read
+ * yet this round". Outside a run every call reads the hook. Parallel
+ * batch polls may race to fill it; either reading is the round's time.
+ * ------------------------------------------------------------------- */
+
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define coarse_load(p)      __atomic_load_n((p), __ATOMIC_RELAXED)
+#define coarse_store(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#else
+#define coarse_load(p)      (*(p))
+#define coarse_store(p, v)  (void)(*(p) = (v))
+#endif
+
+static uint64_t g_coarse_cached;
+static int g_coarse_in_run;
+
+void asx_coarse_round_begin(void)
+{
+    g_coarse_in_run = 1;
+    coarse_store(&g_coarse_cached, (uint64_t)0);
+}
+
+void asx_coarse_run_end(void)
+{
+    g_coarse_in_run = 0;
+    coarse_store(&g_coarse_cached, (uint64_t)0);
+}
+
+asx_status asx_runtime_coarse_now_ns(asx_time *out_now)
+{
+    uint64_t cached;
+    asx_status st;
+
+    if (out_now == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (!g_coarse_in_run) return asx_runtime_now_ns(out_now);
+
+    cached = coarse_load(&g_coarse_cached);
+    if (cached != 0u) {
+        *out_now = cached - 1u;
+        return ASX_OK;
+    }
+    st = asx_runtime_now_ns(out_now);
+    if (st == ASX_OK) coarse_store(&g_coarse_cached, *out_now + 1u);
+    return st;
+}
+
+/* -------------------------------------------------------------------
+ * Priority and EDF modes
+ *
+ * A ranked round first walks the ready list setting one bitmap bit
+ * per occupied level; the lowest set bit is the level the round
+ * polls, and the poll walk skips every other task. Levels are
+ * recomputed identically in both walks: the round's coarse time is
+ * fixed and sched_wait only changes once a task's turn is decided.
+ * ------------------------------------------------------------------- */
+
+static asx_scheduler_mode g_sched_mode = ASX_SCHED_MODE_ROUND_ROBIN;
+static uint32_t g_sched_aging_rounds = 0;
+static asx_task_poll_fn g_batch_poll_fn[ASX_SCHED_BATCH_FN_MAX];
+static asx_task_batch_poll_fn g_batch_fn[ASX_SCHED_BATCH_FN_MAX];
+static uint32_t g_batch_fn_count = 0;
+
+/* Idle wait policy and the adaptive spin window (see wait_idle below) */
+#define ASX_SCHED_SPIN_WINDOW_INIT_NS 50000u
+static asx_wait_policy g_wait_policy = ASX_WAIT_SLEEP;
+static uint64_t g_spin_window_ns = ASX_SCHED_SPIN_WINDOW_INIT_NS;
+static const asx_wait_policy g_wait_policy_init = ASX_WAIT_SLEEP;
+static const uint64_t g_spin_window_init = ASX_SCHED_SPIN_WINDOW_INIT_NS;
+
+static asx_scheduler_event *const g_event_log_init = g_event_inline;
+static const uint32_t g_event_cap_init = ASX_SCHED_EVENT_LOG_CAPACITY;
+static const asx_context_block g_scheduler_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_event_inline),
+    ASX_CONTEXT_BLOCK_INIT(g_event_log, g_event_log_init),
+    ASX_CONTEXT_BLOCK_INIT(g_event_cap, g_event_cap_init),
+    ASX_CONTEXT_BLOCK(g_event_count),
+    ASX_CONTEXT_BLOCK(g_coarse_cached),
+    ASX_CONTEXT_BLOCK(g_coarse_in_run),
+    ASX_CONTEXT_BLOCK(g_sched_mode),       /* round-robin is 0 */
+    ASX_CONTEXT_BLOCK(g_sched_aging_rounds),
+    ASX_CONTEXT_BLOCK(g_batch_poll_fn),
+    ASX_CONTEXT_BLOCK(g_batch_fn),
+    ASX_CONTEXT_BLOCK(g_batch_fn_count),
+    ASX_CONTEXT_BLOCK_INIT(g_wait_policy, g_wait_policy_init),
+    ASX_CONTEXT_BLOCK_INIT(g_spin_window_ns, g_spin_window_init)
+};
+
+const asx_context_module asx_scheduler_context = ASX_CONTEXT_MODULE(g_scheduler_blocks);
+
+void asx_scheduler_mode_reset(void)
+{
+    g_sched_mode = ASX_SCHED_MODE_ROUND_ROBIN;
+    g_sched_aging_rounds = 0;
+    g_wait_policy = ASX_WAIT_SLEEP;
+    g_spin_window_ns = ASX_SCHED_SPIN_WINDOW_INIT_NS;
+    g_batch_fn_count = 0;
+}
+
+asx_status asx_scheduler_set_mode(asx_scheduler_mode mode,
+                                  uint32_t aging_rounds)
+{
+    if ((unsigned)mode > (unsigned)ASX_SCHED_MODE_EDF) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (aging_rounds > ASX_SCHED_AGING_MAX_ROUNDS) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    g_sched_mode = mode;
+    g_sched_aging_rounds = aging_rounds;
+    return ASX_OK;
+}
+
+asx_status asx_task_set_priority(asx_task_id id, uint32_t priority)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    if (priority >= ASX_TASK_PRIORITY_LEVELS) return ASX_E_INVALID_ARGUMENT;
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+    t->priority = (uint8_t)priority;
+    return ASX_OK;
+}
+
+asx_status asx_task_set_hot_polls(asx_task_id id, uint32_t polls)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    if (polls > ASX_TASK_HOT_POLLS_MAX) return ASX_E_INVALID_ARGUMENT;
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+    t->hot_polls = (uint8_t)polls;
+    return ASX_OK;
+}
+
+asx_status asx_task_set_sched_deadline(asx_task_id id, asx_time deadline)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+    t->cold->sched_deadline = deadline;
+    return ASX_OK;
+}
+
+asx_status asx_task_report_cost(asx_task_id self, uint32_t cost)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    st = asx_task_slot_lookup(self, &t);
+    if (st != ASX_OK) return st;
+    t->poll_cost = cost > UINT32_MAX - t->poll_cost ? UINT32_MAX
+                                                    : t->poll_cost + cost;
+    return ASX_OK;
+}
+
+void asx_budget_charge_task(asx_budget *budget, asx_task_slot *t)
+{
+    uint32_t cost = t->poll_cost;
+
+    if (cost == 0) return;
+    t->poll_cost = 0;
+    if (!asx_budget_consume_cost(budget, cost)) budget->cost_quota = 0;
+}
+
+/* Effective level of t this round, after aging */
+static uint32_t sched_level(const asx_task_slot *t, asx_time now)
+{
+    uint32_t level;
+    uint32_t boost;
+
+    if (g_sched_mode == ASX_SCHED_MODE_PRIORITY) {
+        level = t->priority;
+    } else {
+        asx_time deadline = t->cold->sched_deadline;
+        uint64_t slack_us;
+
+        if (deadline == 0) {
+            level = ASX_TASK_PRIORITY_LEVELS - 1u;
+        } else if (deadline <= now) {
+            level = 0;
+        } else {
+            /* Bit length of the slack in microseconds, capped */
+            slack_us = (deadline - now) / 1000u;
+            level = 0;
+            while (slack_us != 0 && level < ASX_TASK_PRIORITY_LEVELS - 2u) {
+                ASX_CHECKPOINT_WAIVER("bounded by ASX_TASK_PRIORITY_LEVELS");
+                slack_us >>= 1;
+                level++;
+            }
+        }
+    }
+    if (g_sched_aging_rounds != 0) {
+        boost = (uint32_t)t->sched_wait / g_sched_aging_rounds;
+        level = boost >= level ? 0 : level - boost;
+    }
+    return level;
+}
+
+/* Most urgent occupied level on the region's ready list */
+static uint32_t sched_best_level(const asx_region_slot *rslot, asx_time now)
+{
+    uint32_t occupied = 0;
+    uint32_t i = rslot->ready_head;
+
+    while (i != ASX_TASK_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by region ready list <= ASX_ARENA_MAX_TASKS");
+        const asx_task_slot *t = asx_task_at(i);
+
+        if (asx_slot_live(t->key) && !asx_task_is_terminal(t->state)) {
+            occupied |= 1u << sched_level(t, now);
+        }
+        i = t->ready_next;
+    }
+    return occupied == 0 ? 0 : asx_ctz32(occupied);
+}
+
 /* -------------------------------------------------------------------
  * Scheduler: run all tasks in a region until completion or budget
  *
@@ -70,26 +347,247 @@ void asx_scheduler_event_reset(void)
  * for any given input and seed combination.
  * ------------------------------------------------------------------- */
 
-asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
+/* Apply one poll result: charge the task's cost, commit or drop the
+ * park it requested, then complete it (ASX_OK or an error) or spend a
+ * cleanup poll (pending with a cancel). Parked and completed tasks
+ * stop counting in *io_active. Returns a failure that must end the
+ * run (outside POISON_REGION containment), else ASX_OK. */
+static asx_status sched_apply_result(asx_region_id region,
+                                     asx_region_slot *rslot,
+                                     asx_budget *budget, uint32_t i,
+                                     asx_task_id tid, asx_status poll_result,
+                                     uint32_t round, uint32_t *io_active)
 {
-    asx_region_slot *rslot;
-    asx_status st;
-    uint32_t active;
-    uint32_t round;
-    uint32_t i;
+    asx_task_slot *t = asx_task_at(i);
 
-    if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
+    asx_budget_charge_task(budget, t);
 
-    st = asx_region_slot_lookup(region, &rslot);
-    if (st != ASX_OK) return st;
+    /* Apply a park the task requested during its poll. Parked
+     * tasks leave the ready list and stop counting as active. */
+    asx_waker_poll_end(rslot, i, poll_result);
+    if (t->parked) (*io_active)--;
 
-    /* Reset event log for this scheduler invocation */
-    asx_scheduler_event_reset();
+    if (poll_result == ASX_OK) {
+        /* Task completed — set outcome based on cancel state */
+        (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
+        t->state = ASX_TASK_COMPLETED;
+        if (t->cancel_pending) {
+            asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
+        } else {
+            asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_OK);
+        }
+        asx_task_release_capture_internal(t);
+        asx_region_task_completed(rslot, i);
+        (*io_active)--;
+        asx_region_ready_remove(rslot, i);
+        sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
+        asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
+    } else if (poll_result != ASX_E_PENDING) {
+        /* Task failed — mark as completed with error.
+         * If cancel was pending, outcome joins to CANCELLED
+         * since CANCELLED > ERR in the severity lattice. */
+        (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
+        t->state = ASX_TASK_COMPLETED;
+        if (t->cancel_pending) {
+            asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
+        } else {
+            asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_ERR);
+        }
+        asx_task_release_capture_internal(t);
+        asx_region_task_completed(rslot, i);
+        (*io_active)--;
+        asx_region_ready_remove(rslot, i);
+        sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
+        asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
+
+        /* Apply fault containment policy (bd-hwb.15).
+         * In POISON_REGION mode this poisons the region,
+         * blocking further spawn/close. The scheduler
+         * continues draining existing tasks. */
+        if (asx_containment_policy_kernel() != ASX_CONTAIN_POISON_REGION) {
+            return poll_result;
+        }
+        {
+            asx_status fc_ = asx_region_contain_fault(region, poll_result);
+            (void)fc_;  /* the run continues draining */
+        }
+    } else if (t->cancel_pending) {
+        /* PENDING + cancel active: decrement cleanup budget.
+         * The scheduler is the sole budget enforcer — each
+         * poll of a cancel-phase task consumes one unit. */
+        if (t->cleanup_polls_remaining > 0) {
+            t->cleanup_polls_remaining--;
+        }
+    }
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Batch polls
+ *
+ * A run of consecutive ready tasks sharing a registered poll function
+ * is polled through one batch call. Selection, budget and the
+ * CREATED -> RUNNING transitions happen before the call; the call runs
+ * in waker batch mode (parks recorded, channel wakes deferred); then
+ * each result is applied in arena order exactly as a single poll's,
+ * SCHED_POLL first. Later failures are still applied after one that
+ * ends the run, so no completed poll is lost.
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t    slot[ASX_SCHED_BATCH_POLL_MAX];
+    asx_task_id tid[ASX_SCHED_BATCH_POLL_MAX];
+    void       *data[ASX_SCHED_BATCH_POLL_MAX];
+    asx_status  result[ASX_SCHED_BATCH_POLL_MAX];
+} sched_batch;
+
+static sched_batch g_sched_batch;
+
+asx_status asx_scheduler_register_batch_poll(asx_task_poll_fn poll_fn,
+                                             asx_task_batch_poll_fn batch_fn)
+{
+    uint32_t k;
+
+    if (poll_fn == NULL) return ASX_E_INVALID_ARGUMENT;
+    for (k = 0; k < g_batch_fn_count; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_SCHED_BATCH_FN_MAX") */
+        if (g_batch_poll_fn[k] != poll_fn) continue;
+        if (batch_fn != NULL) {
+            g_batch_fn[k] = batch_fn;
+            return ASX_OK;
+        }
+        g_batch_fn_count--;
+        g_batch_poll_fn[k] = g_batch_poll_fn[g_batch_fn_count];
+        g_batch_fn[k] = g_batch_fn[g_batch_fn_count];
+        return ASX_OK;
+    }
+    if (batch_fn == NULL) return ASX_OK;
+    if (g_batch_fn_count == ASX_SCHED_BATCH_FN_MAX) return ASX_E_RESOURCE_EXHAUSTED;
+    g_batch_poll_fn[g_batch_fn_count] = poll_fn;
+    g_batch_fn[g_batch_fn_count] = batch_fn;
+    g_batch_fn_count++;
+    return ASX_OK;
+}
+
+static asx_task_batch_poll_fn sched_batch_fn(asx_task_poll_fn poll_fn)
+{
+    uint32_t k;
+
+    for (k = 0; k < g_batch_fn_count; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_SCHED_BATCH_FN_MAX") */
+        if (g_batch_poll_fn[k] == poll_fn) return g_batch_fn[k];
+    }
+    return NULL;
+}
+
+/* Whether t can join a batch of poll_fn this round */
+static int sched_batchable(const asx_task_slot *t, asx_task_poll_fn poll_fn)
+{
+    return asx_slot_live(t->key) && t->poll_fn == poll_fn &&
+           (t->state == ASX_TASK_CREATED || t->state == ASX_TASK_RUNNING) &&
+           !t->cancel_pending && t->hot_polls == 0;
+}
+
+/* Poll the run of batchable tasks starting at first (already selected
+ * by the caller) through fn. *out_next is the ready-list successor of
+ * the last task polled, read after the batch call and before any
+ * result takes a task off the list. */
+static asx_status sched_poll_batch(asx_region_id region,
+                                   asx_region_slot *rslot,
+                                   asx_budget *budget,
+                                   asx_task_batch_poll_fn fn,
+                                   uint32_t first, uint32_t round,
+                                   int ranked, uint32_t best, asx_time now,
+                                   uint32_t *io_active, uint32_t *out_next)
+{
+    sched_batch *b = &g_sched_batch;
+    asx_task_poll_fn poll_fn = asx_task_at(first)->poll_fn;
+    uint32_t cap = asx_budget_polls(budget);
+    asx_status first_fault = ASX_OK;
+    uint32_t n = 0;
+    uint32_t i = first;
+    uint32_t k;
+
+    if (asx_budget_is_exhausted(budget) || cap == 0) {
+        sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, round);
+        asx_trace_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
+        return ASX_E_POLL_BUDGET_EXHAUSTED;
+    }
+    if (cap > ASX_SCHED_BATCH_POLL_MAX) cap = ASX_SCHED_BATCH_POLL_MAX;
+
+    /* Select the run; every member is active and consumes a poll */
+    while (n < cap && i != ASX_TASK_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SCHED_BATCH_POLL_MAX");
+        asx_task_slot *t = asx_task_at(i);
+
+        if (n > 0) {
+            if (!sched_batchable(t, poll_fn)) break;
+            if (ranked) {
+                if (sched_level(t, now) != best) break;
+                t->sched_wait = 0;
+            }
+            (*io_active)++;
+        }
+        (void)asx_budget_consume_poll(budget);
+        b->tid[n] = asx_handle_pack(ASX_TYPE_TASK,
+                                    (uint16_t)(1u << (unsigned)t->state),
+                                    asx_handle_pack_index(
+                                        asx_slot_generation(t->key), i));
+        if (t->state == ASX_TASK_CREATED) {
+            (void)asx_ghost_check_task_transition(b->tid[n], t->state,
+                                                  ASX_TASK_RUNNING);
+            t->state = ASX_TASK_RUNNING;
+            asx_snapshot_touch_task(i);
+        }
+        b->slot[n] = i;
+        b->data[n] = t->user_data;
+        b->result[n] = ASX_E_PENDING;
+        n++;
+        i = t->ready_next;
+    }
+
+    asx_waker_batch_begin();
+    fn(b->data, b->tid, n, b->result);
+    asx_waker_batch_end();
+    *out_next = asx_task_at(b->slot[n - 1u])->ready_next;
+
+    for (k = 0; k < n; k++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_SCHED_BATCH_POLL_MAX") */
+        asx_status st;
+
+        sched_emit(ASX_SCHED_EVENT_POLL, b->tid[k], round);
+        if (!asx_trace_round_poll(b->tid[k], round)) {
+            asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)b->tid[k], round);
+        }
+        st = sched_apply_result(region, rslot, budget, b->slot[k], b->tid[k],
+                                b->result[k], round, io_active);
+        if (first_fault == ASX_OK) first_fault = st;
+    }
+
+    /* Wakes raised by channel operations in the batch, applied once
+     * every park of the batch is in place */
+    asx_waker_flush_deferred();
+    return first_fault;
+}
+
+static asx_status scheduler_run_rounds(asx_region_id region,
+                                       asx_region_slot *rslot,
+                                       asx_budget *budget)
+{
+    uint32_t active;
+    uint32_t round;
+    uint32_t i;
+    uint32_t next;
+    uint32_t best = 0;
+    uint32_t hot;
+    asx_time now = 0;
+    asx_status st;
+    int ranked = g_sched_mode != ASX_SCHED_MODE_ROUND_ROBIN;
 
     /* Scheduler loop: round-robin poll until all tasks complete */
     for (round = 0; ; round++) {
         ASX_CHECKPOINT_WAIVER("kernel-scheduler: this IS the scheduler event loop; "
                               "budget exhaustion provides bounded termination");
+        asx_coarse_round_begin();
+        asx_region_deadline_poll(asx_handle_slot(region));
+        asx_region_lease_poll(asx_handle_slot(region));
         /* Check budget exhaustion */
         if (asx_budget_is_exhausted(budget)) {
             sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, round);
@@ -97,18 +595,32 @@ asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
             return ASX_E_POLL_BUDGET_EXHAUSTED;
         }
 
+        if (ranked) {
+            /* Without a clock every EDF deadline counts from time 0 */
+            if (asx_runtime_coarse_now_ns(&now) != ASX_OK) now = 0;
+            best = sched_best_level(rslot, now);
+        }
+
         active = 0;
 
-        for (i = 0; i < g_task_count; i++) {
+        /* Walk the region ready list (ascending arena index). The next
+         * link is read only after the poll so tasks spawned into this
+         * region during the round are still visited, exactly as the
+         * former full-arena scan did. */
+        i = rslot->ready_head;
+        while (i != ASX_TASK_LINK_NONE) {
             ASX_CHECKPOINT_WAIVER("kernel-scheduler: inner poll loop bounded by "
-                                  "g_task_count <= ASX_MAX_TASKS arena capacity");
-            asx_task_slot *t = &g_tasks[i];
+                                  "region ready list <= ASX_ARENA_MAX_TASKS arena capacity");
+            asx_task_slot *t = asx_task_at(i);
             asx_task_id tid;
             asx_status poll_result;
 
-            if (!t->alive) continue;
-            if (t->region != region) continue;
-            if (asx_task_is_terminal(t->state)) continue;
+            next = t->ready_next;
+            if (!asx_slot_live(t->key) || asx_task_is_terminal(t->state)) {
+                asx_region_ready_remove(rslot, i);
+                i = next;
+                continue;
+            }
 
             active++;
 
@@ -116,7 +628,7 @@ asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
             tid = asx_handle_pack(ASX_TYPE_TASK,
                                   (uint16_t)(1u << (unsigned)t->state),
                                   asx_handle_pack_index(
-                                      t->generation, (uint16_t)i));
+                                      asx_slot_generation(t->key), i));
 
             /* ----------------------------------------------------------
              * Cancel-phase scheduler integration (bd-2cw.3)
@@ -131,12 +643,14 @@ asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
                 (void)asx_ghost_check_task_transition(tid, t->state,
                                                       ASX_TASK_COMPLETED);
                 t->state = ASX_TASK_COMPLETED;
-                t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
                 asx_task_release_capture_internal(t);
-                rslot->task_count--;
+                asx_region_task_completed(rslot, i);
                 active--;
+                asx_region_ready_remove(rslot, i);
                 sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
                 asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
+                i = next;
                 continue;
             }
 
@@ -150,104 +664,456 @@ asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
                 if (t->state == ASX_TASK_CANCEL_REQUESTED) {
                     (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_CANCELLING);
                     t->state = ASX_TASK_CANCELLING;
-                    t->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+                    t->cold->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
                 }
                 (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_FINALIZING);
                 t->state = ASX_TASK_FINALIZING;
-                t->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
+                t->cold->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
                 (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
                 t->state = ASX_TASK_COMPLETED;
-                t->cancel_phase = ASX_CANCEL_PHASE_COMPLETED;
-                t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                t->cold->cancel_phase = ASX_CANCEL_PHASE_COMPLETED;
+                asx_task_cold_set_outcome(t->cold, ASX_OUTCOME_CANCELLED);
                 asx_task_release_capture_internal(t);
-                rslot->task_count--;
+                asx_region_task_completed(rslot, i);
                 active--;
+                asx_region_ready_remove(rslot, i);
                 sched_emit(ASX_SCHED_EVENT_CANCEL_FORCED, tid, round);
                 asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
+                i = next;
                 continue;
             }
 
-            /* Consume one poll unit */
-            if (asx_budget_consume_poll(budget) == 0) {
-                sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, round);
-                asx_trace_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
-                return ASX_E_POLL_BUDGET_EXHAUSTED;
-            }
-
-            /* Transition Created → Running on first poll */
-            if (t->state == ASX_TASK_CREATED) {
-                (void)asx_ghost_check_task_transition(tid, t->state,
-                                                      ASX_TASK_RUNNING);
-                t->state = ASX_TASK_RUNNING;
+            /* Ranked modes poll only the round's level */
+            if (ranked) {
+                if (sched_level(t, now) != best) {
+                    if (t->sched_wait < UINT16_MAX) t->sched_wait++;
+                    i = next;
+                    continue;
+                }
+                t->sched_wait = 0;
             }
 
-            /* Emit poll event */
-            sched_emit(ASX_SCHED_EVENT_POLL, tid, round);
-            asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)tid, round);
+            if (g_batch_fn_count != 0 && sched_batchable(t, t->poll_fn)) {
+                asx_task_batch_poll_fn batch_fn = sched_batch_fn(t->poll_fn);
 
-            /* Call the task's poll function */
-            asx_error_ledger_bind_task(tid);
-            poll_result = t->poll_fn(t->user_data, tid);
-            asx_error_ledger_bind_task(ASX_INVALID_ID);
-
-            if (poll_result == ASX_OK) {
-                /* Task completed — set outcome based on cancel state */
-                (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
-                t->state = ASX_TASK_COMPLETED;
-                if (t->cancel_pending) {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                } else {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_OK);
+                if (batch_fn != NULL) {
+                    st = sched_poll_batch(region, rslot, budget, batch_fn, i,
+                                          round, ranked, best, now, &active,
+                                          &next);
+                    if (st != ASX_OK) return st;
+                    i = next;
+                    continue;
                 }
-                asx_task_release_capture_internal(t);
-                rslot->task_count--;
-                active--;
-                sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
-                asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
-            } else if (poll_result != ASX_E_PENDING) {
-                /* Task failed — mark as completed with error.
-                 * If cancel was pending, outcome joins to CANCELLED
-                 * since CANCELLED > ERR in the severity lattice. */
-                (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
-                t->state = ASX_TASK_COMPLETED;
-                if (t->cancel_pending) {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                } else {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_ERR);
+            }
+
+            for (hot = 0; ; hot++) {
+                ASX_CHECKPOINT_WAIVER("kernel-scheduler: re-polls bounded by "
+                                      "the task's hot_polls quota");
+                /* Consume one poll unit; a spent cost quota stops the
+                 * round as well */
+                if (asx_budget_is_exhausted(budget) ||
+                    asx_budget_consume_poll(budget) == 0) {
+                    sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, round);
+                    asx_trace_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
+                    return ASX_E_POLL_BUDGET_EXHAUSTED;
                 }
-                asx_task_release_capture_internal(t);
-                rslot->task_count--;
-                active--;
-                sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
-                asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
 
-                /* Apply fault containment policy (bd-hwb.15).
-                 * In POISON_REGION mode this poisons the region,
-                 * blocking further spawn/close. The scheduler
-                 * continues draining existing tasks. */
-                {
-                    asx_status fc_ = asx_region_contain_fault(region, poll_result);
-                    if (fc_ != ASX_OK &&
-                        asx_containment_policy_active() != ASX_CONTAIN_POISON_REGION) {
-                        return fc_;
-                    }
+                /* Transition Created → Running on first poll */
+                if (t->state == ASX_TASK_CREATED) {
+                    (void)asx_ghost_check_task_transition(tid, t->state,
+                                                          ASX_TASK_RUNNING);
+                    t->state = ASX_TASK_RUNNING;
+                    asx_snapshot_touch_task(i);
                 }
-            } else if (t->cancel_pending) {
-                /* PENDING + cancel active: decrement cleanup budget.
-                 * The scheduler is the sole budget enforcer — each
-                 * poll of a cancel-phase task consumes one unit. */
-                if (t->cleanup_polls_remaining > 0) {
-                    t->cleanup_polls_remaining--;
+
+                /* Emit poll event */
+                sched_emit(ASX_SCHED_EVENT_POLL, tid, round);
+                if (!asx_trace_round_poll(tid, round)) {
+                    asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)tid, round);
                 }
+
+                /* Call the task's poll function */
+                asx_ledger_bind(tid);
+                asx_waker_poll_begin(i);
+#if ASX_TASK_PROFILE
+                asx_task_profile_poll_begin(i);
+#endif
+                poll_result = t->poll_fn(t->user_data, tid);
+#if ASX_TASK_PROFILE
+                asx_task_profile_poll_end(i);
+#endif
+                asx_ledger_bind(ASX_INVALID_ID);
+                next = t->ready_next;
+
+                st = sched_apply_result(region, rslot, budget, i, tid,
+                                        poll_result, round, &active);
+                if (st != ASX_OK) return st;
+                if (poll_result != ASX_E_PENDING || t->cancel_pending) break;
+
+                /* ASX_E_PENDING without cancel: a hot task is polled again
+                 * at once, up to its quota, unless it parked */
+                if (t->parked || hot >= t->hot_polls) break;
+                tid = asx_handle_pack(ASX_TYPE_TASK,
+                                      (uint16_t)(1u << (unsigned)t->state),
+                                      asx_handle_pack_index(
+                                          asx_slot_generation(t->key), i));
             }
-            /* ASX_E_PENDING without cancel: task not ready, continue */
+            i = next;
+        }
+
+        /* Destructors deferred by this round's completions */
+        if (rslot->dtor_pending != 0u) {
+            (void)asx_region_dtor_flush(rslot, rslot->dtor_batch);
         }
 
-        /* No active tasks left — quiescent */
-        if (active == 0) {
+        /* No active tasks left. A task woken this round at a lower
+         * index is still on the ready list and gets another round. */
+        if (active == 0 && rslot->ready_head == ASX_TASK_LINK_NONE) {
+            if (rslot->task_count > 0) {
+                /* Remaining tasks are all parked — idle until woken */
+                sched_emit(ASX_SCHED_EVENT_IDLE, ASX_INVALID_ID, round);
+                return ASX_E_PENDING;
+            }
             sched_emit(ASX_SCHED_EVENT_QUIESCENT, ASX_INVALID_ID, round);
             asx_trace_emit(ASX_TRACE_SCHED_QUIESCENT, ASX_INVALID_ID, round);
             return ASX_OK;
         }
     }
 }
+
+asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
+{
+    asx_region_slot *rslot;
+    asx_status st;
+
+    if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(region, &rslot);
+    if (st != ASX_OK) return st;
+
+    /* Reset event log for this scheduler invocation */
+    asx_scheduler_event_reset();
+
+    st = scheduler_run_rounds(region, rslot, budget);
+    asx_coarse_run_end();
+    return st;
+}
+
+/* -------------------------------------------------------------------
+ * Multi-region loop: every region with live tasks, one call
+ *
+ * Each pass visits regions in ascending slot order and runs each
+ * runnable one (ready list non-empty) on a share of the remaining
+ * polls, charging what it used back to the caller's budget. A share
+ * never drops below the region's live task count while polls remain,
+ * so every region gets at least a full round and no task at the end
+ * of a ready list starves behind the shares.
+ * ------------------------------------------------------------------- */
+
+static uint32_t scheduler_share(asx_scheduler_share policy,
+                                uint32_t remaining, uint32_t runnable,
+                                uint64_t tasks, const asx_region_slot *r)
+{
+    uint32_t share;
+
+    switch (policy) {
+    case ASX_SCHED_SHARE_BY_TASKS:
+        share = (uint32_t)(((uint64_t)remaining * r->task_count) / tasks);
+        break;
+    case ASX_SCHED_SHARE_IN_ORDER:
+        share = remaining;
+        break;
+    case ASX_SCHED_SHARE_EQUAL:
+    default:
+        share = remaining / runnable;
+        break;
+    }
+    if (share < r->task_count) share = r->task_count;
+    return share;
+}
+
+static asx_status scheduler_run_all_passes(asx_budget *budget,
+                                           asx_scheduler_share policy)
+{
+    uint32_t pass;
+    uint32_t i;
+
+    for (pass = 0; ; pass++) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: multi-region event loop; "
+                              "budget exhaustion provides bounded termination");
+        uint32_t runnable = 0;
+        uint32_t remaining;
+        uint64_t tasks = 0;
+        int parked = 0;
+
+        for (i = 0; i < g_region_count; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by g_region_count");
+            const asx_region_slot *r = asx_region_at(i);
+
+            if (!asx_slot_live(r->key) || r->task_count == 0) continue;
+            if (r->ready_head == ASX_TASK_LINK_NONE) {
+                parked = 1;
+                continue;
+            }
+            runnable++;
+            tasks += r->task_count;
+        }
+
+        if (runnable == 0) {
+            if (parked) {
+                sched_emit(ASX_SCHED_EVENT_IDLE, ASX_INVALID_ID, pass);
+                return ASX_E_PENDING;
+            }
+            sched_emit(ASX_SCHED_EVENT_QUIESCENT, ASX_INVALID_ID, pass);
+            asx_trace_emit(ASX_TRACE_SCHED_QUIESCENT, ASX_INVALID_ID, pass);
+            return ASX_OK;
+        }
+        if (asx_budget_is_exhausted(budget)) {
+            sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, pass);
+            asx_trace_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, pass);
+            return ASX_E_POLL_BUDGET_EXHAUSTED;
+        }
+
+        /* Shares come from the polls left when the pass began */
+        remaining = asx_budget_polls(budget);
+        for (i = 0; i < g_region_count && budget->poll_quota > 0; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by g_region_count");
+            asx_region_slot *r = asx_region_at(i);
+            asx_budget share;
+            asx_status st;
+
+            if (!asx_slot_live(r->key) || r->task_count == 0) continue;
+            if (r->ready_head == ASX_TASK_LINK_NONE) continue;
+
+            share = *budget;
+            share.poll_quota = scheduler_share(policy, remaining, runnable,
+                                               tasks, r);
+            if (share.poll_quota > budget->poll_quota) {
+                share.poll_quota = budget->poll_quota;
+            }
+            budget->poll_quota -= share.poll_quota;
+            st = scheduler_run_rounds(asx_region_handle_at(i), r, &share);
+            budget->poll_quota += share.poll_quota;
+            budget->cost_quota = share.cost_quota;
+            if (st != ASX_OK && st != ASX_E_PENDING &&
+                st != ASX_E_POLL_BUDGET_EXHAUSTED) {
+                return st;
+            }
+        }
+    }
+}
+
+asx_status asx_scheduler_run_all(asx_budget *budget, asx_scheduler_share policy)
+{
+    asx_status st;
+
+    if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
+    if ((unsigned)policy > (unsigned)ASX_SCHED_SHARE_IN_ORDER) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    /* One log for the whole call: events accumulate across regions */
+    asx_scheduler_event_reset();
+
+    st = scheduler_run_all_passes(budget, policy);
+    asx_coarse_run_end();
+    return st;
+}
+
+/* -------------------------------------------------------------------
+ * Idle wait: sleep in the reactor until the next timer deadline
+ *
+ * The reactor timeout is the distance to the global wheel's earliest
+ * deadline, rounded up to whole milliseconds so the wheel is never
+ * polled early, and capped by the caller's max_wait_ms.
+ *
+ * The wait policy only changes how that gap is spent. SLEEP blocks in
+ * the reactor. BUSY_SPIN and YIELD poll the reactor without blocking
+ * once per ASX_SCHED_SPIN_BATCH CPU pauses (or thread yields) until
+ * something is ready or the deadline passes. ADAPTIVE spins for at
+ * most g_spin_window_ns, then sleeps out the rest: a wait the spin
+ * caught doubles the window, a wait that had to park halves it, so
+ * hosts whose wakeups come quickly keep spinning and idle ones park
+ * at once. A clock that does not move across a spin batch (a logical
+ * or simulated clock) ends the spin and parks. Deterministic builds
+ * always sleep, so replays see the same reactor and clock reads.
+ * ------------------------------------------------------------------- */
+
+#define ASX_SCHED_IDLE_COLLECT_BATCH 32u
+#define ASX_SCHED_SPIN_BATCH         64u
+#define ASX_SCHED_SPIN_WINDOW_MIN_NS 1000u
+#define ASX_SCHED_SPIN_WINDOW_MAX_NS 1000000u
+
+asx_status asx_scheduler_set_wait_policy(asx_wait_policy policy)
+{
+    if ((unsigned)policy > (unsigned)ASX_WAIT_ADAPTIVE) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    g_wait_policy = policy;
+    return ASX_OK;
+}
+
+asx_wait_policy asx_scheduler_wait_policy(void)
+{
+    return g_wait_policy;
+}
+
+uint64_t asx_scheduler_spin_window_ns(void)
+{
+    return g_spin_window_ns;
+}
+
+static void sched_cpu_relax(void)
+{
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    __builtin_ia32_pause();
+#elif (defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    __asm__ __volatile__("yield" : : : "memory");
+#endif
+}
+
+/* Spin until the reactor reports readiness, the clock reaches until,
+ * or the clock stalls; *io_now holds the last clock reading. */
+static asx_status sched_spin(int yield, asx_time until, asx_time *io_now,
+                             uint32_t *out_ready)
+{
+    asx_time last = *io_now;
+    uint32_t i;
+    asx_status st;
+
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("bounded by the spin deadline or readiness");
+        for (i = 0; i < ASX_SCHED_SPIN_BATCH; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_SCHED_SPIN_BATCH") */
+            if (!yield || asx_runtime_thread_yield() != ASX_OK) {
+                sched_cpu_relax();
+            }
+        }
+        st = asx_runtime_reactor_wait(0, out_ready, 0);
+        if (st != ASX_OK) return st;
+        st = asx_runtime_now_ns(io_now);
+        if (st != ASX_OK) return st;
+        if (*out_ready > 0 || *io_now >= until || *io_now == last) {
+            return ASX_OK;
+        }
+        last = *io_now;
+    }
+}
+
+/* Spend timeout_ms (already capped at the next deadline) per policy */
+static asx_status sched_idle_wait(uint32_t timeout_ms, uint64_t logical_step,
+                                  asx_time now)
+{
+    asx_wait_policy policy = g_wait_policy;
+    uint64_t span = (uint64_t)timeout_ms * 1000000u;
+    asx_time until;
+    asx_time spin_until;
+    uint32_t ready = 0;
+    asx_status st;
+
+#if ASX_DETERMINISTIC
+    policy = ASX_WAIT_SLEEP;
+#endif
+    if (policy == ASX_WAIT_SLEEP) {
+        return asx_runtime_reactor_wait(timeout_ms, &ready, logical_step);
+    }
+
+    until = span > UINT64_MAX - now ? UINT64_MAX : now + span;
+    spin_until = until;
+    if (policy == ASX_WAIT_ADAPTIVE && g_spin_window_ns < until - now) {
+        spin_until = now + g_spin_window_ns;
+    }
+
+    st = sched_spin(policy == ASX_WAIT_YIELD, spin_until, &now, &ready);
+    if (st != ASX_OK) return st;
+    if (ready > 0 || now >= until) {
+        if (policy == ASX_WAIT_ADAPTIVE) {
+            g_spin_window_ns = g_spin_window_ns >= ASX_SCHED_SPIN_WINDOW_MAX_NS / 2u
+                             ? ASX_SCHED_SPIN_WINDOW_MAX_NS : g_spin_window_ns * 2u;
+        }
+        return ASX_OK;
+    }
+
+    if (policy == ASX_WAIT_ADAPTIVE) {
+        g_spin_window_ns = g_spin_window_ns <= ASX_SCHED_SPIN_WINDOW_MIN_NS * 2u
+                         ? ASX_SCHED_SPIN_WINDOW_MIN_NS : g_spin_window_ns / 2u;
+    }
+    return asx_runtime_reactor_wait(
+        (uint32_t)((until - now + 999999u) / 1000000u), &ready, logical_step);
+}
+
+asx_status asx_scheduler_wait_idle(uint32_t max_wait_ms, uint32_t *out_fired)
+{
+    asx_timer_wheel *wheel = asx_timer_wheel_global();
+    void *wakers[ASX_SCHED_IDLE_COLLECT_BATCH];
+    asx_time now;
+    asx_time deadline = 0;
+    uint32_t timeout_ms = max_wait_ms;
+    uint32_t fired = 0;
+    uint32_t got;
+    asx_status st;
+
+    if (out_fired == NULL) return ASX_E_INVALID_ARGUMENT;
+    *out_fired = 0;
+
+    st = asx_runtime_now_ns(&now);
+    if (st != ASX_OK) return st;
+
+    if (asx_timer_next_deadline(wheel, &deadline) == ASX_OK) {
+        if (deadline <= now) {
+            timeout_ms = 0;
+        } else {
+            uint64_t ms = (deadline - now + 999999u) / 1000000u;
+            if (ms < (uint64_t)timeout_ms) timeout_ms = (uint32_t)ms;
+        }
+    }
+
+    if (timeout_ms > 0) {
+        st = sched_idle_wait(timeout_ms, (uint64_t)deadline, now);
+        if (st != ASX_OK) return st;
+        st = asx_runtime_now_ns(&now);
+        if (st != ASX_OK) return st;
+    }
+
+    /* Fire everything due; parked timer waiters are woken in order */
+    do {
+        ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+        got = asx_timer_collect_expired(wheel, now, wakers,
+                                        ASX_SCHED_IDLE_COLLECT_BATCH);
+        fired += got;
+    } while (got == ASX_SCHED_IDLE_COLLECT_BATCH);
+
+    *out_fired = fired;
+    return ASX_OK;
+}
+
+asx_status asx_scheduler_run_until(asx_region_id region, asx_budget *budget,
+                                   asx_time horizon)
+{
+    asx_timer_wheel *wheel = asx_timer_wheel_global();
+    asx_time deadline;
+    asx_time before;
+    asx_time after;
+    uint32_t fired;
+    asx_status st;
+
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("bounded by budget and registered timers");
+        st = asx_scheduler_run(region, budget);
+        if (st != ASX_E_PENDING) return st;
+        if (asx_timer_next_deadline(wheel, &deadline) != ASX_OK ||
+            deadline > horizon) {
+            return ASX_E_PENDING;
+        }
+        st = asx_runtime_now_ns(&before);
+        if (st != ASX_OK) return st;
+        st = asx_scheduler_wait_idle(UINT32_MAX, &fired);
+        if (st != ASX_OK) return st;
+        if (fired == 0) {
+            st = asx_runtime_now_ns(&after);
+            if (st != ASX_OK) return st;
+            if (after == before) return ASX_E_INVALID_STATE;
+        }
+    }
+}
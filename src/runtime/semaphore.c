@@ -0,0 +1,350 @@
+/*
+ * semaphore.c — counting semaphores with a FIFO wait queue
+ *
+ * A fixed pool of ASX_MAX_SEMAPHORES semaphores with a LIFO free list
+ * behind a never-used cursor, as the task groups have. A task that
+ * finds no permit joins its semaphore's wait queue, a doubly-linked
+ * list threaded through the tasks' cold slots (sem_prev / sem_next),
+ * and names the semaphore in cold->sem (index + 1).
+ *
+ * Permits are handed over rather than returned: while tasks are
+ * queued no permit is available, and a release marks the queue's head
+ * as granted and wakes that task alone. The granted task takes the
+ * permit on its next try_acquire. Cancellation and completion reach
+ * asx_semaphore_task_left, which unlinks a queued task in O(1) or
+ * hands a granted but untaken permit on to the next waiter, so a
+ * permit is never stranded on a task that will not run again.
+ *
+ * Handles encode [generation:16 | semaphore:16].
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include "runtime_internal.h"
+#include "context_internal.h"
+
+/* asx_task_cold.sem holds index + 1 in a uint8_t */
+#if ASX_MAX_SEMAPHORES > 255u
+#error "ASX_MAX_SEMAPHORES must fit asx_task_cold.sem"
+#endif
+
+typedef struct {
+    asx_region_id  region;
+    uint32_t       permits;      /* capacity given at create */
+    uint32_t       available;    /* 0 whenever tasks are queued */
+    uint32_t       head;         /* wait queue, task arena indices */
+    uint32_t       tail;
+    uint32_t       waiters;      /* tasks on the queue */
+    uint32_t       granted;      /* permits handed over, not yet taken */
+    uint32_t       next;         /* region list, or free list once freed */
+    uint16_t       generation;
+    uint8_t        live;
+} asx_sem_slot;
+
+static asx_sem_slot g_sems[ASX_MAX_SEMAPHORES];
+static uint32_t     g_sem_count;     /* never-used cursor */
+static uint32_t     g_sem_free_head = ASX_SEMAPHORE_LINK_NONE;
+
+static const uint32_t g_sem_link_none = ASX_SEMAPHORE_LINK_NONE;
+static const asx_context_block g_sem_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_sems),
+    ASX_CONTEXT_BLOCK(g_sem_count),
+    ASX_CONTEXT_BLOCK_INIT(g_sem_free_head, g_sem_link_none)
+};
+
+const asx_context_module asx_semaphore_context = ASX_CONTEXT_MODULE(g_sem_blocks);
+
+/* ------------------------------------------------------------------ */
+/* Internal helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+static uint32_t sem_token(uint32_t idx)
+{
+    return ((uint32_t)g_sems[idx].generation << 16) | idx;
+}
+
+/* The live semaphore named by sem, or NULL */
+static asx_sem_slot *sem_lookup(const asx_semaphore *sem)
+{
+    uint32_t idx;
+
+    if (sem == NULL) return NULL;
+    idx = sem->token & 0xFFFFu;
+    if (idx >= g_sem_count || !g_sems[idx].live) return NULL;
+    if (sem->token != sem_token(idx)) return NULL;
+    return &g_sems[idx];
+}
+
+static void sem_release_slot(asx_sem_slot *s)
+{
+    s->live = 0;
+    s->generation = (uint16_t)(s->generation + 1u);
+    s->next = g_sem_free_head;
+    g_sem_free_head = (uint32_t)(s - g_sems);
+}
+
+static void sem_enqueue(asx_sem_slot *s, uint32_t task_idx)
+{
+    asx_task_cold *cold = asx_task_at(task_idx)->cold;
+
+    cold->sem = (uint8_t)((uint32_t)(s - g_sems) + 1u);
+    cold->sem_granted = 0;
+    cold->sem_prev = s->tail;
+    cold->sem_next = ASX_TASK_LINK_NONE;
+    if (s->tail == ASX_TASK_LINK_NONE) {
+        s->head = task_idx;
+    } else {
+        asx_task_at(s->tail)->cold->sem_next = task_idx;
+    }
+    s->tail = task_idx;
+    s->waiters++;
+}
+
+static void sem_unlink(asx_sem_slot *s, uint32_t task_idx)
+{
+    asx_task_cold *cold = asx_task_at(task_idx)->cold;
+
+    if (cold->sem_prev == ASX_TASK_LINK_NONE) {
+        s->head = cold->sem_next;
+    } else {
+        asx_task_at(cold->sem_prev)->cold->sem_next = cold->sem_next;
+    }
+    if (cold->sem_next == ASX_TASK_LINK_NONE) {
+        s->tail = cold->sem_prev;
+    } else {
+        asx_task_at(cold->sem_next)->cold->sem_prev = cold->sem_prev;
+    }
+    cold->sem_prev = ASX_TASK_LINK_NONE;
+    cold->sem_next = ASX_TASK_LINK_NONE;
+    s->waiters--;
+}
+
+/* Give one permit back: to the queue's head if any, else to the pool */
+static void sem_hand_over(asx_sem_slot *s)
+{
+    uint32_t task_idx = s->head;
+
+    if (task_idx == ASX_TASK_LINK_NONE) {
+        s->available++;
+        return;
+    }
+    sem_unlink(s, task_idx);
+    asx_task_at(task_idx)->cold->sem_granted = 1;
+    s->granted++;
+    asx_task_wake_internal(task_idx);
+}
+
+/* Task lookup shared by acquire and park: the task must belong to the
+ * semaphore's region */
+static asx_status sem_task(const asx_sem_slot *s, asx_task_id task,
+                           asx_task_slot **out)
+{
+    asx_status st = asx_task_slot_lookup(task, out);
+
+    if (st != ASX_OK) return st;
+    if ((*out)->region != s->region) return ASX_E_INVALID_ARGUMENT;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Semaphore API                                                      */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_semaphore_create(asx_region_id region, uint32_t permits,
+                                asx_semaphore *out)
+{
+    asx_region_slot *r;
+    asx_sem_slot *s;
+    uint32_t idx;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->token = 0;
+    if (permits == 0u) return ASX_E_INVALID_ARGUMENT;
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+    if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
+
+    if (g_sem_free_head != ASX_SEMAPHORE_LINK_NONE) {
+        idx = g_sem_free_head;
+        g_sem_free_head = g_sems[idx].next;
+    } else if (g_sem_count < ASX_MAX_SEMAPHORES) {
+        idx = g_sem_count++;
+    } else {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    s = &g_sems[idx];
+    s->region = region;
+    s->permits = permits;
+    s->available = permits;
+    s->head = ASX_TASK_LINK_NONE;
+    s->tail = ASX_TASK_LINK_NONE;
+    s->waiters = 0;
+    s->granted = 0;
+    s->live = 1;
+    s->next = r->sem_head;
+    r->sem_head = idx;
+
+    out->token = sem_token(idx);
+    return ASX_OK;
+}
+
+asx_status asx_semaphore_try_acquire(const asx_semaphore *sem, asx_task_id task)
+{
+    asx_sem_slot *s;
+    asx_task_slot *t;
+    asx_task_cold *cold;
+    uint8_t mine;
+    asx_status st;
+
+    if (sem == NULL) return ASX_E_INVALID_ARGUMENT;
+    s = sem_lookup(sem);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    st = sem_task(s, task, &t);
+    if (st != ASX_OK) return st;
+    cold = t->cold;
+    mine = (uint8_t)((sem->token & 0xFFFFu) + 1u);
+    if (cold->sem != 0u && cold->sem != mine) return ASX_E_INVALID_STATE;
+    if (t->cancel_pending) return ASX_E_CANCELLED;
+
+    if (cold->sem == mine) {
+        if (!cold->sem_granted) return ASX_E_WOULD_BLOCK;
+        cold->sem = 0;
+        cold->sem_granted = 0;
+        s->granted--;
+        return ASX_OK;
+    }
+    if (s->available > 0u) {
+        s->available--;
+        return ASX_OK;
+    }
+    sem_enqueue(s, asx_handle_slot(task));
+    return ASX_E_WOULD_BLOCK;
+}
+
+asx_status asx_semaphore_release(const asx_semaphore *sem)
+{
+    asx_sem_slot *s;
+
+    if (sem == NULL) return ASX_E_INVALID_ARGUMENT;
+    s = sem_lookup(sem);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    if (s->head == ASX_TASK_LINK_NONE &&
+        s->available + s->granted >= s->permits) {
+        return ASX_E_INVALID_STATE;
+    }
+    sem_hand_over(s);
+    return ASX_OK;
+}
+
+asx_status asx_semaphore_query(const asx_semaphore *sem,
+                               uint32_t *out_available, uint32_t *out_waiters)
+{
+    asx_sem_slot *s;
+
+    if (sem == NULL || out_available == NULL || out_waiters == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    s = sem_lookup(sem);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    *out_available = s->available;
+    *out_waiters = s->waiters;
+    return ASX_OK;
+}
+
+asx_status asx_semaphore_destroy(const asx_semaphore *sem)
+{
+    asx_sem_slot *s;
+    asx_region_slot *r;
+    uint32_t idx;
+    uint32_t *link;
+
+    if (sem == NULL) return ASX_E_INVALID_ARGUMENT;
+    s = sem_lookup(sem);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    if (s->waiters != 0u || s->granted != 0u) return ASX_E_TASKS_STILL_ACTIVE;
+
+    /* The region is open: closing it would have freed the semaphore */
+    idx = sem->token & 0xFFFFu;
+    if (asx_region_slot_lookup(s->region, &r) == ASX_OK) {
+        for (link = &r->sem_head; *link != ASX_SEMAPHORE_LINK_NONE;
+             link = &g_sems[*link].next) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_SEMAPHORES");
+            if (*link == idx) {
+                *link = s->next;
+                break;
+            }
+        }
+    }
+    sem_release_slot(s);
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Runtime integration                                                */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_semaphore_wait(const asx_semaphore *sem, asx_task_id task,
+                              uint64_t *out_key, int *out_granted)
+{
+    asx_sem_slot *s;
+    asx_task_slot *t;
+    asx_status st;
+
+    if (sem == NULL) return ASX_E_INVALID_ARGUMENT;
+    s = sem_lookup(sem);
+    if (s == NULL) return ASX_E_INVALID_STATE;
+    st = sem_task(s, task, &t);
+    if (st != ASX_OK) return st;
+    if (t->cold->sem != (uint8_t)((sem->token & 0xFFFFu) + 1u)) {
+        return ASX_E_INVALID_STATE;
+    }
+    *out_granted = t->cold->sem_granted;
+    *out_key = (uint64_t)sem->token;
+    return ASX_OK;
+}
+
+void asx_semaphore_task_left(uint32_t task_idx)
+{
+    asx_task_cold *cold = asx_task_at(task_idx)->cold;
+    asx_sem_slot *s = &g_sems[cold->sem - 1u];
+
+    if (cold->sem_granted) {
+        cold->sem_granted = 0;
+        s->granted--;
+        sem_hand_over(s);
+    } else {
+        sem_unlink(s, task_idx);
+    }
+    cold->sem = 0;
+}
+
+void asx_semaphore_region_reclaim(uint32_t *head)
+{
+    uint32_t idx = *head;
+
+    while (idx != ASX_SEMAPHORE_LINK_NONE) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_SEMAPHORES") */
+        uint32_t next = g_sems[idx].next;
+
+        sem_release_slot(&g_sems[idx]);
+        idx = next;
+    }
+    *head = ASX_SEMAPHORE_LINK_NONE;
+}
+
+void asx_semaphore_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_sem_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_SEMAPHORES");
+        /* Keep generations so handles from before the reset stay stale */
+        g_sems[i].live = 0;
+        g_sems[i].generation = (uint16_t)(g_sems[i].generation + 1u);
+        g_sems[i].next = (i + 1u < g_sem_count) ? i + 1u : ASX_SEMAPHORE_LINK_NONE;
+    }
+    g_sem_free_head = g_sem_count != 0u ? 0u : ASX_SEMAPHORE_LINK_NONE;
+}
@@ -0,0 +1,479 @@
+/*
+ * slab.c — size-class slab allocator hook
+ *
+ * Every block carries an 8-byte header naming its class, so free and
+ * realloc find the class in O(1); pass-through allocations carry the
+ * same header with SLAB_LARGE. A free block's first word links it into
+ * its class's free list (or its thread cache).
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("slab: loops are bounded by the class "
+ *   "count, the blocks in one chunk, or the caller's reserve count. "
+ *   "Allocator hooks run outside task polls' checkpointed work.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/runtime/slab.h>
+#include <string.h>
+
+#define SLAB_LARGE     0xFFFFFFFFu
+#define SLAB_HDR_BYTES sizeof(slab_header)
+
+typedef union {
+    uint32_t class_index;
+    uint64_t align;                /* keeps blocks 8-byte aligned */
+} slab_header;
+
+typedef union slab_chunk {
+    union slab_chunk *next;
+    uint64_t align;
+} slab_chunk;
+
+typedef struct slab_free_block {
+    struct slab_free_block *next;
+} slab_free_block;
+
+static uint64_t g_slab_epoch;
+
+#if ASX_SLAB_THREADED
+#define slab_lock(s)   while (__atomic_exchange_n(&(s)->lock, 1u, __ATOMIC_ACQUIRE) != 0u) {}
+#define slab_unlock(s) __atomic_store_n(&(s)->lock, 0u, __ATOMIC_RELEASE)
+#define slab_next_epoch() __atomic_add_fetch(&g_slab_epoch, 1u, __ATOMIC_RELAXED)
+#else
+#define slab_lock(s)   ((void)(s))
+#define slab_unlock(s) ((void)(s))
+#define slab_next_epoch() (++g_slab_epoch)
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Configuration                                                      */
+/* ------------------------------------------------------------------ */
+
+void asx_slab_config_init(asx_slab_config *cfg)
+{
+    asx_runtime_hooks defaults;
+    uint32_t i;
+
+    if (cfg == NULL) return;
+    memset(cfg, 0, sizeof(*cfg));
+    for (i = 0; i < ASX_SLAB_MAX_CLASSES; i++) {
+        cfg->class_sizes[i] = (size_t)16u << i;
+    }
+    cfg->chunk_bytes = ASX_SLAB_CHUNK_BYTES;
+    cfg->thread_cache = 0;
+    (void)asx_runtime_hooks_init(&defaults);
+    cfg->backing = defaults.allocator;
+}
+
+asx_status asx_slab_init(asx_slab *slab, const asx_slab_config *cfg)
+{
+    asx_slab_config defaults;
+    uint32_t i;
+    uint32_t n = 0;
+
+    if (slab == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (cfg == NULL) {
+        asx_slab_config_init(&defaults);
+        cfg = &defaults;
+    }
+    if (cfg->backing.malloc_fn == NULL || cfg->backing.free_fn == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    while (n < ASX_SLAB_MAX_CLASSES && cfg->class_sizes[n] != 0) {
+        if (n > 0 && cfg->class_sizes[n] <= cfg->class_sizes[n - 1u]) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        if (cfg->class_sizes[n] > ((size_t)-1 >> 1)) return ASX_E_INVALID_ARGUMENT;
+        n++;
+    }
+    if (n == 0) return ASX_E_INVALID_ARGUMENT;
+
+    memset(slab, 0, sizeof(*slab));
+    for (i = 0; i < n; i++) {
+        asx_slab_class *c = &slab->classes[i];
+        size_t stride;
+        size_t fit;
+
+        /* Round up to the header's alignment */
+        c->block_size = (cfg->class_sizes[i] + SLAB_HDR_BYTES - 1u) &
+                        ~(SLAB_HDR_BYTES - 1u);
+        stride = SLAB_HDR_BYTES + c->block_size;
+        fit = cfg->chunk_bytes > sizeof(slab_chunk)
+            ? (cfg->chunk_bytes - sizeof(slab_chunk)) / stride : 0;
+        c->blocks_per_chunk = fit == 0 ? 1u : (uint32_t)fit;
+    }
+    slab->class_count = n;
+    slab->backing = cfg->backing;
+    slab->epoch = slab_next_epoch();
+    slab->thread_cache = (uint8_t)(ASX_SLAB_THREADED && cfg->thread_cache);
+    return ASX_OK;
+}
+
+void asx_slab_destroy(asx_slab *slab)
+{
+    slab_chunk *chunk;
+
+    if (slab == NULL) return;
+    chunk = (slab_chunk *)slab->chunks;
+    while (chunk != NULL) {
+        slab_chunk *next = chunk->next;
+        slab->backing.free_fn(slab->backing.ctx, chunk);
+        chunk = next;
+    }
+    memset(slab, 0, sizeof(*slab));
+}
+
+/* ------------------------------------------------------------------ */
+/* Shared free lists (caller holds the lock)                          */
+/* ------------------------------------------------------------------ */
+
+static uint32_t slab_class_for(const asx_slab *slab, size_t size)
+{
+    uint32_t i;
+
+    for (i = 0; i < slab->class_count; i++) {
+        if (size <= slab->classes[i].block_size) return i;
+    }
+    return SLAB_LARGE;
+}
+
+/* Carve one chunk of blocks onto c's free list. */
+static int slab_refill(asx_slab *slab, uint32_t class_index)
+{
+    asx_slab_class *c = &slab->classes[class_index];
+    size_t stride = SLAB_HDR_BYTES + c->block_size;
+    uint8_t *p;
+    slab_chunk *chunk;
+    uint32_t i;
+
+    if (slab->sealed || c->total > UINT32_MAX - c->blocks_per_chunk) return 0;
+    chunk = (slab_chunk *)slab->backing.malloc_fn(
+        slab->backing.ctx, sizeof(slab_chunk) + (size_t)c->blocks_per_chunk * stride);
+    if (chunk == NULL) return 0;
+    chunk->next = (slab_chunk *)slab->chunks;
+    slab->chunks = chunk;
+
+    p = (uint8_t *)(chunk + 1);
+    for (i = 0; i < c->blocks_per_chunk; i++) {
+        slab_free_block *b = (slab_free_block *)(void *)(p + SLAB_HDR_BYTES);
+        ((slab_header *)(void *)p)->class_index = class_index;
+        b->next = (slab_free_block *)c->free_head;
+        c->free_head = b;
+        p += stride;
+    }
+    c->total += c->blocks_per_chunk;
+    c->free_count += c->blocks_per_chunk;
+    return 1;
+}
+
+static slab_free_block *slab_pop_shared(asx_slab *slab, uint32_t class_index)
+{
+    asx_slab_class *c = &slab->classes[class_index];
+    slab_free_block *b;
+
+    if (c->free_head == NULL && !slab_refill(slab, class_index)) return NULL;
+    b = (slab_free_block *)c->free_head;
+    c->free_head = b->next;
+    c->free_count--;
+    return b;
+}
+
+static void slab_push_shared(asx_slab *slab, uint32_t class_index,
+                             slab_free_block *b)
+{
+    asx_slab_class *c = &slab->classes[class_index];
+
+    b->next = (slab_free_block *)c->free_head;
+    c->free_head = b;
+    c->free_count++;
+}
+
+/* ------------------------------------------------------------------ */
+/* Per-thread caches                                                  */
+/* ------------------------------------------------------------------ */
+
+#if ASX_SLAB_THREADED
+#define SLAB_CACHE_BATCH (ASX_SLAB_CACHE_DEPTH / 2u)
+
+typedef struct {
+    uint64_t         epoch;        /* owning slab; 0 when unbound */
+    slab_free_block *head[ASX_SLAB_MAX_CLASSES];
+    uint32_t         count[ASX_SLAB_MAX_CLASSES];
+} slab_thread_cache;
+
+static __thread slab_thread_cache t_slab_cache;
+
+/* The calling thread's cache for slab, rebinding it when it belonged to
+ * another slab. Blocks left in a stale cache stay where they are: the
+ * old slab counts them as held, as if never flushed. */
+static slab_thread_cache *slab_cache_for(const asx_slab *slab)
+{
+    slab_thread_cache *tc = &t_slab_cache;
+
+    if (!slab->thread_cache) return NULL;
+    if (tc->epoch != slab->epoch) {
+        memset(tc, 0, sizeof(*tc));
+        tc->epoch = slab->epoch;
+    }
+    return tc;
+}
+
+static void *slab_cache_alloc(asx_slab *slab, slab_thread_cache *tc,
+                              uint32_t class_index)
+{
+    slab_free_block *b;
+    uint32_t i;
+
+    if (tc->count[class_index] == 0) {
+        slab_lock(slab);
+        for (i = 0; i < SLAB_CACHE_BATCH; i++) {
+            b = slab_pop_shared(slab, class_index);
+            if (b == NULL) break;
+            b->next = tc->head[class_index];
+            tc->head[class_index] = b;
+            tc->count[class_index]++;
+        }
+        slab_unlock(slab);
+        if (tc->count[class_index] == 0) return NULL;
+    }
+    b = tc->head[class_index];
+    tc->head[class_index] = b->next;
+    tc->count[class_index]--;
+    return b;
+}
+
+static void slab_cache_free(asx_slab *slab, slab_thread_cache *tc,
+                            uint32_t class_index, slab_free_block *b)
+{
+    slab_free_block *out;
+    uint32_t i;
+
+    if (tc->count[class_index] >= ASX_SLAB_CACHE_DEPTH) {
+        slab_lock(slab);
+        for (i = 0; i < SLAB_CACHE_BATCH; i++) {
+            out = tc->head[class_index];
+            tc->head[class_index] = out->next;
+            slab_push_shared(slab, class_index, out);
+        }
+        slab_unlock(slab);
+        tc->count[class_index] -= SLAB_CACHE_BATCH;
+    }
+    b->next = tc->head[class_index];
+    tc->head[class_index] = b;
+    tc->count[class_index]++;
+}
+#endif
+
+void asx_slab_thread_flush(asx_slab *slab)
+{
+#if ASX_SLAB_THREADED
+    slab_thread_cache *tc = &t_slab_cache;
+    uint32_t k;
+
+    if (slab == NULL || tc->epoch != slab->epoch) return;
+    slab_lock(slab);
+    for (k = 0; k < slab->class_count; k++) {
+        while (tc->head[k] != NULL) {
+            slab_free_block *b = tc->head[k];
+            tc->head[k] = b->next;
+            slab_push_shared(slab, k, b);
+        }
+        tc->count[k] = 0;
+    }
+    slab_unlock(slab);
+#else
+    (void)slab;
+#endif
+}
+
+/* ------------------------------------------------------------------ */
+/* Allocator hooks                                                    */
+/* ------------------------------------------------------------------ */
+
+static void *slab_large_alloc(asx_slab *slab, size_t size)
+{
+    slab_header *h;
+
+    if (slab->sealed || size > (size_t)-1 - SLAB_HDR_BYTES) return NULL;
+    h = (slab_header *)slab->backing.malloc_fn(slab->backing.ctx,
+                                               SLAB_HDR_BYTES + size);
+    if (h == NULL) return NULL;
+    h->class_index = SLAB_LARGE;
+    slab_lock(slab);
+    slab->large_live++;
+    slab_unlock(slab);
+    return h + 1;
+}
+
+void *asx_slab_alloc(void *ctx, size_t size)
+{
+    asx_slab *slab = (asx_slab *)ctx;
+    uint32_t k;
+    void *p;
+
+    if (slab == NULL || slab->class_count == 0) return NULL;
+    k = slab_class_for(slab, size);
+    if (k == SLAB_LARGE) return slab_large_alloc(slab, size);
+#if ASX_SLAB_THREADED
+    {
+        slab_thread_cache *tc = slab_cache_for(slab);
+        if (tc != NULL) return slab_cache_alloc(slab, tc, k);
+    }
+#endif
+    slab_lock(slab);
+    p = slab_pop_shared(slab, k);
+    slab_unlock(slab);
+    return p;
+}
+
+void asx_slab_free(void *ctx, void *ptr)
+{
+    asx_slab *slab = (asx_slab *)ctx;
+    slab_header *h;
+    uint32_t k;
+
+    if (slab == NULL || ptr == NULL) return;
+    h = (slab_header *)ptr - 1;
+    k = h->class_index;
+    if (k == SLAB_LARGE) {
+        slab_lock(slab);
+        slab->large_live--;
+        slab_unlock(slab);
+        slab->backing.free_fn(slab->backing.ctx, h);
+        return;
+    }
+    if (k >= slab->class_count) return;
+#if ASX_SLAB_THREADED
+    {
+        slab_thread_cache *tc = slab_cache_for(slab);
+        if (tc != NULL) {
+            slab_cache_free(slab, tc, k, (slab_free_block *)ptr);
+            return;
+        }
+    }
+#endif
+    slab_lock(slab);
+    slab_push_shared(slab, k, (slab_free_block *)ptr);
+    slab_unlock(slab);
+}
+
+void *asx_slab_realloc(void *ctx, void *ptr, size_t size)
+{
+    asx_slab *slab = (asx_slab *)ctx;
+    slab_header *h;
+    size_t keep;
+    void *p;
+
+    if (ptr == NULL) return asx_slab_alloc(ctx, size);
+    if (slab == NULL) return NULL;
+    if (size == 0) {
+        asx_slab_free(ctx, ptr);
+        return NULL;
+    }
+    h = (slab_header *)ptr - 1;
+    if (h->class_index == SLAB_LARGE) {
+        if (slab->sealed || slab->backing.realloc_fn == NULL ||
+            size > (size_t)-1 - SLAB_HDR_BYTES) {
+            return NULL;
+        }
+        h = (slab_header *)slab->backing.realloc_fn(slab->backing.ctx, h,
+                                                    SLAB_HDR_BYTES + size);
+        return h != NULL ? (void *)(h + 1) : NULL;
+    }
+    if (h->class_index >= slab->class_count) return NULL;
+    keep = slab->classes[h->class_index].block_size;
+    if (size <= keep) return ptr;
+
+    p = asx_slab_alloc(ctx, size);
+    if (p == NULL) return NULL;
+    memcpy(p, ptr, keep);
+    asx_slab_free(ctx, ptr);
+    return p;
+}
+
+asx_status asx_slab_install(asx_slab *slab, asx_runtime_hooks *hooks)
+{
+    if (slab == NULL || hooks == NULL || slab->class_count == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    hooks->allocator.ctx = slab;
+    hooks->allocator.malloc_fn = asx_slab_alloc;
+    hooks->allocator.realloc_fn = asx_slab_realloc;
+    hooks->allocator.free_fn = asx_slab_free;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Reserve, seal, utilization                                         */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_slab_reserve(asx_slab *slab, size_t size, uint32_t count)
+{
+    asx_status st = ASX_OK;
+    uint32_t k;
+
+    if (slab == NULL || slab->class_count == 0) return ASX_E_INVALID_ARGUMENT;
+    k = slab_class_for(slab, size);
+    if (k == SLAB_LARGE) return ASX_E_INVALID_ARGUMENT;
+
+    slab_lock(slab);
+    if (slab->sealed) {
+        st = ASX_E_INVALID_STATE;
+    } else {
+        while (slab->classes[k].free_count < count) {
+            if (!slab_refill(slab, k)) {
+                st = ASX_E_RESOURCE_EXHAUSTED;
+                break;
+            }
+        }
+    }
+    slab_unlock(slab);
+    return st;
+}
+
+asx_status asx_slab_seal(asx_slab *slab)
+{
+    asx_status st = ASX_OK;
+
+    if (slab == NULL) return ASX_E_INVALID_ARGUMENT;
+    slab_lock(slab);
+    if (slab->sealed) {
+        st = ASX_E_INVALID_STATE;
+    } else {
+        slab->sealed = 1;
+    }
+    slab_unlock(slab);
+    return st;
+}
+
+asx_status asx_slab_snapshot(asx_slab *slab, uint32_t class_index,
+                             asx_resource_snapshot *out)
+{
+    uint32_t first, last, k;
+    uint32_t total = 0;
+    uint32_t free_count = 0;
+
+    if (slab == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (class_index == UINT32_MAX) {
+        first = 0;
+        last = slab->class_count;
+    } else if (class_index < slab->class_count) {
+        first = class_index;
+        last = class_index + 1u;
+    } else {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    slab_lock(slab);
+    for (k = first; k < last; k++) {
+        total += slab->classes[k].total;
+        free_count += slab->classes[k].free_count;
+    }
+    slab_unlock(slab);
+
+    out->kind = ASX_RESOURCE_ALLOCATOR;
+    out->capacity = total;
+    out->used = total - free_count;
+    out->remaining = free_count;
+    return ASX_OK;
+}
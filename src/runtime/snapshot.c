@@ -0,0 +1,945 @@
+/*
+ * snapshot.c — binary runtime state snapshots with dirty-slot refresh
+ *
+ * Records are indexed by arena slot, so a capture into the snapshot
+ * that was captured last only rebuilds the slots whose dirty bit a
+ * lifecycle transition set since then (asx_snapshot_touch_*). Any
+ * other capture, and the first after asx_runtime_reset, rebuilds
+ * every slot.
+ *
+ * The binary form and restore follow: encode/decode of full and delta
+ * snapshots, and rebuilding the arenas from a decoded snapshot.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <asx/asx.h>
+#include <asx/runtime/snapshot.h>
+#include "runtime_internal.h"
+
+uint64_t g_snapshot_dirty_regions[ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_REGIONS)];
+uint64_t g_snapshot_dirty_tasks[ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_TASKS)];
+uint64_t g_snapshot_dirty_obligations[ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_OBLIGATIONS)];
+
+/* Mark of the most recent capture; the dirty words are relative to it */
+static uint64_t g_snapshot_mark;
+
+void asx_snapshot_reset(void)
+{
+    memset(g_snapshot_dirty_regions, 0, sizeof(g_snapshot_dirty_regions));
+    memset(g_snapshot_dirty_tasks, 0, sizeof(g_snapshot_dirty_tasks));
+    memset(g_snapshot_dirty_obligations, 0, sizeof(g_snapshot_dirty_obligations));
+    g_snapshot_mark++;
+}
+
+void asx_runtime_snapshot_init(asx_runtime_snapshot *snap)
+{
+    if (snap == NULL) return;
+    memset(snap, 0, sizeof(*snap));
+}
+
+/* ------------------------------------------------------------------ */
+/* Per-slot refresh                                                    */
+/* ------------------------------------------------------------------ */
+
+static asx_status snapshot_outcome_status(const asx_task_slot *t)
+{
+    if (t->state != ASX_TASK_COMPLETED) return ASX_E_TASK_NOT_COMPLETED;
+    switch (asx_task_cold_outcome(t->cold).severity) {
+    case ASX_OUTCOME_OK:        return ASX_OK;
+    case ASX_OUTCOME_CANCELLED: return ASX_E_CANCELLED;
+    case ASX_OUTCOME_ERR:
+    case ASX_OUTCOME_PANICKED:  break;
+    }
+    return ASX_E_INVALID_STATE;
+}
+
+static void snapshot_refresh_region(asx_runtime_snapshot *snap, uint32_t idx)
+{
+    asx_snapshot_region *rec = &snap->regions[idx];
+    const asx_region_slot *r;
+
+    if (rec->id != ASX_INVALID_ID) snap->region_count--;
+    memset(rec, 0, sizeof(*rec));
+    if (idx >= g_region_count) return;
+    r = asx_region_at(idx);
+    if (!asx_slot_live(r->key)) return;
+
+    rec->id         = asx_region_handle_at(idx);
+    rec->state      = r->state;
+    rec->task_count = r->task_count;
+    rec->task_total = r->task_total;
+    rec->poisoned   = r->poisoned;
+    if (r->parent != ASX_REGION_LINK_NONE) {
+        /* As of the child's open, when the parent was OPEN */
+        rec->parent = asx_handle_pack(ASX_TYPE_REGION,
+                                      (uint16_t)(1u << (unsigned)ASX_REGION_OPEN),
+                                      asx_handle_pack_index(
+                                          asx_slot_generation(asx_region_at(r->parent)->key),
+                                          r->parent));
+    }
+    snap->region_count++;
+}
+
+static void snapshot_refresh_task(asx_runtime_snapshot *snap, uint32_t idx)
+{
+    asx_snapshot_task *rec = &snap->tasks[idx];
+    const asx_task_slot *t;
+
+    if (rec->id != ASX_INVALID_ID) snap->task_count--;
+    memset(rec, 0, sizeof(*rec));
+    if (idx >= g_task_count) return;
+    t = asx_task_at(idx);
+    if (!asx_slot_live(t->key)) return;
+
+    rec->id = asx_handle_pack(ASX_TYPE_TASK,
+                              (uint16_t)(1u << (unsigned)t->state),
+                              asx_handle_pack_index(asx_slot_generation(t->key), idx));
+    rec->state          = t->state;
+    rec->region         = t->region;
+    rec->outcome_status = snapshot_outcome_status(t);
+    snap->task_count++;
+}
+
+static void snapshot_refresh_obligation(asx_runtime_snapshot *snap, uint32_t idx)
+{
+    asx_snapshot_obligation *rec = &snap->obligations[idx];
+    const asx_obligation_slot *o;
+
+    if (rec->id != ASX_INVALID_ID) snap->obligation_count--;
+    memset(rec, 0, sizeof(*rec));
+    if (idx >= g_obligation_count) return;
+    o = asx_obligation_at(idx);
+    if (!asx_slot_live(o->key)) return;
+
+    rec->id = asx_handle_pack(ASX_TYPE_OBLIGATION,
+                              (uint16_t)(1u << (unsigned)o->state),
+                              asx_handle_pack_index(asx_slot_generation(o->key), idx));
+    rec->state  = o->state;
+    rec->region = o->region;
+    snap->obligation_count++;
+}
+
+/* Lowest set bit of *word, cleared; the word must be nonzero. */
+static uint32_t snapshot_take_bit(uint64_t *word)
+{
+    uint64_t w = *word;
+    uint32_t bit = 0;
+
+    while ((w & 1u) == 0) {
+        ASX_CHECKPOINT_WAIVER("bounded by 64 bits per word");
+        w >>= 1;
+        bit++;
+    }
+    *word &= *word - 1u;
+    return bit;
+}
+
+/* 1 if a live slot sits at or above the snapshot's capacity. */
+static int snapshot_overflows(void)
+{
+    uint32_t i;
+
+    for (i = ASX_SNAPSHOT_MAX_REGIONS; i < g_region_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by g_region_count");
+        if (asx_slot_live(asx_region_at(i)->key)) return 1;
+    }
+    for (i = ASX_SNAPSHOT_MAX_TASKS; i < g_task_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by g_task_count");
+        if (asx_slot_live(asx_task_at(i)->key)) return 1;
+    }
+    for (i = ASX_SNAPSHOT_MAX_OBLIGATIONS; i < g_obligation_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by g_obligation_count");
+        if (asx_slot_live(asx_obligation_at(i)->key)) return 1;
+    }
+    return 0;
+}
+
+asx_status asx_runtime_snapshot_capture(asx_runtime_snapshot *snap)
+{
+    uint32_t w;
+    uint32_t i;
+
+    if (snap == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (snapshot_overflows()) return ASX_E_BUFFER_TOO_SMALL;
+
+    if (snap->capture_mark != 0 && snap->capture_mark == g_snapshot_mark) {
+        for (w = 0; w < ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_REGIONS); w++) {
+            ASX_CHECKPOINT_WAIVER("bounded by the region dirty words");
+            while (g_snapshot_dirty_regions[w] != 0) {
+                ASX_CHECKPOINT_WAIVER("bounded by 64 bits per word");
+                snapshot_refresh_region(snap,
+                    w * 64u + snapshot_take_bit(&g_snapshot_dirty_regions[w]));
+            }
+        }
+        for (w = 0; w < ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_TASKS); w++) {
+            ASX_CHECKPOINT_WAIVER("bounded by the task dirty words");
+            while (g_snapshot_dirty_tasks[w] != 0) {
+                ASX_CHECKPOINT_WAIVER("bounded by 64 bits per word");
+                snapshot_refresh_task(snap,
+                    w * 64u + snapshot_take_bit(&g_snapshot_dirty_tasks[w]));
+            }
+        }
+        for (w = 0; w < ASX_SNAPSHOT_DIRTY_WORDS(ASX_SNAPSHOT_MAX_OBLIGATIONS); w++) {
+            ASX_CHECKPOINT_WAIVER("bounded by the obligation dirty words");
+            while (g_snapshot_dirty_obligations[w] != 0) {
+                ASX_CHECKPOINT_WAIVER("bounded by 64 bits per word");
+                snapshot_refresh_obligation(snap,
+                    w * 64u + snapshot_take_bit(&g_snapshot_dirty_obligations[w]));
+            }
+        }
+    } else {
+        asx_runtime_snapshot_init(snap);
+        for (i = 0; i < ASX_SNAPSHOT_MAX_REGIONS; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+            snapshot_refresh_region(snap, i);
+        }
+        for (i = 0; i < ASX_SNAPSHOT_MAX_TASKS; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+            snapshot_refresh_task(snap, i);
+        }
+        for (i = 0; i < ASX_SNAPSHOT_MAX_OBLIGATIONS; i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+            snapshot_refresh_obligation(snap, i);
+        }
+        memset(g_snapshot_dirty_regions, 0, sizeof(g_snapshot_dirty_regions));
+        memset(g_snapshot_dirty_tasks, 0, sizeof(g_snapshot_dirty_tasks));
+        memset(g_snapshot_dirty_obligations, 0, sizeof(g_snapshot_dirty_obligations));
+    }
+
+    snap->event_hash = asx_trace_digest();
+    snap->capture_mark = ++g_snapshot_mark;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Comparison                                                          */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_runtime_snapshot_eq(const asx_runtime_snapshot *a,
+                                   const asx_runtime_snapshot *b)
+{
+    uint32_t i;
+
+    if (a == NULL || b == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (a->region_count != b->region_count ||
+        a->task_count != b->task_count ||
+        a->obligation_count != b->obligation_count ||
+        a->event_hash != b->event_hash) {
+        return ASX_E_EQUIVALENCE_MISMATCH;
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_REGIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        const asx_snapshot_region *ra = &a->regions[i];
+        const asx_snapshot_region *rb = &b->regions[i];
+        if (ra->id != rb->id || ra->state != rb->state ||
+            ra->task_count != rb->task_count ||
+            ra->task_total != rb->task_total ||
+            ra->poisoned != rb->poisoned || ra->parent != rb->parent) {
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_TASKS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        const asx_snapshot_task *ta = &a->tasks[i];
+        const asx_snapshot_task *tb = &b->tasks[i];
+        if (ta->id != tb->id || ta->state != tb->state ||
+            ta->region != tb->region ||
+            ta->outcome_status != tb->outcome_status) {
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_OBLIGATIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+        const asx_snapshot_obligation *oa = &a->obligations[i];
+        const asx_snapshot_obligation *ob = &b->obligations[i];
+        if (oa->id != ob->id || oa->state != ob->state ||
+            oa->region != ob->region) {
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+    }
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* JSON                                                                */
+/* ------------------------------------------------------------------ */
+
+/* Separator, '{' and the slot and id fields every record starts with */
+static asx_status snapshot_json_record(asx_codec_buffer *out, int *first_record,
+                                       uint32_t slot, uint64_t id, int *is_first)
+{
+    asx_status st;
+
+    if (!*first_record) {
+        st = asx_codec_buffer_append_char(out, ',');
+        if (st != ASX_OK) return st;
+    }
+    *first_record = 0;
+    *is_first = 1;
+    st = asx_codec_buffer_append_char(out, '{');
+    if (st != ASX_OK) return st;
+    st = asx_codec_buffer_append_u64_field(out, is_first, "slot", slot);
+    if (st != ASX_OK) return st;
+    return asx_codec_buffer_append_u64_field(out, is_first, "id", id);
+}
+
+asx_status asx_runtime_snapshot_to_json(const asx_runtime_snapshot *snap,
+                                        asx_codec_buffer *out)
+{
+    asx_status st;
+    uint32_t i;
+    int first_record;
+    int is_first;
+
+    if (snap == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_codec_buffer_append_cstr(out, "{\"regions\":[");
+    if (st != ASX_OK) return st;
+    first_record = 1;
+    for (i = 0; i < ASX_SNAPSHOT_MAX_REGIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        const asx_snapshot_region *r = &snap->regions[i];
+        if (r->id == ASX_INVALID_ID) continue;
+        st = snapshot_json_record(out, &first_record, i, r->id, &is_first);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "state",
+                                               (uint64_t)r->state);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "task_count",
+                                               r->task_count);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "task_total",
+                                               r->task_total);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "poisoned",
+                                               r->poisoned ? 1u : 0u);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "parent",
+                                               r->parent);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_char(out, '}');
+        if (st != ASX_OK) return st;
+    }
+
+    st = asx_codec_buffer_append_cstr(out, "],\"tasks\":[");
+    if (st != ASX_OK) return st;
+    first_record = 1;
+    for (i = 0; i < ASX_SNAPSHOT_MAX_TASKS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        const asx_snapshot_task *t = &snap->tasks[i];
+        if (t->id == ASX_INVALID_ID) continue;
+        st = snapshot_json_record(out, &first_record, i, t->id, &is_first);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "state",
+                                               (uint64_t)t->state);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "region",
+                                               t->region);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "outcome_status",
+                                               (uint64_t)t->outcome_status);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_char(out, '}');
+        if (st != ASX_OK) return st;
+    }
+
+    st = asx_codec_buffer_append_cstr(out, "],\"obligations\":[");
+    if (st != ASX_OK) return st;
+    first_record = 1;
+    for (i = 0; i < ASX_SNAPSHOT_MAX_OBLIGATIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+        const asx_snapshot_obligation *o = &snap->obligations[i];
+        if (o->id == ASX_INVALID_ID) continue;
+        st = snapshot_json_record(out, &first_record, i, o->id, &is_first);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "state",
+                                               (uint64_t)o->state);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_u64_field(out, &is_first, "region",
+                                               o->region);
+        if (st != ASX_OK) return st;
+        st = asx_codec_buffer_append_char(out, '}');
+        if (st != ASX_OK) return st;
+    }
+
+    st = asx_codec_buffer_append_cstr(out, "],\"event_hash\":");
+    if (st != ASX_OK) return st;
+    st = asx_codec_buffer_append_u64(out, snap->event_hash);
+    if (st != ASX_OK) return st;
+    return asx_codec_buffer_append_char(out, '}');
+}
+
+/* ------------------------------------------------------------------ */
+/* Digest                                                              */
+/* ------------------------------------------------------------------ */
+
+uint64_t asx_runtime_snapshot_digest(const asx_runtime_snapshot *snap)
+{
+    uint64_t h = 0x736e617073686f74ULL; /* "snapshot" */
+    uint32_t i;
+
+    if (snap == NULL) return 0;
+    h = asx_digest_word(h, ((uint64_t)snap->region_count << 32) | snap->task_count);
+    h = asx_digest_word(h, snap->obligation_count);
+    h = asx_digest_word(h, snap->event_hash);
+    for (i = 0; i < ASX_SNAPSHOT_MAX_REGIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        const asx_snapshot_region *r = &snap->regions[i];
+        if (r->id == ASX_INVALID_ID) continue;
+        h = asx_digest_word(h, r->id);
+        h = asx_digest_word(h, ((uint64_t)r->state << 32) | r->task_count);
+        h = asx_digest_word(h, ((uint64_t)r->task_total << 32) |
+                               (r->poisoned ? 1u : 0u));
+        h = asx_digest_word(h, r->parent);
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_TASKS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        const asx_snapshot_task *t = &snap->tasks[i];
+        if (t->id == ASX_INVALID_ID) continue;
+        h = asx_digest_word(h, t->id);
+        h = asx_digest_word(h, ((uint64_t)t->state << 32) |
+                               (uint32_t)t->outcome_status);
+        h = asx_digest_word(h, t->region);
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_OBLIGATIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+        const asx_snapshot_obligation *o = &snap->obligations[i];
+        if (o->id == ASX_INVALID_ID) continue;
+        h = asx_digest_word(h, o->id);
+        h = asx_digest_word(h, (uint64_t)o->state);
+        h = asx_digest_word(h, o->region);
+    }
+    return h;
+}
+
+/* ------------------------------------------------------------------ */
+/* Binary encode / decode                                              */
+/* ------------------------------------------------------------------ */
+
+enum {
+    SNAP_KIND_REGION     = 1,
+    SNAP_KIND_TASK       = 2,
+    SNAP_KIND_OBLIGATION = 3
+};
+
+static void snap_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void snap_put_u64(uint8_t *p, uint64_t v)
+{
+    snap_put_u32(p, (uint32_t)v);
+    snap_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint32_t snap_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t snap_get_u64(const uint8_t *p)
+{
+    return (uint64_t)snap_get_u32(p) | ((uint64_t)snap_get_u32(p + 4) << 32);
+}
+
+/* Fixed-layout record fields, shared by the three kinds */
+typedef struct {
+    uint8_t  kind;
+    uint8_t  state;
+    uint16_t slot;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+    uint64_t id;
+    uint64_t link;
+} snap_wire_record;
+
+static int snap_wire_eq(const snap_wire_record *x, const snap_wire_record *y)
+{
+    return x->state == y->state && x->a == y->a && x->b == y->b &&
+           x->c == y->c && x->id == y->id && x->link == y->link;
+}
+
+static void snap_wire_of(const asx_runtime_snapshot *snap, uint8_t kind,
+                         uint32_t slot, snap_wire_record *w)
+{
+    memset(w, 0, sizeof(*w));
+    w->kind = kind;
+    w->slot = (uint16_t)slot;
+    if (snap == NULL) return;
+    if (kind == SNAP_KIND_REGION) {
+        const asx_snapshot_region *r = &snap->regions[slot];
+        if (r->id == ASX_INVALID_ID) return;
+        w->state = (uint8_t)r->state;
+        w->a = r->task_count;
+        w->b = r->task_total;
+        w->c = r->poisoned ? 1u : 0u;
+        w->id = r->id;
+        w->link = r->parent;
+    } else if (kind == SNAP_KIND_TASK) {
+        const asx_snapshot_task *t = &snap->tasks[slot];
+        if (t->id == ASX_INVALID_ID) return;
+        w->state = (uint8_t)t->state;
+        w->a = (uint32_t)t->outcome_status;
+        w->id = t->id;
+        w->link = t->region;
+    } else {
+        const asx_snapshot_obligation *o = &snap->obligations[slot];
+        if (o->id == ASX_INVALID_ID) return;
+        w->state = (uint8_t)o->state;
+        w->id = o->id;
+        w->link = o->region;
+    }
+}
+
+static uint32_t snap_kind_slots(uint8_t kind)
+{
+    if (kind == SNAP_KIND_REGION) return ASX_SNAPSHOT_MAX_REGIONS;
+    if (kind == SNAP_KIND_TASK) return ASX_SNAPSHOT_MAX_TASKS;
+    return ASX_SNAPSHOT_MAX_OBLIGATIONS;
+}
+
+asx_status asx_runtime_snapshot_encode(const asx_runtime_snapshot *snap,
+                                       const asx_runtime_snapshot *base,
+                                       uint8_t *buf,
+                                       uint32_t capacity,
+                                       uint32_t *out_len)
+{
+    uint32_t pos = ASX_SNAPSHOT_BINARY_HEADER;
+    uint32_t count = 0;
+    uint8_t kind;
+    uint32_t i;
+
+    if (snap == NULL || buf == NULL || out_len == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (capacity < ASX_SNAPSHOT_BINARY_HEADER) return ASX_E_BUFFER_TOO_SMALL;
+
+    for (kind = SNAP_KIND_REGION; kind <= SNAP_KIND_OBLIGATION; kind++) {
+        ASX_CHECKPOINT_WAIVER("bounded by the three record kinds");
+        for (i = 0; i < snap_kind_slots(kind); i++) {
+            ASX_CHECKPOINT_WAIVER("bounded by the kind's snapshot slots");
+            snap_wire_record cur;
+            snap_wire_record old;
+            uint8_t *p;
+
+            snap_wire_of(snap, kind, i, &cur);
+            if (base != NULL) {
+                snap_wire_of(base, kind, i, &old);
+                if (cur.id == old.id && snap_wire_eq(&cur, &old)) continue;
+                if (cur.id == ASX_INVALID_ID) {
+                    cur.kind = (uint8_t)(kind | ASX_SNAPSHOT_RECORD_CLEARED);
+                }
+            } else if (cur.id == ASX_INVALID_ID) {
+                continue;
+            }
+            if (capacity - pos < ASX_SNAPSHOT_BINARY_RECORD) {
+                return ASX_E_BUFFER_TOO_SMALL;
+            }
+            p = buf + pos;
+            p[0] = cur.kind;
+            p[1] = cur.state;
+            p[2] = (uint8_t)cur.slot;
+            p[3] = (uint8_t)(cur.slot >> 8);
+            snap_put_u32(p + 4, cur.a);
+            snap_put_u32(p + 8, cur.b);
+            snap_put_u32(p + 12, cur.c);
+            snap_put_u64(p + 16, cur.id);
+            snap_put_u64(p + 24, cur.link);
+            pos += ASX_SNAPSHOT_BINARY_RECORD;
+            count++;
+        }
+    }
+
+    snap_put_u32(buf, ASX_SNAPSHOT_BINARY_MAGIC);
+    snap_put_u32(buf + 4, ASX_SNAPSHOT_BINARY_VERSION |
+                          (base != NULL ? ASX_SNAPSHOT_BINARY_FLAG_DELTA : 0u));
+    snap_put_u32(buf + 8, count);
+    snap_put_u32(buf + 12, 0);
+    snap_put_u64(buf + 16, snap->event_hash);
+    snap_put_u64(buf + 24, base != NULL ? asx_runtime_snapshot_digest(base) : 0u);
+    snap_put_u64(buf + 32, asx_runtime_snapshot_digest(snap));
+    *out_len = pos;
+    return ASX_OK;
+}
+
+/* Apply one wire record to snap, keeping the counts. 0 if malformed. */
+static int snap_apply_record(asx_runtime_snapshot *snap, const uint8_t *p)
+{
+    uint8_t kind = (uint8_t)(p[0] & ~ASX_SNAPSHOT_RECORD_CLEARED);
+    int cleared = (p[0] & ASX_SNAPSHOT_RECORD_CLEARED) != 0;
+    uint32_t slot = (uint32_t)p[2] | ((uint32_t)p[3] << 8);
+    uint8_t state = p[1];
+    uint64_t id = snap_get_u64(p + 16);
+
+    if (kind < SNAP_KIND_REGION || kind > SNAP_KIND_OBLIGATION) return 0;
+    if (slot >= snap_kind_slots(kind)) return 0;
+    if (cleared ? id != ASX_INVALID_ID : id == ASX_INVALID_ID) return 0;
+
+    if (kind == SNAP_KIND_REGION) {
+        asx_snapshot_region *r = &snap->regions[slot];
+        if (!cleared && state > (uint8_t)ASX_REGION_CLOSED) return 0;
+        if (r->id != ASX_INVALID_ID) snap->region_count--;
+        memset(r, 0, sizeof(*r));
+        if (cleared) return 1;
+        r->id         = id;
+        r->state      = (asx_region_state)state;
+        r->task_count = snap_get_u32(p + 4);
+        r->task_total = snap_get_u32(p + 8);
+        r->poisoned   = snap_get_u32(p + 12) != 0;
+        r->parent     = snap_get_u64(p + 24);
+        snap->region_count++;
+    } else if (kind == SNAP_KIND_TASK) {
+        asx_snapshot_task *t = &snap->tasks[slot];
+        if (!cleared && state > (uint8_t)ASX_TASK_COMPLETED) return 0;
+        if (t->id != ASX_INVALID_ID) snap->task_count--;
+        memset(t, 0, sizeof(*t));
+        if (cleared) return 1;
+        t->id             = id;
+        t->state          = (asx_task_state)state;
+        t->outcome_status = (asx_status)snap_get_u32(p + 4);
+        t->region         = snap_get_u64(p + 24);
+        snap->task_count++;
+    } else {
+        asx_snapshot_obligation *o = &snap->obligations[slot];
+        if (!cleared && state > (uint8_t)ASX_OBLIGATION_LEAKED) return 0;
+        if (o->id != ASX_INVALID_ID) snap->obligation_count--;
+        memset(o, 0, sizeof(*o));
+        if (cleared) return 1;
+        o->id     = id;
+        o->state  = (asx_obligation_state)state;
+        o->region = snap_get_u64(p + 24);
+        snap->obligation_count++;
+    }
+    return 1;
+}
+
+asx_status asx_runtime_snapshot_decode(asx_runtime_snapshot *snap,
+                                       const uint8_t *buf,
+                                       uint32_t len)
+{
+    asx_runtime_snapshot work;
+    uint32_t version;
+    uint32_t count;
+    uint32_t prev_key = 0;
+    uint32_t i;
+    int delta;
+
+    if (snap == NULL || buf == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (len < ASX_SNAPSHOT_BINARY_HEADER) return ASX_E_INVALID_ARGUMENT;
+    if (snap_get_u32(buf) != ASX_SNAPSHOT_BINARY_MAGIC) return ASX_E_INVALID_ARGUMENT;
+    version = snap_get_u32(buf + 4);
+    if ((version & ~ASX_SNAPSHOT_BINARY_FLAG_DELTA) != ASX_SNAPSHOT_BINARY_VERSION ||
+        snap_get_u32(buf + 12) != 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    count = snap_get_u32(buf + 8);
+    if (count > (len - ASX_SNAPSHOT_BINARY_HEADER) / ASX_SNAPSHOT_BINARY_RECORD ||
+        len != ASX_SNAPSHOT_BINARY_HEADER + count * ASX_SNAPSHOT_BINARY_RECORD) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    delta = (version & ASX_SNAPSHOT_BINARY_FLAG_DELTA) != 0;
+
+    if (delta) {
+        if (asx_runtime_snapshot_digest(snap) != snap_get_u64(buf + 24)) {
+            return ASX_E_REPLAY_MISMATCH;
+        }
+        work = *snap;
+    } else {
+        asx_runtime_snapshot_init(&work);
+    }
+
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by the buffer's record count");
+        const uint8_t *p = buf + ASX_SNAPSHOT_BINARY_HEADER +
+                           i * ASX_SNAPSHOT_BINARY_RECORD;
+        /* Strictly ascending (kind, slot): no slot appears twice */
+        uint32_t key = ((uint32_t)(p[0] & ~ASX_SNAPSHOT_RECORD_CLEARED) << 16) |
+                       (uint32_t)p[2] | ((uint32_t)p[3] << 8);
+        if (key <= prev_key) return ASX_E_INVALID_ARGUMENT;
+        prev_key = key;
+        if (!delta && (p[0] & ASX_SNAPSHOT_RECORD_CLEARED) != 0) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        if (!snap_apply_record(&work, p)) return ASX_E_INVALID_ARGUMENT;
+    }
+    work.event_hash = snap_get_u64(buf + 16);
+    work.capture_mark = 0;
+    if (asx_runtime_snapshot_digest(&work) != snap_get_u64(buf + 32)) {
+        return ASX_E_REPLAY_MISMATCH;
+    }
+    *snap = work;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Restore                                                             */
+/* ------------------------------------------------------------------ */
+
+/* 1 if ref names the region recorded in snap's slot for it. */
+static int snap_region_ref_ok(const asx_runtime_snapshot *snap, uint64_t ref)
+{
+    uint32_t slot;
+
+    if (asx_handle_type_tag(ref) != ASX_TYPE_REGION) return 0;
+    slot = asx_handle_slot(ref);
+    if (slot >= ASX_SNAPSHOT_MAX_REGIONS) return 0;
+    if (snap->regions[slot].id == ASX_INVALID_ID) return 0;
+    return asx_handle_index(snap->regions[slot].id) == asx_handle_index(ref);
+}
+
+/* Count record i of a kind into *n. 0 unless the records in use are
+ * dense from slot 0 with handles of the kind's type naming their own
+ * slot; slots stay live until reset, so a captured arena has no holes. */
+static int snap_dense_step(uint64_t id, uint32_t i, uint16_t type, uint32_t *n)
+{
+    if (id == ASX_INVALID_ID) return 1;
+    if (*n != i || asx_handle_type_tag(id) != type || asx_handle_slot(id) != i) {
+        return 0;
+    }
+    (*n)++;
+    return 1;
+}
+
+static asx_status snapshot_restore_check(const asx_runtime_snapshot *snap,
+                                         uint32_t *out_regions,
+                                         uint32_t *out_tasks,
+                                         uint32_t *out_obligations)
+{
+    uint32_t live[ASX_SNAPSHOT_MAX_REGIONS];
+    uint32_t nr = 0, nt = 0, no = 0;
+    uint32_t i;
+
+    for (i = 0; i < ASX_SNAPSHOT_MAX_REGIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        if (!snap_dense_step(snap->regions[i].id, i, ASX_TYPE_REGION, &nr)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_TASKS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        if (!snap_dense_step(snap->tasks[i].id, i, ASX_TYPE_TASK, &nt)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_OBLIGATIONS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+        if (!snap_dense_step(snap->obligations[i].id, i, ASX_TYPE_OBLIGATION, &no)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+    if (nr != snap->region_count || nt != snap->task_count ||
+        no != snap->obligation_count) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    memset(live, 0, sizeof(live));
+    for (i = 0; i < nr; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        const asx_snapshot_region *r = &snap->regions[i];
+        if (r->parent != ASX_INVALID_ID &&
+            (!snap_region_ref_ok(snap, r->parent) ||
+             asx_handle_slot(r->parent) == i ||
+             r->state == ASX_REGION_CLOSED)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+    for (i = 0; i < nt; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        const asx_snapshot_task *t = &snap->tasks[i];
+        if (!snap_region_ref_ok(snap, t->region)) return ASX_E_INVALID_ARGUMENT;
+        if (t->state != ASX_TASK_COMPLETED) live[asx_handle_slot(t->region)]++;
+    }
+    for (i = 0; i < nr; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        if (snap->regions[i].task_count != live[i]) return ASX_E_INVALID_ARGUMENT;
+    }
+    for (i = 0; i < no; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+        if (!snap_region_ref_ok(snap, snap->obligations[i].region)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+    *out_regions = nr;
+    *out_tasks = nt;
+    *out_obligations = no;
+    return ASX_OK;
+}
+
+static asx_cancel_phase snapshot_cancel_phase(asx_task_state state)
+{
+    switch (state) {
+    case ASX_TASK_CANCELLING: return ASX_CANCEL_PHASE_CANCELLING;
+    case ASX_TASK_FINALIZING: return ASX_CANCEL_PHASE_FINALIZING;
+    case ASX_TASK_COMPLETED:  return ASX_CANCEL_PHASE_COMPLETED;
+    case ASX_TASK_CREATED:
+    case ASX_TASK_RUNNING:
+    case ASX_TASK_CANCEL_REQUESTED:
+        break;
+    }
+    return ASX_CANCEL_PHASE_REQUESTED;
+}
+
+static asx_outcome_severity snapshot_outcome_severity(asx_status st)
+{
+    if (st == ASX_OK) return ASX_OUTCOME_OK;
+    if (st == ASX_E_CANCELLED) return ASX_OUTCOME_CANCELLED;
+    return ASX_OUTCOME_ERR;
+}
+
+/* Append task idx to a region task list (live or done). */
+static void snapshot_list_append(uint32_t *head, uint32_t *tail, uint32_t idx)
+{
+    asx_task_cold *cold = asx_task_cold_at(idx);
+
+    cold->region_prev = *tail;
+    cold->region_next = ASX_TASK_LINK_NONE;
+    if (*tail != ASX_TASK_LINK_NONE) {
+        asx_task_cold_at(*tail)->region_next = idx;
+    } else {
+        *head = idx;
+    }
+    *tail = idx;
+}
+
+asx_status asx_runtime_snapshot_restore(const asx_runtime_snapshot *snap,
+                                        asx_snapshot_rebind_fn rebind,
+                                        void *ctx)
+{
+    asx_task_poll_fn polls[ASX_SNAPSHOT_MAX_TASKS];
+    void *user_data[ASX_SNAPSHOT_MAX_TASKS];
+    uint32_t nr, nt, no;
+    uint32_t i;
+    asx_status st;
+
+    if (snap == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = snapshot_restore_check(snap, &nr, &nt, &no);
+    if (st != ASX_OK) return st;
+
+    /* Every poll function up front, so a failed rebind changes nothing */
+    for (i = 0; i < nt; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        polls[i] = NULL;
+        user_data[i] = NULL;
+        if (snap->tasks[i].state == ASX_TASK_COMPLETED) continue;
+        if (rebind == NULL) return ASX_E_INVALID_ARGUMENT;
+        st = rebind(ctx, &snap->tasks[i], &polls[i], &user_data[i]);
+        if (st != ASX_OK) return st;
+        if (polls[i] == NULL) return ASX_E_INVALID_ARGUMENT;
+    }
+
+    asx_runtime_reset();
+
+    for (i = 0; i < nr; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_REGIONS");
+        const asx_snapshot_region *rec = &snap->regions[i];
+        asx_region_slot *r = asx_region_at(i);
+
+        r->state      = rec->state;
+        r->task_total = rec->task_total;
+        r->key        = asx_slot_key(ASX_TYPE_REGION, asx_handle_generation(rec->id));
+        r->poisoned   = rec->poisoned ? 1 : 0;
+        if (rec->parent != ASX_INVALID_ID) {
+            uint32_t pidx = asx_handle_slot(rec->parent);
+            asx_region_slot *p = asx_region_at(pidx);
+
+            r->parent = pidx;
+            r->prev_sibling = p->last_child;
+            if (p->last_child != ASX_REGION_LINK_NONE) {
+                asx_region_at(p->last_child)->next_sibling = i;
+            } else {
+                p->first_child = i;
+            }
+            p->last_child = i;
+        }
+#ifndef ASX_DEBUG_QUARANTINE
+        if (rec->state == ASX_REGION_CLOSED) {
+            r->free_next = g_region_free_head;
+            g_region_free_head = i;
+        }
+#endif
+    }
+    g_region_count = nr;
+
+    for (i = 0; i < nt; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_TASKS");
+        const asx_snapshot_task *rec = &snap->tasks[i];
+        uint32_t ridx = asx_handle_slot(rec->region);
+        asx_region_slot *r = asx_region_at(ridx);
+        asx_task_slot *t = asx_task_at(i);
+        asx_task_cold *cold = asx_task_cold_at(i);
+
+        t->state      = rec->state;
+        t->region     = rec->region;
+        t->key        = asx_slot_key(ASX_TYPE_TASK, asx_handle_generation(rec->id));
+        cold->cancel_phase = snapshot_cancel_phase(rec->state);
+
+        if (rec->state == ASX_TASK_COMPLETED) {
+            asx_task_cold_set_outcome(cold,
+                snapshot_outcome_severity(rec->outcome_status));
+#ifndef ASX_DEBUG_QUARANTINE
+            if (r->state == ASX_REGION_CLOSED) {
+                /* Reclaimed when the region closed */
+                cold->region_next = g_task_free_head;
+                cold->reclaimed = 1;
+                g_task_free_head = i;
+                g_task_free_count++;
+                continue;
+            }
+#endif
+            snapshot_list_append(&r->done_head, &r->done_tail, i);
+            continue;
+        }
+
+        t->poll_fn   = polls[i];
+        t->user_data = user_data[i];
+        snapshot_list_append(&r->task_head, &r->task_tail, i);
+        asx_region_ready_insert(r, i);
+        r->task_count++;
+        if (rec->state >= ASX_TASK_CANCEL_REQUESTED) {
+            asx_budget cleanup = asx_cancel_cleanup_budget(ASX_CANCEL_USER);
+
+            t->cancel_pending = 1;
+            t->cleanup_polls_remaining = asx_budget_polls(&cleanup);
+            cold->cancel_kind = (uint8_t)ASX_CANCEL_USER;
+            cold->cancel_epoch = 1;
+        } else {
+            r->tasks_uncancelled++;
+        }
+    }
+    g_task_count = nt;
+
+    for (i = 0; i < no; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SNAPSHOT_MAX_OBLIGATIONS");
+        const asx_snapshot_obligation *rec = &snap->obligations[i];
+        asx_obligation_slot *o = asx_obligation_at(i);
+
+        o->state      = rec->state;
+        o->region     = rec->region;
+        o->key        = asx_slot_key(ASX_TYPE_OBLIGATION, asx_handle_generation(rec->id));
+        if (rec->state == ASX_OBLIGATION_RESERVED) {
+            asx_region_slot *r = asx_region_at(asx_handle_slot(rec->region));
+
+            r->obligations_reserved++;
+            asx_region_obligation_append(r, i);
+            if (asx_ghost_region_sampled(rec->region)) {
+                asx_ghost_obligation_reserved(rec->id);
+            }
+        } else {
+#ifndef ASX_DEBUG_QUARANTINE
+            o->link = g_obligation_free_head;
+            g_obligation_free_head = i;
+            g_obligation_free_count++;
+#endif
+        }
+    }
+    g_obligation_count = no;
+    return ASX_OK;
+}
@@ -0,0 +1,274 @@
+/*
+ * task_group.c — completion counters over a region's tasks
+ *
+ * A fixed pool of ASX_MAX_TASK_GROUPS groups with a LIFO free list
+ * behind a never-used cursor. A member's cold slot names its group
+ * (index + 1, so a zeroed slot is in none), and every completion site
+ * reaches asx_task_group_completed through asx_region_task_completed,
+ * which bumps the done count and joins the outcome in O(1).
+ *
+ * A waiter parks on the group's token with the done count it needs
+ * (wake_at). The completion that reaches the smallest requested count
+ * wakes the group's waiters and clears wake_at, so each park is woken
+ * once; a waiter that wanted more re-checks and parks again.
+ *
+ * Members come from the group's region only, so by the time the region
+ * closes every member has completed and its groups can be freed
+ * without visiting any task.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include "runtime_internal.h"
+#include "context_internal.h"
+
+/* asx_task_cold.group holds index + 1 in a uint8_t */
+#if ASX_MAX_TASK_GROUPS > 255u
+#error "ASX_MAX_TASK_GROUPS must fit asx_task_cold.group"
+#endif
+
+typedef struct {
+    asx_region_id  region;
+    uint32_t       members;
+    uint32_t       done;
+    uint32_t       wake_at;      /* smallest done count awaited, 0 = none */
+    uint32_t       next;         /* region list, or free list once freed */
+    uint16_t       generation;
+    uint8_t        live;
+    uint8_t        joined;       /* asx_outcome_severity of done members */
+} asx_group_slot;
+
+static asx_group_slot g_groups[ASX_MAX_TASK_GROUPS];
+static uint32_t       g_group_count;     /* never-used cursor */
+static uint32_t       g_group_free_head = ASX_GROUP_LINK_NONE;
+
+static const uint32_t g_group_link_none = ASX_GROUP_LINK_NONE;
+static const asx_context_block g_group_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_groups),
+    ASX_CONTEXT_BLOCK(g_group_count),
+    ASX_CONTEXT_BLOCK_INIT(g_group_free_head, g_group_link_none)
+};
+
+const asx_context_module asx_group_context = ASX_CONTEXT_MODULE(g_group_blocks);
+
+/* ------------------------------------------------------------------ */
+/* Internal helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+static uint32_t group_token(uint32_t idx)
+{
+    return ((uint32_t)g_groups[idx].generation << 16) | idx;
+}
+
+/* The live group named by group, or NULL */
+static asx_group_slot *group_lookup(const asx_task_group *group)
+{
+    uint32_t idx;
+
+    if (group == NULL) return NULL;
+    idx = group->token & 0xFFFFu;
+    if (idx >= g_group_count || !g_groups[idx].live) return NULL;
+    if (group->token != group_token(idx)) return NULL;
+    return &g_groups[idx];
+}
+
+static void group_release(asx_group_slot *g)
+{
+    g->live = 0;
+    g->generation = (uint16_t)(g->generation + 1u);
+    g->next = g_group_free_head;
+    g_group_free_head = (uint32_t)(g - g_groups);
+}
+
+static uint32_t group_target(const asx_group_slot *g, uint32_t count)
+{
+    return count == 0u ? g->members : count;
+}
+
+/* ------------------------------------------------------------------ */
+/* Task group API                                                     */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_task_group_create(asx_region_id region, asx_task_group *out)
+{
+    asx_region_slot *r;
+    asx_group_slot *g;
+    uint32_t idx;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->token = 0;
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+    if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
+
+    if (g_group_free_head != ASX_GROUP_LINK_NONE) {
+        idx = g_group_free_head;
+        g_group_free_head = g_groups[idx].next;
+    } else if (g_group_count < ASX_MAX_TASK_GROUPS) {
+        idx = g_group_count++;
+    } else {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    g = &g_groups[idx];
+    g->region = region;
+    g->members = 0;
+    g->done = 0;
+    g->wake_at = 0;
+    g->live = 1;
+    g->joined = (uint8_t)ASX_OUTCOME_OK;
+    g->next = r->group_head;
+    r->group_head = idx;
+
+    out->token = group_token(idx);
+    return ASX_OK;
+}
+
+asx_status asx_task_group_add(const asx_task_group *group, asx_task_id task)
+{
+    asx_group_slot *g;
+    asx_task_slot *t;
+    asx_status st;
+
+    if (group == NULL) return ASX_E_INVALID_ARGUMENT;
+    g = group_lookup(group);
+    if (g == NULL) return ASX_E_INVALID_STATE;
+    st = asx_task_slot_lookup(task, &t);
+    if (st != ASX_OK) return st;
+    if (t->region != g->region) return ASX_E_INVALID_ARGUMENT;
+    if (t->cold->group != 0u) return ASX_E_INVALID_STATE;
+
+    g->members++;
+    if (t->state == ASX_TASK_COMPLETED) {
+        /* Done already: count it now, it will not complete again */
+        asx_task_group_completed(group->token & 0xFFFFu,
+                                 (asx_outcome_severity)t->cold->outcome);
+    } else {
+        t->cold->group = (uint8_t)((group->token & 0xFFFFu) + 1u);
+    }
+    return ASX_OK;
+}
+
+asx_status asx_task_group_try_join(const asx_task_group *group, uint32_t count,
+                                   asx_outcome *out_outcome)
+{
+    asx_group_slot *g;
+
+    if (group == NULL || out_outcome == NULL) return ASX_E_INVALID_ARGUMENT;
+    g = group_lookup(group);
+    if (g == NULL) return ASX_E_INVALID_STATE;
+    if (count > g->members) return ASX_E_INVALID_ARGUMENT;
+    if (g->done < group_target(g, count)) return ASX_E_WOULD_BLOCK;
+    *out_outcome = asx_outcome_make((asx_outcome_severity)g->joined);
+    return ASX_OK;
+}
+
+asx_status asx_task_group_progress(const asx_task_group *group,
+                                   uint32_t *out_done, uint32_t *out_members)
+{
+    asx_group_slot *g;
+
+    if (group == NULL || out_done == NULL || out_members == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    g = group_lookup(group);
+    if (g == NULL) return ASX_E_INVALID_STATE;
+    *out_done = g->done;
+    *out_members = g->members;
+    return ASX_OK;
+}
+
+asx_status asx_task_group_destroy(const asx_task_group *group)
+{
+    asx_group_slot *g;
+    asx_region_slot *r;
+    uint32_t idx;
+    uint32_t *link;
+
+    if (group == NULL) return ASX_E_INVALID_ARGUMENT;
+    g = group_lookup(group);
+    if (g == NULL) return ASX_E_INVALID_STATE;
+    if (g->done < g->members) return ASX_E_TASK_NOT_COMPLETED;
+
+    /* The region is open: closing it would have freed the group */
+    idx = group->token & 0xFFFFu;
+    if (asx_region_slot_lookup(g->region, &r) == ASX_OK) {
+        for (link = &r->group_head; *link != ASX_GROUP_LINK_NONE;
+             link = &g_groups[*link].next) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TASK_GROUPS");
+            if (*link == idx) {
+                *link = g->next;
+                break;
+            }
+        }
+    }
+    group_release(g);
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Runtime integration                                                */
+/* ------------------------------------------------------------------ */
+
+void asx_task_group_completed(uint32_t group, asx_outcome_severity severity)
+{
+    asx_group_slot *g = &g_groups[group];
+    asx_outcome joined = asx_outcome_make((asx_outcome_severity)g->joined);
+    asx_outcome member = asx_outcome_make(severity);
+
+    joined = asx_outcome_join(&joined, &member);
+    g->joined = (uint8_t)joined.severity;
+    g->done++;
+    if (g->wake_at != 0u && g->done >= g->wake_at) {
+        g->wake_at = 0;
+        (void)asx_wake_source(ASX_PARK_GROUP, (uint64_t)group_token(group));
+    }
+}
+
+asx_status asx_task_group_wait(const asx_task_group *group, uint32_t count,
+                               uint64_t *out_key)
+{
+    asx_group_slot *g;
+    uint32_t target;
+
+    if (group == NULL) return ASX_E_INVALID_ARGUMENT;
+    g = group_lookup(group);
+    if (g == NULL) return ASX_E_INVALID_STATE;
+    if (count > g->members) return ASX_E_INVALID_ARGUMENT;
+    target = group_target(g, count);
+    if (target > g->done && (g->wake_at == 0u || target < g->wake_at)) {
+        g->wake_at = target;
+    }
+    *out_key = (uint64_t)group->token;
+    return ASX_OK;
+}
+
+void asx_task_group_region_reclaim(uint32_t *head)
+{
+    uint32_t idx = *head;
+
+    while (idx != ASX_GROUP_LINK_NONE) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TASK_GROUPS") */
+        uint32_t next = g_groups[idx].next;
+
+        group_release(&g_groups[idx]);
+        idx = next;
+    }
+    *head = ASX_GROUP_LINK_NONE;
+}
+
+void asx_task_group_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_group_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TASK_GROUPS");
+        /* Keep generations so handles from before the reset stay stale */
+        g_groups[i].live = 0;
+        g_groups[i].generation = (uint16_t)(g_groups[i].generation + 1u);
+        g_groups[i].next = (i + 1u < g_group_count) ? i + 1u : ASX_GROUP_LINK_NONE;
+    }
+    g_group_free_head = g_group_count != 0u ? 0u : ASX_GROUP_LINK_NONE;
+}
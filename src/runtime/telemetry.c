@@ -5,40 +5,36 @@
  * with a tier-independent rolling digest that ensures canonical semantic
  * identity is preserved regardless of observability level.
  *
- * ASX_CHECKPOINT_WAIVER_FILE("telemetry: loops bounded by sizeof() for FNV-1a "
- *   "mixing. Emit/digest functions are observability-only, not on task poll path.")
+ * Each tier's retention policy is a 64-bit event-kind mask, latched when
+ * the tier is set, so the per-emit filter is a single AND.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("telemetry: no unbounded loops. Emit/digest "
+ *   "functions are observability-only, not on task poll path.")
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/runtime/telemetry.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/digest.h>
+#include <string.h>
+#include "context_internal.h"
 
 /* -------------------------------------------------------------------
  * State
  * ------------------------------------------------------------------- */
 
-static asx_telemetry_tier g_tier = ASX_TELEMETRY_FORENSIC;
+#if !ASX_STATIC_PROFILE
+static asx_telemetry_tier g_tier = (asx_telemetry_tier)ASX_TELEMETRY_MIN_TIER;
+#endif
 static uint64_t g_rolling_digest = 0x517cc1b727220a95ULL;
 static uint32_t g_emitted_count;
 static uint32_t g_filtered_count;
 static uint32_t g_rolling_sequence;
-
-/* -------------------------------------------------------------------
- * FNV-1a helpers (local copy to avoid cross-TU dependency)
- * ------------------------------------------------------------------- */
-
-static uint64_t telem_fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
-{
-    const uint8_t *p = (const uint8_t *)data;
-    uint32_t i;
-
-    for (i = 0; i < len; i++) {
-        hash ^= (uint64_t)p[i];
-        hash *= 0x00000100000001B3ULL;
-    }
-    return hash;
-}
+static asx_digest_mode g_digest_mode;  /* latched at digest reset */
+static uint64_t g_parity_cps[ASX_TELEMETRY_PARITY_CHECKPOINTS];
+static uint32_t g_parity_cp_count;
+static uint32_t g_parity_window = ASX_TELEMETRY_PARITY_WINDOW;
 
 /* -------------------------------------------------------------------
  * Tier retention policy
@@ -46,48 +42,92 @@ static uint64_t telem_fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
  * FORENSIC:  all events retained
  * OPS_LIGHT: lifecycle and scheduler completion events only
  * ULTRA_MIN: no events retained (digest-only)
+ *
+ * Each policy is a 64-bit mask over event kinds. Kinds are grouped by
+ * high nibble with at most 8 per group, so (group << 3) | index packs
+ * groups 0..6 into bits 0..55; any other kind shares bit 63, which only
+ * the retain-all mask sets.
  * ------------------------------------------------------------------- */
 
-int asx_telemetry_retains(asx_telemetry_tier tier,
-                           asx_trace_event_kind kind)
+#define TELEM_KIND_BIT(k) \
+    (1ULL << ((((uint32_t)(k) >> 4) << 3) | ((uint32_t)(k) & 0x07u)))
+#define TELEM_OTHER_BIT   (1ULL << 63)
+
+#define TELEM_MASK_FORENSIC  (~0ULL)
+#define TELEM_MASK_OPS_LIGHT                      \
+    (TELEM_KIND_BIT(ASX_TRACE_REGION_OPEN)      | \
+     TELEM_KIND_BIT(ASX_TRACE_REGION_CLOSE)     | \
+     TELEM_KIND_BIT(ASX_TRACE_REGION_CLOSED)    | \
+     TELEM_KIND_BIT(ASX_TRACE_TASK_SPAWN)       | \
+     TELEM_KIND_BIT(ASX_TRACE_TASK_TRANSITION)  | \
+     TELEM_KIND_BIT(ASX_TRACE_SCHED_COMPLETE)   | \
+     TELEM_KIND_BIT(ASX_TRACE_SCHED_QUIESCENT)  | \
+     TELEM_KIND_BIT(ASX_TRACE_SCHED_BUDGET))
+#define TELEM_MASK_ULTRA_MIN 0ULL
+
+#if ASX_TELEMETRY_MIN_TIER >= 2
+#define TELEM_MASK_MIN_TIER TELEM_MASK_ULTRA_MIN
+#elif ASX_TELEMETRY_MIN_TIER == 1
+#define TELEM_MASK_MIN_TIER TELEM_MASK_OPS_LIGHT
+#else
+#define TELEM_MASK_MIN_TIER TELEM_MASK_FORENSIC
+#endif
+
+/* Retention mask of g_tier, latched by asx_telemetry_set_tier();
+ * fixed under ASX_STATIC_PROFILE */
+#if ASX_STATIC_PROFILE
+#define g_retain_mask TELEM_MASK_MIN_TIER
+#else
+static uint64_t g_retain_mask = TELEM_MASK_MIN_TIER;
+#endif
+
+#if !ASX_STATIC_PROFILE
+static const asx_telemetry_tier g_tier_init = (asx_telemetry_tier)ASX_TELEMETRY_MIN_TIER;
+static const uint64_t g_retain_mask_init = TELEM_MASK_MIN_TIER;
+#endif
+static const uint64_t g_rolling_digest_init = 0x517cc1b727220a95ULL;
+static const uint32_t g_parity_window_init = ASX_TELEMETRY_PARITY_WINDOW;
+static const asx_context_block g_telemetry_blocks[] = {
+#if !ASX_STATIC_PROFILE
+    ASX_CONTEXT_BLOCK_INIT(g_tier, g_tier_init),
+    ASX_CONTEXT_BLOCK_INIT(g_retain_mask, g_retain_mask_init),
+#endif
+    ASX_CONTEXT_BLOCK_INIT(g_rolling_digest, g_rolling_digest_init),
+    ASX_CONTEXT_BLOCK(g_emitted_count),
+    ASX_CONTEXT_BLOCK(g_filtered_count),
+    ASX_CONTEXT_BLOCK(g_rolling_sequence),
+    ASX_CONTEXT_BLOCK(g_digest_mode),
+    ASX_CONTEXT_BLOCK(g_parity_cps),
+    ASX_CONTEXT_BLOCK(g_parity_cp_count),
+    ASX_CONTEXT_BLOCK_INIT(g_parity_window, g_parity_window_init)
+};
+
+const asx_context_module asx_telemetry_context = ASX_CONTEXT_MODULE(g_telemetry_blocks);
+
+static uint64_t telem_kind_bit(asx_trace_event_kind kind)
 {
-    if (tier == ASX_TELEMETRY_FORENSIC) {
-        return 1;
-    }
+    uint32_t k = (uint32_t)kind;
 
-    if (tier == ASX_TELEMETRY_ULTRA_MIN) {
-        return 0;
-    }
+    if (k >= 0x70u || (k & 0x08u) != 0) return TELEM_OTHER_BIT;
+    return TELEM_KIND_BIT(k);
+}
 
-    /* OPS_LIGHT: retain lifecycle and scheduler terminal events */
-    switch (kind) {
-    case ASX_TRACE_REGION_OPEN:
-    case ASX_TRACE_REGION_CLOSE:
-    case ASX_TRACE_REGION_CLOSED:
-    case ASX_TRACE_TASK_SPAWN:
-    case ASX_TRACE_TASK_TRANSITION:
-    case ASX_TRACE_SCHED_COMPLETE:
-    case ASX_TRACE_SCHED_QUIESCENT:
-    case ASX_TRACE_SCHED_BUDGET:
-        return 1;
-
-    case ASX_TRACE_SCHED_POLL:
-    case ASX_TRACE_SCHED_ROUND:
-    case ASX_TRACE_OBLIGATION_RESERVE:
-    case ASX_TRACE_OBLIGATION_COMMIT:
-    case ASX_TRACE_OBLIGATION_ABORT:
-    case ASX_TRACE_CHANNEL_SEND:
-    case ASX_TRACE_CHANNEL_RECV:
-    case ASX_TRACE_TIMER_SET:
-    case ASX_TRACE_TIMER_FIRE:
-    case ASX_TRACE_TIMER_CANCEL:
-        return 0;
-
-    default:
-        return 0;
+static uint64_t telem_tier_mask(asx_telemetry_tier tier)
+{
+    switch (tier) {
+    case ASX_TELEMETRY_FORENSIC:  return TELEM_MASK_FORENSIC;
+    case ASX_TELEMETRY_OPS_LIGHT: return TELEM_MASK_OPS_LIGHT;
+    case ASX_TELEMETRY_ULTRA_MIN: return TELEM_MASK_ULTRA_MIN;
+    default:                      return TELEM_MASK_ULTRA_MIN;
     }
 }
 
+int asx_telemetry_retains(asx_telemetry_tier tier,
+                           asx_trace_event_kind kind)
+{
+    return (telem_tier_mask(tier) & telem_kind_bit(kind)) != 0;
+}
+
 /* -------------------------------------------------------------------
  * Tier configuration
  * ------------------------------------------------------------------- */
@@ -99,13 +139,25 @@ asx_status asx_telemetry_set_tier(asx_telemetry_tier tier)
         tier != ASX_TELEMETRY_ULTRA_MIN) {
         return ASX_E_INVALID_ARGUMENT;
     }
+    if ((int)tier < ASX_TELEMETRY_MIN_TIER) {
+        tier = (asx_telemetry_tier)ASX_TELEMETRY_MIN_TIER;
+    }
+#if ASX_STATIC_PROFILE
+    return (int)tier == ASX_TELEMETRY_MIN_TIER ? ASX_OK : ASX_E_INVALID_STATE;
+#else
     g_tier = tier;
+    g_retain_mask = telem_tier_mask(tier);
     return ASX_OK;
+#endif
 }
 
 asx_telemetry_tier asx_telemetry_get_tier(void)
 {
+#if ASX_STATIC_PROFILE
+    return (asx_telemetry_tier)ASX_TELEMETRY_MIN_TIER;
+#else
     return g_tier;
+#endif
 }
 
 const char *asx_telemetry_tier_str(asx_telemetry_tier tier)
@@ -118,6 +170,47 @@ const char *asx_telemetry_tier_str(asx_telemetry_tier tier)
     }
 }
 
+/* -------------------------------------------------------------------
+ * Parity checkpoints
+ * ------------------------------------------------------------------- */
+
+/* Called when g_rolling_sequence reaches a multiple of the window */
+static void telem_parity_checkpoint(void)
+{
+    uint32_t k;
+
+    if (g_parity_cp_count == ASX_TELEMETRY_PARITY_CHECKPOINTS) {
+        /* Keep the checkpoints that fall on the doubled window */
+        for (k = 0; k < ASX_TELEMETRY_PARITY_CHECKPOINTS / 2u; k++) {
+            g_parity_cps[k] = g_parity_cps[2u * k + 1u];
+        }
+        g_parity_cp_count = ASX_TELEMETRY_PARITY_CHECKPOINTS / 2u;
+        g_parity_window *= 2u;
+        if ((g_rolling_sequence & (g_parity_window - 1u)) != 0) return;
+    }
+    g_parity_cps[g_parity_cp_count++] = g_rolling_digest;
+}
+
+static void telem_parity_reset(void)
+{
+    g_parity_cp_count = 0;
+    g_parity_window = ASX_TELEMETRY_PARITY_WINDOW;
+}
+
+uint32_t asx_telemetry_parity_window(void)
+{
+    return g_parity_window;
+}
+
+uint32_t asx_telemetry_parity_checkpoints(uint64_t *out, uint32_t capacity)
+{
+    uint32_t n = g_parity_cp_count < capacity ? g_parity_cp_count : capacity;
+
+    if (out == NULL) return 0;
+    memcpy(out, g_parity_cps, (size_t)n * sizeof(out[0]));
+    return n;
+}
+
 /* -------------------------------------------------------------------
  * Tier-aware emission
  * ------------------------------------------------------------------- */
@@ -126,26 +219,42 @@ void asx_telemetry_emit(asx_trace_event_kind kind,
                          uint64_t entity_id,
                          uint64_t aux)
 {
+    uint8_t rec[24];
     uint32_t k;
 
-    /* Always update rolling digest (tier-independent) */
+    /* Always update rolling digest (tier-independent). For FNV-1a the
+     * fields are packed into one record so the mix is a single pass
+     * (same bytes, same digest as mixing each field in turn). */
     k = (uint32_t)kind;
-    g_rolling_digest = telem_fnv1a_mix(g_rolling_digest,
-                                        &g_rolling_sequence,
-                                        sizeof(g_rolling_sequence));
-    g_rolling_digest = telem_fnv1a_mix(g_rolling_digest, &k, sizeof(k));
-    g_rolling_digest = telem_fnv1a_mix(g_rolling_digest,
-                                        &entity_id, sizeof(entity_id));
-    g_rolling_digest = telem_fnv1a_mix(g_rolling_digest, &aux, sizeof(aux));
+    if (g_digest_mode == ASX_DIGEST_WORD64) {
+        g_rolling_digest = asx_digest_word(g_rolling_digest,
+            (uint64_t)g_rolling_sequence | ((uint64_t)k << 32));
+        g_rolling_digest = asx_digest_word(g_rolling_digest, entity_id);
+        g_rolling_digest = asx_digest_word(g_rolling_digest, aux);
+    } else {
+        memcpy(rec, &g_rolling_sequence, 4);
+        memcpy(rec + 4, &k, 4);
+        memcpy(rec + 8, &entity_id, 8);
+        memcpy(rec + 16, &aux, 8);
+        g_rolling_digest = asx_digest_fnv1a(g_rolling_digest, rec, sizeof(rec));
+    }
     g_rolling_sequence++;
     g_emitted_count++;
+    if ((g_rolling_sequence & (g_parity_window - 1u)) == 0) {
+        telem_parity_checkpoint();
+    }
 
+#if ASX_TELEMETRY_MIN_TIER >= 2
+    /* Digest-only build: nothing ever reaches the trace ring */
+    g_filtered_count++;
+#else
     /* Record in trace ring only if tier retains this event kind */
-    if (asx_telemetry_retains(g_tier, kind)) {
+    if ((g_retain_mask & telem_kind_bit(kind)) != 0) {
         asx_trace_emit(kind, entity_id, aux);
     } else {
         g_filtered_count++;
     }
+#endif
 }
 
 /* -------------------------------------------------------------------
@@ -161,6 +270,8 @@ void asx_telemetry_digest_reset(void)
 {
     g_rolling_digest = 0x517cc1b727220a95ULL;
     g_rolling_sequence = 0;
+    g_digest_mode = asx_digest_get_mode(ASX_DIGEST_DOMAIN_TELEMETRY);
+    telem_parity_reset();
 }
 
 /* -------------------------------------------------------------------
@@ -183,9 +294,11 @@ uint32_t asx_telemetry_filtered_count(void)
 
 void asx_telemetry_reset(void)
 {
-    g_tier = ASX_TELEMETRY_FORENSIC;
+    (void)asx_telemetry_set_tier(ASX_TELEMETRY_FORENSIC);
     g_rolling_digest = 0x517cc1b727220a95ULL;
     g_emitted_count = 0;
     g_filtered_count = 0;
     g_rolling_sequence = 0;
+    g_digest_mode = asx_digest_get_mode(ASX_DIGEST_DOMAIN_TELEMETRY);
+    telem_parity_reset();
 }
@@ -10,34 +10,240 @@
  *   "conversion limits. Snapshot/export functions are observability-only, "
  *   "never called from the task poll hot path.")
  *
+ * The digest over the stored events is kept as a running hash that is
+ * brought up to date on query: each event is hashed once per run, so
+ * a query after every step costs O(new events) rather than a rescan,
+ * and emit itself stays a plain store.
+ *
+ * With a sink installed the ring is a staging buffer: when it fills,
+ * its events are handed to the sink as one ASX_TRACE_BINARY chunk and
+ * the ring is reused. Sequence numbers and the digest run on across
+ * chunks, so each chunk's header digest chains from the one before.
+ *
+ * With timestamps on, each stored event also gets the asx_runtime_now_ns
+ * delta since the previous event in a side array. The digest never
+ * sees it, and exports carry it as a trailing column.
+ *
+ * Kinds disabled in the filter are dropped at the top of emit. They
+ * keep their sequence numbers and are folded into the running digest
+ * as they go, so the digest covers them; exports instead carry a
+ * digest of just the stored events, chained across chunks.
+ *
+ * With history storage attached, each emitted event is also appended
+ * to it as a compact delta/varint record, in segments that are dropped
+ * oldest first, so a small RAM budget keeps a long post-mortem tail.
+ *
+ * A mapped replay reference is never copied: its v1 records are read
+ * in place as each live event is emitted, so it may be any length.
+ *
+ * In round mode the sequential scheduler hands each poll to
+ * asx_trace_round_poll rather than asx_trace_emit. The poll goes into
+ * the current round's record (a bit in the window bitmap plus its
+ * generation, state and ring position) and the ring keeps only the
+ * other events. The first reader to call trace_stored rebuilds the
+ * canonical ring from the records in one backward pass, so everything
+ * layered on the ring is unaware of round mode.
+ *
+ * During a threaded parallel batch each worker thread stages the events
+ * its polls emit in a private buffer (one writer, no atomics). The
+ * calling thread merges every poll's run into the ring right after
+ * that poll's SCHED_POLL event, which is where a serial run would have
+ * emitted them, so the ring and its digest match the serial trace.
+ *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/asx.h>
 #include <asx/portable.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/digest.h>
+#include <asx/runtime/parallel.h>
 #include <string.h>
 #include "runtime_internal.h"
+#include "context_internal.h"
+#include "codec_internal.h"
 
 /* -------------------------------------------------------------------
  * Trace ring buffer
  * ------------------------------------------------------------------- */
 
 static asx_trace_event g_trace_ring[ASX_TRACE_CAPACITY];
-static uint32_t g_trace_count;
+static uint32_t g_trace_count;      /* events emitted since reset */
+static uint32_t g_trace_base;       /* kept events before g_trace_ring[0] */
+
+/* Kind filter (kept across reset): a set bit drops that kind */
+#define TRACE_KIND_WORDS 8u
+static uint32_t g_trace_kind_off[TRACE_KIND_WORDS];
+static uint32_t g_trace_kinds_off;  /* kinds dropped */
+static uint32_t g_trace_filtered;   /* events dropped since reset */
+
+/* Digest windows; the length is kept across reset */
+static uint32_t g_window_len;
+static uint32_t g_window_left;      /* events until the open window closes */
+static uint32_t g_window_count;     /* windows closed since reset */
+static uint32_t g_window_first;     /* first window latched since reset */
+static uint64_t g_window_digest[ASX_TRACE_WINDOW_HISTORY];
+
+/* FNV-1a offset basis */
+#define TRACE_DIGEST_BASIS 0x517cc1b727220a95ULL
+
+/* Running digest over g_trace_ring[0 .. g_digest_count) */
+static uint64_t g_digest_hash = TRACE_DIGEST_BASIS;
+static asx_digest_mode g_trace_digest_mode; /* latched at reset */
+static uint32_t g_digest_count;
+
+/* Digest of the stored events of every flushed chunk; differs from the
+ * running digest only once events have been filtered out */
+static uint64_t g_trace_stored_chain = TRACE_DIGEST_BASIS;
+
+/* Installed chunk sink (kept across reset) */
+static asx_trace_sink_fn g_trace_sink;
+static void             *g_trace_sink_ctx;
+static uint32_t          g_trace_chunks;
+
+/* Optional time deltas (ns since the previous event, saturating) */
+static uint32_t g_trace_delta[ASX_TRACE_CAPACITY];
+static int      g_trace_times_on;
+static int      g_trace_last_valid;
+static uint64_t g_trace_last_ns;
+
+/* Mapped replay reference (NULL if none); see replay_map_check */
+static const uint8_t *g_map_data;
+
+/* Round mode: polls held in records, not yet in the ring */
+typedef struct {
+    uint16_t offset;               /* ring slot minus the record's base */
+    uint16_t state_mask;
+    asx_generation generation;
+} trace_round_poll;
+
+typedef struct {
+    asx_trace_round pub;
+    uint32_t base;                 /* ring slot when the record opened */
+    uint32_t first_poll;           /* into g_round_polls */
+    uint32_t last_index;           /* highest arena index polled */
+} trace_round_rec;
+
+static trace_round_rec  g_rounds[ASX_TRACE_ROUND_CAPACITY];
+static trace_round_poll g_round_polls[ASX_TRACE_CAPACITY];
+static uint32_t g_round_count;
+static uint32_t g_trace_elided;    /* polls held in g_round_polls */
+static int      g_trace_round_on;
+
+/* Compressed history ring over caller storage (see the history
+ * section); the delta state is per kind group (kind >> 4) */
+#define TRACE_HIST_GROUPS 16u
+static uint8_t *g_hist_buf;
+static uint32_t g_hist_segs;       /* segments in the storage */
+static uint32_t g_hist_head;       /* oldest live segment */
+static uint32_t g_hist_live;       /* live segments, the newest open */
+static uint32_t g_hist_used;       /* bytes of the open segment */
+static uint32_t g_hist_events;     /* events in the open segment */
+static uint64_t g_hist_entity[TRACE_HIST_GROUPS];
+static uint64_t g_hist_aux[TRACE_HIST_GROUPS];
+
+static void trace_flush_chunk(void);
+static void trace_window_tick(void);
+static void replay_map_check(const asx_trace_event *e);
+static void replay_map_rewind(void);
+static void replay_watermark_clamp(uint32_t from);
+static void replay_watermark_reset(void);
+static int trace_stage_append(asx_trace_event_kind kind,
+                              uint64_t entity_id, uint64_t aux);
+static void trace_rebuild_rounds(void);
+static void trace_history_append(const asx_trace_event *e);
+static uint64_t trace_digest_event(asx_digest_mode mode, uint64_t hash,
+                                   const asx_trace_event *e);
+
+/* Events held in the ring, with any pending round records rebuilt. */
+static uint32_t trace_stored(void)
+{
+    uint32_t n;
+
+    if (g_round_count != 0) trace_rebuild_rounds();
+    n = g_trace_count - g_trace_filtered - g_trace_base;
+    return n < ASX_TRACE_CAPACITY ? n : ASX_TRACE_CAPACITY;
+}
+
+/* Clock delta since the previous stamped event; 0 for the first one or
+ * if the clock is unavailable or stepped back. */
+static uint32_t trace_time_delta(void)
+{
+    asx_time now;
+    uint64_t d = 0;
+
+    if (asx_runtime_now_ns(&now) != ASX_OK) return 0;
+    if (g_trace_last_valid && (uint64_t)now > g_trace_last_ns) {
+        d = (uint64_t)now - g_trace_last_ns;
+    }
+    g_trace_last_ns = (uint64_t)now;
+    g_trace_last_valid = 1;
+    return d > UINT32_MAX ? UINT32_MAX : (uint32_t)d;
+}
+
+static int trace_kind_dropped(asx_trace_event_kind kind)
+{
+    uint32_t k = (uint32_t)kind;
+
+    if (k >= TRACE_KIND_WORDS * 32u) return 0;
+    return (g_trace_kind_off[k >> 5] >> (k & 31u)) & 1u;
+}
+
+/* Fold a filtered event into the running digest in stream order, after
+ * the stored events before it, without storing it. */
+static void trace_drop(asx_trace_event_kind kind, uint64_t entity_id,
+                       uint64_t aux)
+{
+    asx_trace_event e;
+
+    e.sequence  = g_trace_count;
+    e.kind      = kind;
+    e.entity_id = entity_id;
+    e.aux       = aux;
+    (void)asx_trace_digest();
+    g_digest_hash = trace_digest_event(g_trace_digest_mode, g_digest_hash, &e);
+    g_trace_filtered++;
+    g_trace_count++;
+    if (g_window_len != 0) trace_window_tick();
+}
 
 void asx_trace_emit(asx_trace_event_kind kind,
                      uint64_t entity_id,
                      uint64_t aux)
 {
-    if (g_trace_count < ASX_TRACE_CAPACITY) {
-        asx_trace_event *e = &g_trace_ring[g_trace_count];
+    uint32_t slot;
+
+    if (trace_stage_append(kind, entity_id, aux)) return;
+    if (g_trace_kinds_off != 0 && trace_kind_dropped(kind)) {
+        trace_drop(kind, entity_id, aux);
+        return;
+    }
+
+    /* Held polls count against the capacity they will take up */
+    slot = g_trace_count - g_trace_filtered - g_trace_base;
+    if (slot + g_trace_elided >= ASX_TRACE_CAPACITY && g_trace_sink != NULL) {
+        trace_flush_chunk();
+        slot = 0;
+    }
+    if (slot + g_trace_elided < ASX_TRACE_CAPACITY) {
+        asx_trace_event *e = &g_trace_ring[slot];
         e->sequence  = g_trace_count;
         e->kind      = kind;
         e->entity_id = entity_id;
         e->aux       = aux;
+        g_trace_delta[slot] = g_trace_times_on ? trace_time_delta() : 0u;
+    }
+    if (g_map_data != NULL || g_hist_buf != NULL) {
+        asx_trace_event e;
+        e.sequence  = g_trace_count;
+        e.kind      = kind;
+        e.entity_id = entity_id;
+        e.aux       = aux;
+        if (g_map_data != NULL) replay_map_check(&e);
+        if (g_hist_buf != NULL) trace_history_append(&e);
     }
     g_trace_count++;
+    if (g_window_len != 0) trace_window_tick();
 }
 
 uint32_t asx_trace_event_count(void)
@@ -45,60 +251,304 @@ uint32_t asx_trace_event_count(void)
     /* Return stored count, not total emitted. Events beyond capacity
      * are silently dropped; reporting the unbounded count misleads
      * callers into iterating past readable entries. */
-    return g_trace_count < ASX_TRACE_CAPACITY
-         ? g_trace_count : ASX_TRACE_CAPACITY;
+    return trace_stored();
 }
 
 int asx_trace_event_get(uint32_t index, asx_trace_event *out)
 {
     if (out == NULL) return 0;
-    if (index >= g_trace_count) return 0;
-    if (index >= ASX_TRACE_CAPACITY) return 0;
+    if (index >= trace_stored()) return 0;
     *out = g_trace_ring[index];
     return 1;
 }
 
+void asx_trace_set_timestamps(int enabled)
+{
+    g_trace_times_on = enabled != 0;
+    g_trace_last_valid = 0;
+}
+
+int asx_trace_timestamps_enabled(void)
+{
+    return g_trace_times_on;
+}
+
+int asx_trace_event_delta_ns(uint32_t index, uint32_t *out_ns)
+{
+    if (out_ns == NULL) return 0;
+    if (index >= trace_stored()) return 0;
+    *out_ns = g_trace_delta[index];
+    return 1;
+}
+
+void asx_trace_set_round_mode(int enabled)
+{
+    g_trace_round_on = enabled != 0;
+}
+
+int asx_trace_round_mode_enabled(void)
+{
+    return g_trace_round_on;
+}
+
+uint32_t asx_trace_round_count(void)
+{
+    return g_round_count;
+}
+
+int asx_trace_round_get(uint32_t index, asx_trace_round *out)
+{
+    if (out == NULL) return 0;
+    if (index >= g_round_count) return 0;
+    *out = g_rounds[index].pub;
+    return 1;
+}
+
+int asx_trace_round_poll(asx_task_id tid, uint32_t round)
+{
+    trace_round_rec *rec;
+    trace_round_poll *p;
+    uint32_t slot;
+    uint32_t index = asx_handle_slot(tid);
+
+    if (!g_trace_round_on || g_trace_sink != NULL || g_map_data != NULL ||
+        g_hist_buf != NULL || g_trace_kinds_off != 0 || g_trace_times_on ||
+        g_window_len != 0) {
+        return 0;
+    }
+    slot = g_trace_count - g_trace_filtered - g_trace_base;
+    if (slot + g_trace_elided >= ASX_TRACE_CAPACITY) return 0;
+
+    /* A round polls ascending indices; anything else opens a record */
+    rec = g_round_count != 0 ? &g_rounds[g_round_count - 1u] : NULL;
+    if (rec == NULL || rec->pub.round != round || index <= rec->last_index ||
+        index - rec->pub.first_index >= ASX_TRACE_ROUND_WINDOW) {
+        if (g_round_count == ASX_TRACE_ROUND_CAPACITY) return 0;
+        rec = &g_rounds[g_round_count++];
+        rec->pub.round = round;
+        rec->pub.first_index = index;
+        rec->pub.polled = 0;
+        rec->base = slot;
+        rec->first_poll = g_trace_elided;
+    }
+    rec->pub.polled |= (uint64_t)1 << (index - rec->pub.first_index);
+    rec->last_index = index;
+
+    p = &g_round_polls[g_trace_elided++];
+    p->offset = (uint16_t)(slot - rec->base);
+    p->generation = asx_handle_generation(tid);
+    p->state_mask = asx_handle_state_mask(tid);
+    return 1;
+}
+
+/* Insert every held poll at its ring position, back to front so each
+ * stored event moves once, then renumber from the first insertion. */
+static void trace_rebuild_rounds(void)
+{
+    uint32_t held = g_trace_count - g_trace_filtered - g_trace_base;
+    uint32_t total;
+    uint32_t src;
+    uint32_t dst;
+    uint32_t r = g_round_count;
+    uint32_t from = g_rounds[0].base;
+    uint32_t k;
+
+    if (held > ASX_TRACE_CAPACITY - g_trace_elided) {
+        held = ASX_TRACE_CAPACITY - g_trace_elided;
+    }
+    total = held + g_trace_elided;
+    src = held;
+    dst = total;
+    k = g_trace_elided;
+
+    while (r-- > 0) {
+        const trace_round_rec *rec = &g_rounds[r];
+        uint32_t bit = ASX_TRACE_ROUND_WINDOW;
+
+        while (bit-- > 0) {
+            const trace_round_poll *p;
+            asx_trace_event *e;
+            uint32_t pos;
+            uint32_t n;
+
+            if (((rec->pub.polled >> bit) & 1u) == 0) continue;
+            p = &g_round_polls[--k];
+            pos = rec->base + p->offset;
+            n = src - pos;
+            memmove(&g_trace_ring[dst - n], &g_trace_ring[pos],
+                    n * sizeof(g_trace_ring[0]));
+            memmove(&g_trace_delta[dst - n], &g_trace_delta[pos],
+                    n * sizeof(g_trace_delta[0]));
+            dst -= n + 1u;
+            src = pos;
+
+            e = &g_trace_ring[dst];
+            e->kind = ASX_TRACE_SCHED_POLL;
+            e->entity_id = asx_handle_pack(
+                ASX_TYPE_TASK, p->state_mask,
+                asx_handle_pack_index(p->generation,
+                                      rec->pub.first_index + bit));
+            e->aux = rec->pub.round;
+            g_trace_delta[dst] = 0;
+        }
+    }
+
+    /* Records are only made with the filter off, so every dropped
+     * event precedes them */
+    for (k = from; k < total; k++) {
+        g_trace_ring[k].sequence = g_trace_base + g_trace_filtered + k;
+    }
+    /* Events from the first insertion on have moved */
+    replay_watermark_clamp(from);
+    g_trace_count += g_trace_elided;
+    g_trace_elided = 0;
+    g_round_count = 0;
+}
+
 void asx_trace_reset(void)
 {
     g_trace_count = 0;
+    g_trace_base = 0;
+    g_trace_filtered = 0;
+    g_trace_stored_chain = TRACE_DIGEST_BASIS;
+    g_trace_elided = 0;
+    g_round_count = 0;
+    g_trace_chunks = 0;
+    g_digest_hash = TRACE_DIGEST_BASIS;
+    g_digest_count = 0;
+    g_trace_digest_mode = asx_digest_get_mode(ASX_DIGEST_DOMAIN_TRACE);
+    g_trace_last_valid = 0;
+    g_hist_head = 0;
+    g_hist_live = 0;
+    g_window_left = g_window_len;
+    g_window_count = 0;
+    g_window_first = 0;
+    replay_watermark_reset();
+    if (g_map_data != NULL) replay_map_rewind();
 }
 
 /* -------------------------------------------------------------------
  * FNV-1a 64-bit digest over the trace event stream
  * ------------------------------------------------------------------- */
 
-static uint64_t fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
+/* Fold one event into a digest: sequence, kind, entity_id, aux.
+ * WORD64 packs sequence and kind into one word. */
+static uint64_t trace_digest_event(asx_digest_mode mode, uint64_t hash,
+                                   const asx_trace_event *e)
+{
+    uint32_t k = (uint32_t)e->kind;
+
+    if (mode == ASX_DIGEST_WORD64) {
+        hash = asx_digest_word(hash, (uint64_t)e->sequence | ((uint64_t)k << 32));
+        hash = asx_digest_word(hash, e->entity_id);
+        return asx_digest_word(hash, e->aux);
+    }
+    hash = asx_digest_fnv1a(hash, &e->sequence, sizeof(e->sequence));
+    hash = asx_digest_fnv1a(hash, &k, sizeof(k));
+    hash = asx_digest_fnv1a(hash, &e->entity_id, sizeof(e->entity_id));
+    return asx_digest_fnv1a(hash, &e->aux, sizeof(e->aux));
+}
+
+/* Fold count events into hash (TRACE_DIGEST_BASIS for a whole trace). */
+static uint64_t trace_digest_events(asx_digest_mode mode, uint64_t hash,
+                                    const asx_trace_event *events,
+                                    uint32_t count)
 {
-    const uint8_t *p = (const uint8_t *)data;
     uint32_t i;
 
-    for (i = 0; i < len; i++) {
-        hash ^= (uint64_t)p[i];
-        hash *= 0x00000100000001B3ULL;
+    for (i = 0; i < count; i++) {
+        hash = trace_digest_event(mode, hash, &events[i]);
     }
     return hash;
 }
 
 uint64_t asx_trace_digest(void)
 {
-    uint64_t hash = 0x517cc1b727220a95ULL; /* FNV-1a offset basis */
-    uint32_t count;
-    uint32_t i;
-
-    count = g_trace_count < ASX_TRACE_CAPACITY
-            ? g_trace_count
-            : ASX_TRACE_CAPACITY;
+    uint32_t count = trace_stored();
 
-    for (i = 0; i < count; i++) {
-        asx_trace_event *e = &g_trace_ring[i];
-        uint32_t k = (uint32_t)e->kind;
-        hash = fnv1a_mix(hash, &e->sequence, sizeof(e->sequence));
-        hash = fnv1a_mix(hash, &k, sizeof(k));
-        hash = fnv1a_mix(hash, &e->entity_id, sizeof(e->entity_id));
-        hash = fnv1a_mix(hash, &e->aux, sizeof(e->aux));
+    /* Stored events are append-only until reset: hash only new ones */
+    while (g_digest_count < count) {
+        g_digest_hash = trace_digest_event(g_trace_digest_mode, g_digest_hash,
+                                           &g_trace_ring[g_digest_count]);
+        g_digest_count++;
     }
+    return g_digest_hash;
+}
 
-    return hash;
+/* Digest of the stored events alone, which exports carry and replay
+ * compares: the running digest unless events were filtered out. */
+static uint64_t trace_stored_digest(void)
+{
+    if (g_trace_filtered == 0) return asx_trace_digest();
+    return trace_digest_events(g_trace_digest_mode, g_trace_stored_chain,
+                               g_trace_ring, trace_stored());
+}
+
+void asx_trace_set_kind_enabled(asx_trace_event_kind kind, int enabled)
+{
+    uint32_t k = (uint32_t)kind;
+    uint32_t bit;
+    int off;
+
+    if (k >= TRACE_KIND_WORDS * 32u) return;
+    bit = 1u << (k & 31u);
+    off = (g_trace_kind_off[k >> 5] & bit) != 0;
+    if (off == !enabled) return;
+
+    /* Pending round records were made unfiltered: rebuild them first */
+    (void)trace_stored();
+    g_trace_kind_off[k >> 5] ^= bit;
+    if (enabled) g_trace_kinds_off--;
+    else g_trace_kinds_off++;
+}
+
+int asx_trace_kind_enabled(asx_trace_event_kind kind)
+{
+    return !trace_kind_dropped(kind);
+}
+
+uint32_t asx_trace_filtered_count(void)
+{
+    return g_trace_filtered;
+}
+
+/* Latch the digest as of the event just counted if it ends a window */
+static void trace_window_tick(void)
+{
+    if (--g_window_left != 0) return;
+    g_window_digest[g_window_count % ASX_TRACE_WINDOW_HISTORY] =
+        asx_trace_digest();
+    g_window_count++;
+    g_window_left = g_window_len;
+}
+
+void asx_trace_set_digest_window(uint32_t events)
+{
+    /* Pending round records hold uncounted polls: rebuild them first */
+    (void)trace_stored();
+    g_window_len = events;
+    g_window_count = events != 0 ? g_trace_count / events : 0;
+    g_window_first = g_window_count;
+    g_window_left = events != 0 ? events - g_trace_count % events : 0;
+}
+
+uint32_t asx_trace_digest_window(void)
+{
+    return g_window_len;
+}
+
+uint32_t asx_trace_window_count(void)
+{
+    return g_window_count;
+}
+
+int asx_trace_window_get(uint32_t window, uint64_t *out_digest)
+{
+    if (out_digest == NULL) return 0;
+    if (window >= g_window_count || window < g_window_first) return 0;
+    if (g_window_count - window > ASX_TRACE_WINDOW_HISTORY) return 0;
+    *out_digest = g_window_digest[window % ASX_TRACE_WINDOW_HISTORY];
+    return 1;
 }
 
 /* -------------------------------------------------------------------
@@ -107,8 +557,49 @@ uint64_t asx_trace_digest(void)
 
 static asx_trace_event g_replay_ref[ASX_TRACE_CAPACITY];
 static uint32_t g_replay_ref_count;
+static uint64_t g_replay_ref_digest;
 static int      g_replay_loaded;
 
+/* Verified prefix: live events [0, g_replay_verified) matched the loaded
+ * reference at an earlier verify and are not compared again. Dropped
+ * whenever those events or the reference may change. */
+static uint32_t g_replay_verified;
+static uint64_t g_replay_verified_digest = TRACE_DIGEST_BASIS;
+
+static void replay_watermark_reset(void)
+{
+    g_replay_verified = 0;
+    g_replay_verified_digest = TRACE_DIGEST_BASIS;
+}
+
+/* Drop the prefix if ring positions from on were rewritten */
+static void replay_watermark_clamp(uint32_t from)
+{
+    if (from < g_replay_verified) replay_watermark_reset();
+}
+
+/* Compare live events from the watermark up to limit, moving it past
+ * each match. Returns the kind of the first mismatch, which stays at
+ * the watermark. */
+static asx_replay_result_kind replay_advance(uint32_t limit)
+{
+    while (g_replay_verified < limit) {
+        const asx_trace_event *actual = &g_trace_ring[g_replay_verified];
+        const asx_trace_event *expected = &g_replay_ref[g_replay_verified];
+
+        if (actual->kind != expected->kind) return ASX_REPLAY_KIND_MISMATCH;
+        if (actual->entity_id != expected->entity_id) {
+            return ASX_REPLAY_ENTITY_MISMATCH;
+        }
+        if (actual->aux != expected->aux) return ASX_REPLAY_AUX_MISMATCH;
+        g_replay_verified_digest = trace_digest_event(g_trace_digest_mode,
+                                                      g_replay_verified_digest,
+                                                      actual);
+        g_replay_verified++;
+    }
+    return ASX_REPLAY_MATCH;
+}
+
 asx_status asx_replay_load_reference(const asx_trace_event *events,
                                       uint32_t count)
 {
@@ -126,7 +617,12 @@ asx_status asx_replay_load_reference(const asx_trace_event *events,
         memcpy(g_replay_ref, events, copy_count * sizeof(asx_trace_event));
     }
     g_replay_ref_count = count;
+    g_replay_ref_digest = trace_digest_events(g_trace_digest_mode,
+                                              TRACE_DIGEST_BASIS,
+                                              g_replay_ref, count);
     g_replay_loaded = 1;
+    g_map_data = NULL;
+    replay_watermark_reset();
     return ASX_OK;
 }
 
@@ -134,79 +630,62 @@ void asx_replay_clear_reference(void)
 {
     g_replay_ref_count = 0;
     g_replay_loaded = 0;
+    g_map_data = NULL;
+    replay_watermark_reset();
+}
+
+uint32_t asx_replay_verified_prefix(uint64_t *out_digest)
+{
+    if (out_digest != NULL) *out_digest = g_replay_verified_digest;
+    return g_replay_verified;
 }
 
+static asx_replay_result replay_map_verify(void);
+
 asx_replay_result asx_replay_verify(void)
 {
     asx_replay_result result;
+    asx_replay_result_kind kind;
     uint32_t check_count;
-    uint32_t i;
+    uint32_t kept;
     uint64_t expected_digest;
     uint64_t actual_digest;
 
     memset(&result, 0, sizeof(result));
 
+    if (g_map_data != NULL) return replay_map_verify();
     if (!g_replay_loaded) {
         result.result = ASX_REPLAY_MATCH;
         return result;
     }
+    check_count = trace_stored();
+
+    /* Compare only what the watermark has not covered, even when the
+     * lengths differ, so a growing trace verifies each event once */
+    kind = replay_advance(check_count < g_replay_ref_count ? check_count
+                                                           : g_replay_ref_count);
 
     /* Check event count */
-    if (g_trace_count != g_replay_ref_count) {
+    kept = g_trace_count - g_trace_filtered;
+    if (kept != g_replay_ref_count) {
         result.result = ASX_REPLAY_LENGTH_MISMATCH;
-        result.divergence_index = g_trace_count < g_replay_ref_count
-                                  ? g_trace_count
+        result.divergence_index = kept < g_replay_ref_count
+                                  ? kept
                                   : g_replay_ref_count;
         return result;
     }
 
-    /* Element-by-element comparison */
-    check_count = g_trace_count < ASX_TRACE_CAPACITY
-                  ? g_trace_count
-                  : ASX_TRACE_CAPACITY;
-
-    for (i = 0; i < check_count; i++) {
-        asx_trace_event *actual = &g_trace_ring[i];
-        asx_trace_event *expected = &g_replay_ref[i];
-
-        if (actual->kind != expected->kind) {
-            result.result = ASX_REPLAY_KIND_MISMATCH;
-            result.divergence_index = i;
-            return result;
-        }
-        if (actual->entity_id != expected->entity_id) {
-            result.result = ASX_REPLAY_ENTITY_MISMATCH;
-            result.divergence_index = i;
-            return result;
-        }
-        if (actual->aux != expected->aux) {
-            result.result = ASX_REPLAY_AUX_MISMATCH;
-            result.divergence_index = i;
-            return result;
-        }
+    if (kind != ASX_REPLAY_MATCH) {
+        result.result = kind;
+        result.divergence_index = g_replay_verified;
+        return result;
     }
 
     /* Compute and compare digests */
-    actual_digest = asx_trace_digest();
+    actual_digest = trace_stored_digest();
 
-    /* Compute expected digest from reference */
-    {
-        uint64_t hash = 0x517cc1b727220a95ULL;
-        uint32_t ref_count = g_replay_ref_count < ASX_TRACE_CAPACITY
-                             ? g_replay_ref_count
-                             : ASX_TRACE_CAPACITY;
-        for (i = 0; i < ref_count; i++) {
-            uint32_t k = (uint32_t)g_replay_ref[i].kind;
-            hash = fnv1a_mix(hash, &g_replay_ref[i].sequence,
-                             sizeof(g_replay_ref[i].sequence));
-            hash = fnv1a_mix(hash, &k, sizeof(k));
-            hash = fnv1a_mix(hash, &g_replay_ref[i].entity_id,
-                             sizeof(g_replay_ref[i].entity_id));
-            hash = fnv1a_mix(hash, &g_replay_ref[i].aux,
-                             sizeof(g_replay_ref[i].aux));
-        }
-        expected_digest = hash;
-    }
+    /* Reference digest, computed once at load */
+    expected_digest = g_replay_ref_digest;
 
     result.expected_digest = expected_digest;
     result.actual_digest = actual_digest;
@@ -220,6 +699,201 @@ asx_replay_result asx_replay_verify(void)
     return result;
 }
 
+/* -------------------------------------------------------------------
+ * Trace diff
+ *
+ * Myers' greedy diff over the events between the common prefix and
+ * suffix. Round d keeps, for each diagonal k = x - y in [-d, d], the
+ * furthest reference index x reached with d edits; rounds are stored
+ * back to back (round d at d*d), so band edits take (band+1)^2 words
+ * and the script is recovered by walking the rounds backwards.
+ * ------------------------------------------------------------------- */
+
+static int diff_event_eq(const asx_trace_event *a, const asx_trace_event *b)
+{
+    return a->kind == b->kind && a->entity_id == b->entity_id &&
+           a->aux == b->aux;
+}
+
+/* V[k] of round d */
+#define DIFF_V(work, d, k) ((work)[(uint32_t)((int64_t)(d) * (d) + (k) + (d))])
+
+/* Whether round d reached diagonal k by an insertion (from k + 1)
+ * rather than a deletion (from k - 1) */
+static int diff_went_down(const uint32_t *work, int64_t d, int64_t k)
+{
+    if (k == -d) return 1;
+    if (k == d) return 0;
+    return DIFF_V(work, d - 1, k - 1) < DIFF_V(work, d - 1, k + 1);
+}
+
+/* Edits needed to align ref[0..n) with act[0..m), or band + 1 when
+ * more than band */
+static uint32_t diff_forward(const asx_trace_event *ref, uint32_t n,
+                             const asx_trace_event *act, uint32_t m,
+                             uint32_t *work, uint32_t band)
+{
+    int64_t d;
+    int64_t k;
+
+    for (d = 0; d <= (int64_t)band; d++) {
+        for (k = -d; k <= d; k += 2) {
+            int64_t x;
+            int64_t y;
+
+            if (d == 0) x = 0;
+            else if (diff_went_down(work, d, k)) x = DIFF_V(work, d - 1, k + 1);
+            else x = DIFF_V(work, d - 1, k - 1) + 1;
+            y = x - k;
+            while (x < (int64_t)n && y < (int64_t)m &&
+                   diff_event_eq(&ref[x], &act[y])) {
+                x++;
+                y++;
+            }
+            DIFF_V(work, d, k) = (uint32_t)x;
+            if (x >= (int64_t)n && y >= (int64_t)m) return (uint32_t)d;
+        }
+    }
+    return band + 1u;
+}
+
+/* Store window slot of total, counted from the end, when it is among
+ * the first ASX_TRACE_DIFF_MAX_WINDOWS */
+static void diff_window_put(asx_trace_diff *out, uint32_t slot,
+                            uint32_t base, int64_t sx, int64_t sy,
+                            int64_t ex, int64_t ey)
+{
+    asx_trace_diff_window *w;
+
+    if (out == NULL || slot >= ASX_TRACE_DIFF_MAX_WINDOWS) return;
+    w = &out->windows[slot];
+    w->ref_start = base + (uint32_t)sx;
+    w->ref_len = (uint32_t)(ex - sx);
+    w->act_start = base + (uint32_t)sy;
+    w->act_len = (uint32_t)(ey - sy);
+}
+
+/* Walk the d_end-edit script back from (n, m), joining edits with no
+ * match between them into one window. Returns the window count; with
+ * out non-NULL, stores the first windows of total, offset by base. */
+static uint32_t diff_windows(const uint32_t *work, uint32_t d_end,
+                             uint32_t n, uint32_t m, uint32_t base,
+                             uint32_t total, asx_trace_diff *out)
+{
+    int64_t k = (int64_t)n - (int64_t)m;
+    int64_t sx = 0;
+    int64_t sy = 0;
+    int64_t ex = 0;
+    int64_t ey = 0;
+    int open = 0;
+    uint32_t found = 0;
+    int64_t d;
+
+    for (d = d_end; d > 0; d--) {
+        int down = diff_went_down(work, d, k);
+        int64_t px;
+        int64_t py;
+        int64_t ax;
+        int64_t ay;
+
+        k += down ? 1 : -1;
+        px = DIFF_V(work, d - 1, k);
+        py = px - k;
+        ax = down ? px : px + 1;
+        ay = down ? py + 1 : py;
+        if (!open || ax != sx || ay != sy) {
+            if (open) {
+                found++;
+                diff_window_put(out, total - found, base, sx, sy, ex, ey);
+            }
+            open = 1;
+            ex = ax;
+            ey = ay;
+        }
+        sx = px;
+        sy = py;
+    }
+    if (open) {
+        found++;
+        diff_window_put(out, total - found, base, sx, sy, ex, ey);
+    }
+    return found;
+}
+
+#undef DIFF_V
+
+asx_status asx_trace_diff_events(const asx_trace_event *ref,
+                                 uint32_t ref_count,
+                                 const asx_trace_event *act,
+                                 uint32_t act_count,
+                                 uint32_t *work,
+                                 uint32_t work_words,
+                                 asx_trace_diff *out)
+{
+    uint32_t pre = 0;
+    uint32_t suf = 0;
+    uint32_t n;
+    uint32_t m;
+    uint32_t band = 0;
+    uint32_t d;
+
+    if (out == NULL || (ref == NULL && ref_count > 0) ||
+        (act == NULL && act_count > 0) || (work == NULL && work_words > 0)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    memset(out, 0, sizeof(*out));
+    out->aligned = 1;
+
+    while (pre < ref_count && pre < act_count &&
+           diff_event_eq(&ref[pre], &act[pre])) {
+        pre++;
+    }
+    while (suf < ref_count - pre && suf < act_count - pre &&
+           diff_event_eq(&ref[ref_count - 1u - suf],
+                         &act[act_count - 1u - suf])) {
+        suf++;
+    }
+    n = ref_count - pre - suf;
+    m = act_count - pre - suf;
+    out->matched = pre + suf;
+    if (n == 0 && m == 0) return ASX_OK;
+
+    if (n != 0 && m != 0) {
+        /* Largest band the work space holds, never more than n + m */
+        while ((band + 2u) * (band + 2u) <= work_words && band < n + m) band++;
+        d = work_words == 0
+          ? 1u
+          : diff_forward(ref + pre, n, act + pre, m, work, band);
+        if (d <= band) {
+            out->edits = d;
+            out->matched += (n + m - d) / 2u;
+            out->window_count = diff_windows(work, d, n, m, pre, 0, NULL);
+            (void)diff_windows(work, d, n, m, pre, out->window_count, out);
+            return ASX_OK;
+        }
+        out->aligned = 0;
+    }
+
+    /* One window spans the middle: a pure insertion or deletion, or an
+     * alignment beyond the band */
+    out->edits = n + m;
+    out->window_count = 1;
+    out->windows[0].ref_start = pre;
+    out->windows[0].ref_len = n;
+    out->windows[0].act_start = pre;
+    out->windows[0].act_len = m;
+    return ASX_OK;
+}
+
+asx_status asx_replay_diff(uint32_t *work, uint32_t work_words,
+                           asx_trace_diff *out)
+{
+    if (g_map_data != NULL || !g_replay_loaded) return ASX_E_INVALID_STATE;
+    return asx_trace_diff_events(g_replay_ref, g_replay_ref_count,
+                                 g_trace_ring, trace_stored(),
+                                 work, work_words, out);
+}
+
 /* -------------------------------------------------------------------
  * Snapshot export
  * ------------------------------------------------------------------- */
@@ -282,52 +956,52 @@ asx_status asx_snapshot_capture(asx_snapshot_buffer *out)
     snap_str(out, "{\"regions\":[");
     first = 1;
     for (i = 0; i < g_region_count; i++) {
-        if (!g_regions[i].alive) continue;
+        if (!asx_slot_live(asx_region_at(i)->key)) continue;
         if (!first) snap_str(out, ",");
         first = 0;
         snap_str(out, "{\"slot\":");
         snap_u32(out, i);
         snap_str(out, ",\"state\":");
-        snap_u32(out, (uint32_t)g_regions[i].state);
+        snap_u32(out, (uint32_t)asx_region_at(i)->state);
         snap_str(out, ",\"tasks\":");
-        snap_u32(out, g_regions[i].task_count);
+        snap_u32(out, asx_region_at(i)->task_count);
         snap_str(out, ",\"gen\":");
-        snap_u32(out, (uint32_t)g_regions[i].generation);
+        snap_u32(out, (uint32_t)asx_slot_generation(asx_region_at(i)->key));
         snap_str(out, "}");
     }
 
     snap_str(out, "],\"tasks\":[");
     first = 1;
     for (i = 0; i < g_task_count; i++) {
-        if (!g_tasks[i].alive) continue;
+        if (!asx_slot_live(asx_task_at(i)->key)) continue;
         if (!first) snap_str(out, ",");
         first = 0;
         snap_str(out, "{\"slot\":");
         snap_u32(out, i);
         snap_str(out, ",\"state\":");
-        snap_u32(out, (uint32_t)g_tasks[i].state);
+        snap_u32(out, (uint32_t)asx_task_at(i)->state);
         snap_str(out, ",\"gen\":");
-        snap_u32(out, (uint32_t)g_tasks[i].generation);
+        snap_u32(out, (uint32_t)asx_slot_generation(asx_task_at(i)->key));
         snap_str(out, "}");
     }
 
     snap_str(out, "],\"obligations\":[");
     first = 1;
     for (i = 0; i < g_obligation_count; i++) {
-        if (!g_obligations[i].alive) continue;
+        if (!asx_slot_live(asx_obligation_at(i)->key)) continue;
         if (!first) snap_str(out, ",");
         first = 0;
         snap_str(out, "{\"slot\":");
         snap_u32(out, i);
         snap_str(out, ",\"state\":");
-        snap_u32(out, (uint32_t)g_obligations[i].state);
+        snap_u32(out, (uint32_t)asx_obligation_at(i)->state);
         snap_str(out, ",\"gen\":");
-        snap_u32(out, (uint32_t)g_obligations[i].generation);
+        snap_u32(out, (uint32_t)asx_slot_generation(asx_obligation_at(i)->key));
         snap_str(out, "}");
     }
 
     snap_str(out, "],\"trace_count\":");
-    snap_u32(out, g_trace_count);
+    snap_u32(out, g_trace_count + g_trace_elided);
     snap_str(out, ",\"trace_digest\":");
     {
         uint64_t d = asx_trace_digest();
@@ -349,7 +1023,8 @@ asx_status asx_snapshot_capture(asx_snapshot_buffer *out)
 uint64_t asx_snapshot_digest(const asx_snapshot_buffer *snap)
 {
     if (snap == NULL) return 0;
-    return fnv1a_mix(0x517cc1b727220a95ULL, snap->data, snap->len);
+    return asx_digest_bytes(g_trace_digest_mode, 0x517cc1b727220a95ULL,
+                            snap->data, snap->len);
 }
 
 /* -------------------------------------------------------------------
@@ -369,6 +1044,8 @@ const char *asx_trace_event_kind_str(asx_trace_event_kind kind)
     case ASX_TRACE_REGION_CLOSED:      return "region_closed";
     case ASX_TRACE_TASK_SPAWN:         return "task_spawn";
     case ASX_TRACE_TASK_TRANSITION:    return "task_transition";
+    case ASX_TRACE_TASK_PARK:          return "task_park";
+    case ASX_TRACE_TASK_WAKE:          return "task_wake";
     case ASX_TRACE_OBLIGATION_RESERVE: return "obligation_reserve";
     case ASX_TRACE_OBLIGATION_COMMIT:  return "obligation_commit";
     case ASX_TRACE_OBLIGATION_ABORT:   return "obligation_abort";
@@ -377,6 +1054,8 @@ const char *asx_trace_event_kind_str(asx_trace_event_kind kind)
     case ASX_TRACE_TIMER_SET:          return "timer_set";
     case ASX_TRACE_TIMER_FIRE:         return "timer_fire";
     case ASX_TRACE_TIMER_CANCEL:       return "timer_cancel";
+    case ASX_TRACE_ADMISSION:          return "admission";
+    case ASX_TRACE_WATERMARK:          return "watermark";
     default:                           return "unknown";
     }
 }
@@ -428,102 +1107,392 @@ static uint64_t read_le64(const uint8_t *p)
          | ((uint64_t)read_le32(p + 4) << 32);
 }
 
+#define TRACE_KNOWN_FLAGS (ASX_TRACE_BINARY_FLAG_TIMES | \
+                           ASX_TRACE_BINARY_FLAG_WORD_DIGEST)
+
+/* Version-word flags for the current export */
+static uint32_t trace_flags(void)
+{
+    uint32_t flags = g_trace_times_on ? ASX_TRACE_BINARY_FLAG_TIMES : 0u;
+    if (g_trace_digest_mode == ASX_DIGEST_WORD64) {
+        flags |= ASX_TRACE_BINARY_FLAG_WORD_DIGEST;
+    }
+    return flags;
+}
+
+/* Digest mode a buffer's header flags were written under */
+static asx_digest_mode trace_flags_mode(uint32_t flags)
+{
+    return (flags & ASX_TRACE_BINARY_FLAG_WORD_DIGEST) != 0
+        ? ASX_DIGEST_WORD64 : ASX_DIGEST_FNV1A;
+}
+
+/* Encoded v1 length of count events with the given flags */
+static uint32_t trace_v1_len(uint32_t count, uint32_t flags)
+{
+    uint32_t per = ASX_TRACE_BINARY_EVENT;
+    if (flags & ASX_TRACE_BINARY_FLAG_TIMES) per += 4u;
+    return ASX_TRACE_BINARY_HEADER + count * per;
+}
+
+static void trace_encode_header(uint8_t *buf, uint32_t count,
+                                uint32_t chunk, uint64_t digest)
+{
+    write_le32(buf + 0, ASX_TRACE_BINARY_MAGIC);
+    write_le32(buf + 4, ASX_TRACE_BINARY_VERSION | trace_flags());
+    write_le32(buf + 8, count);
+    write_le32(buf + 12, chunk);
+    write_le64(buf + 16, digest);
+}
+
+static void trace_encode_event(uint8_t *p, const asx_trace_event *e)
+{
+    write_le32(p + 0, e->sequence);
+    write_le32(p + 4, (uint32_t)e->kind);
+    write_le64(p + 8, e->entity_id);
+    write_le64(p + 16, e->aux);
+}
+
+/* Write the ring's first count events in the binary format; reserved
+ * carries the chunk index (0 for a run that never flushed). */
+static void trace_encode(uint8_t *buf, uint32_t count, uint32_t chunk,
+                         uint64_t digest)
+{
+    uint32_t flags = trace_flags();
+    uint32_t i;
+    uint8_t *p;
+
+    trace_encode_header(buf, count, chunk, digest);
+    p = buf + ASX_TRACE_BINARY_HEADER;
+    for (i = 0; i < count; i++) {
+        trace_encode_event(p, &g_trace_ring[i]);
+        p += ASX_TRACE_BINARY_EVENT;
+    }
+    if (flags & ASX_TRACE_BINARY_FLAG_TIMES) {
+        asx_store_le_u32_array(p, g_trace_delta, count);
+    }
+}
+
 asx_status asx_trace_export_binary(uint8_t *buf,
                                     uint32_t capacity,
                                     uint32_t *out_len)
 {
     uint32_t count;
     uint32_t needed;
-    uint64_t digest;
-    uint32_t i;
-    uint8_t *p;
 
     if (buf == NULL || out_len == NULL) return ASX_E_INVALID_ARGUMENT;
 
-    count = g_trace_count < ASX_TRACE_CAPACITY
-            ? g_trace_count
-            : ASX_TRACE_CAPACITY;
-
-    needed = ASX_TRACE_BINARY_HEADER + count * ASX_TRACE_BINARY_EVENT;
+    count = trace_stored();
+    needed = trace_v1_len(count, trace_flags());
     if (capacity < needed) {
         *out_len = needed;
         return ASX_E_BUFFER_TOO_SMALL;
     }
 
-    digest = asx_trace_digest();
+    trace_encode(buf, count, g_trace_chunks, trace_stored_digest());
+    *out_len = needed;
+    return ASX_OK;
+}
 
-    /* Write header */
-    write_le32(buf + 0, ASX_TRACE_BINARY_MAGIC);
-    write_le32(buf + 4, ASX_TRACE_BINARY_VERSION);
-    write_le32(buf + 8, count);
-    write_le32(buf + 12, 0);  /* reserved */
-    write_le64(buf + 16, digest);
+/* Fixed-size blocks staged in caller scratch on their way to a writer */
+typedef struct {
+    asx_trace_sink_fn writer;
+    void *ctx;
+    uint8_t *block;
+    uint32_t cap;
+    uint32_t len;
+    uint32_t total;
+    asx_status st;
+} trace_block_out;
 
-    /* Write events */
-    p = buf + ASX_TRACE_BINARY_HEADER;
-    for (i = 0; i < count; i++) {
-        asx_trace_event *e = &g_trace_ring[i];
-        write_le32(p + 0, e->sequence);
-        write_le32(p + 4, (uint32_t)e->kind);
-        write_le64(p + 8, e->entity_id);
-        write_le64(p + 16, e->aux);
-        p += ASX_TRACE_BINARY_EVENT;
+/* Append n bytes, handing each block to the writer as it fills. */
+static void trace_block_put(trace_block_out *o, const uint8_t *p, uint32_t n)
+{
+    while (n > 0 && o->st == ASX_OK) {
+        uint32_t take = o->cap - o->len;
+
+        if (take > n) take = n;
+        memcpy(o->block + o->len, p, take);
+        o->len += take;
+        o->total += take;
+        p += take;
+        n -= take;
+        if (o->len == o->cap) {
+            o->st = o->writer(o->ctx, o->block, o->len);
+            o->len = 0;
+        }
     }
-
-    *out_len = needed;
-    return ASX_OK;
 }
 
-asx_status asx_trace_import_binary(const uint8_t *buf, uint32_t len)
+asx_status asx_trace_export_binary_blocks(asx_trace_sink_fn writer,
+                                          void *ctx,
+                                          uint8_t *scratch,
+                                          uint32_t block_len,
+                                          uint32_t *out_len)
 {
-    uint32_t magic;
-    uint32_t version;
+    trace_block_out o;
+    uint8_t rec[ASX_TRACE_BINARY_EVENT];
     uint32_t count;
-    uint64_t stored_digest;
-    uint32_t needed;
     uint32_t i;
-    const uint8_t *p;
-    asx_trace_event events[ASX_TRACE_CAPACITY];
-    uint64_t computed_digest;
-    uint64_t hash;
-
-    if (buf == NULL) return ASX_E_INVALID_ARGUMENT;
-    if (len < ASX_TRACE_BINARY_HEADER) return ASX_E_INVALID_ARGUMENT;
+    uint32_t n;
 
-    magic   = read_le32(buf + 0);
-    version = read_le32(buf + 4);
-    count   = read_le32(buf + 8);
-    stored_digest = read_le64(buf + 16);
+    if (writer == NULL || scratch == NULL || block_len == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    count = trace_stored();
+
+    o.writer = writer;
+    o.ctx = ctx;
+    o.block = scratch;
+    o.cap = block_len;
+    o.len = 0;
+    o.total = 0;
+    o.st = ASX_OK;
+
+    trace_encode_header(rec, count, g_trace_chunks, trace_stored_digest());
+    trace_block_put(&o, rec, ASX_TRACE_BINARY_HEADER);
+    for (i = 0; i < count; i++) {
+        trace_encode_event(rec, &g_trace_ring[i]);
+        trace_block_put(&o, rec, ASX_TRACE_BINARY_EVENT);
+    }
+    if (g_trace_times_on) {
+        /* The time column goes out a record's worth of values at a time */
+        for (i = 0; i < count; i += n) {
+            n = count - i;
+            if (n > ASX_TRACE_BINARY_EVENT / 4u) n = ASX_TRACE_BINARY_EVENT / 4u;
+            asx_store_le_u32_array(rec, &g_trace_delta[i], n);
+            trace_block_put(&o, rec, n * 4u);
+        }
+    }
+    if (o.st == ASX_OK && o.len != 0) o.st = writer(ctx, scratch, o.len);
+    if (o.st == ASX_OK && out_len != NULL) *out_len = o.total;
+    return o.st;
+}
 
-    if (magic != ASX_TRACE_BINARY_MAGIC) return ASX_E_INVALID_ARGUMENT;
-    if (version != ASX_TRACE_BINARY_VERSION) return ASX_E_INVALID_ARGUMENT;
-    if (count > ASX_TRACE_CAPACITY) return ASX_E_INVALID_ARGUMENT;
+/* Compact (v2) encoding: unsigned LEB128 varints, zigzag-mapped
+ * deltas against the previous event of the same kind (0 at the start
+ * of each buffer). With p == NULL only the length is computed. */
+#define TRACE_KIND_SLOTS  256u
+#define TRACE_VARINT_MAX  10u
 
-    needed = ASX_TRACE_BINARY_HEADER + count * ASX_TRACE_BINARY_EVENT;
-    if (len < needed) return ASX_E_INVALID_ARGUMENT;
+static uint32_t put_varint(uint8_t *p, uint64_t v)
+{
+    uint32_t n = 0;
 
-    /* Decode events */
-    p = buf + ASX_TRACE_BINARY_HEADER;
-    for (i = 0; i < count; i++) {
-        events[i].sequence  = read_le32(p + 0);
-        events[i].kind      = (asx_trace_event_kind)read_le32(p + 4);
-        events[i].entity_id = read_le64(p + 8);
-        events[i].aux       = read_le64(p + 16);
-        p += ASX_TRACE_BINARY_EVENT;
+    while (v >= 0x80u) {
+        if (p != NULL) p[n] = (uint8_t)((v & 0x7Fu) | 0x80u);
+        v >>= 7;
+        n++;
     }
+    if (p != NULL) p[n] = (uint8_t)v;
+    return n + 1u;
+}
 
-    /* Verify digest of decoded events matches stored digest */
-    hash = 0x517cc1b727220a95ULL;
-    for (i = 0; i < count; i++) {
-        uint32_t k = (uint32_t)events[i].kind;
-        hash = fnv1a_mix(hash, &events[i].sequence, sizeof(events[i].sequence));
-        hash = fnv1a_mix(hash, &k, sizeof(k));
-        hash = fnv1a_mix(hash, &events[i].entity_id, sizeof(events[i].entity_id));
-        hash = fnv1a_mix(hash, &events[i].aux, sizeof(events[i].aux));
+/* Read one varint from [*p, end); returns 0 on truncation or overlong. */
+static int get_varint(const uint8_t **p, const uint8_t *end, uint64_t *out)
+{
+    uint64_t v = 0;
+    uint32_t shift = 0;
+    uint32_t n;
+
+    for (n = 0; n < TRACE_VARINT_MAX && *p < end; n++) {
+        uint8_t b = *(*p)++;
+        v |= (uint64_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            *out = v;
+            return 1;
+        }
+        shift += 7u;
     }
-    computed_digest = hash;
+    return 0;
+}
+
+static uint64_t zigzag_delta(uint64_t prev, uint64_t cur)
+{
+    uint64_t d = cur - prev;
+    return (d << 1) ^ (0u - (d >> 63));
+}
+
+static uint64_t zigzag_apply(uint64_t prev, uint64_t zz)
+{
+    return prev + ((zz >> 1) ^ (0u - (zz & 1u)));
+}
+
+/* Encode the ring's first count events as v2 after a v2 header.
+ * Returns the total length, or 0 if a kind does not fit in a byte. */
+static uint32_t trace_encode_compact(uint8_t *buf, uint32_t count,
+                                     uint32_t chunk, uint64_t digest)
+{
+    uint64_t prev_entity[TRACE_KIND_SLOTS];
+    uint64_t prev_aux[TRACE_KIND_SLOTS];
+    uint32_t flags = trace_flags();
+    uint32_t len = ASX_TRACE_BINARY_HEADER;
+    uint32_t i;
+
+    memset(prev_entity, 0, sizeof(prev_entity));
+    memset(prev_aux, 0, sizeof(prev_aux));
+
+    if (buf != NULL) {
+        write_le32(buf + 0, ASX_TRACE_BINARY_MAGIC);
+        write_le32(buf + 4, ASX_TRACE_BINARY_VERSION_COMPACT | flags);
+        write_le32(buf + 8, count);
+        write_le32(buf + 12, chunk);
+        write_le64(buf + 16, digest);
+    }
+
+    /* Sequences are consecutive: only the first one is stored */
+    if (count > 0) {
+        len += put_varint(buf != NULL ? buf + len : NULL,
+                          g_trace_ring[0].sequence);
+    }
+
+    for (i = 0; i < count; i++) {
+        const asx_trace_event *e = &g_trace_ring[i];
+        uint32_t k = (uint32_t)e->kind;
+
+        if (k >= TRACE_KIND_SLOTS) return 0;
+        if (buf != NULL) buf[len] = (uint8_t)k;
+        len++;
+        len += put_varint(buf != NULL ? buf + len : NULL,
+                          zigzag_delta(prev_entity[k], e->entity_id));
+        len += put_varint(buf != NULL ? buf + len : NULL,
+                          zigzag_delta(prev_aux[k], e->aux));
+        prev_entity[k] = e->entity_id;
+        prev_aux[k] = e->aux;
+    }
+    if (flags & ASX_TRACE_BINARY_FLAG_TIMES) {
+        for (i = 0; i < count; i++) {
+            len += put_varint(buf != NULL ? buf + len : NULL, g_trace_delta[i]);
+        }
+    }
+    return len;
+}
+
+asx_status asx_trace_export_compact(uint8_t *buf,
+                                     uint32_t capacity,
+                                     uint32_t *out_len)
+{
+    uint32_t count;
+    uint32_t needed;
+
+    if (buf == NULL || out_len == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    count = trace_stored();
+    needed = trace_encode_compact(NULL, count, 0, 0);
+    if (needed == 0) return ASX_E_INVALID_ARGUMENT;
+    if (capacity < needed) {
+        *out_len = needed;
+        return ASX_E_BUFFER_TOO_SMALL;
+    }
+
+    (void)trace_encode_compact(buf, count, g_trace_chunks, trace_stored_digest());
+    *out_len = needed;
+    return ASX_OK;
+}
+
+static asx_status trace_decode_compact(const uint8_t *buf, uint32_t len,
+                                       uint32_t count,
+                                       asx_trace_event *events)
+{
+    uint64_t prev_entity[TRACE_KIND_SLOTS];
+    uint64_t prev_aux[TRACE_KIND_SLOTS];
+    const uint8_t *p = buf + ASX_TRACE_BINARY_HEADER;
+    const uint8_t *end = buf + len;
+    uint64_t seq;
+    uint64_t v;
+    uint32_t i;
+
+    memset(prev_entity, 0, sizeof(prev_entity));
+    memset(prev_aux, 0, sizeof(prev_aux));
+
+    if (count == 0) return ASX_OK;
+    if (!get_varint(&p, end, &seq)) return ASX_E_INVALID_ARGUMENT;
+    if (seq > 0xFFFFFFFFu) return ASX_E_INVALID_ARGUMENT;
+
+    for (i = 0; i < count; i++) {
+        uint32_t k;
+
+        if (p >= end) return ASX_E_INVALID_ARGUMENT;
+        k = *p++;
+        events[i].sequence = (uint32_t)(seq + i);
+        events[i].kind = (asx_trace_event_kind)k;
+
+        if (!get_varint(&p, end, &v)) return ASX_E_INVALID_ARGUMENT;
+        prev_entity[k] = zigzag_apply(prev_entity[k], v);
+        if (!get_varint(&p, end, &v)) return ASX_E_INVALID_ARGUMENT;
+        prev_aux[k] = zigzag_apply(prev_aux[k], v);
+
+        events[i].entity_id = prev_entity[k];
+        events[i].aux = prev_aux[k];
+    }
+    return ASX_OK;
+}
+
+/* Decode a v1 or v2 buffer into events; yields event count, the
+ * header digest and the digest mode it was written under. */
+static asx_status trace_decode(const uint8_t *buf, uint32_t len,
+                               asx_trace_event *events,
+                               uint32_t *out_count,
+                               uint64_t *out_digest,
+                               asx_digest_mode *out_mode)
+{
+    uint32_t version;
+    uint32_t flags;
+    uint32_t count;
+    uint32_t i;
+    const uint8_t *p;
+
+    if (buf == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (len < ASX_TRACE_BINARY_HEADER) return ASX_E_INVALID_ARGUMENT;
+
+    version = read_le32(buf + 4);
+    flags = version & ~ASX_TRACE_BINARY_VERSION_MASK;
+    version &= ASX_TRACE_BINARY_VERSION_MASK;
+    count = read_le32(buf + 8);
+    if (read_le32(buf + 0) != ASX_TRACE_BINARY_MAGIC) return ASX_E_INVALID_ARGUMENT;
+    if (flags & ~TRACE_KNOWN_FLAGS) return ASX_E_INVALID_ARGUMENT;
+    if (count > ASX_TRACE_CAPACITY) return ASX_E_INVALID_ARGUMENT;
+
+    /* The time column follows the events and is not needed here */
+    if (version == ASX_TRACE_BINARY_VERSION_COMPACT) {
+        asx_status st = trace_decode_compact(buf, len, count, events);
+        if (st != ASX_OK) return st;
+    } else if (version == ASX_TRACE_BINARY_VERSION) {
+        if (len < trace_v1_len(count, flags)) return ASX_E_INVALID_ARGUMENT;
+        p = buf + ASX_TRACE_BINARY_HEADER;
+        for (i = 0; i < count; i++) {
+            events[i].sequence  = read_le32(p + 0);
+            events[i].kind      = (asx_trace_event_kind)read_le32(p + 4);
+            events[i].entity_id = read_le64(p + 8);
+            events[i].aux       = read_le64(p + 16);
+            p += ASX_TRACE_BINARY_EVENT;
+        }
+    } else {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    *out_count = count;
+    *out_digest = read_le64(buf + 16);
+    *out_mode = trace_flags_mode(flags);
+    return ASX_OK;
+}
 
-    if (computed_digest != stored_digest) return ASX_E_INVALID_ARGUMENT;
+asx_status asx_trace_import_binary(const uint8_t *buf, uint32_t len)
+{
+    uint32_t count;
+    uint64_t stored_digest;
+    asx_digest_mode mode;
+    asx_status st;
+    asx_trace_event events[ASX_TRACE_CAPACITY];
+
+    st = trace_decode(buf, len, events, &count, &stored_digest, &mode);
+    if (st != ASX_OK) return st;
+
+    /* Verify digest of decoded events matches stored digest */
+    if (trace_digest_events(mode, TRACE_DIGEST_BASIS, events, count)
+            != stored_digest) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
 
     /* Load as replay reference for continuity verification.
      * The trace ring is NOT overwritten — callers that need to
@@ -538,39 +1507,13 @@ asx_status asx_trace_continuity_check(const uint8_t *buf, uint32_t len)
     asx_status st;
     asx_replay_result result;
 
-    /* Save current trace state — import_binary overwrites g_trace_ring
-     * and g_trace_count, but we need the *current* trace for comparison. */
-    asx_trace_event saved_ring[ASX_TRACE_CAPACITY];
-    uint32_t saved_count = g_trace_count;
-    uint32_t copy_count = saved_count < ASX_TRACE_CAPACITY
-                          ? saved_count : ASX_TRACE_CAPACITY;
-
-    if (copy_count > 0) {
-        memcpy(saved_ring, g_trace_ring,
-               copy_count * sizeof(asx_trace_event));
-    }
-
-    /* Import binary loads events as replay reference AND into g_trace_ring.
-     * After import, g_trace_ring/count contain the reference data. */
+    /* Import loads the events as the replay reference only; the live
+     * trace ring (and its running digest) is left untouched. */
     st = asx_trace_import_binary(buf, len);
     if (st != ASX_OK) {
-        /* Restore trace state on failure */
-        if (copy_count > 0) {
-            memcpy(g_trace_ring, saved_ring,
-                   copy_count * sizeof(asx_trace_event));
-        }
-        g_trace_count = saved_count;
         return st;
     }
 
-    /* Restore the current trace so replay_verify compares the live
-     * trace against the imported reference. */
-    if (copy_count > 0) {
-        memcpy(g_trace_ring, saved_ring,
-               copy_count * sizeof(asx_trace_event));
-    }
-    g_trace_count = saved_count;
-
     result = asx_replay_verify();
 
     /* Clean up reference */
@@ -582,3 +1525,689 @@ asx_status asx_trace_continuity_check(const uint8_t *buf, uint32_t len)
 
     return ASX_OK;
 }
+
+/* -------------------------------------------------------------------
+ * Mapped replay reference
+ * ------------------------------------------------------------------- */
+
+static uint32_t g_map_len;
+static uint32_t g_map_events;       /* events in the whole reference */
+static uint64_t g_map_digest;       /* digest after the last chunk */
+static uint32_t g_map_next;         /* offset of the next record */
+static uint32_t g_map_chunk_left;   /* records left in the current chunk */
+static uint32_t g_map_chunk_tail;   /* time column after the current chunk */
+static uint32_t g_map_seen;         /* live events compared */
+static uint64_t g_map_hash;         /* digest of the live events */
+static asx_digest_mode g_map_mode;  /* digest mode of the reference */
+static asx_replay_result_kind g_map_result;
+static uint32_t g_map_divergence;
+
+/* Worker staging buffers stay out: they are empty between batches */
+static const uint64_t g_digest_hash_init = TRACE_DIGEST_BASIS;
+static const asx_context_block g_trace_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_trace_ring),
+    ASX_CONTEXT_BLOCK(g_trace_count),
+    ASX_CONTEXT_BLOCK(g_trace_base),
+    ASX_CONTEXT_BLOCK(g_trace_kind_off),
+    ASX_CONTEXT_BLOCK(g_trace_kinds_off),
+    ASX_CONTEXT_BLOCK(g_trace_filtered),
+    ASX_CONTEXT_BLOCK(g_window_len),
+    ASX_CONTEXT_BLOCK(g_window_left),
+    ASX_CONTEXT_BLOCK(g_window_count),
+    ASX_CONTEXT_BLOCK(g_window_first),
+    ASX_CONTEXT_BLOCK(g_window_digest),
+    ASX_CONTEXT_BLOCK_INIT(g_digest_hash, g_digest_hash_init),
+    ASX_CONTEXT_BLOCK(g_trace_digest_mode),
+    ASX_CONTEXT_BLOCK(g_digest_count),
+    ASX_CONTEXT_BLOCK_INIT(g_trace_stored_chain, g_digest_hash_init),
+    ASX_CONTEXT_BLOCK(g_trace_sink),
+    ASX_CONTEXT_BLOCK(g_trace_sink_ctx),
+    ASX_CONTEXT_BLOCK(g_trace_chunks),
+    ASX_CONTEXT_BLOCK(g_trace_delta),
+    ASX_CONTEXT_BLOCK(g_trace_times_on),
+    ASX_CONTEXT_BLOCK(g_trace_last_valid),
+    ASX_CONTEXT_BLOCK(g_trace_last_ns),
+    ASX_CONTEXT_BLOCK(g_rounds),
+    ASX_CONTEXT_BLOCK(g_round_polls),
+    ASX_CONTEXT_BLOCK(g_round_count),
+    ASX_CONTEXT_BLOCK(g_trace_elided),
+    ASX_CONTEXT_BLOCK(g_trace_round_on),
+    ASX_CONTEXT_BLOCK(g_hist_buf),
+    ASX_CONTEXT_BLOCK(g_hist_segs),
+    ASX_CONTEXT_BLOCK(g_hist_head),
+    ASX_CONTEXT_BLOCK(g_hist_live),
+    ASX_CONTEXT_BLOCK(g_hist_used),
+    ASX_CONTEXT_BLOCK(g_hist_events),
+    ASX_CONTEXT_BLOCK(g_hist_entity),
+    ASX_CONTEXT_BLOCK(g_hist_aux),
+    ASX_CONTEXT_BLOCK(g_replay_ref),
+    ASX_CONTEXT_BLOCK(g_replay_ref_count),
+    ASX_CONTEXT_BLOCK(g_replay_ref_digest),
+    ASX_CONTEXT_BLOCK(g_replay_loaded),
+    ASX_CONTEXT_BLOCK(g_replay_verified),
+    ASX_CONTEXT_BLOCK_INIT(g_replay_verified_digest, g_digest_hash_init),
+    ASX_CONTEXT_BLOCK(g_map_data),
+    ASX_CONTEXT_BLOCK(g_map_len),
+    ASX_CONTEXT_BLOCK(g_map_events),
+    ASX_CONTEXT_BLOCK(g_map_digest),
+    ASX_CONTEXT_BLOCK(g_map_next),
+    ASX_CONTEXT_BLOCK(g_map_chunk_left),
+    ASX_CONTEXT_BLOCK(g_map_chunk_tail),
+    ASX_CONTEXT_BLOCK(g_map_seen),
+    ASX_CONTEXT_BLOCK(g_map_hash),
+    ASX_CONTEXT_BLOCK(g_map_mode),
+    ASX_CONTEXT_BLOCK(g_map_result),
+    ASX_CONTEXT_BLOCK(g_map_divergence)
+};
+
+const asx_context_module asx_trace_context = ASX_CONTEXT_MODULE(g_trace_blocks);
+
+static void replay_map_rewind(void)
+{
+    g_map_next = 0;
+    g_map_chunk_left = 0;
+    g_map_chunk_tail = 0;
+    g_map_seen = 0;
+    g_map_hash = TRACE_DIGEST_BASIS;
+    g_map_result = ASX_REPLAY_MATCH;
+    g_map_divergence = 0;
+}
+
+/* Compare one live event against the next reference record in place.
+ * The first divergence is latched; later events only extend the
+ * digest and the count. */
+static void replay_map_check(const asx_trace_event *e)
+{
+    const uint8_t *p;
+
+    g_map_hash = trace_digest_event(g_map_mode, g_map_hash, e);
+    if (g_map_result == ASX_REPLAY_MATCH) {
+        while (g_map_chunk_left == 0) {
+            g_map_next += g_map_chunk_tail;
+            if (g_map_next >= g_map_len) {
+                g_map_chunk_tail = 0;
+                break;
+            }
+            p = g_map_data + g_map_next;
+            g_map_chunk_left = read_le32(p + 8);
+            g_map_chunk_tail = trace_v1_len(g_map_chunk_left, read_le32(p + 4))
+                             - ASX_TRACE_BINARY_HEADER
+                             - g_map_chunk_left * ASX_TRACE_BINARY_EVENT;
+            g_map_next += ASX_TRACE_BINARY_HEADER;
+        }
+        if (g_map_chunk_left == 0) {
+            g_map_result = ASX_REPLAY_LENGTH_MISMATCH;
+            g_map_divergence = g_map_seen;
+        } else {
+            p = g_map_data + g_map_next;
+            if (read_le32(p + 4) != (uint32_t)e->kind) {
+                g_map_result = ASX_REPLAY_KIND_MISMATCH;
+            } else if (read_le64(p + 8) != e->entity_id) {
+                g_map_result = ASX_REPLAY_ENTITY_MISMATCH;
+            } else if (read_le64(p + 16) != e->aux) {
+                g_map_result = ASX_REPLAY_AUX_MISMATCH;
+            }
+            g_map_divergence = g_map_seen;
+            g_map_next += ASX_TRACE_BINARY_EVENT;
+            g_map_chunk_left--;
+        }
+    }
+    g_map_seen++;
+}
+
+static asx_replay_result replay_map_verify(void)
+{
+    asx_replay_result result;
+
+    memset(&result, 0, sizeof(result));
+    result.result = g_map_result;
+    result.divergence_index = g_map_divergence;
+    if (result.result != ASX_REPLAY_MATCH) return result;
+
+    if (g_map_seen != g_map_events) {
+        result.result = ASX_REPLAY_LENGTH_MISMATCH;
+        result.divergence_index = g_map_seen;
+        return result;
+    }
+
+    result.expected_digest = g_map_digest;
+    result.actual_digest = g_map_hash;
+    if (g_map_hash != g_map_digest) {
+        result.result = ASX_REPLAY_DIGEST_MISMATCH;
+    }
+    return result;
+}
+
+asx_status asx_replay_map_reference(const uint8_t *buf, uint32_t len)
+{
+    uint64_t hash = TRACE_DIGEST_BASIS;
+    uint32_t events = 0;
+    uint32_t off = 0;
+    asx_digest_mode mode = ASX_DIGEST_FNV1A;
+
+    if (buf == NULL || len == 0) return ASX_E_INVALID_ARGUMENT;
+
+    /* One pass over the chunk chain: headers, lengths and digests */
+    while (off < len) {
+        uint32_t count;
+        uint32_t flags;
+        uint32_t i;
+        const uint8_t *p;
+
+        if (len - off < ASX_TRACE_BINARY_HEADER) return ASX_E_INVALID_ARGUMENT;
+        p = buf + off;
+        count = read_le32(p + 8);
+        flags = read_le32(p + 4) & ~ASX_TRACE_BINARY_VERSION_MASK;
+        if (read_le32(p + 0) != ASX_TRACE_BINARY_MAGIC) return ASX_E_INVALID_ARGUMENT;
+        if ((read_le32(p + 4) & ASX_TRACE_BINARY_VERSION_MASK) !=
+                ASX_TRACE_BINARY_VERSION ||
+            (flags & ~TRACE_KNOWN_FLAGS) != 0) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        /* One chain, one digest mode */
+        if (off == 0) {
+            mode = trace_flags_mode(flags);
+        } else if (trace_flags_mode(flags) != mode) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        if (count > ASX_TRACE_CAPACITY) return ASX_E_INVALID_ARGUMENT;
+        if (len - off < trace_v1_len(count, flags)) return ASX_E_INVALID_ARGUMENT;
+        if (count > UINT32_MAX - events) return ASX_E_INVALID_ARGUMENT;
+
+        for (i = 0; i < count; i++) {
+            const uint8_t *q = p + ASX_TRACE_BINARY_HEADER +
+                               i * ASX_TRACE_BINARY_EVENT;
+            asx_trace_event e;
+            e.sequence  = read_le32(q + 0);
+            e.kind      = (asx_trace_event_kind)read_le32(q + 4);
+            e.entity_id = read_le64(q + 8);
+            e.aux       = read_le64(q + 16);
+            hash = trace_digest_event(mode, hash, &e);
+        }
+        if (hash != read_le64(p + 16)) return ASX_E_INVALID_ARGUMENT;
+
+        events += count;
+        off += trace_v1_len(count, flags);
+    }
+
+    asx_replay_clear_reference();
+    g_map_data = buf;
+    g_map_len = len;
+    g_map_events = events;
+    g_map_digest = hash;
+    g_map_mode = mode;
+    replay_map_rewind();
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Streaming sink
+ * ------------------------------------------------------------------- */
+
+/* Staging buffer for one encoded chunk */
+static uint8_t g_trace_chunk_buf[ASX_TRACE_BINARY_HEADER +
+                                 ASX_TRACE_CAPACITY *
+                                 (ASX_TRACE_BINARY_EVENT + 4u)];
+
+/* Hand the ring to the sink and start it over. The digest is brought
+ * up to date first, so it carries on from the last event flushed. A
+ * sink error drops the chunk; sequencing and the digest still run on. */
+static void trace_flush_chunk(void)
+{
+    uint32_t count = trace_stored();
+    uint64_t digest;
+
+    (void)asx_trace_digest();
+    digest = trace_stored_digest();
+    if (count == 0) return;
+
+    trace_encode(g_trace_chunk_buf, count, g_trace_chunks, digest);
+    (void)g_trace_sink(g_trace_sink_ctx, g_trace_chunk_buf,
+                       trace_v1_len(count, trace_flags()));
+    g_trace_chunks++;
+    g_trace_base = g_trace_count - g_trace_filtered;
+    g_trace_stored_chain = digest;
+    g_digest_count = 0;
+    replay_watermark_reset();
+}
+
+void asx_trace_set_sink(asx_trace_sink_fn sink, void *ctx)
+{
+    g_trace_sink = sink;
+    g_trace_sink_ctx = sink != NULL ? ctx : NULL;
+}
+
+asx_status asx_trace_flush(void)
+{
+    if (g_trace_sink == NULL) return ASX_E_INVALID_STATE;
+    trace_flush_chunk();
+    return ASX_OK;
+}
+
+uint32_t asx_trace_chunk_count(void)
+{
+    return g_trace_chunks;
+}
+
+asx_status asx_trace_chunk_verify(const uint8_t *buf, uint32_t len,
+                                  uint64_t prev_digest,
+                                  uint64_t *out_digest)
+{
+    uint32_t count;
+    uint64_t stored_digest;
+    asx_digest_mode mode;
+    asx_status st;
+    asx_trace_event events[ASX_TRACE_CAPACITY];
+
+    if (out_digest == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = trace_decode(buf, len, events, &count, &stored_digest, &mode);
+    if (st != ASX_OK) return st;
+
+    if (trace_digest_events(mode, prev_digest, events, count) != stored_digest) {
+        return ASX_E_REPLAY_MISMATCH;
+    }
+
+    *out_digest = stored_digest;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Compressed history ring
+ *
+ * A segment starts with its first sequence (LE32) and a word packing
+ * its event count (low 16 bits) and bytes used (high 16), then records
+ * of a kind byte and the zigzag varint deltas of entity and aux from
+ * the last event of the same kind group in that segment. Opening a
+ * segment zeroes the group state, so the oldest one can be dropped and
+ * the rest still decode.
+ * ------------------------------------------------------------------- */
+
+#define TRACE_HIST_SEG_HEADER 8u
+#define TRACE_HIST_RECORD_MAX (1u + 2u * TRACE_VARINT_MAX)
+
+#if ASX_TRACE_HISTORY_SEGMENT > 0xFFFFu || \
+    ASX_TRACE_HISTORY_SEGMENT < TRACE_HIST_SEG_HEADER + TRACE_HIST_RECORD_MAX
+#error "ASX_TRACE_HISTORY_SEGMENT must hold one record and fit in 16 bits"
+#endif
+
+static uint8_t *trace_history_seg(uint32_t nth)
+{
+    return g_hist_buf +
+           ((g_hist_head + nth) % g_hist_segs) * ASX_TRACE_HISTORY_SEGMENT;
+}
+
+/* Encode e against the open segment's group state into rec. */
+static uint32_t trace_history_record(uint8_t *rec, const asx_trace_event *e)
+{
+    uint32_t g = ((uint32_t)e->kind >> 4) & (TRACE_HIST_GROUPS - 1u);
+    uint32_t n = 1;
+
+    rec[0] = (uint8_t)e->kind;
+    n += put_varint(rec + n, zigzag_delta(g_hist_entity[g], e->entity_id));
+    n += put_varint(rec + n, zigzag_delta(g_hist_aux[g], e->aux));
+    return n;
+}
+
+static void trace_history_append(const asx_trace_event *e)
+{
+    uint8_t rec[TRACE_HIST_RECORD_MAX];
+    uint32_t g = ((uint32_t)e->kind >> 4) & (TRACE_HIST_GROUPS - 1u);
+    uint32_t n;
+    uint8_t *seg;
+
+    if ((uint32_t)e->kind > 0xFFu) return;
+    n = trace_history_record(rec, e);
+    if (g_hist_live == 0 || g_hist_used + n > ASX_TRACE_HISTORY_SEGMENT) {
+        /* Open the next segment, dropping the oldest when all are live */
+        if (g_hist_live == g_hist_segs) {
+            g_hist_head = (g_hist_head + 1u) % g_hist_segs;
+            g_hist_live--;
+        }
+        g_hist_live++;
+        g_hist_used = TRACE_HIST_SEG_HEADER;
+        g_hist_events = 0;
+        memset(g_hist_entity, 0, sizeof(g_hist_entity));
+        memset(g_hist_aux, 0, sizeof(g_hist_aux));
+        write_le32(trace_history_seg(g_hist_live - 1u), e->sequence);
+        n = trace_history_record(rec, e);
+    }
+    seg = trace_history_seg(g_hist_live - 1u);
+    memcpy(seg + g_hist_used, rec, n);
+    g_hist_used += n;
+    g_hist_events++;
+    g_hist_entity[g] = e->entity_id;
+    g_hist_aux[g] = e->aux;
+    write_le32(seg + 4, g_hist_events | g_hist_used << 16);
+}
+
+/* Decode the next record of a segment into e, advancing *p. */
+static void trace_history_next(const uint8_t **p, const uint8_t *end,
+                               uint64_t *entity, uint64_t *aux,
+                               asx_trace_event *e)
+{
+    uint32_t g;
+    uint64_t v = 0;
+
+    e->kind = (asx_trace_event_kind)*(*p)++;
+    g = ((uint32_t)e->kind >> 4) & (TRACE_HIST_GROUPS - 1u);
+    (void)get_varint(p, end, &v);
+    entity[g] = zigzag_apply(entity[g], v);
+    (void)get_varint(p, end, &v);
+    aux[g] = zigzag_apply(aux[g], v);
+    e->entity_id = entity[g];
+    e->aux = aux[g];
+}
+
+/* Fold segment seg's events into digest, or with o non-NULL write them
+ * as v1 records; returns the digest. */
+static uint64_t trace_history_walk(const uint8_t *seg, uint64_t digest,
+                                   trace_block_out *o)
+{
+    uint64_t entity[TRACE_HIST_GROUPS];
+    uint64_t aux[TRACE_HIST_GROUPS];
+    uint32_t word = read_le32(seg + 4);
+    const uint8_t *p = seg + TRACE_HIST_SEG_HEADER;
+    const uint8_t *end = seg + (word >> 16);
+    uint8_t rec[ASX_TRACE_BINARY_EVENT];
+    asx_trace_event e;
+    uint32_t i;
+
+    memset(entity, 0, sizeof(entity));
+    memset(aux, 0, sizeof(aux));
+    e.sequence = read_le32(seg);
+    for (i = 0; i < (word & 0xFFFFu); i++) {
+        trace_history_next(&p, end, entity, aux, &e);
+        if (o != NULL) {
+            trace_encode_event(rec, &e);
+            trace_block_put(o, rec, ASX_TRACE_BINARY_EVENT);
+        } else {
+            digest = trace_digest_event(g_trace_digest_mode, digest, &e);
+        }
+        e.sequence++;
+    }
+    return digest;
+}
+
+asx_status asx_trace_history_attach(uint8_t *storage, uint32_t len)
+{
+    if (storage == NULL && len > 0) return ASX_E_INVALID_ARGUMENT;
+    if (storage != NULL && len < 2u * ASX_TRACE_HISTORY_SEGMENT) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    g_hist_buf = storage;
+    g_hist_segs = len / ASX_TRACE_HISTORY_SEGMENT;
+    g_hist_head = 0;
+    g_hist_live = 0;
+    return ASX_OK;
+}
+
+uint32_t asx_trace_history_count(void)
+{
+    uint32_t total = 0;
+    uint32_t i;
+
+    if (g_hist_buf == NULL) return 0;
+    for (i = 0; i < g_hist_live; i++) {
+        total += read_le32(trace_history_seg(i) + 4) & 0xFFFFu;
+    }
+    return total;
+}
+
+asx_status asx_trace_history_export(asx_trace_sink_fn writer,
+                                    void *ctx,
+                                    uint8_t *scratch,
+                                    uint32_t block_len,
+                                    uint32_t *out_len)
+{
+    trace_block_out o;
+    uint8_t hdr[ASX_TRACE_BINARY_HEADER];
+    uint32_t flags = trace_flags() & ~ASX_TRACE_BINARY_FLAG_TIMES;
+    uint64_t digest = TRACE_DIGEST_BASIS;
+    uint32_t i;
+
+    if (writer == NULL || scratch == NULL || block_len == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (g_hist_buf == NULL) return ASX_E_INVALID_STATE;
+
+    o.writer = writer;
+    o.ctx = ctx;
+    o.block = scratch;
+    o.cap = block_len;
+    o.len = 0;
+    o.total = 0;
+    o.st = ASX_OK;
+
+    /* One v1 chunk per segment, chaining the digest; each segment is
+     * walked twice, since its header carries the digest after it */
+    for (i = 0; i < g_hist_live && o.st == ASX_OK; i++) {
+        const uint8_t *seg = trace_history_seg(i);
+
+        digest = trace_history_walk(seg, digest, NULL);
+        write_le32(hdr + 0, ASX_TRACE_BINARY_MAGIC);
+        write_le32(hdr + 4, ASX_TRACE_BINARY_VERSION | flags);
+        write_le32(hdr + 8, read_le32(seg + 4) & 0xFFFFu);
+        write_le32(hdr + 12, i);
+        write_le64(hdr + 16, digest);
+        trace_block_put(&o, hdr, ASX_TRACE_BINARY_HEADER);
+        (void)trace_history_walk(seg, digest, &o);
+    }
+    if (o.st == ASX_OK && o.len != 0) o.st = writer(ctx, scratch, o.len);
+    if (o.st == ASX_OK && out_len != NULL) *out_len = o.total;
+    return o.st;
+}
+
+/* -------------------------------------------------------------------
+ * JSON export
+ * ------------------------------------------------------------------- */
+
+/* Upper bound on one formatted event, separator included */
+#define TRACE_JSON_EVENT_MAX 160u
+
+static size_t trace_json_lit(char *p, const char *lit)
+{
+    size_t n = strlen(lit);
+    memcpy(p, lit, n);
+    return n;
+}
+
+/* Format stored event i at p; returns the bytes written. */
+static size_t trace_json_event(char *p, uint32_t i, int times)
+{
+    const asx_trace_event *e = &g_trace_ring[i];
+    size_t n = 0;
+
+    if (i > 0) p[n++] = ',';
+    n += trace_json_lit(p + n, "{\"sequence\":");
+    n += asx_codec_format_u64(p + n, e->sequence);
+    n += trace_json_lit(p + n, ",\"kind\":\"");
+    n += trace_json_lit(p + n, asx_trace_event_kind_str(e->kind));
+    n += trace_json_lit(p + n, "\",\"entity_id\":");
+    n += asx_codec_format_u64(p + n, e->entity_id);
+    n += trace_json_lit(p + n, ",\"aux\":");
+    n += asx_codec_format_u64(p + n, e->aux);
+    if (times) {
+        n += trace_json_lit(p + n, ",\"delta_ns\":");
+        n += asx_codec_format_u64(p + n, g_trace_delta[i]);
+    }
+    p[n++] = '}';
+    return n;
+}
+
+asx_status asx_trace_export_json(asx_codec_buffer *out)
+{
+    uint32_t count = trace_stored();
+    uint32_t i;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    /* One reserve for the whole array, then unchecked writes */
+    out->len = 0;
+    st = asx_codec_buffer_reserve(out, 2u + (size_t)count * TRACE_JSON_EVENT_MAX);
+    if (st != ASX_OK) return st;
+
+    out->data[out->len++] = '[';
+    for (i = 0; i < count; i++) {
+        out->len += trace_json_event(out->data + out->len, i, g_trace_times_on);
+    }
+    out->data[out->len++] = ']';
+    out->data[out->len] = '\0';
+    return ASX_OK;
+}
+
+asx_status asx_trace_export_json_sink(asx_trace_sink_fn sink, void *ctx)
+{
+    char *buf = (char *)g_trace_chunk_buf;
+    uint32_t count = trace_stored();
+    uint32_t len = 0;
+    uint32_t i;
+    asx_status st;
+
+    if (sink == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    /* The binary chunk staging buffer is idle outside trace_flush_chunk */
+    buf[len++] = '[';
+    for (i = 0; i < count; i++) {
+        if (sizeof(g_trace_chunk_buf) - len < TRACE_JSON_EVENT_MAX + 1u) {
+            st = sink(ctx, g_trace_chunk_buf, len);
+            if (st != ASX_OK) return st;
+            len = 0;
+        }
+        len += (uint32_t)trace_json_event(buf + len, i, g_trace_times_on);
+    }
+    buf[len++] = ']';
+    return sink(ctx, g_trace_chunk_buf, len);
+}
+
+/* -------------------------------------------------------------------
+ * Per-worker staging
+ * ------------------------------------------------------------------- */
+
+#if ASX_DETERMINISTIC
+#define ASX_TRACE_STAGING 0         /* batches poll on the calling thread */
+#elif defined(__GNUC__) || defined(__clang__)
+#define ASX_TRACE_STAGING 1
+#define ASX_TRACE_TLS __thread
+#elif defined(_MSC_VER)
+#define ASX_TRACE_STAGING 1
+#define ASX_TRACE_TLS __declspec(thread)
+#else
+#define ASX_TRACE_STAGING 0
+#endif
+
+#ifndef ASX_TRACE_WORKER_CAPACITY
+#define ASX_TRACE_WORKER_CAPACITY 32u
+#endif
+
+typedef struct {
+    asx_trace_event_kind kind;
+    uint32_t             round;
+    uint32_t             slot;     /* arena index of the polled task */
+    uint8_t              lane;
+    uint64_t             entity_id;
+    uint64_t             aux;
+} trace_staged;
+
+typedef struct {
+    trace_staged events[ASX_TRACE_WORKER_CAPACITY];
+    uint32_t     count;
+    uint32_t     round;            /* stamp for the poll in progress */
+    uint32_t     slot;
+    uint8_t      lane;
+} trace_worker;
+
+static trace_worker g_trace_workers[ASX_MAX_WORKERS];
+
+#if ASX_TRACE_STAGING
+/* The entered worker's buffer, NULL outside a batch poll */
+static ASX_TRACE_TLS trace_worker *t_trace_worker;
+#endif
+
+/* Past capacity a worker's events are dropped, as past the ring's. */
+static int trace_stage_append(asx_trace_event_kind kind,
+                              uint64_t entity_id, uint64_t aux)
+{
+#if ASX_TRACE_STAGING
+    trace_worker *w = t_trace_worker;
+    trace_staged *e;
+
+    if (w == NULL) return 0;
+    if (w->count < ASX_TRACE_WORKER_CAPACITY) {
+        e = &w->events[w->count++];
+        e->kind = kind;
+        e->round = w->round;
+        e->slot = w->slot;
+        e->lane = w->lane;
+        e->entity_id = entity_id;
+        e->aux = aux;
+    }
+    return 1;
+#else
+    (void)kind;
+    (void)entity_id;
+    (void)aux;
+    return 0;
+#endif
+}
+
+void asx_trace_stage_reset(uint32_t workers)
+{
+    uint32_t i;
+
+    if (workers > ASX_MAX_WORKERS) workers = ASX_MAX_WORKERS;
+    for (i = 0; i < workers; i++) {
+        g_trace_workers[i].count = 0;
+    }
+}
+
+void asx_trace_stage_enter(uint32_t worker, uint32_t round,
+                           uint32_t lane, uint32_t slot)
+{
+    trace_worker *w = &g_trace_workers[worker];
+
+    w->round = round;
+    w->lane = (uint8_t)lane;
+    w->slot = slot;
+#if ASX_TRACE_STAGING
+    t_trace_worker = w;
+#endif
+}
+
+void asx_trace_stage_leave(void)
+{
+#if ASX_TRACE_STAGING
+    t_trace_worker = NULL;
+#endif
+}
+
+uint32_t asx_trace_stage_worker(void)
+{
+#if ASX_TRACE_STAGING
+    if (t_trace_worker != NULL) {
+        return (uint32_t)(t_trace_worker - g_trace_workers);
+    }
+#endif
+    return UINT32_MAX;
+}
+
+uint32_t asx_trace_stage_mark(uint32_t worker)
+{
+    return g_trace_workers[worker].count;
+}
+
+void asx_trace_stage_merge(uint32_t worker, uint32_t begin,
+                           uint32_t round, uint32_t lane, uint32_t slot)
+{
+    const trace_worker *w = &g_trace_workers[worker];
+    uint32_t i;
+
+    /* A poll's run ends where the next poll's stamp starts */
+    for (i = begin; i < w->count; i++) {
+        const trace_staged *e = &w->events[i];
+        if (e->round != round || e->lane != (uint8_t)lane || e->slot != slot) {
+            break;
+        }
+        asx_trace_emit(e->kind, e->entity_id, e->aux);
+    }
+}
@@ -10,35 +10,97 @@
 /* ASX_CHECKPOINT_WAIVER_FILE() — bounded iteration over small fixed arrays */
 
 #include <asx/runtime/vertical_adapter.h>
+#include <asx/runtime/digest.h>
+#include <asx/runtime/hindsight.h>
 #include <string.h>
 
 /* -------------------------------------------------------------------
- * Internal: FNV-1a decision digest
+ * Internal: decision digest (adapter digest domain)
  * ------------------------------------------------------------------- */
 
 #define FNV_OFFSET 14695981039346656037ULL
-#define FNV_PRIME  1099511628211ULL
 
-static uint64_t fnv_u32(uint64_t h, uint32_t v)
+static uint64_t compute_decision_digest(const asx_overload_decision *d)
 {
-    const unsigned char *p = (const unsigned char *)&v;
-    int i;
-    for (i = 0; i < 4; i++) {
-        h ^= (uint64_t)p[i];
-        h *= FNV_PRIME;
-    }
-    return h;
+    uint32_t f[5];
+    f[0] = (uint32_t)d->triggered;
+    f[1] = (uint32_t)d->mode;
+    f[2] = d->load_pct;
+    f[3] = d->shed_count;
+    f[4] = (uint32_t)d->admit_status;
+    return asx_digest_u32s(asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER),
+                           FNV_OFFSET, f, 5u);
 }
 
-static uint64_t compute_decision_digest(const asx_overload_decision *d)
+/* -------------------------------------------------------------------
+ * Internal: compiled catalog decisions
+ *
+ * A catalog decision depends on (used, capacity) only through the load
+ * percent, so each profile compiles to one row per percent 0..100 with
+ * the decision's digest. Loads past capacity, zero capacity, a shed
+ * count clamped by used, or a digest mode changed since the build take
+ * the reference path.
+ * ------------------------------------------------------------------- */
+
+#define TABLE_LOADS          101u
+#define TABLE_BUILD_CAPACITY 100u
+#define TABLE_CHECK_CAPACITY 1000u
+
+typedef struct {
+    asx_overload_mode mode;
+    uint32_t          shed_count;   /* when triggered */
+    asx_status        refused;      /* admit_status when triggered */
+    uint8_t           triggered[TABLE_LOADS];
+    uint64_t          digest[TABLE_LOADS];
+} catalog_table;
+
+static catalog_table   g_tables[ASX_PROFILE_ID_COUNT];
+static int             g_tables_on = 0;
+static asx_digest_mode g_tables_digest;
+
+static uint32_t table_load_pct(uint32_t used, uint32_t capacity)
+{
+    return (uint32_t)(((uint64_t)used * 100u) / capacity);
+}
+
+static void table_decision(const catalog_table *t, uint32_t pct,
+                           asx_overload_decision *d)
 {
-    uint64_t h = FNV_OFFSET;
-    h = fnv_u32(h, (uint32_t)d->triggered);
-    h = fnv_u32(h, (uint32_t)d->mode);
-    h = fnv_u32(h, d->load_pct);
-    h = fnv_u32(h, d->shed_count);
-    h = fnv_u32(h, (uint32_t)d->admit_status);
-    return h;
+    memset(d, 0, sizeof(*d));
+    d->mode = t->mode;
+    d->load_pct = pct;
+    d->triggered = t->triggered[pct];
+    d->shed_count = d->triggered ? t->shed_count : 0u;
+    d->admit_status = d->triggered ? t->refused : ASX_OK;
+}
+
+/* Table row for (used, capacity), or 0 when the reference must run. */
+static int table_lookup(asx_profile_id profile, uint32_t used,
+                        uint32_t capacity, asx_overload_decision *d,
+                        uint64_t *digest)
+{
+    const catalog_table *t;
+    uint32_t pct;
+
+    if (!g_tables_on || capacity == 0u || used > capacity) return 0;
+    if (asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER) != g_tables_digest)
+        return 0;
+
+    t = &g_tables[profile];
+    pct = table_load_pct(used, capacity);
+    if (t->triggered[pct] && used < t->shed_count) return 0;
+
+    table_decision(t, pct, d);
+    *digest = t->digest[pct];
+    return 1;
+}
+
+static int decision_equal(const asx_overload_decision *a,
+                          const asx_overload_decision *b)
+{
+    return a->triggered == b->triggered && a->mode == b->mode &&
+           a->load_pct == b->load_pct && a->shed_count == b->shed_count &&
+           a->admit_status == b->admit_status;
 }
 
 /* -------------------------------------------------------------------
@@ -47,6 +109,14 @@ static uint64_t compute_decision_digest(const asx_overload_decision *d)
 
 static uint32_t g_router_reject_streak = 0;
 
+/* -------------------------------------------------------------------
+ * Internal: shadow sampling (module-level state)
+ * ------------------------------------------------------------------- */
+
+static uint32_t                 g_shadow_every = 0;
+static uint32_t                 g_shadow_phase[ASX_ADAPTER_COUNT];
+static asx_adapter_shadow_stats g_shadow_stats;
+
 /* -------------------------------------------------------------------
  * Descriptor table
  * ------------------------------------------------------------------- */
@@ -185,8 +255,11 @@ asx_status asx_adapter_evaluate(asx_adapter_id id,
     out->mode = mode;
 
     profile = g_descriptors[id].profile;
-    evaluate_via_catalog(profile, used, capacity, &out->decision);
-    out->decision_digest = compute_decision_digest(&out->decision);
+    if (!table_lookup(profile, used, capacity, &out->decision,
+                      &out->decision_digest)) {
+        evaluate_via_catalog(profile, used, capacity, &out->decision);
+        out->decision_digest = compute_decision_digest(&out->decision);
+    }
 
     /* Populate annotations only in accelerated mode */
     if (mode == ASX_ADAPTER_MODE_ACCELERATED) {
@@ -229,9 +302,122 @@ asx_status asx_adapter_evaluate_both(asx_adapter_id id,
     return s;
 }
 
+void asx_adapter_shadow_set_rate(uint32_t sample_every)
+{
+    g_shadow_every = sample_every;
+    memset(g_shadow_phase, 0, sizeof(g_shadow_phase));
+}
+
+asx_status asx_adapter_evaluate_shadowed(asx_adapter_id id,
+                                          uint32_t used,
+                                          uint32_t capacity,
+                                          asx_adapter_result *out)
+{
+    asx_adapter_result fb;
+    asx_status s;
+    int sampled;
+
+    s = asx_adapter_evaluate(id, ASX_ADAPTER_MODE_ACCELERATED,
+                              used, capacity, out);
+    if (s != ASX_OK) return s;
+
+    g_shadow_stats.evaluations++;
+    if (g_shadow_every == 0u) return ASX_OK;
+    sampled = g_shadow_phase[id] == 0u;
+    if (++g_shadow_phase[id] >= g_shadow_every) g_shadow_phase[id] = 0;
+    if (!sampled) return ASX_OK;
+
+    /* FALLBACK leaves the annotation state (router streak) alone */
+    g_shadow_stats.sampled++;
+    s = asx_adapter_evaluate(id, ASX_ADAPTER_MODE_FALLBACK,
+                              used, capacity, &fb);
+    if (s != ASX_OK) return s;
+    if (fb.decision_digest != out->decision_digest) {
+        g_shadow_stats.divergences++;
+#if ASX_HINDSIGHT
+        asx_hindsight_log(ASX_ND_ADAPTER_DIVERGENCE,
+                          ((uint64_t)id << 32) | used, fb.decision_digest);
+#endif
+    }
+    return ASX_OK;
+}
+
+void asx_adapter_shadow_stats_get(asx_adapter_shadow_stats *out)
+{
+    if (out != NULL) *out = g_shadow_stats;
+}
+
+asx_status asx_adapter_tables_build(void)
+{
+    uint32_t p;
+    uint32_t used;
+
+    g_tables_on = 0;
+    g_tables_digest = asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER);
+
+    for (p = 0; p < (uint32_t)ASX_PROFILE_ID_COUNT; p++) {
+        catalog_table *t = &g_tables[p];
+        asx_overload_policy pol;
+        asx_overload_decision d;
+        uint32_t pct;
+
+        memset(t, 0, sizeof(*t));
+        if (asx_overload_catalog_to_policy((asx_profile_id)p, &pol) != ASX_OK)
+            return ASX_E_INVALID_STATE;
+        t->mode = pol.mode;
+        t->refused = ASX_OK;
+        for (pct = 0; pct < TABLE_LOADS; pct++) {
+            asx_overload_evaluate(&pol, pct, TABLE_BUILD_CAPACITY, &d);
+            t->triggered[pct] = (uint8_t)(d.triggered != 0);
+            if (d.triggered) {
+                t->shed_count = d.shed_count;
+                t->refused = d.admit_status;
+            }
+        }
+        for (pct = 0; pct < TABLE_LOADS; pct++) {
+            table_decision(t, pct, &d);
+            t->digest[pct] = compute_decision_digest(&d);
+        }
+    }
+
+    /* Check every row against the reference at another capacity, so
+     * several used values land on each row, before serving from it */
+    g_tables_on = 1;
+    for (p = 0; p < (uint32_t)ASX_PROFILE_ID_COUNT; p++) {
+        for (used = 0; used <= TABLE_CHECK_CAPACITY; used++) {
+            asx_overload_decision ref, got;
+            uint64_t digest;
+
+            evaluate_via_catalog((asx_profile_id)p, used,
+                                 TABLE_CHECK_CAPACITY, &ref);
+            if (table_lookup((asx_profile_id)p, used, TABLE_CHECK_CAPACITY,
+                             &got, &digest) &&
+                (!decision_equal(&ref, &got) ||
+                 digest != compute_decision_digest(&ref))) {
+                g_tables_on = 0;
+                return ASX_E_INVALID_STATE;
+            }
+        }
+    }
+    return ASX_OK;
+}
+
+void asx_adapter_tables_clear(void)
+{
+    g_tables_on = 0;
+}
+
+int asx_adapter_tables_enabled(void)
+{
+    return g_tables_on;
+}
+
 void asx_adapter_reset_all(void)
 {
     g_router_reject_streak = 0;
+    g_shadow_every = 0;
+    memset(g_shadow_phase, 0, sizeof(g_shadow_phase));
+    memset(&g_shadow_stats, 0, sizeof(g_shadow_stats));
     asx_hft_instrument_reset();
     asx_auto_instrument_reset();
 }
@@ -0,0 +1,686 @@
+/*
+ * waker.c — task parking and event-driven wakeups
+ *
+ * Parked tasks leave their region ready list and join a single global
+ * park list in park order, reusing the task's ready-list links. Each
+ * also joins the wait list of its source: one of ASX_WAKE_BUCKETS
+ * lists picked by a hash of (kind, key), or the select list for a
+ * select park. Event sources call asx_wake_source(), which walks the
+ * source's bucket and the select list merged by park sequence, so a
+ * wakeup costs the tasks sharing its bucket plus the select waiters
+ * (at most ASX_SELECT_MAX_WAITERS), not every parked task.
+ *
+ * A park requested by the task being polled is deferred until its
+ * poll returns: unlinking it mid-poll would lose the scheduler's place
+ * in the ready list.
+ *
+ * Event sources running on worker threads during a parallel batch
+ * record wakes with asx_wake_source_deferred(). They are applied on the
+ * calling thread once the batch's results (and so its parks) are in,
+ * sorted by (kind, key) so the wake order does not depend on thread
+ * timing.
+ *
+ * A select park stores its source set in a fixed table of select
+ * records; the task's park key is the record index and every wake
+ * path matches (kind, key) against the record as well as against
+ * single-source parks. The record is returned whenever the park
+ * request ends (wake, discarded request, or re-park).
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/waker.h>
+#include "runtime_internal.h"
+#include "context_internal.h"
+
+/* -------------------------------------------------------------------
+ * Park list state
+ * ------------------------------------------------------------------- */
+
+static uint32_t g_park_head = ASX_TASK_LINK_NONE;
+static uint32_t g_park_tail = ASX_TASK_LINK_NONE;
+static uint32_t g_park_count;
+
+/* Wait lists in park order, linked through the cold slot. A list's
+ * head and tail mean something only while its length is nonzero, so
+ * every list starts out empty from zeroed state. */
+#define ASX_WAKE_BUCKET_BITS 6u
+#define ASX_WAKE_BUCKETS     (1u << ASX_WAKE_BUCKET_BITS)
+#define ASX_WAKE_SELECT_LIST ASX_WAKE_BUCKETS
+
+static uint32_t g_wait_head[ASX_WAKE_BUCKETS + 1u];
+static uint32_t g_wait_tail[ASX_WAKE_BUCKETS + 1u];
+static uint32_t g_wait_len[ASX_WAKE_BUCKETS + 1u];
+static uint32_t g_park_seq;
+static uint32_t g_wake_visits;
+
+/* Task currently inside its poll function, or ASX_TASK_LINK_NONE */
+static uint32_t g_polling_task = ASX_TASK_LINK_NONE;
+
+/* Nonzero while a parallel batch polls on worker threads: every park is
+ * a self-park and is only recorded on the task's own slot. */
+static int g_polling_batch;
+
+/* Wakes recorded during a batch. Past capacity, a kind's bit in
+ * g_defer_overflow makes the flush wake every task parked on it. */
+#define ASX_WAKE_DEFER_CAPACITY 64u
+
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define defer_claim(p)     __atomic_fetch_add((p), 1u, __ATOMIC_RELAXED)
+#define defer_mark(p, v)   (void)__atomic_fetch_or((p), (v), __ATOMIC_RELAXED)
+#else
+#define defer_claim(p)     ((*(p))++)
+#define defer_mark(p, v)   (void)(*(p) |= (v))
+#endif
+
+static uint64_t g_defer_key[ASX_WAKE_DEFER_CAPACITY];
+static uint8_t  g_defer_kind[ASX_WAKE_DEFER_CAPACITY];
+static uint32_t g_defer_count;
+static uint32_t g_defer_overflow;
+
+/* Select records; claimed with an exchange so batch polls may select */
+#if !ASX_DETERMINISTIC && (defined(__GNUC__) || defined(__clang__))
+#define select_claim(p)    (__atomic_exchange_n((p), 1u, __ATOMIC_ACQ_REL) == 0u)
+#define select_release(p)  __atomic_store_n((p), 0u, __ATOMIC_RELEASE)
+#else
+#define select_claim(p)    (*(p) == 0u ? ((*(p) = 1u), 1) : 0)
+#define select_release(p)  (void)(*(p) = 0u)
+#endif
+
+typedef struct {
+    uint64_t channel_keys[ASX_SELECT_MAX_CHANNELS];
+    uint64_t timer_key;
+    uint32_t channel_count;
+    int      has_timer;
+    uint32_t used;
+} asx_select_record;
+
+static asx_select_record g_select[ASX_SELECT_MAX_WAITERS];
+
+static const uint32_t g_waker_link_none = ASX_TASK_LINK_NONE;
+static const asx_context_block g_waker_blocks[] = {
+    ASX_CONTEXT_BLOCK_INIT(g_park_head, g_waker_link_none),
+    ASX_CONTEXT_BLOCK_INIT(g_park_tail, g_waker_link_none),
+    ASX_CONTEXT_BLOCK(g_park_count),
+    ASX_CONTEXT_BLOCK(g_wait_head),
+    ASX_CONTEXT_BLOCK(g_wait_tail),
+    ASX_CONTEXT_BLOCK(g_wait_len),
+    ASX_CONTEXT_BLOCK(g_park_seq),
+    ASX_CONTEXT_BLOCK(g_wake_visits),
+    ASX_CONTEXT_BLOCK_INIT(g_polling_task, g_waker_link_none),
+    ASX_CONTEXT_BLOCK(g_polling_batch),
+    ASX_CONTEXT_BLOCK(g_defer_key),
+    ASX_CONTEXT_BLOCK(g_defer_kind),
+    ASX_CONTEXT_BLOCK(g_defer_count),
+    ASX_CONTEXT_BLOCK(g_defer_overflow),
+    ASX_CONTEXT_BLOCK(g_select)
+};
+
+const asx_context_module asx_waker_context = ASX_CONTEXT_MODULE(g_waker_blocks);
+
+void asx_waker_reset(void)
+{
+    uint32_t i;
+
+    g_park_head = ASX_TASK_LINK_NONE;
+    g_park_tail = ASX_TASK_LINK_NONE;
+    g_park_count = 0;
+    for (i = 0; i <= ASX_WAKE_BUCKETS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_WAKE_BUCKETS");
+        g_wait_len[i] = 0;
+    }
+    g_park_seq = 0;
+    g_wake_visits = 0;
+    g_polling_task = ASX_TASK_LINK_NONE;
+    g_polling_batch = 0;
+    g_defer_count = 0;
+    g_defer_overflow = 0;
+    for (i = 0; i < ASX_SELECT_MAX_WAITERS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SELECT_MAX_WAITERS");
+        g_select[i].used = 0;
+    }
+}
+
+/* Does select record rec wait on (kind, key)? */
+static int select_matches(uint64_t rec, asx_park_kind kind, uint64_t key)
+{
+    const asx_select_record *sr = &g_select[rec];
+    uint32_t i;
+
+    if (kind == ASX_PARK_TIMER) {
+        return sr->has_timer && sr->timer_key == key;
+    }
+    if (kind != ASX_PARK_CHANNEL) return 0;
+    for (i = 0; i < sr->channel_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SELECT_MAX_CHANNELS");
+        if (sr->channel_keys[i] == key) return 1;
+    }
+    return 0;
+}
+
+/* Does the task's park request cover (kind, key)? */
+static int park_matches(const asx_task_slot *t, asx_park_kind kind,
+                        uint64_t key)
+{
+    if (t->park_kind == (uint8_t)kind) {
+        return t->cold->park_key == key;
+    }
+    if (t->park_kind == (uint8_t)ASX_PARK_SELECT) {
+        return select_matches(t->cold->park_key, kind, key);
+    }
+    return 0;
+}
+
+/* Wait list a park on (kind, key) joins: Fibonacci hash of the key
+ * with the kind folded into its top byte. */
+static uint32_t wait_list_of(uint8_t kind, uint64_t key)
+{
+    if (kind == (uint8_t)ASX_PARK_SELECT) return ASX_WAKE_SELECT_LIST;
+    return (uint32_t)(((key ^ ((uint64_t)kind << 56)) *
+                       0x9E3779B97F4A7C15ull) >> (64u - ASX_WAKE_BUCKET_BITS));
+}
+
+/* Was a parked before b? Sequences wrap; live parks span far less. */
+static int park_seq_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+/* Link a parked task into its wait list at its park_seq position:
+ * the tail for a new park, further in only for a re-park. */
+static void wait_list_insert(uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+    asx_task_cold *c = t->cold;
+    uint32_t list = wait_list_of(t->park_kind, c->park_key);
+    uint32_t prev = g_wait_len[list] != 0 ? g_wait_tail[list]
+                                          : ASX_TASK_LINK_NONE;
+    uint32_t next = ASX_TASK_LINK_NONE;
+
+    while (prev != ASX_TASK_LINK_NONE &&
+           park_seq_before(c->park_seq, asx_task_cold_at(prev)->park_seq)) {
+        ASX_CHECKPOINT_WAIVER("bounded by the wait list length");
+        next = prev;
+        prev = asx_task_cold_at(prev)->wait_prev;
+    }
+    c->wait_prev = prev;
+    c->wait_next = next;
+    if (prev == ASX_TASK_LINK_NONE) {
+        g_wait_head[list] = task_idx;
+    } else {
+        asx_task_cold_at(prev)->wait_next = task_idx;
+    }
+    if (next == ASX_TASK_LINK_NONE) {
+        g_wait_tail[list] = task_idx;
+    } else {
+        asx_task_cold_at(next)->wait_prev = task_idx;
+    }
+    g_wait_len[list]++;
+}
+
+static void wait_list_remove(uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+    asx_task_cold *c = t->cold;
+    uint32_t list = wait_list_of(t->park_kind, c->park_key);
+
+    if (c->wait_prev == ASX_TASK_LINK_NONE) {
+        g_wait_head[list] = c->wait_next;
+    } else {
+        asx_task_cold_at(c->wait_prev)->wait_next = c->wait_next;
+    }
+    if (c->wait_next == ASX_TASK_LINK_NONE) {
+        g_wait_tail[list] = c->wait_prev;
+    } else {
+        asx_task_cold_at(c->wait_next)->wait_prev = c->wait_prev;
+    }
+    g_wait_len[list]--;
+}
+
+/* End a task's park request, returning its select record if any. A
+ * parked task also leaves its wait list. */
+static void park_clear(asx_task_slot *t, uint32_t task_idx)
+{
+    if (t->park_kind == (uint8_t)ASX_PARK_NONE) return;
+    if (t->parked) wait_list_remove(task_idx);
+    if (t->park_kind == (uint8_t)ASX_PARK_SELECT) {
+        select_release(&g_select[t->cold->park_key].used);
+    }
+    t->park_kind = ASX_PARK_NONE;
+}
+
+static asx_task_id waker_task_handle(const asx_task_slot *t, uint32_t task_idx)
+{
+    return asx_handle_pack(ASX_TYPE_TASK,
+                           (uint16_t)(1u << (unsigned)t->state),
+                           asx_handle_pack_index(asx_slot_generation(t->key),
+                                                 task_idx));
+}
+
+static void park_list_append(uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+
+    t->ready_prev = g_park_tail;
+    t->ready_next = ASX_TASK_LINK_NONE;
+    if (g_park_tail == ASX_TASK_LINK_NONE) {
+        g_park_head = task_idx;
+    } else {
+        asx_task_at(g_park_tail)->ready_next = task_idx;
+    }
+    g_park_tail = task_idx;
+    t->parked = 1;
+    g_park_count++;
+    t->cold->park_seq = g_park_seq++;
+    wait_list_insert(task_idx);
+}
+
+static void park_list_remove(uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+
+    if (t->ready_prev == ASX_TASK_LINK_NONE) {
+        g_park_head = t->ready_next;
+    } else {
+        asx_task_at(t->ready_prev)->ready_next = t->ready_next;
+    }
+    if (t->ready_next == ASX_TASK_LINK_NONE) {
+        g_park_tail = t->ready_prev;
+    } else {
+        asx_task_at(t->ready_next)->ready_prev = t->ready_prev;
+    }
+    t->ready_prev = ASX_TASK_LINK_NONE;
+    t->ready_next = ASX_TASK_LINK_NONE;
+    t->parked = 0;
+    g_park_count--;
+}
+
+/* Move a task with a park request from its ready list to the park list. */
+static void park_commit(asx_region_slot *region, uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+
+    asx_region_ready_remove(region, task_idx);
+    park_list_append(task_idx);
+    asx_parallel_lane_sync(task_idx);
+    asx_trace_emit(ASX_TRACE_TASK_PARK, waker_task_handle(t, task_idx),
+                   (uint64_t)t->park_kind);
+}
+
+/* -------------------------------------------------------------------
+ * Scheduler integration
+ * ------------------------------------------------------------------- */
+
+void asx_waker_poll_begin(uint32_t task_idx)
+{
+    g_polling_task = task_idx;
+}
+
+void asx_waker_batch_begin(void)
+{
+    g_polling_batch = 1;
+}
+
+void asx_waker_batch_end(void)
+{
+    g_polling_batch = 0;
+}
+
+/* Wake every parked task waiting on any key of the given kind. */
+static void wake_kind(asx_park_kind kind)
+{
+    uint32_t i = g_park_head;
+    uint32_t next;
+
+    while (i != ASX_TASK_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by park list length <= ASX_ARENA_MAX_TASKS");
+        asx_task_slot *t = asx_task_at(i);
+        next = t->ready_next;
+        if (t->park_kind == (uint8_t)kind) {
+            asx_task_wake_internal(i);
+        } else if (t->park_kind == (uint8_t)ASX_PARK_SELECT) {
+            const asx_select_record *sr = &g_select[t->cold->park_key];
+            if (kind == ASX_PARK_TIMER ? sr->has_timer
+                                       : kind == ASX_PARK_CHANNEL &&
+                                         sr->channel_count != 0u) {
+                asx_task_wake_internal(i);
+            }
+        }
+        i = next;
+    }
+}
+
+void asx_waker_flush_deferred(void)
+{
+    uint32_t n = g_defer_count;
+    uint32_t i;
+    uint32_t j;
+
+    if (n > ASX_WAKE_DEFER_CAPACITY) n = ASX_WAKE_DEFER_CAPACITY;
+
+    /* Insertion sort by (kind, key): n is small and usually sorted */
+    for (i = 1; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_WAKE_DEFER_CAPACITY");
+        uint64_t key = g_defer_key[i];
+        uint8_t kind = g_defer_kind[i];
+        for (j = i; j > 0 && (g_defer_kind[j - 1u] > kind ||
+                              (g_defer_kind[j - 1u] == kind &&
+                               g_defer_key[j - 1u] > key)); j--) {
+            ASX_CHECKPOINT_WAIVER("bounded by ASX_WAKE_DEFER_CAPACITY");
+            g_defer_key[j] = g_defer_key[j - 1u];
+            g_defer_kind[j] = g_defer_kind[j - 1u];
+        }
+        g_defer_key[j] = key;
+        g_defer_kind[j] = kind;
+    }
+
+    for (i = 0; i < n; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_WAKE_DEFER_CAPACITY");
+        if (i > 0 && g_defer_kind[i] == g_defer_kind[i - 1u] &&
+            g_defer_key[i] == g_defer_key[i - 1u]) {
+            continue;
+        }
+        (void)asx_wake_source((asx_park_kind)g_defer_kind[i], g_defer_key[i]);
+    }
+    for (i = 1; i <= (uint32_t)ASX_PARK_SEMAPHORE; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by park kind count");
+        if (g_defer_overflow & (1u << i)) wake_kind((asx_park_kind)i);
+    }
+    g_defer_count = 0;
+    g_defer_overflow = 0;
+}
+
+void asx_waker_poll_end(asx_region_slot *region, uint32_t task_idx,
+                        asx_status poll_result)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+
+    g_polling_task = ASX_TASK_LINK_NONE;
+    if (t->park_kind == ASX_PARK_NONE) return;
+
+    if (poll_result == ASX_E_PENDING && !t->cancel_pending &&
+        !asx_task_is_terminal(t->state)) {
+        park_commit(region, task_idx);
+    } else {
+        park_clear(t, task_idx);
+    }
+}
+
+void asx_task_wake_internal(uint32_t task_idx)
+{
+    asx_task_slot *t = asx_task_at(task_idx);
+    asx_region_slot *r;
+    asx_park_kind kind = (asx_park_kind)t->park_kind;
+
+    park_clear(t, task_idx);
+    if (!t->parked) return; /* deferred request simply discarded */
+
+    park_list_remove(task_idx);
+    if (asx_region_slot_lookup(t->region, &r) == ASX_OK) {
+        asx_region_ready_insert(r, task_idx);
+    }
+    asx_parallel_lane_sync(task_idx);
+    asx_trace_emit(ASX_TRACE_TASK_WAKE, waker_task_handle(t, task_idx),
+                   (uint64_t)kind);
+}
+
+/* -------------------------------------------------------------------
+ * Public parking API
+ * ------------------------------------------------------------------- */
+
+static asx_status task_park(asx_task_id id, asx_park_kind kind, uint64_t key)
+{
+    asx_task_slot *t;
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t idx;
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+    if (asx_task_is_terminal(t->state)) return ASX_E_INVALID_STATE;
+    if (t->cancel_pending) return ASX_OK;
+
+    idx = asx_handle_slot(id);
+    park_clear(t, idx);
+    if (t->parked) {
+        /* Re-park on a new source: keep park-list position */
+        t->park_kind = (uint8_t)kind;
+        t->cold->park_key = key;
+        wait_list_insert(idx);
+        return ASX_OK;
+    }
+
+    t->park_kind = (uint8_t)kind;
+    t->cold->park_key = key;
+    if (idx == g_polling_task || g_polling_batch) {
+        return ASX_OK; /* applied by poll_end */
+    }
+
+    st = asx_region_slot_lookup(t->region, &r);
+    if (st != ASX_OK) return st;
+    park_commit(r, idx);
+    return ASX_OK;
+}
+
+asx_status asx_task_park_on_channel(asx_task_id task, asx_channel_id channel)
+{
+    return task_park(task, ASX_PARK_CHANNEL, asx_park_key_channel(channel));
+}
+
+asx_status asx_task_park_on_timer(asx_task_id task, const asx_timer_handle *timer)
+{
+    if (timer == NULL) return ASX_E_INVALID_ARGUMENT;
+    return task_park(task, ASX_PARK_TIMER, asx_park_key_timer(timer));
+}
+
+asx_status asx_task_park_on_obligation(asx_task_id task,
+                                       asx_obligation_id obligation)
+{
+    return task_park(task, ASX_PARK_OBLIGATION,
+                     asx_park_key_obligation(obligation));
+}
+
+asx_status asx_task_park_on_io(asx_task_id task, uint64_t key)
+{
+    return task_park(task, ASX_PARK_IO, key);
+}
+
+asx_status asx_task_park_on_group(asx_task_id task, const asx_task_group *group,
+                                  uint32_t count)
+{
+    uint64_t key;
+    asx_status st;
+
+    st = asx_task_group_wait(group, count, &key);
+    if (st != ASX_OK) return st;
+    return task_park(task, ASX_PARK_GROUP, key);
+}
+
+asx_status asx_task_park_on_semaphore(asx_task_id task, const asx_semaphore *sem)
+{
+    uint64_t key;
+    int granted;
+    asx_status st;
+
+    st = asx_semaphore_wait(sem, task, &key, &granted);
+    if (st != ASX_OK) return st;
+    if (granted) return ASX_OK; /* polled again, takes the permit */
+    return task_park(task, ASX_PARK_SEMAPHORE, key);
+}
+
+asx_status asx_task_wake(asx_task_id task)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    st = asx_task_slot_lookup(task, &t);
+    if (st != ASX_OK) return st;
+    asx_task_wake_internal(asx_handle_slot(task));
+    return ASX_OK;
+}
+
+uint32_t asx_wake_source(asx_park_kind kind, uint64_t key)
+{
+    uint32_t list = wait_list_of((uint8_t)kind, key);
+    uint32_t i;
+    uint32_t s;
+    uint32_t woken = 0;
+
+    /* Deferred request from the task being polled */
+    if (g_polling_task != ASX_TASK_LINK_NONE) {
+        asx_task_slot *pt = asx_task_at(g_polling_task);
+        if (!pt->parked && park_matches(pt, kind, key)) {
+            park_clear(pt, g_polling_task);
+        }
+    }
+
+    /* The source's bucket and, for the kinds a select can wait on, the
+     * select list, in park order */
+    i = g_wait_len[list] != 0 ? g_wait_head[list] : ASX_TASK_LINK_NONE;
+    s = (kind == ASX_PARK_CHANNEL || kind == ASX_PARK_TIMER) &&
+        g_wait_len[ASX_WAKE_SELECT_LIST] != 0
+      ? g_wait_head[ASX_WAKE_SELECT_LIST] : ASX_TASK_LINK_NONE;
+    g_wake_visits = 0;
+    while (i != ASX_TASK_LINK_NONE || s != ASX_TASK_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by bucket length + ASX_SELECT_MAX_WAITERS");
+        uint32_t cur;
+
+        if (s == ASX_TASK_LINK_NONE ||
+            (i != ASX_TASK_LINK_NONE &&
+             park_seq_before(asx_task_cold_at(i)->park_seq,
+                             asx_task_cold_at(s)->park_seq))) {
+            cur = i;
+            i = asx_task_cold_at(i)->wait_next;
+        } else {
+            cur = s;
+            s = asx_task_cold_at(s)->wait_next;
+        }
+        g_wake_visits++;
+        if (park_matches(asx_task_at(cur), kind, key)) {
+            asx_task_wake_internal(cur);
+            woken++;
+        }
+    }
+    return woken;
+}
+
+uint32_t asx_waker_last_visits(void)
+{
+    return g_wake_visits;
+}
+
+uint32_t asx_wake_source_deferred(asx_park_kind kind, uint64_t key)
+{
+    uint32_t n;
+
+    if (!g_polling_batch) return asx_wake_source(kind, key);
+
+    n = defer_claim(&g_defer_count);
+    if (n < ASX_WAKE_DEFER_CAPACITY) {
+        g_defer_key[n] = key;
+        g_defer_kind[n] = (uint8_t)kind;
+    } else {
+        defer_mark(&g_defer_overflow, 1u << (unsigned)kind);
+    }
+    return 0;
+}
+
+asx_status asx_task_is_parked(asx_task_id task, int *out_parked)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    if (out_parked == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = asx_task_slot_lookup(task, &t);
+    if (st != ASX_OK) return st;
+    *out_parked = t->parked ? 1 : 0;
+    return ASX_OK;
+}
+
+uint32_t asx_parked_count(void)
+{
+    return g_park_count;
+}
+
+/* -------------------------------------------------------------------
+ * Select
+ * ------------------------------------------------------------------- */
+
+/* A receive on the channel would not block. */
+static asx_status select_channel_ready(asx_channel_id id, int *out_ready)
+{
+    asx_channel_state state;
+    uint32_t len;
+    asx_status st;
+
+    st = asx_channel_get_state(id, &state);
+    if (st != ASX_OK) return st;
+    st = asx_channel_queue_len(id, &len);
+    if (st != ASX_OK) return st;
+    *out_ready = len != 0u ||
+                 state == ASX_CHANNEL_SENDER_CLOSED ||
+                 state == ASX_CHANNEL_FULLY_CLOSED;
+    return ASX_OK;
+}
+
+asx_status asx_select(asx_task_id task, const asx_select_set *set,
+                      uint32_t *out_index)
+{
+    asx_task_slot *t;
+    asx_select_record *sr;
+    asx_status st;
+    uint32_t rec;
+    uint32_t i;
+    int ready;
+
+    if (set == NULL || out_index == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (set->channel_count > ASX_SELECT_MAX_CHANNELS) return ASX_E_INVALID_ARGUMENT;
+    if (set->channel_count == 0u && set->timer == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (set->timer != NULL && set->timer_wheel == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    /* First ready source in set order */
+    for (i = 0; i < set->channel_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SELECT_MAX_CHANNELS");
+        st = select_channel_ready(set->channels[i], &ready);
+        if (st != ASX_OK) return st;
+        if (ready) {
+            *out_index = i;
+            return ASX_OK;
+        }
+    }
+    if (set->timer != NULL && !asx_timer_is_live(set->timer_wheel, set->timer)) {
+        *out_index = set->channel_count;
+        return ASX_OK;
+    }
+
+    /* Nothing ready: park on the whole set */
+    st = asx_task_slot_lookup(task, &t);
+    if (st != ASX_OK) return st;
+    if (asx_task_is_terminal(t->state)) return ASX_E_INVALID_STATE;
+    if (t->cancel_pending) return ASX_E_PENDING; /* never parked */
+
+    for (rec = 0; rec < ASX_SELECT_MAX_WAITERS; rec++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SELECT_MAX_WAITERS");
+        if (select_claim(&g_select[rec].used)) break;
+    }
+    if (rec == ASX_SELECT_MAX_WAITERS) return ASX_E_RESOURCE_EXHAUSTED;
+
+    sr = &g_select[rec];
+    for (i = 0; i < set->channel_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_SELECT_MAX_CHANNELS");
+        sr->channel_keys[i] = asx_park_key_channel(set->channels[i]);
+    }
+    sr->channel_count = set->channel_count;
+    sr->has_timer = set->timer != NULL;
+    sr->timer_key = set->timer != NULL ? asx_park_key_timer(set->timer) : 0u;
+
+    st = task_park(task, ASX_PARK_SELECT, rec);
+    if (st != ASX_OK) {
+        select_release(&sr->used);
+        return st;
+    }
+    return ASX_E_PENDING;
+}
@@ -1,20 +1,78 @@
 /*
- * timer_wheel.c — timer wheel with deterministic ordering and O(1) cancel
+ * timer_wheel.c — hierarchical timer wheel with deterministic ordering
  *
- * Walking-skeleton implementation using a flat arena of timer slots.
- * Provides deterministic tie-break ordering (deadline ASC, insertion_seq ASC)
- * and O(1) cancel via generation-validated handles.
+ * Four wheel levels of 256 buckets each; level L buckets are
+ * 256^L time units wide, so the wheel spans 2^32 units ahead of the
+ * current time and later deadlines wait in an overflow bucket. A
+ * timer sits at the lowest level whose bucket window contains both
+ * its deadline and the current time, so advancing time only touches
+ * buckets the current time has moved past. Per-level occupied bitmaps
+ * let an advance skip empty buckets 64 at a time.
  *
- * Phase 5 will upgrade to a hierarchical 4-level wheel with occupied
- * bitmaps for O(1) skip optimization. The flat approach is correct and
- * sufficient for proving semantics.
+ * Expired timers move to a due list, which is merge-sorted by
+ * (deadline ASC, insertion_seq ASC) before firing. Buckets keep
+ * insertion order and are drained in deadline order, so the due list
+ * is usually ordered already and the sort is a single pass. Bucket membership
+ * is an intrusive doubly-linked list, so cancel stays O(1), and dead
+ * slots go on a free list, so register is O(1).
+ *
+ * A coalesced registration rounds its deadline up within its slack and
+ * joins a recent group with that deadline, found through a small
+ * direct-mapped cache. The group is an ordinary bucket entry (a slot
+ * with no handle of its own) heading a list of member timers, so the
+ * wheel cascades and sorts it once however many members it has. Firing
+ * the group emits its members in registration order; cancelling the
+ * last member retires it.
+ *
+ * Slots live in a chunked arena: the first ASX_MAX_TIMERS slots are
+ * embedded in the wheel, further chunks come from asx_runtime_alloc
+ * up to ASX_ARENA_MAX_TIMERS (see asx/runtime/runtime.h for the
+ * arena growth rules). Slots never move, so handles stay valid. Free
+ * slots are tracked in a two-level bitmap and the lowest is always
+ * taken, so live timers pack into the low chunks and, when most timers
+ * are cancelled, the top chunks drain. An empty top chunk is returned
+ * to the allocator as soon as at least a chunk of free slots would
+ * remain below it; the generations of its slots raise a floor that
+ * regrown slots start from, so handles into it stay stale.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/time/timer_wheel.h>
+#include <asx/runtime/waker.h>
 #include <asx/asx_config.h>
 #include <string.h>
+#include "../runtime/context_internal.h"
+#include "../core/bits.h"
+
+/* -------------------------------------------------------------------
+ * Wheel geometry
+ * ------------------------------------------------------------------- */
+
+#define TW_LEVELS         4u
+#define TW_LEVEL_BITS     8u
+#define TW_SLOTS          (1u << TW_LEVEL_BITS)
+#define TW_SLOT_MASK      (TW_SLOTS - 1u)
+#define TW_BITMAP_WORDS   (TW_SLOTS / 64u)
+
+#define TW_BUCKET_OVERFLOW (TW_LEVELS * TW_SLOTS)
+#define TW_BUCKET_DUE      (TW_BUCKET_OVERFLOW + 1u)
+#define TW_BUCKET_COUNT    (TW_BUCKET_DUE + 1u)
+#define TW_BUCKET_NONE     0xFFFFu
+#define TW_BUCKET_MEMBER   0xFFFEu  /* on a group's member list */
+
+#define TW_LINK_NONE       0xFFFFFFFFu
+#define TW_CHUNK_LIMIT     (ASX_ARENA_MAX_TIMERS / ASX_MAX_TIMERS)
+#define TW_CHUNK_WORDS     (ASX_MAX_TIMERS / 64u)
+#define TW_MAP_WORDS       (ASX_ARENA_MAX_TIMERS / 64u)
+#define TW_SUMMARY_WORDS   (TW_MAP_WORDS / 64u)
+
+#define TW_COALESCE_BITS   3u
+#define TW_COALESCE_WAYS   (1u << TW_COALESCE_BITS)
+
+#define TW_KIND_TIMER      0u
+#define TW_KIND_GROUP      1u  /* bucket entry for coalesced members */
+#define TW_KIND_MEMBER     2u  /* coalesced timer, fires with its group */
 
 /* -------------------------------------------------------------------
  * Timer slot (internal)
@@ -25,7 +83,13 @@ typedef struct {
     void     *waker_data;     /* opaque callback data */
     uint64_t  insertion_seq;  /* monotonic tie-break key */
     uint32_t  generation;     /* for stale-handle detection */
-    int       alive;          /* 1 if slot is live (not cancelled/fired) */
+    uint32_t  prev;           /* bucket, due or member list links */
+    uint32_t  next;
+    uint32_t  group;          /* member: its group; group: first member */
+    uint32_t  group_tail;     /* group: last member */
+    uint16_t  bucket;         /* owning bucket, TW_BUCKET_NONE if free */
+    uint8_t   alive;          /* 1 if slot is live (not cancelled/fired) */
+    uint8_t   kind;           /* TW_KIND_*; groups are never alive */
 } asx_timer_slot;
 
 /* -------------------------------------------------------------------
@@ -33,12 +97,26 @@ typedef struct {
  * ------------------------------------------------------------------- */
 
 struct asx_timer_wheel {
-    asx_timer_slot slots[ASX_MAX_TIMERS];
-    uint32_t       slot_count;       /* high-water mark for slot allocation */
-    uint32_t       active_count;     /* number of alive timers */
-    uint64_t       next_insertion;   /* monotonic insertion sequence */
-    asx_time       current_time;     /* last advanced-to time */
-    uint64_t       max_duration_ns;  /* maximum allowed timer duration */
+    asx_timer_slot  base[ASX_MAX_TIMERS];         /* chunk 0 */
+    asx_timer_slot *chunks[TW_CHUNK_LIMIT];
+    uint32_t        capacity;         /* slots across all chunks */
+    uint32_t        free_count;       /* free slots across all chunks */
+    uint32_t        trimmed;          /* chunks returned to the allocator */
+    uint32_t        generation_floor; /* highest generation of a trimmed slot */
+    uint32_t        active_count;     /* number of alive timers */
+    uint64_t        next_insertion;   /* monotonic insertion sequence */
+    asx_time        current_time;     /* last advanced-to time */
+    uint64_t        max_duration_ns;  /* maximum allowed timer duration */
+    int             due_sorted;       /* due list already in firing order */
+    int             next_valid;       /* next_deadline is the live minimum */
+    asx_time        next_deadline;    /* cached earliest live deadline */
+    uint32_t        primed;           /* chunk-0 slots initialized so far */
+    uint32_t        head[TW_BUCKET_COUNT]; /* first entry + 1, 0 if empty */
+    uint32_t        tail[TW_BUCKET_COUNT]; /* last entry + 1, 0 if empty */
+    uint64_t        occupied[TW_LEVELS][TW_BITMAP_WORDS];
+    uint32_t        coalesce[TW_COALESCE_WAYS]; /* recent groups by deadline */
+    uint64_t        free_map[TW_MAP_WORDS];         /* 1: slot free */
+    uint64_t        free_summary[TW_SUMMARY_WORDS]; /* 1: free_map word nonzero */
 };
 
 /* -------------------------------------------------------------------
@@ -48,6 +126,13 @@ struct asx_timer_wheel {
 static asx_timer_wheel g_wheel;
 static int g_wheel_initialized = 0;
 
+static const asx_context_block g_timer_blocks[] = {
+    ASX_CONTEXT_BLOCK(g_wheel),
+    ASX_CONTEXT_BLOCK(g_wheel_initialized)
+};
+
+const asx_context_module asx_timer_context = ASX_CONTEXT_MODULE(g_timer_blocks);
+
 static uint32_t asx_timer_next_generation(uint32_t current)
 {
     current++;
@@ -66,138 +151,850 @@ asx_timer_wheel *asx_timer_wheel_global(void)
     return &g_wheel;
 }
 
+static asx_timer_slot *timer_at(asx_timer_wheel *wheel, uint32_t idx)
+{
+    return &wheel->chunks[idx / ASX_MAX_TIMERS][idx % ASX_MAX_TIMERS];
+}
+
+/* Bucket ends are stored biased by one (TW_LINK_NONE wraps to 0), so
+ * the zeroed storage of a fresh wheel already has every bucket empty. */
+static uint32_t tw_head(const asx_timer_wheel *wheel, uint32_t bucket)
+{
+    return wheel->head[bucket] - 1u;
+}
+
+static uint32_t tw_tail(const asx_timer_wheel *wheel, uint32_t bucket)
+{
+    return wheel->tail[bucket] - 1u;
+}
+
+static void tw_set_head(asx_timer_wheel *wheel, uint32_t bucket, uint32_t idx)
+{
+    wheel->head[bucket] = idx + 1u;
+}
+
+static void tw_set_tail(asx_timer_wheel *wheel, uint32_t bucket, uint32_t idx)
+{
+    wheel->tail[bucket] = idx + 1u;
+}
+
+static void timer_slot_init(asx_timer_slot *s, uint32_t generation)
+{
+    s->deadline = 0;
+    s->waker_data = NULL;
+    s->insertion_seq = 0;
+    s->generation = generation;
+    s->prev = TW_LINK_NONE;
+    s->next = TW_LINK_NONE;
+    s->group = TW_LINK_NONE;
+    s->group_tail = TW_LINK_NONE;
+    s->bucket = TW_BUCKET_NONE;
+    s->alive = 0;
+    s->kind = TW_KIND_TIMER;
+}
+
 /* -------------------------------------------------------------------
- * Init / Reset
+ * Occupied bitmaps
  * ------------------------------------------------------------------- */
 
-void asx_timer_wheel_init(asx_timer_wheel *wheel)
+/* First occupied bucket index >= from on a level, or TW_SLOTS. */
+static uint32_t tw_next_occupied(const asx_timer_wheel *wheel, uint32_t level,
+                                 uint32_t from)
+{
+    uint32_t w;
+    uint64_t word;
+
+    if (from >= TW_SLOTS) return TW_SLOTS;
+    w = from / 64u;
+    word = wheel->occupied[level][w] & (~(uint64_t)0 << (from % 64u));
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_BITMAP_WORDS");
+        if (word != 0) return w * 64u + asx_ctz64(word);
+        if (++w >= TW_BITMAP_WORDS) return TW_SLOTS;
+        word = wheel->occupied[level][w];
+    }
+}
+
+static void tw_mark(asx_timer_wheel *wheel, uint32_t bucket, int set)
+{
+    uint32_t level = bucket / TW_SLOTS;
+    uint32_t slot = bucket % TW_SLOTS;
+    uint64_t bit = (uint64_t)1 << (slot % 64u);
+
+    if (level >= TW_LEVELS) return;
+    if (set) {
+        wheel->occupied[level][slot / 64u] |= bit;
+    } else {
+        wheel->occupied[level][slot / 64u] &= ~bit;
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Bucket lists
+ * ------------------------------------------------------------------- */
+
+/* Append, so every bucket keeps insertion order */
+static void bucket_push(asx_timer_wheel *wheel, uint32_t bucket, uint32_t idx)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
+    uint32_t old = tw_tail(wheel, bucket);
+
+    s->bucket = (uint16_t)bucket;
+    s->prev = old;
+    s->next = TW_LINK_NONE;
+    if (old != TW_LINK_NONE) {
+        timer_at(wheel, old)->next = idx;
+    } else {
+        tw_set_head(wheel, bucket, idx);
+        tw_mark(wheel, bucket, 1);
+    }
+    tw_set_tail(wheel, bucket, idx);
+}
+
+static void bucket_unlink(asx_timer_wheel *wheel, uint32_t idx)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
+    uint32_t bucket = s->bucket;
+
+    if (s->prev == TW_LINK_NONE) {
+        tw_set_head(wheel, bucket, s->next);
+    } else {
+        timer_at(wheel, s->prev)->next = s->next;
+    }
+    if (s->next == TW_LINK_NONE) {
+        tw_set_tail(wheel, bucket, s->prev);
+    } else {
+        timer_at(wheel, s->next)->prev = s->prev;
+    }
+    if (tw_head(wheel, bucket) == TW_LINK_NONE) {
+        tw_mark(wheel, bucket, 0);
+    }
+    s->prev = TW_LINK_NONE;
+    s->next = TW_LINK_NONE;
+    s->bucket = TW_BUCKET_NONE;
+}
+
+/* Append a coalesced timer to its group, keeping registration order */
+static void group_append(asx_timer_wheel *wheel, uint32_t group, uint32_t idx)
+{
+    asx_timer_slot *g = timer_at(wheel, group);
+    asx_timer_slot *s = timer_at(wheel, idx);
+
+    s->group = group;
+    s->bucket = TW_BUCKET_MEMBER;
+    s->prev = g->group_tail;
+    s->next = TW_LINK_NONE;
+    if (g->group_tail != TW_LINK_NONE) {
+        timer_at(wheel, g->group_tail)->next = idx;
+    } else {
+        g->group = idx;
+    }
+    g->group_tail = idx;
+}
+
+/* Detach a whole bucket and return its first entry. */
+static uint32_t bucket_take(asx_timer_wheel *wheel, uint32_t bucket)
+{
+    uint32_t first = tw_head(wheel, bucket);
+    tw_set_head(wheel, bucket, TW_LINK_NONE);
+    tw_set_tail(wheel, bucket, TW_LINK_NONE);
+    tw_mark(wheel, bucket, 0);
+    return first;
+}
+
+/* File a live timer relative to current_time: the due list if expired,
+ * else the lowest level whose window holds both deadline and now. */
+/* (deadline, insertion_seq) order */
+static int timer_before(const asx_timer_slot *a, const asx_timer_slot *b)
+{
+    if (a->deadline != b->deadline) return a->deadline < b->deadline;
+    return a->insertion_seq < b->insertion_seq;
+}
+
+static void timer_place(asx_timer_wheel *wheel, uint32_t idx)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
+    uint64_t diff;
+    uint32_t level;
+
+    if (s->deadline <= wheel->current_time) {
+        /* Expiry mostly arrives in order; only note when it does not */
+        uint32_t last = tw_tail(wheel, TW_BUCKET_DUE);
+        if (last != TW_LINK_NONE && timer_before(s, timer_at(wheel, last))) {
+            wheel->due_sorted = 0;
+        }
+        bucket_push(wheel, TW_BUCKET_DUE, idx);
+        return;
+    }
+
+    diff = s->deadline ^ wheel->current_time;
+    for (level = 0; level < TW_LEVELS; level++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_LEVELS");
+        if ((diff >> (TW_LEVEL_BITS * (level + 1u))) == 0) {
+            uint32_t slot = (uint32_t)(s->deadline >> (TW_LEVEL_BITS * level))
+                            & TW_SLOT_MASK;
+            bucket_push(wheel, level * TW_SLOTS + slot, idx);
+            return;
+        }
+    }
+    bucket_push(wheel, TW_BUCKET_OVERFLOW, idx);
+}
+
+/* Re-file every timer of a detached bucket list. */
+static void timer_place_list(asx_timer_wheel *wheel, uint32_t i)
 {
+    while (i != TW_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+        uint32_t next = timer_at(wheel, i)->next;
+        timer_place(wheel, i);
+        i = next;
+    }
+}
+
+/* Move the wheel from current_time to now (> current_time). Levels are
+ * processed bottom-up so re-filed timers only land on levels already
+ * brought up to date. Invariant: a level-L timer shares every bit above
+ * level L with current_time, so its bucket index is ahead of now's. */
+static void timer_wheel_advance_to(asx_timer_wheel *wheel, asx_time now)
+{
+    asx_time old = wheel->current_time;
+    uint32_t level;
+
+    wheel->current_time = now;
+
+    for (level = 0; level < TW_LEVELS; level++) {
+        uint32_t shift = TW_LEVEL_BITS * level;
+        uint32_t old_idx = (uint32_t)(old >> shift) & TW_SLOT_MASK;
+        uint32_t new_idx = (uint32_t)(now >> shift) & TW_SLOT_MASK;
+        uint32_t b;
+
+        if ((old >> (shift + TW_LEVEL_BITS)) != (now >> (shift + TW_LEVEL_BITS))) {
+            /* Left this level's window: everything on it has expired */
+            for (b = tw_next_occupied(wheel, level, 0); b < TW_SLOTS;
+                 b = tw_next_occupied(wheel, level, b + 1u)) {
+                ASX_CHECKPOINT_WAIVER("bounded by TW_SLOTS");
+                timer_place_list(wheel, bucket_take(wheel, level * TW_SLOTS + b));
+            }
+            continue;
+        }
+        if (old_idx == new_idx) return; /* higher levels unchanged */
+
+        /* Buckets passed over have expired; now's own bucket cascades */
+        for (b = tw_next_occupied(wheel, level, old_idx + 1u); b <= new_idx;
+             b = tw_next_occupied(wheel, level, b + 1u)) {
+            ASX_CHECKPOINT_WAIVER("bounded by TW_SLOTS");
+            timer_place_list(wheel, bucket_take(wheel, level * TW_SLOTS + b));
+        }
+        return;
+    }
+
+    /* Top level wrapped: far timers may now fit in the wheel */
+    timer_place_list(wheel, bucket_take(wheel, TW_BUCKET_OVERFLOW));
+}
+
+/* Detach the maximal ordered run at the front of *list (run is
+ * NONE-terminated); returns its head and sets *out_tail. */
+static uint32_t due_take_run(asx_timer_wheel *wheel, uint32_t *list,
+                             uint32_t *out_tail)
+{
+    uint32_t head = *list;
+    uint32_t last = head;
+    asx_timer_slot *ls = timer_at(wheel, head);
+
+    while (ls->next != TW_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+        asx_timer_slot *ns = timer_at(wheel, ls->next);
+        if (timer_before(ns, ls)) break;
+        last = ls->next;
+        ls = ns;
+    }
+    *list = ls->next;
+    ls->next = TW_LINK_NONE;
+    *out_tail = last;
+    return head;
+}
+
+/* Stable merge of two ordered runs; a wins ties. Sets *out_tail. */
+static uint32_t due_merge(asx_timer_wheel *wheel, uint32_t a, uint32_t b,
+                          uint32_t *out_tail)
+{
+    uint32_t head = TW_LINK_NONE;
+    uint32_t tail = TW_LINK_NONE;
+
+    while (a != TW_LINK_NONE || b != TW_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+        uint32_t e;
+        if (b == TW_LINK_NONE ||
+            (a != TW_LINK_NONE &&
+             !timer_before(timer_at(wheel, b), timer_at(wheel, a)))) {
+            e = a;
+            a = timer_at(wheel, a)->next;
+        } else {
+            e = b;
+            b = timer_at(wheel, b)->next;
+        }
+        if (tail == TW_LINK_NONE) {
+            head = e;
+        } else {
+            timer_at(wheel, tail)->next = e;
+        }
+        tail = e;
+    }
+    *out_tail = tail;
+    return head;
+}
+
+/* Natural merge sort of the due list: merge adjacent ordered runs
+ * until one remains, so an already-ordered list costs one pass. */
+static void timer_sort_due(asx_timer_wheel *wheel)
+{
+    uint32_t list = tw_head(wheel, TW_BUCKET_DUE);
+    uint32_t tail = TW_LINK_NONE;
+    uint32_t prev;
+    uint32_t i;
+
+    if (wheel->due_sorted) return;
+    wheel->due_sorted = 1;
+    if (list == TW_LINK_NONE) return;
+
+    for (;;) {
+        uint32_t out_head = TW_LINK_NONE;
+        uint32_t out_tail = TW_LINK_NONE;
+        uint32_t runs = 0;
+
+        ASX_CHECKPOINT_WAIVER("bounded by log2(live timer count) passes");
+        while (list != TW_LINK_NONE) {
+            uint32_t a, b, a_tail, b_tail, m, m_tail;
+
+            ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+            a = due_take_run(wheel, &list, &a_tail);
+            if (list != TW_LINK_NONE) {
+                b = due_take_run(wheel, &list, &b_tail);
+                m = due_merge(wheel, a, b, &m_tail);
+            } else {
+                m = a;
+                m_tail = a_tail;
+            }
+            if (out_tail == TW_LINK_NONE) {
+                out_head = m;
+            } else {
+                timer_at(wheel, out_tail)->next = m;
+            }
+            out_tail = m_tail;
+            runs++;
+        }
+        list = out_head;
+        tail = out_tail;
+        if (runs <= 1) break;
+    }
+
+    tw_set_head(wheel, TW_BUCKET_DUE, list);
+    tw_set_tail(wheel, TW_BUCKET_DUE, tail);
+    prev = TW_LINK_NONE;
+    for (i = list; i != TW_LINK_NONE; i = timer_at(wheel, i)->next) {
+        ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+        timer_at(wheel, i)->prev = prev;
+        prev = i;
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Slot arena
+ * ------------------------------------------------------------------- */
+
+static void timer_map_set(asx_timer_wheel *wheel, uint32_t idx)
+{
+    uint32_t w = idx / 64u;
+
+    wheel->free_map[w] |= (uint64_t)1 << (idx % 64u);
+    wheel->free_summary[w / 64u] |= (uint64_t)1 << (w % 64u);
+}
+
+static void timer_map_clear(asx_timer_wheel *wheel, uint32_t idx)
+{
+    uint32_t w = idx / 64u;
+
+    wheel->free_map[w] &= ~((uint64_t)1 << (idx % 64u));
+    if (wheel->free_map[w] == 0) {
+        wheel->free_summary[w / 64u] &= ~((uint64_t)1 << (w % 64u));
+    }
+}
+
+/* Mark every slot of chunk c free */
+static void timer_chunk_add(asx_timer_wheel *wheel, uint32_t c)
+{
+    uint32_t w;
+
+    for (w = c * TW_CHUNK_WORDS; w < (c + 1u) * TW_CHUNK_WORDS; w++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_CHUNK_WORDS");
+        wheel->free_map[w] = ~(uint64_t)0;
+        wheel->free_summary[w / 64u] |= (uint64_t)1 << (w % 64u);
+    }
+    wheel->free_count += ASX_MAX_TIMERS;
+    wheel->capacity += ASX_MAX_TIMERS;
+}
+
+static int timer_chunk_empty(const asx_timer_wheel *wheel, uint32_t c)
+{
+    uint32_t w;
+
+    for (w = c * TW_CHUNK_WORDS; w < (c + 1u) * TW_CHUNK_WORDS; w++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_CHUNK_WORDS");
+        if (wheel->free_map[w] != ~(uint64_t)0) return 0;
+    }
+    return 1;
+}
+
+/* Return the empty grown chunk c, the top one, to the allocator */
+static void timer_chunk_release(asx_timer_wheel *wheel, uint32_t c)
+{
+    asx_timer_slot *chunk = wheel->chunks[c];
     uint32_t i;
-    if (wheel == NULL) return;
 
     for (i = 0; i < ASX_MAX_TIMERS; i++) {
-        wheel->slots[i].deadline = 0;
-        wheel->slots[i].waker_data = NULL;
-        wheel->slots[i].insertion_seq = 0;
-        wheel->slots[i].generation = 0;
-        wheel->slots[i].alive = 0;
+        if (chunk[i].generation > wheel->generation_floor) {
+            wheel->generation_floor = chunk[i].generation;
+        }
+    }
+    for (i = c * TW_CHUNK_WORDS; i < (c + 1u) * TW_CHUNK_WORDS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_CHUNK_WORDS");
+        wheel->free_map[i] = 0;
+        wheel->free_summary[i / 64u] &= ~((uint64_t)1 << (i % 64u));
+    }
+    (void)asx_runtime_free(chunk);
+    wheel->chunks[c] = NULL;
+    wheel->free_count -= ASX_MAX_TIMERS;
+    wheel->capacity -= ASX_MAX_TIMERS;
+    wheel->trimmed++;
+}
+
+static asx_status timer_arena_grow(asx_timer_wheel *wheel)
+{
+    void *mem;
+    asx_timer_slot *chunk;
+    uint32_t i;
+
+    if (wheel->capacity >= ASX_ARENA_MAX_TIMERS) return ASX_E_RESOURCE_EXHAUSTED;
+    if (asx_runtime_alloc_tagged(ASX_ALLOC_TAG_TIMER,
+                                 sizeof(asx_timer_slot) * ASX_MAX_TIMERS, &mem) != ASX_OK) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    chunk = (asx_timer_slot *)mem;
+    for (i = 0; i < ASX_MAX_TIMERS; i++) {
+        timer_slot_init(&chunk[i], wheel->generation_floor);
+    }
+    wheel->chunks[wheel->capacity / ASX_MAX_TIMERS] = chunk;
+    timer_chunk_add(wheel, wheel->capacity / ASX_MAX_TIMERS);
+    return ASX_OK;
+}
+
+/* Return empty top chunks while a whole chunk of free slots would
+ * remain below them, so a burst right after a trim does not regrow.
+ * A sealed allocator could not regrow at all: the arena keeps its size. */
+static void timer_arena_trim(asx_timer_wheel *wheel)
+{
+    const asx_runtime_hooks *hooks;
+
+    if (wheel->capacity <= ASX_MAX_TIMERS ||
+        wheel->free_count < 2u * ASX_MAX_TIMERS) {
+        return;
+    }
+    hooks = asx_runtime_get_hooks();
+    if (hooks == NULL || hooks->allocator_sealed) return;
+    while (wheel->capacity > ASX_MAX_TIMERS &&
+           wheel->free_count >= 2u * ASX_MAX_TIMERS) {
+        uint32_t c = wheel->capacity / ASX_MAX_TIMERS - 1u;
+
+        ASX_CHECKPOINT_WAIVER("bounded by TW_CHUNK_LIMIT");
+        if (!timer_chunk_empty(wheel, c)) return;
+        timer_chunk_release(wheel, c);
     }
-    wheel->slot_count = 0;
+}
+
+/* -------------------------------------------------------------------
+ * Init / Reset
+ * ------------------------------------------------------------------- */
+
+/* Empty every bucket and mark chunk 0 free. Only the free-map words
+ * below the old capacity can be set, so a wheel that never grew
+ * touches two of them. */
+static void timer_wheel_clear(asx_timer_wheel *wheel)
+{
+    uint32_t i;
+
+    memset(wheel->head, 0, sizeof(wheel->head));
+    memset(wheel->tail, 0, sizeof(wheel->tail));
+    memset(wheel->occupied, 0, sizeof(wheel->occupied));
+    memset(wheel->free_map, 0, (size_t)(wheel->capacity / 64u) * sizeof(uint64_t));
+    memset(wheel->free_summary, 0, sizeof(wheel->free_summary));
+    wheel->capacity = 0;
+    wheel->free_count = 0;
+    wheel->trimmed = 0;
+    timer_chunk_add(wheel, 0);
     wheel->active_count = 0;
     wheel->next_insertion = 0;
     wheel->current_time = 0;
     wheel->max_duration_ns = ASX_TIMER_MAX_DURATION_NS;
+    wheel->due_sorted = 1;
+    wheel->next_valid = 0;
+    wheel->next_deadline = 0;
+    for (i = 0; i < TW_COALESCE_WAYS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_COALESCE_WAYS");
+        wheel->coalesce[i] = TW_LINK_NONE;
+    }
+}
+
+/* The wheel's storage is zeroed (static or context storage), where
+ * every bucket is already empty and a zeroed slot already reads as
+ * free; slots are initialized as they are first taken, so the embedded
+ * chunk's untouched pages stay untouched. */
+void asx_timer_wheel_init(asx_timer_wheel *wheel)
+{
+    uint32_t i;
+    if (wheel == NULL) return;
+
+    wheel->chunks[0] = wheel->base;
+    wheel->max_duration_ns = ASX_TIMER_MAX_DURATION_NS;
+    wheel->due_sorted = 1;
+    for (i = 0; i < TW_COALESCE_WAYS; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_COALESCE_WAYS");
+        wheel->coalesce[i] = TW_LINK_NONE;
+    }
+    timer_chunk_add(wheel, 0);
 }
 
+/* Grown chunks are returned to the allocator hook and the wheel
+ * shrinks back to its embedded chunk; their generations raise the
+ * floor, as for a trim. */
 void asx_timer_wheel_reset(asx_timer_wheel *wheel)
 {
     uint32_t i;
 
     if (wheel == NULL) return;
 
-    for (i = 0; i < ASX_MAX_TIMERS; i++) {
-        wheel->slots[i].deadline = 0;
-        wheel->slots[i].waker_data = NULL;
-        wheel->slots[i].insertion_seq = 0;
+    for (i = 0; i < wheel->primed; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TIMERS");
         /* Preserve stale-handle safety across reset epochs. */
-        wheel->slots[i].generation = asx_timer_next_generation(wheel->slots[i].generation);
-        wheel->slots[i].alive = 0;
+        timer_slot_init(&wheel->base[i],
+                        asx_timer_next_generation(wheel->base[i].generation));
     }
-    wheel->slot_count = 0;
-    wheel->active_count = 0;
-    wheel->next_insertion = 0;
-    wheel->current_time = 0;
-    wheel->max_duration_ns = ASX_TIMER_MAX_DURATION_NS;
+    for (i = 1; i < TW_CHUNK_LIMIT; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_CHUNK_LIMIT");
+        if (wheel->chunks[i] != NULL) {
+            uint32_t k;
+            for (k = 0; k < ASX_MAX_TIMERS; k++) {
+                if (wheel->chunks[i][k].generation > wheel->generation_floor) {
+                    wheel->generation_floor = wheel->chunks[i][k].generation;
+                }
+            }
+            (void)asx_runtime_free(wheel->chunks[i]);
+            wheel->chunks[i] = NULL;
+        }
+    }
+    timer_wheel_clear(wheel);
 }
 
 /* -------------------------------------------------------------------
  * Timer registration
  * ------------------------------------------------------------------- */
 
-asx_status asx_timer_register(asx_timer_wheel *wheel,
+static int timer_duration_ok(const asx_timer_wheel *wheel, asx_time deadline)
+{
+    return deadline <= wheel->current_time ||
+           deadline - wheel->current_time <= wheel->max_duration_ns;
+}
+
+/* Take the lowest free slot, growing the arena if none is left */
+static asx_status timer_slot_alloc(asx_timer_wheel *wheel, uint32_t *out_idx)
+{
+    uint32_t s = 0;
+    uint32_t w;
+
+    if (wheel->free_count == 0 && timer_arena_grow(wheel) != ASX_OK) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    while (wheel->free_summary[s] == 0) {
+        ASX_CHECKPOINT_WAIVER("bounded by TW_SUMMARY_WORDS");
+        s++;
+    }
+    w = s * 64u + asx_ctz64(wheel->free_summary[s]);
+    *out_idx = w * 64u + asx_ctz64(wheel->free_map[w]);
+    timer_map_clear(wheel, *out_idx);
+    if (*out_idx >= wheel->primed && *out_idx < ASX_MAX_TIMERS) {
+        /* The lowest free slot is taken, so chunk 0 primes in order */
+        timer_slot_init(&wheel->base[*out_idx], 0);
+        wheel->primed = *out_idx + 1u;
+    }
+    wheel->free_count--;
+    return ASX_OK;
+}
+
+/* Free an unlinked slot, trimming the arena if that empties its top */
+static void timer_slot_free(asx_timer_wheel *wheel, uint32_t idx)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
+
+    s->alive = 0;
+    s->kind = TW_KIND_TIMER;
+    timer_map_set(wheel, idx);
+    wheel->free_count++;
+    timer_arena_trim(wheel);
+}
+
+/* Stamp a freshly allocated slot with its deadline and sequence */
+static asx_timer_slot *timer_arm(asx_timer_wheel *wheel, uint32_t idx,
+                                 asx_time deadline, void *waker_data,
+                                 uint8_t kind)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
+
+    s->deadline = deadline;
+    s->waker_data = waker_data;
+    s->insertion_seq = wheel->next_insertion++;
+    s->generation = asx_timer_next_generation(s->generation);
+    s->group = TW_LINK_NONE;
+    s->group_tail = TW_LINK_NONE;
+    s->alive = kind != TW_KIND_GROUP;
+    s->kind = kind;
+    return s;
+}
+
+/* Count a new live timer, keeping the cached minimum exact without a
+ * rescan, and hand out its handle */
+static void timer_count_new(asx_timer_wheel *wheel, uint32_t idx,
+                            asx_timer_handle *out_handle)
+{
+    const asx_timer_slot *s = timer_at(wheel, idx);
+
+    if (wheel->active_count == 0) {
+        wheel->next_deadline = s->deadline;
+        wheel->next_valid = 1;
+    } else if (wheel->next_valid && s->deadline < wheel->next_deadline) {
+        wheel->next_deadline = s->deadline;
+    }
+    wheel->active_count++;
+
+    out_handle->slot = idx;
+    out_handle->generation = s->generation;
+}
+
+/* Register one timer on a validated wheel (shared by single and batch). */
+static asx_status timer_insert(asx_timer_wheel *wheel,
                                asx_time deadline,
                                void *waker_data,
                                asx_timer_handle *out_handle)
 {
     uint32_t idx;
-    uint64_t delta;
 
+    if (!timer_duration_ok(wheel, deadline)) return ASX_E_TIMER_DURATION_EXCEEDED;
+    if (timer_slot_alloc(wheel, &idx) != ASX_OK) return ASX_E_RESOURCE_EXHAUSTED;
+
+    (void)timer_arm(wheel, idx, deadline, waker_data, TW_KIND_TIMER);
+    timer_place(wheel, idx);
+    timer_count_new(wheel, idx, out_handle);
+    return ASX_OK;
+}
+
+asx_status asx_timer_register(asx_timer_wheel *wheel,
+                               asx_time deadline,
+                               void *waker_data,
+                               asx_timer_handle *out_handle)
+{
     if (wheel == NULL || out_handle == NULL) return ASX_E_INVALID_ARGUMENT;
+    return timer_insert(wheel, deadline, waker_data, out_handle);
+}
+
+/* Items are applied in array order, so insertion_seq, slot reuse and
+ * per-item failures are exactly those of sequential register calls. */
+asx_status asx_timer_register_batch(asx_timer_wheel *wheel,
+                                     const asx_time *deadlines,
+                                     void *const *waker_data,
+                                     uint32_t count,
+                                     asx_timer_handle *out_handles,
+                                     asx_status *out_status)
+{
+    asx_status first = ASX_OK;
+    uint32_t i;
 
-    /* Validate duration */
-    if (deadline > wheel->current_time) {
-        delta = deadline - wheel->current_time;
-        if (delta > wheel->max_duration_ns) {
-            return ASX_E_TIMER_DURATION_EXCEEDED;
+    if (wheel == NULL || out_handles == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (count > 0 && deadlines == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by caller batch count");
+        asx_status st = timer_insert(wheel, deadlines[i],
+                                     waker_data != NULL ? waker_data[i] : NULL,
+                                     &out_handles[i]);
+        if (st != ASX_OK) {
+            out_handles[i].slot = TW_LINK_NONE;
+            out_handles[i].generation = 0;
+            if (first == ASX_OK) first = st;
         }
+        if (out_status != NULL) out_status[i] = st;
     }
+    return first;
+}
 
-    /* Find a free slot: try recycling a dead slot first */
-    idx = ASX_MAX_TIMERS; /* sentinel */
-    {
-        uint32_t i;
-        for (i = 0; i < wheel->slot_count; i++) {
-            ASX_CHECKPOINT_WAIVER("bounded: slot_count <= ASX_MAX_TIMERS");
-            if (!wheel->slots[i].alive) {
-                idx = i;
-                break;
-            }
-        }
+/* Fibonacci hash of a coalesced deadline to its cache way */
+static uint32_t timer_coalesce_way(asx_time deadline)
+{
+    return (uint32_t)((deadline * 0x9E3779B97F4A7C15ULL) >> (64u - TW_COALESCE_BITS));
+}
+
+/* The window is the largest power of two <= slack_ns, so members of a
+ * group share an aligned deadline at most slack_ns past their own. */
+asx_status asx_timer_register_coalesced(asx_timer_wheel *wheel,
+                                        asx_time deadline,
+                                        uint64_t slack_ns,
+                                        void *waker_data,
+                                        asx_timer_handle *out_handle)
+{
+    uint64_t window = slack_ns;
+    asx_time at;
+    uint32_t way;
+    uint32_t group;
+    uint32_t idx;
+    int fresh = 0;
+
+    if (wheel == NULL || out_handle == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (slack_ns == 0u || deadline <= wheel->current_time) {
+        return timer_insert(wheel, deadline, waker_data, out_handle);
+    }
+    while ((window & (window - 1u)) != 0u) {
+        ASX_CHECKPOINT_WAIVER("bounded by 64 bits");
+        window &= window - 1u;
+    }
+    if (deadline > UINT64_MAX - (window - 1u)) {
+        return timer_insert(wheel, deadline, waker_data, out_handle);
     }
+    at = (deadline + (window - 1u)) & ~(window - 1u);
+    if (!timer_duration_ok(wheel, at)) return ASX_E_TIMER_DURATION_EXCEEDED;
 
-    /* No dead slot found — allocate a new one */
-    if (idx == ASX_MAX_TIMERS) {
-        if (wheel->slot_count >= ASX_MAX_TIMERS) {
-            return ASX_E_RESOURCE_EXHAUSTED;
-        }
-        idx = wheel->slot_count++;
+    /* A cached group still heads its own deadline while it has members */
+    way = timer_coalesce_way(at);
+    group = wheel->coalesce[way];
+    if (group >= wheel->capacity ||
+        timer_at(wheel, group)->kind != TW_KIND_GROUP ||
+        timer_at(wheel, group)->deadline != at) {
+        if (timer_slot_alloc(wheel, &group) != ASX_OK) return ASX_E_RESOURCE_EXHAUSTED;
+        fresh = 1;
+    }
+    if (timer_slot_alloc(wheel, &idx) != ASX_OK) {
+        if (fresh) timer_slot_free(wheel, group);
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    if (fresh) {
+        (void)timer_arm(wheel, group, at, NULL, TW_KIND_GROUP);
+        timer_place(wheel, group);
+        wheel->coalesce[way] = group;
     }
+    (void)timer_arm(wheel, idx, at, waker_data, TW_KIND_MEMBER);
+    group_append(wheel, group, idx);
+    timer_count_new(wheel, idx, out_handle);
+    return ASX_OK;
+}
 
-    wheel->slots[idx].deadline = deadline;
-    wheel->slots[idx].waker_data = waker_data;
-    wheel->slots[idx].insertion_seq = wheel->next_insertion++;
-    wheel->slots[idx].generation = asx_timer_next_generation(wheel->slots[idx].generation);
-    wheel->slots[idx].alive = 1;
+/* Unlink a coalesced timer from its group, retiring the group once it
+ * is empty. */
+static void group_unlink(asx_timer_wheel *wheel, uint32_t idx)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
+    uint32_t group = s->group;
+    asx_timer_slot *g = timer_at(wheel, group);
 
-    wheel->active_count++;
+    if (s->prev == TW_LINK_NONE) {
+        g->group = s->next;
+    } else {
+        timer_at(wheel, s->prev)->next = s->next;
+    }
+    if (s->next == TW_LINK_NONE) {
+        g->group_tail = s->prev;
+    } else {
+        timer_at(wheel, s->next)->prev = s->prev;
+    }
+    s->prev = TW_LINK_NONE;
+    s->next = TW_LINK_NONE;
+    s->group = TW_LINK_NONE;
+    s->bucket = TW_BUCKET_NONE;
+    if (g->group == TW_LINK_NONE) {
+        bucket_unlink(wheel, group);
+        timer_slot_free(wheel, group);
+    }
+}
 
-    out_handle->slot = idx;
-    out_handle->generation = wheel->slots[idx].generation;
+/* Unlink a live timer and put its slot on the free list. */
+static void timer_retire(asx_timer_wheel *wheel, uint32_t idx)
+{
+    asx_timer_slot *s = timer_at(wheel, idx);
 
-    return ASX_OK;
+    if (s->kind == TW_KIND_MEMBER) {
+        group_unlink(wheel, idx);
+    } else {
+        bucket_unlink(wheel, idx);
+    }
+    if (s->deadline == wheel->next_deadline) {
+        wheel->next_valid = 0;
+    }
+    timer_slot_free(wheel, idx);
+    wheel->active_count--;
 }
 
 /* -------------------------------------------------------------------
  * Timer cancellation — O(1)
  * ------------------------------------------------------------------- */
 
-int asx_timer_cancel(asx_timer_wheel *wheel,
-                      const asx_timer_handle *handle)
+/* Cancel one handle on a validated wheel (shared by single and batch). */
+static int timer_cancel_one(asx_timer_wheel *wheel,
+                            const asx_timer_handle *handle)
 {
     asx_timer_slot *s;
 
-    if (wheel == NULL || handle == NULL) return 0;
-    if (handle->slot >= wheel->slot_count) return 0;
+    if (handle->slot >= wheel->capacity) return 0;
 
-    s = &wheel->slots[handle->slot];
+    s = timer_at(wheel, handle->slot);
 
     /* Check generation and liveness */
     if (!s->alive) return 0;
     if (s->generation != handle->generation) return 0;
 
-    /* Logical cancel: mark dead */
-    s->alive = 0;
-    wheel->active_count--;
+    timer_retire(wheel, handle->slot);
 
+    (void)asx_wake_source(ASX_PARK_TIMER, asx_park_key_timer(handle));
     return 1;
 }
 
+int asx_timer_cancel(asx_timer_wheel *wheel,
+                      const asx_timer_handle *handle)
+{
+    if (wheel == NULL || handle == NULL) return 0;
+    return timer_cancel_one(wheel, handle);
+}
+
+uint32_t asx_timer_cancel_batch(asx_timer_wheel *wheel,
+                                 const asx_timer_handle *handles,
+                                 uint32_t count,
+                                 int *out_cancelled)
+{
+    uint32_t cancelled = 0;
+    uint32_t i;
+
+    if (wheel == NULL || handles == NULL) return 0;
+
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by caller batch count");
+        int ok = timer_cancel_one(wheel, &handles[i]);
+        cancelled += (uint32_t)ok;
+        if (out_cancelled != NULL) out_cancelled[i] = ok;
+    }
+    return cancelled;
+}
+
 /* -------------------------------------------------------------------
  * Timer collection — deterministic ordering
  *
- * Collects all alive timers with deadline <= now.
- * Returns them sorted by (deadline ASC, insertion_seq ASC).
- * Uses insertion sort on the output for stability and simplicity.
+ * Advances the wheel (moving expired timers to the due list), sorts
+ * the due list by (deadline ASC, insertion_seq ASC), and fires its
+ * prefix with deadline <= now. Due timers beyond max_wakers stay due
+ * for the next call.
  * ------------------------------------------------------------------- */
 
 uint32_t asx_timer_collect_expired(asx_timer_wheel *wheel,
@@ -205,67 +1002,100 @@ uint32_t asx_timer_collect_expired(asx_timer_wheel *wheel,
                                     void **out_wakers,
                                     uint32_t max_wakers)
 {
-    uint32_t i, j, count;
-    /* Collect candidates: (slot_index, deadline, insertion_seq) */
-    uint32_t cand_idx[ASX_MAX_TIMERS];
-    uint64_t cand_deadline[ASX_MAX_TIMERS];
-    uint64_t cand_seq[ASX_MAX_TIMERS];
+    uint32_t count = 0;
 
     if (wheel == NULL) return 0;
 
     /* Advance current time */
     if (now > wheel->current_time) {
-        wheel->current_time = now;
+        timer_wheel_advance_to(wheel, now);
     }
 
     if (out_wakers == NULL || max_wakers == 0) return 0;
 
-    /* Scan for expired alive timers */
-    count = 0;
-    for (i = 0; i < wheel->slot_count && count < ASX_MAX_TIMERS; i++) {
-        asx_timer_slot *s = &wheel->slots[i];
-        if (!s->alive) continue;
-        if (s->deadline <= now) {
-            cand_idx[count] = i;
-            cand_deadline[count] = s->deadline;
-            cand_seq[count] = s->insertion_seq;
-            count++;
+    /* Emit wakers in sorted order, up to max_wakers. Tasks parked on
+     * a fired timer are woken in the same order. */
+    timer_sort_due(wheel);
+    while (count < max_wakers && tw_head(wheel, TW_BUCKET_DUE) != TW_LINK_NONE) {
+        ASX_CHECKPOINT_WAIVER("bounded: count <= max_wakers");
+        uint32_t idx = tw_head(wheel, TW_BUCKET_DUE);
+        asx_timer_slot *s = timer_at(wheel, idx);
+        asx_timer_handle fired;
+
+        if (s->deadline > now) break;
+        if (s->kind == TW_KIND_GROUP) {
+            /* A group fires its members in registration order */
+            idx = s->group;
+            s = timer_at(wheel, idx);
         }
+        out_wakers[count++] = s->waker_data;
+        fired.slot = idx;
+        fired.generation = s->generation;
+        timer_retire(wheel, idx); /* may trim the chunk holding s */
+        (void)asx_wake_source(ASX_PARK_TIMER, asx_park_key_timer(&fired));
     }
 
-    /* Sort by (deadline ASC, insertion_seq ASC) — insertion sort for stability */
-    for (i = 1; i < count; i++) {
-        ASX_CHECKPOINT_WAIVER("bounded: count <= ASX_MAX_TIMERS");
-        uint32_t  tmp_idx = cand_idx[i];
-        uint64_t  tmp_dl  = cand_deadline[i];
-        uint64_t  tmp_seq = cand_seq[i];
-        j = i;
-        while (j > 0 &&
-               (cand_deadline[j - 1] > tmp_dl ||
-                (cand_deadline[j - 1] == tmp_dl && cand_seq[j - 1] > tmp_seq))) {
-            ASX_CHECKPOINT_WAIVER("bounded: j <= count <= ASX_MAX_TIMERS");
-            cand_idx[j] = cand_idx[j - 1];
-            cand_deadline[j] = cand_deadline[j - 1];
-            cand_seq[j] = cand_seq[j - 1];
-            j--;
+    return count;
+}
+
+/* -------------------------------------------------------------------
+ * Next deadline
+ *
+ * Levels partition the future: every level-L timer fires before any
+ * timer on a higher level, and within a level bucket order is deadline
+ * order from now's bucket onward. The minimum is therefore the due
+ * head, else the first occupied bucket of the lowest nonempty level
+ * (one deadline per bucket on level 0), else the overflow minimum.
+ * The result is cached until a timer holding it retires.
+ * ------------------------------------------------------------------- */
+
+static asx_time timer_list_min(asx_timer_wheel *wheel, uint32_t i)
+{
+    asx_time best = timer_at(wheel, i)->deadline;
+
+    for (i = timer_at(wheel, i)->next; i != TW_LINK_NONE;
+         i = timer_at(wheel, i)->next) {
+        ASX_CHECKPOINT_WAIVER("bounded by live timer count");
+        if (timer_at(wheel, i)->deadline < best) {
+            best = timer_at(wheel, i)->deadline;
         }
-        cand_idx[j] = tmp_idx;
-        cand_deadline[j] = tmp_dl;
-        cand_seq[j] = tmp_seq;
     }
+    return best;
+}
 
-    /* Emit wakers in sorted order, up to max_wakers */
-    if (count > max_wakers) count = max_wakers;
+static asx_time timer_compute_next(asx_timer_wheel *wheel)
+{
+    uint32_t level;
 
-    for (i = 0; i < count; i++) {
-        ASX_CHECKPOINT_WAIVER("bounded: count <= max_wakers <= ASX_MAX_TIMERS");
-        asx_timer_slot *s = &wheel->slots[cand_idx[i]];
-        out_wakers[i] = s->waker_data;
-        s->alive = 0;
-        wheel->active_count--;
+    if (tw_head(wheel, TW_BUCKET_DUE) != TW_LINK_NONE) {
+        timer_sort_due(wheel);
+        return timer_at(wheel, tw_head(wheel, TW_BUCKET_DUE))->deadline;
     }
+    for (level = 0; level < TW_LEVELS; level++) {
+        uint32_t from = (uint32_t)(wheel->current_time >>
+                                   (TW_LEVEL_BITS * level)) & TW_SLOT_MASK;
+        uint32_t b;
+        ASX_CHECKPOINT_WAIVER("bounded by TW_LEVELS");
+        b = tw_next_occupied(wheel, level, from);
+        if (b < TW_SLOTS) {
+            return timer_list_min(wheel, tw_head(wheel, level * TW_SLOTS + b));
+        }
+    }
+    return timer_list_min(wheel, tw_head(wheel, TW_BUCKET_OVERFLOW));
+}
 
-    return count;
+asx_status asx_timer_next_deadline(asx_timer_wheel *wheel,
+                                   asx_time *out_deadline)
+{
+    if (wheel == NULL || out_deadline == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (wheel->active_count == 0) return ASX_E_NOT_FOUND;
+
+    if (!wheel->next_valid) {
+        wheel->next_deadline = timer_compute_next(wheel);
+        wheel->next_valid = 1;
+    }
+    *out_deadline = wheel->next_deadline;
+    return ASX_OK;
 }
 
 /* -------------------------------------------------------------------
@@ -299,6 +1129,29 @@ uint32_t asx_timer_active_count(const asx_timer_wheel *wheel)
     return wheel->active_count;
 }
 
+int asx_timer_is_live(const asx_timer_wheel *wheel,
+                      const asx_timer_handle *handle)
+{
+    const asx_timer_slot *s;
+
+    if (wheel == NULL || handle == NULL) return 0;
+    if (handle->slot >= wheel->capacity) return 0;
+
+    s = &wheel->chunks[handle->slot / ASX_MAX_TIMERS][handle->slot % ASX_MAX_TIMERS];
+    return s->alive && s->generation == handle->generation;
+}
+
+asx_status asx_timer_arena_query(const asx_timer_wheel *wheel,
+                                 asx_timer_arena_stats *out)
+{
+    if (wheel == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->capacity = wheel->capacity;
+    out->used = wheel->capacity - wheel->free_count;
+    out->free = wheel->free_count;
+    out->trimmed = wheel->trimmed;
+    return ASX_OK;
+}
+
 void asx_timer_set_max_duration(asx_timer_wheel *wheel,
                                  uint64_t max_duration_ns)
 {
@@ -310,6 +1163,6 @@ void asx_timer_advance(asx_timer_wheel *wheel, asx_time now)
 {
     if (wheel == NULL) return;
     if (now > wheel->current_time) {
-        wheel->current_time = now;
+        timer_wheel_advance_to(wheel, now);
     }
 }
@@ -1,9 +1,14 @@
 /*
  * bench_runtime.c — performance benchmark suite for asx runtime (bd-1md.6)
  *
- * Microbenchmarks for scheduler, timer wheel, channel, and quiescence
- * paths. Emits p50/p95/p99/p99.9/p99.99 plus jitter and deadline-miss
- * metrics in machine-readable JSON for CI gates and trend tracking.
+ * Microbenchmarks for scheduler, timer wheel, channel, quiescence and
+ * codec paths. Emits p50/p95/p99/p99.9/p99.99 plus jitter and deadline-miss
+ * metrics in machine-readable JSON for CI gates and trend tracking. A
+ * scaling matrix reports polls/sec and per-round latency as task count,
+ * region count, channel fan-in and (parallel builds) worker count grow.
+ * On Linux each benchmark also reports hardware counters (cycles,
+ * instructions, L1D/LLC read misses, branch misses) via perf_event_open;
+ * counters the host or platform cannot provide are reported as null.
  *
  * Build:  make bench
  * Run:    build/bench/bench_runtime [--json]
@@ -12,6 +17,9 @@
  */
 
 #define _POSIX_C_SOURCE 199309L
+#if defined(__linux__)
+#define _DEFAULT_SOURCE  /* syscall() for perf_event_open */
+#endif
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -19,9 +27,16 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <time.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include <asx/asx.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/parallel.h>
 #include <asx/time/timer_wheel.h>
 #include <asx/core/channel.h>
 #include <asx/core/adaptive.h>
@@ -39,11 +54,122 @@ static uint64_t bench_now_ns(void)
          + (uint64_t)ts.tv_nsec;
 }
 
+/* -------------------------------------------------------------------
+ * Hardware counters (Linux perf_event_open)
+ *
+ * Each counter is opened on its own, user space only, so one the host
+ * lacks (or perf_event_paranoid forbids) leaves the others working.
+ * Counts cover a whole benchmark call, setup included, and are scaled
+ * for multiplexing by time enabled / time running.
+ * ------------------------------------------------------------------- */
+
+typedef enum {
+    BENCH_HW_CYCLES = 0,
+    BENCH_HW_INSTRUCTIONS,
+    BENCH_HW_L1D_MISSES,
+    BENCH_HW_LLC_MISSES,
+    BENCH_HW_BRANCH_MISSES,
+    BENCH_HW_COUNT
+} bench_hw_counter;
+
+static const char *const g_hw_names[BENCH_HW_COUNT] = {
+    "cycles", "instructions", "l1d_read_misses", "llc_read_misses",
+    "branch_misses"
+};
+
+typedef struct {
+    uint64_t value[BENCH_HW_COUNT];
+    int      valid[BENCH_HW_COUNT];
+} bench_hw;
+
+#if defined(__linux__)
+
+static int g_hw_fd[BENCH_HW_COUNT] = { -1, -1, -1, -1, -1 };
+
+static int bench_hw_open(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#define BENCH_HW_CACHE_READ_MISS(cache)                    \
+    ((uint64_t)(cache) |                                   \
+     ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |        \
+     ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static void bench_hw_init(void)
+{
+    g_hw_fd[BENCH_HW_CYCLES] =
+        bench_hw_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    g_hw_fd[BENCH_HW_INSTRUCTIONS] =
+        bench_hw_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    g_hw_fd[BENCH_HW_L1D_MISSES] =
+        bench_hw_open(PERF_TYPE_HW_CACHE,
+                      BENCH_HW_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D));
+    g_hw_fd[BENCH_HW_LLC_MISSES] =
+        bench_hw_open(PERF_TYPE_HW_CACHE,
+                      BENCH_HW_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL));
+    g_hw_fd[BENCH_HW_BRANCH_MISSES] =
+        bench_hw_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+}
+
+static void bench_hw_start(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < BENCH_HW_COUNT; i++) {
+        if (g_hw_fd[i] < 0) continue;
+        ioctl(g_hw_fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(g_hw_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static void bench_hw_stop(bench_hw *hw)
+{
+    uint32_t i;
+
+    memset(hw, 0, sizeof(*hw));
+    for (i = 0; i < BENCH_HW_COUNT; i++) {
+        uint64_t buf[3];  /* value, time enabled, time running */
+
+        if (g_hw_fd[i] < 0) continue;
+        ioctl(g_hw_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(g_hw_fd[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf) ||
+            buf[2] == 0) {
+            continue;
+        }
+        hw->value[i] = buf[2] < buf[1]
+                     ? (uint64_t)((double)buf[0] * (double)buf[1] /
+                                  (double)buf[2])
+                     : buf[0];
+        hw->valid[i] = 1;
+    }
+}
+
+#else /* !__linux__ */
+
+static void bench_hw_init(void) {}
+static void bench_hw_start(void) {}
+static void bench_hw_stop(bench_hw *hw) { memset(hw, 0, sizeof(*hw)); }
+
+#endif
+
 /* -------------------------------------------------------------------
  * Sample collection and statistics
  * ------------------------------------------------------------------- */
 
 #define BENCH_MAX_SAMPLES 10000u
+#define BENCH_QUANTILES   256u   /* sample summary kept for the gate */
 
 typedef struct {
     uint64_t samples[BENCH_MAX_SAMPLES];
@@ -99,6 +225,8 @@ typedef struct {
     uint64_t p99_99;
     uint64_t jitter;  /* mean absolute deviation */
     uint32_t count;
+    uint64_t quantiles[BENCH_QUANTILES];  /* evenly spaced, min..max */
+    bench_hw hw;      /* whole benchmark call */
 } bench_stats;
 
 static bench_stats bench_compute_stats(bench_samples *s)
@@ -137,12 +265,23 @@ static bench_stats bench_compute_stats(bench_samples *s)
     st.p99_99 = bench_percentile(s, 99.99);
     st.count  = n;
 
+    for (i = 0; i < BENCH_QUANTILES; i++) {
+        st.quantiles[i] = s->samples[(uint64_t)i * (n - 1u) /
+                                     (BENCH_QUANTILES - 1u)];
+    }
+
     return st;
 }
 
+static void bench_gate_collect(const char *name, const bench_stats *st);
+
+/* Print one benchmark's stats and keep them for the regression gate */
 static void bench_print_stats_json(const char *name, const bench_stats *st,
                                    int last)
 {
+    uint32_t i;
+
+    bench_gate_collect(name, st);
     printf("    \"%s\": {\n", name);
     printf("      \"count\": %" PRIu32 ",\n", st->count);
     printf("      \"mean_ns\": %" PRIu64 ",\n", st->mean);
@@ -153,7 +292,17 @@ static void bench_print_stats_json(const char *name, const bench_stats *st,
     printf("      \"p99_ns\": %" PRIu64 ",\n", st->p99);
     printf("      \"p99_9_ns\": %" PRIu64 ",\n", st->p99_9);
     printf("      \"p99_99_ns\": %" PRIu64 ",\n", st->p99_99);
-    printf("      \"jitter_ns\": %" PRIu64 "\n", st->jitter);
+    printf("      \"jitter_ns\": %" PRIu64 ",\n", st->jitter);
+    printf("      \"hw\": {");
+    for (i = 0; i < BENCH_HW_COUNT; i++) {
+        printf("%s\"%s\": ", i == 0 ? "" : ", ", g_hw_names[i]);
+        if (st->hw.valid[i]) {
+            printf("%" PRIu64, st->hw.value[i]);
+        } else {
+            printf("null");
+        }
+    }
+    printf("}\n");
     printf("    }%s\n", last ? "" : ",");
 }
 
@@ -305,6 +454,52 @@ static bench_stats bench_scheduler_multi_round(void)
     return bench_compute_stats(&s);
 }
 
+/* -------------------------------------------------------------------
+ * BENCH 3b: Scheduler — per-round cost over a full task arena
+ *
+ * Measures: nanoseconds per scheduler round with ASX_MAX_TASKS tasks
+ * that all stay pending for many rounds. Each round polls every task,
+ * so this isolates the per-poll slot footprint (hot/cold task layout).
+ * ------------------------------------------------------------------- */
+
+#define BENCH_ROUND_POLLS 32
+
+static bench_stats bench_scheduler_round_full_arena(void)
+{
+    bench_samples s;
+    uint32_t iter;
+
+    bench_samples_init(&s);
+
+    for (iter = 0; iter < 1000; iter++) {
+        asx_region_id rid;
+        asx_task_id tid;
+        asx_budget budget;
+        uint64_t t0, t1;
+        uint32_t t_i;
+        countdown_ctx ctxs[ASX_MAX_TASKS];
+
+        asx_runtime_reset();
+        (void)asx_region_open(&rid);
+
+        for (t_i = 0; t_i < ASX_MAX_TASKS; t_i++) {
+            ctxs[t_i].remaining = BENCH_ROUND_POLLS;
+            (void)asx_task_spawn(rid, countdown_poll, &ctxs[t_i], &tid);
+        }
+
+        budget = asx_budget_from_polls(ASX_MAX_TASKS * (BENCH_ROUND_POLLS + 2u));
+
+        t0 = bench_now_ns();
+        (void)asx_scheduler_run(rid, &budget);
+        t1 = bench_now_ns();
+
+        /* BENCH_ROUND_POLLS pending rounds + the completing round */
+        bench_samples_add(&s, (t1 - t0) / (BENCH_ROUND_POLLS + 1u));
+    }
+
+    return bench_compute_stats(&s);
+}
+
 /* -------------------------------------------------------------------
  * BENCH 4: Timer wheel — register throughput
  *
@@ -461,6 +656,49 @@ static bench_stats bench_channel_send(void)
     return bench_compute_stats(&s);
 }
 
+/* -------------------------------------------------------------------
+ * BENCH 7b: Channel — batched reserve+send throughput
+ *
+ * Measures: the same N messages as BENCH 7 moved with one multi-permit
+ * reserve and one bulk commit.
+ * ------------------------------------------------------------------- */
+
+static bench_stats bench_channel_send_batch(void)
+{
+    bench_samples s;
+    uint32_t iter;
+
+    bench_samples_init(&s);
+
+    for (iter = 0; iter < 2000; iter++) {
+        asx_region_id rid;
+        asx_channel_id cid;
+        asx_send_permit permits[ASX_CHANNEL_MAX_CAPACITY];
+        uint64_t values[ASX_CHANNEL_MAX_CAPACITY];
+        uint64_t t0, t1;
+        uint32_t n;
+        uint32_t m_i;
+
+        asx_runtime_reset();
+        asx_channel_reset();
+        (void)asx_region_open(&rid);
+        (void)asx_channel_create(rid, ASX_CHANNEL_MAX_CAPACITY, &cid);
+        for (m_i = 0; m_i < ASX_CHANNEL_MAX_CAPACITY; m_i++) {
+            values[m_i] = (uint64_t)m_i;
+        }
+
+        t0 = bench_now_ns();
+        (void)asx_channel_try_reserve_many(cid, permits,
+                                           ASX_CHANNEL_MAX_CAPACITY, 1, &n);
+        (void)asx_send_permit_send_many(permits, values, n, &n);
+        t1 = bench_now_ns();
+
+        bench_samples_add(&s, t1 - t0);
+    }
+
+    return bench_compute_stats(&s);
+}
+
 /* -------------------------------------------------------------------
  * BENCH 8: Channel — recv throughput
  *
@@ -591,6 +829,42 @@ static bench_stats bench_budget_meet(void)
     return bench_compute_stats(&s);
 }
 
+/* Batch meet: 1000 child budgets clamped to one bound per sample. */
+static bench_stats bench_budget_meet_each(void)
+{
+    static asx_budget batch[1000];
+    bench_samples s;
+    asx_budget bound;
+    uint32_t iter;
+    uint32_t m_i;
+
+    bench_samples_init(&s);
+    bound.deadline = 5000;
+    bound.poll_quota = 100;
+    bound.cost_quota = 10000;
+    bound.priority = 3;
+
+    for (iter = 0; iter < BENCH_MAX_SAMPLES; iter++) {
+        uint64_t t0, t1;
+
+        for (m_i = 0; m_i < 1000; m_i++) {
+            batch[m_i] = asx_budget_infinite();
+            batch[m_i].poll_quota = 90u + (m_i & 0x1Fu);
+        }
+        t0 = bench_now_ns();
+        asx_budget_meet_each(batch, 1000u, &bound);
+        t1 = bench_now_ns();
+
+        if (batch[iter % 1000u].poll_quota > 100u) {
+            fprintf(stderr, "unexpected\n");
+        }
+
+        bench_samples_add(&s, t1 - t0);
+    }
+
+    return bench_compute_stats(&s);
+}
+
 /* -------------------------------------------------------------------
  * BENCH 11: Embedded pressure — scheduler under tight budget
  *
@@ -846,8 +1120,612 @@ static bench_adaptive_report bench_adaptive_metrics(void)
     return rpt;
 }
 
+/* -------------------------------------------------------------------
+ * BENCH 14: Codec — JSON fixture decode
+ *
+ * Measures: one owning decode plus reset of a fixture whose
+ * expected_events array holds 200 events (~24 KiB of JSON).
+ * ------------------------------------------------------------------- */
+
+#define BENCH_CODEC_EVENTS 200u
+
+static char g_bench_codec_json[32768];
+
+static void bench_codec_build_fixture(uint32_t events)
+{
+    size_t n = 0;
+    uint32_t i;
+
+    n += (size_t)snprintf(g_bench_codec_json + n, sizeof(g_bench_codec_json) - n,
+        "{\"codec\":\"json\",\"expected_error_codes\":[],\"expected_events\":[");
+    for (i = 0; i < events; i++) {
+        n += (size_t)snprintf(g_bench_codec_json + n, sizeof(g_bench_codec_json) - n,
+            "%s{\"kind\":\"task_spawn\",\"task_id\":\"task-%05u\","
+            "\"note\":\"spawned under region alpha\",\"seq\":%u}",
+            i ? "," : "", (unsigned)i, (unsigned)i);
+    }
+    (void)snprintf(g_bench_codec_json + n, sizeof(g_bench_codec_json) - n,
+        "],\"expected_final_snapshot\":{},\"fixture_schema_version\":\"fixture-v1\","
+        "\"input\":{\"ops\":[]},\"profile\":\"ASX_PROFILE_CORE\",\"provenance\":{"
+        "\"cargo_lock_sha256\":\"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\","
+        "\"capture_run_id\":\"bench\",\"rust_baseline_commit\":\"0123456789abcdef\","
+        "\"rust_toolchain_commit_hash\":\"toolchain\",\"rust_toolchain_host\":\"host\","
+        "\"rust_toolchain_release\":\"rustc\"},\"scenario_dsl_version\":\"dsl-v1\","
+        "\"scenario_id\":\"bench.codec\",\"seed\":42,\"semantic_digest\":"
+        "\"sha256:0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\"}");
+}
+
+static bench_stats bench_codec_json_decode(void)
+{
+    bench_samples s;
+    uint32_t iter;
+
+    bench_samples_init(&s);
+    bench_codec_build_fixture(BENCH_CODEC_EVENTS);
+
+    for (iter = 0; iter < BENCH_MAX_SAMPLES; iter++) {
+        asx_canonical_fixture fixture;
+        uint64_t t0, t1;
+        asx_status rc;
+
+        asx_canonical_fixture_init(&fixture);
+        t0 = bench_now_ns();
+        rc = asx_codec_decode_fixture_json(g_bench_codec_json, &fixture);
+        asx_canonical_fixture_reset(&fixture);
+        t1 = bench_now_ns();
+
+        if (rc != ASX_OK) {
+            fprintf(stderr, "unexpected\n");
+            break;
+        }
+        bench_samples_add(&s, t1 - t0);
+    }
+
+    return bench_compute_stats(&s);
+}
+
+/* -------------------------------------------------------------------
+ * BENCH 15: Codec — binary frame encode and decode
+ *
+ * Measures: 64 encodes (into one reused buffer) or 64 zero-copy view
+ * decodes of a small fixture frame, where keys and lengths, rather
+ * than payload bytes, dominate the work.
+ * ------------------------------------------------------------------- */
+
+#define BENCH_CODEC_FRAME_EVENTS 2u
+#define BENCH_CODEC_FRAME_REPS   64u
+
+static bench_stats bench_codec_bin_frame(int decode)
+{
+    bench_samples s;
+    asx_canonical_fixture fixture;
+    asx_codec_buffer frame;
+    uint32_t iter;
+
+    bench_samples_init(&s);
+    bench_codec_build_fixture(BENCH_CODEC_FRAME_EVENTS);
+    asx_canonical_fixture_init(&fixture);
+    asx_codec_buffer_init(&frame);
+    if (asx_codec_decode_fixture_json(g_bench_codec_json, &fixture) != ASX_OK ||
+        asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, &fixture, &frame) != ASX_OK) {
+        fprintf(stderr, "unexpected\n");
+        goto done;
+    }
+
+    for (iter = 0; iter < BENCH_MAX_SAMPLES; iter++) {
+        asx_codec_bin_fixture_view view;
+        uint64_t t0, t1;
+        asx_status rc = ASX_OK;
+        uint32_t r;
+
+        t0 = bench_now_ns();
+        for (r = 0; r < BENCH_CODEC_FRAME_REPS && rc == ASX_OK; r++) {
+            if (decode) {
+                rc = asx_codec_decode_fixture_bin_view(frame.data, frame.len, &view);
+            } else {
+                rc = asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, &fixture, &frame);
+            }
+        }
+        t1 = bench_now_ns();
+
+        if (rc != ASX_OK) {
+            fprintf(stderr, "unexpected\n");
+            break;
+        }
+        bench_samples_add(&s, t1 - t0);
+    }
+
+done:
+    asx_codec_buffer_reset(&frame);
+    asx_canonical_fixture_reset(&fixture);
+    return bench_compute_stats(&s);
+}
+
+/* -------------------------------------------------------------------
+ * BENCH 14: Scaling matrix — tasks x regions, channel fan-in, workers
+ *
+ * Measures: per-round latency and polls/sec while one dimension grows,
+ * so a cost that grows with the arena rather than with the work done
+ * shows up as a bend in the curve. Every task stays pending for
+ * BENCH_SCALE_ROUNDS polls; each scheduler call is given one round of
+ * polls and timed as one round sample. Task counts past the initial
+ * arena chunk are kept only if the arena can grow (tasks_spawned
+ * reports what was reached).
+ * ------------------------------------------------------------------- */
+
+#define BENCH_SCALE_ROUNDS      32u
+#define BENCH_SCALE_TARGET_POLLS 200000u  /* polls per point, all reps */
+#define BENCH_SCALE_MAX_TASKS   1024u
+#define BENCH_FANIN_MESSAGES    16u       /* per producer */
+
+typedef struct {
+    const char *sweep;
+    uint32_t tasks;          /* requested */
+    uint32_t tasks_spawned;
+    uint32_t regions;
+    uint32_t fan_in;         /* producers into one channel (0 = none) */
+    uint32_t workers;        /* 0 = asx_scheduler_run_all */
+    uint64_t polls;
+    uint64_t elapsed_ns;
+    bench_stats round;       /* per scheduler round */
+} bench_scale_point;
+
+static countdown_ctx g_scale_ctx[BENCH_SCALE_MAX_TASKS];
+static bench_samples g_scale_samples;
+
+typedef struct {
+    asx_channel_id cid;
+    uint32_t       left;     /* producer: messages still to send */
+    uint32_t       expected; /* consumer: messages still to read */
+} bench_fanin_ctx;
+
+static bench_fanin_ctx g_fanin_ctx[ASX_MAX_TASKS];
+
+static asx_status fanin_produce(void *user_data, asx_task_id self)
+{
+    bench_fanin_ctx *ctx = (bench_fanin_ctx *)user_data;
+    asx_send_permit permit;
+    (void)self;
+    if (asx_channel_try_reserve(ctx->cid, &permit) == ASX_OK) {
+        (void)asx_send_permit_send(&permit, (uint64_t)ctx->left);
+        ctx->left--;
+    }
+    return ctx->left > 0 ? ASX_E_PENDING : ASX_OK;
+}
+
+static asx_status fanin_consume(void *user_data, asx_task_id self)
+{
+    bench_fanin_ctx *ctx = (bench_fanin_ctx *)user_data;
+    uint64_t val;
+    (void)self;
+    while (ctx->expected > 0 && asx_channel_try_recv(ctx->cid, &val) == ASX_OK) {
+        ctx->expected--;
+    }
+    return ctx->expected > 0 ? ASX_E_PENDING : ASX_OK;
+}
+
+/* Spawn the point's tasks round-robin over its regions */
+static uint32_t bench_scale_setup(bench_scale_point *pt, asx_region_id *rids)
+{
+    asx_task_id tid;
+    uint32_t spawned = 0;
+    uint32_t i;
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    for (i = 0; i < pt->regions; i++) {
+        (void)asx_region_open(&rids[i]);
+    }
+
+    if (pt->fan_in > 0) {
+        asx_channel_id cid;
+
+        (void)asx_channel_create(rids[0], ASX_CHANNEL_MAX_CAPACITY, &cid);
+        for (i = 0; i < pt->fan_in; i++) {
+            g_fanin_ctx[i].cid = cid;
+            g_fanin_ctx[i].left = BENCH_FANIN_MESSAGES;
+            if (asx_task_spawn(rids[0], fanin_produce, &g_fanin_ctx[i],
+                               &tid) != ASX_OK) break;
+            spawned++;
+        }
+        g_fanin_ctx[spawned].cid = cid;
+        g_fanin_ctx[spawned].expected = spawned * BENCH_FANIN_MESSAGES;
+        if (asx_task_spawn(rids[0], fanin_consume, &g_fanin_ctx[spawned],
+                           &tid) == ASX_OK) {
+            spawned++;
+        }
+        return spawned;
+    }
+
+    for (i = 0; i < pt->tasks; i++) {
+        g_scale_ctx[i].remaining = (int)BENCH_SCALE_ROUNDS;
+        if (asx_task_spawn(rids[i % pt->regions], countdown_poll,
+                           &g_scale_ctx[i], &tid) != ASX_OK) break;
+        spawned++;
+    }
+    return spawned;
+}
+
+static void bench_scale_run(bench_scale_point *pt)
+{
+    asx_region_id rids[ASX_MAX_REGIONS];
+    uint32_t reps;
+    uint32_t rep;
+
+    bench_samples_init(&g_scale_samples);
+    pt->polls = 0;
+    pt->elapsed_ns = 0;
+    pt->tasks_spawned = bench_scale_setup(pt, rids);
+    reps = BENCH_SCALE_TARGET_POLLS /
+           ((pt->tasks_spawned + 1u) * BENCH_SCALE_ROUNDS) + 1u;
+
+    for (rep = 0; rep < reps; rep++) {
+        asx_status st;
+        uint32_t calls = 0;
+
+        if (rep > 0) (void)bench_scale_setup(pt, rids);
+#if defined(ASX_PROFILE_PARALLEL)
+        if (pt->workers > 0) {
+            asx_parallel_config cfg;
+
+            memset(&cfg, 0, sizeof(cfg));
+            cfg.worker_count = pt->workers;
+            cfg.fairness = ASX_FAIRNESS_ROUND_ROBIN;
+            cfg.lane_weights[0] = 1;
+            cfg.lane_weights[1] = 1;
+            cfg.lane_weights[2] = 1;
+            cfg.starvation_limit = 5;
+            asx_parallel_reset();
+            (void)asx_parallel_init(&cfg);
+        }
+#endif
+        do {
+            asx_budget budget = asx_budget_from_polls(pt->tasks_spawned);
+            uint64_t t0, t1;
+
+            t0 = bench_now_ns();
+#if defined(ASX_PROFILE_PARALLEL)
+            if (pt->workers > 0) {
+                st = asx_parallel_run_regions(rids, pt->regions, &budget);
+            } else
+#endif
+            {
+                st = asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_BY_TASKS);
+            }
+            t1 = bench_now_ns();
+
+            bench_samples_add(&g_scale_samples, t1 - t0);
+            pt->polls += pt->tasks_spawned - budget.poll_quota;
+            pt->elapsed_ns += t1 - t0;
+            calls++;
+        } while (st == ASX_E_POLL_BUDGET_EXHAUSTED &&
+                 calls < 4u * (BENCH_SCALE_ROUNDS + BENCH_FANIN_MESSAGES));
+    }
+    pt->round = bench_compute_stats(&g_scale_samples);
+}
+
+static void bench_print_scale_point_json(const bench_scale_point *pt)
+{
+    double secs = (double)pt->elapsed_ns / 1e9;
+
+    printf("    {\"sweep\": \"%s\", \"tasks\": %" PRIu32
+           ", \"tasks_spawned\": %" PRIu32 ", \"regions\": %" PRIu32
+           ", \"fan_in\": %" PRIu32 ", \"workers\": %" PRIu32
+           ", \"polls\": %" PRIu64 ", \"polls_per_sec\": %.0f"
+           ", \"round_mean_ns\": %" PRIu64 ", \"round_p50_ns\": %" PRIu64
+           ", \"round_p99_ns\": %" PRIu64 ", \"round_max_ns\": %" PRIu64
+           "}",
+           pt->sweep, pt->tasks, pt->tasks_spawned, pt->regions, pt->fan_in,
+           pt->workers, pt->polls,
+           secs > 0.0 ? (double)pt->polls / secs : 0.0,
+           pt->round.mean, pt->round.p50, pt->round.p99, pt->round.max_val);
+}
+
+static const uint32_t g_scale_tasks[] = { 1u, 4u, 16u, 64u, 256u, 1024u };
+static const uint32_t g_scale_regions[] = { 1u, 2u, ASX_MAX_REGIONS };
+static const uint32_t g_scale_fanin[] = { 1u, 4u, 16u, ASX_MAX_TASKS - 1u };
+#if defined(ASX_PROFILE_PARALLEL)
+static const uint32_t g_scale_workers[] = { 1u, 2u, 4u };
+#endif
+
+#define BENCH_COUNT_OF(a) ((uint32_t)(sizeof(a) / sizeof((a)[0])))
+
+static void bench_scaling_matrix(int json_only)
+{
+    bench_scale_point pt;
+    uint32_t i;
+    uint32_t j;
+    int first = 1;
+
+    printf("  \"scaling_report\": {\n");
+    printf("    \"rounds_per_task\": %" PRIu32 ",\n", BENCH_SCALE_ROUNDS);
+    printf("    \"points\": [\n");
+
+    for (i = 0; i < BENCH_COUNT_OF(g_scale_regions); i++) {
+        for (j = 0; j < BENCH_COUNT_OF(g_scale_tasks); j++) {
+            memset(&pt, 0, sizeof(pt));
+            pt.sweep = "tasks_x_regions";
+            pt.tasks = g_scale_tasks[j];
+            pt.regions = g_scale_regions[i];
+            if (pt.tasks < pt.regions) continue;
+            bench_scale_run(&pt);
+            if (!first) printf(",\n");
+            bench_print_scale_point_json(&pt);
+            first = 0;
+        }
+    }
+    for (i = 0; i < BENCH_COUNT_OF(g_scale_fanin); i++) {
+        memset(&pt, 0, sizeof(pt));
+        pt.sweep = "channel_fan_in";
+        pt.tasks = g_scale_fanin[i] + 1u;
+        pt.regions = 1;
+        pt.fan_in = g_scale_fanin[i];
+        bench_scale_run(&pt);
+        printf(",\n");
+        bench_print_scale_point_json(&pt);
+    }
+#if defined(ASX_PROFILE_PARALLEL)
+    /* Parallel lanes hold ASX_LANE_TASK_CAPACITY tasks across regions */
+    for (i = 0; i < BENCH_COUNT_OF(g_scale_workers); i++) {
+        memset(&pt, 0, sizeof(pt));
+        pt.sweep = "workers";
+        pt.tasks = ASX_LANE_TASK_CAPACITY;
+        pt.regions = 4;
+        pt.workers = g_scale_workers[i];
+        bench_scale_run(&pt);
+        printf(",\n");
+        bench_print_scale_point_json(&pt);
+    }
+#endif
+    printf("\n    ]\n");
+    printf("  }");
+
+    if (!json_only) fprintf(stderr, "done\n");
+}
+
+/* -------------------------------------------------------------------
+ * Regression gate — stored baselines and bootstrap comparison
+ *
+ * --baseline-out FILE stores each benchmark's quantile summary; a later
+ * --baseline FILE run of the same profile compares against it. For p50
+ * and p99, BENCH_BOOT_REPS bootstrap replicates resample both summaries
+ * (as many draws as each run had samples, up to BENCH_BOOT_DRAWS) and
+ * take the ratio current/baseline. A benchmark regresses when the lower
+ * end of the 95% interval of that ratio is above its budget, so noise
+ * within the interval never fails the gate. The resampler is seeded
+ * with a constant: one pair of summaries always gives one verdict.
+ * The interval covers sampling noise only, not drift between machines
+ * or runs, so noisy hosts may need wider budgets (--p50-budget-pct,
+ * --p99-budget-pct).
+ * ------------------------------------------------------------------- */
+
+#define BENCH_GATE_MAX          32u
+#define BENCH_GATE_NAME_MAX     48u
+#define BENCH_BOOT_REPS         400u
+#define BENCH_BOOT_DRAWS        1000u
+#define BENCH_GATE_P50_PCT      5u     /* default: p50 may grow 5% */
+#define BENCH_GATE_P99_PCT      10u    /* default: p99 may grow 10% */
+#define BENCH_BASELINE_MAGIC    "asx-bench-baseline"
+#define BENCH_BASELINE_VERSION  1
+
+typedef struct {
+    char        name[BENCH_GATE_NAME_MAX];
+    bench_stats st;
+} bench_gate_entry;
+
+static bench_gate_entry g_gate_current[BENCH_GATE_MAX];
+static uint32_t g_gate_current_count;
+static bench_gate_entry g_gate_baseline[BENCH_GATE_MAX];
+static uint32_t g_gate_baseline_count;
+static double g_gate_p50_budget = 1.0 + BENCH_GATE_P50_PCT / 100.0;
+static double g_gate_p99_budget = 1.0 + BENCH_GATE_P99_PCT / 100.0;
+
+static void bench_gate_collect(const char *name, const bench_stats *st)
+{
+    bench_gate_entry *e;
+
+    if (g_gate_current_count >= BENCH_GATE_MAX) return;
+    e = &g_gate_current[g_gate_current_count++];
+    snprintf(e->name, sizeof(e->name), "%s", name);
+    e->st = *st;
+}
+
+static const char *bench_profile_name(void)
+{
+#if defined(ASX_PROFILE_PARALLEL)
+    return "PARALLEL";
+#elif defined(ASX_PROFILE_EMBEDDED_ROUTER)
+    return "EMBEDDED_ROUTER";
+#elif defined(ASX_PROFILE_HFT)
+    return "HFT";
+#elif defined(ASX_PROFILE_AUTOMOTIVE)
+    return "AUTOMOTIVE";
+#elif defined(ASX_PROFILE_POSIX)
+    return "POSIX";
+#elif defined(ASX_PROFILE_WIN32)
+    return "WIN32";
+#elif defined(ASX_PROFILE_FREESTANDING)
+    return "FREESTANDING";
+#else
+    return "CORE";
+#endif
+}
+
+static int bench_baseline_save(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    uint32_t i;
+    uint32_t k;
+
+    if (f == NULL) return -1;
+    fprintf(f, "%s %d %s\n", BENCH_BASELINE_MAGIC, BENCH_BASELINE_VERSION,
+            bench_profile_name());
+    for (i = 0; i < g_gate_current_count; i++) {
+        const bench_gate_entry *e = &g_gate_current[i];
+
+        fprintf(f, "%s %" PRIu32, e->name, e->st.count);
+        for (k = 0; k < BENCH_QUANTILES; k++) {
+            fprintf(f, " %" PRIu64, e->st.quantiles[k]);
+        }
+        fprintf(f, "\n");
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/* Returns 0 on success, -1 if unreadable or for another profile */
+static int bench_baseline_load(const char *path)
+{
+    char magic[32];
+    char profile[32];
+    int version;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL) return -1;
+    if (fscanf(f, "%31s %d %31s", magic, &version, profile) != 3 ||
+        strcmp(magic, BENCH_BASELINE_MAGIC) != 0 ||
+        version != BENCH_BASELINE_VERSION ||
+        strcmp(profile, bench_profile_name()) != 0) {
+        fclose(f);
+        return -1;
+    }
+    g_gate_baseline_count = 0;
+    while (g_gate_baseline_count < BENCH_GATE_MAX) {
+        bench_gate_entry *e = &g_gate_baseline[g_gate_baseline_count];
+        uint32_t k;
+
+        if (fscanf(f, "%47s %" SCNu32, e->name, &e->st.count) != 2) break;
+        for (k = 0; k < BENCH_QUANTILES; k++) {
+            if (fscanf(f, "%" SCNu64, &e->st.quantiles[k]) != 1) break;
+        }
+        if (k != BENCH_QUANTILES) break;
+        g_gate_baseline_count++;
+    }
+    fclose(f);
+    return 0;
+}
+
+static uint64_t g_boot_rng;
+
+static uint32_t bench_boot_below(uint32_t n)
+{
+    /* xorshift64* */
+    g_boot_rng ^= g_boot_rng >> 12;
+    g_boot_rng ^= g_boot_rng << 25;
+    g_boot_rng ^= g_boot_rng >> 27;
+    return (uint32_t)(((g_boot_rng * UINT64_C(2685821657736338717)) >> 32)
+                      * (uint64_t)n >> 32);
+}
+
+/* One bootstrap replicate of a summary's p50 and p99 */
+static void bench_boot_draw(const bench_stats *st, uint64_t *p50, uint64_t *p99)
+{
+    static uint64_t draws[BENCH_BOOT_DRAWS];
+    uint32_t m = st->count < BENCH_BOOT_DRAWS ? st->count : BENCH_BOOT_DRAWS;
+    uint32_t i;
+
+    if (m == 0) m = 1;
+    for (i = 0; i < m; i++) {
+        draws[i] = st->quantiles[bench_boot_below(BENCH_QUANTILES)];
+    }
+    qsort(draws, (size_t)m, sizeof(draws[0]), cmp_u64);
+    *p50 = draws[(uint64_t)(m - 1u) * 50u / 100u];
+    *p99 = draws[(uint64_t)(m - 1u) * 99u / 100u];
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double va = *(const double *)a;
+    double vb = *(const double *)b;
+    if (va < vb) return -1;
+    if (va > vb) return  1;
+    return 0;
+}
+
+typedef struct {
+    double ratio;      /* from the summaries themselves */
+    double ci_lo;      /* 95% bootstrap interval */
+    double ci_hi;
+} bench_gate_ratio;
+
+static void bench_gate_compare(const bench_stats *cur, const bench_stats *base,
+                               bench_gate_ratio *r50, bench_gate_ratio *r99)
+{
+    static double ratio50[BENCH_BOOT_REPS];
+    static double ratio99[BENCH_BOOT_REPS];
+    uint32_t i;
+
+    g_boot_rng = UINT64_C(0x9E3779B97F4A7C15);
+    for (i = 0; i < BENCH_BOOT_REPS; i++) {
+        uint64_t c50, c99, b50, b99;
+
+        bench_boot_draw(cur, &c50, &c99);
+        bench_boot_draw(base, &b50, &b99);
+        /* +1 keeps a 0 ns baseline (timer granularity) finite */
+        ratio50[i] = (double)(c50 + 1u) / (double)(b50 + 1u);
+        ratio99[i] = (double)(c99 + 1u) / (double)(b99 + 1u);
+    }
+    qsort(ratio50, BENCH_BOOT_REPS, sizeof(double), cmp_double);
+    qsort(ratio99, BENCH_BOOT_REPS, sizeof(double), cmp_double);
+
+    r50->ratio = (double)(cur->quantiles[(BENCH_QUANTILES - 1u) * 50u / 100u] + 1u) /
+                 (double)(base->quantiles[(BENCH_QUANTILES - 1u) * 50u / 100u] + 1u);
+    r99->ratio = (double)(cur->quantiles[(BENCH_QUANTILES - 1u) * 99u / 100u] + 1u) /
+                 (double)(base->quantiles[(BENCH_QUANTILES - 1u) * 99u / 100u] + 1u);
+    r50->ci_lo = ratio50[BENCH_BOOT_REPS * 25u / 1000u];
+    r50->ci_hi = ratio50[BENCH_BOOT_REPS * 975u / 1000u];
+    r99->ci_lo = ratio99[BENCH_BOOT_REPS * 25u / 1000u];
+    r99->ci_hi = ratio99[BENCH_BOOT_REPS * 975u / 1000u];
+}
+
+/* Print the regression report; returns the number of regressions */
+static uint32_t bench_gate_report(const char *baseline_path)
+{
+    uint32_t regressions = 0;
+    uint32_t i;
+    uint32_t j;
+    int first = 1;
+
+    printf("  \"regression_report\": {\n");
+    printf("    \"baseline\": \"%s\",\n", baseline_path);
+    printf("    \"p50_budget\": %.2f,\n", g_gate_p50_budget);
+    printf("    \"p99_budget\": %.2f,\n", g_gate_p99_budget);
+    printf("    \"benchmarks\": [\n");
+    for (i = 0; i < g_gate_current_count; i++) {
+        const bench_gate_entry *cur = &g_gate_current[i];
+        bench_gate_ratio r50, r99;
+        int regressed;
+
+        for (j = 0; j < g_gate_baseline_count; j++) {
+            if (strcmp(g_gate_baseline[j].name, cur->name) == 0) break;
+        }
+        if (j == g_gate_baseline_count) continue;  /* new benchmark */
+
+        bench_gate_compare(&cur->st, &g_gate_baseline[j].st, &r50, &r99);
+        regressed = r50.ci_lo > g_gate_p50_budget ||
+                    r99.ci_lo > g_gate_p99_budget;
+        if (regressed) regressions++;
+
+        if (!first) printf(",\n");
+        first = 0;
+        printf("      {\"name\": \"%s\", \"p50_ratio\": %.4f"
+               ", \"p50_ci\": [%.4f, %.4f], \"p99_ratio\": %.4f"
+               ", \"p99_ci\": [%.4f, %.4f], \"regressed\": %s}",
+               cur->name, r50.ratio, r50.ci_lo, r50.ci_hi,
+               r99.ratio, r99.ci_lo, r99.ci_hi, regressed ? "true" : "false");
+    }
+    printf("\n    ],\n");
+    printf("    \"regressions\": %" PRIu32 "\n", regressions);
+    printf("  }");
+    return regressions;
+}
+
 /* -------------------------------------------------------------------
  * Main — run all benchmarks and emit JSON report
+ *
+ * Usage: bench_runtime [--json] [--baseline-out FILE] [--baseline FILE]
+ *                      [--p50-budget-pct N] [--p99-budget-pct N]
+ * Exit status 1 if --baseline finds a regression, 2 if the baseline
+ * cannot be read or was stored by another profile.
  * ------------------------------------------------------------------- */
 
 int main(int argc, char **argv)
@@ -856,13 +1734,34 @@ int main(int argc, char **argv)
     bench_deadline_report dlr;
     bench_adaptive_report adr;
     int json_only = 0;
-
-    (void)argc;
-    (void)argv;
-
-    /* Check for --json flag */
-    if (argc > 1 && strcmp(argv[1], "--json") == 0) {
-        json_only = 1;
+    const char *baseline_out = NULL;
+    const char *baseline_in = NULL;
+    uint32_t regressions = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json_only = 1;
+        } else if (strcmp(argv[i], "--baseline-out") == 0 && i + 1 < argc) {
+            baseline_out = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_in = argv[++i];
+        } else if (strcmp(argv[i], "--p50-budget-pct") == 0 && i + 1 < argc) {
+            g_gate_p50_budget = 1.0 + atof(argv[++i]) / 100.0;
+        } else if (strcmp(argv[i], "--p99-budget-pct") == 0 && i + 1 < argc) {
+            g_gate_p99_budget = 1.0 + atof(argv[++i]) / 100.0;
+        } else {
+            fprintf(stderr, "usage: %s [--json] [--baseline-out FILE]"
+                    " [--baseline FILE] [--p50-budget-pct N]"
+                    " [--p99-budget-pct N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (baseline_in != NULL && bench_baseline_load(baseline_in) != 0) {
+        fprintf(stderr, "[asx-bench] cannot use baseline %s"
+                " (missing, malformed or not %s)\n",
+                baseline_in, bench_profile_name());
+        return 2;
     }
 
     if (!json_only) {
@@ -873,27 +1772,13 @@ int main(int argc, char **argv)
         fprintf(stderr, "[asx-bench] Running benchmarks...\n\n");
     }
 
+    bench_hw_init();
+
     printf("{\n");
     printf("  \"version\": \"%d.%d.%d\",\n",
            ASX_API_VERSION_MAJOR, ASX_API_VERSION_MINOR,
            ASX_API_VERSION_PATCH);
-    printf("  \"profile\": \"");
-#if defined(ASX_PROFILE_EMBEDDED_ROUTER)
-    printf("EMBEDDED_ROUTER");
-#elif defined(ASX_PROFILE_HFT)
-    printf("HFT");
-#elif defined(ASX_PROFILE_AUTOMOTIVE)
-    printf("AUTOMOTIVE");
-#elif defined(ASX_PROFILE_POSIX)
-    printf("POSIX");
-#elif defined(ASX_PROFILE_WIN32)
-    printf("WIN32");
-#elif defined(ASX_PROFILE_FREESTANDING)
-    printf("FREESTANDING");
-#else
-    printf("CORE");
-#endif
-    printf("\",\n");
+    printf("  \"profile\": \"%s\",\n", bench_profile_name());
 
     printf("  \"deterministic\": %d,\n", ASX_DETERMINISTIC);
 
@@ -901,62 +1786,127 @@ int main(int argc, char **argv)
 
     /* Scheduler benchmarks */
     if (!json_only) fprintf(stderr, "  scheduler_single_task... ");
+    bench_hw_start();
     st = bench_scheduler_single_task();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("scheduler_single_task", &st, 0);
 
     if (!json_only) fprintf(stderr, "  scheduler_multi_task... ");
+    bench_hw_start();
     st = bench_scheduler_multi_task();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("scheduler_multi_task", &st, 0);
 
     if (!json_only) fprintf(stderr, "  scheduler_multi_round... ");
+    bench_hw_start();
     st = bench_scheduler_multi_round();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("scheduler_multi_round", &st, 0);
 
+    if (!json_only) fprintf(stderr, "  scheduler_round_full_arena... ");
+    bench_hw_start();
+    st = bench_scheduler_round_full_arena();
+    bench_hw_stop(&st.hw);
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns/round)\n", st.p50);
+    bench_print_stats_json("scheduler_round_full_arena", &st, 0);
+
     /* Timer benchmarks */
     if (!json_only) fprintf(stderr, "  timer_register... ");
+    bench_hw_start();
     st = bench_timer_register();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("timer_register", &st, 0);
 
     if (!json_only) fprintf(stderr, "  timer_cancel... ");
+    bench_hw_start();
     st = bench_timer_cancel();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("timer_cancel", &st, 0);
 
     if (!json_only) fprintf(stderr, "  timer_collect_expired... ");
+    bench_hw_start();
     st = bench_timer_collect();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("timer_collect_expired", &st, 0);
 
     /* Channel benchmarks */
     if (!json_only) fprintf(stderr, "  channel_send... ");
+    bench_hw_start();
     st = bench_channel_send();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("channel_send", &st, 0);
 
+    if (!json_only) fprintf(stderr, "  channel_send_batch... ");
+    bench_hw_start();
+    st = bench_channel_send_batch();
+    bench_hw_stop(&st.hw);
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("channel_send_batch", &st, 0);
+
     if (!json_only) fprintf(stderr, "  channel_recv... ");
+    bench_hw_start();
     st = bench_channel_recv();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("channel_recv", &st, 0);
 
     /* Quiescence benchmark */
     if (!json_only) fprintf(stderr, "  quiescence_drain... ");
+    bench_hw_start();
     st = bench_quiescence_drain();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("quiescence_drain", &st, 0);
 
     /* Budget algebra benchmark */
     if (!json_only) fprintf(stderr, "  budget_meet_1000x... ");
+    bench_hw_start();
     st = bench_budget_meet();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("budget_meet_1000x", &st, 0);
 
+    if (!json_only) fprintf(stderr, "  budget_meet_each_1000... ");
+    bench_hw_start();
+    st = bench_budget_meet_each();
+    bench_hw_stop(&st.hw);
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("budget_meet_each_1000", &st, 0);
+
+    /* Codec decode benchmark */
+    if (!json_only) fprintf(stderr, "  codec_json_decode... ");
+    bench_hw_start();
+    st = bench_codec_json_decode();
+    bench_hw_stop(&st.hw);
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("codec_json_decode", &st, 0);
+
+    if (!json_only) fprintf(stderr, "  codec_bin_encode_64x... ");
+    bench_hw_start();
+    st = bench_codec_bin_frame(0);
+    bench_hw_stop(&st.hw);
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("codec_bin_encode_64x", &st, 0);
+
+    if (!json_only) fprintf(stderr, "  codec_bin_decode_64x... ");
+    bench_hw_start();
+    st = bench_codec_bin_frame(1);
+    bench_hw_stop(&st.hw);
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("codec_bin_decode_64x", &st, 0);
+
     /* Embedded pressure benchmark */
     if (!json_only) fprintf(stderr, "  embedded_pressure... ");
+    bench_hw_start();
     st = bench_embedded_pressure();
+    bench_hw_stop(&st.hw);
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("embedded_pressure", &st, 1);
 
@@ -1008,13 +1958,29 @@ int main(int argc, char **argv)
     printf("    \"ledger_count\": %" PRIu32 ",\n", adr.ledger_count);
     printf("    \"ledger_overflowed\": %s\n",
            adr.ledger_overflowed ? "true" : "false");
-    printf("  }\n");
+    printf("  },\n");
 
-    printf("}\n");
+    if (!json_only) fprintf(stderr, "  scaling_matrix... ");
+    bench_scaling_matrix(json_only);
+
+    if (baseline_in != NULL) {
+        printf(",\n");
+        regressions = bench_gate_report(baseline_in);
+    }
+    printf("\n}\n");
 
+    if (baseline_out != NULL && bench_baseline_save(baseline_out) != 0) {
+        fprintf(stderr, "[asx-bench] cannot write baseline %s\n", baseline_out);
+        return 2;
+    }
     if (!json_only) {
         fprintf(stderr, "\n[asx-bench] All benchmarks complete.\n");
     }
+    if (regressions > 0) {
+        fprintf(stderr, "[asx-bench] %" PRIu32 " benchmark(s) regressed"
+                " against %s\n", regressions, baseline_in);
+        return 1;
+    }
 
     return 0;
 }
@@ -3,7 +3,8 @@
  *
  * Exercises: trace export/import round-trip, continuity check after
  * restart simulation, multi-task trace persistence, digest identity
- * across replays, corrupted trace detection, and snapshot capture.
+ * across replays, corrupted trace detection, snapshot capture, and
+ * automotive audit ring recovery from persisted flash pages.
  *
  * Output: one line per scenario in the format:
  *   SCENARIO <id> <pass|fail> [diagnostic]
@@ -15,6 +16,7 @@
 #include <asx/runtime/runtime.h>
 #include <asx/runtime/telemetry.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/automotive_instrument.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -391,6 +393,105 @@ static void scenario_snapshot_capture(void)
     SCENARIO_END();
 }
 
+/* Flash emulator: pages appended in order, as a NOR log would be */
+static uint8_t  g_flash[16u * ASX_AUTO_AUDIT_PAGE_BYTES];
+static uint32_t g_flash_len;
+static uint32_t g_flash_writes;
+
+static asx_status flash_append(void *ctx, const uint8_t *page, uint32_t len)
+{
+    (void)ctx;
+    if (g_flash_len + len > (uint32_t)sizeof(g_flash)) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    memcpy(g_flash + g_flash_len, page, len);
+    g_flash_len += len;
+    g_flash_writes++;
+    return ASX_OK;
+}
+
+/* Audit ring persisted by a scheduler task, recovered after restart */
+static void scenario_audit_ring_recovery(void)
+{
+    SCENARIO_BEGIN("continuity-audit-flash.recover_after_restart");
+
+    static asx_auto_audit_persist persist;
+    asx_auto_audit_ring *ring;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    uint32_t i;
+    uint32_t pages = 0;
+    uint32_t seq_before;
+
+    asx_runtime_reset();
+    asx_trace_reset();
+    asx_auto_instrument_reset();
+    g_flash_len = 0;
+    g_flash_writes = 0;
+    memset(g_flash, 0xFF, sizeof(g_flash));
+
+    ring = asx_auto_audit_global();
+    SCENARIO_CHECK(asx_auto_audit_persist_init(&persist, ring, flash_append,
+                                               NULL, 0) == ASX_OK,
+                   "persist_init");
+    SCENARIO_CHECK(asx_region_open(&rid) == ASX_OK, "region_open");
+    SCENARIO_CHECK(asx_task_spawn(rid, asx_auto_audit_persist_poll, &persist,
+                                  &tid) == ASX_OK,
+                   "spawn flush task");
+
+    /* Deadline misses between scheduler rounds */
+    for (i = 0; i < 20u; i++) {
+        asx_auto_record_deadline(1000u, 1500u + i, 0xA000u + i);
+        budget = asx_budget_from_polls(1);
+        IGNORE_RC(asx_scheduler_run(rid, &budget));
+    }
+    /* Only full pages so far */
+    SCENARIO_CHECK(g_flash_writes == 20u / ASX_AUTO_AUDIT_PAGE_ENTRIES,
+                   "flush task should batch full pages only");
+
+    asx_auto_audit_persist_stop(&persist);
+    budget = asx_budget_from_polls(10);
+    SCENARIO_CHECK(asx_scheduler_run(rid, &budget) == ASX_OK,
+                   "flush task drains on stop");
+    SCENARIO_CHECK(persist.lost == 0u, "no entries lost");
+    seq_before = ring->next_seq;
+
+    /* Restart: RAM state is gone, flash survives */
+    asx_runtime_reset();
+    asx_auto_instrument_reset();
+    SCENARIO_CHECK(asx_auto_audit_count(ring) == 0u, "ring cleared");
+
+    SCENARIO_CHECK(asx_auto_audit_recover(g_flash, (uint32_t)sizeof(g_flash),
+                                          ring, &pages) == ASX_OK,
+                   "recover");
+    SCENARIO_CHECK(pages == g_flash_writes, "every stored page recovered");
+    SCENARIO_CHECK(asx_auto_audit_count(ring) == 20u, "all entries back");
+    SCENARIO_CHECK(ring->next_seq == seq_before, "sequence continues");
+    for (i = 0; i < 20u; i++) {
+        const asx_audit_entry *e = asx_auto_audit_get(ring, i);
+        SCENARIO_CHECK(e != NULL && e->seq == i &&
+                       e->kind == ASX_AUDIT_DEADLINE_MISS &&
+                       e->entity_id == 0xA000u + i &&
+                       e->detail == -(int64_t)(500u + i),
+                       "recovered entry matches");
+    }
+
+    /* Appending after restart continues the log */
+    SCENARIO_CHECK(asx_auto_audit_persist_init(&persist, ring, flash_append,
+                                               NULL, pages) == ASX_OK,
+                   "persist_init_2");
+    asx_auto_record_deadline(1000u, 2000u, 0xB000u);
+    SCENARIO_CHECK(asx_auto_audit_persist_flush(&persist, 1) == ASX_OK,
+                   "sync flush");
+    SCENARIO_CHECK(asx_auto_audit_recover(g_flash, g_flash_len, ring,
+                                          &pages) == ASX_OK,
+                   "recover_2");
+    SCENARIO_CHECK(asx_auto_audit_count(ring) == 21u, "appended entry back");
+
+    SCENARIO_END();
+}
+
 /* -------------------------------------------------------------------
  * Main
  * ------------------------------------------------------------------- */
@@ -403,6 +504,7 @@ int main(void)
     scenario_multi_task_roundtrip();
     scenario_corrupted_trace_detected();
     scenario_snapshot_capture();
+    scenario_audit_ring_recovery();
 
     fprintf(stderr, "[e2e] continuity_restart: %d passed, %d failed\n",
             g_pass, g_fail);
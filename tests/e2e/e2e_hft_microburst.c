@@ -3,7 +3,8 @@
  *
  * Exercises: admission under load, deterministic overload handling,
  * fairness (round-robin no starvation), budget-bounded partial
- * completion, mass cancellation, and replay digest stability.
+ * completion, priority scheduling of the order path, mass
+ * cancellation, and replay digest stability.
  *
  * Output: one line per scenario in the format:
  *   SCENARIO <id> <pass|fail> [diagnostic]
@@ -211,6 +212,48 @@ static void scenario_fairness_partial_budget(void)
     SCENARIO_END();
 }
 
+/* hft-microburst-priority-002c: order path ahead of a bulk backlog */
+static void scenario_priority_order_path(void)
+{
+    SCENARIO_BEGIN("hft-microburst-priority-002c.order_path_first");
+    asx_runtime_reset();
+
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_task_id order;
+    void *state;
+    yield_once_state *ys;
+    asx_task_state ts;
+    uint32_t i;
+
+    SCENARIO_CHECK(asx_region_open(&rid) == ASX_OK, "region_open");
+
+    /* Bulk backlog spawned ahead of the order, at default priority */
+    for (i = 0; i < 8; i++) {
+        SCENARIO_CHECK(asx_task_spawn(rid, poll_pending, NULL, &tid) == ASX_OK,
+                       "spawn bulk");
+    }
+    SCENARIO_CHECK(asx_task_spawn_captured(rid, poll_yield_once,
+                   (uint32_t)sizeof(yield_once_state), NULL,
+                   &order, &state) == ASX_OK, "spawn order");
+    ys = (yield_once_state *)state;
+    ys->co.line = 0;
+    ys->done = 0;
+    SCENARIO_CHECK(asx_task_set_priority(order, 0) == ASX_OK, "set_priority");
+    SCENARIO_CHECK(asx_scheduler_set_mode(ASX_SCHED_MODE_PRIORITY, 4) == ASX_OK,
+                   "set_mode");
+
+    /* Round-robin would need 18 polls; priority needs the order's own 2 */
+    asx_budget budget = asx_budget_from_polls(2);
+    asx_status rc = asx_scheduler_run(rid, &budget);
+    SCENARIO_CHECK(rc == ASX_E_POLL_BUDGET_EXHAUSTED, "bulk still pending");
+    SCENARIO_CHECK(asx_task_get_state(order, &ts) == ASX_OK &&
+                   ts == ASX_TASK_COMPLETED, "order must complete first");
+
+    IGNORE_RC(asx_scheduler_set_mode(ASX_SCHED_MODE_ROUND_ROBIN, 0));
+    SCENARIO_END();
+}
+
 /* hft-overload-recovery-003: mass cancel + drain to quiescence */
 static void scenario_overload_recovery(void)
 {
@@ -318,6 +361,7 @@ int main(void)
     scenario_overload_saturation();
     scenario_fairness_round_robin();
     scenario_fairness_partial_budget();
+    scenario_priority_order_path();
     scenario_overload_recovery();
     scenario_replay_digest();
 
@@ -20,6 +20,10 @@
  *     --mutations <n>       Mutations per scenario (default: 4)
  *     --fixtures-dir <dir>  Path to Rust reference fixtures (optional)
  *     --report <path>       JSONL report output path (default: stdout)
+ *     --jobs <n>            Worker processes sharding the iterations (default: 1)
+ *     --corpus-dir <dir>    Store one failing scenario per trace digest
+ *     --minimize <path>     fuzz_minimize binary to run on new corpus entries
+ *     --guided              Mutate inputs that reach new trace transitions first
  *     --smoke               CI smoke mode (100 iterations, fast)
  *     --nightly             Nightly mode (100000 iterations)
  *     --verbose             Print each scenario to stderr
@@ -34,6 +38,11 @@
 #include <string.h>
 #include <stdint.h>
 #include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #include <asx/asx.h>
 #include <asx/time/timer_wheel.h>
@@ -501,6 +510,251 @@ static fuzz_mutation_record fuzz_mutate(fuzz_rng *rng, fuzz_scenario *sc)
     return rec;
 }
 
+/* ===================================================================
+ * Coverage feedback (--guided)
+ *
+ * After each op the executor reads the trace events emitted since the
+ * last look. Each event's entity is mapped to its region, task or
+ * obligation state, and the pair (event kind, previous state -> current
+ * state) sets one bit in the coverage map. Pairs whose states differ
+ * and that appear in the transition authority tables (transition.h)
+ * are also counted as covered edges. An input that sets a new bit is
+ * kept in a per-shard queue and mutated before anything else.
+ * =================================================================== */
+
+#define FUZZ_COV_KINDS       0x60u   /* trace kinds live below 0x60 */
+#define FUZZ_COV_TYPES       4u      /* other, region, task, obligation */
+#define FUZZ_COV_STATES      8u
+#define FUZZ_COV_NEW         7u      /* "from" slot of a first sighting */
+#define FUZZ_COV_BITS        (FUZZ_COV_KINDS * FUZZ_COV_TYPES * \
+                              FUZZ_COV_STATES * FUZZ_COV_STATES)
+#define FUZZ_COV_EDGE_BITS   (FUZZ_COV_TYPES * FUZZ_COV_STATES * FUZZ_COV_STATES)
+#define FUZZ_COV_ENTITIES    256u
+#define FUZZ_QUEUE_MAX       256u
+#define FUZZ_QUEUE_ENERGY    8u      /* mutants drawn from each new input */
+
+typedef struct {
+    uint8_t  bits[FUZZ_COV_BITS / 8u];
+    uint8_t  edges[FUZZ_COV_EDGE_BITS / 8u];
+    uint32_t pairs;
+    uint32_t edge_count;
+} fuzz_coverage;
+
+typedef struct {
+    fuzz_scenario entries[FUZZ_QUEUE_MAX];
+    uint32_t      energy[FUZZ_QUEUE_MAX];
+    uint32_t      count;
+    uint64_t      kept;               /* inputs that found something new */
+} fuzz_queue;
+
+static int           g_fuzz_cov_on = 0;
+static fuzz_coverage g_fuzz_cov_exec;   /* this execution */
+static fuzz_coverage g_fuzz_cov_total;  /* this shard so far */
+static uint32_t      g_fuzz_cov_cursor;
+static uint64_t      g_fuzz_cov_ent_id[FUZZ_COV_ENTITIES];
+static uint8_t       g_fuzz_cov_ent_state[FUZZ_COV_ENTITIES];
+static uint32_t      g_fuzz_cov_ent_count;
+
+static int fuzz_cov_set(uint8_t *bits, uint32_t bit)
+{
+    uint8_t mask = (uint8_t)(1u << (bit & 7u));
+
+    if (bits[bit >> 3] & mask) return 0;
+    bits[bit >> 3] |= mask;
+    return 1;
+}
+
+/* Coverage type slot and state of a handle; 0 for untracked types. */
+static uint32_t fuzz_cov_state_of(uint64_t handle, uint32_t *out_state)
+{
+    switch (asx_handle_type_tag(handle)) {
+    case ASX_TYPE_REGION: {
+        asx_region_state s;
+        if (asx_region_get_state(handle, &s) != ASX_OK) return 0u;
+        *out_state = (uint32_t)s;
+        return 1u;
+    }
+    case ASX_TYPE_TASK: {
+        asx_task_state s;
+        if (asx_task_get_state(handle, &s) != ASX_OK) return 0u;
+        *out_state = (uint32_t)s;
+        return 2u;
+    }
+    case ASX_TYPE_OBLIGATION: {
+        asx_obligation_state s;
+        if (asx_obligation_get_state(handle, &s) != ASX_OK) return 0u;
+        *out_state = (uint32_t)s;
+        return 3u;
+    }
+    default:
+        return 0u;
+    }
+}
+
+static int fuzz_cov_edge_legal(uint32_t type, uint32_t from, uint32_t to)
+{
+    switch (type) {
+    case 1u: return asx_region_transition_legal((asx_region_state)from,
+                                                (asx_region_state)to);
+    case 2u: return asx_task_transition_legal((asx_task_state)from,
+                                              (asx_task_state)to);
+    case 3u: return asx_obligation_transition_legal((asx_obligation_state)from,
+                                                    (asx_obligation_state)to);
+    default: return 0;
+    }
+}
+
+/* Number of legal edges in the authority tables, the edge denominator. */
+static uint32_t fuzz_cov_edge_total(void)
+{
+    uint32_t type, from, to, n = 0u;
+
+    for (type = 1u; type < FUZZ_COV_TYPES; type++) {
+        for (from = 0u; from < FUZZ_COV_NEW; from++) {
+            for (to = 0u; to < FUZZ_COV_NEW; to++) {
+                if (from != to && fuzz_cov_edge_legal(type, from, to)) n++;
+            }
+        }
+    }
+    return n;
+}
+
+static uint8_t *fuzz_cov_entity_slot(uint64_t handle)
+{
+    uint32_t i;
+
+    for (i = 0u; i < g_fuzz_cov_ent_count; i++) {
+        if (g_fuzz_cov_ent_id[i] == handle) return &g_fuzz_cov_ent_state[i];
+    }
+    if (g_fuzz_cov_ent_count == FUZZ_COV_ENTITIES) return NULL;
+    g_fuzz_cov_ent_id[g_fuzz_cov_ent_count] = handle;
+    g_fuzz_cov_ent_state[g_fuzz_cov_ent_count] = (uint8_t)FUZZ_COV_NEW;
+    return &g_fuzz_cov_ent_state[g_fuzz_cov_ent_count++];
+}
+
+static void fuzz_cov_begin(void)
+{
+    memset(&g_fuzz_cov_exec, 0, sizeof(g_fuzz_cov_exec));
+    g_fuzz_cov_cursor = 0u;
+    g_fuzz_cov_ent_count = 0u;
+    asx_trace_reset();
+}
+
+/* Fold the trace events since the last call into g_fuzz_cov_exec. The
+ * scheduler resets the trace when it runs, so those ops rescan it. */
+static void fuzz_cov_observe(fuzz_op_kind op_kind)
+{
+    uint32_t n = asx_trace_event_count();
+    uint32_t first = g_fuzz_cov_cursor;
+    uint32_t i;
+
+    if (op_kind == FUZZ_OP_SCHEDULER_RUN || op_kind == FUZZ_OP_REGION_DRAIN ||
+        n < first) {
+        first = 0u;
+    }
+    for (i = first; i < n; i++) {
+        asx_trace_event ev;
+        uint32_t kind, type, from, to = 0u;
+        uint32_t bit;
+        uint8_t *slot;
+
+        if (!asx_trace_event_get(i, &ev)) break;
+        kind = (uint32_t)ev.kind;
+        if (kind >= FUZZ_COV_KINDS) continue;
+        type = fuzz_cov_state_of(ev.entity_id, &to);
+        slot = type != 0u ? fuzz_cov_entity_slot(ev.entity_id) : NULL;
+        from = slot != NULL ? *slot : FUZZ_COV_NEW;
+        if (to >= FUZZ_COV_NEW) continue;
+        bit = ((kind * FUZZ_COV_TYPES + type) * FUZZ_COV_STATES + from) *
+              FUZZ_COV_STATES + to;
+        if (fuzz_cov_set(g_fuzz_cov_exec.bits, bit)) {
+            g_fuzz_cov_exec.pairs++;
+        }
+        if (from != FUZZ_COV_NEW && from != to &&
+            fuzz_cov_edge_legal(type, from, to) &&
+            fuzz_cov_set(g_fuzz_cov_exec.edges,
+                         (type * FUZZ_COV_STATES + from) * FUZZ_COV_STATES + to)) {
+            g_fuzz_cov_exec.edge_count++;
+        }
+        if (slot != NULL) *slot = (uint8_t)to;
+    }
+    g_fuzz_cov_cursor = n;
+}
+
+/* Merge the last execution into the shard total; nonzero if it added
+ * at least one new pair. */
+static uint32_t fuzz_cov_fold(uint8_t *total, const uint8_t *exec,
+                              uint32_t bytes)
+{
+    uint32_t i, added = 0u;
+
+    for (i = 0u; i < bytes; i++) {
+        uint8_t fresh = (uint8_t)(exec[i] & ~total[i]);
+
+        total[i] |= fresh;
+        for (; fresh != 0u; fresh &= (uint8_t)(fresh - 1u)) added++;
+    }
+    return added;
+}
+
+static int fuzz_cov_merge(void)
+{
+    uint32_t added;
+
+    if (g_fuzz_cov_exec.pairs == 0u) return 0;
+    added = fuzz_cov_fold(g_fuzz_cov_total.bits, g_fuzz_cov_exec.bits,
+                          (uint32_t)sizeof(g_fuzz_cov_total.bits));
+    g_fuzz_cov_total.pairs += added;
+    g_fuzz_cov_total.edge_count +=
+        fuzz_cov_fold(g_fuzz_cov_total.edges, g_fuzz_cov_exec.edges,
+                      (uint32_t)sizeof(g_fuzz_cov_total.edges));
+    return added != 0u;
+}
+
+/* Keep sc if its execution found new coverage. */
+static void fuzz_queue_offer(fuzz_queue *q, const fuzz_scenario *sc)
+{
+    uint32_t slot;
+
+    if (!fuzz_cov_merge()) return;
+    q->kept++;
+    slot = q->count < FUZZ_QUEUE_MAX ? q->count++
+                                     : (uint32_t)(q->kept % FUZZ_QUEUE_MAX);
+    q->entries[slot] = *sc;
+    q->energy[slot] = FUZZ_QUEUE_ENERGY;
+}
+
+/*
+ * Choose the next base scenario: a mutant of the newest kept input
+ * with energy left, else alternately a mutant of a random kept input
+ * or a freshly generated scenario.
+ */
+static void fuzz_queue_next(fuzz_rng *rng, fuzz_queue *q, uint32_t max_ops,
+                            uint32_t mutations, fuzz_scenario *sc)
+{
+    uint32_t pick = q->count;
+    uint32_t i;
+
+    for (i = q->count; i > 0u; i--) {
+        if (q->energy[i - 1u] > 0u) {
+            pick = i - 1u;
+            q->energy[pick]--;
+            break;
+        }
+    }
+    if (pick == q->count && q->count > 0u && fuzz_rng_u32(rng, 2u) == 0u) {
+        pick = fuzz_rng_u32(rng, q->count);
+    }
+    if (pick == q->count) {
+        fuzz_generate_scenario(rng, sc, max_ops);
+        return;
+    }
+    *sc = q->entries[pick];
+    for (i = 0u; i < mutations && i < 16u; i++) {
+        (void)fuzz_mutate(rng, sc);
+    }
+}
+
 /* ===================================================================
  * Scenario executor
  *
@@ -523,6 +777,7 @@ static void fuzz_execute(const fuzz_scenario *sc, fuzz_execution *exec)
     asx_channel_reset();
     asx_timer_wheel_reset(asx_timer_wheel_global());
     fuzz_reset_task_states();
+    if (g_fuzz_cov_on) fuzz_cov_begin();
 
     fuzz_hasher_init(&hasher);
     fuzz_hasher_u64(&hasher, sc->seed);
@@ -799,6 +1054,7 @@ static void fuzz_execute(const fuzz_scenario *sc, fuzz_execution *exec)
 
         exec->results[i].result = st;
         fuzz_hasher_i32(&hasher, (int32_t)st);
+        if (g_fuzz_cov_on) fuzz_cov_observe(op->kind);
     }
 
     /* Hash scheduler event log for extra determinism verification */
@@ -896,22 +1152,28 @@ static void fuzz_report_mismatch(FILE *out,
 static void fuzz_report_summary(FILE *out,
                                 uint64_t initial_seed,
                                 uint64_t iterations,
+                                uint32_t jobs,
                                 uint64_t determinism_failures,
                                 uint64_t crash_count,
+                                uint64_t unique_failures,
                                 double duration_sec)
 {
     fprintf(out,
         "{\"kind\":\"summary\","
         "\"initial_seed\":%llu,"
         "\"iterations\":%llu,"
+        "\"jobs\":%u,"
         "\"determinism_failures\":%llu,"
         "\"crashes\":%llu,"
+        "\"unique_failures\":%llu,"
         "\"duration_sec\":%.3f,"
         "\"iterations_per_sec\":%.1f}\n",
         (unsigned long long)initial_seed,
         (unsigned long long)iterations,
+        jobs,
         (unsigned long long)determinism_failures,
         (unsigned long long)crash_count,
+        (unsigned long long)unique_failures,
         duration_sec,
         iterations > 0 ? (double)iterations / duration_sec : 0.0);
     fflush(out);
@@ -919,63 +1181,89 @@ static void fuzz_report_summary(FILE *out,
 
 /* ===================================================================
  * Main fuzz loop
+ *
+ * The iteration range is split into one contiguous shard per job.
+ * Shard 0 draws from the initial seed itself, so a single-job run
+ * replays the sequential harness exactly; shard k starts its stream
+ * k golden-ratio steps further on. With more than one job each shard
+ * runs in a forked worker (the runtime is process-global state), and
+ * a worker that dies on a signal counts as a crash.
+ *
+ * Workers write mismatch records to their own temporary file. The
+ * parent merges them into the report, keys each by the digest of the
+ * failing trace, and stores one copy per digest in the corpus
+ * directory; a digest already on disk from an earlier run is not
+ * stored or minimized again. New entries are handed to fuzz_minimize
+ * when a minimizer binary is configured.
  * =================================================================== */
 
+#define FUZZ_MAX_JOBS        64u
+#define FUZZ_CORPUS_MAX      1024u
+#define FUZZ_LINE_MAX        65536u
+#define FUZZ_PATH_MAX        1024u
+
 typedef struct {
     uint64_t initial_seed;
     uint64_t iterations;
     uint32_t max_ops;
     uint32_t mutations_per_scenario;
+    uint32_t jobs;
     const char *fixtures_dir;
     const char *report_path;
+    const char *corpus_dir;      /* deduplicated failures, one file per digest */
+    const char *minimize_bin;    /* fuzz_minimize run on each new corpus entry */
+    int guided;                  /* coverage feedback from the trace */
     int verbose;
 } fuzz_config;
 
+typedef struct {
+    uint64_t seen[FUZZ_CORPUS_MAX];
+    uint32_t seen_count;
+    uint64_t unique;             /* distinct digests this run */
+    uint64_t stored;             /* new files written to the corpus */
+    uint64_t minimized;          /* minimizer runs that exited 0 */
+} fuzz_corpus;
+
+static char g_fuzz_line[FUZZ_LINE_MAX];
+
 static void fuzz_config_defaults(fuzz_config *cfg)
 {
     cfg->initial_seed = 0u;
     cfg->iterations = 1000u;
     cfg->max_ops = 64u;
     cfg->mutations_per_scenario = 4u;
+    cfg->jobs = 1u;
     cfg->fixtures_dir = NULL;
     cfg->report_path = NULL;
+    cfg->corpus_dir = NULL;
+    cfg->minimize_bin = NULL;
+    cfg->guided = 0;
     cfg->verbose = 0;
 }
 
-static int fuzz_run(const fuzz_config *cfg)
+static uint64_t fuzz_shard_seed(uint64_t initial_seed, uint32_t shard)
 {
+    return initial_seed + (uint64_t)shard * 0x9e3779b97f4a7c15ULL;
+}
+
+/* Run iterations [first, end) of the sequence seeded by seed, writing
+ * mismatch records to report. Returns the number of records written. */
+static uint64_t fuzz_run_shard(const fuzz_config *cfg, uint32_t shard,
+                               uint64_t seed, uint64_t first, uint64_t end,
+                               FILE *report)
+{
+    static fuzz_queue queue;
     fuzz_rng rng;
-    FILE *report;
     uint64_t iter;
     uint64_t determinism_failures = 0u;
-    uint64_t crash_count = 0u;
-    double start_time;
-    double end_time;
-    int exit_code = 0;
+    double start_time = fuzz_clock_sec();
 
-    fuzz_rng_seed(&rng, cfg->initial_seed);
+    fuzz_rng_seed(&rng, seed);
+    g_fuzz_cov_on = cfg->guided;
+    memset(&g_fuzz_cov_total, 0, sizeof(g_fuzz_cov_total));
+    memset(&queue, 0, sizeof(queue));
 
-    report = stdout;
-    if (cfg->report_path != NULL) {
-        report = fopen(cfg->report_path, "w");
-        if (report == NULL) {
-            fprintf(stderr, "[fuzz] error: cannot open report file: %s\n",
-                    cfg->report_path);
-            return 1;
-        }
-    }
-
-    fprintf(stderr,
-        "[fuzz] differential fuzz harness (bd-1md.3)\n"
-        "[fuzz] seed=%llu iterations=%llu max_ops=%u mutations=%u\n",
-        (unsigned long long)cfg->initial_seed,
-        (unsigned long long)cfg->iterations,
-        cfg->max_ops,
-        cfg->mutations_per_scenario);
-
-    start_time = fuzz_clock_sec();
-
-    for (iter = 0u; iter < cfg->iterations; iter++) {
+    for (iter = first; iter < end; iter++) {
         fuzz_scenario base_scenario;
         fuzz_scenario mutated;
         fuzz_execution exec_a;
@@ -984,12 +1272,19 @@ static int fuzz_run(const fuzz_config *cfg)
         uint32_t mut_count = 0u;
         uint32_t m;
 
-        /* Generate a random base scenario */
-        fuzz_generate_scenario(&rng, &base_scenario, cfg->max_ops);
+        /* Generate a random base scenario, or one derived from an
+         * input that found new coverage */
+        if (cfg->guided) {
+            fuzz_queue_next(&rng, &queue, cfg->max_ops,
+                            cfg->mutations_per_scenario, &base_scenario);
+        } else {
+            fuzz_generate_scenario(&rng, &base_scenario, cfg->max_ops);
+        }
 
         /* ---- Phase 1: Determinism self-check ---- */
         /* Run the base scenario twice and verify identical digest */
         fuzz_execute(&base_scenario, &exec_a);
+        if (cfg->guided) fuzz_queue_offer(&queue, &base_scenario);
         fuzz_execute(&base_scenario, &exec_b);
 
         if (exec_a.digest != exec_b.digest) {
@@ -1021,6 +1316,7 @@ static int fuzz_run(const fuzz_config *cfg)
 
         /* Execute mutated scenario (crash detection via result) */
         fuzz_execute(&mutated, &exec_b);
+        if (cfg->guided) fuzz_queue_offer(&queue, &mutated);
 
         /* Verify mutated scenario is also deterministic */
         {
@@ -1042,31 +1338,243 @@ static int fuzz_run(const fuzz_config *cfg)
         }
 
         /* Progress reporting */
-        if (cfg->verbose && (iter % 100u == 0u)) {
+        if (cfg->verbose && ((iter - first) % 100u == 0u)) {
             double elapsed = fuzz_clock_sec() - start_time;
             fprintf(stderr,
-                "[fuzz] progress: %llu/%llu (%.1f/s) det_fail=%llu\n",
-                (unsigned long long)iter,
-                (unsigned long long)cfg->iterations,
-                iter > 0u ? (double)iter / elapsed : 0.0,
+                "[fuzz] shard %u progress: %llu/%llu (%.1f/s) det_fail=%llu\n",
+                shard,
+                (unsigned long long)(iter - first),
+                (unsigned long long)(end - first),
+                iter > first ? (double)(iter - first) / elapsed : 0.0,
                 (unsigned long long)determinism_failures);
         }
     }
 
+    if (cfg->guided) {
+        fprintf(stderr,
+            "[fuzz] shard %u coverage: pairs=%u transitions=%u/%u kept=%llu\n",
+            shard, g_fuzz_cov_total.pairs, g_fuzz_cov_total.edge_count,
+            fuzz_cov_edge_total(), (unsigned long long)queue.kept);
+    }
+    g_fuzz_cov_on = 0;
+    return determinism_failures;
+}
+
+/* Value of a "digest_a":"<hex>" field, or 0 when absent. */
+static uint64_t fuzz_line_digest(const char *line)
+{
+    const char *p = strstr(line, "\"digest_a\":\"");
+    uint64_t v = 0u;
+
+    if (p == NULL) return 0u;
+    for (p += 12; (*p >= '0' && *p <= '9') || (*p >= 'a' && *p <= 'f'); p++) {
+        v = (v << 4) | (uint64_t)(*p <= '9' ? *p - '0' : *p - 'a' + 10);
+    }
+    return v;
+}
+
+static void fuzz_corpus_minimize(const fuzz_config *cfg, fuzz_corpus *corpus,
+                                 const char *entry_path, uint64_t digest)
+{
+    char out_path[FUZZ_PATH_MAX];
+    pid_t pid;
+    int status;
+
+    snprintf(out_path, sizeof(out_path), "%s/%016llx.min.json",
+             cfg->corpus_dir, (unsigned long long)digest);
+    fflush(NULL);
+    pid = fork();
+    if (pid == 0) {
+        execl(cfg->minimize_bin, cfg->minimize_bin,
+              "--scenario-file", entry_path, "--output", out_path,
+              (char *)NULL);
+        _exit(127);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) < 0 ||
+        !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "[fuzz] minimize failed for %016llx\n",
+                (unsigned long long)digest);
+        return;
+    }
+    corpus->minimized++;
+}
+
+/* Record one mismatch line: dedupe by digest, then store and minimize
+ * it if the corpus does not hold that digest yet. */
+static void fuzz_corpus_add(const fuzz_config *cfg, fuzz_corpus *corpus,
+                            const char *line)
+{
+    char path[FUZZ_PATH_MAX];
+    uint64_t digest = fuzz_line_digest(line);
+    FILE *f;
+    uint32_t i;
+
+    for (i = 0u; i < corpus->seen_count; i++) {
+        if (corpus->seen[i] == digest) return;
+    }
+    if (corpus->seen_count < FUZZ_CORPUS_MAX) {
+        corpus->seen[corpus->seen_count++] = digest;
+    }
+    corpus->unique++;
+    if (cfg->corpus_dir == NULL) return;
+
+    snprintf(path, sizeof(path), "%s/%016llx.json",
+             cfg->corpus_dir, (unsigned long long)digest);
+    f = fopen(path, "r");
+    if (f != NULL) {
+        fclose(f);
+        return;
+    }
+    f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[fuzz] error: cannot write corpus entry: %s\n", path);
+        return;
+    }
+    fputs(line, f);
+    fclose(f);
+    corpus->stored++;
+    if (cfg->minimize_bin != NULL) {
+        fuzz_corpus_minimize(cfg, corpus, path, digest);
+    }
+}
+
+/* Copy a finished shard's records into the report and the corpus. */
+static uint64_t fuzz_merge_shard(const fuzz_config *cfg, fuzz_corpus *corpus,
+                                 FILE *shard_file, FILE *report)
+{
+    uint64_t records = 0u;
+
+    rewind(shard_file);
+    while (fgets(g_fuzz_line, (int)sizeof(g_fuzz_line), shard_file) != NULL) {
+        fputs(g_fuzz_line, report);
+        fuzz_corpus_add(cfg, corpus, g_fuzz_line);
+        records++;
+    }
+    fflush(report);
+    return records;
+}
+
+static int fuzz_run(const fuzz_config *cfg)
+{
+    FILE *shard_files[FUZZ_MAX_JOBS];
+    pid_t pids[FUZZ_MAX_JOBS];
+    static fuzz_corpus corpus;
+    FILE *report;
+    uint32_t jobs = cfg->jobs;
+    uint32_t w;
+    uint64_t determinism_failures = 0u;
+    uint64_t crash_count = 0u;
+    double start_time;
+    double end_time;
+    int exit_code = 0;
+
+    if (jobs == 0u) jobs = 1u;
+    if (jobs > FUZZ_MAX_JOBS) jobs = FUZZ_MAX_JOBS;
+    if ((uint64_t)jobs > cfg->iterations && cfg->iterations > 0u) {
+        jobs = (uint32_t)cfg->iterations;
+    }
+    memset(&corpus, 0, sizeof(corpus));
+
+    if (cfg->minimize_bin != NULL && cfg->corpus_dir == NULL) {
+        fprintf(stderr, "[fuzz] error: --minimize requires --corpus-dir\n");
+        return 2;
+    }
+    if (cfg->corpus_dir != NULL && mkdir(cfg->corpus_dir, 0777) != 0 &&
+        errno != EEXIST) {
+        fprintf(stderr, "[fuzz] error: cannot create corpus dir: %s\n",
+                cfg->corpus_dir);
+        return 1;
+    }
+
+    report = stdout;
+    if (cfg->report_path != NULL) {
+        report = fopen(cfg->report_path, "w");
+        if (report == NULL) {
+            fprintf(stderr, "[fuzz] error: cannot open report file: %s\n",
+                    cfg->report_path);
+            return 1;
+        }
+    }
+
+    fprintf(stderr,
+        "[fuzz] differential fuzz harness (bd-1md.3)\n"
+        "[fuzz] seed=%llu iterations=%llu max_ops=%u mutations=%u jobs=%u\n",
+        (unsigned long long)cfg->initial_seed,
+        (unsigned long long)cfg->iterations,
+        cfg->max_ops,
+        cfg->mutations_per_scenario,
+        jobs);
+
+    start_time = fuzz_clock_sec();
+
+    for (w = 0u; w < jobs; w++) {
+        uint64_t first = cfg->iterations * w / jobs;
+        uint64_t end = cfg->iterations * (w + 1u) / jobs;
+        uint64_t seed = fuzz_shard_seed(cfg->initial_seed, w);
+
+        pids[w] = -1;
+        shard_files[w] = tmpfile();
+        if (shard_files[w] == NULL) {
+            fprintf(stderr, "[fuzz] error: cannot create shard %u file\n", w);
+            crash_count++;
+            continue;
+        }
+        if (jobs == 1u) {
+            (void)fuzz_run_shard(cfg, w, seed, first, end, shard_files[w]);
+            continue;
+        }
+        fflush(NULL);
+        pids[w] = fork();
+        if (pids[w] == 0) {
+            (void)fuzz_run_shard(cfg, w, seed, first, end, shard_files[w]);
+            fflush(shard_files[w]);
+            _exit(0);
+        }
+        if (pids[w] < 0) {
+            fprintf(stderr, "[fuzz] error: cannot fork shard %u\n", w);
+            crash_count++;
+        }
+    }
+
+    for (w = 0u; w < jobs; w++) {
+        int status;
+
+        if (pids[w] > 0) {
+            if (waitpid(pids[w], &status, 0) < 0 ||
+                !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                crash_count++;
+                fprintf(stderr, "[fuzz] CRASH shard=%u seed=%llu\n", w,
+                        (unsigned long long)fuzz_shard_seed(cfg->initial_seed, w));
+            }
+        }
+        if (shard_files[w] != NULL) {
+            determinism_failures += fuzz_merge_shard(cfg, &corpus,
+                                                     shard_files[w], report);
+            fclose(shard_files[w]);
+        }
+    }
+
     end_time = fuzz_clock_sec();
 
-    fuzz_report_summary(report, cfg->initial_seed, cfg->iterations,
-                        determinism_failures, crash_count,
+    fuzz_report_summary(report, cfg->initial_seed, cfg->iterations, jobs,
+                        determinism_failures, crash_count, corpus.unique,
                         end_time - start_time);
 
     fprintf(stderr,
         "[fuzz] complete: %llu iterations in %.3fs (%.1f/s)\n"
-        "[fuzz] determinism_failures=%llu crashes=%llu\n",
+        "[fuzz] determinism_failures=%llu crashes=%llu unique=%llu\n",
         (unsigned long long)cfg->iterations,
         end_time - start_time,
         (double)cfg->iterations / (end_time - start_time),
         (unsigned long long)determinism_failures,
-        (unsigned long long)crash_count);
+        (unsigned long long)crash_count,
+        (unsigned long long)corpus.unique);
+    if (cfg->corpus_dir != NULL) {
+        fprintf(stderr, "[fuzz] corpus %s: stored=%llu minimized=%llu\n",
+                cfg->corpus_dir,
+                (unsigned long long)corpus.stored,
+                (unsigned long long)corpus.minimized);
+    }
 
     if (determinism_failures > 0u || crash_count > 0u) {
         fprintf(stderr, "[fuzz] FAIL: issues detected\n");
@@ -1116,6 +1624,12 @@ int main(int argc, char **argv)
             cfg.fixtures_dir = argv[++i];
         } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
             cfg.report_path = argv[++i];
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            cfg.jobs = (uint32_t)parse_u64(argv[++i]);
+        } else if (strcmp(argv[i], "--corpus-dir") == 0 && i + 1 < argc) {
+            cfg.corpus_dir = argv[++i];
+        } else if (strcmp(argv[i], "--minimize") == 0 && i + 1 < argc) {
+            cfg.minimize_bin = argv[++i];
         } else if (strcmp(argv[i], "--smoke") == 0) {
             cfg.iterations = 100u;
             cfg.max_ops = 32u;
@@ -1123,6 +1637,8 @@ int main(int argc, char **argv)
             cfg.iterations = 100000u;
             cfg.max_ops = 96u;
             cfg.mutations_per_scenario = 8u;
+        } else if (strcmp(argv[i], "--guided") == 0) {
+            cfg.guided = 1;
         } else if (strcmp(argv[i], "--verbose") == 0) {
             cfg.verbose = 1;
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
@@ -1134,6 +1650,10 @@ int main(int argc, char **argv)
                 "  --mutations <n>       Mutations per scenario (default: 4)\n"
                 "  --fixtures-dir <dir>  Path to Rust reference fixtures\n"
                 "  --report <path>       JSONL report output path\n"
+                "  --jobs <n>            Worker processes (default: 1)\n"
+                "  --corpus-dir <dir>    Deduplicated failure corpus\n"
+                "  --minimize <path>     Minimize new corpus entries\n"
+                "  --guided              Coverage-guided mutation\n"
                 "  --smoke               CI smoke mode (100 iterations)\n"
                 "  --nightly             Nightly mode (100000 iterations)\n"
                 "  --verbose             Verbose progress output\n");
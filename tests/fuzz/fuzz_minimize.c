@@ -712,13 +712,17 @@ static void min_minimize(min_scenario *sc, const min_config *cfg, min_result *re
 
         result->rounds = round + 1u;
 
-        /* Phase 1: Delta debugging (chunk removal) */
-        removed = min_delta_debug(sc, cfg);
-        result->ops_removed += removed;
-
-        /* Phase 2: Single op removal */
-        removed = min_try_remove_singles(sc, cfg);
-        result->ops_removed += removed;
+        /* The digest hashes op_count, so in DIGEST_MATCH mode no removal
+         * can keep it and both removal phases would only burn replays */
+        if (cfg->mode != MIN_MODE_DIGEST_MATCH) {
+            /* Phase 1: Delta debugging (chunk removal) */
+            removed = min_delta_debug(sc, cfg);
+            result->ops_removed += removed;
+
+            /* Phase 2: Single op removal */
+            removed = min_try_remove_singles(sc, cfg);
+            result->ops_removed += removed;
+        }
 
         /* Phase 3: Argument simplification */
         result->args_simplified += min_simplify_args(sc, cfg);
@@ -1020,6 +1024,74 @@ static uint64_t parse_hex64(const char *s)
     return v;
 }
 
+/* ===================================================================
+ * Scenario input (fuzz report record or corpus entry)
+ * =================================================================== */
+
+#define MIN_INPUT_MAX 65536u
+
+static char g_min_input[MIN_INPUT_MAX];
+
+/* Unsigned value following "key": within [p, end), or 0 when absent. */
+static uint64_t min_json_u64(const char *p, const char *end, const char *key)
+{
+    const char *hit = strstr(p, key);
+
+    if (hit == NULL || hit >= end) return 0u;
+    return parse_u64(hit + strlen(key));
+}
+
+/*
+ * Parse the "seed" and "ops" of a fuzz_differential mismatch record.
+ * Returns 0 on success, -1 if the record has no ops array or names an
+ * unknown op.
+ */
+static int min_parse_scenario(const char *text, min_scenario *sc)
+{
+    const char *p = strstr(text, "\"ops\":[");
+
+    memset(sc, 0, sizeof(*sc));
+    if (p == NULL) return -1;
+    sc->seed = min_json_u64(text, p, "\"seed\":");
+
+    for (p += 7; *p == '{' && sc->op_count < MIN_MAX_OPS; ) {
+        const char *end = strchr(p, '}');
+        min_op *op = &sc->ops[sc->op_count];
+        const char *name = strstr(p, "\"op\":\"");
+        int k;
+
+        if (end == NULL || name == NULL || name > end) return -1;
+        name += 6;
+        for (k = 0; k < MIN_OP_KIND_COUNT; k++) {
+            const char *n = min_op_name((min_op_kind)k);
+            size_t len = strlen(n);
+            if (strncmp(name, n, len) == 0 && name[len] == '"') break;
+        }
+        if (k == MIN_OP_KIND_COUNT) return -1;
+        op->kind = (min_op_kind)k;
+        op->idx_a = (uint32_t)min_json_u64(p, end, "\"idx_a\":");
+        op->idx_b = (uint32_t)min_json_u64(p, end, "\"idx_b\":");
+        op->arg_u32 = (uint32_t)min_json_u64(p, end, "\"arg_u32\":");
+        op->arg_u64 = min_json_u64(p, end, "\"arg_u64\":");
+        sc->op_count++;
+        p = end + 1;
+        if (*p == ',') p++;
+    }
+    return 0;
+}
+
+static int min_read_file(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    size_t n;
+
+    if (f == NULL) return -1;
+    n = fread(g_min_input, 1u, MIN_INPUT_MAX - 1u, f);
+    fclose(f);
+    g_min_input[n] = '\0';
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     int i;
@@ -1029,6 +1101,11 @@ int main(int argc, char **argv)
     uint64_t target_digest = 0u;
     int has_target = 0;
     const char *output_path = NULL;
+    const char *scenario_text = NULL;
+    min_scenario sc;
+    min_config cfg;
+    min_result result;
+    FILE *out;
 
     for (i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--selftest") == 0) {
@@ -1042,10 +1119,20 @@ int main(int argc, char **argv)
             has_target = 1;
         } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
             output_path = argv[++i];
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario_text = argv[++i];
+        } else if (strcmp(argv[i], "--scenario-file") == 0 && i + 1 < argc) {
+            if (min_read_file(argv[++i]) != 0) {
+                fprintf(stderr, "[minimize] cannot read %s\n", argv[i]);
+                return 2;
+            }
+            scenario_text = g_min_input;
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             fprintf(stderr,
                 "Usage: fuzz_minimize [options]\n"
                 "  --selftest                Run built-in self-test\n"
+                "  --scenario <json>         Inline scenario (fuzz report record)\n"
+                "  --scenario-file <path>    Read scenario from file\n"
                 "  --failure-digest <hex>    Target digest to preserve\n"
                 "  --output <path>           Write minimized result to file\n"
                 "  --max-rounds <n>          Max minimization rounds (default: 50)\n"
@@ -1061,19 +1148,39 @@ int main(int argc, char **argv)
         return min_selftest(verbose);
     }
 
-    if (!has_target) {
-        /* Default to self-test mode if no target specified */
-        fprintf(stderr, "[minimize] no --failure-digest specified, running self-test\n");
+    if (scenario_text == NULL) {
+        /* Default to self-test mode if no scenario specified */
+        fprintf(stderr, "[minimize] no --scenario specified, running self-test\n");
         return min_selftest(verbose);
     }
+    if (min_parse_scenario(scenario_text, &sc) != 0) {
+        fprintf(stderr, "[minimize] scenario has no parsable ops array\n");
+        return 2;
+    }
 
-    (void)output_path;
-    (void)max_rounds;
+    /* Without a target digest, preserve the determinism failure */
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.mode = has_target ? MIN_MODE_DIGEST_MATCH : MIN_MODE_DETERMINISM;
+    cfg.target_digest = target_digest;
+    cfg.max_rounds = max_rounds;
+    cfg.verbose = verbose;
+    if (has_target && verbose) {
+        fprintf(stderr, "[minimize] target digest: %016llx\n",
+                (unsigned long long)target_digest);
+    }
 
-    fprintf(stderr, "[minimize] target digest: %016llx\n",
-            (unsigned long long)target_digest);
-    fprintf(stderr, "[minimize] scenario input from stdin not yet implemented\n");
-    fprintf(stderr, "[minimize] use --selftest to verify minimizer functionality\n");
+    memset(&result, 0, sizeof(result));
+    min_minimize(&sc, &cfg, &result);
 
+    out = stdout;
+    if (output_path != NULL) {
+        out = fopen(output_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "[minimize] cannot write %s\n", output_path);
+            return 1;
+        }
+    }
+    min_emit_json(out, &sc, &result);
+    if (out != stdout) fclose(out);
     return 0;
 }
@@ -14,15 +14,37 @@
  * This is a compile-and-run exhaustive check, not a symbolic model checker,
  * but the state spaces are small enough (5×5, 6×6, 4×4) for full enumeration.
  *
+ * The interleaving check then drives the live runtime through every
+ * sequence of spawn, cancel, poll, reserve, resolve, close and drain
+ * operations up to a depth bound, deduplicating states by snapshot
+ * digest and spreading each level of the search across forked workers.
+ *
+ * Usage: test_bounded_model [--depth N] [--jobs N]
+ *
  * SPDX-License-Identifier: MIT
  */
 
 /* ASX_CHECKPOINT_WAIVER_FILE() — bounded iteration over small state enums */
 
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
 #include "test_harness.h"
 #include <asx/asx.h>
 #include <asx/core/transition.h>
 #include <asx/core/cancel.h>
+#include <asx/runtime/snapshot.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#define MODEL_HAVE_FORK 1
+#else
+#define MODEL_HAVE_FORK 0
+#endif
 
 /* -------------------------------------------------------------------
  * State count constants
@@ -432,12 +454,436 @@ TEST(task_all_states_reachable)
     }
 }
 
+/* -------------------------------------------------------------------
+ * Interleaving exploration
+ *
+ * Breadth-first search over operation sequences on one region with
+ * two tasks and up to two obligations. The runtime is deterministic,
+ * so a path is replayed from asx_runtime_reset to reach its state.
+ * The state key is the snapshot digest with event_hash cleared (two
+ * paths to the same arenas differ only in history) mixed with the
+ * model state the snapshot cannot see, task A's poll count. A state
+ * reached along several paths is expanded once.
+ *
+ * Each level's frontier is split into contiguous shards, one per
+ * forked worker (the runtime is process-global state). A worker
+ * replays each of its nodes once per operation and writes one record
+ * per child to its shard file; the parent merges shards in order
+ * into the visited set, so the explored graph, and the next frontier,
+ * are the same for any job count.
+ *
+ * Along every replayed step: region, task and obligation states never
+ * move backwards for the same handle, a resolved obligation keeps its
+ * outcome, and a CLOSED region holds no live task or RESERVED
+ * obligation.
+ * ------------------------------------------------------------------- */
+
+enum {
+    OP_SPAWN_A,     /* task A: PENDING twice then OK; acks cancel */
+    OP_SPAWN_B,     /* task B: PENDING until cancelled */
+    OP_CANCEL_A,
+    OP_CANCEL_B,
+    OP_POLL,        /* one scheduler poll */
+    OP_RESERVE,
+    OP_COMMIT,      /* newest obligation */
+    OP_ABORT_ALL,   /* asx_region_abort_obligations */
+    OP_CLOSE,
+    OP_DRAIN,       /* one-poll asx_region_drain_step */
+    OP_COUNT
+};
+
+#define MODEL_MAX_DEPTH    24u
+#define MODEL_MAX_FRONTIER 65536u
+#define MODEL_MAX_STATES   (1u << 18)
+#define MODEL_MAX_JOBS     16u
+#define MODEL_DEFAULT_DEPTH 16u
+
+typedef struct {
+    uint8_t len;
+    uint8_t ops[MODEL_MAX_DEPTH];
+} model_path;
+
+typedef struct {
+    uint32_t node;       /* frontier index of the parent */
+    uint8_t  op;
+    uint8_t  violation;
+    uint64_t key;
+} model_record;
+
+typedef struct {
+    asx_region_id     region;
+    asx_task_id       task[2];
+    int               spawned[2];
+    uint32_t          polls[2];
+    asx_obligation_id obligation[2];
+    uint32_t          obligations;
+} model_world;
+
+static model_world g_world;
+static uint32_t g_model_depth = MODEL_DEFAULT_DEPTH;
+static uint32_t g_model_jobs = 1u;
+
+static model_path g_frontier[2][MODEL_MAX_FRONTIER];
+static uint64_t g_visited[MODEL_MAX_STATES];
+
+static asx_status model_poll(void *user_data, asx_task_id self)
+{
+    uint32_t which = (uint32_t)(uintptr_t)user_data;
+    asx_checkpoint_result cr;
+
+    g_world.polls[which]++;
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled) return ASX_OK;
+    if (which == 0u && g_world.polls[0] > 2u) return ASX_OK;
+    return ASX_E_PENDING;
+}
+
+static void model_apply(uint8_t op)
+{
+    asx_budget budget;
+    asx_region_drain_phase phase;
+    asx_status st = ASX_OK;
+    uint32_t which = (op == OP_SPAWN_B || op == OP_CANCEL_B) ? 1u : 0u;
+
+    switch (op) {
+    case OP_SPAWN_A:
+    case OP_SPAWN_B:
+        if (g_world.spawned[which]) return;
+        if (asx_task_spawn(g_world.region, model_poll, (void *)(uintptr_t)which,
+                           &g_world.task[which]) == ASX_OK) {
+            g_world.spawned[which] = 1;
+        }
+        return;
+    case OP_CANCEL_A:
+    case OP_CANCEL_B:
+        if (!g_world.spawned[which]) return;
+        st = asx_task_cancel(g_world.task[which], ASX_CANCEL_USER);
+        break;
+    case OP_POLL:
+        budget = asx_budget_from_polls(1u);
+        st = asx_scheduler_run(g_world.region, &budget);
+        break;
+    case OP_RESERVE:
+        if (g_world.obligations == 2u) return;
+        if (asx_obligation_reserve(g_world.region,
+                                   &g_world.obligation[g_world.obligations]) == ASX_OK) {
+            g_world.obligations++;
+        }
+        return;
+    case OP_COMMIT:
+        if (g_world.obligations == 0u) return;
+        st = asx_obligation_commit(g_world.obligation[g_world.obligations - 1u]);
+        break;
+    case OP_ABORT_ALL:
+        st = asx_region_abort_obligations(g_world.region, NULL);
+        break;
+    case OP_CLOSE:
+        st = asx_region_close(g_world.region);
+        break;
+    case OP_DRAIN:
+        budget = asx_budget_from_polls(1u);
+        st = asx_region_drain_step(g_world.region, &budget, 1u, &phase);
+        break;
+    default:
+        break;
+    }
+    (void)st;
+}
+
+static int model_state_rank_ok(uint32_t before, uint32_t after,
+                               uint64_t before_id, uint64_t after_id)
+{
+    /* A reused slot may start over */
+    if (before_id != after_id) return 1;
+    return after >= before;
+}
+
+/* Safety properties of one step, from snapshot a to snapshot b */
+static int model_step_ok(const asx_runtime_snapshot *a,
+                         const asx_runtime_snapshot *b)
+{
+    uint32_t i, j;
+
+    for (i = 0; i < ASX_SNAPSHOT_MAX_REGIONS; i++) {
+        const asx_snapshot_region *r = &b->regions[i];
+
+        if (!model_state_rank_ok((uint32_t)a->regions[i].state, (uint32_t)r->state,
+                                 a->regions[i].id, r->id)) return 0;
+        if (r->id == ASX_INVALID_ID || r->state != ASX_REGION_CLOSED) continue;
+        for (j = 0; j < ASX_SNAPSHOT_MAX_TASKS; j++) {
+            if (b->tasks[j].id != ASX_INVALID_ID && b->tasks[j].region == r->id &&
+                b->tasks[j].state != ASX_TASK_COMPLETED) return 0;
+        }
+        for (j = 0; j < ASX_SNAPSHOT_MAX_OBLIGATIONS; j++) {
+            if (b->obligations[j].id != ASX_INVALID_ID &&
+                b->obligations[j].region == r->id &&
+                b->obligations[j].state == ASX_OBLIGATION_RESERVED) return 0;
+        }
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_TASKS; i++) {
+        if (!model_state_rank_ok((uint32_t)a->tasks[i].state, (uint32_t)b->tasks[i].state,
+                                 a->tasks[i].id, b->tasks[i].id)) return 0;
+    }
+    for (i = 0; i < ASX_SNAPSHOT_MAX_OBLIGATIONS; i++) {
+        const asx_snapshot_obligation *was = &a->obligations[i];
+        const asx_snapshot_obligation *now = &b->obligations[i];
+
+        if (was->id == ASX_INVALID_ID || was->id != now->id) continue;
+        if (asx_obligation_is_terminal(was->state) && now->state != was->state) return 0;
+    }
+    return 1;
+}
+
+static uint64_t model_key(asx_runtime_snapshot *snap)
+{
+    uint64_t key;
+
+    snap->event_hash = 0;
+    key = asx_runtime_snapshot_digest(snap);
+    key ^= (uint64_t)(g_world.polls[0] > 3u ? 3u : g_world.polls[0]) + 1u;
+    key *= 0x9E3779B97F4A7C15ull;
+    return key ^ (key >> 29);
+}
+
+/* Replay path then op, checking the last step. */
+static int model_replay(const model_path *path, uint8_t op,
+                        uint64_t *out_key)
+{
+    static asx_runtime_snapshot before;
+    static asx_runtime_snapshot after;
+    uint32_t i;
+
+    asx_runtime_reset();
+    memset(&g_world, 0, sizeof(g_world));
+    if (asx_region_open(&g_world.region) != ASX_OK) return 0;
+    for (i = 0; i < path->len; i++) model_apply(path->ops[i]);
+
+    asx_runtime_snapshot_init(&before);
+    asx_runtime_snapshot_init(&after);
+    if (asx_runtime_snapshot_capture(&before) != ASX_OK) return 0;
+    model_apply(op);
+    if (asx_runtime_snapshot_capture(&after) != ASX_OK) return 0;
+    *out_key = model_key(&after);
+    return model_step_ok(&before, &after);
+}
+
+static void model_print_path(const model_path *path, uint8_t op)
+{
+    static const char *const names[OP_COUNT] = {
+        "spawn_a", "spawn_b", "cancel_a", "cancel_b", "poll",
+        "reserve", "commit", "abort_all", "close", "drain"
+    };
+    uint32_t i;
+
+    fprintf(stderr, "    counterexample:");
+    for (i = 0; i < path->len; i++) fprintf(stderr, " %s", names[path->ops[i]]);
+    fprintf(stderr, " %s\n", names[op]);
+}
+
+static void model_expand_shard(const model_path *frontier, uint32_t first,
+                               uint32_t end, FILE *out)
+{
+    uint32_t n;
+    uint8_t op;
+
+    for (n = first; n < end; n++) {
+        for (op = 0; op < OP_COUNT; op++) {
+            model_record rec;
+
+            memset(&rec, 0, sizeof(rec));
+            rec.node = n;
+            rec.op = op;
+            rec.violation = (uint8_t)!model_replay(&frontier[n], op, &rec.key);
+            if (rec.violation) model_print_path(&frontier[n], op);
+            (void)fwrite(&rec, sizeof(rec), 1, out);
+        }
+    }
+}
+
+/* Insert key into the visited set; 1 if it was new. */
+static int model_visit(uint64_t key, uint32_t *count)
+{
+    uint32_t slot = (uint32_t)(key & (MODEL_MAX_STATES - 1u));
+
+    if (key == 0u) key = 1u;
+    while (g_visited[slot] != 0u) {
+        if (g_visited[slot] == key) return 0;
+        slot = (slot + 1u) & (MODEL_MAX_STATES - 1u);
+    }
+    g_visited[slot] = key;
+    (*count)++;
+    return 1;
+}
+
+typedef struct {
+    uint32_t states;
+    uint32_t transitions;
+    uint32_t violations;
+    uint32_t crashes;
+    uint32_t depth;
+    int      overflow;
+} model_stats;
+
+static void model_explore(model_stats *stats)
+{
+    FILE *shard[MODEL_MAX_JOBS];
+#if MODEL_HAVE_FORK
+    pid_t pids[MODEL_MAX_JOBS];
+#endif
+    uint32_t size = 1u, cur = 0u;
+    uint32_t jobs, w, level;
+    asx_runtime_snapshot root;
+    uint64_t root_key = 0;
+
+    memset(stats, 0, sizeof(*stats));
+    memset(g_visited, 0, sizeof(g_visited));
+    memset(&g_frontier[0][0], 0, sizeof(model_path));
+
+    /* The root is the freshly opened region */
+    asx_runtime_reset();
+    memset(&g_world, 0, sizeof(g_world));
+    asx_runtime_snapshot_init(&root);
+    if (asx_region_open(&g_world.region) == ASX_OK &&
+        asx_runtime_snapshot_capture(&root) == ASX_OK) {
+        root_key = model_key(&root);
+    }
+    (void)model_visit(root_key, &stats->states);
+
+    for (level = 0; level < g_model_depth && size > 0u; level++) {
+        const model_path *frontier = g_frontier[cur];
+        model_path *next = g_frontier[cur ^ 1u];
+        uint32_t next_size = 0u;
+
+        jobs = g_model_jobs < size ? g_model_jobs : size;
+        for (w = 0; w < jobs; w++) {
+            uint32_t first = (uint32_t)((uint64_t)size * w / jobs);
+            uint32_t end = (uint32_t)((uint64_t)size * (w + 1u) / jobs);
+
+            shard[w] = tmpfile();
+            if (shard[w] == NULL) {
+                stats->crashes++;
+                continue;
+            }
+#if MODEL_HAVE_FORK
+            pids[w] = -1;
+            if (jobs > 1u) {
+                fflush(NULL);
+                pids[w] = fork();
+                if (pids[w] == 0) {
+                    model_expand_shard(frontier, first, end, shard[w]);
+                    fflush(shard[w]);
+                    _exit(0);
+                }
+                if (pids[w] < 0) stats->crashes++;
+                continue;
+            }
+#endif
+            model_expand_shard(frontier, first, end, shard[w]);
+        }
+
+        for (w = 0; w < jobs; w++) {
+            model_record rec;
+
+#if MODEL_HAVE_FORK
+            if (jobs > 1u && pids[w] > 0) {
+                int status;
+
+                if (waitpid(pids[w], &status, 0) < 0 ||
+                    !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                    stats->crashes++;
+                }
+            }
+#endif
+            if (shard[w] == NULL) continue;
+            rewind(shard[w]);
+            while (fread(&rec, sizeof(rec), 1, shard[w]) == 1) {
+                stats->transitions++;
+                if (rec.violation) stats->violations++;
+                if (!model_visit(rec.key, &stats->states)) continue;
+                if (stats->states >= MODEL_MAX_STATES / 2u ||
+                    next_size == MODEL_MAX_FRONTIER) {
+                    stats->overflow = 1;
+                    continue;
+                }
+                next[next_size] = frontier[rec.node];
+                next[next_size].ops[next[next_size].len++] = rec.op;
+                next_size++;
+            }
+            fclose(shard[w]);
+        }
+
+        size = next_size;
+        cur ^= 1u;
+        stats->depth = level + 1u;
+    }
+}
+
+TEST(interleavings_preserve_safety)
+{
+    model_stats stats;
+
+    model_explore(&stats);
+    fprintf(stderr, "    depth=%u jobs=%u states=%u transitions=%u\n",
+            stats.depth, g_model_jobs, stats.states, stats.transitions);
+    ASSERT_EQ(stats.crashes, 0u);
+    ASSERT_EQ(stats.violations, 0u);
+    ASSERT_TRUE(!stats.overflow);
+    /* Deduplication collapses the 10^depth paths to a few states */
+    ASSERT_TRUE(stats.states > 100u);
+}
+
+TEST(interleaving_graph_independent_of_jobs)
+{
+    model_stats serial, sharded;
+    uint32_t jobs = g_model_jobs;
+    uint32_t depth = g_model_depth;
+
+    g_model_depth = depth < 6u ? depth : 6u;
+    g_model_jobs = 1u;
+    model_explore(&serial);
+    g_model_jobs = 3u;
+    model_explore(&sharded);
+    g_model_jobs = jobs;
+    g_model_depth = depth;
+
+    ASSERT_EQ(serial.states, sharded.states);
+    ASSERT_EQ(serial.transitions, sharded.transitions);
+    ASSERT_EQ(serial.violations, sharded.violations);
+}
+
+static uint32_t model_default_jobs(void)
+{
+#if MODEL_HAVE_FORK && defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (n > (long)MODEL_MAX_JOBS) return MODEL_MAX_JOBS;
+    if (n > 1) return (uint32_t)n;
+#endif
+    return 1u;
+}
+
 /* -------------------------------------------------------------------
  * Test runner
  * ------------------------------------------------------------------- */
 
-int main(void)
+int main(int argc, char **argv)
 {
+    int i;
+
+    g_model_jobs = model_default_jobs();
+    for (i = 1; i + 1 < argc; i += 2) {
+        unsigned long v = strtoul(argv[i + 1], NULL, 10);
+
+        if (strcmp(argv[i], "--depth") == 0 && v > 0u && v <= MODEL_MAX_DEPTH) {
+            g_model_depth = (uint32_t)v;
+        } else if (strcmp(argv[i], "--jobs") == 0 && v > 0u && v <= MODEL_MAX_JOBS) {
+            g_model_jobs = (uint32_t)v;
+        } else {
+            fprintf(stderr, "usage: %s [--depth 1..%u] [--jobs 1..%u]\n",
+                    argv[0], MODEL_MAX_DEPTH, MODEL_MAX_JOBS);
+            return 2;
+        }
+    }
+
     /* Invariant 1: Terminal no-outgoing */
     RUN_TEST(region_terminal_no_outgoing);
     RUN_TEST(task_terminal_no_outgoing);
@@ -477,6 +923,10 @@ int main(void)
     RUN_TEST(region_all_states_reachable);
     RUN_TEST(task_all_states_reachable);
 
+    /* Interleavings of the live runtime */
+    RUN_TEST(interleavings_preserve_safety);
+    RUN_TEST(interleaving_graph_independent_of_jobs);
+
     TEST_REPORT();
     return test_failures > 0 ? 1 : 0;
 }
@@ -0,0 +1,109 @@
+/*
+ * test_bridge.c — unit tests for bridge channels between contexts
+ *
+ * Tests: argument and capacity checks, FIFO order with full and empty
+ * reports across wraparound, and values crossing between two runtime
+ * contexts.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/core/channel.h>
+#include <asx/runtime/runtime.h>
+#include <stdlib.h>
+
+TEST(bridge_init_checks_arguments) {
+    static asx_channel_bridge bridge;
+    uint64_t cells[4];
+    uint64_t v;
+
+    ASSERT_EQ(asx_channel_bridge_send(&bridge, 1), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_bridge_init(NULL, cells, 4), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_bridge_init(&bridge, NULL, 4), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_bridge_init(&bridge, cells, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_bridge_init(&bridge, cells, 3), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_bridge_init(&bridge, cells, 4), ASX_OK);
+    ASSERT_EQ(asx_channel_bridge_send(NULL, 1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(bridge_fifo_full_and_empty_across_wrap) {
+    asx_channel_bridge bridge;
+    uint64_t cells[4];
+    uint64_t next = 0;
+    uint64_t expect = 0;
+    uint64_t v;
+    uint32_t lap;
+    uint32_t i;
+
+    ASSERT_EQ(asx_channel_bridge_init(&bridge, cells, 4), ASX_OK);
+    ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_E_WOULD_BLOCK);
+    for (lap = 0; lap < 5u; lap++) {
+        for (i = 0; i < 4u; i++) {
+            ASSERT_EQ(asx_channel_bridge_send(&bridge, next++), ASX_OK);
+        }
+        ASSERT_EQ(asx_channel_bridge_send(&bridge, 99), ASX_E_CHANNEL_FULL);
+
+        /* Freeing one cell admits exactly one more */
+        ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_OK);
+        ASSERT_EQ(v, expect++);
+        ASSERT_EQ(asx_channel_bridge_send(&bridge, next++), ASX_OK);
+        ASSERT_EQ(asx_channel_bridge_send(&bridge, 99), ASX_E_CHANNEL_FULL);
+        for (i = 0; i < 4u; i++) {
+            ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_OK);
+            ASSERT_EQ(v, expect++);
+        }
+        ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_E_WOULD_BLOCK);
+    }
+}
+
+TEST(bridge_crosses_runtime_contexts) {
+    uint32_t size = asx_runtime_context_size();
+    void *main_storage = malloc(size);
+    void *peer_storage = malloc(size);
+    asx_runtime *main_ctx = NULL;
+    asx_runtime *peer = NULL;
+    asx_channel_bridge bridge;
+    uint64_t cells[8];
+    asx_region_id rid;
+    asx_channel_id cid;
+    uint32_t len;
+    uint64_t v;
+
+    ASSERT_TRUE(main_storage != NULL && peer_storage != NULL);
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_context_adopt(main_storage, size, &main_ctx), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_init(peer_storage, size, &peer), ASX_OK);
+    ASSERT_EQ(asx_channel_bridge_init(&bridge, cells, 8), ASX_OK);
+
+    /* The sender's channel handles mean nothing to the peer */
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &cid), ASX_OK);
+    ASSERT_EQ(asx_channel_bridge_send(&bridge, 0x1234u), ASX_OK);
+    ASSERT_EQ(asx_channel_bridge_send(&bridge, 0x5678u), ASX_OK);
+
+    ASSERT_EQ(asx_runtime_context_bind(peer), ASX_OK);
+    ASSERT_EQ(asx_channel_queue_len(cid, &len), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)0x1234u);
+    ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)0x5678u);
+    ASSERT_EQ(asx_channel_bridge_try_recv(&bridge, &v), ASX_E_WOULD_BLOCK);
+
+    ASSERT_EQ(asx_runtime_context_bind(main_ctx), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_fini(peer), ASX_OK);
+    asx_runtime_reset();
+    free(peer_storage);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_bridge ===\n");
+    RUN_TEST(bridge_init_checks_arguments);
+    RUN_TEST(bridge_fifo_full_and_empty_across_wrap);
+    RUN_TEST(bridge_crosses_runtime_contexts);
+    TEST_REPORT();
+    return test_failures;
+}
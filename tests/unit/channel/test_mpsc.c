@@ -2,14 +2,16 @@
  * test_mpsc.c — unit tests for bounded MPSC two-phase channel (bd-1md.5)
  *
  * Exercises: create/close lifecycle, two-phase reserve/send/abort,
- * FIFO ordering, capacity enforcement, disconnect detection, ring
- * buffer wraparound, stale handle rejection, and capacity exhaustion.
+ * FIFO ordering, priority classes, capacity enforcement, disconnect detection, ring
+ * buffer wraparound, stale handle rejection, capacity exhaustion, and
+ * region admission ceilings.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/asx.h>
 #include <asx/core/channel.h>
+#include <asx/runtime/telemetry.h>
 #include "test_harness.h"
 
 /* Suppress warn_unused_result for intentionally-ignored calls */
@@ -29,6 +31,15 @@ static void setup(void)
     CH_IGNORE(asx_region_open(&g_rid));
 }
 
+/* Payload and large-ring storage come from the allocator hook */
+static void setup_alloc(void)
+{
+    asx_runtime_hooks hooks;
+    setup();
+    (void)asx_runtime_hooks_init(&hooks);
+    CH_IGNORE(asx_runtime_set_hooks(&hooks));
+}
+
 /* -------------------------------------------------------------------
  * Lifecycle tests
  * ------------------------------------------------------------------- */
@@ -57,10 +68,66 @@ TEST(create_over_max_capacity)
 {
     asx_channel_id ch;
     setup();
-    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_MAX_CAPACITY + 1, &ch),
+    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_ARENA_MAX_CAPACITY + 1, &ch),
               ASX_E_INVALID_ARGUMENT);
 }
 
+TEST(create_large_capacity_needs_allocator)
+{
+    asx_channel_id ch;
+    setup_alloc();
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_MAX_CAPACITY + 1, &ch),
+              ASX_E_RESOURCE_EXHAUSTED);
+    /* Static-pool capacities never touch the allocator */
+    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_MAX_CAPACITY, &ch), ASX_OK);
+    setup_alloc();
+}
+
+TEST(large_capacity_channel_fill_and_drain)
+{
+    asx_channel_id big;
+    asx_channel_id odd;
+    asx_send_permit p;
+    uint64_t val;
+    uint32_t n;
+    uint32_t i;
+    uint32_t round;
+    setup_alloc();
+    ASSERT_EQ(asx_channel_create(g_rid, 1000, &big), ASX_OK);
+
+    for (i = 0; i < 1000; i++) {
+        ASSERT_EQ(asx_channel_try_reserve(big, &p), ASX_OK);
+        ASSERT_EQ(asx_send_permit_send(&p, i), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_try_reserve(big, &p), ASX_E_CHANNEL_FULL);
+    ASSERT_EQ(asx_channel_queue_len(big, &n), ASX_OK);
+    ASSERT_EQ(n, 1000u);
+    for (i = 0; i < 1000; i++) {
+        ASSERT_EQ(asx_channel_try_recv(big, &val), ASX_OK);
+        ASSERT_EQ(val, (uint64_t)i);
+    }
+
+    /* Non-power-of-two capacity wraps its rounded-up ring */
+    ASSERT_EQ(asx_channel_create(g_rid, 100, &odd), ASX_OK);
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 100; i++) {
+            ASSERT_EQ(asx_channel_try_reserve(odd, &p), ASX_OK);
+            ASSERT_EQ(asx_send_permit_send(&p, round * 100u + i), ASX_OK);
+        }
+        ASSERT_EQ(asx_channel_try_reserve(odd, &p), ASX_E_CHANNEL_FULL);
+        for (i = 0; i < 100; i++) {
+            ASSERT_EQ(asx_channel_try_recv(odd, &val), ASX_OK);
+            ASSERT_EQ(val, (uint64_t)(round * 100u + i));
+        }
+    }
+
+    /* The static pool still fits every remaining slot at full size */
+    for (i = 2; i < ASX_MAX_CHANNELS; i++) {
+        ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_MAX_CAPACITY, &odd), ASX_OK);
+    }
+}
+
 TEST(create_max_capacity)
 {
     asx_channel_id ch;
@@ -332,6 +399,127 @@ TEST(abort_consumed_is_noop)
     ASSERT_TRUE(1);
 }
 
+/* -------------------------------------------------------------------
+ * Batched reserve / send
+ * ------------------------------------------------------------------- */
+
+TEST(reserve_many_all_or_nothing_vs_best_effort)
+{
+    asx_channel_id ch;
+    asx_send_permit p[8];
+    uint32_t n = 9;
+    uint32_t res;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 5, &ch), ASX_OK);
+
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 3, 1, &n), ASX_OK);
+    ASSERT_EQ(n, 3u);
+
+    /* Only 2 slots remain: all-or-nothing takes none */
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p + 3, 3, 1, &n), ASX_E_CHANNEL_FULL);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &res), ASX_OK);
+    ASSERT_EQ(res, 3u);
+
+    /* Best-effort takes what is left */
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p + 3, 3, 0, &n), ASX_OK);
+    ASSERT_EQ(n, 2u);
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p + 5, 1, 0, &n), ASX_E_CHANNEL_FULL);
+
+    /* Batch permits abort individually */
+    asx_send_permit_abort(&p[4]);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &res), ASX_OK);
+    ASSERT_EQ(res, 4u);
+
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, NULL, 1, 0, &n), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 0, 0, &n), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 1, 0, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(send_many_enqueues_fifo_run)
+{
+    asx_channel_id ch;
+    asx_send_permit p[6];
+    asx_send_permit single;
+    uint64_t vals[6];
+    uint64_t out[8];
+    uint32_t n;
+    uint32_t round;
+    uint32_t i;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 7, &ch), ASX_OK);
+
+    /* Interleave with single sends so the runs wrap the ring */
+    for (round = 0; round < 40; round++) {
+        ASSERT_EQ(asx_channel_try_reserve(ch, &single), ASX_OK);
+        ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 6, 1, &n), ASX_OK);
+        for (i = 0; i < 6; i++) vals[i] = round * 10u + i + 1u;
+        ASSERT_EQ(asx_send_permit_send_many(p, vals, 6, &n), ASX_OK);
+        ASSERT_EQ(n, 6u);
+        ASSERT_EQ(asx_send_permit_send(&single, round * 10u + 9u), ASX_OK);
+
+        ASSERT_EQ(asx_channel_try_recv_many(ch, out, 8, &n), ASX_OK);
+        ASSERT_EQ(n, 7u);
+        for (i = 0; i < 6; i++) ASSERT_EQ(out[i], round * 10u + i + 1u);
+        ASSERT_EQ(out[6], round * 10u + 9u);
+    }
+}
+
+TEST(send_many_rejects_consumed_and_foreign_permits)
+{
+    asx_channel_id ch;
+    asx_channel_id other;
+    asx_send_permit p[4];
+    uint64_t vals[4] = {1, 2, 3, 4};
+    uint64_t got;
+    uint32_t n;
+    uint32_t res;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &other), ASX_OK);
+
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 3, 1, &n), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(other, &p[3]), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&p[1], 20), ASX_OK);
+
+    /* p[1] is spent and p[3] is foreign; p[0] and p[2] still go out */
+    ASSERT_EQ(asx_send_permit_send_many(p, vals, 4, &n), ASX_E_INVALID_STATE);
+    ASSERT_EQ(n, 2u);
+    ASSERT_EQ(p[3].consumed, 0);
+    ASSERT_EQ(asx_channel_try_recv(ch, &got), ASX_OK);
+    ASSERT_EQ(got, 20u);
+    ASSERT_EQ(asx_channel_try_recv(ch, &got), ASX_OK);
+    ASSERT_EQ(got, 1u);
+    ASSERT_EQ(asx_channel_try_recv(ch, &got), ASX_OK);
+    ASSERT_EQ(got, 3u);
+
+    /* Resending the same batch admits nothing */
+    ASSERT_EQ(asx_send_permit_send_many(p, vals, 3, &n), ASX_E_INVALID_STATE);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &res), ASX_OK);
+    ASSERT_EQ(res, 0u);
+    ASSERT_EQ(asx_send_permit_send(&p[3], 5), ASX_OK);
+}
+
+TEST(send_many_after_receiver_closed_releases_claims)
+{
+    asx_channel_id ch;
+    asx_send_permit p[3];
+    uint64_t vals[3] = {1, 2, 3};
+    uint32_t n;
+    uint32_t res;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch), ASX_OK);
+
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 3, 1, &n), ASX_OK);
+    ASSERT_EQ(asx_channel_close_receiver(ch), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send_many(p, vals, 3, &n), ASX_E_DISCONNECTED);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &res), ASX_OK);
+    ASSERT_EQ(res, 0u);
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, p, 1, 0, &n), ASX_E_DISCONNECTED);
+}
+
 /* -------------------------------------------------------------------
  * Receive
  * ------------------------------------------------------------------- */
@@ -381,6 +569,490 @@ TEST(recv_after_sender_closed_empty)
     ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_E_DISCONNECTED);
 }
 
+TEST(recv_many_drains_fifo_across_wraparound)
+{
+    asx_channel_id ch;
+    asx_send_permit p;
+    uint64_t vals[8];
+    uint64_t next_send = 0;
+    uint64_t next_recv = 0;
+    uint32_t n;
+    uint32_t res;
+    uint32_t round;
+    uint32_t i;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 5, &ch), ASX_OK);
+
+    /* Enough rounds to wrap the ring several times */
+    for (round = 0; round < 60; round++) {
+        for (i = 0; i < 5; i++) {
+            ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_OK);
+            ASSERT_EQ(asx_send_permit_send(&p, next_send++), ASX_OK);
+        }
+        ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 3, &n), ASX_OK);
+        ASSERT_EQ(n, 3u);
+        ASSERT_EQ(asx_channel_try_recv_many(ch, vals + 3, 8, &n), ASX_OK);
+        ASSERT_EQ(n, 2u);
+        for (i = 0; i < 5; i++) {
+            ASSERT_EQ(vals[i], next_recv++);
+        }
+    }
+    ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 8, &n), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &res), ASX_OK);
+    ASSERT_EQ(res, 0u);
+
+    /* Freed capacity is reusable immediately */
+    for (i = 0; i < 5; i++) {
+        ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_OK);
+        ASSERT_EQ(asx_send_permit_send(&p, i), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_E_CHANNEL_FULL);
+    ASSERT_EQ(asx_channel_close_sender(ch), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 8, &n), ASX_OK);
+    ASSERT_EQ(n, 5u);
+    ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 8, &n), ASX_E_DISCONNECTED);
+}
+
+TEST(recv_many_rejects_bad_arguments)
+{
+    asx_channel_id ch;
+    uint64_t vals[2];
+    uint32_t n = 7;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 2, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_try_recv_many(ch, NULL, 2, &n), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 0, &n), ASX_E_INVALID_ARGUMENT);
+}
+
+/* -------------------------------------------------------------------
+ * Payload channels (zero-copy slots)
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t seq;
+    uint32_t qty;
+    double   px;
+    char     sym[6];
+} tick_msg;
+
+TEST(payload_round_trip_is_in_place)
+{
+    asx_channel_id ch;
+    asx_send_permit p;
+    asx_recv_view v;
+    tick_msg *slot;
+    const tick_msg *got;
+    void *data;
+    uint32_t size;
+    uint32_t round;
+    setup_alloc();
+    ASSERT_EQ(asx_channel_create_payload(g_rid, 3, (uint32_t)sizeof(tick_msg), &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_element_size(ch, &size), ASX_OK);
+    ASSERT_EQ(size, (uint32_t)sizeof(tick_msg));
+
+    /* Wrap the ring several times; FIFO and contents survive */
+    for (round = 0; round < 20; round++) {
+        ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p, &data), ASX_OK);
+        slot = (tick_msg *)data;
+        slot->seq = round;
+        slot->qty = round * 100u;
+        slot->px = 1.5 * (double)round;
+        slot->sym[0] = 'A';
+        ASSERT_EQ(asx_send_permit_commit(&p), ASX_OK);
+
+        ASSERT_EQ(asx_channel_try_recv_view(ch, &v), ASX_OK);
+        ASSERT_TRUE(v.data == data);
+        ASSERT_EQ(v.size, (uint32_t)sizeof(tick_msg));
+        got = (const tick_msg *)v.data;
+        ASSERT_EQ(got->seq, round);
+        ASSERT_EQ(got->qty, round * 100u);
+        ASSERT_TRUE(got->px == 1.5 * (double)round);
+        ASSERT_EQ(got->sym[0], 'A');
+        ASSERT_EQ(asx_recv_view_release(&v), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_try_recv_view(ch, &v), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_send_permit_commit(&p), ASX_E_INVALID_STATE);
+}
+
+TEST(payload_view_holds_capacity_until_release)
+{
+    asx_channel_id ch;
+    asx_send_permit p[3];
+    asx_recv_view v;
+    asx_recv_view copy;
+    void *data[3];
+    uint32_t n;
+    setup_alloc();
+    ASSERT_EQ(asx_channel_create_payload(g_rid, 2, 16, &ch), ASX_OK);
+
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[0], &data[0]), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[1], &data[1]), ASX_OK);
+    ASSERT_TRUE(data[0] != data[1]);
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[2], &data[2]), ASX_E_CHANNEL_FULL);
+    ASSERT_EQ(asx_send_permit_commit(&p[0]), ASX_OK);
+    ASSERT_EQ(asx_send_permit_commit(&p[1]), ASX_OK);
+
+    /* A borrowed element still occupies its slot */
+    ASSERT_EQ(asx_channel_try_recv_view(ch, &v), ASX_OK);
+    ASSERT_TRUE(v.data == data[0]);
+    ASSERT_EQ(asx_channel_queue_len(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 1u);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[2], &data[2]), ASX_E_CHANNEL_FULL);
+
+    copy = v;
+    ASSERT_EQ(asx_recv_view_release(&v), ASX_OK);
+    ASSERT_TRUE(v.data == NULL);
+    ASSERT_EQ(asx_recv_view_release(&v), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_recv_view_release(&copy), ASX_E_INVALID_STATE);
+
+    /* The released slot is the one handed out next */
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[2], &data[2]), ASX_OK);
+    ASSERT_TRUE(data[2] == data[0]);
+    asx_send_permit_abort(&p[2]);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+}
+
+TEST(payload_and_value_apis_do_not_mix)
+{
+    asx_channel_id pch;
+    asx_channel_id vch;
+    asx_send_permit p;
+    asx_recv_view v;
+    uint64_t val;
+    uint32_t n;
+    void *data;
+    setup_alloc();
+    ASSERT_EQ(asx_channel_create_payload(g_rid, 4, 0, &pch), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_create_payload(g_rid, 4, ASX_CHANNEL_MAX_ELEMENT_SIZE + 1u, &pch),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_create_payload(g_rid, 4, 24, &pch), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &vch), ASX_OK);
+    ASSERT_EQ(asx_channel_element_size(vch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+
+    ASSERT_EQ(asx_channel_try_reserve(pch, &p), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_try_recv(pch, &val), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_try_reserve_slot(vch, &p, &data), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_try_recv_view(vch, &v), ASX_E_INVALID_STATE);
+
+    /* A slot permit cannot be sent as a value and stays committable */
+    ASSERT_EQ(asx_channel_try_reserve_slot(pch, &p, &data), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&p, 7), ASX_E_INVALID_STATE);
+    ASSERT_EQ(p.consumed, 0);
+    ASSERT_EQ(asx_send_permit_commit(&p), ASX_OK);
+
+    ASSERT_EQ(asx_channel_try_reserve(vch, &p), ASX_OK);
+    ASSERT_EQ(asx_send_permit_commit(&p), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_send_permit_send(&p, 7), ASX_OK);
+}
+
+TEST(payload_close_receiver_returns_slots)
+{
+    asx_channel_id ch;
+    asx_send_permit p[3];
+    asx_recv_view v;
+    void *data;
+    uint32_t n;
+    setup_alloc();
+    ASSERT_EQ(asx_channel_create_payload(g_rid, 3, 8, &ch), ASX_OK);
+
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[0], &data), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[1], &data), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[2], &data), ASX_OK);
+    ASSERT_EQ(asx_send_permit_commit(&p[0]), ASX_OK);
+    ASSERT_EQ(asx_send_permit_commit(&p[1]), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv_view(ch, &v), ASX_OK);
+
+    ASSERT_EQ(asx_channel_close_receiver(ch), ASX_OK);
+    ASSERT_EQ(asx_channel_queue_len(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_send_permit_commit(&p[2]), ASX_E_DISCONNECTED);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+
+    /* An outstanding view can still be released after the close */
+    ASSERT_EQ(asx_recv_view_release(&v), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve_slot(ch, &p[0], &data), ASX_E_DISCONNECTED);
+}
+
+/* -------------------------------------------------------------------
+ * Broadcast channels
+ * ------------------------------------------------------------------- */
+
+static void send_one(asx_channel_id ch, uint64_t v)
+{
+    asx_send_permit p;
+    CH_IGNORE(asx_channel_try_reserve(ch, &p));
+    CH_IGNORE(asx_send_permit_send(&p, v));
+}
+
+TEST(broadcast_delivers_to_every_subscriber)
+{
+    asx_channel_id ch;
+    asx_broadcast_receiver rx[3];
+    asx_broadcast_receiver late;
+    uint64_t val;
+    uint32_t i;
+    uint32_t k;
+    setup();
+    ASSERT_EQ(asx_channel_create_broadcast(g_rid, 8, &ch), ASX_OK);
+    for (k = 0; k < 3; k++) {
+        ASSERT_EQ(asx_broadcast_subscribe(ch, &rx[k]), ASX_OK);
+    }
+
+    for (i = 0; i < 5; i++) send_one(ch, 100u + i);
+
+    /* A late subscriber only sees values committed after it joined */
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &late), ASX_OK);
+    send_one(ch, 105u);
+
+    for (k = 0; k < 3; k++) {
+        for (i = 0; i < 6; i++) {
+            ASSERT_EQ(asx_broadcast_try_recv(&rx[k], &val), ASX_OK);
+            ASSERT_EQ(val, 100u + i);
+        }
+        ASSERT_EQ(asx_broadcast_try_recv(&rx[k], &val), ASX_E_WOULD_BLOCK);
+    }
+    ASSERT_EQ(asx_broadcast_try_recv(&late, &val), ASX_OK);
+    ASSERT_EQ(val, 105u);
+    ASSERT_EQ(asx_broadcast_try_recv(&late, &val), ASX_E_WOULD_BLOCK);
+}
+
+TEST(broadcast_slowest_subscriber_applies_backpressure)
+{
+    asx_channel_id ch;
+    asx_broadcast_receiver fast;
+    asx_broadcast_receiver slow;
+    asx_send_permit p;
+    uint64_t val;
+    uint32_t n;
+    uint32_t i;
+    uint32_t round;
+    setup();
+    ASSERT_EQ(asx_channel_create_broadcast(g_rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &fast), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &slow), ASX_OK);
+
+    for (i = 0; i < 4; i++) send_one(ch, i);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_E_CHANNEL_FULL);
+
+    /* The fast reader alone frees nothing */
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_broadcast_try_recv(&fast, &val), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_queue_len(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 4u);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_E_CHANNEL_FULL);
+
+    ASSERT_EQ(asx_broadcast_try_recv(&slow, &val), ASX_OK);
+    ASSERT_EQ(val, 0u);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&p, 4), ASX_OK);
+
+    /* Dropping the slow subscriber releases its backlog */
+    ASSERT_EQ(asx_broadcast_unsubscribe(&slow), ASX_OK);
+    ASSERT_EQ(asx_broadcast_try_recv(&slow, &val), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_broadcast_unsubscribe(&slow), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_queue_len(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 1u);
+
+    /* Keep wrapping the ring with one reader left */
+    for (round = 0; round < 30; round++) {
+        ASSERT_EQ(asx_broadcast_try_recv(&fast, &val), ASX_OK);
+        ASSERT_EQ(val, 4u + round);
+        send_one(ch, 5u + round);
+    }
+    ASSERT_EQ(asx_channel_reserved_count(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+}
+
+TEST(broadcast_edges_and_misuse)
+{
+    asx_channel_id ch;
+    asx_channel_id plain;
+    asx_broadcast_receiver rx[ASX_CHANNEL_MAX_SUBSCRIBERS + 1u];
+    uint64_t val;
+    uint32_t n;
+    uint32_t k;
+    setup();
+    ASSERT_EQ(asx_channel_create_broadcast(g_rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &plain), ASX_OK);
+
+    /* Nobody subscribed: a committed value is dropped at once */
+    send_one(ch, 1);
+    ASSERT_EQ(asx_channel_queue_len(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_broadcast_subscribe(plain, &rx[0]), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_broadcast_subscribe(ch, NULL), ASX_E_INVALID_ARGUMENT);
+
+    for (k = 0; k < ASX_CHANNEL_MAX_SUBSCRIBERS; k++) {
+        ASSERT_EQ(asx_broadcast_subscribe(ch, &rx[k]), ASX_OK);
+    }
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &rx[k]), ASX_E_RESOURCE_EXHAUSTED);
+
+    /* Sender close: queued values drain, then disconnect */
+    send_one(ch, 2);
+    ASSERT_EQ(asx_channel_close_sender(ch), ASX_OK);
+    ASSERT_EQ(asx_broadcast_try_recv(&rx[0], &val), ASX_OK);
+    ASSERT_EQ(val, 2u);
+    ASSERT_EQ(asx_broadcast_try_recv(&rx[0], &val), ASX_E_DISCONNECTED);
+
+    /* Receiver close drops every subscription and its backlog */
+    ASSERT_EQ(asx_channel_close_receiver(ch), ASX_OK);
+    ASSERT_EQ(asx_channel_queue_len(ch, &n), ASX_OK);
+    ASSERT_EQ(n, 0u);
+    ASSERT_EQ(asx_broadcast_try_recv(&rx[1], &val), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &rx[0]), ASX_E_INVALID_STATE);
+}
+
+/* -------------------------------------------------------------------
+ * Statistics
+ * ------------------------------------------------------------------- */
+
+static asx_time g_stats_clock;
+
+static asx_time stats_clock(void *ctx)
+{
+    (void)ctx;
+    return g_stats_clock;
+}
+
+/* Default hooks on a clock the test steps by hand */
+static void setup_stats_clock(void)
+{
+    asx_runtime_hooks hooks;
+    setup();
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = stats_clock;
+    hooks.clock.logical_now_ns_fn = stats_clock;
+    CH_IGNORE(asx_runtime_set_hooks(&hooks));
+    g_stats_clock = 1000;
+}
+
+#if ASX_TELEMETRY_MIN_TIER < 2
+TEST(stats_track_sends_receives_and_high_water)
+{
+    asx_channel_id ch;
+    asx_send_permit p;
+    asx_channel_stats st;
+    uint64_t val;
+    setup_stats_clock();
+    ASSERT_EQ(asx_channel_create(g_rid, 2, &ch), ASX_OK);
+
+    ASSERT_EQ(asx_channel_get_stats(ch, &st), ASX_OK);
+    ASSERT_EQ(st.sends, 0u);
+    ASSERT_EQ(st.high_water, 0u);
+
+    send_one(ch, 1);
+    g_stats_clock = 1100;
+    send_one(ch, 2);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &p), ASX_E_CHANNEL_FULL);
+
+    g_stats_clock = 1400;
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_E_WOULD_BLOCK);
+
+    ASSERT_EQ(asx_channel_get_stats(ch, &st), ASX_OK);
+    ASSERT_EQ(st.sends, 2u);
+    ASSERT_EQ(st.receives, 2u);
+    ASSERT_EQ(st.high_water, 2u);
+    ASSERT_EQ(st.reserve_full, 1u);
+    ASSERT_EQ(st.wait_total_ns, (uint64_t)(400 + 300));
+    ASSERT_EQ(st.wait_max_ns, (uint64_t)400);
+
+    /* Discarded messages are not receives */
+    send_one(ch, 3);
+    ASSERT_EQ(asx_channel_close_receiver(ch), ASX_OK);
+    ASSERT_EQ(asx_channel_get_stats(ch, &st), ASX_OK);
+    ASSERT_EQ(st.sends, 3u);
+    ASSERT_EQ(st.receives, 2u);
+
+    ASSERT_EQ(asx_channel_get_stats(ch, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(stats_sum_broadcast_subscribers)
+{
+    asx_channel_id ch;
+    asx_broadcast_receiver rx[2];
+    asx_channel_stats st;
+    uint64_t val;
+    setup_stats_clock();
+    ASSERT_EQ(asx_channel_create_broadcast(g_rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &rx[0]), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(ch, &rx[1]), ASX_OK);
+
+    send_one(ch, 7);
+    g_stats_clock = 1050;
+    ASSERT_EQ(asx_broadcast_try_recv(&rx[0], &val), ASX_OK);
+    g_stats_clock = 1200;
+    ASSERT_EQ(asx_broadcast_try_recv(&rx[1], &val), ASX_OK);
+
+    /* A leaving subscriber's counts stay with the channel */
+    ASSERT_EQ(asx_broadcast_unsubscribe(&rx[1]), ASX_OK);
+    ASSERT_EQ(asx_channel_get_stats(ch, &st), ASX_OK);
+    ASSERT_EQ(st.sends, 1u);
+    ASSERT_EQ(st.receives, 2u);
+    ASSERT_EQ(st.high_water, 1u);
+    ASSERT_EQ(st.wait_total_ns, (uint64_t)(50 + 200));
+    ASSERT_EQ(st.wait_max_ns, (uint64_t)200);
+}
+#endif
+
+#if !ASX_STATIC_PROFILE && ASX_TELEMETRY_MIN_TIER < 2
+/* Needs a runtime tier switch, which ASX_STATIC_PROFILE rejects */
+TEST(stats_off_at_ultra_min_tier)
+{
+    asx_channel_id tracked;
+    asx_channel_id bare;
+    asx_channel_stats st;
+    uint64_t val;
+    setup_stats_clock();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &tracked), ASX_OK);
+    ASSERT_EQ(asx_telemetry_set_tier(ASX_TELEMETRY_ULTRA_MIN), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &bare), ASX_OK);
+
+    send_one(bare, 1);
+    ASSERT_EQ(asx_channel_try_recv(bare, &val), ASX_OK);
+    ASSERT_EQ(val, 1u);
+    ASSERT_EQ(asx_channel_get_stats(bare, &st), ASX_E_INVALID_STATE);
+
+    /* The tier is sampled at create */
+    send_one(tracked, 2);
+    ASSERT_EQ(asx_channel_get_stats(tracked, &st), ASX_OK);
+    ASSERT_EQ(st.sends, 1u);
+
+    asx_telemetry_reset();
+}
+#endif
+
+#if ASX_TELEMETRY_MIN_TIER >= 2
+/* At a ULTRA_MIN floor every channel is created untracked */
+TEST(stats_off_at_ultra_min_floor)
+{
+    asx_channel_id ch;
+    asx_channel_stats st;
+    uint64_t val;
+    setup_stats_clock();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch), ASX_OK);
+
+    send_one(ch, 1);
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+    ASSERT_EQ(val, 1u);
+    ASSERT_EQ(asx_channel_get_stats(ch, &st), ASX_E_INVALID_STATE);
+}
+#endif
+
 /* -------------------------------------------------------------------
  * Ring buffer wraparound
  * ------------------------------------------------------------------- */
@@ -424,6 +1096,69 @@ TEST(ring_buffer_batch_wraparound)
     }
 }
 
+TEST(priority_classes_drain_urgent_first_and_share_capacity)
+{
+    asx_channel_id ch;
+    asx_send_permit p[4];
+    asx_send_permit extra;
+    uint64_t vals[4];
+    uint64_t val;
+    uint32_t n;
+    uint32_t i, round;
+    setup();
+    ASSERT_EQ(asx_channel_create_priority(g_rid, 4, 1, &ch),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_create_priority(g_rid, 4,
+                                          ASX_CHANNEL_MAX_PRIORITIES + 1u, &ch),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_create_priority(g_rid, 4, 3, &ch), ASX_OK);
+
+    /* One capacity for all classes */
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_channel_try_reserve(ch, &p[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_try_reserve(ch, &extra), ASX_E_CHANNEL_FULL);
+    ASSERT_EQ(asx_send_permit_send_priority(&p[0], 3, 9), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(p[0].consumed, 0);
+
+    /* Bulk, control, bulk, middle: control first, then middle, then
+     * the bulk class in FIFO order */
+    ASSERT_EQ(asx_send_permit_send(&p[0], 100), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send_priority(&p[1], 0, 1), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send_priority(&p[2], 2, 101), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send_priority(&p[3], 1, 50), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+    ASSERT_EQ(val, (uint64_t)1);
+    ASSERT_EQ(asx_channel_try_recv_many(ch, vals, 4, &n), ASX_OK);
+    ASSERT_EQ(n, (uint32_t)3);
+    ASSERT_EQ(vals[0], (uint64_t)50);
+    ASSERT_EQ(vals[1], (uint64_t)100);
+    ASSERT_EQ(vals[2], (uint64_t)101);
+
+    /* A whole capacity's worth in one class wraps its ring */
+    for (round = 0; round < 3; round++) {
+        for (i = 0; i < 4; i++) {
+            ASSERT_EQ(asx_channel_try_reserve(ch, &p[i]), ASX_OK);
+            ASSERT_EQ(asx_send_permit_send_priority(&p[i], round,
+                                                    (uint64_t)(round * 10 + i)),
+                      ASX_OK);
+        }
+        for (i = 0; i < 4; i++) {
+            ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+            ASSERT_EQ(val, (uint64_t)(round * 10 + i));
+        }
+    }
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_E_WOULD_BLOCK);
+
+    /* A plain channel has only class 0 */
+    ASSERT_EQ(asx_channel_create(g_rid, 2, &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &p[0]), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send_priority(&p[0], 1, 7), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_send_permit_send_priority(&p[0], 0, 7), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+    ASSERT_EQ(val, (uint64_t)7);
+}
+
 /* -------------------------------------------------------------------
  * Disconnect scenarios
  * ------------------------------------------------------------------- */
@@ -571,6 +1306,167 @@ TEST(stale_permit_copy_cannot_send)
     ASSERT_EQ(res, 0u);
 }
 
+TEST(recycled_permit_slot_rejects_old_token)
+{
+    asx_channel_id ch;
+    asx_send_permit first;
+    asx_send_permit stale_copy;
+    asx_send_permit second;
+    uint64_t v;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 1, &ch), ASX_OK);
+
+    /* Capacity 1: the second reserve must reuse the freed permit slot */
+    ASSERT_EQ(asx_channel_try_reserve(ch, &first), ASX_OK);
+    stale_copy = first;
+    asx_send_permit_abort(&first);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &second), ASX_OK);
+    ASSERT_NE(second.token, stale_copy.token);
+
+    ASSERT_EQ(asx_send_permit_send(&stale_copy, 1u), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_send_permit_send(&second, 2u), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)2);
+}
+
+TEST(full_reservation_cycles_keep_accounting)
+{
+    asx_channel_id ch;
+    asx_send_permit permits[ASX_CHANNEL_MAX_CAPACITY];
+    asx_send_permit extra;
+    uint32_t round;
+    uint32_t i;
+    uint32_t res;
+    uint64_t v;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_MAX_CAPACITY, &ch), ASX_OK);
+
+    for (round = 0; round < 50; round++) {
+        for (i = 0; i < ASX_CHANNEL_MAX_CAPACITY; i++) {
+            ASSERT_EQ(asx_channel_try_reserve(ch, &permits[i]), ASX_OK);
+        }
+        ASSERT_EQ(asx_channel_try_reserve(ch, &extra), ASX_E_CHANNEL_FULL);
+        /* Release out of order: odd slots abort, even slots send */
+        for (i = ASX_CHANNEL_MAX_CAPACITY; i-- > 0;) {
+            if (i % 2u) {
+                asx_send_permit_abort(&permits[i]);
+            } else {
+                ASSERT_EQ(asx_send_permit_send(&permits[i], i), ASX_OK);
+            }
+        }
+        ASSERT_EQ(asx_channel_reserved_count(ch, &res), ASX_OK);
+        ASSERT_EQ(res, 0u);
+        for (i = 0; i < ASX_CHANNEL_MAX_CAPACITY / 2u; i++) {
+            ASSERT_EQ(asx_channel_try_recv(ch, &v), ASX_OK);
+        }
+        ASSERT_EQ(asx_channel_try_recv(ch, &v), ASX_E_WOULD_BLOCK);
+    }
+}
+
+TEST(region_admission_caps_reserves_below_capacity)
+{
+    asx_channel_id ch, late;
+    asx_send_permit permits[10];
+    asx_send_permit extra;
+    asx_overload_policy pol;
+    asx_trace_event ev;
+    uint32_t got;
+    uint32_t i;
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 10, &ch), ASX_OK);
+
+    /* REJECT at half the channel: five claims, then closed */
+    asx_overload_policy_init(&pol);
+    pol.threshold_pct = 50;
+    ASSERT_EQ(asx_region_set_admission(g_rid, &pol), ASX_OK);
+    asx_trace_reset();
+    for (i = 0; i < 5u; i++) {
+        ASSERT_EQ(asx_channel_try_reserve(ch, &permits[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_try_reserve(ch, &extra), ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(asx_trace_event_count(), 1u);
+    ASSERT_TRUE(asx_trace_event_get(0, &ev));
+    ASSERT_EQ((int)ev.kind, (int)ASX_TRACE_ADMISSION);
+    ASSERT_EQ(ev.entity_id, ch);
+    ASSERT_EQ(ev.aux, ASX_TRACE_ADMISSION_AUX(ASX_ADMISSION_CHANNEL,
+                                              ASX_OVERLOAD_REJECT, 50u));
+
+    /* Channels opened later pick up the policy too */
+    pol.mode = ASX_OVERLOAD_BACKPRESSURE;
+    ASSERT_EQ(asx_region_set_admission(g_rid, &pol), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &extra), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_channel_create(g_rid, 2, &late), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(late, &extra), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(late, &extra), ASX_E_WOULD_BLOCK);
+
+    /* Past capacity the channel is full whatever the policy */
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, &permits[5], 6, 1, &got),
+              ASX_E_CHANNEL_FULL);
+
+    ASSERT_EQ(asx_region_set_admission(g_rid, NULL), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve_many(ch, &permits[5], 5, 1, &got), ASX_OK);
+    ASSERT_EQ(got, 5u);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &extra), ASX_E_CHANNEL_FULL);
+    for (i = 0; i < 10u; i++) asx_send_permit_abort(&permits[i]);
+}
+
+/* -------------------------------------------------------------------
+ * Region teardown
+ * ------------------------------------------------------------------- */
+
+TEST(region_drain_reclaims_only_its_channels)
+{
+    asx_region_id other;
+    asx_channel_id mine[3];
+    asx_channel_id theirs;
+    asx_channel_state st;
+    asx_budget budget = asx_budget_infinite();
+    uint32_t i;
+    setup();
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_channel_create(g_rid, 4, &mine[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_create(other, 4, &theirs), ASX_OK);
+    send_one(mine[1], 5);
+
+    ASSERT_EQ(asx_region_drain(g_rid, &budget), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_channel_get_state(mine[i], &st), ASX_E_NOT_FOUND);
+    }
+    ASSERT_EQ(asx_channel_get_state(theirs, &st), ASX_OK);
+    ASSERT_EQ(st, ASX_CHANNEL_OPEN);
+}
+
+TEST(region_cycles_do_not_leak_channel_slots)
+{
+    asx_region_id rid;
+    asx_channel_id ch;
+    asx_channel_id stale;
+    asx_channel_state st;
+    asx_budget budget;
+    uint32_t round;
+    uint32_t i;
+    setup_alloc();
+
+    /* Each round fills the arena, with heap rings and payloads too */
+    for (round = 0; round < 3; round++) {
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+        ASSERT_EQ(asx_channel_create(rid, ASX_CHANNEL_MAX_CAPACITY * 2u,
+                                     &ch), ASX_OK);
+        ASSERT_EQ(asx_channel_create_payload(rid, 4, 32, &ch), ASX_OK);
+        if (round == 0) stale = ch;
+        for (i = 2; i < ASX_MAX_CHANNELS; i++) {
+            ASSERT_EQ(asx_channel_create(rid, ASX_CHANNEL_MAX_CAPACITY, &ch),
+                      ASX_OK);
+        }
+        ASSERT_EQ(asx_channel_create(rid, 4, &ch), ASX_E_RESOURCE_EXHAUSTED);
+        budget = asx_budget_infinite();
+        ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    }
+    ASSERT_NE(asx_channel_get_state(stale, &st), ASX_OK);
+}
+
 /* -------------------------------------------------------------------
  * Reset
  * ------------------------------------------------------------------- */
@@ -600,6 +1496,8 @@ int main(void)
     RUN_TEST(create_zero_capacity);
     RUN_TEST(create_over_max_capacity);
     RUN_TEST(create_max_capacity);
+    RUN_TEST(create_large_capacity_needs_allocator);
+    RUN_TEST(large_capacity_channel_fill_and_drain);
     RUN_TEST(create_exhaustion);
     RUN_TEST(create_rejects_non_region_handle);
     RUN_TEST(create_rejects_closed_region);
@@ -623,13 +1521,40 @@ int main(void)
     RUN_TEST(abort_null_is_safe);
     RUN_TEST(abort_consumed_is_noop);
 
+    RUN_TEST(reserve_many_all_or_nothing_vs_best_effort);
+    RUN_TEST(send_many_enqueues_fifo_run);
+    RUN_TEST(send_many_rejects_consumed_and_foreign_permits);
+    RUN_TEST(send_many_after_receiver_closed_releases_claims);
+
     RUN_TEST(recv_empty_returns_would_block);
     RUN_TEST(recv_null_out);
     RUN_TEST(recv_after_sender_closed_with_data);
     RUN_TEST(recv_after_sender_closed_empty);
+    RUN_TEST(recv_many_drains_fifo_across_wraparound);
+    RUN_TEST(recv_many_rejects_bad_arguments);
+
+    RUN_TEST(payload_round_trip_is_in_place);
+    RUN_TEST(payload_view_holds_capacity_until_release);
+    RUN_TEST(payload_and_value_apis_do_not_mix);
+    RUN_TEST(payload_close_receiver_returns_slots);
+
+    RUN_TEST(broadcast_delivers_to_every_subscriber);
+    RUN_TEST(broadcast_slowest_subscriber_applies_backpressure);
+    RUN_TEST(broadcast_edges_and_misuse);
+
+#if ASX_TELEMETRY_MIN_TIER < 2
+    RUN_TEST(stats_track_sends_receives_and_high_water);
+    RUN_TEST(stats_sum_broadcast_subscribers);
+#else
+    RUN_TEST(stats_off_at_ultra_min_floor);
+#endif
+#if !ASX_STATIC_PROFILE && ASX_TELEMETRY_MIN_TIER < 2
+    RUN_TEST(stats_off_at_ultra_min_tier);
+#endif
 
     RUN_TEST(ring_buffer_wraparound);
     RUN_TEST(ring_buffer_batch_wraparound);
+    RUN_TEST(priority_classes_drain_urgent_first_and_share_capacity);
 
     RUN_TEST(reserve_after_sender_closed);
     RUN_TEST(reserve_after_receiver_closed);
@@ -644,6 +1569,12 @@ int main(void)
     RUN_TEST(double_send_same_permit);
     RUN_TEST(forged_permit_send_rejected);
     RUN_TEST(stale_permit_copy_cannot_send);
+    RUN_TEST(recycled_permit_slot_rejects_old_token);
+    RUN_TEST(full_reservation_cycles_keep_accounting);
+    RUN_TEST(region_admission_caps_reserves_below_capacity);
+
+    RUN_TEST(region_drain_reclaims_only_its_channels);
+    RUN_TEST(region_cycles_do_not_leak_channel_slots);
 
     RUN_TEST(reset_clears_all);
 
@@ -0,0 +1,180 @@
+/*
+ * test_oneshot.c — unit tests for oneshots sent through obligations
+ *
+ * Tests: argument checks and pool exhaustion, commit delivering the
+ * staged value, abort reporting disconnect, a parked receiver woken by
+ * the send, drop before and after resolve, and region close
+ * reclaiming cells never received.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/core/channel.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+
+static asx_budget make_budget(uint32_t poll_quota)
+{
+    asx_budget b = asx_budget_infinite();
+    b.poll_quota = poll_quota;
+    return b;
+}
+
+TEST(oneshot_create_checks_arguments) {
+    asx_region_id rid;
+    asx_oneshot os;
+    asx_oneshot last;
+    uint32_t i;
+    uint64_t v;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_oneshot_create(rid, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_oneshot_create(ASX_INVALID_ID, &os), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_oneshot_send(NULL, 1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_oneshot_try_recv(&os, NULL), ASX_E_INVALID_ARGUMENT);
+
+    /* A zeroed oneshot names no cell */
+    os.sender = ASX_INVALID_ID;
+    os.token = 0;
+    ASSERT_EQ(asx_oneshot_try_recv(&os, &v), ASX_E_INVALID_STATE);
+
+    for (i = 0; i < ASX_MAX_ONESHOTS; i++) {
+        ASSERT_EQ(asx_oneshot_create(rid, &last), ASX_OK);
+    }
+    ASSERT_EQ(asx_oneshot_create(rid, &os), ASX_E_RESOURCE_EXHAUSTED);
+
+    /* Taking one outcome frees its cell for the next create */
+    ASSERT_EQ(asx_oneshot_send(&last, 9), ASX_OK);
+    ASSERT_EQ(asx_oneshot_try_recv(&last, &v), ASX_OK);
+    ASSERT_EQ(asx_oneshot_create(rid, &os), ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(oneshot_commit_sends_abort_disconnects) {
+    asx_region_id rid;
+    asx_oneshot a;
+    asx_oneshot b;
+    asx_obligation_state ob;
+    uint64_t v = 0;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_oneshot_create(rid, &a), ASX_OK);
+    ASSERT_EQ(asx_oneshot_create(rid, &b), ASX_OK);
+    ASSERT_EQ(asx_obligation_get_state(a.sender, &ob), ASX_OK);
+    ASSERT_EQ(ob, ASX_OBLIGATION_RESERVED);
+    ASSERT_EQ(asx_oneshot_try_recv(&a, &v), ASX_E_WOULD_BLOCK);
+
+    ASSERT_EQ(asx_oneshot_send(&a, 0xBEEFu), ASX_OK);
+    ASSERT_EQ(asx_obligation_get_state(a.sender, &ob), ASX_OK);
+    ASSERT_EQ(ob, ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(asx_oneshot_send(&a, 1), ASX_E_INVALID_TRANSITION);
+    ASSERT_EQ(asx_oneshot_try_recv(&a, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)0xBEEFu);
+    ASSERT_EQ(asx_oneshot_try_recv(&a, &v), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_oneshot_send(&a, 1), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_obligation_abort(b.sender), ASX_OK);
+    ASSERT_EQ(asx_oneshot_try_recv(&b, &v), ASX_E_DISCONNECTED);
+    ASSERT_EQ(asx_oneshot_try_recv(&b, &v), ASX_E_INVALID_STATE);
+    asx_runtime_reset();
+}
+
+ASX_CO_FRAME_BEGIN(reply_frame)
+    asx_oneshot os;
+    uint64_t    value;
+    asx_status  st;
+    int         polls;
+ASX_CO_FRAME_END(reply_frame);
+
+static asx_status reply_poll(void *user_data, asx_task_id self)
+{
+    reply_frame *f = ASX_CO_FRAME(reply_frame, user_data);
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    ASX_CO_AWAIT_ONESHOT(&f->co, self, &f->os, &f->value, f->st);
+    ASX_CO_END(&f->co);
+}
+
+TEST(oneshot_send_wakes_parked_receiver) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    void *mem = NULL;
+    reply_frame *f;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(ASX_CO_SPAWN(rid, reply_frame, reply_poll, &tid, &mem), ASX_OK);
+    f = (reply_frame *)mem;
+    ASSERT_EQ(asx_oneshot_create(rid, &f->os), ASX_OK);
+
+    budget = make_budget(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->polls, 1);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)1);
+
+    ASSERT_EQ(asx_oneshot_send(&f->os, 42), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(f->polls, 2);
+    ASSERT_EQ(f->st, ASX_OK);
+    ASSERT_EQ(f->value, (uint64_t)42);
+    asx_runtime_reset();
+}
+
+TEST(oneshot_drop_and_region_close_free_cells) {
+    asx_region_id rid;
+    asx_oneshot os[ASX_MAX_ONESHOTS];
+    asx_oneshot extra;
+    asx_budget budget;
+    uint32_t i;
+    uint64_t v;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_ONESHOTS; i++) {
+        ASSERT_EQ(asx_oneshot_create(rid, &os[i]), ASX_OK);
+    }
+
+    /* Dropped while pending: freed by the resolve, not before */
+    ASSERT_EQ(asx_oneshot_drop(&os[0]), ASX_OK);
+    ASSERT_EQ(asx_oneshot_drop(&os[0]), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_oneshot_create(rid, &extra), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_oneshot_send(&os[0], 1), ASX_OK);
+    ASSERT_EQ(asx_oneshot_create(rid, &extra), ASX_OK);
+
+    /* Dropped after resolve: freed at once */
+    ASSERT_EQ(asx_obligation_abort(os[1].sender), ASX_OK);
+    ASSERT_EQ(asx_oneshot_drop(&os[1]), ASX_OK);
+    ASSERT_EQ(asx_oneshot_create(rid, &os[1]), ASX_OK);
+
+    /* The rest resolve but are never received; close reclaims them */
+    ASSERT_EQ(asx_oneshot_send(&extra, 2), ASX_OK);
+    for (i = 1; i < ASX_MAX_ONESHOTS; i++) {
+        ASSERT_EQ(asx_oneshot_send(&os[i], i), ASX_OK);
+    }
+    budget = make_budget(100);
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_oneshot_try_recv(&os[2], &v), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_ONESHOTS; i++) {
+        ASSERT_EQ(asx_oneshot_create(rid, &os[i]), ASX_OK);
+    }
+    asx_runtime_reset();
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_oneshot ===\n");
+    RUN_TEST(oneshot_create_checks_arguments);
+    RUN_TEST(oneshot_commit_sends_abort_disconnects);
+    RUN_TEST(oneshot_send_wakes_parked_receiver);
+    RUN_TEST(oneshot_drop_and_region_close_free_cells);
+    TEST_REPORT();
+    return test_failures;
+}
@@ -144,7 +144,9 @@ TEST(task_handle_type_mismatch)
 TEST(generation_preserved_in_handle_round_trip)
 {
     asx_region_id rid;
-    uint16_t gen, slot_idx, tag;
+    asx_generation gen;
+    uint32_t slot_idx;
+    uint16_t tag;
 
     ASSERT_EQ(asx_region_open(&rid), ASX_OK);
 
@@ -153,32 +155,72 @@ TEST(generation_preserved_in_handle_round_trip)
     slot_idx = asx_handle_slot(rid);
 
     ASSERT_EQ(tag, ASX_TYPE_REGION);
-    ASSERT_EQ(gen, (uint16_t)0);
-    ASSERT_EQ(slot_idx, (uint16_t)0);
+#if ASX_HANDLE_EPOCH
+    (void)gen;
+#else
+    ASSERT_EQ(gen, (asx_generation)0);
+#endif
+    ASSERT_EQ(slot_idx, 0u);
 }
 
 TEST(generation_increments_on_recycle)
 {
     asx_region_id rid1, rid2, rid3;
     asx_budget budget;
+    asx_generation base;
 
-    /* First generation */
+    /* First generation: 0, or the reset epoch with ASX_HANDLE_EPOCH */
     ASSERT_EQ(asx_region_open(&rid1), ASX_OK);
-    ASSERT_EQ(asx_handle_generation(rid1), (uint16_t)0);
+    base = asx_handle_generation(rid1);
+#if !ASX_HANDLE_EPOCH
+    ASSERT_EQ(base, (asx_generation)0);
+#endif
 
     budget = asx_budget_infinite();
     ASSERT_EQ(asx_region_drain(rid1, &budget), ASX_OK);
 
     /* Second generation */
     ASSERT_EQ(asx_region_open(&rid2), ASX_OK);
-    ASSERT_EQ(asx_handle_generation(rid2), (uint16_t)1);
+    ASSERT_EQ(asx_handle_generation(rid2), (asx_generation)(base + 1u));
 
     budget = asx_budget_infinite();
     ASSERT_EQ(asx_region_drain(rid2, &budget), ASX_OK);
 
     /* Third generation */
     ASSERT_EQ(asx_region_open(&rid3), ASX_OK);
-    ASSERT_EQ(asx_handle_generation(rid3), (uint16_t)2);
+    ASSERT_EQ(asx_handle_generation(rid3), (asx_generation)(base + 2u));
+}
+
+TEST(slot_key_lookup_classifies_misses)
+{
+    asx_region_id rid;
+    asx_region_slot *r = NULL;
+    asx_task_slot *t = NULL;
+
+    /* Never-used slot 0: a tag-0, generation-0 handle keys to 0 too */
+    ASSERT_EQ(asx_region_slot_lookup(ASX_INVALID_ID, &r), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_task_slot_lookup(asx_handle_pack(ASX_TYPE_TASK, 0, 0), &t),
+              ASX_E_NOT_FOUND);
+    ASSERT_TRUE(t == NULL);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_region_slot_lookup(rid, &r), ASX_OK);
+    ASSERT_TRUE(r == asx_region_at(0));
+    ASSERT_EQ(r->key, asx_handle_key(rid));
+
+    /* The state mask is not part of the key */
+    ASSERT_EQ(asx_region_slot_lookup(asx_handle_pack(ASX_TYPE_REGION, 0,
+                                                     asx_handle_index(rid)), &r),
+              ASX_OK);
+    ASSERT_EQ(asx_region_slot_lookup(asx_handle_pack(0, 0, asx_handle_index(rid)), &r),
+              ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_region_slot_lookup(asx_handle_pack(ASX_TYPE_REGION, 0,
+                                                     asx_handle_pack_index(1, 0)), &r),
+              ASX_E_STALE_HANDLE);
+    ASSERT_TRUE(r == NULL);
+    ASSERT_EQ(asx_region_slot_lookup(asx_handle_pack(ASX_TYPE_REGION, 0,
+                                                     asx_handle_pack_index(0, g_region_capacity)), &r),
+              ASX_E_NOT_FOUND);
 }
 
 /* ------------------------------------------------------------------ */
@@ -255,11 +297,15 @@ TEST(cleanup_drain_idempotent)
 
 TEST(cleanup_capacity_limit)
 {
+    asx_runtime_hooks hooks;
     asx_cleanup_stack stack;
     asx_cleanup_handle h;
     int v = 0;
     uint32_t i;
 
+    /* Entries past the inline ones need the allocator hook */
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
     asx_cleanup_init(&stack);
 
     /* Fill to capacity */
@@ -270,6 +316,7 @@ TEST(cleanup_capacity_limit)
     /* One more should fail */
     ASSERT_EQ(asx_cleanup_push(&stack, cleanup_record, &v, &h),
               ASX_E_RESOURCE_EXHAUSTED);
+    asx_cleanup_release(&stack);
 }
 
 TEST(cleanup_pop_invalid_handle)
@@ -301,8 +348,8 @@ TEST(cleanup_drain_during_region_finalize)
 
     /* Push cleanups onto the region's internal stack */
     {
-        uint16_t slot_idx = asx_handle_slot(rid);
-        asx_cleanup_stack *stk = &g_regions[slot_idx].cleanup;
+        uint32_t slot_idx = asx_handle_slot(rid);
+        asx_cleanup_stack *stk = &asx_region_at(slot_idx)->cleanup;
 
         ASSERT_EQ(asx_cleanup_push(stk, cleanup_record, &v1, &h1), ASX_OK);
         ASSERT_EQ(asx_cleanup_push(stk, cleanup_record, &v2, &h2), ASX_OK);
@@ -318,6 +365,67 @@ TEST(cleanup_drain_during_region_finalize)
     ASSERT_EQ(g_cleanup_log[1], 100);
 }
 
+TEST(region_drain_step_bounds_polls_and_cleanups)
+{
+    asx_region_options opts;
+    asx_region_id rid, child;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_region_drain_phase phase;
+    asx_region_state state;
+    asx_cleanup_stack *stk;
+    asx_cleanup_handle h;
+    int vals[5] = {1, 2, 3, 4, 5};
+    int i;
+
+    cleanup_log_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    asx_region_options_init(&opts);
+    opts.parent = rid;
+    ASSERT_EQ(asx_region_open_with(&opts, &child), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, noop_poll, NULL, &tid), ASX_OK);
+    }
+    stk = &asx_region_at(asx_handle_slot(rid))->cleanup;
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_cleanup_push(stk, cleanup_record, &vals[i], &h), ASX_OK);
+    }
+    ASSERT_EQ(asx_cleanup_push(&asx_region_at(asx_handle_slot(child))->cleanup,
+                               cleanup_record, &vals[4], &h), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 2, NULL), ASX_E_INVALID_ARGUMENT);
+
+    /* The child's callback is the subtree's first */
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 0, &phase), ASX_E_PENDING);
+    ASSERT_EQ((int)phase, (int)ASX_REGION_DRAIN_CHILDREN);
+
+    /* Child closes, then one poll and out of budget with tasks left */
+    budget = asx_budget_from_polls(1);
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 1, &phase), ASX_E_PENDING);
+    ASSERT_EQ((int)phase, (int)ASX_REGION_DRAIN_TASKS);
+    ASSERT_EQ(g_cleanup_log_count, 1);
+    ASSERT_EQ(asx_region_get_state(child, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_REGION_CLOSED);
+
+    /* Tasks done; two of the four cleanups per step, newest first */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 2, &phase), ASX_E_PENDING);
+    ASSERT_EQ((int)phase, (int)ASX_REGION_DRAIN_CLEANUP);
+    ASSERT_EQ(asx_region_get_state(rid, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_REGION_FINALIZING);
+    ASSERT_EQ(g_cleanup_log_count, 3);
+    ASSERT_EQ(g_cleanup_log[1], 4);
+    ASSERT_EQ(g_cleanup_log[2], 3);
+
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 2, &phase), ASX_OK);
+    ASSERT_EQ((int)phase, (int)ASX_REGION_DRAIN_DONE);
+    ASSERT_EQ(g_cleanup_log_count, 5);
+    ASSERT_EQ(g_cleanup_log[4], 1);
+    ASSERT_EQ(asx_quiescence_check(rid), ASX_OK);
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 2, &phase), ASX_OK);
+}
+
 /* ------------------------------------------------------------------ */
 /* Main                                                                */
 /* ------------------------------------------------------------------ */
@@ -334,14 +442,16 @@ int main(void)
     asx_runtime_reset(); RUN_TEST(task_handle_type_mismatch);
     asx_runtime_reset(); RUN_TEST(generation_preserved_in_handle_round_trip);
     asx_runtime_reset(); RUN_TEST(generation_increments_on_recycle);
+    asx_runtime_reset(); RUN_TEST(slot_key_lookup_classifies_misses);
 
     /* Cleanup-stack tests */
     RUN_TEST(cleanup_stack_lifo_order);
     RUN_TEST(cleanup_pop_skips_during_drain);
     RUN_TEST(cleanup_drain_idempotent);
-    RUN_TEST(cleanup_capacity_limit);
     RUN_TEST(cleanup_pop_invalid_handle);
     asx_runtime_reset(); RUN_TEST(cleanup_drain_during_region_finalize);
+    asx_runtime_reset(); RUN_TEST(region_drain_step_bounds_polls_and_cleanups);
+    RUN_TEST(cleanup_capacity_limit);   /* installs hooks */
 
     TEST_REPORT();
     return test_failures;
@@ -2,7 +2,8 @@
  * test_adaptive.c — unit tests for adaptive-decision contract
  *
  * Tests expected-loss decision layer, evidence ledger, deterministic
- * fallback, and replay digest stability.
+ * fallback, replay digest stability, the incremental engine and
+ * ledger sampling.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -492,6 +493,162 @@ TEST(high_confidence_uses_adaptive_not_fallback)
     ASSERT_EQ(result.used_fallback, 0);
 }
 
+static void two_state_surface(asx_adaptive_surface *surface)
+{
+    memset(surface, 0, sizeof(*surface));
+    surface->name = "engine";
+    surface->action_count = 2;
+    surface->state_count  = 2;
+    surface->loss_fn      = test_loss_fn;
+    surface->fallback     = 1;
+}
+
+static void two_state_posterior(asx_adaptive_posterior *posterior,
+                                uint32_t p0, uint32_t confidence)
+{
+    memset(posterior, 0, sizeof(*posterior));
+    posterior->posterior[0] = p0;
+    posterior->posterior[1] = UINT32_MAX - p0;
+    posterior->state_count  = 2;
+    posterior->confidence_fp32 = confidence;
+}
+
+TEST(engine_matches_reference_decide)
+{
+    asx_adaptive_surface surface;
+    asx_adaptive_posterior posterior;
+    asx_adaptive_engine eng;
+    asx_adaptive_decision ref[8];
+    asx_adaptive_decision got;
+    asx_adaptive_policy policy;
+    uint64_t ref_digest;
+    uint32_t i;
+
+    two_state_surface(&surface);
+    policy.confidence_threshold_fp32 = 1u << 30;
+    policy.budget_remaining = 7;
+
+    /* Reference: full recomputation each decision */
+    asx_adaptive_init();
+    ASSERT_EQ(asx_adaptive_set_policy(&policy), ASX_OK);
+    for (i = 0; i < 8u; i++) {
+        two_state_posterior(&posterior, i * 0x1F000000u, i * 0x20000000u);
+        ASSERT_EQ(asx_adaptive_decide(&surface, &posterior, NULL, 0, &ref[i]),
+                  ASX_OK);
+    }
+    ref_digest = asx_adaptive_ledger_digest();
+
+    /* Engine fed the same posteriors */
+    asx_adaptive_init();
+    ASSERT_EQ(asx_adaptive_set_policy(&policy), ASX_OK);
+    two_state_posterior(&posterior, 0, 0);
+    ASSERT_EQ(asx_adaptive_engine_init(&eng, &surface, &posterior), ASX_OK);
+    for (i = 0; i < 8u; i++) {
+        two_state_posterior(&posterior, i * 0x1F000000u, i * 0x20000000u);
+        ASSERT_EQ(asx_adaptive_engine_update(&eng, &posterior), ASX_OK);
+        ASSERT_EQ(asx_adaptive_engine_decide(&eng, NULL, 0, &got), ASX_OK);
+        ASSERT_EQ(got.selected, ref[i].selected);
+        ASSERT_EQ(got.expected_loss_fp16, ref[i].expected_loss_fp16);
+        ASSERT_EQ(got.counterfactual, ref[i].counterfactual);
+        ASSERT_EQ(got.cf_loss_fp16, ref[i].cf_loss_fp16);
+        ASSERT_EQ(got.used_fallback, ref[i].used_fallback);
+    }
+    ASSERT_EQ(asx_adaptive_ledger_digest(), ref_digest);
+    ASSERT_EQ(asx_adaptive_fallback_count(), 3u); /* low conf x2, budget x1 */
+}
+
+TEST(engine_observe_moves_selection)
+{
+    asx_adaptive_surface surface;
+    asx_adaptive_posterior posterior;
+    asx_adaptive_engine eng;
+    asx_adaptive_decision result;
+
+    asx_adaptive_init();
+    two_state_surface(&surface);
+    /* All mass on state 0: aggressive action 1 wins (5 < 10) */
+    two_state_posterior(&posterior, UINT32_MAX, UINT32_MAX);
+    ASSERT_EQ(asx_adaptive_engine_init(&eng, &surface, &posterior), ASX_OK);
+    ASSERT_EQ(asx_adaptive_engine_decide(&eng, NULL, 0, &result), ASX_OK);
+    ASSERT_EQ(result.selected, 1u);
+
+    /* Evidence for state 1 flips the choice to cautious action 0 */
+    ASSERT_EQ(asx_adaptive_engine_observe(&eng, 0, 0x80000000u), ASX_OK);
+    ASSERT_EQ(asx_adaptive_engine_observe(&eng, 1, 0x80000000u), ASX_OK);
+    ASSERT_EQ(asx_adaptive_engine_decide(&eng, NULL, 0, &result), ASX_OK);
+    ASSERT_EQ(result.selected, 0u);
+    ASSERT_EQ(result.expected_loss_fp16, 20u << 16);
+    ASSERT_EQ(result.cf_loss_fp16, (55u << 16) / 2u);
+}
+
+TEST(engine_rejects_invalid_arguments)
+{
+    asx_adaptive_surface surface;
+    asx_adaptive_posterior posterior;
+    asx_adaptive_engine eng;
+    asx_adaptive_decision result;
+
+    asx_adaptive_init();
+    two_state_surface(&surface);
+    two_state_posterior(&posterior, 0, 0);
+    ASSERT_EQ(asx_adaptive_engine_init(NULL, &surface, &posterior),
+              ASX_E_INVALID_ARGUMENT);
+    posterior.state_count = 1;
+    ASSERT_EQ(asx_adaptive_engine_init(&eng, &surface, &posterior),
+              ASX_E_INVALID_ARGUMENT);
+    posterior.state_count = 2;
+    ASSERT_EQ(asx_adaptive_engine_init(&eng, &surface, &posterior), ASX_OK);
+    ASSERT_EQ(asx_adaptive_engine_observe(&eng, 2, 0), ASX_E_INVALID_ARGUMENT);
+    posterior.state_count = 3;
+    ASSERT_EQ(asx_adaptive_engine_update(&eng, &posterior),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_adaptive_engine_decide(&eng, NULL, 0, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_adaptive_engine_decide(NULL, NULL, 0, &result),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(ledger_sampling_records_every_nth)
+{
+    asx_adaptive_surface surface;
+    asx_adaptive_posterior posterior;
+    asx_adaptive_decision result;
+    asx_adaptive_ledger_entry entry;
+    uint64_t first;
+    uint32_t i;
+
+    two_state_surface(&surface);
+    two_state_posterior(&posterior, 0x40000000u, UINT32_MAX);
+
+    asx_adaptive_init();
+    asx_adaptive_set_ledger_sampling(4);
+    for (i = 0; i < 10u; i++) {
+        ASSERT_EQ(asx_adaptive_decide(&surface, &posterior, NULL, 0, &result),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_adaptive_ledger_count(), 3u);
+    ASSERT_TRUE(asx_adaptive_ledger_get(2, &entry));
+    ASSERT_EQ(entry.sequence, 8u);
+    first = asx_adaptive_ledger_digest();
+
+    /* Same run, same sampled entries */
+    asx_adaptive_init();
+    asx_adaptive_set_ledger_sampling(4);
+    for (i = 0; i < 10u; i++) {
+        ASSERT_EQ(asx_adaptive_decide(&surface, &posterior, NULL, 0, &result),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_adaptive_ledger_digest(), first);
+
+    /* 0 disables the ledger; reset restores full logging */
+    asx_adaptive_set_ledger_sampling(0);
+    ASSERT_EQ(asx_adaptive_decide(&surface, &posterior, NULL, 0, &result), ASX_OK);
+    ASSERT_EQ(asx_adaptive_ledger_count(), 3u);
+    asx_adaptive_reset();
+    ASSERT_EQ(asx_adaptive_decide(&surface, &posterior, NULL, 0, &result), ASX_OK);
+    ASSERT_EQ(asx_adaptive_ledger_count(), 1u);
+}
+
 /* ------------------------------------------------------------------ */
 /* Test runner                                                        */
 /* ------------------------------------------------------------------ */
@@ -519,6 +676,10 @@ int main(void)
     RUN_TEST(ledger_get_out_of_bounds_returns_zero);
     RUN_TEST(single_action_surface);
     RUN_TEST(high_confidence_uses_adaptive_not_fallback);
+    RUN_TEST(engine_matches_reference_decide);
+    RUN_TEST(engine_observe_moves_selection);
+    RUN_TEST(engine_rejects_invalid_arguments);
+    RUN_TEST(ledger_sampling_records_every_nth);
 
     TEST_REPORT();
     return test_failures;
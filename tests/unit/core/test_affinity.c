@@ -320,6 +320,34 @@ TEST(affinity_unbind_frees_slot) {
     ASSERT_EQ(asx_affinity_bind(eid2, 10u), ASX_OK);
 }
 
+TEST(affinity_unbind_keeps_colliding_entries) {
+    uint64_t base = 0x0001000100010000ULL;
+    asx_affinity_domain dom = 0;
+    uint32_t i;
+
+    asx_affinity_reset();
+
+    for (i = 0; i < ASX_AFFINITY_TABLE_CAPACITY; i++) {
+        ASSERT_EQ(asx_affinity_bind(base + i + 1u, i + 1u), ASX_OK);
+    }
+
+    /* Unbinding shifts probe runs; every survivor keeps its domain */
+    for (i = 0; i < ASX_AFFINITY_TABLE_CAPACITY; i += 3u) {
+        asx_affinity_unbind(base + i + 1u);
+    }
+    for (i = 0; i < ASX_AFFINITY_TABLE_CAPACITY; i++) {
+        if (i % 3u == 0u) {
+            ASSERT_EQ(asx_affinity_get_domain(base + i + 1u, &dom),
+                      ASX_E_AFFINITY_NOT_BOUND);
+        } else {
+            ASSERT_EQ(asx_affinity_get_domain(base + i + 1u, &dom), ASX_OK);
+            ASSERT_EQ(dom, i + 1u);
+        }
+    }
+    ASSERT_EQ(asx_affinity_tracked_count(),
+              ASX_AFFINITY_TABLE_CAPACITY - (ASX_AFFINITY_TABLE_CAPACITY + 2u) / 3u);
+}
+
 /* ================================================================== */
 /* Status String Tests                                                 */
 /* ================================================================== */
@@ -399,6 +427,7 @@ int main(void) {
     /* Table capacity */
     RUN_TEST(affinity_table_capacity);
     RUN_TEST(affinity_unbind_frees_slot);
+    RUN_TEST(affinity_unbind_keeps_colliding_entries);
 
     /* Status strings */
     RUN_TEST(affinity_status_strings);
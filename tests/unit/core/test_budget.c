@@ -150,6 +150,43 @@ TEST(budget_deadline_max) {
     ASSERT_TRUE(asx_budget_is_past_deadline(&b, UINT64_MAX));
 }
 
+TEST(budget_meet_deadline_zero_is_unconstrained) {
+    asx_budget a = {0, 50, 1000, 128};
+    asx_budget b = {UINT64_MAX, 50, 1000, 128};
+    asx_budget result = asx_budget_meet(&a, &b);
+    ASSERT_EQ(result.deadline, (asx_time)UINT64_MAX);
+    result = asx_budget_meet(&a, &a);
+    ASSERT_EQ(result.deadline, (asx_time)0);
+    b.deadline = 1;
+    result = asx_budget_meet(&b, &a);
+    ASSERT_EQ(result.deadline, (asx_time)1);
+}
+
+TEST(budget_meet_each_matches_pairwise_meet) {
+    asx_budget bound = {150, 40, 500, 100};
+    asx_budget batch[5] = {
+        {0, UINT32_MAX, UINT64_MAX, 255},
+        {100, 50, 1000, 128},
+        {200, 30, 2000, 64},
+        {UINT64_MAX, 0, 0, 0},
+        {150, 40, 500, 100}
+    };
+    asx_budget expect[5];
+    uint32_t i;
+
+    for (i = 0; i < 5u; i++) expect[i] = asx_budget_meet(&batch[i], &bound);
+    asx_budget_meet_each(batch, 5u, &bound);
+    for (i = 0; i < 5u; i++) {
+        ASSERT_EQ(batch[i].deadline, expect[i].deadline);
+        ASSERT_EQ(batch[i].poll_quota, expect[i].poll_quota);
+        ASSERT_EQ(batch[i].cost_quota, expect[i].cost_quota);
+        ASSERT_EQ(batch[i].priority, expect[i].priority);
+    }
+    ASSERT_EQ(batch[0].deadline, (asx_time)150);
+    asx_budget_meet_each(NULL, 5u, &bound);
+    asx_budget_meet_each(batch, 5u, NULL);
+}
+
 int main(void) {
     test_log_open("unit", "core/budget", "test_budget");
     fprintf(stderr, "=== test_budget ===\n");
@@ -168,6 +205,8 @@ int main(void) {
     RUN_TEST(budget_consume_cost_zero);
     RUN_TEST(budget_consume_cost_exact_boundary);
     RUN_TEST(budget_deadline_max);
+    RUN_TEST(budget_meet_deadline_zero_is_unconstrained);
+    RUN_TEST(budget_meet_each_matches_pairwise_meet);
     TEST_REPORT();
     test_log_close();
     return test_failures;
@@ -6,6 +6,8 @@
 
 #include "test_harness.h"
 #include <asx/core/cleanup.h>
+#include <asx/asx_config.h>
+#include <stdlib.h>
 
 /* ---- Test helpers ---- */
 
@@ -35,6 +37,32 @@ static void increment_counter(void *user_data)
     (*counter)++;
 }
 
+static int g_fail_alloc;
+
+static void *failing_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    if (g_fail_alloc) return NULL;
+    return malloc(size);
+}
+
+static void plain_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    free(ptr);
+}
+
+/* Entries past the inline ones need an allocator hook */
+static void install_hooks(void)
+{
+    asx_runtime_hooks hooks;
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.allocator.malloc_fn = failing_malloc;
+    hooks.allocator.free_fn   = plain_free;
+    g_fail_alloc = 0;
+    (void)asx_runtime_set_hooks(&hooks);
+}
+
 /* ---- Tests ---- */
 
 TEST(cleanup_init_empty) {
@@ -213,6 +241,7 @@ TEST(cleanup_capacity_exhaustion) {
     asx_cleanup_handle h;
     uint32_t i;
 
+    install_hooks();
     asx_cleanup_init(&s);
     for (i = 0; i < ASX_CLEANUP_STACK_CAPACITY; i++) {
         ASSERT_EQ(asx_cleanup_push(&s, increment_counter, NULL, &h), ASX_OK);
@@ -222,6 +251,96 @@ TEST(cleanup_capacity_exhaustion) {
     /* One more should fail */
     ASSERT_EQ(asx_cleanup_push(&s, increment_counter, NULL, &h),
               ASX_E_RESOURCE_EXHAUSTED);
+    asx_cleanup_release(&s);
+}
+
+TEST(cleanup_chunked_entries_drain_lifo) {
+    asx_cleanup_stack s;
+    asx_cleanup_handle h;
+    int ids[40];
+    int i;
+
+    reset_tracker();
+    install_hooks();
+    asx_cleanup_init(&s);
+    for (i = 0; i < 40; i++) {
+        ids[i] = i;
+        ASSERT_EQ(asx_cleanup_push(&s, track_cleanup, &ids[i], &h), ASX_OK);
+    }
+    ASSERT_TRUE(s.chunks != NULL);
+    ASSERT_EQ(asx_cleanup_pending(&s), (uint32_t)40);
+
+    asx_cleanup_drain(&s);
+    ASSERT_EQ(g_call_count, 40);
+    for (i = 0; i < 40; i++) {
+        ASSERT_EQ(g_call_order[i], 39 - i);
+    }
+    ASSERT_EQ(asx_cleanup_pending(&s), (uint32_t)0);
+    asx_cleanup_release(&s);
+    ASSERT_TRUE(s.chunks == NULL);
+}
+
+TEST(cleanup_chunked_pop_and_stale_handle) {
+    asx_cleanup_stack s;
+    asx_cleanup_handle hs[30];
+    asx_cleanup_handle h;
+    int counter = 0;
+    uint32_t i;
+
+    install_hooks();
+    asx_cleanup_init(&s);
+    for (i = 0; i < 30u; i++) {
+        ASSERT_EQ(asx_cleanup_push(&s, increment_counter, &counter, &hs[i]),
+                  ASX_OK);
+    }
+    /* Middle of a chunk, then the top down across a chunk boundary */
+    ASSERT_EQ(asx_cleanup_pop(&s, hs[10]), ASX_OK);
+    ASSERT_EQ(asx_cleanup_pop(&s, hs[10]), ASX_E_NOT_FOUND);
+    for (i = 30u; i > 19u; i--) {
+        ASSERT_EQ(asx_cleanup_pop(&s, hs[i - 1u]), ASX_OK);
+    }
+    ASSERT_EQ(asx_cleanup_pending(&s), (uint32_t)18);
+    ASSERT_EQ(s.count, 19u);
+
+    asx_cleanup_drain(&s);
+    ASSERT_EQ(counter, 18);
+
+    /* Chunks survive the drain, so reused slots get new generations */
+    ASSERT_EQ(asx_cleanup_push(&s, increment_counter, &counter, &h), ASX_OK);
+    for (i = 1u; i < 15u; i++) {
+        ASSERT_EQ(asx_cleanup_push(&s, increment_counter, &counter, &h), ASX_OK);
+    }
+    ASSERT_NE(h, hs[14]);
+    ASSERT_EQ(asx_cleanup_pop(&s, hs[14]), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_cleanup_pop(&s, h), ASX_OK);
+    asx_cleanup_release(&s);
+    ASSERT_EQ(counter, 18);
+}
+
+TEST(cleanup_drain_some_is_bounded_lifo) {
+    asx_cleanup_stack s;
+    asx_cleanup_handle h, mid;
+    int ids[4] = {0, 1, 2, 3};
+    int i;
+
+    reset_tracker();
+    asx_cleanup_init(&s);
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_cleanup_push(&s, track_cleanup, &ids[i], i == 2 ? &mid : &h),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_cleanup_pop(&s, mid), ASX_OK);
+
+    /* Popped entries are skipped and not charged */
+    ASSERT_EQ(asx_cleanup_drain_some(&s, 2), (uint32_t)2);
+    ASSERT_EQ(g_call_order[0], 3);
+    ASSERT_EQ(g_call_order[1], 1);
+    ASSERT_EQ(asx_cleanup_pending(&s), (uint32_t)1);
+    ASSERT_EQ(asx_cleanup_drain_some(&s, 0), (uint32_t)0);
+    ASSERT_EQ(asx_cleanup_drain_some(&s, 5), (uint32_t)1);
+    ASSERT_EQ(g_call_order[2], 0);
+    ASSERT_EQ(asx_cleanup_drain_some(&s, 5), (uint32_t)0);
+    ASSERT_EQ(asx_cleanup_drain_some(NULL, 5), (uint32_t)0);
 }
 
 TEST(cleanup_pending_null) {
@@ -248,6 +367,28 @@ TEST(cleanup_pop_null_stack) {
     ASSERT_EQ(asx_cleanup_pop(NULL, 0), ASX_E_INVALID_ARGUMENT);
 }
 
+TEST(cleanup_chunk_alloc_failure_exhausts) {
+    asx_cleanup_stack s;
+    asx_cleanup_handle h;
+    uint32_t i;
+
+    install_hooks();
+    g_fail_alloc = 1;
+
+    asx_cleanup_init(&s);
+    for (i = 0; i < ASX_CLEANUP_INLINE_CAPACITY; i++) {
+        ASSERT_EQ(asx_cleanup_push(&s, increment_counter, NULL, &h), ASX_OK);
+    }
+    ASSERT_EQ(asx_cleanup_push(&s, increment_counter, NULL, &h),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_cleanup_pending(&s), (uint32_t)ASX_CLEANUP_INLINE_CAPACITY);
+
+    g_fail_alloc = 0;
+    ASSERT_EQ(asx_cleanup_push(&s, increment_counter, NULL, &h), ASX_OK);
+    asx_cleanup_release(&s);
+    ASSERT_EQ(asx_cleanup_pending(&s), (uint32_t)0);
+}
+
 int main(void) {
     fprintf(stderr, "=== test_cleanup ===\n");
     RUN_TEST(cleanup_init_empty);
@@ -265,10 +406,14 @@ int main(void) {
     RUN_TEST(cleanup_drain_empty_is_noop);
     RUN_TEST(cleanup_drain_null_is_safe);
     RUN_TEST(cleanup_capacity_exhaustion);
+    RUN_TEST(cleanup_drain_some_is_bounded_lifo);
     RUN_TEST(cleanup_pending_null);
     RUN_TEST(cleanup_init_null_is_safe);
     RUN_TEST(cleanup_user_data_passed_through);
+    RUN_TEST(cleanup_chunked_entries_drain_lifo);
+    RUN_TEST(cleanup_chunked_pop_and_stale_handle);
     RUN_TEST(cleanup_pop_null_stack);
+    RUN_TEST(cleanup_chunk_alloc_failure_exhausts);
     TEST_REPORT();
     return test_failures;
 }
@@ -3,7 +3,7 @@
  *
  * Tests: roundtrip load/store for LE/BE u16/u32/u64, unaligned buffer
  * access, edge cases (0, MAX), byte-order canaries, cross-endian
- * fixture validation.
+ * fixture validation, bulk array conversion.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -260,6 +260,67 @@ TEST(be_known_vector_fixture_length) {
     ASSERT_EQ(buf[3], (uint8_t)0x00);
 }
 
+/* ---- Bulk array helpers ---- */
+
+#define BULK_N 37u  /* odd length: no vector-width multiple */
+
+TEST(bulk_u32_arrays_match_scalar) {
+    uint32_t src[BULK_N], back[BULK_N];
+    uint8_t bulk[BULK_N * 4u + 1u], scalar[BULK_N * 4u];
+    uint32_t i;
+
+    for (i = 0; i < BULK_N; i++) src[i] = 0x01020304u * (i + 1u);
+
+    /* Offset 1: destination unaligned */
+    asx_store_le_u32_array(bulk + 1, src, BULK_N);
+    for (i = 0; i < BULK_N; i++) asx_store_le_u32(scalar + i * 4u, src[i]);
+    ASSERT_EQ(memcmp(bulk + 1, scalar, sizeof(scalar)), 0);
+    asx_load_le_u32_array(back, bulk + 1, BULK_N);
+    ASSERT_EQ(memcmp(back, src, sizeof(src)), 0);
+
+    asx_store_be_u32_array(bulk + 1, src, BULK_N);
+    for (i = 0; i < BULK_N; i++) asx_store_be_u32(scalar + i * 4u, src[i]);
+    ASSERT_EQ(memcmp(bulk + 1, scalar, sizeof(scalar)), 0);
+    asx_load_be_u32_array(back, bulk + 1, BULK_N);
+    ASSERT_EQ(memcmp(back, src, sizeof(src)), 0);
+}
+
+TEST(bulk_u64_arrays_match_scalar) {
+    uint64_t src[BULK_N], back[BULK_N];
+    uint8_t bulk[BULK_N * 8u + 3u], scalar[BULK_N * 8u];
+    uint32_t i;
+
+    for (i = 0; i < BULK_N; i++) src[i] = 0x0102030405060708ULL * (i + 1u);
+
+    asx_store_le_u64_array(bulk + 3, src, BULK_N);
+    for (i = 0; i < BULK_N; i++) asx_store_le_u64(scalar + i * 8u, src[i]);
+    ASSERT_EQ(memcmp(bulk + 3, scalar, sizeof(scalar)), 0);
+    asx_load_le_u64_array(back, bulk + 3, BULK_N);
+    ASSERT_EQ(memcmp(back, src, sizeof(src)), 0);
+
+    asx_store_be_u64_array(bulk + 3, src, BULK_N);
+    for (i = 0; i < BULK_N; i++) asx_store_be_u64(scalar + i * 8u, src[i]);
+    ASSERT_EQ(memcmp(bulk + 3, scalar, sizeof(scalar)), 0);
+    asx_load_be_u64_array(back, bulk + 3, BULK_N);
+    ASSERT_EQ(memcmp(back, src, sizeof(src)), 0);
+}
+
+TEST(bulk_known_vectors_and_empty) {
+    uint32_t v32 = 0x41535874u;
+    uint64_t v64 = 0x0102030405060708ULL;
+    uint8_t buf[8] = { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+
+    asx_store_le_u32_array(buf, &v32, 0);
+    ASSERT_EQ(buf[0], (uint8_t)0xAA);
+
+    asx_store_le_u32_array(buf, &v32, 1);
+    ASSERT_EQ(buf[0], (uint8_t)0x74);
+    ASSERT_EQ(buf[3], (uint8_t)0x41);
+    asx_store_be_u64_array(buf, &v64, 1);
+    ASSERT_EQ(buf[0], (uint8_t)0x01);
+    ASSERT_EQ(buf[7], (uint8_t)0x08);
+}
+
 /* ---- Test suite runner ---- */
 
 int main(void) {
@@ -288,6 +349,9 @@ int main(void) {
     RUN_TEST(endian_detection_defined);
     RUN_TEST(le_known_vector_trace_magic);
     RUN_TEST(be_known_vector_fixture_length);
+    RUN_TEST(bulk_u32_arrays_match_scalar);
+    RUN_TEST(bulk_u64_arrays_match_scalar);
+    RUN_TEST(bulk_known_vectors_and_empty);
     TEST_REPORT();
     return test_failures;
 }
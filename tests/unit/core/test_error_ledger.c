@@ -132,6 +132,47 @@ TEST(ledger_overflow_is_deterministic_ring) {
     ASSERT_EQ(newest.sequence, total - 1u);
 }
 
+static asx_task_id slot_task(asx_generation generation, uint32_t slot)
+{
+    return asx_handle_pack(ASX_TYPE_TASK, 0,
+                           asx_handle_pack_index(generation, slot));
+}
+
+TEST(ledger_rings_are_pooled_per_failing_slot) {
+    asx_error_ledger_entry entry;
+    asx_task_id high = slot_task(1u, ASX_ERROR_LEDGER_TASK_SLOTS - 1u);
+    uint16_t i;
+
+    asx_error_ledger_reset();
+
+    /* A high slot keeps its own ledger; a recycled generation restarts */
+    asx_error_ledger_record_for_task(high, ASX_E_CANCELLED, "high", "pool", 1u);
+    ASSERT_EQ(asx_error_ledger_count(high), 1u);
+    asx_error_ledger_record_for_task(slot_task(2u, asx_handle_slot(high)),
+                                     ASX_E_CANCELLED, "recycled", "pool", 2u);
+    ASSERT_EQ(asx_error_ledger_count(high), 0u);
+    ASSERT_EQ(asx_error_ledger_count(slot_task(2u, asx_handle_slot(high))), 1u);
+
+    /* Fill the pool: one failing task per slot */
+    for (i = 1; i < ASX_ERROR_LEDGER_RINGS; i++) {
+        asx_error_ledger_record_for_task(slot_task(1u, i), ASX_E_INVALID_STATE,
+                                         "storm", "pool", i);
+    }
+    ASSERT_EQ(asx_error_ledger_count(slot_task(1u, 0u)), 0u);   /* healthy */
+
+    /* One more failing slot reclaims the earliest ring */
+    asx_error_ledger_record_for_task(slot_task(1u, 0u), ASX_E_INVALID_STATE,
+                                     "late", "pool", 99u);
+    ASSERT_EQ(asx_error_ledger_count(slot_task(2u, asx_handle_slot(high))), 0u);
+    ASSERT_EQ(asx_error_ledger_count(slot_task(1u, 0u)), 1u);
+    ASSERT_TRUE(asx_error_ledger_get(slot_task(1u, 0u), 0u, &entry));
+    ASSERT_EQ(entry.task_id, slot_task(1u, 0u));
+    ASSERT_EQ(entry.line, 99u);
+    for (i = 1; i < ASX_ERROR_LEDGER_RINGS; i++) {
+        ASSERT_EQ(asx_error_ledger_count(slot_task(1u, i)), 1u);
+    }
+}
+
 TEST(must_use_manifest_covers_transition_and_acquisition_surfaces) {
     ASSERT_TRUE(asx_must_use_surface_count() >= 10u);
     ASSERT_TRUE(manifest_contains("asx_region_transition_check"));
@@ -152,6 +193,7 @@ int main(void) {
     RUN_TEST(try_captures_multi_hop_breadcrumbs);
     RUN_TEST(try_task_uses_explicit_task_context);
     RUN_TEST(ledger_overflow_is_deterministic_ring);
+    RUN_TEST(ledger_rings_are_pooled_per_failing_slot);
     RUN_TEST(must_use_manifest_covers_transition_and_acquisition_surfaces);
     TEST_REPORT();
     return test_failures;
@@ -332,6 +332,67 @@ TEST(determinism_check_without_seal) {
     ASSERT_EQ(asx_ghost_determinism_check(), 0u);
 }
 
+TEST(determinism_long_run_locates_drift_window) {
+    uint32_t i;
+    uint32_t first = 0, len = 0;
+
+    asx_ghost_reset();
+    for (i = 0; i < 100000u; i++) asx_ghost_determinism_record(i * 7u);
+    asx_ghost_determinism_seal();
+
+    /* Identical replay, far past the key buffer */
+    for (i = 0; i < 100000u; i++) asx_ghost_determinism_record(i * 7u);
+    ASSERT_FALSE(asx_ghost_determinism_locate(&first, &len));
+    ASSERT_EQ(asx_ghost_determinism_check(), 0u);
+
+    /* One key changed: located to a single window holding it */
+    asx_ghost_reset();
+    for (i = 0; i < 100000u; i++) asx_ghost_determinism_record(i * 7u);
+    asx_ghost_determinism_seal();
+    for (i = 0; i < 100000u; i++) {
+        asx_ghost_determinism_record(i == 70001u ? 1u : i * 7u);
+    }
+    ASSERT_TRUE(asx_ghost_determinism_locate(&first, &len));
+    ASSERT_TRUE(first <= 70001u && 70001u < first + len);
+    ASSERT_TRUE(len <= 100000u / (ASX_GHOST_DETERMINISM_WINDOWS / 2u));
+    ASSERT_EQ(asx_ghost_determinism_check(), 1u);
+    ASSERT_EQ(asx_ghost_violation_count(), 1u);
+
+    /* Change in the unfinished tail window */
+    asx_ghost_reset();
+    for (i = 0; i < 1000u; i++) asx_ghost_determinism_record(i);
+    asx_ghost_determinism_seal();
+    for (i = 0; i < 1000u; i++) asx_ghost_determinism_record(i == 999u ? 0u : i);
+    ASSERT_TRUE(asx_ghost_determinism_locate(&first, &len));
+    ASSERT_TRUE(first <= 999u && 999u < first + len);
+}
+
+TEST(determinism_long_prefix_run_diverges_where_it_ends) {
+    uint32_t i;
+    uint32_t first = 0, len = 0;
+
+    asx_ghost_reset();
+    for (i = 0; i < 100000u; i++) asx_ghost_determinism_record(i);
+    asx_ghost_determinism_seal();
+
+    /* Half as long: window tables sit at different levels */
+    for (i = 0; i < 50000u; i++) asx_ghost_determinism_record(i);
+    ASSERT_TRUE(asx_ghost_determinism_locate(&first, &len));
+    ASSERT_TRUE(first <= 50000u && 50000u < first + len);
+    ASSERT_EQ(asx_ghost_determinism_check(), 1u);  /* length only */
+
+    /* Short runs stay exact */
+    asx_ghost_reset();
+    asx_ghost_determinism_record(1);
+    asx_ghost_determinism_record(2);
+    asx_ghost_determinism_seal();
+    asx_ghost_determinism_record(1);
+    asx_ghost_determinism_record(3);
+    ASSERT_TRUE(asx_ghost_determinism_locate(&first, &len));
+    ASSERT_EQ(first, 1u);
+    ASSERT_EQ(len, 1u);
+}
+
 /* ================================================================== */
 /* Borrow Ledger — Slot Reclamation                                    */
 /* ================================================================== */
@@ -363,6 +424,34 @@ TEST(borrow_release_untracked_is_noop) {
     ASSERT_EQ(asx_ghost_violation_count(), 0u);
 }
 
+TEST(borrow_table_full_then_release_keeps_others) {
+    uint64_t base = 0x0001000100010000ULL;
+    uint64_t extra = 0x0002000100010000ULL;
+    uint32_t i;
+
+    asx_ghost_reset();
+
+    /* Fill the ledger with sequential IDs (neighbouring hash runs) */
+    for (i = 0; i < ASX_GHOST_BORROW_TABLE_CAPACITY; i++) {
+        ASSERT_EQ(asx_ghost_borrow_shared(base + i), 1u);
+    }
+    ASSERT_EQ(asx_ghost_borrow_shared(extra), 0u);
+
+    /* Release every other entity; the rest stay reachable */
+    for (i = 0; i < ASX_GHOST_BORROW_TABLE_CAPACITY; i += 2u) {
+        asx_ghost_borrow_release(base + i);
+    }
+    for (i = 0; i < ASX_GHOST_BORROW_TABLE_CAPACITY; i++) {
+        ASSERT_EQ(asx_ghost_borrow_shared_count(base + i),
+                  (i % 2u) ? 1u : 0u);
+    }
+
+    /* Freed slots are reusable */
+    ASSERT_EQ(asx_ghost_borrow_shared(extra), 1u);
+    ASSERT_TRUE(asx_ghost_borrow_exclusive(base));
+    ASSERT_EQ(asx_ghost_violation_count(), 0u);
+}
+
 /* ================================================================== */
 /* main                                                                */
 /* ================================================================== */
@@ -405,10 +494,13 @@ int main(void) {
     RUN_TEST(determinism_seal_and_replay_drift);
     RUN_TEST(determinism_length_mismatch_detected);
     RUN_TEST(determinism_check_without_seal);
+    RUN_TEST(determinism_long_run_locates_drift_window);
+    RUN_TEST(determinism_long_prefix_run_diverges_where_it_ends);
 
     /* Slot reclamation */
     RUN_TEST(borrow_slot_reclaimed_after_release);
     RUN_TEST(borrow_release_untracked_is_noop);
+    RUN_TEST(borrow_table_full_then_release_keeps_others);
 
     TEST_REPORT();
     return test_failures;
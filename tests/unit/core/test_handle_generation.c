@@ -15,9 +15,9 @@
 /* ---- Handle packing helpers ---- */
 
 TEST(handle_pack_index_roundtrip) {
-    uint16_t gen = 42;
-    uint16_t slot = 7;
-    uint32_t packed = asx_handle_pack_index(gen, slot);
+    asx_generation gen = 42;
+    uint32_t slot = 7;
+    uint64_t packed = asx_handle_pack_index(gen, slot);
     uint64_t h = asx_handle_pack(ASX_TYPE_REGION, 0x0001, packed);
 
     ASSERT_EQ(asx_handle_slot(h), slot);
@@ -27,21 +27,51 @@ TEST(handle_pack_index_roundtrip) {
 }
 
 TEST(handle_pack_index_zero) {
-    uint32_t packed = asx_handle_pack_index(0, 0);
+    uint64_t packed = asx_handle_pack_index(0, 0);
     uint64_t h = asx_handle_pack(ASX_TYPE_TASK, 0x0001, packed);
-    ASSERT_EQ(asx_handle_slot(h), (uint16_t)0);
-    ASSERT_EQ(asx_handle_generation(h), (uint16_t)0);
+    ASSERT_EQ(asx_handle_slot(h), 0u);
+    ASSERT_EQ(asx_handle_generation(h), (asx_generation)0);
 }
 
 TEST(handle_pack_index_max) {
-    uint32_t packed = asx_handle_pack_index(0xFFFF, 0xFFFF);
-    uint64_t h = asx_handle_pack(ASX_TYPE_REGION, 0xFFFF, packed);
-    ASSERT_EQ(asx_handle_slot(h), (uint16_t)0xFFFF);
-    ASSERT_EQ(asx_handle_generation(h), (uint16_t)0xFFFF);
+    uint64_t packed = asx_handle_pack_index(
+        (asx_generation)ASX_HANDLE_FIELD_MASK, ASX_HANDLE_FIELD_MASK);
+    uint64_t h = asx_handle_pack(ASX_TYPE_REGION, 0x00FF, packed);
+    ASSERT_EQ(asx_handle_slot(h), ASX_HANDLE_FIELD_MASK);
+    ASSERT_EQ(asx_handle_generation(h), (asx_generation)ASX_HANDLE_FIELD_MASK);
+    ASSERT_EQ(asx_handle_type_tag(h), ASX_TYPE_REGION);
+    ASSERT_EQ(asx_handle_state_mask(h), (uint16_t)0x00FF);
 }
 
+TEST(handle_fields_do_not_spill) {
+    /* A slot past the field neither leaks into the generation nor
+     * survives; the generation wraps within its own bits */
+    uint64_t packed = asx_handle_pack_index(3, ASX_HANDLE_SLOT_LIMIT + 5u);
+    uint64_t h = asx_handle_pack(ASX_TYPE_TASK, 0, packed);
+
+    ASSERT_EQ(asx_handle_slot(h), 5u);
+    ASSERT_EQ(asx_handle_generation(h), (asx_generation)3);
+    ASSERT_EQ(asx_generation_next((asx_generation)ASX_HANDLE_FIELD_MASK),
+              (asx_generation)0);
+    ASSERT_EQ(asx_generation_next(7), (asx_generation)8);
+}
+
+#if ASX_HANDLE_WIDE
+TEST(handle_wide_layout_carries_24_bit_fields) {
+    uint64_t packed = asx_handle_pack_index(0xABCDEFu, 0x123456u);
+    uint64_t h = asx_handle_pack(ASX_TYPE_OBLIGATION,
+                                 (uint16_t)(1u << 5), packed);
+
+    ASSERT_EQ(h, UINT64_C(0x0320ABCDEF123456));
+    ASSERT_EQ(asx_handle_slot(h), 0x123456u);
+    ASSERT_EQ(asx_handle_generation(h), (asx_generation)0xABCDEFu);
+    ASSERT_TRUE(asx_handle_state_allowed(h, (uint16_t)(1u << 5)));
+    ASSERT_TRUE(ASX_ARENA_MAX_TASKS > 65536u);
+}
+#endif
+
 TEST(handle_generation_independent_of_type_tag) {
-    uint32_t packed = asx_handle_pack_index(5, 3);
+    uint64_t packed = asx_handle_pack_index(5, 3);
     uint64_t h1 = asx_handle_pack(ASX_TYPE_REGION, 0, packed);
     uint64_t h2 = asx_handle_pack(ASX_TYPE_TASK, 0, packed);
     /* Same generation and slot regardless of type */
@@ -100,6 +130,8 @@ TEST(region_stale_handle_different_generation) {
               asx_handle_slot(second_id));
 }
 
+#if !ASX_HANDLE_EPOCH
+/* With ASX_HANDLE_EPOCH, fresh slots start at the reset epoch instead */
 TEST(region_fresh_handle_generation_zero) {
     asx_region_id id;
     asx_runtime_reset();
@@ -126,6 +158,7 @@ TEST(region_reclaimed_handle_generation_increments) {
     ASSERT_EQ(asx_handle_generation(ids[1]), (uint16_t)1);
     ASSERT_EQ(asx_handle_generation(ids[2]), (uint16_t)2);
 }
+#endif
 
 /* ---- Task handle uses generation from spawn ---- */
 
@@ -135,6 +168,7 @@ static asx_status noop_poll(void *ud, asx_task_id self)
     return ASX_OK;
 }
 
+#if !ASX_HANDLE_EPOCH
 TEST(task_handle_has_generation_zero) {
     asx_region_id rid;
     asx_task_id tid;
@@ -144,6 +178,60 @@ TEST(task_handle_has_generation_zero) {
     ASSERT_EQ(asx_task_spawn(rid, noop_poll, NULL, &tid), ASX_OK);
     ASSERT_EQ(asx_handle_generation(tid), (uint16_t)0);
 }
+#endif
+
+/* Reset reinitialises the slots that were used; until a slot is
+ * handed out again its old handles find nothing */
+TEST(reset_clears_used_slots) {
+    asx_region_id rid;
+    asx_task_id tid[3];
+    asx_task_state tstate;
+    asx_region_state rstate;
+    int i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, noop_poll, NULL, &tid[i]), ASX_OK);
+    }
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_get_state(rid, &rstate), ASX_E_NOT_FOUND);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_task_get_state(tid[i], &tstate), ASX_E_NOT_FOUND);
+    }
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), (uint32_t)0);
+}
+
+#if ASX_HANDLE_EPOCH
+TEST(reset_epoch_keeps_old_handles_stale) {
+    asx_region_id old_rid, rid;
+    asx_task_id old_tid, tid;
+    asx_region_state rstate;
+    asx_task_state tstate;
+    asx_budget budget;
+    int i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&old_rid), ASX_OK);
+    /* Push the slot's generation past the epoch before resetting */
+    for (i = 0; i < 3; i++) {
+        budget = asx_budget_infinite();
+        ASSERT_EQ(asx_region_drain(old_rid, &budget), ASX_OK);
+        ASSERT_EQ(asx_region_open(&old_rid), ASX_OK);
+    }
+    ASSERT_EQ(asx_task_spawn(old_rid, noop_poll, NULL, &old_tid), ASX_OK);
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, noop_poll, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_handle_slot(rid), asx_handle_slot(old_rid));
+    ASSERT_EQ(asx_handle_slot(tid), asx_handle_slot(old_tid));
+    ASSERT_EQ(asx_region_get_state(old_rid, &rstate), ASX_E_STALE_HANDLE);
+    ASSERT_EQ(asx_task_get_state(old_tid, &tstate), ASX_E_STALE_HANDLE);
+    ASSERT_EQ(asx_region_get_state(rid, &rstate), ASX_OK);
+}
+#endif
 
 TEST(task_lookup_validates_generation) {
     asx_region_id rid;
@@ -173,12 +261,22 @@ int main(void) {
     RUN_TEST(handle_pack_index_roundtrip);
     RUN_TEST(handle_pack_index_zero);
     RUN_TEST(handle_pack_index_max);
+    RUN_TEST(handle_fields_do_not_spill);
+#if ASX_HANDLE_WIDE
+    RUN_TEST(handle_wide_layout_carries_24_bit_fields);
+#endif
     RUN_TEST(handle_generation_independent_of_type_tag);
     RUN_TEST(region_stale_handle_after_reclaim);
     RUN_TEST(region_stale_handle_different_generation);
+#if !ASX_HANDLE_EPOCH
     RUN_TEST(region_fresh_handle_generation_zero);
     RUN_TEST(region_reclaimed_handle_generation_increments);
     RUN_TEST(task_handle_has_generation_zero);
+#endif
+    RUN_TEST(reset_clears_used_slots);
+#if ASX_HANDLE_EPOCH
+    RUN_TEST(reset_epoch_keeps_old_handles_stale);
+#endif
     RUN_TEST(task_lookup_validates_generation);
     TEST_REPORT();
     return test_failures;
@@ -2,11 +2,16 @@
  * test_hooks.c — unit tests for runtime hook contract
  *
  * Tests: initialization, validation (deterministic/live), allocator seal,
- * hook dispatch, and forbidden entropy in deterministic mode.
+ * hook dispatch, and forbidden entropy in deterministic mode. On POSIX
+ * also the platform reactor and the readiness sources built on it.
  *
  * SPDX-License-Identifier: MIT
  */
 
+#ifdef ASX_PROFILE_POSIX
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "../../test_harness.h"
 #include <asx/asx_config.h>
 #include <stdlib.h>
@@ -240,6 +245,430 @@ TEST(hooks_entropy_forbidden_without_prng) {
     ASSERT_EQ(asx_runtime_random_u64(&val), ASX_E_INVALID_STATE);
 }
 
+TEST(prng_matches_reference_and_jumps) {
+    asx_prng rng, w0, w1;
+    asx_runtime_hooks hooks;
+    uint64_t val = 0;
+
+    /* Reference xoshiro256** outputs from state {1, 2, 3, 4} */
+    rng.s[0] = 1; rng.s[1] = 2; rng.s[2] = 3; rng.s[3] = 4;
+    ASSERT_EQ(asx_prng_next(&rng), (uint64_t)0x2D00u);
+    ASSERT_EQ(asx_prng_next(&rng), (uint64_t)0);
+    ASSERT_EQ(asx_prng_next(&rng), (uint64_t)0x5A007080u);
+
+    rng.s[0] = 1; rng.s[1] = 2; rng.s[2] = 3; rng.s[3] = 4;
+    asx_prng_jump(&rng);
+    ASSERT_EQ(asx_prng_next(&rng), (uint64_t)0xBBD2F312298443D8ULL);
+
+    asx_prng_seed(&rng, 42);
+    ASSERT_EQ(rng.s[0], (uint64_t)0xBDD732262FEB6E95ULL);
+    ASSERT_EQ(asx_prng_next(&rng), (uint64_t)0x15780B2E0C2EC716ULL);
+
+    /* Stream 0 is the root; stream 1 is the root jumped once */
+    asx_prng_seed(&rng, 7);
+    asx_prng_stream(&rng, 0, &w0);
+    asx_prng_stream(&rng, 1, &w1);
+    ASSERT_EQ(asx_prng_next(&w0), asx_prng_next(&rng));
+    asx_prng_seed(&rng, 7);
+    asx_prng_jump(&rng);
+    ASSERT_EQ(asx_prng_next(&w1), asx_prng_next(&rng));
+
+    /* Installed as the entropy hook it is a seeded stream */
+    asx_prng_seed(&rng, 42);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.deterministic_seeded_prng = 0;
+    ASSERT_EQ(asx_prng_install(&rng, &hooks), ASX_OK);
+    ASSERT_EQ(hooks.deterministic_seeded_prng, 1);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_random_u64(&val), ASX_OK);
+    ASSERT_EQ(val, (uint64_t)0x15780B2E0C2EC716ULL);
+    ASSERT_EQ(asx_prng_install(NULL, &hooks), ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+}
+
+#if defined(ASX_PROFILE_POSIX) || defined(ASX_PROFILE_WIN32)
+
+/* ------------------------------------------------------------------ */
+/* Platform adapter clock and entropy                                 */
+/* ------------------------------------------------------------------ */
+
+TEST(platform_default_clock_is_monotonic) {
+    asx_runtime_hooks hooks;
+    asx_time a, b;
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_TRUE(hooks.clock.now_ns_fn == asx_platform_monotonic_now_ns);
+    a = asx_platform_monotonic_now_ns(NULL);
+    b = asx_platform_monotonic_now_ns(NULL);
+    ASSERT_TRUE(a > 0);
+    ASSERT_TRUE(b >= a);
+}
+
+TEST(platform_entropy_fills_buffers) {
+    uint8_t buf[300];
+    uint64_t a, b;
+    size_t i, nonzero = 0;
+
+    memset(buf, 0, sizeof(buf));
+    ASSERT_EQ(asx_platform_entropy_fill(buf, sizeof(buf)), ASX_OK);
+    for (i = 0; i < sizeof(buf); i++) nonzero += buf[i] != 0;
+    ASSERT_TRUE(nonzero > sizeof(buf) / 2u);
+    ASSERT_EQ(asx_platform_entropy_fill(NULL, 1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_platform_entropy_fill(NULL, 0), ASX_OK);
+
+    a = asx_platform_random_u64(NULL);
+    b = asx_platform_random_u64(NULL);
+    ASSERT_NE(a, b);
+}
+
+#endif
+
+#ifdef ASX_PROFILE_POSIX
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ------------------------------------------------------------------ */
+/* POSIX readiness reactor                                            */
+/* ------------------------------------------------------------------ */
+
+TEST(posix_reactor_reports_pipe_readiness) {
+    static asx_platform_reactor r;
+    asx_runtime_hooks hooks;
+    uint32_t ready = 99;
+    int fds[2];
+    char byte = 'x';
+
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(asx_platform_reactor_open(&r), ASX_OK);
+    ASSERT_EQ(asx_platform_reactor_add(&r, fds[0], ASX_PLATFORM_IO_READ, 0xABCDu),
+              ASX_OK);
+
+    /* Nothing written yet: a zero timeout reports nothing */
+    ASSERT_EQ(asx_platform_reactor_wait(&r, 0, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+
+    ASSERT_EQ(write(fds[1], &byte, 1), 1);
+    ASSERT_EQ(asx_platform_reactor_wait(&r, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(r.ready_count, 1u);
+    ASSERT_EQ(r.ready[0].token, (uint64_t)0xABCDu);
+    ASSERT_TRUE((r.ready[0].events & ASX_PLATFORM_IO_READ) != 0);
+
+    /* The write end is writable once registered; the token follows modify */
+    ASSERT_EQ(asx_platform_reactor_add(&r, fds[1], ASX_PLATFORM_IO_WRITE, 7u),
+              ASX_OK);
+    ASSERT_EQ(asx_platform_reactor_modify(&r, fds[0], 0, 0xABCDu), ASX_OK);
+    ASSERT_EQ(asx_platform_reactor_wait(&r, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(r.ready[0].token, (uint64_t)7u);
+    ASSERT_TRUE((r.ready[0].events & ASX_PLATFORM_IO_WRITE) != 0);
+
+    ASSERT_EQ(asx_platform_reactor_remove(&r, fds[1]), ASX_OK);
+    ASSERT_EQ(asx_platform_reactor_wait(&r, 0, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+#ifdef __linux__
+    ASSERT_EQ(asx_platform_reactor_add(&r, fds[0], ASX_PLATFORM_IO_READ, 1u),
+              ASX_E_ALREADY_EXISTS);
+    ASSERT_EQ(asx_platform_reactor_remove(&r, fds[1]), ASX_E_NOT_FOUND);
+#endif
+    ASSERT_EQ(asx_platform_reactor_add(&r, -1, ASX_PLATFORM_IO_READ, 1u),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* Installed as the live reactor hook */
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_reactor_install(&r, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.reactor.ctx == &r);
+    ASSERT_TRUE(hooks.reactor.wait_fn == asx_platform_reactor_wait);
+    ASSERT_EQ(asx_runtime_hooks_validate(&hooks, 0), ASX_OK);
+
+    asx_platform_reactor_close(&r);
+    ASSERT_EQ(r.fd, -1);
+    ASSERT_EQ(asx_platform_reactor_wait(&r, 0, &ready), ASX_E_INVALID_ARGUMENT);
+    (void)close(fds[0]);
+    (void)close(fds[1]);
+}
+
+static asx_status io_pending_poll(void *user_data, asx_task_id self) {
+    (void)user_data;
+    (void)self;
+    return ASX_E_PENDING;
+}
+
+static int io_parked(asx_task_id tid) {
+    int parked = -1;
+    if (asx_task_is_parked(tid, &parked) != ASX_OK) return -1;
+    return parked;
+}
+
+TEST(posix_io_source_wakes_armed_task) {
+    static asx_platform_reactor r;
+    asx_platform_io_source src;
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id reader;
+    asx_task_id writer;
+    asx_task_id other;
+    uint32_t ready = 99;
+    int sv[2];
+    char byte = 'x';
+
+    asx_runtime_reset();
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+    ASSERT_EQ(asx_platform_reactor_open(&r), ASX_OK);
+    ASSERT_EQ(asx_platform_io_register(&r, &src, sv[0]), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, io_pending_poll, NULL, &reader), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, io_pending_poll, NULL, &writer), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, io_pending_poll, NULL, &other), ASX_OK);
+    ASSERT_EQ(asx_platform_io_arm(&src, reader, ASX_PLATFORM_IO_READ |
+                                  ASX_PLATFORM_IO_WRITE), ASX_E_INVALID_ARGUMENT);
+
+    /* Nothing to read: the reader stays parked */
+    ASSERT_EQ(asx_platform_io_arm(&src, reader, ASX_PLATFORM_IO_READ), ASX_OK);
+    ASSERT_EQ(asx_platform_io_wait(&r, 0, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+    ASSERT_EQ(io_parked(reader), 1);
+    ASSERT_EQ(asx_platform_io_arm(&src, other, ASX_PLATFORM_IO_READ),
+              ASX_E_INVALID_STATE);
+
+    /* The write edge wakes only the writer; read stays armed */
+    ASSERT_EQ(asx_platform_io_arm(&src, writer, ASX_PLATFORM_IO_WRITE), ASX_OK);
+    ASSERT_EQ(asx_platform_io_wait(&r, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_TRUE((src.events & ASX_PLATFORM_IO_WRITE) != 0);
+    ASSERT_EQ(io_parked(writer), 0);
+    ASSERT_EQ(io_parked(reader), 1);
+
+    ASSERT_EQ(write(sv[1], &byte, 1), 1);
+    ASSERT_EQ(asx_platform_io_wait(&r, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(io_parked(reader), 0);
+
+    /* One-shot: unread data reports nothing until re-armed */
+    ASSERT_EQ(asx_platform_io_wait(&r, 0, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+    ASSERT_EQ(asx_platform_io_arm(&src, reader, ASX_PLATFORM_IO_READ), ASX_OK);
+    ASSERT_EQ(asx_platform_io_wait(&r, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(io_parked(reader), 0);
+
+    /* Deregistering wakes an armed task */
+    ASSERT_EQ(read(sv[0], &byte, 1), 1);
+    ASSERT_EQ(asx_platform_io_arm(&src, other, ASX_PLATFORM_IO_READ), ASX_OK);
+    ASSERT_EQ(io_parked(other), 1);
+    ASSERT_EQ(asx_platform_io_deregister(&src), ASX_OK);
+    ASSERT_EQ(io_parked(other), 0);
+    ASSERT_EQ(asx_platform_io_arm(&src, other, ASX_PLATFORM_IO_READ),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_io_install(&r, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.reactor.wait_fn == asx_platform_io_wait);
+    asx_platform_reactor_close(&r);
+    (void)close(sv[0]);
+    (void)close(sv[1]);
+    asx_runtime_reset();
+}
+
+TEST(posix_fast_clock_tracks_monotonic) {
+    asx_platform_fast_clock clock;
+    asx_runtime_hooks hooks;
+    struct timespec nap = {0, 5000000L};
+    asx_time m0, f0, f1, m1;
+    asx_status st;
+
+    ASSERT_EQ(asx_platform_fast_clock_calibrate(NULL, 0), ASX_E_INVALID_ARGUMENT);
+    st = asx_platform_fast_clock_calibrate(&clock, 2000);
+    if (st == ASX_E_HOOK_MISSING) return; /* no invariant counter here */
+    ASSERT_EQ(st, ASX_OK);
+
+    m0 = asx_platform_monotonic_now_ns(NULL);
+    f0 = asx_platform_fast_now_ns(&clock);
+    (void)nanosleep(&nap, NULL);
+    f1 = asx_platform_fast_now_ns(&clock);
+    m1 = asx_platform_monotonic_now_ns(NULL);
+    ASSERT_TRUE(f1 > f0);
+    /* Within 1 ms of the reference over a few milliseconds */
+    ASSERT_TRUE(f0 + 1000000u > m0 && f0 < m0 + 1000000u);
+    ASSERT_TRUE(f1 + 1000000u > m1 && f1 < m1 + 1000000u);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_fast_clock_install(&clock, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.clock.now_ns_fn == asx_platform_fast_now_ns);
+    ASSERT_TRUE(hooks.clock.ctx == &clock);
+}
+
+TEST(posix_huge_arena_backs_region_chunks) {
+    static asx_platform_huge_arena arena;
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    void *small = NULL;
+    size_t used;
+    uint32_t i;
+
+    ASSERT_EQ(asx_platform_huge_arena_open(NULL, 1, 0, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_platform_huge_arena_open(&arena, 1, 0, NULL), ASX_OK);
+    ASSERT_EQ(arena.size, ASX_PLATFORM_HUGE_PAGE_BYTES);
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_huge_arena_install(&arena, &hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+
+    /* Small requests bypass the mapping */
+    ASSERT_EQ(asx_runtime_alloc(128, &small), ASX_OK);
+    ASSERT_EQ(arena.used, (size_t)0);
+    ASSERT_EQ(asx_runtime_free(small), ASX_OK);
+
+    /* The first region past the static chunk grows into the mapping */
+    for (i = 0; i <= ASX_MAX_REGIONS; i++) {
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    }
+    ASSERT_TRUE(arena.used > 0);
+    used = arena.used;
+
+    /* A released chunk is reused on the next growth */
+    asx_runtime_reset();
+    ASSERT_TRUE(arena.free_slices != NULL);
+    for (i = 0; i <= ASX_MAX_REGIONS; i++) {
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    }
+    ASSERT_EQ(arena.used, used);
+
+    /* Sealing still stops growth */
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    for (i = ASX_MAX_REGIONS + 1u; i < 2u * ASX_MAX_REGIONS; i++) {
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    }
+    ASSERT_EQ(asx_region_open(&rid), ASX_E_RESOURCE_EXHAUSTED);
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    asx_platform_huge_arena_close(&arena);
+}
+
+TEST(posix_huge_arena_binds_node) {
+    static asx_platform_huge_arena arena;
+    asx_status st;
+
+    ASSERT_EQ(asx_platform_huge_arena_bind_node(NULL, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_platform_huge_arena_bind_node(&arena, 0), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_platform_huge_arena_open(&arena, 1, 1, NULL), ASX_OK);
+    ASSERT_EQ(asx_platform_huge_arena_bind_node(&arena, ASX_PLATFORM_NUMA_MAX_NODES),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* Node 0 exists wherever NUMA policy is supported at all */
+    st = asx_platform_huge_arena_bind_node(&arena, 0);
+    ASSERT_TRUE(st == ASX_OK || st == ASX_E_HOOK_MISSING);
+    asx_platform_huge_arena_close(&arena);
+}
+#endif
+
+#ifdef ASX_PROFILE_FREESTANDING
+TEST(freestanding_pool_allocates_fixed_blocks) {
+    static uint64_t region[33];
+    asx_platform_pool pool;
+    asx_runtime_hooks hooks;
+    void *blocks[8];
+    void *p;
+    uint32_t i;
+
+    /* Misaligned start: the pool aligns inside the region */
+    ASSERT_EQ(asx_platform_pool_init(&pool, (uint8_t *)region + 1,
+                                     sizeof(region) - 1u, 30), ASX_OK);
+    ASSERT_EQ(pool.block_size, (size_t)32);
+    ASSERT_EQ(pool.block_count, 8u);
+
+    for (i = 0; i < 8u; i++) {
+        blocks[i] = asx_platform_pool_alloc(&pool, 32);
+        ASSERT_TRUE(blocks[i] != NULL);
+        ASSERT_EQ((uintptr_t)blocks[i] % sizeof(uint64_t), (uintptr_t)0);
+    }
+    ASSERT_EQ(pool.free_count, 0u);
+    ASSERT_TRUE(asx_platform_pool_alloc(&pool, 1) == NULL);
+
+    /* Freed blocks are reused LIFO; foreign pointers are ignored */
+    asx_platform_pool_free(&pool, blocks[3]);
+    asx_platform_pool_free(&pool, (uint8_t *)blocks[4] + 4);
+    asx_platform_pool_free(&pool, &pool);
+    ASSERT_EQ(pool.free_count, 1u);
+    ASSERT_TRUE(asx_platform_pool_alloc(&pool, 8) == blocks[3]);
+
+    /* realloc works only in place */
+    ASSERT_TRUE(asx_platform_pool_realloc(&pool, blocks[0], 32) == blocks[0]);
+    ASSERT_TRUE(asx_platform_pool_realloc(&pool, blocks[0], 33) == NULL);
+    ASSERT_TRUE(asx_platform_pool_realloc(&pool, blocks[0], 0) == NULL);
+    ASSERT_EQ(pool.free_count, 1u);
+    ASSERT_TRUE(asx_platform_pool_alloc(&pool, 64) == NULL);
+
+    ASSERT_EQ(asx_platform_pool_init(&pool, region, 16, 32),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_platform_pool_init(&pool, region, sizeof(region), 64), ASX_OK);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_pool_install(&pool, &hooks), ASX_OK);
+    hooks.clock.now_ns_fn = test_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc(48, &p), ASX_OK);
+    ASSERT_EQ(pool.free_count, pool.block_count - 1u);
+    ASSERT_EQ(asx_runtime_free(p), ASX_OK);
+    ASSERT_EQ(pool.free_count, pool.block_count);
+    ASSERT_EQ(asx_runtime_alloc(65, &p), ASX_E_RESOURCE_EXHAUSTED);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.clock.now_ns_fn = test_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+}
+
+static uint64_t g_fake_ticks;
+
+static uint64_t read_fake_ticks(void *ctx)
+{
+    (void)ctx;
+    return g_fake_ticks;
+}
+
+TEST(freestanding_tick_clock_extends_wraps) {
+    asx_platform_tick_clock clock;
+    asx_runtime_hooks hooks;
+
+    /* 16-bit counter at 32768 Hz wraps every two seconds */
+    g_fake_ticks = 0xFFF0u;
+    ASSERT_EQ(asx_platform_tick_clock_init(&clock, read_fake_ticks, NULL,
+                                           32768u, 16), ASX_OK);
+    ASSERT_EQ(asx_platform_tick_now_ns(&clock), (asx_time)1999511718u);
+    g_fake_ticks = 0x10010u;  /* bits above the counter are masked off */
+    ASSERT_EQ(asx_platform_tick_now_ns(&clock), (asx_time)2000488281u);
+    g_fake_ticks = 0x8000u;
+    ASSERT_EQ(asx_platform_tick_now_ns(&clock), (asx_time)3000000000u);
+
+    /* 64-bit counter at 1 GHz does not overflow the conversion */
+    g_fake_ticks = UINT64_MAX - 1u;
+    ASSERT_EQ(asx_platform_tick_clock_init(&clock, read_fake_ticks, NULL,
+                                           1000000000u, 64), ASX_OK);
+    ASSERT_EQ(asx_platform_tick_now_ns(&clock), (asx_time)(UINT64_MAX - 1u));
+
+    ASSERT_EQ(asx_platform_tick_clock_init(&clock, read_fake_ticks, NULL,
+                                           1000u, 65), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_platform_tick_clock_init(&clock, read_fake_ticks, NULL,
+                                           0u, 32), ASX_E_INVALID_ARGUMENT);
+
+    g_fake_ticks = 5000u;
+    ASSERT_EQ(asx_platform_tick_clock_init(&clock, read_fake_ticks, NULL,
+                                           1000u, 32), ASX_OK);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_tick_clock_install(&clock, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.clock.now_ns_fn == asx_platform_tick_now_ns);
+    ASSERT_EQ(hooks.clock.now_ns_fn(hooks.clock.ctx), (asx_time)5000000000u);
+}
+#endif
+
 int main(void) {
     fprintf(stderr, "=== test_hooks ===\n");
     RUN_TEST(hooks_init_defaults);
@@ -255,6 +684,22 @@ int main(void) {
     RUN_TEST(hooks_log_dispatch);
     RUN_TEST(hooks_config_init);
     RUN_TEST(hooks_entropy_forbidden_without_prng);
+    RUN_TEST(prng_matches_reference_and_jumps);
+#if defined(ASX_PROFILE_POSIX) || defined(ASX_PROFILE_WIN32)
+    RUN_TEST(platform_default_clock_is_monotonic);
+    RUN_TEST(platform_entropy_fills_buffers);
+#endif
+#ifdef ASX_PROFILE_POSIX
+    RUN_TEST(posix_reactor_reports_pipe_readiness);
+    RUN_TEST(posix_io_source_wakes_armed_task);
+    RUN_TEST(posix_fast_clock_tracks_monotonic);
+    RUN_TEST(posix_huge_arena_backs_region_chunks);
+    RUN_TEST(posix_huge_arena_binds_node);
+#endif
+#ifdef ASX_PROFILE_FREESTANDING
+    RUN_TEST(freestanding_pool_allocates_fixed_blocks);
+    RUN_TEST(freestanding_tick_clock_extends_wraps);
+#endif
     TEST_REPORT();
     return test_failures;
 }
@@ -22,10 +22,16 @@ TEST(handle_pack_unpack_roundtrip) {
 }
 
 TEST(handle_pack_max_values) {
-    uint64_t h = asx_handle_pack((uint16_t)0xFFFF, (uint16_t)0xFFFF, (uint32_t)0xFFFFFFFF);
-    ASSERT_EQ(asx_handle_type_tag(h), (uint16_t)0xFFFF);
-    ASSERT_EQ(asx_handle_state_mask(h), (uint16_t)0xFFFF);
-    ASSERT_EQ(asx_handle_index(h), (uint32_t)0xFFFFFFFF);
+#if ASX_HANDLE_WIDE
+    uint16_t field_max = 0x00FF;
+#else
+    uint16_t field_max = 0xFFFF;
+#endif
+    uint64_t h = asx_handle_pack(field_max, field_max, ASX_HANDLE_INDEX_MASK);
+    ASSERT_EQ(h, UINT64_MAX);
+    ASSERT_EQ(asx_handle_type_tag(h), field_max);
+    ASSERT_EQ(asx_handle_state_mask(h), field_max);
+    ASSERT_EQ(asx_handle_index(h), ASX_HANDLE_INDEX_MASK);
 }
 
 TEST(handle_pack_zero) {
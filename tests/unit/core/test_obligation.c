@@ -7,6 +7,7 @@
 #include "test_harness.h"
 #include <asx/asx.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
 
 /* ---- Reserve / commit / abort ---- */
 
@@ -166,6 +167,158 @@ TEST(obligation_multiple_in_region) {
     ASSERT_EQ(state, ASX_OBLIGATION_ABORTED);
 }
 
+/* ---- Batched commit and region-wide abort ---- */
+
+#if !ASX_HANDLE_EPOCH
+/* Compares traces across a reset; epoch handles differ per reset */
+TEST(obligation_commit_many_matches_single_commits) {
+    asx_region_id rid;
+    asx_obligation_id ids[6];
+    asx_obligation_state state;
+    uint64_t single_digest;
+    uint32_t single_count;
+    uint32_t i;
+    int pass;
+
+    /* Same trace either way */
+    for (pass = 0; pass < 2; pass++) {
+        asx_runtime_reset();
+        asx_trace_reset();
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+        for (i = 0; i < 6; i++) {
+            ASSERT_EQ(asx_obligation_reserve(rid, &ids[i]), ASX_OK);
+        }
+        if (pass == 0) {
+            for (i = 0; i < 6; i++) {
+                ASSERT_EQ(asx_obligation_commit(ids[i]), ASX_OK);
+            }
+            single_digest = asx_trace_digest();
+            single_count = asx_trace_event_count();
+        } else {
+            ASSERT_EQ(asx_obligation_commit_many(ids, 6), ASX_OK);
+            ASSERT_EQ(asx_trace_digest(), single_digest);
+            ASSERT_EQ(asx_trace_event_count(), single_count);
+        }
+        for (i = 0; i < 6; i++) {
+            ASSERT_EQ(asx_obligation_get_state(ids[i], &state), ASX_OK);
+            ASSERT_EQ(state, ASX_OBLIGATION_COMMITTED);
+        }
+    }
+    ASSERT_EQ(asx_obligation_commit_many(NULL, 0), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit_many(NULL, 1), ASX_E_INVALID_ARGUMENT);
+}
+#endif
+
+TEST(obligation_commit_many_is_all_or_nothing) {
+    asx_region_id rid;
+    asx_obligation_id ids[4];
+    asx_obligation_id dup[3];
+    asx_obligation_state state;
+    asx_budget budget;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_obligation_reserve(rid, &ids[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_obligation_commit(ids[3]), ASX_OK);
+
+    /* An already committed entry rejects the whole batch */
+    ASSERT_EQ(asx_obligation_commit_many(ids, 4), ASX_E_INVALID_TRANSITION);
+    /* As does a duplicate */
+    dup[0] = ids[0];
+    dup[1] = ids[1];
+    dup[2] = ids[0];
+    ASSERT_EQ(asx_obligation_commit_many(dup, 3), ASX_E_INVALID_TRANSITION);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_obligation_get_state(ids[i], &state), ASX_OK);
+        ASSERT_EQ(state, ASX_OBLIGATION_RESERVED);
+    }
+
+    ASSERT_EQ(asx_obligation_commit_many(ids, 3), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+}
+
+TEST(region_abort_obligations_resolves_only_that_region) {
+    asx_region_id ra, rb;
+    asx_obligation_id oa[5];
+    asx_obligation_id ob;
+    asx_obligation_state state;
+    asx_budget budget;
+    uint32_t aborted = 99;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    for (i = 0; i < 5; i++) {
+        ASSERT_EQ(asx_obligation_reserve(ra, &oa[i]), ASX_OK);
+        if (i == 2) ASSERT_EQ(asx_obligation_reserve(rb, &ob), ASX_OK);
+    }
+    /* Resolved ones, head and middle, have left the list */
+    ASSERT_EQ(asx_obligation_commit(oa[0]), ASX_OK);
+    ASSERT_EQ(asx_obligation_abort(oa[3]), ASX_OK);
+
+    ASSERT_EQ(asx_region_abort_obligations(ra, &aborted), ASX_OK);
+    ASSERT_EQ(aborted, (uint32_t)3);
+    ASSERT_EQ(asx_obligation_get_state(oa[0], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_COMMITTED);
+    for (i = 1; i < 5; i++) {
+        ASSERT_EQ(asx_obligation_get_state(oa[i], &state), ASX_OK);
+        ASSERT_EQ(state, ASX_OBLIGATION_ABORTED);
+    }
+    ASSERT_EQ(asx_obligation_get_state(ob, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_RESERVED);
+
+    /* A freed slot is reused on another region's list */
+    ASSERT_EQ(asx_obligation_reserve(rb, &oa[0]), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(ra, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_drain(rb, &budget), ASX_E_OBLIGATIONS_UNRESOLVED);
+
+    /* A closing region can still be unblocked */
+    ASSERT_EQ(asx_region_abort_obligations(rb, NULL), ASX_OK);
+    ASSERT_EQ(asx_obligation_get_state(ob, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(asx_region_abort_obligations(rb, &aborted), ASX_OK);
+    ASSERT_EQ(aborted, (uint32_t)0);
+    ASSERT_EQ(asx_region_drain(rb, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_abort_obligations(ASX_INVALID_ID, NULL), ASX_E_NOT_FOUND);
+}
+
+/* ---- Per-region quiescence accounting ---- */
+
+TEST(obligation_drain_counts_reserved_per_region) {
+    asx_region_id ra, rb;
+    asx_obligation_id oa, ob;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+
+    /* A slot resolved in one region and reused by another moves the
+     * reserved count with it */
+    ASSERT_EQ(asx_obligation_reserve(ra, &oa), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(oa), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rb, &ob), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(ra, &oa), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(ra, &budget), ASX_E_OBLIGATIONS_UNRESOLVED);
+    ASSERT_EQ(asx_obligation_abort(oa), ASX_OK);
+    ASSERT_EQ(asx_region_drain(ra, &budget), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(ra), ASX_OK);
+
+    ASSERT_EQ(asx_region_drain(rb, &budget), ASX_E_OBLIGATIONS_UNRESOLVED);
+    ASSERT_EQ(asx_obligation_commit(ob), ASX_OK);
+    ASSERT_EQ(asx_region_drain(rb, &budget), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(rb), ASX_OK);
+}
+
 int main(void) {
     fprintf(stderr, "=== test_obligation ===\n");
     RUN_TEST(obligation_reserve_and_get_state);
@@ -180,6 +333,12 @@ int main(void) {
     RUN_TEST(obligation_reserve_rejected_after_close);
     RUN_TEST(obligation_handle_type_tag);
     RUN_TEST(obligation_multiple_in_region);
+#if !ASX_HANDLE_EPOCH
+    RUN_TEST(obligation_commit_many_matches_single_commits);
+#endif
+    RUN_TEST(obligation_commit_many_is_all_or_nothing);
+    RUN_TEST(region_abort_obligations_resolves_only_that_region);
+    RUN_TEST(obligation_drain_counts_reserved_per_region);
     TEST_REPORT();
     return test_failures;
 }
@@ -2,8 +2,10 @@
  * test_resource.c — exhaustion boundary tests for resource contract engine
  *
  * Tests resource capacity queries, admission gates, arena exhaustion
- * for all resource kinds, per-region queries, and failure-atomic
- * rollback on multi-step operations.
+ * for all resource kinds, per-region capture limits and reserves,
+ * per-region queries, failure-atomic rollback on multi-step
+ * operations, region admission policies, claim tokens and per-region
+ * quotas, watermark edges, and allocation accounting.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -12,6 +14,7 @@
 #include <asx/asx.h>
 #include <asx/core/resource.h>
 #include <asx/runtime/runtime.h>
+#include <stdlib.h>
 
 /* Trivial poll function for spawning tasks */
 static asx_status noop_poll(void *user_data, asx_task_id self)
@@ -21,6 +24,51 @@ static asx_status noop_poll(void *user_data, asx_task_id self)
     return ASX_OK;
 }
 
+/* Never completes */
+static asx_status pending_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data;
+    (void)self;
+    return ASX_E_PENDING;
+}
+
+/* Allocator that counts live blocks */
+static int g_live_blocks;
+
+static void *counting_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    g_live_blocks++;
+    return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    if (ptr != NULL) g_live_blocks--;
+    free(ptr);
+}
+
+static void install_counting_allocator(void)
+{
+    asx_runtime_hooks hooks;
+
+    asx_runtime_hooks_init(&hooks);
+    hooks.allocator.malloc_fn = counting_malloc;
+    hooks.allocator.realloc_fn = NULL;
+    hooks.allocator.free_fn = counting_free;
+    asx_runtime_set_hooks(&hooks);
+    g_live_blocks = 0;
+}
+
+static void restore_default_hooks(void)
+{
+    asx_runtime_hooks hooks;
+
+    asx_runtime_hooks_init(&hooks);
+    asx_runtime_set_hooks(&hooks);
+}
+
 /* ---- Resource query accuracy ---- */
 
 TEST(resource_capacity_region) {
@@ -233,11 +281,14 @@ TEST(resource_cleanup_stack_exhaustion) {
     asx_cleanup_handle h;
     uint32_t i, remaining;
     asx_cleanup_stack stack;
+    asx_runtime_hooks hooks;
     asx_runtime_reset();
 
     ASSERT_EQ(asx_region_open(&rid), ASX_OK);
 
-    /* Fill cleanup stack directly */
+    /* Fill cleanup stack directly; chunks come from the allocator hook */
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
     asx_cleanup_init(&stack);
     for (i = 0; i < ASX_CLEANUP_STACK_CAPACITY; i++) {
         ASSERT_EQ(asx_cleanup_push(&stack, dummy_cleanup, NULL, &h), ASX_OK);
@@ -250,6 +301,7 @@ TEST(resource_cleanup_stack_exhaustion) {
     /* Query remaining via region API */
     ASSERT_EQ(asx_resource_region_cleanup_remaining(rid, &remaining), ASX_OK);
     ASSERT_EQ(remaining, (uint32_t)ASX_CLEANUP_STACK_CAPACITY);
+    asx_cleanup_release(&stack);
 }
 
 /* ---- Capture arena exhaustion ---- */
@@ -319,6 +371,83 @@ TEST(resource_capture_rollback_on_task_exhaustion) {
     ASSERT_EQ(capture_after, capture_before);
 }
 
+/* ---- Per-region capture sizing ---- */
+
+TEST(resource_capture_limit_per_region) {
+    asx_region_options opts;
+    asx_region_id small, big;
+    asx_task_id tid;
+    void *state;
+    uint32_t remaining;
+    int blocks;
+
+    install_counting_allocator();
+    asx_runtime_reset();
+
+    asx_region_options_init(&opts);
+    ASSERT_EQ(opts.capture_limit, (uint32_t)ASX_REGION_CAPTURE_ARENA_BYTES);
+    opts.capture_limit = 512u;
+    ASSERT_EQ(asx_region_open_with(&opts, &small), ASX_OK);
+    ASSERT_EQ(asx_resource_region_capture_remaining(small, &remaining), ASX_OK);
+    ASSERT_EQ(remaining, 512u);
+    ASSERT_EQ(asx_task_spawn_captured(small, noop_poll, 513u, NULL, &tid, &state),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_task_spawn_captured(small, noop_poll, 500u, NULL, &tid, &state),
+              ASX_OK);
+    ASSERT_EQ(asx_resource_region_capture_remaining(small, &remaining), ASX_OK);
+    ASSERT_EQ(remaining, 8u);
+
+    /* Unbounded: past the inline bytes each spawn chains a block */
+    blocks = g_live_blocks;
+    opts.capture_limit = ASX_REGION_CAPTURE_UNBOUNDED;
+    ASSERT_EQ(asx_region_open_with(&opts, &big), ASX_OK);
+    ASSERT_EQ(asx_task_spawn_captured(big, noop_poll,
+              ASX_REGION_CAPTURE_INLINE_BYTES + 1u, NULL, &tid, &state), ASX_OK);
+    ASSERT_EQ(g_live_blocks, blocks + 1);
+    ((uint8_t *)state)[ASX_REGION_CAPTURE_INLINE_BYTES] = 0xAB;
+    ASSERT_EQ(asx_task_spawn_captured(big, noop_poll,
+              ASX_REGION_CAPTURE_ARENA_BYTES * 2u, NULL, &tid, &state), ASX_OK);
+    ASSERT_EQ(g_live_blocks, blocks + 2);
+
+    /* Chained blocks go back on reset */
+    asx_runtime_reset();
+    ASSERT_EQ(g_live_blocks, 0);
+    restore_default_hooks();
+}
+
+TEST(resource_capture_reserve_survives_seal) {
+    asx_region_options opts;
+    asx_region_id rid;
+    asx_task_id tid;
+    void *state;
+    uint32_t want = ASX_REGION_CAPTURE_INLINE_BYTES + 1024u;
+
+    install_counting_allocator();
+    asx_runtime_reset();
+
+    asx_region_options_init(&opts);
+    opts.capture_reserve = opts.capture_limit + 1u;
+    ASSERT_EQ(asx_region_open_with(&opts, &rid), ASX_E_INVALID_ARGUMENT);
+
+    opts.capture_limit = ASX_REGION_CAPTURE_UNBOUNDED;
+    opts.capture_reserve = want;
+    ASSERT_EQ(asx_region_open_with(&opts, &rid), ASX_OK);
+    ASSERT_EQ(g_live_blocks, 1);
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+
+    /* The reserve serves spawns without the allocator */
+    ASSERT_EQ(asx_task_spawn_captured(rid, noop_poll, want, NULL, &tid, &state),
+              ASX_OK);
+    /* Beyond it a sealed allocator cannot chain, and nothing leaks */
+    ASSERT_EQ(asx_task_spawn_captured(rid, noop_poll, 8u, NULL, &tid, &state),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(g_live_blocks, 1);
+
+    asx_runtime_reset();
+    ASSERT_EQ(g_live_blocks, 0);
+    restore_default_hooks();
+}
+
 /* ---- Per-region queries ---- */
 
 TEST(resource_region_capture_remaining_invalid_region) {
@@ -364,6 +493,73 @@ TEST(resource_kind_str_coverage) {
     ASSERT_STR_EQ(asx_resource_kind_str(ASX_RESOURCE_KIND_COUNT), "unknown");
 }
 
+TEST(resource_alloc_tag_str_coverage) {
+    ASSERT_STR_EQ(asx_alloc_tag_str(ASX_ALLOC_TAG_OTHER), "other");
+    ASSERT_STR_EQ(asx_alloc_tag_str(ASX_ALLOC_TAG_CODEC), "codec");
+    ASSERT_STR_EQ(asx_alloc_tag_str(ASX_ALLOC_TAG_EVENT_LOG), "event_log");
+    ASSERT_STR_EQ(asx_alloc_tag_str(ASX_ALLOC_TAG_BUFFER), "buffer");
+    ASSERT_STR_EQ(asx_alloc_tag_str(ASX_ALLOC_TAG_COUNT), "unknown");
+}
+
+/* ---- Allocation accounting ---- */
+
+#if ASX_ALLOC_PROFILE
+TEST(resource_alloc_snapshot_tracks_tags_and_seal) {
+    asx_alloc_snapshot snap;
+    uint64_t base;
+    void *a = NULL;
+    void *b = NULL;
+
+    /* Earlier tests may leave grown arenas live */
+    restore_default_hooks();
+    asx_resource_alloc_snapshot_reset();
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(&snap), ASX_OK);
+    base = snap.live_bytes;
+    ASSERT_EQ(snap.peak_bytes, base);
+
+    ASSERT_EQ(asx_runtime_alloc(100u, &a), ASX_OK);
+    ASSERT_EQ(asx_runtime_realloc(a, 300u, &a), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc_tagged(ASX_ALLOC_TAG_TIMER, 50u, &b), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc_tagged(ASX_ALLOC_TAG_COUNT, 1u, &b),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_free(a), ASX_OK);
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(&snap), ASX_OK);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].allocs, 1u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].reallocs, 1u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].frees, 1u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].bytes, 400u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].live_bytes, 0u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].peak_bytes, 300u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_TIMER].live_bytes, 50u);
+    ASSERT_EQ(snap.live_bytes, base + 50u);
+    ASSERT_EQ(snap.peak_bytes, base + 350u);
+    ASSERT_EQ(snap.untracked, 0u);
+
+    /* Sealed: refused calls are counted, nothing else moves */
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc(8u, &a), ASX_E_ALLOCATOR_SEALED);
+    asx_resource_alloc_snapshot_reset();
+    ASSERT_EQ(asx_runtime_alloc(8u, &a), ASX_E_ALLOCATOR_SEALED);
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(&snap), ASX_OK);
+    ASSERT_EQ(snap.sealed_rejects, 1u);
+    ASSERT_EQ(snap.site[ASX_ALLOC_TAG_OTHER].allocs, 0u);
+    ASSERT_EQ(snap.peak_bytes, base + 50u);
+
+    ASSERT_EQ(asx_runtime_free(b), ASX_OK);
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(&snap), ASX_OK);
+    ASSERT_EQ(snap.live_bytes, base);
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(NULL), ASX_E_INVALID_ARGUMENT);
+    restore_default_hooks();
+}
+#else
+TEST(resource_alloc_snapshot_compiled_out) {
+    asx_alloc_snapshot snap;
+
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(&snap), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_resource_alloc_snapshot_get(NULL), ASX_E_INVALID_ARGUMENT);
+}
+#endif
+
 /* ---- Determinism: exhaustion error is stable across calls ---- */
 
 TEST(resource_exhaustion_deterministic) {
@@ -409,6 +605,276 @@ TEST(resource_admit_then_allocate) {
               ASX_E_RESOURCE_EXHAUSTED);
 }
 
+TEST(resource_claim_holds_slots_against_plain_spawns) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_resource_token token;
+    uint32_t spawned = 0;
+    uint32_t i;
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_TASK, 4, &token), ASX_OK);
+    ASSERT_EQ(token.count, (uint32_t)4);
+    ASSERT_EQ(asx_resource_claimed(ASX_RESOURCE_TASK), (uint32_t)4);
+
+    /* Plain spawns stop short of the claimed slots */
+    while (asx_task_spawn(rid, noop_poll, NULL, &tid) == ASX_OK) spawned++;
+    ASSERT_EQ(spawned, (uint32_t)(ASX_MAX_TASKS - 4));
+    ASSERT_EQ(asx_resource_admit(ASX_RESOURCE_TASK, 1),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_TASK, 1, &token),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(token.count, (uint32_t)4);
+
+    /* Every claim spends without meeting exhaustion */
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_task_spawn_claimed(&token, noop_poll, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(token.count, (uint32_t)0);
+    ASSERT_EQ(asx_resource_claimed(ASX_RESOURCE_TASK), (uint32_t)0);
+    ASSERT_EQ(asx_task_spawn_claimed(&token, noop_poll, NULL, &tid),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(resource_region_quota_bounds_one_tenant) {
+    asx_region_id tenant, other;
+    asx_task_id tid;
+    asx_obligation_id oid, oid2;
+    asx_resource_token token;
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&tenant), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_resource_region_set_quota(tenant, ASX_RESOURCE_TASK, 3), ASX_OK);
+
+    /* Live and claimed tasks both count against the quota */
+    ASSERT_EQ(asx_task_spawn(tenant, pending_poll, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_resource_claim(tenant, ASX_RESOURCE_TASK, 2, &token), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(tenant, pending_poll, NULL, &tid),
+              ASX_E_ADMISSION_LIMIT);
+    ASSERT_EQ(asx_resource_claim(tenant, ASX_RESOURCE_TASK, 1, &token),
+              ASX_E_ADMISSION_LIMIT);
+    ASSERT_EQ(asx_task_spawn_claimed(&token, pending_poll, NULL, &tid), ASX_OK);
+    asx_resource_token_release(&token);
+    ASSERT_EQ(token.count, (uint32_t)0);
+    ASSERT_EQ(asx_task_spawn(tenant, pending_poll, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(tenant, pending_poll, NULL, &tid),
+              ASX_E_ADMISSION_LIMIT);
+
+    /* Other regions are untouched */
+    ASSERT_EQ(asx_task_spawn(other, pending_poll, NULL, &tid), ASX_OK);
+
+    /* Obligation quota counts RESERVED obligations; resolving frees room */
+    ASSERT_EQ(asx_resource_region_set_quota(tenant, ASX_RESOURCE_OBLIGATION, 1),
+              ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(tenant, &oid), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(tenant, &oid2), ASX_E_ADMISSION_LIMIT);
+    ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(tenant, &oid2), ASX_OK);
+
+    /* Zero lifts the quota */
+    ASSERT_EQ(asx_resource_region_set_quota(tenant, ASX_RESOURCE_TASK, 0), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(tenant, pending_poll, NULL, &tid), ASX_OK);
+
+    ASSERT_EQ(asx_resource_region_set_quota(tenant, ASX_RESOURCE_REGION, 1),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_resource_region_set_quota(ASX_INVALID_ID, ASX_RESOURCE_TASK, 1),
+              ASX_E_NOT_FOUND);
+}
+
+TEST(resource_claim_returned_on_release_and_close) {
+    asx_region_id rid;
+    asx_obligation_id oid;
+    asx_task_id tid;
+    asx_resource_token token, copy;
+    asx_budget budget;
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    /* Spending needs a token of the matching kind */
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_OBLIGATION, 3, &token), ASX_OK);
+    ASSERT_EQ(asx_task_spawn_claimed(&token, noop_poll, NULL, &tid),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_obligation_reserve_claimed(&token, &oid), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+
+    /* A copy cannot spend what the original already returned */
+    copy = token;
+    asx_resource_token_release(&token);
+    ASSERT_EQ(asx_resource_claimed(ASX_RESOURCE_OBLIGATION), (uint32_t)0);
+    ASSERT_EQ(asx_obligation_reserve_claimed(&copy, &oid), ASX_E_INVALID_STATE);
+    asx_resource_token_release(&token);
+    asx_resource_token_release(NULL);
+
+    /* Closing the region returns unspent claims */
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_TASK, 2, &token), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_resource_claimed(ASX_RESOURCE_TASK), (uint32_t)0);
+    ASSERT_NE(asx_task_spawn_claimed(&token, noop_poll, NULL, &tid), ASX_OK);
+    asx_resource_token_release(&token);
+
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_TASK, 1, &token),
+              ASX_E_REGION_NOT_OPEN);
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_REGION, 1, &token),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_resource_claim(rid, ASX_RESOURCE_TASK, 0, &token),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+/* Watermark crossings seen by the callback */
+static uint32_t g_edges;
+static asx_watermark_edge g_last_edge;
+static uint32_t g_last_used;
+
+static void record_edge(void *ctx, asx_resource_kind kind,
+                        asx_watermark_edge edge, uint32_t used)
+{
+    (void)ctx;
+    (void)kind;
+    g_edges++;
+    g_last_edge = edge;
+    g_last_used = used;
+}
+
+TEST(resource_watermark_fires_once_per_edge) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_obligation_id oid;
+    asx_resource_watermark wm;
+    asx_trace_event ev;
+    asx_budget budget;
+    uint32_t i;
+    asx_runtime_reset();
+    asx_trace_reset();
+    g_edges = 0;
+
+    wm.low = 2;
+    wm.high = 4;
+    wm.fn = record_edge;
+    wm.ctx = NULL;
+    ASSERT_EQ(asx_resource_set_watermark(ASX_RESOURCE_TASK, &wm), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    /* Rising to high fires once; staying above fires nothing */
+    for (i = 0; i < 6; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, noop_poll, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(g_edges, 1u);
+    ASSERT_EQ((int)g_last_edge, (int)ASX_WATERMARK_HIGH);
+    ASSERT_EQ(g_last_used, 4u);
+    ASSERT_TRUE(asx_resource_watermark_high(ASX_RESOURCE_TASK));
+
+    /* Draining reclaims every slot; the fall fires once, at low */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 0u);
+    ASSERT_EQ(g_edges, 2u);
+    ASSERT_EQ((int)g_last_edge, (int)ASX_WATERMARK_LOW);
+    ASSERT_EQ(g_last_used, 2u);
+    ASSERT_FALSE(asx_resource_watermark_high(ASX_RESOURCE_TASK));
+
+    /* Each crossing is traced too, after the spawn that made it */
+    ASSERT_TRUE(asx_trace_event_get(5u, &ev));
+    ASSERT_EQ((int)ev.kind, (int)ASX_TRACE_WATERMARK);
+    ASSERT_EQ(ev.aux, ASX_TRACE_WATERMARK_AUX(ASX_RESOURCE_TASK,
+                                              ASX_WATERMARK_HIGH, 4u));
+
+    /* Installing while already past high starts on that side silently */
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
+    wm.low = 0;
+    wm.high = 1;
+    ASSERT_EQ(asx_resource_set_watermark(ASX_RESOURCE_OBLIGATION, &wm), ASX_OK);
+    ASSERT_TRUE(asx_resource_watermark_high(ASX_RESOURCE_OBLIGATION));
+    ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+    ASSERT_EQ(g_edges, 3u);
+    ASSERT_EQ((int)g_last_edge, (int)ASX_WATERMARK_LOW);
+
+    /* Removal and argument checks */
+    ASSERT_EQ(asx_resource_set_watermark(ASX_RESOURCE_OBLIGATION, NULL), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
+    ASSERT_EQ(g_edges, 3u);
+    wm.low = 4;
+    wm.high = 4;
+    ASSERT_EQ(asx_resource_set_watermark(ASX_RESOURCE_TASK, &wm),
+              ASX_E_INVALID_ARGUMENT);
+    wm.low = 0;
+    wm.high = 0;
+    ASSERT_EQ(asx_resource_set_watermark(ASX_RESOURCE_TASK, &wm),
+              ASX_E_INVALID_ARGUMENT);
+    wm.high = 1;
+    ASSERT_EQ(asx_resource_set_watermark(ASX_RESOURCE_REGION, &wm),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* Reset removes every watermark */
+    asx_runtime_reset();
+    ASSERT_FALSE(asx_resource_watermark_high(ASX_RESOURCE_TASK));
+}
+
+TEST(resource_admission_policy_inline_in_spawn_and_reserve) {
+    asx_region_id rid;
+    asx_task_id oldest, tid;
+    asx_obligation_id oid;
+    asx_overload_policy pol;
+    asx_trace_event ev;
+    asx_task_state state;
+    uint32_t events;
+    asx_runtime_reset();
+    asx_trace_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &oldest), ASX_OK);
+
+    /* Threshold 0 triggers at any load */
+    asx_overload_policy_init(&pol);
+    pol.threshold_pct = 0;
+    ASSERT_EQ(asx_region_set_admission(rid, &pol), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid),
+              ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 1u);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_OBLIGATION), 0u);
+
+    events = asx_trace_event_count();
+    ASSERT_TRUE(asx_trace_event_get(events - 1u, &ev));
+    ASSERT_EQ((int)ev.kind, (int)ASX_TRACE_ADMISSION);
+    ASSERT_EQ(ev.entity_id, rid);
+    ASSERT_EQ(ev.aux, ASX_TRACE_ADMISSION_AUX(ASX_ADMISSION_OBLIGATION,
+                                              ASX_OVERLOAD_REJECT, 0u));
+
+    pol.mode = ASX_OVERLOAD_BACKPRESSURE;
+    ASSERT_EQ(asx_region_set_admission(rid, &pol), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid), ASX_E_WOULD_BLOCK);
+
+    /* Shed mode evicts the oldest task and admits in the same call */
+    pol.mode = ASX_OVERLOAD_SHED_OLDEST;
+    pol.shed_max = 1;
+    ASSERT_EQ(asx_region_set_admission(rid, &pol), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_get_state(oldest, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_task_get_state(tid, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CREATED);
+
+    /* Detached: no decision, no event */
+    ASSERT_EQ(asx_region_set_admission(rid, NULL), ASX_OK);
+    events = asx_trace_event_count();
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
+    ASSERT_TRUE(asx_trace_event_get(events, &ev));
+    ASSERT_EQ((int)ev.kind, (int)ASX_TRACE_OBLIGATION_RESERVE);
+    ASSERT_EQ(asx_obligation_abort(oid), ASX_OK);
+
+    pol.threshold_pct = 101;
+    ASSERT_EQ(asx_region_set_admission(rid, &pol), ASX_E_INVALID_ARGUMENT);
+    pol.threshold_pct = 50;
+    pol.mode = (asx_overload_mode)7;
+    ASSERT_EQ(asx_region_set_admission(rid, &pol), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_region_set_admission(ASX_INVALID_ID, NULL), ASX_E_NOT_FOUND);
+}
+
 int main(void)
 {
     fprintf(stderr, "=== test_resource ===\n");
@@ -440,8 +906,6 @@ int main(void)
     RUN_TEST(resource_obligation_arena_exhaustion);
 
     /* Cleanup stack exhaustion */
-    RUN_TEST(resource_cleanup_stack_exhaustion);
-
     /* Capture arena exhaustion */
     RUN_TEST(resource_capture_arena_exhaustion);
 
@@ -456,12 +920,30 @@ int main(void)
 
     /* Diagnostic */
     RUN_TEST(resource_kind_str_coverage);
+    RUN_TEST(resource_alloc_tag_str_coverage);
 
     /* Determinism */
     RUN_TEST(resource_exhaustion_deterministic);
 
     /* Integration */
     RUN_TEST(resource_admit_then_allocate);
+    RUN_TEST(resource_claim_holds_slots_against_plain_spawns);
+    RUN_TEST(resource_region_quota_bounds_one_tenant);
+    RUN_TEST(resource_claim_returned_on_release_and_close);
+    RUN_TEST(resource_watermark_fires_once_per_edge);
+    RUN_TEST(resource_admission_policy_inline_in_spawn_and_reserve);
+
+    /* Capture sizing (installs hooks, so arenas may grow afterwards) */
+    RUN_TEST(resource_capture_limit_per_region);
+    RUN_TEST(resource_capture_reserve_survives_seal);
+    RUN_TEST(resource_cleanup_stack_exhaustion);
+
+    /* Allocation accounting (installs hooks) */
+#if ASX_ALLOC_PROFILE
+    RUN_TEST(resource_alloc_snapshot_tracks_tags_and_seal);
+#else
+    RUN_TEST(resource_alloc_snapshot_compiled_out);
+#endif
 
     TEST_REPORT();
     return test_failures;
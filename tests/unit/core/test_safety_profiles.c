@@ -3,7 +3,7 @@
  *
  * Tests: safety profile query, fault injection (clock skew, clock reverse,
  * entropy constant, alloc fail), trigger_after/trigger_count semantics,
- * fault clear, and deterministic replay consistency.
+ * per-hook arming, fault clear, and deterministic replay consistency.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -50,6 +50,14 @@ TEST(safety_profile_active_matches_compile_flag) {
     ASSERT_EQ(p, (asx_safety_profile)ASX_SAFETY_PROFILE_SELECTED);
 }
 
+TEST(containment_policy_selected_matches_active) {
+    /* The constant the static profile folds in is the runtime answer */
+    ASSERT_EQ(asx_containment_policy_active(),
+              (asx_containment_policy)ASX_CONTAINMENT_POLICY_SELECTED);
+    ASSERT_EQ(asx_containment_policy_active(),
+              asx_containment_policy_for_profile(asx_safety_profile_active()));
+}
+
 TEST(safety_profile_str_debug) {
     ASSERT_STR_EQ(asx_safety_profile_str(ASX_SAFETY_DEBUG), "debug");
 }
@@ -80,6 +88,7 @@ TEST(fault_inject_none_kind_rejected) {
     ASSERT_EQ(asx_fault_inject(&f), ASX_E_INVALID_ARGUMENT);
 }
 
+#if ASX_FAULT_INJECTION
 TEST(fault_inject_and_count) {
     asx_fault_injection f;
     asx_fault_clear();
@@ -292,6 +301,65 @@ TEST(fault_trigger_count_limits_injections) {
     asx_fault_clear();
 }
 
+/* ---- Fault injection: per-hook arming ---- */
+
+TEST(fault_trigger_after_counts_from_hook_arming) {
+    asx_fault_injection f;
+    asx_time base = 0, now = 0;
+    uint64_t val = 0;
+
+    install_test_hooks();
+    asx_fault_clear();
+    ASSERT_EQ(asx_runtime_now_ns(&base), ASX_OK);
+
+    /* An entropy fault leaves the clock hook unarmed */
+    memset(&f, 0, sizeof(f));
+    f.kind = ASX_FAULT_ENTROPY_CONST;
+    f.param = 7;
+    ASSERT_EQ(asx_fault_inject(&f), ASX_OK);
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_EQ(now, base);
+    ASSERT_EQ(asx_runtime_random_u64(&val), ASX_OK);
+    ASSERT_EQ(val, (uint64_t)7);
+
+    /* Unarmed clock reads did not count toward trigger_after */
+    memset(&f, 0, sizeof(f));
+    f.kind = ASX_FAULT_CLOCK_SKEW;
+    f.param = 5;
+    f.trigger_after = 1;
+    ASSERT_EQ(asx_fault_inject(&f), ASX_OK);
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_EQ(now, base);
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_EQ(now, base + 5u);
+
+    /* Clearing disarms every hook */
+    asx_fault_clear();
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_EQ(now, base);
+    ASSERT_EQ(asx_runtime_random_u64(&val), ASX_OK);
+    ASSERT_NE(val, (uint64_t)7);
+}
+#else
+/* Compiled out: a valid fault is refused and nothing is ever armed */
+TEST(fault_inject_compiled_out_returns_invalid_state) {
+    asx_fault_injection f;
+    asx_time before = 0, after = 0;
+
+    install_test_hooks();
+    ASSERT_EQ(asx_runtime_now_ns(&before), ASX_OK);
+    memset(&f, 0, sizeof(f));
+    f.kind = ASX_FAULT_CLOCK_SKEW;
+    f.param = 100;
+    ASSERT_EQ(asx_fault_inject(&f), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_fault_injection_count(), (uint32_t)0);
+    ASSERT_EQ(asx_runtime_now_ns(&after), ASX_OK);
+    ASSERT_EQ(after, before);
+    ASSERT_EQ(asx_fault_clear(), ASX_OK);
+}
+#endif
+
 /* ---- Determinism: fault injection is deterministic across reruns ---- */
 
 TEST(fault_injection_deterministic_replay) {
@@ -323,6 +391,7 @@ int main(void) {
 
     /* Safety profile queries */
     RUN_TEST(safety_profile_active_matches_compile_flag);
+    RUN_TEST(containment_policy_selected_matches_active);
     RUN_TEST(safety_profile_str_debug);
     RUN_TEST(safety_profile_str_hardened);
     RUN_TEST(safety_profile_str_release);
@@ -331,6 +400,7 @@ int main(void) {
     /* Fault injection: basic API */
     RUN_TEST(fault_inject_null_rejected);
     RUN_TEST(fault_inject_none_kind_rejected);
+#if ASX_FAULT_INJECTION
     RUN_TEST(fault_inject_and_count);
     RUN_TEST(fault_clear_resets_count);
 
@@ -348,6 +418,10 @@ int main(void) {
     /* Fault injection: trigger semantics */
     RUN_TEST(fault_trigger_after_delays_activation);
     RUN_TEST(fault_trigger_count_limits_injections);
+    RUN_TEST(fault_trigger_after_counts_from_hook_arming);
+#else
+    RUN_TEST(fault_inject_compiled_out_returns_invalid_state);
+#endif
 
     /* Determinism */
     RUN_TEST(fault_injection_deterministic_replay);
@@ -166,6 +166,31 @@ TEST(obligation_terminal_predicates) {
     ASSERT_TRUE(asx_obligation_is_terminal(ASX_OBLIGATION_LEAKED));
 }
 
+/* Inline masks agree with the out-of-line checks, every pair */
+TEST(legal_masks_match_checks) {
+    int f, t;
+
+    for (f = 0; f < 8; f++) {
+        for (t = 0; t < 8; t++) {
+            ASSERT_EQ(asx_region_transition_legal((asx_region_state)f,
+                                                  (asx_region_state)t),
+                      asx_region_transition_check((asx_region_state)f,
+                                                  (asx_region_state)t) == ASX_OK);
+            ASSERT_EQ(asx_task_transition_legal((asx_task_state)f,
+                                                (asx_task_state)t),
+                      asx_task_transition_check((asx_task_state)f,
+                                                (asx_task_state)t) == ASX_OK);
+            ASSERT_EQ(asx_obligation_transition_legal((asx_obligation_state)f,
+                                                      (asx_obligation_state)t),
+                      asx_obligation_transition_check((asx_obligation_state)f,
+                                                      (asx_obligation_state)t) == ASX_OK);
+        }
+    }
+    ASSERT_EQ(ASX_TASK_NEXT_RUNNING & ASX_STATE_BIT(ASX_TASK_COMPLETED),
+              ASX_STATE_BIT(ASX_TASK_COMPLETED));
+    ASSERT_FALSE(asx_task_transition_legal(ASX_TASK_RUNNING, (asx_task_state)40));
+}
+
 int main(void) {
     fprintf(stderr, "=== test_transition ===\n");
     RUN_TEST(region_legal_forward);
@@ -190,6 +215,7 @@ int main(void) {
     RUN_TEST(obligation_transition_out_of_range);
     RUN_TEST(task_terminal_predicates);
     RUN_TEST(obligation_terminal_predicates);
+    RUN_TEST(legal_masks_match_checks);
     TEST_REPORT();
     return test_failures;
 }
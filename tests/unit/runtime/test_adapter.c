@@ -9,6 +9,7 @@
  *   5. Isomorphism proof: single point and sweep
  *   6. Edge cases: zero capacity, boundary loads
  *   7. Diagnostics: string functions, version
+ *   8. Compiled dispatch tables against the reference paths
  *
  * SPDX-License-Identifier: MIT
  */
@@ -17,6 +18,7 @@
 
 #include "test_harness.h"
 #include <asx/runtime/adapter.h>
+#include <asx/runtime/digest.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -415,6 +417,84 @@ TEST(iso_decision_hash_deterministic)
     ASSERT_EQ(proof1.fallback_hash, proof2.fallback_hash);
 }
 
+/* ===================================================================
+ * Compiled dispatch table tests
+ * =================================================================== */
+
+static int decisions_equal(const asx_adapter_decision *a,
+                           const asx_adapter_decision *b)
+{
+    return a->triggered == b->triggered && a->mode == b->mode &&
+           a->load_pct == b->load_pct && a->shed_count == b->shed_count &&
+           a->admit_status == b->admit_status &&
+           a->path_used == b->path_used &&
+           a->decision_hash == b->decision_hash;
+}
+
+TEST(dispatch_tables_match_reference_paths)
+{
+    static const uint32_t caps[] = { 0, 1, 2, 3, 7, 100, 333 };
+    asx_resource_class r1 = ASX_CLASS_R1;
+    asx_auto_deadline_tracker dt;
+    uint32_t c, used;
+
+    ASSERT_EQ(asx_adapter_dispatch_tables_enabled(), 0);
+    ASSERT_EQ(asx_adapter_dispatch_tables_build(), ASX_OK);
+    ASSERT_EQ(asx_adapter_dispatch_tables_enabled(), 1);
+
+    asx_auto_deadline_init(&dt);
+    asx_auto_deadline_record(&dt, 10, 5);
+
+    for (c = 0; c < sizeof(caps) / sizeof(caps[0]); c++) {
+        for (used = 0; used <= caps[c] + 2u; used++) {
+            asx_adapter_decision got, ref;
+
+            asx_adapter_dispatch(ASX_ADAPTER_DOMAIN_HFT, ASX_ADAPTER_ACCELERATED,
+                                 used, caps[c], NULL, &got);
+            asx_adapter_hft_decide(used, caps[c], &ref);
+            ASSERT_TRUE(decisions_equal(&got, &ref));
+
+            asx_adapter_dispatch(ASX_ADAPTER_DOMAIN_ROUTER, ASX_ADAPTER_FALLBACK,
+                                 used, caps[c], NULL, &got);
+            asx_adapter_router_fallback(used, caps[c], &ref);
+            ASSERT_TRUE(decisions_equal(&got, &ref));
+
+            asx_adapter_dispatch(ASX_ADAPTER_DOMAIN_AUTOMOTIVE,
+                                 ASX_ADAPTER_ACCELERATED, used, caps[c], NULL, &got);
+            asx_adapter_auto_decide(used, caps[c], NULL, &ref);
+            ASSERT_TRUE(decisions_equal(&got, &ref));
+
+            /* Paths no table covers */
+            asx_adapter_dispatch(ASX_ADAPTER_DOMAIN_AUTOMOTIVE,
+                                 ASX_ADAPTER_ACCELERATED, used, caps[c], &dt, &got);
+            asx_adapter_auto_decide(used, caps[c], &dt, &ref);
+            ASSERT_TRUE(decisions_equal(&got, &ref));
+
+            asx_adapter_dispatch(ASX_ADAPTER_DOMAIN_ROUTER, ASX_ADAPTER_ACCELERATED,
+                                 used, caps[c], &r1, &got);
+            asx_adapter_router_decide(used, caps[c], ASX_CLASS_R1, &ref);
+            ASSERT_TRUE(decisions_equal(&got, &ref));
+        }
+    }
+
+    /* A digest mode set after the build falls back to hashing */
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_ADAPTER, ASX_DIGEST_WORD64),
+              ASX_OK);
+    {
+        asx_adapter_decision got, ref;
+        asx_adapter_dispatch(ASX_ADAPTER_DOMAIN_HFT, ASX_ADAPTER_ACCELERATED,
+                             90, 100, NULL, &got);
+        asx_adapter_hft_decide(90, 100, &ref);
+        ASSERT_TRUE(decisions_equal(&got, &ref));
+    }
+    asx_digest_reset_modes();
+
+    ASSERT_EQ(asx_adapter_prove_isomorphism_sweep(ASX_ADAPTER_DOMAIN_ROUTER,
+                                                  100, NULL, NULL), 1);
+    asx_adapter_dispatch_tables_clear();
+    ASSERT_EQ(asx_adapter_dispatch_tables_enabled(), 0);
+}
+
 /* ===================================================================
  * Diagnostics tests
  * =================================================================== */
@@ -500,6 +580,9 @@ int main(void)
     RUN_TEST(iso_zero_capacity_all_domains);
     RUN_TEST(iso_decision_hash_deterministic);
 
+    /* Compiled tables */
+    RUN_TEST(dispatch_tables_match_reference_paths);
+
     /* Diagnostics */
     RUN_TEST(domain_str_all_valid);
     RUN_TEST(mode_str_all_valid);
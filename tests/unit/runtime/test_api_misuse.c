@@ -74,7 +74,7 @@ TEST(channel_create_exceeds_max_capacity) {
     asx_channel_reset();
 
     ASSERT_EQ(asx_region_open(&rid), ASX_OK);
-    ASSERT_EQ(asx_channel_create(rid, ASX_CHANNEL_MAX_CAPACITY + 1, &cid),
+    ASSERT_EQ(asx_channel_create(rid, ASX_CHANNEL_ARENA_MAX_CAPACITY + 1, &cid),
               ASX_E_INVALID_ARGUMENT);
 }
 
@@ -0,0 +1,345 @@
+/*
+ * test_arena_growth.c — hook-backed chunked arena growth
+ *
+ * Tests: growth past the static ASX_MAX_* chunk through the allocator
+ * hook, handle/generation validity in grown chunks, freeze after
+ * asx_runtime_seal_allocator, allocator failure mapping, reset
+ * shrinking arenas back to the static chunk, and timer wheel growth and
+ * trimming under cancel-heavy load.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/core/ghost.h>
+#include <asx/core/resource.h>
+#include <stdlib.h>
+
+/* ---- Hook helpers ---- */
+
+static int g_fail_alloc;
+
+static void *growth_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    if (g_fail_alloc) return NULL;
+    return malloc(size);
+}
+
+static void growth_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    free(ptr);
+}
+
+static void install_growth_hooks(void)
+{
+    asx_runtime_hooks hooks;
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.allocator.malloc_fn = growth_malloc;
+    hooks.allocator.free_fn   = growth_free;
+    g_fail_alloc = 0;
+    (void)asx_runtime_set_hooks(&hooks);
+}
+
+static asx_status poll_complete(void *data, asx_task_id self)
+{
+    (void)data; (void)self;
+    return ASX_OK;
+}
+
+/* ---- Tests ---- */
+
+TEST(task_arena_grows_past_static_chunk)
+{
+    asx_region_id rid;
+    asx_task_id tids[ASX_MAX_TASKS * 3];
+    asx_task_state st;
+    asx_budget budget;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS * 3; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tids[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), (uint32_t)(ASX_MAX_TASKS * 3));
+
+    /* Handles in grown chunks resolve like static ones */
+    ASSERT_EQ(asx_task_get_state(tids[ASX_MAX_TASKS * 2 + 5], &st), ASX_OK);
+    ASSERT_EQ(st, ASX_TASK_CREATED);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS * 3; i++) {
+        ASSERT_EQ(asx_task_get_state(tids[i], &st), ASX_OK);
+        ASSERT_EQ(st, ASX_TASK_COMPLETED);
+    }
+
+    asx_runtime_reset();
+}
+
+TEST(seal_freezes_arena_size)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    /* One past the static chunk forces exactly one grown chunk */
+    for (i = 0; i < ASX_MAX_TASKS + 1; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    }
+
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_resource_capacity(ASX_RESOURCE_TASK), (uint32_t)(ASX_MAX_TASKS * 2));
+
+    /* Remaining slots of the grown chunk are still usable */
+    for (i = ASX_MAX_TASKS + 1; i < ASX_MAX_TASKS * 2; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_resource_remaining(ASX_RESOURCE_TASK), (uint32_t)0);
+
+    asx_runtime_reset();
+}
+
+TEST(reset_shrinks_to_static_chunk)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS * 2; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_resource_capacity(ASX_RESOURCE_TASK), (uint32_t)ASX_MAX_TASKS);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), (uint32_t)0);
+}
+
+TEST(alloc_failure_reports_exhaustion)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    }
+
+    g_fail_alloc = 1;
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), (uint32_t)ASX_MAX_TASKS);
+
+    /* Recovers once the allocator succeeds again */
+    g_fail_alloc = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+
+    asx_runtime_reset();
+}
+
+TEST(region_arena_grows_and_recycles_with_generation)
+{
+    asx_region_id rids[ASX_MAX_REGIONS + 2];
+    asx_region_id again;
+    asx_region_state st;
+    asx_budget budget;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    for (i = 0; i < ASX_MAX_REGIONS + 2; i++) {
+        ASSERT_EQ(asx_region_open(&rids[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_handle_slot(rids[ASX_MAX_REGIONS + 1]),
+              (uint16_t)(ASX_MAX_REGIONS + 1));
+
+    /* Close and recycle a slot in the grown chunk */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rids[ASX_MAX_REGIONS], &budget), ASX_OK);
+    ASSERT_EQ(asx_region_get_state(rids[ASX_MAX_REGIONS], &st), ASX_OK);
+    ASSERT_EQ(st, ASX_REGION_CLOSED);
+
+    ASSERT_EQ(asx_region_open(&again), ASX_OK);
+#ifndef ASX_DEBUG_QUARANTINE
+    ASSERT_EQ(asx_handle_slot(again), asx_handle_slot(rids[ASX_MAX_REGIONS]));
+    ASSERT_EQ(asx_region_get_state(rids[ASX_MAX_REGIONS], &st),
+              ASX_E_STALE_HANDLE);
+
+    /* Free slots come back most recently closed first, across chunks */
+    ASSERT_EQ(asx_region_drain(rids[1], &budget), ASX_OK);
+    ASSERT_EQ(asx_region_drain(rids[ASX_MAX_REGIONS + 1], &budget), ASX_OK);
+    ASSERT_EQ(asx_region_open(&again), ASX_OK);
+    ASSERT_EQ(asx_handle_slot(again), (uint16_t)(ASX_MAX_REGIONS + 1));
+    ASSERT_EQ(asx_region_open(&again), ASX_OK);
+    ASSERT_EQ(asx_handle_slot(again), (uint16_t)1);
+    ASSERT_EQ(asx_region_open(&again), ASX_OK);
+    ASSERT_EQ(asx_handle_slot(again), (uint16_t)(ASX_MAX_REGIONS + 2));
+#endif
+
+    asx_runtime_reset();
+}
+
+TEST(obligation_arena_grows_past_static_chunk)
+{
+    asx_region_id rid;
+    asx_obligation_id oid;
+    asx_obligation_state st;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_OBLIGATIONS + 1; i++) {
+        ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
+    }
+    ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+    ASSERT_EQ(asx_obligation_get_state(oid, &st), ASX_OK);
+    ASSERT_EQ(st, ASX_OBLIGATION_COMMITTED);
+
+    asx_runtime_reset();
+}
+
+TEST(timer_wheel_grows_past_static_chunk)
+{
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    static asx_timer_handle handles[ASX_MAX_TIMERS * 2 + 1];
+    static void *wakers[ASX_MAX_TIMERS * 2 + 1];
+    asx_timer_handle extra;
+    uint32_t n = ASX_MAX_TIMERS * 2 + 1;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_timer_wheel_reset(w);
+
+    /* Descending deadlines so firing order differs from slot order */
+    for (i = 0; i < n; i++) {
+        ASSERT_EQ(asx_timer_register(w, (asx_time)(10000 - i),
+                                     (void *)(uintptr_t)(i + 1u), &handles[i]),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_timer_active_count(w), n);
+
+    /* Handles in grown chunks cancel like static ones */
+    ASSERT_TRUE(asx_timer_cancel(w, &handles[ASX_MAX_TIMERS + 7]));
+    ASSERT_FALSE(asx_timer_cancel(w, &handles[ASX_MAX_TIMERS + 7]));
+
+    ASSERT_EQ(asx_timer_collect_expired(w, 10000, wakers, n), n - 1u);
+    ASSERT_EQ(wakers[0], (void *)(uintptr_t)n);
+    ASSERT_EQ(wakers[n - 2u], (void *)(uintptr_t)1);
+
+    /* Sealed: recycled slots stay usable, reset shrinks to the static chunk */
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_timer_register(w, 20000, NULL, &extra), ASX_OK);
+    asx_timer_wheel_reset(w);
+    for (i = 0; i < ASX_MAX_TIMERS; i++) {
+        ASSERT_EQ(asx_timer_register(w, 100, NULL, &extra), ASX_OK);
+    }
+    ASSERT_EQ(asx_timer_register(w, 100, NULL, &extra), ASX_E_RESOURCE_EXHAUSTED);
+
+    asx_timer_wheel_reset(w);
+    asx_runtime_reset();
+}
+
+TEST(timer_wheel_trims_chunks_after_cancels)
+{
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    static asx_timer_handle handles[ASX_MAX_TIMERS * 3];
+    asx_timer_arena_stats stats;
+    asx_timer_handle again;
+    uint32_t n = ASX_MAX_TIMERS * 3;
+    uint32_t i;
+
+    install_growth_hooks();
+    asx_timer_wheel_reset(w);
+    for (i = 0; i < n; i++) {
+        ASSERT_EQ(asx_timer_register(w, 1000, NULL, &handles[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_timer_arena_query(w, &stats), ASX_OK);
+    ASSERT_EQ(stats.capacity, n);
+    ASSERT_EQ(stats.used, n);
+    ASSERT_EQ(asx_timer_arena_query(w, NULL), ASX_E_INVALID_ARGUMENT);
+
+    /* Request timeouts: all but the first few are cancelled */
+    for (i = n; i-- > 4u;) {
+        ASSERT_TRUE(asx_timer_cancel(w, &handles[i]));
+    }
+    ASSERT_EQ(asx_timer_arena_query(w, &stats), ASX_OK);
+    ASSERT_EQ(stats.capacity, ASX_MAX_TIMERS * 2u);
+    ASSERT_EQ(stats.used, 4u);
+    ASSERT_EQ(stats.free, ASX_MAX_TIMERS * 2u - 4u);
+    ASSERT_EQ(stats.trimmed, 1u);
+
+    /* The lowest free slot is reused; trimmed handles stay stale */
+    ASSERT_EQ(asx_timer_register(w, 1000, NULL, &again), ASX_OK);
+    ASSERT_EQ(again.slot, 4u);
+    ASSERT_FALSE(asx_timer_is_live(w, &handles[n - 1u]));
+    for (i = 0; i < ASX_MAX_TIMERS * 2u - 5u; i++) {
+        ASSERT_EQ(asx_timer_register(w, 1000, NULL, &again), ASX_OK);
+    }
+    ASSERT_EQ(asx_timer_register(w, 1000, NULL, &again), ASX_OK);
+    ASSERT_EQ(again.slot, ASX_MAX_TIMERS * 2u);
+    ASSERT_TRUE(again.generation > handles[ASX_MAX_TIMERS * 2u].generation);
+    ASSERT_FALSE(asx_timer_cancel(w, &handles[ASX_MAX_TIMERS * 2u]));
+    ASSERT_TRUE(asx_timer_is_live(w, &again));
+
+    /* Sealed: the arena keeps its size however many timers retire */
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_timer_collect_expired(w, 1000, NULL, 0), 0u);
+    {
+        static void *wakers[ASX_MAX_TIMERS * 3];
+        ASSERT_EQ(asx_timer_collect_expired(w, 1000, wakers, n), ASX_MAX_TIMERS * 2u + 1u);
+    }
+    ASSERT_EQ(asx_timer_arena_query(w, &stats), ASX_OK);
+    ASSERT_EQ(stats.capacity, n);
+    ASSERT_EQ(stats.used, 0u);
+    ASSERT_EQ(stats.trimmed, 1u);
+
+    asx_timer_wheel_reset(w);
+    asx_runtime_reset();
+}
+
+int main(void)
+{
+    fprintf(stderr, "=== test_arena_growth ===\n");
+
+    RUN_TEST(task_arena_grows_past_static_chunk);
+    RUN_TEST(seal_freezes_arena_size);
+    RUN_TEST(reset_shrinks_to_static_chunk);
+    RUN_TEST(alloc_failure_reports_exhaustion);
+    RUN_TEST(region_arena_grows_and_recycles_with_generation);
+    RUN_TEST(obligation_arena_grows_past_static_chunk);
+    RUN_TEST(timer_wheel_grows_past_static_chunk);
+    RUN_TEST(timer_wheel_trims_chunks_after_cancels);
+
+    TEST_REPORT();
+    return test_failures;
+}
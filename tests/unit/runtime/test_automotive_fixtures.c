@@ -626,6 +626,8 @@ TEST(scheduler_budget_event_on_exhaustion) {
     ASSERT_TRUE(found_budget);
 }
 
+#if !ASX_HANDLE_EPOCH
+/* Reset epochs make handle values, and so digests, differ per run */
 TEST(deterministic_trace_digest_across_runs) {
     asx_region_id rid;
     asx_task_id tid;
@@ -666,6 +668,7 @@ TEST(deterministic_trace_digest_across_runs) {
     /* Deterministic: identical scenarios produce identical digests */
     ASSERT_EQ(digest1, digest2);
 }
+#endif
 
 /* ===================================================================
  * Main
@@ -700,7 +703,9 @@ int main(void) {
     RUN_TEST(budget_meet_tightens_deadline);
     RUN_TEST(watchdog_region_containment_after_deadline);
     RUN_TEST(scheduler_budget_event_on_exhaustion);
+#if !ASX_HANDLE_EPOCH
     RUN_TEST(deterministic_trace_digest_across_runs);
+#endif
 
     TEST_REPORT();
     return test_failures;
@@ -1,15 +1,19 @@
 /*
  * test_automotive_instrument.c — automotive instrumentation tests (bd-j4m.4)
  *
- * Exercises deadline tracking, watchdog monitoring, audit ring,
- * compliance gates, and global instrumentation state.
+ * Exercises deadline tracking, per-class sliding windows, watchdog
+ * monitoring (polled and timer-driven), audit ring and its page persistence, compliance gates,
+ * and global instrumentation state.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include "test_log.h"
 #include "test_harness.h"
+#include <asx/asx.h>
 #include <asx/runtime/automotive_instrument.h>
+#include <asx/runtime/waker.h>
+#include <string.h>
 
 /* -------------------------------------------------------------------
  * Deadline tracker tests
@@ -203,6 +207,74 @@ TEST(watchdog_reset_preserves_period)
     ASSERT_EQ(wd.armed, 0);
 }
 
+static uint32_t g_escalations;
+static uint64_t g_last_overdue;
+
+static void count_escalation(void *ctx, asx_auto_watchdog *wd,
+                             uint64_t overdue_ns)
+{
+    (void)ctx;
+    (void)wd;
+    g_escalations++;
+    g_last_overdue = overdue_ns;
+}
+
+TEST(watchdog_timer_escalates_on_expiry_without_polling)
+{
+    static asx_auto_watchdog wd;
+    asx_timer_wheel *wheel = asx_timer_wheel_global();
+    void *fired[4];
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    asx_timer_wheel_reset(wheel);
+    asx_auto_instrument_reset();
+    g_escalations = 0;
+
+    asx_auto_watchdog_init(&wd, 1000);
+    ASSERT_EQ(asx_auto_watchdog_arm_timer(NULL, NULL, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    asx_auto_watchdog_checkpoint(&wd, 100);
+    ASSERT_EQ(asx_auto_watchdog_arm_timer(&wd, count_escalation, NULL), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(wheel), 1u);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, asx_auto_watchdog_poll, &wd, &tid), ASX_OK);
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_parked_count(), 1u);
+
+    /* A checkpoint moves the one timer rather than adding one */
+    asx_auto_watchdog_checkpoint(&wd, 600);
+    ASSERT_EQ(asx_timer_active_count(wheel), 1u);
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_timer_collect_expired(wheel, 1599, fired, 4), 0u);
+    ASSERT_EQ(g_escalations, 0u);
+
+    /* Expiry wakes the supervisor, which escalates once */
+    ASSERT_EQ(asx_timer_collect_expired(wheel, 1600, fired, 4), 1u);
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(g_escalations, 1u);
+    ASSERT_EQ(g_last_overdue, (uint64_t)0);
+    ASSERT_EQ(wd.violations, 1u);
+    ASSERT_EQ(asx_auto_audit_count(asx_auto_audit_global()), 1u);
+    ASSERT_EQ(asx_parked_count(), 1u);
+
+    /* The late checkpoint is not counted twice */
+    asx_auto_watchdog_checkpoint(&wd, 2000);
+    ASSERT_EQ(wd.violations, 1u);
+
+    /* Leaving timer mode completes the supervisor */
+    asx_auto_watchdog_disarm_timer(&wd);
+    ASSERT_EQ(asx_timer_active_count(wheel), 0u);
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+}
+
 /* -------------------------------------------------------------------
  * Audit ring tests
  * ------------------------------------------------------------------- */
@@ -313,6 +385,161 @@ TEST(audit_null_safety)
     ASSERT_EQ(asx_auto_audit_total(NULL), 0u);
 }
 
+/* -------------------------------------------------------------------
+ * Audit persistence tests
+ * ------------------------------------------------------------------- */
+
+/* RAM page log; fail_next makes the next append fail */
+static uint8_t  g_log[16u * ASX_AUTO_AUDIT_PAGE_BYTES];
+static uint32_t g_log_len;
+static int      g_fail_next;
+
+static asx_status log_append(void *ctx, const uint8_t *page, uint32_t len)
+{
+    (void)ctx;
+    if (g_fail_next) {
+        g_fail_next = 0;
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    if (g_log_len + len > (uint32_t)sizeof(g_log)) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    memcpy(g_log + g_log_len, page, len);
+    g_log_len += len;
+    return ASX_OK;
+}
+
+static void log_reset(void)
+{
+    memset(g_log, 0xFF, sizeof(g_log));
+    g_log_len = 0;
+    g_fail_next = 0;
+}
+
+TEST(audit_persist_batches_full_pages)
+{
+    asx_auto_audit_ring ring;
+    asx_auto_audit_persist p;
+    uint32_t i;
+
+    log_reset();
+    asx_auto_audit_init(&ring);
+    ASSERT_EQ(asx_auto_audit_persist_init(NULL, &ring, log_append, NULL, 0),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_auto_audit_persist_init(&p, &ring, NULL, NULL, 0),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_auto_audit_persist_init(&p, &ring, log_append, NULL, 0),
+              ASX_OK);
+
+    for (i = 0; i < ASX_AUTO_AUDIT_PAGE_ENTRIES - 1u; i++) {
+        asx_auto_audit_record(&ring, ASX_AUDIT_DEADLINE_MISS, i, i, 0);
+    }
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 0), ASX_OK);
+    ASSERT_EQ(p.pages_written, 0u);    /* partial page held back */
+
+    asx_auto_audit_record(&ring, ASX_AUDIT_CHECKPOINT_OK, 99, 99, 0);
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 0), ASX_OK);
+    ASSERT_EQ(p.pages_written, 1u);
+    ASSERT_EQ(g_log_len, ASX_AUTO_AUDIT_PAGE_BYTES);
+
+    /* sync pushes a partial page out */
+    asx_auto_audit_record(&ring, ASX_AUDIT_DEGRADED_ENTER, 100, 1, 0);
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 1), ASX_OK);
+    ASSERT_EQ(p.pages_written, 2u);
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 1), ASX_OK);
+    ASSERT_EQ(p.pages_written, 2u);    /* nothing new, no write */
+}
+
+TEST(audit_persist_retries_failed_store_and_counts_lost)
+{
+    asx_auto_audit_ring ring;
+    asx_auto_audit_persist p;
+    uint32_t i;
+
+    log_reset();
+    asx_auto_audit_init(&ring);
+    ASSERT_EQ(asx_auto_audit_persist_init(&p, &ring, log_append, NULL, 0),
+              ASX_OK);
+    for (i = 0; i < ASX_AUTO_AUDIT_PAGE_ENTRIES; i++) {
+        asx_auto_audit_record(&ring, ASX_AUDIT_DEADLINE_MISS, i, i, 0);
+    }
+    g_fail_next = 1;
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 0), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(p.store_failures, 1u);
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 0), ASX_OK);
+    ASSERT_EQ(p.pages_written, 1u);
+
+    /* Overrun the ring between flushes */
+    for (i = 0; i < ASX_AUTO_AUDIT_RING_SIZE + 3u; i++) {
+        asx_auto_audit_record(&ring, ASX_AUDIT_DEADLINE_MISS, i, i, 0);
+    }
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 1), ASX_OK);
+    ASSERT_EQ(p.lost, 3u);
+}
+
+TEST(audit_persist_poll_drains_on_stop)
+{
+    asx_auto_audit_ring ring;
+    asx_auto_audit_persist p;
+    asx_task_id self = 0;
+
+    log_reset();
+    asx_auto_audit_init(&ring);
+    ASSERT_EQ(asx_auto_audit_persist_init(&p, &ring, log_append, NULL, 0),
+              ASX_OK);
+    asx_auto_audit_record(&ring, ASX_AUDIT_CANCEL_FORCED, 5, 5, 0);
+    ASSERT_EQ(asx_auto_audit_persist_poll(&p, self), ASX_E_PENDING);
+    ASSERT_EQ(g_log_len, 0u);
+
+    asx_auto_audit_persist_stop(&p);
+    g_fail_next = 1;
+    ASSERT_EQ(asx_auto_audit_persist_poll(&p, self), ASX_E_PENDING);
+    ASSERT_EQ(asx_auto_audit_persist_poll(&p, self), ASX_OK);
+    ASSERT_EQ(g_log_len, ASX_AUTO_AUDIT_PAGE_BYTES);
+}
+
+TEST(audit_recover_restores_and_detects_torn_page)
+{
+    asx_auto_audit_ring ring;
+    asx_auto_audit_ring back;
+    asx_auto_audit_persist p;
+    const asx_audit_entry *e;
+    uint32_t pages = 0;
+    uint32_t i;
+
+    log_reset();
+    asx_auto_audit_init(&ring);
+    ASSERT_EQ(asx_auto_audit_persist_init(&p, &ring, log_append, NULL, 0),
+              ASX_OK);
+    for (i = 0; i < 10u; i++) {
+        asx_auto_audit_record(&ring, ASX_AUDIT_WATCHDOG_VIOLATION,
+                              1000u + i, 7u, -(int64_t)i);
+    }
+    ASSERT_EQ(asx_auto_audit_persist_flush(&p, 1), ASX_OK);
+    ASSERT_EQ(p.pages_written, 2u);
+
+    ASSERT_EQ(asx_auto_audit_recover(g_log, (uint32_t)sizeof(g_log), &back,
+                                     &pages), ASX_OK);
+    ASSERT_EQ(pages, 2u);
+    ASSERT_EQ(asx_auto_audit_count(&back), 10u);
+    ASSERT_EQ(back.next_seq, 10u);
+    e = asx_auto_audit_get(&back, 9);
+    ASSERT_TRUE(e != NULL);
+    ASSERT_EQ(e->seq, 9u);
+    ASSERT_EQ(e->kind, ASX_AUDIT_WATCHDOG_VIOLATION);
+    ASSERT_EQ(e->timestamp_ns, (uint64_t)1009);
+    ASSERT_EQ(e->detail, (int64_t)-9);
+
+    /* A bit flip in the second page: the first page survives */
+    g_log[ASX_AUTO_AUDIT_PAGE_BYTES + ASX_AUTO_AUDIT_PAGE_HEADER] ^= 0x01u;
+    ASSERT_EQ(asx_auto_audit_recover(g_log, g_log_len, &back, &pages),
+              ASX_E_REPLAY_MISMATCH);
+    ASSERT_EQ(pages, 1u);
+    ASSERT_EQ(asx_auto_audit_count(&back), ASX_AUTO_AUDIT_PAGE_ENTRIES);
+    ASSERT_EQ(asx_auto_audit_recover(NULL, 0, &back, &pages),
+              ASX_E_INVALID_ARGUMENT);
+}
+
 /* -------------------------------------------------------------------
  * Compliance gate tests
  * ------------------------------------------------------------------- */
@@ -351,7 +578,7 @@ TEST(compliance_pass_all_within_thresholds)
     asx_auto_watchdog_checkpoint(&wd, 400);
     asx_auto_watchdog_checkpoint(&wd, 500);
 
-    asx_auto_compliance_evaluate(&gate, &dt, &wd, &result);
+    asx_auto_compliance_evaluate(&gate, &dt, NULL, &wd, &result);
     ASSERT_EQ(result.pass, 1);
     ASSERT_EQ(result.violation_mask, 0u);
 }
@@ -378,7 +605,7 @@ TEST(compliance_fail_high_miss_rate)
 
     asx_auto_watchdog_checkpoint(&wd, 100);
 
-    asx_auto_compliance_evaluate(&gate, &dt, &wd, &result);
+    asx_auto_compliance_evaluate(&gate, &dt, NULL, &wd, &result);
     ASSERT_EQ(result.pass, 0);
     ASSERT_TRUE((result.violation_mask & ASX_COMPLIANCE_DEADLINE_RATE) != 0);
 }
@@ -401,7 +628,7 @@ TEST(compliance_fail_watchdog_violations)
     asx_auto_watchdog_checkpoint(&wd, 100);
     asx_auto_watchdog_checkpoint(&wd, 300); /* interval 200 > 100 */
 
-    asx_auto_compliance_evaluate(&gate, &dt, &wd, &result);
+    asx_auto_compliance_evaluate(&gate, &dt, NULL, &wd, &result);
     ASSERT_EQ(result.pass, 0);
     ASSERT_TRUE((result.violation_mask & ASX_COMPLIANCE_WATCHDOG) != 0);
 }
@@ -416,11 +643,81 @@ TEST(compliance_fail_insufficient_checkpoints)
     asx_auto_watchdog_init(&wd, 1000);
 
     /* No checkpoints recorded */
-    asx_auto_compliance_evaluate(&gate, NULL, &wd, &result);
+    asx_auto_compliance_evaluate(&gate, NULL, NULL, &wd, &result);
     ASSERT_EQ(result.pass, 0);
     ASSERT_TRUE((result.violation_mask & ASX_COMPLIANCE_CHECKPOINT_MIN) != 0);
 }
 
+TEST(deadline_window_slides_in_constant_time)
+{
+    asx_auto_deadline_tracker dt;
+    uint32_t i;
+
+    asx_auto_deadline_init(&dt);
+    ASSERT_EQ(asx_auto_deadline_window_miss_rate(&dt), 0u);
+
+    /* 16 misses, then a full window of hits pushes them all out */
+    for (i = 0; i < 16u; i++) asx_auto_deadline_record(&dt, 1000, 2000);
+    ASSERT_EQ(asx_auto_deadline_window_miss_rate(&dt), 10000u);
+    for (i = 0; i < 48u; i++) asx_auto_deadline_record(&dt, 1000, 500);
+    ASSERT_EQ(dt.window_len, ASX_AUTO_DEADLINE_WINDOW);
+    ASSERT_EQ(asx_auto_deadline_window_miss_rate(&dt), 2500u);
+    for (i = 0; i < 16u; i++) asx_auto_deadline_record(&dt, 1000, 500);
+    ASSERT_EQ(dt.window_misses, 0u);
+    ASSERT_EQ(asx_auto_deadline_window_miss_rate(&dt), 0u);
+    /* Cumulative rate still remembers */
+    ASSERT_EQ(asx_auto_deadline_miss_rate(&dt), 2000u);
+}
+
+TEST(compliance_gates_each_class_separately)
+{
+    asx_auto_compliance_gate gate;
+    asx_auto_deadline_tracker all;
+    asx_auto_deadline_table table;
+    asx_auto_watchdog wd;
+    asx_auto_compliance_result result;
+    uint32_t i;
+
+    asx_auto_compliance_gate_init(&gate);
+    asx_auto_deadline_init(&all);
+    asx_auto_deadline_table_init(&table);
+    asx_auto_watchdog_init(&wd, 1000);
+    asx_auto_watchdog_checkpoint(&wd, 100);
+
+    ASSERT_EQ(asx_auto_deadline_table_record(&table, ASX_AUTO_DEADLINE_CLASSES,
+                                             1000, 500),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_auto_deadline_table_set_limit(NULL, 0, 1),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_TRUE(asx_auto_deadline_table_get(&table, ASX_AUTO_DEADLINE_CLASSES) == NULL);
+
+    /* Class 0 always hits, class 3 misses one deadline in ten */
+    for (i = 0; i < 200u; i++) {
+        ASSERT_EQ(asx_auto_deadline_table_record(&table, 0, 1000, 500), ASX_OK);
+        asx_auto_deadline_record(&all, 1000, 500);
+    }
+    for (i = 0; i < 10u; i++) {
+        uint64_t actual = i == 0 ? 2000u : 500u;
+        ASSERT_EQ(asx_auto_deadline_table_record(&table, 3, 1000, actual), ASX_OK);
+        asx_auto_deadline_record(&all, 1000, actual);
+    }
+
+    /* The aggregate passes; the class table does not */
+    asx_auto_compliance_evaluate(&gate, &all, NULL, &wd, &result);
+    ASSERT_EQ(result.pass, 1);
+    asx_auto_compliance_evaluate(&gate, &all, &table, &wd, &result);
+    ASSERT_EQ(result.pass, 0);
+    ASSERT_EQ(result.violation_mask, ASX_COMPLIANCE_CLASS_RATE);
+    ASSERT_EQ(result.failed_classes, 1u << 3);
+    ASSERT_EQ(result.worst_class_miss_rate, 1000u);
+
+    /* A looser limit for class 3 alone clears it */
+    ASSERT_EQ(asx_auto_deadline_table_set_limit(&table, 3, 1000), ASX_OK);
+    asx_auto_compliance_evaluate(&gate, &all, &table, &wd, &result);
+    ASSERT_EQ(result.pass, 1);
+    ASSERT_EQ(result.failed_classes, 0u);
+}
+
 /* -------------------------------------------------------------------
  * Global state tests
  * ------------------------------------------------------------------- */
@@ -470,6 +767,28 @@ TEST(global_record_deadline_auto_logs_miss)
     ASSERT_EQ(e->entity_id, (uint64_t)2);
 }
 
+TEST(global_record_deadline_class_feeds_both)
+{
+    asx_auto_deadline_table *classes;
+    const asx_auto_deadline_tracker *ct;
+
+    asx_auto_instrument_reset();
+    classes = asx_auto_deadline_classes_global();
+    ASSERT_EQ(asx_auto_record_deadline_class(2, 1000, 1200, 7), ASX_OK);
+    ASSERT_EQ(asx_auto_record_deadline_class(ASX_AUTO_DEADLINE_CLASSES,
+                                             1000, 1200, 7),
+              ASX_E_INVALID_ARGUMENT);
+
+    ct = asx_auto_deadline_table_get(classes, 2);
+    ASSERT_TRUE(ct != NULL);
+    ASSERT_EQ(ct->deadline_misses, 1u);
+    ASSERT_EQ(asx_auto_deadline_global()->deadline_misses, 1u);
+    ASSERT_EQ(asx_auto_audit_count(asx_auto_audit_global()), 1u);
+
+    asx_auto_instrument_reset();
+    ASSERT_EQ(asx_auto_deadline_table_get(classes, 2)->total_deadlines, 0u);
+}
+
 TEST(global_record_checkpoint_auto_logs_violation)
 {
     asx_auto_watchdog *wd;
@@ -530,6 +849,10 @@ int main(void)
     RUN_TEST(audit_ring_wraparound);
     RUN_TEST(audit_kind_str);
     RUN_TEST(audit_null_safety);
+    RUN_TEST(audit_persist_batches_full_pages);
+    RUN_TEST(audit_persist_retries_failed_store_and_counts_lost);
+    RUN_TEST(audit_persist_poll_drains_on_stop);
+    RUN_TEST(audit_recover_restores_and_detects_torn_page);
 
     /* Compliance gate */
     RUN_TEST(compliance_gate_default_thresholds);
@@ -537,11 +860,15 @@ int main(void)
     RUN_TEST(compliance_fail_high_miss_rate);
     RUN_TEST(compliance_fail_watchdog_violations);
     RUN_TEST(compliance_fail_insufficient_checkpoints);
+    RUN_TEST(deadline_window_slides_in_constant_time);
+    RUN_TEST(compliance_gates_each_class_separately);
 
     /* Global state */
     RUN_TEST(global_reset_clears_state);
     RUN_TEST(global_record_deadline_auto_logs_miss);
+    RUN_TEST(global_record_deadline_class_feeds_both);
     RUN_TEST(global_record_checkpoint_auto_logs_violation);
+    RUN_TEST(watchdog_timer_escalates_on_expiry_without_polling);
 
     TEST_REPORT();
     test_log_close();
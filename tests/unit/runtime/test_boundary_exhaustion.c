@@ -521,7 +521,7 @@ TEST(capture_arena_independent_per_region)
  * Obligation edge cases at exhaustion
  * ==================================================================== */
 
-TEST(obligation_exhaust_then_commit_no_free_slots)
+TEST(obligation_exhaust_then_commit_frees_slots)
 {
     asx_region_id rid;
     asx_obligation_id oids[ASX_MAX_OBLIGATIONS];
@@ -539,20 +539,29 @@ TEST(obligation_exhaust_then_commit_no_free_slots)
     /* Exhaust */
     ASSERT_EQ(asx_obligation_reserve(rid, &extra), ASX_E_RESOURCE_EXHAUSTED);
 
-    /* Commit all — arena stays full (no recycling in walking skeleton) */
+    /* Commit all: every slot goes back on the free list */
     for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
         ASSERT_EQ(asx_obligation_commit(oids[i]), ASX_OK);
     }
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_OBLIGATION), 0u);
 
-    /* Still exhausted */
-    ASSERT_EQ(asx_obligation_reserve(rid, &extra), ASX_E_RESOURCE_EXHAUSTED);
-
-    /* All obligations in committed state */
+    /* Committed state stays readable until a slot is reused */
     for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
         asx_obligation_state s;
         ASSERT_EQ(asx_obligation_get_state(oids[i], &s), ASX_OK);
         ASSERT_EQ(s, ASX_OBLIGATION_COMMITTED);
     }
+
+    /* The last slot freed is reused first, under a new generation */
+    ASSERT_EQ(asx_obligation_reserve(rid, &extra), ASX_OK);
+    ASSERT_EQ(asx_handle_slot(extra), asx_handle_slot(oids[ASX_MAX_OBLIGATIONS - 1u]));
+    {
+        asx_obligation_state s;
+        ASSERT_EQ(asx_obligation_get_state(oids[ASX_MAX_OBLIGATIONS - 1u], &s),
+                  ASX_E_STALE_HANDLE);
+        ASSERT_EQ(asx_obligation_get_state(extra, &s), ASX_OK);
+        ASSERT_EQ(s, ASX_OBLIGATION_RESERVED);
+    }
 }
 
 TEST(obligation_exhaust_mixed_commit_abort)
@@ -579,9 +588,6 @@ TEST(obligation_exhaust_mixed_commit_abort)
         }
     }
 
-    /* Still exhausted (no slot recycling) */
-    ASSERT_EQ(asx_obligation_reserve(rid, &extra), ASX_E_RESOURCE_EXHAUSTED);
-
     /* Verify final states */
     for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
         asx_obligation_state s;
@@ -592,6 +598,12 @@ TEST(obligation_exhaust_mixed_commit_abort)
             ASSERT_EQ(s, ASX_OBLIGATION_ABORTED);
         }
     }
+
+    /* Aborted slots are recycled as well as committed ones */
+    for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
+        ASSERT_EQ(asx_obligation_reserve(rid, &extra), ASX_OK);
+    }
+    ASSERT_EQ(asx_obligation_reserve(rid, &extra), ASX_E_RESOURCE_EXHAUSTED);
 }
 
 /* ====================================================================
@@ -732,6 +744,167 @@ TEST(scheduler_drains_full_task_arena)
     }
 }
 
+TEST(task_slots_reclaimed_after_outcome_read)
+{
+    asx_region_id rid;
+    asx_task_id tid, first;
+    asx_outcome out;
+    asx_task_state st;
+    uint32_t i;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    /* Far past ASX_MAX_TASKS spawns: each read outcome frees its slot */
+    ASSERT_EQ(asx_task_spawn(rid, poll_ok, NULL, &first), ASX_OK);
+    tid = first;
+    for (i = 0; i < 4u * ASX_MAX_TASKS; i++) {
+        asx_budget budget = asx_budget_from_polls(4);
+        ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+        ASSERT_EQ(asx_task_get_outcome(tid, &out), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_ok, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(asx_handle_slot(tid), asx_handle_slot(first));
+    ASSERT_EQ(asx_task_get_state(first, &st), ASX_E_STALE_HANDLE);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 1u);
+}
+
+TEST(task_slots_reclaimed_when_region_drained)
+{
+    asx_region_id ra, rb;
+    asx_task_id tids[ASX_MAX_TASKS];
+    asx_task_id tid;
+    asx_task_state st;
+    asx_budget budget;
+    uint32_t i;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS; i++) {
+        ASSERT_EQ(asx_task_spawn(ra, poll_ok, NULL, &tids[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_task_spawn(rb, poll_ok, NULL, &tid), ASX_E_RESOURCE_EXHAUSTED);
+
+    /* Completed but unobserved: still held until the region closes */
+    budget = asx_budget_from_polls(ASX_MAX_TASKS * 2);
+    ASSERT_EQ(asx_scheduler_run(ra, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_ok, NULL, &tid), ASX_E_RESOURCE_EXHAUSTED);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(ra, &budget), ASX_OK);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 0u);
+    ASSERT_EQ(asx_task_get_state(tids[0], &st), ASX_OK);
+    ASSERT_EQ(st, ASX_TASK_COMPLETED);
+
+    for (i = 0; i < ASX_MAX_TASKS; i++) {
+        ASSERT_EQ(asx_task_spawn(rb, poll_ok, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(asx_task_get_state(tids[0], &st), ASX_E_STALE_HANDLE);
+}
+
+TEST(spawn_batch_is_all_or_nothing)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_task_id ids[3];
+    asx_task_poll_fn fns[3];
+    uint32_t i;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 3u; i++) fns[i] = poll_ok;
+    for (i = 0; i < ASX_MAX_TASKS - 2u; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_ok, NULL, &tid), ASX_OK);
+    }
+
+    /* Three do not fit in two free slots: nothing is spawned */
+    ASSERT_EQ(asx_task_spawn_batch(rid, 3, fns, NULL, ids),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), ASX_MAX_TASKS - 2u);
+
+    fns[1] = NULL;
+    ASSERT_EQ(asx_task_spawn_batch(rid, 2, fns, NULL, ids), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_spawn_batch(rid, 0, fns, NULL, ids), ASX_E_INVALID_ARGUMENT);
+    fns[1] = poll_ok;
+    ASSERT_EQ(asx_task_spawn_batch(rid, 2, fns, NULL, ids), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_ok, NULL, &tid), ASX_E_RESOURCE_EXHAUSTED);
+}
+
+#if !ASX_HANDLE_EPOCH
+/* Both traces must start from the same handle generations */
+TEST(spawn_batch_trace_matches_individual_spawns)
+{
+    asx_region_id rid;
+    asx_task_id ids[4];
+    asx_task_id tid;
+    asx_task_poll_fn fns[4];
+    void *datas[4];
+    asx_trace_event batch[4];
+    asx_trace_event ev;
+    uint32_t i;
+
+    for (i = 0; i < 4u; i++) {
+        fns[i] = (i % 2u) ? poll_pending : poll_ok;
+        datas[i] = &ids[i];
+    }
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    asx_trace_reset();
+    ASSERT_EQ(asx_task_spawn_batch(rid, 4, fns, datas, ids), ASX_OK);
+    ASSERT_EQ(asx_trace_event_count(), 4u);
+    for (i = 0; i < 4u; i++) {
+        ASSERT_TRUE(asx_trace_event_get(i, &batch[i]));
+    }
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    asx_trace_reset();
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, fns[i], datas[i], &tid), ASX_OK);
+        ASSERT_EQ(tid, ids[i]);
+        ASSERT_TRUE(asx_trace_event_get(i, &ev));
+        ASSERT_EQ(ev.kind, batch[i].kind);
+        ASSERT_EQ(ev.entity_id, batch[i].entity_id);
+        ASSERT_EQ(ev.aux, batch[i].aux);
+    }
+}
+#endif
+
+TEST(spawn_captured_batch_carves_one_contiguous_run)
+{
+    asx_region_id rid;
+    asx_task_id ids[8];
+    asx_task_poll_fn fns[8];
+    void *states[8];
+    uint32_t before, after;
+    uint32_t i;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 8u; i++) fns[i] = poll_ok;
+    ASSERT_EQ(asx_resource_region_capture_remaining(rid, &before), ASX_OK);
+
+    ASSERT_EQ(asx_task_spawn_captured_batch(rid, 8, fns, 20, NULL, ids, states),
+              ASX_OK);
+    ASSERT_EQ(asx_resource_region_capture_remaining(rid, &after), ASX_OK);
+    ASSERT_EQ(before - after, 8u * 24u);
+    for (i = 0; i < 8u; i++) {
+        ASSERT_EQ((uint8_t *)states[i] - (uint8_t *)states[0], (ptrdiff_t)(24u * i));
+        ASSERT_EQ(((uint8_t *)states[i])[19], 0);
+    }
+
+    /* Too big for the arena: no task and no capture bytes taken */
+    ASSERT_EQ(asx_task_spawn_captured_batch(rid, 8, fns, before, NULL, ids, states),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_resource_region_capture_remaining(rid, &before), ASX_OK);
+    ASSERT_EQ(before, after);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 8u);
+    ASSERT_EQ(asx_task_spawn_captured_batch(rid, 8, fns, 0, NULL, ids, states),
+              ASX_E_INVALID_ARGUMENT);
+}
+
 TEST(scheduler_partial_drain_budget_boundary)
 {
     asx_region_id rid;
@@ -863,7 +1036,7 @@ int main(void)
     RUN_TEST(capture_arena_independent_per_region);
 
     /* Obligation edge cases */
-    RUN_TEST(obligation_exhaust_then_commit_no_free_slots);
+    RUN_TEST(obligation_exhaust_then_commit_frees_slots);
     RUN_TEST(obligation_exhaust_mixed_commit_abort);
 
     /* Determinism */
@@ -874,6 +1047,13 @@ int main(void)
 
     /* Scheduler with exhaustion */
     RUN_TEST(scheduler_drains_full_task_arena);
+    RUN_TEST(task_slots_reclaimed_after_outcome_read);
+    RUN_TEST(task_slots_reclaimed_when_region_drained);
+    RUN_TEST(spawn_batch_is_all_or_nothing);
+#if !ASX_HANDLE_EPOCH
+    RUN_TEST(spawn_batch_trace_matches_individual_spawns);
+#endif
+    RUN_TEST(spawn_captured_batch_carves_one_contiguous_run);
     RUN_TEST(scheduler_partial_drain_budget_boundary);
 
     /* No corruption after failures */
@@ -0,0 +1,235 @@
+/*
+ * test_buffer_pool.c — unit tests for refcounted I/O buffer pools
+ *
+ * Tests: argument checks and size rounding, exhaustion and LIFO reuse,
+ * released handles going stale, retained buffers surviving until the
+ * last release, length bounds, snapshots and destroy refusing while a
+ * buffer is held, a handle passed through a channel and read in place
+ * by the receiver, and on POSIX (where io_uring is available) a fixed
+ * read from a pipe into a registered pool.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifdef ASX_PROFILE_POSIX
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/buffer_pool.h>
+#include <string.h>
+
+static void pool_test_reset(void)
+{
+    asx_runtime_hooks hooks;
+
+    asx_runtime_reset();
+    (void)asx_runtime_hooks_init(&hooks);
+    (void)asx_runtime_set_hooks(&hooks);
+}
+
+TEST(buffer_pool_checks_arguments) {
+    asx_buffer_pool pool;
+    uint64_t h;
+    uint8_t *data = NULL;
+
+    pool_test_reset();
+    ASSERT_EQ(asx_buffer_pool_init(NULL, 64, 4), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 0, 4), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 64, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 1u << 20, 2048), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(h, ASX_BUFFER_NONE);
+
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 100, 4), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_buffer_release(&pool, ASX_BUFFER_NONE), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_buffer_retain(&pool, 99u), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, h, &data, NULL), ASX_OK);
+    ASSERT_EQ(((uintptr_t)data) % ASX_BUFFER_ALIGN, 0u);
+    /* 100 rounds up to 128: the whole rounded size is usable */
+    ASSERT_EQ(asx_buffer_set_len(&pool, h, 128), ASX_OK);
+    ASSERT_EQ(asx_buffer_set_len(&pool, h, 129), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_buffer_release(&pool, h), ASX_OK);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+}
+
+TEST(buffer_pool_exhausts_and_reuses_lifo) {
+    asx_buffer_pool pool;
+    asx_resource_snapshot snap;
+    uint64_t h[3];
+    uint64_t again;
+    uint8_t *a = NULL;
+    uint8_t *b = NULL;
+
+    pool_test_reset();
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 64, 3), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h[0]), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h[1]), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h[2]), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &again), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_buffer_pool_snapshot(&pool, &snap), ASX_OK);
+    ASSERT_EQ(snap.kind, ASX_RESOURCE_ALLOCATOR);
+    ASSERT_EQ(snap.capacity, 3u);
+    ASSERT_EQ(snap.used, 3u);
+    ASSERT_EQ(snap.remaining, 0u);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_E_INVALID_STATE);
+
+    /* The buffer just released comes back first, under a new handle */
+    ASSERT_EQ(asx_buffer_get(&pool, h[1], &a, NULL), ASX_OK);
+    ASSERT_EQ(asx_buffer_set_len(&pool, h[1], 10), ASX_OK);
+    ASSERT_EQ(asx_buffer_release(&pool, h[1]), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, h[1], NULL, NULL), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_buffer_release(&pool, h[1]), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &again), ASX_OK);
+    ASSERT_TRUE(again != h[1]);
+    ASSERT_EQ(asx_buffer_get(&pool, again, &b, NULL), ASX_OK);
+    ASSERT_TRUE(a == b);
+    ASSERT_EQ(asx_buffer_release(&pool, h[1]), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_buffer_release(&pool, again), ASX_OK);
+    ASSERT_EQ(asx_buffer_release(&pool, h[0]), ASX_OK);
+    ASSERT_EQ(asx_buffer_release(&pool, h[2]), ASX_OK);
+    ASSERT_EQ(asx_buffer_pool_snapshot(&pool, &snap), ASX_OK);
+    ASSERT_EQ(snap.used, 0u);
+    ASSERT_EQ(snap.remaining, 3u);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+}
+
+TEST(buffer_pool_retain_defers_return) {
+    asx_buffer_pool pool;
+    uint64_t h;
+    uint64_t other;
+    uint32_t len = 0;
+
+    pool_test_reset();
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 64, 1), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h), ASX_OK);
+    ASSERT_EQ(asx_buffer_set_len(&pool, h, 7), ASX_OK);
+    ASSERT_EQ(asx_buffer_retain(&pool, h), ASX_OK);
+    ASSERT_EQ(asx_buffer_retain(&pool, h), ASX_OK);
+
+    ASSERT_EQ(asx_buffer_release(&pool, h), ASX_OK);
+    ASSERT_EQ(asx_buffer_release(&pool, h), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, h, NULL, &len), ASX_OK);
+    ASSERT_EQ(len, 7u);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &other), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_buffer_release(&pool, h), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, h, NULL, &len), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &other), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, other, NULL, &len), ASX_OK);
+    ASSERT_EQ(len, 0u);
+    ASSERT_EQ(asx_buffer_release(&pool, other), ASX_OK);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+}
+
+TEST(buffer_pool_handle_through_channel) {
+    asx_buffer_pool pool;
+    asx_region_id rid;
+    asx_channel_id ch;
+    asx_send_permit permit;
+    uint64_t h;
+    uint64_t got = ASX_BUFFER_NONE;
+    uint8_t *data = NULL;
+    uint8_t *seen = NULL;
+    uint32_t len = 0;
+
+    pool_test_reset();
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 256, 2), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ch), ASX_OK);
+
+    /* Producer fills a buffer and sends only its handle */
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, h, &data, NULL), ASX_OK);
+    memcpy(data, "payload", 7);
+    ASSERT_EQ(asx_buffer_set_len(&pool, h, 7), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &permit), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&permit, h), ASX_OK);
+
+    /* Consumer reads the same bytes in place and owns the release */
+    ASSERT_EQ(asx_channel_try_recv(ch, &got), ASX_OK);
+    ASSERT_EQ(got, h);
+    ASSERT_EQ(asx_buffer_get(&pool, got, &seen, &len), ASX_OK);
+    ASSERT_TRUE(seen == data);
+    ASSERT_EQ(len, 7u);
+    ASSERT_TRUE(memcmp(seen, "payload", 7) == 0);
+    ASSERT_EQ(asx_buffer_release(&pool, got), ASX_OK);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+    asx_runtime_reset();
+}
+
+#ifdef ASX_PROFILE_POSIX
+#include <unistd.h>
+
+TEST(buffer_pool_uring_read_fixed) {
+    static asx_platform_uring ring;
+    asx_buffer_pool pool;
+    asx_platform_uring_op op;
+    uint64_t h;
+    uint8_t *data = NULL;
+    uint32_t ready;
+    uint32_t i;
+    int fds[2];
+
+    pool_test_reset();
+    if (asx_platform_uring_open(&ring, 8) != ASX_OK) {
+        return; /* io_uring unavailable on this host */
+    }
+    ASSERT_EQ(asx_buffer_pool_init(&pool, 64, 4), ASX_OK);
+    ASSERT_EQ(asx_buffer_acquire(&pool, &h), ASX_OK);
+    ASSERT_EQ(asx_platform_uring_read_fixed(&ring, &op, ASX_INVALID_ID, 0,
+                                            &pool, h, 0),
+              ASX_E_INVALID_STATE);
+    if (asx_platform_uring_register_pool(&ring, &pool) != ASX_OK) {
+        ASSERT_EQ(asx_buffer_release(&pool, h), ASX_OK);
+        ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+        asx_platform_uring_close(&ring);
+        return; /* locked-memory limit too low to pin the pool */
+    }
+    ASSERT_EQ(asx_platform_uring_register_pool(&ring, &pool), ASX_E_ALREADY_EXISTS);
+
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "fixed", 5), (ssize_t)5);
+    memset(&op, 0, sizeof(op));
+    ASSERT_EQ(asx_platform_uring_read_fixed(&ring, &op, ASX_INVALID_ID, fds[0],
+                                            &pool, h, UINT64_MAX),
+              ASX_OK);
+    for (i = 0; i < 100u && !op.done; i++) {
+        ASSERT_EQ(asx_platform_uring_wait(&ring, 1000, &ready), ASX_OK);
+    }
+    ASSERT_EQ(op.done, 1u);
+    ASSERT_EQ(op.result, 5);
+    ASSERT_EQ(asx_buffer_set_len(&pool, h, (uint32_t)op.result), ASX_OK);
+    ASSERT_EQ(asx_buffer_get(&pool, h, &data, NULL), ASX_OK);
+    ASSERT_TRUE(memcmp(data, "fixed", 5) == 0);
+
+    /* A released handle is refused before anything is queued */
+    ASSERT_EQ(asx_buffer_release(&pool, h), ASX_OK);
+    ASSERT_EQ(asx_platform_uring_read_fixed(&ring, &op, ASX_INVALID_ID, fds[0],
+                                            &pool, h, UINT64_MAX),
+              ASX_E_INVALID_STATE);
+    (void)close(fds[0]);
+    (void)close(fds[1]);
+    asx_platform_uring_close(&ring);
+    ASSERT_EQ(asx_buffer_pool_destroy(&pool), ASX_OK);
+    asx_runtime_reset();
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "=== test_buffer_pool ===\n");
+    RUN_TEST(buffer_pool_checks_arguments);
+    RUN_TEST(buffer_pool_exhausts_and_reuses_lifo);
+    RUN_TEST(buffer_pool_retain_defers_return);
+    RUN_TEST(buffer_pool_handle_through_channel);
+#ifdef ASX_PROFILE_POSIX
+    RUN_TEST(buffer_pool_uring_read_fixed);
+#endif
+    TEST_REPORT();
+    return test_failures;
+}
@@ -2,7 +2,8 @@
  * test_cancellation.c — runtime-level cancellation tests (bd-2cw.3)
  *
  * Tests cancellation propagation, checkpoint protocol, cleanup budget
- * enforcement, cancel strengthening at runtime, and region-wide cancel.
+ * enforcement, cancel strengthening at runtime, region-wide cancel, and
+ * oldest-first shedding.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -12,6 +13,8 @@
 #include <asx/runtime/runtime.h>
 #include <asx/core/cancel.h>
 #include <asx/core/ghost.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/hft_instrument.h>
 
 /* Suppress warn_unused_result for intentionally-ignored scheduler calls.
  * GCC's (void) cast does not silence warn_unused_result under -Werror. */
@@ -303,7 +306,7 @@ TEST(cancel_propagation_cancels_all_tasks_in_region) {
 
 TEST(cancel_propagation_skips_completed_tasks) {
     asx_region_id rid;
-    asx_task_id tid1, tid2;
+    asx_task_id tid1, tid2, extra;
     asx_task_state s1, s2;
     uint32_t count;
     asx_budget budget;
@@ -313,14 +316,18 @@ TEST(cancel_propagation_skips_completed_tasks) {
     ASSERT_EQ(asx_region_open(&rid), ASX_OK);
     ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid1), ASX_OK);
     ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &tid2), ASX_OK);
+    /* Completions at the middle and tail of the live list as well */
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &extra), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &extra), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &extra), ASX_OK);
 
     /* Run scheduler — tid1 completes, tid2 remains pending */
     budget = asx_budget_from_polls(10);
     SCHED_RUN_IGNORE(rid, &budget);
 
-    /* Propagate cancel — should only affect tid2 */
+    /* Propagate cancel — should only affect the pending tasks */
     count = asx_cancel_propagate(rid, ASX_CANCEL_SHUTDOWN);
-    ASSERT_EQ(count, (uint32_t)1);
+    ASSERT_EQ(count, (uint32_t)2);
 
     ASSERT_EQ(asx_task_get_state(tid1, &s1), ASX_OK);
     ASSERT_EQ((int)s1, (int)ASX_TASK_COMPLETED);
@@ -517,6 +524,8 @@ TEST(scheduler_decrements_cleanup_budget) {
 TEST(cancel_with_origin_sets_attribution) {
     asx_region_id rid;
     asx_task_id tid1, tid2;
+    asx_region_id origin_region;
+    asx_task_id origin_task;
     asx_budget budget;
 
     asx_runtime_reset();
@@ -530,6 +539,46 @@ TEST(cancel_with_origin_sets_attribution) {
 
     /* Cancel tid2 with origin from tid1 */
     ASSERT_EQ(asx_task_cancel_with_origin(tid2, ASX_CANCEL_LINKED_EXIT, rid, tid1), ASX_OK);
+    ASSERT_EQ(asx_task_get_cancel_origin(tid2, &origin_region, &origin_task), ASX_OK);
+    ASSERT_EQ(origin_region, rid);
+    ASSERT_EQ(origin_task, tid1);
+
+    /* tid1 was never cancelled: no attribution */
+    ASSERT_EQ(asx_task_get_cancel_origin(tid1, &origin_region, &origin_task), ASX_OK);
+    ASSERT_EQ(origin_region, ASX_INVALID_ID);
+    ASSERT_EQ(origin_task, ASX_INVALID_ID);
+}
+
+/* -------------------------------------------------------------------
+ * Test: plain cancel records no origin; NULL outputs rejected
+ * ------------------------------------------------------------------- */
+
+TEST(cancel_origin_absent_for_plain_cancel) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_region_id origin_region;
+    asx_task_id origin_task;
+    asx_budget budget;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(1);
+    SCHED_RUN_IGNORE(rid, &budget);
+
+    ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(asx_task_get_cancel_origin(tid, &origin_region, &origin_task), ASX_OK);
+    ASSERT_EQ(origin_region, ASX_INVALID_ID);
+    ASSERT_EQ(origin_task, ASX_INVALID_ID);
+
+    ASSERT_EQ(asx_task_get_cancel_origin(tid, NULL, &origin_task),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_get_cancel_origin(tid, &origin_region, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_get_cancel_origin(ASX_INVALID_ID, &origin_region,
+                                         &origin_task), ASX_E_NOT_FOUND);
 }
 
 /* -------------------------------------------------------------------
@@ -586,6 +635,8 @@ TEST(cancel_propagation_sets_origin_region) {
     asx_region_id rid;
     asx_task_id tid;
     asx_task_state state;
+    asx_region_id origin_region;
+    asx_task_id origin_task;
     asx_budget budget;
     uint32_t count;
 
@@ -604,6 +655,84 @@ TEST(cancel_propagation_sets_origin_region) {
     /* The task should now be CancelRequested */
     ASSERT_EQ(asx_task_get_state(tid, &state), ASX_OK);
     ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_task_get_cancel_origin(tid, &origin_region, &origin_task), ASX_OK);
+    ASSERT_EQ(origin_region, rid);
+    ASSERT_EQ(origin_task, ASX_INVALID_ID);
+}
+
+/* -------------------------------------------------------------------
+ * Test: shedding cancels the oldest uncancelled tasks first
+ * ------------------------------------------------------------------- */
+
+TEST(region_shed_oldest_cancels_in_spawn_order) {
+    asx_region_id rid;
+    asx_task_id tids[4];
+    asx_task_state state;
+    asx_budget budget;
+    uint32_t k;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (k = 0; k < 4; k++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &tids[k]), ASX_OK);
+    }
+    budget = asx_budget_from_polls(4);
+    SCHED_RUN_IGNORE(rid, &budget);
+
+    /* Already cancelled: skipped, not counted */
+    ASSERT_EQ(asx_task_cancel(tids[0], ASX_CANCEL_USER), ASX_OK);
+
+    ASSERT_EQ(asx_region_shed_oldest(rid, 2), (uint32_t)2);
+    for (k = 1; k < 3; k++) {
+        ASSERT_EQ(asx_task_get_state(tids[k], &state), ASX_OK);
+        ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+    }
+    ASSERT_EQ(asx_task_get_state(tids[3], &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_RUNNING);
+
+    /* More than remain: only the one left */
+    ASSERT_EQ(asx_region_shed_oldest(rid, 10), (uint32_t)1);
+    ASSERT_EQ(asx_task_get_state(tids[3], &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_region_shed_oldest(rid, 10), (uint32_t)0);
+    ASSERT_EQ(asx_region_shed_oldest(rid, 0), (uint32_t)0);
+    ASSERT_EQ(asx_region_shed_oldest(ASX_INVALID_ID, 1), (uint32_t)0);
+}
+
+/* -------------------------------------------------------------------
+ * Test: overload decisions shed only when they call for it
+ * ------------------------------------------------------------------- */
+
+TEST(overload_shed_applies_shed_oldest_decision) {
+    asx_region_id rid;
+    asx_task_id tid1, tid2;
+    asx_task_state state;
+    asx_overload_policy pol;
+    asx_overload_decision dec;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &tid1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &tid2), ASX_OK);
+
+    asx_overload_policy_init(&pol);
+    asx_overload_evaluate(&pol, 95, 100, &dec);
+    ASSERT_EQ(asx_overload_shed(rid, &dec), (uint32_t)0);   /* REJECT */
+
+    pol.mode = ASX_OVERLOAD_SHED_OLDEST;
+    pol.shed_max = 1;
+    asx_overload_evaluate(&pol, 10, 100, &dec);
+    ASSERT_EQ(asx_overload_shed(rid, &dec), (uint32_t)0);   /* below */
+    ASSERT_EQ(asx_overload_shed(rid, NULL), (uint32_t)0);
+
+    asx_overload_evaluate(&pol, 95, 100, &dec);
+    ASSERT_EQ(asx_overload_shed(rid, &dec), (uint32_t)1);
+    ASSERT_EQ(asx_task_get_state(tid1, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_task_get_state(tid2, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CREATED);
 }
 
 /* -------------------------------------------------------------------
@@ -632,6 +761,116 @@ TEST(scheduler_quiesces_after_cancel_completion) {
     ASSERT_EQ(result, ASX_OK); /* ASX_OK means quiescent */
 }
 
+/* -------------------------------------------------------------------
+ * Region trees: session -> {request1 -> {sub1}, request2}
+ * ------------------------------------------------------------------- */
+
+static asx_status open_child(asx_region_id parent, asx_region_id *out)
+{
+    asx_region_options opts;
+
+    asx_region_options_init(&opts);
+    opts.parent = parent;
+    return asx_region_open_with(&opts, out);
+}
+
+static void open_session_tree(asx_region_id *session, asx_region_id *req1,
+                              asx_region_id *sub1, asx_region_id *req2)
+{
+    ASSERT_EQ(asx_region_open(session), ASX_OK);
+    ASSERT_EQ(open_child(*session, req1), ASX_OK);
+    ASSERT_EQ(open_child(*req1, sub1), ASX_OK);
+    ASSERT_EQ(open_child(*session, req2), ASX_OK);
+}
+
+TEST(region_tree_cancel_covers_subtree_only) {
+    asx_region_id session, req1, sub1, req2;
+    asx_task_id t_session, t_req1, t_sub1, t_req2;
+    asx_task_state state;
+
+    asx_runtime_reset();
+    open_session_tree(&session, &req1, &sub1, &req2);
+    ASSERT_EQ(asx_task_spawn(session, poll_pending, NULL, &t_session), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(req1, poll_pending, NULL, &t_req1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(sub1, poll_pending, NULL, &t_sub1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(req2, poll_pending, NULL, &t_req2), ASX_OK);
+
+    /* Down the subtree, never up or sideways */
+    ASSERT_EQ(asx_cancel_propagate(req1, ASX_CANCEL_USER), (uint32_t)2);
+    ASSERT_EQ(asx_task_get_state(t_sub1, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_task_get_state(t_session, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CREATED);
+    ASSERT_EQ(asx_task_get_state(t_req2, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CREATED);
+
+    ASSERT_EQ(asx_cancel_propagate(session, ASX_CANCEL_PARENT), (uint32_t)4);
+    ASSERT_EQ(asx_task_get_state(t_req2, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_TASK_CANCEL_REQUESTED);
+}
+
+TEST(region_tree_close_cascades_in_preorder) {
+    asx_region_id session, req1, sub1, req2, late;
+    asx_region_id expect[4];
+    asx_trace_event ev;
+    asx_region_state state;
+    uint32_t i, n = 0;
+
+    asx_runtime_reset();
+    open_session_tree(&session, &req1, &sub1, &req2);
+    expect[0] = session; expect[1] = req1; expect[2] = sub1; expect[3] = req2;
+
+    asx_trace_reset();
+    ASSERT_EQ(asx_region_close(session), ASX_OK);
+    for (i = 0; i < asx_trace_event_count(); i++) {
+        ASSERT_TRUE(asx_trace_event_get(i, &ev));
+        if (ev.kind != ASX_TRACE_REGION_CLOSE) continue;
+        ASSERT_TRUE(n < 4u);
+        ASSERT_EQ(asx_handle_slot(ev.entity_id), asx_handle_slot(expect[n]));
+        n++;
+    }
+    ASSERT_EQ(n, (uint32_t)4);
+    ASSERT_EQ(asx_region_get_state(sub1, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_REGION_CLOSING);
+
+    /* A closing parent admits no children */
+    ASSERT_EQ(open_child(req2, &late), ASX_E_REGION_NOT_OPEN);
+    ASSERT_EQ(open_child(ASX_INVALID_ID + 1u, &late), ASX_E_NOT_FOUND);
+}
+
+TEST(region_tree_drain_finishes_children_first) {
+    asx_region_id session, req1, sub1, req2, reused;
+    asx_task_id tid;
+    asx_region_state state;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    open_session_tree(&session, &req1, &sub1, &req2);
+    ASSERT_EQ(asx_task_spawn(session, poll_checkpoint_then_complete, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(sub1, poll_checkpoint_forever, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(req2, poll_checkpoint_then_complete, NULL, &tid), ASX_OK);
+
+    /* Out of budget inside sub1: the rest of the tree waits */
+    budget = asx_budget_from_polls(1);
+    ASSERT_NE(asx_region_drain(session, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_get_state(req2, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_REGION_CLOSING);
+    ASSERT_EQ(asx_region_get_state(session, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_REGION_CLOSING);
+
+    /* Resuming reaches CLOSED everywhere */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(session, &budget), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(session), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(req1), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(sub1), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(req2), ASX_OK);
+
+    /* Closed children left the tree: their slots open as roots */
+    ASSERT_EQ(asx_region_open(&reused), ASX_OK);
+    ASSERT_EQ(asx_region_drain(reused, &budget), ASX_OK);
+}
+
 /* -------------------------------------------------------------------
  * Test: cleanup budget varies by cancel kind
  * ------------------------------------------------------------------- */
@@ -706,9 +945,15 @@ int main(void) {
     RUN_TEST(cancel_phase_query_tracks_progression);
     RUN_TEST(scheduler_decrements_cleanup_budget);
     RUN_TEST(cancel_with_origin_sets_attribution);
+    RUN_TEST(cancel_origin_absent_for_plain_cancel);
     RUN_TEST(cancel_storm_all_tasks_resolve);
     RUN_TEST(cancel_propagation_sets_origin_region);
+    RUN_TEST(region_shed_oldest_cancels_in_spawn_order);
+    RUN_TEST(overload_shed_applies_shed_oldest_decision);
     RUN_TEST(scheduler_quiesces_after_cancel_completion);
+    RUN_TEST(region_tree_cancel_covers_subtree_only);
+    RUN_TEST(region_tree_close_cascades_in_preorder);
+    RUN_TEST(region_tree_drain_finishes_children_first);
     RUN_TEST(cleanup_budget_tighter_for_severe_cancels);
     RUN_TEST(checkpoint_null_result_rejected);
     RUN_TEST(cancel_phase_null_output_rejected);
@@ -10,6 +10,8 @@
 
 #include "../../test_harness.h"
 #include <asx/asx.h>
+#include <asx/runtime/parallel.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -425,6 +427,267 @@ TEST(equiv_digest_identity_across_codecs) {
     asx_canonical_fixture_reset(&fixture);
 }
 
+/* ---- Semantic hash and index ---- */
+
+TEST(equiv_semantic_hash_tracks_semantic_eq) {
+    asx_canonical_fixture a;
+    asx_canonical_fixture b;
+    uint64_t ha, hb;
+
+    asx_canonical_fixture_init(&a);
+    asx_canonical_fixture_init(&b);
+    populate_fixture(&a, "scenario.equiv.hash.001");
+    populate_fixture(&b, "scenario.equiv.hash.001");
+
+    /* Codec is not semantic */
+    b.codec = ASX_CODEC_KIND_BIN;
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(&a, &ha), ASX_OK);
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(&b, &hb), ASX_OK);
+    ASSERT_EQ(ha, hb);
+
+    /* Field boundaries count: moving a byte between fields changes it */
+    free(b.provenance.rust_toolchain_release);
+    free(b.provenance.rust_toolchain_host);
+    b.provenance.rust_toolchain_release = dup_text("rustc 1.90.");
+    b.provenance.rust_toolchain_host = dup_text("0x86_64-unknown-linux-gnu");
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(&b, &hb), ASX_OK);
+    ASSERT_NE(ha, hb);
+
+    /* NULL and empty differ */
+    free(b.provenance.rust_toolchain_release);
+    free(b.provenance.rust_toolchain_host);
+    b.provenance.rust_toolchain_release = dup_text("rustc 1.90.0");
+    b.provenance.rust_toolchain_host = dup_text("x86_64-unknown-linux-gnu");
+    free(b.provenance.capture_run_id);
+    b.provenance.capture_run_id = NULL;
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(&b, &ha), ASX_OK);
+    b.provenance.capture_run_id = dup_text("");
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(&b, &hb), ASX_OK);
+    ASSERT_NE(ha, hb);
+
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(NULL, &ha), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_fixture_semantic_hash(&a, NULL), ASX_E_INVALID_ARGUMENT);
+
+    asx_canonical_fixture_reset(&b);
+    asx_canonical_fixture_reset(&a);
+}
+
+TEST(equiv_semantic_index_dedupes_in_one_pass) {
+    static const char *ids[] = {
+        "scenario.dedupe.a", "scenario.dedupe.b", "scenario.dedupe.a",
+        "scenario.dedupe.c", "scenario.dedupe.b", "scenario.dedupe.a"
+    };
+    enum { N = sizeof(ids) / sizeof(ids[0]) };
+    asx_canonical_fixture corpus[N];
+    asx_codec_semantic_slot slots[8];
+    asx_codec_semantic_index index;
+    const asx_canonical_fixture *first;
+    uint32_t unique = 0;
+    uint32_t i;
+
+    for (i = 0; i < N; i++) {
+        asx_canonical_fixture_init(&corpus[i]);
+        populate_fixture(&corpus[i], ids[i]);
+    }
+    ASSERT_EQ(asx_codec_semantic_index_init(&index, slots, 8u), ASX_OK);
+
+    for (i = 0; i < N; i++) {
+        asx_status st = asx_codec_semantic_index_insert(&index, &corpus[i], &first);
+        if (st == ASX_OK) {
+            unique++;
+        } else {
+            ASSERT_EQ(st, ASX_E_ALREADY_EXISTS);
+            ASSERT_STR_EQ(first->scenario_id, ids[i]);
+            ASSERT_TRUE(first < &corpus[i]);
+        }
+    }
+    ASSERT_EQ(unique, (uint32_t)3);
+
+    /* A cross-codec copy finds its source; a changed seed does not */
+    corpus[3].codec = ASX_CODEC_KIND_BIN;
+    ASSERT_EQ(asx_codec_semantic_index_find(&index, &corpus[3], &first), ASX_OK);
+    ASSERT_TRUE(first == &corpus[3]);
+    corpus[5].seed++;
+    ASSERT_EQ(asx_codec_semantic_index_find(&index, &corpus[5], NULL), ASX_E_NOT_FOUND);
+
+    for (i = 0; i < N; i++) asx_canonical_fixture_reset(&corpus[i]);
+}
+
+TEST(equiv_semantic_index_caps_load_and_checks_args) {
+    asx_canonical_fixture fixtures[4];
+    asx_codec_semantic_slot slots[4];
+    asx_codec_semantic_index index;
+    char id[32];
+    uint32_t i;
+
+    ASSERT_EQ(asx_codec_semantic_index_init(&index, slots, 6u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_semantic_index_init(&index, slots, 2u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_semantic_index_init(NULL, slots, 4u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_semantic_index_init(&index, slots, 4u), ASX_OK);
+
+    for (i = 0; i < 4u; i++) {
+        asx_canonical_fixture_init(&fixtures[i]);
+        (void)snprintf(id, sizeof(id), "scenario.load.%u", (unsigned)i);
+        populate_fixture(&fixtures[i], id);
+    }
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_codec_semantic_index_insert(&index, &fixtures[i], NULL), ASX_OK);
+    }
+    ASSERT_EQ(asx_codec_semantic_index_insert(&index, &fixtures[3], NULL),
+              ASX_E_RESOURCE_EXHAUSTED);
+
+    /* Misses still terminate on the reserved empty slot */
+    ASSERT_EQ(asx_codec_semantic_index_find(&index, &fixtures[3], NULL), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_codec_semantic_index_find(&index, &fixtures[2], NULL), ASX_OK);
+
+    for (i = 0; i < 4u; i++) asx_canonical_fixture_reset(&fixtures[i]);
+}
+
+/* ---- Batch encode/decode and verification ---- */
+
+#define BATCH_N 6u
+
+static void populate_batch(asx_canonical_fixture *fixtures, uint32_t n)
+{
+    char id[32];
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        asx_canonical_fixture_init(&fixtures[i]);
+        (void)snprintf(id, sizeof(id), "scenario.batch.%03u", (unsigned)i);
+        populate_fixture(&fixtures[i], id);
+        fixtures[i].seed = (uint64_t)(i * 7u + 1u);
+    }
+}
+
+static void reset_batch(asx_canonical_fixture *fixtures, uint32_t n)
+{
+    uint32_t i;
+    for (i = 0; i < n; i++) asx_canonical_fixture_reset(&fixtures[i]);
+}
+
+TEST(equiv_batch_encode_matches_single_encodes) {
+    static const asx_codec_kind kinds[2] = {ASX_CODEC_KIND_JSON, ASX_CODEC_KIND_BIN};
+    asx_canonical_fixture fixtures[BATCH_N];
+    asx_canonical_fixture decoded[BATCH_N];
+    asx_codec_buffer batch;
+    asx_codec_buffer single;
+    size_t offsets[BATCH_N + 1u];
+    uint32_t k, i;
+
+    populate_batch(fixtures, BATCH_N);
+    for (i = 0; i < BATCH_N; i++) asx_canonical_fixture_init(&decoded[i]);
+    asx_codec_buffer_init(&batch);
+    asx_codec_buffer_init(&single);
+
+    for (k = 0; k < 2u; k++) {
+        ASSERT_EQ(asx_codec_encode_fixtures(kinds[k], fixtures, BATCH_N,
+                                            &batch, offsets), ASX_OK);
+        ASSERT_EQ(offsets[0], (size_t)0);
+        ASSERT_EQ(offsets[BATCH_N], batch.len);
+
+        /* Each slot holds exactly the standalone payload */
+        for (i = 0; i < BATCH_N; i++) {
+            ASSERT_EQ(asx_codec_encode_fixture(kinds[k], &fixtures[i], &single), ASX_OK);
+            ASSERT_EQ(offsets[i + 1u] - offsets[i], single.len);
+            ASSERT_EQ(memcmp(batch.data + offsets[i], single.data, single.len), 0);
+        }
+
+        /* Decoding into populated fixtures replaces their contents */
+        ASSERT_EQ(asx_codec_decode_fixtures(kinds[k], batch.data, offsets,
+                                            BATCH_N, decoded), ASX_OK);
+        for (i = 0; i < BATCH_N; i++) {
+            ASSERT_EQ(asx_codec_fixture_semantic_eq(&fixtures[i], &decoded[i], NULL),
+                      ASX_OK);
+        }
+    }
+
+    asx_codec_buffer_reset(&single);
+    asx_codec_buffer_reset(&batch);
+    reset_batch(decoded, BATCH_N);
+    reset_batch(fixtures, BATCH_N);
+}
+
+TEST(equiv_batch_codec_is_all_or_nothing) {
+    asx_canonical_fixture fixtures[3];
+    asx_canonical_fixture decoded[3];
+    asx_codec_buffer batch;
+    size_t offsets[4];
+    uint32_t i;
+
+    populate_batch(fixtures, 3u);
+    for (i = 0; i < 3u; i++) asx_canonical_fixture_init(&decoded[i]);
+    asx_codec_buffer_init(&batch);
+
+    /* An invalid fixture mid-batch leaves the output empty */
+    free(fixtures[1].scenario_id);
+    fixtures[1].scenario_id = NULL;
+    ASSERT_NE(asx_codec_encode_fixtures(ASX_CODEC_KIND_BIN, fixtures, 3u,
+                                        &batch, offsets), ASX_OK);
+    ASSERT_EQ(batch.len, (size_t)0);
+    fixtures[1].scenario_id = dup_text("scenario.batch.001");
+
+    /* A corrupted last frame resets the fixtures decoded before it */
+    ASSERT_EQ(asx_codec_encode_fixtures(ASX_CODEC_KIND_BIN, fixtures, 3u,
+                                        &batch, offsets), ASX_OK);
+    batch.data[offsets[3] - 1u] ^= 0x01;
+    ASSERT_NE(asx_codec_decode_fixtures(ASX_CODEC_KIND_BIN, batch.data, offsets,
+                                        3u, decoded), ASX_OK);
+    ASSERT_TRUE(decoded[0].scenario_id == NULL);
+
+    /* Empty JSON slots and descending offsets are rejected */
+    ASSERT_EQ(asx_codec_encode_fixtures(ASX_CODEC_KIND_JSON, fixtures, 3u,
+                                        &batch, offsets), ASX_OK);
+    offsets[1] = offsets[0];
+    ASSERT_EQ(asx_codec_decode_fixtures(ASX_CODEC_KIND_JSON, batch.data, offsets,
+                                        3u, decoded), ASX_E_INVALID_ARGUMENT);
+    offsets[1] = offsets[2] + 1u;
+    ASSERT_EQ(asx_codec_decode_fixtures(ASX_CODEC_KIND_JSON, batch.data, offsets,
+                                        3u, decoded), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_encode_fixtures(ASX_CODEC_KIND_JSON, NULL, 1u,
+                                        &batch, offsets), ASX_E_INVALID_ARGUMENT);
+
+    asx_codec_buffer_reset(&batch);
+    reset_batch(decoded, 3u);
+    reset_batch(fixtures, 3u);
+}
+
+TEST(equiv_batch_verify_is_worker_count_independent) {
+    asx_canonical_fixture fixtures[BATCH_N];
+    asx_status serial[BATCH_N];
+    asx_status threaded[BATCH_N];
+    asx_codec_equiv_report reports[BATCH_N];
+    asx_runtime_hooks hooks;
+    uint32_t i;
+
+    populate_batch(fixtures, BATCH_N);
+    (void)asx_runtime_hooks_init(&hooks);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+
+    /* A fixture the binary codec refuses fails only its own slot */
+    free(fixtures[3].fixture_schema_version);
+    fixtures[3].fixture_schema_version = dup_text("fixture-v0");
+
+    ASSERT_EQ(asx_codec_cross_codec_verify_batch(fixtures, BATCH_N, 1u,
+                                                 serial, reports),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_cross_codec_verify_batch(fixtures, BATCH_N, 4u,
+                                                 threaded, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    for (i = 0; i < BATCH_N; i++) {
+        ASSERT_EQ(threaded[i], serial[i]);
+        ASSERT_EQ(serial[i], i == 3u ? ASX_E_INVALID_ARGUMENT : ASX_OK);
+        if (i != 3u) ASSERT_EQ(reports[i].count, (uint32_t)0);
+    }
+
+    ASSERT_EQ(asx_codec_cross_codec_verify_batch(fixtures, 0u, 4u, NULL, NULL), ASX_OK);
+    ASSERT_EQ(asx_codec_cross_codec_verify_batch(fixtures, BATCH_N, 0u,
+                                                 serial, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_cross_codec_verify_batch(fixtures, BATCH_N, ASX_MAX_WORKERS + 1u,
+                                                 serial, NULL), ASX_E_INVALID_ARGUMENT);
+    reset_batch(fixtures, BATCH_N);
+}
+
 int main(void)
 {
     fprintf(stderr, "=== test_codec_equivalence ===\n");
@@ -461,6 +724,16 @@ int main(void)
     /* Digest identity */
     RUN_TEST(equiv_digest_identity_across_codecs);
 
+    /* Semantic hash and index */
+    RUN_TEST(equiv_semantic_hash_tracks_semantic_eq);
+    RUN_TEST(equiv_semantic_index_dedupes_in_one_pass);
+    RUN_TEST(equiv_semantic_index_caps_load_and_checks_args);
+
+    /* Batch API */
+    RUN_TEST(equiv_batch_encode_matches_single_encodes);
+    RUN_TEST(equiv_batch_codec_is_all_or_nothing);
+    RUN_TEST(equiv_batch_verify_is_worker_count_independent);
+
     TEST_REPORT();
     return test_failures;
 }
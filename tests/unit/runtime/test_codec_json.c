@@ -118,6 +118,7 @@ TEST(decode_rejects_missing_required_field) {
         "\"semantic_digest\":\"sha256:0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\""
         "}";
     asx_canonical_fixture fixture;
+    asx_codec_bin_fixture_view view;
 
     asx_canonical_fixture_init(&fixture);
     ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_JSON,
@@ -125,6 +126,8 @@ TEST(decode_rejects_missing_required_field) {
                                        strlen(missing_scenario),
                                        &fixture),
               ASX_E_INVALID_ARGUMENT);
+    asx_codec_bin_fixture_view_init(&view);
+    ASSERT_EQ(asx_codec_decode_fixture_json_view(missing_scenario, &view), ASX_E_INVALID_ARGUMENT);
     asx_canonical_fixture_reset(&fixture);
 }
 
@@ -152,6 +155,7 @@ TEST(decode_rejects_invalid_digest_pattern) {
         "\"semantic_digest\":\"sha256:XYZ\""
         "}";
     asx_canonical_fixture fixture;
+    asx_codec_bin_fixture_view view;
 
     asx_canonical_fixture_init(&fixture);
     ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_JSON,
@@ -159,6 +163,8 @@ TEST(decode_rejects_invalid_digest_pattern) {
                                        strlen(bad_digest),
                                        &fixture),
               ASX_E_INVALID_ARGUMENT);
+    asx_codec_bin_fixture_view_init(&view);
+    ASSERT_EQ(asx_codec_decode_fixture_json_view(bad_digest, &view), ASX_E_INVALID_ARGUMENT);
     asx_canonical_fixture_reset(&fixture);
 }
 
@@ -408,6 +414,551 @@ TEST(bin_decode_rejects_little_endian_length_mutation) {
     asx_canonical_fixture_reset(&fixture);
 }
 
+/* ---- Allocator routing and arena mode ---- */
+
+static uint32_t g_heap_calls;
+
+static void *counting_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    g_heap_calls++;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    g_heap_calls++;
+    return realloc(ptr, size);
+}
+
+static void install_counting_hooks(void)
+{
+    asx_runtime_hooks hooks;
+
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.allocator.malloc_fn = counting_malloc;
+    hooks.allocator.realloc_fn = counting_realloc;
+    (void)asx_runtime_set_hooks(&hooks);
+    g_heap_calls = 0u;
+}
+
+TEST(codec_buffer_growth_uses_allocator_hooks) {
+    asx_canonical_fixture fixture;
+    asx_codec_buffer out;
+
+    install_counting_hooks();
+    asx_canonical_fixture_init(&fixture);
+    asx_codec_buffer_init(&out);
+    populate_fixture(&fixture);
+
+    ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, &fixture, &out), ASX_OK);
+    ASSERT_TRUE(g_heap_calls > 0u);
+    asx_codec_buffer_reset(&out);
+
+    /* A sealed allocator is honoured instead of bypassed */
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, &fixture, &out),
+              ASX_E_ALLOCATOR_SEALED);
+    asx_codec_buffer_reset(&out);
+
+    install_counting_hooks();
+    asx_canonical_fixture_reset(&fixture);
+}
+
+#if ASX_DETERMINISTIC && ASX_FAULT_INJECTION
+TEST(codec_alloc_fault_surfaces_as_exhaustion) {
+    asx_canonical_fixture fixture;
+    asx_canonical_fixture decoded;
+    asx_codec_buffer out;
+    asx_fault_injection fault;
+
+    install_counting_hooks();
+    asx_canonical_fixture_init(&fixture);
+    asx_canonical_fixture_init(&decoded);
+    asx_codec_buffer_init(&out);
+    populate_fixture(&fixture);
+    ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, &fixture, &out), ASX_OK);
+
+    memset(&fault, 0, sizeof(fault));
+    fault.kind = ASX_FAULT_ALLOC_FAIL;
+    ASSERT_EQ(asx_fault_inject(&fault), ASX_OK);
+    ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_JSON, out.data, out.len, &decoded),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_fault_clear(), ASX_OK);
+
+    asx_codec_buffer_reset(&out);
+    asx_canonical_fixture_reset(&fixture);
+}
+#endif
+
+TEST(codec_arena_round_trip_makes_no_heap_calls) {
+    static uint8_t storage[16384];
+    asx_codec_arena arena;
+    asx_canonical_fixture fixture;
+    asx_canonical_fixture decoded;
+    asx_codec_buffer json_out;
+    asx_codec_buffer bin_out;
+
+    install_counting_hooks();
+    asx_canonical_fixture_init(&fixture);
+    populate_fixture(&fixture);
+
+    asx_codec_arena_init(&arena, storage, sizeof(storage));
+    asx_codec_set_arena(&arena);
+    ASSERT_EQ(asx_codec_active_arena(), &arena);
+    g_heap_calls = 0u;
+
+    asx_canonical_fixture_init(&decoded);
+    asx_codec_buffer_init(&json_out);
+    asx_codec_buffer_init(&bin_out);
+    ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, &fixture, &json_out), ASX_OK);
+    ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_JSON, json_out.data, json_out.len,
+                                       &decoded), ASX_OK);
+    ASSERT_EQ(decoded.arena, &arena);
+    ASSERT_STR_EQ(decoded.scenario_id, fixture.scenario_id);
+    asx_canonical_fixture_reset(&decoded);
+
+    ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, &fixture, &bin_out), ASX_OK);
+    ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_BIN, bin_out.data, bin_out.len,
+                                       &decoded), ASX_OK);
+    ASSERT_STR_EQ(decoded.provenance.capture_run_id, fixture.provenance.capture_run_id);
+    asx_canonical_fixture_reset(&decoded);
+    asx_codec_buffer_reset(&bin_out);
+    asx_codec_buffer_reset(&json_out);
+    ASSERT_EQ(g_heap_calls, 0u);
+
+    /* One reset reclaims the whole round trip */
+    ASSERT_TRUE(arena.used > 0u);
+    asx_codec_arena_reset(&arena);
+    ASSERT_EQ(arena.used, 0u);
+
+    asx_codec_set_arena(NULL);
+    asx_canonical_fixture_reset(&fixture);
+}
+
+TEST(codec_arena_exhaustion_is_reported) {
+    static uint8_t storage[64];
+    asx_codec_arena arena;
+    asx_canonical_fixture fixture;
+    asx_codec_buffer out;
+
+    asx_canonical_fixture_init(&fixture);
+    populate_fixture(&fixture);
+    asx_codec_arena_init(&arena, storage, sizeof(storage));
+    asx_codec_set_arena(&arena);
+
+    asx_codec_buffer_init(&out);
+    ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_JSON, &fixture, &out),
+              ASX_E_RESOURCE_EXHAUSTED);
+    asx_codec_buffer_reset(&out);
+
+    asx_codec_set_arena(NULL);
+    asx_canonical_fixture_reset(&fixture);
+}
+
+TEST(decode_scans_escapes_inside_raw_values) {
+    asx_canonical_fixture fixture;
+    asx_canonical_fixture decoded;
+    asx_codec_buffer json;
+    const char *events = "[{\"note\":\"say \\\"hi\\\" \\\\\"},{\"u\":\"\\u00e9\"}]";
+
+    asx_canonical_fixture_init(&fixture);
+    asx_canonical_fixture_init(&decoded);
+    asx_codec_buffer_init(&json);
+    populate_fixture(&fixture);
+    free(fixture.expected_events_json);
+    fixture.expected_events_json = dup_text(events);
+    ASSERT_EQ(asx_canonical_fixture_validate(&fixture), ASX_OK);
+
+    ASSERT_EQ(asx_codec_encode_fixture_json(&fixture, &json), ASX_OK);
+    ASSERT_EQ(asx_codec_decode_fixture_json(json.data, &decoded), ASX_OK);
+    ASSERT_STR_EQ(decoded.expected_events_json, events);
+
+    /* An unterminated string inside a raw value is still rejected */
+    asx_canonical_fixture_reset(&decoded);
+    free(fixture.expected_events_json);
+    fixture.expected_events_json = dup_text("[\"open]");
+    ASSERT_EQ(asx_canonical_fixture_validate(&fixture), ASX_E_INVALID_ARGUMENT);
+
+    asx_codec_buffer_reset(&json);
+    asx_canonical_fixture_reset(&fixture);
+}
+
+/* ---- Streaming binary decode ---- */
+
+typedef struct {
+    uint32_t fields;
+    uint64_t seed;
+    char scenario_id[64];
+    size_t longest;
+} stream_sink;
+
+static asx_status collect_field(void *ctx, const asx_codec_stream_field *field)
+{
+    stream_sink *sink = (stream_sink *)ctx;
+
+    sink->fields++;
+    if (field->field == ASX_CODEC_FIELD_SEED) {
+        sink->seed = field->value;
+    } else if (field->field == ASX_CODEC_FIELD_SCENARIO_ID &&
+               field->bytes.len < sizeof(sink->scenario_id)) {
+        memcpy(sink->scenario_id, field->bytes.ptr, field->bytes.len + 1u);
+    }
+    if (field->bytes.len > sink->longest) {
+        sink->longest = field->bytes.len;
+    }
+    return ASX_OK;
+}
+
+static asx_status encode_bin_fixture(asx_codec_buffer *out)
+{
+    asx_canonical_fixture fixture;
+    asx_status st;
+
+    asx_canonical_fixture_init(&fixture);
+    populate_fixture(&fixture);
+    fixture.codec = ASX_CODEC_KIND_BIN;
+    st = asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, &fixture, out);
+    asx_canonical_fixture_reset(&fixture);
+    return st;
+}
+
+TEST(bin_stream_decodes_any_chunking) {
+    static const size_t chunks[] = {1u, 3u, 7u, 64u, 4096u};
+    char field_buf[80];
+    asx_codec_bin_stream stream;
+    asx_codec_buffer out;
+    size_t c;
+
+    asx_codec_buffer_init(&out);
+    ASSERT_EQ(encode_bin_fixture(&out), ASX_OK);
+
+    for (c = 0u; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        stream_sink sink;
+        size_t off;
+
+        memset(&sink, 0, sizeof(sink));
+        asx_codec_bin_stream_init(&stream, field_buf, sizeof(field_buf),
+                                  collect_field, &sink);
+        for (off = 0u; off < out.len; off += chunks[c]) {
+            size_t n = out.len - off < chunks[c] ? out.len - off : chunks[c];
+            ASSERT_EQ(asx_codec_bin_stream_feed(&stream, out.data + off, n), ASX_OK);
+        }
+        ASSERT_EQ(asx_codec_bin_stream_finish(&stream), ASX_OK);
+        ASSERT_EQ(sink.fields, 17u);
+        ASSERT_EQ(sink.seed, 42u);
+        ASSERT_STR_EQ(sink.scenario_id, "scenario.codec.json.001");
+        ASSERT_TRUE(sink.longest < sizeof(field_buf));
+    }
+
+    /* Bytes past the frame are rejected and the error sticks */
+    ASSERT_EQ(asx_codec_bin_stream_feed(&stream, "x", 1u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_bin_stream_finish(&stream), ASX_E_INVALID_ARGUMENT);
+
+    asx_codec_buffer_reset(&out);
+}
+
+TEST(bin_stream_rejects_oversized_truncated_and_corrupt_frames) {
+    char small_buf[16];
+    char field_buf[80];
+    asx_codec_bin_stream stream;
+    asx_codec_buffer out;
+    stream_sink sink;
+
+    asx_codec_buffer_init(&out);
+    ASSERT_EQ(encode_bin_fixture(&out), ASX_OK);
+
+    /* Field larger than the caller's buffer */
+    memset(&sink, 0, sizeof(sink));
+    asx_codec_bin_stream_init(&stream, small_buf, sizeof(small_buf), collect_field, &sink);
+    ASSERT_EQ(asx_codec_bin_stream_feed(&stream, out.data, out.len), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_codec_bin_stream_finish(&stream), ASX_E_RESOURCE_EXHAUSTED);
+
+    /* Truncated frame only fails at finish */
+    asx_codec_bin_stream_init(&stream, field_buf, sizeof(field_buf), collect_field, &sink);
+    ASSERT_EQ(asx_codec_bin_stream_feed(&stream, out.data, out.len - 1u), ASX_OK);
+    ASSERT_EQ(asx_codec_bin_stream_finish(&stream), ASX_E_INVALID_ARGUMENT);
+
+    /* Checksum footer mismatch */
+    out.data[out.len - 1u] = (char)(out.data[out.len - 1u] ^ 0x01);
+    asx_codec_bin_stream_init(&stream, field_buf, sizeof(field_buf), collect_field, &sink);
+    ASSERT_EQ(asx_codec_bin_stream_feed(&stream, out.data, out.len), ASX_E_INVALID_ARGUMENT);
+
+    asx_codec_buffer_reset(&out);
+}
+
+TEST(bin_v2_frames_use_crc32c_and_v1_still_decodes) {
+    asx_canonical_fixture decoded;
+    asx_codec_bin_fixture_view view;
+    asx_codec_bin_stream stream;
+    asx_codec_buffer v1;
+    asx_codec_buffer v2;
+    stream_sink sink;
+    char field_buf[80];
+
+    asx_codec_buffer_init(&v1);
+    asx_codec_buffer_init(&v2);
+    ASSERT_EQ(asx_codec_bin_frame_version(), ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1);
+    ASSERT_EQ(encode_bin_fixture(&v1), ASX_OK);
+
+    ASSERT_EQ(asx_codec_set_bin_frame_version(3u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_set_bin_frame_version(ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2), ASX_OK);
+    ASSERT_EQ(encode_bin_fixture(&v2), ASX_OK);
+    ASSERT_EQ(v2.len, v1.len);
+    ASSERT_EQ((unsigned char)v2.data[4], ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2);
+    ASSERT_TRUE(memcmp(v1.data + 5, v2.data + 5, v1.len - 9u) == 0);
+    ASSERT_TRUE(memcmp(v1.data + v1.len - 4u, v2.data + v2.len - 4u, 4u) != 0);
+
+    /* Both versions decode whichever the encoder writes */
+    asx_codec_bin_fixture_view_init(&view);
+    ASSERT_EQ(asx_codec_decode_fixture_bin_view(v1.data, v1.len, &view), ASX_OK);
+    ASSERT_EQ(view.frame_schema_version, ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1);
+    ASSERT_EQ(asx_codec_decode_fixture_bin_view(v2.data, v2.len, &view), ASX_OK);
+    ASSERT_EQ(view.frame_schema_version, ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2);
+
+    memset(&sink, 0, sizeof(sink));
+    asx_codec_bin_stream_init(&stream, field_buf, sizeof(field_buf), collect_field, &sink);
+    ASSERT_EQ(asx_codec_bin_stream_feed(&stream, v2.data, v2.len), ASX_OK);
+    ASSERT_EQ(asx_codec_bin_stream_finish(&stream), ASX_OK);
+
+    /* A V1 footer on a V2 frame no longer checks out */
+    memcpy(v2.data + v2.len - 4u, v1.data + v1.len - 4u, 4u);
+    asx_canonical_fixture_init(&decoded);
+    ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_BIN, v2.data, v2.len, &decoded),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_codec_set_bin_frame_version(ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1), ASX_OK);
+    asx_codec_buffer_reset(&v2);
+    asx_codec_buffer_reset(&v1);
+}
+
+TEST(bin_varints_round_trip_at_every_width) {
+    static const uint64_t seeds[] = {
+        0u, 127u, 128u, 16383u, 16384u, 0xffffffffu,
+        0x00ffffffffffffffULL, 0x0100000000000000ULL,
+        0x8000000000000000ULL, 0xffffffffffffffffULL
+    };
+    asx_canonical_fixture fixture;
+    asx_canonical_fixture decoded;
+    asx_codec_bin_fixture_view view;
+    asx_codec_buffer out;
+    uint32_t crc;
+    size_t i, at;
+
+    asx_canonical_fixture_init(&fixture);
+    populate_fixture(&fixture);
+    asx_codec_buffer_init(&out);
+    ASSERT_EQ(asx_codec_set_bin_frame_version(ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V2), ASX_OK);
+
+    /* 1 to 10 byte seeds; 9 and 10 bytes take the per-byte loop */
+    for (i = 0; i < sizeof(seeds) / sizeof(seeds[0]); i++) {
+        fixture.seed = seeds[i];
+        ASSERT_EQ(asx_codec_encode_fixture(ASX_CODEC_KIND_BIN, &fixture, &out), ASX_OK);
+        asx_codec_bin_fixture_view_init(&view);
+        ASSERT_EQ(asx_codec_decode_fixture_bin_view(out.data, out.len, &view), ASX_OK);
+        ASSERT_EQ(view.seed, seeds[i]);
+        asx_canonical_fixture_init(&decoded);
+        ASSERT_EQ(asx_codec_decode_fixture(ASX_CODEC_KIND_BIN, out.data, out.len, &decoded),
+                  ASX_OK);
+        ASSERT_EQ(decoded.seed, seeds[i]);
+        asx_canonical_fixture_reset(&decoded);
+    }
+
+    /* A tenth byte above 1 overflows 64 bits even with a valid footer */
+    for (at = 11u; at + 10u < out.len; at++) {
+        if (memcmp(out.data + at, "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 10u) == 0) break;
+    }
+    ASSERT_TRUE(at + 10u < out.len);
+    out.data[at + 9u] = 0x02;
+    crc = asx_digest_crc32c(0, out.data, out.len - 4u);
+    out.data[out.len - 4u] = (char)(crc >> 24);
+    out.data[out.len - 3u] = (char)(crc >> 16);
+    out.data[out.len - 2u] = (char)(crc >> 8);
+    out.data[out.len - 1u] = (char)crc;
+    ASSERT_EQ(asx_codec_decode_fixture_bin_view(out.data, out.len, &view),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_codec_set_bin_frame_version(ASX_CODEC_BIN_FRAME_SCHEMA_VERSION_V1), ASX_OK);
+    asx_codec_buffer_reset(&out);
+    asx_canonical_fixture_reset(&fixture);
+}
+
+/* ---- Borrowed JSON view ---- */
+
+TEST(json_view_borrows_fields_without_allocating) {
+    asx_canonical_fixture fixture;
+    asx_codec_bin_fixture_view view;
+    asx_codec_buffer json;
+
+    asx_canonical_fixture_init(&fixture);
+    asx_codec_buffer_init(&json);
+    populate_fixture(&fixture);
+    ASSERT_EQ(asx_codec_encode_fixture_json(&fixture, &json), ASX_OK);
+
+    install_counting_hooks();
+    asx_codec_bin_fixture_view_init(&view);
+    ASSERT_EQ(asx_codec_decode_fixture_json_view(json.data, &view), ASX_OK);
+    ASSERT_EQ(g_heap_calls, 0u);
+
+    ASSERT_TRUE(view.scenario_id.ptr > json.data &&
+                view.scenario_id.ptr < json.data + json.len);
+    ASSERT_SLICE_EQ(view.scenario_id, fixture.scenario_id);
+    ASSERT_SLICE_EQ(view.profile, fixture.profile);
+    ASSERT_SLICE_EQ(view.input_json, fixture.input_json);
+    ASSERT_SLICE_EQ(view.expected_final_snapshot_json, fixture.expected_final_snapshot_json);
+    ASSERT_SLICE_EQ(view.semantic_digest, fixture.semantic_digest);
+    ASSERT_SLICE_EQ(view.capture_run_id, fixture.provenance.capture_run_id);
+    ASSERT_EQ(view.seed, fixture.seed);
+    ASSERT_EQ(view.codec, ASX_CODEC_KIND_JSON);
+    ASSERT_EQ(view.frame_schema_version, 0u);
+
+    asx_codec_buffer_reset(&json);
+    asx_canonical_fixture_reset(&fixture);
+}
+
+TEST(json_view_unescapes_only_escaped_strings) {
+    asx_canonical_fixture fixture;
+    asx_codec_bin_fixture_view view;
+    asx_codec_buffer json;
+    asx_codec_buffer scratch;
+    asx_codec_slice text;
+
+    asx_canonical_fixture_init(&fixture);
+    asx_codec_buffer_init(&json);
+    asx_codec_buffer_init(&scratch);
+    populate_fixture(&fixture);
+    free(fixture.scenario_id);
+    fixture.scenario_id = dup_text("scenario \"quoted\"\tid");
+    ASSERT_EQ(asx_codec_encode_fixture_json(&fixture, &json), ASX_OK);
+
+    asx_codec_bin_fixture_view_init(&view);
+    ASSERT_EQ(asx_codec_decode_fixture_json_view(json.data, &view), ASX_OK);
+
+    /* Plain strings resolve in place and leave scratch untouched */
+    ASSERT_EQ(asx_codec_json_view_text(view.profile, &scratch, &text), ASX_OK);
+    ASSERT_EQ(text.ptr, view.profile.ptr);
+    ASSERT_EQ(scratch.data, NULL);
+
+    ASSERT_TRUE(memchr(view.scenario_id.ptr, '\\', view.scenario_id.len) != NULL);
+    ASSERT_EQ(asx_codec_json_view_text(view.scenario_id, &scratch, &text), ASX_OK);
+    ASSERT_EQ(text.ptr, scratch.data);
+    ASSERT_SLICE_EQ(text, fixture.scenario_id);
+
+    asx_codec_buffer_reset(&scratch);
+    asx_codec_buffer_reset(&json);
+    asx_canonical_fixture_reset(&fixture);
+}
+
+/* Byte-at-a-time reference for asx_codec_buffer_append_json_string */
+static size_t reference_json_escape(const char *text, char *out)
+{
+    const unsigned char *p = (const unsigned char *)text;
+    size_t n = 0;
+
+    out[n++] = '"';
+    for (; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            out[n++] = '\\';
+            out[n++] = (char)*p;
+        } else if (*p == '\n') {
+            out[n++] = '\\';
+            out[n++] = 'n';
+        } else if (*p == '\t') {
+            out[n++] = '\\';
+            out[n++] = 't';
+        } else if (*p == '\r') {
+            out[n++] = '\\';
+            out[n++] = 'r';
+        } else if (*p == '\b') {
+            out[n++] = '\\';
+            out[n++] = 'b';
+        } else if (*p == '\f') {
+            out[n++] = '\\';
+            out[n++] = 'f';
+        } else if (*p < 0x20u) {
+            n += (size_t)sprintf(out + n, "\\u%04x", (unsigned int)*p);
+        } else {
+            out[n++] = (char)*p;
+        }
+    }
+    out[n++] = '"';
+    out[n] = '\0';
+    return n;
+}
+
+TEST(json_string_escape_matches_reference_at_every_offset) {
+    static const unsigned char specials[] = {
+        '"', '\\', '\n', '\t', 0x01u, 0x1fu, 0x7fu, 0x80u, 0xffu, ' ', 0x21u, 0x5bu
+    };
+    char text[41];
+    char expected[41u * 6u + 3u];
+    asx_codec_buffer out;
+    size_t len, pos, k, n;
+
+    asx_codec_buffer_init(&out);
+    for (len = 1; len < sizeof(text); len++) {
+        for (pos = 0; pos < len; pos++) {
+            for (k = 0; k < sizeof(specials); k++) {
+                memset(text, 'a', len);
+                text[len] = '\0';
+                text[pos] = (char)specials[k];
+                /* A trailing quote keeps the tail path busy too */
+                if (pos + 3u < len) text[len - 1u] = '"';
+                n = reference_json_escape(text, expected);
+
+                out.len = 0;
+                ASSERT_EQ(asx_codec_buffer_append_json_string(&out, text), ASX_OK);
+                ASSERT_EQ(out.len, n);
+                ASSERT_STR_EQ(out.data, expected);
+            }
+        }
+    }
+
+    /* Appends after existing content */
+    out.len = 0;
+    ASSERT_EQ(asx_codec_buffer_append_cstr(&out, "x:"), ASX_OK);
+    ASSERT_EQ(asx_codec_buffer_append_json_string(&out, ""), ASX_OK);
+    ASSERT_STR_EQ(out.data, "x:\"\"");
+    ASSERT_EQ(asx_codec_buffer_append_json_string(&out, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_buffer_append_json_string(NULL, "a"), ASX_E_INVALID_ARGUMENT);
+    asx_codec_buffer_reset(&out);
+}
+
+TEST(json_view_rejects_duplicate_members) {
+    const char *dup_seed =
+        "{"
+        "\"codec\":\"json\","
+        "\"expected_error_codes\":[],"
+        "\"expected_events\":[],"
+        "\"expected_final_snapshot\":{},"
+        "\"fixture_schema_version\":\"fixture-v1\","
+        "\"input\":{\"ops\":[]},"
+        "\"profile\":\"ASX_PROFILE_CORE\","
+        "\"provenance\":{"
+          "\"cargo_lock_sha256\":\"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\","
+          "\"capture_run_id\":\"capture-run-0001\","
+          "\"rust_baseline_commit\":\"0123456789abcdef0123456789abcdef01234567\","
+          "\"rust_toolchain_commit_hash\":\"toolchain-abcdef12\","
+          "\"rust_toolchain_host\":\"x86_64-unknown-linux-gnu\","
+          "\"rust_toolchain_release\":\"rustc 1.90.0\""
+        "},"
+        "\"scenario_dsl_version\":\"dsl-v1\","
+        "\"scenario_id\":\"scenario.codec.json.001\","
+        "\"seed\":42,"
+        "\"seed\":43,"
+        "\"semantic_digest\":\"sha256:0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\""
+        "}";
+    asx_canonical_fixture fixture;
+    asx_codec_bin_fixture_view view;
+
+    asx_canonical_fixture_init(&fixture);
+    ASSERT_EQ(asx_codec_decode_fixture_json(dup_seed, &fixture), ASX_E_INVALID_ARGUMENT);
+    asx_codec_bin_fixture_view_init(&view);
+    ASSERT_EQ(asx_codec_decode_fixture_json_view(dup_seed, &view), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_codec_decode_fixture_json_view(NULL, &view), ASX_E_INVALID_ARGUMENT);
+}
+
 int main(void) {
     fprintf(stderr, "=== test_codec_json ===\n");
     RUN_TEST(json_round_trip_is_stable);
@@ -422,6 +973,21 @@ int main(void) {
     RUN_TEST(bin_header_payload_length_is_big_endian);
     RUN_TEST(bin_decode_accepts_unaligned_input_pointer);
     RUN_TEST(bin_decode_rejects_little_endian_length_mutation);
+    RUN_TEST(codec_buffer_growth_uses_allocator_hooks);
+#if ASX_DETERMINISTIC && ASX_FAULT_INJECTION
+    RUN_TEST(codec_alloc_fault_surfaces_as_exhaustion);
+#endif
+    RUN_TEST(codec_arena_round_trip_makes_no_heap_calls);
+    RUN_TEST(codec_arena_exhaustion_is_reported);
+    RUN_TEST(decode_scans_escapes_inside_raw_values);
+    RUN_TEST(bin_stream_decodes_any_chunking);
+    RUN_TEST(bin_stream_rejects_oversized_truncated_and_corrupt_frames);
+    RUN_TEST(bin_v2_frames_use_crc32c_and_v1_still_decodes);
+    RUN_TEST(bin_varints_round_trip_at_every_width);
+    RUN_TEST(json_view_borrows_fields_without_allocating);
+    RUN_TEST(json_view_unescapes_only_escaped_strings);
+    RUN_TEST(json_view_rejects_duplicate_members);
+    RUN_TEST(json_string_escape_matches_reference_at_every_offset);
     TEST_REPORT();
     return test_failures;
 }
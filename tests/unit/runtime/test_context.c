@@ -0,0 +1,261 @@
+/*
+ * test_context.c — unit tests for runtime contexts
+ *
+ * Tests: argument and storage checks, binding before the implicit
+ * context is adopted, arenas, trace and hooks kept apart across
+ * binds, a new context starting clean, zeroed storage usable without a
+ * reset, and finalization returning a context's allocations.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/core/resource.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/hindsight.h>
+#include <asx/core/channel.h>
+#include <asx/time/timer_wheel.h>
+#include <stdlib.h>
+
+static asx_status pending_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data;
+    (void)self;
+    return ASX_E_PENDING;
+}
+
+static asx_status noop_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data;
+    (void)self;
+    return ASX_OK;
+}
+
+static int g_live_blocks;
+
+static void *counting_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    g_live_blocks++;
+    return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    if (ptr != NULL) g_live_blocks--;
+    free(ptr);
+}
+
+static int counting_hooks_installed(void)
+{
+    const asx_runtime_hooks *hooks = asx_runtime_get_hooks();
+
+    return hooks != NULL && hooks->allocator.malloc_fn == counting_malloc;
+}
+
+static asx_runtime *g_main_ctx;
+
+TEST(context_init_checks_storage) {
+    uint32_t size = asx_runtime_context_size();
+    uint64_t *storage;
+    asx_runtime *ctx = NULL;
+
+    ASSERT_TRUE(size > 0u);
+    storage = (uint64_t *)malloc(size);
+    ASSERT_TRUE(storage != NULL);
+    ASSERT_EQ(asx_runtime_context_init(NULL, size, &ctx), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_context_init(storage, size, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_context_init((uint8_t *)storage + 4, size - 8u, &ctx),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_context_init(storage, size - 1u, &ctx),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_TRUE(ctx == NULL);
+    ASSERT_EQ(asx_runtime_context_bind(NULL), ASX_E_INVALID_ARGUMENT);
+
+    /* The implicit context cannot be bound away from until adopted */
+    ASSERT_EQ(asx_runtime_context_init(storage, size, &ctx), ASX_OK);
+    ASSERT_TRUE(asx_runtime_context_current() == NULL);
+    ASSERT_EQ(asx_runtime_context_bind(ctx), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_runtime_context_fini(ctx), ASX_E_INVALID_STATE);
+    free(storage);
+}
+
+TEST(context_adopt_keeps_implicit_state_bound) {
+    uint32_t size = asx_runtime_context_size();
+    void *storage = malloc(size);
+    void *again = malloc(size);
+    asx_runtime *ctx = NULL;
+    asx_region_id rid;
+
+    ASSERT_TRUE(storage != NULL && again != NULL);
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_adopt(storage, size, &g_main_ctx), ASX_OK);
+    ASSERT_TRUE(asx_runtime_context_current() == g_main_ctx);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_REGION), 1u);
+    ASSERT_EQ(asx_runtime_context_adopt(again, size, &ctx), ASX_E_INVALID_STATE);
+    ASSERT_TRUE(ctx == NULL);
+    ASSERT_EQ(asx_runtime_context_bind(g_main_ctx), ASX_OK);
+    asx_runtime_reset();
+    free(again);
+}
+
+TEST(context_bind_isolates_arenas_trace_and_hooks) {
+    uint32_t size = asx_runtime_context_size();
+    void *storage = malloc(size);
+    asx_runtime *tenant = NULL;
+    asx_runtime_hooks hooks;
+    asx_region_id main_rid;
+    asx_region_id tenant_rid;
+    asx_task_id tid;
+    asx_task_state state;
+    asx_budget budget;
+    uint32_t main_events;
+
+    ASSERT_TRUE(storage != NULL);
+    ASSERT_EQ(asx_runtime_context_bind(g_main_ctx), ASX_OK);
+    asx_runtime_reset();
+    asx_trace_reset();
+    ASSERT_EQ(asx_region_open(&main_rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(main_rid, pending_poll, NULL, &tid), ASX_OK);
+    main_events = asx_trace_event_count();
+    ASSERT_FALSE(counting_hooks_installed());
+
+    /* A new context starts empty */
+    ASSERT_EQ(asx_runtime_context_init(storage, size, &tenant), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_bind(tenant), ASX_OK);
+    ASSERT_TRUE(asx_runtime_context_current() == tenant);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_REGION), 0u);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 0u);
+    ASSERT_EQ(asx_trace_event_count(), 0u);
+    ASSERT_EQ(asx_task_get_state(tid, &state), ASX_E_NOT_FOUND);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.allocator.malloc_fn = counting_malloc;
+    hooks.allocator.realloc_fn = NULL;
+    hooks.allocator.free_fn = counting_free;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_region_open(&tenant_rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(tenant_rid, noop_poll, NULL, &tid), ASX_OK);
+    budget = asx_budget_from_polls(8);
+    ASSERT_EQ(asx_scheduler_run(tenant_rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_state(tid, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+
+    /* Back home: our task is still pending, their hooks are theirs */
+    ASSERT_EQ(asx_runtime_context_bind(g_main_ctx), ASX_OK);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_TASK), 1u);
+    ASSERT_EQ(asx_trace_event_count(), main_events);
+    ASSERT_FALSE(counting_hooks_installed());
+
+    ASSERT_EQ(asx_runtime_context_bind(tenant), ASX_OK);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_REGION), 1u);
+    ASSERT_TRUE(counting_hooks_installed());
+    ASSERT_EQ(asx_runtime_context_bind(g_main_ctx), ASX_OK);
+
+    ASSERT_EQ(asx_runtime_context_fini(tenant), ASX_OK);
+    free(storage);
+    asx_runtime_reset();
+}
+
+TEST(context_zeroed_storage_needs_no_reset) {
+    uint32_t size = asx_runtime_context_size();
+    void *storage = malloc(size);
+    asx_runtime *tenant = NULL;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_task_state state;
+    asx_obligation_id oid;
+    asx_budget budget;
+    asx_timer_wheel *wheel;
+    asx_timer_handle keep;
+    asx_timer_handle drop;
+    asx_channel_id ch;
+    asx_send_permit permit;
+    asx_hindsight_event ev;
+    void *wakers[4];
+    asx_time next;
+    uint64_t val;
+    int marker = 0;
+
+    /* Every module is set up as it is first used */
+    ASSERT_TRUE(storage != NULL);
+    ASSERT_EQ(asx_runtime_context_init(storage, size, &tenant), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_bind(tenant), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, noop_poll, NULL, &tid), ASX_OK);
+    budget = asx_budget_from_polls(8);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_state(tid, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+
+    wheel = asx_timer_wheel_global();
+    ASSERT_EQ(asx_timer_register(wheel, 100, &marker, &keep), ASX_OK);
+    ASSERT_EQ(asx_timer_register(wheel, 50, NULL, &drop), ASX_OK);
+    ASSERT_TRUE(asx_timer_cancel(wheel, &drop));
+    ASSERT_EQ(asx_timer_next_deadline(wheel, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)100);
+    ASSERT_EQ(asx_timer_collect_expired(wheel, 100, wakers, 4), 1u);
+    ASSERT_TRUE(wakers[0] == &marker);
+    ASSERT_EQ(asx_timer_active_count(wheel), 0u);
+
+    ASSERT_EQ(asx_channel_create(rid, 2, &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(ch, &permit), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&permit, 7), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &val), ASX_OK);
+    ASSERT_EQ(val, (uint64_t)7);
+
+    ASSERT_FALSE(asx_hindsight_get(0, &ev));
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 1, 2);
+    ASSERT_TRUE(asx_hindsight_get(0, &ev));
+    ASSERT_EQ(ev.entity_id, (uint64_t)1);
+    ASSERT_EQ(ev.observed_value, (uint64_t)2);
+
+    ASSERT_EQ(asx_runtime_context_bind(g_main_ctx), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_fini(tenant), ASX_OK);
+    free(storage);
+}
+
+TEST(context_fini_returns_allocations) {
+    uint32_t size = asx_runtime_context_size();
+    void *storage = malloc(size);
+    asx_runtime *tenant = NULL;
+    asx_runtime_hooks hooks;
+
+    ASSERT_TRUE(storage != NULL);
+    ASSERT_EQ(asx_runtime_context_init(storage, size, &tenant), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_bind(tenant), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_fini(tenant), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.allocator.malloc_fn = counting_malloc;
+    hooks.allocator.realloc_fn = NULL;
+    hooks.allocator.free_fn = counting_free;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_live_blocks = 0;
+    ASSERT_EQ(asx_scheduler_event_log_reserve(4096u), ASX_OK);
+    ASSERT_EQ(g_live_blocks, 1);
+
+    ASSERT_EQ(asx_runtime_context_bind(g_main_ctx), ASX_OK);
+    ASSERT_EQ(asx_runtime_context_fini(tenant), ASX_OK);
+    ASSERT_EQ(g_live_blocks, 0);
+    ASSERT_TRUE(asx_runtime_context_current() == g_main_ctx);
+    ASSERT_EQ(asx_runtime_context_bind(tenant), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_context_fini(tenant), ASX_E_INVALID_ARGUMENT);
+    free(storage);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_context ===\n");
+    RUN_TEST(context_init_checks_storage);
+    RUN_TEST(context_adopt_keeps_implicit_state_bound);
+    RUN_TEST(context_bind_isolates_arenas_trace_and_hooks);
+    RUN_TEST(context_zeroed_storage_needs_no_reset);
+    RUN_TEST(context_fini_returns_allocations);
+    TEST_REPORT();
+    return test_failures;
+}
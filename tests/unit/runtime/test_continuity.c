@@ -443,6 +443,635 @@ TEST(empty_trace_export_import_roundtrip)
     asx_replay_clear_reference();
 }
 
+/* -------------------------------------------------------------------
+ * Compact (v2) format
+ * ------------------------------------------------------------------- */
+
+static uint8_t g_compact[BUF_SIZE];
+
+TEST(compact_export_roundtrips_and_shrinks)
+{
+    uint32_t v1_len = 0;
+    uint32_t v2_len = 0;
+    uint32_t i;
+
+    reset_all();
+    /* Handle-shaped ids: tag in the high bits, slot index below */
+    for (i = 0; i < 200; i++) {
+        uint64_t task = 0x0002000000000000ull | (uint64_t)(i % 16u);
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, task, 0);
+        asx_trace_emit(ASX_TRACE_TASK_PARK, task, 2);
+        asx_trace_emit(ASX_TRACE_CHANNEL_SEND,
+                       0x0004000000000000ull | 3u, i);
+    }
+
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &v1_len), ASX_OK);
+    ASSERT_EQ(asx_trace_export_compact(g_compact, BUF_SIZE, &v2_len), ASX_OK);
+    ASSERT_TRUE(v2_len * 6u < v1_len);
+    ASSERT_EQ(g_compact[4], ASX_TRACE_BINARY_VERSION_COMPACT);
+    ASSERT_EQ(memcmp(g_compact + 16, g_buf + 16, 8), 0);  /* same digest */
+
+    ASSERT_EQ(asx_trace_import_binary(g_compact, v2_len), ASX_OK);
+    {
+        asx_replay_result rr = asx_replay_verify();
+        ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    }
+    asx_replay_clear_reference();
+    ASSERT_EQ(asx_trace_continuity_check(g_compact, v2_len), ASX_OK);
+}
+
+TEST(compact_handles_wide_and_negative_deltas)
+{
+    uint32_t len = 0;
+    uint32_t need = 0;
+
+    reset_all();
+    asx_trace_emit(ASX_TRACE_TIMER_SET, 0xFFFFFFFFFFFFFFFFull, 0);
+    asx_trace_emit(ASX_TRACE_TIMER_SET, 0, 0xFFFFFFFFFFFFFFFFull);
+    asx_trace_emit(ASX_TRACE_TIMER_SET, 0x8000000000000000ull, 1);
+    asx_trace_emit(ASX_TRACE_TIMER_FIRE, 5, 0);
+    asx_trace_emit(ASX_TRACE_TIMER_SET, 7, 0x7FFFFFFFFFFFFFFFull);
+
+    ASSERT_EQ(asx_trace_export_compact(g_compact, 30, &need),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(asx_trace_export_compact(g_compact, BUF_SIZE, &len), ASX_OK);
+    ASSERT_EQ(len, need);
+    ASSERT_EQ(asx_trace_continuity_check(g_compact, len), ASX_OK);
+
+    /* Truncation and a corrupted delta are both caught */
+    ASSERT_EQ(asx_trace_import_binary(g_compact, len - 1u),
+              ASX_E_INVALID_ARGUMENT);
+    g_compact[len - 1u] ^= 0x01u;
+    ASSERT_EQ(asx_trace_import_binary(g_compact, len), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(compact_empty_trace_is_header_only)
+{
+    uint32_t len = 0;
+
+    reset_all();
+    ASSERT_EQ(asx_trace_export_compact(g_compact, BUF_SIZE, &len), ASX_OK);
+    ASSERT_EQ(len, ASX_TRACE_BINARY_HEADER);
+    ASSERT_EQ(asx_trace_continuity_check(g_compact, len), ASX_OK);
+}
+
+/* -------------------------------------------------------------------
+ * Streaming sink
+ * ------------------------------------------------------------------- */
+
+#define SINK_CHUNKS 4u
+static uint8_t  g_sink_buf[SINK_CHUNKS][BUF_SIZE];
+static uint32_t g_sink_len[SINK_CHUNKS];
+static uint32_t g_sink_calls;
+
+static asx_status collect_sink(void *ctx, const uint8_t *chunk, uint32_t len)
+{
+    (void)ctx;
+    if (g_sink_calls < SINK_CHUNKS && len <= BUF_SIZE) {
+        memcpy(g_sink_buf[g_sink_calls], chunk, len);
+        g_sink_len[g_sink_calls] = len;
+    }
+    g_sink_calls++;
+    return ASX_OK;
+}
+
+static uint32_t chunk_word(uint32_t chunk, uint32_t off)
+{
+    const uint8_t *p = g_sink_buf[chunk] + off;
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+         | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+TEST(sink_streams_chunks_past_capacity)
+{
+    uint32_t total = ASX_TRACE_CAPACITY * 2u + ASX_TRACE_CAPACITY / 2u;
+    uint64_t digest;
+    uint32_t i;
+
+    reset_all();
+    g_sink_calls = 0;
+    digest = asx_trace_digest();
+    asx_trace_set_sink(collect_sink, NULL);
+
+    for (i = 0; i < total; i++) {
+        asx_trace_emit((asx_trace_event_kind)(i % 8u), i, i * 3u);
+    }
+    /* Two full chunks handed off; the tail is still in the ring */
+    ASSERT_EQ(g_sink_calls, 2u);
+    ASSERT_EQ(asx_trace_event_count(), ASX_TRACE_CAPACITY / 2u);
+    ASSERT_EQ(asx_trace_flush(), ASX_OK);
+    ASSERT_EQ(g_sink_calls, 3u);
+    ASSERT_EQ(asx_trace_chunk_count(), 3u);
+    ASSERT_EQ(asx_trace_event_count(), 0u);
+
+    /* Headers carry the chunk index; sequences run on across chunks */
+    ASSERT_EQ(chunk_word(0, 12), 0u);
+    ASSERT_EQ(chunk_word(2, 12), 2u);
+    ASSERT_EQ(chunk_word(1, 8), ASX_TRACE_CAPACITY);
+    ASSERT_EQ(chunk_word(2, 8), ASX_TRACE_CAPACITY / 2u);
+    ASSERT_EQ(chunk_word(1, ASX_TRACE_BINARY_HEADER), ASX_TRACE_CAPACITY);
+
+    /* Chaining the chunk digests reproduces the live digest */
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_trace_chunk_verify(g_sink_buf[i], g_sink_len[i],
+                                         digest, &digest), ASX_OK);
+    }
+    ASSERT_EQ(digest, asx_trace_digest());
+
+    /* The first chunk is an ordinary v1 trace */
+    ASSERT_EQ(asx_trace_import_binary(g_sink_buf[0], g_sink_len[0]), ASX_OK);
+
+    asx_trace_set_sink(NULL, NULL);
+    reset_all();
+}
+
+TEST(sink_chunk_verify_rejects_broken_chain)
+{
+    uint64_t basis;
+    uint64_t next = 0;
+    uint32_t i;
+
+    reset_all();
+    g_sink_calls = 0;
+    basis = asx_trace_digest();
+    ASSERT_EQ(asx_trace_flush(), ASX_E_INVALID_STATE);
+
+    asx_trace_set_sink(collect_sink, NULL);
+    for (i = 0; i < ASX_TRACE_CAPACITY + 4u; i++) {
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, i, 0);
+    }
+    ASSERT_EQ(asx_trace_flush(), ASX_OK);
+    ASSERT_EQ(g_sink_calls, 2u);
+
+    /* Chunk 1 does not verify from the basis, only from chunk 0 */
+    ASSERT_EQ(asx_trace_chunk_verify(g_sink_buf[1], g_sink_len[1],
+                                     basis, &next), ASX_E_REPLAY_MISMATCH);
+    ASSERT_EQ(asx_trace_chunk_verify(g_sink_buf[0], g_sink_len[0],
+                                     basis, &next), ASX_OK);
+    ASSERT_EQ(asx_trace_chunk_verify(g_sink_buf[1], g_sink_len[1],
+                                     next, &next), ASX_OK);
+    ASSERT_EQ(asx_trace_chunk_verify(g_sink_buf[1], 20, next, &next),
+              ASX_E_INVALID_ARGUMENT);
+
+    asx_trace_set_sink(NULL, NULL);
+    reset_all();
+}
+
+/* -------------------------------------------------------------------
+ * Mapped replay reference
+ * ------------------------------------------------------------------- */
+
+#define MAP_EVENTS 3000u
+static uint8_t  g_stream[4u * BUF_SIZE];
+static uint32_t g_stream_len;
+
+/* Appends chunks back to back, as the file sink does */
+static asx_status append_sink(void *ctx, const uint8_t *chunk, uint32_t len)
+{
+    (void)ctx;
+    if (len > sizeof(g_stream) - g_stream_len) return ASX_E_RESOURCE_EXHAUSTED;
+    memcpy(g_stream + g_stream_len, chunk, len);
+    g_stream_len += len;
+    return ASX_OK;
+}
+
+static void emit_map_scenario(uint32_t count, uint32_t perturb_at)
+{
+    uint32_t i;
+    for (i = 0; i < count; i++) {
+        asx_trace_emit((asx_trace_event_kind)(i % 8u),
+                       i == perturb_at ? 0xBADull : (uint64_t)i, i / 3u);
+    }
+}
+
+static void record_map_stream(void)
+{
+    reset_all();
+    g_stream_len = 0;
+    asx_trace_set_sink(append_sink, NULL);
+    emit_map_scenario(MAP_EVENTS, UINT32_MAX);
+    (void)asx_trace_flush();
+    asx_trace_set_sink(NULL, NULL);
+}
+
+/* -------------------------------------------------------------------
+ * Block export
+ * ------------------------------------------------------------------- */
+
+static uint32_t g_block_calls;
+static uint32_t g_block_short;     /* calls shorter than the block */
+static uint32_t g_block_fail_at;   /* call that fails, 0 = none */
+static uint8_t  g_block_scratch[BUF_SIZE + 256u];
+
+static asx_status block_sink(void *ctx, const uint8_t *chunk, uint32_t len)
+{
+    uint32_t block = *(const uint32_t *)ctx;
+
+    if (++g_block_calls == g_block_fail_at) return ASX_E_RESOURCE_EXHAUSTED;
+    if (len != block) g_block_short++;
+    return append_sink(NULL, chunk, len);
+}
+
+TEST(export_blocks_match_whole_buffer_export)
+{
+    /* The last is larger than the whole trace */
+    static const uint32_t blocks[] = { 1u, 7u, 24u, 256u, sizeof(g_block_scratch) };
+    uint32_t whole_len;
+    uint32_t len;
+    uint32_t k;
+    int times;
+
+    for (times = 0; times < 2; times++) {
+        reset_all();
+        asx_trace_set_timestamps(times);
+        emit_map_scenario(300, UINT32_MAX);
+        ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &whole_len), ASX_OK);
+
+        for (k = 0; k < sizeof(blocks) / sizeof(blocks[0]); k++) {
+            uint32_t block = blocks[k];
+
+            g_stream_len = 0;
+            g_block_calls = 0;
+            g_block_short = 0;
+            g_block_fail_at = 0;
+            ASSERT_EQ(asx_trace_export_binary_blocks(block_sink, &block,
+                                                     g_block_scratch, block,
+                                                     &len), ASX_OK);
+            ASSERT_EQ(len, whole_len);
+            ASSERT_EQ(g_stream_len, whole_len);
+            ASSERT_TRUE(memcmp(g_stream, g_buf, whole_len) == 0);
+            ASSERT_TRUE(g_block_short <= 1u);
+            ASSERT_EQ(g_block_calls, (whole_len + block - 1u) / block);
+        }
+    }
+    asx_trace_set_timestamps(0);
+}
+
+TEST(export_blocks_stop_on_writer_error)
+{
+    uint8_t scratch[64];
+    uint32_t block = sizeof(scratch);
+    uint32_t len = 0;
+
+    reset_all();
+    emit_map_scenario(50, UINT32_MAX);
+    g_stream_len = 0;
+    g_block_calls = 0;
+    g_block_fail_at = 3;
+    ASSERT_EQ(asx_trace_export_binary_blocks(block_sink, &block, scratch,
+                                             block, &len),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(g_block_calls, 3u);
+    ASSERT_EQ(len, 0u);
+
+    ASSERT_EQ(asx_trace_export_binary_blocks(NULL, NULL, scratch, 8, &len),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_export_binary_blocks(block_sink, &block, NULL, 8, &len),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_export_binary_blocks(block_sink, &block, scratch, 0, &len),
+              ASX_E_INVALID_ARGUMENT);
+    g_block_fail_at = 0;
+}
+
+/* -------------------------------------------------------------------
+ * Compressed history ring
+ * ------------------------------------------------------------------- */
+
+#define HIST_TASKS 8u
+static uint8_t g_hist[16u * ASX_TRACE_HISTORY_SEGMENT];
+
+/* Scheduler rounds over HIST_TASKS tasks, as a router's loop emits */
+static void emit_history_rounds(uint32_t rounds)
+{
+    uint32_t r;
+    uint32_t t;
+
+    for (r = 0; r < rounds; r++) {
+        asx_trace_emit(ASX_TRACE_SCHED_ROUND, 0, r);
+        for (t = 0; t < HIST_TASKS; t++) {
+            asx_trace_emit(ASX_TRACE_SCHED_POLL, 0x0002000100000000u + t, r);
+        }
+    }
+}
+
+static uint64_t stream_le(uint32_t off, uint32_t bytes)
+{
+    uint64_t v = 0;
+    uint32_t i;
+
+    for (i = bytes; i > 0; i--) v = (v << 8) | g_stream[off + i - 1u];
+    return v;
+}
+
+TEST(history_holds_recent_events_compressed)
+{
+    uint32_t rounds = 1000;
+    uint32_t total = rounds * (HIST_TASKS + 1u);
+    uint32_t block = 100;
+    uint32_t held;
+    uint32_t first;
+    uint32_t off = 0;
+    uint32_t seq;
+    uint32_t len;
+    uint64_t digest;
+
+    reset_all();
+    ASSERT_EQ(asx_trace_history_attach(g_hist, sizeof(g_hist)), ASX_OK);
+    digest = asx_trace_digest();
+    emit_history_rounds(rounds);
+
+    /* At least four times the events plain records would fit */
+    held = asx_trace_history_count();
+    ASSERT_TRUE(held < total);
+    ASSERT_TRUE(held * ASX_TRACE_BINARY_EVENT >= 4u * sizeof(g_hist));
+
+    g_stream_len = 0;
+    g_block_calls = 0;
+    g_block_fail_at = 0;
+    ASSERT_EQ(asx_trace_history_export(block_sink, &block, g_block_scratch,
+                                       block, &len), ASX_OK);
+    ASSERT_EQ(len, g_stream_len);
+
+    /* Chained v1 chunks holding the last held events, in order */
+    first = total - held;
+    seq = first;
+    while (off < g_stream_len) {
+        uint32_t count = (uint32_t)stream_le(off + 8u, 4);
+        uint32_t i;
+
+        ASSERT_EQ(asx_trace_chunk_verify(g_stream + off,
+                                         ASX_TRACE_BINARY_HEADER +
+                                         count * ASX_TRACE_BINARY_EVENT,
+                                         digest, &digest), ASX_OK);
+        off += ASX_TRACE_BINARY_HEADER;
+        for (i = 0; i < count; i++, seq++) {
+            uint32_t r = seq / (HIST_TASKS + 1u);
+            uint32_t t = seq % (HIST_TASKS + 1u);
+
+            ASSERT_EQ((uint32_t)stream_le(off, 4), seq);
+            ASSERT_EQ((uint32_t)stream_le(off + 4u, 4),
+                      t == 0 ? (uint32_t)ASX_TRACE_SCHED_ROUND
+                             : (uint32_t)ASX_TRACE_SCHED_POLL);
+            ASSERT_EQ(stream_le(off + 8u, 8),
+                      t == 0 ? 0u : 0x0002000100000000u + t - 1u);
+            ASSERT_EQ(stream_le(off + 16u, 8), (uint64_t)r);
+            off += ASX_TRACE_BINARY_EVENT;
+        }
+    }
+    ASSERT_EQ(seq, total);
+
+    /* Reset empties it; detaching stops it */
+    asx_trace_reset();
+    ASSERT_EQ(asx_trace_history_count(), 0u);
+    ASSERT_EQ(asx_trace_history_attach(NULL, 0), ASX_OK);
+    asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, 0);
+    ASSERT_EQ(asx_trace_history_count(), 0u);
+    reset_all();
+}
+
+TEST(history_rejects_bad_storage)
+{
+    uint32_t block = 64;
+    uint32_t len;
+
+    reset_all();
+    ASSERT_EQ(asx_trace_history_attach(NULL, 64), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_history_attach(g_hist, 2u * ASX_TRACE_HISTORY_SEGMENT - 1u),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_history_export(block_sink, &block, g_block_scratch,
+                                       block, &len), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_trace_history_attach(g_hist, sizeof(g_hist)), ASX_OK);
+    ASSERT_EQ(asx_trace_history_export(NULL, NULL, g_block_scratch, block, &len),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_history_attach(NULL, 0), ASX_OK);
+}
+
+/* -------------------------------------------------------------------
+ * Verified prefix
+ * ------------------------------------------------------------------- */
+
+TEST(verify_resumes_from_verified_prefix)
+{
+    asx_trace_event ref[8];
+    asx_replay_result r;
+    uint64_t digest;
+    uint32_t i;
+
+    reset_all();
+    emit_map_scenario(8, UINT32_MAX);
+    for (i = 0; i < 8; i++) ASSERT_TRUE(asx_trace_event_get(i, &ref[i]));
+
+    /* A trace still growing: the prefix so far is verified once */
+    reset_all();
+    ASSERT_EQ(asx_replay_load_reference(ref, 8), ASX_OK);
+    emit_map_scenario(5, UINT32_MAX);
+    r = asx_replay_verify();
+    ASSERT_EQ(r.result, ASX_REPLAY_LENGTH_MISMATCH);
+    ASSERT_EQ(asx_replay_verified_prefix(&digest), 5u);
+    ASSERT_EQ(digest, asx_trace_digest());
+
+    for (i = 5; i < 8; i++) {
+        asx_trace_emit(ref[i].kind, ref[i].entity_id, ref[i].aux);
+    }
+    r = asx_replay_verify();
+    ASSERT_EQ(r.result, ASX_REPLAY_MATCH);
+    ASSERT_EQ(asx_replay_verified_prefix(&digest), 8u);
+    ASSERT_EQ(digest, r.actual_digest);
+    r = asx_replay_verify();
+    ASSERT_EQ(r.result, ASX_REPLAY_MATCH);
+
+    /* A new run starts over */
+    asx_trace_reset();
+    ASSERT_EQ(asx_replay_verified_prefix(NULL), 0u);
+    emit_map_scenario(8, 6);
+    r = asx_replay_verify();
+    ASSERT_EQ(r.result, ASX_REPLAY_ENTITY_MISMATCH);
+    ASSERT_EQ(r.divergence_index, 6u);
+    ASSERT_EQ(asx_replay_verified_prefix(NULL), 6u);
+
+    asx_replay_clear_reference();
+    ASSERT_EQ(asx_replay_verified_prefix(NULL), 0u);
+}
+
+TEST(mapped_reference_replays_past_capacity)
+{
+    asx_replay_result rr;
+
+    record_map_stream();
+    ASSERT_EQ(asx_replay_map_reference(g_stream, g_stream_len), ASX_OK);
+
+    /* Identical rerun, no sink: every event compared in place */
+    asx_trace_reset();
+    emit_map_scenario(MAP_EVENTS, UINT32_MAX);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    ASSERT_EQ(rr.actual_digest, rr.expected_digest);
+
+    /* A divergence past the ring's capacity is located */
+    asx_trace_reset();
+    emit_map_scenario(MAP_EVENTS, 2500u);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_ENTITY_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, 2500u);
+
+    /* Short and long reruns */
+    asx_trace_reset();
+    emit_map_scenario(MAP_EVENTS - 1u, UINT32_MAX);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_LENGTH_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, MAP_EVENTS - 1u);
+    asx_trace_reset();
+    emit_map_scenario(MAP_EVENTS + 1u, UINT32_MAX);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_LENGTH_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, MAP_EVENTS);
+
+    asx_replay_clear_reference();
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+}
+
+TEST(mapped_reference_rejects_bad_streams)
+{
+    uint32_t len = 0;
+
+    record_map_stream();
+    ASSERT_EQ(asx_replay_map_reference(NULL, 10), ASX_E_INVALID_ARGUMENT);
+
+    /* Truncated last chunk, and a broken digest chain */
+    ASSERT_EQ(asx_replay_map_reference(g_stream, g_stream_len - 1u),
+              ASX_E_INVALID_ARGUMENT);
+    g_stream[ASX_TRACE_BINARY_HEADER + 8u] ^= 0x01u;
+    ASSERT_EQ(asx_replay_map_reference(g_stream, g_stream_len),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* Compact exports must be imported instead */
+    reset_all();
+    run_trace_scenario_simple();
+    ASSERT_EQ(asx_trace_export_compact(g_buf, BUF_SIZE, &len), ASX_OK);
+    ASSERT_EQ(asx_replay_map_reference(g_buf, len), ASX_E_INVALID_ARGUMENT);
+}
+
+/* -------------------------------------------------------------------
+ * Timestamp side column
+ * ------------------------------------------------------------------- */
+
+static asx_time g_trace_clock;
+
+static asx_time trace_clock(void *ctx)
+{
+    (void)ctx;
+    return g_trace_clock;
+}
+
+/* Five events, the clock advancing 100, 200, 300, 400 ns between them */
+static void emit_timed_scenario(void)
+{
+    uint32_t i;
+    g_trace_clock = 5000;
+    for (i = 0; i < 5; i++) {
+        g_trace_clock += 100u * i;
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, 100u + i, i);
+    }
+}
+
+TEST(timestamps_stay_out_of_the_digest)
+{
+    asx_runtime_hooks hooks;
+    uint64_t plain_digest;
+    uint32_t plain_len = 0;
+    uint32_t len = 0;
+    uint32_t delta = 0;
+    uint32_t i;
+
+    reset_all();
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = trace_clock;
+    hooks.clock.logical_now_ns_fn = trace_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+
+    emit_timed_scenario();
+    plain_digest = asx_trace_digest();
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &plain_len), ASX_OK);
+
+    asx_trace_reset();
+    asx_trace_set_timestamps(1);
+    emit_timed_scenario();
+    ASSERT_EQ(asx_trace_digest(), plain_digest);
+    for (i = 0; i < 5; i++) {
+        ASSERT_TRUE(asx_trace_event_delta_ns(i, &delta));
+        ASSERT_EQ(delta, 100u * i);
+    }
+    ASSERT_FALSE(asx_trace_event_delta_ns(5, &delta));
+
+    /* v1 carries a uint32 column after the events */
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &len), ASX_OK);
+    ASSERT_EQ(len, plain_len + 5u * 4u);
+    ASSERT_EQ(g_buf[4], ASX_TRACE_BINARY_VERSION);
+    ASSERT_EQ(g_buf[6], 1u);  /* ASX_TRACE_BINARY_FLAG_TIMES */
+    ASSERT_EQ(g_buf[plain_len + 4u * 4u], 144u);  /* 400 = 0x190 */
+    ASSERT_EQ(g_buf[plain_len + 4u * 4u + 1u], 1u);
+    ASSERT_EQ(asx_trace_continuity_check(g_buf, len), ASX_OK);
+
+    /* v2 carries varints; both still import */
+    ASSERT_EQ(asx_trace_export_compact(g_compact, BUF_SIZE, &len), ASX_OK);
+    ASSERT_EQ(g_compact[6], 1u);
+    ASSERT_EQ(asx_trace_continuity_check(g_compact, len), ASX_OK);
+
+    /* A stamped stream maps and replays like a plain one */
+    asx_trace_reset();
+    g_stream_len = 0;
+    asx_trace_set_sink(append_sink, NULL);
+    emit_timed_scenario();
+    ASSERT_EQ(asx_trace_flush(), ASX_OK);
+    emit_timed_scenario();
+    ASSERT_EQ(asx_trace_flush(), ASX_OK);
+    asx_trace_set_sink(NULL, NULL);
+    ASSERT_EQ(asx_replay_map_reference(g_stream, g_stream_len), ASX_OK);
+    asx_trace_reset();
+    asx_trace_set_timestamps(0);
+    emit_timed_scenario();
+    emit_timed_scenario();
+    ASSERT_EQ(asx_replay_verify().result, ASX_REPLAY_MATCH);
+
+    asx_replay_clear_reference();
+    ASSERT_EQ(asx_trace_timestamps_enabled(), 0);
+}
+
+#ifdef ASX_PROFILE_POSIX
+#include <stdio.h>
+
+TEST(mapped_reference_from_file)
+{
+    const char *path = "asx_test_trace_map.bin";
+    const uint8_t *data = NULL;
+    uint32_t len = 0;
+    FILE *f;
+    asx_replay_result rr;
+
+    reset_all();
+    f = fopen(path, "wb");
+    ASSERT_TRUE(f != NULL);
+    asx_trace_set_sink(asx_platform_trace_file_sink, f);
+    emit_map_scenario(MAP_EVENTS, UINT32_MAX);
+    ASSERT_EQ(asx_trace_flush(), ASX_OK);
+    asx_trace_set_sink(NULL, NULL);
+    ASSERT_EQ(fclose(f), 0);
+
+    ASSERT_EQ(asx_platform_map_file(path, &data, &len), ASX_OK);
+    ASSERT_EQ(asx_replay_map_reference(data, len), ASX_OK);
+    asx_trace_reset();
+    emit_map_scenario(MAP_EVENTS, UINT32_MAX);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+
+    asx_replay_clear_reference();
+    asx_platform_unmap_file(data, len);
+    (void)remove(path);
+    ASSERT_EQ(asx_platform_map_file(path, &data, &len), ASX_E_NOT_FOUND);
+}
+#endif
+
 /* -------------------------------------------------------------------
  * Status string coverage
  * ------------------------------------------------------------------- */
@@ -494,6 +1123,34 @@ int main(void)
     /* Edge cases */
     RUN_TEST(empty_trace_export_import_roundtrip);
 
+    /* Compact format */
+    RUN_TEST(compact_export_roundtrips_and_shrinks);
+    RUN_TEST(compact_handles_wide_and_negative_deltas);
+    RUN_TEST(compact_empty_trace_is_header_only);
+
+    /* Streaming sink */
+    RUN_TEST(sink_streams_chunks_past_capacity);
+    RUN_TEST(sink_chunk_verify_rejects_broken_chain);
+
+    /* Block export */
+    RUN_TEST(export_blocks_match_whole_buffer_export);
+    RUN_TEST(export_blocks_stop_on_writer_error);
+
+    /* Verified prefix */
+    RUN_TEST(history_holds_recent_events_compressed);
+    RUN_TEST(history_rejects_bad_storage);
+    RUN_TEST(verify_resumes_from_verified_prefix);
+
+    /* Mapped replay reference */
+    RUN_TEST(mapped_reference_replays_past_capacity);
+    RUN_TEST(mapped_reference_rejects_bad_streams);
+#ifdef ASX_PROFILE_POSIX
+    RUN_TEST(mapped_reference_from_file);
+#endif
+
+    /* Timestamp side column */
+    RUN_TEST(timestamps_stay_out_of_the_digest);
+
     /* Status string coverage */
     RUN_TEST(new_error_codes_have_strings);
 
@@ -7,9 +7,11 @@
  *   - asx_task_spawn_captured region-arena allocation
  *   - Suspend/resume ordering (deterministic)
  *   - Captured state destruction on task completion
+ *   - Deferred, batched captured state destruction
  *   - Captured state destruction on region drain
  *   - Budget exhaustion during coroutine execution
  *   - Multiple coroutines interleaving within a region
+ *   - ASX_CO_FRAME / ASX_CO_SPAWN frames and the ASX_CO_AWAIT_* parks
  *
  * SPDX-License-Identifier: MIT
  */
@@ -374,6 +376,56 @@ TEST(co_captured_state_dtor_on_complete) {
     ASSERT_EQ(g_dtor_last_size, (uint32_t)sizeof(yield_n_state));
 }
 
+static asx_status complete_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data; (void)self;
+    return ASX_OK;
+}
+
+TEST(co_captured_state_dtor_deferred_in_batches) {
+    asx_region_options opts;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_region_drain_phase phase;
+    void *state_ptr;
+    asx_budget budget;
+    int i;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    reset_dtor_tracker();
+
+    asx_region_options_init(&opts);
+    opts.dtor_batch = 2;
+    ASSERT_EQ(asx_region_open_with(&opts, &rid), ASX_OK);
+    for (i = 1; i <= 5; i++) {
+        ASSERT_EQ(asx_task_spawn_captured(rid, complete_poll,
+                    (uint32_t)sizeof(int), test_dtor,
+                    &tid, &state_ptr), ASX_OK);
+        *(int *)state_ptr = i;
+    }
+
+    /* All five complete in one round; two destructors run at its end */
+    budget = make_budget(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(g_dtor_call_count, 2);
+
+    /* Every round runs the next batch, oldest first */
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(g_dtor_call_count, 4);
+
+    /* Drain charges the rest to its cleanup quota */
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 0, &phase), ASX_E_PENDING);
+    ASSERT_EQ(phase, ASX_REGION_DRAIN_CLEANUP);
+    ASSERT_EQ(g_dtor_call_count, 4);
+    ASSERT_EQ(asx_region_drain_step(rid, &budget, 1, &phase), ASX_OK);
+    ASSERT_EQ(phase, ASX_REGION_DRAIN_DONE);
+    ASSERT_EQ(g_dtor_call_count, 5);
+    for (i = 0; i < 5; i++) {
+        ASSERT_EQ(g_dtor_call_order[i], i + 1);
+    }
+}
+
 TEST(co_error_produces_err_outcome) {
     asx_region_id rid;
     asx_task_id tid;
@@ -584,6 +636,130 @@ TEST(co_state_init_macro) {
     ASSERT_EQ(cs.line, 0u);
 }
 
+/* ------------------------------------------------------------------ */
+/* Frames and awaits                                                   */
+/* ------------------------------------------------------------------ */
+
+ASX_CO_FRAME_BEGIN(reader_frame)
+    asx_channel_id ch;
+    uint64_t       value;
+    uint64_t       sum;
+    asx_status     st;
+    int            polls;
+ASX_CO_FRAME_END(reader_frame);
+
+static asx_status reader_poll(void *user_data, asx_task_id self)
+{
+    reader_frame *f = ASX_CO_FRAME(reader_frame, user_data);
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    for (;;) {
+        ASX_CO_AWAIT_RECV(&f->co, self, f->ch, &f->value, f->st);
+        if (f->st != ASX_OK) break;
+        f->sum += f->value;
+    }
+    ASX_CO_END(&f->co);
+}
+
+ASX_CO_FRAME_BEGIN(waiter_frame)
+    asx_timer_handle     timer;
+    asx_obligation_id    ob;
+    asx_obligation_state ob_state;
+    asx_status           st;
+    int                  polls;
+    int                  phase;
+ASX_CO_FRAME_END(waiter_frame);
+
+static asx_status waiter_poll(void *user_data, asx_task_id self)
+{
+    waiter_frame *f = ASX_CO_FRAME(waiter_frame, user_data);
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    ASX_CO_AWAIT_TIMER(&f->co, self, asx_timer_wheel_global(), &f->timer);
+    f->phase = 1;
+    ASX_CO_AWAIT_OBLIGATION(&f->co, self, f->ob, &f->ob_state, f->st);
+    f->phase = 2;
+    ASX_CO_END(&f->co);
+}
+
+static void send_value(asx_channel_id ch, uint64_t v)
+{
+    asx_send_permit permit;
+    ASSERT_EQ(asx_channel_try_reserve(ch, &permit), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&permit, v), ASX_OK);
+}
+
+TEST(co_frame_await_recv_parks_until_send) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    void *mem = NULL;
+    reader_frame *f;
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(ASX_CO_SPAWN(rid, reader_frame, reader_poll, &tid, &mem), ASX_OK);
+    f = (reader_frame *)mem;
+    ASSERT_EQ(f->co.line, 0u);
+    ASSERT_EQ(asx_channel_create(rid, 4, &f->ch), ASX_OK);
+
+    /* Empty channel: one poll, then parked rather than spinning */
+    budget = make_budget(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->polls, 1);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)1);
+
+    send_value(f->ch, 5);
+    send_value(f->ch, 7);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->polls, 2);
+    ASSERT_EQ(f->sum, (uint64_t)12);
+
+    /* Closing the sender ends the wait with ASX_E_DISCONNECTED */
+    ASSERT_EQ(asx_channel_close_sender(f->ch), ASX_OK);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(f->st, ASX_E_DISCONNECTED);
+    ASSERT_EQ(f->polls, 3);
+}
+
+TEST(co_await_timer_then_obligation) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    void *wakers[2];
+    void *mem = NULL;
+    waiter_frame *f;
+
+    asx_runtime_reset();
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(ASX_CO_SPAWN(rid, waiter_frame, waiter_poll, &tid, &mem), ASX_OK);
+    f = (waiter_frame *)mem;
+    ASSERT_EQ(asx_timer_register(w, 10, NULL, &f->timer), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &f->ob), ASX_OK);
+
+    budget = make_budget(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->phase, 0);
+
+    ASSERT_EQ(asx_timer_collect_expired(w, 10, wakers, 2), (uint32_t)1);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->phase, 1);
+    ASSERT_EQ(f->polls, 2);
+
+    ASSERT_EQ(asx_obligation_commit(f->ob), ASX_OK);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(f->phase, 2);
+    ASSERT_EQ(f->st, ASX_OK);
+    ASSERT_EQ(f->ob_state, ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(f->polls, 3);
+    asx_timer_wheel_reset(w);
+}
+
 /* ================================================================== */
 /* main                                                                */
 /* ================================================================== */
@@ -597,6 +773,7 @@ int main(void) {
     RUN_TEST(co_budget_exhaustion_mid_coroutine);
     RUN_TEST(co_resume_preserves_state);
     RUN_TEST(co_captured_state_dtor_on_complete);
+    RUN_TEST(co_captured_state_dtor_deferred_in_batches);
     RUN_TEST(co_error_produces_err_outcome);
     RUN_TEST(co_interleaved_tasks_deterministic);
     RUN_TEST(co_spawn_captured_null_args);
@@ -604,6 +781,8 @@ int main(void) {
     RUN_TEST(co_captured_state_zero_initialized);
     RUN_TEST(co_capture_arena_exhaustion);
     RUN_TEST(co_state_init_macro);
+    RUN_TEST(co_frame_await_recv_parks_until_send);
+    RUN_TEST(co_await_timer_then_obligation);
 
     TEST_REPORT();
     return test_failures;
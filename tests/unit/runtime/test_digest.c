@@ -0,0 +1,242 @@
+/*
+ * test_digest.c — unit tests for the shared digest module
+ *
+ * Tests: per-domain mode selection, FNV-1a compatibility, WORD64
+ * mixing, and trace exports that record their digest mode so
+ * fixtures written under either mode keep verifying.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/digest.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/telemetry.h>
+#include <asx/runtime/hindsight.h>
+#include <asx/runtime/adapter.h>
+
+#define BUF_SIZE (24u + 64u * 24u)
+static uint8_t g_buf[BUF_SIZE];
+
+static uint32_t read_flags_word(const uint8_t *buf)
+{
+    return (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) |
+           ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 24);
+}
+
+static void emit_scenario(void)
+{
+    asx_trace_emit(ASX_TRACE_REGION_OPEN, 0x10, 0);
+    asx_trace_emit(ASX_TRACE_TASK_SPAWN, 0x20, 0x10);
+    asx_trace_emit(ASX_TRACE_SCHED_POLL, 0x20, 7);
+    asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, 0x20, 0);
+}
+
+/* ---- Mode selection ---- */
+
+TEST(digest_modes_default_to_fnv1a) {
+    asx_digest_reset_modes();
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_TRACE), ASX_DIGEST_FNV1A);
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_TELEMETRY), ASX_DIGEST_FNV1A);
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_HINDSIGHT), ASX_DIGEST_FNV1A);
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_ADAPTER), ASX_DIGEST_FNV1A);
+}
+
+TEST(digest_set_mode_is_per_domain) {
+    asx_digest_reset_modes();
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_HINDSIGHT,
+                                  ASX_DIGEST_WORD64), ASX_OK);
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_HINDSIGHT), ASX_DIGEST_WORD64);
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_TRACE), ASX_DIGEST_FNV1A);
+
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_COUNT, ASX_DIGEST_WORD64),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_TRACE, (asx_digest_mode)9),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_digest_get_mode(ASX_DIGEST_DOMAIN_COUNT), ASX_DIGEST_FNV1A);
+    asx_digest_reset_modes();
+}
+
+/* ---- Mixers ---- */
+
+TEST(digest_fnv1a_matches_reference_vector) {
+    /* FNV-1a 64 of "a" from the standard offset basis */
+    ASSERT_EQ(asx_digest_fnv1a(14695981039346656037ULL, "a", 1),
+              (uint64_t)0xaf63dc4c8601ec8cULL);
+    ASSERT_EQ(asx_digest_bytes(ASX_DIGEST_FNV1A, 14695981039346656037ULL, "a", 1),
+              (uint64_t)0xaf63dc4c8601ec8cULL);
+}
+
+TEST(digest_word64_separates_lengths_and_values) {
+    static const uint8_t zeros[16] = {0};
+    uint32_t a[3] = {1u, 2u, 3u};
+    uint32_t b[3] = {1u, 2u, 4u};
+    uint64_t h7, h8, h9;
+
+    h7 = asx_digest_bytes(ASX_DIGEST_WORD64, 0, zeros, 7);
+    h8 = asx_digest_bytes(ASX_DIGEST_WORD64, 0, zeros, 8);
+    h9 = asx_digest_bytes(ASX_DIGEST_WORD64, 0, zeros, 9);
+    ASSERT_NE(h7, h8);
+    ASSERT_NE(h8, h9);
+
+    ASSERT_NE(asx_digest_u32s(ASX_DIGEST_WORD64, 1, a, 3),
+              asx_digest_u32s(ASX_DIGEST_WORD64, 1, b, 3));
+    ASSERT_EQ(asx_digest_u32s(ASX_DIGEST_FNV1A, 1, a, 3),
+              asx_digest_fnv1a(1, a, sizeof(a)));
+}
+
+TEST(digest_crc32c_matches_check_value_and_chains) {
+    static const char check[] = "123456789";
+    uint8_t bytes[37];
+    uint32_t whole, split;
+    uint32_t i;
+
+    ASSERT_EQ(asx_digest_crc32c(0, check, 9), 0xE3069283u);
+    ASSERT_EQ(asx_digest_crc32c(0, check, 0), 0u);
+
+    /* Chunked feeding crosses the 8-byte stride at odd offsets */
+    for (i = 0; i < sizeof(bytes); i++) bytes[i] = (uint8_t)(i * 37u + 11u);
+    whole = asx_digest_crc32c(0, bytes, sizeof(bytes));
+    split = asx_digest_crc32c(0, bytes, 5);
+    split = asx_digest_crc32c(split, bytes + 5, 19);
+    split = asx_digest_crc32c(split, bytes + 24, sizeof(bytes) - 24u);
+    ASSERT_EQ(whole, split);
+}
+
+/* ---- Trace domain ---- */
+
+TEST(digest_trace_mode_latches_at_reset) {
+    uint64_t d_fnv, d_word;
+    uint32_t len;
+
+    asx_digest_reset_modes();
+    asx_trace_reset();
+    emit_scenario();
+    d_fnv = asx_trace_digest();
+
+    /* Not picked up until the next reset */
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_TRACE, ASX_DIGEST_WORD64),
+              ASX_OK);
+    asx_trace_emit(ASX_TRACE_SCHED_QUIESCENT, 0, 0);
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &len), ASX_OK);
+    ASSERT_EQ(read_flags_word(g_buf) & ASX_TRACE_BINARY_FLAG_WORD_DIGEST, 0u);
+    asx_trace_reset();
+    emit_scenario();
+    d_word = asx_trace_digest();
+    ASSERT_NE(d_fnv, d_word);
+
+    asx_digest_reset_modes();
+    asx_trace_reset();
+    emit_scenario();
+    ASSERT_EQ(asx_trace_digest(), d_fnv);
+}
+
+TEST(digest_trace_exports_verify_under_their_own_mode) {
+    uint32_t fnv_len, word_len;
+    uint8_t fnv_buf[BUF_SIZE];
+    uint64_t out;
+
+    /* One fixture per mode */
+    asx_digest_reset_modes();
+    asx_trace_reset();
+    emit_scenario();
+    ASSERT_EQ(asx_trace_export_binary(fnv_buf, BUF_SIZE, &fnv_len), ASX_OK);
+    ASSERT_EQ(read_flags_word(fnv_buf) & ASX_TRACE_BINARY_FLAG_WORD_DIGEST, 0u);
+
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_TRACE, ASX_DIGEST_WORD64),
+              ASX_OK);
+    asx_trace_reset();
+    emit_scenario();
+    ASSERT_EQ(asx_trace_export_compact(g_buf, BUF_SIZE, &word_len), ASX_OK);
+    ASSERT_NE(read_flags_word(g_buf) & ASX_TRACE_BINARY_FLAG_WORD_DIGEST, 0u);
+
+    /* Under WORD64 the old FNV-1a fixture still imports and replays */
+    ASSERT_EQ(asx_trace_chunk_verify(fnv_buf, fnv_len, 0x517cc1b727220a95ULL,
+                                     &out), ASX_OK);
+    ASSERT_EQ(asx_trace_continuity_check(fnv_buf, fnv_len), ASX_OK);
+
+    /* And back under FNV-1a the WORD64 export does too */
+    asx_digest_reset_modes();
+    asx_trace_reset();
+    emit_scenario();
+    ASSERT_EQ(asx_trace_chunk_verify(g_buf, word_len, 0x517cc1b727220a95ULL,
+                                     &out), ASX_OK);
+    ASSERT_EQ(asx_trace_continuity_check(g_buf, word_len), ASX_OK);
+
+    /* Flipping the flag breaks the digest check */
+    g_buf[6] ^= 0x02u;
+    ASSERT_EQ(asx_trace_import_binary(g_buf, word_len), ASX_E_INVALID_ARGUMENT);
+    asx_replay_clear_reference();
+}
+
+/* ---- Other domains ---- */
+
+#if !ASX_STATIC_PROFILE
+/* Switches tier at runtime, which ASX_STATIC_PROFILE does not allow */
+TEST(digest_telemetry_word64_stays_tier_independent) {
+    uint64_t d_forensic, d_ultra;
+
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_TELEMETRY,
+                                  ASX_DIGEST_WORD64), ASX_OK);
+    asx_telemetry_reset();
+    asx_trace_reset();
+    asx_telemetry_emit(ASX_TRACE_TASK_SPAWN, 0x20, 0x10);
+    asx_telemetry_emit(ASX_TRACE_SCHED_POLL, 0x20, 0);
+    d_forensic = asx_telemetry_digest();
+
+    asx_telemetry_reset();
+    asx_trace_reset();
+    ASSERT_EQ(asx_telemetry_set_tier(ASX_TELEMETRY_ULTRA_MIN), ASX_OK);
+    asx_telemetry_emit(ASX_TRACE_TASK_SPAWN, 0x20, 0x10);
+    asx_telemetry_emit(ASX_TRACE_SCHED_POLL, 0x20, 0);
+    d_ultra = asx_telemetry_digest();
+    ASSERT_EQ(d_forensic, d_ultra);
+
+    asx_digest_reset_modes();
+    asx_telemetry_reset();
+    asx_telemetry_emit(ASX_TRACE_TASK_SPAWN, 0x20, 0x10);
+    asx_telemetry_emit(ASX_TRACE_SCHED_POLL, 0x20, 0);
+    ASSERT_NE(asx_telemetry_digest(), d_forensic);
+    asx_telemetry_reset();
+}
+#endif
+
+TEST(digest_hindsight_and_adapter_follow_their_domains) {
+    asx_adapter_decision a, b;
+    uint64_t h_fnv, h_word;
+
+    asx_digest_reset_modes();
+    asx_hindsight_reset();
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 1, 1000);
+    h_fnv = asx_hindsight_digest();
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_HINDSIGHT,
+                                  ASX_DIGEST_WORD64), ASX_OK);
+    h_word = asx_hindsight_digest();
+    ASSERT_NE(h_fnv, h_word);
+
+    asx_adapter_hft_decide(95, 100, &a);
+    ASSERT_EQ(asx_digest_set_mode(ASX_DIGEST_DOMAIN_ADAPTER,
+                                  ASX_DIGEST_WORD64), ASX_OK);
+    asx_adapter_hft_decide(95, 100, &b);
+    ASSERT_NE(a.decision_hash, b.decision_hash);
+
+    asx_digest_reset_modes();
+    asx_hindsight_reset();
+}
+
+int main(void) {
+    RUN_TEST(digest_modes_default_to_fnv1a);
+    RUN_TEST(digest_set_mode_is_per_domain);
+    RUN_TEST(digest_fnv1a_matches_reference_vector);
+    RUN_TEST(digest_word64_separates_lengths_and_values);
+    RUN_TEST(digest_crc32c_matches_check_value_and_chains);
+    RUN_TEST(digest_trace_mode_latches_at_reset);
+    RUN_TEST(digest_trace_exports_verify_under_their_own_mode);
+#if !ASX_STATIC_PROFILE
+    RUN_TEST(digest_telemetry_word64_stays_tier_independent);
+#endif
+    RUN_TEST(digest_hindsight_and_adapter_follow_their_domains);
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,180 @@
+/*
+ * test_event.c — unit tests for the operation-level event log
+ *
+ * Tests: emit and get across ring eviction, chain equal to a recomputed
+ * chain, checkpoint coarsening, replay verify match and first-mismatch
+ * index, locate from exported checkpoints, and JSON export.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/event.h>
+#include <string.h>
+
+#define EVENTS_MAX 10000u
+
+static asx_event_record g_expected[EVENTS_MAX];
+static uint64_t g_cps[ASX_EVENT_CHECKPOINT_CAPACITY];
+
+/* Emit n events of a fixed pattern, mirroring them into g_expected */
+static void emit_pattern(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        asx_event_record *ev = &g_expected[i];
+
+        ev->kind = (asx_event_kind)(i % (uint32_t)ASX_EVENT_KIND_COUNT);
+        ev->entity_id = 1000u + i;
+        ev->parent_id = i / 4u;
+        ev->status = ASX_OK;
+        ev->sequence = asx_event_emit(ev->kind, ev->entity_id,
+                                      ev->parent_id, ev->status);
+    }
+}
+
+TEST(event_emit_and_get_across_eviction) {
+    asx_event_record rec;
+    uint32_t n = ASX_EVENT_LOG_CAPACITY + 40u;
+
+    asx_event_log_reset();
+    emit_pattern(n);
+    ASSERT_EQ(asx_event_log_count(), n);
+    ASSERT_EQ(g_expected[n - 1u].sequence, n - 1u);
+    ASSERT_EQ(asx_event_log_get(39u, &rec), 0);
+    ASSERT_EQ(asx_event_log_get(40u, &rec), 1);
+    ASSERT_EQ(rec.entity_id, 1040u);
+    ASSERT_EQ(asx_event_log_get(n - 1u, &rec), 1);
+    ASSERT_EQ(rec.sequence, n - 1u);
+    ASSERT_EQ(asx_event_log_get(n, &rec), 0);
+    ASSERT_EQ(asx_event_hash_chain(), asx_event_hash_chain_of(g_expected, n));
+
+    asx_event_log_reset();
+    ASSERT_EQ(asx_event_log_count(), 0u);
+    ASSERT_EQ(asx_event_hash_chain(), asx_event_hash_chain_of(NULL, 0));
+}
+
+TEST(event_checkpoints_coarsen_when_full) {
+    uint32_t n = ASX_EVENT_CHECKPOINT_CAPACITY * ASX_EVENT_CHECKPOINT_INTERVAL;
+    uint32_t held;
+
+    asx_event_log_reset();
+    emit_pattern(n);
+    ASSERT_EQ(asx_event_checkpoint_interval(), ASX_EVENT_CHECKPOINT_INTERVAL);
+    held = asx_event_checkpoints(g_cps, ASX_EVENT_CHECKPOINT_CAPACITY);
+    ASSERT_EQ(held, ASX_EVENT_CHECKPOINT_CAPACITY);
+    ASSERT_EQ(g_cps[0],
+              asx_event_hash_chain_of(g_expected, ASX_EVENT_CHECKPOINT_INTERVAL));
+
+    asx_event_log_reset();
+    emit_pattern(n + 2u * ASX_EVENT_CHECKPOINT_INTERVAL);
+    ASSERT_EQ(asx_event_checkpoints(g_cps, ASX_EVENT_CHECKPOINT_CAPACITY),
+              ASX_EVENT_CHECKPOINT_CAPACITY / 2u + 1u);
+    ASSERT_EQ(g_cps[0], asx_event_hash_chain_of(g_expected,
+                                                2u * ASX_EVENT_CHECKPOINT_INTERVAL));
+    ASSERT_EQ(asx_event_checkpoint_interval(),
+              2u * ASX_EVENT_CHECKPOINT_INTERVAL);
+}
+
+TEST(event_replay_verify_reports_first_divergence) {
+    asx_replay_divergence div;
+    uint32_t n = 700u;
+
+    asx_event_log_reset();
+    emit_pattern(n);
+    ASSERT_EQ(asx_event_replay_verify(g_expected, n, &div), ASX_OK);
+    ASSERT_EQ(div.diverged, 0);
+
+    g_expected[650].status = ASX_E_CANCELLED;
+    ASSERT_EQ(asx_event_replay_verify(g_expected, n, &div),
+              ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(div.diverged, 1);
+    ASSERT_EQ(div.count_mismatch, 0);
+    ASSERT_EQ(div.first_divergence_index, 650u);
+    ASSERT_EQ(div.expected.status, ASX_E_CANCELLED);
+    ASSERT_EQ(div.actual.status, ASX_OK);
+    g_expected[650].status = ASX_OK;
+
+    /* A divergence that has left the ring reports its interval start */
+    g_expected[70].entity_id = 7u;
+    ASSERT_EQ(asx_event_replay_verify(g_expected, n, &div),
+              ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(div.first_divergence_index, 64u);
+    ASSERT_EQ(div.actual.entity_id, 0u);
+    g_expected[70].entity_id = 1070u;
+
+    ASSERT_EQ(asx_event_replay_verify(g_expected, n - 5u, &div),
+              ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(div.count_mismatch, 1);
+    ASSERT_EQ(div.first_divergence_index, n - 5u);
+    ASSERT_EQ(div.expected_count, n - 5u);
+    ASSERT_EQ(div.actual_count, n);
+    ASSERT_EQ(asx_event_replay_verify(NULL, 1u, &div), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(event_replay_locate_uses_exported_checkpoints) {
+    asx_replay_divergence div;
+    uint32_t n = 600u;
+    uint32_t held;
+    uint32_t interval;
+    uint32_t i;
+
+    /* Reference run */
+    asx_event_log_reset();
+    emit_pattern(n);
+    held = asx_event_checkpoints(g_cps, ASX_EVENT_CHECKPOINT_CAPACITY);
+    interval = asx_event_checkpoint_interval();
+    ASSERT_EQ(held, n / ASX_EVENT_CHECKPOINT_INTERVAL);
+
+    ASSERT_EQ(asx_event_replay_locate(g_cps, held, interval, g_expected, n, &div),
+              ASX_OK);
+
+    /* Replay that parts at 500 */
+    asx_event_log_reset();
+    for (i = 0; i < n; i++) {
+        const asx_event_record *ev = &g_expected[i];
+
+        (void)asx_event_emit(i == 500u ? ASX_EVENT_TASK_POLL : ev->kind,
+                             ev->entity_id, ev->parent_id, ev->status);
+    }
+    ASSERT_EQ(asx_event_replay_locate(g_cps, held, interval, g_expected, n, &div),
+              ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(div.first_divergence_index, 500u);
+    ASSERT_EQ(div.actual.kind, ASX_EVENT_TASK_POLL);
+
+    ASSERT_EQ(asx_event_replay_locate(g_cps, held, 48u, g_expected, n, &div),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_event_replay_locate(NULL, held, interval, g_expected, n, &div),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(event_json_lists_retained_events) {
+    static const char head[] =
+        "[{\"sequence\":0,\"kind\":\"region_open\",\"entity\":5,";
+    asx_codec_buffer buf;
+
+    asx_event_log_reset();
+    (void)asx_event_emit(ASX_EVENT_REGION_OPEN, 5u, 0u, ASX_OK);
+    (void)asx_event_emit(ASX_EVENT_TASK_SPAWN, 9u, 5u, ASX_OK);
+    asx_codec_buffer_init(&buf);
+    ASSERT_EQ(asx_event_log_to_json(&buf), ASX_OK);
+    ASSERT_TRUE(strncmp(buf.data, head, sizeof(head) - 1u) == 0);
+    ASSERT_TRUE(strstr(buf.data, "\"kind\":\"task_spawn\"") != NULL);
+    ASSERT_EQ(asx_event_log_to_json(NULL), ASX_E_INVALID_ARGUMENT);
+    asx_codec_buffer_reset(&buf);
+    ASSERT_STR_EQ(asx_event_kind_str(ASX_EVENT_DRAIN_END), "drain_end");
+    ASSERT_STR_EQ(asx_event_kind_str(ASX_EVENT_KIND_COUNT), "unknown");
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_event ===\n");
+    RUN_TEST(event_emit_and_get_across_eviction);
+    RUN_TEST(event_checkpoints_coarsen_when_full);
+    RUN_TEST(event_replay_verify_reports_first_divergence);
+    RUN_TEST(event_replay_locate_uses_exported_checkpoints);
+    RUN_TEST(event_json_lists_retained_events);
+    TEST_REPORT();
+    return test_failures;
+}
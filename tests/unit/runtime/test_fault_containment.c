@@ -553,8 +553,11 @@ TEST(containment_event_ordering_is_deterministic) {
         asx_scheduler_event events_1[256];
         asx_scheduler_event events_2[256];
 
+        /* The ring keeps the newest events; copy those */
         for (i = 0; i < event_count_1 && i < 256u; i++) {
-            (void)asx_scheduler_event_get(i, &events_1[i]);
+            memset(&events_1[i], 0, sizeof(events_1[i]));
+            (void)asx_scheduler_event_get(asx_scheduler_event_first() + i,
+                                          &events_1[i]);
         }
 
         /* Run 2: identical sequence */
@@ -576,7 +579,9 @@ TEST(containment_event_ordering_is_deterministic) {
         ASSERT_EQ(event_count_1, event_count_2);
 
         for (i = 0; i < event_count_2 && i < 256u; i++) {
-            (void)asx_scheduler_event_get(i, &events_2[i]);
+            memset(&events_2[i], 0, sizeof(events_2[i]));
+            (void)asx_scheduler_event_get(asx_scheduler_event_first() + i,
+                                          &events_2[i]);
         }
 
         /* Compare event streams */
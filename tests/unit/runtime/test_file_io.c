@@ -0,0 +1,270 @@
+/*
+ * test_file_io.c — unit tests for asynchronous file writes and fsyncs
+ *
+ * Tests: argument checks and a missing file hook, a task awaiting the
+ * obligation of a write woken when the backend completes it, short
+ * writes, errors and hook refusals aborting the obligation, and on
+ * POSIX the helper thread and (where available) io_uring writing and
+ * syncing a temporary file.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifdef ASX_PROFILE_POSIX
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+
+/* Fake file hook: records submitted ops for the test to complete */
+static asx_file_op *g_submitted[4];
+static uint32_t     g_submit_count;
+static asx_status   g_submit_status;
+
+static asx_status fake_file_submit(void *ctx, asx_file_op *op)
+{
+    (void)ctx;
+    if (g_submit_status != ASX_OK) return g_submit_status;
+    if (g_submit_count >= 4u) return ASX_E_RESOURCE_EXHAUSTED;
+    g_submitted[g_submit_count++] = op;
+    return ASX_OK;
+}
+
+static void file_test_reset(asx_file_submit_fn submit)
+{
+    asx_runtime_hooks hooks;
+
+    asx_runtime_reset();
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.file.submit_fn = submit;
+    (void)asx_runtime_set_hooks(&hooks);
+    g_submit_count = 0;
+    g_submit_status = ASX_OK;
+}
+
+static asx_obligation_state op_state(const asx_file_op *op)
+{
+    asx_obligation_state state = ASX_OBLIGATION_RESERVED;
+
+    if (asx_obligation_get_state(op->obligation, &state) != ASX_OK) {
+        return ASX_OBLIGATION_LEAKED;
+    }
+    return state;
+}
+
+TEST(file_io_checks_arguments) {
+    asx_region_id rid;
+    asx_file_op op;
+    const char data[4] = "abc";
+
+    file_test_reset(NULL);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op, 3, data, 3, 0), ASX_E_HOOK_MISSING);
+    ASSERT_EQ(asx_runtime_file_fsync(rid, &op, 3), ASX_E_HOOK_MISSING);
+
+    file_test_reset(fake_file_submit);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_write(rid, NULL, 3, data, 3, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op, -1, data, 3, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op, 3, NULL, 3, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op, 3, data, 0x80000000u, 0),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_file_fsync(rid, NULL, 3), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_file_fsync(rid, &op, -1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_file_write(ASX_INVALID_ID, &op, 3, data, 3, 0),
+              ASX_E_NOT_FOUND);
+    ASSERT_EQ(g_submit_count, 0u);
+    ASSERT_EQ(asx_runtime_file_complete(NULL, 0), ASX_E_INVALID_ARGUMENT);
+    asx_runtime_reset();
+}
+
+/* Writer: submit a write, then await its obligation */
+ASX_CO_FRAME_BEGIN(writer_frame)
+    asx_file_op          op;
+    asx_obligation_state state;
+    asx_status           st;
+    int                  polls;
+ASX_CO_FRAME_END(writer_frame);
+
+static const char g_payload[] = "trace chunk";
+static asx_region_id g_rid;
+
+static asx_status writer_poll(void *user_data, asx_task_id self)
+{
+    writer_frame *f = ASX_CO_FRAME(writer_frame, user_data);
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    f->st = asx_runtime_file_write(g_rid, &f->op, 5, g_payload,
+                                   (uint32_t)sizeof(g_payload), 0);
+    if (f->st != ASX_OK) return f->st;
+    ASX_CO_AWAIT_OBLIGATION(&f->co, self, f->op.obligation, &f->state, f->st);
+    ASX_CO_END(&f->co);
+}
+
+TEST(file_io_completion_wakes_awaiting_task) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    writer_frame *f;
+    void *mem = NULL;
+    int parked = 0;
+
+    file_test_reset(fake_file_submit);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    g_rid = rid;
+    ASSERT_EQ(ASX_CO_SPAWN(rid, writer_frame, writer_poll, &tid, &mem), ASX_OK);
+    f = (writer_frame *)mem;
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(g_submit_count, 1u);
+    ASSERT_TRUE(g_submitted[0] == &f->op);
+    ASSERT_EQ(f->op.kind, (uint32_t)ASX_FILE_OP_WRITE);
+    ASSERT_EQ(f->op.len, (uint32_t)sizeof(g_payload));
+    ASSERT_EQ(asx_task_is_parked(tid, &parked), ASX_OK);
+    ASSERT_EQ(parked, 1);
+
+    ASSERT_EQ(asx_runtime_file_complete(&f->op, (int32_t)sizeof(g_payload)), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_complete(&f->op, 0), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_parked_count(), 0u);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(f->polls, 2);
+    ASSERT_EQ(f->st, ASX_OK);
+    ASSERT_EQ(f->state, ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(f->op.result, (int32_t)sizeof(g_payload));
+    asx_runtime_reset();
+}
+
+TEST(file_io_failures_abort_obligation) {
+    asx_region_id rid;
+    asx_file_op op[4];
+    const char data[8] = "0123456";
+
+    file_test_reset(fake_file_submit);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op[0], 3, data, 8, 0), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op[1], 3, data, 8, 64), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_fsync(rid, &op[2], 3), ASX_OK);
+    ASSERT_EQ(op[1].offset, (uint64_t)64u);
+    ASSERT_EQ(op[2].kind, (uint32_t)ASX_FILE_OP_FSYNC);
+    ASSERT_EQ(op_state(&op[0]), ASX_OBLIGATION_RESERVED);
+
+    /* A short write and an error abort; a clean fsync commits */
+    ASSERT_EQ(asx_runtime_file_complete(&op[0], 5), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_complete(&op[1], -28), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_complete(&op[2], 0), ASX_OK);
+    ASSERT_EQ(op_state(&op[0]), ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(op_state(&op[1]), ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(op_state(&op[2]), ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(op[1].result, -28);
+
+    /* A hook refusal is returned with the obligation already aborted */
+    g_submit_status = ASX_E_RESOURCE_EXHAUSTED;
+    ASSERT_EQ(asx_runtime_file_fsync(rid, &op[3], 3), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(op_state(&op[3]), ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(op[3].done, 1u);
+    asx_runtime_reset();
+}
+
+#ifdef ASX_PROFILE_POSIX
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Write two chunks out of order and sync, completing through wait */
+static void write_and_sync(asx_reactor_wait_fn wait, void *ctx)
+{
+    asx_region_id rid;
+    asx_file_op op[3];
+    char path[] = "/tmp/asx_file_io_XXXXXX";
+    char back[8];
+    uint32_t ready;
+    uint32_t done = 0;
+    uint32_t i;
+    int fd;
+
+    fd = mkstemp(path);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op[0], fd, "efgh", 4, 4), ASX_OK);
+    ASSERT_EQ(asx_runtime_file_write(rid, &op[1], fd, "abcd", 4, 0), ASX_OK);
+
+    for (i = 0; i < 100u && done < 2u; i++) {
+        ASSERT_EQ(wait(ctx, 1000, &ready), ASX_OK);
+        done += ready;
+    }
+    ASSERT_EQ(done, 2u);
+    /* Checked now: the fsync's reserve may reuse a resolved slot */
+    for (i = 0; i < 2u; i++) {
+        ASSERT_EQ(op[i].done, 1u);
+        ASSERT_EQ(op[i].result, 4);
+        ASSERT_EQ(op_state(&op[i]), ASX_OBLIGATION_COMMITTED);
+    }
+    ASSERT_EQ(asx_runtime_file_fsync(rid, &op[2], fd), ASX_OK);
+    for (i = 0; i < 100u && done < 3u; i++) {
+        ASSERT_EQ(wait(ctx, 1000, &ready), ASX_OK);
+        done += ready;
+    }
+    ASSERT_EQ(done, 3u);
+    ASSERT_EQ(op[2].done, 1u);
+    ASSERT_EQ(op[2].result, 0);
+    ASSERT_EQ(op_state(&op[2]), ASX_OBLIGATION_COMMITTED);
+
+    /* Nothing in flight: a timed wait returns at once */
+    ASSERT_EQ(wait(ctx, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+
+    ASSERT_EQ(pread(fd, back, sizeof(back), 0), (ssize_t)sizeof(back));
+    ASSERT_TRUE(memcmp(back, "abcdefgh", sizeof(back)) == 0);
+    (void)close(fd);
+    (void)unlink(path);
+}
+
+TEST(file_io_helper_thread_writes_file) {
+    asx_runtime_hooks hooks;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_file_thread_install(&hooks), ASX_OK);
+    ASSERT_TRUE(hooks.file.submit_fn == asx_platform_file_thread_submit);
+    ASSERT_TRUE(hooks.reactor.wait_fn == asx_platform_file_thread_wait);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    write_and_sync(asx_platform_file_thread_wait, NULL);
+    asx_runtime_reset();
+}
+
+TEST(file_io_uring_writes_file) {
+    static asx_platform_uring ring;
+    asx_runtime_hooks hooks;
+
+    asx_runtime_reset();
+    if (asx_platform_uring_open(&ring, 8) != ASX_OK) {
+        return; /* io_uring unavailable on this host */
+    }
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_uring_install(&ring, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.file.ctx == &ring);
+    ASSERT_TRUE(hooks.file.submit_fn == asx_platform_uring_file_submit);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    write_and_sync(asx_platform_uring_wait, &ring);
+    asx_platform_uring_close(&ring);
+    asx_runtime_reset();
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "=== test_file_io ===\n");
+    RUN_TEST(file_io_checks_arguments);
+    RUN_TEST(file_io_completion_wakes_awaiting_task);
+    RUN_TEST(file_io_failures_abort_obligation);
+#ifdef ASX_PROFILE_POSIX
+    RUN_TEST(file_io_helper_thread_writes_file);
+    RUN_TEST(file_io_uring_writes_file);
+#endif
+    TEST_REPORT();
+    return test_failures;
+}
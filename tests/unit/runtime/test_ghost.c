@@ -8,6 +8,7 @@
  *   - Violation ring buffer: count, retrieval, overflow
  *   - Query interface: violation_get, ring_overflowed, kind_str
  *   - Integration with lifecycle operations
+ *   - Sampled mode: 1-in-N region selection, hindsight routing
  *
  * SPDX-License-Identifier: MIT
  */
@@ -24,6 +25,7 @@
 #include <asx/core/transition.h>
 #include <asx/core/budget.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/hindsight.h>
 
 /* ------------------------------------------------------------------ */
 /* Budget helper                                                       */
@@ -198,6 +200,36 @@ TEST(ghost_linearity_multiple_leaks) {
     ASSERT_EQ(asx_ghost_violation_count(), 3u);
 }
 
+TEST(ghost_linearity_tracks_beyond_old_table_and_recycled_slots) {
+    asx_obligation_id base = 0x0003000100000000ULL;
+    asx_obligation_id stale = base | asx_handle_pack_index(1u, 7u);
+    asx_obligation_id fresh = base | asx_handle_pack_index(2u, 7u);
+    uint32_t i;
+
+    asx_ghost_reset();
+
+    /* Thousands of reserve/resolve pairs stay tracked */
+    for (i = 0; i < 4000u; i++) {
+        asx_obligation_id oid = base | asx_handle_pack_index(
+            (uint16_t)(i >> 8), (uint16_t)(i & 0xFFu));
+        asx_ghost_obligation_reserved(oid);
+        asx_ghost_obligation_resolved(oid);
+    }
+    ASSERT_EQ(asx_ghost_check_obligation_leaks(ASX_INVALID_ID), 0u);
+
+    /* A slot reused by a new generation: the old handle is not the
+     * live one, the new one is tracked on its own */
+    asx_ghost_obligation_reserved(stale);
+    asx_ghost_obligation_reserved(fresh);
+    asx_ghost_obligation_resolved(stale);
+    ASSERT_EQ(asx_ghost_violation_count(), 0u);
+    ASSERT_EQ(asx_ghost_check_obligation_leaks(ASX_INVALID_ID), 1u);
+    asx_ghost_obligation_resolved(fresh);
+    asx_ghost_obligation_resolved(fresh);
+    ASSERT_EQ(asx_ghost_violation_count(), 2u); /* the leak, then double */
+    ASSERT_EQ(asx_ghost_check_obligation_leaks(ASX_INVALID_ID), 0u);
+}
+
 /* ================================================================== */
 /* Violation Ring Buffer Tests                                         */
 /* ================================================================== */
@@ -361,6 +393,58 @@ TEST(ghost_lifecycle_obligation_abort) {
     ASSERT_EQ(asx_ghost_check_obligation_leaks(ASX_INVALID_ID), 0u);
 }
 
+/* ================================================================== */
+/* Sampled Mode Tests                                                  */
+/* ================================================================== */
+
+TEST(ghost_sampled_mode_checks_one_region_in_n) {
+    static asx_hindsight_flush_buffer out;
+    asx_region_id rids[ASX_MAX_REGIONS];
+    asx_obligation_id oid;
+    uint32_t i;
+    uint32_t sampled = 0;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    asx_hindsight_reset();
+    asx_ghost_set_sampling(2);
+    ASSERT_EQ(asx_ghost_sampling(), 2u);
+
+    /* One leaked obligation per region; only sampled ones are tracked */
+    for (i = 0; i < ASX_MAX_REGIONS; i++) {
+        ASSERT_EQ(asx_region_open(&rids[i]), ASX_OK);
+        ASSERT_EQ(asx_obligation_reserve(rids[i], &oid), ASX_OK);
+        if (asx_ghost_region_sampled(rids[i])) sampled++;
+    }
+    ASSERT_TRUE(sampled > 0u && sampled < ASX_MAX_REGIONS);
+    ASSERT_EQ(asx_ghost_check_obligation_leaks(ASX_INVALID_ID), sampled);
+
+    /* Decisions depend only on the handle */
+    for (i = 0; i < ASX_MAX_REGIONS; i++) {
+        ASSERT_EQ(asx_ghost_region_sampled(rids[i]),
+                  asx_ghost_region_sampled(rids[i]));
+    }
+
+    /* Illegal transitions are reported always, recorded when sampled;
+     * recording routes a flush of the hindsight ring */
+    asx_ghost_reset();
+    asx_hindsight_route_ghost(&out);
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 42);
+    for (i = 0; i < ASX_MAX_REGIONS; i++) {
+        ASSERT_EQ(asx_ghost_check_region_transition(rids[i],
+                      ASX_REGION_CLOSED, ASX_REGION_OPEN),
+                  ASX_E_INVALID_TRANSITION);
+    }
+    ASSERT_EQ(asx_ghost_violation_count(), sampled);
+    ASSERT_EQ(asx_hindsight_ghost_flush_count(), sampled);
+    ASSERT_TRUE(out.len > 0u);
+
+    asx_hindsight_route_ghost(NULL);
+    asx_ghost_set_sampling(1);
+    ASSERT_EQ(asx_ghost_sampling(), 1u);
+    ASSERT_TRUE(asx_ghost_region_sampled(rids[0]));
+}
+
 /* ================================================================== */
 /* main                                                                */
 /* ================================================================== */
@@ -381,6 +465,7 @@ int main(void) {
     RUN_TEST(ghost_linearity_double_resolve);
     RUN_TEST(ghost_linearity_leak_detection);
     RUN_TEST(ghost_linearity_multiple_leaks);
+    RUN_TEST(ghost_linearity_tracks_beyond_old_table_and_recycled_slots);
 
     /* Ring buffer */
     RUN_TEST(ghost_violation_get_empty);
@@ -398,6 +483,9 @@ int main(void) {
     RUN_TEST(ghost_lifecycle_legal_workflow);
     RUN_TEST(ghost_lifecycle_obligation_abort);
 
+    /* Sampled mode */
+    RUN_TEST(ghost_sampled_mode_checks_one_region_in_n);
+
     TEST_REPORT();
     return test_failures;
 }
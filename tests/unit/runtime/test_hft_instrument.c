@@ -3,10 +3,12 @@
  *
  * Verifies:
  *   - Histogram bin assignment and percentile computation
+ *   - Log-linear histogram precision, merge and binary round trip
  *   - Jitter tracker (MAD) computation
  *   - Deterministic overload policy evaluation
  *   - Metric gate pass/fail thresholds
  *   - Global instrumentation state management
+ *   - Per-worker histograms folded by snapshots
  *
  * SPDX-License-Identifier: MIT
  */
@@ -189,6 +191,150 @@ TEST(histogram_min_max_tracked)
     ASSERT_EQ(h.max_ns, (uint64_t)200);
 }
 
+/* ===================================================================
+ * Log-linear histogram tests
+ * =================================================================== */
+
+/* Histograms are large; keep them off the test stack */
+static asx_hft_hdr g_hdr_a;
+static asx_hft_hdr g_hdr_b;
+
+TEST(hdr_init_rejects_bad_layout)
+{
+    ASSERT_EQ(asx_hft_hdr_init(NULL, 5, 36), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_a, 0, 36), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_a, ASX_HFT_HDR_PRECISION_MAX + 1u, 36),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_a, 5, 5), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_a, 5, ASX_HFT_HDR_RANGE_BITS_MAX + 1u),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_a, ASX_HFT_HDR_PRECISION_MAX,
+                               ASX_HFT_HDR_RANGE_BITS_MAX), ASX_OK);
+    ASSERT_EQ(g_hdr_a.bucket_count, ASX_HFT_HDR_COUNTS_MAX);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P99), (uint64_t)0);
+}
+
+TEST(hdr_values_within_relative_precision)
+{
+    uint64_t v;
+    uint64_t got;
+
+    /* Every value reads back at or above itself, within 2^-precision */
+    for (v = 1; v < (UINT64_C(1) << 35); v = v * 3u + 1u) {
+        asx_hft_hdr_init_default(&g_hdr_a);
+        asx_hft_hdr_record(&g_hdr_a, v);
+        asx_hft_hdr_record(&g_hdr_a, UINT64_C(1) << 35);
+        got = asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P50);
+        ASSERT_TRUE(got >= v);
+        ASSERT_TRUE(got - v <= v >> ASX_HFT_HDR_DEFAULT_PRECISION);
+    }
+
+    /* Small values are exact */
+    asx_hft_hdr_init_default(&g_hdr_a);
+    asx_hft_hdr_record(&g_hdr_a, 0);
+    asx_hft_hdr_record(&g_hdr_a, 37);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, 0), (uint64_t)0);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P50), (uint64_t)0);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, 1000000u), (uint64_t)37);
+    ASSERT_EQ(asx_hft_hdr_mean(&g_hdr_a), (uint64_t)18);
+}
+
+TEST(hdr_overflow_clamps_to_top_bucket)
+{
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_a, 3, 10), ASX_OK);
+    asx_hft_hdr_record(&g_hdr_a, 5000);
+    ASSERT_EQ(g_hdr_a.overflow, (uint64_t)1);
+    ASSERT_EQ(g_hdr_a.counts[g_hdr_a.bucket_count - 1u], 1u);
+    ASSERT_EQ(g_hdr_a.max_ns, (uint64_t)5000);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, 1000000u), (uint64_t)1023);
+}
+
+TEST(hdr_gate_sees_multi_second_tail)
+{
+    asx_hft_gate gate;
+    asx_hft_gate_result result;
+    uint64_t stall = UINT64_C(5000000000); /* 5 s */
+    uint32_t i;
+
+    asx_hft_hdr_init_default(&g_hdr_a);
+    for (i = 0; i < 9990; i++) asx_hft_hdr_record(&g_hdr_a, 1000);
+    for (i = 0; i < 10; i++) asx_hft_hdr_record(&g_hdr_a, stall);
+
+    ASSERT_TRUE(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P99) < 1032);
+    ASSERT_TRUE(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P99_9) < 1032);
+    ASSERT_TRUE(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P99_99) >=
+                stall - (stall >> ASX_HFT_HDR_DEFAULT_PRECISION));
+
+    asx_hft_gate_init(&gate);
+    gate.p99_9_ns = 2000;
+    gate.p99_99_ns = 1000000;
+    asx_hft_gate_evaluate_hdr(&gate, &g_hdr_a, NULL, &result);
+    ASSERT_EQ(result.pass, 0);
+    ASSERT_EQ(result.violations, ASX_GATE_VIOLATION_P99_99);
+    ASSERT_EQ(result.actual_p99_99, stall);
+}
+
+TEST(hdr_merge_adds_counts)
+{
+    uint32_t i;
+
+    asx_hft_hdr_init_default(&g_hdr_a);
+    asx_hft_hdr_init_default(&g_hdr_b);
+    for (i = 0; i < 100; i++) asx_hft_hdr_record(&g_hdr_a, 10);
+    for (i = 0; i < 100; i++) asx_hft_hdr_record(&g_hdr_b, 90000);
+
+    ASSERT_EQ(asx_hft_hdr_merge(&g_hdr_a, &g_hdr_b), ASX_OK);
+    ASSERT_EQ(g_hdr_a.total, (uint64_t)200);
+    ASSERT_EQ(g_hdr_a.min_ns, (uint64_t)10);
+    ASSERT_EQ(g_hdr_a.max_ns, (uint64_t)90000);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P50), (uint64_t)10);
+    ASSERT_EQ(asx_hft_hdr_value_at(&g_hdr_a, ASX_HFT_PPM_P99), (uint64_t)90000);
+
+    ASSERT_EQ(asx_hft_hdr_init(&g_hdr_b, 4, 36), ASX_OK);
+    ASSERT_EQ(asx_hft_hdr_merge(&g_hdr_a, &g_hdr_b), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hft_hdr_merge(NULL, &g_hdr_b), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(hdr_binary_round_trip)
+{
+    uint8_t buf[256];
+    uint32_t len = 0;
+    uint32_t needed = 0;
+    uint32_t i;
+
+    asx_hft_hdr_init_default(&g_hdr_a);
+    for (i = 0; i < 50; i++) asx_hft_hdr_record(&g_hdr_a, 100u + i * 7u);
+    asx_hft_hdr_record(&g_hdr_a, UINT64_C(3000000000));
+
+    ASSERT_EQ(asx_hft_hdr_export(&g_hdr_a, NULL, 0, &needed), ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_TRUE(needed > 8u && needed <= sizeof(buf));
+    ASSERT_EQ(asx_hft_hdr_export(&g_hdr_a, buf, needed - 1u, &len),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(asx_hft_hdr_export(&g_hdr_a, buf, sizeof(buf), &len), ASX_OK);
+    ASSERT_EQ(len, needed);
+
+    ASSERT_EQ(asx_hft_hdr_import(buf, len, &g_hdr_b), ASX_OK);
+    ASSERT_EQ(g_hdr_b.precision, g_hdr_a.precision);
+    ASSERT_EQ(g_hdr_b.range_bits, g_hdr_a.range_bits);
+    ASSERT_EQ(g_hdr_b.total, g_hdr_a.total);
+    ASSERT_EQ(g_hdr_b.sum_ns, g_hdr_a.sum_ns);
+    ASSERT_EQ(g_hdr_b.min_ns, g_hdr_a.min_ns);
+    ASSERT_EQ(g_hdr_b.max_ns, g_hdr_a.max_ns);
+    ASSERT_TRUE(memcmp(g_hdr_b.counts, g_hdr_a.counts,
+                       sizeof(g_hdr_a.counts)) == 0);
+
+    /* Truncated, trailing or corrupted input is rejected */
+    ASSERT_EQ(asx_hft_hdr_import(buf, len - 1u, &g_hdr_b), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(g_hdr_b.total, (uint64_t)0);
+    buf[len] = 0;
+    ASSERT_EQ(asx_hft_hdr_import(buf, len + 1u, &g_hdr_b), ASX_E_INVALID_ARGUMENT);
+    buf[0] ^= 0xFFu;
+    ASSERT_EQ(asx_hft_hdr_import(buf, len, &g_hdr_b), ASX_E_INVALID_ARGUMENT);
+    buf[0] ^= 0xFFu;
+    buf[5] = 0;
+    ASSERT_EQ(asx_hft_hdr_import(buf, len, &g_hdr_b), ASX_E_INVALID_ARGUMENT);
+}
+
 /* ===================================================================
  * Jitter tracker tests
  * =================================================================== */
@@ -207,15 +353,14 @@ TEST(jitter_uniform_low)
     asx_hft_jitter_tracker jt;
     uint32_t i;
 
-    asx_hft_jitter_init(&jt, 0);  /* recompute every sample */
+    asx_hft_jitter_init(&jt, 0);  /* default window */
 
-    /* All same value (0) — bin midpoint equals mean, so MAD = 0 */
+    /* A constant signal has no deviation from its mean */
     for (i = 0; i < 100; i++) {
-        asx_hft_jitter_record(&jt, 0);
+        asx_hft_jitter_record(&jt, 700);
     }
-
-    /* All samples in bin 0 (midpoint=0), mean=0, MAD=0 */
     ASSERT_EQ(asx_hft_jitter_get(&jt), (uint64_t)0);
+    ASSERT_EQ(jt.shift, 4u);
 }
 
 TEST(jitter_bimodal_nonzero)
@@ -236,25 +381,49 @@ TEST(jitter_bimodal_nonzero)
     ASSERT_TRUE(asx_hft_jitter_get(&jt) > 0);
 }
 
-TEST(jitter_recompute_interval)
+TEST(jitter_streaming_follows_step)
 {
     asx_hft_jitter_tracker jt;
     uint32_t i;
-    uint64_t jitter_before;
 
-    asx_hft_jitter_init(&jt, 10);  /* recompute every 10 samples */
+    asx_hft_jitter_init(&jt, 10);  /* rounds down to a window of 8 */
+    ASSERT_EQ(jt.shift, 3u);
 
-    /* First 9 samples at value 0: jitter not yet recomputed */
-    for (i = 0; i < 9; i++) {
-        asx_hft_jitter_record(&jt, 0);
+    for (i = 0; i < 100; i++) {
+        asx_hft_jitter_record(&jt, 1000);
     }
-    jitter_before = asx_hft_jitter_get(&jt);
-    ASSERT_EQ(jitter_before, (uint64_t)0);  /* not yet triggered */
-
-    /* 10th sample (also 0) triggers recompute */
-    asx_hft_jitter_record(&jt, 0);
-    /* All samples at 0 (bin 0, midpoint 0), mean 0, MAD 0 */
     ASSERT_EQ(asx_hft_jitter_get(&jt), (uint64_t)0);
+
+    /* A step shows up on the first sample: 1000 ns away, weight 1/8 */
+    asx_hft_jitter_record(&jt, 2000);
+    ASSERT_EQ(asx_hft_jitter_get(&jt), (uint64_t)125);
+
+    /* ... and decays once the mean has caught up */
+    for (i = 0; i < 200; i++) {
+        asx_hft_jitter_record(&jt, 2000);
+    }
+    ASSERT_TRUE(asx_hft_jitter_get(&jt) < 10);
+}
+
+TEST(jitter_streaming_alternating_signal)
+{
+    asx_hft_jitter_tracker jt;
+    uint32_t i;
+    uint64_t j;
+
+    asx_hft_jitter_init(&jt, 16);
+
+    /* 1000/3000 alternating: every sample is ~1000 ns off the mean */
+    for (i = 0; i < 400; i++) {
+        asx_hft_jitter_record(&jt, (i & 1u) ? 3000u : 1000u);
+    }
+    j = asx_hft_jitter_get(&jt);
+    ASSERT_TRUE(j >= 900 && j <= 1100);
+
+    /* The bin-derived MAD is only refreshed on request */
+    ASSERT_EQ(asx_hft_jitter_binned(&jt), (uint64_t)0);
+    asx_hft_jitter_recompute(&jt);
+    ASSERT_TRUE(asx_hft_jitter_binned(&jt) > 0);
 }
 
 TEST(jitter_reset)
@@ -561,16 +730,76 @@ TEST(global_record_updates_jitter)
 
     asx_hft_instrument_reset();
 
-    /* Record enough samples to trigger jitter recompute (every 64) */
+    /* Every sample updates the streaming estimate */
     for (i = 0; i < 64; i++) {
         asx_hft_record_poll_latency(0);
     }
 
     jt = asx_hft_sched_jitter();
-    /* All same value (0) in bin 0 = zero MAD */
+    /* Constant samples: zero MAD */
     ASSERT_EQ(asx_hft_jitter_get(jt), (uint64_t)0);
 }
 
+TEST(histogram_merge_adds_bins)
+{
+    asx_hft_histogram a;
+    asx_hft_histogram b;
+
+    asx_hft_histogram_init(&a);
+    asx_hft_histogram_init(&b);
+    asx_hft_histogram_record(&a, 3);
+    asx_hft_histogram_record(&b, 3);
+    asx_hft_histogram_record(&b, 40000);
+
+    asx_hft_histogram_merge(&a, &b);
+    ASSERT_EQ(a.total, 3u);
+    ASSERT_EQ(a.bins[2], 2u);
+    ASSERT_EQ(a.overflow, 1u);
+    ASSERT_EQ(a.min_ns, (uint64_t)3);
+    ASSERT_EQ(a.max_ns, (uint64_t)40000);
+    ASSERT_EQ(a.sum_ns, (uint64_t)40006);
+}
+
+TEST(worker_histograms_fold_on_snapshot)
+{
+    asx_hft_histogram snap;
+    asx_hft_gate gate;
+    asx_hft_gate_result result;
+    uint32_t i;
+
+    asx_hft_instrument_reset();
+    ASSERT_EQ(asx_hft_sched_snapshot(NULL), ASX_E_INVALID_ARGUMENT);
+
+    for (i = 0; i < 10; i++) asx_hft_record_worker_poll_latency(0, 100);
+    for (i = 0; i < 10; i++) asx_hft_record_worker_poll_latency(3, 20000);
+    asx_hft_record_worker_poll_latency(ASX_HFT_MAX_WORKERS, 1);
+    asx_hft_record_poll_latency(500);
+
+    /* Worker samples stay out of the global histogram until folded */
+    ASSERT_EQ(asx_hft_sched_histogram()->total, 1u);
+    ASSERT_EQ(asx_hft_sched_snapshot(&snap), ASX_OK);
+    ASSERT_EQ(snap.total, 21u);
+    ASSERT_EQ(snap.min_ns, (uint64_t)100);
+    ASSERT_EQ(snap.max_ns, (uint64_t)20000);
+
+    asx_hft_gate_init(&gate);
+    gate.p99_ns = 1000;
+    asx_hft_gate_evaluate(&gate, &snap, NULL, &result);
+    ASSERT_TRUE(result.violations & ASX_GATE_VIOLATION_P99);
+
+    /* Records after the swap go to the other side; totals accumulate */
+    for (i = 0; i < 5; i++) asx_hft_record_worker_poll_latency(0, 50);
+    ASSERT_EQ(asx_hft_sched_snapshot(&snap), ASX_OK);
+    ASSERT_EQ(snap.total, 26u);
+    ASSERT_EQ(snap.min_ns, (uint64_t)50);
+    ASSERT_EQ(asx_hft_sched_snapshot(&snap), ASX_OK);
+    ASSERT_EQ(snap.total, 26u);
+
+    asx_hft_instrument_reset();
+    ASSERT_EQ(asx_hft_sched_snapshot(&snap), ASX_OK);
+    ASSERT_EQ(snap.total, 0u);
+}
+
 /* ===================================================================
  * Runner
  * =================================================================== */
@@ -590,11 +819,20 @@ int main(void)
     RUN_TEST(histogram_reset);
     RUN_TEST(histogram_min_max_tracked);
 
+    /* Log-linear histogram */
+    RUN_TEST(hdr_init_rejects_bad_layout);
+    RUN_TEST(hdr_values_within_relative_precision);
+    RUN_TEST(hdr_overflow_clamps_to_top_bucket);
+    RUN_TEST(hdr_gate_sees_multi_second_tail);
+    RUN_TEST(hdr_merge_adds_counts);
+    RUN_TEST(hdr_binary_round_trip);
+
     /* Jitter tracker */
     RUN_TEST(jitter_init_zero);
     RUN_TEST(jitter_uniform_low);
     RUN_TEST(jitter_bimodal_nonzero);
-    RUN_TEST(jitter_recompute_interval);
+    RUN_TEST(jitter_streaming_follows_step);
+    RUN_TEST(jitter_streaming_alternating_signal);
     RUN_TEST(jitter_reset);
 
     /* Overload policy */
@@ -621,6 +859,8 @@ int main(void)
     RUN_TEST(global_instrument_reset);
     RUN_TEST(global_record_poll_latency);
     RUN_TEST(global_record_updates_jitter);
+    RUN_TEST(histogram_merge_adds_bins);
+    RUN_TEST(worker_histograms_fold_on_snapshot);
 
     TEST_REPORT();
     return test_failures > 0 ? 1 : 0;
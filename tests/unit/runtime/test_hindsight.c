@@ -446,6 +446,7 @@ static void setup_hooks(void) {
     asx_runtime_set_hooks(&hooks);
 }
 
+#if ASX_HINDSIGHT
 TEST(hindsight_clock_read_produces_event) {
     asx_hindsight_event ev;
     asx_time now;
@@ -494,6 +495,23 @@ TEST(hindsight_multiple_hook_calls_accumulate) {
 
     ASSERT_EQ(asx_hindsight_total_count(), (uint32_t)3);
 }
+#else
+/* Compiled out: hook reads leave the ring alone */
+TEST(hindsight_hook_reads_log_nothing) {
+    asx_time now;
+    uint64_t val;
+
+    asx_hindsight_reset();
+    asx_trace_reset();
+    setup_hooks();
+
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_EQ(asx_runtime_random_u64(&val), ASX_OK);
+
+    ASSERT_EQ(asx_hindsight_total_count(), (uint32_t)0);
+    ASSERT_EQ(asx_hindsight_digest(), (uint64_t)0x517cc1b727220a95ULL);
+}
+#endif
 
 /* ---- Flush policy ---- */
 
@@ -581,6 +599,7 @@ TEST(hindsight_check_divergence_empty_ring) {
 
 /* ---- Digest stability with hook integration ---- */
 
+#if ASX_HINDSIGHT
 TEST(hindsight_hook_events_digest_stable_across_runs) {
     uint64_t d1, d2;
     asx_time now;
@@ -608,6 +627,243 @@ TEST(hindsight_hook_events_digest_stable_across_runs) {
     /* Run 1 digest should NOT equal FNV offset (we logged events) */
     ASSERT_TRUE(d1 != d2);
 }
+#endif
+
+/* ---- Binary flush and deferred render ---- */
+
+static uint8_t g_dump[ASX_HINDSIGHT_DUMP_HEADER +
+                      ASX_HINDSIGHT_CAPACITY * sizeof(asx_hindsight_event)];
+static asx_hindsight_flush_buffer g_live_json;
+static asx_hindsight_flush_buffer g_late_json;
+
+TEST(hindsight_binary_dump_renders_like_live_flush) {
+    uint32_t len;
+    uint32_t i;
+
+    asx_hindsight_reset();
+    asx_trace_reset();
+    for (i = 0; i < ASX_HINDSIGHT_CAPACITY + 7u; i++) {
+        asx_hindsight_log(ASX_ND_IO_READY, (uint64_t)i, (uint64_t)i * 3u);
+    }
+
+    ASSERT_EQ(asx_hindsight_flush_binary(g_dump, sizeof(g_dump), &len), ASX_OK);
+    ASSERT_EQ(asx_hindsight_flush_json(&g_live_json), ASX_OK);
+
+    /* Later activity does not touch the dump */
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 1, 1);
+    ASSERT_EQ(asx_hindsight_render_json(g_dump, len, &g_late_json), ASX_OK);
+    ASSERT_EQ(g_late_json.len, g_live_json.len);
+    ASSERT_TRUE(memcmp(g_late_json.data, g_live_json.data, g_live_json.len) == 0);
+}
+
+TEST(hindsight_binary_dump_rejects_short_and_foreign_buffers) {
+    uint32_t len;
+    uint32_t needed;
+
+    asx_hindsight_reset();
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 1, 2);
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 3, 4);
+
+    ASSERT_EQ(asx_hindsight_flush_binary(g_dump, 8, &needed),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(needed, ASX_HINDSIGHT_DUMP_HEADER +
+                      2u * (uint32_t)sizeof(asx_hindsight_event));
+    ASSERT_EQ(asx_hindsight_flush_binary(g_dump, needed, &len), ASX_OK);
+    ASSERT_EQ(len, needed);
+
+    ASSERT_EQ(asx_hindsight_render_json(g_dump, len - 1u, &g_late_json),
+              ASX_E_INVALID_ARGUMENT);
+    g_dump[0] ^= 0xFFu;
+    ASSERT_EQ(asx_hindsight_render_json(g_dump, len, &g_late_json),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hindsight_render_json(NULL, len, &g_late_json),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(hindsight_init_with_caller_storage) {
+    asx_hindsight_event storage[4];
+    asx_hindsight_event ev;
+    uint32_t i;
+
+    ASSERT_EQ(asx_hindsight_init_with(NULL, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hindsight_init_with(NULL, ASX_HINDSIGHT_CAPACITY + 1u),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_hindsight_init_with(storage, 4), ASX_OK);
+    ASSERT_EQ(asx_hindsight_capacity(), (uint32_t)4);
+    for (i = 0; i < 10u; i++) {
+        asx_hindsight_log(ASX_ND_ENTROPY_READ, 0, (uint64_t)i);
+    }
+    ASSERT_EQ(asx_hindsight_readable_count(), (uint32_t)4);
+    ASSERT_TRUE(asx_hindsight_overflowed());
+    ASSERT_TRUE(asx_hindsight_get(0, &ev));
+    ASSERT_EQ(ev.observed_value, (uint64_t)6);
+    ASSERT_TRUE(asx_hindsight_get(3, &ev));
+    ASSERT_EQ(ev.observed_value, (uint64_t)9);
+
+    /* Reset keeps the configured ring */
+    asx_hindsight_reset();
+    ASSERT_EQ(asx_hindsight_capacity(), (uint32_t)4);
+
+    ASSERT_EQ(asx_hindsight_init_with(NULL, ASX_HINDSIGHT_CAPACITY), ASX_OK);
+    ASSERT_EQ(asx_hindsight_capacity(), ASX_HINDSIGHT_CAPACITY);
+}
+
+/* ---- Sampling ---- */
+
+TEST(hindsight_sampling_keeps_one_in_n) {
+    asx_hindsight_sampling cfg = { 4, 0, 0 };
+    asx_hindsight_event ev;
+    uint32_t i;
+
+    asx_hindsight_reset();
+    asx_trace_reset();
+    ASSERT_EQ(asx_hindsight_set_sampling(ASX_ND_CLOCK_READ, &cfg), ASX_OK);
+
+    for (i = 0; i < 10u; i++) {
+        asx_hindsight_log(ASX_ND_CLOCK_READ, 0, (uint64_t)i);
+    }
+    asx_hindsight_log(ASX_ND_ENTROPY_READ, 0, 99);
+
+    /* Clock reads 0, 4, 8 kept; other kinds unaffected */
+    ASSERT_EQ(asx_hindsight_total_count(), (uint32_t)4);
+    ASSERT_TRUE(asx_hindsight_get(1, &ev));
+    ASSERT_EQ(ev.observed_value, (uint64_t)4);
+    ASSERT_EQ(ev.sequence, (uint32_t)1);
+    ASSERT_EQ(asx_hindsight_seen_count(ASX_ND_CLOCK_READ), (uint32_t)10);
+    ASSERT_EQ(asx_hindsight_dropped_count(ASX_ND_CLOCK_READ), (uint32_t)7);
+    ASSERT_EQ(asx_hindsight_dropped_count(ASX_ND_ENTROPY_READ), (uint32_t)0);
+
+    ASSERT_EQ(asx_hindsight_set_sampling(ASX_ND_CLOCK_READ, NULL), ASX_OK);
+    asx_hindsight_reset();
+}
+
+TEST(hindsight_sampling_rate_limits_per_trace_window) {
+    asx_hindsight_sampling cfg = { 0, 2, 5 };
+    uint32_t i;
+
+    asx_hindsight_reset();
+    asx_trace_reset();
+    ASSERT_EQ(asx_hindsight_set_sampling(ASX_ND_CLOCK_READ, &cfg), ASX_OK);
+    ASSERT_EQ(asx_hindsight_sampling_active(ASX_ND_CLOCK_READ).max_per_window,
+              (uint32_t)2);
+
+    /* Three reads per poll, one poll per iteration: two per 5 polls */
+    for (i = 0; i < 10u; i++) {
+        asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 0);
+        asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 0);
+        asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 0);
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, 0, 0);
+    }
+
+    ASSERT_EQ(asx_hindsight_total_count(), (uint32_t)4);
+    ASSERT_EQ(asx_hindsight_dropped_count(ASX_ND_CLOCK_READ), (uint32_t)26);
+
+    /* Counters reset, config survives */
+    asx_hindsight_reset();
+    ASSERT_EQ(asx_hindsight_dropped_count(ASX_ND_CLOCK_READ), (uint32_t)0);
+    ASSERT_EQ(asx_hindsight_sampling_active(ASX_ND_CLOCK_READ).window,
+              (uint32_t)5);
+
+    ASSERT_EQ(asx_hindsight_set_sampling(ASX_ND_KIND_COUNT, &cfg),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_hindsight_set_sampling(ASX_ND_CLOCK_READ, NULL), ASX_OK);
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 0);
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 0);
+    asx_hindsight_log(ASX_ND_CLOCK_READ, 0, 0);
+    ASSERT_EQ(asx_hindsight_total_count(), (uint32_t)3);
+    asx_hindsight_reset();
+}
+
+/* ---- Streaming divergence windows ---- */
+
+static asx_hindsight_flush_buffer g_window_flush;
+
+/* 40 polls, each after one clock read; odd_at takes a different aux */
+static void window_run(uint32_t odd_at)
+{
+    uint32_t i;
+
+    asx_hindsight_reset();
+    asx_trace_reset();
+    for (i = 0; i < 40u; i++) {
+        asx_hindsight_log(ASX_ND_CLOCK_READ, 0, i);
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, i == odd_at ? 999u : i);
+    }
+}
+
+TEST(hindsight_window_flushes_at_first_divergent_window) {
+    asx_hindsight_policy policy = { 1, 1 };
+    uint64_t ref[5];
+    uint32_t i;
+
+    asx_hindsight_set_policy(&policy);
+    asx_trace_set_digest_window(8);
+    window_run(UINT32_MAX);
+    ASSERT_EQ(asx_trace_window_count(), (uint32_t)5);
+    for (i = 0; i < 5u; i++) ASSERT_TRUE(asx_trace_window_get(i, &ref[i]));
+    ASSERT_EQ(ref[4], asx_trace_digest());
+
+    /* The replica differs at sequence 21, inside window 2 */
+    window_run(21);
+    g_window_flush.len = 0;
+    ASSERT_EQ(asx_hindsight_check_window(0, ref[0], &g_window_flush), ASX_OK);
+    ASSERT_EQ(asx_hindsight_check_window(1, ref[1], &g_window_flush), ASX_OK);
+    ASSERT_EQ(g_window_flush.len, (uint32_t)0);
+    ASSERT_EQ(asx_hindsight_check_window(2, ref[2], &g_window_flush),
+              ASX_E_REPLAY_MISMATCH);
+    ASSERT_TRUE(g_window_flush.len > 0);
+    ASSERT_EQ(asx_hindsight_check_window(5, ref[4], NULL), ASX_E_PENDING);
+
+    /* Policy off: still reported, not flushed */
+    policy.flush_on_divergence = 0;
+    asx_hindsight_set_policy(&policy);
+    g_window_flush.len = 0;
+    ASSERT_EQ(asx_hindsight_check_window(3, ref[3], &g_window_flush),
+              ASX_E_REPLAY_MISMATCH);
+    ASSERT_EQ(g_window_flush.len, (uint32_t)0);
+
+    policy.flush_on_divergence = 1;
+    asx_hindsight_set_policy(&policy);
+    asx_trace_set_digest_window(0);
+    ASSERT_EQ(asx_hindsight_check_window(0, ref[0], NULL), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_hindsight_check_window(9, ref[0], NULL), ASX_E_NOT_FOUND);
+}
+
+TEST(hindsight_window_history_evicts_and_aligns) {
+    uint64_t d;
+    uint32_t i;
+
+    /* One-event windows: only the newest 16 of 40 are held */
+    asx_trace_set_digest_window(1);
+    window_run(UINT32_MAX);
+    ASSERT_EQ(asx_trace_window_count(), (uint32_t)40);
+    ASSERT_FALSE(asx_trace_window_get(23, &d));
+    ASSERT_TRUE(asx_trace_window_get(24, &d));
+    ASSERT_EQ(asx_hindsight_check_window(0, d, NULL), ASX_E_NOT_FOUND);
+    ASSERT_FALSE(asx_trace_window_get(39, NULL));
+
+    /* Set mid-run, windows still count from sequence 0 */
+    asx_trace_set_digest_window(0);
+    asx_trace_reset();
+    for (i = 0; i < 5u; i++) asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, i);
+    asx_trace_set_digest_window(4);
+    ASSERT_EQ(asx_trace_digest_window(), (uint32_t)4);
+    ASSERT_EQ(asx_trace_window_count(), (uint32_t)1);
+    ASSERT_FALSE(asx_trace_window_get(0, &d));
+    for (i = 5; i < 8u; i++) asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, i);
+    ASSERT_EQ(asx_trace_window_count(), (uint32_t)2);
+    ASSERT_TRUE(asx_trace_window_get(1, &d));
+    ASSERT_EQ(d, asx_trace_digest());
+
+    /* Reset restarts numbering with the length kept */
+    asx_trace_reset();
+    ASSERT_EQ(asx_trace_window_count(), (uint32_t)0);
+    for (i = 0; i < 4u; i++) asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, i);
+    ASSERT_TRUE(asx_trace_window_get(0, &d));
+    asx_trace_set_digest_window(0);
+    asx_trace_reset();
+}
 
 /* ---- Test suite runner ---- */
 
@@ -635,16 +891,29 @@ int main(void) {
     RUN_TEST(hindsight_trace_seq_tracks_trace_count);
     RUN_TEST(hindsight_reset_clears_all);
     RUN_TEST(hindsight_deterministic_scenario_zero_events);
+#if ASX_HINDSIGHT
     RUN_TEST(hindsight_clock_read_produces_event);
     RUN_TEST(hindsight_entropy_read_produces_event);
     RUN_TEST(hindsight_multiple_hook_calls_accumulate);
+#else
+    RUN_TEST(hindsight_hook_reads_log_nothing);
+#endif
     RUN_TEST(hindsight_policy_defaults_enabled);
     RUN_TEST(hindsight_policy_disables_divergence_flush);
     RUN_TEST(hindsight_policy_disables_invariant_flush);
     RUN_TEST(hindsight_check_divergence_same_digest);
     RUN_TEST(hindsight_check_divergence_different_digest);
     RUN_TEST(hindsight_check_divergence_empty_ring);
+#if ASX_HINDSIGHT
     RUN_TEST(hindsight_hook_events_digest_stable_across_runs);
+#endif
+    RUN_TEST(hindsight_binary_dump_renders_like_live_flush);
+    RUN_TEST(hindsight_binary_dump_rejects_short_and_foreign_buffers);
+    RUN_TEST(hindsight_init_with_caller_storage);
+    RUN_TEST(hindsight_sampling_keeps_one_in_n);
+    RUN_TEST(hindsight_sampling_rate_limits_per_trace_window);
+    RUN_TEST(hindsight_window_flushes_at_first_divergent_window);
+    RUN_TEST(hindsight_window_history_evicts_and_aligns);
     TEST_REPORT();
     return test_failures;
 }
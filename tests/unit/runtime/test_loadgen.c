@@ -0,0 +1,185 @@
+/*
+ * test_loadgen.c — unit tests for the open-loop load generator
+ *
+ * Tests: Poisson mean rate and seed determinism, on/off arrivals
+ * confined to bursts, trace replay and end of schedule, coordinated-
+ * omission-corrected latency after a stall, rejected arrivals, and
+ * argument checks.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/loadgen.h>
+
+#define ARRIVALS_MAX 10000u
+
+typedef struct {
+    asx_loadgen_arrival seen[ARRIVALS_MAX];
+    uint32_t count;
+    asx_status result;
+} collector;
+
+static collector g_col;
+static asx_loadgen g_gen;
+static asx_loadgen g_gen2;
+
+static asx_status collect(void *ctx, const asx_loadgen_arrival *arrival)
+{
+    collector *c = (collector *)ctx;
+
+    if (c->count < ARRIVALS_MAX) c->seen[c->count++] = *arrival;
+    return c->result;
+}
+
+static void collector_reset(void)
+{
+    g_col.count = 0;
+    g_col.result = ASX_OK;
+}
+
+TEST(loadgen_poisson_hits_mean_rate_deterministically) {
+    asx_loadgen_config cfg = {0};
+    uint32_t issued;
+    uint64_t last;
+
+    cfg.kind = ASX_LOADGEN_POISSON;
+    cfg.rate_per_sec = 1000000u;         /* mean gap 1 us */
+    cfg.seed = 42u;
+    cfg.limit = ARRIVALS_MAX;
+    collector_reset();
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 5000u), ASX_OK);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, UINT64_MAX, ARRIVALS_MAX + 1u,
+                               collect, &g_col, &issued), ASX_OK);
+    ASSERT_EQ(issued, ARRIVALS_MAX);
+    ASSERT_TRUE(asx_loadgen_done(&g_gen));
+    ASSERT_EQ(asx_loadgen_next_ns(&g_gen), UINT64_MAX);
+
+    /* 10000 gaps of mean 1000 ns: within 3% of 10 ms */
+    last = g_col.seen[ARRIVALS_MAX - 1u].intended_ns - 5000u;
+    ASSERT_TRUE(last > 9700000u && last < 10300000u);
+    ASSERT_TRUE(g_col.seen[1].intended_ns >= g_col.seen[0].intended_ns);
+
+    /* Same seed, same schedule */
+    ASSERT_EQ(asx_loadgen_init(&g_gen2, &cfg, 5000u), ASX_OK);
+    ASSERT_EQ(asx_loadgen_next_ns(&g_gen2), g_col.seen[0].intended_ns);
+}
+
+TEST(loadgen_on_off_arrivals_stay_in_bursts) {
+    asx_loadgen_config cfg = {0};
+    uint32_t issued;
+    uint32_t i;
+
+    cfg.kind = ASX_LOADGEN_ON_OFF;
+    cfg.rate_per_sec = 1000000u;
+    cfg.on_ns = 10000u;
+    cfg.off_ns = 90000u;
+    cfg.seed = 7u;
+    cfg.limit = 1000u;
+    collector_reset();
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 0), ASX_OK);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, UINT64_MAX, 2000u, collect, &g_col,
+                               &issued), ASX_OK);
+    ASSERT_EQ(issued, 1000u);
+    for (i = 0; i < issued; i++) {
+        ASSERT_TRUE(g_col.seen[i].intended_ns % 100000u < 10000u);
+    }
+    /* About ten arrivals per 100 us period */
+    ASSERT_TRUE(g_col.seen[issued - 1u].intended_ns > 9000000u &&
+                g_col.seen[issued - 1u].intended_ns < 11000000u);
+}
+
+TEST(loadgen_trace_replays_offsets_then_ends) {
+    static const uint64_t trace[4] = {0, 5, 5, 20};
+    static const uint64_t backwards[2] = {10, 3};
+    asx_loadgen_config cfg = {0};
+    uint32_t issued;
+
+    cfg.kind = ASX_LOADGEN_TRACE;
+    cfg.trace_ns = trace;
+    cfg.trace_count = 4u;
+    collector_reset();
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 100u), ASX_OK);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, 99u, 8u, collect, &g_col, &issued), ASX_OK);
+    ASSERT_EQ(issued, 0u);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, 105u, 8u, collect, &g_col, &issued), ASX_OK);
+    ASSERT_EQ(issued, 3u);
+    ASSERT_EQ(g_col.seen[2].seq, 2u);
+    ASSERT_EQ(g_col.seen[2].intended_ns, 105u);
+    ASSERT_EQ(asx_loadgen_next_ns(&g_gen), 120u);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, 500u, 8u, collect, &g_col, &issued), ASX_OK);
+    ASSERT_EQ(issued, 1u);
+    ASSERT_TRUE(asx_loadgen_done(&g_gen));
+
+    cfg.trace_ns = backwards;
+    cfg.trace_count = 2u;
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 0), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(loadgen_latency_counts_from_intended_time) {
+    static const uint64_t trace[10] = {0, 10, 20, 30, 40, 50, 60, 70, 80, 90};
+    asx_loadgen_config cfg = {0};
+    uint32_t issued;
+    uint32_t i;
+
+    cfg.kind = ASX_LOADGEN_TRACE;
+    cfg.trace_ns = trace;
+    cfg.trace_count = 10u;
+    collector_reset();
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 0), ASX_OK);
+
+    /* The driver stalls until t=100, then serves each in 1 ns */
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, 100u, 16u, collect, &g_col, &issued), ASX_OK);
+    ASSERT_EQ(issued, 10u);
+    for (i = 0; i < issued; i++) {
+        ASSERT_EQ(g_col.seen[i].issued_ns, 100u);
+        asx_loadgen_complete(&g_gen, &g_col.seen[i], 101u);
+    }
+    ASSERT_EQ(g_gen.completed, 10u);
+    ASSERT_EQ(g_gen.max_lag_ns, 100u);
+    ASSERT_EQ(g_gen.latency.max_ns, 101u);
+    ASSERT_EQ(g_gen.latency.min_ns, 11u);
+    ASSERT_EQ(g_gen.service.max_ns, 1u);
+}
+
+TEST(loadgen_counts_rejections_and_checks_arguments) {
+    asx_loadgen_config cfg = {0};
+    uint32_t issued;
+
+    cfg.kind = ASX_LOADGEN_POISSON;
+    cfg.rate_per_sec = 1000u;
+    cfg.limit = 5u;
+    collector_reset();
+    g_col.result = ASX_E_CHANNEL_FULL;
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 0), ASX_OK);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, UINT64_MAX, 2u, collect, &g_col, &issued), ASX_OK);
+    ASSERT_EQ(issued, 2u);
+    ASSERT_EQ(g_gen.rejected, 2u);
+    ASSERT_FALSE(asx_loadgen_done(&g_gen));
+
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, 0, 0, collect, &g_col, &issued),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_loadgen_pump(&g_gen, 0, 1u, NULL, &g_col, &issued),
+              ASX_E_INVALID_ARGUMENT);
+    cfg.rate_per_sec = 0;
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 0), ASX_E_INVALID_ARGUMENT);
+    cfg.kind = ASX_LOADGEN_ON_OFF;
+    cfg.rate_per_sec = 1000u;
+    ASSERT_EQ(asx_loadgen_init(&g_gen, &cfg, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_loadgen_init(NULL, &cfg, 0), ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_STR_EQ(asx_loadgen_kind_str(ASX_LOADGEN_ON_OFF), "on_off");
+    ASSERT_STR_EQ(asx_loadgen_kind_str((asx_loadgen_kind)9), "unknown");
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_loadgen ===\n");
+    RUN_TEST(loadgen_poisson_hits_mean_rate_deterministically);
+    RUN_TEST(loadgen_on_off_arrivals_stay_in_bursts);
+    RUN_TEST(loadgen_trace_replays_offsets_then_ends);
+    RUN_TEST(loadgen_latency_counts_from_intended_time);
+    RUN_TEST(loadgen_counts_rejections_and_checks_arguments);
+    TEST_REPORT();
+    return test_failures;
+}
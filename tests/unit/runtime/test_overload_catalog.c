@@ -213,6 +213,38 @@ TEST(to_policy_invalid_profile_rejected)
     ASSERT_EQ(s, ASX_E_INVALID_ARGUMENT);
 }
 
+TEST(to_watermark_leads_threshold)
+{
+    asx_resource_watermark wm;
+    const asx_overload_catalog_entry *entry = NULL;
+
+    /* CORE rejects at 90%: degrade from 80%, recover at 70% */
+    ASSERT_EQ(asx_overload_catalog_to_watermark(ASX_PROFILE_ID_CORE, 1000, &wm),
+              ASX_OK);
+    ASSERT_EQ(wm.high, 800u);
+    ASSERT_EQ(wm.low, 700u);
+    ASSERT_TRUE(wm.fn == NULL);
+
+    /* Small capacities keep low strictly below high */
+    ASSERT_EQ(asx_overload_catalog_to_watermark(ASX_PROFILE_ID_CORE, 4, &wm),
+              ASX_OK);
+    ASSERT_EQ(wm.high, 3u);
+    ASSERT_EQ(wm.low, 2u);
+
+    asx_overload_catalog_get(ASX_PROFILE_ID_HFT, &entry);
+    ASSERT_EQ(asx_overload_catalog_to_watermark(ASX_PROFILE_ID_HFT, 100, &wm),
+              ASX_OK);
+    ASSERT_TRUE(wm.high < entry->threshold_pct);
+    ASSERT_TRUE(wm.low < wm.high);
+
+    ASSERT_EQ(asx_overload_catalog_to_watermark(ASX_PROFILE_ID_CORE, 1, &wm),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_overload_catalog_to_watermark((asx_profile_id)99, 100, &wm),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_overload_catalog_to_watermark(ASX_PROFILE_ID_CORE, 100, NULL),
+              ASX_E_INVALID_ARGUMENT);
+}
+
 /* ===================================================================
  * Decision consistency tests
  * =================================================================== */
@@ -438,6 +470,7 @@ int main(void)
     RUN_TEST(to_policy_hft_matches_catalog);
     RUN_TEST(to_policy_null_rejected);
     RUN_TEST(to_policy_invalid_profile_rejected);
+    RUN_TEST(to_watermark_leads_threshold);
 
     /* Decision consistency */
     RUN_TEST(decision_consistent_reject_below_threshold);
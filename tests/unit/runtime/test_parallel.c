@@ -3,7 +3,8 @@
  *
  * Tests: init/reset, lane assignment/removal, fairness policies,
  * starvation detection, worker state, parallel_run integration,
- * budget exhaustion, cancel lane segregation, deterministic ordering.
+ * budget exhaustion, cancel lane segregation and strict cancel mode,
+ * cancel latency histogram, deterministic ordering, worker CPU pinning.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -14,6 +15,9 @@
 #include <asx/runtime/parallel.h>
 #include <asx/runtime/trace.h>
 #include <asx/core/ghost.h>
+#include <asx/core/channel.h>
+#include <asx/runtime/waker.h>
+#include <asx/runtime/hft_instrument.h>
 
 /* ---- Test poll functions ---- */
 
@@ -66,6 +70,7 @@ static void reset_all(void) {
 
 static asx_parallel_config default_config(void) {
     asx_parallel_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
     cfg.worker_count = 1;
     cfg.fairness = ASX_FAIRNESS_ROUND_ROBIN;
     cfg.lane_weights[0] = 1;
@@ -488,6 +493,44 @@ TEST(parallel_weighted_run_completes) {
     asx_parallel_reset();
 }
 
+TEST(parallel_weighted_shares_exact_over_runs) {
+    asx_region_id rid;
+    asx_task_id tr, tc;
+    asx_budget budget;
+    asx_parallel_config cfg = default_config();
+    int cr = 1000, cc = 1000;
+    int ready_polls, cancel_polls;
+    int run;
+
+    /* A one-poll budget is a third of a poll for CANCEL and two thirds
+     * for READY: without carried shares neither lane is ever polled */
+    cfg.fairness = ASX_FAIRNESS_WEIGHTED;
+    cfg.lane_weights[ASX_LANE_READY] = 2;
+    cfg.lane_weights[ASX_LANE_CANCEL] = 1;
+
+    reset_all();
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &cr, &tr), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &cc, &tc), ASX_OK);
+    ASSERT_EQ(asx_task_cancel(tc, ASX_CANCEL_USER), ASX_OK);
+
+    for (run = 0; run < 61; run++) {
+        budget = asx_budget_from_polls(1);
+        ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    }
+
+    /* The first run only builds up shares; then 2:1 exactly */
+    ready_polls = 1000 - cr;
+    cancel_polls = 1000 - cc;
+    ASSERT_EQ(ready_polls + cancel_polls, 60);
+    ASSERT_EQ(ready_polls, 40);
+    ASSERT_EQ(cancel_polls, 20);
+    ASSERT_FALSE(asx_parallel_starvation_detected());
+
+    asx_parallel_reset();
+}
+
 /* ================================================================
  * Priority fairness — cancel lane gets budget first
  * ================================================================ */
@@ -512,6 +555,85 @@ TEST(parallel_priority_run_completes) {
     asx_parallel_reset();
 }
 
+/* First poll cancels the two victims, then stays pending */
+static asx_task_id g_strict_victims[2];
+
+static asx_status poll_cancel_victims(void *data, asx_task_id self) {
+    int *first = (int *)data;
+    (void)self;
+    if (*first) {
+        *first = 0;
+        if (asx_task_cancel(g_strict_victims[0], ASX_CANCEL_USER) != ASX_OK ||
+            asx_task_cancel(g_strict_victims[1], ASX_CANCEL_USER) != ASX_OK) {
+            return ASX_E_INVALID_STATE;
+        }
+    }
+    return ASX_E_PENDING;
+}
+
+/* Task slot of the first SCHED_POLL in round, and cancel-victim polls
+ * in that round */
+static uint32_t first_poll_in_round(uint64_t round, uint32_t *victim_polls) {
+    asx_trace_event ev;
+    uint32_t first = UINT32_MAX;
+    uint32_t i;
+
+    *victim_polls = 0;
+    for (i = 0; asx_trace_event_get(i, &ev); i++) {
+        if (ev.kind != ASX_TRACE_SCHED_POLL || ev.aux != round) continue;
+        if (first == UINT32_MAX) first = asx_handle_slot(ev.entity_id);
+        if (asx_handle_slot(ev.entity_id) == asx_handle_slot(g_strict_victims[0]) ||
+            asx_handle_slot(ev.entity_id) == asx_handle_slot(g_strict_victims[1])) {
+            (*victim_polls)++;
+        }
+    }
+    return first;
+}
+
+TEST(parallel_cancel_strict_services_cancelled_first) {
+    asx_region_id rid;
+    asx_task_id killer, other;
+    asx_budget budget;
+    asx_parallel_config cfg = default_config();
+    asx_lane_state ls;
+    uint32_t victim_polls;
+    int first;
+    int mode;
+
+    for (mode = 0; mode < 2; mode++) {
+        cfg.fairness = mode ? ASX_FAIRNESS_CANCEL_STRICT : ASX_FAIRNESS_PRIORITY;
+        cfg.cancel_round_cap = 1;
+        reset_all();
+        ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+        first = 1;
+        ASSERT_EQ(asx_task_spawn(rid, poll_cancel_victims, &first, &killer), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &other), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &g_strict_victims[0]), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &g_strict_victims[1]), ASX_OK);
+
+        asx_trace_reset();
+        budget = asx_budget_from_polls(10);
+        ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+
+        if (mode) {
+            /* Moved at the round boundary; one cancel poll per round,
+             * ahead of the ready lane */
+            ASSERT_EQ(first_poll_in_round(1, &victim_polls),
+                      asx_handle_slot(g_strict_victims[0]));
+            ASSERT_EQ(victim_polls, (uint32_t)1);
+            ASSERT_EQ(asx_lane_get_state(ASX_LANE_CANCEL, &ls), ASX_OK);
+            ASSERT_EQ(ls.task_count, (uint32_t)2);
+        } else {
+            /* Priority mode keeps run-start lanes: victims compete */
+            ASSERT_EQ(first_poll_in_round(1, &victim_polls),
+                      asx_handle_slot(killer));
+            ASSERT_EQ(victim_polls, (uint32_t)2);
+        }
+    }
+    asx_parallel_reset();
+}
+
 /* ================================================================
  * Starvation detection
  * ================================================================ */
@@ -591,6 +713,8 @@ TEST(parallel_replay_identity) {
     asx_parallel_reset();
 }
 
+#if !ASX_HANDLE_EPOCH
+/* Trace comparisons across runs need handles to restart at each reset */
 TEST(parallel_single_worker_trace_matches_core_scheduler) {
     asx_region_id rid;
     asx_task_id t1, t2;
@@ -642,6 +766,7 @@ TEST(parallel_single_worker_trace_matches_core_scheduler) {
 
     asx_parallel_reset();
 }
+#endif
 
 /* ================================================================
  * Multi-worker config
@@ -693,10 +818,1062 @@ TEST(parallel_lane_weight_query) {
     asx_parallel_reset();
 }
 
+/* ================================================================
+ * TIMED lane — timer waiters cost no polls
+ * ================================================================ */
+
+typedef struct {
+    asx_timer_handle timer;
+    uint32_t         polls;
+} timed_sleeper;
+
+/* Parks on its timer on the first poll, completes once woken */
+static asx_status poll_sleep_on_timer(void *data, asx_task_id self) {
+    timed_sleeper *s = (timed_sleeper *)data;
+    s->polls++;
+    if (s->polls == 1) {
+        if (asx_task_park_on_timer(self, &s->timer) != ASX_OK) {
+            return ASX_E_INVALID_STATE;
+        }
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+typedef struct {
+    asx_time now;
+    asx_time stop;
+} timed_ticker;
+
+/* Advances the global wheel one tick per poll */
+static asx_status poll_tick_wheel(void *data, asx_task_id self) {
+    timed_ticker *tk = (timed_ticker *)data;
+    void *wakers[4];
+    (void)self;
+    tk->now++;
+    (void)asx_timer_collect_expired(asx_timer_wheel_global(), tk->now,
+                                    wakers, 4);
+    return tk->now >= tk->stop ? ASX_OK : ASX_E_PENDING;
+}
+
+TEST(parallel_timer_waiter_sits_in_timed_lane) {
+    asx_parallel_config cfg = default_config();
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_lane_state ls;
+    timed_sleeper sleeper;
+    void *wakers[4];
+
+    reset_all();
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    sleeper.polls = 0;
+    ASSERT_EQ(asx_timer_register(w, 10, &sleeper, &sleeper.timer), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_sleep_on_timer, &sleeper, &tid), ASX_OK);
+
+    /* Only a timer waiter remains: idle, not budget-exhausted */
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(sleeper.polls, (uint32_t)1);
+    ASSERT_EQ(asx_lane_get_state(ASX_LANE_TIMED, &ls), ASX_OK);
+    ASSERT_EQ(ls.task_count, (uint32_t)1);
+    ASSERT_EQ(ls.starvation_count, (uint32_t)0);
+    ASSERT_EQ(asx_lane_get_state(ASX_LANE_READY, &ls), ASX_OK);
+    ASSERT_EQ(ls.task_count, (uint32_t)0);
+
+    /* The waiter stays in TIMED across runs without being polled */
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(sleeper.polls, (uint32_t)1);
+    ASSERT_EQ(asx_budget_polls(&budget), (uint32_t)99);
+
+    ASSERT_EQ(asx_timer_collect_expired(w, 10, wakers, 4), (uint32_t)1);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(sleeper.polls, (uint32_t)2);
+
+    asx_timer_wheel_reset(w);
+    asx_parallel_reset();
+}
+
+TEST(parallel_timer_fire_promotes_to_ready_lane) {
+    asx_parallel_config cfg = default_config();
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    timed_sleeper sleepers[3];
+    timed_ticker ticker;
+    uint32_t i;
+
+    reset_all();
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        sleepers[i].polls = 0;
+        ASSERT_EQ(asx_timer_register(w, 5 + 5 * (asx_time)i, &sleepers[i],
+                                     &sleepers[i].timer), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_sleep_on_timer, &sleepers[i], &tid),
+                  ASX_OK);
+    }
+    ticker.now = 0;
+    ticker.stop = 20;
+    ASSERT_EQ(asx_task_spawn(rid, poll_tick_wheel, &ticker, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+    /* Each sleeper: one poll to park, one after its timer fired */
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(sleepers[i].polls, (uint32_t)2);
+    }
+    ASSERT_EQ(asx_budget_polls(&budget), (uint32_t)(1000 - 20 - 6));
+
+    asx_timer_wheel_reset(w);
+    asx_parallel_reset();
+}
+
+/* ================================================================
+ * Persistent lane membership
+ * ================================================================ */
+
+static uint32_t lane_count(asx_lane_class lane) {
+    asx_lane_state ls;
+    if (asx_lane_get_state(lane, &ls) != ASX_OK) return UINT32_MAX;
+    return ls.task_count;
+}
+
+TEST(parallel_lanes_follow_tasks_between_runs) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rid, other;
+    asx_task_id t1, t2, t3, t4;
+    asx_budget budget;
+
+    reset_all();
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &t1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &t2), ASX_OK);
+
+    /* Lanes track nothing until a run classifies its regions */
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)0);
+    budget = asx_budget_from_polls(1);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)2);
+
+    /* Spawn and cancel move tasks between runs */
+    ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &t3), ASX_OK);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)3);
+    ASSERT_EQ(asx_task_cancel(t1, ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)2);
+    ASSERT_EQ(lane_count(ASX_LANE_CANCEL), (uint32_t)1);
+
+    /* Tasks of regions outside the lanes are left alone */
+    ASSERT_EQ(asx_task_spawn(other, poll_forever, NULL, &t4), ASX_OK);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)2);
+
+    /* The cancelled task runs out of cleanup polls, completes and
+     * leaves its lane */
+    budget = asx_budget_from_polls(4000);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(lane_count(ASX_LANE_CANCEL), (uint32_t)0);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)2);
+
+    /* A run over other regions classifies those instead */
+    budget = asx_budget_from_polls(1);
+    ASSERT_EQ(asx_parallel_run(other, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)1);
+
+    /* Runtime reset drops the lanes */
+    asx_runtime_reset();
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)0);
+
+    asx_parallel_reset();
+}
+
+TEST(parallel_lane_overflow_joins_as_lanes_drain) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    int yields[ASX_LANE_TASK_CAPACITY + 6u];
+    uint32_t n = ASX_LANE_TASK_CAPACITY + 6u;
+    uint32_t i;
+    asx_worker_state ws;
+
+    reset_all();
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < n; i++) {
+        yields[i] = 1;
+        ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &yields[i], &tid), ASX_OK);
+    }
+
+    /* The READY lane fills; the last tasks wait outside it */
+    budget = asx_budget_from_polls(1);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(lane_count(ASX_LANE_READY), (uint32_t)ASX_LANE_TASK_CAPACITY);
+
+    /* Runs over the same region reuse the lanes, and the waiting tasks
+     * join as the first ones complete */
+    for (i = 0; i < 3u; i++) {
+        budget = asx_budget_from_polls(20);
+        ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    }
+    budget = asx_budget_from_polls(4000);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+    for (i = 0; i < n; i++) {
+        ASSERT_EQ(yields[i], 0);
+    }
+    ASSERT_EQ(asx_worker_get_state(0, &ws), ASX_OK);
+    ASSERT_EQ(ws.tasks_completed, n);
+    ASSERT_EQ(asx_lane_total_tasks(), (uint32_t)0);
+
+    asx_parallel_reset();
+}
+
+/* ================================================================
+ * Worker thread dispatch
+ * ================================================================ */
+
+static uint32_t g_dispatch_calls;
+
+/* Test dispatch hook: runs every worker share inline */
+static asx_status inline_dispatch(void *ctx, uint32_t worker_count,
+                                  asx_worker_entry_fn entry, void *arg) {
+    uint32_t w;
+    (void)ctx;
+    g_dispatch_calls++;
+    for (w = 0; w < worker_count; w++) {
+        entry(arg, w);
+    }
+    return ASX_OK;
+}
+
+static void install_dispatch_hook(void) {
+    asx_runtime_hooks hooks;
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.threads.dispatch_fn = inline_dispatch;
+    (void)asx_runtime_set_hooks(&hooks);
+    g_dispatch_calls = 0;
+}
+
+static void count_worker_entry(void *arg, uint32_t worker_index) {
+    uint32_t *seen = (uint32_t *)arg;
+    *seen |= 1u << worker_index;
+}
+
+TEST(worker_dispatch_requires_hook) {
+    asx_runtime_hooks hooks;
+    uint32_t seen = 0;
+
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.threads.dispatch_fn = NULL;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_worker_dispatch(2, NULL, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_worker_dispatch(2, count_worker_entry, &seen),
+              ASX_E_HOOK_MISSING);
+
+    install_dispatch_hook();
+    ASSERT_EQ(asx_runtime_worker_dispatch(3, count_worker_entry, &seen), ASX_OK);
+    ASSERT_EQ(seen, (uint32_t)0x7);
+    ASSERT_EQ(g_dispatch_calls, (uint32_t)1);
+}
+
+TEST(parallel_multi_worker_counts_real_polls) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_worker_state ws;
+    int counters[8];
+    uint32_t i;
+    uint32_t polls = 0;
+    uint32_t completed = 0;
+
+    reset_all();
+    install_dispatch_hook();
+    cfg.worker_count = 4;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 8; i++) {
+        counters[i] = 2;
+        ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &counters[i], &tid), ASX_OK);
+    }
+
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+    for (i = 0; i < 4; i++) {
+        ASSERT_EQ(asx_worker_get_state(i, &ws), ASX_OK);
+        polls += ws.polls_total;
+        completed += ws.tasks_completed;
+    }
+    /* Each task: two PENDING polls and one completing poll */
+    ASSERT_EQ(polls, (uint32_t)24);
+    ASSERT_EQ(completed, (uint32_t)8);
+
+#if ASX_DETERMINISTIC
+    /* Deterministic builds stay serialized on the calling thread */
+    ASSERT_EQ(g_dispatch_calls, (uint32_t)0);
+    ASSERT_EQ(asx_worker_get_state(0, &ws), ASX_OK);
+    ASSERT_EQ(ws.polls_total, (uint32_t)24);
+#else
+    /* The inline hook runs worker 0 first, which drains its own deque
+     * and then steals every other worker's share. */
+    ASSERT_TRUE(g_dispatch_calls > 0);
+    ASSERT_EQ(asx_worker_get_state(0, &ws), ASX_OK);
+    ASSERT_EQ(ws.polls_total, (uint32_t)24);
+    ASSERT_TRUE(ws.steals_total > 0);
+#endif
+
+    asx_parallel_reset();
+}
+
+/* Test dispatch hook: runs worker shares inline, last worker first */
+static asx_status reverse_dispatch(void *ctx, uint32_t worker_count,
+                                   asx_worker_entry_fn entry, void *arg) {
+    uint32_t w;
+    (void)ctx;
+    g_dispatch_calls++;
+    for (w = worker_count; w > 0; w--) {
+        entry(arg, w - 1u);
+    }
+    return ASX_OK;
+}
+
+TEST(parallel_idle_worker_steals_from_busy) {
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_worker_state ws;
+    uint32_t i;
+    uint32_t polls = 0;
+    uint32_t steals = 0;
+
+    reset_all();
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.threads.dispatch_fn = reverse_dispatch;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    cfg.worker_count = 3;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 9; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    }
+
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_worker_get_state(i, &ws), ASX_OK);
+        polls += ws.polls_total;
+        steals += ws.steals_total;
+    }
+    ASSERT_EQ(polls, (uint32_t)9);
+
+#if ASX_DETERMINISTIC
+    ASSERT_EQ(steals, (uint32_t)0);
+#else
+    /* Worker 2 runs first: its own block of 3, then workers 0 and 1 */
+    ASSERT_EQ(asx_worker_get_state(2, &ws), ASX_OK);
+    ASSERT_EQ(ws.polls_total, (uint32_t)9);
+    ASSERT_EQ(ws.steals_total, (uint32_t)6);
+    ASSERT_EQ(steals, (uint32_t)6);
+#endif
+
+    asx_parallel_reset();
+}
+
+/* Test pin hooks: record each pin, count two switches per sample pair */
+static uint64_t g_pin_masks[4];
+static uint32_t g_pin_calls;
+static uint64_t g_switch_reads;
+
+static asx_status record_pin(void *ctx, uint64_t cpu_mask) {
+    (void)ctx;
+    if (g_pin_calls < 4) g_pin_masks[g_pin_calls] = cpu_mask;
+    g_pin_calls++;
+    return ASX_OK;
+}
+
+static asx_status count_switches(void *ctx, uint64_t *out_count) {
+    (void)ctx;
+    *out_count = g_switch_reads++ * 2u;
+    return ASX_OK;
+}
+
+TEST(parallel_workers_pin_to_cpu_sets) {
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_worker_state ws;
+    int counters[4];
+    uint32_t i;
+
+    reset_all();
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.threads.dispatch_fn = inline_dispatch;
+    hooks.threads.pin_fn = record_pin;
+    hooks.threads.switches_fn = count_switches;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_dispatch_calls = 0;
+    g_pin_calls = 0;
+    g_switch_reads = 0;
+
+    cfg.worker_count = 2;
+    cfg.worker_cpus[1] = 0x0Cu; /* worker 1 on CPUs 2-3 */
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_worker_get_state(0, &ws), ASX_OK);
+    ASSERT_EQ(ws.domain, ASX_AFFINITY_DOMAIN_ANY);
+    ASSERT_EQ(ws.cpu_mask, (uint64_t)0);
+    ASSERT_EQ(asx_worker_get_state(1, &ws), ASX_OK);
+    ASSERT_EQ(ws.domain, (asx_affinity_domain)2);
+    ASSERT_EQ(ws.cpu_mask, (uint64_t)0x0Cu);
+    ASSERT_EQ(ws.pinned, 0);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 4; i++) {
+        counters[i] = 2;
+        ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &counters[i], &tid), ASX_OK);
+    }
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+    ASSERT_EQ(asx_worker_get_state(1, &ws), ASX_OK);
+#if ASX_DETERMINISTIC
+    /* Serialized runs never dispatch, so nothing is pinned */
+    ASSERT_EQ(g_pin_calls, (uint32_t)0);
+    ASSERT_EQ(ws.pinned, 0);
+    ASSERT_EQ(ws.involuntary_switches, (uint64_t)0);
+#else
+    /* Pinned once across all rounds; every batch adds one switch */
+    ASSERT_TRUE(g_dispatch_calls > 1);
+    ASSERT_EQ(g_pin_calls, (uint32_t)1);
+    ASSERT_EQ(g_pin_masks[0], (uint64_t)0x0Cu);
+    ASSERT_EQ(ws.pinned, 1);
+    ASSERT_EQ(ws.involuntary_switches, (uint64_t)2 * g_dispatch_calls);
+    ASSERT_EQ(asx_worker_get_state(0, &ws), ASX_OK);
+    ASSERT_EQ(ws.involuntary_switches, (uint64_t)0);
+#endif
+
+    asx_parallel_reset();
+}
+
+TEST(parallel_regions_rejects_bad_arguments) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rids[2];
+    asx_budget budget;
+
+    reset_all();
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rids[0]), ASX_OK);
+    rids[1] = rids[0];
+    budget = asx_budget_from_polls(100);
+
+    ASSERT_EQ(asx_parallel_run_regions(NULL, 1, &budget), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_parallel_run_regions(rids, 0, &budget), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_parallel_run_regions(rids, ASX_PARALLEL_REGION_MAX + 1u, &budget),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_parallel_run_regions(rids, 2, &budget), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_parallel_run_regions(rids, 1, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_parallel_run_regions(rids, 1, &budget), ASX_OK);
+    asx_parallel_reset();
+}
+
+TEST(parallel_regions_pin_each_region_to_one_worker) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rids[3];
+    asx_task_id tid;
+    asx_budget budget;
+    asx_worker_state ws;
+    int counters[6];
+    uint32_t i;
+    uint32_t polls = 0;
+
+    reset_all();
+    asx_affinity_reset();
+    install_dispatch_hook();
+    cfg.worker_count = 2;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_region_open(&rids[i]), ASX_OK);
+    }
+    /* Region 2 would fall on worker 0 by position; bind it to worker 1 */
+    ASSERT_EQ(asx_affinity_bind((uint64_t)rids[2], 2u), ASX_OK);
+    /* Two tasks per region: one poll each for region 0, two for
+     * region 1, three for region 2 */
+    for (i = 0; i < 6; i++) {
+        counters[i] = (int)(i / 2u);
+        ASSERT_EQ(asx_task_spawn(rids[i / 2u], poll_yield_n, &counters[i], &tid),
+                  ASX_OK);
+    }
+
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_parallel_run_regions(rids, 3, &budget), ASX_OK);
+
+    for (i = 0; i < 2; i++) {
+        ASSERT_EQ(asx_worker_get_state(i, &ws), ASX_OK);
+        polls += ws.polls_total;
+        ASSERT_EQ(ws.steals_total, (uint32_t)0);
+    }
+    ASSERT_EQ(polls, (uint32_t)12);
+
+    ASSERT_EQ(asx_worker_get_state(0, &ws), ASX_OK);
+#if ASX_DETERMINISTIC || !defined(ASX_DEBUG_AFFINITY)
+    (void)ws;
+#else
+    /* Worker 0 ran region 0; worker 1 ran regions 1 and 2 */
+    ASSERT_EQ(ws.polls_total, (uint32_t)2);
+    ASSERT_EQ(ws.tasks_completed, (uint32_t)2);
+    ASSERT_EQ(asx_worker_get_state(1, &ws), ASX_OK);
+    ASSERT_EQ(ws.polls_total, (uint32_t)10);
+    ASSERT_EQ(ws.tasks_completed, (uint32_t)4);
+#endif
+
+    asx_affinity_reset();
+    asx_parallel_reset();
+}
+
+#if !ASX_HANDLE_EPOCH
+TEST(parallel_regions_trace_independent_of_workers) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rids[3];
+    asx_task_id tid;
+    asx_budget budget;
+    asx_trace_event single[96];
+    asx_trace_event ev;
+    int counters[9];
+    uint32_t single_count = 0;
+    uint32_t i;
+    uint32_t pass;
+
+    for (pass = 0; pass < 2; pass++) {
+        reset_all();
+        install_dispatch_hook();
+        cfg.worker_count = pass == 0 ? 1u : 3u;
+        ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+        for (i = 0; i < 3; i++) {
+            ASSERT_EQ(asx_region_open(&rids[i]), ASX_OK);
+        }
+        asx_trace_reset();
+        for (i = 0; i < 9; i++) {
+            counters[i] = (int)(i % 4u);
+            ASSERT_EQ(asx_task_spawn(rids[i % 3u], poll_yield_n, &counters[i], &tid),
+                      ASX_OK);
+        }
+        budget = asx_budget_from_polls(1000);
+        ASSERT_EQ(asx_parallel_run_regions(rids, 3, &budget), ASX_OK);
+
+        if (pass == 0) {
+            single_count = asx_trace_event_count();
+            ASSERT_TRUE(single_count <= 96);
+            for (i = 0; i < single_count; i++) {
+                ASSERT_TRUE(asx_trace_event_get(i, &single[i]));
+            }
+        } else {
+            ASSERT_EQ(asx_trace_event_count(), single_count);
+            for (i = 0; i < single_count; i++) {
+                ASSERT_TRUE(asx_trace_event_get(i, &ev));
+                ASSERT_EQ(ev.kind, single[i].kind);
+                ASSERT_EQ(ev.entity_id, single[i].entity_id);
+                ASSERT_EQ(ev.aux, single[i].aux);
+            }
+        }
+        asx_parallel_reset();
+    }
+}
+#endif
+
+#if !ASX_HANDLE_EPOCH
+TEST(parallel_multi_worker_trace_matches_single_worker) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_trace_event single[64];
+    asx_trace_event ev;
+    int counters[6];
+    uint32_t single_count = 0u;
+    uint32_t i;
+    uint32_t pass;
+
+    for (pass = 0; pass < 2; pass++) {
+        reset_all();
+        asx_trace_reset();
+        install_dispatch_hook();
+        cfg.worker_count = pass == 0 ? 1u : 3u;
+        ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+        asx_trace_reset();
+        for (i = 0; i < 6; i++) {
+            counters[i] = (int)i % 3;
+            ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &counters[i], &tid), ASX_OK);
+        }
+        budget = asx_budget_from_polls(1000);
+        ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+        if (pass == 0) {
+            single_count = asx_trace_event_count();
+            ASSERT_TRUE(single_count <= 64);
+            for (i = 0; i < single_count; i++) {
+                ASSERT_TRUE(asx_trace_event_get(i, &single[i]));
+            }
+        } else {
+            ASSERT_EQ(asx_trace_event_count(), single_count);
+            for (i = 0; i < single_count; i++) {
+                ASSERT_TRUE(asx_trace_event_get(i, &ev));
+                ASSERT_EQ(ev.kind, single[i].kind);
+                ASSERT_EQ(ev.entity_id, single[i].entity_id);
+                ASSERT_EQ(ev.aux, single[i].aux);
+            }
+        }
+        asx_parallel_reset();
+    }
+}
+#endif
+
+static asx_status poll_record_latency(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    asx_hft_record_poll_latency(700);
+    return ASX_OK;
+}
+
+TEST(parallel_worker_polls_record_own_histograms) {
+    asx_parallel_config cfg = default_config();
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_hft_histogram snap;
+    uint32_t i;
+
+    reset_all();
+    asx_hft_instrument_reset();
+    install_dispatch_hook();
+    cfg.worker_count = 4;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 8; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_record_latency, NULL, &tid), ASX_OK);
+    }
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+#if ASX_DETERMINISTIC
+    /* Polled on the calling thread: the global histogram */
+    ASSERT_EQ(asx_hft_sched_histogram()->total, 8u);
+#else
+    ASSERT_EQ(asx_hft_sched_histogram()->total, 0u);
+#endif
+    ASSERT_EQ(asx_hft_sched_snapshot(&snap), ASX_OK);
+    ASSERT_EQ(snap.total, 8u);
+    ASSERT_EQ(snap.min_ns, (uint64_t)700);
+
+    asx_hft_instrument_reset();
+    asx_parallel_reset();
+}
+
+#if !ASX_HANDLE_EPOCH
+/* Emits two events of its own per poll, then yields until done */
+typedef struct {
+    uint64_t id;
+    int      remaining;
+} emitter_ctx;
+
+static asx_status poll_emit_events(void *data, asx_task_id self) {
+    emitter_ctx *c = (emitter_ctx *)data;
+    (void)self;
+    asx_trace_emit(ASX_TRACE_CHANNEL_SEND, c->id, (uint64_t)c->remaining);
+    asx_trace_emit(ASX_TRACE_CHANNEL_RECV, c->id, 0);
+    if (c->remaining-- > 0) return ASX_E_PENDING;
+    return ASX_OK;
+}
+
+TEST(parallel_worker_trace_events_merge_in_serial_order) {
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_trace_event single[128];
+    asx_trace_event ev;
+    emitter_ctx ctx[8];
+    uint32_t single_count = 0;
+    uint64_t single_digest = 0;
+    uint32_t i;
+    uint32_t pass;
+
+    /* 1 worker; 3 workers run last-first (stealing); 4 platform threads */
+    for (pass = 0; pass < 3; pass++) {
+        reset_all();
+        (void)asx_runtime_hooks_init(&hooks);
+        if (pass == 1) hooks.threads.dispatch_fn = reverse_dispatch;
+        ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+        cfg.worker_count = pass == 0 ? 1u : pass + 2u;
+        ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+        for (i = 0; i < 8; i++) {
+            ctx[i].id = 100u + i;
+            ctx[i].remaining = (int)(i % 4u);
+            ASSERT_EQ(asx_task_spawn(rid, poll_emit_events, &ctx[i], &tid), ASX_OK);
+        }
+        asx_trace_reset();
+        budget = asx_budget_from_polls(1000);
+        ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+        if (pass == 0) {
+            single_count = asx_trace_event_count();
+            single_digest = asx_trace_digest();
+            ASSERT_TRUE(single_count <= 128);
+            for (i = 0; i < single_count; i++) {
+                ASSERT_TRUE(asx_trace_event_get(i, &single[i]));
+            }
+            /* A poll's own events follow its SCHED_POLL */
+            ASSERT_EQ(single[0].kind, ASX_TRACE_SCHED_POLL);
+            ASSERT_EQ(single[1].kind, ASX_TRACE_CHANNEL_SEND);
+            ASSERT_EQ(single[2].kind, ASX_TRACE_CHANNEL_RECV);
+        } else {
+            ASSERT_EQ(asx_trace_event_count(), single_count);
+            for (i = 0; i < single_count; i++) {
+                ASSERT_TRUE(asx_trace_event_get(i, &ev));
+                ASSERT_EQ(ev.kind, single[i].kind);
+                ASSERT_EQ(ev.entity_id, single[i].entity_id);
+                ASSERT_EQ(ev.aux, single[i].aux);
+            }
+            ASSERT_EQ(asx_trace_digest(), single_digest);
+        }
+        asx_parallel_reset();
+    }
+}
+#endif
+
+/* Producers and a consumer sharing one channel across worker threads */
+#define MPSC_PRODUCERS     6u
+#define MPSC_PER_PRODUCER  40u
+
+typedef struct {
+    asx_channel_id channel;
+    uint32_t       base;
+    uint32_t       sent;
+} producer_ctx;
+
+typedef struct {
+    asx_channel_id channel;
+    uint32_t       received;
+    uint8_t        seen[MPSC_PRODUCERS * MPSC_PER_PRODUCER];
+} consumer_ctx;
+
+static asx_status poll_produce(void *data, asx_task_id self) {
+    producer_ctx *p = (producer_ctx *)data;
+    asx_send_permit permit;
+    asx_status st;
+
+    while (p->sent < MPSC_PER_PRODUCER) {
+        st = asx_channel_try_reserve(p->channel, &permit);
+        if (st == ASX_E_CHANNEL_FULL) {
+            if (asx_task_park_on_channel(self, p->channel) != ASX_OK) {
+                return ASX_E_INVALID_STATE;
+            }
+            return ASX_E_PENDING;
+        }
+        if (st != ASX_OK) return st;
+        st = asx_send_permit_send(&permit, (uint64_t)(p->base + p->sent));
+        if (st != ASX_OK) return st;
+        p->sent++;
+    }
+    return ASX_OK;
+}
+
+static asx_status poll_consume(void *data, asx_task_id self) {
+    consumer_ctx *c = (consumer_ctx *)data;
+    uint64_t v;
+    asx_status st;
+
+    while (c->received < MPSC_PRODUCERS * MPSC_PER_PRODUCER) {
+        st = asx_channel_try_recv(c->channel, &v);
+        if (st == ASX_E_WOULD_BLOCK) {
+            if (asx_task_park_on_channel(self, c->channel) != ASX_OK) {
+                return ASX_E_INVALID_STATE;
+            }
+            return ASX_E_PENDING;
+        }
+        if (st != ASX_OK) return st;
+        if (v >= MPSC_PRODUCERS * MPSC_PER_PRODUCER || c->seen[v]) {
+            return ASX_E_INVALID_STATE;
+        }
+        c->seen[v] = 1;
+        c->received++;
+    }
+    return ASX_OK;
+}
+
+TEST(parallel_channel_producers_on_workers) {
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    static producer_ctx producers[MPSC_PRODUCERS];
+    static consumer_ctx consumer;
+    asx_status st = ASX_E_PENDING;
+    uint32_t i;
+    uint32_t len;
+
+    reset_all();
+    asx_channel_reset();
+    /* Default hooks: the platform thread pool where one exists */
+    (void)asx_runtime_hooks_init(&hooks);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    cfg.worker_count = 4;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &consumer.channel), ASX_OK);
+
+    consumer.received = 0;
+    for (i = 0; i < MPSC_PRODUCERS * MPSC_PER_PRODUCER; i++) consumer.seen[i] = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_consume, &consumer, &tid), ASX_OK);
+    for (i = 0; i < MPSC_PRODUCERS; i++) {
+        producers[i].channel = consumer.channel;
+        producers[i].base = i * MPSC_PER_PRODUCER;
+        producers[i].sent = 0;
+        ASSERT_EQ(asx_task_spawn(rid, poll_produce, &producers[i], &tid), ASX_OK);
+    }
+
+    /* Tasks woken mid-run rejoin the lanes on the next run; a lost
+     * wake would leave everyone parked and the loop never reaching OK */
+    budget = asx_budget_from_polls(100000);
+    for (i = 0; i < 1000; i++) {
+        st = asx_parallel_run(rid, &budget);
+        if (st != ASX_E_PENDING) break;
+    }
+    ASSERT_EQ(st, ASX_OK);
+    ASSERT_EQ(consumer.received, MPSC_PRODUCERS * MPSC_PER_PRODUCER);
+    ASSERT_EQ(asx_channel_queue_len(consumer.channel, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)0);
+    ASSERT_EQ(asx_channel_reserved_count(consumer.channel, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)0);
+
+    asx_parallel_reset();
+    asx_channel_reset();
+}
+
+/* Tasks failing through ASX_TRY on worker threads */
+#define LEDGER_TASKS 8u
+
+static asx_status ledger_leaf_failure(void) {
+    return ASX_E_WOULD_BLOCK;
+}
+
+static asx_status ledger_try_step(void) {
+    ASX_TRY(ledger_leaf_failure());
+    return ASX_OK;
+}
+
+static asx_status poll_try_fail_twice(void *data, asx_task_id self) {
+    uint32_t *polls = (uint32_t *)data;
+    (void)self;
+    if (++(*polls) <= 2u) {
+        (void)ledger_try_step();
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+TEST(parallel_try_records_against_polled_task_on_workers) {
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tids[LEDGER_TASKS];
+    static uint32_t polls[LEDGER_TASKS];
+    asx_error_ledger_entry entry;
+    asx_budget budget;
+    asx_status st = ASX_E_PENDING;
+    uint32_t i;
+
+    reset_all();
+    asx_error_ledger_reset();
+    (void)asx_runtime_hooks_init(&hooks);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    cfg.worker_count = 4;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < LEDGER_TASKS; i++) {
+        polls[i] = 0;
+        ASSERT_EQ(asx_task_spawn(rid, poll_try_fail_twice, &polls[i], &tids[i]),
+                  ASX_OK);
+    }
+
+    budget = asx_budget_from_polls(1000);
+    for (i = 0; i < 100u && st != ASX_OK; i++) {
+        st = asx_parallel_run(rid, &budget);
+    }
+    ASSERT_EQ(st, ASX_OK);
+
+    /* Each worker's binding named the task it was polling */
+    for (i = 0; i < LEDGER_TASKS; i++) {
+        ASSERT_EQ(asx_error_ledger_count(tids[i]), 2u);
+        ASSERT_TRUE(asx_error_ledger_get(tids[i], 1u, &entry));
+        ASSERT_EQ(entry.task_id, tids[i]);
+        ASSERT_STR_EQ(entry.operation, "ledger_leaf_failure()");
+    }
+    ASSERT_EQ(asx_error_ledger_count(ASX_INVALID_ID), 0u);
+    ASSERT_EQ(asx_error_ledger_bound_task(), ASX_INVALID_ID);
+
+    asx_parallel_reset();
+}
+
+/* Producers and several subscribers sharing one broadcast channel */
+#define BCAST_SUBSCRIBERS 3u
+
+typedef struct {
+    asx_broadcast_receiver rx;
+    asx_channel_id         channel;
+    uint32_t               received;
+    uint32_t               next[MPSC_PRODUCERS]; /* per-producer FIFO */
+} subscriber_ctx;
+
+static asx_status poll_subscriber(void *data, asx_task_id self) {
+    subscriber_ctx *c = (subscriber_ctx *)data;
+    uint64_t v;
+    uint32_t from;
+    asx_status st;
+
+    while (c->received < MPSC_PRODUCERS * MPSC_PER_PRODUCER) {
+        st = asx_broadcast_try_recv(&c->rx, &v);
+        if (st == ASX_E_WOULD_BLOCK) {
+            if (asx_task_park_on_channel(self, c->channel) != ASX_OK) {
+                return ASX_E_INVALID_STATE;
+            }
+            return ASX_E_PENDING;
+        }
+        if (st != ASX_OK) return st;
+        from = (uint32_t)v / MPSC_PER_PRODUCER;
+        if (from >= MPSC_PRODUCERS ||
+            (uint32_t)v != from * MPSC_PER_PRODUCER + c->next[from]) {
+            return ASX_E_INVALID_STATE;
+        }
+        c->next[from]++;
+        c->received++;
+    }
+    return ASX_OK;
+}
+
+TEST(parallel_broadcast_fans_out_across_workers) {
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_channel_id ch;
+    static producer_ctx producers[MPSC_PRODUCERS];
+    static subscriber_ctx subs[BCAST_SUBSCRIBERS];
+    asx_status st = ASX_E_PENDING;
+    uint32_t i;
+    uint32_t j;
+    uint32_t len;
+
+    reset_all();
+    asx_channel_reset();
+    (void)asx_runtime_hooks_init(&hooks);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    cfg.worker_count = 4;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create_broadcast(rid, 4, &ch), ASX_OK);
+
+    for (i = 0; i < BCAST_SUBSCRIBERS; i++) {
+        subs[i].channel = ch;
+        subs[i].received = 0;
+        for (j = 0; j < MPSC_PRODUCERS; j++) subs[i].next[j] = 0;
+        ASSERT_EQ(asx_broadcast_subscribe(ch, &subs[i].rx), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_subscriber, &subs[i], &tid), ASX_OK);
+    }
+    for (i = 0; i < MPSC_PRODUCERS; i++) {
+        producers[i].channel = ch;
+        producers[i].base = i * MPSC_PER_PRODUCER;
+        producers[i].sent = 0;
+        ASSERT_EQ(asx_task_spawn(rid, poll_produce, &producers[i], &tid), ASX_OK);
+    }
+
+    budget = asx_budget_from_polls(100000);
+    for (i = 0; i < 1000; i++) {
+        st = asx_parallel_run(rid, &budget);
+        if (st != ASX_E_PENDING) break;
+    }
+    ASSERT_EQ(st, ASX_OK);
+    for (i = 0; i < BCAST_SUBSCRIBERS; i++) {
+        ASSERT_EQ(subs[i].received, MPSC_PRODUCERS * MPSC_PER_PRODUCER);
+    }
+    ASSERT_EQ(asx_channel_queue_len(ch, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)0);
+    ASSERT_EQ(asx_channel_reserved_count(ch, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)0);
+
+    asx_parallel_reset();
+    asx_channel_reset();
+}
+
 /* ================================================================
  * main
  * ================================================================ */
 
+/* ================================================================
+ * Cancel latency histogram
+ * ================================================================ */
+
+static uint64_t g_cancel_clock_ns;
+
+static asx_time cancel_clock(void *ctx) {
+    (void)ctx;
+    return g_cancel_clock_ns;
+}
+
+TEST(parallel_cancel_latency_histogram) {
+    asx_region_id rid;
+    asx_task_id tid, plain;
+    asx_budget budget;
+    asx_parallel_config cfg = default_config();
+    asx_runtime_hooks hooks;
+    asx_hft_histogram *h;
+
+    reset_all();
+    asx_hft_instrument_reset();
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = cancel_clock;
+    hooks.clock.logical_now_ns_fn = cancel_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+
+    cfg.fairness = ASX_FAIRNESS_CANCEL_STRICT;
+    cfg.cancel_round_cap = 0;
+    ASSERT_EQ(asx_parallel_init(&cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &plain), ASX_OK);
+
+    g_cancel_clock_ns = 1000;
+    ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_USER), ASX_OK);
+    g_cancel_clock_ns = 1700;
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_parallel_run(rid, &budget), ASX_OK);
+
+    /* Only the cancelled task is sampled */
+    h = asx_hft_cancel_histogram();
+    ASSERT_EQ(h->total, (uint32_t)1);
+    ASSERT_EQ(h->max_ns, (uint64_t)700);
+
+    (void)asx_runtime_hooks_init(&hooks);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    asx_hft_instrument_reset();
+    asx_parallel_reset();
+}
+
 int main(void) {
     fprintf(stderr, "=== test_parallel ===\n");
 
@@ -737,7 +1914,9 @@ int main(void) {
     RUN_TEST(parallel_fairness_weighted);
     RUN_TEST(parallel_fairness_priority);
     RUN_TEST(parallel_weighted_run_completes);
+    RUN_TEST(parallel_weighted_shares_exact_over_runs);
     RUN_TEST(parallel_priority_run_completes);
+    RUN_TEST(parallel_cancel_strict_services_cancelled_first);
 
     /* Starvation */
     RUN_TEST(parallel_no_starvation_initially);
@@ -745,7 +1924,9 @@ int main(void) {
 
     /* Replay identity */
     RUN_TEST(parallel_replay_identity);
+#if !ASX_HANDLE_EPOCH
     RUN_TEST(parallel_single_worker_trace_matches_core_scheduler);
+#endif
 
     /* Multi-worker */
     RUN_TEST(parallel_multi_worker_init);
@@ -753,6 +1934,30 @@ int main(void) {
     /* Lane weight query */
     RUN_TEST(parallel_lane_weight_query);
 
+    /* Worker thread dispatch */
+    RUN_TEST(worker_dispatch_requires_hook);
+    RUN_TEST(parallel_multi_worker_counts_real_polls);
+#if !ASX_HANDLE_EPOCH
+    RUN_TEST(parallel_multi_worker_trace_matches_single_worker);
+    RUN_TEST(parallel_worker_trace_events_merge_in_serial_order);
+#endif
+    RUN_TEST(parallel_worker_polls_record_own_histograms);
+    RUN_TEST(parallel_channel_producers_on_workers);
+    RUN_TEST(parallel_try_records_against_polled_task_on_workers);
+    RUN_TEST(parallel_broadcast_fans_out_across_workers);
+    RUN_TEST(parallel_idle_worker_steals_from_busy);
+    RUN_TEST(parallel_regions_rejects_bad_arguments);
+    RUN_TEST(parallel_regions_pin_each_region_to_one_worker);
+    RUN_TEST(parallel_workers_pin_to_cpu_sets);
+#if !ASX_HANDLE_EPOCH
+    RUN_TEST(parallel_regions_trace_independent_of_workers);
+#endif
+    RUN_TEST(parallel_timer_waiter_sits_in_timed_lane);
+    RUN_TEST(parallel_timer_fire_promotes_to_ready_lane);
+    RUN_TEST(parallel_lanes_follow_tasks_between_runs);
+    RUN_TEST(parallel_lane_overflow_joins_as_lanes_drain);
+    RUN_TEST(parallel_cancel_latency_histogram);
+
     TEST_REPORT();
     return test_failures;
 }
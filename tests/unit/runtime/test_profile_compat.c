@@ -127,7 +127,7 @@ TEST(descriptor_embedded_router_defaults)
     asx_profile_descriptor desc;
     asx_status s = asx_profile_get_descriptor(ASX_PROFILE_ID_EMBEDDED_ROUTER, &desc);
     ASSERT_EQ((int)s, (int)ASX_OK);
-    ASSERT_EQ((int)desc.default_wait, (int)ASX_WAIT_BUSY_SPIN);
+    ASSERT_EQ((int)desc.default_wait, (int)ASX_WAIT_ADAPTIVE);
     ASSERT_EQ(desc.allocator_sealable, 1);
 }
 
@@ -362,6 +362,90 @@ TEST(self_parity_null_out_returns_zero)
     ASSERT_EQ(asx_profile_check_parity(0, NULL), 0);
 }
 
+/* -------------------------------------------------------------------
+ * Windowed parity tests
+ * ------------------------------------------------------------------- */
+
+/* Emit n telemetry events; event `bad` (if < n) carries a different aux */
+static void emit_parity_run(uint32_t n, uint32_t bad)
+{
+    uint32_t i;
+
+    asx_telemetry_reset();
+    for (i = 0; i < n; i++) {
+        asx_telemetry_emit(ASX_TRACE_SCHED_POLL, i, i == bad ? 1u : 0u);
+    }
+}
+
+TEST(parity_windows_locate_first_divergent_window)
+{
+    static uint64_t ref[ASX_TELEMETRY_PARITY_CHECKPOINTS];
+    asx_parity_result result;
+    uint32_t n = 20u * ASX_TELEMETRY_PARITY_WINDOW;
+    uint32_t count;
+    uint32_t window;
+
+    emit_parity_run(n, n);
+    count = asx_telemetry_parity_checkpoints(ref, ASX_TELEMETRY_PARITY_CHECKPOINTS);
+    window = asx_telemetry_parity_window();
+    ASSERT_EQ(count, 20u);
+    ASSERT_EQ(window, ASX_TELEMETRY_PARITY_WINDOW);
+    ASSERT_EQ(ref[count - 1u], asx_telemetry_digest());
+    ASSERT_EQ(asx_profile_check_parity_windows(ref, count, window, &result), 1);
+    ASSERT_EQ(result.pass, 1);
+
+    emit_parity_run(n, 7u * ASX_TELEMETRY_PARITY_WINDOW + 3u);
+    ASSERT_EQ(asx_profile_check_parity_windows(ref, count, window, &result), 0);
+    ASSERT_EQ(result.pass, 0);
+    ASSERT_EQ(result.divergence_index, 7u * ASX_TELEMETRY_PARITY_WINDOW);
+    ASSERT_EQ(result.divergence_window, ASX_TELEMETRY_PARITY_WINDOW);
+    ASSERT_EQ(result.digest_b, ref[7]);
+
+    /* A run that stops early parts where it ends */
+    emit_parity_run(n - ASX_TELEMETRY_PARITY_WINDOW, n);
+    ASSERT_EQ(asx_profile_check_parity_windows(ref, count, window, &result), 0);
+    ASSERT_EQ(result.divergence_index, n - ASX_TELEMETRY_PARITY_WINDOW);
+
+    ASSERT_EQ(asx_profile_check_parity_windows(ref, count, 96u, &result), 0);
+    ASSERT_EQ(result.divergence_window, 0u);
+    ASSERT_EQ(asx_profile_check_parity_windows(NULL, count, window, &result), 0);
+}
+
+TEST(parity_windows_compare_across_window_lengths)
+{
+    static uint64_t ref[ASX_TELEMETRY_PARITY_CHECKPOINTS];
+    static uint64_t cur[ASX_TELEMETRY_PARITY_CHECKPOINTS];
+    asx_parity_result result;
+    uint32_t n = (ASX_TELEMETRY_PARITY_CHECKPOINTS + 2u) *
+                 ASX_TELEMETRY_PARITY_WINDOW;
+    uint32_t ref_count;
+    uint32_t cur_count;
+
+    /* The full run has coarsened; its prefix has not */
+    emit_parity_run(n, n);
+    ref_count = asx_telemetry_parity_checkpoints(ref, ASX_TELEMETRY_PARITY_CHECKPOINTS);
+    ASSERT_EQ(asx_telemetry_parity_window(), 2u * ASX_TELEMETRY_PARITY_WINDOW);
+    ASSERT_EQ(ref_count, ASX_TELEMETRY_PARITY_CHECKPOINTS / 2u + 1u);
+
+    emit_parity_run(n, 300u);
+    cur_count = asx_telemetry_parity_checkpoints(cur, 10u);
+    ASSERT_EQ(asx_profile_parity_windows_compare(cur, cur_count,
+                  2u * ASX_TELEMETRY_PARITY_WINDOW, ASX_PROFILE_ID_HFT,
+                  ref, ref_count, 2u * ASX_TELEMETRY_PARITY_WINDOW,
+                  ASX_PROFILE_ID_CORE, &result), 0);
+    ASSERT_EQ(result.profile_a, ASX_PROFILE_ID_HFT);
+    ASSERT_EQ(result.divergence_index, 256u);
+    ASSERT_EQ(result.divergence_window, 2u * ASX_TELEMETRY_PARITY_WINDOW);
+
+    /* A short prefix at the base window against the coarse table */
+    emit_parity_run(8u * ASX_TELEMETRY_PARITY_WINDOW, n);
+    cur_count = asx_telemetry_parity_checkpoints(cur, ASX_TELEMETRY_PARITY_CHECKPOINTS);
+    ASSERT_EQ(asx_profile_parity_windows_compare(cur, cur_count,
+                  ASX_TELEMETRY_PARITY_WINDOW, ASX_PROFILE_ID_POSIX,
+                  ref, 4u, 2u * ASX_TELEMETRY_PARITY_WINDOW,
+                  ASX_PROFILE_ID_CORE, &result), 1);
+}
+
 /* -------------------------------------------------------------------
  * Resource class scaling tests (bd-j4m.2)
  *
@@ -492,7 +576,7 @@ TEST(descriptor_for_class_embedded_router_r1)
     ASSERT_TRUE(r1.max_regions >= 1);
     ASSERT_EQ(r1.max_tasks, base.max_tasks / 2);
     ASSERT_TRUE(r1.max_tasks >= 1);
-    ASSERT_EQ((int)r1.default_wait, (int)ASX_WAIT_BUSY_SPIN);
+    ASSERT_EQ((int)r1.default_wait, (int)ASX_WAIT_ADAPTIVE);
     ASSERT_EQ(r1.allocator_sealable, 1);
 }
 
@@ -699,6 +783,8 @@ int main(void)
     RUN_TEST(self_parity_after_scenario);
     RUN_TEST(self_parity_divergence_detected);
     RUN_TEST(self_parity_null_out_returns_zero);
+    RUN_TEST(parity_windows_locate_first_divergent_window);
+    RUN_TEST(parity_windows_compare_across_window_lengths);
 
     /* Resource class scaling (bd-j4m.2) */
     RUN_TEST(descriptor_for_class_null_returns_error);
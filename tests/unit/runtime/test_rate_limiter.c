@@ -0,0 +1,268 @@
+/*
+ * test_rate_limiter.c — unit tests for token-bucket rate limiters
+ *
+ * Tests: argument checks and pool exhaustion, lazy refill keeping
+ * partial intervals and capping at the burst, a short task parked on
+ * the refill timer until the idle wait fires it, waiters sharing one
+ * timer, and destroy and region close freeing limiters and timers.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include <asx/time/timer_wheel.h>
+
+#define MS 1000000u
+
+/* Fake clock: a reactor wait advances it by the timeout */
+static asx_time g_fake_now;
+
+static asx_time fake_clock(void *ctx)
+{
+    (void)ctx;
+    return g_fake_now;
+}
+
+static asx_status fake_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                    uint32_t *ready_count)
+{
+    (void)ctx;
+    g_fake_now += (asx_time)timeout_ms * MS;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+static asx_status fake_ghost_wait(void *ctx, uint64_t logical_step,
+                                  uint32_t *ready_count)
+{
+    (void)ctx;
+    if (logical_step > g_fake_now) g_fake_now = logical_step;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+static void rate_test_reset(void)
+{
+    asx_runtime_hooks hooks;
+
+    asx_runtime_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = fake_clock;
+    hooks.clock.logical_now_ns_fn = fake_clock;
+    hooks.reactor.wait_fn = fake_reactor_wait;
+    hooks.reactor.ghost_wait_fn = fake_ghost_wait;
+    (void)asx_runtime_set_hooks(&hooks);
+    g_fake_now = 0;
+}
+
+static asx_status pending_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data;
+    (void)self;
+    return ASX_E_PENDING;
+}
+
+TEST(rate_limiter_checks_arguments) {
+    asx_region_id rid;
+    asx_region_id other;
+    asx_rate_limiter rl;
+    asx_rate_limiter last;
+    asx_rate_limiter extra;
+    asx_task_id stranger;
+    uint32_t tokens;
+    uint32_t i;
+
+    rate_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 1, MS, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 0, MS, &rl), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 1, 0, &rl), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 4, UINT64_MAX / 2u, &rl),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_create(ASX_INVALID_ID, 1, MS, &rl), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 2, MS, &rl), ASX_OK);
+
+    ASSERT_EQ(asx_rate_limiter_try_take(NULL, 1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 3), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_query(&rl, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_spawn(other, pending_poll, NULL, &stranger), ASX_OK);
+    ASSERT_EQ(asx_task_park_on_rate_limiter(stranger, &rl, 1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_rate_limiter_query(&rl, &tokens), ASX_OK);
+    ASSERT_EQ(tokens, 2u);
+
+    for (i = 1; i < ASX_MAX_RATE_LIMITERS; i++) {
+        ASSERT_EQ(asx_rate_limiter_create(other, 1, MS, &last), ASX_OK);
+    }
+    ASSERT_EQ(asx_rate_limiter_create(other, 1, MS, &extra), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_rate_limiter_destroy(&last), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_destroy(&last), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_rate_limiter_try_take(&last, 1), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_rate_limiter_create(other, 1, MS, &extra), ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(rate_limiter_refills_lazily) {
+    asx_region_id rid;
+    asx_rate_limiter rl;
+    uint32_t tokens;
+
+    rate_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 3, 2u * MS, &rl), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 3), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 1), ASX_E_WOULD_BLOCK);
+
+    /* Part of an interval gains nothing but is kept */
+    g_fake_now = 3u * MS;
+    ASSERT_EQ(asx_rate_limiter_query(&rl, &tokens), ASX_OK);
+    ASSERT_EQ(tokens, 1u);
+    g_fake_now = 4u * MS;
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 2), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 1), ASX_E_WOULD_BLOCK);
+
+    /* A long idle spell fills the bucket to the burst only */
+    g_fake_now = 100u * MS;
+    ASSERT_EQ(asx_rate_limiter_query(&rl, &tokens), ASX_OK);
+    ASSERT_EQ(tokens, 3u);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 3), ASX_OK);
+    g_fake_now = 101u * MS;
+    ASSERT_EQ(asx_rate_limiter_query(&rl, &tokens), ASX_OK);
+    ASSERT_EQ(tokens, 0u);
+    asx_runtime_reset();
+}
+
+/* Sender: take one token per send until it has sent `sends` times */
+static asx_rate_limiter g_rl;
+
+ASX_CO_FRAME_BEGIN(sender_frame)
+    uint32_t   sends;
+    uint32_t   sent;
+    asx_status st;
+    int        polls;
+ASX_CO_FRAME_END(sender_frame);
+
+static asx_status sender_poll(void *user_data, asx_task_id self)
+{
+    sender_frame *f = ASX_CO_FRAME(sender_frame, user_data);
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    while (f->sent < f->sends) {
+        ASX_CO_AWAIT_RATE(&f->co, self, &g_rl, 1, f->st);
+        if (f->st != ASX_OK) return f->st;
+        f->sent++;
+    }
+    ASX_CO_END(&f->co);
+}
+
+TEST(rate_limiter_parks_on_refill_timer) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_time next;
+    sender_frame *f;
+    void *mem = NULL;
+    uint32_t fired;
+
+    rate_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 1, 5u * MS, &g_rl), ASX_OK);
+    ASSERT_EQ(ASX_CO_SPAWN(rid, sender_frame, sender_poll, &tid, &mem), ASX_OK);
+    f = (sender_frame *)mem;
+    f->sends = 3;
+
+    /* The first send uses the full bucket, the second sleeps */
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->sent, 1u);
+    ASSERT_EQ(f->polls, 1);
+    ASSERT_EQ(asx_parked_count(), 1u);
+    ASSERT_EQ(asx_timer_next_deadline(asx_timer_wheel_global(), &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)(5u * MS));
+
+    /* The idle wait sleeps exactly to the refill and fires it */
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(fired, 1u);
+    ASSERT_EQ(g_fake_now, (asx_time)(5u * MS));
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(f->sent, 2u);
+    ASSERT_EQ(f->polls, 2);
+
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(g_fake_now, (asx_time)(10u * MS));
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(f->sent, 3u);
+    ASSERT_EQ(f->polls, 3);
+    ASSERT_EQ(f->st, ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(rate_limiter_waiters_share_one_timer) {
+    asx_region_id rid;
+    asx_rate_limiter rl;
+    asx_task_id a;
+    asx_task_id b;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    uint32_t fired;
+
+    rate_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_create(rid, 4, MS, &rl), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &a), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &b), ASX_OK);
+
+    /* A full bucket does not park */
+    ASSERT_EQ(asx_task_park_on_rate_limiter(a, &rl, 4), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), 0u);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 4), ASX_OK);
+
+    /* A later need shares the earlier timer; an earlier one moves it */
+    ASSERT_EQ(asx_task_park_on_rate_limiter(a, &rl, 2), ASX_OK);
+    ASSERT_EQ(asx_task_park_on_rate_limiter(b, &rl, 3), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), 1u);
+    ASSERT_EQ(asx_parked_count(), 2u);
+    ASSERT_EQ(asx_task_park_on_rate_limiter(b, &rl, 1), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), 1u);
+    ASSERT_EQ(asx_parked_count(), 1u);   /* a woken by the move */
+
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(fired, 1u);
+    ASSERT_EQ(g_fake_now, (asx_time)MS);
+    ASSERT_EQ(asx_parked_count(), 0u);
+
+    /* Destroy cancels the timer and wakes the sleeper */
+    ASSERT_EQ(asx_task_park_on_rate_limiter(a, &rl, 3), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), 1u);
+    ASSERT_EQ(asx_rate_limiter_destroy(&rl), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), 0u);
+    ASSERT_EQ(asx_timer_active_count(w), 0u);
+
+    /* Region close frees the rest, timers included */
+    ASSERT_EQ(asx_rate_limiter_create(rid, 1, MS, &rl), ASX_OK);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 1), ASX_OK);
+    ASSERT_EQ(asx_task_park_on_rate_limiter(a, &rl, 1), ASX_OK);
+    ASSERT_EQ(asx_task_cancel(a, ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(asx_task_cancel(b, ASX_CANCEL_USER), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), 0u);
+    ASSERT_EQ(asx_rate_limiter_try_take(&rl, 1), ASX_E_INVALID_STATE);
+    asx_runtime_reset();
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_rate_limiter ===\n");
+    RUN_TEST(rate_limiter_checks_arguments);
+    RUN_TEST(rate_limiter_refills_lazily);
+    RUN_TEST(rate_limiter_parks_on_refill_timer);
+    RUN_TEST(rate_limiter_waiters_share_one_timer);
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,181 @@
+/*
+ * test_scenario.c — unit tests for the dsl-v1 scenario executor
+ *
+ * Tests: compile-time rejection of malformed scenarios, a lifecycle
+ * scenario meeting every expectation, a mismatch stopping the run at
+ * its op, channel and timer ops recording their errors, cancel
+ * request and acknowledgement, and a fixture's input replayed many
+ * times in one process with identical results.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/scenario.h>
+
+static asx_scenario_op g_ops[32];
+
+static asx_status compile(asx_scenario_program *prog, const char *json)
+{
+    asx_scenario_program_init(prog, g_ops, 32);
+    return asx_scenario_compile(prog, json);
+}
+
+TEST(scenario_compile_rejects_malformed)
+{
+    asx_scenario_program prog;
+    asx_scenario_op one[1];
+
+    ASSERT_EQ(compile(&prog, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(compile(&prog, "{\"seed\":1}"), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(compile(&prog, "{\"ops\":[{\"args\":{},\"id\":0,\"op\":\"Launch\"}]}"),
+              ASX_E_INVALID_ARGUMENT);
+    /* r1 named as a region, then as a task */
+    ASSERT_EQ(compile(&prog,
+        "{\"ops\":[{\"args\":{\"region\":\"r1\"},\"id\":0,\"op\":\"SpawnRegion\"},"
+        "{\"args\":{\"region\":\"r1\",\"task\":\"r1\"},\"id\":1,\"op\":\"SpawnTask\"}]}"),
+        ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(compile(&prog,
+        "{\"ops\":[{\"args\":{},\"expect\":{\"status\":\"ASX_E_NOPE\"},\"id\":0,\"op\":\"noop\"}]}"),
+        ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(compile(&prog, "{\"ops\":[{\"args\":{},\"id\":0,\"op\":\"AdvanceTime\"}]}"),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(compile(&prog, "{\"ops\":[]} trailing"), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(prog.count, 0u);
+
+    asx_scenario_program_init(&prog, one, 1);
+    ASSERT_EQ(asx_scenario_compile(&prog,
+        "{\"ops\":[{\"args\":{},\"id\":0,\"op\":\"noop\"},{\"args\":{},\"id\":1,\"op\":\"noop\"}]}"),
+        ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(asx_scenario_run(NULL, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(scenario_lifecycle_meets_expectations)
+{
+    asx_scenario_program prog;
+    asx_scenario_result res;
+
+    ASSERT_EQ(compile(&prog,
+        "{\"scenario_id\":\"lifecycle.basic\",\"seed\":7,\"version\":\"dsl-v1\",\"ops\":["
+        "{\"args\":{\"region\":\"r1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":0,\"op\":\"SpawnRegion\"},"
+        "{\"args\":{\"polls\":3,\"region\":\"r1\",\"task\":\"t1\"},\"id\":1,\"op\":\"SpawnTask\"},"
+        "{\"args\":{\"polls\":16,\"region\":\"r1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":2,\"op\":\"PollTask\"},"
+        "{\"args\":{\"state\":\"Completed\",\"task\":\"t1\"},\"id\":3,\"op\":\"Assert\"},"
+        "{\"args\":{\"obligation\":\"o1\",\"region\":\"r1\"},\"id\":4,\"op\":\"ReserveObligation\"},"
+        "{\"args\":{\"obligation\":\"o1\"},\"id\":5,\"op\":\"CommitObligation\"},"
+        "{\"args\":{\"obligation\":\"o1\",\"state\":\"Committed\"},\"id\":6,\"op\":\"Assert\"},"
+        "{\"args\":{\"obligation\":\"o1\"},\"expect\":{\"status\":\"ASX_E_INVALID_TRANSITION\"},\"id\":7,\"op\":\"CommitObligation\"},"
+        "{\"args\":{\"region\":\"r1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":8,\"op\":\"CloseRegion\"}"
+        "]}"), ASX_OK);
+    ASSERT_EQ(prog.count, 9u);
+    ASSERT_EQ(prog.names, 3u);
+    ASSERT_EQ(prog.seed, (uint64_t)7);
+    ASSERT_EQ(prog.ops[3].code, (uint8_t)ASX_SCENARIO_ASSERT_TASK);
+
+    ASSERT_EQ(asx_scenario_run(&prog, &res), ASX_OK);
+    ASSERT_EQ(res.executed, 9u);
+    ASSERT_EQ(res.error_count, 1u);
+    ASSERT_EQ(res.errors[0], ASX_E_INVALID_TRANSITION);
+}
+
+TEST(scenario_mismatch_stops_at_op)
+{
+    asx_scenario_program prog;
+    asx_scenario_result res;
+
+    ASSERT_EQ(compile(&prog, "{\"ops\":["
+        "{\"args\":{\"region\":\"r1\"},\"id\":10,\"op\":\"SpawnRegion\"},"
+        "{\"args\":{\"obligation\":\"o1\",\"region\":\"r1\"},\"id\":11,\"op\":\"ReserveObligation\"},"
+        "{\"args\":{\"obligation\":\"o1\",\"state\":\"Committed\"},\"id\":12,\"op\":\"Assert\"},"
+        "{\"args\":{\"region\":\"r1\"},\"id\":13,\"op\":\"CloseRegion\"}"
+        "]}"), ASX_OK);
+    ASSERT_EQ(asx_scenario_run(&prog, &res), ASX_E_REPLAY_MISMATCH);
+    ASSERT_EQ(res.executed, 3u);
+    ASSERT_EQ(res.failed_id, 12u);
+    ASSERT_EQ(res.expected, ASX_OK);
+    ASSERT_EQ(res.actual, ASX_E_REPLAY_MISMATCH);
+}
+
+TEST(scenario_channel_and_timer_ops)
+{
+    asx_scenario_program prog;
+    asx_scenario_result res;
+
+    ASSERT_EQ(compile(&prog, "{\"ops\":["
+        "{\"args\":{\"region\":\"r1\"},\"id\":0,\"op\":\"SpawnRegion\"},"
+        "{\"args\":{\"capacity\":1,\"channel\":\"c1\",\"permit\":\"p1\",\"region\":\"r1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":1,\"op\":\"ChannelReserve\"},"
+        "{\"args\":{\"channel\":\"c1\",\"permit\":\"p2\",\"region\":\"r1\"},\"expect\":{\"status\":\"ASX_E_CHANNEL_FULL\"},\"id\":2,\"op\":\"ChannelReserve\"},"
+        "{\"args\":{\"permit\":\"p1\",\"value\":99},\"expect\":{\"status\":\"ASX_OK\"},\"id\":3,\"op\":\"ChannelSend\"},"
+        "{\"args\":{\"deadline\":5000,\"timer\":\"tm1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":4,\"op\":\"TimerRegister\"},"
+        "{\"args\":{\"deadline\":9000,\"timer\":\"tm2\"},\"id\":5,\"op\":\"TimerRegister\"},"
+        "{\"args\":{\"ns\":6000},\"id\":6,\"op\":\"AdvanceTime\"},"
+        "{\"args\":{\"timer\":\"tm1\"},\"expect\":{\"status\":\"ASX_E_TIMER_NOT_FOUND\"},\"id\":7,\"op\":\"TimerCancel\"},"
+        "{\"args\":{\"timer\":\"tm2\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":8,\"op\":\"TimerCancel\"}"
+        "]}"), ASX_OK);
+    ASSERT_EQ(asx_scenario_run(&prog, &res), ASX_OK);
+    ASSERT_EQ(res.executed, 9u);
+    ASSERT_EQ(res.error_count, 2u);
+    ASSERT_EQ(res.errors[0], ASX_E_CHANNEL_FULL);
+    ASSERT_EQ(res.errors[1], ASX_E_TIMER_NOT_FOUND);
+}
+
+TEST(scenario_cancel_request_and_ack)
+{
+    asx_scenario_program prog;
+    asx_scenario_result res;
+
+    ASSERT_EQ(compile(&prog, "{\"ops\":["
+        "{\"args\":{\"region\":\"r1\"},\"id\":0,\"op\":\"SpawnRegion\"},"
+        "{\"args\":{\"polls\":100,\"region\":\"r1\",\"task\":\"t1\"},\"id\":1,\"op\":\"SpawnTask\"},"
+        "{\"args\":{\"region\":\"r1\"},\"id\":2,\"op\":\"PollTask\"},"
+        "{\"args\":{\"state\":\"Running\",\"task\":\"t1\"},\"id\":3,\"op\":\"Assert\"},"
+        "{\"args\":{\"kind\":\"Deadline\",\"task\":\"t1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":4,\"op\":\"RequestCancel\"},"
+        "{\"args\":{\"state\":\"CancelRequested\",\"task\":\"t1\"},\"id\":5,\"op\":\"Assert\"},"
+        "{\"args\":{\"task\":\"t1\"},\"expect\":{\"status\":\"ASX_OK\"},\"id\":6,\"op\":\"AckCancel\"},"
+        "{\"args\":{\"state\":\"Cancelling\",\"task\":\"t1\"},\"id\":7,\"op\":\"Assert\"}"
+        "]}"), ASX_OK);
+    ASSERT_EQ(prog.ops[4].arg, (uint64_t)ASX_CANCEL_DEADLINE);
+    ASSERT_EQ(asx_scenario_run(&prog, &res), ASX_OK);
+    ASSERT_EQ(res.executed, 8u);
+}
+
+TEST(scenario_replays_in_process)
+{
+    asx_scenario_program prog;
+    asx_scenario_result first;
+    asx_scenario_result res;
+    uint32_t i;
+
+    /* A fixture's input_json is an object holding ops */
+    ASSERT_EQ(compile(&prog, "{\"ops\":["
+        "{\"args\":{\"region\":\"r1\"},\"id\":0,\"op\":\"SpawnRegion\"},"
+        "{\"args\":{\"polls\":2,\"region\":\"r1\",\"task\":\"t1\"},\"id\":1,\"op\":\"SpawnTask\"},"
+        "{\"args\":{\"polls\":2,\"region\":\"r1\",\"task\":\"t2\"},\"id\":2,\"op\":\"SpawnTask\"},"
+        "{\"args\":{\"polls\":3,\"region\":\"r1\"},\"id\":3,\"op\":\"PollTask\"},"
+        "{\"args\":{\"obligation\":\"o1\"},\"id\":4,\"op\":\"AbortObligation\"},"
+        "{\"args\":{\"polls\":8,\"region\":\"r1\"},\"id\":5,\"op\":\"PollTask\"},"
+        "{\"args\":{\"state\":\"Completed\",\"task\":\"t2\"},\"id\":6,\"op\":\"Assert\"}"
+        "]}"), ASX_OK);
+    ASSERT_EQ(asx_scenario_run(&prog, &first), ASX_OK);
+    ASSERT_TRUE(first.error_count >= 1u);
+
+    for (i = 0; i < 1000; i++) {
+        ASSERT_EQ(asx_scenario_run(&prog, &res), ASX_OK);
+        ASSERT_EQ(res.error_count, first.error_count);
+        ASSERT_EQ(res.errors[0], first.errors[0]);
+    }
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_scenario ===\n");
+    RUN_TEST(scenario_compile_rejects_malformed);
+    RUN_TEST(scenario_lifecycle_meets_expectations);
+    RUN_TEST(scenario_mismatch_stops_at_op);
+    RUN_TEST(scenario_channel_and_timer_ops);
+    RUN_TEST(scenario_cancel_request_and_ack);
+    RUN_TEST(scenario_replays_in_process);
+    TEST_REPORT();
+    return test_failures;
+}
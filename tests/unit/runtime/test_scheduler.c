@@ -2,7 +2,12 @@
  * test_scheduler.c — unit tests for deterministic scheduler loop
  *
  * Tests: event sequencing, deterministic ordering, budget exhaustion,
- * round tracking, multi-task tie-break, and replay identity.
+ * round tracking, multi-task tie-break, replay identity, the
+ * per-round coarse clock, the multi-region loop's visit order and
+ * budget shares, the priority and EDF modes with aging, charging
+ * reported poll cost, the event ring's wrap and resize, inline
+ * re-polls of hot tasks, per-task poll profiles, and batch polls of
+ * tasks sharing a poll function.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -10,6 +15,7 @@
 #include "../../test_harness.h"
 #include <asx/asx.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
 #include <asx/core/ghost.h>
 
 /* ---- Test poll functions ---- */
@@ -37,12 +43,56 @@ static asx_status poll_forever(void *data, asx_task_id self) {
     return ASX_E_PENDING;
 }
 
+/* Stays pending, reporting *(uint32_t *)data cost per poll */
+static asx_status poll_costly(void *data, asx_task_id self) {
+    if (asx_task_report_cost(self, *(const uint32_t *)data) != ASX_OK) {
+        return ASX_E_INVALID_STATE;
+    }
+    return ASX_E_PENDING;
+}
+
 /* Fails immediately */
 static asx_status poll_fail(void *data, asx_task_id self) {
     (void)data; (void)self;
     return ASX_E_INVALID_STATE;
 }
 
+/* Spawns one poll_complete task into the region in user_data, then completes */
+static asx_status poll_spawn_sibling(void *data, asx_task_id self) {
+    asx_region_id *rid = (asx_region_id *)data;
+    asx_task_id child;
+    (void)self;
+    return asx_task_spawn(*rid, poll_complete, NULL, &child);
+}
+
+#if !ASX_TASK_PROFILE
+/* Clock that advances on every read, counting the reads. Profiled
+ * polls read the clock themselves, so the coarse-clock test is left
+ * out of ASX_TASK_PROFILE builds. */
+static uint32_t g_clock_reads;
+
+static asx_time counting_clock(void *ctx) {
+    (void)ctx;
+    g_clock_reads++;
+    return (asx_time)g_clock_reads * 1000u;
+}
+
+/* Reads coarse time twice per poll; yields 2 times. Records the last
+ * readings in user_data[1..2]. */
+static asx_status poll_read_coarse(void *data, asx_task_id self) {
+    asx_time *t = (asx_time *)data;
+    (void)self;
+    if (asx_runtime_coarse_now_ns(&t[1]) != ASX_OK) return ASX_E_INVALID_STATE;
+    if (asx_runtime_coarse_now_ns(&t[2]) != ASX_OK) return ASX_E_INVALID_STATE;
+    if (t[1] != t[2]) return ASX_E_INVALID_STATE;
+    if (t[0] > 0) {
+        t[0]--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+#endif
+
 /* ---- Event sequence helpers ---- */
 
 TEST(scheduler_single_task_immediate_complete) {
@@ -211,6 +261,8 @@ TEST(scheduler_multi_task_deterministic_order) {
     ASSERT_EQ(e2.sequence, (uint32_t)4);
 }
 
+#if !ASX_HANDLE_EPOCH
+/* Replay identity holds only while reset restarts handle generations */
 TEST(scheduler_replay_identity) {
     /* Run the same scenario twice and verify identical event streams */
     asx_region_id rid;
@@ -264,6 +316,7 @@ TEST(scheduler_replay_identity) {
         ASSERT_EQ(e.round, events_run1[i].round);
     }
 }
+#endif
 
 TEST(scheduler_event_get_out_of_bounds) {
     asx_scheduler_event ev;
@@ -340,6 +393,743 @@ TEST(scheduler_no_tasks_is_quiescent) {
     ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
 }
 
+TEST(scheduler_ignores_tasks_of_other_regions) {
+    asx_region_id ra, rb;
+    asx_task_id a1, b1, a2;
+    asx_budget budget;
+    asx_scheduler_event e0, e1;
+    int forever_guard = 0;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    /* Interleave arena slots across the two regions */
+    ASSERT_EQ(asx_task_spawn(ra, poll_complete, NULL, &a1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_forever, &forever_guard, &b1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_complete, NULL, &a2), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(ra, &budget), ASX_OK);
+
+    /* Only region A's tasks are polled, in ascending slot order */
+    ASSERT_EQ(asx_scheduler_event_count(), (uint32_t)5);
+    ASSERT_TRUE(asx_scheduler_event_get(0, &e0));
+    ASSERT_TRUE(asx_scheduler_event_get(2, &e1));
+    ASSERT_EQ(asx_handle_slot(e0.task_id), asx_handle_slot(a1));
+    ASSERT_EQ(asx_handle_slot(e1.task_id), asx_handle_slot(a2));
+
+    /* Region B's task was never touched */
+    {
+        asx_task_state bs;
+        ASSERT_EQ(asx_task_get_state(b1, &bs), ASX_OK);
+        ASSERT_EQ(bs, ASX_TASK_CREATED);
+    }
+}
+
+TEST(scheduler_task_spawned_mid_round_polled_same_round) {
+    asx_region_id rid;
+    asx_task_id parent;
+    asx_budget budget;
+    asx_scheduler_event ev;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_spawn_sibling, &rid, &parent), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* poll parent, complete parent, poll child, complete child, quiescent */
+    ASSERT_EQ(asx_scheduler_event_count(), (uint32_t)5);
+    ASSERT_TRUE(asx_scheduler_event_get(2, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_POLL);
+    ASSERT_EQ(ev.round, (uint32_t)0);
+    ASSERT_EQ(asx_handle_slot(ev.task_id), asx_handle_slot(parent) + 1u);
+}
+
+#if !ASX_TASK_PROFILE
+TEST(scheduler_coarse_now_reads_clock_once_per_round) {
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id a, b;
+    asx_budget budget;
+    asx_time ta[3] = {2, 0, 0};
+    asx_time tb[3] = {2, 0, 0};
+    asx_time now;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.clock.now_ns_fn = counting_clock;
+    hooks.clock.logical_now_ns_fn = counting_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_clock_reads = 0;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_read_coarse, ta, &a), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_read_coarse, tb, &b), ASX_OK);
+
+    /* Three polling rounds, four coarse reads each: one clock read per
+     * round, shared by both tasks */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(g_clock_reads, 3u);
+    ASSERT_EQ(ta[1], (asx_time)3000u);
+    ASSERT_EQ(tb[1], (asx_time)3000u);
+
+    /* Outside a run every call reads the clock */
+    ASSERT_EQ(asx_runtime_coarse_now_ns(&now), ASX_OK);
+    ASSERT_EQ(asx_runtime_coarse_now_ns(&now), ASX_OK);
+    ASSERT_EQ(g_clock_reads, 5u);
+    ASSERT_EQ(asx_runtime_coarse_now_ns(NULL), ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+}
+#endif
+
+#if ASX_TASK_PROFILE
+/* Manual clock; poll_advance moves it by data[0] per poll and
+ * completes on the third poll, counted in data[1]. */
+static asx_time g_manual_now;
+
+static asx_time manual_clock(void *ctx) {
+    (void)ctx;
+    return g_manual_now;
+}
+
+static asx_status poll_advance(void *data, asx_task_id self) {
+    asx_time *adv = (asx_time *)data;
+    (void)self;
+    g_manual_now += adv[0];
+    return ++adv[1] == 3u ? ASX_OK : ASX_E_PENDING;
+}
+
+TEST(scheduler_task_profile_splits_running_and_pending) {
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id slow, fast;
+    asx_task_profile prof;
+    asx_budget budget;
+    asx_time slow_adv[2] = {1000u, 0};
+    asx_time fast_adv[2] = {10u, 0};
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.clock.now_ns_fn = manual_clock;
+    hooks.clock.logical_now_ns_fn = manual_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_manual_now = 0;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_advance, slow_adv, &slow), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_advance, fast_adv, &fast), ASX_OK);
+    ASSERT_EQ(asx_task_profile_get(slow, &prof), ASX_OK);
+    ASSERT_EQ(prof.polls, 0u);
+    ASSERT_EQ(asx_task_profile_get(slow, NULL), ASX_E_INVALID_ARGUMENT);
+
+    /* Rounds alternate slow, fast: each task's polls are the other's
+     * pending time */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_profile_get(slow, &prof), ASX_OK);
+    ASSERT_EQ(prof.polls, 3u);
+    ASSERT_EQ(prof.poll_ns_total, 3000u);
+    ASSERT_EQ(prof.poll_ns_max, 1000u);
+    ASSERT_EQ(prof.pending_ns, 20u);
+    ASSERT_EQ(asx_task_profile_get(fast, &prof), ASX_OK);
+    ASSERT_EQ(prof.polls, 3u);
+    ASSERT_EQ(prof.poll_ns_total, 30u);
+    ASSERT_EQ(prof.poll_ns_max, 10u);
+    ASSERT_EQ(prof.pending_ns, 3000u);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+}
+#else
+TEST(scheduler_task_profile_compiled_out) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_task_profile prof;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_profile_get(tid, &prof), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_task_profile_get(tid, NULL), ASX_E_INVALID_ARGUMENT);
+}
+#endif
+
+/* Polls of each region's tasks in the current event log. Events carry
+ * the handle as of the poll, so tasks are matched by slot. */
+static void count_polls_by_region(const asx_task_id *tids, const uint32_t *region_of,
+                                  uint32_t ntids, uint32_t *out, uint32_t nregions) {
+    asx_scheduler_event ev;
+    uint32_t i, k;
+
+    for (k = 0; k < nregions; k++) out[k] = 0;
+    for (i = 0; i < asx_scheduler_event_count(); i++) {
+        ASSERT_TRUE(asx_scheduler_event_get(i, &ev));
+        if (ev.kind != ASX_SCHED_EVENT_POLL) continue;
+        for (k = 0; k < ntids; k++) {
+            if (asx_handle_slot(ev.task_id) == asx_handle_slot(tids[k])) {
+                out[region_of[k]]++;
+            }
+        }
+    }
+}
+
+TEST(scheduler_run_all_visits_regions_in_slot_order) {
+    asx_region_id ra, rb, rc;
+    asx_task_id ta, tb, tc;
+    asx_budget budget;
+    asx_scheduler_event ev;
+    int ca = 1, cb = 1, cc = 1;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rc), ASX_OK);
+    /* Task slots run opposite to region slots */
+    ASSERT_EQ(asx_task_spawn(rc, poll_yield_n, &cc, &tc), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_yield_n, &cb, &tb), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_yield_n, &ca, &ta), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_EQUAL), ASX_OK);
+
+    /* One log for the call: A, then B, then C */
+    ASSERT_TRUE(asx_scheduler_event_get(0, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_POLL);
+    ASSERT_EQ(asx_handle_slot(ev.task_id), asx_handle_slot(ta));
+    ASSERT_EQ(ev.sequence, (uint32_t)0);
+    ASSERT_TRUE(asx_scheduler_event_get(asx_scheduler_event_count() - 1u, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
+    {
+        uint32_t i, seen = 0;
+        uint32_t order[3];
+        for (i = 0; i < asx_scheduler_event_count() && seen < 3u; i++) {
+            ASSERT_TRUE(asx_scheduler_event_get(i, &ev));
+            if (ev.kind == ASX_SCHED_EVENT_COMPLETE) {
+                order[seen++] = asx_handle_slot(ev.task_id);
+            }
+        }
+        ASSERT_EQ(seen, (uint32_t)3);
+        ASSERT_EQ(order[0], asx_handle_slot(ta));
+        ASSERT_EQ(order[1], asx_handle_slot(tb));
+        ASSERT_EQ(order[2], asx_handle_slot(tc));
+    }
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_EQUAL), ASX_OK);
+}
+
+TEST(scheduler_run_all_splits_budget_by_policy) {
+    asx_region_id ra, rb;
+    asx_task_id tids[3];
+    uint32_t region_of[3] = {0, 1, 1};
+    uint32_t polls[2];
+    asx_budget budget;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_forever, NULL, &tids[0]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_forever, NULL, &tids[1]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_forever, NULL, &tids[2]), ASX_OK);
+
+    budget = asx_budget_from_polls(12);
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_EQUAL),
+              ASX_E_POLL_BUDGET_EXHAUSTED);
+    count_polls_by_region(tids, region_of, 3, polls, 2);
+    ASSERT_EQ(polls[0], (uint32_t)6);
+    ASSERT_EQ(polls[1], (uint32_t)6);
+    ASSERT_EQ(asx_budget_polls(&budget), (uint32_t)0);
+
+    budget = asx_budget_from_polls(12);
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_BY_TASKS),
+              ASX_E_POLL_BUDGET_EXHAUSTED);
+    count_polls_by_region(tids, region_of, 3, polls, 2);
+    ASSERT_EQ(polls[0], (uint32_t)4);
+    ASSERT_EQ(polls[1], (uint32_t)8);
+
+    budget = asx_budget_from_polls(12);
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_IN_ORDER),
+              ASX_E_POLL_BUDGET_EXHAUSTED);
+    count_polls_by_region(tids, region_of, 3, polls, 2);
+    ASSERT_EQ(polls[0], (uint32_t)12);
+    ASSERT_EQ(polls[1], (uint32_t)0);
+
+    /* A share never drops below a full round of the region's tasks */
+    budget = asx_budget_from_polls(3);
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_BY_TASKS),
+              ASX_E_POLL_BUDGET_EXHAUSTED);
+    count_polls_by_region(tids, region_of, 3, polls, 2);
+    ASSERT_EQ(polls[0], (uint32_t)1);
+    ASSERT_EQ(polls[1], (uint32_t)2);
+
+    ASSERT_EQ(asx_scheduler_run_all(NULL, ASX_SCHED_SHARE_EQUAL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_scheduler_run_all(&budget, (asx_scheduler_share)7),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+/* Task slots of the POLL events in the current log, in order */
+static uint32_t poll_slots(uint32_t *out, uint32_t max)
+{
+    asx_scheduler_event ev;
+    uint32_t i, n = 0;
+
+    for (i = 0; i < asx_scheduler_event_count() && n < max; i++) {
+        if (!asx_scheduler_event_get(i, &ev)) break;
+        if (ev.kind == ASX_SCHED_EVENT_POLL) out[n++] = asx_handle_slot(ev.task_id);
+    }
+    return n;
+}
+
+TEST(scheduler_priority_mode_polls_most_urgent_level) {
+    asx_region_id rid;
+    asx_task_id t[3];
+    uint32_t slots[8];
+    asx_budget budget;
+    int c0 = 0, c1 = 1, c2 = 0;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &c0, &t[0]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &c1, &t[1]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &c2, &t[2]), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(t[0], 20), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(t[1], 5), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(t[2], 5), ASX_OK);
+    ASSERT_EQ(asx_scheduler_set_mode(ASX_SCHED_MODE_PRIORITY, 0), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* Level 5 in index order until it empties, then level 20 */
+    ASSERT_EQ(poll_slots(slots, 8), (uint32_t)4);
+    ASSERT_EQ(slots[0], asx_handle_slot(t[1]));
+    ASSERT_EQ(slots[1], asx_handle_slot(t[2]));
+    ASSERT_EQ(slots[2], asx_handle_slot(t[1]));
+    ASSERT_EQ(slots[3], asx_handle_slot(t[0]));
+
+    ASSERT_EQ(asx_task_set_priority(t[0], ASX_TASK_PRIORITY_LEVELS),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_scheduler_set_mode((asx_scheduler_mode)3, 0),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_scheduler_set_mode(ASX_SCHED_MODE_PRIORITY,
+                                     ASX_SCHED_AGING_MAX_ROUNDS + 1u),
+              ASX_E_INVALID_ARGUMENT);
+    asx_runtime_reset();
+}
+
+TEST(scheduler_priority_aging_bounds_starvation) {
+    asx_region_id rid;
+    asx_task_id hot, cold;
+    asx_task_state st;
+    asx_budget budget;
+
+    /* Without aging a busy level 0 starves level 2 */
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &hot), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &cold), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(hot, 0), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(cold, 2), ASX_OK);
+    ASSERT_EQ(asx_scheduler_set_mode(ASX_SCHED_MODE_PRIORITY, 0), ASX_OK);
+    budget = asx_budget_from_polls(10);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_task_get_state(cold, &st), ASX_OK);
+    ASSERT_EQ(st, ASX_TASK_CREATED);
+
+    /* One level per round waited: level 2 ties level 0 on round 2 */
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &hot), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &cold), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(hot, 0), ASX_OK);
+    ASSERT_EQ(asx_task_set_priority(cold, 2), ASX_OK);
+    ASSERT_EQ(asx_scheduler_set_mode(ASX_SCHED_MODE_PRIORITY, 1), ASX_OK);
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_task_get_state(cold, &st), ASX_OK);
+    ASSERT_EQ(st, ASX_TASK_COMPLETED);
+    asx_runtime_reset();
+}
+
+TEST(scheduler_edf_mode_orders_by_deadline_bucket) {
+    asx_region_id rid;
+    asx_task_id t[3];
+    uint32_t slots[4];
+    asx_budget budget;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t[0]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t[1]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t[2]), ASX_OK);
+    /* t[0] has no deadline; t[2] is due well before t[1] */
+    ASSERT_EQ(asx_task_set_sched_deadline(t[1], (asx_time)5000000000ull), ASX_OK);
+    ASSERT_EQ(asx_task_set_sched_deadline(t[2], (asx_time)2000000ull), ASX_OK);
+    ASSERT_EQ(asx_scheduler_set_mode(ASX_SCHED_MODE_EDF, 0), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(poll_slots(slots, 4), (uint32_t)3);
+    ASSERT_EQ(slots[0], asx_handle_slot(t[2]));
+    ASSERT_EQ(slots[1], asx_handle_slot(t[1]));
+    ASSERT_EQ(slots[2], asx_handle_slot(t[0]));
+
+    /* Reset restores round-robin */
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t[0]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t[1]), ASX_OK);
+    ASSERT_EQ(asx_task_set_sched_deadline(t[1], (asx_time)1), ASX_OK);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(poll_slots(slots, 4), (uint32_t)2);
+    ASSERT_EQ(slots[0], asx_handle_slot(t[0]));
+}
+
+TEST(scheduler_charges_reported_cost) {
+    asx_region_id ra, rb;
+    asx_task_id heavy, light, other;
+    asx_budget budget;
+    uint32_t heavy_cost = 100, light_cost = 1;
+    uint32_t slots[8];
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_costly, &heavy_cost, &heavy), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_costly, &light_cost, &light), ASX_OK);
+
+    /* 101 per round: the third heavy poll overruns and ends the run */
+    budget = asx_budget_infinite();
+    budget.cost_quota = 250;
+    ASSERT_EQ(asx_scheduler_run(ra, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(poll_slots(slots, 8), (uint32_t)5);
+    ASSERT_EQ(slots[4], asx_handle_slot(heavy));
+    ASSERT_EQ(budget.cost_quota, (uint64_t)0);
+
+    /* Unconstrained cost budgets ignore reports */
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_scheduler_run(ra, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(poll_slots(slots, 8), (uint32_t)4);
+
+    /* run_all charges each region's cost back to the caller */
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_costly, &light_cost, &other), ASX_OK);
+    budget = asx_budget_from_polls(6);
+    budget.cost_quota = 1000;
+    ASSERT_EQ(asx_scheduler_run_all(&budget, ASX_SCHED_SHARE_EQUAL),
+              ASX_E_POLL_BUDGET_EXHAUSTED);
+    /* A: heavy, light, heavy on its 3 polls; B: light 3 times */
+    ASSERT_EQ(budget.cost_quota, (uint64_t)(1000 - 201 - 3));
+
+    ASSERT_EQ(asx_task_report_cost(ASX_INVALID_ID, 1), ASX_E_NOT_FOUND);
+}
+
+/* 301 polls, one completion and the quiescent event */
+static void run_303_events(void)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    static int counter;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    counter = 300;
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &counter, &tid), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_scheduler_event_count(), (uint32_t)303);
+}
+
+TEST(scheduler_hot_polls_repoll_inline) {
+    asx_region_id rid;
+    asx_task_id hot, other;
+    uint32_t slots[16];
+    asx_budget budget;
+    int c_hot = 5, c_other = 1;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &c_hot, &hot), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &c_other, &other), ASX_OK);
+    ASSERT_EQ(asx_task_set_hot_polls(hot, 2), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* Round 0: hot x3, other; round 1: hot x3 (completes), other */
+    ASSERT_EQ(poll_slots(slots, 16), (uint32_t)8);
+    ASSERT_EQ(slots[0], asx_handle_slot(hot));
+    ASSERT_EQ(slots[1], asx_handle_slot(hot));
+    ASSERT_EQ(slots[2], asx_handle_slot(hot));
+    ASSERT_EQ(slots[3], asx_handle_slot(other));
+    ASSERT_EQ(slots[6], asx_handle_slot(hot));
+    ASSERT_EQ(slots[7], asx_handle_slot(other));
+    {
+        asx_scheduler_event ev;
+        ASSERT_TRUE(asx_scheduler_event_get(2, &ev));
+        ASSERT_EQ(ev.round, (uint32_t)0);
+    }
+
+    /* Re-polls draw on the budget like any poll */
+    asx_runtime_reset();
+    asx_ghost_reset();
+    c_hot = 5;
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &c_hot, &hot), ASX_OK);
+    ASSERT_EQ(asx_task_set_hot_polls(hot, 10), ASX_OK);
+    budget = asx_budget_from_polls(3);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(c_hot, 2);
+
+    ASSERT_EQ(asx_task_set_hot_polls(hot, ASX_TASK_HOT_POLLS_MAX + 1u),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+/* Counts its polls in its own task-local word 0, done at three */
+static asx_status poll_local_count(void *ud, asx_task_id self)
+{
+    uint64_t n = 0;
+    (void)ud;
+    if (asx_task_local_get(self, 0, &n) != ASX_OK) return ASX_E_INVALID_STATE;
+    n++;
+    if (asx_task_local_set(self, 0, n) != ASX_OK) return ASX_E_INVALID_STATE;
+    return n < 3u ? ASX_E_PENDING : ASX_OK;
+}
+
+TEST(task_local_words_live_in_slot) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    uint64_t v = 7;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_local_count, NULL, &tid), ASX_OK);
+
+    for (i = 0; i < ASX_TASK_LOCAL_WORDS; i++) {
+        ASSERT_EQ(asx_task_local_get(tid, i, &v), ASX_OK);
+        ASSERT_EQ(v, (uint64_t)0);
+    }
+    ASSERT_EQ(asx_task_local_set(tid, 1, 0xABCDu), ASX_OK);
+    ASSERT_EQ(asx_task_local_get(tid, 1, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)0xABCDu);
+
+    ASSERT_EQ(asx_task_local_set(tid, ASX_TASK_LOCAL_WORDS, 1),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_local_get(tid, ASX_TASK_LOCAL_WORDS, &v),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_local_get(tid, 0, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_local_set(ASX_INVALID_ID, 0, 1), ASX_E_NOT_FOUND);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_local_get(tid, 0, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)3);
+    ASSERT_EQ(asx_task_local_get(tid, 1, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)0xABCDu);
+}
+
+/* Batch form of poll_yield_n, counting calls and the largest batch */
+static uint32_t g_batch_calls;
+static uint32_t g_batch_max;
+
+static void batch_yield_n(void *const *user_datas, const asx_task_id *task_ids,
+                          uint32_t n, asx_status *results) {
+    uint32_t k;
+    g_batch_calls++;
+    if (n > g_batch_max) g_batch_max = n;
+    for (k = 0; k < n; k++) results[k] = poll_yield_n(user_datas[k], task_ids[k]);
+}
+
+static void unused_batch(void *const *user_datas, const asx_task_id *task_ids,
+                         uint32_t n, asx_status *results) {
+    (void)user_datas; (void)task_ids; (void)n; (void)results;
+}
+
+/* Distinct poll functions to fill the registration table */
+static asx_status poll_filler_a(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    return ASX_OK;
+}
+
+static asx_status poll_filler_b(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    return ASX_E_PENDING;
+}
+
+static asx_status poll_filler_c(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    return ASX_E_CANCELLED;
+}
+
+/* Two runs of yield tasks split by a poll_complete task, over budget */
+static asx_status run_batch_scenario(int *counters, uint32_t polls) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    uint32_t k;
+
+    asx_trace_reset();
+    if (asx_region_open(&rid) != ASX_OK) return ASX_E_INVALID_STATE;
+    for (k = 0; k < 5; k++) {
+        if (asx_task_spawn(rid, k == 2 ? poll_complete : poll_yield_n,
+                           &counters[k], &tid) != ASX_OK) {
+            return ASX_E_INVALID_STATE;
+        }
+    }
+    budget = asx_budget_from_polls(polls);
+    return asx_scheduler_run(rid, &budget);
+}
+
+#if !ASX_HANDLE_EPOCH
+TEST(scheduler_batch_poll_keeps_event_stream) {
+    int c[5] = { 2, 0, 0, 1, 3 };
+    asx_scheduler_event single[32];
+    uint32_t count;
+    uint64_t digest;
+    uint32_t i;
+    asx_status st;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    st = run_batch_scenario(c, 100);
+    ASSERT_EQ(st, ASX_OK);
+    count = asx_scheduler_event_count();
+    ASSERT_TRUE(count <= 32u);
+    for (i = 0; i < count; i++) ASSERT_TRUE(asx_scheduler_event_get(i, &single[i]));
+    digest = asx_trace_digest();
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_yield_n, batch_yield_n), ASX_OK);
+    g_batch_calls = 0;
+    g_batch_max = 0;
+    c[0] = 2; c[1] = 0; c[3] = 1; c[4] = 3;
+    ASSERT_EQ(run_batch_scenario(c, 100), ASX_OK);
+
+    /* Round 0: [0,1] and [3,4]; once task 2 completes the survivors
+     * are adjacent: [0,3,4], [0,4], [4] */
+    ASSERT_EQ(g_batch_max, (uint32_t)3);
+    ASSERT_EQ(g_batch_calls, (uint32_t)5);
+    ASSERT_EQ(asx_scheduler_event_count(), count);
+    for (i = 0; i < count; i++) {
+        asx_scheduler_event e;
+        ASSERT_TRUE(asx_scheduler_event_get(i, &e));
+        ASSERT_EQ(e.kind, single[i].kind);
+        ASSERT_EQ(e.task_id, single[i].task_id);
+        ASSERT_EQ(e.round, single[i].round);
+    }
+    ASSERT_EQ(asx_trace_digest(), digest);
+
+    /* A short budget cuts the batch where single polls would stop */
+    c[0] = 2; c[1] = 0; c[3] = 1; c[4] = 3;
+    asx_runtime_reset();
+    ASSERT_EQ(run_batch_scenario(c, 4), ASX_E_POLL_BUDGET_EXHAUSTED);
+    count = asx_scheduler_event_count();
+    digest = asx_trace_digest();
+    c[0] = 2; c[1] = 0; c[3] = 1; c[4] = 3;
+    asx_runtime_reset();
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_yield_n, batch_yield_n), ASX_OK);
+    ASSERT_EQ(run_batch_scenario(c, 4), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_scheduler_event_count(), count);
+    ASSERT_EQ(asx_trace_digest(), digest);
+    ASSERT_EQ(c[4], 3);
+}
+#endif
+
+TEST(scheduler_batch_poll_registration) {
+    static const asx_task_poll_fn fns[] = {
+        poll_complete, poll_yield_n, poll_forever, poll_costly,
+        poll_fail, poll_spawn_sibling, poll_filler_a, poll_filler_b
+    };
+    uint32_t k;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_scheduler_register_batch_poll(NULL, unused_batch),
+              ASX_E_INVALID_ARGUMENT);
+    for (k = 0; k < ASX_SCHED_BATCH_FN_MAX; k++) {
+        ASSERT_EQ(asx_scheduler_register_batch_poll(fns[k], unused_batch), ASX_OK);
+    }
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_yield_n, batch_yield_n), ASX_OK);
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_filler_c, unused_batch),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_fail, NULL), ASX_OK);
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_filler_c, unused_batch), ASX_OK);
+
+    /* Reset drops every registration: tasks poll singly again */
+    asx_runtime_reset();
+    ASSERT_EQ(asx_scheduler_register_batch_poll(poll_fail, NULL), ASX_OK);
+    {
+        int c[5] = { 1, 1, 0, 1, 1 };
+        g_batch_calls = 0;
+        ASSERT_EQ(run_batch_scenario(c, 100), ASX_OK);
+        ASSERT_EQ(g_batch_calls, (uint32_t)0);
+    }
+}
+
+TEST(scheduler_event_log_wraps_keeping_newest) {
+    asx_scheduler_event ev;
+
+    run_303_events();
+    ASSERT_EQ(asx_scheduler_event_first(),
+              (uint32_t)(303u - ASX_SCHED_EVENT_LOG_CAPACITY));
+    ASSERT_FALSE(asx_scheduler_event_get(asx_scheduler_event_first() - 1u, &ev));
+    ASSERT_TRUE(asx_scheduler_event_get(asx_scheduler_event_first(), &ev));
+    ASSERT_EQ(ev.sequence, asx_scheduler_event_first());
+    ASSERT_TRUE(asx_scheduler_event_get(302, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
+    ASSERT_EQ(ev.sequence, (uint32_t)302);
+}
+
+TEST(scheduler_event_log_reserve_resizes_ring) {
+    asx_runtime_hooks hooks;
+    asx_scheduler_event ev;
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_scheduler_event_log_reserve(ASX_SCHED_EVENT_LOG_MAX + 1u),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_scheduler_event_log_reserve(1000), ASX_OK);
+    run_303_events();
+    ASSERT_EQ(asx_scheduler_event_first(), (uint32_t)0);
+    ASSERT_TRUE(asx_scheduler_event_get(0, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_POLL);
+    ASSERT_EQ(ev.sequence, (uint32_t)0);
+
+    /* Shrinking back to the inline ring keeps the newest events */
+    ASSERT_EQ(asx_scheduler_event_log_reserve(0), ASX_OK);
+    ASSERT_EQ(asx_scheduler_event_first(),
+              (uint32_t)(303u - ASX_SCHED_EVENT_LOG_CAPACITY));
+    ASSERT_TRUE(asx_scheduler_event_get(302, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
+    ASSERT_TRUE(asx_scheduler_event_get(asx_scheduler_event_first(), &ev));
+    ASSERT_EQ(ev.sequence, asx_scheduler_event_first());
+}
+
 int main(void) {
     fprintf(stderr, "=== test_scheduler ===\n");
 
@@ -348,11 +1138,35 @@ int main(void) {
     RUN_TEST(scheduler_budget_exhaustion_emits_event);
     RUN_TEST(scheduler_task_failure_emits_complete);
     RUN_TEST(scheduler_multi_task_deterministic_order);
+#if !ASX_HANDLE_EPOCH
     RUN_TEST(scheduler_replay_identity);
+#endif
     RUN_TEST(scheduler_event_get_out_of_bounds);
     RUN_TEST(scheduler_event_reset_clears);
     RUN_TEST(scheduler_round_tracking_multi_round);
     RUN_TEST(scheduler_no_tasks_is_quiescent);
+    RUN_TEST(scheduler_ignores_tasks_of_other_regions);
+    RUN_TEST(scheduler_task_spawned_mid_round_polled_same_round);
+    RUN_TEST(scheduler_run_all_visits_regions_in_slot_order);
+    RUN_TEST(scheduler_run_all_splits_budget_by_policy);
+    RUN_TEST(scheduler_priority_mode_polls_most_urgent_level);
+    RUN_TEST(scheduler_priority_aging_bounds_starvation);
+    RUN_TEST(scheduler_edf_mode_orders_by_deadline_bucket);
+    RUN_TEST(scheduler_charges_reported_cost);
+    RUN_TEST(scheduler_hot_polls_repoll_inline);
+    RUN_TEST(task_local_words_live_in_slot);
+#if !ASX_HANDLE_EPOCH
+    RUN_TEST(scheduler_batch_poll_keeps_event_stream);
+#endif
+    RUN_TEST(scheduler_batch_poll_registration);
+    RUN_TEST(scheduler_event_log_wraps_keeping_newest);
+#if ASX_TASK_PROFILE
+    RUN_TEST(scheduler_task_profile_splits_running_and_pending);
+#else
+    RUN_TEST(scheduler_coarse_now_reads_clock_once_per_round);
+    RUN_TEST(scheduler_task_profile_compiled_out);
+#endif
+    RUN_TEST(scheduler_event_log_reserve_resizes_ring);
 
     TEST_REPORT();
     return test_failures;
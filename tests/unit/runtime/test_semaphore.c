@@ -0,0 +1,257 @@
+/*
+ * test_semaphore.c — unit tests for semaphores
+ *
+ * Tests: argument checks and pool exhaustion, FIFO hand-over waking
+ * one waiter per release, cancelled and completed waiters leaving the
+ * queue and passing on untaken permits, bounded concurrency under the
+ * scheduler without re-polling waiters, and region close freeing
+ * semaphores.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+
+static asx_budget make_budget(uint32_t poll_quota)
+{
+    asx_budget b = asx_budget_infinite();
+    b.poll_quota = poll_quota;
+    return b;
+}
+
+static asx_status pending_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data;
+    (void)self;
+    return ASX_E_PENDING;
+}
+
+/* Queue tid on sem and park it */
+static asx_status queue_and_park(const asx_semaphore *sem, asx_task_id tid)
+{
+    asx_status st = asx_semaphore_try_acquire(sem, tid);
+
+    if (st != ASX_E_WOULD_BLOCK) return st;
+    return asx_task_park_on_semaphore(tid, sem);
+}
+
+TEST(semaphore_checks_arguments) {
+    asx_region_id rid;
+    asx_region_id other;
+    asx_semaphore sem;
+    asx_semaphore last;
+    asx_semaphore extra;
+    asx_task_id tid;
+    asx_task_id stranger;
+    uint32_t avail;
+    uint32_t waiters;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_semaphore_create(rid, 1, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_semaphore_create(rid, 0, &sem), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_semaphore_create(ASX_INVALID_ID, 1, &sem), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_semaphore_create(rid, 1, &sem), ASX_OK);
+
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(other, pending_poll, NULL, &stranger), ASX_OK);
+    ASSERT_EQ(asx_semaphore_try_acquire(NULL, tid), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_semaphore_try_acquire(&sem, stranger), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_park_on_semaphore(tid, &sem), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_semaphore_release(&sem), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid), ASX_OK);
+    ASSERT_EQ(asx_semaphore_query(&sem, &avail, &waiters), ASX_OK);
+    ASSERT_EQ(avail, 0u);
+    ASSERT_EQ(waiters, 0u);
+    ASSERT_EQ(asx_semaphore_release(&sem), ASX_OK);
+    ASSERT_EQ(asx_semaphore_release(&sem), ASX_E_INVALID_STATE);
+
+    for (i = 1; i < ASX_MAX_SEMAPHORES; i++) {
+        ASSERT_EQ(asx_semaphore_create(other, 2, &last), ASX_OK);
+    }
+    ASSERT_EQ(asx_semaphore_create(other, 2, &extra), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_semaphore_destroy(&last), ASX_OK);
+    ASSERT_EQ(asx_semaphore_destroy(&last), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_semaphore_release(&last), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_semaphore_create(other, 2, &extra), ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(semaphore_hands_over_fifo_one_wake_per_release) {
+    asx_region_id rid;
+    asx_semaphore sem;
+    asx_task_id tid[4];
+    uint32_t avail;
+    uint32_t waiters;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_semaphore_create(rid, 1, &sem), ASX_OK);
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid[0]), ASX_OK);
+    for (i = 1; i < 4u; i++) {
+        ASSERT_EQ(queue_and_park(&sem, tid[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_parked_count(), 3u);
+    ASSERT_EQ(asx_semaphore_destroy(&sem), ASX_E_TASKS_STILL_ACTIVE);
+
+    /* Each release wakes only the head; later waiters keep waiting */
+    for (i = 1; i < 4u; i++) {
+        ASSERT_EQ(asx_semaphore_release(&sem), ASX_OK);
+        ASSERT_EQ(asx_parked_count(), 3u - i);
+        ASSERT_EQ(asx_semaphore_query(&sem, &avail, &waiters), ASX_OK);
+        ASSERT_EQ(avail, 0u);
+        ASSERT_EQ(waiters, 3u - i);
+        if (i + 1u < 4u) {
+            ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid[i + 1u]), ASX_E_WOULD_BLOCK);
+        }
+        ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_semaphore_release(&sem), ASX_OK);
+    ASSERT_EQ(asx_semaphore_query(&sem, &avail, &waiters), ASX_OK);
+    ASSERT_EQ(avail, 1u);
+    ASSERT_EQ(asx_semaphore_destroy(&sem), ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(semaphore_cancelled_waiter_leaves_queue) {
+    asx_region_id rid;
+    asx_semaphore sem;
+    asx_task_id tid[4];
+    uint32_t avail;
+    uint32_t waiters;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_semaphore_create(rid, 1, &sem), ASX_OK);
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid[0]), ASX_OK);
+    for (i = 1; i < 4u; i++) {
+        ASSERT_EQ(queue_and_park(&sem, tid[i]), ASX_OK);
+    }
+
+    /* A queued waiter cancelled from the middle of the queue */
+    ASSERT_EQ(asx_task_cancel(tid[2], ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(asx_semaphore_query(&sem, &avail, &waiters), ASX_OK);
+    ASSERT_EQ(waiters, 2u);
+    ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid[2]), ASX_E_CANCELLED);
+
+    /* A waiter cancelled after the hand-over passes the permit on */
+    ASSERT_EQ(asx_semaphore_release(&sem), ASX_OK);
+    ASSERT_EQ(asx_task_cancel(tid[1], ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(asx_semaphore_query(&sem, &avail, &waiters), ASX_OK);
+    ASSERT_EQ(waiters, 0u);
+    ASSERT_EQ(avail, 0u);
+    ASSERT_EQ(asx_semaphore_try_acquire(&sem, tid[3]), ASX_OK);
+    ASSERT_EQ(asx_semaphore_release(&sem), ASX_OK);
+    ASSERT_EQ(asx_semaphore_query(&sem, &avail, &waiters), ASX_OK);
+    ASSERT_EQ(avail, 1u);
+    asx_runtime_reset();
+}
+
+/* Worker: take a permit, hold it across one yield, give it back */
+static asx_semaphore g_sem;
+static uint32_t g_holding;
+static uint32_t g_max_holding;
+
+ASX_CO_FRAME_BEGIN(worker_frame)
+    asx_status st;
+    int        polls;
+ASX_CO_FRAME_END(worker_frame);
+
+static asx_status worker_poll(void *user_data, asx_task_id self)
+{
+    worker_frame *f = ASX_CO_FRAME(worker_frame, user_data);
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    ASX_CO_AWAIT_SEMAPHORE(&f->co, self, &g_sem, f->st);
+    if (f->st != ASX_OK) return f->st;
+    g_holding++;
+    if (g_holding > g_max_holding) g_max_holding = g_holding;
+    ASX_CO_YIELD(&f->co);
+    g_holding--;
+    if (asx_semaphore_release(&g_sem) != ASX_OK) return ASX_E_INVALID_STATE;
+    ASX_CO_END(&f->co);
+}
+
+TEST(semaphore_bounds_concurrency_without_repolls) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    worker_frame *w[6];
+    void *mem;
+    uint32_t avail;
+    uint32_t waiters;
+    uint32_t i;
+
+    asx_runtime_reset();
+    g_holding = 0;
+    g_max_holding = 0;
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_semaphore_create(rid, 2, &g_sem), ASX_OK);
+    for (i = 0; i < 6u; i++) {
+        mem = NULL;
+        ASSERT_EQ(ASX_CO_SPAWN(rid, worker_frame, worker_poll, &tid, &mem), ASX_OK);
+        w[i] = (worker_frame *)mem;
+    }
+
+    budget = make_budget(1000);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(g_max_holding, 2u);
+    for (i = 0; i < 6u; i++) {
+        ASSERT_EQ(w[i]->st, ASX_OK);
+        /* Holders: acquire, release. Waiters: queue, acquire, release */
+        ASSERT_TRUE(w[i]->polls <= 3);
+    }
+    ASSERT_EQ(asx_semaphore_query(&g_sem, &avail, &waiters), ASX_OK);
+    ASSERT_EQ(avail, 2u);
+    ASSERT_EQ(waiters, 0u);
+    asx_runtime_reset();
+}
+
+TEST(semaphore_region_close_frees) {
+    asx_region_id rid;
+    asx_semaphore sem[ASX_MAX_SEMAPHORES];
+    asx_budget budget;
+    uint32_t avail;
+    uint32_t waiters;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_SEMAPHORES; i++) {
+        ASSERT_EQ(asx_semaphore_create(rid, 1, &sem[i]), ASX_OK);
+    }
+    budget = make_budget(100);
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_semaphore_query(&sem[0], &avail, &waiters), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_SEMAPHORES; i++) {
+        ASSERT_EQ(asx_semaphore_create(rid, 1, &sem[i]), ASX_OK);
+    }
+    asx_runtime_reset();
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_semaphore ===\n");
+    RUN_TEST(semaphore_checks_arguments);
+    RUN_TEST(semaphore_hands_over_fifo_one_wake_per_release);
+    RUN_TEST(semaphore_cancelled_waiter_leaves_queue);
+    RUN_TEST(semaphore_bounds_concurrency_without_repolls);
+    RUN_TEST(semaphore_region_close_frees);
+    TEST_REPORT();
+    return test_failures;
+}
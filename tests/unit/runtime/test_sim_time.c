@@ -0,0 +1,244 @@
+/*
+ * test_sim_time.c — unit tests for the simulated clock driver
+ *
+ * Tests: argument checks, a watchdog sleeping a simulated day in hourly
+ * steps, a horizon that stops the run before a deadline and a second
+ * run that resumes it, two runs replaying identical wake times, a
+ * task parked with no timer reported as pending, and wait policy
+ * selection, with every policy reaching the same wake times.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include <asx/time/timer_wheel.h>
+
+#define HOUR ((asx_time)3600u * 1000000000u)
+
+static asx_sim_clock g_sim;
+
+static void sim_test_reset(asx_time start)
+{
+    asx_runtime_hooks hooks;
+
+    asx_runtime_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    (void)asx_runtime_hooks_init(&hooks);
+    asx_sim_clock_init(&g_sim, start);
+    (void)asx_sim_clock_install(&g_sim, &hooks);
+    (void)asx_runtime_set_hooks(&hooks);
+}
+
+/* Watchdog: sleeps period steps times, recording the clock at each wake */
+typedef struct {
+    asx_timer_handle timer;
+    asx_time period;
+    asx_time wakes[32];
+    uint32_t steps;
+    uint32_t woken;
+    int armed;
+} watchdog_ctx;
+
+static asx_status poll_watchdog(void *data, asx_task_id self)
+{
+    watchdog_ctx *c = (watchdog_ctx *)data;
+    asx_time now;
+    asx_status st;
+
+    st = asx_runtime_now_ns(&now);
+    if (st != ASX_OK) return st;
+    if (c->armed && !asx_timer_is_live(asx_timer_wheel_global(), &c->timer)) {
+        c->wakes[c->woken++] = now;
+        c->armed = 0;
+    }
+    if (c->woken == c->steps) return ASX_OK;
+    if (!c->armed) {
+        st = asx_timer_register(asx_timer_wheel_global(), now + c->period, c,
+                                &c->timer);
+        if (st != ASX_OK) return st;
+        c->armed = 1;
+    }
+    st = asx_task_park_on_timer(self, &c->timer);
+    if (st != ASX_OK) return st;
+    return ASX_E_PENDING;
+}
+
+static void watchdog_init(watchdog_ctx *c, asx_time period, uint32_t steps)
+{
+    memset(c, 0, sizeof(*c));
+    c->period = period;
+    c->steps = steps;
+}
+
+/* Parks on a channel nobody sends to */
+static asx_status poll_stuck(void *data, asx_task_id self)
+{
+    asx_channel_id *ch = (asx_channel_id *)data;
+    asx_status st = asx_task_park_on_channel(self, *ch);
+
+    if (st != ASX_OK) return st;
+    return ASX_E_PENDING;
+}
+
+TEST(sim_clock_rejects_null)
+{
+    asx_runtime_hooks hooks;
+    asx_sim_clock clock;
+
+    (void)asx_runtime_hooks_init(&hooks);
+    ASSERT_EQ(asx_sim_clock_install(NULL, &hooks), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_sim_clock_install(&clock, NULL), ASX_E_INVALID_ARGUMENT);
+    asx_sim_clock_init(&clock, 42);
+    ASSERT_EQ(asx_sim_clock_now(&clock), (asx_time)42);
+}
+
+TEST(sim_day_runs_in_hourly_jumps)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    watchdog_ctx wd;
+    uint32_t i;
+
+    sim_test_reset(0);
+    watchdog_init(&wd, HOUR, 24);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &wd, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_scheduler_run_until(rid, &budget, 48 * HOUR), ASX_OK);
+    ASSERT_EQ(wd.woken, (uint32_t)24);
+    for (i = 0; i < 24; i++) ASSERT_EQ(wd.wakes[i], (asx_time)(i + 1) * HOUR);
+    ASSERT_EQ(g_sim.now, 24 * HOUR);
+}
+
+TEST(sim_horizon_stops_then_resumes)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    watchdog_ctx wd;
+
+    sim_test_reset(0);
+    watchdog_init(&wd, HOUR, 10);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &wd, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_scheduler_run_until(rid, &budget, 4 * HOUR + 1), ASX_E_PENDING);
+    ASSERT_EQ(wd.woken, (uint32_t)4);
+    ASSERT_EQ(g_sim.now, 4 * HOUR);
+
+    ASSERT_EQ(asx_scheduler_run_until(rid, &budget, 10 * HOUR), ASX_OK);
+    ASSERT_EQ(wd.woken, (uint32_t)10);
+    ASSERT_EQ(g_sim.now, 10 * HOUR);
+}
+
+TEST(sim_runs_replay_identically)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    watchdog_ctx a[2];
+    watchdog_ctx b[2];
+    uint32_t i;
+
+    sim_test_reset(1000);
+    watchdog_init(&a[0], HOUR, 8);
+    watchdog_init(&a[1], 3 * HOUR, 3);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &a[0], &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &a[1], &tid), ASX_OK);
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_scheduler_run_until(rid, &budget, 24 * HOUR), ASX_OK);
+
+    sim_test_reset(1000);
+    watchdog_init(&b[0], HOUR, 8);
+    watchdog_init(&b[1], 3 * HOUR, 3);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &b[0], &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &b[1], &tid), ASX_OK);
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_scheduler_run_until(rid, &budget, 24 * HOUR), ASX_OK);
+
+    ASSERT_EQ(a[0].woken, (uint32_t)8);
+    ASSERT_EQ(a[1].woken, (uint32_t)3);
+    for (i = 0; i < 8; i++) ASSERT_EQ(a[0].wakes[i], b[0].wakes[i]);
+    for (i = 0; i < 3; i++) ASSERT_EQ(a[1].wakes[i], b[1].wakes[i]);
+    ASSERT_EQ(a[1].wakes[2], 1000 + 9 * HOUR);
+}
+
+TEST(sim_untimed_park_is_pending)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_channel_id ch;
+    asx_budget budget;
+
+    sim_test_reset(0);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_stuck, &ch, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run_until(rid, &budget, HOUR), ASX_E_PENDING);
+    ASSERT_EQ(g_sim.now, (asx_time)0);
+}
+
+TEST(wait_policy_set_and_reset)
+{
+    sim_test_reset(0);
+    ASSERT_EQ((int)asx_scheduler_wait_policy(), (int)ASX_WAIT_SLEEP);
+    ASSERT_EQ(asx_scheduler_spin_window_ns(), (uint64_t)50000u);
+    ASSERT_EQ(asx_scheduler_set_wait_policy((asx_wait_policy)4),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_scheduler_set_wait_policy(ASX_WAIT_ADAPTIVE), ASX_OK);
+    ASSERT_EQ((int)asx_scheduler_wait_policy(), (int)ASX_WAIT_ADAPTIVE);
+    asx_runtime_reset();
+    ASSERT_EQ((int)asx_scheduler_wait_policy(), (int)ASX_WAIT_SLEEP);
+}
+
+TEST(every_wait_policy_wakes_on_schedule)
+{
+    static const asx_wait_policy policies[] = {
+        ASX_WAIT_BUSY_SPIN, ASX_WAIT_YIELD, ASX_WAIT_SLEEP, ASX_WAIT_ADAPTIVE
+    };
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    watchdog_ctx wd;
+    uint32_t p;
+    uint32_t i;
+
+    /* A simulated clock stalls every spin, so each policy parks */
+    for (p = 0; p < 4; p++) {
+        sim_test_reset(0);
+        ASSERT_EQ(asx_scheduler_set_wait_policy(policies[p]), ASX_OK);
+        watchdog_init(&wd, HOUR, 6);
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_watchdog, &wd, &tid), ASX_OK);
+
+        budget = asx_budget_from_polls(1000);
+        ASSERT_EQ(asx_scheduler_run_until(rid, &budget, 12 * HOUR), ASX_OK);
+        ASSERT_EQ(wd.woken, (uint32_t)6);
+        for (i = 0; i < 6; i++) ASSERT_EQ(wd.wakes[i], (asx_time)(i + 1) * HOUR);
+        ASSERT_TRUE(asx_scheduler_spin_window_ns() >= 1000u);
+        ASSERT_TRUE(asx_scheduler_spin_window_ns() <= 1000000u);
+    }
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_sim_time ===\n");
+    RUN_TEST(sim_clock_rejects_null);
+    RUN_TEST(sim_day_runs_in_hourly_jumps);
+    RUN_TEST(sim_horizon_stops_then_resumes);
+    RUN_TEST(sim_runs_replay_identically);
+    RUN_TEST(sim_untimed_park_is_pending);
+    RUN_TEST(wait_policy_set_and_reset);
+    RUN_TEST(every_wait_policy_wakes_on_schedule);
+    TEST_REPORT();
+    return test_failures;
+}
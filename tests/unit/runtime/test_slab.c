@@ -0,0 +1,263 @@
+/*
+ * test_slab.c — unit tests for the size-class slab allocator hook
+ *
+ * Tests: class rounding and block reuse, pass-through of large
+ * requests, realloc across classes, reserve-then-seal serving without
+ * backing calls, utilization through asx_resource_snapshot, and
+ * per-thread cache batching where it is compiled in.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/slab.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Backing allocator that counts its calls */
+static uint32_t g_backing_mallocs;
+static uint32_t g_backing_frees;
+
+static void *counting_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    g_backing_mallocs++;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    g_backing_mallocs++;
+    return realloc(ptr, size);
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    g_backing_frees++;
+    free(ptr);
+}
+
+static void counting_config(asx_slab_config *cfg)
+{
+    asx_slab_config_init(cfg);
+    cfg->backing.malloc_fn = counting_malloc;
+    cfg->backing.realloc_fn = counting_realloc;
+    cfg->backing.free_fn = counting_free;
+    g_backing_mallocs = 0;
+    g_backing_frees = 0;
+}
+
+TEST(slab_init_rejects_bad_config) {
+    asx_slab_config cfg;
+    asx_slab slab;
+
+    asx_slab_config_init(&cfg);
+    cfg.class_sizes[3] = cfg.class_sizes[2];
+    ASSERT_EQ(asx_slab_init(&slab, &cfg), ASX_E_INVALID_ARGUMENT);
+
+    asx_slab_config_init(&cfg);
+    cfg.class_sizes[0] = 0;
+    ASSERT_EQ(asx_slab_init(&slab, &cfg), ASX_E_INVALID_ARGUMENT);
+
+    asx_slab_config_init(&cfg);
+    cfg.backing.free_fn = NULL;
+    ASSERT_EQ(asx_slab_init(&slab, &cfg), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_slab_init(NULL, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(slab_rounds_to_class_and_reuses_blocks) {
+    asx_slab slab;
+    asx_resource_snapshot snap;
+    void *a, *b, *c;
+
+    ASSERT_EQ(asx_slab_init(&slab, NULL), ASX_OK);
+    a = asx_slab_alloc(&slab, 1);
+    b = asx_slab_alloc(&slab, 17);
+    ASSERT_TRUE(a != NULL && b != NULL);
+    ASSERT_EQ((uintptr_t)a % 8u, (uintptr_t)0);
+    memset(a, 0xAB, 16);
+    memset(b, 0xCD, 32);
+
+    ASSERT_EQ(asx_slab_snapshot(&slab, 0, &snap), ASX_OK);
+    ASSERT_EQ(snap.kind, ASX_RESOURCE_ALLOCATOR);
+    ASSERT_EQ(snap.used, 1u);
+    ASSERT_EQ(snap.remaining, snap.capacity - 1u);
+    ASSERT_EQ(asx_slab_snapshot(&slab, 1, &snap), ASX_OK);
+    ASSERT_EQ(snap.used, 1u);
+    ASSERT_EQ(asx_slab_snapshot(&slab, UINT32_MAX, &snap), ASX_OK);
+    ASSERT_EQ(snap.used, 2u);
+    ASSERT_EQ(asx_slab_snapshot(&slab, ASX_SLAB_MAX_CLASSES, &snap),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* A freed block is the next one handed out in its class */
+    asx_slab_free(&slab, a);
+    c = asx_slab_alloc(&slab, 16);
+    ASSERT_TRUE(c == a);
+    asx_slab_free(&slab, c);
+    asx_slab_free(&slab, b);
+    ASSERT_EQ(asx_slab_snapshot(&slab, UINT32_MAX, &snap), ASX_OK);
+    ASSERT_EQ(snap.used, 0u);
+    asx_slab_destroy(&slab);
+}
+
+TEST(slab_large_requests_pass_through) {
+    asx_slab_config cfg;
+    asx_slab slab;
+    asx_resource_snapshot snap;
+    uint8_t *p;
+
+    counting_config(&cfg);
+    ASSERT_EQ(asx_slab_init(&slab, &cfg), ASX_OK);
+    p = (uint8_t *)asx_slab_alloc(&slab, 5000);
+    ASSERT_TRUE(p != NULL);
+    ASSERT_EQ(g_backing_mallocs, 1u);
+    p[4999] = 7;
+    p = (uint8_t *)asx_slab_realloc(&slab, p, 9000);
+    ASSERT_TRUE(p != NULL);
+    ASSERT_EQ(p[4999], 7);
+    ASSERT_EQ(asx_slab_snapshot(&slab, UINT32_MAX, &snap), ASX_OK);
+    ASSERT_EQ(snap.capacity, 0u);
+
+    asx_slab_free(&slab, p);
+    ASSERT_EQ(g_backing_frees, 1u);
+    asx_slab_destroy(&slab);
+    ASSERT_EQ(g_backing_frees, 1u);
+}
+
+TEST(slab_realloc_moves_across_classes) {
+    asx_slab slab;
+    uint8_t *p, *q;
+    uint32_t i;
+
+    ASSERT_EQ(asx_slab_init(&slab, NULL), ASX_OK);
+    p = (uint8_t *)asx_slab_alloc(&slab, 10);
+    for (i = 0; i < 16u; i++) p[i] = (uint8_t)i;
+
+    /* Within the class: in place */
+    ASSERT_TRUE(asx_slab_realloc(&slab, p, 16) == p);
+
+    q = (uint8_t *)asx_slab_realloc(&slab, p, 100);
+    ASSERT_TRUE(q != NULL && q != p);
+    for (i = 0; i < 16u; i++) ASSERT_EQ(q[i], (uint8_t)i);
+
+    q = (uint8_t *)asx_slab_realloc(&slab, q, 4000);
+    ASSERT_TRUE(q != NULL);
+    ASSERT_EQ(q[15], 15);
+    ASSERT_TRUE(asx_slab_realloc(&slab, q, 0) == NULL);
+    asx_slab_destroy(&slab);
+}
+
+TEST(slab_sealed_serves_reserve_without_backing_calls) {
+    asx_slab_config cfg;
+    asx_slab slab;
+    void *blocks[300];
+    uint32_t mallocs;
+    uint32_t i;
+
+    counting_config(&cfg);
+    cfg.chunk_bytes = 1024;
+    ASSERT_EQ(asx_slab_init(&slab, &cfg), ASX_OK);
+    ASSERT_EQ(asx_slab_reserve(&slab, 64, 300), ASX_OK);
+    ASSERT_EQ(asx_slab_reserve(&slab, 5000, 1), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_slab_seal(&slab), ASX_OK);
+    ASSERT_EQ(asx_slab_seal(&slab), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_slab_reserve(&slab, 64, 400), ASX_E_INVALID_STATE);
+    mallocs = g_backing_mallocs;
+
+    for (i = 0; i < 300u; i++) {
+        blocks[i] = asx_slab_alloc(&slab, 64);
+        ASSERT_TRUE(blocks[i] != NULL);
+    }
+    /* Only what was reserved: no refills, no pass-through */
+    ASSERT_EQ(g_backing_mallocs, mallocs);
+    for (i = 0; i < 300u; i++) asx_slab_free(&slab, blocks[i]);
+    ASSERT_TRUE(asx_slab_alloc(&slab, 8) == NULL);
+    ASSERT_TRUE(asx_slab_alloc(&slab, 5000) == NULL);
+    ASSERT_EQ(g_backing_mallocs, mallocs);
+
+    asx_slab_destroy(&slab);
+    ASSERT_EQ(g_backing_frees, mallocs);
+}
+
+TEST(slab_reports_through_resource_snapshot) {
+    static asx_slab slab;
+    asx_runtime_hooks hooks;
+    asx_resource_snapshot snap;
+    void *p = NULL;
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_resource_snapshot_get(ASX_RESOURCE_ALLOCATOR, &snap), ASX_OK);
+    ASSERT_EQ(snap.capacity, 0u);
+    ASSERT_STR_EQ(asx_resource_kind_str(ASX_RESOURCE_ALLOCATOR), "allocator");
+
+    ASSERT_EQ(asx_slab_init(&slab, NULL), ASX_OK);
+    ASSERT_EQ(asx_slab_install(&slab, &hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc(48, &p), ASX_OK);
+
+    ASSERT_EQ(asx_resource_snapshot_get(ASX_RESOURCE_ALLOCATOR, &snap), ASX_OK);
+    ASSERT_EQ(snap.kind, ASX_RESOURCE_ALLOCATOR);
+    ASSERT_EQ(snap.used, 1u);
+    ASSERT_TRUE(snap.capacity > 1u);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_ALLOCATOR), 1u);
+    ASSERT_EQ(asx_resource_admit(ASX_RESOURCE_ALLOCATOR, snap.remaining), ASX_OK);
+    ASSERT_EQ(asx_resource_admit(ASX_RESOURCE_ALLOCATOR, snap.remaining + 1u),
+              ASX_E_RESOURCE_EXHAUSTED);
+
+    ASSERT_EQ(asx_runtime_free(p), ASX_OK);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_ALLOCATOR), 0u);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    asx_slab_destroy(&slab);
+}
+
+TEST(slab_thread_cache_batches_shared_list) {
+    asx_slab_config cfg;
+    asx_slab slab;
+    asx_resource_snapshot snap;
+    void *p;
+
+    asx_slab_config_init(&cfg);
+    cfg.thread_cache = 1;
+    ASSERT_EQ(asx_slab_init(&slab, &cfg), ASX_OK);
+    p = asx_slab_alloc(&slab, 32);
+    ASSERT_TRUE(p != NULL);
+    ASSERT_EQ(asx_slab_snapshot(&slab, 1, &snap), ASX_OK);
+#if ASX_SLAB_THREADED
+    /* One lock round trip moved half a cache's worth */
+    ASSERT_EQ(snap.used, ASX_SLAB_CACHE_DEPTH / 2u);
+#else
+    ASSERT_EQ(snap.used, 1u);
+#endif
+
+    /* Freed back into the cache: still held until flushed */
+    asx_slab_free(&slab, p);
+    ASSERT_EQ(asx_slab_snapshot(&slab, 1, &snap), ASX_OK);
+#if ASX_SLAB_THREADED
+    ASSERT_EQ(snap.used, ASX_SLAB_CACHE_DEPTH / 2u);
+#else
+    ASSERT_EQ(snap.used, 0u);
+#endif
+    asx_slab_thread_flush(&slab);
+    ASSERT_EQ(asx_slab_snapshot(&slab, 1, &snap), ASX_OK);
+    ASSERT_EQ(snap.used, 0u);
+    asx_slab_destroy(&slab);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_slab ===\n");
+    RUN_TEST(slab_init_rejects_bad_config);
+    RUN_TEST(slab_rounds_to_class_and_reuses_blocks);
+    RUN_TEST(slab_large_requests_pass_through);
+    RUN_TEST(slab_realloc_moves_across_classes);
+    RUN_TEST(slab_sealed_serves_reserve_without_backing_calls);
+    RUN_TEST(slab_reports_through_resource_snapshot);
+    RUN_TEST(slab_thread_cache_batches_shared_list);
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,389 @@
+/*
+ * test_snapshot.c — unit tests for binary runtime snapshots
+ *
+ * Tests: records after lifecycle transitions, incremental capture
+ * matching a full capture across scheduler steps, refresh of dirty
+ * slots only, full rebuild for a stale snapshot or after reset,
+ * equality, JSON export, binary full/delta round trips, and restore.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/snapshot.h>
+#include <string.h>
+
+/* Polls left before the task completes */
+static uint32_t g_left[8];
+
+static asx_status countdown_poll(void *user_data, asx_task_id self)
+{
+    uint32_t *left = (uint32_t *)user_data;
+
+    (void)self;
+    if (*left == 0) return ASX_OK;
+    (*left)--;
+    return ASX_E_PENDING;
+}
+
+TEST(snapshot_records_lifecycle_state) {
+    asx_runtime_snapshot snap;
+    asx_region_id rid;
+    asx_task_id tid[2];
+    asx_obligation_id oid[2];
+    asx_budget budget = asx_budget_infinite();
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    g_left[0] = 0;
+    g_left[1] = 3;
+    ASSERT_EQ(asx_task_spawn(rid, countdown_poll, &g_left[0], &tid[0]), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, countdown_poll, &g_left[1], &tid[1]), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid[0]), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid[1]), ASX_OK);
+
+    asx_runtime_snapshot_init(&snap);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&snap), ASX_OK);
+    ASSERT_EQ(snap.region_count, 1u);
+    ASSERT_EQ(snap.task_count, 2u);
+    ASSERT_EQ(snap.obligation_count, 2u);
+    ASSERT_EQ(snap.regions[0].id, rid);
+    ASSERT_EQ(snap.regions[0].task_count, 2u);
+    ASSERT_EQ(snap.tasks[1].id, tid[1]);
+    ASSERT_EQ(snap.tasks[1].region, rid);
+    ASSERT_EQ(snap.tasks[1].outcome_status, ASX_E_TASK_NOT_COMPLETED);
+    ASSERT_EQ(snap.obligations[0].state, ASX_OBLIGATION_RESERVED);
+
+    ASSERT_EQ(asx_obligation_commit(oid[0]), ASX_OK);
+    ASSERT_EQ(asx_obligation_abort(oid[1]), ASX_OK);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_poison(rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&snap), ASX_OK);
+    ASSERT_EQ(snap.regions[0].task_count, 0u);
+    ASSERT_EQ(snap.regions[0].task_total, 2u);
+    ASSERT_EQ(snap.regions[0].poisoned, 1);
+    ASSERT_EQ(snap.tasks[0].state, ASX_TASK_COMPLETED);
+    ASSERT_EQ(snap.tasks[1].outcome_status, ASX_OK);
+    ASSERT_EQ(snap.obligations[0].state, ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(snap.obligations[1].state, ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(snap.event_hash, asx_trace_digest());
+}
+
+TEST(snapshot_incremental_matches_full_capture) {
+    asx_runtime_snapshot inc;
+    asx_runtime_snapshot full;
+    asx_region_id rid[2];
+    asx_task_id tid;
+    asx_obligation_id oid;
+    asx_budget budget;
+    asx_status st;
+    uint32_t step;
+    uint32_t k;
+
+    asx_runtime_reset();
+    asx_runtime_snapshot_init(&inc);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&inc), ASX_OK);
+    ASSERT_EQ(inc.region_count, 0u);
+
+    ASSERT_EQ(asx_region_open(&rid[0]), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid[1]), ASX_OK);
+    for (k = 0; k < 8u; k++) {
+        g_left[k] = k;
+        ASSERT_EQ(asx_task_spawn(rid[k % 2u], countdown_poll, &g_left[k], &tid),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid[1], &oid), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&inc), ASX_OK);
+
+    for (step = 0; step < 6u; step++) {
+        budget = asx_budget_from_polls(3);
+        st = asx_scheduler_run(rid[step % 2u], &budget);
+        ASSERT_TRUE(st == ASX_OK || st == ASX_E_POLL_BUDGET_EXHAUSTED);
+        if (step == 2u) {
+            ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+            ASSERT_EQ(asx_region_close(rid[0]), ASX_OK);
+        }
+        ASSERT_EQ(asx_runtime_snapshot_capture(&inc), ASX_OK);
+    }
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid[0], &budget), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&inc), ASX_OK);
+
+    asx_runtime_snapshot_init(&full);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&full), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&inc, &full), ASX_OK);
+    ASSERT_EQ(full.regions[0].state, ASX_REGION_CLOSED);
+}
+
+TEST(snapshot_incremental_rebuilds_only_dirty_slots) {
+    asx_runtime_snapshot snap;
+    asx_region_id rid[2];
+    asx_task_id tid;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid[0]), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid[1]), ASX_OK);
+    asx_runtime_snapshot_init(&snap);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&snap), ASX_OK);
+
+    /* A clean record is carried over as it stands */
+    snap.regions[0].task_total = 99u;
+    g_left[0] = 0;
+    ASSERT_EQ(asx_task_spawn(rid[1], countdown_poll, &g_left[0], &tid), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&snap), ASX_OK);
+    ASSERT_EQ(snap.regions[0].task_total, 99u);
+    ASSERT_EQ(snap.regions[1].task_total, 1u);
+    ASSERT_EQ(snap.task_count, 1u);
+}
+
+TEST(snapshot_stale_or_reset_recaptures_in_full) {
+    asx_runtime_snapshot a;
+    asx_runtime_snapshot b;
+    asx_region_id rid;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    asx_runtime_snapshot_init(&a);
+    asx_runtime_snapshot_init(&b);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&a), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&b), ASX_OK);
+
+    /* b consumed the dirty bits; a is no longer the latest capture */
+    a.regions[0].task_total = 99u;
+    ASSERT_EQ(asx_region_poison(rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&a), ASX_OK);
+    ASSERT_EQ(a.regions[0].task_total, 0u);
+    ASSERT_EQ(a.regions[0].poisoned, 1);
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_snapshot_capture(&a), ASX_OK);
+    ASSERT_EQ(a.region_count, 0u);
+    ASSERT_EQ(a.regions[0].id, ASX_INVALID_ID);
+}
+
+TEST(snapshot_eq_reports_mismatch) {
+    asx_runtime_snapshot a;
+    asx_runtime_snapshot b;
+    asx_region_id rid;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    asx_runtime_snapshot_init(&a);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&a), ASX_OK);
+    b = a;
+    b.capture_mark = 0;
+    ASSERT_EQ(asx_runtime_snapshot_eq(&a, &b), ASX_OK);
+    b.regions[0].state = ASX_REGION_CLOSING;
+    ASSERT_EQ(asx_runtime_snapshot_eq(&a, &b), ASX_E_EQUIVALENCE_MISMATCH);
+    b = a;
+    b.event_hash++;
+    ASSERT_EQ(asx_runtime_snapshot_eq(&a, &b), ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&a, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_snapshot_capture(NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(snapshot_json_lists_used_records) {
+    asx_runtime_snapshot snap;
+    asx_codec_buffer buf;
+    asx_region_id rid;
+    asx_task_id tid;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    g_left[0] = 0;
+    ASSERT_EQ(asx_task_spawn(rid, countdown_poll, &g_left[0], &tid), ASX_OK);
+    asx_runtime_snapshot_init(&snap);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&snap), ASX_OK);
+
+    asx_codec_buffer_init(&buf);
+    ASSERT_EQ(asx_runtime_snapshot_to_json(&snap, &buf), ASX_OK);
+    ASSERT_TRUE(strncmp(buf.data, "{\"regions\":[{\"slot\":0,", 22) == 0);
+    ASSERT_TRUE(strstr(buf.data, "\"task_total\":1") != NULL);
+    ASSERT_TRUE(strstr(buf.data, "\"obligations\":[]") != NULL);
+    ASSERT_TRUE(strstr(buf.data, "\"event_hash\":") != NULL);
+    ASSERT_TRUE(strstr(buf.data, "},{") == NULL);
+    ASSERT_EQ(asx_runtime_snapshot_to_json(NULL, &buf), ASX_E_INVALID_ARGUMENT);
+    asx_codec_buffer_reset(&buf);
+}
+
+TEST(snapshot_binary_full_and_delta_roundtrip) {
+    static uint8_t full_buf[8192];
+    static uint8_t delta_buf[8192];
+    asx_runtime_snapshot base;
+    asx_runtime_snapshot cur;
+    asx_runtime_snapshot dec;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_obligation_id oid;
+    asx_budget budget = asx_budget_infinite();
+    uint32_t full_len;
+    uint32_t delta_len;
+    uint32_t k;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (k = 0; k < 6u; k++) {
+        g_left[k] = 1;
+        ASSERT_EQ(asx_task_spawn(rid, countdown_poll, &g_left[k], &tid), ASX_OK);
+    }
+    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
+    asx_runtime_snapshot_init(&base);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&base), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_encode(&base, NULL, full_buf,
+                                          sizeof(full_buf), &full_len), ASX_OK);
+    ASSERT_EQ(full_len, ASX_SNAPSHOT_BINARY_HEADER + 8u * ASX_SNAPSHOT_BINARY_RECORD);
+
+    ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
+    ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_USER), ASX_OK);
+    cur = base;
+    ASSERT_EQ(asx_runtime_snapshot_capture(&cur), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_encode(&cur, &base, delta_buf,
+                                          sizeof(delta_buf), &delta_len), ASX_OK);
+    /* The cancelled task and the committed obligation */
+    ASSERT_EQ(delta_len, ASX_SNAPSHOT_BINARY_HEADER + 2u * ASX_SNAPSHOT_BINARY_RECORD);
+
+    asx_runtime_snapshot_init(&dec);
+    ASSERT_EQ(asx_runtime_snapshot_decode(&dec, delta_buf, delta_len),
+              ASX_E_REPLAY_MISMATCH);
+    ASSERT_EQ(asx_runtime_snapshot_decode(&dec, full_buf, full_len), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&dec, &base), ASX_OK);
+    ASSERT_EQ(dec.capture_mark, 0u);
+    ASSERT_EQ(asx_runtime_snapshot_decode(&dec, delta_buf, delta_len), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&dec, &cur), ASX_OK);
+
+    /* Corruption and truncation are refused, leaving dec as it was */
+    delta_buf[ASX_SNAPSHOT_BINARY_HEADER + 4u] ^= 1u;
+    ASSERT_EQ(asx_runtime_snapshot_decode(&base, delta_buf, delta_len),
+              ASX_E_REPLAY_MISMATCH);
+    ASSERT_EQ(asx_runtime_snapshot_decode(&dec, full_buf, full_len - 1u),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&dec, &cur), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_encode(&cur, NULL, full_buf, 64u, &full_len),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+}
+
+static asx_status rebind_countdown(void *ctx, const asx_snapshot_task *task,
+                                   asx_task_poll_fn *out_poll,
+                                   void **out_user_data)
+{
+    (void)ctx;
+    *out_poll = countdown_poll;
+    *out_user_data = &g_left[asx_handle_slot(task->id)];
+    return ASX_OK;
+}
+
+TEST(snapshot_restore_rebuilds_arenas) {
+    asx_runtime_snapshot before;
+    asx_runtime_snapshot after;
+    asx_region_id root, child;
+    asx_region_options opts;
+    asx_task_id tid[4];
+    asx_obligation_id oid[2];
+    asx_task_state ts;
+    asx_region_state rs;
+    asx_budget budget;
+    asx_status st;
+    asx_generation gen;
+    uint32_t k;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&root), ASX_OK);
+    asx_region_options_init(&opts);
+    opts.parent = root;
+    ASSERT_EQ(asx_region_open_with(&opts, &child), ASX_OK);
+    for (k = 0; k < 4u; k++) {
+        g_left[k] = k * 2u;
+        ASSERT_EQ(asx_task_spawn(k < 2u ? root : child, countdown_poll,
+                                 &g_left[k], &tid[k]), ASX_OK);
+    }
+    ASSERT_EQ(asx_obligation_reserve(child, &oid[0]), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(root, &oid[1]), ASX_OK);
+    ASSERT_EQ(asx_obligation_abort(oid[1]), ASX_OK);
+    budget = asx_budget_from_polls(3);
+    st = asx_scheduler_run(root, &budget);
+    ASSERT_TRUE(st == ASX_OK || st == ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_task_cancel(tid[3], ASX_CANCEL_USER), ASX_OK);
+    asx_runtime_snapshot_init(&before);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&before), ASX_OK);
+
+    /* Nothing changes without poll functions for unfinished tasks */
+    ASSERT_EQ(asx_runtime_snapshot_restore(&before, NULL, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_get_state(tid[3], &ts), ASX_OK);
+
+    /* A fresh runtime, as after a restart, rebuilt from the snapshot */
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_snapshot_restore(&before, rebind_countdown, NULL),
+              ASX_OK);
+    asx_runtime_snapshot_init(&after);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&after), ASX_OK);
+    after.event_hash = before.event_hash;
+    ASSERT_EQ(asx_runtime_snapshot_eq(&after, &before), ASX_OK);
+
+    /* Old handles keep working and the run finishes */
+    ASSERT_EQ(asx_task_get_state(tid[3], &ts), ASX_OK);
+    ASSERT_EQ(ts, ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_obligation_commit(oid[0]), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(oid[1]), ASX_E_INVALID_TRANSITION);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(root, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_get_state(child, &rs), ASX_OK);
+    ASSERT_EQ(rs, ASX_REGION_CLOSED);
+    ASSERT_EQ(asx_task_get_state(tid[2], &ts), ASX_OK);
+    ASSERT_EQ(ts, ASX_TASK_COMPLETED);
+
+    /* Slot reuse moves to the next generation */
+    gen = asx_handle_generation(child);
+    ASSERT_EQ(asx_region_open(&child), ASX_OK);
+    ASSERT_EQ(asx_handle_generation(child), gen + 1u);
+}
+
+TEST(snapshot_restore_rejects_inconsistent_snapshot) {
+    asx_runtime_snapshot snap;
+    asx_runtime_snapshot bad;
+    asx_region_id rid;
+    asx_task_id tid;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    g_left[0] = 0;
+    ASSERT_EQ(asx_task_spawn(rid, countdown_poll, &g_left[0], &tid), ASX_OK);
+    asx_runtime_snapshot_init(&snap);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&snap), ASX_OK);
+
+    bad = snap;
+    bad.regions[0].task_count = 2u;
+    ASSERT_EQ(asx_runtime_snapshot_restore(&bad, rebind_countdown, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    bad = snap;
+    bad.tasks[3] = bad.tasks[0];
+    bad.task_count++;
+    ASSERT_EQ(asx_runtime_snapshot_restore(&bad, rebind_countdown, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    bad = snap;
+    bad.tasks[0].region = tid;
+    ASSERT_EQ(asx_runtime_snapshot_restore(&bad, rebind_countdown, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_snapshot_restore(NULL, NULL, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_get_state(tid, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_snapshot_restore(&snap, rebind_countdown, NULL), ASX_OK);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_snapshot ===\n");
+    RUN_TEST(snapshot_records_lifecycle_state);
+    RUN_TEST(snapshot_incremental_matches_full_capture);
+    RUN_TEST(snapshot_incremental_rebuilds_only_dirty_slots);
+    RUN_TEST(snapshot_stale_or_reset_recaptures_in_full);
+    RUN_TEST(snapshot_eq_reports_mismatch);
+    RUN_TEST(snapshot_json_lists_used_records);
+    RUN_TEST(snapshot_binary_full_and_delta_roundtrip);
+    RUN_TEST(snapshot_restore_rebuilds_arenas);
+    RUN_TEST(snapshot_restore_rejects_inconsistent_snapshot);
+    TEST_REPORT();
+    return test_failures;
+}
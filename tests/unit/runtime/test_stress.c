@@ -534,16 +534,14 @@ TEST(obligation_rapid_reserve_commit_cycle)
     reset_all();
     ASSERT_EQ(asx_region_open(&rid), ASX_OK);
 
-    /* Rapidly reserve and commit obligations.
-     * The walking skeleton doesn't recycle slots, so we're bounded
-     * by ASX_MAX_OBLIGATIONS. */
-    for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
+    /* Rapidly reserve and commit obligations. Resolved slots are
+     * recycled, so the total is unbounded and one slot serves all. */
+    for (i = 0; i < 10u * ASX_MAX_OBLIGATIONS; i++) {
         ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_OK);
         ASSERT_EQ(asx_obligation_commit(oid), ASX_OK);
     }
-
-    /* Arena exhausted — no recycling in walking skeleton */
-    ASSERT_EQ(asx_obligation_reserve(rid, &oid), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_handle_slot(oid), (uint16_t)0);
+    ASSERT_EQ(asx_resource_used(ASX_RESOURCE_OBLIGATION), 0u);
 }
 
 TEST(obligation_mixed_commit_abort_pattern)
@@ -0,0 +1,229 @@
+/*
+ * test_task_group.c — unit tests for task groups
+ *
+ * Tests: argument checks and pool exhaustion, a parent woken once when
+ * every child is done with the joined outcome, "first N" waits, members
+ * that completed before being added, and destroy and region close
+ * freeing groups.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+
+static asx_budget make_budget(uint32_t poll_quota)
+{
+    asx_budget b = asx_budget_infinite();
+    b.poll_quota = poll_quota;
+    return b;
+}
+
+/* Child: completes after *user_data polls; fails if that is 3 */
+static uint32_t g_child_polls[8];
+
+static asx_status child_poll(void *user_data, asx_task_id self)
+{
+    uint32_t *left = (uint32_t *)user_data;
+
+    (void)self;
+    if (--*left > 0u) return ASX_E_PENDING;
+    return (left == &g_child_polls[2]) ? ASX_E_INVALID_STATE : ASX_OK;
+}
+
+static asx_status pending_poll(void *user_data, asx_task_id self)
+{
+    (void)user_data;
+    (void)self;
+    return ASX_E_PENDING;
+}
+
+ASX_CO_FRAME_BEGIN(parent_frame)
+    asx_task_group group;
+    uint32_t       count;
+    asx_outcome    outcome;
+    asx_status     st;
+    uint32_t       done_at_wake;
+    int            polls;
+ASX_CO_FRAME_END(parent_frame);
+
+static asx_status parent_poll(void *user_data, asx_task_id self)
+{
+    parent_frame *f = ASX_CO_FRAME(parent_frame, user_data);
+    uint32_t members;
+
+    f->polls++;
+    ASX_CO_BEGIN(&f->co);
+    ASX_CO_AWAIT_GROUP(&f->co, self, &f->group, f->count, &f->outcome, f->st);
+    if (asx_task_group_progress(&f->group, &f->done_at_wake, &members) != ASX_OK) {
+        return ASX_E_INVALID_STATE;
+    }
+    ASX_CO_END(&f->co);
+}
+
+/* Run until quiescent; the failing child stops a run early once */
+static asx_status run_family(asx_region_id rid, uint32_t poll_quota)
+{
+    asx_budget budget = make_budget(poll_quota);
+    asx_status st = asx_scheduler_run(rid, &budget);
+
+    if (st == ASX_E_INVALID_STATE) {
+        budget = make_budget(poll_quota);
+        st = asx_scheduler_run(rid, &budget);
+    }
+    return st;
+}
+
+/* Spawn the parent, then n children of increasing length into its group */
+static parent_frame *spawn_family(asx_region_id rid, uint32_t n, uint32_t count)
+{
+    asx_task_id tid;
+    void *mem = NULL;
+    parent_frame *f;
+    uint32_t i;
+
+    if (ASX_CO_SPAWN(rid, parent_frame, parent_poll, &tid, &mem) != ASX_OK) return NULL;
+    f = (parent_frame *)mem;
+    f->count = count;
+    if (asx_task_group_create(rid, &f->group) != ASX_OK) return NULL;
+    for (i = 0; i < n; i++) {
+        g_child_polls[i] = i + 1u;
+        if (asx_task_spawn(rid, child_poll, &g_child_polls[i], &tid) != ASX_OK) return NULL;
+        if (asx_task_group_add(&f->group, tid) != ASX_OK) return NULL;
+    }
+    return f;
+}
+
+TEST(group_checks_arguments) {
+    asx_region_id rid;
+    asx_region_id other;
+    asx_task_group group;
+    asx_task_group last;
+    asx_task_group extra;
+    asx_task_id tid;
+    asx_task_id stranger;
+    asx_outcome outcome;
+    uint32_t done;
+    uint32_t members;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_task_group_create(rid, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_group_create(ASX_INVALID_ID, &group), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_task_group_create(rid, &group), ASX_OK);
+
+    ASSERT_EQ(asx_task_spawn(rid, pending_poll, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(other, pending_poll, NULL, &stranger), ASX_OK);
+    ASSERT_EQ(asx_task_group_add(NULL, tid), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_group_add(&group, stranger), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_group_add(&group, tid), ASX_OK);
+    ASSERT_EQ(asx_task_group_add(&group, tid), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_task_group_try_join(&group, 2, &outcome), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_group_try_join(&group, 0, &outcome), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_task_park_on_group(tid, &group, 2), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_group_progress(&group, &done, &members), ASX_OK);
+    ASSERT_EQ(done, 0u);
+    ASSERT_EQ(members, 1u);
+    ASSERT_EQ(asx_task_group_destroy(&group), ASX_E_TASK_NOT_COMPLETED);
+
+    for (i = 1; i < ASX_MAX_TASK_GROUPS; i++) {
+        ASSERT_EQ(asx_task_group_create(other, &last), ASX_OK);
+    }
+    ASSERT_EQ(asx_task_group_create(other, &extra), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_task_group_destroy(&last), ASX_OK);
+    ASSERT_EQ(asx_task_group_destroy(&last), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_task_group_create(other, &extra), ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(group_wakes_parent_once_when_all_done) {
+    asx_region_id rid;
+    parent_frame *f;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    f = spawn_family(rid, 6, 0);
+    ASSERT_TRUE(f != NULL);
+
+    ASSERT_EQ(run_family(rid, 1000), ASX_OK);
+    ASSERT_EQ(f->polls, 2);
+    ASSERT_EQ(f->st, ASX_OK);
+    ASSERT_EQ(f->done_at_wake, 6u);
+    /* Child 2 failed: ERR joins over the OKs */
+    ASSERT_EQ(f->outcome.severity, ASX_OUTCOME_ERR);
+    ASSERT_EQ(asx_task_group_destroy(&f->group), ASX_OK);
+    asx_runtime_reset();
+}
+
+TEST(group_first_n_done_wakes_early) {
+    asx_region_id rid;
+    parent_frame *f;
+    asx_outcome outcome;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    f = spawn_family(rid, 6, 2);
+    ASSERT_TRUE(f != NULL);
+
+    ASSERT_EQ(run_family(rid, 1000), ASX_OK);
+    ASSERT_EQ(f->polls, 2);
+    ASSERT_EQ(f->st, ASX_OK);
+    ASSERT_TRUE(f->done_at_wake >= 2u && f->done_at_wake < 6u);
+    ASSERT_EQ(f->outcome.severity, ASX_OUTCOME_OK);
+
+    /* The group kept counting after the parent left */
+    ASSERT_EQ(asx_task_group_try_join(&f->group, 0, &outcome), ASX_OK);
+    ASSERT_EQ(outcome.severity, ASX_OUTCOME_ERR);
+    asx_runtime_reset();
+}
+
+TEST(group_counts_completed_member_and_region_close_frees) {
+    asx_region_id rid;
+    asx_task_group group;
+    asx_task_group groups[ASX_MAX_TASK_GROUPS];
+    asx_task_id tid;
+    asx_budget budget;
+    asx_outcome outcome;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    g_child_polls[0] = 1;
+    ASSERT_EQ(asx_task_spawn(rid, child_poll, &g_child_polls[0], &tid), ASX_OK);
+    budget = make_budget(10);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    ASSERT_EQ(asx_task_group_create(rid, &group), ASX_OK);
+    ASSERT_EQ(asx_task_group_try_join(&group, 0, &outcome), ASX_OK);
+    ASSERT_EQ(asx_task_group_add(&group, tid), ASX_OK);
+    ASSERT_EQ(asx_task_group_try_join(&group, 1, &outcome), ASX_OK);
+    ASSERT_EQ(outcome.severity, ASX_OUTCOME_OK);
+
+    for (i = 1; i < ASX_MAX_TASK_GROUPS; i++) {
+        ASSERT_EQ(asx_task_group_create(rid, &groups[i]), ASX_OK);
+    }
+    budget = make_budget(100);
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_group_try_join(&group, 0, &outcome), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASK_GROUPS; i++) {
+        ASSERT_EQ(asx_task_group_create(rid, &groups[i]), ASX_OK);
+    }
+    asx_runtime_reset();
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_task_group ===\n");
+    RUN_TEST(group_checks_arguments);
+    RUN_TEST(group_wakes_parent_once_when_all_done);
+    RUN_TEST(group_first_n_done_wakes_early);
+    RUN_TEST(group_counts_completed_member_and_region_close_frees);
+    TEST_REPORT();
+    return test_failures;
+}
@@ -14,11 +14,18 @@
 
 /* ---- Tier configuration ---- */
 
-TEST(telemetry_default_tier_is_forensic) {
+/* Most verbose tier this build runs at, and where a request lands
+ * after clamping: FORENSIC unless ASX_TELEMETRY_MIN_TIER raises it */
+#define TIER_FLOOR ((asx_telemetry_tier)ASX_TELEMETRY_MIN_TIER)
+#define TIER_CLAMPED(t) ((int)(t) < ASX_TELEMETRY_MIN_TIER ? TIER_FLOOR : (t))
+
+TEST(telemetry_default_tier_is_most_verbose) {
     asx_telemetry_reset();
-    ASSERT_EQ(asx_telemetry_get_tier(), ASX_TELEMETRY_FORENSIC);
+    ASSERT_EQ(asx_telemetry_get_tier(), TIER_FLOOR);
 }
 
+#if !ASX_STATIC_PROFILE
+/* Runtime tier switches; ASX_STATIC_PROFILE pins the tier instead */
 TEST(telemetry_set_tier_valid) {
     asx_status st;
 
@@ -26,7 +33,7 @@ TEST(telemetry_set_tier_valid) {
 
     st = asx_telemetry_set_tier(ASX_TELEMETRY_OPS_LIGHT);
     ASSERT_EQ(st, ASX_OK);
-    ASSERT_EQ(asx_telemetry_get_tier(), ASX_TELEMETRY_OPS_LIGHT);
+    ASSERT_EQ(asx_telemetry_get_tier(), TIER_CLAMPED(ASX_TELEMETRY_OPS_LIGHT));
 
     st = asx_telemetry_set_tier(ASX_TELEMETRY_ULTRA_MIN);
     ASSERT_EQ(st, ASX_OK);
@@ -34,8 +41,9 @@ TEST(telemetry_set_tier_valid) {
 
     st = asx_telemetry_set_tier(ASX_TELEMETRY_FORENSIC);
     ASSERT_EQ(st, ASX_OK);
-    ASSERT_EQ(asx_telemetry_get_tier(), ASX_TELEMETRY_FORENSIC);
+    ASSERT_EQ(asx_telemetry_get_tier(), TIER_FLOOR);
 }
+#endif
 
 TEST(telemetry_set_tier_invalid) {
     asx_status st;
@@ -43,9 +51,27 @@ TEST(telemetry_set_tier_invalid) {
     st = asx_telemetry_set_tier((asx_telemetry_tier)99);
     ASSERT_EQ(st, ASX_E_INVALID_ARGUMENT);
     /* Tier should remain unchanged */
-    ASSERT_EQ(asx_telemetry_get_tier(), ASX_TELEMETRY_FORENSIC);
+    ASSERT_EQ(asx_telemetry_get_tier(), TIER_FLOOR);
 }
 
+#if ASX_STATIC_PROFILE
+/* The tier is fixed at ASX_TELEMETRY_MIN_TIER: more verbose requests
+ * clamp to it, less verbose ones are refused */
+TEST(telemetry_static_profile_pins_tier) {
+    int t;
+
+    asx_telemetry_reset();
+    ASSERT_EQ((int)asx_telemetry_get_tier(), ASX_TELEMETRY_MIN_TIER);
+    for (t = (int)ASX_TELEMETRY_FORENSIC; t <= (int)ASX_TELEMETRY_ULTRA_MIN; t++) {
+        ASSERT_EQ(asx_telemetry_set_tier((asx_telemetry_tier)t),
+                  t > ASX_TELEMETRY_MIN_TIER ? ASX_E_INVALID_STATE : ASX_OK);
+        ASSERT_EQ((int)asx_telemetry_get_tier(), ASX_TELEMETRY_MIN_TIER);
+    }
+    asx_telemetry_reset();
+    ASSERT_EQ((int)asx_telemetry_get_tier(), ASX_TELEMETRY_MIN_TIER);
+}
+#endif
+
 /* ---- Tier string ---- */
 
 TEST(telemetry_tier_str_coverage) {
@@ -57,6 +83,7 @@ TEST(telemetry_tier_str_coverage) {
 
 /* ---- Forensic tier: all events recorded ---- */
 
+#if ASX_TELEMETRY_MIN_TIER == 0
 TEST(telemetry_forensic_records_all) {
     asx_telemetry_reset();
     asx_trace_reset();
@@ -72,9 +99,11 @@ TEST(telemetry_forensic_records_all) {
     ASSERT_EQ(asx_telemetry_emitted_count(), (uint32_t)5);
     ASSERT_EQ(asx_telemetry_filtered_count(), (uint32_t)0);
 }
+#endif
 
 /* ---- OPS_LIGHT tier: only lifecycle events retained ---- */
 
+#if !ASX_STATIC_PROFILE && ASX_TELEMETRY_MIN_TIER <= 1
 TEST(telemetry_ops_light_filters_polls) {
     asx_status st;
 
@@ -111,9 +140,11 @@ TEST(telemetry_ops_light_filters_polls) {
     ASSERT_EQ(asx_trace_event_count(), (uint32_t)8);
     ASSERT_EQ(asx_telemetry_filtered_count(), (uint32_t)10);
 }
+#endif
 
 /* ---- ULTRA_MIN tier: no events stored ---- */
 
+#if !ASX_STATIC_PROFILE
 TEST(telemetry_ultra_min_stores_nothing) {
     asx_status st;
 
@@ -133,9 +164,11 @@ TEST(telemetry_ultra_min_stores_nothing) {
     ASSERT_EQ(asx_telemetry_emitted_count(), (uint32_t)4);
     ASSERT_EQ(asx_telemetry_filtered_count(), (uint32_t)4);
 }
+#endif
 
 /* ---- Digest tier-independence (critical invariant) ---- */
 
+#if !ASX_STATIC_PROFILE
 TEST(telemetry_digest_identical_across_tiers) {
     uint64_t d_forensic, d_ops, d_ultra;
     asx_status st;
@@ -178,6 +211,7 @@ TEST(telemetry_digest_identical_across_tiers) {
     ASSERT_EQ(d_forensic, d_ops);
     ASSERT_EQ(d_ops, d_ultra);
 }
+#endif
 
 TEST(telemetry_digest_deterministic_across_runs) {
     uint64_t d1, d2;
@@ -250,8 +284,29 @@ TEST(telemetry_retains_ultra_min_none) {
     ASSERT_FALSE(asx_telemetry_retains(ASX_TELEMETRY_ULTRA_MIN, ASX_TRACE_TIMER_FIRE));
 }
 
+TEST(telemetry_retains_kinds_outside_mask_range) {
+    /* Kinds the policy mask cannot index share one "other" bit */
+    asx_trace_event_kind odd = (asx_trace_event_kind)0x18;
+    asx_trace_event_kind high = (asx_trace_event_kind)0xF0;
+
+    ASSERT_TRUE(asx_telemetry_retains(ASX_TELEMETRY_FORENSIC, odd));
+    ASSERT_TRUE(asx_telemetry_retains(ASX_TELEMETRY_FORENSIC, high));
+    ASSERT_FALSE(asx_telemetry_retains(ASX_TELEMETRY_OPS_LIGHT, odd));
+    ASSERT_FALSE(asx_telemetry_retains(ASX_TELEMETRY_OPS_LIGHT, high));
+    ASSERT_FALSE(asx_telemetry_retains(ASX_TELEMETRY_ULTRA_MIN, high));
+    ASSERT_FALSE(asx_telemetry_retains((asx_telemetry_tier)99,
+                                       ASX_TRACE_REGION_OPEN));
+
+    /* Neighbours of retained kinds stay filtered under OPS_LIGHT */
+    ASSERT_TRUE(asx_telemetry_retains(ASX_TELEMETRY_OPS_LIGHT, ASX_TRACE_SCHED_QUIESCENT));
+    ASSERT_FALSE(asx_telemetry_retains(ASX_TELEMETRY_OPS_LIGHT, ASX_TRACE_SCHED_ROUND));
+    ASSERT_TRUE(asx_telemetry_retains(ASX_TELEMETRY_OPS_LIGHT, ASX_TRACE_TASK_TRANSITION));
+    ASSERT_FALSE(asx_telemetry_retains(ASX_TELEMETRY_OPS_LIGHT, ASX_TRACE_TASK_PARK));
+}
+
 /* ---- Reset ---- */
 
+#if !ASX_STATIC_PROFILE
 TEST(telemetry_reset_clears_all) {
     asx_status st;
 
@@ -267,14 +322,16 @@ TEST(telemetry_reset_clears_all) {
 
     asx_telemetry_reset();
 
-    ASSERT_EQ(asx_telemetry_get_tier(), ASX_TELEMETRY_FORENSIC);
+    ASSERT_EQ(asx_telemetry_get_tier(), TIER_FLOOR);
     ASSERT_EQ(asx_telemetry_emitted_count(), (uint32_t)0);
     ASSERT_EQ(asx_telemetry_filtered_count(), (uint32_t)0);
     ASSERT_EQ(asx_telemetry_digest(), (uint64_t)0x517cc1b727220a95ULL);
 }
+#endif
 
 /* ---- Mixed-tier scenario ---- */
 
+#if !ASX_STATIC_PROFILE
 TEST(telemetry_mid_scenario_tier_switch) {
     uint64_t d_pure, d_switched;
     asx_status st;
@@ -304,9 +361,11 @@ TEST(telemetry_mid_scenario_tier_switch) {
     /* Rolling digest is tier-independent */
     ASSERT_EQ(d_pure, d_switched);
 }
+#endif
 
 /* ---- Large-volume filtered scenario ---- */
 
+#if !ASX_STATIC_PROFILE
 TEST(telemetry_high_volume_filtered) {
     uint32_t i;
     asx_status st;
@@ -328,27 +387,42 @@ TEST(telemetry_high_volume_filtered) {
     /* Digest must still be non-trivial (not the offset basis) */
     ASSERT_TRUE(asx_telemetry_digest() != (uint64_t)0x517cc1b727220a95ULL);
 }
+#endif
 
 /* ---- Suite runner ---- */
 
 int main(void) {
-    RUN_TEST(telemetry_default_tier_is_forensic);
+    RUN_TEST(telemetry_default_tier_is_most_verbose);
+#if !ASX_STATIC_PROFILE
     RUN_TEST(telemetry_set_tier_valid);
+#endif
     RUN_TEST(telemetry_set_tier_invalid);
+#if ASX_STATIC_PROFILE
+    RUN_TEST(telemetry_static_profile_pins_tier);
+#endif
     RUN_TEST(telemetry_tier_str_coverage);
+#if ASX_TELEMETRY_MIN_TIER == 0
     RUN_TEST(telemetry_forensic_records_all);
+#endif
+#if !ASX_STATIC_PROFILE && ASX_TELEMETRY_MIN_TIER <= 1
     RUN_TEST(telemetry_ops_light_filters_polls);
+#endif
+#if !ASX_STATIC_PROFILE
     RUN_TEST(telemetry_ultra_min_stores_nothing);
     RUN_TEST(telemetry_digest_identical_across_tiers);
+#endif
     RUN_TEST(telemetry_digest_deterministic_across_runs);
     RUN_TEST(telemetry_digest_differs_on_different_input);
     RUN_TEST(telemetry_digest_empty_is_fnv_offset);
     RUN_TEST(telemetry_retains_forensic_all);
     RUN_TEST(telemetry_retains_ops_light_selective);
     RUN_TEST(telemetry_retains_ultra_min_none);
+    RUN_TEST(telemetry_retains_kinds_outside_mask_range);
+#if !ASX_STATIC_PROFILE
     RUN_TEST(telemetry_reset_clears_all);
     RUN_TEST(telemetry_mid_scenario_tier_switch);
     RUN_TEST(telemetry_high_volume_filtered);
+#endif
     TEST_REPORT();
     return test_failures;
 }
@@ -1,8 +1,9 @@
 /*
  * test_trace.c — unit tests for deterministic event trace, replay, and snapshot
  *
- * Tests: trace emission, digest computation, replay verification,
- * snapshot export, and deterministic identity across runs.
+ * Tests: trace emission, digest computation, round-mode rebuild,
+ * replay verification, kind filtering, trace diff windows, snapshot
+ * export, and deterministic identity across runs.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -11,6 +12,7 @@
 #include <asx/asx.h>
 #include <asx/runtime/trace.h>
 #include <asx/core/ghost.h>
+#include <string.h>
 
 /* ---- Trace emission ---- */
 
@@ -119,6 +121,159 @@ TEST(trace_digest_empty_is_stable) {
     ASSERT_EQ(d1, d2);
 }
 
+/* Full-rescan reference: FNV-1a over every stored event's fields */
+static uint64_t rescan_digest(void) {
+    uint64_t hash = 0x517cc1b727220a95ULL;
+    uint32_t i, b;
+    asx_trace_event e;
+
+    for (i = 0; asx_trace_event_get(i, &e); i++) {
+        uint32_t k = (uint32_t)e.kind;
+        const uint8_t *fields[4];
+        uint32_t sizes[4];
+        uint32_t f;
+        fields[0] = (const uint8_t *)&e.sequence;  sizes[0] = sizeof(e.sequence);
+        fields[1] = (const uint8_t *)&k;           sizes[1] = sizeof(k);
+        fields[2] = (const uint8_t *)&e.entity_id; sizes[2] = sizeof(e.entity_id);
+        fields[3] = (const uint8_t *)&e.aux;       sizes[3] = sizeof(e.aux);
+        for (f = 0; f < 4; f++) {
+            for (b = 0; b < sizes[f]; b++) {
+                hash ^= (uint64_t)fields[f][b];
+                hash *= 0x00000100000001B3ULL;
+            }
+        }
+    }
+    return hash;
+}
+
+TEST(trace_running_digest_matches_rescan) {
+    uint64_t once;
+    uint64_t full;
+    uint32_t i;
+
+    asx_trace_reset();
+    for (i = 0; i < 300; i++) {
+        asx_trace_emit((asx_trace_event_kind)(i % 8u), i * 7u, i);
+    }
+    once = asx_trace_digest();
+
+    /* Querying after every emit gives the same value */
+    asx_trace_reset();
+    for (i = 0; i < 300; i++) {
+        asx_trace_emit((asx_trace_event_kind)(i % 8u), i * 7u, i);
+        ASSERT_EQ(asx_trace_digest(), rescan_digest());
+    }
+    ASSERT_EQ(asx_trace_digest(), once);
+
+    /* Events past capacity are not stored and do not change it */
+    for (i = 300; i < ASX_TRACE_CAPACITY + 10u; i++) {
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, i, 0);
+    }
+    full = asx_trace_digest();
+    ASSERT_EQ(full, rescan_digest());
+    asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, 1);
+    ASSERT_EQ(asx_trace_digest(), full);
+
+    /* Reset restarts from the empty digest */
+    asx_trace_reset();
+    ASSERT_EQ(asx_trace_digest(), rescan_digest());
+}
+
+/* ---- Round mode ---- */
+
+#if !ASX_HANDLE_EPOCH
+/* The canonical run and the round-mode run sit in different reset epochs */
+static uint32_t g_rt_left[4];
+static uint32_t g_rt_ids[4] = { 0, 1, 2, 3 };
+
+/* Emits a channel event on every other poll so held polls interleave
+ * with stored events */
+static asx_status round_task_poll(void *user_data, asx_task_id self)
+{
+    uint32_t k = *(const uint32_t *)user_data;
+
+    (void)self;
+    if (g_rt_left[k] % 2u == 0) {
+        asx_trace_emit(ASX_TRACE_CHANNEL_SEND, k, g_rt_left[k]);
+    }
+    if (g_rt_left[k] == 0) return ASX_OK;
+    g_rt_left[k]--;
+    return ASX_E_PENDING;
+}
+
+/* Run four tasks of polls..polls+3 polls; returns the pending round
+ * record count before anything reads the trace. */
+static uint32_t run_round_scenario(uint32_t polls)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget = asx_budget_infinite();
+    uint32_t k;
+
+    asx_runtime_reset();
+    asx_trace_reset();
+    if (asx_region_open(&rid) != ASX_OK) return UINT32_MAX;
+    for (k = 0; k < 4u; k++) {
+        g_rt_left[k] = polls + k;
+        if (asx_task_spawn(rid, round_task_poll, &g_rt_ids[k], &tid) != ASX_OK) {
+            return UINT32_MAX;
+        }
+    }
+    if (asx_scheduler_run(rid, &budget) != ASX_OK) return UINT32_MAX;
+    return asx_trace_round_count();
+}
+
+TEST(trace_round_mode_rebuilds_canonical_stream) {
+    static asx_trace_event canon[ASX_TRACE_CAPACITY];
+    asx_trace_event ev;
+    asx_trace_round rec;
+    uint32_t count;
+    uint32_t rounds;
+    uint64_t digest;
+    uint32_t polls[2] = { 5, 400 };
+    uint32_t p;
+    uint32_t i;
+
+    for (p = 0; p < 2u; p++) {
+        asx_trace_set_round_mode(0);
+        ASSERT_EQ(run_round_scenario(polls[p]), (uint32_t)0);
+        count = asx_trace_event_count();
+        for (i = 0; i < count; i++) ASSERT_TRUE(asx_trace_event_get(i, &canon[i]));
+        digest = asx_trace_digest();
+
+        asx_trace_set_round_mode(1);
+        ASSERT_TRUE(asx_trace_round_mode_enabled());
+        /* One record per round; the long run stops holding polls
+         * once the canonical stream would fill the ring */
+        rounds = run_round_scenario(polls[p]);
+        if (p == 0) {
+            ASSERT_EQ(rounds, (uint32_t)9);
+        } else {
+            ASSERT_TRUE(rounds > 9u && rounds < polls[p]);
+            ASSERT_EQ(count, ASX_TRACE_CAPACITY);
+        }
+        ASSERT_TRUE(asx_trace_round_get(0, &rec));
+        ASSERT_EQ(rec.round, (uint32_t)0);
+        ASSERT_EQ(rec.first_index, (uint32_t)0);
+        ASSERT_EQ(rec.polled, (uint64_t)0xF);
+        ASSERT_FALSE(asx_trace_round_get(ASX_TRACE_ROUND_CAPACITY, &rec));
+
+        /* First read rebuilds: same events, sequence and digest */
+        ASSERT_EQ(asx_trace_event_count(), count);
+        ASSERT_EQ(asx_trace_round_count(), (uint32_t)0);
+        for (i = 0; i < count; i++) {
+            ASSERT_TRUE(asx_trace_event_get(i, &ev));
+            ASSERT_EQ(ev.sequence, canon[i].sequence);
+            ASSERT_EQ(ev.kind, canon[i].kind);
+            ASSERT_EQ(ev.entity_id, canon[i].entity_id);
+            ASSERT_EQ(ev.aux, canon[i].aux);
+        }
+        ASSERT_EQ(asx_trace_digest(), digest);
+    }
+    asx_trace_set_round_mode(0);
+}
+#endif
+
 /* ---- Replay verification ---- */
 
 TEST(replay_match_identical_sequence) {
@@ -242,6 +397,187 @@ TEST(replay_reference_rejects_over_capacity) {
               ASX_E_INVALID_ARGUMENT);
 }
 
+/* ---- Kind filter ---- */
+
+/* One region, then rounds of polls over three tasks */
+static void emit_filter_scenario(void)
+{
+    uint32_t r;
+    uint32_t t;
+
+    asx_trace_emit(ASX_TRACE_REGION_OPEN, 0x1000, 0);
+    for (t = 0; t < 3; t++) asx_trace_emit(ASX_TRACE_TASK_SPAWN, 0x2000 + t, 0x1000);
+    for (r = 0; r < 5; r++) {
+        for (t = 0; t < 3; t++) asx_trace_emit(ASX_TRACE_SCHED_POLL, 0x2000 + t, r);
+    }
+    asx_trace_emit(ASX_TRACE_REGION_CLOSED, 0x1000, 0);
+}
+
+TEST(trace_kind_filter_keeps_semantic_digest) {
+    asx_trace_event ev;
+    uint64_t unfiltered;
+
+    asx_trace_reset();
+    emit_filter_scenario();
+    unfiltered = asx_trace_digest();
+
+    asx_trace_set_kind_enabled(ASX_TRACE_SCHED_POLL, 0);
+    ASSERT_FALSE(asx_trace_kind_enabled(ASX_TRACE_SCHED_POLL));
+    ASSERT_TRUE(asx_trace_kind_enabled(ASX_TRACE_TASK_SPAWN));
+    asx_trace_reset();
+    emit_filter_scenario();
+
+    /* Only lifecycle events are stored, at their stream positions */
+    ASSERT_EQ(asx_trace_event_count(), (uint32_t)5);
+    ASSERT_EQ(asx_trace_filtered_count(), (uint32_t)15);
+    ASSERT_TRUE(asx_trace_event_get(4, &ev));
+    ASSERT_EQ(ev.kind, ASX_TRACE_REGION_CLOSED);
+    ASSERT_EQ(ev.sequence, (uint32_t)19);
+    ASSERT_EQ(asx_trace_digest(), unfiltered);
+
+    asx_trace_set_kind_enabled(ASX_TRACE_SCHED_POLL, 1);
+    ASSERT_TRUE(asx_trace_kind_enabled(ASX_TRACE_SCHED_POLL));
+    asx_trace_reset();
+    ASSERT_EQ(asx_trace_filtered_count(), (uint32_t)0);
+}
+
+TEST(trace_kind_filter_export_replays) {
+    static uint8_t buf[ASX_TRACE_BINARY_HEADER + 64u * ASX_TRACE_BINARY_EVENT];
+    uint32_t len;
+
+    asx_trace_set_kind_enabled(ASX_TRACE_SCHED_POLL, 0);
+    asx_trace_reset();
+    emit_filter_scenario();
+    ASSERT_EQ(asx_trace_export_binary(buf, sizeof(buf), &len), ASX_OK);
+
+    /* The export's digest covers what it holds, so it imports */
+    ASSERT_EQ(asx_trace_import_binary(buf, len), ASX_OK);
+    asx_trace_reset();
+    emit_filter_scenario();
+    ASSERT_EQ(asx_replay_verify().result, ASX_REPLAY_MATCH);
+
+    asx_replay_clear_reference();
+    asx_trace_set_kind_enabled(ASX_TRACE_SCHED_POLL, 1);
+}
+
+/* ---- Trace diff ---- */
+
+static uint32_t g_diff_work[ASX_TRACE_DIFF_WORK_WORDS(64u)];
+
+static void diff_fill(asx_trace_event *e, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        e[i].sequence = i;
+        e[i].kind = ASX_TRACE_SCHED_POLL;
+        e[i].entity_id = 0x2000u + i;
+        e[i].aux = 0;
+    }
+}
+
+TEST(replay_diff_realigns_after_inserted_poll) {
+    asx_trace_event ref[10];
+    asx_trace_diff diff;
+    uint32_t i;
+
+    diff_fill(ref, 10);
+    ASSERT_EQ(asx_replay_load_reference(ref, 10), ASX_OK);
+
+    /* An extra poll before event 3, and event 7's aux differs */
+    asx_trace_reset();
+    for (i = 0; i < 10; i++) {
+        if (i == 3) asx_trace_emit(ASX_TRACE_SCHED_POLL, 0x9999, 0);
+        asx_trace_emit(ref[i].kind, ref[i].entity_id, i == 7 ? 1u : 0u);
+    }
+    /* Verify only sees the lengths differ */
+    ASSERT_EQ(asx_replay_verify().result, ASX_REPLAY_LENGTH_MISMATCH);
+
+    ASSERT_EQ(asx_replay_diff(g_diff_work, ASX_TRACE_DIFF_WORK_WORDS(64u),
+                              &diff), ASX_OK);
+    ASSERT_TRUE(diff.aligned);
+    ASSERT_EQ(diff.edits, (uint32_t)3);
+    ASSERT_EQ(diff.matched, (uint32_t)9);
+    ASSERT_EQ(diff.window_count, (uint32_t)2);
+    ASSERT_EQ(diff.windows[0].ref_start, (uint32_t)3);
+    ASSERT_EQ(diff.windows[0].ref_len, (uint32_t)0);
+    ASSERT_EQ(diff.windows[0].act_start, (uint32_t)3);
+    ASSERT_EQ(diff.windows[0].act_len, (uint32_t)1);
+    ASSERT_EQ(diff.windows[1].ref_start, (uint32_t)7);
+    ASSERT_EQ(diff.windows[1].ref_len, (uint32_t)1);
+    ASSERT_EQ(diff.windows[1].act_start, (uint32_t)8);
+    ASSERT_EQ(diff.windows[1].act_len, (uint32_t)1);
+
+    /* Identical traces have no windows */
+    ASSERT_EQ(asx_trace_diff_events(ref, 10, ref, 10, NULL, 0, &diff), ASX_OK);
+    ASSERT_EQ(diff.window_count, (uint32_t)0);
+    ASSERT_EQ(diff.matched, (uint32_t)10);
+
+    asx_replay_clear_reference();
+}
+
+TEST(trace_diff_counts_windows_past_storage) {
+    asx_trace_event ref[60];
+    asx_trace_event act[60];
+    asx_trace_diff diff;
+    uint32_t i;
+
+    /* Every third event dropped: 20 one-event windows */
+    diff_fill(ref, 60);
+    memcpy(act, ref, sizeof(act));
+    for (i = 0; i < 20; i++) act[i * 3u + 1u].entity_id = 0x9999;
+
+    ASSERT_EQ(asx_trace_diff_events(ref, 60, act, 60, g_diff_work,
+                                    ASX_TRACE_DIFF_WORK_WORDS(64u), &diff),
+              ASX_OK);
+    ASSERT_TRUE(diff.aligned);
+    ASSERT_EQ(diff.edits, (uint32_t)40);
+    ASSERT_EQ(diff.window_count, (uint32_t)20);
+    for (i = 0; i < ASX_TRACE_DIFF_MAX_WINDOWS; i++) {
+        ASSERT_EQ(diff.windows[i].ref_start, i * 3u + 1u);
+        ASSERT_EQ(diff.windows[i].ref_len, (uint32_t)1);
+        ASSERT_EQ(diff.windows[i].act_len, (uint32_t)1);
+    }
+}
+
+TEST(trace_diff_beyond_band_is_unaligned) {
+    asx_trace_event ref[8];
+    asx_trace_event act[8];
+    asx_trace_diff diff;
+
+    diff_fill(ref, 8);
+    memcpy(act, ref, sizeof(act));
+    act[2].aux = 1;
+    act[5].aux = 1;
+
+    /* Room for one edit only; the gap needs four */
+    ASSERT_EQ(asx_trace_diff_events(ref, 8, act, 8, g_diff_work,
+                                    ASX_TRACE_DIFF_WORK_WORDS(1u), &diff),
+              ASX_OK);
+    ASSERT_FALSE(diff.aligned);
+    ASSERT_EQ(diff.window_count, (uint32_t)1);
+    ASSERT_EQ(diff.windows[0].ref_start, (uint32_t)2);
+    ASSERT_EQ(diff.windows[0].ref_len, (uint32_t)4);
+    ASSERT_EQ(diff.windows[0].act_len, (uint32_t)4);
+    ASSERT_EQ(diff.matched, (uint32_t)4);
+
+    /* A pure deletion needs no work space */
+    ASSERT_EQ(asx_trace_diff_events(ref, 8, act, 1, NULL, 0, &diff), ASX_OK);
+    ASSERT_TRUE(diff.aligned);
+    ASSERT_EQ(diff.edits, (uint32_t)7);
+    ASSERT_EQ(diff.windows[0].ref_start, (uint32_t)1);
+    ASSERT_EQ(diff.windows[0].ref_len, (uint32_t)7);
+
+    ASSERT_EQ(asx_trace_diff_events(NULL, 1, act, 8, NULL, 0, &diff),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_diff_events(ref, 8, act, 8, NULL, 4, &diff),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_diff_events(ref, 8, act, 8, NULL, 0, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    asx_replay_clear_reference();
+    ASSERT_EQ(asx_replay_diff(NULL, 0, &diff), ASX_E_INVALID_STATE);
+}
+
 /* ---- Snapshot export ---- */
 
 TEST(snapshot_capture_empty) {
@@ -298,6 +634,92 @@ TEST(snapshot_null_returns_error) {
     ASSERT_EQ(asx_snapshot_capture(NULL), ASX_E_INVALID_ARGUMENT);
 }
 
+/* ---- JSON export ---- */
+
+static asx_codec_buffer g_json_sunk;
+static uint32_t g_json_chunks;
+static uint32_t g_json_fail_at;
+
+static asx_status json_collect_sink(void *ctx, const uint8_t *chunk, uint32_t len)
+{
+    (void)ctx;
+    g_json_chunks++;
+    if (g_json_fail_at != 0 && g_json_chunks == g_json_fail_at) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    return asx_codec_buffer_append_bytes(&g_json_sunk, (const char *)chunk, len);
+}
+
+TEST(trace_export_json_formats_events) {
+    asx_codec_buffer out;
+
+    asx_codec_buffer_init(&out);
+    asx_trace_reset();
+    ASSERT_EQ(asx_trace_export_json(&out), ASX_OK);
+    ASSERT_STR_EQ(out.data, "[]");
+
+    asx_trace_emit(ASX_TRACE_REGION_OPEN, 0, 0);
+    asx_trace_emit(ASX_TRACE_TASK_SPAWN, 18446744073709551615ULL, 10);
+    asx_trace_emit(ASX_TRACE_SCHED_POLL, 9999999999ULL, 100);
+    ASSERT_EQ(asx_trace_export_json(&out), ASX_OK);
+    ASSERT_STR_EQ(out.data,
+        "[{\"sequence\":0,\"kind\":\"region_open\",\"entity_id\":0,\"aux\":0},"
+        "{\"sequence\":1,\"kind\":\"task_spawn\","
+        "\"entity_id\":18446744073709551615,\"aux\":10},"
+        "{\"sequence\":2,\"kind\":\"sched_poll\","
+        "\"entity_id\":9999999999,\"aux\":100}]");
+    ASSERT_EQ(out.len, strlen(out.data));
+
+    ASSERT_EQ(asx_trace_export_json(NULL), ASX_E_INVALID_ARGUMENT);
+    asx_codec_buffer_reset(&out);
+}
+
+TEST(trace_export_json_includes_deltas_when_timed) {
+    asx_codec_buffer out;
+
+    asx_codec_buffer_init(&out);
+    asx_trace_reset();
+    asx_trace_set_timestamps(1);
+    asx_trace_emit(ASX_TRACE_SCHED_POLL, 1, 2);
+    ASSERT_EQ(asx_trace_export_json(&out), ASX_OK);
+    asx_trace_set_timestamps(0);
+    ASSERT_TRUE(strstr(out.data, ",\"delta_ns\":") != NULL);
+    asx_codec_buffer_reset(&out);
+}
+
+TEST(trace_export_json_sink_matches_buffer_export) {
+    asx_codec_buffer out;
+    uint32_t i;
+
+    asx_codec_buffer_init(&out);
+    asx_codec_buffer_init(&g_json_sunk);
+    asx_trace_reset();
+    for (i = 0; i < ASX_TRACE_CAPACITY; i++) {
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, 0xFFFFFFFFFFFF0000ULL + i,
+                       (uint64_t)i * 1000003u);
+    }
+    ASSERT_EQ(asx_trace_export_json(&out), ASX_OK);
+
+    g_json_chunks = 0;
+    g_json_fail_at = 0;
+    ASSERT_EQ(asx_trace_export_json_sink(json_collect_sink, NULL), ASX_OK);
+    ASSERT_TRUE(g_json_chunks > 1u);
+    ASSERT_EQ(g_json_sunk.len, out.len);
+    ASSERT_TRUE(memcmp(g_json_sunk.data, out.data, out.len) == 0);
+
+    /* A failing sink stops the export */
+    g_json_chunks = 0;
+    g_json_fail_at = 2;
+    ASSERT_EQ(asx_trace_export_json_sink(json_collect_sink, NULL),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(g_json_chunks, 2u);
+    g_json_fail_at = 0;
+
+    ASSERT_EQ(asx_trace_export_json_sink(NULL, NULL), ASX_E_INVALID_ARGUMENT);
+    asx_codec_buffer_reset(&g_json_sunk);
+    asx_codec_buffer_reset(&out);
+}
+
 /* ---- String helpers ---- */
 
 TEST(trace_event_kind_str_all_kinds) {
@@ -323,16 +745,28 @@ int main(void) {
     RUN_TEST(trace_digest_deterministic);
     RUN_TEST(trace_digest_differs_on_different_events);
     RUN_TEST(trace_digest_empty_is_stable);
+    RUN_TEST(trace_running_digest_matches_rescan);
+#if !ASX_HANDLE_EPOCH
+    RUN_TEST(trace_round_mode_rebuilds_canonical_stream);
+#endif
     RUN_TEST(replay_match_identical_sequence);
     RUN_TEST(replay_detects_length_mismatch);
     RUN_TEST(replay_detects_kind_mismatch);
     RUN_TEST(replay_detects_entity_mismatch);
     RUN_TEST(replay_no_reference_is_match);
     RUN_TEST(replay_reference_rejects_over_capacity);
+    RUN_TEST(trace_kind_filter_keeps_semantic_digest);
+    RUN_TEST(trace_kind_filter_export_replays);
+    RUN_TEST(replay_diff_realigns_after_inserted_poll);
+    RUN_TEST(trace_diff_counts_windows_past_storage);
+    RUN_TEST(trace_diff_beyond_band_is_unaligned);
     RUN_TEST(snapshot_capture_empty);
     RUN_TEST(snapshot_capture_with_region);
     RUN_TEST(snapshot_digest_deterministic);
     RUN_TEST(snapshot_null_returns_error);
+    RUN_TEST(trace_export_json_formats_events);
+    RUN_TEST(trace_export_json_includes_deltas_when_timed);
+    RUN_TEST(trace_export_json_sink_matches_buffer_export);
     RUN_TEST(trace_event_kind_str_all_kinds);
     RUN_TEST(replay_result_kind_str_all_kinds);
 
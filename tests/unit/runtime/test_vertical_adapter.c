@@ -2,8 +2,9 @@
  * test_vertical_adapter.c — vertical acceleration adapter tests (bd-j4m.5)
  *
  * Validates adapter descriptors, evaluation correctness, mode
- * invariance (isomorphism), annotation population, and regression
- * diagnostics for HFT, AUTOMOTIVE, and EMBEDDED_ROUTER adapters.
+ * invariance (isomorphism), annotation population, compiled decision
+ * tables, and regression diagnostics for HFT, AUTOMOTIVE, and
+ * EMBEDDED_ROUTER adapters.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -15,6 +16,7 @@
 #include <asx/runtime/automotive_instrument.h>
 #include <asx/runtime/overload_catalog.h>
 #include <asx/runtime/profile_compat.h>
+#include <asx/runtime/hindsight.h>
 #include <string.h>
 
 /* ===================================================================
@@ -487,6 +489,61 @@ TEST(adapter_decision_consistent_with_catalog)
     }
 }
 
+/* ===================================================================
+ * Compiled decision table tests
+ * =================================================================== */
+
+#define TABLE_CASES (3u + 4u + 5u + 102u + 335u)
+
+TEST(tables_match_reference_evaluation)
+{
+    static const uint32_t caps[] = { 1, 2, 3, 100, 333 };
+    static asx_adapter_result ref[ASX_ADAPTER_COUNT][TABLE_CASES];
+    uint32_t a, c, used, k;
+
+    asx_adapter_reset_all();
+    ASSERT_EQ(asx_adapter_tables_enabled(), 0);
+    for (a = 0; a < (uint32_t)ASX_ADAPTER_COUNT; a++) {
+        k = 0;
+        for (c = 0; c < 5u; c++) {
+            for (used = 0; used <= caps[c] + 1u; used++) {
+                ASSERT_EQ(asx_adapter_evaluate((asx_adapter_id)a,
+                          ASX_ADAPTER_MODE_FALLBACK, used, caps[c],
+                          &ref[a][k++]), ASX_OK);
+            }
+        }
+    }
+
+    ASSERT_EQ(asx_adapter_tables_build(), ASX_OK);
+    ASSERT_EQ(asx_adapter_tables_enabled(), 1);
+    for (a = 0; a < (uint32_t)ASX_ADAPTER_COUNT; a++) {
+        k = 0;
+        for (c = 0; c < 5u; c++) {
+            for (used = 0; used <= caps[c] + 1u; used++) {
+                asx_adapter_result got;
+                const asx_overload_decision *d = &ref[a][k].decision;
+                ASSERT_EQ(asx_adapter_evaluate((asx_adapter_id)a,
+                          ASX_ADAPTER_MODE_FALLBACK, used, caps[c], &got),
+                          ASX_OK);
+                ASSERT_EQ(got.decision.triggered, d->triggered);
+                ASSERT_EQ((int)got.decision.mode, (int)d->mode);
+                ASSERT_EQ(got.decision.load_pct, d->load_pct);
+                ASSERT_EQ(got.decision.shed_count, d->shed_count);
+                ASSERT_EQ((int)got.decision.admit_status, (int)d->admit_status);
+                ASSERT_EQ(got.decision_digest, ref[a][k].decision_digest);
+                k++;
+            }
+        }
+    }
+
+    {
+        asx_isomorphism_result iso;
+        ASSERT_EQ(asx_adapter_isomorphism_builtin(ASX_ADAPTER_HFT, &iso), 1);
+    }
+    asx_adapter_tables_clear();
+    ASSERT_EQ(asx_adapter_tables_enabled(), 0);
+}
+
 /* ===================================================================
  * Reset and isolation tests
  * =================================================================== */
@@ -580,6 +637,63 @@ TEST(router_annotations_zero_headroom_at_capacity)
     ASSERT_EQ(res.annotations.router.headroom, 0u);
 }
 
+/* ===================================================================
+ * Shadow evaluation
+ * =================================================================== */
+
+TEST(shadow_samples_one_in_n_per_adapter)
+{
+    asx_adapter_shadow_stats st;
+    asx_adapter_result got, ref;
+    uint32_t i;
+
+    asx_adapter_reset_all();
+    asx_hindsight_reset();
+
+    /* Off by default: accelerated result, nothing re-run */
+    ASSERT_EQ(asx_adapter_evaluate_shadowed(ASX_ADAPTER_HFT, 95, 100, &got),
+              ASX_OK);
+    ASSERT_EQ((int)got.mode, (int)ASX_ADAPTER_MODE_ACCELERATED);
+    ASSERT_EQ(asx_adapter_evaluate(ASX_ADAPTER_HFT,
+              ASX_ADAPTER_MODE_ACCELERATED, 95, 100, &ref), ASX_OK);
+    ASSERT_EQ(got.decision_digest, ref.decision_digest);
+    asx_adapter_shadow_stats_get(&st);
+    ASSERT_EQ(st.evaluations, 1u);
+    ASSERT_EQ(st.sampled, 0u);
+
+    /* 1 in 4, counted per adapter: evaluations 0, 4, 8 of each */
+    asx_adapter_shadow_set_rate(4);
+    for (i = 0; i < 10u; i++) {
+        ASSERT_EQ(asx_adapter_evaluate_shadowed(ASX_ADAPTER_ROUTER,
+                  i * 10u, 100, &got), ASX_OK);
+        ASSERT_EQ(asx_adapter_evaluate_shadowed(ASX_ADAPTER_AUTOMOTIVE,
+                  i * 10u, 100, &got), ASX_OK);
+    }
+    asx_adapter_shadow_stats_get(&st);
+    ASSERT_EQ(st.evaluations, 21u);
+    ASSERT_EQ(st.sampled, 6u);
+    ASSERT_EQ(st.divergences, 0u);
+    ASSERT_EQ(asx_hindsight_total_count(), 0u);
+
+    /* Every evaluation at rate 1 */
+    asx_adapter_shadow_set_rate(1);
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_adapter_evaluate_shadowed(ASX_ADAPTER_HFT, 50, 100,
+                  &got), ASX_OK);
+    }
+    asx_adapter_shadow_stats_get(&st);
+    ASSERT_EQ(st.sampled, 9u);
+
+    ASSERT_EQ(asx_adapter_evaluate_shadowed(ASX_ADAPTER_COUNT, 1, 2, &got),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_adapter_evaluate_shadowed(ASX_ADAPTER_HFT, 1, 2, NULL),
+              ASX_E_INVALID_ARGUMENT);
+
+    asx_adapter_reset_all();
+    asx_adapter_shadow_stats_get(&st);
+    ASSERT_EQ(st.evaluations, 0u);
+}
+
 /* ===================================================================
  * main
  * =================================================================== */
@@ -641,6 +755,12 @@ int main(void)
     RUN_TEST(adapter_profile_matches_catalog);
     RUN_TEST(adapter_decision_consistent_with_catalog);
 
+    /* Compiled decision tables */
+    RUN_TEST(tables_match_reference_evaluation);
+
+    /* Shadow evaluation */
+    RUN_TEST(shadow_samples_one_in_n_per_adapter);
+
     /* Reset and isolation */
     RUN_TEST(reset_clears_state);
 
@@ -0,0 +1,1043 @@
+/*
+ * test_waker.c — task parking and event-driven wakeups
+ *
+ * Tests: parked tasks are not polled, the scheduler reports idle with
+ * ASX_E_PENDING, channel/timer/obligation sources wake their waiters,
+ * cancel wakes a parked task so drain completes, a park intent is
+ * dropped when the poll does not return PENDING, wake order is
+ * recorded deterministically in the trace, an idle wait sleeps in
+ * the reactor exactly until the next timer deadline, and select parks
+ * on several channels and a timer at once. I/O keys wake their
+ * waiters, a wake visits only the waiters sharing its source's bucket,
+ * on Linux an io_uring completion wakes its task, and on freestanding
+ * targets a WFI reactor line wakes its task.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifdef ASX_PROFILE_POSIX
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/waker.h>
+#include <asx/core/channel.h>
+#include <asx/core/ghost.h>
+#include <asx/time/timer_wheel.h>
+
+/* Internal header for the wake visit count */
+#include "../../../src/runtime/runtime_internal.h"
+
+static void waker_test_reset(void)
+{
+    asx_runtime_reset();
+    asx_ghost_reset();
+    asx_channel_reset();
+    asx_trace_reset();
+}
+
+/* ---- Test poll functions ---- */
+
+/* Channel receiver: parks on the channel until a value arrives. */
+typedef struct {
+    asx_channel_id channel;
+    uint64_t       received;
+    int            polls;
+} recv_ctx;
+
+static asx_status poll_recv(void *data, asx_task_id self)
+{
+    recv_ctx *c = (recv_ctx *)data;
+    asx_status st;
+
+    c->polls++;
+    st = asx_channel_try_recv(c->channel, &c->received);
+    if (st == ASX_OK) return ASX_OK;
+    if (st != ASX_E_WOULD_BLOCK) return st;
+    st = asx_task_park_on_channel(self, c->channel);
+    if (st != ASX_OK) return st;
+    return ASX_E_PENDING;
+}
+
+/* Generic waiter: parks on a timer or obligation until fired. */
+typedef struct {
+    asx_timer_handle  timer;
+    asx_obligation_id obligation;
+    int               use_timer;
+    int               fired;
+    int               polls;
+} wait_ctx;
+
+static asx_status poll_wait(void *data, asx_task_id self)
+{
+    wait_ctx *c = (wait_ctx *)data;
+    asx_status st;
+
+    c->polls++;
+    if (c->fired) return ASX_OK;
+    if (c->use_timer) {
+        st = asx_task_park_on_timer(self, &c->timer);
+    } else {
+        st = asx_task_park_on_obligation(self, c->obligation);
+    }
+    if (st != ASX_OK) return st;
+    return ASX_E_PENDING;
+}
+
+/* Parks, then completes in the same poll: the park must be dropped. */
+static asx_status poll_park_then_complete(void *data, asx_task_id self)
+{
+    asx_channel_id *ch = (asx_channel_id *)data;
+    if (asx_task_park_on_channel(self, *ch) != ASX_OK) return ASX_E_INVALID_STATE;
+    return ASX_OK;
+}
+
+/* Selects over a set of channels and an optional timer. */
+typedef struct {
+    asx_select_set set;
+    uint32_t       ready;
+    int            polls;
+} select_ctx;
+
+static asx_status poll_select(void *data, asx_task_id self)
+{
+    select_ctx *c = (select_ctx *)data;
+    c->polls++;
+    return asx_select(self, &c->set, &c->ready);
+}
+
+static void send_value(asx_channel_id ch, uint64_t v)
+{
+    asx_send_permit permit;
+    if (asx_channel_try_reserve(ch, &permit) == ASX_OK &&
+        asx_send_permit_send(&permit, v) != ASX_OK) {
+        fprintf(stderr, "send_value: send failed\n");
+    }
+}
+
+/* ---- Tests ---- */
+
+TEST(parked_task_not_polled_and_scheduler_idles)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_scheduler_event ev;
+    recv_ctx ctx;
+    int parked = 0;
+    uint32_t n;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ctx.channel), ASX_OK);
+    ctx.received = 0;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_recv, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(ctx.polls, 1);
+    ASSERT_EQ(asx_task_is_parked(tid, &parked), ASX_OK);
+    ASSERT_EQ(parked, 1);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)1);
+
+    n = asx_scheduler_event_count();
+    ASSERT_TRUE(asx_scheduler_event_get(n - 1, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_IDLE);
+
+    /* Running again without an event does not poll the task */
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(ctx.polls, 1);
+}
+
+TEST(channel_send_wakes_receiver)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_send_permit permit;
+    asx_task_state st;
+    recv_ctx ctx;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ctx.channel), ASX_OK);
+    ctx.received = 0;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_recv, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+
+    ASSERT_EQ(asx_channel_try_reserve(ctx.channel, &permit), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&permit, 42), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(ctx.polls, 2);
+    ASSERT_EQ(ctx.received, (uint64_t)42);
+    ASSERT_EQ(asx_task_get_state(tid, &st), ASX_OK);
+    ASSERT_EQ(st, ASX_TASK_COMPLETED);
+}
+
+TEST(timer_fire_wakes_waiter)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    void *wakers[4];
+    wait_ctx ctx;
+
+    waker_test_reset();
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ctx.use_timer = 1;
+    ctx.fired = 0;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_timer_register(w, 10, &ctx, &ctx.timer), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_wait, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+
+    /* Not yet due: still parked */
+    ASSERT_EQ(asx_timer_collect_expired(w, 5, wakers, 4), (uint32_t)0);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)1);
+
+    ASSERT_EQ(asx_timer_collect_expired(w, 10, wakers, 4), (uint32_t)1);
+    ((wait_ctx *)wakers[0])->fired = 1;
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(ctx.polls, 2);
+    asx_timer_wheel_reset(w);
+}
+
+TEST(obligation_commit_wakes_waiter)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    wait_ctx ctx;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ctx.use_timer = 0;
+    ctx.fired = 0;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_obligation_reserve(rid, &ctx.obligation), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_wait, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+
+    ASSERT_EQ(asx_obligation_commit(ctx.obligation), ASX_OK);
+    ctx.fired = 1;
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(ctx.polls, 2);
+}
+
+TEST(cancel_wakes_parked_task_and_drain_completes)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_region_state rs;
+    recv_ctx ctx;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ctx.channel), ASX_OK);
+    ctx.received = 0;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_recv, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+
+    ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_USER), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_get_state(rid, &rs), ASX_OK);
+    ASSERT_EQ(rs, ASX_REGION_CLOSED);
+}
+
+TEST(park_intent_dropped_when_poll_completes)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_channel_id ch;
+    asx_budget budget;
+    asx_task_state st;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_park_then_complete, &ch, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+    ASSERT_EQ(asx_task_get_state(tid, &st), ASX_OK);
+    ASSERT_EQ(st, ASX_TASK_COMPLETED);
+}
+
+TEST(park_terminal_task_rejected)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_channel_id ch;
+    asx_budget budget;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_park_then_complete, &ch, &tid), ASX_OK);
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    ASSERT_EQ(asx_task_park_on_channel(tid, ch), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_task_park_on_timer(tid, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(wake_order_follows_park_order_in_trace)
+{
+    asx_region_id rid;
+    asx_task_id tids[3];
+    asx_budget budget;
+    asx_trace_event ev;
+    asx_send_permit permit;
+    recv_ctx ctx[3];
+    uint32_t i;
+    uint32_t n;
+    uint32_t wakes = 0;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_channel_create(rid, 4, &ctx[i].channel), ASX_OK);
+        ctx[i].received = 0;
+        ctx[i].polls = 0;
+    }
+    /* All three receivers wait on channel 0 */
+    ctx[1].channel = ctx[0].channel;
+    ctx[2].channel = ctx[0].channel;
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_recv, &ctx[i], &tids[i]), ASX_OK);
+    }
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)3);
+
+    ASSERT_EQ(asx_channel_try_reserve(ctx[0].channel, &permit), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&permit, 7), ASX_OK);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+
+    n = asx_trace_event_count();
+    for (i = 0; i < n; i++) {
+        ASSERT_TRUE(asx_trace_event_get(i, &ev));
+        if (ev.kind != ASX_TRACE_TASK_WAKE) continue;
+        ASSERT_EQ(asx_handle_slot((asx_task_id)ev.entity_id),
+                  asx_handle_slot(tids[wakes]));
+        ASSERT_EQ(ev.aux, (uint64_t)ASX_PARK_CHANNEL);
+        wakes++;
+    }
+    ASSERT_EQ(wakes, (uint32_t)3);
+
+    /* One value for three waiters: first receiver wins, rest re-park */
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(ctx[0].received, (uint64_t)7);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)2);
+}
+
+/* Fake clock and reactor: a wait advances the clock by its timeout
+ * (live) or to the requested logical step (deterministic ghost). */
+static asx_time g_fake_now;
+static uint32_t g_wait_calls;
+static uint32_t g_wait_timeout_ms;
+
+static asx_time fake_clock(void *ctx)
+{
+    (void)ctx;
+    return g_fake_now;
+}
+
+static asx_status fake_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                    uint32_t *ready_count)
+{
+    (void)ctx;
+    g_wait_calls++;
+    g_wait_timeout_ms = timeout_ms;
+    g_fake_now += (asx_time)timeout_ms * 1000000u;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+static asx_status fake_ghost_wait(void *ctx, uint64_t logical_step,
+                                  uint32_t *ready_count)
+{
+    (void)ctx;
+    g_wait_calls++;
+    if (logical_step > g_fake_now) g_fake_now = logical_step;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+TEST(idle_wait_sleeps_until_next_timer)
+{
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    wait_ctx ctx;
+    uint32_t fired = 99;
+
+    waker_test_reset();
+    asx_timer_wheel_reset(w);
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = fake_clock;
+    hooks.clock.logical_now_ns_fn = fake_clock;
+    hooks.reactor.wait_fn = fake_reactor_wait;
+    hooks.reactor.ghost_wait_fn = fake_ghost_wait;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_fake_now = 0;
+    g_wait_calls = 0;
+    g_wait_timeout_ms = 0;
+
+    /* No timers: the wait is the caller's cap and nothing fires */
+    ASSERT_EQ(asx_scheduler_wait_idle(7, &fired), ASX_OK);
+    ASSERT_EQ(fired, (uint32_t)0);
+    ASSERT_EQ(g_wait_calls, (uint32_t)1);
+    g_fake_now = 0;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ctx.use_timer = 1;
+    ctx.fired = 0;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_timer_register(w, 2500000u, &ctx, &ctx.timer), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_wait, &ctx, &tid), ASX_OK);
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+
+    /* One wait, rounded up past the deadline, fires and wakes */
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(fired, (uint32_t)1);
+    ASSERT_EQ(g_wait_calls, (uint32_t)2);
+#if !ASX_DETERMINISTIC
+    ASSERT_EQ(g_wait_timeout_ms, (uint32_t)3);
+#endif
+    ASSERT_TRUE(g_fake_now >= 2500000u);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+    ctx.fired = 1;
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* A timer already due skips the reactor */
+    ASSERT_EQ(asx_timer_register(w, g_fake_now, &ctx, &ctx.timer), ASX_OK);
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(fired, (uint32_t)1);
+    ASSERT_EQ(g_wait_calls, (uint32_t)2);
+
+    ASSERT_EQ(asx_scheduler_wait_idle(0, NULL), ASX_E_INVALID_ARGUMENT);
+    asx_timer_wheel_reset(w);
+}
+
+/* Deadline victim: parks on a far timer, or spins while park is 0 and
+ * moves the fake clock on its third poll; records the cancel kind. */
+typedef struct {
+    asx_timer_handle timer;
+    int              park;
+    int              polls;
+    int              cancelled;
+    asx_cancel_kind  kind;
+} deadline_ctx;
+
+static asx_status poll_until_deadline(void *data, asx_task_id self)
+{
+    deadline_ctx *c = (deadline_ctx *)data;
+    asx_checkpoint_result cp;
+    asx_status st;
+
+    c->polls++;
+    st = asx_checkpoint(self, &cp);
+    if (st != ASX_OK) return st;
+    if (cp.cancelled) {
+        c->cancelled = 1;
+        c->kind = cp.kind;
+        return ASX_OK;
+    }
+    if (!c->park) {
+        if (c->polls == 3) g_fake_now += 2000000u;
+        return ASX_E_PENDING;
+    }
+    st = asx_task_park_on_timer(self, &c->timer);
+    if (st != ASX_OK) return st;
+    return ASX_E_PENDING;
+}
+
+TEST(region_deadline_cancels_subtree_with_deadline_kind)
+{
+    asx_runtime_hooks hooks;
+    asx_region_options opts;
+    asx_region_id rid, child, other;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    deadline_ctx parked, spinner, bystander;
+    asx_time next;
+    uint32_t fired;
+
+    waker_test_reset();
+    asx_timer_wheel_reset(w);
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = fake_clock;
+    hooks.clock.logical_now_ns_fn = fake_clock;
+    hooks.reactor.wait_fn = fake_reactor_wait;
+    hooks.reactor.ghost_wait_fn = fake_ghost_wait;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_fake_now = 0;
+
+    /* Idle path: the deadline timer sizes the wait, the next round cancels */
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    asx_region_options_init(&opts);
+    opts.parent = rid;
+    ASSERT_EQ(asx_region_open_with(&opts, &child), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    memset(&parked, 0, sizeof(parked));
+    memset(&bystander, 0, sizeof(bystander));
+    parked.park = 1;
+    bystander.park = 1;
+    ASSERT_EQ(asx_timer_register(w, 1000000000u, NULL, &parked.timer), ASX_OK);
+    bystander.timer = parked.timer;
+    ASSERT_EQ(asx_task_spawn(child, poll_until_deadline, &parked, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(other, poll_until_deadline, &bystander, &tid), ASX_OK);
+    ASSERT_EQ(asx_region_set_deadline(rid, 5000000u), ASX_OK);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)5000000u);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(child, &budget), ASX_E_PENDING);
+    ASSERT_EQ(parked.cancelled, 0);
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(fired, (uint32_t)1);
+    ASSERT_TRUE(g_fake_now >= 5000000u);
+    /* Running the child still sees its parent's deadline */
+    ASSERT_EQ(asx_scheduler_run(child, &budget), ASX_OK);
+    ASSERT_EQ(parked.cancelled, 1);
+    ASSERT_EQ((int)parked.kind, (int)ASX_CANCEL_DEADLINE);
+    ASSERT_EQ(asx_scheduler_run(other, &budget), ASX_E_PENDING);
+    ASSERT_EQ(bystander.cancelled, 0);
+
+    /* Busy path: no idle wait, the round's clock read sees it pass */
+    memset(&spinner, 0, sizeof(spinner));
+    ASSERT_EQ(asx_task_spawn(child, poll_until_deadline, &spinner, &tid), ASX_OK);
+    ASSERT_EQ(asx_region_set_deadline(child, g_fake_now + 1000000u), ASX_OK);
+    ASSERT_EQ(asx_scheduler_run(child, &budget), ASX_OK);
+    ASSERT_EQ(spinner.polls, 4);
+    ASSERT_EQ((int)spinner.kind, (int)ASX_CANCEL_DEADLINE);
+
+    /* Cleared deadlines leave the wheel; CLOSED regions refuse one */
+    ASSERT_EQ(asx_region_set_deadline(other, g_fake_now + 1000000u), ASX_OK);
+    ASSERT_EQ(asx_region_set_deadline(other, 0), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)1);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_set_deadline(rid, g_fake_now + 1u), ASX_E_REGION_CLOSED);
+    asx_timer_wheel_reset(w);
+}
+
+TEST(obligation_lease_expiry_aborts_and_unblocks_drain)
+{
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_obligation_id leased, plain, early;
+    asx_obligation_state state;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_trace_event ev;
+    uint32_t fired;
+    uint32_t i;
+    int traced = 0;
+
+    waker_test_reset();
+    asx_timer_wheel_reset(w);
+    (void)asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = fake_clock;
+    hooks.clock.logical_now_ns_fn = fake_clock;
+    hooks.reactor.wait_fn = fake_reactor_wait;
+    hooks.reactor.ghost_wait_fn = fake_ghost_wait;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_fake_now = 0;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve_leased(rid, 5000000u, &leased), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &plain), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)1);
+
+    /* Replace, remove, and resolution all give the timer back */
+    ASSERT_EQ(asx_obligation_set_lease(plain, 3000000u), ASX_OK);
+    ASSERT_EQ(asx_obligation_set_lease(plain, 4000000u), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)2);
+    ASSERT_EQ(asx_obligation_set_lease(plain, 0), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve_leased(rid, 2000000u, &early), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(early), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)1);
+    ASSERT_EQ(asx_obligation_set_lease(early, 1u), ASX_E_INVALID_STATE);
+
+    /* An unleased reservation still blocks the drain; leased ones wait */
+    ASSERT_EQ(asx_region_close(rid), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_E_OBLIGATIONS_UNRESOLVED);
+    ASSERT_EQ(asx_obligation_abort(plain), ASX_OK);
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_obligation_get_state(leased, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_OBLIGATION_RESERVED);
+
+    /* The lease timer sizes the idle wait; the next drain aborts it */
+    ASSERT_EQ(asx_scheduler_wait_idle(1000, &fired), ASX_OK);
+    ASSERT_EQ(fired, (uint32_t)1);
+    ASSERT_TRUE(g_fake_now >= 5000000u);
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_obligation_get_state(leased, &state), ASX_OK);
+    ASSERT_EQ((int)state, (int)ASX_OBLIGATION_ABORTED);
+
+    for (i = 0; i < asx_trace_event_count(); i++) {
+        ASSERT_TRUE(asx_trace_event_get(i, &ev));
+        if (ev.kind == ASX_TRACE_OBLIGATION_ABORT) {
+            ASSERT_EQ(ev.entity_id, leased);
+            ASSERT_EQ(ev.aux, (uint64_t)5000000u);
+            traced++;
+        }
+    }
+    ASSERT_EQ(traced, 1);
+    asx_timer_wheel_reset(w);
+}
+
+TEST(select_returns_first_ready_source_in_order)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    select_ctx ctx;
+    uint32_t idx = 99;
+    uint64_t v;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ctx.set.channels[0]), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ctx.set.channels[1]), ASX_OK);
+    ctx.set.channel_count = 2;
+    ctx.set.timer_wheel = NULL;
+    ctx.set.timer = NULL;
+    ASSERT_EQ(asx_task_spawn(rid, poll_select, &ctx, &tid), ASX_OK);
+
+    send_value(ctx.set.channels[1], 1);
+    send_value(ctx.set.channels[0], 2);
+    ASSERT_EQ(asx_select(tid, &ctx.set, &idx), ASX_OK);
+    ASSERT_EQ(idx, (uint32_t)0);
+
+    ASSERT_EQ(asx_channel_try_recv(ctx.set.channels[0], &v), ASX_OK);
+    ASSERT_EQ(asx_select(tid, &ctx.set, &idx), ASX_OK);
+    ASSERT_EQ(idx, (uint32_t)1);
+
+    /* A closed sender makes the channel ready (recv reports it) */
+    ASSERT_EQ(asx_channel_try_recv(ctx.set.channels[1], &v), ASX_OK);
+    ASSERT_EQ(asx_channel_close_sender(ctx.set.channels[0]), ASX_OK);
+    ASSERT_EQ(asx_select(tid, &ctx.set, &idx), ASX_OK);
+    ASSERT_EQ(idx, (uint32_t)0);
+
+    ASSERT_EQ(asx_select(tid, NULL, &idx), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_select(tid, &ctx.set, NULL), ASX_E_INVALID_ARGUMENT);
+    ctx.set.channel_count = 0;
+    ASSERT_EQ(asx_select(tid, &ctx.set, &idx), ASX_E_INVALID_ARGUMENT);
+    ctx.set.channel_count = ASX_SELECT_MAX_CHANNELS + 1u;
+    ASSERT_EQ(asx_select(tid, &ctx.set, &idx), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(select_parks_until_any_channel_is_ready)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    select_ctx ctx;
+    uint32_t i;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_channel_create(rid, 4, &ctx.set.channels[i]), ASX_OK);
+    }
+    ctx.set.channel_count = 3;
+    ctx.set.timer_wheel = NULL;
+    ctx.set.timer = NULL;
+    ctx.polls = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_select, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)1);
+
+    /* Not re-polled until a source in the set signals */
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(ctx.polls, 1);
+
+    send_value(ctx.set.channels[2], 7);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(ctx.polls, 2);
+    ASSERT_EQ(ctx.ready, (uint32_t)2);
+}
+
+TEST(select_timer_times_out_and_records_recycle)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle timer;
+    void *wakers[4];
+    select_ctx ctx;
+    uint32_t round;
+
+    waker_test_reset();
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ctx.set.channels[0]), ASX_OK);
+    ctx.set.channel_count = 1;
+    ctx.set.timer_wheel = w;
+    ctx.set.timer = &timer;
+    budget = asx_budget_from_polls(100);
+
+    /* More rounds than select records: each wake returns its record */
+    for (round = 0; round < ASX_SELECT_MAX_WAITERS + 2u; round++) {
+        ctx.polls = 0;
+        ASSERT_EQ(asx_timer_register(w, (asx_time)(round + 1u) * 10u, &ctx,
+                                     &timer), ASX_OK);
+        ASSERT_EQ(asx_task_spawn(rid, poll_select, &ctx, &tid), ASX_OK);
+        ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+        ASSERT_EQ(asx_parked_count(), (uint32_t)1);
+
+        ASSERT_EQ(asx_timer_collect_expired(w, (asx_time)(round + 1u) * 10u,
+                                            wakers, 4), (uint32_t)1);
+        ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+        ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+        ASSERT_EQ(ctx.polls, 2);
+        ASSERT_EQ(ctx.ready, (uint32_t)1);
+    }
+    asx_timer_wheel_reset(w);
+}
+
+/* I/O waiter: parks on its own key until a source signals it. */
+typedef struct {
+    uint64_t key;
+    int      polls;
+    int      signalled;
+} io_wait_ctx;
+
+static asx_status poll_io_wait(void *data, asx_task_id self)
+{
+    io_wait_ctx *c = (io_wait_ctx *)data;
+    asx_status st;
+
+    c->polls++;
+    if (c->signalled) return ASX_OK;
+    st = asx_task_park_on_io(self, c->key);
+    if (st != ASX_OK) return st;
+    return ASX_E_PENDING;
+}
+
+TEST(io_key_wakes_only_its_waiter)
+{
+    asx_region_id rid;
+    asx_task_id a, b;
+    asx_budget budget;
+    io_wait_ctx ca, cb;
+    int parked = 0;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ca.key = asx_park_key_io(&ca);
+    cb.key = asx_park_key_io(&cb);
+    ca.polls = cb.polls = 0;
+    ca.signalled = cb.signalled = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_io_wait, &ca, &a), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_io_wait, &cb, &b), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)2);
+
+    /* Same key under another kind wakes nobody */
+    ASSERT_EQ(asx_wake_source(ASX_PARK_CHANNEL, cb.key), (uint32_t)0);
+    cb.signalled = 1;
+    ASSERT_EQ(asx_wake_source(ASX_PARK_IO, cb.key), (uint32_t)1);
+    ASSERT_EQ(asx_task_is_parked(a, &parked), ASX_OK);
+    ASSERT_EQ(parked, 1);
+
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(cb.polls, 2);
+    ASSERT_EQ(ca.polls, 1);
+    ca.signalled = 1;
+    ASSERT_EQ(asx_task_wake(a), ASX_OK);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+}
+
+TEST(wake_visits_only_its_source_bucket)
+{
+    asx_region_id rid;
+    asx_task_id tids[ASX_MAX_TASKS];
+    io_wait_ctx ctx[ASX_MAX_TASKS];
+    asx_trace_event ev;
+    uint32_t i;
+    uint32_t n;
+    uint32_t wakes = 0;
+
+    waker_test_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS; i++) {
+        ctx[i].key = i + 1u;
+        ctx[i].polls = 0;
+        ctx[i].signalled = 0;
+        ASSERT_EQ(asx_task_spawn(rid, poll_io_wait, &ctx[i], &tids[i]), ASX_OK);
+        ASSERT_EQ(asx_task_park_on_io(tids[i], ctx[i].key), ASX_OK);
+    }
+    ASSERT_EQ(asx_parked_count(), (uint32_t)ASX_MAX_TASKS);
+
+    /* Every other waiter sits on an unrelated key: a wake walks the
+     * key's bucket, not the whole park list */
+    ASSERT_EQ(asx_wake_source(ASX_PARK_IO, 1u), (uint32_t)1);
+    ASSERT_TRUE(asx_waker_last_visits() <= 8u);
+    ASSERT_EQ(asx_wake_source(ASX_PARK_IO, 0x5eedu), (uint32_t)0);
+    ASSERT_TRUE(asx_waker_last_visits() <= 8u);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)(ASX_MAX_TASKS - 1u));
+
+    /* A re-park changes bucket but keeps its place in park order */
+    ASSERT_EQ(asx_task_park_on_io(tids[1], ctx[3].key), ASX_OK);
+    asx_trace_reset();
+    ASSERT_EQ(asx_wake_source(ASX_PARK_IO, ctx[3].key), (uint32_t)2);
+    n = asx_trace_event_count();
+    for (i = 0; i < n; i++) {
+        ASSERT_TRUE(asx_trace_event_get(i, &ev));
+        if (ev.kind != ASX_TRACE_TASK_WAKE) continue;
+        ASSERT_EQ(asx_handle_slot((asx_task_id)ev.entity_id),
+                  asx_handle_slot(tids[wakes == 0u ? 1u : 3u]));
+        wakes++;
+    }
+    ASSERT_EQ(wakes, (uint32_t)2);
+    ASSERT_EQ(asx_wake_source(ASX_PARK_IO, ctx[1].key), (uint32_t)0);
+}
+
+#ifdef ASX_PROFILE_POSIX
+#include <unistd.h>
+
+/* Reads one byte through io_uring, parking until it completes. */
+typedef struct {
+    asx_platform_uring     *ring;
+    asx_platform_uring_op   op;
+    int                     fd;
+    int                     submitted;
+    int                     polls;
+    char                    byte;
+} uring_read_ctx;
+
+static asx_status poll_uring_read(void *data, asx_task_id self)
+{
+    uring_read_ctx *c = (uring_read_ctx *)data;
+    asx_status st;
+
+    c->polls++;
+    if (c->submitted) return c->op.done ? ASX_OK : ASX_E_PENDING;
+    st = asx_platform_uring_read(c->ring, &c->op, self, c->fd, &c->byte, 1,
+                                 UINT64_MAX);
+    if (st != ASX_OK) return st;
+    c->submitted = 1;
+    return ASX_E_PENDING;
+}
+
+TEST(uring_completion_wakes_owning_task)
+{
+    static asx_platform_uring ring;
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    uring_read_ctx ctx;
+    uint32_t ready = 99;
+    int fds[2];
+    int parked = 0;
+    const char x = 'q';
+
+    waker_test_reset();
+    if (asx_platform_uring_open(&ring, 8) != ASX_OK) {
+        return; /* io_uring unavailable on this host */
+    }
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ctx.ring = &ring;
+    ctx.fd = fds[0];
+    ctx.submitted = 0;
+    ctx.polls = 0;
+    ctx.byte = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_uring_read, &ctx, &tid), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+    ASSERT_EQ(asx_task_is_parked(tid, &parked), ASX_OK);
+    ASSERT_EQ(parked, 1);
+
+    /* Submitted by the first wait; nothing to read yet */
+    ASSERT_EQ(asx_platform_uring_wait(&ring, 0, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+    ASSERT_EQ(ctx.op.done, 0u);
+
+    ASSERT_EQ(write(fds[1], &x, 1), 1);
+    ASSERT_EQ(asx_platform_uring_wait(&ring, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(ctx.op.done, 1u);
+    ASSERT_EQ(ctx.op.result, 1);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(ctx.polls, 2);
+    ASSERT_EQ(ctx.byte, 'q');
+
+    /* A timed wait with nothing in flight returns at once */
+    ASSERT_EQ(asx_platform_uring_wait(&ring, 1000, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_uring_install(&ring, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.reactor.wait_fn == asx_platform_uring_wait);
+    ASSERT_TRUE(hooks.reactor.ghost_wait_fn != NULL);
+
+    asx_platform_uring_close(&ring);
+    ASSERT_EQ(asx_platform_uring_wait(&ring, 0, &ready), ASX_E_INVALID_ARGUMENT);
+    (void)close(fds[0]);
+    (void)close(fds[1]);
+}
+#endif
+
+#ifdef ASX_PROFILE_FREESTANDING
+/* Stands in for the core sleeping: each call is one interrupt, which
+ * advances the tick counter and may signal a line. */
+typedef struct {
+    asx_platform_wfi_reactor *r;
+    uint64_t ticks;
+    uint32_t line;           /* ASX_PLATFORM_WFI_LINES: signal nothing */
+    uint32_t sleeps;
+} wfi_idle_ctx;
+
+static void wfi_test_idle(void *ctx, volatile uint32_t *pending)
+{
+    wfi_idle_ctx *c = (wfi_idle_ctx *)ctx;
+
+    (void)pending;
+    c->sleeps++;
+    c->ticks += 1000u;
+    asx_platform_wfi_signal(c->r, c->line);
+}
+
+static uint64_t wfi_test_ticks(void *ctx)
+{
+    return ((wfi_idle_ctx *)ctx)->ticks;
+}
+
+TEST(wfi_signal_wakes_task_parked_on_line)
+{
+    static asx_platform_wfi_reactor r;
+    asx_platform_tick_clock clock;
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    io_wait_ctx ctx;
+    wfi_idle_ctx idle;
+    uint32_t ready = 99;
+    int parked = 0;
+
+    waker_test_reset();
+    idle.r = &r;
+    idle.ticks = 0;
+    idle.line = ASX_PLATFORM_WFI_LINES;
+    idle.sleeps = 0;
+    /* 1 MHz counter: each idle call advances one millisecond */
+    ASSERT_EQ(asx_platform_tick_clock_init(&clock, wfi_test_ticks, &idle,
+                                           1000000u, 32), ASX_OK);
+    ASSERT_EQ(asx_platform_wfi_init(&r, wfi_test_idle, &idle, &clock), ASX_OK);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ctx.key = asx_platform_wfi_key(&r, 3);
+    ctx.polls = 0;
+    ctx.signalled = 0;
+    ASSERT_EQ(asx_task_spawn(rid, poll_io_wait, &ctx, &tid), ASX_OK);
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_PENDING);
+
+    /* A zero timeout never sleeps; a bounded one sleeps to the deadline */
+    ASSERT_EQ(asx_platform_wfi_wait(&r, 0, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+    ASSERT_EQ(idle.sleeps, 0u);
+    ASSERT_EQ(asx_platform_wfi_wait(&r, 5, &ready), ASX_OK);
+    ASSERT_EQ(ready, 0u);
+    ASSERT_EQ(idle.sleeps, 5u);
+
+    /* Another line wakes nobody */
+    asx_platform_wfi_signal(&r, 4);
+    ASSERT_EQ(asx_platform_wfi_wait(&r, UINT32_MAX, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(idle.sleeps, 5u);
+    ASSERT_EQ(asx_task_is_parked(tid, &parked), ASX_OK);
+    ASSERT_EQ(parked, 1);
+
+    /* The interrupt taken during the sleep wakes the task */
+    idle.line = 3;
+    ctx.signalled = 1;
+    ASSERT_EQ(asx_platform_wfi_wait(&r, UINT32_MAX, &ready), ASX_OK);
+    ASSERT_EQ(ready, 1u);
+    ASSERT_EQ(idle.sleeps, 6u);
+    ASSERT_EQ(asx_parked_count(), (uint32_t)0);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(ctx.polls, 2);
+
+    ASSERT_EQ(asx_platform_wfi_key(&r, ASX_PLATFORM_WFI_LINES), (uint64_t)0);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_platform_wfi_install(&r, &hooks), ASX_OK);
+    ASSERT_TRUE(hooks.reactor.wait_fn == asx_platform_wfi_wait);
+}
+#endif
+
+int main(void)
+{
+    fprintf(stderr, "=== test_waker ===\n");
+
+    RUN_TEST(parked_task_not_polled_and_scheduler_idles);
+    RUN_TEST(channel_send_wakes_receiver);
+    RUN_TEST(timer_fire_wakes_waiter);
+    RUN_TEST(obligation_commit_wakes_waiter);
+    RUN_TEST(cancel_wakes_parked_task_and_drain_completes);
+    RUN_TEST(park_intent_dropped_when_poll_completes);
+    RUN_TEST(park_terminal_task_rejected);
+    RUN_TEST(wake_order_follows_park_order_in_trace);
+    RUN_TEST(idle_wait_sleeps_until_next_timer);
+    RUN_TEST(region_deadline_cancels_subtree_with_deadline_kind);
+    RUN_TEST(obligation_lease_expiry_aborts_and_unblocks_drain);
+    RUN_TEST(select_returns_first_ready_source_in_order);
+    RUN_TEST(select_parks_until_any_channel_is_ready);
+    RUN_TEST(select_timer_times_out_and_records_recycle);
+    RUN_TEST(io_key_wakes_only_its_waiter);
+    RUN_TEST(wake_visits_only_its_source_bucket);
+#ifdef ASX_PROFILE_POSIX
+    RUN_TEST(uring_completion_wakes_owning_task);
+#endif
+#ifdef ASX_PROFILE_FREESTANDING
+    RUN_TEST(wfi_signal_wakes_task_parked_on_line);
+#endif
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -570,6 +570,418 @@ TEST(timer_large_time_jump) {
     ASSERT_EQ(wakers[2], (void *)5);
 }
 
+/* -------------------------------------------------------------------
+ * Test: ordering holds across wheel levels and the overflow bucket
+ * ------------------------------------------------------------------- */
+
+TEST(timer_cross_level_ordering) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    /* Level 0, 1, 2, 3 and overflow (> 2^32 ahead), registered backwards */
+    static const asx_time deadlines[] = {
+        (asx_time)1 << 40, 5000000000ULL, 20000000, 70000, 300, 300, 5
+    };
+    asx_timer_handle h;
+    void *wakers[8];
+    uint32_t count;
+    uint32_t i;
+
+    asx_timer_wheel_reset(w);
+    asx_timer_set_max_duration(w, (uint64_t)1 << 41);
+
+    for (i = 0; i < 7; i++) {
+        ASSERT_EQ(asx_timer_register(w, deadlines[i], (void *)(uintptr_t)(i + 1u), &h),
+                  ASX_OK);
+    }
+
+    /* Step through each deadline; exactly the due timers fire */
+    ASSERT_EQ(asx_timer_collect_expired(w, 4, wakers, 8), (uint32_t)0);
+    ASSERT_EQ(asx_timer_collect_expired(w, 5, wakers, 8), (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)7);
+    ASSERT_EQ(asx_timer_collect_expired(w, 299, wakers, 8), (uint32_t)0);
+    ASSERT_EQ(asx_timer_collect_expired(w, 300, wakers, 8), (uint32_t)2);
+    ASSERT_EQ(wakers[0], (void *)5); /* same deadline: insertion order */
+    ASSERT_EQ(wakers[1], (void *)6);
+    ASSERT_EQ(asx_timer_collect_expired(w, 69999, wakers, 8), (uint32_t)0);
+    ASSERT_EQ(asx_timer_collect_expired(w, 70000, wakers, 8), (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)4);
+
+    /* One jump past the level-2 and level-3 deadlines */
+    count = asx_timer_collect_expired(w, 6000000000ULL, wakers, 8);
+    ASSERT_EQ(count, (uint32_t)2);
+    ASSERT_EQ(wakers[0], (void *)3);
+    ASSERT_EQ(wakers[1], (void *)2);
+
+    /* The overflow timer cascades down and fires on time */
+    ASSERT_EQ(asx_timer_collect_expired(w, ((asx_time)1 << 40) - 1, wakers, 8),
+              (uint32_t)0);
+    ASSERT_EQ(asx_timer_collect_expired(w, (asx_time)1 << 40, wakers, 8),
+              (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)1);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)0);
+}
+
+/* -------------------------------------------------------------------
+ * Test: next deadline tracks the earliest live timer across levels
+ * ------------------------------------------------------------------- */
+
+TEST(timer_next_deadline_tracks_minimum) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle far, mid, near;
+    asx_time next = 0;
+    void *wakers[4];
+
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_timer_next_deadline(NULL, &next), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_timer_next_deadline(w, NULL), ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_timer_register(w, (asx_time)1 << 40, NULL, &far), ASX_OK);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)1 << 40);
+
+    ASSERT_EQ(asx_timer_register(w, 70000, NULL, &mid), ASX_OK);
+    ASSERT_EQ(asx_timer_register(w, 300, NULL, &near), ASX_OK);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)300);
+
+    /* Cancelling the minimum exposes the next level up */
+    ASSERT_EQ(asx_timer_cancel(w, &near), 1);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)70000);
+
+    /* Advancing past it leaves it due until collected */
+    asx_timer_advance(w, 80000);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)70000);
+    ASSERT_EQ(asx_timer_collect_expired(w, 80000, wakers, 4), (uint32_t)1);
+
+    /* The overflow timer is found by scanning overflow */
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)1 << 40);
+    ASSERT_EQ(asx_timer_cancel(w, &far), 1);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_E_NOT_FOUND);
+}
+
+/* -------------------------------------------------------------------
+ * Test: batch register/cancel match sequential calls
+ * ------------------------------------------------------------------- */
+
+TEST(timer_batch_register_matches_sequential) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_time deadlines[5] = { 50, 20, ASX_TIMER_MAX_DURATION_NS + 1u, 20, 10 };
+    void *data[5] = { (void *)1, (void *)2, (void *)3, (void *)4, (void *)5 };
+    asx_timer_handle handles[5];
+    asx_status status[5];
+    asx_timer_handle single;
+    void *wakers[8];
+
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_timer_register(w, 20, (void *)9, &single), ASX_OK);
+
+    /* The over-long item fails alone; the rest register in order */
+    ASSERT_EQ(asx_timer_register_batch(w, deadlines, data, 5, handles, status),
+              ASX_E_TIMER_DURATION_EXCEEDED);
+    ASSERT_EQ(status[0], ASX_OK);
+    ASSERT_EQ(status[1], ASX_OK);
+    ASSERT_EQ(status[2], ASX_E_TIMER_DURATION_EXCEEDED);
+    ASSERT_EQ(status[3], ASX_OK);
+    ASSERT_EQ(status[4], ASX_OK);
+    ASSERT_EQ(handles[2].generation, (uint32_t)0);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)5);
+
+    /* Same-deadline ties follow single-then-batch array order */
+    ASSERT_EQ(asx_timer_collect_expired(w, 100, wakers, 8), (uint32_t)5);
+    ASSERT_EQ(wakers[0], (void *)5);
+    ASSERT_EQ(wakers[1], (void *)9);
+    ASSERT_EQ(wakers[2], (void *)2);
+    ASSERT_EQ(wakers[3], (void *)4);
+    ASSERT_EQ(wakers[4], (void *)1);
+
+    ASSERT_EQ(asx_timer_register_batch(NULL, deadlines, data, 1, handles, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_timer_register_batch(w, NULL, data, 1, handles, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_timer_register_batch(w, NULL, NULL, 0, handles, NULL), ASX_OK);
+}
+
+TEST(timer_batch_cancel_reports_per_item) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_time deadlines[4] = { 200, 300, 400, 500 };
+    asx_timer_handle handles[4];
+    asx_timer_handle victims[4];
+    int cancelled[4];
+    void *wakers[8];
+
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_timer_register_batch(w, deadlines, NULL, 4, handles, NULL),
+              ASX_OK);
+    ASSERT_EQ(asx_timer_cancel(w, &handles[1]), 1);
+
+    /* Live, already-cancelled, duplicate, live */
+    victims[0] = handles[0];
+    victims[1] = handles[1];
+    victims[2] = handles[0];
+    victims[3] = handles[3];
+    ASSERT_EQ(asx_timer_cancel_batch(w, victims, 4, cancelled), (uint32_t)2);
+    ASSERT_EQ(cancelled[0], 1);
+    ASSERT_EQ(cancelled[1], 0);
+    ASSERT_EQ(cancelled[2], 0);
+    ASSERT_EQ(cancelled[3], 1);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)1);
+
+    ASSERT_EQ(asx_timer_collect_expired(w, 1000, wakers, 8), (uint32_t)1);
+    ASSERT_EQ(asx_timer_cancel_batch(w, NULL, 4, cancelled), (uint32_t)0);
+}
+
+/* -------------------------------------------------------------------
+ * Test: randomized ops match a flat reference model
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    asx_time         deadline;
+    uint64_t         seq;
+    asx_timer_handle handle;
+    int              alive;
+} ref_timer;
+
+static uint64_t g_ref_rng;
+
+static uint32_t ref_rand(uint32_t bound) {
+    g_ref_rng = g_ref_rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (uint32_t)((g_ref_rng >> 33) % bound);
+}
+
+TEST(timer_matches_reference_model) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    static ref_timer ref[2048];
+    void *wakers[16];
+    uint32_t ref_count = 0;
+    uint64_t seq = 0;
+    asx_time now = 0;
+    uint32_t op;
+
+    asx_timer_wheel_reset(w);
+    g_ref_rng = 42;
+
+    for (op = 0; op < 4000; op++) {
+        uint32_t kind = ref_rand(10);
+
+        if (kind < 5 && ref_count < 2048 &&
+            asx_timer_active_count(w) < ASX_MAX_TIMERS) {
+            /* Register: mostly near, sometimes far, sometimes past */
+            static const uint32_t spans[4] = { 16, 1000, 300000, 90000000 };
+            uint32_t span = spans[ref_rand(4)];
+            asx_time dl = now + ref_rand(span);
+            if (ref_rand(8) == 0 && now > 10) dl = now - ref_rand(10);
+            ref[ref_count].deadline = dl;
+            ref[ref_count].seq = seq++;
+            ref[ref_count].alive = 1;
+            ASSERT_EQ(asx_timer_register(w, dl, (void *)(uintptr_t)(ref_count + 1u),
+                                         &ref[ref_count].handle), ASX_OK);
+            ref_count++;
+        } else if (kind < 7 && ref_count > 0) {
+            /* Cancel a random timer (possibly already dead) */
+            uint32_t i = ref_rand(ref_count);
+            ASSERT_EQ(asx_timer_cancel(w, &ref[i].handle), ref[i].alive);
+            ref[i].alive = 0;
+        } else {
+            /* Collect after a random jump, bounded output */
+            static const uint32_t jumps[4] = { 1, 200, 70000, 50000000 };
+            uint32_t max = 1u + ref_rand(16);
+            uint32_t got;
+            uint32_t k;
+
+            now += ref_rand(jumps[ref_rand(4)]);
+            got = asx_timer_collect_expired(w, now, wakers, max);
+            for (k = 0; k < max; k++) {
+                /* Reference: earliest alive (deadline, seq) with deadline <= now */
+                uint32_t best = ref_count;
+                uint32_t i;
+                for (i = 0; i < ref_count; i++) {
+                    if (!ref[i].alive || ref[i].deadline > now) continue;
+                    if (best == ref_count ||
+                        ref[i].deadline < ref[best].deadline ||
+                        (ref[i].deadline == ref[best].deadline &&
+                         ref[i].seq < ref[best].seq)) {
+                        best = i;
+                    }
+                }
+                if (best == ref_count) {
+                    ASSERT_EQ(got, k);
+                    break;
+                }
+                ASSERT_TRUE(k < got);
+                ASSERT_EQ(wakers[k], (void *)(uintptr_t)(best + 1u));
+                ref[best].alive = 0;
+            }
+        }
+
+        /* Next deadline: earliest alive deadline, due or not */
+        {
+            asx_time next = 0;
+            asx_time ref_next = 0;
+            int any = 0;
+            uint32_t i;
+            for (i = 0; i < ref_count; i++) {
+                if (!ref[i].alive) continue;
+                if (!any || ref[i].deadline < ref_next) ref_next = ref[i].deadline;
+                any = 1;
+            }
+            if (any) {
+                ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+                ASSERT_EQ(next, ref_next);
+            } else {
+                ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_E_NOT_FOUND);
+            }
+        }
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Test: coalesced timers share a deadline and fire as one group, in
+ * registration order, where the group's first registration sorts
+ * ------------------------------------------------------------------- */
+
+TEST(timer_coalesced_group_fires_together) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle a, b, c, p, late;
+    asx_time next = 0;
+    void *wakers[8];
+    uint32_t count;
+
+    asx_timer_wheel_reset(w);
+
+    /* Slack 15 rounds to multiples of 8: 1001..1008 all become 1008 */
+    ASSERT_EQ(asx_timer_register_coalesced(w, 1001, 15, (void *)1, &a), ASX_OK);
+    ASSERT_EQ(asx_timer_register(w, 1008, (void *)4, &p), ASX_OK);
+    ASSERT_EQ(asx_timer_register_coalesced(w, 1005, 15, (void *)2, &b), ASX_OK);
+    ASSERT_EQ(asx_timer_register_coalesced(w, 1008, 15, (void *)3, &c), ASX_OK);
+    ASSERT_EQ(asx_timer_register_coalesced(w, 1009, 15, (void *)5, &late), ASX_OK);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)5);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)1008);
+
+    ASSERT_EQ(asx_timer_collect_expired(w, 1007, wakers, 8), (uint32_t)0);
+    count = asx_timer_collect_expired(w, 1008, wakers, 8);
+    ASSERT_EQ(count, (uint32_t)4);
+    ASSERT_EQ(wakers[0], (void *)1);
+    ASSERT_EQ(wakers[1], (void *)2);
+    ASSERT_EQ(wakers[2], (void *)3);
+    ASSERT_EQ(wakers[3], (void *)4);
+    ASSERT_FALSE(asx_timer_is_live(w, &a));
+    ASSERT_FALSE(asx_timer_cancel(w, &c));
+
+    /* 1009 landed in the next window */
+    ASSERT_TRUE(asx_timer_is_live(w, &late));
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)1016);
+    count = asx_timer_collect_expired(w, 1016, wakers, 8);
+    ASSERT_EQ(count, (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)5);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)0);
+    (void)p;
+}
+
+/* -------------------------------------------------------------------
+ * Test: cancelling members, splitting a group across collect calls,
+ * and the plain-register fallbacks
+ * ------------------------------------------------------------------- */
+
+TEST(timer_coalesced_cancel_and_partial_collect) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle h[4];
+    asx_time next = 0;
+    void *wakers[4];
+    uint32_t i;
+
+    asx_timer_wheel_reset(w);
+
+    ASSERT_EQ(asx_timer_register_coalesced(NULL, 10, 4, NULL, &h[0]),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_timer_register_coalesced(w, 10, 4, NULL, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    asx_timer_set_max_duration(w, 1000);
+    ASSERT_EQ(asx_timer_register_coalesced(w, 999, 512, NULL, &h[0]),
+              ASX_E_TIMER_DURATION_EXCEEDED);
+    asx_timer_set_max_duration(w, ASX_TIMER_MAX_DURATION_NS);
+
+    /* Cancelling every member retires the group */
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_timer_register_coalesced(w, 100 + i, 64, (void *)(uintptr_t)(i + 1u),
+                                               &h[i]), ASX_OK);
+    }
+    ASSERT_TRUE(asx_timer_cancel(w, &h[1]));
+    ASSERT_FALSE(asx_timer_cancel(w, &h[1]));
+    ASSERT_TRUE(asx_timer_cancel(w, &h[0]));
+    ASSERT_TRUE(asx_timer_cancel(w, &h[2]));
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)0);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_timer_collect_expired(w, 200, wakers, 4), (uint32_t)0);
+
+    /* A cancelled member is skipped; the rest fire one call at a time */
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_timer_register_coalesced(w, 300 + i, 64, (void *)(uintptr_t)(i + 1u),
+                                               &h[i]), ASX_OK);
+    }
+    ASSERT_TRUE(asx_timer_cancel(w, &h[1]));
+    ASSERT_EQ(asx_timer_collect_expired(w, 320, wakers, 1), (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)1);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)1);
+    ASSERT_EQ(asx_timer_collect_expired(w, 320, wakers, 1), (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)3);
+    ASSERT_EQ(asx_timer_collect_expired(w, 320, wakers, 4), (uint32_t)0);
+
+    /* No slack, or a deadline already due, registers plainly */
+    ASSERT_EQ(asx_timer_register_coalesced(w, 333, 0, (void *)7, &h[0]), ASX_OK);
+    ASSERT_EQ(asx_timer_register_coalesced(w, 100, 64, (void *)8, &h[1]), ASX_OK);
+    ASSERT_EQ(asx_timer_next_deadline(w, &next), ASX_OK);
+    ASSERT_EQ(next, (asx_time)100);
+    ASSERT_EQ(asx_timer_collect_expired(w, 332, wakers, 4), (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)8);
+    ASSERT_EQ(asx_timer_collect_expired(w, 333, wakers, 4), (uint32_t)1);
+    ASSERT_EQ(wakers[0], (void *)7);
+}
+
+/* -------------------------------------------------------------------
+ * Test: a storm of nearby idle timeouts uses a handful of wheel
+ * entries, so it fits in the static chunk with room to spare
+ * ------------------------------------------------------------------- */
+
+TEST(timer_coalesced_storm_fits_static_chunk) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle h;
+    void *wakers[32];
+    uint32_t fired = 0;
+    uint32_t got;
+    uint32_t i;
+
+    asx_timer_wheel_reset(w);
+
+    /* 120 members within one 1024-unit window: one group slot */
+    for (i = 0; i < 120u; i++) {
+        ASSERT_EQ(asx_timer_register_coalesced(w, 5000 + i, 1024,
+                                               (void *)(uintptr_t)(i + 1u), &h),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)120);
+    /* 120 members + 1 group: 7 plain slots remain of ASX_MAX_TIMERS */
+    for (i = 0; i < 7u; i++) {
+        ASSERT_EQ(asx_timer_register(w, 9000, NULL, &h), ASX_OK);
+    }
+    ASSERT_EQ(asx_timer_register(w, 9000, NULL, &h), ASX_E_RESOURCE_EXHAUSTED);
+
+    do {
+        uint32_t k;
+        got = asx_timer_collect_expired(w, 5120, wakers, 32);
+        for (k = 0; k < got; k++) {
+            ASSERT_EQ(wakers[k], (void *)(uintptr_t)(fired + k + 1u));
+        }
+        fired += got;
+    } while (got != 0u);
+    ASSERT_EQ(fired, (uint32_t)120);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)7);
+}
+
 /* -------------------------------------------------------------------
  * Main
  * ------------------------------------------------------------------- */
@@ -602,6 +1014,14 @@ int main(void) {
     RUN_TEST(timer_double_cancel_returns_false);
     RUN_TEST(timer_cancellation_race);
     RUN_TEST(timer_large_time_jump);
+    RUN_TEST(timer_cross_level_ordering);
+    RUN_TEST(timer_next_deadline_tracks_minimum);
+    RUN_TEST(timer_batch_register_matches_sequential);
+    RUN_TEST(timer_batch_cancel_reports_per_item);
+    RUN_TEST(timer_matches_reference_model);
+    RUN_TEST(timer_coalesced_group_fires_together);
+    RUN_TEST(timer_coalesced_cancel_and_partial_collect);
+    RUN_TEST(timer_coalesced_storm_fits_static_chunk);
 
     TEST_REPORT();
     return test_failures;
@@ -0,0 +1,138 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+usage() {
+  cat <<'EOF'
+Usage: generate_amalgamation.sh
+  --out <file>
+  -- <source.c>...
+
+Concatenates the given library sources, in order, into one C file
+(a single translation unit, the way SQLite ships sqlite3.c), so the
+compiler sees every definition at once and can inline calls across
+what are otherwise separate objects without LTO.
+
+Quoted private headers ("runtime_internal.h", "../core/entity_hash.h")
+are inlined once, at their first use; <asx/...> public headers are
+left as includes and keep their own guards. #line directives map
+diagnostics back to the original files.
+
+Sources are given relative to the repository root. Prints the
+output path on stdout on success.
+EOF
+}
+
+out=""
+declare -a sources=()
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --out)
+      out="$2"
+      shift 2
+      ;;
+    --)
+      shift
+      sources=("$@")
+      break
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    *)
+      echo "Unknown argument: $1" >&2
+      usage >&2
+      exit 2
+      ;;
+  esac
+done
+
+if [[ -z "$out" || ${#sources[@]} -eq 0 ]]; then
+  echo "Missing required arguments" >&2
+  usage >&2
+  exit 2
+fi
+
+script_dir="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+repo_root="$(cd "$script_dir/../.." && pwd)"
+
+for src in "${sources[@]}"; do
+  if [[ ! -f "$repo_root/$src" ]]; then
+    echo "amalgamation source not found: $src" >&2
+    exit 1
+  fi
+done
+
+mkdir -p "$(dirname "$out")"
+tmp_out="$out.tmp"
+
+{
+  printf '/*\n'
+  printf ' * asx.c — single translation unit build of the asx library\n'
+  printf ' *\n'
+  printf ' * Generated by tools/ci/generate_amalgamation.sh from %d sources.\n' "${#sources[@]}"
+  printf ' * Do not edit; regenerate with "make amalgamation".\n'
+  printf ' *\n'
+  printf ' * SPDX-License-Identifier: MIT\n'
+  printf ' */\n'
+  (cd "$repo_root" && awk '
+    # Collapse "a/b/../c" to "a/c" so a header reached by two relative
+    # paths is recognized as already inlined.
+    function canon(path,    n, i, k, part, out) {
+      n = split(path, part, "/")
+      k = 0
+      for (i = 1; i <= n; i++) {
+        if (part[i] == "" || part[i] == ".") continue
+        if (part[i] == ".." && k > 0 && stack[k] != "..") { k--; continue }
+        stack[++k] = part[i]
+      }
+      out = ""
+      for (i = 1; i <= k; i++) out = out (i > 1 ? "/" : "") stack[i]
+      return out
+    }
+
+    function emit(path,    line, lineno, inc, dir, hdr, eof) {
+      lineno = 0
+      printf "#line 1 \"%s\"\n", path
+      while ((eof = (getline line < path)) > 0) {
+        lineno++
+        if (line !~ /^[ \t]*#[ \t]*include[ \t]*"/) {
+          print line
+          continue
+        }
+        inc = line
+        sub(/^[^"]*"/, "", inc)
+        sub(/".*$/, "", inc)
+        dir = path
+        if (!sub(/\/[^\/]*$/, "", dir)) dir = "."
+        hdr = canon(dir "/" inc)
+        if (!(hdr in seen)) {
+          seen[hdr] = 1
+          print "/* ---- begin " hdr " ---- */"
+          emit(hdr)
+          print "/* ---- end " hdr " ---- */"
+        }
+        printf "#line %d \"%s\"\n", lineno + 1, path
+      }
+      if (eof < 0) {
+        print "cannot read " path > "/dev/stderr"
+        failed = 1
+      }
+      close(path)
+    }
+
+    BEGIN {
+      for (i = 1; i < ARGC; i++) {
+        print ""
+        print "/* ==== begin " ARGV[i] " ==== */"
+        emit(ARGV[i])
+        print "/* ==== end " ARGV[i] " ==== */"
+      }
+      exit failed
+    }
+  ' "${sources[@]}")
+} >"$tmp_out"
+
+mv "$tmp_out" "$out"
+printf '%s\n' "$out"
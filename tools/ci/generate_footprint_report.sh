@@ -0,0 +1,229 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+usage() {
+  cat <<'EOF'
+Usage: generate_footprint_report.sh
+  --compiler <compiler>
+  --target-id <id>
+  --out-dir <dir>
+  [--profile <CORE|POSIX|WIN32|FREESTANDING|EMBEDDED_ROUTER|HFT|AUTOMOTIVE>]
+  [--codec <JSON|BIN>]
+  [--run-id <id>]
+  [--extra-cflags "<flags>"]
+  -- <source.c>...
+
+Compiles each library source at -Os with -fstack-usage and
+-fcallgraph-info=su and writes:
+  - <out-dir>/<run-id>-<target-id>-footprint.json
+
+The report lists .text/.rodata/.data/.bss per object, and for every
+exported function its own frame and its worst-case stack depth over
+the static call graph. A depth is a lower bound ("bounded": false)
+when the path reaches an indirect call (poll functions, hooks), a
+dynamically sized frame, or recursion. Calls outside the library
+(libc) count as zero.
+
+Prints the JSON report path on stdout on success.
+EOF
+}
+
+json_escape() {
+  printf '%s' "$1" | sed -e 's/\\/\\\\/g' -e 's/"/\\"/g'
+}
+
+compiler=""
+target_id=""
+profile="EMBEDDED_ROUTER"
+codec="BIN"
+out_dir=""
+run_id="footprint-$(date -u +%Y%m%dT%H%M%SZ)"
+extra_cflags=""
+declare -a sources=()
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --compiler)
+      compiler="$2"
+      shift 2
+      ;;
+    --target-id)
+      target_id="$2"
+      shift 2
+      ;;
+    --profile)
+      profile="$2"
+      shift 2
+      ;;
+    --codec)
+      codec="$2"
+      shift 2
+      ;;
+    --out-dir)
+      out_dir="$2"
+      shift 2
+      ;;
+    --run-id)
+      run_id="$2"
+      shift 2
+      ;;
+    --extra-cflags)
+      extra_cflags="$2"
+      shift 2
+      ;;
+    --)
+      shift
+      sources=("$@")
+      break
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    *)
+      echo "Unknown argument: $1" >&2
+      usage >&2
+      exit 2
+      ;;
+  esac
+done
+
+if [[ -z "$compiler" || -z "$target_id" || -z "$out_dir" || ${#sources[@]} -eq 0 ]]; then
+  echo "Missing required arguments" >&2
+  usage >&2
+  exit 2
+fi
+
+script_dir="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+repo_root="$(cd "$script_dir/../.." && pwd)"
+
+# The matching binutils size sits next to the cross gcc
+size_tool="size"
+if [[ "$compiler" == *gcc ]] && command -v "${compiler%gcc}size" >/dev/null 2>&1; then
+  size_tool="${compiler%gcc}size"
+fi
+
+mkdir -p "$out_dir"
+safe_target="${target_id//\//_}"
+json_path="$out_dir/${run_id}-${safe_target}-footprint.json"
+log_path="$out_dir/${run_id}-${safe_target}-footprint.log"
+
+tmp_dir="$(mktemp -d "${TMPDIR:-/tmp}/asx-footprint.XXXXXX")"
+cleanup() {
+  rm -rf "$tmp_dir"
+}
+trap cleanup EXIT
+
+declare -a cflags
+cflags=("-std=c99" "-Os" "-DNDEBUG" "-I$repo_root/include"
+        "-DASX_PROFILE_${profile}" "-DASX_CODEC_${codec}" "-DASX_DETERMINISTIC=1"
+        "-fstack-usage" "-fcallgraph-info=su")
+if [[ -n "$extra_cflags" ]]; then
+  # shellcheck disable=SC2206
+  extra_tokens=($extra_cflags)
+  cflags+=("${extra_tokens[@]}")
+fi
+
+: >"$log_path"
+sizes="$tmp_dir/sizes.tsv"
+: >"$sizes"
+for src in "${sources[@]}"; do
+  rel="${src#src/}"
+  rel="${rel%.c}"
+  obj="$tmp_dir/${rel//\//__}.o"
+  if ! (cd "$tmp_dir" && "$compiler" "${cflags[@]}" -c "$repo_root/$src" -o "$obj") >>"$log_path" 2>&1; then
+    echo "footprint compile failed for '$src' on target '$target_id' (see $log_path)" >&2
+    exit 1
+  fi
+  "$size_tool" -A "$obj" | awk -v obj="$rel" '
+    $1 ~ /^\.text/                    { text += $2 }
+    $1 ~ /^\.rodata/                  { rodata += $2 }
+    $1 ~ /^\.s?data/                  { data += $2 }
+    $1 ~ /^\.s?bss/                   { bss += $2 }
+    END { printf "%s\t%d\t%d\t%d\t%d\n", obj, text, rodata, data, bss }
+  ' >>"$sizes"
+done
+
+# One merged call graph: "node <name> <frame> <flags>" and
+# "edge <caller> <callee>". Static functions keep their file prefix.
+graph="$tmp_dir/graph.txt"
+cat "$tmp_dir"/*.ci | awk '
+  function field(line, key,    i, rest) {
+    i = index(line, key ": \"")
+    if (i == 0) return ""
+    rest = substr(line, i + length(key) + 3)
+    return substr(rest, 1, index(rest, "\"") - 1)
+  }
+  /^node:/ {
+    label = field($0, "label")
+    if (label !~ / bytes \(/) next
+    frame = label
+    sub(/ bytes \(.*/, "", frame)
+    sub(/.*\\n/, "", frame)
+    flags = label
+    sub(/.* bytes \(/, "", flags)
+    sub(/\).*/, "", flags)
+    print "node", field($0, "title"), frame, flags
+  }
+  /^edge:/ { print "edge", field($0, "sourcename"), field($0, "targetname") }
+' >"$graph"
+
+stack="$tmp_dir/stack.tsv"
+awk '
+  $1 == "node" { frame[$2] = $3 + 0; flags[$2] = $4 }
+  $1 == "edge" { n = ++ncallee[$2]; callee[$2, n] = $3 }
+
+  # Worst-case depth of f, memoized; sets unbounded when the path
+  # reaches an indirect call, a dynamic frame or recursion.
+  function depth(f,    i, d, best, outer) {
+    if (f in memo) {
+      if (memo_unbounded[f]) unbounded = 1
+      return memo[f]
+    }
+    if (f == "__indirect_call" || open[f]) { unbounded = 1; return 0 }
+    if (!(f in frame)) return 0          # libc and other externals
+    outer = unbounded
+    unbounded = flags[f] != "static"
+    open[f] = 1
+    best = 0
+    for (i = 1; i <= ncallee[f]; i++) {
+      d = depth(callee[f, i])
+      if (d > best) best = d
+    }
+    open[f] = 0
+    memo[f] = frame[f] + best
+    memo_unbounded[f] = unbounded
+    unbounded = unbounded || outer
+    return memo[f]
+  }
+
+  END {
+    for (f in frame) {
+      if (index(f, ":") != 0) continue   # file-local helper
+      unbounded = 0
+      d = depth(f)
+      printf "%s\t%d\t%d\t%s\n", f, frame[f], d, unbounded ? "false" : "true"
+    }
+  }
+' "$graph" | sort -t "$(printf '\t')" -k3,3nr -k1,1 >"$stack"
+
+{
+  printf '{"schema":"asx.footprint.v1","run_id":"%s","target_id":"%s","compiler":"%s","profile":"ASX_PROFILE_%s","codec":"%s",' \
+    "$(json_escape "$run_id")" "$(json_escape "$target_id")" \
+    "$(json_escape "$compiler")" "$(json_escape "$profile")" "$(json_escape "$codec")"
+  awk -F '\t' '
+    { t += $2; r += $3; d += $4; b += $5 }
+    END { printf "\"totals\":{\"text\":%d,\"rodata\":%d,\"data\":%d,\"bss\":%d,\"static_ram\":%d},", t, r, d, b, d + b }
+  ' "$sizes"
+  printf '"objects":['
+  sort -t "$(printf '\t')" -k5,5nr -k1,1 "$sizes" | awk -F '\t' '
+    { printf "%s{\"object\":\"%s\",\"text\":%d,\"rodata\":%d,\"data\":%d,\"bss\":%d}", (NR > 1 ? "," : ""), $1, $2, $3, $4, $5 }
+  '
+  printf '],"stack":['
+  awk -F '\t' '
+    { printf "%s{\"function\":\"%s\",\"frame\":%d,\"worst_case\":%d,\"bounded\":%s}", (NR > 1 ? "," : ""), $1, $2, $3, $4 }
+  ' "$stack"
+  printf ']}\n'
+} >"$json_path"
+
+printf '%s\n' "$json_path"